@@ -57,6 +57,22 @@ private:
                             const PairsIndex margin_right,
                             const Size verbose_level) const;
 
+    /**
+      @brief Solves a slice whose features each have only one charge/adduct variant, without calling the ILP solver
+
+      Such a slice contains no conflicting edges, so the optimal solution activates every edge with a positive score.
+    */
+    double computeConflictFreeSlice_(const FeatureMap& fm,
+                                     PairsType& pairs,
+                                     const PairsIndex margin_left,
+                                     const PairsIndex margin_right) const;
+
+    /// do all features have only one charge/adduct variant among the given edges?
+    bool isConflictFree_(const PairsType& pairs, const std::set<Size>& pair_indices) const;
+
+    /// name of the charge/adduct variant of the feature at @p side (0 or 1) of an edge
+    String getFeatureVariant_(const PairsType::value_type& pair, UInt side) const;
+
     /// calculate a score for the i_th edge
     double getLogScore_(const PairsType::value_type& pair, const FeatureMap& fm) const;
 
@@ -132,6 +132,12 @@ namespace OpenMS
     /// Computes number of matched ions between windows and the given spectrum. All spectra have to be sorted by position!
     Size numberOfMatchedIons_(const PeakSpectrum& th, const PeakSpectrum& windows, Size depth) const;
 
+    /// Computes number of matched ions between the given (sorted) spectrum and the windows of one peak depth (see windowsByPeakDepth_())
+    Size numberOfMatchedIons_(const PeakSpectrum& th, const std::vector<PeakSpectrum>& windows_at_depth) const;
+
+    /// The 1 to 10 most intense peaks of each window (indexed by peak depth - 1), sorted by position
+    std::vector<std::vector<PeakSpectrum>> windowsByPeakDepth_(const std::vector<PeakSpectrum>& windows_top10) const;
+
     /// Computes the peptide score according to Beausoleil et al. page 1291
     double peptideScore_(const std::vector<double>& scores) const;
 
@@ -153,14 +159,21 @@ namespace OpenMS
     /// Create variant of the peptide with all phosphorylations removed
     AASequence removePhosphositesFromSequence_(const String& sequence) const;
     
-    /// Create theoretical spectra with all combinations with the number of phosphorylation events
+    /**
+        @brief Create theoretical spectra with all combinations with the number of phosphorylation events
+
+        The spectra contain the singly charged b- and y-ions (as generated by TheoreticalSpectrumGenerator with
+        default parameters). Only the masses of the residues at the phospho sites differ between permutations,
+        so the ion ladders are summed up from the residues of the sequence without phosphorylations and the
+        phosphorylated sites, instead of generating the spectrum of every permuted sequence from scratch.
+    */
     std::vector<PeakSpectrum> createTheoreticalSpectra_(const std::vector<std::vector<Size>>& permutations, const AASequence& seq_without_phospho) const;
     
     /// Pick top 10 intensity peaks for each 100 Da windows
     std::vector<PeakSpectrum> peakPickingPerWindowsInSpectrum_(PeakSpectrum& real_spectrum) const;
     
     /// Create 10 scores for each theoretical spectrum (permutation), according to Beausoleil et al. Figure 3 b
-    std::vector<std::vector<double>> calculatePermutationPeptideScores_(std::vector<PeakSpectrum>& th_spectra, const std::vector<PeakSpectrum>& windows_top10) const;
+    std::vector<std::vector<double>> calculatePermutationPeptideScores_(const std::vector<PeakSpectrum>& th_spectra, const std::vector<std::vector<PeakSpectrum>>& windows_by_depth) const;
     
     /// Rank weighted permutation scores ascending
     std::multimap<double, Size> rankWeightedPermutationPeptideScores_(const std::vector<std::vector<double>>& peptide_site_scores) const;
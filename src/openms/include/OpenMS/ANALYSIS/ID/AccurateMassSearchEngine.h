@@ -201,6 +201,11 @@ public:
     void queryByFeature(const Feature& feature, const Size& feature_index, const String& ion_mode, std::vector<AccurateMassSearchResult>& results) const;
     void queryByConsensusFeature(const ConsensusFeature& cfeat, const Size& cf_index, const Size& number_of_maps, const String& ion_mode, std::vector<AccurateMassSearchResult>& results) const;
 
+    /// Calls queryByFeature() for all features of @p fmap (in parallel); @p results has one entry per feature
+    void queryByFeatureMap(const FeatureMap& fmap, const String& ion_mode, std::vector<std::vector<AccurateMassSearchResult>>& results) const;
+    /// Calls queryByConsensusFeature() for all consensus features of @p cmap (in parallel); @p results has one entry per consensus feature
+    void queryByConsensusMap(const ConsensusMap& cmap, const String& ion_mode, std::vector<std::vector<AccurateMassSearchResult>>& results) const;
+
     /// main method of AccurateMassSearchEngine
     /// input map is not const, since it will get annotated with results
     void run(FeatureMap&, MzTab&) const;
@@ -265,9 +270,13 @@ private:
       return ion_mode_internal;
     }
 
+    typedef std::vector<std::vector<AccurateMassSearchResult> > QueryResultsTable;
+
     void parseMappingFile_(const StringList&);
     void parseStructMappingFile_(const StringList&);
     void parseAdductsFile_(const String& filename, std::vector<AdductInfo>& result);
+    /// For each adduct, flags the entries of @p mass_mappings_ which can carry it (see AdductInfo::isCompatible())
+    std::vector<std::vector<bool>> computeAdductCompatibility_(const std::vector<AdductInfo>& adducts) const;
     void searchMass_(double neutral_query_mass, double diff_mass, std::pair<Size, Size>& hit_indices) const;
 
     /// Add search results to a Consensus/Feature
@@ -276,6 +285,9 @@ private:
     /// Extract query results from feature
     std::vector<AccurateMassSearchResult> extractQueryResults_(const Feature& feature, const Size& feature_index, const String& ion_mode_internal, Size& dummy_count) const;
 
+    /// Calls extractQueryResults_() for all features of @p fmap (in parallel)
+    QueryResultsTable extractAllQueryResults_(const FeatureMap& fmap, const String& ion_mode_internal, Size& dummy_count) const;
+
     /// Add resulting matches to IdentificationData
     void addMatchesToID_(
       IdentificationData& id,
@@ -292,8 +304,6 @@ private:
 
     double computeIsotopePatternSimilarity_(const Feature& feat, const EmpiricalFormula& form) const;
 
-    typedef std::vector<std::vector<AccurateMassSearchResult> > QueryResultsTable;
-
     void exportMzTab_(const QueryResultsTable& overall_results, const Size number_of_maps, MzTab& mztab_out, const std::vector<String>& file_locations) const;
 
     void exportMzTabM_(const FeatureMap& fmap, MzTabM& mztabm_out) const;
@@ -307,9 +317,14 @@ private:
       double mass;
       std::vector<String> massIDs;
       String formula;
+      EmpiricalFormula formula_ef; ///< parsed @p formula (for adduct compatibility and isotope patterns)
     };
     std::vector<MappingEntry_> mass_mappings_;
 
+    /// [adduct index][mass_mappings_ index]: can the entry carry the adduct? (see computeAdductCompatibility_())
+    std::vector<std::vector<bool>> pos_adducts_compatible_;
+    std::vector<std::vector<bool>> neg_adducts_compatible_;
+
     struct CompareEntryAndMass_ // defined here to allow for inlining by compiler
     {
       double asMass(const MappingEntry_& v) const
@@ -247,7 +247,7 @@ namespace OpenMS
 
     Index suffix {0};        ///< which node is our suffix?
     Index first_child {0};   ///< which node contains our first child node (if tree is in BFS order)
-    // there is room for optimization here, by pulling edge labels into a separate vector (allows for SSE-enabled search of children)
+    // edge labels are mirrored in a separate, contiguous vector in ACTrie for a fast (vectorized) search of children
     AA edge {0};             ///< what is the edge label (from parent to this node)
     ChildCountType nr_children = 0; ///< number of children (if tree is in BFS order); // we could also go with a bitfield of size 22, but that would cost extra 3 bytes per node
     DepthHits depth_and_hits; ///< depth of node in the tree and one bit if a needle ends in this node or any of its suffices
@@ -378,12 +378,30 @@ namespace OpenMS
     /// I.e. similar to while(next(state)) merge(hits_all, state.hits);
     void getAllHits(ACTrieState& state) const;
 
+    /**
+      @brief Collects all hits for several independent queries (same result as calling getAllHits() for each state)
+
+      The master paths of all @p states are advanced in lockstep, one amino acid at a time.
+      Since the trie lookups of different queries do not depend on each other, their memory latency
+      overlaps, which is considerably faster than searching one query after the other for large tries.
+      Spawns (ambiguous AAs and mismatches) are processed afterwards, query by query.
+
+      @note Call ACTrieState::setQuery() on the states after they were placed into @p states (copying a state invalidates its query position).
+    */
+    void getAllHits(std::vector<ACTrieState>& states) const;
+
   private:
     /// Resume search at the last position in the query and node in the trie.
     /// If a node (or any suffices) are a hit, then @p state.hits is NOT cleared, but filled and true is returned.
     /// If the query ends and all spawns are processed, false is returned (but hits might still have changed)
     bool nextHitsNoClear_(ACTrieState& state) const;
 
+    /// Let all spawns of @p state traverse the trie until they die (adding their hits to @p state.hits)
+    void processSpawns_(ACTrieState& state) const;
+
+    /// Hint the CPU to load the data needed to leave node @p i into the cache
+    void prefetch_(const Index i) const;
+
     /// Insert a new child node into the trie (unless already present) when starting at parent node @p from and following the edge labeled @p edge.
     /// Return the index of the (new) child node.
     /// Note: This operates on the naive trie, not the BFS.
@@ -438,7 +456,16 @@ namespace OpenMS
     /// After compression (BFS trie), obtain the child with edge @p child_label from @p parent; if it does not exist, an invalid Index is returned
     Index findChildBFS_(const Index parent, const AA child_label) const;
 
+    /// nodes up to this depth get a dense transition table (at most 1 + 26 + 26^2 + 26^3 nodes, i.e. < 2 MB)
+    static constexpr uint8_t DENSE_MAX_DEPTH = 3;
+    /// alphabet of the dense transition table: all valid AAs, including '$'
+    static constexpr uint8_t DENSE_ALPHABET = AA('$')() + 1;
+
     std::vector<ACNode> trie_;  ///< the trie, in either naive structure or BFS order (after compressTrie)
+    std::vector<uint8_t> edge_labels_; ///< edge labels of the BFS trie (i.e. trie_[i].edge), children of a node are consecutive
+    /// full Aho-Corasick transitions (i.e. including suffix links) for the first @p dense_node_count_ nodes of the BFS trie (i.e. its top levels); row-major, DENSE_ALPHABET entries per node
+    std::vector<Index> dense_transitions_;
+    Index::T dense_node_count_ {0}; ///< number of nodes in @p dense_transitions_
     uint32_t needle_count_ {0}; ///< total number of needles in the trie
     uint32_t max_aaa_ {0};      ///< maximum number of ambAAs allowed
     uint32_t max_mm_ {0};       ///< maximum number of mismatches allowed
@@ -29,7 +29,8 @@ namespace OpenMS
    * - "sum"
    * - "product" (ignoring zeroes)
    * Annotation of the number of peptides used for aggregation can be disabled (see parameters).
-   * Supports multiple runs but goes through them one by one iterating over the full PeptideIdentification vector.
+   * Supports multiple runs. Runs with unique identifiers are processed in parallel, each on its own peptides.
+   * Protein accessions are interned to consecutive ids per run, so peptide scores are aggregated over flat arrays.
    */
   class OPENMS_DLLAPI BasicProteinInferenceAlgorithm :
     public DefaultParamHandler,
@@ -56,6 +57,9 @@ namespace OpenMS
      * Performs the actual inference based on best psm per peptide in @p pep_ids per run in @p prot_ids.
      * Sorts and filters psms in @p pep_ids. Annotates results in @p prot_ids.
      * Associations (via getIdentifier) for peptides to protein runs need to be correct.
+     * If the identifiers of the runs are unique, the peptides are partitioned by run and the runs are processed in parallel
+     * (the order of @p pep_ids is preserved).
+     * @throw Exception::InvalidParameter if the peptides have differing score types
      */
     void run(std::vector<PeptideIdentification>& pep_ids, std::vector<ProteinIdentification>& prot_ids) const;
 
@@ -77,23 +81,45 @@ namespace OpenMS
 
   private:
 
+    /// The protein hits of a run with their accessions interned to consecutive ids
+    struct ProteinIndex_
+    {
+      /// accession to id (if an accession occurs repeatedly, the id of its last hit)
+      std::unordered_map<std::string, Size> acc_to_id;
+      /// protein hit per id
+      std::vector<ProteinHit*> hits;
+
+      /// interns the accession of @p hit (re-pointing the id of an accession seen before to @p hit)
+      void insert(ProteinHit& hit)
+      {
+        auto it = acc_to_id.emplace(hit.getAccession(), hits.size());
+        if (it.second)
+        {
+          hits.push_back(&hit);
+        }
+        else
+        {
+          hits[it.first->second] = &hit;
+        }
+      }
+    };
+
     /**
      * @brief Performs simple aggregation-based inference on one protein run.
-     * @param acc_to_protein_hitP_and_count Maps Accessions to a pair of ProteinHit pointers
-     *  and number of peptidoforms encountered
-     * @param best_pep Maps (un)modified peptide sequence to a map from charge (0 when unconsidered) to the
-     *  best PeptideHit pointer
      * @param prot_run The current run to process
      * @param pep_ids Peptides for the current run to process
+     * @param overall_score_type the score type of all peptides (usually the one of the first peptide)
+     * @param higher_better if for this score type higher is better
      */
     void processRun_(
-      std::unordered_map<std::string, std::pair<ProteinHit*, Size>>& acc_to_protein_hitP_and_count,
-      SequenceToChargeToPSM& best_pep,
       ProteinIdentification& prot_run,
-      std::vector<PeptideIdentification>& pep_ids) const;
+      std::vector<PeptideIdentification>& pep_ids,
+      const String& overall_score_type,
+      bool higher_better) const;
 
     /**
      * @brief fills and updates the map of best peptide scores @p best_pep (by sequence or modified sequence, depending on algorithm settings)
+     * The lookup keys of the spectra are computed in parallel, the map is updated in the order of @p pep_ids.
      * @param best_pep (mod.) sequence to charge to pointer of best PSM (PeptideHit*)
      * @param pep_ids the spectra with PSMs
      * @param overall_score_type the pre-determined type name to raise an error if mixed types occur
@@ -102,7 +128,7 @@ namespace OpenMS
      */
     void aggregatePeptideScores_(
         SequenceToChargeToPSM& best_pep,
-        std::vector<PeptideIdentification>& pep_ids,
+        const std::vector<PeptideIdentification*>& pep_ids,
         const String& overall_score_type,
         bool higher_better,
         const std::string& run_id) const;
@@ -110,13 +136,13 @@ namespace OpenMS
     /**
      * @brief aggregates and updates protein scores based on aggregation settings and aggregated peptide level results in
      * prefilled @p best_pep
-     * @param acc_to_protein_hitP_and_count the results to fill
+     * @param proteins the interned protein hits whose scores (and number of found peptides) are updated
      * @param best_pep best psm per peptide to read the score
      * @param pep_scores if the score is a posterior error probability -> Auto-converts to posterior probability
      * @param higher_better if for the score higher is better. Assume score is unconverted.
      */
     void updateProteinScores_(
-        std::unordered_map<std::string, std::pair<ProteinHit*, Size>>& acc_to_protein_hitP_and_count,
+        const ProteinIndex_& proteins,
         const SequenceToChargeToPSM& best_pep,
         bool pep_scores,
         bool higher_better) const;
@@ -11,6 +11,8 @@
 #include <OpenMS/ANALYSIS/ID/ConsensusIDAlgorithmSimilarity.h>
 #include <OpenMS/ANALYSIS/SEQUENCE/NeedlemanWunsch.h>
 
+#include <unordered_map>
+
 namespace OpenMS
 {
   /**
@@ -35,6 +37,12 @@ namespace OpenMS
     /// object for alignment score calculation
     NeedlemanWunsch alignment_;
 
+    /// Cache for alignment scores of unmodified sequences with themselves (used for normalization)
+    std::unordered_map<String, double> self_alignment_scores_;
+
+    /// Alignment score of an unmodified sequence with itself (cached)
+    double getSelfAlignmentScore_(const String& unmod_seq);
+
     /// Not implemented
     ConsensusIDAlgorithmPEPMatrix(const ConsensusIDAlgorithmPEPMatrix&);
 
@@ -13,8 +13,12 @@
 #include <OpenMS/FORMAT/MzTabM.h>
 #include <OpenMS/FORMAT/MzTabFile.h>
 
+#include <memory>
+
 namespace OpenMS
 {
+  class AccurateMassSearchEngine;
+
   /**
     @brief Data processing for FIA-MS data
     
@@ -82,7 +86,10 @@ public:
 
       The bin size for summing the intensities is defined as mz / (resolution*4) 
       for all the mzs taken with the @p bin_step defined in the parameters.
-      Uses `SpectrumAddition::addUpSpectra` function with the sliding bin size parameter. 
+      Gives the same result as `SpectrumAddition::addUpSpectra` with the sliding bin size parameter,
+      restricted to each window of the sliding bin. Only the raster points inside a window are computed
+      (from the points of each spectrum next to the window), so the memory needed does not depend on
+      the m/z range of the spectra. The windows are merged in parallel.
 
       @param input  Input vector of spectra
       @return a spectrum
@@ -127,6 +134,25 @@ public:
     */
     void runAccurateMassSearch(FeatureMap& input, OpenMS::MzTab& output);
 
+    /**
+      @brief Get the parameters of the `AccurateMassSearchEngine` used by runAccurateMassSearch()
+    */
+    Param getAccurateMassSearchParameters() const;
+
+    /**
+      @brief Set the initialized `AccurateMassSearchEngine` used by runAccurateMassSearch()
+
+      `AccurateMassSearchEngine::run` does not modify the engine, so one engine (and its database)
+      can be shared by several data processors, also running concurrently (see FIAMSScheduler).
+      Without an engine, runAccurateMassSearch() initializes one on its first call and keeps it.
+      Changing the parameters of the data processor drops the engine.
+
+      @param engine  An engine initialized with getAccurateMassSearchParameters()
+
+      @throw Exception::IllegalArgument if the parameters of @p engine differ from getAccurateMassSearchParameters()
+    */
+    void setAccurateMassSearchEngine(std::shared_ptr<const AccurateMassSearchEngine> engine);
+
     /**
       @brief Get mass-to-charge ratios to base the summing the spectra along the time axis upon
     */
@@ -146,9 +172,16 @@ private:
     */
     void storeSpectrum_(const MSSpectrum& input, const String& filename);
 
+    /**
+      @brief Implementation of mergeAlongTime() on spectra which are not copied
+    */
+    MSSpectrum mergeAlongTime_(const std::vector<const MSSpectrum*>& input) const;
+
     std::vector<float> mzs_; 
     std::vector<float> bin_sizes_;
     SavitzkyGolayFilter sgfilter_;
     PeakPickerHiRes picker_;
+    /// The (shared, read-only) accurate mass search engine
+    std::shared_ptr<const AccurateMassSearchEngine> ams_;
   };
 } // namespace OpenMS
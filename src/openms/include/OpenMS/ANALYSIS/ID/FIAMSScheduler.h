@@ -53,6 +53,9 @@ public:
 
     /**
       @brief Run the FIA-MS data analysis for the batch defined in the @p filename_
+
+      The samples are processed in parallel. Samples with the same accurate mass search settings
+      (databases, adducts and resolution) share one `AccurateMassSearchEngine`, which is initialized once.
     */
     void run();
 
@@ -14,6 +14,8 @@
 #include <OpenMS/METADATA/ProteinIdentification.h>
 #include <OpenMS/KERNEL/ConsensusMap.h>
 
+#include <boost/container/flat_map.hpp>
+
 #include <unordered_map>
 
 #include <vector>
@@ -220,7 +222,7 @@ private:
     FalseDiscoveryRate& operator=(const FalseDiscoveryRate&);
 
     /// calculates the FDR, given two vectors of scores
-    void calculateFDRs_(std::map<double, double>& score_to_fdr, std::vector<double>& target_scores, std::vector<double>& decoy_scores, bool q_value, bool higher_score_better) const;
+    void calculateFDRs_(boost::container::flat_map<double, double>& score_to_fdr, std::vector<double>& target_scores, std::vector<double>& decoy_scores, bool q_value, bool higher_score_better) const;
 
     /// Helper function for applyToObservationMatches()
     void handleObservationMatch_(
@@ -233,7 +235,7 @@ private:
 
     /// calculates an estimated FDR (based on P(E)Ps) given a vector of score value pairs and fills a map for lookup
     /// in scores_to_FDR
-    void calculateEstimatedQVal_(std::map<double, double> &scores_to_FDR,
+    void calculateEstimatedQVal_(boost::container::flat_map<double, double> &scores_to_FDR,
                                  ScoreToTgtDecLabelPairs &scores_labels,
                                  bool higher_score_better) const;
 
@@ -242,7 +244,7 @@ private:
     /// this score as it goes. Q-values are optionally annotated by calculating the cumulative minimum in reversed
     /// order afterwards. Since I never understood our other algorithm, I can not explain the difference.
     /// @note Formula used depends on Param "conservative": false -> (D+1)/T, true (e.g. used in Fido) -> (D+1)/(T+D)
-    void calculateFDRBasic_(std::map<double,double>& scores_to_FDR, ScoreToTgtDecLabelPairs& scores_labels, bool qvalue, bool higher_score_better) const;
+    void calculateFDRBasic_(boost::container::flat_map<double, double>& scores_to_FDR, ScoreToTgtDecLabelPairs& scores_labels, bool qvalue, bool higher_score_better) const;
 
     /// calculates the error area around the x=x line between two consecutive values of expected and actual
     /// i.e. it assumes exp2 > exp1
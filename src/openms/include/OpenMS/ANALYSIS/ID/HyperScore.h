@@ -58,6 +58,14 @@ struct OPENMS_DLLAPI HyperScore
                         PSMDetail& d
                        );
 
+  /** @brief compute the (ln transformed) X!Tandem HyperScore from already matched peaks
+   *  (e.g. found by fragment ion index lookups)
+   * @param matched_b_ions number of matched b-ions
+   * @param matched_y_ions number of matched y-ions
+   * @param dot_product sum of the intensity products of all matched peaks
+   */
+  static double computeFromMatches(size_t matched_b_ions, size_t matched_y_ions, double dot_product);
+
   private:
     /// helper to compute the log factorial
     static double logfactorial_(const int x, int base = 2);
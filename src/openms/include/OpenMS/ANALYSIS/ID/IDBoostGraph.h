@@ -18,6 +18,7 @@
 #include <OpenMS/METADATA/ProteinIdentification.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
 
+#include <limits>
 #include <vector>
 #include <unordered_map>
 #include <queue>
@@ -115,6 +116,10 @@ namespace OpenMS
       template < typename Vertex, typename Graph >
       void start_vertex(Vertex u, const Graph & tg)
       {
+        if (m.empty())
+        {
+          m.resize(boost::num_vertices(tg), unmapped);
+        }
         gs.emplace_back();
         next_v = boost::add_vertex(tg[u], gs.back());
         m[u] = next_v;
@@ -129,7 +134,7 @@ namespace OpenMS
       template < typename Edge, typename Graph >
       void examine_edge(Edge e, const Graph & tg)
       {
-        if (m.find(e.m_target) == m.end())
+        if (m[e.m_target] == unmapped)
         {
           next_v = boost::add_vertex(tg[e.m_target], gs.back());
           m[e.m_target] = next_v;
@@ -145,7 +150,10 @@ namespace OpenMS
       Graphs& gs;
       vertex_t curr_v, next_v;
       /// A mapping from old node id to new node id to not duplicate existing ones in the new graph
-      std::map<vertex_t, vertex_t> m;
+      /// (vertices are consecutive indices, so a flat vector indexed by old id suffices)
+      std::vector<vertex_t> m;
+      /// Marks vertices that were not copied yet
+      static constexpr vertex_t unmapped = std::numeric_limits<vertex_t>::max();
     };
 
     ///@brief Visits nodes in the boost graph (ptrs to an ID Object) and depending on their type creates a label
@@ -357,7 +365,12 @@ namespace OpenMS
     // although we usually do long-running tasks per CC such that the extra virtual call does not matter much
     // Instead we gain type erasure.
     /// Do sth on connected components (your functor object has to inherit from std::function or be a lambda)
+    /// The components are processed in parallel, largest first (the index passed to the functor is the one of the component)
     void applyFunctorOnCCs(const std::function<unsigned long(Graph&, unsigned int)>& functor);
+    /// Do sth on connected components with several functors (e.g. one per parameter set). All pairs of functor and
+    /// component are processed in parallel (largest components first), so the functors are called concurrently on the
+    /// same component and must not modify the graph or other shared state.
+    void applyFunctorsOnCCs(const std::vector<std::function<unsigned long(Graph&, unsigned int)>>& functors);
     /// Do sth on connected components single threaded (your functor object has to inherit from std::function or be a lambda)
     void applyFunctorOnCCsST(const std::function<void(Graph&)>& functor);
 
@@ -510,6 +523,9 @@ namespace OpenMS
     /// helper function to add a vertex if it is not present yet, otherwise return the present one
     /// needs a temporary filled vertex_map that is modifiable
     vertex_t addVertexWithLookup_(const IDPointer& ptr, std::unordered_map<IDPointer, vertex_t, boost::hash<IDPointer>>& vertex_map);
+
+    /// indices of the connected components, sorted by decreasing size (nr. of vertices + edges)
+    std::vector<int> getCCsBySize_() const;
     //vertex_t addVertexWithLookup_(IDPointerConst& ptr, std::unordered_map<IDPointerConst, vertex_t, boost::hash<IDPointerConst>>& vertex_map);
 
 
@@ -101,6 +101,15 @@ namespace OpenMS
         bool annotate_origin
     );
 
+    /// updates the references in @p pid to the new protein ID run (thread-safe)
+    /// @return false if the run of @p pid is not in @p runID_to_runIdx (i.e. @p pid is not merged)
+    bool updatePepID_(
+        PeptideIdentification& pid,
+        const std::map<String, Size>& runID_to_runIdx,
+        const std::vector<StringList>& originFiles,
+        bool annotate_origin
+    ) const;
+
 
     void movePepIDsAndRefProteinsToResultFaster_(
         std::vector<PeptideIdentification>&& pepIDs,
@@ -10,6 +10,7 @@
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <OpenMS/METADATA/ProteinIdentification.h>
+#include <functional>
 #include <unordered_map>
 
 
@@ -94,6 +95,11 @@ public:
         /// Constructs a new RipFileContent object
         RipFileContent(const std::vector<ProteinIdentification>& prot_idents, const std::vector<PeptideIdentification>& pep_idents)
             : prot_idents(prot_idents), pep_idents(pep_idents) {}
+
+        /// Constructs a new RipFileContent object, taking over the identifications
+        RipFileContent(std::vector<ProteinIdentification>&& prot_idents, std::vector<PeptideIdentification>&& pep_idents)
+            : prot_idents(std::move(prot_idents)), pep_idents(std::move(pep_idents)) {}
+
         /// Get protein identifications
         const std::vector<ProteinIdentification> & getProteinIdentifications();
         /// Get peptide identifications
@@ -103,6 +109,9 @@ public:
     /// Represents the result of an IDRipper process, a map assigning file content to output file identifiers
     typedef std::map<RipFileIdentifier, RipFileContent, RipFileIdentifierIdxComparator> RipFileMap;
 
+    /// Receives the content of one output file of rip() (and may take it over)
+    typedef std::function<void(const RipFileIdentifier&, RipFileContent&&)> RipFileConsumer;
+
     /// Default constructor
     IDRipper();
 
@@ -115,7 +124,7 @@ public:
       Iteration over all @p peptides. For each annotated file origin create a map entry and store the
       respective @p peptides and @p proteins.
 
-      @param ripped Contains the protein identification and peptide identification for each file origin annotated in proteins and peptides
+      @param ripped Contains the protein identification and peptide identification for each file origin annotated in proteins and peptides (cleared first)
       @param proteins Protein identification
       @param peptides Peptide identification annotated with file origin
       @param numeric_filenames If false, deduce output files using basenames of origin annotations. Throws an exception if they are not unique. If true, assemble output files based on numerical IDs only.
@@ -150,6 +159,28 @@ public:
             bool numeric_filenames,
             bool split_ident_runs);
 
+    /**
+      @brief Ripping protein/peptide identification according their file origin, streaming the output files
+
+      Same as rip(RipFileMap&, ...), but the content of each output file is assembled and passed to @p consumer
+      (e.g. a writer) one file at a time, in the order of the RipFileMap, instead of collecting all of them in a map.
+      The peptide identifications are moved out of @p peptides (which is cleared) instead of being copied, so
+      only the input and one output file are held in memory at a time.
+
+      @param consumer Called once per output file
+      @param proteins Protein identification
+      @param peptides Peptide identification annotated with file origin (cleared)
+      @param numeric_filenames If false, deduce output files using basenames of origin annotations. Throws an exception if they are not unique. If true, assemble output files based on numerical IDs only.
+      @param split_ident_runs Split identification runs into different files.
+    */
+    void rip(
+            const RipFileConsumer& consumer,
+            std::vector<ProteinIdentification>& proteins,
+            std::vector<PeptideIdentification>& peptides,
+            bool numeric_filenames,
+            bool split_ident_runs);
+
+
 private:
     // Not implemented
     /// Copy constructor
@@ -161,8 +192,6 @@ private:
 
     /// helper function, detects file origin annotation standard from collections of protein and peptide hits
     OriginAnnotationFormat detectOriginAnnotationFormat_(std::map<String, UInt> & file_origin_map, const std::vector<PeptideIdentification> & peptide_idents);
-    /// helper function, extracts all protein hits that match the protein accession
-    void getProteinHits_(std::vector<ProteinHit> & result, const std::unordered_map<String, const ProteinHit*> & acc2protein_hits, const std::set<String> & protein_accessions);
     /// helper function, returns the string representation of the peptide hit accession
     std::set<String> getProteinAccessions_(const std::vector<PeptideHit> & peptide_hits);
     /// helper function, returns the index of the protein identification for the given peptide identification based on the same identifier using id_runs as lookup
@@ -171,6 +200,10 @@ private:
     bool registerBasename_(std::map<String, std::pair<UInt, UInt> >& basename_to_numeric, const IDRipper::RipFileIdentifier& rfi);
     /// helper function, sets the value of mode to new_value and returns true if the old value was identical or unset (-1)
     bool setOriginAnnotationMode_(short& mode, short const new_value);
+
+    /// implementation of rip(): passes each output file to @p consumer; moves the peptide identifications out of @p peptides if @p move_peptides is set, otherwise copies them
+    void rip_(const RipFileConsumer& consumer, std::vector<ProteinIdentification>& proteins, std::vector<PeptideIdentification>& peptides, bool numeric_filenames, bool split_ident_runs,
+              bool move_peptides);
   };
 
 } // namespace OpenMS
@@ -14,6 +14,8 @@
 #include <OpenMS/METADATA/ProteinIdentification.h>
 #include <OpenMS/KERNEL/ConsensusMap.h>
 
+#include <boost/container/flat_map.hpp>
+
 #include <vector>
 #include <unordered_set>
 #include <unordered_map>
@@ -33,6 +35,10 @@ namespace OpenMS
     using Base::Base;
   };
 
+  /// Lookup from a score to its FDR/q-value, sorted by score.
+  /// Stored as one contiguous array (lookups are binary searches); fill it in sorted order.
+  using ScoreToFDRMap = boost::container::flat_map<double, double>;
+
   /**
    * @brief A class for extracting and reinserting IDScores from Peptide/ProteinIdentifications and from ConsensusMaps
    */
@@ -257,7 +263,7 @@ namespace OpenMS
      */
 
     template<typename IDType, class ...Args>
-    static void setScores_(const std::map<double, double> &scores_to_FDR,
+    static void setScores_(const ScoreToFDRMap &scores_to_FDR,
                     std::vector<IDType> &ids,
                     const std::string &score_type,
                     bool higher_better,
@@ -280,7 +286,7 @@ namespace OpenMS
     }
 
     template<typename IDType>
-    static void setScores_(const std::map<double, double> &scores_to_FDR, IDType &id, const std::string &score_type,
+    static void setScores_(const ScoreToFDRMap &scores_to_FDR, IDType &id, const std::string &score_type,
                     bool higher_better, bool keep_decoy)
     {
       bool old_higher_better = id.isHigherScoreBetter();
@@ -311,7 +317,7 @@ namespace OpenMS
     }
 
     template<typename IDType>
-    static void setScores_(const std::map<double, double> &scores_to_FDR, IDType &id,
+    static void setScores_(const ScoreToFDRMap &scores_to_FDR, IDType &id,
                     const String &old_score_type)
     {
       std::vector<typename IDType::HitType> &hits = id.getHits();
@@ -322,7 +328,7 @@ namespace OpenMS
     }
 
     template<typename IDType>
-    static void setScoresHigherWorse_(const std::map<double, double> &scores_to_FDR, IDType &id,
+    static void setScoresHigherWorse_(const ScoreToFDRMap &scores_to_FDR, IDType &id,
                            const String &old_score_type)
     {
       std::vector<typename IDType::HitType> &hits = id.getHits();
@@ -333,7 +339,7 @@ namespace OpenMS
     }
 
     template<typename IDType, class ...Args>
-    static void setScoresAndRemoveDecoys_(const std::map<double, double> &scores_to_FDR, IDType &id,
+    static void setScoresAndRemoveDecoys_(const ScoreToFDRMap &scores_to_FDR, IDType &id,
                                    const String &old_score_type, Args&& ... args)
     {
       std::vector<typename IDType::HitType> &hits = id.getHits();
@@ -347,7 +353,7 @@ namespace OpenMS
     }
 
     template<typename IDType, class ...Args>
-    static void setScoresHigherWorseAndRemoveDecoys_(const std::map<double, double> &scores_to_FDR, IDType &id,
+    static void setScoresHigherWorseAndRemoveDecoys_(const ScoreToFDRMap &scores_to_FDR, IDType &id,
                                           const String &old_score_type, Args&& ... args)
     {
       std::vector<typename IDType::HitType> &hits = id.getHits();
@@ -361,14 +367,14 @@ namespace OpenMS
     }
 
     template<typename HitType>
-    static void setScore_(const std::map<double, double> &scores_to_FDR, HitType &hit, const std::string &old_score_type)
+    static void setScore_(const ScoreToFDRMap &scores_to_FDR, HitType &hit, const std::string &old_score_type)
     {
       hit.setMetaValue(old_score_type, hit.getScore());
       hit.setScore(scores_to_FDR.lower_bound(hit.getScore())->second);
     }
 
     template<typename HitType>
-    static void setScoreHigherWorse_(const std::map<double, double> &scores_to_FDR, HitType &hit, const std::string &old_score_type)
+    static void setScoreHigherWorse_(const ScoreToFDRMap &scores_to_FDR, HitType &hit, const std::string &old_score_type)
     {
       hit.setMetaValue(old_score_type, hit.getScore());
       auto ub = scores_to_FDR.upper_bound(hit.getScore());
@@ -377,7 +383,7 @@ namespace OpenMS
     }
 
     /*template<typename IDType>
-    static void setScores_(const std::map<double, double> &scores_to_FDR, IDType &id, const std::string &score_type,
+    static void setScores_(const ScoreToFDRMap &scores_to_FDR, IDType &id, const std::string &score_type,
                     bool higher_better)
     {
       bool old_higher_better = id.isHigherScoreBetter();
@@ -385,7 +391,7 @@ namespace OpenMS
       setScores_(scores_to_FDR, id, old_score_type, old_higher_better);
     }*/
 
-    static void setScores_(const std::map<double, double> &scores_to_FDR,
+    static void setScores_(const ScoreToFDRMap &scores_to_FDR,
                     PeptideIdentification &id,
                     const std::string &score_type,
                     bool higher_better,
@@ -403,7 +409,7 @@ namespace OpenMS
       }
     }
 
-    static void setScores_(const std::map<double, double> &scores_to_FDR,
+    static void setScores_(const ScoreToFDRMap &scores_to_FDR,
                     PeptideIdentification &id,
                     const std::string &score_type,
                     bool higher_better,
@@ -418,7 +424,7 @@ namespace OpenMS
     }
 
     template<typename IDType>
-    static void setScores_(const std::map<double, double> &scores_to_FDR, IDType &id, const std::string &score_type,
+    static void setScores_(const ScoreToFDRMap &scores_to_FDR, IDType &id, const std::string &score_type,
                     bool higher_better, bool keep_decoy, const String &identifier)
     {
       if (id.getIdentifier() == identifier)
@@ -427,7 +433,7 @@ namespace OpenMS
       }
     }
 
-    static void setScores_(const std::map<double, double> &scores_to_FDR,
+    static void setScores_(const ScoreToFDRMap &scores_to_FDR,
                     PeptideIdentification &id,
                     const std::string &score_type,
                     bool higher_better,
@@ -441,7 +447,7 @@ namespace OpenMS
     }
 
     template<typename IDType>
-    static void setScores_(const std::map<double, double> &scores_to_FDR, IDType &id, const std::string &score_type,
+    static void setScores_(const ScoreToFDRMap &scores_to_FDR, IDType &id, const std::string &score_type,
                     bool higher_better, const String &identifier)
     {
       if (id.getIdentifier() == identifier)
@@ -451,7 +457,7 @@ namespace OpenMS
     }
 
     template<typename IDType>
-    static void setScores_(const std::map<double, double> &scores_to_FDR, IDType &id, const std::string &score_type,
+    static void setScores_(const ScoreToFDRMap &scores_to_FDR, IDType &id, const std::string &score_type,
                            bool higher_better, int charge)
     {
       for (auto& hit : id.getHits())
@@ -472,7 +478,7 @@ namespace OpenMS
 
     //TODO could also get a keep_decoy flag when we define what a "decoy group" is -> keep all always for now
     static void setScores_(
-        const std::map<double, double> &scores_to_FDR,
+        const ScoreToFDRMap &scores_to_FDR,
         std::vector<ProteinIdentification::ProteinGroup> &grps,
         const std::string &score_type,
         bool higher_better);
@@ -488,7 +494,7 @@ namespace OpenMS
      * @param new_hits where to move if target (i.e. target or target+decoy)
      */
     template<typename HitType>
-    static void setScoreAndMoveIfTarget_(const std::map<double, double> &scores_to_FDR,
+    static void setScoreAndMoveIfTarget_(const ScoreToFDRMap &scores_to_FDR,
                                   HitType &hit,
                                   const std::string &old_score_type,
                                   std::vector<HitType> &new_hits)
@@ -503,7 +509,7 @@ namespace OpenMS
     }
 
     template<typename HitType>
-    static void setScoreHigherWorseAndMoveIfTarget_(const std::map<double, double> &scores_to_FDR,
+    static void setScoreHigherWorseAndMoveIfTarget_(const ScoreToFDRMap &scores_to_FDR,
                                          HitType &hit,
                                          const std::string &old_score_type,
                                          std::vector<HitType> &new_hits)
@@ -528,7 +534,7 @@ namespace OpenMS
     * @param new_hits where to move if target (i.e. target or target+decoy)
     * @param charge If only peptides with charge X are currently considered
     */
-    static void setScoreAndMoveIfTarget_(const std::map<double, double> &scores_to_FDR,
+    static void setScoreAndMoveIfTarget_(const ScoreToFDRMap &scores_to_FDR,
                                   PeptideHit &hit,
                                   const std::string &old_score_type,
                                   std::vector<PeptideHit> &new_hits,
@@ -562,7 +568,7 @@ namespace OpenMS
      * @param args optional additional arguments (int charge, string run ID)
     */
     template<class ...Args>
-    static void setPeptideScoresForMap_(const std::map<double, double>& scores_to_FDR,
+    static void setPeptideScoresForMap_(const ScoreToFDRMap& scores_to_FDR,
                                  ConsensusMap& cmap,
                                  bool include_unassigned_peptides,
                                  const std::string& score_type,
@@ -33,13 +33,25 @@ namespace OpenMS
     /// if we do per charge state fitting) or empirically estimated from the input PSMs
     std::map<int, double> chgLLhoods = {{1, 0.7}, {2, 0.9}, {3, 0.7}, {4, 0.5}, {5, 0.5}};
 
+    /// notConditionalGivenSum() for the first few numbers of parents, computed on demand and reused
+    /// for all factors of this factory (peptides mostly have few parent proteins)
+    std::vector<double> notConditionalGivenSumCache_;
+
     /// to fill the noisy-OR table for a peptide given parent proteins
-    /// TODO pre-compute for like a hundred parent proteins
     /// TODO introduce special case for alpha or beta = 1. The log formula does not work otherwise.
     inline double notConditionalGivenSum(unsigned long summ) {
+      if (summ < notConditionalGivenSumCache_.size())
+      {
+        return notConditionalGivenSumCache_[summ];
+      }
       // use log for better precision
-      return std::pow(2., log2(1. - beta_) + summ * log2(1. - alpha_));
+      double result = std::pow(2., log2(1. - beta_) + summ * log2(1. - alpha_));
       //return std::pow((1.0 - alpha_), summ) * (1.0 - beta_); // standard way
+      if (summ == notConditionalGivenSumCache_.size() && summ < 128)
+      {
+        notConditionalGivenSumCache_.push_back(result);
+      }
+      return result;
     }
 
   public:
@@ -14,6 +14,7 @@
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <vector>
 #include <set>
+#include <unordered_map>
 
 namespace OpenMS
 {
@@ -72,10 +73,18 @@ namespace OpenMS
     /** represents the middle layer of an implicit tripartite graph:
     consists of single protein accessions and their mapping to the (indist.)
     group's indices */
-    std::map<String, Size> prot_acc_to_indist_prot_grp_;
+    std::unordered_map<std::string, Size> prot_acc_to_indist_prot_grp_;
     
     /// log debug information?
     bool statistics_;
+
+    /// Resolves @p conn_comp like resolveConnectedComponent() but returns its ambiguity group in @p ambiguity_grp
+    /// instead of inserting it into @p protein (returns false for singleton components, which get no group).
+    /// Only touches the peptides and graph entries of @p conn_comp, so disjoint components can be resolved concurrently.
+    bool resolveConnectedComponent_(ConnectedComponent& conn_comp,
+                                    const ProteinIdentification& protein,
+                                    std::vector<PeptideIdentification>& peptides,
+                                    ProteinIdentification::ProteinGroup& ambiguity_grp);
     
   public:
     /// Constructor
@@ -90,6 +99,7 @@ namespace OpenMS
     /// @param resolve_ties If ties should be resolved or multiple best groups reported
     /// @param targets_first If target groups should get picked first no matter the posterior
     /// @todo warning: all peptides are used (not filtered for matching protein ID run yet).
+    /// The peptides are resolved in parallel.
     static void resolve(ProteinIdentification& protein,
                         std::vector<PeptideIdentification>& peptides,
                         bool resolve_ties,
@@ -115,6 +125,8 @@ namespace OpenMS
     /// Applies resolveConnectedComponent to every component of the graph and
     /// is able to write statistics when specified. Parameters will
     /// both be mutated in this method.
+    /// The components are collected first and then resolved in parallel; their ambiguity
+    /// groups are added in the order of the components (by their first protein group).
     /// @param protein ProteinIdentification object storing IDs and groups
     /// @param peptides vector of ProteinIdentifications with links to the proteins
     /// @todo warning: all peptides are used (not filtered for matching protein ID run yet).
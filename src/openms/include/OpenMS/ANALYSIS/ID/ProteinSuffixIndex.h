@@ -0,0 +1,98 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/FORMAT/FASTAFile.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief A persistent suffix array over a protein database for exact peptide-to-protein lookups
+
+    All protein sequences are concatenated (upper case, separated by '$', optionally with I replaced by L)
+    and all suffixes of the resulting text are sorted. A peptide is then found by binary search in
+    O(|peptide| * log(N)), independent of the number of peptides or proteins, and the index can be
+    stored to and loaded from a binary file, so it is built only once per protein database.
+
+    Building the index takes O(N log^2(N)) time (prefix doubling) and 12 bytes per residue of temporary
+    memory; the index itself needs about 5 bytes per residue. The database is limited to 2^32 - 1 residues.
+
+    @note The index only supports exact matches (no ambiguous amino acids or mismatches, see ACTrie for that).
+    The index files use the byte order of the machine they were written on.
+
+    @ingroup Analysis_ID
+  */
+  class OPENMS_DLLAPI ProteinSuffixIndex
+  {
+  public:
+    /// Position of a peptide in the database
+    struct Occurrence
+    {
+      uint32_t protein_index; ///< index of the protein (order as passed to build())
+      uint32_t position;      ///< start of the peptide in the protein sequence
+      bool operator==(const Occurrence& rhs) const
+      {
+        return protein_index == rhs.protein_index && position == rhs.position;
+      }
+    };
+
+    /// Default constructor (an empty index)
+    ProteinSuffixIndex() = default;
+
+    /**
+      @brief Builds the index for @p proteins
+
+      @param proteins Protein database
+      @param IL_equivalent Treat isoleucine and leucine as equal (when building and when searching)
+      @throw Exception::InvalidValue if the database has more than 2^32 - 1 residues
+    */
+    void build(const std::vector<FASTAFile::FASTAEntry>& proteins, bool IL_equivalent = true);
+
+    /// Stores the index in a binary file
+    /// @throw Exception::UnableToCreateFile if @p filename cannot be written
+    void store(const String& filename) const;
+
+    /// Loads an index from a binary file written by store()
+    /// @throw Exception::FileNotFound if @p filename does not exist
+    /// @throw Exception::ParseError if @p filename is not a valid index file
+    void load(const String& filename);
+
+    /// All occurrences of @p peptide (sorted by protein and position); empty for an empty peptide
+    std::vector<Occurrence> findPeptide(const String& peptide) const;
+
+    /// Number of occurrences of @p peptide in the database (faster than findPeptide().size())
+    Size countOccurrences(const String& peptide) const;
+
+    /// Number of proteins in the index
+    Size getNumberOfProteins() const;
+
+    /// Accession of protein @p index
+    const String& getAccession(Size index) const;
+
+    /// Are isoleucine and leucine treated as equal?
+    bool isILEquivalent() const;
+
+  protected:
+    /// Normalizes a sequence like the indexed text (upper case, I to L if requested)
+    std::string normalize_(const String& sequence) const;
+
+    /// Range of @p suffix_array_ of all suffixes starting with @p peptide (normalized)
+    std::pair<Size, Size> findRange_(const std::string& peptide) const;
+
+    std::string text_;                      ///< concatenated, normalized proteins, each one followed by '$'
+    std::vector<uint32_t> suffix_array_;    ///< start positions of all suffixes of @p text_, lexicographically sorted
+    std::vector<uint32_t> protein_starts_;  ///< start of each protein in @p text_
+    std::vector<String> accessions_;        ///< accession of each protein
+    bool IL_equivalent_ = true;             ///< treat I and L as equal
+  };
+}
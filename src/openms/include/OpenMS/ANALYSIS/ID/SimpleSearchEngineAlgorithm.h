@@ -64,6 +64,41 @@ class OPENMS_DLLAPI SimpleSearchEngineAlgorithm :
       }
     };
 
+    /// Candidate peptide with its b- and y-ion m/z (charge 1) for the fragment ion index
+    struct IndexedCandidate_
+    {
+      StringView sequence;
+      SignedSize peptide_mod_index; ///< enumeration index of the non-RNA peptide modification
+      double mass = 0; ///< monoisotopic mass
+      std::vector<double> fragment_mz; ///< b-ions followed by y-ions
+      Size nr_prefix_ions = 0; ///< number of b-ions in fragment_mz
+
+      static bool hasSmallerMass(const IndexedCandidate_& a, const IndexedCandidate_& b)
+      {
+        if (a.mass != b.mass) return a.mass < b.mass;
+        if (b.peptide_mod_index != a.peptide_mod_index) return a.peptide_mod_index < b.peptide_mod_index;
+        return a.sequence < b.sequence;
+      }
+    };
+
+    /// Entry of the fragment ion index
+    struct IndexedFragment_
+    {
+      double mz; ///< theoretical m/z
+      UInt32 candidate; ///< index of the candidate (sorted by mass)
+      bool is_prefix; ///< b-ion (or y-ion)
+    };
+
+    /// @brief score all spectra against all @p candidates using an inverted index of their fragments
+    /// Each spectrum peak is looked up in the index (only candidates in the precursor windows of the spectrum are considered),
+    /// instead of matching the theoretical spectrum of each candidate against all spectra in its precursor window.
+    void scoreFragmentIndex_(const PeakMap& spectra,
+      const std::vector<std::vector<double> >& precursor_masses,
+      std::vector<IndexedCandidate_>& candidates,
+      std::vector<std::vector<AnnotatedHit_> >& annotated_hits,
+      bool precursor_mass_tolerance_unit_ppm,
+      bool fragment_mass_tolerance_unit_ppm) const;
+
     /// @brief filter, deisotope, decharge spectra
     static void preprocessSpectra_(PeakMap& exp, double fragment_mass_tolerance, bool fragment_mass_tolerance_unit_ppm);
 
@@ -120,6 +155,8 @@ class OPENMS_DLLAPI SimpleSearchEngineAlgorithm :
     String peptide_motif_;
 
     Size report_top_hits_;
+
+    bool fragment_index_;
 };
 
 } // namespace
@@ -123,7 +123,7 @@ public:
     @param file_index: file index (to differentiate entries derived from different mzML files and resolve ambiguities)
     */
 
-    static void writeMsFile_(std::ofstream& os,
+    static void writeMsFile_(std::ostream& os,
                              const MSExperiment& spectra,
                              const std::vector<size_t>& ms2_spectra_index,
                              const SiriusMSFile::AccessionInfo& ainfo,
@@ -36,6 +36,7 @@ MetaboliteSpectralMatching.h
 MorpheusScore.h
 NeighborSeq.h
 PeptideIndexing.h
+ProteinSuffixIndex.h
 PeptideProteinResolution.h
 PercolatorFeatureSetHelper.h
 PrecursorPurity.h
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <OpenMS/KERNEL/ColumnarConsensusMap.h>
 #include <OpenMS/KERNEL/ConsensusMap.h>
 #include <OpenMS/ANALYSIS/MAPMATCHING/ConsensusMapNormalizerAlgorithmThreshold.h>
 
@@ -62,6 +63,22 @@ public:
      */
     static Size computeMedians(const ConsensusMap & map, std::vector<double> & medians, const String& acc_filter, const String& desc_filter);
 
+    /**
+     * @brief computes medians of all maps from the extracted feature handles @p columns of @p map and returns index of map with most features
+     *
+     * Same as above, but reuses the handles already extracted from @p map (e.g. by a previous normalization step).
+     * The filters are evaluated and the medians are computed in parallel.
+     *
+     * @param map ConsensusMap
+     * @param columns the feature handles of @p map
+     * @param medians vector of medians to be filled
+     * @param acc_filter string describing the regular expression for filtering accessions
+     * @param desc_filter string describing the regular expression for filtering descriptions
+     * @return index of map with largest number of features
+     * @exception Exception::InvalidSize is thrown if @p columns does not have as many consensus features as @p map
+     */
+    static Size computeMedians(const ConsensusMap & map, const ColumnarConsensusMap & columns, std::vector<double> & medians, const String& acc_filter, const String& desc_filter);
+
     /**
      * @brief returns whether consensus feature passes filters
      * returns whether consensus feature @p cf_it in @p map passes accession
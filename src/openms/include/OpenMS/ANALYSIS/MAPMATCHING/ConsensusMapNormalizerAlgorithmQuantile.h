@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <OpenMS/KERNEL/ColumnarConsensusMap.h>
 #include <OpenMS/KERNEL/ConsensusMap.h>
 
 namespace OpenMS
@@ -36,9 +37,20 @@ public:
     /**
      * @brief normalizes the maps of the consensusMap
      * @param map ConsensusMap
+     * @exception Exception::ElementNotFound is thrown if the column headers of @p map are not numbered consecutively
      */
     static void normalizeMaps(ConsensusMap & map);
 
+    /**
+     * @brief normalizes the intensities of the maps (columns) of an extracted consensus map
+     *
+     * The intensities of each map are sorted in parallel; use ColumnarConsensusMap::applyIntensities() to write
+     * the result into the consensus map. Every map must contain at least one feature.
+     *
+     * @param columns the feature handles of a ConsensusMap, intensities are normalized in place
+     */
+    static void normalizeMaps(ColumnarConsensusMap & columns);
+
     /**
      * @brief resamples data_in and writes the results to data_out
      * @param data_in the data to be resampled
@@ -145,6 +145,9 @@ private:
       The algorithm takes a number of feature or consensus maps and searches
       for corresponding (consensus) features across different maps.
 
+      The features are split into partitions at m/z gaps that no tolerance
+      window can cross; the partitions are linked in parallel.
+
       @htmlinclude OpenMS_FeatureGroupingAlgorithmKD.parameters
 
       @ingroup FeatureGrouping
@@ -193,14 +196,18 @@ private:
     template <typename MapType>
     void group_(const std::vector<MapType>& input_maps, ConsensusMap& out);
 
-    /// Run the actual clustering algorithm
-    void runClustering_(const KDTreeFeatureMaps& kd_data, ConsensusMap& out);
+    /**
+        @brief Run the actual clustering algorithm
+
+        Only reads from the members (@p feature_distance is modified), so partitions can be clustered in parallel.
+    */
+    void runClustering_(const KDTreeFeatureMaps& kd_data, FeatureDistance& feature_distance, ConsensusMap& out) const;
 
     /// Update maximum possible sizes of potential consensus features for indices specified in @p update_these
-    void updateClusterProxies_(std::set<ClusterProxyKD>& potential_clusters, std::vector<ClusterProxyKD>& cluster_for_idx, const std::set<Size>& update_these, const std::vector<Int>& assigned, const KDTreeFeatureMaps& kd_data);
+    void updateClusterProxies_(std::set<ClusterProxyKD>& potential_clusters, std::vector<ClusterProxyKD>& cluster_for_idx, const std::set<Size>& update_these, const std::vector<Int>& assigned, const KDTreeFeatureMaps& kd_data, FeatureDistance& feature_distance) const;
 
     /// Compute the current best cluster with center index @p i (mutates @p proxy and @p cf_indices)
-    ClusterProxyKD computeBestClusterForCenter_(Size i, std::vector<Size>& cf_indices, const std::vector<Int>& assigned, const KDTreeFeatureMaps& kd_data) const;
+    ClusterProxyKD computeBestClusterForCenter_(Size i, std::vector<Size>& cf_indices, const std::vector<Int>& assigned, const KDTreeFeatureMaps& kd_data, FeatureDistance& feature_distance) const;
 
     /// Construct consensus feature and add to out map
     void addConsensusFeature_(const std::vector<Size>& indices, const KDTreeFeatureMaps& kd_data, ConsensusMap& out) const;
@@ -217,6 +224,12 @@ private:
     /// m/z unit ppm?
     bool mz_ppm_;
 
+    /// How to use charge information for linking ("link:charge_merging")
+    String merge_charge_;
+
+    /// How to use adduct information for linking ("link:adduct_merging")
+    String merge_adduct_;
+
     /// Feature distance functor
     FeatureDistance feature_distance_;
   };
@@ -12,16 +12,20 @@
 #include <OpenMS/ANALYSIS/MAPMATCHING/TransformationDescription.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
+#include <OpenMS/DATASTRUCTURES/InternedString.h>
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 #include <OpenMS/KERNEL/ConsensusMap.h>
 #include <OpenMS/KERNEL/FeatureMap.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <OpenMS/METADATA/ID/IdentificationData.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
 
+#include <algorithm>
 #include <cmath> // for "abs"
 #include <limits> // for "max"
-#include <map>
+#include <type_traits>
+#include <unordered_map>
 
 namespace OpenMS
 {
@@ -39,6 +43,8 @@ namespace OpenMS
     Cubic spline smoothing is used to convert this mapping to a smooth function.
     Retention times in the map are transformed to the consensus scale by applying this function.
 
+    The retention time data of the maps is collected, and the data points of their transformations are computed, in parallel.
+
     @htmlinclude OpenMS_MapAlignmentAlgorithmIdentification.parameters
 
     @ingroup MapAlignment
@@ -106,14 +112,39 @@ public:
 
       // one set of RT data for each input map, except reference (if any):
       std::vector<SeqToList> rt_data(data.size() - use_internal_reference);
-      bool all_sorted = true;
-      for (Size i = 0, j = 0; i < data.size(); ++i)
+      std::vector<Size> map_index;
+      for (Size i = 0; i < data.size(); ++i)
       {
         if ((reference_index >= 0) && (i == Size(reference_index)))
         {
           continue; // skip reference map, if any
         }
-        all_sorted &= getRetentionTimes_(data[i], rt_data[j++]);
+        map_index.push_back(i);
+      }
+      bool all_sorted = true;
+      if constexpr (std::is_same<DataType, IdentificationData>::value)
+      {
+        // the first map with matches determines the score type (if not given) -> serial
+        for (Size j = 0; j < map_index.size(); ++j)
+        {
+          all_sorted &= getRetentionTimes_(data[map_index[j]], rt_data[j]);
+        }
+      }
+      else
+      {
+        // score orientation per map, as in the serial collection
+        std::vector<ScoreComparator> better(map_index.size(), better_);
+        for (Size j = 0; j < map_index.size(); ++j)
+        {
+          better[j] = getScoreComparator_(data[map_index[j]]);
+        }
+        if (!better.empty()) better_ = better.back();
+        std::vector<char> sorted(map_index.size());
+        TaskScheduler::parallelFor(0, map_index.size(), [&](SignedSize j)
+        {
+          sorted[j] = getRetentionTimes_(data[map_index[j]], rt_data[j], better[j]);
+        });
+        all_sorted = std::all_of(sorted.begin(), sorted.end(), [](char s) { return s; });
       }
       setProgress(1);
 
@@ -126,11 +157,14 @@ public:
 
 protected:
 
-    /// Type to store retention times given for individual peptide sequences
-    typedef std::map<String, DoubleList> SeqToList;
+    /// Type to store retention times given for individual peptide sequences (of one map)
+    typedef std::unordered_map<String, DoubleList> SeqToList;
 
-    /// Type to store one representative retention time per peptide sequence
-    typedef std::map<String, double> SeqToValue;
+    /// Type to store one representative retention time per peptide sequence (interned, as most sequences occur in many maps)
+    typedef std::unordered_map<InternedString, double> SeqToValue;
+
+    /// Score comparison: is the first score good enough given the second (minimum) score?
+    typedef bool (*ScoreComparator) (double, double);
 
     /// Index of input file to use as reference (if any)
     Int reference_index_;
@@ -157,7 +191,7 @@ protected:
     String score_type_;
 
     /// Score better?
-    bool (*better_) (double, double) = [](double, double) {return true;};
+    ScoreComparator better_ = [](double, double) {return true;};
 
     /**
       @brief Compute the median retention time for each peptide sequence
@@ -182,6 +216,10 @@ protected:
     bool getRetentionTimes_(std::vector<PeptideIdentification>& peptides,
                             SeqToList& rt_data);
 
+    /// As above, with the score comparison @p better (does not change the state of the algorithm)
+    bool getRetentionTimes_(std::vector<PeptideIdentification>& peptides,
+                            SeqToList& rt_data, ScoreComparator better) const;
+
     /**
       @brief Collect retention time data from spectrum matches
 
@@ -203,6 +241,44 @@ protected:
     */
     bool getRetentionTimes_(PeakMap& experiment, SeqToList& rt_data);
 
+    /// As above, with the score comparison @p better (does not change the state of the algorithm)
+    bool getRetentionTimes_(PeakMap& experiment, SeqToList& rt_data,
+                            ScoreComparator better) const;
+
+    /// Score comparison for peptide IDs and peak maps (the current one)
+    ScoreComparator getScoreComparator_(const std::vector<PeptideIdentification>&) const
+    {
+      return better_;
+    }
+
+    /// Score comparison for peptide IDs and peak maps (the current one)
+    ScoreComparator getScoreComparator_(const PeakMap&) const
+    {
+      return better_;
+    }
+
+    /**
+      @brief Score comparison for feature maps or consensus maps
+
+      If @p score_cutoff is set, the orientation of the scores is determined from the first peptide ID of the first feature.
+    */
+    template <typename MapType>
+    ScoreComparator getScoreComparator_(const MapType& features) const
+    {
+      if (!score_cutoff_)
+      {
+        return [](double, double) {return true;};
+      }
+      else if (features[0].getPeptideIdentifications()[0].isHigherScoreBetter())
+      {
+        return [](double a, double b) { return a >= b; };
+      }
+      else
+      {
+        return [](double a, double b) { return a <= b; };
+      }
+    }
+
     /**
       @brief Collect retention time data from peptide IDs contained in feature maps or consensus maps
 
@@ -220,22 +296,15 @@ protected:
     template <typename MapType>
     bool getRetentionTimes_(MapType& features, SeqToList& rt_data)
     {
-      if (!score_cutoff_)
-      {
-        better_ = [](double, double)
-        {return true;};
-      }
-      else if (features[0].getPeptideIdentifications()[0].isHigherScoreBetter())
-      {
-        better_ = [](double a, double b)
-        { return a >= b; };
-      }
-      else
-      {
-        better_ = [](double a, double b)
-        { return a <= b; };
-      }
+      better_ = getScoreComparator_(features);
+      return getRetentionTimes_(features, rt_data, better_);
+    }
 
+    /// As above, with the score comparison @p better (does not change the state of the algorithm)
+    template <typename MapType>
+    bool getRetentionTimes_(MapType& features, SeqToList& rt_data,
+                            ScoreComparator better) const
+    {
       for (typename MapType::Iterator feat_it = features.begin();
            feat_it != features.end(); ++feat_it)
       {
@@ -257,7 +326,7 @@ protected:
               if (current_distance < rt_distance)
               {
                 pep_it->sort();
-                if (better_(pep_it->getHits()[0].getScore(), min_score_))
+                if (better(pep_it->getHits()[0].getScore(), min_score_))
                 {
                   sequence = pep_it->getHits()[0].getSequence().toString();
                   rt_distance = current_distance;
@@ -270,7 +339,7 @@ protected:
         }
         else
         {
-          getRetentionTimes_(feat_it->getPeptideIdentifications(), rt_data);
+          getRetentionTimes_(feat_it->getPeptideIdentifications(), rt_data, better);
         }
       }
 
@@ -278,7 +347,7 @@ protected:
           param_.getValue("use_unassigned_peptides").toBool())
       {
         getRetentionTimes_(features.getUnassignedPeptideIdentifications(),
-                           rt_data);
+                           rt_data, better);
       }
 
       // remove duplicates (can occur if a peptide ID was assigned to several
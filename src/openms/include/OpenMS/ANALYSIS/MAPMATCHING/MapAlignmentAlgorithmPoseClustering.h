@@ -52,8 +52,15 @@ public:
     /// Destructor
     ~MapAlignmentAlgorithmPoseClustering() override;
 
+    /**
+      @brief Computes the transformation of @p map onto the reference (see setReference())
+
+      Different maps can be aligned to the same reference concurrently (e.g. in an OpenMP loop).
+    */
     void align(const FeatureMap& map, TransformationDescription& trafo);
+    /// Overload for peak maps
     void align(const PeakMap& map, TransformationDescription& trafo);
+    /// Overload for consensus maps
     void align(const ConsensusMap& map, TransformationDescription& trafo);
 
     /// Sets the reference for the alignment
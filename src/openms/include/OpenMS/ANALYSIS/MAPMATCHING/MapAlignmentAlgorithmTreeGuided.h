@@ -64,6 +64,8 @@ public:
     /**
      * @brief Align feature maps tree guided using align() of @ref OpenMS::MapAlignmentAlgorithmIdentification and use TreeNode with larger 10/90 percentile range as reference.
      *
+     * Nodes of independent subtrees are aligned in parallel; the result does not depend on the number of threads.
+     *
      * @param tree Vector of BinaryTreeNodes that contains order for alignment.
      * @param feature_maps_transformed Vector with input maps for transformation process. Because the transformed maps are stored within this vector it's not const.
      * @param maps_ranges Vector that contains all sorted RTs of extracted identifications for each map; needed to determine the 10/90 percentiles.
@@ -112,9 +114,17 @@ protected:
     /// Default params of transformation models linear, b_spline, lowess and interpolated
     Param model_param_;
 
-    /// Instantiation of alignment algorithm
+    /// Instantiation of alignment algorithm (holds the parameters, see alignTreeNode_)
     MapAlignmentAlgorithmIdentification align_algorithm_;
 
+    /**
+     * @brief Align the two maps (clusters) joined by @p node and combine them at the smaller index (see treeGuidedAlignment()).
+     *
+     * Only accesses the maps and map sets of the children of @p node, so nodes of different subtrees can be aligned in parallel.
+     */
+    void alignTreeNode_(const BinaryTreeNode& node, std::vector<FeatureMap>& feature_maps_transformed,
+                        const std::vector<std::vector<double>>& maps_ranges, std::vector<std::vector<Size>>& map_sets) const;
+
     /**
      * @brief Similarity functor that provides similarity calculations with the ()-operator for protected type SeqAndRTList.
      * SeqAndRTList stores retention times given for individual peptide sequences of a feature map.
@@ -10,7 +10,7 @@
 
 #include <OpenMS/ANALYSIS/MAPMATCHING/BaseGroupFinder.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
-#include <OpenMS/ML/CLUSTERING/HashGrid.h>
+#include <OpenMS/ML/CLUSTERING/StaticHashGrid.h>
 #include <OpenMS/DATASTRUCTURES/GridFeature.h>
 #include <OpenMS/DATASTRUCTURES/QTCluster.h>
 #include <OpenMS/ANALYSIS/MAPMATCHING/FeatureDistance.h>
@@ -66,7 +66,8 @@ namespace OpenMS
    This algorithm includes a number of optimizations to reduce run-time:
    @li two-dimensional hashing of features,
    @li a look-up table for feature distances,
-   @li a variant of QT clustering that requires only one round of clustering.
+   @li a variant of QT clustering that requires only one round of clustering,
+   @li parallel (but deterministic) computation of the initial clusters and of cluster updates.
 
    @see FeatureGroupingAlgorithmQT
 
@@ -92,7 +93,8 @@ namespace OpenMS
     /// Heap to efficiently find the best clusters
     typedef boost::heap::fibonacci_heap<QTCluster> Heap;
 
-    typedef HashGrid<OpenMS::GridFeature*> Grid;
+    /// Grid of all features (built once, queried for the neighborhood of every cluster)
+    typedef StaticHashGrid<OpenMS::GridFeature*> Grid;
 
   private:
     /// Number of input maps
@@ -135,9 +137,12 @@ namespace OpenMS
 
     /**
        @brief Calculates the distance between two grid features.
+
+       @p feature_distance caches normalization factors, so each thread needs its own copy of feature_distance_.
     */
-    double getDistance_(const OpenMS::GridFeature* left, const
-        OpenMS::GridFeature* right);
+    double getDistance_(FeatureDistance& feature_distance,
+                        const OpenMS::GridFeature* left,
+                        const OpenMS::GridFeature* right) const;
 
     /// Sets algorithm parameters
     void setParameters_(double max_intensity, double max_mz);
@@ -161,6 +166,8 @@ namespace OpenMS
 
     /**
      * @brief Computes an initial QT clustering of the points in the hash grid
+     *
+     * The clusters are filled in parallel and inserted into the heap and the element mapping in grid order.
      * 
      * @param grid the grid is used to find new features for clusters that have to be updated
      * @param cluster_heads the heap where the QTClusters are inserted
@@ -201,6 +208,9 @@ namespace OpenMS
      * 1. remove current best cluster from the heap
      * 2. update all clusters accordingly by removing neighbors used by the current best
      * 3. invalidate clusters whose center has been used by the current best
+     *
+     * The affected clusters are recomputed in parallel (on copies of their heads), the results are
+     * written back to the heap and the element mapping sequentially in the original order.
      * 
      * @param element_mapping the element mapping is used to update clusters and updated itself
      * @param grid the grid is used to find new features for clusters that have to be updated
@@ -234,13 +244,16 @@ namespace OpenMS
      * 
      * @param grid the grid is used to find neighboring features the cluster
      * @param cluster cluster to which the new elements are added
+     * @param feature_distance distance functor (a copy of feature_distance_ per thread)
+     *
+     * @note Only reads from the members (e.g. already_used_), so it can be called for different clusters in parallel.
      */ 
-    void addClusterElements_(const Grid& grid, QTCluster& cluster);
+    void addClusterElements_(const Grid& grid, QTCluster& cluster, FeatureDistance& feature_distance) const;
 
     /**
      * @brief Looks up the matching bin for @p rt in bin_tolerances_ and checks if @p dist is in the allowed range.
      */
-    bool distIsOutlier_(double dist, double rt);
+    bool distIsOutlier_(double dist, double rt) const;
 
 protected:
 
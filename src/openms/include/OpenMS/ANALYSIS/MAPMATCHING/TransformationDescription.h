@@ -95,6 +95,14 @@ public:
     */
     double apply(double value) const;
 
+    /**
+      @brief Applies the transformation to all @p values (in place).
+
+      Same result as calling apply(double) for each value, but faster,
+      especially for sorted values.
+    */
+    void apply(std::vector<double>& values) const;
+
     /// Gets the type of the fitted model
     const String& getModelType() const;
 
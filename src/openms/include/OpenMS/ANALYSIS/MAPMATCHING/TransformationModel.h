@@ -76,6 +76,15 @@ namespace OpenMS
 
     /// Evaluates the model at the given value
     virtual double evaluate(double value) const;
+
+    /**
+      @brief Evaluates the model at all given values (in place)
+
+      Equivalent to calling evaluate(double) for each value, but avoids a
+      virtual call per value; derived classes may additionally exploit that
+      the values are sorted (e.g. retention times of consecutive spectra).
+    */
+    virtual void evaluate(std::vector<double>& values) const;
     
     /**
     @brief Weight the data by the given weight function
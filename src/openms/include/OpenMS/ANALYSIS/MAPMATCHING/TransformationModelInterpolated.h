@@ -68,6 +68,13 @@ public:
      */
     double evaluate(double value) const override;
 
+    /**
+     * @brief Evaluate the interpolation model at all given values (in place)
+     *
+     * Sorted input is evaluated in a single pass over the data points.
+     */
+    void evaluate(std::vector<double>& values) const override;
+
     /// Gets the default parameters
     static void getDefaultParameters(Param& params);
 
@@ -99,6 +106,19 @@ public:
        */
       virtual double eval(const double& x) const = 0;
 
+      /**
+       * @brief Evaluate the underlying interpolation at all positions in @p x (in place).
+       *
+       * The default implementation calls eval() for each position.
+       */
+      virtual void eval(std::vector<double>& x) const
+      {
+        for (double& value : x)
+        {
+          value = eval(value);
+        }
+      }
+
       /**
        * @brief d'tor.
        */
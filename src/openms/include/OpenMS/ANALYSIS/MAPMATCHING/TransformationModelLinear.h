@@ -46,6 +46,9 @@ public:
     /// Evaluates the model at the given value
     double evaluate(double value) const override;
 
+    /// Evaluates the model at all given values (in place)
+    void evaluate(std::vector<double>& values) const override;
+
     using TransformationModel::getParameters;
 
     /// Gets the "real" parameters
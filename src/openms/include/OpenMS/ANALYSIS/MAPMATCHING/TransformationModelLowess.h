@@ -40,6 +40,12 @@ public:
       return model_->evaluate(value);
     }
 
+    /// Evaluates the model at all given values (in place)
+    void evaluate(std::vector<double>& values) const override
+    {
+      model_->evaluate(values);
+    }
+
     using TransformationModel::getParameters;
 
     /// Gets the default parameters
@@ -13,6 +13,7 @@
 
 namespace OpenMS
 {
+  class ColumnarSpectrum;
 
   /**
    * @brief The ChromatogramExtractorAlgorithm extracts chromatograms from a MS data.
@@ -82,6 +83,68 @@ public:
         double im_extraction_window,
         const String& filter);
 
+    /**
+     * @brief Extract several batches of chromatograms in a single pass over the spectra
+     *
+     * Same as calling extractChromatograms() once for each batch (with
+     * @p outputs[i] and @p extraction_coordinates[i]), but every spectrum is
+     * read from @p input only once: the spectra are read in blocks of
+     * @p block_size spectra and each block is extracted for all batches while
+     * it is still in the cache. Batches whose coordinates lie outside of the
+     * RT range of a block skip that block. If called outside of a parallel
+     * region (or with nested parallelism), the batches of a block are
+     * distributed dynamically over the available threads.
+     *
+     * @param input Input spectral map
+     * @param outputs Output chromatograms (XICs), one vector per batch
+     * @param extraction_coordinates Extraction coordinates, one vector per batch (each sorted by m/z)
+     * @param mz_extraction_window Extracts a window of this size in m/z
+     * dimension in Th or ppm (e.g. a window of 50 ppm means an extraction of
+     * 25 ppm on either side)
+     * @param ppm Whether mz_extraction_window is in ppm or in Th
+     * @param im_extraction_window Full window width (i.e. twice the tolerance) for IM extraction. Must be positive.
+     * @param filter Which function to apply in m/z space (currently "tophat" only)
+     * @param block_size Number of spectra which are read at once
+     *
+    */
+    void extractChromatograms(const OpenSwath::SpectrumAccessPtr& input,
+        std::vector< std::vector< OpenSwath::ChromatogramPtr > >& outputs,
+        const std::vector< std::vector<ExtractionCoordinates> >& extraction_coordinates,
+        double mz_extraction_window,
+        bool ppm,
+        double im_extraction_window,
+        const String& filter,
+        Size block_size = 64);
+
+    /**
+     * @brief Extract chromatograms at the m/z and RT defined by the ExtractionCoordinates.
+     *
+     * Same as above, but operates on spectra in column-oriented layout. The
+     * m/z, intensity and ion mobility columns are walked directly without any
+     * conversion. Each spectrum needs to be sorted by m/z and, if
+     * @p im_extraction_window is positive, needs to have an ion mobility column.
+     *
+     * @param input Input spectra (sorted by RT)
+     * @param output Output chromatograms (XICs)
+     * @param extraction_coordinates Extracts around these coordinates (from
+     *   rt_start to rt_end in seconds - extracts the whole chromatogram if
+     *   rt_end - rt_start < 0).
+     * @param mz_extraction_window Extracts a window of this size in m/z
+     * dimension in Th or ppm (e.g. a window of 50 ppm means an extraction of
+     * 25 ppm on either side)
+     * @param ppm Whether mz_extraction_window is in ppm or in Th
+     * @param im_extraction_window Full window width (i.e. twice the tolerance) for IM extraction. Must be positive.
+     * @param filter Which function to apply in m/z space (currently "tophat" only)
+     *
+    */
+    void extractChromatograms(const std::vector<ColumnarSpectrum>& input,
+        std::vector< OpenSwath::ChromatogramPtr >& output,
+        const std::vector<ExtractionCoordinates>& extraction_coordinates,
+        double mz_extraction_window,
+        bool ppm,
+        double im_extraction_window,
+        const String& filter);
+
     /**
      * @brief Extract the next mz value and add the integrated intensity to integrated_intensity.
      *
@@ -0,0 +1,97 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessTransforming.h>
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/KERNEL/RangeManager.h>
+
+namespace OpenMS
+{
+
+  /**
+    @brief A bounded least-recently-used cache of decoded spectra around any spectrum access
+
+    During DIA scoring, the same few spectra around the apex of overlapping
+    peak groups are fetched (and added up) over and over again. For cached
+    (SpectrumAccessOpenMSCached) or sqMass (SpectrumAccessSqMass) backends
+    each fetch means reading and decoding the spectrum again. This wrapper
+    keeps the last @p max_spectra decoded spectra (keyed by spectrum id) and
+    the last @p max_summed added up spectra (see getSummedSpectrum(), keyed
+    by the closest spectrum, the number of spectra and the mobility window).
+
+    The cache is shared between light clones: each thread works on its own
+    light clone (which holds a light clone of the wrapped spectrum access),
+    while all threads profit from spectra decoded by any of them. Lookups are
+    serialized by a mutex, the wrapped spectrum access is called outside of
+    it.
+
+    @note Spectra returned from the cache are shared between all callers and
+    must not be modified.
+  */
+  class OPENMS_DLLAPI SpectrumAccessLRUCache :
+    public SpectrumAccessTransforming
+  {
+public:
+
+    /// Hit and miss counts of the cache (summed over all light clones)
+    struct CacheStatistics
+    {
+      Size hits = 0; ///< getSpectrumById() calls answered from the cache
+      Size misses = 0; ///< getSpectrumById() calls forwarded to the wrapped spectrum access
+      Size summed_hits = 0; ///< getSummedSpectrum() calls answered from the cache
+      Size summed_misses = 0; ///< getSummedSpectrum() calls which added up the spectra
+
+      /// Fraction of all lookups (both caches) answered from the cache (0 if there were none)
+      double getHitRate() const;
+    };
+
+    /**
+      @brief Constructor
+
+      @param sptr The wrapped spectrum access
+      @param max_spectra Maximal number of decoded spectra kept in the cache (0 disables caching of spectra)
+      @param max_summed Maximal number of added up spectra kept in the cache (0 disables caching of added up spectra)
+    */
+    SpectrumAccessLRUCache(OpenSwath::SpectrumAccessPtr sptr, Size max_spectra, Size max_summed);
+
+    ~SpectrumAccessLRUCache() override;
+
+    /// Light clone (see ISpectrumAccess::lightClone()): the wrapped access is light cloned, the cache is shared
+    boost::shared_ptr<OpenSwath::ISpectrumAccess> lightClone() const override;
+
+    /// Returns the spectrum with the given id from the cache, decoding it with the wrapped spectrum access on a miss
+    OpenSwath::SpectrumPtr getSpectrumById(int id) override;
+
+    /**
+      @brief Returns the spectra around @p RT added up, from the cache if possible
+
+      Equivalent to SpectrumAddition::addUpSpectra(getMultipleSpectra(RT, nr_spectra_to_add), im_range, sampling_rate, true).
+      Returns an empty spectrum if there is no spectrum close to @p RT.
+    */
+    OpenSwath::SpectrumPtr getSummedSpectrum(double RT, int nr_spectra_to_add, const RangeMobility& im_range, double sampling_rate);
+
+    /// Hit and miss counts of the cache
+    CacheStatistics getStatistics() const;
+
+    /// Removes all spectra from the cache and resets the statistics
+    void clearCache();
+
+protected:
+
+    struct CacheData_;
+
+    /// Constructor for light clones
+    SpectrumAccessLRUCache(OpenSwath::SpectrumAccessPtr sptr, boost::shared_ptr<CacheData_> cache);
+
+    /// Cache shared between all light clones
+    boost::shared_ptr<CacheData_> cache_;
+  };
+
+}
@@ -63,6 +63,8 @@ public:
 
     std::vector<std::size_t> getSpectraByRT(double RT, double deltaRT) const override;
 
+    const OpenSwath::SpectrumRTIndex* getRTIndex() const override;
+
     size_t getNrSpectra() const override;
 
     SpectrumSettings getSpectraMetaInfo(int id) const;
@@ -81,6 +83,9 @@ public:
 private:
     boost::shared_ptr<MSExperimentType> ms_experiment_;
 
+    /// RT index of the spectra (shared between light clones)
+    boost::shared_ptr<const OpenSwath::SpectrumRTIndex> rt_index_;
+
   };
 } //end namespace OpenMS
 
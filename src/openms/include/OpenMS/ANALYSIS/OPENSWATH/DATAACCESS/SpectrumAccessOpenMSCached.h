@@ -29,10 +29,13 @@ namespace OpenMS
     (ISpectrumAccess) using the CachedmzML class which is able to read and
     write a cached mzML file.
 
-    @note This implementation is @a not thread-safe since it keeps internally a
-    single file access pointer which it moves when accessing a specific
-    data item. The caller is responsible to ensure that access is performed
-    atomically.
+    @note If the cached file could be memory mapped (see
+    CachedmzML::isMemoryMapped), data items are read directly from the
+    shared read-only mapping and light clones can be used concurrently from
+    multiple threads. Otherwise this implementation is @a not thread-safe
+    since it keeps internally a single file access pointer which it moves
+    when accessing a specific data item. The caller is then responsible to
+    ensure that access is performed atomically.
 
   */
   class OPENMS_DLLAPI SpectrumAccessOpenMSCached :
@@ -72,6 +75,8 @@ public:
 
     std::vector<std::size_t> getSpectraByRT(double RT, double deltaRT) const override;
 
+    const OpenSwath::SpectrumRTIndex* getRTIndex() const override;
+
     size_t getNrSpectra() const override;
 
     SpectrumSettings getSpectraMetaInfo(int id) const;
@@ -83,6 +88,10 @@ public:
     ChromatogramSettings getChromatogramMetaInfo(int id) const;
 
     std::string getChromatogramNativeID(int id) const override;
+
+private:
+    /// RT index of the spectra (shared between light clones)
+    boost::shared_ptr<const OpenSwath::SpectrumRTIndex> rt_index_;
   };
 
 } //end namespace
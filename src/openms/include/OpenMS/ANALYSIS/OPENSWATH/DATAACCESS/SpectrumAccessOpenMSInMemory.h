@@ -29,6 +29,10 @@ namespace OpenMS
    * object with the added benefits (and downside) of keeping all data in system
    * memory.
    * 
+   * Spectra with an ion mobility array get an ion mobility index (see
+   * OpenSwath::SpectrumMobilityIndex), which speeds up filtering them by ion
+   * mobility (e.g. for diaPASEF data).
+   * 
    * A possible example
    * 
    * @code
@@ -70,6 +74,8 @@ public:
 
     std::vector<std::size_t> getSpectraByRT(double RT, double deltaRT) const override;
 
+    const OpenSwath::SpectrumRTIndex* getRTIndex() const override;
+
     size_t getNrSpectra() const override;
 
     OpenSwath::ChromatogramPtr getChromatogramById(int id) override;
@@ -86,6 +92,9 @@ private:
     std::vector< OpenSwath::ChromatogramPtr > chromatograms_;
     std::vector< std::string > chromatogram_ids_;
 
+    /// RT index of the spectra (shared between light clones)
+    boost::shared_ptr<const OpenSwath::SpectrumRTIndex> rt_index_;
+
   };
 
 } //end namespace OpenMS
@@ -89,6 +89,8 @@ public:
 
     std::vector<std::size_t> getSpectraByRT(double /* RT */, double /* deltaRT */) const override;
 
+    const OpenSwath::SpectrumRTIndex* getRTIndex() const override;
+
     size_t getNrSpectra() const override;
 
     OpenSwath::ChromatogramPtr getChromatogramById(int /* id */) override;
@@ -99,10 +101,15 @@ public:
 
 private:
 
+    /// Reads the retention times of the (selected) spectra and builds the RT index
+    void buildRTIndex_();
+
     /// Access to underlying sqMass file
     OpenMS::Internal::MzMLSqliteHandler handler_;
     /// Optional subset of spectral indices
     std::vector<int> sidx_;
+    /// RT index of the (selected) spectra, shared between light clones (nullptr if the spectrum ids are not consecutive)
+    boost::shared_ptr<const OpenSwath::SpectrumRTIndex> rt_index_;
   };
 } //end namespace OpenMS
 
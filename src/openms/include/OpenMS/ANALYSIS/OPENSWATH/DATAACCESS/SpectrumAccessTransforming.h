@@ -35,6 +35,8 @@ public:
 
     std::vector<std::size_t> getSpectraByRT(double RT, double deltaRT) const override;
 
+    const OpenSwath::SpectrumRTIndex* getRTIndex() const override;
+
     size_t getNrSpectra() const override;
 
     OpenSwath::ChromatogramPtr getChromatogramById(int id) override;
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <OpenMS/CHEMISTRY/AASequence.h>
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopeDistribution.h>
 #include <OpenMS/OPENSWATHALGO/DATAACCESS/DataStructures.h>
 #include <OpenMS/OPENSWATHALGO/DATAACCESS/ISpectrumAccess.h>
 #include <vector>
@@ -112,6 +113,25 @@ namespace OpenMS
                                          const int nr_isotopes = 4,
                                          const double mannmass = 1.00048);
 
+    /**
+      @brief Coarse isotope distribution of @p formula with @p nr_isotopes peaks, from a lookup table
+
+      Same as formula.getIsotopeDistribution(CoarseIsotopePatternGenerator(nr_isotopes)),
+      but each distribution is only computed once per process. The table is
+      shared between threads (access is synchronized) and never shrinks, the
+      returned reference stays valid.
+    */
+    OPENMS_DLLAPI const IsotopeDistribution& getCoarseIsotopeDistribution(const EmpiricalFormula& formula, Size nr_isotopes);
+
+    /**
+      @brief Averagine isotope distribution with @p nr_isotopes peaks for a peptide of @p average_weight, from a lookup table
+
+      Same as CoarseIsotopePatternGenerator(nr_isotopes).estimateFromPeptideWeight(average_weight).
+      The averagine model rounds the element counts, so all weights with the
+      same composition share one entry of the table of getCoarseIsotopeDistribution().
+    */
+    OPENMS_DLLAPI const IsotopeDistribution& getCoarseAveragineDistribution(double average_weight, Size nr_isotopes);
+
     /// simulate spectrum from AASequence
     OPENMS_DLLAPI void simulateSpectrumFromAASequence(const AASequence& aa,
                                         std::vector<double>& first_isotope_masses, //[out]
@@ -71,6 +71,25 @@ namespace OpenMS
 
 public:
 
+    /**
+      @brief Theoretical patterns of a transition group, independent of the peak group scored
+
+      Computing the theoretical isotope patterns and the b/y ion series is
+      expensive compared to looking them up in a spectrum. Compute them once
+      per transition group with prepareTheoreticalPatterns() and pass them to
+      the corresponding overloads of dia_isotope_scores() and
+      dia_by_ion_score() for each of its peak groups.
+    */
+    struct TheoreticalPatterns
+    {
+      /// theoretical isotope intensities (scaled to a maximum of 1) of each transition
+      std::vector<std::vector<double> > isotopes;
+      /// m/z of the b ions (empty if no sequence was given)
+      std::vector<double> bseries;
+      /// m/z of the y ions (empty if no sequence was given)
+      std::vector<double> yseries;
+    };
+
     ///@name Constructors and Destructor
     //@{
     /// Default constructor
@@ -124,6 +143,30 @@ public:
     void dia_by_ion_score(const SpectrumSequence& spectrum, AASequence& sequence,
                           int charge, const RangeMobility& im_range, double& bseries_score, double& yseries_score) const;
 
+    /**
+      @brief Precompute the theoretical patterns of a transition group
+
+      @param transitions The transitions for the isotope scores (with the same order as passed to dia_isotope_scores())
+      @param sequence The peptide for the b/y ion scores; if empty, no b/y ion series are computed
+      @param by_charge Charge state of the b/y ions
+      @param patterns Output
+    */
+    void prepareTheoreticalPatterns(const std::vector<TransitionType>& transitions, const AASequence& sequence,
+                                    int by_charge, TheoreticalPatterns& patterns) const;
+
+    /// Isotope scores using precomputed theoretical isotope patterns, identical to dia_isotope_scores() above
+    void dia_isotope_scores(const std::vector<TransitionType>& transitions,
+                            SpectrumSequence& spectrum,
+                            OpenSwath::IMRMFeature* mrmfeature,
+                            const RangeMobility& im_range,
+                            const TheoreticalPatterns& patterns,
+                            double& isotope_corr,
+                            double& isotope_overlap) const;
+
+    /// b/y ion scores using precomputed b/y ion series, identical to dia_by_ion_score() above
+    void dia_by_ion_score(const SpectrumSequence& spectrum, const TheoreticalPatterns& patterns,
+                          const RangeMobility& im_range, double& bseries_score, double& yseries_score) const;
+
     /// Dotproduct / Manhattan score with theoretical spectrum
     void score_with_isotopes(SpectrumSequence& spectrum,
                              const std::vector<TransitionType>& transitions,
@@ -143,14 +186,19 @@ private:
     /// Synchronize members with param class
     void updateMembers_() override;
 
-    /// Subfunction of dia_isotope_scores
+    /// Subfunction of dia_isotope_scores, computes the theoretical isotope patterns unless @p theoretical_isotopes is given
     void diaIsotopeScoresSub_(const std::vector<TransitionType>& transitions,
                               const SpectrumSequence& spectrum,
                               std::map<std::string, double>& intensities,
                               const RangeMobility& im_range,
+                              const std::vector<std::vector<double> >* theoretical_isotopes,
                               double& isotope_corr,
                               double& isotope_overlap) const;
 
+    /// Subfunction of dia_by_ion_score, counts the b and y ions found in @p spectrum
+    void scoreBYSeries_(const SpectrumSequence& spectrum, const std::vector<double>& bseries, const std::vector<double>& yseries,
+                        const RangeMobility& im_range, double& bseries_score, double& yseries_score) const;
+
     /// retrieves intensities from MRMFeature
     /// computes a vector of relative intensities for each feature (output to intensities)
     void getFirstIsotopeRelativeIntensities_(const std::vector<TransitionType>& transitions,
@@ -209,6 +257,16 @@ private:
     double scoreIsotopePattern_(const std::vector<double>& isotopes_int,
                                 const IsotopeDistribution& isotope_dist) const;
 
+    /// Compare an experimental isotope pattern to theoretical isotope intensities scaled to a maximum of 1 (Pearson correlation)
+    double scoreIsotopePattern_(const std::vector<double>& isotopes_int,
+                                const std::vector<double>& theoretical_isotopes) const;
+
+    /// Theoretical isotope intensities (averagine model, scaled to a maximum of 1) of a fragment at @p product_mz
+    void getTheoreticalIsotopes_(double product_mz, int putative_fragment_charge, std::vector<double>& theoretical_isotopes) const;
+
+    /// Scale the intensities of @p isotope_dist to a maximum of 1
+    void scaleIsotopeDistribution_(const IsotopeDistribution& isotope_dist, std::vector<double>& theoretical_isotopes) const;
+
     /// Get the intensities of isotopes around @p precursor_mz in experimental @p spectrum
     /// and fill @p isotopes_int.
     void getIsotopeIntysFromExpSpec_(double precursor_mz, const SpectrumSequence& spectrum, int charge_state, const RangeMobility& im_range,
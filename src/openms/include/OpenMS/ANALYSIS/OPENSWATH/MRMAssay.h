@@ -296,6 +296,7 @@ protected:
       
       Then store the ion series for each of these theoretical fragment ions in
       the provided maps TargetSequenceMap, TargetIonMap, TargetPeptideMap.
+      The fragment maps in TargetIonMap are sorted by m/z and free of duplicates.
 
       @details Used internally by the IPF algorithm, see MRMAssay::uisTransitions()
 
@@ -334,6 +335,8 @@ protected:
       possibilities) that are physicochemically possible according to
       ModificationsDB.
 
+      The fragment maps in DecoyIonMap are sorted by m/z and free of duplicates.
+
       @details Used internally by the IPF algorithm, see MRMAssay::uisTransitions()
 
     */
@@ -364,7 +367,7 @@ protected:
       @param swathes The swath windows used
       @param round_decPow round product m/z values to decimal power (default: -4)
       @param TargetPeptideMap Theoretical transitions for each peptide generated before
-      @param TargetIonMap Theoretical transitions for each peptide generated before
+      @param TargetIonMap Theoretical transitions for each peptide generated before (sorted, see generateTargetInSilicoMap_())
 
       @details Used internally by the IPF algorithm, see MRMAssay::uisTransitions()
 
@@ -380,6 +383,10 @@ protected:
     /**
       @brief Generate decoy assays
 
+      Same as generateTargetAssays_() for the decoy peptides; decoy transitions
+      that overlap with a target transition are skipped. DecoyIonMap and
+      TargetIonMap have to be sorted (see generateDecoyInSilicoMap_()).
+
       @details Used internally by the IPF algorithm, see MRMAssay::uisTransitions()
 
     */
@@ -57,6 +57,9 @@ public:
     /**
       @brief Flags or filters features and subordinates in a FeatureMap
 
+      The QC criteria are compiled once (QCs indexed by name, metaValue keys resolved
+      in the MetaInfoRegistry) and the features are evaluated in parallel.
+
       @param features FeatureMap to flag or filter
       @param filter_criteria MRMFeatureQC class defining QC parameters
       @param transitions transitions from a TargetedExperiment
@@ -80,6 +80,21 @@ namespace OpenSwath
         const XCorrMatrixType& getXCorrPrecursorCombinedMatrix() const;
         //@}
 
+        /**
+           @brief Whether the full cross-correlation arrays are kept (default: true)
+
+           The scores only need the lag and the value of the maximum of each
+           cross-correlation. If disabled (compact mode), the
+           initializeXCorr*Matrix() functions only keep these, computing the
+           cross-correlations one after another in a buffer that is reused for
+           all pairs and all subsequent peak groups scored by this object. The
+           getXCorr*Matrix() accessors then return empty matrices.
+        */
+        void setStoreXCorrArrays(bool store);
+
+        /// whether the full cross-correlation arrays are kept, see setStoreXCorrArrays()
+        bool getStoreXCorrArrays() const;
+
         /** @name Scores */
         //@{
       
@@ -258,19 +273,40 @@ namespace OpenSwath
         //@}
 
         /// contains max Peaks from xcorr_contrast_matrix_
+        OpenMS::Matrix<int> xcorr_contrast_matrix_max_peak_;
         OpenMS::Matrix<double> xcorr_contrast_matrix_max_peak_sec_;
 
         /// the precomputed cross correlation matrix of the MS1 trace
         XCorrMatrixType xcorr_precursor_matrix_;
 
+        /// contains max Peaks from xcorr_precursor_matrix_
+        OpenMS::Matrix<int> xcorr_precursor_matrix_max_peak_;
+        OpenMS::Matrix<double> xcorr_precursor_matrix_max_peak_sec_;
+
         /// the precomputed cross correlation against the MS1 trace
         XCorrMatrixType xcorr_precursor_contrast_matrix_;
         //@}
 
+        /// contains max Peaks from xcorr_precursor_contrast_matrix_
+        OpenMS::Matrix<int> xcorr_precursor_contrast_matrix_max_peak_;
+        OpenMS::Matrix<double> xcorr_precursor_contrast_matrix_max_peak_sec_;
+
         /// the precomputed cross correlation with the MS1 trace
         XCorrMatrixType xcorr_precursor_combined_matrix_;
         //@}
 
+        /// contains max Peaks from xcorr_precursor_combined_matrix_
+        OpenMS::Matrix<int> xcorr_precursor_combined_matrix_max_peak_;
+        OpenMS::Matrix<double> xcorr_precursor_combined_matrix_max_peak_sec_;
+
+        /// whether the full cross-correlation arrays are kept (see setStoreXCorrArrays())
+        bool store_xcorr_arrays_ = true;
+
+        /// buffers reused for all peak groups: cross-correlation array (compact mode) and standardized intensities
+        XCorrArrayType xcorr_buffer_;
+        std::vector<std::vector<double>> intensity_buffer_i_;
+        std::vector<std::vector<double>> intensity_buffer_j_;
+
         /// the precomputed mutual information matrix
 
         OpenMS::Matrix<double> mi_matrix_;
@@ -287,5 +323,17 @@ namespace OpenSwath
         /// the precomputed contrast mutual information matrix with the MS1 trace
         OpenMS::Matrix<double> mi_precursor_combined_matrix_;
         //@}
+
+        /**
+           @brief Cross-correlates the standardized traces @p data_i with @p data_j
+
+           Stores the lag and the value of the maximum of each cross-correlation
+           in @p max_peak and @p max_peak_sec and, unless in compact mode, the
+           cross-correlation in @p xcorr_matrix. If @p upper_triangle is set,
+           @p data_i and @p data_j are the same traces and only pairs (i, j)
+           with j >= i are computed.
+        */
+        void computeXCorrMatrix_(std::vector<std::vector<double>>& data_i, std::vector<std::vector<double>>& data_j, bool upper_triangle,
+                                 XCorrMatrixType& xcorr_matrix, OpenMS::Matrix<int>& max_peak, OpenMS::Matrix<double>& max_peak_sec);
     };
 }
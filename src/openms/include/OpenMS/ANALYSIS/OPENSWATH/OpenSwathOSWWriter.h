@@ -9,6 +9,7 @@
 #pragma once
 
 // Interfaces
+#include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathOutputQueue.h>
 #include <OpenMS/OPENSWATHALGO/DATAACCESS/TransitionExperiment.h>
 
 #include <OpenMS/CONCEPT/UniqueIdGenerator.h>
@@ -16,6 +17,7 @@
 #include <OpenMS/KERNEL/FeatureMap.h>
 
 #include <fstream>
+#include <set>
 
 namespace OpenMS
 {
@@ -85,6 +87,13 @@ namespace OpenMS
         <tr> <td BGCOLOR="#EBEBEB">VAR_...</td> <td>REAL</td> <td>Fragment ion score used in pyProphet  </td> </tr>
       </table>
 
+    With checkpoints (see writeHeader()), the file has an additional table:
+
+      <table>
+        <tr> <th BGCOLOR="#EBEBEB" colspan=3>CHECKPOINT</th> </tr>
+        <tr> <td BGCOLOR="#EBEBEB">UNIT</td> <td>TEXT</td> <td> Primary Key (work unit, e.g. SWATH window, whose features are completely written)</td> </tr>
+      </table>
+
    */
   class OPENMS_DLLAPI OpenSwathOSWWriter
   {
@@ -93,6 +102,7 @@ namespace OpenMS
     OpenMS::UInt64 run_id_;
     bool doWrite_;
     bool enable_uis_scoring_;
+    OpenSwathOutputQueue queue_;
 
   public:
 
@@ -106,8 +116,32 @@ namespace OpenMS
     /**
      * @brief Initializes file by generating SQLite tables
      *
+     * @param checkpoints Also create the CHECKPOINT table, which records the
+     * completed work units (see prepareCheckpoint())
+     *
+     */
+    void writeHeader(bool checkpoints = false);
+
+    /**
+     * @brief Read the work units recorded as completed (see prepareCheckpoint())
+     *
+     * @returns The completed units, empty if the file does not exist or has no CHECKPOINT table
+     *
+     */
+    std::set<String> readCheckpoints() const;
+
+    /**
+     * @brief Prepare the statement recording @p unit as completed
+     *
+     * Write it with the lines of the unit (in the same call of writeLines()
+     * or enqueueLines()), so the features of the unit and its checkpoint are
+     * committed in one transaction: a unit is either complete in the file or
+     * not present at all.
+     *
+     * @note Requires the CHECKPOINT table (see writeHeader())
+     *
      */
-    void writeHeader();
+    String prepareCheckpoint(const String& unit) const;
 
     /**
      * @brief Prepare scores for SQLite insertion
@@ -168,6 +202,24 @@ namespace OpenMS
      */
     void writeLines(const std::vector<String>& to_osw_output);
 
+    /**
+     * @brief Hand over data statements from any thread
+     *
+     * Unlike writeLines, this may be called concurrently by many threads
+     * without a critical section: the statements are queued and written in
+     * batches (one transaction per batch) by whichever thread finds the
+     * writer idle, see OpenSwathOutputQueue.
+     *
+     * @param to_osw_output Statements generated by prepareLine (empty afterwards)
+     *
+     * @note Call flush() once all threads are done
+     *
+     */
+    void enqueueLines(std::vector<String>& to_osw_output);
+
+    /// Write all statements queued by enqueueLines to disk
+    void flush();
+
   };
 
 }
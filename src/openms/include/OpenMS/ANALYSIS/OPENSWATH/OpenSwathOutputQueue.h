@@ -0,0 +1,80 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace OpenMS
+{
+
+  /**
+    @brief Collects output lines from many threads and writes them in batches without making the threads wait for the output
+
+    Scoring threads prepare their output lines (e.g. with
+    OpenSwathTSVWriter::prepareLine() or OpenSwathOSWWriter::prepareLine())
+    in thread-local buffers and hand them over with push(). Handing over only
+    appends the lines to a pending queue under a short lock. If no other thread
+    is currently writing, the pushing thread becomes the writer and passes all
+    pending lines (including the ones pushed meanwhile by other threads) to
+    the sink in one batch; otherwise it returns immediately and the current
+    writer picks its lines up. Thus at most one thread waits for the disk at
+    any time and the batches grow with the contention.
+
+    Lines pushed while the writer is just finishing may stay in the queue
+    until the next push(), call flush() once all threads are done.
+
+    The order of the batches is the order in which the threads pushed them,
+    lines of a single push() are written consecutively.
+  */
+  class OPENMS_DLLAPI OpenSwathOutputQueue
+  {
+public:
+
+    /// Writes a batch of lines (only called by one thread at a time)
+    typedef std::function<void(const std::vector<String>&)> Sink;
+
+    /// Constructor
+    explicit OpenSwathOutputQueue(Sink sink);
+
+    /**
+      @brief Appends @p lines to the queue and writes the queue if no other thread is writing
+
+      @p lines is empty afterwards. May be called concurrently by any number of
+      threads. Exceptions thrown by the sink are passed on to the thread that
+      was writing.
+    */
+    void push(std::vector<String>& lines);
+
+    /// Writes all pending lines (waits for a thread which is currently writing)
+    void flush();
+
+    /// Number of lines in the queue which have not been written yet
+    Size pending() const;
+
+protected:
+
+    /// Writes batches until the queue is empty, provided @p writer holds the write lock
+    void drain_(std::unique_lock<std::mutex>& writer);
+
+    Sink sink_;
+
+    /// Protects pending_ (only held to append or take out lines)
+    mutable std::mutex queue_mutex_;
+
+    /// Held by the thread currently writing
+    std::mutex write_mutex_;
+
+    std::vector<String> pending_;
+  };
+
+}
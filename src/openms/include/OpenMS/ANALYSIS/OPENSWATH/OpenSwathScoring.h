@@ -18,6 +18,8 @@
 // scoring
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathScores.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DIAScoring.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/MRMScoring.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/SpectrumAddition.h>
 
 #include <vector>
 #include <boost/shared_ptr.hpp>
@@ -55,6 +57,8 @@ namespace OpenMS
     OpenSwath_Scores_Usage su_;
     bool use_ms1_ion_mobility_; ///< whether to use MS1 ion mobility extraction in DIA scores
     const std::string ION_MOBILITY_DESCRIPTION = "Ion Mobility";
+    SpectrumAddition::Workspace addition_workspace_; ///< buffers reused by spectrum addition in fetchSpectrumSwath()
+    mutable OpenSwath::MRMScoring mrmscore_; ///< chromatographic scoring in compact mode, reusing its buffers for all peak groups
 
   public:
 
@@ -169,6 +173,7 @@ namespace OpenMS
      * @param mzerror_ppm m/z and mass error (in ppm) for all transitions
      * @param[in] drift_target target drift value
      * @param[in] range_im drift time lower and upper bounds
+     * @param[in] patterns Theoretical patterns of the transition group (see prepareTheoreticalPatterns()), computed on the fly if NULL
      *
     */
     void calculateDIAScores(OpenSwath::IMRMFeature* imrmfeature,
@@ -180,7 +185,26 @@ namespace OpenMS
                             OpenSwath_Scores& scores,
                             std::vector<double>& mzerror_ppm,
                             const double drift_target,
-                            const RangeMobility& range_im);
+                            const RangeMobility& range_im,
+                            const DIAScoring::TheoreticalPatterns* patterns = nullptr);
+
+    /** @brief Precompute the theoretical patterns used by calculateDIAScores()
+     *
+     * The theoretical isotope patterns of the transitions and the b/y ion
+     * series of the compound only depend on the transition group. Computing
+     * them once and passing them to calculateDIAScores() for each of its peak
+     * groups gives the same scores.
+     *
+     * @param transitions The library transitions (as passed to calculateDIAScores())
+     * @param diascoring DIA Scoring object to use for scoring
+     * @param compound The compound corresponding to the library transitions
+     * @param patterns Output
+     *
+    */
+    void prepareTheoreticalPatterns(const std::vector<TransitionType>& transitions,
+                                    const OpenMS::DIAScoring& diascoring,
+                                    const CompoundType& compound,
+                                    DIAScoring::TheoreticalPatterns& patterns) const;
 
     /** @brief Score a single chromatographic feature using the precursor map.
      *
@@ -11,6 +11,7 @@
 // Interfaces
 #include <OpenMS/OPENSWATHALGO/DATAACCESS/TransitionExperiment.h>
 
+#include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathOutputQueue.h>
 #include <OpenMS/KERNEL/FeatureMap.h>
 
 #include <fstream>
@@ -107,6 +108,7 @@ namespace OpenMS
     bool doWrite_;
     bool use_ms1_traces_;
     bool sonar_;
+    OpenSwathOutputQueue queue_;
 
   public:
 
@@ -153,6 +155,24 @@ namespace OpenMS
      */
     void writeLines(const std::vector<String>& to_output);
 
+    /**
+     * @brief Hand over prepared lines from any thread
+     *
+     * Unlike writeLines, this may be called concurrently by many threads
+     * without a critical section: the lines are queued and written in
+     * batches by whichever thread finds the writer idle, see
+     * OpenSwathOutputQueue.
+     *
+     * @param to_output Lines generated by prepareLine (empty afterwards)
+     *
+     * @note Call flush() once all threads are done
+     *
+     */
+    void enqueueLines(std::vector<String>& to_output);
+
+    /// Write all lines queued by enqueueLines to disk
+    void flush();
+
   };
 
 }
@@ -20,6 +20,7 @@
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessOpenMS.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessTransforming.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessLRUCache.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessOpenMSInMemory.h>
 #include <OpenMS/OPENSWATHALGO/DATAACCESS/SwathMap.h>
 
@@ -455,8 +456,93 @@ protected:
                            int ms1_isotopes,
                            bool load_into_memory);
 
+    /** @brief Set how many batches are extracted together in one pass over a SWATH map
+     *
+     * performExtraction() extracts the chromatograms of @p batches_per_pass
+     * batches (see @p batchSize) in a single traversal of the SWATH map, so
+     * each spectrum is read and decoded once per pass instead of once per
+     * batch. Larger values reduce I/O and decoding at the cost of keeping the
+     * raw chromatograms of all batches of a pass in memory. A value of 1
+     * extracts each batch separately.
+    */
+    void setBatchesPerPass(int batches_per_pass)
+    {
+      batches_per_pass_ = batches_per_pass;
+    }
+
+    /** @brief Set how many decoded spectra are cached per SWATH map during scoring
+     *
+     * During scoring, overlapping peak groups fetch the same spectra around
+     * their apex repeatedly. If @p spectrum_cache_size is positive,
+     * performExtraction() scores each SWATH map through a
+     * SpectrumAccessLRUCache shared by all threads, which holds up to
+     * @p spectrum_cache_size decoded and as many added up spectra. This
+     * mostly helps with cached and sqMass input. A value of 0 disables the
+     * cache.
+    */
+    void setSpectrumCacheSize(int spectrum_cache_size)
+    {
+      spectrum_cache_size_ = spectrum_cache_size;
+    }
+
+    /** @brief Restrict performExtraction() to one shard of the SWATH windows
+     *
+     * The MS2 SWATH maps are dealt round-robin (in input order) to
+     * @p shard_count shards and only those of shard @p shard_index are
+     * extracted and scored; MS1-only extraction is done by shard 0. The
+     * assignment of precursors to their best window (for overlapping PRM and
+     * diaPASEF windows) still considers all maps, so the union of the results
+     * of all shards equals the result of a single run. A shard count of 1
+     * (the default) processes all windows.
+     *
+     * @throw Exception::IllegalArgument if @p shard_count is zero or @p shard_index is not smaller than @p shard_count
+    */
+    void setShard(Size shard_index, Size shard_count)
+    {
+      if (shard_count == 0 || shard_index >= shard_count)
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Shard index " + String(shard_index) + " is out of range for " + String(shard_count) + " shards.");
+      }
+      shard_index_ = shard_index;
+      shard_count_ = shard_count;
+    }
+
+    /** @brief Checkpoint completed SWATH windows in the OSW output and resume interrupted runs
+     *
+     * If @p resume is set and OSW output is written, performExtraction()
+     * writes the features of each SWATH window together with a checkpoint of
+     * the window in one transaction (see
+     * OpenSwathOSWWriter::prepareCheckpoint()), so a window is either
+     * completely in the output or not at all. If the OSW output already holds
+     * checkpoints (of a run which was interrupted), only the windows not
+     * completed yet are processed. Otherwise the output is initialized as
+     * usual. TSV, featureXML and chromatogram output are not checkpointed.
+     *
+     * @note With checkpoints, the features of a window are kept in memory until the window is completed
+    */
+    void setResume(bool resume)
+    {
+      resume_ = resume;
+    }
+
   protected:
 
+    /// Number of batches extracted together in one pass over a SWATH map (see setBatchesPerPass())
+    int batches_per_pass_ = 8;
+
+    /// Number of spectra cached per SWATH map during scoring (see setSpectrumCacheSize())
+    int spectrum_cache_size_ = 0;
+
+    /// Shard of the SWATH windows processed by performExtraction() (see setShard())
+    Size shard_index_ = 0;
+
+    /// Number of shards the SWATH windows are dealt to (see setShard())
+    Size shard_count_ = 1;
+
+    /// Whether to checkpoint completed windows and skip the ones already completed (see setResume())
+    bool resume_ = false;
+
 
     /** @brief Write output features and chromatograms
      *
@@ -515,6 +601,8 @@ protected:
      * @param osw_writer OSW Writer object to store identified features in SQLite format
      * @param nr_ms1_isotopes Consider this many MS1 isotopes for precursor chromatograms
      * @param ms1only If true, will only score on MS1 level and ignore MS2 level
+     * @param osw_lines If set, the OSW output lines are appended here (thread-safe) instead of being handed over to @p osw_writer
+     * @param tsv_lines If set, the TSV output lines are appended here instead of being handed over to @p tsv_writer
      *
     */
     void scoreAllChromatograms_(
@@ -529,7 +617,9 @@ protected:
         OpenSwathTSVWriter& tsv_writer,
         OpenSwathOSWWriter& osw_writer,
         int nr_ms1_isotopes = 0,
-        bool ms1only = false) const;
+        bool ms1only = false,
+        std::vector<String>* osw_lines = nullptr,
+        std::vector<String>* tsv_lines = nullptr) const;
 
     /** @brief Select which compounds to analyze in the next batch (and copy to output)
      *
@@ -873,6 +873,16 @@ private:
     bool fit_EMG_;
     EmgGradientDescent emg_;
 
+    /// The last EMG fit of a thread (see EMGPreProcess_())
+    template <typename PeakContainerT>
+    struct EMGFit_
+    {
+      bool valid = false;
+      double left = 0.0;
+      double right = 0.0;
+      PeakContainerT input;
+      PeakContainerT output;
+    };
 
     /**
       @brief Fit the peak to the EMG model
@@ -880,6 +890,10 @@ private:
       The fitting process happens only if `fit_EMG_` is true. `left` and `right`
       are updated accordingly.
 
+      integratePeak(), estimateBackground() and calculatePeakShapeMetrics() are
+      usually called one after the other for the same peak, so the last fit of
+      each thread is reused if `pc`, `left` and `right` did not change.
+
       @tparam PeakContainerT Either a MSChromatogram or a MSSpectrum
       @param[in] pc Input peak
       @param[out] emg_pc Will possibly contain the processed peak
@@ -897,7 +911,21 @@ private:
     {
       if (fit_EMG_)
       {
-        emg_.fitEMGPeakModel(pc, emg_pc, left, right);
+        thread_local EMGFit_<PeakContainerT> last_fit;
+        if (last_fit.valid && last_fit.left == left && last_fit.right == right && last_fit.input == pc)
+        {
+          emg_pc = last_fit.output;
+        }
+        else
+        {
+          emg_.fitEMGPeakModel(pc, emg_pc, left, right);
+          last_fit.valid = false; // in case an assignment throws
+          last_fit.left = left;
+          last_fit.right = right;
+          last_fit.input = pc;
+          last_fit.output = emg_pc;
+          last_fit.valid = true;
+        }
         left = emg_pc.front().getPos();
         right = emg_pc.back().getPos();
         return emg_pc;
@@ -13,6 +13,9 @@
 
 #include <OpenMS/KERNEL/MSSpectrum.h>
 
+#include <utility>
+#include <vector>
+
 namespace OpenMS
 {
   /**
@@ -28,11 +31,53 @@ namespace OpenMS
 
 public:
 
+    /**
+      @brief Reusable buffers for the workspace overloads of addUpSpectra() and concatenateSpectra()
+
+      The buffers grow to the largest spectra seen and are then reused, so
+      repeated calls with the same workspace (and output spectrum) do not
+      allocate. A workspace must not be used by multiple threads at the same
+      time; keep one per thread (e.g. per scoring object). Its content between
+      calls is unspecified.
+    */
+    struct OPENMS_DLLAPI Workspace
+    {
+      /// m/z and intensity range of an input spectrum
+      struct View
+      {
+        const double* mz;
+        const double* intensity;
+        Size size;
+      };
+
+      std::vector<View> views; ///< the (filtered) input spectra
+      std::vector<double> grid_mz; ///< m/z of the resampling raster
+      std::vector<double> grid_intensity; ///< intensities of the resampling raster
+      std::vector<std::vector<double> > filtered_mz; ///< m/z of each input spectrum after ion mobility filtering
+      std::vector<std::vector<double> > filtered_intensity; ///< intensities of each input spectrum after ion mobility filtering
+      std::vector<std::pair<double, Size> > heap; ///< heap of the k-way merge in concatenateSpectra()
+      std::vector<Size> cursors; ///< positions of the k-way merge in concatenateSpectra()
+      std::vector<std::size_t> peaks; ///< peaks within the ion mobility range (see OpenSwath::SpectrumMobilityIndex)
+    };
+
     /// adds up a list of Spectra by resampling them and then addition of intensities
     static OpenSwath::SpectrumPtr addUpSpectra(const SpectrumSequence& all_spectra,
                                                double sampling_rate,
                                                bool filter_zeros);
 
+    /**
+      @brief Adds up a list of spectra like addUpSpectra() above, but writes into @p output using the buffers of @p workspace
+
+      The m/z and intensity arrays of @p output are overwritten (keeping their
+      capacity), further data arrays are removed. A single input spectrum is
+      copied without resampling. @p output must not be one of the inputs.
+    */
+    static void addUpSpectra(const SpectrumSequence& all_spectra,
+                             double sampling_rate,
+                             bool filter_zeros,
+                             Workspace& workspace,
+                             OpenSwath::Spectrum& output);
+
 
     /// adds up a list of ion mobility enhacned Spectra by resampling them and then addition of intensities. Currently this involves filtering to the desired IM extracion window and then performing addition across m/z and intensity.
     static OpenSwath::SpectrumPtr addUpSpectra(const SpectrumSequence& all_spectra,
@@ -40,9 +85,36 @@ public:
                                                double sampling_rate,
                                                bool filter_zeros);
 
+    /**
+      @brief Ion mobility version of the workspace overload of addUpSpectra()
+
+      The peaks outside of @p im_range are skipped while adding up, without
+      creating filtered copies of the input spectra. Spectra without ion
+      mobility array are used as a whole.
+    */
+    static void addUpSpectra(const SpectrumSequence& all_spectra,
+                             const RangeMobility& im_range,
+                             double sampling_rate,
+                             bool filter_zeros,
+                             Workspace& workspace,
+                             OpenSwath::Spectrum& output);
+
     /// Concatenates a spectrum sequence into a single spectrum. Values are sorted by m/z
     static OpenSwath::SpectrumPtr concatenateSpectra(const SpectrumSequence& all_spectra);
 
+    /**
+      @brief Concatenates a spectrum sequence into @p output using the buffers of @p workspace
+
+      Spectra sorted by m/z (the usual case) are merged k-way; only if one of
+      them is unsorted, they are concatenated and sorted. Peaks with equal m/z
+      keep the order of the input spectra. All data arrays of the first
+      spectrum are kept (the other spectra need to have at least as many).
+      @p output must not be one of the inputs.
+    */
+    static void concatenateSpectra(const SpectrumSequence& all_spectra,
+                                   Workspace& workspace,
+                                   OpenSwath::Spectrum& output);
+
 
     /// adds up a list of Spectra by resampling them and then addition of intensities
     static OpenMS::MSSpectrum addUpSpectra(const std::vector<MSSpectrum>& all_spectra,
@@ -51,6 +123,11 @@ public:
 
     // sorts a spectrumPtr object by mz
     static void sortSpectrumByMZ(OpenSwath::Spectrum&);
+
+private:
+
+    /// Adds up workspace.views (at least two) into @p output
+    static void addUpViews_(double sampling_rate, bool filter_zeros, Workspace& workspace, OpenSwath::Spectrum& output);
   };
 }
 
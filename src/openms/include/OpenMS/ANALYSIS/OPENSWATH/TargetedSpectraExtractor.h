@@ -95,12 +95,13 @@ public:
       {
         scores.clear();
         const BinnedSpectrum in_bs(spec, bin_size_, false, peak_spread_, bin_offset_);
-        for (Size i = 0; i < bs_library_.size(); ++i)
+        // one-vs-library kernel: scatters the query once instead of a sparse-sparse product per library spectrum
+        const std::vector<double> all_scores = cmp_bs_.scoreAll(in_bs, bs_library_);
+        for (Size i = 0; i < all_scores.size(); ++i)
         {
-          const double cmp_score = cmp_bs_(in_bs, bs_library_[i]);
-          if (cmp_score >= min_score)
+          if (all_scores[i] >= min_score)
           {
-            scores.emplace_back(i, cmp_score);
+            scores.emplace_back(i, all_scores[i]);
           }
         }
       }
@@ -404,6 +405,8 @@ public:
       result of `extractSpectra()`, meaning they went (at least) through the process
       of peak picking.
 
+      The spectra are matched in parallel, i.e. `cmp.generateScores()` is called concurrently.
+
       @param[in] spectra The input spectra
       @param[in] cmp The `Comparator` object containing the spectral library
       @param[in,out] features The `FeatureMap` to be updated with matching info
@@ -208,6 +208,9 @@ private:
     */
     void writePQPOutput_(const char* filename, OpenMS::TargetedExperiment& targeted_exp);
 
+    /// Settings which influence the conversion (stored in snapshots, which are only valid for the same settings)
+    String getSnapshotOptions_(bool legacy_traml_id) const;
+
 public:
 
     //@{
@@ -244,6 +247,42 @@ public:
     */
     void convertPQPToTargetedExperiment(const char* filename, OpenSwath::LightTargetedExperiment& targeted_exp, bool legacy_traml_id = false);
 
+    /** @brief Read in a PQP file and construct a targeted experiment (Light transition structure), using a binary snapshot if possible
+     *
+     * Converting a large PQP file is slow, mostly because all modified peptide sequences need to be parsed.
+     * If an up-to-date snapshot of the converted library (see getSnapshotName()) exists, it is loaded instead.
+     * Otherwise, the PQP file is converted and, if @p write_snapshot is true, a snapshot is written for the next run
+     * (failures to write it, e.g. in read-only directories, are ignored).
+     *
+     * @param filename The input file
+     * @param targeted_exp The output targeted experiment
+     * @param legacy_traml_id Should legacy TraML IDs be used (boolean)?
+     * @param write_snapshot Write a snapshot if none could be loaded?
+     *
+    */
+    void convertPQPToTargetedExperimentCached(const char* filename, OpenSwath::LightTargetedExperiment& targeted_exp, bool legacy_traml_id = false, bool write_snapshot = true);
+
+    /** @brief Store a binary snapshot of the converted PQP file @p pqp_file
+     *
+     * The size and modification time of @p pqp_file as well as the conversion settings (parameters and @p legacy_traml_id)
+     * are stored as well, so loadSnapshot() can detect outdated snapshots. Strings are interned, i.e. each distinct string is stored only once.
+     *
+     * @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    void storeSnapshot(const String& snapshot_file, const String& pqp_file, const OpenSwath::LightTargetedExperiment& targeted_exp, bool legacy_traml_id = false) const;
+
+    /** @brief Load a binary snapshot of the converted PQP file @p pqp_file
+     *
+     * The transitions are decoded in parallel.
+     *
+     * @return false (and @p targeted_exp is empty) if @p snapshot_file does not exist, is not a valid snapshot,
+     * is outdated with respect to @p pqp_file or was written with different conversion settings
+    */
+    bool loadSnapshot(const String& snapshot_file, const String& pqp_file, OpenSwath::LightTargetedExperiment& targeted_exp, bool legacy_traml_id = false) const;
+
+    /// Name of the snapshot file of the PQP file @p pqp_file
+    static String getSnapshotName(const String& pqp_file);
+
   };
 }
 
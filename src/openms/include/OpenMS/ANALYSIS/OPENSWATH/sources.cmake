@@ -28,6 +28,7 @@ set(sources_list_h
   OpenSwathScoring.h
   OpenSwathTSVWriter.h
   OpenSwathOSWWriter.h
+  OpenSwathOutputQueue.h
   OpenSwathWorkflow.h
   PeakIntegrator.h
   PeakPickerChromatogram.h
@@ -182,6 +182,9 @@ public:
         Note that the method will update the list of featureConcentrations in place.  The resulting
         components_concentrations will reflect the optimal set of points for downstream QC/QA.
 
+      The calibration curves of the components are optimized in parallel.
+
+      @exception Exception::IllegalArgument if the optimization method is not supported
     */ 
     void optimizeCalibrationCurves(std::map<String,std::vector<AbsoluteQuantitationStandards::featureConcentration>> & components_concentrations);    
 
@@ -254,6 +257,9 @@ protected:
        leaving one point out to find the one which results in the maximum R^2
        of a first order linear regression of the remaining ones.
 
+      The correlation coefficients of all subsets are computed in closed form
+      from the co-moments of the weighted points (the model is fitted once).
+
       @param component_concentrations list of structures with features and concentrations
       @param feature_name name of the feature to calculate the absolute concentration.
       @param transformation_model model used to fit the calibration points
@@ -60,6 +60,9 @@ public:
     /**
       @brief Extracts the isobaric channels from the tandem MS data and stores intensity values in a consensus map.
 
+      The precursor purity and the reporter ion signals are computed for several spectra in parallel,
+      the consensus features are added to @p consensus_map in the order of the spectra.
+
       @param ms_exp_data Raw data to search for isobaric quantitation channels.
       @param consensus_map Output map containing the identified channels and the corresponding intensities.
     */
@@ -107,6 +110,19 @@ private:
       bool followUpValid(const double rt) const;
     };
 
+    /// Reporter ion signal of a single channel in a single spectrum (see findChannelSignals_)
+    struct ChannelSignal_
+    {
+      /// Indicates if a non-zero peak was found close to the channel
+      bool found = false;
+      /// Distance between expected and observed m/z of the peak closest to the channel
+      double mz_delta = 0.0;
+      /// Intensity of the closest peak
+      Peak2D::IntensityType intensity = 0;
+      /// Number of peaks within the allowed reporter mass shift
+      int peak_count = 0;
+    };
+
     /// The used quantitation method (itraq4plex, tmt6plex,..).
     const IsobaricQuantitationMethod* quant_method_;
 
@@ -174,6 +190,17 @@ private:
     */
     double computeSingleScanPrecursorPurity_(const PeakMap::ConstIterator& ms2_spec, const PeakMap::SpectrumType& precursor_spec) const;
 
+    /**
+      @brief Searches the non-zero peak closest to each channel of the quantitation method in @p spec.
+
+      Only reads from the members, so it can be called in parallel.
+
+      @param spec The MSn spectrum holding the reporter ions.
+      @param qc_dist_mz Maximum m/z distance of the peaks that are considered.
+      @param signals Output iterator, one entry per channel is written.
+    */
+    void findChannelSignals_(const PeakMap::SpectrumType& spec, const double qc_dist_mz, std::vector<ChannelSignal_>::iterator signals) const;
+
     /**
       @brief Get the first (of potentially many) activation methods (HCD,CID,...) of this spectrum.
 
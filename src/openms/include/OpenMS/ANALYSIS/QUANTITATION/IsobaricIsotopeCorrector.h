@@ -10,6 +10,8 @@
 
 #include <OpenMS/DATASTRUCTURES/Matrix.h>
 
+#include <map>
+
 // forward decl
 namespace Eigen
 {
@@ -39,6 +41,8 @@ public:
      @param consensus_map_out The map where the corrected values should be stored.
      @param quant_method IsobaricQuantitationMethod (e.g., iTRAQ 4 plex)
 
+     The consensus features are corrected in parallel; the results do not depend on the number of threads.
+
      @throws Exception::FailedAPICall If the least-squares fit fails.
      @throws Exception::InvalidParameter If the given correction matrix is invalid.
      */
@@ -47,13 +51,31 @@ public:
                                                                   const IsobaricQuantitationMethod* quant_method);
 
 private:
+    /// Comparison of the NNLS and the naive solution for a single consensus feature (see computeStats_)
+    struct SolutionComparison_
+    {
+      Size negative = 0; ///< number of channels where the naive solution was negative
+      Size different_count = 0; ///< number of channels where the naive solution differs by more than 1%
+      double different_intensity = 0; ///< absolute intensity difference of these channels
+      float cf_intensity = 0; ///< corrected intensity of the consensus feature
+    };
+
+    /**
+     @brief Returns the channel_id of the map with index @p map_index.
+
+     @throws Exception::MissingInformation if the map has no channel_id.
+     */
+    static Int channelIdOf_(const std::map<Size, Int>& channel_ids, Size map_index);
+
     /**
      @brief Fills the input vector for the Eigen/NNLS step given the ConsensusFeature.
+
+     @p channel_ids maps the map index of each element to its channel_id.
      */
     static void fillInputVector_(Eigen::VectorXd& b,
                                  Matrix<double>& m_b,
                                  const ConsensusFeature& cf,
-                                 const ConsensusMap& cm);
+                                 const std::map<Size, Int>& channel_ids);
 
     /**
      @brief
@@ -62,21 +84,29 @@ private:
                            const Matrix<double>& m_b, Matrix<double>& m_x);
 
     /**
-     @brief
+     @brief Compares the NNLS solution @p m_x to the naive solution @p x.
      */
-    static void computeStats_(const Matrix<double>& m_x,
-                              const Eigen::MatrixXd& x,
-                              const float cf_intensity,
-                              const IsobaricQuantitationMethod* quant_method,
+    static SolutionComparison_ compareSolutions_(const Matrix<double>& m_x,
+                                                 const Eigen::MatrixXd& x,
+                                                 const float cf_intensity,
+                                                 const IsobaricQuantitationMethod* quant_method);
+
+    /**
+     @brief Adds the @p comparison of a single consensus feature to @p stats.
+     */
+    static void computeStats_(const SolutionComparison_& comparison,
                               IsobaricQuantifierStatistics& stats);
 
     /**
-     @brief
+     @brief Writes the corrected intensities @p m_x to the consensus feature @p current_cf of the output map.
+
+     @p channel_ids maps the map index of each element to its channel_id in the output map.
      */
     static float updateOutpuMap_(const ConsensusMap& consensus_map_in,
                                  ConsensusMap& consensus_map_out,
                                  Size current_cf,
-                                 const Matrix<double>& m_x);
+                                 const Matrix<double>& m_x,
+                                 const std::map<Size, Int>& channel_ids);
   };
 } // namespace
 
@@ -13,8 +13,7 @@
 #include <OpenMS/KERNEL/Feature.h>
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 #include <OpenMS/ANALYSIS/MAPMATCHING/TransformationModelLowess.h>
-#include <OpenMS/DATASTRUCTURES/KDTree.h>
-#include <OpenMS/ANALYSIS/QUANTITATION/KDTreeFeatureNode.h>
+#include <OpenMS/DATASTRUCTURES/StaticKDTree.h>
 
 namespace OpenMS
 {
@@ -25,8 +24,11 @@ class OPENMS_DLLAPI KDTreeFeatureMaps : public DefaultParamHandler
 
 public:
 
-  /// 2D tree on features
-  typedef KDTree::KDTree<2,KDTreeFeatureNode> FeatureKDTree;
+  /// 2D tree on features (RT, m/z), storing feature indices
+  typedef StaticKDTree FeatureKDTree;
+
+  /// A query region (RT, m/z) for queryRegions()
+  typedef StaticKDTree::Box Region;
 
   /// Default constructor
   KDTreeFeatureMaps() :
@@ -45,6 +47,15 @@ public:
     addMaps(maps);
   }
 
+  /// Constructor for features from @p num_maps maps that are added later via addFeature() (call optimizeTree() afterwards)
+  KDTreeFeatureMaps(Size num_maps, const Param& param) :
+    DefaultParamHandler("KDTreeFeatureMaps"),
+    num_maps_(num_maps)
+  {
+    check_defaults_ = false;
+    setParameters(param);
+  }
+
   /// Destructor
   ~KDTreeFeatureMaps() override
   {
@@ -100,7 +111,7 @@ public:
   /// Clear all data
   void clear();
 
-  /// Optimize the kD tree
+  /// Bulk-load the kD tree with all features added since the last call (features added later are still found, but slower)
   void optimizeTree();
 
   /// Fill @p result with indices of all features compatible (wrt. RT, m/z, map index) to the feature with @p index
@@ -109,13 +120,19 @@ public:
   /// Fill @p result with indices of all features within the specified boundaries
   void queryRegion(double rt_low, double rt_high, double mz_low, double mz_high, std::vector<Size>& result_indices, Size ignored_map_index = std::numeric_limits<Size>::max()) const;
 
-  /// Apply RT transformations
+  /// Fill @p result_indices[i] with indices of all features within @p regions[i], like queryRegion() but for many regions at once (in parallel)
+  void queryRegions(const std::vector<Region>& regions, std::vector<std::vector<Size> >& result_indices, Size ignored_map_index = std::numeric_limits<Size>::max()) const;
+
+  /// Apply RT transformations (and rebuild the kD tree)
   void applyTransformations(const std::vector<TransformationModelLowess*>& trafos);
 
 protected:
 
   void updateMembers_() override;
 
+  /// Remove indices of features from map @p ignored_map_index (if not numeric_limits<Size>::max()) from @p indices
+  void filterMapIndex_(std::vector<Size>& indices, Size ignored_map_index) const;
+
   /// Feature data
   std::vector<const BaseFeature*> features_;
 
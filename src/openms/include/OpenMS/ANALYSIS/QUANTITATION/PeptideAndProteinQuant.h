@@ -204,15 +204,15 @@ private:
     /**
          @brief Gather quantitative information from a feature.
 
-         Store quantitative information from @p feature in member @p pep_quant_, based on the peptide annotation in @p hit. 
+         Store quantitative information from @p feature in @p data (the entry of member @p pep_quant_ for the peptide annotation in @p hit).
          @p fraction, use 0 for first fraction (or if no fractionation was performed)
          @p sample, use 0 for first sample, 1 for second, ... 
-         If @p hit is empty ("ambiguous/no annotation"), nothing is stored.
     */
     void quantifyFeature_(const FeatureHandle& feature, 
       size_t fraction, 
       size_t sample, 
-      const PeptideHit& hit);
+      const PeptideHit& hit,
+      PeptideData& data);
 
     /**
      *   @brief Determine fraction and charge state of a peptide with the highest
@@ -48,6 +48,16 @@ namespace OpenMS
      */
     int align(const String& seq1, const String& seq2);
 
+    /**
+     @brief Calculates the similarity scores of the global alignments of @p seq1 against each of the sequences in @p seqs2.
+
+     Returns the same scores as calling align(seq1, s) for every s in @p seqs2, but aligns up to eight sequences at once
+     (one per lane of a 128 bit SIMD register with 16 bit scores). Sequences are grouped by length to keep the lanes busy.
+     Pairs whose scores could exceed the 16 bit range, or which contain residues without a valid score (e.g. 'J', 'O',
+     'U'), are aligned with the scalar code.
+     */
+    std::vector<int> align(const String& seq1, const std::vector<String>& seqs2);
+
     /**
      @brief sets the scoring matrix. Takes either a string or the enum ScoringMatrix.
      @exception Exception: illegal argument is thrown if the input is not a member of the valid matrices.
@@ -211,6 +211,12 @@ namespace OpenMS
     /// This stores the patterns for harmonic reduction in binned dimension
     Matrix<int> harmonic_bin_offset_matrix_;
 
+    /// per mass bin buffers of updateCandidateMassBins_, kept between spectra so that they are not reallocated for every spectrum
+    std::vector<float> mass_intensities_;
+    std::vector<unsigned short> support_peak_count_;
+    std::vector<unsigned short> prev_charges_;
+    std::vector<float> prev_intensities_;
+
     /// minimum mass and mz values representing the first bin of massBin and mzBin, respectively: to save memory space
     double mass_bin_min_value_;
     double mz_bin_min_value_;
@@ -279,7 +285,7 @@ namespace OpenMS
      */
     void getCandidatePeakGroups_(const Matrix<int>& per_mass_abs_charge_ranges);
 
-    /// Make the universal pattern.
+    /// Make the universal pattern. The patterns do not depend on the spectrum, so they are only extended when a spectrum needs a larger charge range than all spectra before.
     void setFilters_();
 
     /// function for peak group scoring and filtering
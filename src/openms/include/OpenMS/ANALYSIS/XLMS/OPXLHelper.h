@@ -14,6 +14,7 @@
 #include <OpenMS/FORMAT/FASTAFile.h>
 #include <OpenMS/CHEMISTRY/EnzymaticDigestion.h>
 #include <OpenMS/CHEMISTRY/ModifiedPeptideGenerator.h>
+#include <functional>
 #include <numeric>
 
 namespace OpenMS
@@ -85,6 +86,18 @@ namespace OpenMS
        */
       static std::vector<OPXLDataStructs::XLPrecursor> enumerateCrossLinksAndMasses(const std::vector<OPXLDataStructs::AASeqWithMass>&  peptides, double cross_link_mass_light, const DoubleList& cross_link_mass_mono_link, const StringList& cross_link_residue1, const StringList& cross_link_residue2, const std::vector< double >& spectrum_precursors, std::vector< int >& precursor_correction_positions, double precursor_mass_tolerance, bool precursor_mass_tolerance_unit_ppm);
 
+      /**
+       * @brief Enumerates precursor masses for all candidates in an XL-MS search and passes each candidate to @p callback
+
+          Same as the overload above, but the candidates are not collected, so that callers can filter them on the fly with bounded memory.
+          For every precursor mass, loop-links, mono-links and cross-links are enumerated in this order; the beta peptides of cross-links
+          are determined by a single sweep over the sorted peptide masses (two pointers instead of binary searches per alpha peptide).
+          The enumeration is serial and deterministic, so it can be called from several threads at once (e.g. one per spectrum).
+
+       * @param callback Called with each candidate and the position of its precursor mass in @p spectrum_precursors
+       */
+      static void enumerateCrossLinksAndMasses(const std::vector<OPXLDataStructs::AASeqWithMass>&  peptides, double cross_link_mass_light, const DoubleList& cross_link_mass_mono_link, const StringList& cross_link_residue1, const StringList& cross_link_residue2, const std::vector< double >& spectrum_precursors, double precursor_mass_tolerance, bool precursor_mass_tolerance_unit_ppm, const std::function<void(const OPXLDataStructs::XLPrecursor&, int)>& callback);
+
       /**
        * @brief Digests a database with the given EnzymaticDigestion settings and precomputes masses for all peptides
 
@@ -0,0 +1,76 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/APPLICATIONS/TOPPBase.h>
+
+#include <functional>
+#include <memory>
+
+namespace OpenMS
+{
+  /**
+    @brief Runs a chain of TOPP tools within the current process, passing intermediate results in memory
+
+    Each step is a tool (an instance of a class derived from TOPPBase, created when the step runs)
+    with its command line arguments. Intermediate files are given in-memory file names
+    (InMemoryFileStore::PREFIX, e.g. "mem://picked.mzML"): tools write them to and read them
+    from the InMemoryFileStore via FileHandler, so no XML is written or parsed between steps.
+    All other file names are regular files, i.e. only the declared outputs are written to disk.
+
+    An in-memory file is removed from the store after the last step which references it (this
+    includes inputs stored by the caller), and all in-memory files referenced by the pipeline are
+    removed when run() returns.
+
+    @code
+    InProcessPipeline pipeline;
+    pipeline.addStep("PeakPickerHiRes", []() { return std::make_unique<TOPPPeakPickerHiRes>(); }, {"-in", "raw.mzML", "-out", "mem://picked.mzML"});
+    pipeline.addStep("FeatureFinderMetabo", []() { return std::make_unique<TOPPFeatureFinderMetabo>(); }, {"-in", "mem://picked.mzML", "-out", "features.featureXML"});
+    pipeline.run();
+    @endcode
+  */
+  class OPENMS_DLLAPI InProcessPipeline
+  {
+public:
+    /// Creates the tool of a step
+    using ToolFactory = std::function<std::unique_ptr<TOPPBase>()>;
+
+    /**
+      @brief Appends a step
+
+      @param name Name of the step (used in log messages)
+      @param factory Creates the tool
+      @param arguments Command line arguments of the tool (without the program name)
+    */
+    void addStep(const String& name, const ToolFactory& factory, const StringList& arguments);
+
+    /// Number of steps
+    Size size() const;
+
+    /**
+      @brief Runs all steps in order
+
+      Stops at the first step which fails.
+
+      @return The exit code of the failing step or TOPPBase::EXECUTION_OK
+    */
+    TOPPBase::ExitCodes run();
+
+private:
+    /// A tool with its arguments
+    struct Step
+    {
+      String name;
+      ToolFactory factory;
+      StringList arguments;
+    };
+
+    std::vector<Step> steps_;
+  };
+}
@@ -283,11 +283,14 @@ protected:
    * @param tr_type Input file type
    * @param tr_file Input file name
    * @param tsv_reader_param Parameters on how to interpret spectral data
+   * @param use_snapshot For PQP files: load the converted transitions from a binary snapshot of a previous run
+   *                     (or write one); see TransitionPQPFile::convertPQPToTargetedExperimentCached()
    *
    */
   OpenSwath::LightTargetedExperiment loadTransitionList(const FileTypes::Type& tr_type,
                                                         const String& tr_file,
-                                                        const Param& tsv_reader_param)
+                                                        const Param& tsv_reader_param,
+                                                        bool use_snapshot = false)
   {
     OpenSwath::LightTargetedExperiment transition_exp;
     ProgressLogger progresslogger;
@@ -303,7 +306,14 @@ protected:
     else if (tr_type == FileTypes::PQP)
     {
       progresslogger.startProgress(0, 1, "Load PQP file");
-      TransitionPQPFile().convertPQPToTargetedExperiment(tr_file.c_str(), transition_exp);
+      if (use_snapshot)
+      {
+        TransitionPQPFile().convertPQPToTargetedExperimentCached(tr_file.c_str(), transition_exp);
+      }
+      else
+      {
+        TransitionPQPFile().convertPQPToTargetedExperiment(tr_file.c_str(), transition_exp);
+      }
       progresslogger.endProgress();
     }
     else if (tr_type == FileTypes::TSV)
@@ -685,6 +685,17 @@ protected:
     /// Registers a flag
     void registerFlag_(const String& name, const String& description, bool advanced = false);
 
+    /**
+       @brief Registers the flag 'resume' for tools which checkpoint their completed work units
+
+       Tools processing their input in independent work units (e.g. the SWATH windows of @ref TOPP_OpenSwathWorkflow)
+       can record each completed unit in their output. With -resume, a run which was interrupted (e.g. a preempted job)
+       is continued from these checkpoints instead of starting over. Query the flag with getFlag_("resume").
+
+       @param units Description of the work units (plural, e.g. "SWATH windows")
+    */
+    void registerResumeFlag_(const String& units);
+
     /**
       @brief Registers an allowed subsection in the INI file (usually from OpenMS algorithms).
 
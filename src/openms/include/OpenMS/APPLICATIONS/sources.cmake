@@ -5,6 +5,7 @@ set(directory include/OpenMS/APPLICATIONS)
 set(sources_list_h
 ConsoleUtils.h
 INIUpdater.h
+InProcessPipeline.h
 MapAlignerBase.h
 OpenSwathBase.h
 ParameterInformation.h
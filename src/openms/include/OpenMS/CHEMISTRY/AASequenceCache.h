@@ -0,0 +1,77 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CHEMISTRY/AASequence.h>
+
+#include <memory>
+#include <unordered_map>
+
+namespace OpenMS
+{
+  /**
+      @brief Cache of parsed amino acid sequences (string to shared, immutable AASequence)
+
+      Identification files typically contain the same peptide sequences many
+      times (e.g. in the hits of different spectra). Parsing a sequence
+      string with AASequence::fromString() is much more expensive than
+      copying the resulting AASequence, so file loaders parse each distinct
+      string only once using this cache.
+
+      The cached sequences are immutable and can be shared with intern(). If
+      the cache grows beyond its maximum size it is cleared (sequences handed
+      out with intern() stay valid).
+
+      @note The cache itself is not thread safe, use one cache per thread
+      (e.g. per file that is loaded).
+
+      @ingroup Chemistry
+  */
+  class OPENMS_DLLAPI AASequenceCache
+  {
+public:
+    /**
+      @brief Constructor
+
+      @param max_size Maximum number of cached sequences (0 for no limit)
+      @param permissive Passed to AASequence::fromString()
+    */
+    explicit AASequenceCache(Size max_size = 1000000, bool permissive = true);
+
+    /**
+      @brief Returns the parsed sequence of @p s (parses it on the first request)
+
+      The reference is valid until the next call of a non-const member.
+
+      @throws Exception::ParseError if @p s is not a valid sequence (see AASequence::fromString())
+    */
+    const AASequence& fromString(const String& s);
+
+    /**
+      @brief Returns the parsed sequence of @p s as shared, immutable object (parses it on the first request)
+
+      @throws Exception::ParseError if @p s is not a valid sequence (see AASequence::fromString())
+    */
+    std::shared_ptr<const AASequence> intern(const String& s);
+
+    /// Number of cached sequences
+    Size size() const;
+
+    /// Removes all cached sequences
+    void clear();
+
+protected:
+    /// Maximum number of cached sequences (0 for no limit)
+    Size max_size_;
+    /// Passed to AASequence::fromString()
+    bool permissive_;
+    /// Parsed sequences by their string representation
+    std::unordered_map<String, std::shared_ptr<const AASequence> > sequences_;
+  };
+}
@@ -15,6 +15,9 @@
 
 #include <OpenMS/CONCEPT/Types.h>
 
+#include <boost/container/flat_map.hpp>
+#include <boost/container/small_vector.hpp>
+
 namespace OpenMS
 {
   class String;
@@ -53,14 +56,20 @@ namespace OpenMS
     are supported in different flavors. However, one must be careful, because this can lead to negative
     frequencies. In most cases this might be misleading, however, the class therefore supports difference
     formulae. E.g. formula differences of reactions from post-translational modifications.
+
+    The element counts are kept in a sorted flat map with inline storage for a few elements (enough for
+    CHNOPS and some isotopes), so the arithmetic operators do not allocate for typical formulae, and the
+    monoisotopic and average weights are cached. Modifying counts through the non-const iterators
+    disables the cache until the next modifying member function is called.
   */
 
   class OPENMS_DLLAPI EmpiricalFormula
   {
 
 protected:
-	  /// Internal typedef for the used map type
-	  typedef std::map<const Element*, SignedSize> MapType_;
+	  /// Internal typedef for the used map type (sorted by element pointer, no allocation for up to 8 elements)
+	  typedef boost::container::flat_map<const Element*, SignedSize, std::less<const Element*>,
+	                                     boost::container::small_vector<std::pair<const Element*, SignedSize>, 8> > MapType_;
 
 public:
     /** @name Typedefs
@@ -279,9 +288,9 @@ public:
 
     inline ConstIterator end() const { return formula_.end(); }
 
-    inline Iterator begin() { return formula_.begin(); }
+    inline Iterator begin() { weights_valid_ = false; return formula_.begin(); }
 
-    inline Iterator end() { return formula_.end(); }
+    inline Iterator end() { weights_valid_ = false; return formula_.end(); }
     //@}
 
     /** @name Static member functions
@@ -300,11 +309,26 @@ protected:
     /// remove elements with count 0
     void removeZeroedElements_();
 
+    /// recomputes the cached weights, must be called after formula_ or charge_ changed
+    void updateWeights_();
+
+    /// returns the element-wise sum @p a + @p factor * @p b without zero counts
+    static MapType_ merge_(const MapType_& a, const MapType_& b, SignedSize factor);
+
     MapType_ formula_;
 
     Int charge_;
 
-    Int parseFormula_(std::map<const Element*, SignedSize>& ef, const String& formula) const;
+    /// cached monoisotopic weight (valid if weights_valid_)
+    double mono_weight_ = 0.0;
+
+    /// cached average weight (valid if weights_valid_)
+    double average_weight_ = 0.0;
+
+    /// false after non-const iterators were handed out
+    bool weights_valid_ = true;
+
+    Int parseFormula_(MapType_& ef, const String& formula) const;
 
   };
 
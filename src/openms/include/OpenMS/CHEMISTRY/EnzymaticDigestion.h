@@ -119,6 +119,19 @@ namespace OpenMS
      */
     Size digestUnmodified(const StringView& sequence, std::vector<std::pair<Size, Size>>& output, Size min_length = 1, Size max_length = 0) const;
 
+    /**
+     @brief Performs the enzymatic digestion of several unmodified sequences in parallel.
+
+     Equivalent to calling the single sequence version for each of @p sequences (but using all threads).
+
+     @param sequences Sequences to digest
+     @param output Digestion products (start and length) for each sequence, in the order of @p sequences
+     @param min_length Minimal length of reported products
+     @param max_length Maximal length of reported products (0 = no restriction)
+     @return Total number of discarded digestion products (which are not matching length restrictions)
+     */
+    Size digestUnmodified(const std::vector<StringView>& sequences, std::vector<std::vector<std::pair<Size, Size>>>& output, Size min_length = 1, Size max_length = 0) const;
+
     /**
     @brief Is the peptide fragment starting at position @p pep_pos with length @p pep_length within the sequence @p protein generated by the current enzyme?
 
@@ -149,6 +162,13 @@ namespace OpenMS
     bool filterByMissedCleavages(const String& sequence, const std::function<bool(const Int)>& filter) const;
 
   protected:
+    /**
+      @brief Sets the regular expression (and the precompiled cleavage site matcher, if applicable) from the current enzyme
+
+      Must be called whenever @p enzyme_ changes.
+    */
+    void updateRegEx_();
+
     /**
       @brief supports functionality for ProteaseDigestion as well (which is deeply weaved into the function)
              To avoid code duplication, this is stored here and called by wrappers.
@@ -164,6 +184,10 @@ namespace OpenMS
     /**
       @brief Digests the sequence using the enzyme's regular expression
 
+      Most enzyme regular expressions only consist of lookbehind and lookahead assertions on character classes,
+      e.g. "(?<=[KR])(?!P)" for trypsin. These are precompiled into a table-driven matcher which tests each
+      position of @p sequence directly; all other expressions fall back to boost::regex.
+
       The resulting split positions include @p start as first position, but not end.
       If start is negative, it is reset to zero.
       If end is negative or beyond @p sequence's size(), it is set to size().
@@ -207,6 +231,10 @@ namespace OpenMS
     /// Regex for tokenizing (huge speedup by making this a member instead of stack object in tokenize_())
     std::unique_ptr<boost::regex> re_; // use PImpl, since #include cost is huge
 
+    /// Precompiled form of @p re_ (see tokenize_()); immutable and shared between copies; null if the regex is not supported
+    class CleavageSiteMatcher_;
+    std::shared_ptr<const CleavageSiteMatcher_> matcher_;
+
     /// specificity of enzyme
     Specificity specificity_;
   };
@@ -11,7 +11,9 @@
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopePatternGenerator.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopeDistribution.h>
 
+#include <memory>
 #include <set>
+#include <vector>
 
 namespace OpenMS
 {
@@ -71,6 +73,15 @@ namespace OpenMS
     * @note If you need fine isotope distributions, consider using the
     * FineIsotopePatternGenerator.
     *
+    * Results of run() are memoized in a global, thread-safe table keyed by
+    * the element composition, the charge, the max isotope and the round
+    * masses flag, so repeated requests for the same formula (e.g. from the
+    * averagine estimators, which round to integer atom counts) are not
+    * convolved again.
+    * For even faster averagine estimates, setAveragineGrid() precomputes
+    * distributions on a grid of weights which estimateFromPeptideWeight()
+    * then interpolates.
+    *
     * See also method run()
     **/
 
@@ -101,6 +112,29 @@ namespace OpenMS
 
     /// returns the current value of the flag to return expected masses (true) or atomic numbers (false).
     bool getRoundMasses() const;
+
+    /**
+      @brief Precomputes peptide averagine distributions every @p bin_width Da up to @p max_weight
+
+      Afterwards, estimateFromPeptideWeight() linearly interpolates (per isotope) between the two
+      neighbouring grid points for average weights in [@p bin_width, @p max_weight] instead of
+      estimating and convolving a formula. The grid is computed with the current max isotope and
+      round masses settings and is discarded when either of them changes.
+
+      @note The interpolated result is an approximation. Its deviation from the exact estimate shrinks with @p bin_width.
+
+      @throw Exception::InvalidValue if @p bin_width is not positive or @p max_weight is smaller than @p bin_width
+    */
+    void setAveragineGrid(double bin_width, double max_weight);
+
+    /// discards the averagine grid (see setAveragineGrid()), estimateFromPeptideWeight() is exact again
+    void clearAveragineGrid();
+
+    /// returns the bin width of the averagine grid, or 0 if there is none
+    double getAveragineGridBinWidth() const;
+
+    /// clears the global memo table of run() (e.g. after changing element isotope abundances)
+    static void clearCache();
     ///@}
 
     /**
@@ -175,6 +209,9 @@ namespace OpenMS
     */
     static std::vector<double> approximateIntensities(double mass, UInt num_peaks = 20);
 
+    /// Same as above, but writes the intensities to @p result (reusing its memory)
+    static void approximateIntensities(double mass, UInt num_peaks, std::vector<double>& result);
+
     /**
        @brief Estimate Nucleotide Isotopedistribution from weight and number of isotopes that should be reported
 
@@ -369,10 +406,20 @@ namespace OpenMS
     /// fill a gapped isotope pattern (i.e. certain masses are missing), with zero probability masses
     IsotopeDistribution::ContainerType fillGaps_(const IsotopeDistribution::ContainerType& id) const;
 
+    /// the uncached part of run(): convolves the element distributions of @p formula
+    IsotopeDistribution convolveFormula_(const EmpiricalFormula& formula) const;
+
+    /// interpolates the averagine grid at @p average_weight (must lie within the grid)
+    IsotopeDistribution interpolateAveragine_(double average_weight) const;
+
     /// maximal isotopes which is used to calculate the distribution
     Size max_isotope_;
     /// flag to determine whether masses should be rounded or not
     bool round_masses_;
+    /// bin width of the averagine grid (0 if there is none)
+    double averagine_bin_width_ = 0.0;
+    /// averagine distributions at weights (i + 1) * averagine_bin_width_ (shared between copies, never modified)
+    std::shared_ptr<const std::vector<IsotopeDistribution::ContainerType>> averagine_grid_;
 
   };
 
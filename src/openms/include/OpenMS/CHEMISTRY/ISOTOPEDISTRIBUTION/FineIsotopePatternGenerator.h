@@ -9,6 +9,10 @@
 #pragma once
 
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopePatternGenerator.h>
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopeDistribution.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <vector>
 
 namespace OpenMS
 {
@@ -138,6 +142,26 @@ namespace OpenMS
       **/
     IsotopeDistribution run(const EmpiricalFormula&) const override;
 
+    /**
+      * @brief Creates isotope distributions for many formulas at once
+      *
+      * The result is the same as calling run() for each of @p formulas, but
+      * the isotope tables of each element are converted to IsoSpec input only
+      * once per batch, formulas with the same string representation are only
+      * computed once and distinct formulas are computed in parallel.
+      *
+      * If @p cache_file is given and exists, distributions stored there by an
+      * earlier call with the same settings (threshold, total probability,
+      * absolute) are reused instead of being computed; a cache written with
+      * other settings is ignored. Afterwards @p cache_file is (re)written
+      * with all previously cached and newly computed distributions, keyed by
+      * EmpiricalFormula::toString().
+      *
+      * @throw Exception::ParseError if @p cache_file is malformed
+      * @throw Exception::UnableToCreateFile if @p cache_file cannot be written
+      **/
+    std::vector<IsotopeDistribution> runBatch(const std::vector<EmpiricalFormula>& formulas, const String& cache_file = "") const;
+
     /// Set probability stop condition (lower values generate fewer results)
     void setThreshold(double stop_condition)
     {
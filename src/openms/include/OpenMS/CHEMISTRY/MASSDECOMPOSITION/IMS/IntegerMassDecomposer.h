@@ -101,6 +101,23 @@ public:
       */
       decomposition_value_type getNumberOfDecompositions(value_type mass) override;
 
+      /**
+        Calls @p visitor with every possible decomposition for @p mass (in the
+        order of getAllDecompositions()), without storing them.
+
+        The decomposer is not modified, so several threads may visit
+        decompositions concurrently.
+
+        @param mass Mass to be decomposed.
+        @param visitor Callable taking a <tt>const decomposition_type&</tt>. The reference is only valid during the call.
+      */
+      template <typename Visitor>
+      void visitDecompositions(value_type mass, Visitor& visitor) const
+      {
+        decomposition_type decomposition(alphabet_.size());
+        visitDecompositionsRecursively_(mass, alphabet_.size() - 1, decomposition, visitor);
+      }
+
 private:
 
       /**
@@ -162,15 +179,16 @@ private:
                                      witness_vector_type & _witness_vector, residues_table_type & _ertable);
 
       /**
-        Collects decompositions for @c mass by recursion.
+        Visits decompositions for @c mass by recursion.
 
         @param mass Mass to be decomposed.
         @param alphabetMassIndex An index of the mass in alphabet that is used on this step of recursion.
-        @param decomposition Decomposition which is calculated on this step of recursion.
-        @param decompositionsStore Container where decompositions are collected.
+        @param decomposition Decomposition which is calculated on this step of recursion (entries up to @p alphabetMassIndex are overwritten).
+        @param visitor Callable which is passed every complete decomposition.
       */
-      void collectDecompositionsRecursively_(value_type mass, size_type alphabetMassIndex,
-                                             decomposition_type decomposition, decompositions_type & decompositionsStore);
+      template <typename Visitor>
+      void visitDecompositionsRecursively_(value_type mass, size_type alphabetMassIndex,
+                                           decomposition_type & decomposition, Visitor & visitor) const;
     };
 
 
@@ -437,15 +455,16 @@ private:
     IntegerMassDecomposer<ValueType, DecompositionValueType>::getAllDecompositions(value_type mass)
     {
       decompositions_type decompositionsStore;
-      decomposition_type decomposition(alphabet_.size());
-      collectDecompositionsRecursively_(mass, alphabet_.size() - 1, decomposition, decompositionsStore);
+      auto store = [&decompositionsStore](const decomposition_type & decomposition) { decompositionsStore.push_back(decomposition); };
+      visitDecompositions(mass, store);
       return decompositionsStore;
     }
 
     template <typename ValueType, typename DecompositionValueType>
+    template <typename Visitor>
     void IntegerMassDecomposer<ValueType, DecompositionValueType>::
-    collectDecompositionsRecursively_(value_type mass, size_type alphabetMassIndex,
-                                      decomposition_type decomposition, decompositions_type & decompositionsStore)
+    visitDecompositionsRecursively_(value_type mass, size_type alphabetMassIndex,
+                                    decomposition_type & decomposition, Visitor & visitor) const
     {
       if (alphabetMassIndex == 0)
       {
@@ -453,7 +472,7 @@ private:
         if (numberOfMasses0 * alphabet_.getWeight(0) == mass)
         {
           decomposition[0] = static_cast<decomposition_value_type>(numberOfMasses0);
-          decompositionsStore.push_back(decomposition);
+          visitor(static_cast<const decomposition_type &>(decomposition));
         }
         return;
       }
@@ -489,7 +508,7 @@ private:
             // the condition of the 'for' loop (m >= r) and decrementing the mass
             // in steps of the lcm ensures that m is decomposable. Therefore
             // the recursion will result in at least one witness.
-            collectDecompositionsRecursively_(m, alphabetMassIndex - 1, decomposition, decompositionsStore);
+            visitDecompositionsRecursively_(m, alphabetMassIndex - 1, decomposition, visitor);
             decomposition[alphabetMassIndex] += mass_in_lcm;
             // this check is needed because mass could have unsigned type and after reduction on i*alphabetMass will be still be positive but huge
             // and that will end up in infinite loop
@@ -523,7 +542,10 @@ private:
     typename IntegerMassDecomposer<ValueType, DecompositionValueType>::decomposition_value_type IntegerMassDecomposer<ValueType,
                                                                                                                       DecompositionValueType>::getNumberOfDecompositions(value_type mass)
     {
-      return static_cast<typename IntegerMassDecomposer<ValueType, DecompositionValueType>::decomposition_value_type>(getAllDecompositions(mass).size());
+      decomposition_value_type number_of_decompositions = 0;
+      auto count = [&number_of_decompositions](const decomposition_type &) { ++number_of_decompositions; };
+      visitDecompositions(mass, count);
+      return number_of_decompositions;
     }
 
   } // namespace ims
@@ -36,6 +36,9 @@ namespace OpenMS
       them using @c IntegerMassDecomposer, does some checks (i.e. on false
       positives appeared due to rounding) and collects decompositions together.
 
+      The extended residue table is built once in the constructor, all
+      queries only read it and can therefore be run in parallel.
+
       @author Anton Pervukhin <Anton.Pervukhin@CeBiTec.Uni-Bielefeld.DE>
     */
     class OPENMS_DLLAPI RealMassDecomposer
@@ -70,9 +73,9 @@ public:
         @param error Error allowed between given and result decomposition.
         @return All possible decompositions for a given mass and error.
       */
-      decompositions_type getDecompositions(double mass, double error);
+      decompositions_type getDecompositions(double mass, double error) const;
 
-      decompositions_type getDecompositions(double mass, double error, const constraints_type & constraints);
+      decompositions_type getDecompositions(double mass, double error, const constraints_type & constraints) const;
 
       /**
        Gets a number of all decompositions for a @c mass with an @c error
@@ -83,7 +86,7 @@ public:
        @param error Error allowed between given and result decomposition.
        @return Number of all decompositions for a given mass and error.
       */
-      number_of_decompositions_type getNumberOfDecompositions(double mass, double error);
+      number_of_decompositions_type getNumberOfDecompositions(double mass, double error) const;
 
 private:
       /// Weights over which values/masses to be decomposed.
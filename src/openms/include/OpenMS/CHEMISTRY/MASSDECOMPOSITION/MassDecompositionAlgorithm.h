@@ -61,12 +61,29 @@ public:
     //@{
     /// returns the possible decompositions given the weight
     void getDecompositions(std::vector<MassDecomposition> & decomps, double weight);
+
+    /**
+      @brief returns the possible decompositions for each of the given @p weights
+
+      The extended residue table is built only once (when the parameters are set) and the
+      weights are decomposed in parallel. @p decomps is resized to the number of weights.
+    */
+    void getDecompositions(std::vector<std::vector<MassDecomposition> > & decomps, const std::vector<double> & weights) const;
+
+    /// returns the number of possible decompositions given the weight, without creating them (for weights above the tolerance it equals the size of getDecompositions())
+    Size getNumberOfDecompositions(double weight) const;
+
+    /// returns the number of possible decompositions for each of the given @p weights (computed in parallel)
+    std::vector<Size> getNumberOfDecompositions(const std::vector<double> & weights) const;
     //@}
 
 protected:
 
     void updateMembers_() override;
 
+    /// converts the decompositions of the IMS decomposer to MassDecomposition objects and appends them to @p decomps
+    void appendDecompositions_(const ims::RealMassDecomposer::decompositions_type & decompositions, std::vector<MassDecomposition> & decomps) const;
+
     ims::IMSAlphabet * alphabet_;
 
     ims::RealMassDecomposer * decomposer_;
@@ -14,6 +14,7 @@
 
 #include <set>
 #include <memory>  // unique_ptr
+#include <shared_mutex>
 #include <unordered_map>
 
 namespace OpenMS
@@ -45,6 +46,9 @@ namespace OpenMS
       databases. This can be done by providing a path through
       initializeModificationsDB(), however it is important that this is done
       *before* the first call to getInstance().
+
+      All methods are thread safe: lookups take a shared (reader) lock and run
+      concurrently, only adding modifications takes an exclusive lock.
   */
   class OPENMS_DLLAPI ModificationsDB
   {
@@ -222,6 +226,9 @@ public:
     /// Stores the mappings of (unique) names to the modifications
     std::unordered_map<String, std::set<const ResidueModification*> > modification_names_;
 
+    /// Guards mods_ and modification_names_ (shared for lookups, exclusive for adding modifications)
+    mutable std::shared_mutex mutex_;
+
     /** @brief Helper function to check if a residue matches the origin for a modification
      *
      * Special cases are handled as follows:
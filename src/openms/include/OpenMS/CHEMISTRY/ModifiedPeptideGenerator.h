@@ -13,6 +13,7 @@
 
 #include <OpenMS/CHEMISTRY/ResidueModification.h>
 #include <OpenMS/CHEMISTRY/AASequence.h>
+#include <functional>
 #include <vector>
 #include <map>
 #include <unordered_map>
@@ -30,6 +31,17 @@ namespace OpenMS
     // struct needed to wrap the template for pyOpenMS
     struct MapToResidueType { std::unordered_map<const ResidueModification*, const Residue*> val; };
 
+    /// A variable modification that can be placed at a position of a peptide (see getVariableModificationSites())
+    struct ModificationSite
+    {
+      int index; ///< residue index (or internal index for terminal modifications)
+      const ResidueModification* modification;
+      double mono_mass_delta; ///< change of the monoisotopic weight of the peptide by the modification
+    };
+
+    /// Called for each enumerated variant with its monoisotopic weight and the indices of its modification sites
+    using VariantCallback = std::function<void(double mono_weight, const std::vector<Size>& chosen_sites)>;
+
       /**
       * @brief Retrieve modifications from strings
       * 
@@ -55,6 +67,49 @@ namespace OpenMS
      std::vector<AASequence>& all_modified_peptides, 
      bool keep_original=true);
 
+    /**
+      @brief Collects all positions of @p peptide where a variable modification can be placed
+
+      Together with enumerateVariableModifications() and applyVariableModificationSites() this allows
+      to enumerate the same variants as applyVariableModifications() without creating an AASequence
+      for each of them, e.g. to only create the variants that match a precursor mass.
+
+      @param var_mods The variable modifications
+      @param peptide The peptide (with fixed modifications already applied)
+      @param sites The modification sites (grouped by position)
+    */
+    static void getVariableModificationSites(
+      const MapToResidueType& var_mods,
+      const AASequence& peptide,
+      std::vector<ModificationSite>& sites);
+
+    /**
+      @brief Enumerates all variants with up to @p max_variable_mods_per_peptide modifications at different positions
+
+      The monoisotopic weight of each variant is updated incrementally from @p mono_weight (the weight of the
+      unmodified peptide), no sequences are created. The order of the variants is deterministic (the same for
+      the same @p sites), but differs from applyVariableModifications().
+
+      @param sites The modification sites (see getVariableModificationSites())
+      @param mono_weight Monoisotopic weight of the peptide without variable modifications
+      @param max_variable_mods_per_peptide Maximum number of variable modifications per variant
+      @param callback Called for each variant
+      @param keep_original Whether the variant without variable modifications is enumerated (first)
+    */
+    static void enumerateVariableModifications(
+      const std::vector<ModificationSite>& sites,
+      double mono_weight,
+      Size max_variable_mods_per_peptide,
+      const VariantCallback& callback,
+      bool keep_original=true);
+
+    /// Creates the variant of @p peptide with the modifications of the @p chosen_sites (indices into @p sites, see enumerateVariableModifications())
+    static AASequence applyVariableModificationSites(
+      const MapToResidueType& var_mods,
+      const AASequence& peptide,
+      const std::vector<ModificationSite>& sites,
+      const std::vector<Size>& chosen_sites);
+
   protected:
     static const int N_TERM_MODIFICATION_INDEX; // magic constant to distinguish N_TERM only modifications from ANYWHERE modifications placed at N-term residue
     static const int C_TERM_MODIFICATION_INDEX; // magic constant to distinguish C_TERM only modifications from ANYWHERE modifications placed at C-term residue
@@ -69,7 +124,15 @@ namespace OpenMS
       std::vector<AASequence>& all_modified_peptides, 
       bool keep_original=true);
 
+    // builds the mapping from peptide index (or terminal index) to the compatible modifications (skips already modified residues)
+    static void getModificationCompatibility_(
+      const MapToResidueType& var_mods,
+      const AASequence& peptide,
+      std::map<int, std::vector<const ResidueModification*> >& mod_compatibility);
+
   private:
+    /// enumerates all variants that extend @p chosen by sites starting at @p first_site (depth-first)
+    static void enumerateVariants_(const std::vector<ModificationSite>& sites, Size first_site, double mono_weight, Size max_variable_mods_per_peptide, std::vector<Size>& chosen, const VariantCallback& callback);
     /// take a vector of AASequences @p original_sequences, and for each mod in @p mods, add a version with mod at index @p idx_to_modify. In-place, with the original sequences recieving the first mod in @p mods.
     static void applyAllModsAtIdxAndExtend_(std::vector<AASequence>& original_sequences, int idx_to_modify, const std::vector<const ResidueModification*>& mods, const MapToResidueType& var_mods);
     /// applies a modification @p m to the @p current_peptide at @p current_index. Overwrites mod if it exists. Looks up in var_mods for existing modified Residue pointers.
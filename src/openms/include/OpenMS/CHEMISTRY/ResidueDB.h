@@ -15,6 +15,7 @@
 #include <map>
 #include <set>
 #include <array>
+#include <shared_mutex>
 
 namespace OpenMS
 {
@@ -27,6 +28,11 @@ namespace OpenMS
       @brief OpenMS stores a central database of all residues in the ResidueDB.
       All (unmodified) residues are added to the database on construction.
       Modified residues get created and added if getModifiedResidue is called.
+
+      All methods are thread safe. The unmodified residues are never changed
+      after construction and are accessed without locking; lookups of existing
+      modified residues only take a shared (reader) lock, so concurrent
+      threads only wait for each other if a new modified residue is created.
   */
   class OPENMS_DLLAPI ResidueDB
   {
@@ -151,6 +157,12 @@ protected:
 
     /// adds names of single modified residue to the index
     void addModifiedResidueNames_(const Residue*);
+
+    /// returns the modified residue with (unmodified) name @p res_name and modification @p mod_id or nullptr if not present (requires a lock of modified_residues_mutex_)
+    const Residue* findModifiedResidue_(const String& res_name, const String& mod_id) const;
+
+    /// returns the residue @p res_name modified by @p mod, creates and adds it if it doesn't exist yet
+    const Residue* getOrAddModifiedResidue_(const String& res_name, const ResidueModification* mod);
     
     std::map<String, std::map<String, const Residue*> > residue_mod_names_;
 
@@ -169,5 +181,8 @@ protected:
     std::array<const Residue*, 256> residue_by_one_letter_code_ = {{nullptr}};
 
     std::map<String, std::set<const Residue*> > residues_by_set_;    
+
+    /// guards the modified residues (const_modified_residues_ and residue_mod_names_)
+    mutable std::shared_mutex modified_residues_mutex_;
   };
 }
@@ -10,6 +10,8 @@
 
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 #include <map>
+#include <utility>
+#include <vector>
 
 namespace OpenMS
 {
@@ -85,10 +87,21 @@ namespace OpenMS
       size_t min_charge_; ///< minimal fragment charge
       size_t max_charge_; ///< maximal fragment charge
       std::map<double, char> mass2aa_; ///< mapping of residue masses to their one letter codes
+      std::vector<double> aa_masses_; ///< sorted residue masses (keys of mass2aa_, as a flat lookup table)
+      std::vector<char> aa_codes_; ///< one letter codes of aa_masses_
 
-      /// get a residue one letter code by matching the mass @p m to the map of residues mass2aa_, returns ' ' if there is no match
+      /// Edges of the peak graph of one charge: peak pairs whose mass difference matches a residue, in CSR format
+      struct PeakGraph_
+      {
+        std::vector<size_t> first_edge; ///< edges of peak i are [first_edge[i], first_edge[i + 1])
+        std::vector<std::pair<size_t, char> > edges; ///< target peak and residue
+      };
+
+      /// get a residue one letter code by matching the mass @p m to the lookup table of residues, returns ' ' if there is no match
       char getAAByMass_(double m) const;
-      /// start searching for tags starting from peak @p i of the mz vector @p mzs
-      void getTag_(std::string& tag, const std::vector<double>& mzs, const size_t i, std::vector<std::string>& tags, const size_t charge) const;
+      /// find all peak pairs of @p mzs whose mass difference at charge @p charge matches a residue (each pair is only compared once)
+      void buildPeakGraph_(const std::vector<double>& mzs, const size_t charge, PeakGraph_& graph) const;
+      /// start searching for tags starting from peak @p i of the peak graph
+      void getTag_(std::string& tag, const PeakGraph_& graph, const size_t i, std::vector<std::string>& tags) const;
   };
 }
@@ -85,6 +85,9 @@ namespace OpenMS
     /// adds peaks to a spectrum of the given ion-type, peptide, charge, and intensity, also adds charges and ion names to the DataArrays, if the add_metainfo parameter is set to true
     virtual void addPeaks_(PeakSpectrum& spectrum, const AASequence& peptide, DataArrays::StringDataArray& ion_names, DataArrays::IntegerDataArray& charges, MSSpectrum::Chunks& chunks, const Residue::ResidueType res_type, Int charge = 1) const;
 
+    /// adds the unannotated single-peak ladders of all ion types and charges (i.e. without isotopes, losses and meta info) using precomputed prefix and suffix masses
+    void addPeaksFast_(PeakSpectrum& spectrum, const AASequence& peptide, MSSpectrum::Chunks& chunks, Int min_charge, Int max_charge) const;
+
     /// adds the precursor peaks to the spectrum, also adds charges and ion names to the DataArrays, if the add_metainfo parameter is set to true
     virtual void addPrecursorPeaks_(PeakSpectrum& spec, const AASequence& peptide, DataArrays::StringDataArray& ion_names, DataArrays::IntegerDataArray& charges, Int charge = 1) const;
 
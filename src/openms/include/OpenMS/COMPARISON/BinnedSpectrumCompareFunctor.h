@@ -13,6 +13,8 @@
 #include <OpenMS/KERNEL/BinnedSpectrum.h>
 
 #include <cmath>
+#include <utility>
+#include <vector>
 
 namespace OpenMS
 {
@@ -52,6 +54,38 @@ public:
     /// function call operator, calculates self similarity
     virtual double operator()(const BinnedSpectrum& spec) const = 0;
 
+    /**
+      @brief Calculates the similarity of @p query to each spectrum of @p library (in parallel)
+
+      The default implementation calls the pairwise operator for each library spectrum. Derived classes
+      override it with a kernel that scatters the query into dense arrays once and scores each library
+      spectrum by a single pass over its filled bins.
+
+      @param query Spectrum to compare
+      @param library Spectra to compare against (binned compatibly to @p query)
+      @return Similarity scores in the order of @p library
+    */
+    virtual std::vector<double> scoreAll(const BinnedSpectrum& query, const std::vector<BinnedSpectrum>& library) const;
+
+    /**
+      @brief Finds the @p k spectra of @p library most similar to @p query
+
+      @return Pairs of library index and score, best first (ties are ordered by index; NaN scores rank last)
+    */
+    std::vector<std::pair<Size, double>> topK(const BinnedSpectrum& query, const std::vector<BinnedSpectrum>& library, Size k) const;
+
+  protected:
+    /// The bins of a query spectrum scattered into dense arrays (indexed by bin), see scoreAll()
+    struct DenseQuery_
+    {
+      explicit DenseQuery_(const BinnedSpectrum& spec);
+
+      /// intensity of each bin (zero if not filled)
+      std::vector<float> intensity;
+      /// is the bin filled (i.e. stored in the sparse vector)?
+      std::vector<char> filled;
+    };
+
   };
 
 }
@@ -63,6 +63,9 @@ public:
     /// function call operator, calculates self similarity
     double operator()(const BinnedSpectrum& spec) const override;
 
+    /// calculates the similarity of @p query to each spectrum of @p library (sums agreeing intensities with the scattered query, in parallel)
+    std::vector<double> scoreAll(const BinnedSpectrum& query, const std::vector<BinnedSpectrum>& library) const override;
+
 protected:
     void updateMembers_() override;
     double precursor_mass_tolerance_;
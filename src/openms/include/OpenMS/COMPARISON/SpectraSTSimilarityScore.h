@@ -78,7 +78,7 @@ public:
 
 
     ///spectrum is transformed into a binned spectrum with bin size 1 and spread 1 and the intensities are normalized.
-    BinnedSpectrum transform(const PeakSpectrum & spec);
+    BinnedSpectrum transform(const PeakSpectrum & spec) const;
 
     /**
         @brief Calculates how much of the dot product is dominated by a few peaks
@@ -99,7 +99,7 @@ public:
 
         @note Range of the dot products is between 0 and 1.
     */
-    double delta_D(double top_hit, double runner_up);
+    double delta_D(double top_hit, double runner_up) const;
 
     /**
         @brief computes the overall all score
@@ -109,7 +109,7 @@ public:
 
         @return the SpectraST similarity score
     */
-    double compute_F(double dot_product, double delta_D, double dot_bias);
+    double compute_F(double dot_product, double delta_D, double dot_bias) const;
 
 protected:
 
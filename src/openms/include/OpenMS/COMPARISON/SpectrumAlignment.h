@@ -72,32 +72,44 @@ public:
 
       if (!param_.getValue("is_relative_tolerance").toBool() )
       {
-        std::map<Size, std::map<Size, std::pair<Size, Size> > > traceback;
-        std::map<Size, std::map<Size, double> > matrix;
-
-        // init the matrix with "gap costs" tolerance
-        matrix[0][0] = 0;
-        for (Size i = 1; i <= s1.size(); ++i)
-        {
-          matrix[i][0] = i * tolerance;
-          traceback[i][0]  = std::make_pair(i - 1, 0);
-        }
-        for (Size j = 1; j <= s2.size(); ++j)
+        // The matrix is only filled within the band. Besides column 0, every row i >= 1 holds the
+        // contiguous columns [first_col[i], first_col[i] + row length) that were visited, stored
+        // in flat arrays (row i starts at row_start[i]); cells outside the band are "missing".
+        const Size n1 = s1.size();
+        const Size n2 = s2.size();
+        std::vector<Size> first_col(n1 + 1, 0), row_start(n1 + 2, 0);
+        std::vector<double> scores;
+        std::vector<unsigned char> moves; // traceback: DIAGONAL (i - 1, j - 1), UP (i, j - 1), LEFT (i - 1, j)
+        enum : unsigned char { DIAGONAL, UP, LEFT };
+
+        // matrix value of cell (i, j); false if it was not computed
+        auto cell = [&](Size i, Size j, double& value)
         {
-          matrix[0][j] = j * tolerance;
-          traceback[0][j] = std::make_pair(0, j - 1);
-        }
+          if (i == 0 || j == 0)
+          {
+            value = (i + j) * tolerance; // "gap costs" (matrix[0][0] = 0)
+            return true;
+          }
+          if (j < first_col[i] || j >= first_col[i] + (row_start[i + 1] - row_start[i]))
+          {
+            return false;
+          }
+          value = scores[row_start[i] + j - first_col[i]];
+          return true;
+        };
 
         // fill in the matrix
         Size left_ptr(1);
         Size last_i(0), last_j(0);
 
-        //Size off_band_counter(0);
-        for (Size i = 1; i <= s1.size(); ++i)
+        for (Size i = 1; i <= n1; ++i)
         {
           double pos1(s1[i - 1].getMZ());
+          first_col[i] = left_ptr;
+          row_start[i] = scores.size();
+          row_start[i + 1] = scores.size();
 
-          for (Size j = left_ptr; j <= s2.size(); ++j)
+          for (Size j = left_ptr; j <= n2; ++j)
           {
             bool off_band(false);
             // find min of the three possible directions
@@ -107,7 +119,7 @@ public:
             // running off the right border of the band?
             if (pos2 > pos1 && diff_align > tolerance)
             {
-              if (i < s1.size() && j < s2.size() && s1[i].getMZ() < pos2)
+              if (i < n1 && j < n2 && s1[i].getMZ() < pos2)
               {
                 off_band = true;
               }
@@ -119,166 +131,79 @@ public:
               ++left_ptr;
             }
 
+            double value;
             double score_align = diff_align;
-
-            if (matrix.find(i - 1) != matrix.end() && matrix[i - 1].find(j - 1) != matrix[i - 1].end())
-            {
-              score_align += matrix[i - 1][j - 1];
-            }
-            else
-            {
-              score_align += (i - 1 + j - 1) * tolerance;
-            }
+            score_align += cell(i - 1, j - 1, value) ? value : (i - 1 + j - 1) * tolerance;
 
             double score_up = tolerance;
-            if (matrix.find(i) != matrix.end() && matrix[i].find(j - 1) != matrix[i].end())
-            {
-              score_up += matrix[i][j - 1];
-            }
-            else
-            {
-              score_up += (i + j - 1) * tolerance;
-            }
+            score_up += cell(i, j - 1, value) ? value : (i + j - 1) * tolerance;
 
             double score_left = tolerance;
-            if (matrix.find(i - 1) != matrix.end() && matrix[i - 1].find(j) != matrix[i - 1].end())
-            {
-              score_left += matrix[i - 1][j];
-            }
-            else
-            {
-              score_left += (i - 1 + j) * tolerance;
-            }
+            score_left += cell(i - 1, j, value) ? value : (i - 1 + j) * tolerance;
 
     #ifdef ALIGNMENT_DEBUG
-          cerr << i << " " << j << " " << left_ptr << " " << pos1 << " " << pos2 << " " << score_align << " " << score_left << " " << score_up << endl;
+          std::cerr << i << " " << j << " " << left_ptr << " " << pos1 << " " << pos2 << " " << score_align << " " << score_left << " " << score_up << std::endl;
     #endif
 
-          if (score_align <= score_up && score_align <= score_left && diff_align <= tolerance)
-          {
-             matrix[i][j] = score_align;
-             traceback[i][j] = std::make_pair(i - 1, j - 1);
-             last_i = i;
-             last_j = j;
-          }
-          else
-          {
-            if (score_up <= score_left)
+            if (score_align <= score_up && score_align <= score_left && diff_align <= tolerance)
             {
-              matrix[i][j] = score_up;
-              traceback[i][j] = std::make_pair(i, j - 1);
+              scores.push_back(score_align);
+              moves.push_back(DIAGONAL);
+              last_i = i;
+              last_j = j;
+            }
+            else if (score_up <= score_left)
+            {
+              scores.push_back(score_up);
+              moves.push_back(UP);
             }
             else
             {
-              matrix[i][j] = score_left;
-              traceback[i][j] = std::make_pair(i - 1, j);
+              scores.push_back(score_left);
+              moves.push_back(LEFT);
             }
-          }
+            row_start[i + 1] = scores.size();
 
-          if (off_band)
-          {
-            break;
+            if (off_band)
+            {
+              break;
+            }
           }
         }
-      }
-
-          //last_i = s1.size() + 1;
-          //last_j = s2.size() + 1;
 
-          //cerr << last_i << " " << last_j << endl;
+        // do traceback
+        Size i = last_i;
+        Size j = last_j;
 
-    #ifdef ALIGNMENT_DEBUG
-    #if 0
-          cerr << "TheMatrix: " << endl << " \t  \t";
-          for (Size j = 0; j != s2.size(); ++j)
-          {
-        cerr << s2[j].getPosition()[0] << " \t";
-          }
-          cerr << endl;
-          for (Size i = 0; i <= s1.size(); ++i)
-          {
-        if (i != 0)
+        while (i >= 1 && j >= 1)
         {
-          cerr << s1[i - 1].getPosition()[0] << " \t";
-        }
-        else
-        {
-          cerr << " \t";
-        }
-        for (Size j = 0; j <= s2.size(); ++j)
-        {
-          if (matrix.has(i) && matrix[i].has(j))
+          double value;
+          if (!cell(i, j, value))
           {
-            if (traceback[i][j].first == i - 1 && traceback[i][j].second == j - 1)
-            {
-              cerr << "\\";
-            }
-            else
+            // cell outside of the band: traceback (0, 0)
+            if (i == 1 && j == 1)
             {
-              if (traceback[i][j].first == i - 1 && traceback[i][j].second == j)
-              {
-            cerr << "|";
-              }
-              else
-              {
-            cerr << "-";
-              }
+              alignment.push_back(std::make_pair(0, 0));
             }
-
-            cerr << matrix[i][j] << "  \t";
+            break;
           }
-          else
+          switch (moves[row_start[i] + j - first_col[i]])
           {
-            cerr << "-1  \t";
+            case DIAGONAL:
+              alignment.push_back(std::make_pair(i - 1, j - 1));
+              --i;
+              --j;
+              break;
+            case UP:
+              --j;
+              break;
+            default:
+              --i;
+              break;
           }
         }
-        cerr << endl;
-          }
-    #endif
-    #endif
-
-      // do traceback
-      Size i = last_i;
-      Size j = last_j;
-
-      while (i >= 1 && j >= 1)
-      {
-        if (traceback[i][j].first == i - 1 && traceback[i][j].second == j - 1)
-        {
-          alignment.push_back(std::make_pair(i - 1, j - 1));
-        }
-        Size new_i = traceback[i][j].first;
-        Size new_j = traceback[i][j].second;
-
-        i = new_i;
-        j = new_j;
-      }
 
-      std::reverse(alignment.begin(), alignment.end());
-
-      #ifdef ALIGNMENT_DEBUG
-      #if 0
-          // print alignment
-          cerr << "Alignment (size=" << alignment.size() << "): " << endl;
-
-          Size i_s1(0), i_s2(0);
-          for (vector<pair<Size, Size> >::const_reverse_iterator it = alignment.rbegin(); it != alignment.rend(); ++it, ++i_s1, ++i_s2)
-          {
-        while (i_s1 < it->first - 1)
-        {
-          cerr << i_s1 << " " << s1[i_s1].getPosition()[0] << " " << s1[i_s1].getIntensity() << endl;
-          i_s1++;
-        }
-        while (i_s2 < it->second - 1)
-        {
-          cerr << " \t " <<  i_s2 << " " << s2[i_s2].getPosition()[0] << " " << s2[i_s2].getIntensity() << endl;
-          i_s2++;
-        }
-        cerr << "(" << s1[it->first - 1].getPosition()[0] << " <-> " << s2[it->second - 1].getPosition()[0] << ") ("
-             << it->first << "|" << it->second << ") (" << s1[it->first - 1].getIntensity() << "|" << s2[it->second - 1].getIntensity() << ")" << endl;
-          }
-      #endif
-      #endif
+        std::reverse(alignment.begin(), alignment.end());
       }
       else  // relative alignment (ppm tolerance)
       {        
@@ -72,6 +72,10 @@ public:
     void setFactor(double f);
     // @}
 
+protected:
+
+    void updateMembers_() override;
+
 private:
 
     /// O(n^2) dynamical programming
@@ -85,6 +89,12 @@ private:
     /// consensus spectrum of the last comparison
     mutable PeakSpectrum lastconsensus_;
 
+    /// maximum relative position difference of two peaks (parameter "variation")
+    double variation_;
+
+    /// how the peak heights are used in the score (parameter "int_cnt")
+    unsigned int int_cnt_;
+
     /// should peaks with no alignment partner be kept in the consensus?
     bool keeppeaks_;
 
@@ -70,6 +70,14 @@ public:
         This function return the similarity score of itself based on SteinScott.
     */
     double operator()(const PeakSpectrum & spec) const override;
+
+protected:
+    void updateMembers_() override;
+
+    /// parameter "tolerance"
+    double epsilon_;
+    /// parameter "threshold"
+    double threshold_;
   };
 }
 
@@ -55,9 +55,19 @@ public:
 
 protected:
 
+    void updateMembers_() override;
+
     /// returns the factor associated with the m/z tolerance and m/z difference of the peaks
     double getFactor_(double mz_tolerance, double mz_difference, bool is_gaussian = false) const;
 
+    /// absolute m/z tolerance (parameter "tolerance")
+    double tolerance_;
+    /// parameter "is_relative_tolerance"
+    bool is_relative_tolerance_;
+    /// parameter "use_linear_factor"
+    bool use_linear_factor_;
+    /// parameter "use_gaussian_factor"
+    bool use_gaussian_factor_;
 
   };
 
@@ -11,6 +11,7 @@
 #include <OpenMS/CONCEPT/Macros.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
 
+#include <atomic>
 #include <sstream>
 #include <iostream>
 #include <list>
@@ -188,6 +189,8 @@ protected:
       std::string             level_;
       std::list<StreamStruct> stream_list_;
       std::string             incomplete_line_;
+      /// true if stream_list_ is not empty (can be read without holding the log lock)
+      std::atomic<bool> active_{false};
       Colorizer* colorizer_ = nullptr; ///< optional Colorizer to color the output to stdout/stdcerr (if attached)
       /// @name Caching
       //@{
@@ -281,10 +284,14 @@ protected:
       Which produces an error message in the log.
 
       @note The log stream macros are thread safe and can be used in a
-      multithreaded environment, the global variables are not! The macros are
-      protected by a OPENMS_THREAD_CRITICAL directive (which translates to an
-      OpenMP critical pragma), however there may be a small performance penalty
-      to this.
+      multithreaded environment, the global variables are not! Each statement
+      is formatted in a thread local buffer and only passing the finished text
+      to the LogStream is protected by a OPENMS_THREAD_CRITICAL(LOGSTREAM)
+      directive (see LogStatement). If no stream is attached to a LogStream
+      (e.g. OPENMS_LOG_DEBUG without debug level), the statement is skipped
+      entirely, i.e. its arguments are not even evaluated.
+      Format flags (e.g. std::setprecision) only apply to the statement they
+      are used in.
 
     */
     class OPENMS_DLLAPI LogStream :
@@ -412,6 +419,13 @@ public:
       ///
       void flush();
       //@}
+
+      /// Is at least one stream attached, i.e. do messages end up anywhere? (does not need the log lock)
+      bool isActive() const
+      {
+        const LogStreamBuf* buf = static_cast<const LogStreamBuf*>(std::ios::rdbuf());
+        return buf != nullptr && buf->active_.load(std::memory_order_relaxed);
+      }
 private:
 
       typedef std::list<LogStreamBuf::StreamStruct>::iterator StreamIterator;
@@ -428,37 +442,75 @@ private:
 
     }; //LogStream
 
+    /**
+      @brief A single statement of the OPENMS_LOG_* macros
+
+      The message is written to stream(), a thread local buffer, without any
+      synchronization. The destructor (at the end of the statement) passes the
+      finished text to the LogStream in one go, which is the only part that is
+      serialized (by the OPENMS_THREAD_CRITICAL(LOGSTREAM) section).
+      So threads which log concurrently only contend for copying the text, not
+      for formatting it.
+    */
+    class OPENMS_DLLAPI LogStatement
+    {
+public:
+      /// Starts a statement for @p target
+      explicit LogStatement(LogStream& target);
+
+      /// Writes the statement to the target and flushes it
+      ~LogStatement();
+
+      LogStatement(const LogStatement&) = delete;
+      LogStatement& operator=(const LogStatement&) = delete;
+
+      /// The buffer to write the message to (with default format flags)
+      std::ostream& stream()
+      {
+        return *buffer_;
+      }
+
+private:
+      LogStream& target_;
+      std::ostringstream* buffer_;
+      bool owned_ = false; ///< buffer_ is not one of the thread local buffers
+    };
+
+    /// Turns a log statement into an expression of type void (so the macros can be used in a conditional expression)
+    struct LogVoidify
+    {
+      void operator&(std::ostream&) {}
+    };
+
   } // namespace Logger
 
+  /// Statement for @p log_stream which is skipped (without evaluating its arguments) if nothing is attached to the stream
+#define OPENMS_LOG_STATEMENT_(log_stream) \
+  !(log_stream).isActive() ? (void)0 : OpenMS::Logger::LogVoidify() & OpenMS::Logger::LogStatement(log_stream).stream()
+
   /// Macro to be used if fatal error are reported (processing stops)
 #define OPENMS_LOG_FATAL_ERROR \
-  OPENMS_THREAD_CRITICAL(LOGSTREAM) \
-  OpenMS_Log_fatal << __FILE__ << "(" << __LINE__ << "): "
+  OPENMS_LOG_STATEMENT_(OpenMS_Log_fatal) << __FILE__ << "(" << __LINE__ << "): "
 
   /// Macro to be used if non-fatal error are reported (processing continues)
 #define OPENMS_LOG_ERROR \
-  OPENMS_THREAD_CRITICAL(LOGSTREAM) \
-  OpenMS_Log_error
+  OPENMS_LOG_STATEMENT_(OpenMS_Log_error)
 
   /// Macro if a warning, a piece of information which should be read by the user, should be logged
 #define OPENMS_LOG_WARN \
-  OPENMS_THREAD_CRITICAL(LOGSTREAM) \
-  OpenMS_Log_warn
+  OPENMS_LOG_STATEMENT_(OpenMS_Log_warn)
 
   /// Macro if a information, e.g. a status should be reported
 #define OPENMS_LOG_INFO \
-  OPENMS_THREAD_CRITICAL(LOGSTREAM) \
-  OpenMS_Log_info
+  OPENMS_LOG_STATEMENT_(OpenMS_Log_info)
 
   /// Macro for general debugging information
 #define OPENMS_LOG_DEBUG \
-  OPENMS_THREAD_CRITICAL(LOGSTREAM) \
-  OpenMS_Log_debug << [](){ constexpr const char* x = (past_last_slash(__FILE__)); return x; }() << "(" << __LINE__ << "): "
+  OPENMS_LOG_STATEMENT_(OpenMS_Log_debug) << [](){ constexpr const char* x = (past_last_slash(__FILE__)); return x; }() << "(" << __LINE__ << "): "
 
   /// Macro for general debugging information (without information on file)
 #define OPENMS_LOG_DEBUG_NOFILE \
-  OPENMS_THREAD_CRITICAL(LOGSTREAM) \
-  OpenMS_Log_debug
+  OPENMS_LOG_STATEMENT_(OpenMS_Log_debug)
 
   OPENMS_DLLAPI extern Logger::LogStream OpenMS_Log_fatal; ///< Global static instance of a LogStream to capture messages classified as fatal errors. By default it is bound to @b cerr.
   OPENMS_DLLAPI extern Logger::LogStream OpenMS_Log_error; ///< Global static instance of a LogStream to capture messages classified as errors. By default it is bound to @b cerr.
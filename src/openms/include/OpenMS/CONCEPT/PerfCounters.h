@@ -0,0 +1,125 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg$
+// $Authors: Timo Sachsenberg$
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Event counters of hot paths (spectra decoded, bytes decompressed, candidates scored, cache hits, lock waits), per thread.
+
+    Hot paths report events with add(), e.g.
+    @code
+    PerfCounters::add(PerfCounters::CANDIDATES_SCORED, candidates.size());
+    @endcode
+    and the time spent waiting for a lock (e.g. an <tt>omp critical</tt> section) with a LockWait:
+    @code
+    PerfCounters::LockWait wait;
+    #pragma omp critical (my_section)
+    {
+      wait.acquired();
+      ...
+    }
+    @endcode
+
+    Counting is disabled by default; in this case add() costs a single relaxed atomic load and
+    LockWait does not read the clock. When enabled, each thread increments its own counters
+    (no shared cache lines, no locks). Threads are numbered in order of their first event.
+
+    The counters can be written as a JSON summary with totals and a breakdown per thread (storeJSON()).
+    TOPP tools write the summary when given the common '-perf_counters' option.
+
+    @ingroup Concept
+  */
+  class OPENMS_DLLAPI PerfCounters
+  {
+public:
+    /// The counted events
+    enum Counter
+    {
+      SPECTRA_DECODED,       ///< spectra whose binary data arrays were decoded
+      CHROMATOGRAMS_DECODED, ///< chromatograms whose binary data arrays were decoded
+      BYTES_DECOMPRESSED,    ///< bytes produced by zlib decompression
+      CANDIDATES_SCORED,     ///< candidates (e.g. peptide-spectrum pairs, peak groups, feature hypotheses) scored
+      CACHE_HITS,            ///< lookups answered by a cache
+      CACHE_MISSES,          ///< lookups not answered by a cache
+      LOCK_ACQUISITIONS,     ///< lock acquisitions measured with LockWait
+      LOCK_WAIT_NS,          ///< nanoseconds spent waiting for locks (measured with LockWait)
+      SIZE_OF_COUNTER
+    };
+
+    /// Names of the counters (as written by storeJSON())
+    static const std::string NamesOfCounter[SIZE_OF_COUNTER];
+
+    /// Values of all counters
+    typedef std::array<UInt64, SIZE_OF_COUNTER> Counts;
+
+    /// Measures the time from construction until acquired() is called as waiting time for a lock
+    class OPENMS_DLLAPI LockWait
+    {
+public:
+      /// Starts waiting (reads the clock only if counting is enabled)
+      LockWait();
+
+      /// The lock was acquired: adds the waiting time to LOCK_WAIT_NS (only the first call counts)
+      void acquired();
+
+private:
+      /// start of waiting in nanoseconds, 0 if not measured
+      UInt64 start_;
+    };
+
+    /// Enables or disables counting (keeps the counts collected so far)
+    static void setEnabled(bool enabled);
+
+    /// Is counting enabled?
+    static bool isEnabled()
+    {
+      return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /// Adds @p count events of type @p counter for the calling thread (no-op if counting is disabled)
+    static void add(Counter counter, UInt64 count = 1)
+    {
+      if (isEnabled())
+      {
+        add_(counter, count);
+      }
+    }
+
+    /// Returns the counts of each thread (in order of first use)
+    static std::vector<Counts> getThreadCounts();
+
+    /// Returns the counts summed over all threads
+    static Counts getTotalCounts();
+
+    /// Sets all counts to zero (call while no thread is counting)
+    static void reset();
+
+    /**
+      @brief Writes the counts as JSON: the name of the @p tool, the "totals" and one entry per thread in "threads"
+
+      @exception Exception::UnableToCreateFile is thrown if the file cannot be created
+    */
+    static void storeJSON(const String& filename, const String& tool = "");
+
+protected:
+    /// Increments a counter of the calling thread
+    static void add_(Counter counter, UInt64 count);
+
+    static std::atomic<bool> enabled_;
+  };
+
+} // namespace OpenMS
@@ -21,6 +21,9 @@ namespace OpenMS
 
     Use startProgress, setProgress and endProgress for the actual logging.
 
+    Independent of the log type, each startProgress/endProgress pair is recorded as a scope
+    by the ProgressProfiler (if profiling is enabled).
+
     @note All methods are const, so it can be used through a const reference or in const methods as well!
   */
   class OPENMS_DLLAPI ProgressLogger
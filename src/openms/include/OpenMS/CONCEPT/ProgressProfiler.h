@@ -0,0 +1,113 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg$
+// $Authors: Timo Sachsenberg$
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Collects wall time, CPU time, peak memory and bytes processed of named (nested) scopes.
+
+    Scopes are opened and closed with beginScope() and endScope() (or a Scope object).
+    Every ProgressLogger opens a scope in startProgress() and closes it in endProgress(),
+    so all progress sections of a run are profiled once the profiler is enabled.
+    Scopes are tracked per thread, i.e. they nest within the thread that opened them.
+
+    The collected scopes can be written as a nested JSON summary (storeJSON()) or in the
+    Chrome trace-event format (storeTraceEvents()), which can be viewed in chrome://tracing or Perfetto.
+    TOPP tools write a profile when given the common '-profile' option.
+
+    Profiling is disabled by default; in this case beginScope() and endScope() return immediately.
+
+    @note CPU time and peak memory are measured for the whole process, not for the calling thread only.
+
+    @ingroup Concept
+  */
+  class OPENMS_DLLAPI ProgressProfiler
+  {
+public:
+    /// A closed scope
+    struct OPENMS_DLLAPI Record
+    {
+      String label; ///< name of the scope
+      Size depth = 0; ///< nesting depth within its thread (0 = outermost scope)
+      Size thread = 0; ///< index of the thread (in order of first use)
+      double start = 0.0; ///< wall time (in seconds) at which the scope was opened, relative to enabling the profiler
+      double wall_time = 0.0; ///< wall time (in seconds) spent in the scope
+      double cpu_time = 0.0; ///< CPU time (user and system, in seconds) of the process spent in the scope
+      size_t peak_memory = 0; ///< peak resident memory of the process (in KB) when the scope was closed (0 if unknown)
+      UInt64 bytes_processed = 0; ///< number of bytes processed within the scope (as reported by the caller)
+    };
+
+    /// Opens a scope on construction and closes it on destruction
+    class OPENMS_DLLAPI Scope
+    {
+public:
+      /// Opens a scope named @p label
+      explicit Scope(const String& label);
+
+      /// Closes the scope
+      ~Scope();
+
+      Scope(const Scope&) = delete;
+      Scope& operator=(const Scope&) = delete;
+
+      /// Sets the number of bytes processed within the scope (reported when it is closed)
+      void setBytesProcessed(UInt64 bytes);
+
+private:
+      UInt64 bytes_processed_ = 0;
+    };
+
+    /// Enables or disables profiling. Enabling restarts the global clock, but keeps records collected so far.
+    static void setEnabled(bool enabled);
+
+    /// Is profiling enabled?
+    static bool isEnabled();
+
+    /// Opens a scope named @p label on the calling thread (no-op if profiling is disabled)
+    static void beginScope(const String& label);
+
+    /**
+      @brief Closes the innermost open scope of the calling thread
+
+      Calls without a matching beginScope() on the same thread are ignored.
+
+      @param bytes_processed Number of bytes processed within the scope (optional)
+    */
+    static void endScope(UInt64 bytes_processed = 0);
+
+    /// Returns all closed scopes (of all threads), sorted by thread and start time
+    static std::vector<Record> getRecords();
+
+    /// Removes all closed scopes
+    static void clear();
+
+    /**
+      @brief Writes the closed scopes as JSON
+
+      Each thread is an entry of "threads", holding its outermost scopes; nested scopes are listed in "children".
+
+      @exception Exception::UnableToCreateFile is thrown if the file cannot be created
+    */
+    static void storeJSON(const String& filename);
+
+    /**
+      @brief Writes the closed scopes in the Chrome trace-event format (complete events, phase 'X')
+
+      @exception Exception::UnableToCreateFile is thrown if the file cannot be created
+    */
+    static void storeTraceEvents(const String& filename);
+  };
+
+} // namespace OpenMS
@@ -15,7 +15,6 @@
 #include <boost/random/variate_generator.hpp>
 #include <boost/random/uniform_int.hpp>
 
-
 namespace OpenMS
 {
 
@@ -25,9 +24,20 @@ namespace OpenMS
     @brief  A generator for unique ids.
 
     The unique ids are 64-bit random unsigned random integers.
-    The class is implemented as a singleton.
     The random generator is implemented using boost::random.
 
+    Every thread has its own random generator, so threads do not need to synchronize when creating ids.
+    The generator of a thread is seeded from the global seed (see setSeed()) and the number of the thread
+    in its OpenMP team, so with a fixed number of threads (and a fixed schedule) the ids are reproducible.
+    The first thread to use a thread number (usually the main thread for 0) uses the global seed itself,
+    i.e. single threaded code gets the same ids as with a single generator. Threads which find their
+    number already in use (e.g. threads not started by OpenMP or nested parallel regions) use a
+    separate generator.
+
+    To get reproducible ids independent of the number of threads and of the schedule, parallel loops
+    can open an ItemScope for each work item: within it, the ids of the calling thread depend only on
+    the global seed and the item.
+
     @ingroup Concept
   */
   class OPENMS_DLLAPI UniqueIdGenerator
@@ -35,6 +45,30 @@ namespace OpenMS
 
 public:
 
+    /**
+      @brief Ids of the calling thread are drawn from a generator seeded by a work item while the scope exists
+
+      Scopes of one thread may be nested (e.g. if a thread executes another task while waiting);
+      the destructor restores the generator used before. setSeed() does not affect open scopes.
+    */
+    class OPENMS_DLLAPI ItemScope
+    {
+public:
+      /// Starts drawing ids from the generator of @p item (does nothing if @p enabled is false)
+      explicit ItemScope(UInt64 item, bool enabled = true);
+
+      /// Restores the generator of the calling thread used before
+      ~ItemScope();
+
+      ItemScope(const ItemScope&) = delete;
+      ItemScope& operator=(const ItemScope&) = delete;
+
+private:
+      bool enabled_;
+      bool previous_scoped_ = false;
+      boost::mt19937_64 previous_rng_;
+    };
+
     /// Returns a new unique id
     static UInt64 getUniqueId();
 
@@ -49,13 +83,6 @@ protected:
     ~UniqueIdGenerator();
 
 private:
-    static UInt64 seed_;
-    static UniqueIdGenerator* instance_;
-    static boost::mt19937_64* rng_;
-    static boost::uniform_int<UInt64>* dist_;
-
-    static UniqueIdGenerator& getInstance_();
-    void init_();
     UniqueIdGenerator(const UniqueIdGenerator& );//protect from c++ auto-generation
   };
 
@@ -17,8 +17,10 @@ LogConfigHandler.h
 LogStream.h
 Macros.h
 MacrosTest.h
+PerfCounters.h
 PrecisionWrapper.h
 ProgressLogger.h
+ProgressProfiler.h
 RAIICleanup.h
 StreamHandler.h
 Types.h
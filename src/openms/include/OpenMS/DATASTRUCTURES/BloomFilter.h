@@ -0,0 +1,80 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <atomic>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+namespace OpenMS
+{
+  /**
+    @brief A Bloom filter: a compact set of strings which answers membership queries with false positives only
+
+    mayContain() is true for all inserted keys and, with a probability of about the false positive
+    rate given to the constructor (if at most the expected number of keys is inserted), for other
+    keys. The filter needs about 1.44 * log2(1 / false positive rate) bits per key, independent of
+    the length of the keys (e.g. 10 bits for 1%), so it can hold the peptides of very large
+    databases where a set of strings would not fit into memory. Use it to skip exact lookups for
+    the (many) keys which are not in the set.
+
+    insert() and mayContain() may be called concurrently.
+
+    @ingroup Datastructures
+  */
+  class OPENMS_DLLAPI BloomFilter
+  {
+public:
+    /**
+      @brief Constructor
+
+      @param expected_keys Number of keys the filter is sized for
+      @param false_positive_rate Probability of false positives with @p expected_keys keys
+
+      @exception Exception::InvalidValue if @p false_positive_rate is not in (0, 1)
+    */
+    explicit BloomFilter(Size expected_keys, double false_positive_rate = 0.01);
+
+    BloomFilter(const BloomFilter&) = delete;
+    BloomFilter& operator=(const BloomFilter&) = delete;
+
+    /// Inserts @p key
+    void insert(std::string_view key);
+
+    /// Is @p key (possibly) in the filter? False means it was never inserted.
+    bool mayContain(std::string_view key) const;
+
+    /// Removes all keys
+    void clear();
+
+    /// Number of bits of the filter
+    Size getBitCount() const
+    {
+      return bit_count_;
+    }
+
+    /// Number of bits set per key
+    Size getHashCount() const
+    {
+      return hash_count_;
+    }
+
+protected:
+    /// The double hash (h1, h2) of @p key; bit i of a key is (h1 + i * h2) mod getBitCount()
+    static std::pair<UInt64, UInt64> hash_(std::string_view key);
+
+    Size bit_count_;
+    Size hash_count_;
+    Size word_count_;
+    std::unique_ptr<std::atomic<UInt64>[]> words_;
+  };
+}
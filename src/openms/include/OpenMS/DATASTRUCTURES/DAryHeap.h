@@ -0,0 +1,151 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Lars Nilse $
+// $Authors: Lars Nilse $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Array-backed d-ary min-heap
+
+    Like std::priority_queue, but with a configurable arity @p D (default 4) and the smallest element on top:
+    a higher arity halves the depth of the heap and keeps the children of a node in one cache line, so pushes
+    and pops touch less memory than in a binary heap.
+
+    There is no decrease-key or erase. Users that need to invalidate elements store a version (or a similar
+    tag) in them and skip outdated elements when they reach the top (lazy invalidation).
+
+    @tparam T Type of the elements
+    @tparam Compare Strict weak ordering; top() is an element that no other element compares less than
+    @tparam D Number of children per node (at least 2)
+
+    @ingroup Datastructures
+  */
+  template<typename T, typename Compare = std::less<T>, UInt D = 4>
+  class DAryHeap
+  {
+    static_assert(D >= 2, "DAryHeap needs at least two children per node");
+
+  public:
+    /// Constructor
+    explicit DAryHeap(const Compare& compare = Compare()) :
+      compare_(compare)
+    {
+    }
+
+    /// Adds @p value
+    void push(T value)
+    {
+      data_.push_back(std::move(value));
+      siftUp_(data_.size() - 1);
+    }
+
+    /// Smallest element (undefined if empty)
+    const T& top() const
+    {
+      return data_.front();
+    }
+
+    /// Removes the smallest element (undefined if empty)
+    void pop()
+    {
+      if (data_.size() > 1)
+      {
+        data_.front() = std::move(data_.back());
+        data_.pop_back();
+        siftDown_(0);
+      }
+      else
+      {
+        data_.pop_back();
+      }
+    }
+
+    /// Number of elements
+    Size size() const
+    {
+      return data_.size();
+    }
+
+    /// No elements?
+    bool empty() const
+    {
+      return data_.empty();
+    }
+
+    /// Removes all elements
+    void clear()
+    {
+      data_.clear();
+    }
+
+    /// Reserves memory for @p n elements
+    void reserve(Size n)
+    {
+      data_.reserve(n);
+    }
+
+  protected:
+    void siftUp_(Size i)
+    {
+      T value = std::move(data_[i]);
+      while (i > 0)
+      {
+        const Size parent = (i - 1) / D;
+        if (!compare_(value, data_[parent]))
+        {
+          break;
+        }
+        data_[i] = std::move(data_[parent]);
+        i = parent;
+      }
+      data_[i] = std::move(value);
+    }
+
+    void siftDown_(Size i)
+    {
+      const Size n = data_.size();
+      T value = std::move(data_[i]);
+      while (true)
+      {
+        const Size first_child = D * i + 1;
+        if (first_child >= n)
+        {
+          break;
+        }
+        // smallest child
+        Size best = first_child;
+        const Size last_child = std::min(first_child + D, n);
+        for (Size c = first_child + 1; c < last_child; ++c)
+        {
+          if (compare_(data_[c], data_[best]))
+          {
+            best = c;
+          }
+        }
+        if (!compare_(data_[best], value))
+        {
+          break;
+        }
+        data_[i] = std::move(data_[best]);
+        i = best;
+      }
+      data_[i] = std::move(value);
+    }
+
+    std::vector<T> data_;
+    Compare compare_;
+  };
+}
@@ -33,6 +33,10 @@ namespace OpenMS
       Extra member variables are needed if getting the value from param_ would be too slow
       e.g. when they are used in methods that are called very often.
 
+      Copies of a DefaultParamHandler share param_ and defaults_ with the original until either is
+      modified (see Param). Copying a configured object (e.g. once per thread) is therefore much cheaper
+      than constructing it and calling setParameters() again.
+
       No matter if you have extra variables or not, do the following:
       - Set defaults_ and subsections_ in the derived classes' default constructor.
       - Make sure to set the 'advanced' flag of the parameters right in order to hide certain parameters from inexperienced users.
@@ -14,7 +14,9 @@
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 #include <OpenMS/DATASTRUCTURES/StringUtilsSimple.h>
 #include <OpenMS/FORMAT/FASTAFile.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
 
+#include <algorithm>
 #include <functional>
 #include <fstream>
 #include <unordered_map>
@@ -40,8 +42,8 @@ namespace OpenMS
   FASTAContainer supports two template specializations FASTAContainer<TFI_File> and FASTAContainer<TFI_Vector>.
   
   FASTAContainer<TFI_File> will make FASTA entries available chunk-wise from start to end by loading it from a FASTA file.
-  This avoids having to load the full file into memory. While loading, the container will
-  memorize the file offsets of each entry, allowing to read an arbitrary i'th entry again from disk.
+  This avoids having to load the full file into memory. Upon construction, the container builds an index
+  of the file offsets of all entries (see FASTAFile::buildIndex()), allowing to read an arbitrary i'th entry again from disk.
   If possible, only entries from the currently cached chunk should be queried, otherwise access will be slow.
   
   FASTAContainer<TFI_Vector> simply takes an existing vector of FASTAEntries and provides the same interface
@@ -57,11 +59,12 @@ class FASTAContainer; // prototype
 
 /**
   @brief FASTAContainer<TFI_File> will make FASTA entries available chunk-wise from start to end by loading it from a FASTA file.
-  This avoids having to load the full file into memory. While loading, the container will
-  memorize the file offsets of each entry, allowing to read an arbitrary i'th entry again from disk.
+  This avoids having to load the full file into memory. Upon construction, the container builds an index
+  of the file offsets of all entries, allowing to read an arbitrary i'th entry again from disk.
   If possible, only entries from the currently cached chunk should be queried, otherwise access will be slow.
 
-  Internally uses FASTAFile class to read single sequences.
+  Internally uses FASTAFile::readEntries() to read chunks (memory mapped and parsed in parallel).
+  An up-to-date index file written by FASTAFile::loadOrBuildIndex() is used instead of scanning the FASTA file.
 */
 template<>
 class FASTAContainer<TFI_File>
@@ -71,14 +74,13 @@ public:
 
   /// C'tor with FASTA filename
   FASTAContainer(const String& FASTA_file)
-    : f_(),
-    offsets_(),
+    : index_(FASTAFile::loadOrBuildIndex(FASTA_file, false)),
+    entries_read_(0),
     data_fg_(),
     data_bg_(),
     chunk_offset_(0),
     filename_(FASTA_file)
   {
-    f_.readStart(FASTA_file);
   }
 
   /// how many entries were read and got swapped out already
@@ -109,16 +111,9 @@ public:
   */
   bool cacheChunk(int suggested_size)
   {
-    data_bg_.clear();
-    data_bg_.reserve(suggested_size);
-    FASTAFile::FASTAEntry p;
-    for (int i = 0; i < suggested_size; ++i)
-    {
-      std::streampos spos = f_.position();
-      if (!f_.readNext(p)) break;
-      data_bg_.push_back(std::move(p));
-      offsets_.push_back(spos);
-    }
+    const size_t end = std::min(entries_read_ + size_t(std::max(suggested_size, 0)), index_.size() - 1);
+    FASTAFile::readEntries(filename_, index_, entries_read_, end, data_bg_);
+    entries_read_ = end;
     return !data_bg_.empty();
   }
 
@@ -162,31 +157,29 @@ public:
       return true;
     }
     // read anew from disk...
-    if (pos >= offsets_.size())
+    if (pos >= entries_read_)
     {
-      throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, pos, offsets_.size());
+      throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, pos, entries_read_);
     }
-    std::streampos spos = f_.position(); // save old position
-    if (!f_.setPosition(offsets_[pos])) return false;
-    bool r = f_.readNext(protein);
-    f_.setPosition(spos); // restore old position
-    return r;
+    std::vector<FASTAFile::FASTAEntry> entry;
+    FASTAFile::readEntries(filename_, index_, pos, pos + 1, entry);
+    protein = std::move(entry[0]);
+    return true;
   }
 
   /// is the FASTA file empty?
   bool empty()
   { // trusting the FASTA file can be read...
-    return f_.atEnd() && offsets_.empty();
+    return index_.size() < 2;
   }
 
   /// resets reading of the FASTA file, enables fresh reading of the FASTA from the beginning
   void reset()
   {
-    offsets_.clear();
+    entries_read_ = 0;
     data_fg_.clear();
     data_bg_.clear();
     chunk_offset_ = 0;
-    f_.readStart(filename_);
   }
 
 
@@ -197,12 +190,12 @@ public:
   */
   size_t size() const
   {
-    return offsets_.size();
+    return entries_read_;
   }
 
 private:
-  FASTAFile f_; ///< FASTA file connection
-  std::vector<std::streampos> offsets_; ///< internal byte offsets into FASTA file for random access reading of previous entries.
+  std::vector<Int64> index_; ///< byte offsets of all entries (followed by the file size); see FASTAFile::buildIndex()
+  size_t entries_read_; ///< number of entries read so far (including the background cache)
   std::vector<FASTAFile::FASTAEntry> data_fg_; ///< active (foreground) data
   std::vector<FASTAFile::FASTAEntry> data_bg_; ///< prefetched (background) data; will become the next active data
   size_t chunk_offset_; ///< number of entries before the current chunk
@@ -355,7 +348,7 @@ public:
   // decoy strings
   inline static const std::vector<std::string> affixes = { "decoy", "dec", "reverse", "rev", "reversed", "__id_decoy", "xxx", "shuffled", "shuffle", "pseudo", "random" };
 
-  // setup prefix- and suffix regex strings
+  // setup prefix- and suffix regex strings (countDecoys() matches the same strings without regexes, see matchDecoyPrefix() and matchDecoySuffix())
   inline static const std::string regexstr_prefix = std::string("^(") + ListUtils::concatenate<std::string>(affixes, "_*|") + "_*)";
   inline static const std::string regexstr_suffix = std::string("(_") + ListUtils::concatenate<std::string>(affixes, "*|_") + ")$";
 
@@ -436,11 +429,58 @@ public:
     return {false, "?", true};
   }
 
+  /**
+    @brief Returns the decoy prefix of the lower case accession @p lower (empty if there is none)
+
+    Same result as a search with regexstr_prefix: the first affix which starts @p lower, followed by all underscores.
+  */
+  static std::string matchDecoyPrefix(const std::string& lower)
+  {
+    for (const auto& a : affixes)
+    {
+      if (lower.compare(0, a.size(), a) == 0)
+      {
+        Size end = a.size();
+        while (end < lower.size() && lower[end] == '_') ++end;
+        return lower.substr(0, end);
+      }
+    }
+    return std::string();
+  }
+
+  /**
+    @brief Returns the decoy suffix of the lower case accession @p lower (empty if there is none)
+
+    Same result as a search with regexstr_suffix: the leftmost '_' followed by an affix (whose last
+    character may be repeated or missing) up to the end of @p lower.
+  */
+  static std::string matchDecoySuffix(const std::string& lower)
+  {
+    for (Size pos = lower.find('_'); pos != std::string::npos; pos = lower.find('_', pos + 1))
+    {
+      for (const auto& a : affixes)
+      {
+        // '_' + all but the last character of the affix, then any number of its last character
+        const Size stem = a.size() - 1;
+        if (lower.size() - pos - 1 < stem || lower.compare(pos + 1, stem, a, 0, stem) != 0) continue;
+        Size end = pos + 1 + stem;
+        while (end < lower.size() && lower[end] == a.back()) ++end;
+        if (end == lower.size())
+        {
+          return lower.substr(pos);
+        }
+      }
+    }
+    return std::string();
+  }
+
   /**
   @brief Function to count the occurrences of decoy strings in a given set of protein names
 
   For tested decoy strings see DecoyHelper::affixes.
   Returns all data needed for interpretation (see DecoyHelper::DecoyStatistics).
+
+  The accessions of each chunk are matched in parallel.
   */
   template<typename T>
   static DecoyStatistics countDecoys(FASTAContainer<T>& proteins)
@@ -450,12 +490,10 @@ public:
 
     DecoyStatistics ds;
 
-    // setup regexes
-    const boost::regex pattern_prefix(regexstr_prefix);
-    const boost::regex pattern_suffix(regexstr_suffix);
-
     constexpr size_t PROTEIN_CACHE_SIZE = 4e5;
 
+    // matched (lower case) prefix and suffix of each protein of the chunk
+    std::vector<std::pair<std::string, std::string> > matches;
     while (true)
     {
       proteins.cacheChunk(PROTEIN_CACHE_SIZE);
@@ -464,42 +502,41 @@ public:
       auto prot_count = (SignedSize)proteins.chunkSize();
       ds.all_proteins_count += prot_count;
 
-      boost::smatch sm;
-      for (SignedSize i = 0; i < prot_count; ++i)
+      matches.assign(prot_count, std::pair<std::string, std::string>());
+      TaskScheduler::parallelFor(0, prot_count, [&](SignedSize i)
       {
-        String seq = proteins.chunkAt(i).identifier;
-
-        String seq_lower = seq;
+        String seq_lower = proteins.chunkAt(i).identifier;
         seq_lower.toLower();
+        matches[i].first = matchDecoyPrefix(seq_lower);
+        matches[i].second = matchDecoySuffix(seq_lower);
+      }, 1000);
 
-        // search for prefix
-        bool found_prefix = boost::regex_search(seq_lower, sm, pattern_prefix);
-        if (found_prefix)
+      // count in the order of the proteins (the case sensitive string of the last protein is kept)
+      for (SignedSize i = 0; i < prot_count; ++i)
+      {
+        const String& seq = proteins.chunkAt(i).identifier;
+        const std::string& prefix = matches[i].first;
+        if (!prefix.empty())
         {
-          std::string match = sm[0];
           ds.all_prefix_occur++;
 
           // increase count of observed prefix
-          ds.decoy_count[match].first++;
+          ds.decoy_count[prefix].first++;
 
           // store observed (case sensitive and with special characters)
-          std::string seq_decoy = StringUtils::prefix(seq, match.length());
-          ds.decoy_case_sensitive[match] = seq_decoy;
+          ds.decoy_case_sensitive[prefix] = StringUtils::prefix(seq, prefix.length());
         }
 
-        // search for suffix
-        bool found_suffix = boost::regex_search(seq_lower, sm, pattern_suffix);
-        if (found_suffix)
+        const std::string& suffix = matches[i].second;
+        if (!suffix.empty())
         {
-          std::string match = sm[0];
           ds.all_suffix_occur++;
 
           // increase count of observed suffix
-          ds.decoy_count[match].second++;
+          ds.decoy_count[suffix].second++;
 
           // store observed (case sensitive and with special characters)
-          std::string seq_decoy = StringUtils::suffix(seq, match.length());
-          ds.decoy_case_sensitive[match] = seq_decoy;
+          ds.decoy_case_sensitive[suffix] = StringUtils::suffix(seq, suffix.length());
         }
       }
     }
@@ -0,0 +1,113 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <functional>
+#include <iosfwd>
+
+namespace OpenMS
+{
+  /**
+    @brief Handle to a string in the global string pool
+
+    Identification and raw data contain the same short strings (protein accessions, native IDs) over and
+    over again, e.g. the accession of a protein in the evidences of all its peptides. An InternedString
+    stores each distinct value only once, in a global pool, and itself is just a pointer into that pool:
+    copies do not allocate and equality is a pointer comparison.
+
+    Interning a value (construction or assignment from a String) looks the value up in the pool, which
+    is thread safe but more expensive than copying a short String. Strings are never removed from the
+    pool, so only use it for values that are repeated many times.
+
+    The empty string does not use the pool.
+
+    @ingroup Datastructures
+  */
+  class OPENMS_DLLAPI InternedString
+  {
+public:
+    /// Default constructor (empty string)
+    InternedString() = default;
+
+    /// Constructor from a string (interns @p s)
+    InternedString(const String& s);
+
+    /// Constructor from a C string (interns @p s)
+    InternedString(const char* s);
+
+    /// Assignment from a string (interns @p s)
+    InternedString& operator=(const String& s);
+
+    /// The string
+    const String& str() const
+    {
+      return *value_;
+    }
+
+    /// The string
+    operator const String&() const
+    {
+      return *value_;
+    }
+
+    /// Is the string empty?
+    bool empty() const
+    {
+      return value_->empty();
+    }
+
+    /// Equality (pointer comparison)
+    bool operator==(const InternedString& rhs) const
+    {
+      return value_ == rhs.value_;
+    }
+
+    /// Inequality (pointer comparison)
+    bool operator!=(const InternedString& rhs) const
+    {
+      return value_ != rhs.value_;
+    }
+
+    /// Lexicographical order of the strings
+    bool operator<(const InternedString& rhs) const
+    {
+      return value_ != rhs.value_ && *value_ < *rhs.value_;
+    }
+
+    /// Number of distinct non-empty strings in the global pool
+    static Size poolSize();
+
+protected:
+    /// Returns the pooled copy of @p s (adds it if new)
+    static const String* intern_(const String& s);
+
+    /// Pooled string (never null; String::EMPTY for the empty string)
+    const String* value_ = &String::EMPTY;
+  };
+
+  /// Print the string to a stream
+  OPENMS_DLLAPI std::ostream& operator<<(std::ostream& os, const InternedString& s);
+
+} // namespace OpenMS
+
+namespace std
+{
+  /// Hash function for InternedString (of the pooled address)
+  template<>
+  struct hash<OpenMS::InternedString>
+  {
+    std::size_t operator()(const OpenMS::InternedString& s) const noexcept
+    {
+      return std::hash<const OpenMS::String*>()(&s.str());
+    }
+  };
+} // namespace std
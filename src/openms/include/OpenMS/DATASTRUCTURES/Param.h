@@ -11,9 +11,10 @@
 #include <OpenMS/DATASTRUCTURES/ParamValue.h>
 #include <OpenMS/OpenMSConfig.h>
 
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
-#include <map>
 
 namespace OpenMS
 {
@@ -36,6 +37,12 @@ namespace OpenMS
     Each parameter can be annotated with an arbitrary number of tags. Tags must not contain comma characters!
     @n E.g. the <i>advanced</i> tag indicates if this parameter is shown to all users or in advanced mode only.
 
+    Copies of a Param share their data until one of them is modified (copy-on-write), so copying a Param
+    (e.g. with DefaultParamHandler::getParameters() and setParameters()) is cheap. Lookups of parameters by
+    their full name use a hash table once a Param has been queried more often than it has entries after its
+    last modification. References and iterators to the data of a Param are invalidated by modifications of
+    that Param (as before) and stay valid while the Param is only read.
+
     @see DefaultParamHandler
 
     @ingroup Datastructures
@@ -123,24 +130,32 @@ public:
         Returns the end iterator if no entry is found
       */
       EntryIterator findEntry(const std::string& name);
+      /// Look up entry of this node (local search, const version)
+      ConstEntryIterator findEntry(const std::string& name) const;
       /**
         @brief Look up subnode of this node (local search)
 
         Returns the end iterator if no entry is found
       */
       NodeIterator findNode(const std::string& name);
+      /// Look up subnode of this node (local search, const version)
+      ConstNodeIterator findNode(const std::string& name) const;
       /**
         @brief Look up the parent node of the entry or node corresponding to @p name (tree search)
 
         Returns 0 if no entry is found
       */
       ParamNode* findParentOf(const std::string& name);
+      /// Look up the parent node of the entry or node corresponding to @p name (tree search, const version)
+      const ParamNode* findParentOf(const std::string& name) const;
       /**
         @brief Look up the entry corresponding to @p name (tree search)
 
         Returns 0 if no entry is found
       */
       ParamEntry* findEntryRecursive(const std::string& name);
+      /// Look up the entry corresponding to @p name (tree search, const version)
+      const ParamEntry* findEntryRecursive(const std::string& name) const;
 
       ///Inserts a @p node with the given @p prefix
       void insert(const ParamNode& node, const std::string& prefix = "");
@@ -635,17 +650,36 @@ protected:
 protected:
 
     /**
-      @brief Returns a mutable reference to a parameter entry.
+      @brief Returns a parameter entry.
+
+      @exception Exception::ElementNotFound is thrown for unset parameters
+    */
+    const ParamEntry& getEntry_(const std::string& key) const;
+
+    /**
+      @brief Returns a mutable reference to a parameter entry (the data is not shared afterwards).
 
       @exception Exception::ElementNotFound is thrown for unset parameters
     */
-    ParamEntry& getEntry_(const std::string& key) const;
+    ParamEntry& getMutableEntry_(const std::string& key);
+
+    /// Looks up a parameter entry by its full name (nullptr if it does not exist)
+    const ParamEntry* findEntry_(const std::string& key) const;
+
+    /// Invisible root node that stores all the data
+    const Param::ParamNode& getRoot_() const;
+
+    /// Mutable root node (the data is not shared afterwards, and the lookup table is discarded)
+    Param::ParamNode& getMutableRoot_();
 
     /// Constructor from a node which is used as root node
     Param(const Param::ParamNode& node);
 
-    /// Invisible root node that stores all the data
-    mutable Param::ParamNode root_;
+    /// Root node and lookup table
+    struct Tree;
+
+    /// Data, shared between copies until one of them is modified (never null, except after a move)
+    std::shared_ptr<Tree> tree_;
   };
 
   /// Output of Param to a stream.
@@ -14,9 +14,6 @@
 #include <OpenMS/OpenMSConfig.h>
 #include <OpenMS/config.h>
 
-#include <unordered_map>
-
-#include <map> // for multimap<>
 #include <vector> // for vector<>
 #include <set> // for set<>
 #include <utility> // for pair<>
@@ -82,17 +79,24 @@ namespace OpenMS
   {
 public:
 
-    // need to store more than one
-    typedef std::multimap<double, const GridFeature*> NeighborList;
-    typedef std::unordered_map<Size, NeighborList> NeighborMapMulti;
-
     struct Neighbor
     {
       double distance;
       const GridFeature* feature;
     };
 
-    typedef std::unordered_map<Size, Neighbor> NeighborMap;
+    /// Best neighbor per input map, as (map index, neighbor) pairs sorted by map index
+    typedef std::vector<std::pair<Size, Neighbor> > NeighborMap;
+
+    /// A potential neighbor from input map @p map_index (needed to optimize annotations)
+    struct Candidate
+    {
+      Size map_index;
+      double distance;
+      const GridFeature* feature;
+    };
+
+    typedef std::vector<Candidate> CandidateList;
 
     struct Element
     {
@@ -136,19 +140,22 @@ public:
         Size id_;
 
         /**
-         * @brief Map that keeps track of the best current feature for each map
+         * @brief Keeps track of the best current feature for each map
          *
+         * Flat storage (sorted by map index) instead of a hash map, since
+         * there is one cluster per feature and at most one entry per map.
          */
         NeighborMap neighbors_;
 
         /**
-         * @brief Temporary map tracking *all* neighbors
+         * @brief Temporary list tracking *all* neighbors
          *
-         * For each input run, a multimap which contains pointers to all
-         * neighboring elements and the respective distance.
+         * Pointers to all neighboring elements with their input run and the
+         * respective distance. Sorted by map index and distance (see
+         * optimizeAnnotations_) before it is evaluated.
          *
          */
-        NeighborMapMulti tmp_neighbors_;
+        CandidateList tmp_neighbors_;
 
         /// Maximum distance of a point that can still belong to the cluster
         double max_distance_;
@@ -307,12 +314,15 @@ public:
        */
       double optimizeAnnotations_();
 
-      /// compute seq table, mapping: peptides -> best distance per input map
+      /// compute seq table, mapping: peptides -> best distance per input map (requires sorted @p tmp_neighbors_)
       void makeSeqTable_(std::map<AASequence, std::map<Size,double>>& seq_table) const;
       
       /// report elements that are compatible with the optimal annotation
       void recomputeNeighbors_();
 
+      /// Returns the position of the neighbor from map @p map_index in @p neighbors_ (or where it would be inserted)
+      NeighborMap::iterator findNeighbor_(Size map_index) const;
+
       /// Quality of the cluster
       double quality_;
 
@@ -0,0 +1,111 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Johannes Veit $
+// $Authors: Johannes Veit $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/config.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+
+/**
+  @brief A static, array-backed 2D tree for fast range queries on large point sets
+
+  In contrast to the node-based KDTree::KDTree, all points are kept in one contiguous array that is
+  bulk-loaded by build(): the array is recursively partitioned at the median of alternating dimensions
+  (std::nth_element), so that the median of every range is its node and the two halves are its subtrees.
+  No pointers or split values are stored, the tree is implicit in the order of the points. Ranges of at
+  most 8 points are not partitioned further and are scanned linearly.
+
+  The levels of the tree are partitioned in parallel (OpenMP). Many range queries can be answered at once
+  (and in parallel) by queryRanges().
+
+  Points inserted after the last call of build() are kept at the end of the array and are scanned
+  linearly by every query until build() is called again, so queries are always correct.
+
+  @code
+  StaticKDTree tree;
+  for (Size i = 0; i < rts.size(); ++i) tree.insert(rts[i], mzs[i], i);
+  tree.build();
+  std::vector<Size> found;
+  tree.queryRange({{rt - 10.0, mz - 0.01}, {rt + 10.0, mz + 0.01}}, found);
+  @endcode
+
+  @ingroup Datastructures
+*/
+class OPENMS_DLLAPI StaticKDTree
+{
+public:
+
+  /// A closed query box [low[0], high[0]] x [low[1], high[1]]
+  struct Box
+  {
+    double low[2];
+    double high[2];
+  };
+
+  /// A point with the index given at insertion
+  struct Point
+  {
+    double coords[2];
+    Size index;
+  };
+
+  /// Adds a point (searchable right away, but only organized in the tree by the next build())
+  void insert(double x, double y, Size index);
+
+  /// Organizes all points in the tree (nothing happens if no points were inserted since the last call)
+  void build();
+
+  /// Removes all points
+  void clear();
+
+  /// Number of points
+  Size size() const;
+
+  /// No points?
+  bool empty() const;
+
+  /// Are all points organized in the tree (i.e. no insert() since the last build())?
+  bool isBuilt() const;
+
+  /// Adds the indices of all points within @p box to @p result (unsorted)
+  void queryRange(const Box& box, std::vector<Size>& result) const;
+
+  /// Fills @p results with the indices of all points within each of @p boxes (unsorted, in parallel)
+  void queryRanges(const std::vector<Box>& boxes, std::vector<std::vector<Size> >& results) const;
+
+  /// The points (in tree order after build())
+  const std::vector<Point>& getPoints() const;
+
+protected:
+
+  /// Ranges with at most this many points are scanned linearly
+  static constexpr Size leaf_size_ = 8;
+
+  /// Is @p point within @p box?
+  static bool contains_(const Box& box, const Point& point)
+  {
+    return point.coords[0] >= box.low[0] && point.coords[0] <= box.high[0] &&
+           point.coords[1] >= box.low[1] && point.coords[1] <= box.high[1];
+  }
+
+  /// Query the subtree of the points in [@p begin, @p end), partitioned in dimension @p dim
+  void queryNode_(Size begin, Size end, UInt dim, const Box& box, std::vector<Size>& result) const;
+
+  /// All points; the first built_ of them are organized in the tree
+  std::vector<Point> points_;
+
+  /// Number of points organized in the tree
+  Size built_ = 0;
+};
+
+}
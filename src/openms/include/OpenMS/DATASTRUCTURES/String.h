@@ -494,7 +494,7 @@ namespace std
   {
     std::size_t operator()( OpenMS::String const& s) const
     {
-      return std::hash<string>()(static_cast<string>(s));
+      return std::hash<string>()(static_cast<const string&>(s)); // no copy
     }
   };
 } // namespace std
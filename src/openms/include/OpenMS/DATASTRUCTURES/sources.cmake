@@ -5,6 +5,7 @@ set(directory include/OpenMS/DATASTRUCTURES)
 set(sources_list_h
 Adduct.h
 BinaryTreeNode.h
+BloomFilter.h
 CalibrationData.h
 ChargePair.h
 Compomer.h
@@ -14,6 +15,7 @@ CVMappingTerm.h
 CVMappingRule.h
 CVReference.h
 CVMappings.h
+DAryHeap.h
 DBoundingBox.h
 DIntervalBase.h
 DPosition.h
@@ -27,6 +29,7 @@ ExposedVector.h
 FASTAContainer.h
 FlagSet.h
 GridFeature.h
+InternedString.h
 IsotopeCluster.h
 KDTree.h
 ListUtils.h
@@ -39,6 +42,7 @@ OSWData.h
 Param.h
 ParamValue.h
 QTCluster.h
+StaticKDTree.h
 String.h
 StringUtils.h
 StringUtilsSimple.h
@@ -13,6 +13,9 @@
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/KERNEL/MassTrace.h>
+#include <OpenMS/PROCESSING/SMOOTHING/SavitzkyGolayFilter.h>
+
+#include <map>
 
 namespace OpenMS
 {
@@ -137,6 +140,12 @@ private:
     /// Whether to apply S/N filtering
     bool mt_snr_filtering_;
 
+    /// Savitzky-Golay filters by frame length (computing the coefficients is much more expensive than smoothing a trace)
+    mutable std::map<int, SavitzkyGolayFilter> sg_filters_;
+
+    /// Returns the (cached) Savitzky-Golay filter for @p frame_length (thread safe)
+    const SavitzkyGolayFilter& getSmoothingFilter_(int frame_length) const;
+
     /// Main function to do the work
     void detectElutionPeaks_(MassTrace&, std::vector<MassTrace>&);
   };
@@ -213,9 +213,11 @@ protected:
 
   ProgressLogger prog_log_;
 
-  /// generate transitions (isotopic traces) for a peptide ion and add them to the library:
+  /// generate transitions (isotopic traces) for a peptide ion and add them to the library (and their probabilities to @p isotope_probs):
   void generateTransitions_(const String& peptide_id, double mz, Int charge,
-                            const IsotopeDistribution& iso_dist);
+                            const IsotopeDistribution& iso_dist,
+                            TargetedExperiment& library,
+                            std::map<String, double>& isotope_probs) const;
 
   void addPeptideRT_(TargetedExperiment::Peptide& peptide, double rt) const;
 
@@ -240,7 +242,9 @@ protected:
   /// creates an assay library out of the peptide sequences and their RT elution windows
   /// the PeptideMap is mutable since we clear it on-the-go
   /// @p clear_IDs set to false to keep IDs in internal charge maps (only needed for debugging purposes)
-  void createAssayLibrary_(const PeptideMap::iterator& begin, const PeptideMap::iterator& end, PeptideRefRTMap& ref_rt_map, bool clear_IDs = true);
+  /// Only the entries in [@p begin, @p end), @p ref_rt_map, @p library and @p isotope_probs are modified, so libraries for disjoint ranges can be created in parallel.
+  void createAssayLibrary_(const PeptideMap::iterator& begin, const PeptideMap::iterator& end, PeptideRefRTMap& ref_rt_map,
+                           TargetedExperiment& library, std::map<String, double>& isotope_probs, bool clear_IDs = true) const;
 
   /// CAUTION: This method stores a pointer to the given @p peptide reference in internals
   /// Make sure it stays valid until destruction of the class.
@@ -315,6 +315,9 @@ private:
 
     bool remove_single_traces_;
     std::vector<const Element*> elements_;
+
+    /// Theoretic isotopic mass windows (see getTheoreticIsotopicMassWindow_()) by isotopic position - 1, up to the highest charge
+    std::vector<Range> isotope_windows_;
   };
 
 }
@@ -14,6 +14,8 @@
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/KERNEL/StandardTypes.h>
 
+#include <boost/dynamic_bitset_fwd.hpp>
+
 namespace OpenMS
 {
 
@@ -84,6 +86,26 @@ namespace OpenMS
           Size peak_idx;
         };
 
+        /// A mass trace extended from an apex, before it is accepted (see run_())
+        struct TraceCandidate_
+        {
+          bool valid = false; ///< does the trace meet the length and quality criteria?
+          MassTrace trace; ///< the trace (only set if valid)
+          std::vector<std::pair<Size, Size> > gathered_idx; ///< (scan, peak) indices of the gathered peaks
+        };
+
+        /**
+          @brief Extends a mass trace from @p apex in both RT directions, using only peaks not set in @p peak_visited
+
+          Only reads from the members, so it can be called in parallel.
+        */
+        void extendTrace_(const Apex& apex,
+                          const PeakMap& work_exp,
+                          const std::vector<Size>& spec_offsets,
+                          const boost::dynamic_bitset<>& peak_visited,
+                          const int fwhm_meta_idx,
+                          TraceCandidate_& candidate);
+
         /// The internal run method
         void run_(const std::vector<Apex>& chrom_apices,
                   const Size peak_count,
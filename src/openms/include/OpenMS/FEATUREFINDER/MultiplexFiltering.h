@@ -12,6 +12,7 @@
 #include <OpenMS/KERNEL/StandardTypes.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopeDistribution.h>
 #include <OpenMS/PROCESSING/CENTROIDING/PeakPickerHiRes.h>
 #include <OpenMS/FEATUREFINDER/MultiplexIsotopicPeakPattern.h>
 #include <OpenMS/FEATUREFINDER/MultiplexFilteredPeak.h>
@@ -57,9 +58,10 @@ public:
      * which blacklisted peaks are removed is called 'white'. White spectra
      * contain fewer peaks than their corresponding primary spectra. Consequently,
      * their indices are shifted. The type maps a peak index in a 'white'
-     * spectrum back to its original spectrum.
+     * spectrum back to its original spectrum (i.e. entry @em j of spectrum
+     * @em i is the original index of the j-th white peak in spectrum @em i).
      */
-    typedef std::vector<std::map<int, int> > White2Original;
+    typedef std::vector<std::vector<int> > White2Original;
 
     /**
      * @brief constructor
@@ -149,6 +151,15 @@ protected:
      * @param pattern_idx    index of the pattern in @em patterns_
      */
     void blacklistPeak_(const MultiplexFilteredPeak& peak, unsigned pattern_idx);
+
+    /**
+     * @brief averagine isotope distribution (of type @em averagine_type_) for the given mass
+     *
+     * @param mass    mass of the peptide (or nucleic acid)
+     *
+     * @throw Exception::InvalidParameter if @em averagine_type_ is invalid
+     */
+    IsotopeDistribution getAveragineDistribution_(double mass) const;
     
     /**
      * @brief check if the satellite peaks conform with the averagine model
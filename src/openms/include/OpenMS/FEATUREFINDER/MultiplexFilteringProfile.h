@@ -88,12 +88,12 @@ private:
      * @brief averagine filter for profile mode
      *
      * @param pattern    m/z pattern to search for
-     * @param peak    peak to be filtered
+     * @param distribution    averagine distribution of the peak to be filtered (see getAveragineDistribution_())
      * @param satellites_profile    spline-interpolated satellites of the peak. If they pass, they will be added to the peak.
      *
      * @return if this filter was passed i.e. the correlation coefficient is greater than averagine_similarity_
      */
-    bool filterAveragineModel_(const MultiplexIsotopicPeakPattern& pattern, const MultiplexFilteredPeak& peak, const std::multimap<size_t, MultiplexSatelliteProfile >& satellites_profile) const;
+    bool filterAveragineModel_(const MultiplexIsotopicPeakPattern& pattern, const IsotopeDistribution& distribution, const std::multimap<size_t, MultiplexSatelliteProfile >& satellites_profile) const;
 
     /**
      * @brief peptide correlation filter for profile mode
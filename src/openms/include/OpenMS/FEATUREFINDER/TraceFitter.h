@@ -55,7 +55,18 @@ public:
       virtual int df(const Eigen::VectorXd& x, Eigen::MatrixXd& J) = 0;
 
 protected:
+      /// Stores the parameters @p x at which the entries of exp_terms_ were computed
+      void setExpTermsParameters_(const Eigen::VectorXd& x);
+
+      /// Were the entries of exp_terms_ computed at the parameters @p x?
+      bool hasExpTerms_(const Eigen::VectorXd& x) const;
+
       const int m_inputs, m_values;
+
+      /// Exponential term of the model for each data point, computed in operator() and reused by df() (which the optimizer usually calls at the same parameters)
+      std::vector<double> exp_terms_;
+      /// Parameters at which exp_terms_ were computed (empty if none)
+      std::vector<double> exp_terms_params_;
     };
 
     /// default constructor
@@ -149,6 +160,17 @@ protected:
     {
       FeatureFinderAlgorithmPickedHelperStructs::MassTraces* traces_ptr;
       bool weighted;
+
+      /// @name Peaks of all traces in contiguous arrays (filled by packPeaks(), in the order of the traces)
+      //@{
+      std::vector<double> rts;
+      std::vector<double> intensities;
+      std::vector<double> theoretical_ints; ///< theoretical intensity of the trace the peak belongs to
+      std::vector<double> weights; ///< residual weight of the peak (theoretical intensity if weighted, otherwise 1)
+      //@}
+
+      /// Fills the peak arrays from the traces in @p traces_ptr (called once per fit, so the functors don't need to walk the traces in every iteration)
+      void packPeaks();
     };
 
     void updateMembers_() override;
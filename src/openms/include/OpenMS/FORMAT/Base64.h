@@ -164,6 +164,17 @@ private:
     static void stringSimdEncoder_(std::string& in, std::string& out);
 
     static void stringSimdDecoder_(const std::string& in, std::string& out);
+
+    /**
+      @brief Decodes @p in_size Base64 characters from @p in directly into @p out
+
+      @p out must provide at least decodedSize_(in, in_size) bytes; nothing is written beyond that.
+      The input length is expected to be a multiple of 4.
+    */
+    static void stringSimdDecoder_(const char* in, const Size in_size, char* out);
+
+    /// Number of bytes encoded by the Base64 string @p in (i.e. without padding)
+    static Size decodedSize_(const char* in, const Size in_size);
   };
 
   // Possible optimization: add simd registerwise endianizer (this will only be beneficial for ARM, since mzML + x64 CPU does not need to convert since both use LITTLE_ENDIAN).
@@ -282,31 +293,11 @@ private:
 
     constexpr Size element_size = sizeof(ToType);
 
-    String decompressed;
+    std::string decompressed;
 
     String s;
     stringSimdDecoder_(in, s);
-    QByteArray bazip = QByteArray::fromRawData(s.c_str(), (int) s.size());
-
-   /////////////////////////////////////////////////////////////////////////////////////if faster: first encode then call fromRawData
-   // QByteArray qt_byte_array = QByteArray::fromRawData(in.c_str(), (int) in.size());
-   // QByteArray bazip = QByteArray::fromBase64(qt_byte_array);
-    QByteArray czip;
-    czip.resize(4);
-    czip[0] = (bazip.size() & 0xff000000) >> 24;
-    czip[1] = (bazip.size() & 0x00ff0000) >> 16;
-    czip[2] = (bazip.size() & 0x0000ff00) >> 8;
-    czip[3] = (bazip.size() & 0x000000ff);
-    czip += bazip;
-    QByteArray base64_uncompressed = qUncompress(czip);
-
-    if (base64_uncompressed.isEmpty())
-    {
-      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
-    }
-    decompressed.resize(base64_uncompressed.size());
-
-    std::copy(base64_uncompressed.begin(), base64_uncompressed.end(), decompressed.begin());
+    ZlibCompression::uncompressString(s.data(), s.size(), decompressed);
 
     void* byte_buffer = reinterpret_cast<void *>(&decompressed[0]);
     Size buffer_size = decompressed.size();
@@ -345,27 +336,19 @@ private:
       throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Malformed base64 input, length is not a multiple of 4.");
     }
 
-    Size src_size = in.size();
-    // last one or two '=' are skipped if contained
-    int padding = 0;
-    if (in[src_size - 1] == '=') padding++;
-    if (in[src_size - 2] == '=') padding++;
-
-    src_size -= padding;
-
     constexpr Size element_size = sizeof(ToType);
-    String s;
-    stringSimdDecoder_(in,s);
+    const Size byte_count = decodedSize_(in.data(), in.size());
+
+    // decode straight into the result (rounded up, incomplete trailing bytes are cut off below)
+    out.resize((byte_count + element_size - 1) / element_size);
+    stringSimdDecoder_(in.data(), in.size(), reinterpret_cast<char*>(out.data()));
+    out.resize(byte_count / element_size);
 
     // change endianness if necessary (mzML is always LITTLE_ENDIAN; x64 is LITTLE_ENDIAN)
     if ((OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_LITTLEENDIAN) || (!OPENMS_IS_BIG_ENDIAN && from_byte_order == Base64::BYTEORDER_BIGENDIAN))
     {
-      invertEndianess<element_size>((void*)s.data(), s.size() / element_size);
+      invertEndianess<element_size>((void*)out.data(), out.size());
     }
-
-    const char* cptr = s.data();
-    const ToType * fptr = reinterpret_cast<const ToType*>(cptr);
-    out.assign(fptr,fptr + s.size()/element_size);
   }
 
   template <typename FromType>
@@ -440,25 +423,11 @@ private:
     Size buffer_size;
     constexpr Size element_size = sizeof(ToType);
 
-    String decompressed;
+    std::string decompressed;
 
     QByteArray qt_byte_array = QByteArray::fromRawData(in.c_str(), (int) in.size());
     QByteArray bazip = QByteArray::fromBase64(qt_byte_array);
-    QByteArray czip;
-    czip.resize(4);
-    czip[0] = (bazip.size() & 0xff000000) >> 24;
-    czip[1] = (bazip.size() & 0x00ff0000) >> 16;
-    czip[2] = (bazip.size() & 0x0000ff00) >> 8;
-    czip[3] = (bazip.size() & 0x000000ff);
-    czip += bazip;
-    QByteArray base64_uncompressed = qUncompress(czip);
-    if (base64_uncompressed.isEmpty())
-    {
-      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
-    }
-    decompressed.resize(base64_uncompressed.size());
-
-    std::copy(base64_uncompressed.begin(), base64_uncompressed.end(), decompressed.begin());
+    ZlibCompression::uncompressString(bazip.constData(), (size_t) bazip.size(), decompressed);
 
     byte_buffer = reinterpret_cast<void *>(&decompressed[0]);
     buffer_size = decompressed.size();
@@ -11,6 +11,9 @@
 #include <xercesc/util/BinInputStream.hpp>
 #include <xercesc/util/PlatformUtils.hpp>
 #include <OpenMS/FORMAT/Bzip2Ifstream.h>
+#include <OpenMS/FORMAT/ReadAheadBuffer.h>
+
+#include <memory>
 
 
 namespace OpenMS
@@ -19,6 +22,7 @@ namespace OpenMS
   /**
     * @brief Implements the BinInputStream class of the xerces-c library in order to read bzip2 compressed XML files.
     *
+    * Decompression runs ahead of the parser on a separate thread (see ReadAheadBuffer).
   */
   class OPENMS_DLLAPI Bzip2InputStream :
     public xercesc::BinInputStream
@@ -69,8 +73,13 @@ public:
 
 
 private:
+    ///starts decompressing on the read ahead thread
+    void startReading_();
+
     ///pointer to an compression stream
     Bzip2Ifstream* bzip2_;
+    ///decompresses on a separate thread (only uses bzip2_ while it exists)
+    std::unique_ptr<ReadAheadBuffer> read_ahead_;
     ///current index of the actual file
     XMLSize_t       file_current_index_;
 
@@ -87,7 +96,7 @@ private:
 
   inline bool Bzip2InputStream::getIsOpen() const
   {
-    return bzip2_->isOpen();
+    return !read_ahead_->atEnd();
   }
 
 } // namespace OpenMS
@@ -11,6 +11,9 @@
 #include <OpenMS/KERNEL/MSExperiment.h>
 
 #include <fstream>
+#include <memory>
+
+class QFile;
 
 namespace OpenMS
 {
@@ -23,6 +26,12 @@ namespace OpenMS
     be very fast and done in random order (once the in-memory index is built
     for the file).
 
+    On load, the cached file is memory mapped read-only if the platform
+    allows it. Data items are then copied straight from the mapped pages
+    without any stream positioning or read calls, and copies of this object
+    share the same mapping. If mapping fails (e.g. address space
+    exhaustion on 32 bit systems), a regular file stream is used instead.
+
   */
   class OPENMS_DLLAPI CachedmzML
   {
@@ -52,6 +61,12 @@ public:
 
     size_t getNrChromatograms() const;
 
+    /// Whether data is read from a memory mapping of the cached file (instead of a file stream)
+    bool isMemoryMapped() const;
+
+    /// Whether the cached file stores zlib compressed records
+    bool isCompressed() const;
+
     const MSExperiment& getMetaData() const
     {
       return meta_ms_experiment_;
@@ -62,10 +77,11 @@ public:
 
       @p filename The data location (ends in .mzML)
       @p map has to be an MSExperiment or have the same interface.
+      @p compress Compress each spectrum and chromatogram record of the cached file individually (zlib)
 
       @exception Exception::UnableToCreateFile is thrown if the file could not be created
     */
-    static void store(const String& filename, const PeakMap& map);
+    static void store(const String& filename, const PeakMap& map, bool compress = false);
 
     /**
       @brief Loads a map from a cached MzML file
@@ -82,6 +98,22 @@ protected:
 
     void load_(const String& filename);
 
+    /// Try to map the cached file into memory; leaves the mapping empty on failure
+    void mapCachedFile_();
+
+    /**
+      @brief Locate the plain (uncompressed) record of a data item starting at @p offset
+
+      Points into the memory mapping for uncompressed files; compressed records
+      are decompressed into @p buffer first.
+
+      @return Start of the record (and its size in @p record_size), or nullptr if the
+      data item has to be read from the file stream directly
+
+      @throws Exception::ParseError if the record cannot be located or decompressed
+    */
+    const char* getRecord_(std::streamoff offset, std::string& buffer, Size& record_size);
+
     /// Meta data
     MSExperiment meta_ms_experiment_;
 
@@ -98,6 +130,18 @@ protected:
     std::vector<std::streampos> spectra_index_;
     std::vector<std::streampos> chrom_index_;
 
+    /// The mapped cached file (shared between copies, keeps the mapping alive)
+    std::shared_ptr<QFile> mapped_file_;
+
+    /// Start of the read-only mapping of the cached file (nullptr if not mapped)
+    const char* mapped_data_ = nullptr;
+
+    /// Size of the mapping in bytes
+    Size mapped_size_ = 0;
+
+    /// Whether records in the cached file are compressed
+    bool compressed_ = false;
+
   };
 }
 
@@ -16,6 +16,12 @@
 namespace OpenMS
 {
   class ConsensusMap;
+
+  namespace Interfaces
+  {
+    class IConsensusDataConsumer;
+  }
+
   /**
     @brief This class provides Input functionality for ConsensusMaps and Output functionality for
     alignments and quantitation.
@@ -57,6 +63,20 @@ public:
     */
     void store(const String& filename, const ConsensusMap& consensus_map);
 
+    /**
+    @brief Reads the consensus features of a file one by one and passes them to @p consumer
+
+    The consensus map is never held in memory as a whole. Before the first
+    consensus feature, the meta data of the map (column headers,
+    identification runs, ...) is passed to the consumer
+    (Interfaces::IConsensusDataConsumer::setMapMetaData()).
+    The range options of getOptions() apply.
+
+    @exception Exception::FileNotFound is thrown if the file could not be opened
+    @exception Exception::ParseError is thrown if an error occurs during parsing
+    */
+    void transform(const String& filename, Interfaces::IConsensusDataConsumer* consumer);
+
     /// Mutable access to the options for loading/storing
     PeakFileOptions& getOptions();
 
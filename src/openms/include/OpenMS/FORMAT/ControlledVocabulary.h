@@ -106,6 +106,24 @@ public:
     */
     void loadFromOBO(const String& name, const String& filename);
 
+    /**
+        @brief Stores the CV in the binary snapshot file @p snapshot_file
+
+        Loading a snapshot is much faster than parsing the OBO files. The size and modification time of the
+        @p sources (the OBO files the CV was loaded from) are stored as well, so loadSnapshot() can detect
+        outdated snapshots.
+
+        @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    void storeSnapshot(const String& snapshot_file, const StringList& sources) const;
+
+    /**
+        @brief Replaces the CV by the content of the binary snapshot file @p snapshot_file (see storeSnapshot())
+
+        @return false (and the CV is unchanged) if @p snapshot_file does not exist, is not a valid snapshot or is outdated with respect to @p sources
+    */
+    bool loadSnapshot(const String& snapshot_file, const StringList& sources);
+
     /// Returns true if the term is in the CV. Returns false otherwise.
     bool exists(const String& id) const;
 
@@ -189,6 +207,9 @@ public:
         <li>BTO (CV/brenda.obo)</li>
         <li>GO (goslim_goa.obo)</li>
       </ul>
+
+      The parsed CV is cached as a binary snapshot in File::getCacheDirectory(), which is used instead of
+      the OBO files as long as none of them changed.
     */
     static const ControlledVocabulary& getPSIMSCV();
 
@@ -0,0 +1,94 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/INTERFACES/IConsensusDataConsumer.h>
+
+#include <OpenMS/FORMAT/HANDLERS/ConsensusXMLHandler.h>
+#include <OpenMS/KERNEL/ConsensusMap.h>
+
+#include <fstream>
+
+namespace OpenMS
+{
+  /**
+    @brief Consumer class that writes consensus features to disk using the consensusXML format.
+
+    Consensus features are written as soon as they are consumed, so
+    arbitrarily large consensus maps can be written (or, together with
+    ConsensusXMLFile::transform(), filtered and converted) without holding
+    them in memory.
+
+    Example usage:
+
+    @code
+    ConsensusXMLWritingConsumer consumer(outfile);
+    consumer.setMapMetaData(meta); // the map without consensus features, incl. column headers
+    [...]
+    // multiple times ...
+    consumer.consumeConsensusFeature(feature);
+    [...]
+    // the file is completed when the consumer is destroyed
+    @endcode
+
+    @note The first call of consumeConsensusFeature() writes the header of the
+    file (everything before the first consensus feature). The meta data thus
+    cannot be changed afterwards.
+
+    @note Consensus features without a valid unique id get a new one, but
+    neither the uniqueness of ids nor the consistency of the map indices with
+    the column headers is checked (unlike ConsensusXMLFile::store()).
+  */
+  class OPENMS_DLLAPI ConsensusXMLWritingConsumer :
+    public Internal::ConsensusXMLHandler,
+    public Interfaces::IConsensusDataConsumer
+  {
+public:
+    /**
+      @brief Constructor
+
+      @param filename Filename of the consensusXML output
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    explicit ConsensusXMLWritingConsumer(const String& filename);
+
+    /// Destructor (completes the file)
+    ~ConsensusXMLWritingConsumer() override;
+
+    /// @name IConsensusDataConsumer interface
+    //@{
+    /// Writes @p f to the file (see class description)
+    void consumeConsensusFeature(ConsensusFeature& f) override;
+
+    /// Not needed for consensusXML (the format does not store the number of consensus features)
+    void setExpectedSize(Size expected_features) override;
+
+    /// Sets the meta data of the file (any consensus features contained in @p map are ignored)
+    void setMapMetaData(const ConsensusMap& map) override;
+    //@}
+
+    /// Number of consensus features written so far
+    Size getNrFeaturesWritten() const;
+
+protected:
+    /// Writes the header and the consensusElementList start tag, unless done already
+    void startWriting_();
+
+    /// File stream (to write consensusXML)
+    std::ofstream ofs_;
+    /// Meta data of the map
+    ConsensusMap meta_;
+    /// Stores whether the header has been written already
+    bool started_writing_;
+    /// Number of consensus features written
+    Size features_written_;
+  };
+
+} //end namespace OpenMS
@@ -0,0 +1,95 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/INTERFACES/IFeatureDataConsumer.h>
+
+#include <OpenMS/FORMAT/HANDLERS/FeatureXMLHandler.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+
+#include <fstream>
+
+namespace OpenMS
+{
+  /**
+    @brief Consumer class that writes features to disk using the featureXML format.
+
+    Features are written as soon as they are consumed, so arbitrarily large
+    feature maps can be written (or, together with FeatureXMLFile::transform(),
+    filtered and converted) without holding them in memory.
+
+    Example usage:
+
+    @code
+    FeatureXMLWritingConsumer consumer(outfile);
+    consumer.setExpectedSize(nr_features); // optional, the count attribute of featureList
+    consumer.setMapMetaData(meta); // optional, the map without features
+    [...]
+    // multiple times ...
+    consumer.consumeFeature(feature);
+    [...]
+    // the file is completed when the consumer is destroyed
+    @endcode
+
+    @note The first call of consumeFeature() writes the header of the file
+    (everything before the first feature). The meta data and the expected
+    size thus cannot be changed afterwards.
+
+    @note Features without a valid unique id get a new one, but the uniqueness
+    of ids is not checked (unlike FeatureXMLFile::store()).
+  */
+  class OPENMS_DLLAPI FeatureXMLWritingConsumer :
+    public Internal::FeatureXMLHandler,
+    public Interfaces::IFeatureDataConsumer
+  {
+public:
+    /**
+      @brief Constructor
+
+      @param filename Filename of the featureXML output
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    explicit FeatureXMLWritingConsumer(const String& filename);
+
+    /// Destructor (completes the file)
+    ~FeatureXMLWritingConsumer() override;
+
+    /// @name IFeatureDataConsumer interface
+    //@{
+    /// Writes @p f to the file (see class description)
+    void consumeFeature(Feature& f) override;
+
+    /// Sets the number written to the count attribute of the featureList tag
+    void setExpectedSize(Size expected_features) override;
+
+    /// Sets the meta data of the file (any features contained in @p map are ignored)
+    void setMapMetaData(const FeatureMap& map) override;
+    //@}
+
+    /// Number of features written so far
+    Size getNrFeaturesWritten() const;
+
+protected:
+    /// Writes the header and the featureList start tag, unless done already
+    void startWriting_();
+
+    /// File stream (to write featureXML)
+    std::ofstream ofs_;
+    /// Meta data of the map
+    FeatureMap meta_;
+    /// Stores whether the header has been written already
+    bool started_writing_;
+    /// Number of features written
+    Size features_written_;
+    /// Number of features expected
+    Size features_expected_;
+  };
+
+} //end namespace OpenMS
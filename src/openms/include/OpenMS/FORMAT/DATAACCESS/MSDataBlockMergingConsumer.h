@@ -0,0 +1,98 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/INTERFACES/IMSDataConsumer.h>
+
+#include <OpenMS/PROCESSING/SPECTRAMERGING/SpectraMerger.h>
+
+#include <map>
+#include <vector>
+
+namespace OpenMS
+{
+
+    /**
+      @brief Merges blocks of spectra (see SpectraMerger::mergeSpectraBlockWise()) while streaming the data
+
+      This consumer collects consecutive spectra of the MS levels given by
+      @p block_method:ms_levels into blocks (using the block_method parameters
+      of the given SpectraMerger) and passes the merged consensus spectrum of
+      each block to the next consumer (see Constructor) as soon as the block
+      is complete. Spectra of all other MS levels and chromatograms are passed
+      on unchanged. Only one block per MS level is kept in memory.
+
+      The consensus spectra are the same as the ones from
+      SpectraMerger::mergeSpectraBlockWise(), given the spectra are consumed
+      in order of RT. However, they are passed on in the order in which their
+      blocks are completed, i.e. they are not sorted by their (averaged) RT.
+
+      @note Remaining blocks are passed on by flush() or when this object is destroyed.
+    */
+    class OPENMS_DLLAPI MSDataBlockMergingConsumer :
+      public Interfaces::IMSDataConsumer
+    {
+
+    public:
+
+      /**
+        @brief Constructor
+
+        @param next_consumer Receives the merged spectra
+        @param merger Provides the parameters for merging ('block_method:*', 'mz_binning_width' and 'mz_binning_width_unit')
+
+        @exception Exception::InvalidParameter if 'block_method:rt_block_size' is smaller than 1
+
+        @note This does not transfer ownership of the consumer
+      */
+      MSDataBlockMergingConsumer(Interfaces::IMSDataConsumer* next_consumer, const SpectraMerger& merger);
+
+      /**
+        @brief Destructor
+
+        Flushes data to next consumer
+
+        @note It is essential to not delete the underlying next_consumer before
+        deleting this object, otherwise we risk a memory error
+      */
+      ~MSDataBlockMergingConsumer() override;
+
+      void setExpectedSize(Size, Size) override {}
+
+      void consumeSpectrum(SpectrumType& s) override;
+
+      void consumeChromatogram(ChromatogramType& c) override;
+
+      void setExperimentalSettings(const OpenMS::ExperimentalSettings& exp) override;
+
+      /// Merges the open blocks of all MS levels and passes them to the next consumer
+      void flush();
+
+    protected:
+
+      /// A block of spectra of one MS level which is still being collected
+      struct Block_
+      {
+        std::vector<SpectrumType> spectra; ///< the first spectrum is the master spectrum
+        UInt size_count = 0; ///< counter for the block size (as in SpectraMerger::mergeSpectraBlockWise())
+      };
+
+      /// Passes the (merged) block on; blocks consisting of a single spectrum are only merged if @p last is true (as in SpectraMerger::mergeSpectraBlockWise())
+      void finishBlock_(Block_& block, const UInt ms_level, const bool last);
+
+      Interfaces::IMSDataConsumer* next_consumer_;
+      SpectraMerger merger_;
+      std::vector<Int> ms_levels_;
+      UInt rt_block_size_;
+      double rt_max_length_;
+      /// open block per MS level
+      std::map<UInt, Block_> blocks_;
+    };
+
+} //end namespace OpenMS
@@ -42,13 +42,15 @@ namespace OpenMS
         @param filename The output file name to which data is written
         @param clearData Whether to clear the spectral and chromatogram data
         after writing (only keep meta-data)
+        @param compress Whether to zlib compress each spectrum and chromatogram
+        record (see CachedMzMLHandler)
 
         @note Clearing data from spectra and chromatograms also clears float
         and integer data arrays associated with the structure as these are
         written to disk as well.
 
       */
-      MSDataCachedConsumer(const String& filename, bool clearData=true);
+      MSDataCachedConsumer(const String& filename, bool clearData=true, bool compress=false);
 
       /**
         @brief Destructor
@@ -78,6 +80,7 @@ namespace OpenMS
     protected:
       std::ofstream ofs_;
       bool clearData_;
+      bool compress_;
       Size spectra_written_;
       Size chromatograms_written_;
 
@@ -0,0 +1,82 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/INTERFACES/IMSDataConsumer.h>
+
+#include <OpenMS/CONCEPT/CommonEnums.h>
+#include <OpenMS/MATH/MathFunctions.h>
+#include <OpenMS/PROCESSING/SPECTRAMERGING/SpectraMerger.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+
+    /**
+      @brief Bins ion mobility frames into IM bins while streaming the data (see IMDataConverter::splitExperimentByIonMobility())
+
+      Each consumed IM frame is binned using IMDataConverter::binIMFrame() and the
+      spectrum of each bin (if the frame has peaks in it) is passed to the consumer of
+      that bin (see Constructor). Only the current frame is kept in memory, so e.g.
+      PASEF frames can be binned while loading an mzML file, without holding the
+      whole input.
+
+      Given the same @p bins, the spectra passed to the consumer of a bin are the
+      spectra of the corresponding MSExperiment of
+      IMDataConverter::splitExperimentByIonMobility(). Like there, chromatograms
+      are not passed on.
+    */
+    class OPENMS_DLLAPI MSDataIMBinningConsumer :
+      public Interfaces::IMSDataConsumer
+    {
+
+    public:
+
+      /**
+        @brief Constructor
+
+        @param bin_consumers Receive the spectra of the respective bin
+        @param bins The IM bins (see Math::createBins())
+        @param mz_binning_width The width of the m/z binning window, when merging spectra of the same IM-bin (in Da or ppm, see @p mz_binning_width_unit)
+        @param mz_binning_width_unit The unit of the m/z binning window (Da or ppm)
+
+        @exception Exception::InvalidValue if the number of @p bin_consumers and @p bins differ
+
+        @note This does not transfer ownership of the consumers
+      */
+      MSDataIMBinningConsumer(const std::vector<Interfaces::IMSDataConsumer*>& bin_consumers,
+                              const Math::BinContainer& bins,
+                              double mz_binning_width,
+                              MZ_UNITS mz_binning_width_unit);
+
+      ~MSDataIMBinningConsumer() override = default;
+
+      void setExpectedSize(Size, Size) override {}
+
+      /**
+        @brief Bins the IM frame @p s and passes the spectra to the consumers of the bins
+
+        @exception Exception::InvalidValue if @p s does not contain 'wide' IM data (see MSSpectrum::containsIMData())
+      */
+      void consumeSpectrum(SpectrumType& s) override;
+
+      /// Chromatograms are not passed on
+      void consumeChromatogram(ChromatogramType&) override {}
+
+      void setExperimentalSettings(const OpenMS::ExperimentalSettings& exp) override;
+
+    protected:
+
+      std::vector<Interfaces::IMSDataConsumer*> bin_consumers_;
+      Math::BinContainer bins_;
+      SpectraMerger merger_;
+    };
+
+} //end namespace OpenMS
@@ -28,6 +28,8 @@
 #include <OpenMS/FORMAT/HANDLERS/CachedMzMLHandler.h>
 #include <OpenMS/KERNEL/StandardTypes.h>
 
+#include <functional>
+
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -528,6 +530,132 @@ protected:
     std::vector<int> nr_ms2_spectra_;
   };
 
+  /**
+   * @brief Streaming implementation of FullSwathFileConsumer with bounded memory
+   *
+   * Keeps the spectra of each SWATH window in memory until the window is
+   * complete, i.e. until the expected number of spectra (@p nr_ms2_spectra,
+   * see SwathFile) has been consumed for it. A complete window is handed to
+   * the window callback right away, so for inputs sorted by window (e.g.
+   * concatenated per-window files) the first windows can be processed while
+   * the remaining ones are still being read. Windows which are not complete
+   * when all spectra are consumed are handed to the callback in
+   * retrieveSwathMaps().
+   *
+   * The spectral data held in memory is bounded by @p memory_budget (in
+   * bytes, 0 for no bound). When the budget is exceeded, cold windows are
+   * spilled to disk in the format of CachedSwathFileConsumer: first the
+   * windows already handed to the callback (least recently completed first),
+   * then the incomplete windows which least recently received a spectrum and
+   * finally the MS1 map. All further spectra of a spilled window are written
+   * to disk directly.
+   *
+   * @note The MS1 map is only complete once all spectra are consumed and is
+   * only available through retrieveSwathMaps().
+   *
+   */
+  class OPENMS_DLLAPI StreamingSwathFileConsumer :
+    public FullSwathFileConsumer
+  {
+
+public:
+    typedef PeakMap MapType;
+    typedef MapType::SpectrumType SpectrumType;
+    typedef MapType::ChromatogramType ChromatogramType;
+
+    /// Called with each SWATH window as soon as it is complete
+    typedef std::function<void(const OpenSwath::SwathMap&)> WindowCallback;
+
+    /**
+     * @brief Constructor
+     *
+     * @param known_window_boundaries The expected SWATH windows
+     * @param cachedir Directory for spilled windows
+     * @param basename Basename of the cache files of spilled windows
+     * @param nr_ms2_spectra Number of spectra expected for each window
+     * @param memory_budget Maximal size of the spectral data kept in memory (in bytes, 0 for no bound)
+     * @param window_ready Callback for complete windows (may be empty)
+     *
+     */
+    StreamingSwathFileConsumer(std::vector<OpenSwath::SwathMap> known_window_boundaries,
+            const String& cachedir, const String& basename, const std::vector<int>& nr_ms2_spectra,
+            Size memory_budget, WindowCallback window_ready = WindowCallback());
+
+    ~StreamingSwathFileConsumer() override;
+
+    /// Size of the spectral data currently kept in memory (in bytes)
+    Size getMemoryUsage() const;
+
+    /// Number of maps (SWATH and MS1) spilled to disk so far
+    Size getNrSpilledMaps() const;
+
+protected:
+
+    /// State of a single map while consuming
+    struct MapBuffer_
+    {
+      /// Writes spectra to disk once the map is spilled (open until the map is complete)
+      MSDataCachedConsumer* cache = nullptr;
+      /// Whether the map was spilled to disk
+      bool spilled = false;
+      /// Whether the map was handed to the callback
+      bool complete = false;
+      /// Size of the spectral data in memory
+      Size bytes = 0;
+      /// Number of consumed spectra
+      Size nr_spectra = 0;
+      /// Time of the last access (spectrum consumed or map completed)
+      Size last_used = 0;
+    };
+
+    /// Approximate size of the spectral data of @p s (peaks and data arrays)
+    static Size estimateMemory_(const SpectrumType& s);
+
+    void consumeSwathSpectrum_(MapType::SpectrumType& s, size_t swath_nr) override;
+
+    void consumeMS1Spectrum_(MapType::SpectrumType& s) override;
+
+    void ensureMapsAreFilled_() override;
+
+    /// Appends @p s to @p map, either in memory or on disk
+    void addSpectrum_(MapType::SpectrumType& s, MapBuffer_& buffer, boost::shared_ptr<PeakMap>& map);
+
+    /// Hands window @p swath_nr to the callback (after finishing its cache file)
+    void completeWindow_(Size swath_nr);
+
+    /// Writes the spectra of @p map to a cache file, keeping only the meta data in memory
+    void spill_(MapBuffer_& buffer, boost::shared_ptr<PeakMap>& map, const String& meta_file);
+
+    /// Closes the cache file of a spilled map and replaces it by the map loaded from disk
+    void finishCache_(MapBuffer_& buffer, boost::shared_ptr<PeakMap>& map, const String& meta_file);
+
+    /// Spills cold maps until the memory budget is kept
+    void enforceBudget_();
+
+    /// Meta data file of window @p swath_nr (the cache file has the additional suffix ".cached")
+    String windowFile_(Size swath_nr) const;
+
+    /// Meta data file of the MS1 map
+    String ms1File_() const;
+
+    /// Closes all open cache files
+    void closeCaches_();
+
+    std::vector<MapBuffer_> swath_buffers_;
+    MapBuffer_ ms1_buffer_;
+
+    String cachedir_;
+    String basename_;
+    std::vector<int> nr_ms2_spectra_;
+    Size memory_budget_;
+    WindowCallback window_ready_;
+
+    /// Size of the spectral data in memory
+    Size memory_used_;
+    /// Access counter for choosing cold maps
+    Size clock_;
+  };
+
   /**
    * @brief On-disk mzML implementation of FullSwathFileConsumer
    *
@@ -3,9 +3,13 @@ set(directory include/OpenMS/FORMAT/DATAACCESS)
 
 ### list all header files of the directory here
 set(sources_list_h
+  ConsensusXMLWritingConsumer.h
+  FeatureXMLWritingConsumer.h
   MSDataAggregatingConsumer.h
+  MSDataBlockMergingConsumer.h
   MSDataCachedConsumer.h
   MSDataChainingConsumer.h
+  MSDataIMBinningConsumer.h
   MSDataStoringConsumer.h
   MSDataSqlConsumer.h
   MSDataTransformingConsumer.h
@@ -11,6 +11,7 @@
 #include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/CONCEPT/Types.h>
 
 #include <fstream>
 #include <utility>
@@ -29,6 +30,10 @@ namespace OpenMS
       and writeStart(), writeNext(), writeEnd() for more memory efficiency.
       Reading from one and writing to another FASTA file can be handled by
       one single FASTAFile instance.
+
+      For random access and parallel parsing of large files, build an index of the entry offsets
+      using buildIndex() (or loadOrBuildIndex(), which caches the index in a file next to the FASTA file)
+      and read any range of entries with readEntries(). load() uses this internally.
     */
 
     class OPENMS_DLLAPI FASTAFile : public ProgressLogger
@@ -148,7 +153,7 @@ namespace OpenMS
 
         /**
           @brief loads a FASTA file given by 'filename' and stores the information in 'data'
-          This uses more RAM than readStart() and readNext().
+          This uses more RAM than readStart() and readNext(), but parses the entries in parallel (see readEntries()).
           @exception Exception::FileNotFound is thrown if the file does not exists.
           @exception Exception::ParseError is thrown if the file does not suit to the standard.
         */
@@ -162,6 +167,56 @@ namespace OpenMS
           */
         void store(const String& filename, const std::vector<FASTAEntry>& data) const;
 
+        /**
+          @brief Builds an index of the entries in the FASTA file @p filename
+
+          The file is memory mapped and scanned for '>' at the beginning of a line (the header of PEFF files is skipped).
+          No entries are parsed.
+
+          @return The byte offsets of all entries, followed by the file size (i.e. there is one element more than there are entries)
+          @exception Exception::FileNotFound is thrown if the file does not exists.
+          @exception Exception::FileNotReadable is thrown if the file is not readable.
+        */
+        static std::vector<Int64> buildIndex(const String& filename);
+
+        /**
+          @brief Stores the index @p offsets of @p filename (see buildIndex()) in @p index_file
+
+          The size and modification time of @p filename are stored as well, so loadIndex() can detect outdated indices.
+          @exception Exception::UnableToCreateFile is thrown if the file could not be created
+        */
+        static void storeIndex(const String& index_file, const String& filename, const std::vector<Int64>& offsets);
+
+        /**
+          @brief Loads the index of @p filename from @p index_file
+
+          @return false (and @p offsets is empty) if @p index_file does not exist, is not a valid index or is outdated with respect to @p filename
+        */
+        static bool loadIndex(const String& index_file, const String& filename, std::vector<Int64>& offsets);
+
+        /**
+          @brief Loads the index from the index file of @p filename (see getIndexName()) or, if that fails, builds it
+
+          After building, the index is written to the index file if @p write_index is true
+          (failures to write it, e.g. in read-only directories, are ignored).
+          @exception Exception::FileNotFound is thrown if the file does not exists.
+          @exception Exception::FileNotReadable is thrown if the file is not readable.
+        */
+        static std::vector<Int64> loadOrBuildIndex(const String& filename, bool write_index = true);
+
+        /// Name of the index file of the FASTA file @p filename
+        static String getIndexName(const String& filename);
+
+        /**
+          @brief Reads the entries [@p begin, @p end) of the FASTA file @p filename, using its index @p offsets
+
+          Only the byte range of the requested entries is memory mapped. The entries are parsed in parallel.
+          @exception Exception::FileNotFound is thrown if the file does not exists.
+          @exception Exception::IndexOverflow is thrown if @p end is larger than the number of entries in @p offsets.
+          @exception Exception::ParseError is thrown if an entry could not be parsed (e.g. it has no sequence).
+        */
+        static void readEntries(const String& filename, const std::vector<Int64>& offsets, Size begin, Size end, std::vector<FASTAEntry>& data);
+
     protected:
         /**
          @brief Reads a protein entry from the current file position and returns the ID and sequence
@@ -19,6 +19,11 @@ namespace OpenMS
   class Feature;
   class FeatureMap;
 
+  namespace Interfaces
+  {
+    class IFeatureDataConsumer;
+  }
+
   /**
     @brief This class provides Input/Output functionality for feature maps
 
@@ -62,6 +67,22 @@ public:
     */
     void store(const String& filename, const FeatureMap& feature_map);
 
+    /**
+        @brief reads the features of file @p filename one by one and passes them to @p consumer
+
+        The feature map is never held in memory as a whole, so this can be used
+        for maps which are too large to be loaded (e.g. to filter or convert
+        them with FeatureXMLWritingConsumer). Before the first feature, the
+        number of features and the meta data of the map are passed to the
+        consumer (see Interfaces::IFeatureDataConsumer). The range options of
+        getOptions() apply, subordinates and convex hulls are loaded according
+        to the options.
+
+        @exception Exception::FileNotFound is thrown if the file could not be opened
+        @exception Exception::ParseError is thrown if an error occurs during parsing
+    */
+    void transform(const String& filename, Interfaces::IFeatureDataConsumer* consumer);
+
     /// Mutable access to the options for loading/storing
     FeatureFileOptions& getOptions();
 
@@ -37,6 +37,9 @@ namespace OpenMS
     It also offer a common interface to load MSExperiment data
     and allows querying for supported file types.
 
+    Experiments, feature maps and consensus maps with in-memory file names (see InMemoryFileStore)
+    are stored and loaded in memory.
+
     @see FileTypes
 
     @ingroup FileIO
@@ -10,17 +10,21 @@
 
 #include <OpenMS/config.h>
 #include <OpenMS/FORMAT/GzipIfstream.h>
+#include <OpenMS/FORMAT/ReadAheadBuffer.h>
 
 #include <xercesc/util/BinInputStream.hpp>
 #include <xercesc/util/PlatformUtils.hpp>
 
+#include <memory>
+
 namespace OpenMS
 {
   class String;
 
   /**
     * @brief Implements the BinInputStream class of the xerces-c library in order to read gzip compressed XML files.
-    * 
+    *
+    * Decompression runs ahead of the parser on a separate thread (see ReadAheadBuffer).
   */
   class OPENMS_DLLAPI GzipInputStream :
     public xercesc::BinInputStream
@@ -74,8 +78,13 @@ public:
     GzipInputStream& operator=(const GzipInputStream& stream) = delete;
 
 private:
+    ///starts decompressing on the read ahead thread
+    void startReading_();
+
     ///pointer to an compression stream
     GzipIfstream* gzip_ = nullptr;
+    ///decompresses on a separate thread (only uses gzip_ while it exists)
+    std::unique_ptr<ReadAheadBuffer> read_ahead_;
     ///current index of the actual file
     XMLSize_t file_current_index_;
   };
@@ -87,7 +96,7 @@ private:
 
   inline bool GzipInputStream::getIsOpen() const
   {
-    return gzip_->isOpen();
+    return !read_ahead_->atEnd();
   }
 
 } // namespace OpenMS
@@ -20,6 +20,7 @@
 #include <fstream>
 
 #define CACHED_MZML_FILE_IDENTIFIER 8094
+#define CACHED_MZML_ZLIB_FILE_IDENTIFIER 8095
 
 namespace OpenMS
 {
@@ -35,6 +36,13 @@ namespace Internal
     be very fast and done in random order (once the in-memory index is built
     for the file).
 
+    Optionally, each spectrum and chromatogram record can be zlib compressed
+    individually (file identifier CACHED_MZML_ZLIB_FILE_IDENTIFIER). Every
+    record is then stored as its uncompressed size, its compressed size and
+    the compressed bytes of the plain record. The index created by
+    createMemdumpIndex() still points to the start of each record, so random
+    access remains a single seek followed by decompressing one record.
+
   */
   class OPENMS_DLLAPI CachedMzMLHandler :
     public ProgressLogger
@@ -70,8 +78,14 @@ public:
     */
     //@{
 
-    /// Write complete spectra as a dump to the disk
-    void writeMemdump(const MapType& exp, const String& out) const;
+    /**
+      @brief Write complete spectra as a dump to the disk
+
+      @param exp The experiment to store
+      @param out Output filename of the cached file
+      @param compress Compress each spectrum and chromatogram record individually with zlib
+    */
+    void writeMemdump(const MapType& exp, const String& out, bool compress = false) const;
 
     /// Write only the meta data of an MSExperiment
     void writeMetadata(MapType exp, const String& out_meta, bool addCacheMetaValue=false);
@@ -94,6 +108,9 @@ public:
 
     /// Access to a constant copy of the binary chromatogram index
     const std::vector<std::streampos>& getChromatogramIndex() const;
+
+    /// Whether the file indexed by createMemdumpIndex() stores zlib compressed records
+    bool isCompressed() const;
     //@}
 
     /** @name Direct access to a single Spectrum or Chromatogram
@@ -158,6 +175,32 @@ public:
       @throws Exception::ParseError is thrown if the chromatogram size cannot be read
     */
     static std::vector<OpenSwath::BinaryDataArrayPtr> readChromatogramFast(std::ifstream& ifs);
+
+    /**
+      @brief Fast access to a spectrum stored in memory (e.g. a memory mapped cached file)
+
+      Same as readSpectrumFast(std::ifstream&, int&, double&) but reads from
+      @p buffer without any stream positioning or system calls, which makes
+      it safe to call concurrently on a shared read-only mapping.
+
+      @param buffer Start of the spectrum record (i.e. file start + index offset)
+      @param buffer_size Number of readable bytes from @p buffer onwards
+      @param ms_level Output parameter to store the MS level of the spectrum (1, 2, 3 ...)
+      @param rt Output parameter to store the retention time of the spectrum
+
+      @throws Exception::ParseError is thrown if the spectrum extends past the end of the buffer
+    */
+    static std::vector<OpenSwath::BinaryDataArrayPtr> readSpectrumFast(const char* buffer, Size buffer_size, int& ms_level, double& rt);
+
+    /**
+      @brief Fast access to a chromatogram stored in memory (e.g. a memory mapped cached file)
+
+      @param buffer Start of the chromatogram record (i.e. file start + index offset)
+      @param buffer_size Number of readable bytes from @p buffer onwards
+
+      @throws Exception::ParseError is thrown if the chromatogram extends past the end of the buffer
+    */
+    static std::vector<OpenSwath::BinaryDataArrayPtr> readChromatogramFast(const char* buffer, Size buffer_size);
     //@}
 
     /**
@@ -180,21 +223,64 @@ public:
     */
     static void readChromatogram(ChromatogramType& chromatogram, std::ifstream& ifs);
 
+    /// Read a single spectrum from memory directly into an OpenMS MSSpectrum (see readSpectrumFast(const char*, Size, int&, double&))
+    static void readSpectrum(SpectrumType& spectrum, const char* buffer, Size buffer_size);
+
+    /// Read a single chromatogram from memory directly into an OpenMS MSChromatogram (see readChromatogramFast(const char*, Size))
+    static void readChromatogram(ChromatogramType& chromatogram, const char* buffer, Size buffer_size);
+
+    /**
+      @brief Decompress a single record of a compressed cached file
+
+      The resulting @p record has the layout of an uncompressed record and can be
+      passed to the memory based read functions (e.g. readSpectrumFast(const char*, Size, int&, double&)).
+
+      @param buffer Start of the compressed record (i.e. file start + index offset)
+      @param buffer_size Number of readable bytes from @p buffer onwards
+      @param record Output buffer for the uncompressed record
+
+      @throws Exception::ParseError is thrown if the record is truncated or cannot be decompressed
+    */
+    static void uncompressRecord(const char* buffer, Size buffer_size, std::string& record);
+
+    /// Read and decompress a single record of a compressed cached file from the current stream position
+    static void uncompressRecord(std::ifstream& ifs, std::string& record);
+
 protected:
 
     /// write a single spectrum to filestream
-    void writeSpectrum_(const SpectrumType& spectrum, std::ofstream& ofs) const;
+    void writeSpectrum_(const SpectrumType& spectrum, std::ostream& ofs) const;
 
     /// write a single chromatogram to filestream
-    void writeChromatogram_(const ChromatogramType& chromatogram, std::ofstream& ofs) const;
+    void writeChromatogram_(const ChromatogramType& chromatogram, std::ostream& ofs) const;
+
+    /// write a single spectrum to filestream as a zlib compressed record
+    void writeCompressedSpectrum_(const SpectrumType& spectrum, std::ostream& ofs) const;
+
+    /// write a single chromatogram to filestream as a zlib compressed record
+    void writeCompressedChromatogram_(const ChromatogramType& chromatogram, std::ostream& ofs) const;
+
+    /// compress @p record and write it (with its header) to filestream
+    static void writeCompressedRecord_(const std::string& record, std::ostream& ofs);
 
     /// helper method for fast reading of spectra and chromatograms
     static inline void readDataFast_(std::ifstream& ifs, std::vector<OpenSwath::BinaryDataArrayPtr>& data, const Size& data_size, 
       const Size& nr_float_arrays);
 
+    /// helper method for fast reading of spectra and chromatograms from memory, advances @p pos
+    static void readDataFast_(const char*& pos, const char* end, std::vector<OpenSwath::BinaryDataArrayPtr>& data, const Size& data_size,
+      const Size& nr_float_arrays);
+
+    /// copy the raw data arrays into an MSSpectrum
+    static void fillSpectrum_(SpectrumType& spectrum, const std::vector<OpenSwath::BinaryDataArrayPtr>& data, int ms_level, double rt);
+
+    /// copy the raw data arrays into an MSChromatogram
+    static void fillChromatogram_(ChromatogramType& chromatogram, const std::vector<OpenSwath::BinaryDataArrayPtr>& data);
+
     /// Members
     std::vector<std::streampos> spectra_index_;
     std::vector<std::streampos> chrom_index_;
+    bool compressed_ = false;
 
   };
 }
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <OpenMS/CHEMISTRY/AASequenceCache.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/FORMAT/HANDLERS/XMLHandler.h>
 #include <OpenMS/FORMAT/OPTIONS/PeakFileOptions.h>
@@ -20,6 +21,11 @@
 
 namespace OpenMS
 {
+namespace Interfaces
+{
+  class IConsensusDataConsumer;
+}
+
 namespace Internal
 {
   /**
@@ -57,6 +63,16 @@ public:
     /// Docu in base class XMLHandler::writeTo
     void writeTo(std::ostream& os) override;
 
+    /**
+      @brief Passes each consensus feature to @p consumer while loading instead of storing it in the map
+
+      The map given in the constructor then only receives the meta data
+      (which is also passed to the consumer, see
+      Interfaces::IConsensusDataConsumer::setMapMetaData()).
+      Consensus features excluded by the range options are not passed on.
+    */
+    void setConsensusConsumer(Interfaces::IConsensusDataConsumer* consumer);
+
 protected:
 
     // Docu in base class
@@ -68,6 +84,12 @@ protected:
     // Docu in base class
     void characters(const XMLCh* const chars, const XMLSize_t length) override;
 
+    /// Writes everything before the &lt;consensusElementList&gt; tag (the meta data of @p consensus_map) to a stream
+    void writeHeader_(std::ostream& os, const ConsensusMap& consensus_map);
+
+    /// Writes a consensus feature to a stream
+    void writeConsensusElement_(std::ostream& os, const ConsensusFeature& elem);
+
     /// Writes a peptide identification to a stream (for assigned/unassigned peptide identifications)
     void writePeptideIdentification_(const String& filename, std::ostream& os, const PeptideIdentification& id, const String& tag_name, UInt indentation_level);
 
@@ -93,6 +115,9 @@ protected:
     double it_;
     //@}
 
+    /// Receives the consensus features while loading (if set, see setConsensusConsumer())
+    Interfaces::IConsensusDataConsumer* consumer_;
+
     /// Pointer to last read object as a MetaInfoInterface, or null.
     MetaInfoInterface* last_meta_;
     /// Temporary protein ProteinIdentification
@@ -103,6 +128,8 @@ protected:
     ProteinHit prot_hit_;
     /// Temporary peptide hit
     PeptideHit pep_hit_;
+    /// Parsed peptide sequences (the same sequence usually occurs in many hits)
+    AASequenceCache sequence_cache_;
     /// Temporary peptide evidences
     std::vector<PeptideEvidence> peptide_evidences_;
     /// Map from protein id to accession
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <OpenMS/CHEMISTRY/AASequenceCache.h>
 #include <OpenMS/FORMAT/OPTIONS/FeatureFileOptions.h>
 #include <OpenMS/FORMAT/XMLFile.h>
 #include <OpenMS/FORMAT/HANDLERS/XMLHandler.h>
@@ -25,6 +26,11 @@ namespace OpenMS
   class Feature;
   class FeatureMap;
 
+  namespace Interfaces
+  {
+    class IFeatureDataConsumer;
+  }
+
   namespace Internal
   {
 
@@ -78,6 +84,20 @@ public:
       return expected_size_;
     }
 
+    /**
+        @brief Passes each (top-level) feature to @p consumer while loading instead of storing it in the map
+
+        The map given in the constructor then only receives the meta data
+        (which is also passed to the consumer, see
+        Interfaces::IFeatureDataConsumer::setMapMetaData()) and never holds
+        more than the feature currently being parsed.
+        Features excluded by the range options are not passed on.
+    */
+    void setFeatureConsumer(Interfaces::IFeatureDataConsumer* consumer)
+    {
+      consumer_ = consumer;
+    }
+
 protected:
 
     // restore default state for next load/store operation
@@ -92,6 +112,9 @@ protected:
     // Docu in base class
     void characters(const XMLCh* const chars, const XMLSize_t length) override;
 
+    /// Writes everything before the &lt;featureList&gt; tag (the meta data of @p feature_map) to a stream
+    void writeHeader_(std::ostream& os, const FeatureMap& feature_map);
+
     /// Writes a feature to a stream
     void writeFeature_(const String& filename, std::ostream& os, const Feature& feat, const String& identifier_prefix, UInt64 identifier, UInt indentation_level);
 
@@ -122,6 +145,8 @@ protected:
     bool size_only_;
     /// holds the putative size given in count
     Size expected_size_;
+    /// receives the features while loading (if set, see setFeatureConsumer())
+    Interfaces::IFeatureDataConsumer* consumer_;
 
     /**@name temporary data structures to hold parsed data */
     //@{
@@ -150,6 +175,8 @@ protected:
     ProteinHit prot_hit_;
     /// Temporary peptide hit
     PeptideHit pep_hit_;
+    /// Parsed peptide sequences (the same sequence usually occurs in many hits)
+    AASequenceCache sequence_cache_;
     /// Map from protein id to accession
     std::map<String, String> proteinid_to_accession_;
     /// Map from search identifier concatenated with protein accession to id
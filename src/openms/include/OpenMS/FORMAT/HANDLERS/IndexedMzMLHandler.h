@@ -18,8 +18,12 @@
 
 #include <string>
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 
+class QFile;
+
 namespace OpenMS
 {
 
@@ -44,10 +48,13 @@ namespace Internal
     extracting all the offsets of the &lt;chromatogram&gt; and &lt;spectrum&gt; tags. These
     offsets are stored as members of this class as well as the offset to the &lt;indexList&gt; element
 
-    @note This implementation is @a not thread-safe since it keeps internally a
-    single file access pointer which it moves when accessing a specific
-    data item. The caller is responsible to ensure that access is performed
-    atomically.
+    The file is memory mapped read-only (if possible), so that the raw text
+    of a spectrum or chromatogram is read by position without moving a shared
+    file pointer. If mapping fails (e.g. address space exhaustion on 32 bit
+    systems), a single file stream is used and access to it is serialized
+    internally. Either way, all data access functions can be called
+    concurrently from multiple threads; copies of this object share the
+    mapping.
 
   */
   class OPENMS_DLLAPI IndexedMzMLHandler
@@ -66,12 +73,26 @@ namespace Internal
     std::streampos index_offset_;
     /// Whether spectra are written before chromatograms in this file
     bool spectra_before_chroms_;
-    /// The current filestream (opened by openFile)
+    /// The current filestream (opened by openFile, only used if the file could not be mapped)
     std::ifstream filestream_;
+
+    /// Serializes access to filestream_
+    std::mutex filestream_mutex_;
+
+    /// The mapped file (shared between copies, keeps the mapping alive)
+    std::shared_ptr<QFile> mapped_file_;
+
+    /// Start of the read-only mapping of the file (nullptr if not mapped)
+    const char* mapped_data_ = nullptr;
+
+    /// Size of the mapping in bytes
+    Size mapped_size_ = 0;
     /// Whether parsing the indexedmzML file was successful
     bool parsing_success_;
     /// Whether to skip XML checks
     bool skip_xml_checks_;
+    /// Whether to index files without \<indexList\> using OffsetIndexFile
+    bool offset_index_fallback_;
 
     /**
       @brief Try to parse the footer of the indexedmzML
@@ -83,6 +104,20 @@ namespace Internal
     */
     void parseFooter_();
 
+    /**
+      @brief Build the offsets from an OffsetIndexFile (for files without \<indexList\>)
+
+      Upon success, the chromatogram and spectra offsets will be populated and
+      parsing_success_ will be set to true.
+    */
+    void parseOffsetIndex_();
+
+    /// Try to map the file into memory; leaves the mapping empty on failure
+    void mapFile_();
+
+    /// Read the raw text between @p startidx and @p endidx (from the mapping or the stream)
+    std::string readRange_(std::streampos startidx, std::streampos endidx);
+
     std::string getChromatogramById_helper_(int id);
 
     std::string getSpectrumById_helper_(int id);
@@ -221,6 +256,24 @@ namespace Internal
       skip_xml_checks_ = skip;
     }
 
+    /**
+      @brief Whether to support mzML files without index (needs to be set before openFile())
+
+      If enabled, files without \<indexList\> are indexed by a fast pre-scan
+      (see OffsetIndexFile) instead of failing to parse. The resulting index is
+      cached in a sidecar file next to the mzML file, if possible.
+    */
+    void setOffsetIndexFallback(bool fallback)
+    {
+      offset_index_fallback_ = fallback;
+    }
+
+    /// Whether data is read from a memory mapping of the file (instead of a file stream)
+    bool isMemoryMapped() const
+    {
+      return mapped_data_ != nullptr;
+    }
+
   };
 }
 }
@@ -23,6 +23,8 @@
 #include <OpenMS/FORMAT/ControlledVocabulary.h>
 #include <OpenMS/FORMAT/VALIDATORS/SemanticValidator.h>
 
+#include <functional>
+#include <future>
 #include <map>
 
 
@@ -185,6 +187,9 @@ protected:
 
       typedef MzMLHandlerHelper::BinaryData BinaryData;
 
+      struct SpectrumData;
+      struct ChromatogramData;
+
       /**@name Helper functions for storing data in memory
        * @anchor helper_read
        */
@@ -195,6 +200,10 @@ protected:
 
           Will populate all spectra on the current work stack with data (using
           multiple threads if available) and append them to the result.
+
+          With PeakFileOptions::getPipelinedDecoding(), the work stack is
+          decoded in the background instead and appended once the next stack
+          is full (or the spectrum list ends).
       */
       void populateSpectraWithData_();
 
@@ -203,9 +212,49 @@ protected:
 
           Will populate all chromatograms on the current work stack with data (using
           multiple threads if available) and append them to the result.
+
+          See populateSpectraWithData_() for the pipelined mode.
       */
       void populateChromatogramsWithData_();
 
+      /**
+          @brief Decode a batch of spectra (using multiple threads if available)
+
+          @note Only reads the options and the file name, so it may run
+          concurrently with the parser (see PeakFileOptions::getPipelinedDecoding()).
+
+          @throw Exception::ParseError if any of the binary arrays cannot be decoded
+      */
+      void decodeSpectra_(std::vector<SpectrumData>& batch);
+
+      /// Decode a batch of chromatograms (see decodeSpectra_())
+      void decodeChromatograms_(std::vector<ChromatogramData>& batch);
+
+      /// Hand decoded spectra (in order) to the consumer and/or the experiment
+      void appendSpectra_(std::vector<SpectrumData>& batch);
+
+      /// Hand decoded chromatograms (in order) to the consumer and/or the experiment
+      void appendChromatograms_(std::vector<ChromatogramData>& batch);
+
+      /**
+          @brief Keep the (decoded) binary arrays for reuse by the following spectra/chromatograms
+
+          The arrays are moved into a pool of spare BinaryData objects (whose
+          string and vector buffers keep their capacity) and @p data is cleared.
+          Reusing these buffers avoids allocating and freeing the base64 and
+          decoding buffers for every single spectrum.
+      */
+      void recycleBinaryData_(std::vector<BinaryData>& data);
+
+      /// Append a new BinaryData to bin_data_, reusing a spare one (see recycleBinaryData_()) if available
+      void addBinaryData_();
+
+      /// Wait for the spectra decoded in the background, then decode the remaining pool and append everything (rethrows decoding errors)
+      void flushSpectra_();
+
+      /// Wait for the chromatograms decoded in the background, then decode the remaining pool and append everything (rethrows decoding errors)
+      void flushChromatograms_();
+
       /**
           @brief Add extra data arrays to a spectrum
 
@@ -299,6 +348,33 @@ protected:
                               Size chrom_idx,
                               const Internal::MzMLValidator& validator);
 
+      /// Write out a single spectrum with the given native id, without recording its offset (used by writeSpectrum_)
+      void formatSpectrum_(std::ostream& os,
+                           const SpectrumType& spec,
+                           const String& native_id,
+                           Size spec_idx,
+                           const Internal::MzMLValidator& validator,
+                           const std::vector<std::vector< ConstDataProcessingPtr > >& dps);
+
+      /// Write out a single chromatogram without recording its offset (used by writeChromatogram_)
+      void formatChromatogram_(std::ostream& os,
+                               const ChromatogramType& chromatogram,
+                               Size chrom_idx,
+                               const Internal::MzMLValidator& validator);
+
+      /**
+          @brief Calls @p format for the indices [begin, end) in parallel, each writing into its own buffer
+
+          Buffer i - begin of @p buffers holds the output for index i and uses
+          the same number formatting as @p os. The first exception thrown by
+          @p format is re-thrown after all threads have finished.
+      */
+      void formatParallel_(const std::ostream& os,
+                           Size begin,
+                           Size end,
+                           std::vector<std::string>& buffers,
+                           const std::function<void(std::ostream&, Size)>& format) const;
+
       template <typename ContainerT>
       void writeContainerData_(std::ostream& os, const PeakFileOptions& pf_options_, const ContainerT& container, const String& array_type);
 
@@ -391,6 +467,8 @@ protected:
       ChromatogramType chromatogram_;
       /// The spectrum data (or chromatogram data)
       std::vector<BinaryData> bin_data_;
+      /// Spare binary data objects (cleared, but with allocated buffers) for reuse
+      std::vector<BinaryData> bin_data_spare_;
       /// The default number of peaks in the current spectrum
       Size default_array_length_;
       /// Flag that indicates that we're inside a spectrum (in contrast to a chromatogram)
@@ -456,6 +534,15 @@ protected:
       /// Vector of chromatogram data stored for later parallel processing
       std::vector<ChromatogramData> chromatogram_data_;
 
+      /// Spectra currently decoded in the background (pipelined decoding)
+      std::vector<SpectrumData> spectrum_data_in_flight_;
+      /// Chromatograms currently decoded in the background (pipelined decoding)
+      std::vector<ChromatogramData> chromatogram_data_in_flight_;
+      /// Pending background decoding of spectrum_data_in_flight_
+      std::future<void> spectrum_decoding_;
+      /// Pending background decoding of chromatogram_data_in_flight_
+      std::future<void> chromatogram_decoding_;
+
       //@}
       
       /**@name temporary data structures to hold written data
@@ -96,6 +96,24 @@ namespace OpenMS
         BinaryData& operator=(BinaryData&&) & = default;       // Move assignment operator
         ~BinaryData() = default;                               // Destructor
 
+        /// Resets all members to their default values but keeps the allocated string and vector buffers for reuse
+        void clear()
+        {
+          precision = PRE_NONE;
+          data_type = DT_NONE;
+          np_compression = MSNumpressCoder::NONE;
+          compression = false;
+          unit_multiplier = 1.0;
+          base64.clear();
+          size = 0;
+          floats_32.clear();
+          floats_64.clear();
+          ints_32.clear();
+          ints_64.clear();
+          decoded_char.clear();
+          meta = MetaInfoDescription();
+        }
+
       };
 
       /**
@@ -139,6 +139,16 @@ public:
       */
       std::vector<size_t> getSpectraIndicesbyRT(double RT, double deltaRT, const std::vector<int> & indices) const;
 
+      /**
+          @brief Get the retention times of spectra (without reading any spectrum)
+
+          @param indices Spectra to consider (if empty, all spectra are considered)
+          @return The retention time of each spectrum in @p indices (or of each spectrum, by spectrum id)
+
+          @exception Exception::IllegalArgument is thrown if an index does not exist
+      */
+      std::vector<double> getSpectraRT(const std::vector<int> & indices) const;
+
 protected:
 
       void populateChromatogramsWithData_(sqlite3 *db, std::vector<MSChromatogram>& chromatograms) const;
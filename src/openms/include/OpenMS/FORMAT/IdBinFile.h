@@ -0,0 +1,194 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CHEMISTRY/AASequence.h>
+#include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/METADATA/PeptideIdentification.h>
+#include <OpenMS/METADATA/ProteinIdentification.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class QFile;
+
+namespace OpenMS
+{
+  /**
+    @brief Compact binary file format for protein and peptide identifications (.idbin)
+
+    An alternative to idXML for large identification results, which is much
+    faster to read and write. It stores the same information as idXML (all
+    members of ProteinIdentification, PeptideIdentification and their hits,
+    including meta values) with the following exceptions:
+    the modifications of protein hits and the data arrays of protein groups
+    are not stored. In contrast to idXML, peptide identifications without
+    hits or without matching protein identification are kept and their order
+    is preserved.
+
+    All strings (identifiers, sequences, accessions, score types, meta value
+    names and string values) are interned into a single string table, i.e.
+    each distinct string is stored (and, on loading, decoded) only once. Peptide
+    sequences are parsed only once per distinct sequence.
+
+    The file is memory mapped for reading. Besides loading everything at once
+    with load(), a file can be opened with open() to access single peptide
+    identifications by index or by spectrum reference (using the index stored
+    in the file) without reading the rest of the file.
+
+    @note The file layout uses the byte order of the writing machine; reading
+    a file written on a machine with different byte order is rejected.
+
+    @note Random access after open() is not thread-safe (decoded strings and
+    sequences are cached).
+
+    @ingroup FileIO
+  */
+  class OPENMS_DLLAPI IdBinFile :
+    public ProgressLogger
+  {
+public:
+    /// Default constructor
+    IdBinFile();
+
+    /// Destructor
+    ~IdBinFile() override;
+
+    /// Copying is not supported (the object may hold a mapping of an open file)
+    IdBinFile(const IdBinFile&) = delete;
+    IdBinFile& operator=(const IdBinFile&) = delete;
+
+    /**
+      @brief Loads all identifications from a file
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file is not a valid idbin file
+    */
+    void load(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids);
+
+    /**
+      @brief Stores identifications in a file
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    void store(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids);
+
+    /// Checks whether the file starts with the idbin magic number
+    static bool isIdBinFile(const String& filename);
+
+    /// @name Random access
+    //@{
+    /**
+      @brief Opens a file for random access (any previously opened file is closed)
+
+      Only the header is read; all other data is read on demand.
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file is not a valid idbin file
+    */
+    void open(const String& filename);
+
+    /// Closes the opened file and releases all cached data
+    void close();
+
+    /// Returns whether a file is opened
+    bool isOpen() const;
+
+    /// Number of protein identifications in the opened file
+    Size getNrProteinIdentifications() const;
+
+    /// Number of peptide identifications in the opened file
+    Size getNrPeptideIdentifications() const;
+
+    /// Reads all protein identifications of the opened file
+    void getProteinIdentifications(std::vector<ProteinIdentification>& protein_ids);
+
+    /**
+      @brief Reads the peptide identification with index @p index of the opened file
+
+      @exception Exception::IndexOverflow is thrown if @p index is out of range
+    */
+    void getPeptideIdentification(Size index, PeptideIdentification& peptide_id);
+
+    /// Returns the indices of all peptide identifications with spectrum reference @p spectrum_reference (in file order)
+    std::vector<Size> findBySpectrumReference(const String& spectrum_reference);
+    //@}
+
+protected:
+    /// Bounds-checked reader over the file data
+    struct Cursor;
+
+    /// Maps (or, if that fails, reads) @p filename and parses the header
+    void openFile_(const String& filename);
+
+    /// Throws if no file is opened
+    void checkOpen_() const;
+
+    /// Returns the string with index @p id from the string table (decoded on first access)
+    const String& string_(UInt32 id);
+
+    /// Returns the sequence parsed from the string with index @p id (parsed on first access)
+    const AASequence& sequence_(UInt32 id);
+
+    /// Reads a string list
+    void readStringList_(Cursor& c, StringList& list);
+
+    /// Reads a DataValue
+    DataValue readDataValue_(Cursor& c);
+
+    /// Reads meta values into @p meta
+    void readMetaInfo_(Cursor& c, MetaInfoInterface& meta);
+
+    /// Reads a protein identification
+    void readProteinIdentification_(Cursor& c, ProteinIdentification& id);
+
+    /// Reads a peptide identification
+    void readPeptideIdentification_(Cursor& c, PeptideIdentification& id);
+
+    /// The mapped file (nullptr if the file content was read into buffer_)
+    std::unique_ptr<QFile> mapped_file_;
+
+    /// File content, if mapping was not possible
+    std::string buffer_;
+
+    /// Start of the file content (mapping or buffer_)
+    const char* data_ = nullptr;
+
+    /// Size of the file in bytes
+    Size size_ = 0;
+
+    /// Name of the opened file (for error messages)
+    String filename_;
+
+    /// @name Header fields of the opened file
+    //@{
+    UInt64 n_strings_ = 0;
+    UInt64 string_offsets_ = 0;
+    UInt64 string_data_ = 0;
+    UInt64 n_proteins_ = 0;
+    UInt64 proteins_ = 0;
+    UInt64 n_peptides_ = 0;
+    UInt64 peptide_offsets_ = 0;
+    UInt64 n_index_ = 0;
+    UInt64 index_ = 0;
+    //@}
+
+    /// Decoded strings (index is the string id)
+    std::vector<String> strings_;
+
+    /// Whether a string has been decoded
+    std::vector<bool> string_decoded_;
+
+    /// Parsed sequences by string id
+    std::unordered_map<UInt32, AASequence> sequences_;
+  };
+
+} // namespace OpenMS
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <OpenMS/CHEMISTRY/AASequenceCache.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/METADATA/ProteinIdentification.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
@@ -146,6 +147,8 @@ protected:
     ProteinHit prot_hit_;
     /// Temporary peptide hit
     PeptideHit pep_hit_;
+    /// Parsed peptide sequences (the same sequence usually occurs in many hits)
+    AASequenceCache sequence_cache_;
     /// Temporary analysis result instance
     PeptideHit::PepXMLAnalysisResult current_analysis_result_;
     /// Temporary peptide evidences
@@ -0,0 +1,71 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  class MSExperiment;
+  class FeatureMap;
+  class ConsensusMap;
+
+  /**
+    @brief Process-wide store of "files" which are kept in memory instead of being written to disk
+
+    File names starting with PREFIX (e.g. "mem://picked.mzML") denote in-memory files. FileHandler
+    stores and loads maps with such names here (after the usual file type checks by extension), and
+    TOPPBase accepts them as input and output files. This way, tools run one after the other
+    within one process (see InProcessPipeline) pass their intermediate results without serializing
+    them to XML.
+
+    Stored maps are immutable; every load returns a copy. All functions are thread-safe.
+  */
+  class OPENMS_DLLAPI InMemoryFileStore
+  {
+public:
+    /// Prefix of in-memory file names
+    static const String PREFIX;
+
+    /// Does @p filename denote an in-memory file (i.e. start with PREFIX)?
+    static bool isInMemory(const String& filename);
+
+    /// Was the in-memory file @p filename stored (and not removed since)?
+    static bool contains(const String& filename);
+
+    /**
+      @name Storing and loading
+
+      The functions return false (and do nothing) if @p filename is not an in-memory file name.
+      Storing replaces a file of the same name.
+
+      @exception Exception::FileNotFound is thrown when loading an in-memory file which was not stored
+      @exception Exception::InvalidFileType is thrown when loading a file which holds another kind of map
+    */
+    //@{
+    static bool store(const String& filename, const MSExperiment& exp);
+    static bool store(const String& filename, const FeatureMap& map);
+    static bool store(const String& filename, const ConsensusMap& map);
+    static bool load(const String& filename, MSExperiment& exp);
+    static bool load(const String& filename, FeatureMap& map);
+    static bool load(const String& filename, ConsensusMap& map);
+    //@}
+
+    /// Removes the in-memory file @p filename (if present)
+    static void remove(const String& filename);
+
+    /// Removes all in-memory files
+    static void clear();
+
+    /// Names of all in-memory files (sorted)
+    static std::vector<String> getFileNames();
+  };
+}
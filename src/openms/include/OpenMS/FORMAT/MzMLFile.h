@@ -50,6 +50,9 @@ public:
     /**
       @brief Loads a map from a MzML file. Spectra and chromatograms are sorted by default (this can be disabled using PeakFileOptions).
 
+      If PeakFileOptions::getSkimBinaryData() is set, only the meta data is
+      loaded and the binary data of the file is skipped without parsing it.
+
       @param filename The filename with the data
       @param map Is an MSExperiment
 
@@ -196,6 +199,13 @@ protected:
     /// Safe parse that catches exceptions and handles them accordingly
     void safeParse_(const String & filename, Internal::XMLHandler * handler);
 
+    /**
+      @brief Loads only the meta data of @p filename by jumping over the binary data (see PeakFileOptions::setSkimBinaryData())
+
+      @return false if the file could not be memory mapped (nothing is loaded in that case)
+    */
+    bool skim_(const String& filename, PeakMap& map);
+
 private:
 
     /// Options for loading / storing
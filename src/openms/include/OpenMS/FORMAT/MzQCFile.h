@@ -14,6 +14,7 @@
 namespace OpenMS
 {
   class FeatureMap;
+  class QCMetricAccumulator;
   
   /**
       @brief File adapter for mzQC files used to load and store mzQC files
@@ -40,6 +41,7 @@ namespace OpenMS
       @param feature_map FeatureMap from feature file (featureXML)
       @param prot_ids protein identifications from ID file (idXML)
       @param pep_ids protein identifications from ID file (idXML)
+      @param accumulator if given, the run (@p input_file) and all its scalar metrics are added to it (e.g. for a later storeSetQualities())
     */
     void store(const String& input_file,
                const String& output_file,
@@ -50,6 +52,28 @@ namespace OpenMS
                const String& label,
                const FeatureMap& feature_map,
                std::vector<ProteinIdentification>& prot_ids,
-               std::vector<PeptideIdentification>& pep_ids) const;
+               std::vector<PeptideIdentification>& pep_ids,
+               QCMetricAccumulator* accumulator = nullptr) const;
+
+    /**
+      @brief Stores the summary of many runs as set quality in mzQC file with JSON format
+
+      For every metric in @p accumulator its count, mean, standard deviation, minimum, maximum and
+      (approximate) quantiles over all runs are written. The runs are listed as input files.
+
+      @param output_file mzQC output file name
+      @param accumulator the merged QC metrics of all runs
+      @param contact_name name of the person creating the mzQC file
+      @param contact_address contact address (mail/e-mail or phone) of the person creating the mzQC file
+      @param description description and comments about the mzQC file contents
+      @param label unique and informative label for the set of runs
+      @exception Exception::UnableToCreateFile if @p output_file cannot be written
+    */
+    void storeSetQualities(const String& output_file,
+                           const QCMetricAccumulator& accumulator,
+                           const String& contact_name,
+                           const String& contact_address,
+                           const String& description,
+                           const String& label) const;
   };
 }
\ No newline at end of file
@@ -15,6 +15,9 @@
 #include <OpenMS/METADATA/ProteinIdentification.h>
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 
+#include <exception>
+#include <iterator>
+#include <ostream>
 #include <vector>
 
 namespace OpenMS
@@ -131,13 +134,66 @@ namespace OpenMS
     /// Generate an mzTab section comprising multiple rows of the same type and perform sanity check
     template <typename SectionRow> void generateMzTabSection_(const std::vector<SectionRow>& rows, const std::vector<String>& optional_columns, const MzTabMetaData& meta, StringList& output, size_t n_header_columns) const
     {
-      output.reserve(output.size() + rows.size() + 1);
-      for (const auto& row : rows)
+      std::vector<String> lines;
+      generateMzTabSectionRows_(rows, optional_columns, meta, lines, n_header_columns);
+      output.reserve(output.size() + lines.size() + 1);
+      std::move(lines.begin(), lines.end(), std::back_inserter(output));
+    }
+
+    /**
+      @brief Formats @p rows into @p lines (one line per row) and performs a sanity check on the number of columns
+
+      Formatting the rows dominates the export time of large files, so the rows
+      are formatted in parallel (the order of @p lines is the order of @p rows).
+
+      @exception Exception::Postcondition is thrown if a row has a different number of columns than the header
+    */
+    template <typename SectionRow> void generateMzTabSectionRows_(const std::vector<SectionRow>& rows, const std::vector<String>& optional_columns, const MzTabMetaData& meta, std::vector<String>& lines, size_t n_header_columns) const
+    {
+      lines.assign(rows.size(), String());
+      std::vector<size_t> n_section_columns(rows.size(), 0);
+      size_t err_count = 0;
+      std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)rows.size(); ++i)
+      {
+        if (err_count) continue; // no need to format further if already an error was encountered
+        try
+        {
+          lines[i] = generateMzTabSectionRow_(rows[i], optional_columns, meta, n_section_columns[i]);
+        }
+        catch (...)
+        {
+#ifdef _OPENMP
+#pragma omp critical(MzTabFileErrorHandling)
+#endif
+          {
+            if (!err_count++) error = std::current_exception();
+          }
+        }
+      }
+      if (err_count != 0)
+      {
+        std::rethrow_exception(error);
+      }
+      for (size_t n : n_section_columns)
+      {
+        if (n_header_columns != n)  throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Header and content differs in columns. Please report this bug to the OpenMS developers.");
+      }
+    }
+
+    /// Writes a batch of streamed rows (see generateMzTabSectionRows_()) to @p os and clears @p batch
+    template <typename SectionRow> void writeMzTabSectionBatch_(std::ostream& os, std::vector<SectionRow>& batch, const std::vector<String>& optional_columns, const MzTabMetaData& meta, size_t n_header_columns) const
+    {
+      std::vector<String> lines;
+      generateMzTabSectionRows_(batch, optional_columns, meta, lines, n_header_columns);
+      for (const String& line : lines)
       {
-        size_t n_section_columns = 0;
-        output.push_back(generateMzTabSectionRow_(row, optional_columns, meta, n_section_columns));
-        if (n_header_columns != n_section_columns)  throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Header and content differs in columns. Please report this bug to the OpenMS developers.");
+        os << line << "\n";
       }
+      batch.clear();
     }
 
     // auxiliary functions
@@ -17,6 +17,7 @@
 namespace OpenMS
 {
   class String;
+  class OffsetIndexFile;
 
   /**
       @brief File adapter for MzXML 3.1 files
@@ -99,6 +100,26 @@ public:
     */
     void transform(const String& filename_in, Interfaces::IMSDataConsumer * consumer, MapType& map, bool skip_full_count = false);
 
+    /**
+      @brief Loads a single spectrum using an offset index of the file
+
+      Only the XML of the requested scan is read and parsed, which allows
+      random access to (non-indexed) mzXML files. Nested scans are not part of
+      their parent scan. If the spectrum is filtered out by the options (e.g.
+      RT or MS level range), @p spectrum is empty.
+
+      @param filename The mzXML file
+      @param index Offset index of @p filename (see OffsetIndexFile::loadOrScan())
+      @param index_pos Position of the spectrum in the index
+      @param spectrum The loaded spectrum
+
+      @exception Exception::IllegalArgument is thrown if @p index is not an index of an mzXML file
+      @exception Exception::IndexOverflow is thrown if @p index_pos is out of range
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if an error occurs during parsing
+    */
+    void loadSpectrum(const String& filename, const OffsetIndexFile& index, Size index_pos, MSSpectrum& spectrum);
+
 protected:
 
     /// Perform first pass through the file and retrieve the meta-data to initialize the consumer
@@ -100,6 +100,17 @@ namespace OpenMS
       */
       void createTable_(const String& name, const String& definition, bool may_exist = false);
 
+      /**
+        @brief Schedule creation of an index on a column of a table
+
+        Indexes are only created by createDeferredIndexes_(), after all data has been inserted.
+        Building an index once is much faster than updating it for every inserted row.
+      */
+      void createIndex_(const String& table, const String& column);
+
+      /// Create all indexes scheduled by createIndex_()
+      void createDeferredIndexes_();
+
       /// Create a database table for the data types used in DataValue
       void createTableDataValue_DataType_();
 
@@ -276,6 +287,9 @@ namespace OpenMS
       /// Prepared queries for inserting data into different tables
       std::map<std::string, std::unique_ptr<SQLite::Statement>> prepared_queries_;
 
+      /// SQL statements for indexes that will be created after inserting the data
+      std::vector<String> deferred_indexes_;
+
       // mapping between loaded data and database keys:
       // @NOTE: in principle we could use `unordered_map` here for efficiency,
       // but that gives compiler errors when pointers or iterators (`...Ref`)
@@ -134,6 +134,19 @@ public:
     ///returns whether to skip some XML checks and be fast instead
     bool getSkipXMLChecks() const;
 
+    /**
+        @brief [mzML only!] Whether to skip the binary data by byte offset instead of parsing it (default: false)
+
+        If enabled, only the meta data of spectra and chromatograms is parsed:
+        using the index of the file (or a pre-scan, see OffsetIndexFile, for
+        files without index), the \<binaryDataArrayList\> element of each
+        spectrum and chromatogram is jumped over without being read by the XML
+        parser. No peak data is loaded (as with setFillData(false)).
+    */
+    bool getSkimBinaryData() const;
+    /// [mzML only!] Set whether to skip the binary data by byte offset instead of parsing it
+    void setSkimBinaryData(bool skim);
+
     /// @name sort peaks in spectra / chromatograms by position
     ///sets whether or not to sort peaks in spectra
     void setSortSpectraByMZ(bool sort);
@@ -195,6 +208,30 @@ public:
     Size getMaxDataPoolSize() const;
     /// Set maximal size of the data pool
     void setMaxDataPoolSize(Size size);
+
+    /**
+        @brief Whether a full data pool is decoded in the background (default: true)
+
+        If enabled, a full pool is handed to a decoder task while the parser
+        continues to tokenize the next pool, i.e. XML parsing and
+        Base64/zlib/numpress decoding overlap. At most one pool is in flight
+        at any time and spectra/chromatograms are still delivered in file order.
+    */
+    bool getPipelinedDecoding() const;
+    /// Set whether a full data pool is decoded in the background
+    void setPipelinedDecoding(bool pipelined);
+
+    /**
+        @brief Whether spectra and chromatograms are formatted in parallel when writing (default: true)
+
+        If enabled, writers format a data pool of spectra/chromatograms
+        (including the Base64/zlib/numpress encoding of their data) in parallel
+        into separate buffers and then write the buffers in order. The output
+        is identical to sequential writing.
+    */
+    bool getParallelWriting() const;
+    /// Set whether spectra and chromatograms are formatted in parallel when writing
+    void setParallelWriting(bool parallel);
     //@}
 
     /// [mzML only!] Whether to use the "selected ion m/z" value as the precursor m/z value (alternative: use the "isolation window target m/z" value)
@@ -226,11 +263,14 @@ private:
     bool sort_spectra_by_mz_;
     bool sort_chromatograms_by_rt_;
     bool fill_data_;
+    bool skim_binary_data_;
     bool write_index_;
     MSNumpressCoder::NumpressConfig np_config_mz_;
     MSNumpressCoder::NumpressConfig np_config_int_;
     MSNumpressCoder::NumpressConfig np_config_fda_;
     Size maximal_data_pool_size_;
+    bool pipelined_decoding_;
+    bool parallel_writing_;
     bool precursor_mz_selected_ion_;
   };
 
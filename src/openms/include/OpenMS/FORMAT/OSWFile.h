@@ -9,13 +9,18 @@
 #pragma once
 
 #include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/DATASTRUCTURES/ListUtils.h>
 #include <OpenMS/DATASTRUCTURES/OSWData.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
 #include <OpenMS/FORMAT/SqliteConnector.h>
 #include <OpenMS/KERNEL/StandardTypes.h>
 
 #include <array>
+#include <atomic>
+#include <future>
 #include <map>
+#include <mutex>
+#include <vector>
 
 namespace OpenMS
 {
@@ -47,8 +52,11 @@ namespace OpenMS
     /// opens an OSW file for reading.
     /// @throws Exception::FileNotReadable if @p filename does not exist
     OSWFile(const String& filename);
-    OSWFile(const OSWFile& rhs) = default;
-    OSWFile& operator=(const OSWFile& rhs) = default;
+    /// not copyable, since the SQL connection cannot be shared
+    OSWFile(const OSWFile& rhs) = delete;
+    OSWFile& operator=(const OSWFile& rhs) = delete;
+    /// waits for a running prefetchProteins()
+    ~OSWFile();
 
     /// read data from an SQLLite OSW file into @p swath_result
     /// Depending on the number of proteins, this could take a while. 
@@ -65,6 +73,9 @@ namespace OpenMS
       @brief populates a protein at index @p index  within @p swath_results with Peptides, unless the protein already has peptides
 
       Internally uses the proteins ID to search for cross referencing peptides and transitions in the OSW file.
+      The first call creates indexed lookup tables (in the temporary database of the connection, the file is not modified)
+      for columns of the OSW file which are not indexed, so that subsequent calls do not have to scan whole tables.
+      Proteins read ahead by prefetchProteins() are taken from there.
 
       @param swath_result OSWData obtained from the readMinimal() method
       @param index Index into swath_result.getProteins()[index]. Make sure the index is within the vector's size.
@@ -72,6 +83,19 @@ namespace OpenMS
     */
     void readProtein(OSWData& swath_result, const Size index);
 
+    /**
+      @brief Reads the proteins at @p indices of @p swath_result in a background thread, for a later readProtein()
+
+      Use it for proteins which are likely requested next, e.g. the neighbours of a protein shown in a GUI.
+      Indices which are out of range or point to proteins which already have peptides are ignored.
+      A prefetch which is still running is stopped after its current protein. Errors are not reported
+      here, but by the readProtein() call which then reads the protein itself.
+
+      @param swath_result OSWData obtained from the readMinimal() method (only the protein IDs are used, it is not modified)
+      @param indices Indices into swath_result.getProteins()
+    */
+    void prefetchProteins(const OSWData& swath_result, const std::vector<Size>& indices);
+
     /// for Percolator data read/write operations
     enum class OSWLevel
     {
@@ -106,6 +130,19 @@ namespace OpenMS
     */
     static void writeFromPercolator(const std::string& osw_filename, const OSWFile::OSWLevel osw_level, const std::map< std::string, PercolatorFeature >& features);
 
+    /**
+      @brief Merges the features of several OSW files (e.g. the shards of one OpenSwathWorkflow run) into @p out
+
+      @p out becomes a copy of the first input (including its library), to which the runs and the FEATURE* tables of all other
+      inputs are added. Runs with the same ID (as for shards of one run) are stored once.
+      The inputs should be created from the same library and feature IDs must be unique across all inputs.
+
+      @throws Exception::FileNotFound if an input does not exist
+      @throws Exception::UnableToCreateFile if @p out cannot be written
+      @throws Exception::IllegalArgument if @p out is one of the inputs or the features cannot be merged (e.g. duplicate feature IDs)
+    */
+    static void merge(const StringList& in, const String& out);
+
     /// extract the RUN::ID from the sqMass file
     /// @throws Exception::SqlOperationFailed more than on run exists
     UInt64 getRunID() const;
@@ -126,6 +163,22 @@ namespace OpenMS
     */
     void getFullProteins_(OSWData& swath_result, Size prot_index = ALL_PROTEINS);
 
+    /**
+      @brief reads the protein with ID @p prot_id into @p prot, using the lookup tables of prepareProteinLookup_()
+
+      @return false (and leaves @p prot unchanged) if the protein does not have any peptides in the OSW file
+    */
+    bool readProteinByID_(Size prot_id, OSWProtein& prot);
+
+    /// creates indexed lookup tables for the per-protein query (once) for all tables whose join column is not indexed in the file
+    void prepareProteinLookup_();
+
+    /// the query for the protein-PeptidePrecursor-Feature hierarchy of the proteins in @p protein_table (joining the lookup tables if @p use_lookup)
+    String proteinQuery_(const String& protein_table, bool use_lookup) const;
+
+    /// stops a running prefetchProteins() after its current protein and waits for it
+    void stopPrefetch_();
+
     /// set source file and sqMass run-ID
     void readMeta_(OSWData& data);
 
@@ -133,6 +186,11 @@ namespace OpenMS
     String filename_;       ///< sql file to open/write to
     SqliteConnector conn_;  ///< SQL connection. Stays open as long as this object lives
     bool has_SCOREMS2_;     ///< database contains pyProphet's score_MS2 table with qvalues
+    std::map<String, String> lookup_tables_; ///< table to join in per-protein queries (an indexed lookup table or the table itself), by table name
+    std::map<Size, OSWProtein> prefetched_;  ///< proteins read by prefetchProteins(), by protein ID
+    std::mutex mutex_;                       ///< guards conn_, lookup_tables_ and prefetched_ (which are used by the prefetching thread)
+    std::future<void> prefetch_;             ///< the running prefetch (if valid)
+    std::atomic<bool> stop_prefetch_{false}; ///< tells the prefetching thread to stop
   };
 
 } // namespace OpenMS
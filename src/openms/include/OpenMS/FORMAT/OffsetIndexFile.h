@@ -0,0 +1,144 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/FORMAT/FileTypes.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Byte offset index of the spectra and chromatograms of an mzML or mzXML file
+
+    indexedmzML files contain an index of all spectra and chromatograms, which
+    allows random access (see IndexedMzMLHandler and OnDiscMSExperiment).
+    Many files do not have such an index (plain mzML, most mzXML converted by
+    vendor tools). This class builds an equivalent index by a fast pre-scan of
+    the file, which only looks at the XML tags (no XML parser is used; binary
+    data is skipped) and records for each spectrum its native ID, position and
+    some meta data (RT, MS level, precursor m/z).
+
+    With loadOrScan(), the index is cached in a sidecar file next to the data
+    file (see getSidecarName()) and only rebuilt if the data file changed
+    (size or modification time differ).
+
+    The index is used by IndexedMzMLHandler (and thus OnDiscMSExperiment) for
+    mzML files without \<indexList\>, by MzXMLFile::loadSpectrum() for random
+    access to single mzXML scans and can be used with
+    SpectrumLookup::readSpectra() to look up spectra without loading them.
+
+    @ingroup FileIO
+  */
+  class OPENMS_DLLAPI OffsetIndexFile
+  {
+public:
+    /// Index entry of a spectrum or chromatogram
+    struct Entry
+    {
+      /// native ID (mzXML: "scan=" followed by the scan number, as MzXMLHandler uses it)
+      String native_id;
+      /// byte offset of the element start tag in the data file
+      Int64 offset = -1;
+      /// length of the element in bytes (for mzXML: up to the first nested scan)
+      Int64 length = 0;
+      /// whether the closing tag of the element is not part of [offset, offset + length) (mzXML with nested scans)
+      bool unclosed = false;
+      /// retention time in seconds (-1 if unknown; not set for chromatograms)
+      double rt = -1.0;
+      /// MS level (0 if unknown; not set for chromatograms)
+      Int ms_level = 0;
+      /// m/z of the first precursor (0 if there is none; not set for chromatograms)
+      double precursor_mz = 0.0;
+
+      bool operator==(const Entry& rhs) const;
+    };
+
+    /// Default constructor
+    OffsetIndexFile() = default;
+
+    /**
+      @brief Builds the index by scanning @p data_file (mzML or mzXML, detected from the content)
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file is neither mzML nor mzXML
+    */
+    void scan(const String& data_file);
+
+    /**
+      @brief Stores the index in @p index_file
+
+      The size and modification time of @p data_file are stored as well, so load() can detect outdated indices.
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    void store(const String& index_file, const String& data_file) const;
+
+    /**
+      @brief Loads the index from @p index_file
+
+      @return false (and the index is empty) if @p index_file does not exist, is not a valid index or is outdated with respect to @p data_file
+    */
+    bool load(const String& index_file, const String& data_file);
+
+    /**
+      @brief Loads the index from the sidecar file of @p data_file or, if that fails, scans @p data_file
+
+      After scanning, the index is written to the sidecar file if @p write_sidecar is true
+      (failures to write it, e.g. in read-only directories, are ignored).
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file is neither mzML nor mzXML
+    */
+    void loadOrScan(const String& data_file, bool write_sidecar = true);
+
+    /// Name of the sidecar index file of @p data_file
+    static String getSidecarName(const String& data_file);
+
+    /**
+      @brief Reads the XML of @p entry from @p data_file
+
+      For entries which are @p unclosed, the closing tag is appended, so the result is always a complete XML element.
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the entry lies outside of the file
+    */
+    static std::string readElement(const String& data_file, const Entry& entry);
+
+    /// Removes all entries
+    void clear();
+
+    /// Type of the indexed file (FileTypes::MZML, FileTypes::MZXML or FileTypes::UNKNOWN if nothing was indexed)
+    FileTypes::Type getFileType() const;
+
+    /// Spectrum entries (in file order)
+    const std::vector<Entry>& getSpectra() const;
+
+    /// Chromatogram entries (in file order, mzML only)
+    const std::vector<Entry>& getChromatograms() const;
+
+    /// Byte offset of the end of the run (mzML: \</run\>, mzXML: \</msRun\>), i.e. the end of the last spectrum or chromatogram list
+    Int64 getRunEnd() const;
+
+protected:
+    /// Scans an mzML document
+    void scanMzML_(const char* data, Size size);
+
+    /// Scans an mzXML document
+    void scanMzXML_(const char* data, Size size);
+
+    FileTypes::Type type_ = FileTypes::UNKNOWN;
+    std::vector<Entry> spectra_;
+    std::vector<Entry> chromatograms_;
+    Int64 run_end_ = -1;
+  };
+
+} // namespace OpenMS
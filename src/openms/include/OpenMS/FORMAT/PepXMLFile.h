@@ -20,6 +20,8 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <tuple>
+#include <unordered_set>
 
 
 namespace OpenMS
@@ -248,6 +250,9 @@ private:
     /// References to currently active ProteinIdentifications
     std::vector<std::vector<ProteinIdentification>::iterator> current_proteins_;
 
+    /// Accessions of the protein hits added so far, per ProteinIdentification (index in "proteins_")
+    std::map<Size, std::unordered_set<String> > protein_accessions_;
+
     /// Search parameters of the current identification run
     ProteinIdentification::SearchParameters params_;
 
@@ -291,6 +296,10 @@ private:
     /// The modifications of the current peptide hit (position is 1-based)
     std::vector<std::pair<const ResidueModification*, Size> > current_modifications_;
 
+    /// Modifications found in the database for (residue, mass, position: 0 = N-term., 1 = C-term., 2 = other) of a
+    /// "mod_aminoacid_mass" that is not in the header; with a flag whether the match was ambiguous
+    std::map<std::tuple<char, double, int>, std::pair<const ResidueModification*, bool> > mod_db_cache_;
+
     /// Fixed aminoacid modifications as parsed from the header
     std::vector<AminoAcidModification> fixed_modifications_;
 
@@ -316,6 +325,9 @@ private:
                               Size modification_position,
                               std::vector<AminoAcidModification> const& header_mods);
 
+    /// adds @p hit to the currently active ProteinIdentification (see "search_id_"), unless a hit with the same accession is already there
+    void insertProteinHit_(const ProteinHit& hit);
+
     //static std::vector<int> getIsotopeErrorsFromIntSetting_(int intSetting);
   };
 } // namespace OpenMS
@@ -0,0 +1,97 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/config.h>
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Reads a byte stream ahead on a separate thread
+
+    Decompressing gzip or bzip2 input on the thread that parses it makes decompression the serial limit of
+    parsing. This class calls a producer function (e.g. Bzip2Ifstream::read) on a reader thread and keeps
+    up to @p max_blocks blocks of @p block_size bytes in a queue, from which read() copies. The reader thread
+    waits while the queue is full, so memory usage is bounded.
+
+    The producer is only called from the reader thread. Exceptions thrown by the producer are rethrown by
+    read() once all bytes produced before the error have been read.
+  */
+  class OPENMS_DLLAPI ReadAheadBuffer
+  {
+public:
+    /**
+      @brief Producer of the data
+
+      Reads up to @p n bytes into @p s and returns the number of bytes read. @p end is set to true if the end
+      of the input was reached (no further calls).
+    */
+    typedef std::function<size_t(char* s, size_t n, bool& end)> Producer;
+
+    /// Constructor; starts reading
+    explicit ReadAheadBuffer(Producer producer, Size block_size = 1 << 20, Size max_blocks = 4);
+
+    /// Destructor; stops the reader thread (without reading to the end)
+    ~ReadAheadBuffer();
+
+    ReadAheadBuffer(const ReadAheadBuffer&) = delete;
+    ReadAheadBuffer& operator=(const ReadAheadBuffer&) = delete;
+
+    /**
+      @brief Copies up to @p n bytes into @p s
+
+      Waits for the reader thread if no data is available.
+
+      @return The number of bytes copied; less than @p n only at the end of the input
+    */
+    size_t read(char* s, size_t n);
+
+    /// true if read() has returned all the data
+    bool atEnd() const
+    {
+      return at_end_;
+    }
+
+protected:
+    /// Reader thread
+    void run_();
+
+    /// Makes the next block the current one; returns false at the end of the input (waits if the queue is empty)
+    bool nextBlock_();
+
+    Producer producer_;
+    Size block_size_;
+    Size max_blocks_;
+
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::deque<std::vector<char> > blocks_;
+    bool done_ = false;
+    bool stop_ = false;
+    std::exception_ptr error_;
+
+    /// Block that is being read (only accessed by the consumer)
+    std::vector<char> current_;
+    Size current_pos_ = 0;
+    bool at_end_ = false;
+
+    std::thread thread_;
+  };
+
+} // namespace OpenMS
@@ -9,10 +9,14 @@
 #pragma once
 
 #include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
 
+#include <algorithm>
+#include <charconv>
 #include <ostream>
 #include <fstream>      // std::ofstream
 #include <sstream>
+#include <vector>
 #include <boost/math/special_functions/fpclassify.hpp> // because isfinite not supported on Mac
 
 namespace OpenMS
@@ -25,6 +29,12 @@ namespace OpenMS
 
       Automatically inserts separators between items and handles quoting of strings. Requires @p nl (preferred) or @p std::endl as the line delimiter - @p "\n" won't be accepted.
 
+      Integers are formatted with @p std::to_chars. Floating point numbers are formatted like @p String (see
+      StringConversions) by default; the considerably faster formats of @p std::to_chars (shortest representation
+      or a fixed number of decimals) can be selected with setNumberFormat().
+
+      Large tables can be written with writeRows(), which formats blocks of rows in parallel.
+
       @ingroup Format
   */
   class OPENMS_DLLAPI SVOutStream :
@@ -32,6 +42,14 @@ namespace OpenMS
   {
 public:
 
+    /// Format of floating point numbers
+    enum NumberFormat
+    {
+      NUMBER_STRING,   ///< as @p String (StringConversions), i.e. fixed or scientific notation depending on the magnitude (default)
+      NUMBER_SHORTEST, ///< shortest representation that reads back to the same value (@p std::to_chars)
+      NUMBER_FIXED     ///< fixed notation with a given number of decimals (@p std::to_chars)
+    };
+
     /**
       @brief Constructor
 
@@ -107,14 +125,12 @@ public:
     */
     SVOutStream& operator<<(enum Newline);
 
-    /// numeric types should be converted to String first to make use
-    /// of StringConversion
+    /// numeric types are formatted according to the number format (see setNumberFormat())
     template<typename T>
     typename std::enable_if<std::is_arithmetic<typename std::remove_reference<T>::type>::value, SVOutStream&>::type operator<<(const T& value)
     {
-      if (!newline_) static_cast<std::ostream&>(*this) << sep_;
-      else newline_ = false;
-      static_cast<std::ostream&>(*this) << String(value);
+      writeSeparator_();
+      writeNumber_(value);
       return *this;
     };
 
@@ -122,10 +138,7 @@ public:
     template<typename T>
     typename std::enable_if<!std::is_arithmetic<typename std::remove_reference<T>::type>::value, SVOutStream&>::type operator<<(const T& value)
     {
-      if (!newline_)
-        static_cast<std::ostream &>(*this) << sep_;
-      else
-        newline_ = false;
+      writeSeparator_();
       static_cast<std::ostream &>(*this) << value;
       return *this;
     };
@@ -141,6 +154,67 @@ public:
     */
     bool modifyStrings(bool modify);
 
+    /**
+      @brief Sets the format of floating point numbers
+
+      @param format The number format
+      @param precision Number of decimals (only used for @p NUMBER_FIXED)
+
+      @exception Exception::IllegalArgument is thrown if @p precision is negative
+    */
+    void setNumberFormat(NumberFormat format, int precision = 6);
+
+    /// Returns the format of floating point numbers
+    NumberFormat getNumberFormat() const;
+
+    /**
+      @brief Writes @p n_rows rows, formatting blocks of rows in parallel
+
+      @p write_row is called as <tt>write_row(Size row, SVOutStream& out)</tt> for every row and must write the
+      complete row including the terminating @p nl to @p out (a stream with the same settings as this one, which
+      buffers the block in memory). It is called concurrently for different blocks, so it must not modify shared
+      state. The blocks are written in order, i.e. the output is the same as the one of a serial loop over the rows.
+
+      @param n_rows Number of rows
+      @param write_row Function writing one row
+      @param block_size Number of rows formatted by one task
+
+      @exception Exception::IllegalArgument is thrown if the stream is not at the beginning of a line
+    */
+    template <typename RowFunction>
+    SVOutStream& writeRows(Size n_rows, const RowFunction& write_row, Size block_size = 256)
+    {
+      checkLineStart_();
+      block_size = std::max(block_size, Size(1));
+      const Size n_blocks = (n_rows + block_size - 1) / block_size;
+      // bound the memory of the buffered output: format a few blocks per thread at a time
+      const Size batch_size = Size(std::max(1, TaskScheduler::getNumThreads())) * 4;
+      std::vector<std::string> buffers;
+      for (Size first = 0; first < n_blocks; first += batch_size)
+      {
+        const Size last = std::min(first + batch_size, n_blocks);
+        buffers.assign(last - first, std::string());
+        TaskScheduler::parallelFor(first, last, [&](SignedSize block)
+        {
+          std::ostringstream buffer;
+          SVOutStream block_out(buffer, *this);
+          const Size b = block;
+          const Size end = std::min((b + 1) * block_size, n_rows);
+          for (Size row = b * block_size; row < end; ++row)
+          {
+            write_row(row, block_out);
+          }
+          block_out.checkLineStart_();
+          buffers[b - first] = buffer.str();
+        });
+        for (const std::string& buffer : buffers)
+        {
+          std::ostream::write(buffer.data(), buffer.size());
+        }
+      }
+      return *this;
+    }
+
 
     /// Write a numeric value or "nan"/"inf"/"-inf", if applicable (would not be needed for Linux)
     template <typename NumericT>
@@ -166,6 +240,58 @@ public:
     }
 
 protected:
+    /// Constructor for a stream writing to @p out with the settings (separator, quoting, number format etc.) of @p settings
+    SVOutStream(std::ostream& out, const SVOutStream& settings);
+
+    /// Writes the separator unless at the beginning of a line
+    void writeSeparator_()
+    {
+      if (!newline_)
+      {
+        std::ostream::write(sep_.c_str(), sep_.size());
+      }
+      else
+      {
+        newline_ = false;
+      }
+    }
+
+    /// Writes an integer or floating point number
+    template <typename T>
+    void writeNumber_(T value)
+    {
+      if constexpr (std::is_integral<T>::value && !std::is_same<T, bool>::value && sizeof(T) > 1)
+      {
+        char buffer[24];
+        std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        std::ostream::write(buffer, result.ptr - buffer);
+      }
+      else if constexpr (std::is_floating_point<T>::value)
+      {
+        if (number_format_ != NUMBER_STRING && !std::is_same<T, long double>::value)
+        {
+          char buffer[64];
+          std::to_chars_result result = (number_format_ == NUMBER_FIXED) ?
+            std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, precision_) :
+            std::to_chars(buffer, buffer + sizeof(buffer), value);
+          if (result.ec == std::errc())
+          {
+            std::ostream::write(buffer, result.ptr - buffer);
+            return;
+          }
+          // very large numbers in fixed notation do not fit into the buffer
+        }
+        static_cast<std::ostream&>(*this) << String(value);
+      }
+      else
+      {
+        static_cast<std::ostream&>(*this) << String(value);
+      }
+    }
+
+    /// Throws Exception::IllegalArgument if the stream is not at the beginning of a line
+    void checkLineStart_() const;
+
     /// internal file stream when C'tor is called with a filename
     std::ofstream* ofs_;
 
@@ -190,6 +316,12 @@ protected:
     /// Are we at the beginning of a line? (Otherwise, insert separator before next item.)
     bool newline_;
 
+    /// Format of floating point numbers
+    NumberFormat number_format_;
+
+    /// Number of decimals for @p NUMBER_FIXED
+    int precision_;
+
     /// Stream for testing if a manipulator is "std::endl"
     std::stringstream ss_;
   };
@@ -0,0 +1,133 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/KERNEL/MSSpectrum.h>
+
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief A list of spectra which moves cold blocks of peak data to disk when the MemoryBudget is exceeded
+
+    Spectra are appended with push_back() and grouped into blocks of @p block_size
+    spectra. Each time a block is completed while MemoryBudget::isExceeded(), the
+    least recently accessed block held in memory is spilled: the peaks and float
+    data arrays of its spectra are written to a cache file (in the record format of
+    cached mzML, see Internal::CachedMzMLHandler) and released. All other data of a
+    spectrum (meta data, precursors, string and integer data arrays) always stays
+    in memory.
+
+    getSpectrum() returns a copy of a spectrum, reading the peaks of spilled
+    spectra back from the cache file. It may be called concurrently.
+
+    Spilling one block per completed block (instead of spilling until the usage is
+    below the limit) keeps the resident memory bounded even though the allocator
+    does not necessarily return released memory to the system.
+
+    @ingroup FileIO
+  */
+  class OPENMS_DLLAPI SpillableSpectrumList
+  {
+public:
+    /**
+      @brief Constructor
+
+      @param cache_file The cache file (a temporary file if empty); it is removed by the destructor
+      @param block_size Number of spectra per block (the unit of spilling)
+
+      @throw Exception::IllegalArgument if @p block_size is zero
+    */
+    explicit SpillableSpectrumList(const String& cache_file = "", Size block_size = 1000);
+
+    /// Destructor; removes the cache file
+    ~SpillableSpectrumList();
+
+    SpillableSpectrumList(const SpillableSpectrumList&) = delete;
+    SpillableSpectrumList& operator=(const SpillableSpectrumList&) = delete;
+
+    /**
+      @brief Appends a spectrum (spills a block if the memory budget is exceeded)
+
+      @throw Exception::UnableToCreateFile if the cache file cannot be written
+    */
+    void push_back(MSSpectrum spectrum);
+
+    /**
+      @brief Returns a copy of spectrum @p index
+
+      @throw Exception::IndexOverflow if @p index is out of range
+      @throw Exception::ParseError if the spilled peaks cannot be read back
+    */
+    MSSpectrum getSpectrum(Size index) const;
+
+    /// Number of spectra
+    Size size() const
+    {
+      return spectra_.size();
+    }
+
+    /// Whether the list is empty
+    bool empty() const
+    {
+      return spectra_.empty();
+    }
+
+    /// Number of spectra whose peaks are on disk
+    Size getSpilledCount() const;
+
+    /**
+      @brief Spills all completed blocks held in memory, regardless of the memory budget
+
+      @throw Exception::UnableToCreateFile if the cache file cannot be written
+    */
+    void spill();
+
+    /// The cache file
+    const String& getCacheFile() const
+    {
+      return cache_file_;
+    }
+
+protected:
+    /// State of a block of spectra
+    struct Block
+    {
+      bool spilled = false;
+      /// access counter value of the last access (for least recently used spilling)
+      mutable UInt64 last_access = 0;
+    };
+
+    /// Writes the peaks of block @p block to the cache file and releases them
+    void spillBlock_(Size block);
+
+    /// Spills the least recently accessed completed block held in memory (if any)
+    void spillColdest_();
+
+    String cache_file_;
+    Size block_size_;
+
+    /// The spectra (without peaks if spilled)
+    std::vector<MSSpectrum> spectra_;
+    /// Offsets of the spilled peak records in the cache file (one per spectrum, valid if its block is spilled)
+    std::vector<std::streampos> offsets_;
+    std::vector<Block> blocks_;
+
+    /// Counter incremented on each access of a block
+    mutable UInt64 access_counter_ = 0;
+
+    std::ofstream ofs_;
+    mutable std::ifstream ifs_;
+    /// Guards ifs_ and the access counters
+    mutable std::mutex mutex_;
+  };
+}
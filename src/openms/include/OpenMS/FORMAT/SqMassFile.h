@@ -71,6 +71,18 @@ public:
 
     void transform(const String& filename_in, Interfaces::IMSDataConsumer* consumer, bool skip_full_count = false, bool skip_first_pass = false) const;
 
+    /**
+      @brief Merges the spectra and chromatograms of several sqMass files (e.g. the shards of one OpenSwathWorkflow run) into @p out
+
+      @p out becomes a copy of the first input, to which the spectra and chromatograms of all other inputs are appended
+      (with their IDs shifted, so they stay consecutive). Runs with the same ID (as for shards of one run) are stored once.
+
+      @throws Exception::FileNotFound if an input does not exist
+      @throws Exception::UnableToCreateFile if @p out cannot be written
+      @throws Exception::IllegalArgument if @p out is one of the inputs or the data cannot be merged
+    */
+    static void merge(const StringList& in, const String& out);
+
     void setConfig(const SqMassConfig& config) 
     {
       config_ = config;
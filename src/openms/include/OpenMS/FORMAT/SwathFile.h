@@ -14,6 +14,7 @@
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 #include <OpenMS/KERNEL/StandardTypes.h>
 
+#include <functional>
 #include <vector>
 #include <boost/shared_ptr.hpp>
 
@@ -71,6 +72,31 @@ public:
                                               const String& readoptions = "normal",
                                               Interfaces::IMSDataConsumer* plugin_consumer = nullptr);
 
+    /**
+      @brief Loads a Swath run from a single mzML file with bounded memory, handing out complete windows while reading
+
+      Uses a StreamingSwathFileConsumer: each SWATH window is passed to @p
+      window_ready as soon as all of its spectra are read, which allows
+      processing of window-sorted input (e.g. concatenated per-window files)
+      to start before the whole file is read. If the spectral data in memory
+      exceeds @p memory_budget, cold windows are spilled to @p tmp (see
+      StreamingSwathFileConsumer).
+
+      @param[in] file Input filename
+      @param[in] tmp Temporary directory (for spilled windows)
+      @param[out] exp_meta Experimental metadata from mzML file
+      @param[in] memory_budget Maximal size of the spectral data kept in memory (in bytes, 0 for no bound)
+      @param[in] window_ready Called with each SWATH window once it is complete (may be empty)
+      @param[in] plugin_consumer An intermediate custom consumer
+      @return Swath maps for MS2 and MS1
+    */
+    std::vector<OpenSwath::SwathMap> loadMzMLStreaming(const String& file,
+                                                       const String& tmp,
+                                                       boost::shared_ptr<ExperimentalSettings>& exp_meta,
+                                                       Size memory_budget,
+                                                       const std::function<void(const OpenSwath::SwathMap&)>& window_ready,
+                                                       Interfaces::IMSDataConsumer* plugin_consumer = nullptr);
+
     /// Loads a Swath run from a single mzXML file
     std::vector<OpenSwath::SwathMap> loadMzXML(const String& file, 
                                                const String& tmp,
@@ -82,6 +108,15 @@ public:
 
 protected:
 
+    /// Loads a single mzML file using the consumer selected by @p readoptions ("stream" uses @p memory_budget and @p window_ready)
+    std::vector<OpenSwath::SwathMap> loadMzML_(const String& file,
+                                               const String& tmp,
+                                               boost::shared_ptr<ExperimentalSettings>& exp_meta,
+                                               const String& readoptions,
+                                               Interfaces::IMSDataConsumer* plugin_consumer,
+                                               Size memory_budget,
+                                               const std::function<void(const OpenSwath::SwathMap&)>& window_ready);
+
     /// Cache a file to disk
     OpenSwath::SpectrumAccessPtr doCacheFile_(const String& in, const String& tmp, const String& tmp_fname,
                                               const boost::shared_ptr<PeakMap >& experiment_metadata);
@@ -26,6 +26,14 @@ namespace OpenMS
     *
     * @note The 'strings' here are not really null-terminated but rather
     * containers of data. If you want safe conversions, use QtByteArray.
+    *
+    * The zlib stream state is allocated once per thread and reused for all
+    * subsequent calls, so compressing or decompressing many small arrays (as
+    * in mzML) does not pay for stream setup each time. All functions are
+    * thread-safe. Building with WITH_LIBDEFLATE uses libdeflate for
+    * decompression, which is considerably faster than zlib; compression always
+    * uses zlib so the output does not depend on the build. zlib-ng in zlib
+    * compatibility mode can be used as a drop-in replacement for zlib.
     * 
   */
   class OPENMS_DLLAPI ZlibCompression
@@ -62,24 +70,38 @@ public:
     static void compressString(const QByteArray& raw_data, QByteArray& compressed_data);
 
     /**
-      * @brief Uncompresses data using Qt (wrapper around Qt function)
+      * @brief Uncompresses data of unknown uncompressed size
       *
       * @param compressed_data Compressed data
       * @param nr_bytes Number of bytes in compressed data
       * @param raw_data Uncompressed result data
-      * 
+      *
+      * @throws Exception::ConversionError if the data cannot be decompressed or the result is empty
     */
     static void uncompressString(const void * compressed_data, size_t nr_bytes, std::string& raw_data);
 
     /**
-      * @brief Uncompresses data using Qt
+      * @brief Uncompresses data of unknown uncompressed size
       *
       * @param compressed_data Compressed data
       * @param raw_data Uncompressed result data
-      * 
+      *
+      * @throws Exception::ConversionError if the data cannot be decompressed or the result is empty
     */
     static void uncompressString(const QByteArray& compressed_data, QByteArray& raw_data);
 
+    /**
+      * @brief Uncompresses data using zlib directly into a buffer of known size
+      *
+      * @param compressed_data Compressed data (zlib stream as written by compressData())
+      * @param nr_bytes Number of bytes in compressed data
+      * @param raw_data Output buffer which has to hold at least @p raw_length bytes
+      * @param raw_length Expected number of bytes of the uncompressed data
+      *
+      * @throws Exception::ConversionError if the data cannot be decompressed or does not have the expected size
+    */
+    static void uncompressData(const void* compressed_data, size_t nr_bytes, void* raw_data, size_t raw_length);
+
   };
 
 } // namespace OpenMS
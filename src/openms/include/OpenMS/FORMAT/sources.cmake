@@ -44,8 +44,10 @@ GNPSQuantificationFile.h
 GzipIfstream.h
 GzipInputStream.h
 IBSpectraFile.h
+IdBinFile.h
 IdXMLFile.h
 IndentedStream.h
+InMemoryFileStore.h
 IndexedMzMLFileLoader.h
 InspectInfile.h
 InspectOutfile.h
@@ -77,6 +79,7 @@ OMSFileStore.h
 OMSSACSVFile.h
 OMSSAXMLFile.h
 OSWFile.h
+OffsetIndexFile.h
 ParamCTDFile.h
 ParamXMLFile.h
 PTMXMLFile.h
@@ -89,9 +92,11 @@ PercolatorInfile.h
 PercolatorOutfile.h
 ProtXMLFile.h
 QcMLFile.h
+ReadAheadBuffer.h
 SequestInfile.h
 SequestOutfile.h
 SpecArrayFile.h
+SpillableSpectrumList.h
 SVOutStream.h
 SwathFile.h
 SqliteConnector.h
@@ -0,0 +1,75 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/config.h>
+#include <OpenMS/CONCEPT/Types.h>
+
+namespace OpenMS
+{
+  class ConsensusFeature;
+  class ConsensusMap;
+
+namespace Interfaces
+{
+
+    /**
+      @brief The interface of a consumer of consensus features
+
+      The consensus feature analogue of IMSDataConsumer: consensus features are
+      passed one by one (e.g. while reading a consensusXML file with
+      ConsensusXMLFile::transform()) and can be processed without ever holding
+      the full ConsensusMap in memory.
+
+      Implementations in OpenMS can be found in OpenMS/FORMAT/DATAACCESS
+
+      @note The member functions setExpectedSize and setMapMetaData are
+      expected to be called before consuming starts.
+    */
+    class OPENMS_DLLAPI IConsensusDataConsumer
+    {
+    public:
+      virtual ~IConsensusDataConsumer() {}
+
+      /**
+        @brief Consume a consensus feature
+
+        The consensus feature will be consumed by the implementation and possibly modified.
+
+        @param f The consensus feature to be consumed
+      */
+      virtual void consumeConsensusFeature(ConsensusFeature& f) = 0;
+
+      /**
+        @brief Set expected number of consensus features to be consumed
+
+        @note Calling this method is optional. consensusXML files do not store
+        the number of consensus features, so ConsensusXMLFile::transform()
+        does not call it.
+
+        @param expected_features Number of consensus features expected
+      */
+      virtual void setExpectedSize(Size expected_features) = 0;
+
+      /**
+        @brief Set meta data of the consensus features to be consumed
+
+        @p map contains everything but the consensus features (identifier,
+        column headers, data processing, protein identifications, unassigned
+        peptide identifications, meta values).
+
+        @note Calling this method is optional but good practice.
+
+        @param map Consensus map (without consensus features) which holds the meta data
+      */
+      virtual void setMapMetaData(const ConsensusMap& map) = 0;
+    };
+
+} //end namespace Interfaces
+} //end namespace OpenMS
@@ -0,0 +1,72 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/config.h>
+#include <OpenMS/CONCEPT/Types.h>
+
+namespace OpenMS
+{
+  class Feature;
+  class FeatureMap;
+
+namespace Interfaces
+{
+
+    /**
+      @brief The interface of a consumer of features
+
+      The feature analogue of IMSDataConsumer: features are passed one by one
+      (e.g. while reading a featureXML file with FeatureXMLFile::transform())
+      and can be processed without ever holding the full FeatureMap in memory.
+
+      Implementations in OpenMS can be found in OpenMS/FORMAT/DATAACCESS
+
+      @note The member functions setExpectedSize and setMapMetaData are
+      expected to be called before consuming starts.
+    */
+    class OPENMS_DLLAPI IFeatureDataConsumer
+    {
+    public:
+      virtual ~IFeatureDataConsumer() {}
+
+      /**
+        @brief Consume a feature
+
+        The feature will be consumed by the implementation and possibly modified.
+
+        @param f The feature to be consumed
+      */
+      virtual void consumeFeature(Feature& f) = 0;
+
+      /**
+        @brief Set expected number of features to be consumed
+
+        @note Calling this method is optional but good practice.
+
+        @param expected_features Number of features expected
+      */
+      virtual void setExpectedSize(Size expected_features) = 0;
+
+      /**
+        @brief Set meta data of the features to be consumed
+
+        @p map contains everything but the features (identifier, data
+        processing, protein identifications, unassigned peptide
+        identifications, meta values).
+
+        @note Calling this method is optional but good practice.
+
+        @param map Feature map (without features) which holds the meta data
+      */
+      virtual void setMapMetaData(const FeatureMap& map) = 0;
+    };
+
+} //end namespace Interfaces
+} //end namespace OpenMS
@@ -4,6 +4,8 @@ set(directory include/OpenMS/INTERFACES)
 ### list all header files of the directory here
 set(sources_list_h
 DataStructures.h
+IConsensusDataConsumer.h
+IFeatureDataConsumer.h
 ISpectrumAccess.h
 IMSDataConsumer.h
 )
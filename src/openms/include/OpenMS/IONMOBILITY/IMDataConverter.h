@@ -24,6 +24,7 @@ namespace OpenMS
       class FloatDataArray;
     }
     enum class DriftTimeUnit;
+    class SpectraMerger;
 
     /**
       @brief This class converts PeakMaps and MSSpectra from/to different IM/FAIMS storage models
@@ -32,6 +33,14 @@ namespace OpenMS
     class OPENMS_DLLAPI IMDataConverter
     {
     public:
+      /// The peaks [begin, end) of an ion mobility frame (sorted by IM), which share the same IM value (see getIMFrameViews())
+      struct IMFrameView
+      {
+        Size begin; ///< index of the first peak
+        Size end; ///< index after the last peak
+        double drift_time; ///< IM value of the peaks
+      };
+
       /**
         @brief Splits a PeakMap into one PeakMap per FAIMS compensation voltage
 
@@ -65,6 +74,42 @@ namespace OpenMS
       */
       static MSExperiment reshapeIMFrameToMany(MSSpectrum im_frame);
 
+      /**
+        @brief The spectra of reshapeIMFrameToMany() as views into the frame, i.e. without copying any peaks
+
+        Each view is the index range of the peaks with one distinct IM value. Use extractIMFrameView() to materialize a view as spectrum when it is needed.
+
+        @param im_frame Concatenated spectrum representing an IM frame, sorted by IM (see MSSpectrum::sortByIonMobility())
+        @return One view per distinct IM value, in order of IM
+
+        @throws Exception::MissingInformation if @p im_frame does not have IM data in floatDataArrays
+        @throws Exception::Precondition if @p im_frame is not sorted by IM
+      */
+      static std::vector<IMFrameView> getIMFrameViews(const MSSpectrum& im_frame);
+
+      /**
+        @brief Copies the peaks of a @p view (see getIMFrameViews()) of @p im_frame into a new spectrum
+
+        The result is the spectrum reshapeIMFrameToMany() creates for the view: it has the meta data of @p im_frame (but no data arrays),
+        the drift time of the view (with unit @p im_unit, see MSSpectrum::getIMData()) and is sorted by m/z.
+      */
+      static MSSpectrum extractIMFrameView(const MSSpectrum& im_frame, const IMFrameView& view, DriftTimeUnit im_unit);
+
+      /**
+        @brief Bins one ion mobility frame, in the same way as splitExperimentByIonMobility() does for each frame
+
+        The spectra of @p im_frame (see reshapeIMFrameToMany()) which fall into a bin are merged using SpectraMerger::mergeBlock().
+        Only the peaks of the bin which is currently merged are copied.
+
+        @param im_frame Concatenated spectrum representing an IM frame (gets sorted by IM if it is not)
+        @param bins The IM bins (see Math::createBins())
+        @param merger Merges the spectra of a bin (using its parameters 'mz_binning_width' and 'mz_binning_width_unit')
+        @return One spectrum per bin, with the bin center as drift time (empty if no peaks fall into the bin)
+
+        @throws Exception::MissingInformation if @p im_frame is not empty and does not have IM data in floatDataArrays
+      */
+      static std::vector<MSSpectrum> binIMFrame(MSSpectrum& im_frame, const Math::BinContainer& bins, const SpectraMerger& merger);
+
       /**
          @brief Bins the ion mobility range into discrete bins and creates a new MSExperiment for each IM bin.
          
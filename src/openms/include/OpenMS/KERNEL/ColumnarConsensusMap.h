@@ -0,0 +1,129 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  class ConsensusMap;
+
+  /**
+    @brief Column-oriented (feature x map) copy of the feature handles of a ConsensusMap
+
+    A ConsensusFeature stores its handles in a tree (ConsensusFeature::HandleSetType). Algorithms that
+    scan the intensities of all handles, or of all handles of one map, e.g. for normalization, spend most
+    of their time chasing tree nodes. This class copies position and intensity of all handles into
+    contiguous columns, in compressed sparse row layout: the handles of consensus feature @em i are the
+    entries <tt>[getFeatureOffsets()[i], getFeatureOffsets()[i+1])</tt>, in the order of the handle set.
+    In addition, the entries of each map (column) are indexed, see getMapEntries().
+
+    Modified intensities can be written back into the consensus map with applyIntensities().
+
+    @ingroup Kernel
+  */
+  class OPENMS_DLLAPI ColumnarConsensusMap
+  {
+public:
+    /// Default constructor (no features)
+    ColumnarConsensusMap() = default;
+
+    /// Copies the handles of all consensus features of @p map
+    explicit ColumnarConsensusMap(const ConsensusMap& map);
+
+    /// Number of consensus features (rows)
+    Size featureCount() const
+    {
+      return feature_offsets_.size() - 1;
+    }
+
+    /// Number of feature handles (entries)
+    Size entryCount() const
+    {
+      return map_indices_.size();
+    }
+
+    /// Number of maps (columns): largest map index of the column headers or the handles, plus one
+    Size mapCount() const
+    {
+      return map_offsets_.size() - 1;
+    }
+
+    /// Start of the entries of each consensus feature (plus the total number of entries at the end)
+    const std::vector<Size>& getFeatureOffsets() const
+    {
+      return feature_offsets_;
+    }
+
+    /// Map index of each entry
+    const std::vector<UInt64>& getMapIndices() const
+    {
+      return map_indices_;
+    }
+
+    /// Retention time of each entry
+    const std::vector<double>& getRT() const
+    {
+      return rt_;
+    }
+
+    /// m/z of each entry
+    const std::vector<double>& getMZ() const
+    {
+      return mz_;
+    }
+
+    /// Intensity of each entry
+    const std::vector<float>& getIntensities() const
+    {
+      return intensities_;
+    }
+
+    /// Intensity of each entry (mutable, see applyIntensities())
+    std::vector<float>& getIntensities()
+    {
+      return intensities_;
+    }
+
+    /// Entries grouped by map: the entries of map @em j are <tt>getMapEntries()[getMapOffsets()[j] ... getMapOffsets()[j+1]-1]</tt>
+    const std::vector<Size>& getMapOffsets() const
+    {
+      return map_offsets_;
+    }
+
+    /// Entry indices grouped by map (in order of the consensus features), see getMapOffsets()
+    const std::vector<Size>& getMapEntries() const
+    {
+      return map_entries_;
+    }
+
+    /// Intensities of all entries of map @p map_index (empty if the index is out of range)
+    std::vector<float> getMapIntensities(UInt64 map_index) const;
+
+    /**
+      @brief Writes the intensities back into the feature handles of @p map
+
+      @exception Exception::InvalidSize is thrown if @p map does not have the same number of consensus
+      features and handles as the map this object was created from
+    */
+    void applyIntensities(ConsensusMap& map) const;
+
+protected:
+    std::vector<Size> feature_offsets_ = std::vector<Size>(1, 0);
+    std::vector<UInt64> map_indices_;
+    std::vector<double> rt_;
+    std::vector<double> mz_;
+    std::vector<float> intensities_;
+    std::vector<Size> map_offsets_ = std::vector<Size>(1, 0);
+    std::vector<Size> map_entries_;
+  };
+
+} // namespace OpenMS
@@ -0,0 +1,181 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  class MSExperiment;
+
+  /**
+    @brief Column-oriented (structure-of-arrays) representation of all peaks of a map
+
+    The m/z and intensity values of all spectra are concatenated into two
+    contiguous columns. The peaks of spectrum @em i are the elements
+    [offsets[i], offsets[i+1]) of these columns, i.e. the offset column has one
+    entry more than there are spectra. RT and MS level are stored as
+    one value per spectrum. Chromatograms are stored the same way (RT and
+    intensity columns plus offsets).
+
+    This is the layout expected by array based consumers (e.g. NumPy or
+    machine learning frameworks): a whole map is exported as a handful of
+    buffers which can be wrapped without copying, instead of one copy per
+    spectrum. Only the peaks and the meta data listed above are kept; use
+    toMSExperiment() on a map which already holds the remaining meta data to
+    convert back.
+
+    Conversion in both directions is parallelized over spectra.
+
+    @see ColumnarSpectrum
+
+    @ingroup Kernel
+  */
+  class OPENMS_DLLAPI ColumnarExperiment
+  {
+public:
+    /// Default constructor (no spectra and chromatograms)
+    ColumnarExperiment() = default;
+
+    /// Constructor from the spectra and chromatograms of @p exp
+    explicit ColumnarExperiment(const MSExperiment& exp);
+
+    /// Equality operator
+    bool operator==(const ColumnarExperiment& rhs) const;
+
+    /// Inequality operator
+    bool operator!=(const ColumnarExperiment& rhs) const;
+
+    /**
+      @name Conversion
+    */
+    //@{
+    /// Replaces the content by the spectra and chromatograms of @p exp
+    void assign(const MSExperiment& exp);
+
+    /**
+      @brief Writes the peaks back to @p exp
+
+      Spectra and chromatograms of @p exp are added or removed to match the
+      number stored here. The peaks (and RT and MS level of the spectra) are
+      replaced, all other meta data of existing spectra and chromatograms
+      is kept. Float, integer and string data arrays are cleared, since their
+      entries would not correspond to the peaks anymore.
+    */
+    void toMSExperiment(MSExperiment& exp) const;
+
+    /**
+      @brief Replaces the spectrum columns
+
+      @param mz m/z values of all spectra
+      @param intensity Intensity values of all spectra (same size as @p mz)
+      @param offsets Start of each spectrum in @p mz / @p intensity, followed by the total number of peaks
+      @param rt Retention time of each spectrum (one entry less than @p offsets)
+      @param ms_level MS level of each spectrum (one entry less than @p offsets)
+
+      @exception Exception::InvalidSize if the sizes of the columns do not match
+      @exception Exception::InvalidValue if the offsets do not start at 0, are decreasing or do not end at the number of peaks
+    */
+    void setSpectra(std::vector<double> mz, std::vector<float> intensity, std::vector<UInt64> offsets,
+                    std::vector<double> rt, std::vector<UInt> ms_level);
+
+    /**
+      @brief Replaces the chromatogram columns
+
+      @param rt Retention times of all chromatograms
+      @param intensity Intensity values of all chromatograms (same size as @p rt)
+      @param offsets Start of each chromatogram in @p rt / @p intensity, followed by the total number of peaks
+
+      @exception Exception::InvalidSize if the sizes of the columns do not match
+      @exception Exception::InvalidValue if the offsets do not start at 0, are decreasing or do not end at the number of peaks
+    */
+    void setChromatograms(std::vector<double> rt, std::vector<float> intensity, std::vector<UInt64> offsets);
+
+    /// Removes all spectra and chromatograms
+    void clear();
+    //@}
+
+    /**
+      @name Spectra
+    */
+    //@{
+    /// Number of spectra
+    Size getNrSpectra() const;
+
+    /// Total number of peaks of all spectra
+    Size getNrSpectraPeaks() const;
+
+    /// m/z values of all spectra (mutable access may change values, but not the number of peaks)
+    const std::vector<double>& getMZArray() const;
+    std::vector<double>& getMZArray();
+
+    /// Intensity values of all spectra (mutable access may change values, but not the number of peaks)
+    const std::vector<float>& getIntensityArray() const;
+    std::vector<float>& getIntensityArray();
+
+    /// Start of each spectrum in the m/z and intensity columns, followed by the total number of peaks
+    const std::vector<UInt64>& getSpectrumOffsets() const;
+
+    /// Retention time of each spectrum
+    const std::vector<double>& getRTArray() const;
+    std::vector<double>& getRTArray();
+
+    /// MS level of each spectrum
+    const std::vector<UInt>& getMSLevelArray() const;
+    std::vector<UInt>& getMSLevelArray();
+    //@}
+
+    /**
+      @name Chromatograms
+    */
+    //@{
+    /// Number of chromatograms
+    Size getNrChromatograms() const;
+
+    /// Total number of peaks of all chromatograms
+    Size getNrChromatogramPeaks() const;
+
+    /// Retention times of all chromatograms (mutable access may change values, but not the number of peaks)
+    const std::vector<double>& getChromatogramRTArray() const;
+    std::vector<double>& getChromatogramRTArray();
+
+    /// Intensity values of all chromatograms (mutable access may change values, but not the number of peaks)
+    const std::vector<float>& getChromatogramIntensityArray() const;
+    std::vector<float>& getChromatogramIntensityArray();
+
+    /// Start of each chromatogram in the RT and intensity columns, followed by the total number of peaks
+    const std::vector<UInt64>& getChromatogramOffsets() const;
+    //@}
+
+protected:
+    /// Throws if @p offsets do not describe @p nr_peaks peaks
+    static void checkOffsets_(const std::vector<UInt64>& offsets, Size nr_peaks);
+
+    /// m/z column of all spectra
+    std::vector<double> mz_;
+    /// intensity column of all spectra
+    std::vector<float> intensity_;
+    /// start of each spectrum in mz_ / intensity_ (size: number of spectra + 1)
+    std::vector<UInt64> spectrum_offsets_ = {0};
+    /// retention time of each spectrum
+    std::vector<double> rt_;
+    /// MS level of each spectrum
+    std::vector<UInt> ms_level_;
+
+    /// RT column of all chromatograms
+    std::vector<double> chrom_rt_;
+    /// intensity column of all chromatograms
+    std::vector<float> chrom_intensity_;
+    /// start of each chromatogram in chrom_rt_ / chrom_intensity_ (size: number of chromatograms + 1)
+    std::vector<UInt64> chrom_offsets_ = {0};
+  };
+
+} // namespace OpenMS
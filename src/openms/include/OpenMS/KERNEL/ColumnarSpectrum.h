@@ -0,0 +1,284 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/IONMOBILITY/IMTypes.h>
+
+#include <string>
+#include <vector>
+
+namespace OpenMS
+{
+  class MSSpectrum;
+
+  /**
+    @brief Column-oriented (structure-of-arrays) representation of the peaks of a spectrum
+
+    MSSpectrum stores its peaks as a vector of Peak1D, i.e. m/z and intensity
+    values are interleaved (including padding) and ion mobility values live in
+    a separate float data array. Algorithms which only need to walk over a
+    single dimension (binary search over m/z, summing intensities, tophat
+    extraction) have to stride over this layout.
+
+    This class stores the m/z, intensity and (optional) ion mobility values in
+    three contiguous columns instead. An m/z value takes 8 bytes and an
+    intensity 4 bytes per peak, compared to 16 bytes for a Peak1D.
+    Only the meta data needed for most signal processing (RT, MS level and
+    drift time) is kept; use toMSSpectrum() on a spectrum which already holds
+    the remaining meta data (e.g. from copySpectrumMeta()) to convert back.
+
+    The ion mobility column is either empty or has the same size as the m/z
+    column. All modifying operations keep the columns aligned.
+
+    @ingroup Kernel
+  */
+  class OPENMS_DLLAPI ColumnarSpectrum
+  {
+public:
+    /// Default constructor
+    ColumnarSpectrum() = default;
+
+    /// Constructor from a spectrum (see assign())
+    explicit ColumnarSpectrum(const MSSpectrum& spectrum);
+
+    /// Copy constructor
+    ColumnarSpectrum(const ColumnarSpectrum& source) = default;
+
+    /// Move constructor
+    ColumnarSpectrum(ColumnarSpectrum&& source) noexcept = default;
+
+    /// Destructor
+    ~ColumnarSpectrum() = default;
+
+    /// Assignment operator
+    ColumnarSpectrum& operator=(const ColumnarSpectrum& source) = default;
+
+    /// Move assignment operator
+    ColumnarSpectrum& operator=(ColumnarSpectrum&& source) noexcept = default;
+
+    /// Equality operator
+    bool operator==(const ColumnarSpectrum& rhs) const;
+
+    /// Equality operator
+    bool operator!=(const ColumnarSpectrum& rhs) const;
+
+    /**
+      @brief Copies the peaks (and ion mobility array, if present) of @p spectrum into the columns
+
+      RT, MS level, drift time and drift time unit are taken over from @p spectrum.
+      If the spectrum contains IM data (see MSSpectrum::containsIMData()), the ion
+      mobility array is copied into the ion mobility column and its name is
+      stored. Other data arrays are ignored.
+    */
+    void assign(const MSSpectrum& spectrum);
+
+    /**
+      @brief Writes the columns back into @p spectrum
+
+      All peaks and data arrays of @p spectrum are replaced. RT, MS level and
+      drift time are set; all other meta data of @p spectrum remains untouched.
+      If an ion mobility column is present, it is added as float data array
+      named getIonMobilityArrayName() or, if no name is set, named according
+      to the drift time unit.
+
+      @exception Exception::InvalidValue is thrown if an ion mobility column without name is present and the drift time unit is not a valid ion mobility array unit
+    */
+    void toMSSpectrum(MSSpectrum& spectrum) const;
+
+    /// Returns a new spectrum holding the peaks and meta data of this object
+    MSSpectrum toMSSpectrum() const;
+
+    /// @name Column access
+    //@{
+    /// Returns the m/z column
+    const std::vector<double>& getMZArray() const
+    {
+      return mz_;
+    }
+    /// Returns the mutable m/z column (the caller needs to keep the columns aligned)
+    std::vector<double>& getMZArray()
+    {
+      return mz_;
+    }
+    /// Returns the intensity column
+    const std::vector<float>& getIntensityArray() const
+    {
+      return intensity_;
+    }
+    /// Returns the mutable intensity column (the caller needs to keep the columns aligned)
+    std::vector<float>& getIntensityArray()
+    {
+      return intensity_;
+    }
+    /// Returns the ion mobility column (empty if no ion mobility data is present)
+    const std::vector<float>& getIonMobilityArray() const
+    {
+      return ion_mobility_;
+    }
+    /// Returns the mutable ion mobility column (the caller needs to keep the columns aligned)
+    std::vector<float>& getIonMobilityArray()
+    {
+      return ion_mobility_;
+    }
+    /// Whether an ion mobility value is available for each peak
+    bool hasIonMobility() const
+    {
+      return !ion_mobility_.empty() && ion_mobility_.size() == mz_.size();
+    }
+    //@}
+
+    /// @name Peak access
+    //@{
+    /// Number of peaks
+    Size size() const
+    {
+      return mz_.size();
+    }
+    /// Whether the spectrum contains no peaks
+    bool empty() const
+    {
+      return mz_.empty();
+    }
+    /// Reserves space for @p n peaks in all used columns
+    void reserve(Size n);
+    /// Removes all peaks (meta data is kept)
+    void clear();
+    /// Appends a peak (only valid if the spectrum has no ion mobility column)
+    void push_back(double mz, float intensity);
+    /// Appends a peak including its ion mobility value
+    void push_back(double mz, float intensity, float ion_mobility);
+    /// Removes the peaks in the index range [@p first, @p last) from all columns
+    void erase(Size first, Size last);
+    //@}
+
+    /// @name Meta data
+    //@{
+    /// Returns the retention time
+    double getRT() const
+    {
+      return rt_;
+    }
+    /// Sets the retention time
+    void setRT(double rt)
+    {
+      rt_ = rt;
+    }
+    /// Returns the MS level
+    UInt getMSLevel() const
+    {
+      return ms_level_;
+    }
+    /// Sets the MS level
+    void setMSLevel(UInt ms_level)
+    {
+      ms_level_ = ms_level;
+    }
+    /// Returns the drift time of the spectrum (IMTypes::DRIFTTIME_NOT_SET if not set)
+    double getDriftTime() const
+    {
+      return drift_time_;
+    }
+    /// Sets the drift time of the spectrum
+    void setDriftTime(double dt)
+    {
+      drift_time_ = dt;
+    }
+    /// Returns the unit of the spectrum drift time
+    DriftTimeUnit getDriftTimeUnit() const
+    {
+      return drift_time_unit_;
+    }
+    /// Sets the unit of the spectrum drift time
+    void setDriftTimeUnit(DriftTimeUnit dt)
+    {
+      drift_time_unit_ = dt;
+    }
+    /// Returns the name of the float data array the ion mobility column is stored in by toMSSpectrum()
+    const std::string& getIonMobilityArrayName() const
+    {
+      return ion_mobility_name_;
+    }
+    /// Sets the name of the float data array the ion mobility column is stored in by toMSSpectrum()
+    void setIonMobilityArrayName(const std::string& name)
+    {
+      ion_mobility_name_ = name;
+    }
+    //@}
+
+    /// @name Sorting and searching
+    //@{
+    /// Checks if the peaks are sorted by m/z
+    bool isSorted() const;
+
+    /// Sorts all columns by m/z (stable)
+    void sortByPosition();
+
+    /**
+      @brief Binary search for the first peak with m/z >= @p mz (returns size() if there is none)
+
+      @note Make sure the spectrum is sorted with respect to m/z. Otherwise the result is undefined.
+    */
+    Size MZBegin(double mz) const;
+
+    /**
+      @brief Binary search for the first peak with m/z > @p mz (returns size() if there is none)
+
+      @note Make sure the spectrum is sorted with respect to m/z. Otherwise the result is undefined.
+    */
+    Size MZEnd(double mz) const;
+
+    /**
+      @brief Binary search for the peak nearest to a specific m/z
+
+      @return The index of the peak.
+
+      @note Make sure the spectrum is sorted with respect to m/z. Otherwise the result is undefined.
+
+      @exception Exception::Precondition is thrown if the spectrum is empty (not only in debug mode)
+    */
+    Size findNearest(double mz) const;
+
+    /**
+      @brief Binary search for the peak nearest to a specific m/z given a +/- tolerance window in Th
+
+      @return The index of the peak or -1 if no peak present in tolerance window.
+
+      @note Make sure the spectrum is sorted with respect to m/z. Otherwise the result is undefined.
+    */
+    Int findNearest(double mz, double tolerance) const;
+
+    /**
+      @brief Sum of the intensities of all peaks with @p mz_start <= m/z <= @p mz_end
+
+      @note Make sure the spectrum is sorted with respect to m/z. Otherwise the result is undefined.
+    */
+    double sumIntensity(double mz_start, double mz_end) const;
+    //@}
+
+protected:
+    /// m/z column
+    std::vector<double> mz_;
+    /// intensity column
+    std::vector<float> intensity_;
+    /// ion mobility column (empty or same size as mz_)
+    std::vector<float> ion_mobility_;
+    /// retention time
+    double rt_ = -1.0;
+    /// MS level
+    UInt ms_level_ = 1;
+    /// drift time of the whole spectrum
+    double drift_time_ = IMTypes::DRIFTTIME_NOT_SET;
+    /// unit of the drift time
+    DriftTimeUnit drift_time_unit_ = DriftTimeUnit::NONE;
+    /// name of the ion mobility float data array
+    std::string ion_mobility_name_;
+  };
+
+} // namespace OpenMS
@@ -14,6 +14,9 @@
 #include <OpenMS/KERNEL/ChromatogramPeak.h>
 #include <OpenMS/METADATA/DataArrays.h>
 
+#include <algorithm>
+#include <limits>
+
 namespace OpenMS
 {
   class ChromatogramPeak;
@@ -132,10 +135,26 @@ public:
     void updateRanges() override
     {
       clearRanges();
+      // local minima and maxima, see MSSpectrum::updateRanges()
+      double min_rt = std::numeric_limits<double>::max(), max_rt = std::numeric_limits<double>::lowest();
+      double min_int = std::numeric_limits<double>::max(), max_int = std::numeric_limits<double>::lowest();
       for (const auto& peak : (ContainerType&) *this)
       {
-        extendRT(peak.getRT());
-        extendIntensity(peak.getIntensity());
+        const double rt = peak.getRT(), intensity = peak.getIntensity();
+        min_rt = std::min(min_rt, rt);
+        max_rt = std::max(max_rt, rt);
+        min_int = std::min(min_int, intensity);
+        max_int = std::max(max_int, intensity);
+      }
+      if (min_rt <= max_rt)
+      {
+        extendRT(min_rt);
+        extendRT(max_rt);
+      }
+      if (min_int <= max_int)
+      {
+        extendIntensity(min_int);
+        extendIntensity(max_int);
       }
     }
 
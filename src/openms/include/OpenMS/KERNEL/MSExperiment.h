@@ -13,6 +13,7 @@
 #include <OpenMS/KERNEL/MSChromatogram.h>
 #include <OpenMS/KERNEL/MSSpectrum.h>
 #include <OpenMS/METADATA/ExperimentalSettings.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
 
 #include <vector>
 
@@ -561,6 +562,18 @@ public:
     */
     bool clearMetaDataArrays();
 
+    /**
+      @brief Re-allocates the data of all spectra and chromatograms on the NUMA nodes of the processing threads
+
+      On multi-socket machines, a map loaded by a single thread resides on the node of that thread; threads
+      on other nodes then access it at reduced bandwidth. FIRST_TOUCH moves spectrum (chromatogram) i to the node of
+      the thread which processes index i in a 'parallel for schedule(static)' loop (bind the threads
+      with TaskScheduler::setThreadAffinity()); INTERLEAVE spreads the pages over all nodes.
+
+      @see TaskScheduler::placeMemory()
+    */
+    void placeMemory(TaskScheduler::MemoryPlacement placement);
+
     /// returns the meta information of this experiment (const access)
     const ExperimentalSettings& getExperimentalSettings() const;
 
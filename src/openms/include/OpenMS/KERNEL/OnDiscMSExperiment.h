@@ -28,14 +28,19 @@ namespace OpenMS
 
     @ingroup Kernel
 
-    @note This implementation is @a not thread-safe since it keeps internally a
-    single file access pointer which it moves when accessing a specific
-    data item. Please provide a separate copy to each thread, e.g. 
+    Reading spectra and chromatograms is thread-safe (see
+    Internal::IndexedMzMLHandler), use getSpectra() / getChromatograms() to
+    read and decode a batch of data items in parallel. Providing a separate
+    copy to each thread is possible as well, e.g.
 
     @code
     #pragma omp parallel for firstprivate(ondisc_map) 
     @endcode
 
+    @note Looking up data items by native id (getSpectrumByNativeId,
+    getChromatogramByNativeId) lazily builds an internal map on first use
+    and is therefore not thread-safe.
+
   */
   class OPENMS_DLLAPI OnDiscMSExperiment
   {
@@ -59,7 +64,7 @@ public:
       the meta information into memory.
 
       @return Whether the parsing of the file was successful (if false, the
-      file most likely was not an indexed mzML file)
+      file most likely was not an indexed mzML file, see setOffsetIndexFallback())
     */
     bool openFile(const String& filename, bool skipMetaData = false);
 
@@ -166,6 +171,30 @@ public:
       return spectrum;
     }
 
+    /**
+      @brief returns multiple spectra, read and decoded in parallel
+
+      Equivalent to calling getSpectrum() for each entry of @p ids, but the
+      spectra are read from disk and decoded concurrently using all available
+      threads.
+
+      @param ids The indices of the spectra (may be in any order)
+      @return The spectra, in the order of @p ids
+
+      @throw Exception::ParseError if any of the spectra cannot be read
+    */
+    std::vector<MSSpectrum> getSpectra(const std::vector<Size>& ids);
+
+    /**
+      @brief returns multiple chromatograms, read and decoded in parallel
+
+      @param ids The indices of the chromatograms (may be in any order)
+      @return The chromatograms, in the order of @p ids
+
+      @throw Exception::ParseError if any of the chromatograms cannot be read
+    */
+    std::vector<MSChromatogram> getChromatograms(const std::vector<Size>& ids);
+
     /**
       @brief returns a single spectrum
     */
@@ -210,6 +239,9 @@ public:
     /// sets whether to skip some XML checks and be fast instead
     void setSkipXMLChecks(bool skip);
 
+    /// sets whether mzML files without index are indexed by a pre-scan (see IndexedMzMLHandler::setOffsetIndexFallback()), call before openFile()
+    void setOffsetIndexFallback(bool fallback);
+
 private:
 
     /// Private Assignment operator -> we cannot copy file streams in IndexedMzMLHandler
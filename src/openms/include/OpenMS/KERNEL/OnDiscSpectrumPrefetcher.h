@@ -0,0 +1,122 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/KERNEL/OnDiscMSExperiment.h>
+
+#include <future>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Reads spectra of an OnDiscMSExperiment ahead on a background thread
+
+    Sequential scans over an on-disc experiment wait for every spectrum to be
+    read and decoded. This class reads the spectra in batches of @p batch_size
+    (using OnDiscMSExperiment::getSpectra(), which decodes a batch in parallel)
+    and always starts reading the next batch before the current one is handed
+    out. Processing of a batch thus overlaps reading of the following one, at
+    the cost of holding at most two batches in memory.
+
+    @code
+    OnDiscSpectrumPrefetcher prefetcher(exp);
+    std::vector<MSSpectrum> batch;
+    while (prefetcher.nextBatch(batch))
+    {
+      // spectrum batch[k] has index prefetcher.batchStart() + k
+    }
+    @endcode
+
+    The experiment must not be modified or destroyed while the prefetcher is in
+    use. Errors while reading are rethrown by nextBatch() / next() for the batch
+    in which they occurred.
+  */
+  class OPENMS_DLLAPI OnDiscSpectrumPrefetcher
+  {
+public:
+    /**
+      @brief Constructor for all spectra of @p exp (in order); starts reading the first batch
+
+      @throw Exception::IllegalArgument if @p batch_size is zero
+    */
+    explicit OnDiscSpectrumPrefetcher(OnDiscMSExperiment& exp, Size batch_size = 1000);
+
+    /**
+      @brief Constructor for the spectra @p ids of @p exp (in the order given); starts reading the first batch
+
+      @throw Exception::IllegalArgument if @p batch_size is zero
+    */
+    OnDiscSpectrumPrefetcher(OnDiscMSExperiment& exp, const std::vector<Size>& ids, Size batch_size = 1000);
+
+    /// Destructor; waits for a pending read
+    ~OnDiscSpectrumPrefetcher();
+
+    OnDiscSpectrumPrefetcher(const OnDiscSpectrumPrefetcher&) = delete;
+    OnDiscSpectrumPrefetcher& operator=(const OnDiscSpectrumPrefetcher&) = delete;
+
+    /**
+      @brief Moves the next batch of spectra into @p batch and starts reading the one after
+
+      @return false (and @p batch is cleared) if all spectra have been returned
+
+      @throw Exception::ParseError if a spectrum of the batch cannot be read
+    */
+    bool nextBatch(std::vector<MSSpectrum>& batch);
+
+    /**
+      @brief Moves the next spectrum into @p spectrum
+
+      Uses the same batches as nextBatch(); do not mix both on one object.
+
+      @return false if all spectra have been returned
+
+      @throw Exception::ParseError if a spectrum cannot be read
+    */
+    bool next(MSSpectrum& spectrum);
+
+    /// Position (in the list of ids) of the first spectrum of the batch last returned by nextBatch()
+    Size batchStart() const
+    {
+      return batch_start_;
+    }
+
+    /// Number of spectra not yet returned
+    Size remaining() const
+    {
+      return ids_.size() - returned_;
+    }
+
+protected:
+    /// Starts reading the batch beginning at position next_start_ (if any)
+    void prefetch_();
+
+    /// Waits for the pending batch and moves it into @p batch, then starts reading the next one
+    bool fetch_(std::vector<MSSpectrum>& batch);
+
+    OnDiscMSExperiment& exp_;
+    std::vector<Size> ids_;
+    Size batch_size_;
+
+    /// Position of the first spectrum of the batch being read
+    Size next_start_ = 0;
+    /// Position of the first spectrum of the last batch returned
+    Size batch_start_ = 0;
+    /// Number of spectra returned (in batches or one by one)
+    Size returned_ = 0;
+
+    /// The batch being read
+    std::future<std::vector<MSSpectrum> > pending_;
+
+    /// Batch from which next() returns spectra
+    std::vector<MSSpectrum> current_;
+    Size current_pos_ = 0;
+  };
+
+} // namespace OpenMS
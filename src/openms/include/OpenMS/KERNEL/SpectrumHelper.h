@@ -11,6 +11,7 @@
 #include <OpenMS/MATH/StatisticFunctions.h>
 #include <OpenMS/METADATA/DataArrays.h>
 #include <OpenMS/KERNEL/MSSpectrum.h>
+#include <OpenMS/KERNEL/ColumnarSpectrum.h>
 #include <OpenMS/CONCEPT/LogStream.h>
 
 namespace OpenMS
@@ -121,6 +122,12 @@ namespace OpenMS
     }
     // Note: data arrays are not updated
   }
+
+  /// remove all peaks EXCEPT in the given range (the ion mobility column is kept aligned)
+  OPENMS_DLLAPI void removePeaks(ColumnarSpectrum& p, const double pos_start, const double pos_end);
+
+  /// subtract the minimum intensity of all peaks from all intensities
+  OPENMS_DLLAPI void subtractMinimumIntensity(ColumnarSpectrum& p);
   
   /**
    * @brief Possible methods for merging peak intensities.
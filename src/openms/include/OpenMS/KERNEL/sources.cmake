@@ -8,6 +8,9 @@ BaseFeature.h
 BinnedSpectrum.h
 ChromatogramPeak.h
 ChromatogramTools.h
+ColumnarConsensusMap.h
+ColumnarExperiment.h
+ColumnarSpectrum.h
 ConsensusFeature.h
 ConversionHelper.h
 ConsensusMap.h
@@ -27,6 +30,7 @@ MSChromatogram.h
 MSExperiment.h
 MSSpectrum.h
 OnDiscMSExperiment.h
+OnDiscSpectrumPrefetcher.h
 Peak1D.h
 Peak2D.h
 PeakIndex.h
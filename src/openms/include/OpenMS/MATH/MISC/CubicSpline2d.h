@@ -61,6 +61,16 @@ public:
      */
     double eval(double x) const;
 
+    /**
+     * @brief evaluates the spline at all positions in @p x (in place)
+     *
+     * Same as eval(double) for each position, but for increasing positions
+     * the spline segments are located in a single pass.
+     *
+     * @param x x-positions
+     */
+    void eval(std::vector<double>& x) const;
+
     /**
      * @brief evaluates first derivative of spline at position x
      *
@@ -90,6 +90,28 @@ public:
       const double right_pos = 0.0
     ) const;
 
+    /**
+      @brief Fit many peaks to the EMG peak model, in parallel
+
+      Equivalent to calling fitEMGPeakModel() for each peak, but the peaks are
+      fitted concurrently (see TaskScheduler::parallelFor(), which also composes
+      with an enclosing parallel region).
+
+      @tparam PeakContainerT Either a MSChromatogram or a MSSpectrum
+      @param[in] input_peaks Input peaks
+      @param[out] output_peaks Output peaks (same order as @p input_peaks)
+      @param[in] boundaries `left_pos` and `right_pos` of each peak (see fitEMGPeakModel()); empty to use the whole peaks
+
+      @throw Exception::InvalidSize if @p boundaries is neither empty nor of the size of @p input_peaks
+      @throw Exception::SizeUnderflow if a peak has less than 2 points (the first error is rethrown)
+    */
+    template <typename PeakContainerT>
+    void fitEMGPeakModels(
+      const std::vector<PeakContainerT>& input_peaks,
+      std::vector<PeakContainerT>& output_peaks,
+      const std::vector<std::pair<double, double>>& boundaries = {}
+    ) const;
+
     /**
       @brief The implementation of the gradient descent algorithm for the EMG peak model
 
@@ -251,6 +273,41 @@ private:
       const double tau
     ) const;
 
+    /**
+      @brief Compute the cost given by loss function E and its partial derivatives in one pass
+
+      Gives the same results as Loss_function(), E_wrt_h(), E_wrt_mu(), E_wrt_sigma()
+      and E_wrt_tau(), at a fraction of the cost: the exponential and error function
+      terms are evaluated once per point instead of once per derivative.
+      Used by estimateEmgParameters() unless `print_debug` is 2 (which prints the
+      terms of the single functions).
+
+      @param[in] xs Positions
+      @param[in] ys Intensities
+      @param[in] h Amplitude
+      @param[in] mu Mean
+      @param[in] sigma Standard deviation
+      @param[in] tau Exponent relaxation time
+      @param[out] E The cost
+      @param[out] diff_E_h Partial derivative with respect to `h`
+      @param[out] diff_E_mu Partial derivative with respect to `mu`
+      @param[out] diff_E_sigma Partial derivative with respect to `sigma`
+      @param[out] diff_E_tau Partial derivative with respect to `tau`
+    */
+    void Loss_and_gradient(
+      const std::vector<double>& xs,
+      const std::vector<double>& ys,
+      const double h,
+      const double mu,
+      const double sigma,
+      const double tau,
+      double& E,
+      double& diff_E_h,
+      double& diff_E_mu,
+      double& diff_E_sigma,
+      double& diff_E_tau
+    ) const;
+
     /**
       @brief Compute the cost given by the partial derivative of the loss function E,
       with respect to `h` (the amplitude)
@@ -431,6 +488,71 @@ public:
       return emg_gd_.Loss_function(xs, ys, h, mu, sigma, tau);
     }
 
+    void Loss_and_gradient(
+      const std::vector<double>& xs,
+      const std::vector<double>& ys,
+      const double h,
+      const double mu,
+      const double sigma,
+      const double tau,
+      double& E,
+      double& diff_E_h,
+      double& diff_E_mu,
+      double& diff_E_sigma,
+      double& diff_E_tau
+    ) const
+    {
+      emg_gd_.Loss_and_gradient(xs, ys, h, mu, sigma, tau, E, diff_E_h, diff_E_mu, diff_E_sigma, diff_E_tau);
+    }
+
+    double E_wrt_h(
+      const std::vector<double>& xs,
+      const std::vector<double>& ys,
+      const double h,
+      const double mu,
+      const double sigma,
+      const double tau
+    ) const
+    {
+      return emg_gd_.E_wrt_h(xs, ys, h, mu, sigma, tau);
+    }
+
+    double E_wrt_mu(
+      const std::vector<double>& xs,
+      const std::vector<double>& ys,
+      const double h,
+      const double mu,
+      const double sigma,
+      const double tau
+    ) const
+    {
+      return emg_gd_.E_wrt_mu(xs, ys, h, mu, sigma, tau);
+    }
+
+    double E_wrt_sigma(
+      const std::vector<double>& xs,
+      const std::vector<double>& ys,
+      const double h,
+      const double mu,
+      const double sigma,
+      const double tau
+    ) const
+    {
+      return emg_gd_.E_wrt_sigma(xs, ys, h, mu, sigma, tau);
+    }
+
+    double E_wrt_tau(
+      const std::vector<double>& xs,
+      const std::vector<double>& ys,
+      const double h,
+      const double mu,
+      const double sigma,
+      const double tau
+    ) const
+    {
+      return emg_gd_.E_wrt_tau(xs, ys, h, mu, sigma, tau);
+    }
+
     double computeMuMaxDistance(const std::vector<double>& xs) const
     {
       return emg_gd_.computeMuMaxDistance(xs);
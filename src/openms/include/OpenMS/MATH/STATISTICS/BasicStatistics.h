@@ -9,6 +9,7 @@
 #pragma once
 
 #include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/MATH/StatisticFunctions.h>
 #include <vector>
 #include <ostream>
 #include <cmath>
@@ -146,6 +147,52 @@ public:
         return;
       }
 
+      /**
+        @brief Same as update(probability.begin(), probability.end()) for contiguous data
+
+        The sums are reduced in partial sums which the compiler can vectorize,
+        so the result may differ in the last digits.
+      */
+      void update(const probability_container& probability)
+      {
+        clear();
+        const RealType* p = probability.data();
+        const Size n = probability.size();
+        sum_ = Detail::laneSum(n, [p](Size i) { return double(p[i]); });
+        const double mean = Detail::laneSum(n, [p](Size i) { return double(p[i]) * double(i); }) / sum_;
+        mean_ = mean;
+        variance_ = Detail::laneSum(n, [p, mean](Size i) { const double diff = double(i) - mean; return double(p[i]) * diff * diff; }) / sum_;
+        if (sum_ == 0 && (std::isnan(mean_) || std::isinf(mean_)) )
+        {
+          mean_ = 0;
+          variance_ = 0;
+        }
+      }
+
+      /**
+        @brief Same as update(probability.begin(), probability.end(), coordinate.begin()) for contiguous data
+
+        The sums are reduced in partial sums which the compiler can vectorize,
+        so the result may differ in the last digits.
+
+        @exception Exception::InvalidRange is thrown if @p coordinate is shorter than @p probability
+      */
+      void update(const probability_container& probability, const coordinate_container& coordinate)
+      {
+        if (coordinate.size() < probability.size())
+        {
+          throw Exception::InvalidRange(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
+        }
+        clear();
+        const RealType* p = probability.data();
+        const RealType* x = coordinate.data();
+        const Size n = probability.size();
+        sum_ = Detail::laneSum(n, [p](Size i) { return double(p[i]); });
+        const double mean = Detail::laneSum(n, [p, x](Size i) { return double(p[i]) * double(x[i]); }) / sum_;
+        mean_ = mean;
+        variance_ = Detail::laneSum(n, [p, x, mean](Size i) { const double diff = double(x[i]) - mean; return double(p[i]) * diff * diff; }) / sum_;
+      }
+
       /// Returns the mean.
       RealType mean() const { return mean_; }
       void setMean(RealType const & mean) { mean_ = mean; }
@@ -151,6 +151,13 @@ public:
           const std::vector<double>& correct_log_density,
           std::vector<double>& incorrect_posterior) const;
 
+      /// same as above for weighted data points (e.g. merged or binned scores); the log-likelihood of each point is multiplied by its weight in @p weights
+      double computeLLAndIncorrectPosteriorsFromLogDensities(
+          const std::vector<double>& incorrect_log_density,
+          const std::vector<double>& correct_log_density,
+          const std::vector<double>& weights,
+          std::vector<double>& incorrect_posterior) const;
+
       /**
        * @param x_scores Scores observed "on the x-axis"
        * @param incorrect_posteriors Posteriors/responsibilities of belonging to the incorrect component
@@ -160,6 +167,11 @@ public:
       std::pair<double, double> pos_neg_mean_weighted_posteriors(const std::vector<double> &x_scores,
                                                                  const std::vector<double> &incorrect_posteriors);
 
+      /// same as above for weighted data points (e.g. merged or binned scores) with weights @p weights
+      std::pair<double, double> pos_neg_mean_weighted_posteriors(const std::vector<double> &x_scores,
+                                                                 const std::vector<double> &incorrect_posteriors,
+                                                                 const std::vector<double> &weights);
+
       /**
        * @param x_scores Scores observed "on the x-axis"
        * @param incorrect_posteriors Posteriors/responsibilities of belonging to the incorrect component
@@ -171,6 +183,12 @@ public:
                                                                  const std::vector<double> &incorrect_posteriors,
                                                                  const std::pair<double, double>& pos_neg_mean);
 
+      /// same as above for weighted data points (e.g. merged or binned scores) with weights @p weights
+      std::pair<double, double> pos_neg_sigma_weighted_posteriors(const std::vector<double> &x_scores,
+                                                                 const std::vector<double> &incorrect_posteriors,
+                                                                 const std::vector<double> &weights,
+                                                                 const std::pair<double, double>& pos_neg_mean);
+
       ///returns estimated parameters for correctly assigned sequences. Fit should be used before.
       GaussFitter::GaussFitResult getCorrectlyAssignedFitResult() const
       {
@@ -236,6 +254,15 @@ private:
       /// transform different score types to a range and score orientation that the model can handle (engine string is assumed in upper-case)
       void processOutliers_(std::vector<double>& x_scores, const String& outlier_handling) const;
 
+      /**
+        @brief Merges the scores into weighted data points for the EM algorithm
+
+        Identical scores are merged into one point weighted by their multiplicity. If @p nr_bins is
+        non-zero and smaller than the number of scores, the scores are instead binned into @p nr_bins
+        equal-width bins, each represented by the mean of its scores (empty bins are omitted).
+      */
+      static void aggregateScores_(const std::vector<double>& x_scores, Size nr_bins, std::vector<double>& values, std::vector<double>& weights);
+
       /// transform different score types to a range and score orientation that the model can handle (engine string is assumed in upper-case)
       /// @param engine the search engine name as in the SE param object
       /// @param hit the PeptideHit to extract transformed scores from
@@ -0,0 +1,120 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg$
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <map>
+
+namespace OpenMS
+{
+  namespace Math
+  {
+    /**
+      @brief Mergeable sketch of a distribution for approximate quantiles in constant memory
+
+      Values are counted in logarithmically spaced bins (DDSketch, Masson et al., VLDB 2019): bin @em i holds the
+      values in (gamma^(i-1), gamma^i] with gamma = (1 + alpha) / (1 - alpha). Every quantile is therefore
+      returned with a relative error of at most alpha (the relative accuracy), independent of the number of values.
+      Negative values are counted in a second set of bins, zeros separately.
+
+      Two sketches with the same relative accuracy can be merged by adding their bin counts. The result is
+      the same as if all values had been added to one sketch, so sketches of single runs can be combined
+      without access to the original values.
+
+      @ingroup Math
+    */
+    class OPENMS_DLLAPI QuantileSketch
+    {
+public:
+      /// Bins: index -> number of values
+      using Bins = std::map<Int, UInt64>;
+
+      /**
+        @brief Constructor
+
+        @param relative_accuracy Maximum relative error of the quantiles (0 < alpha < 1)
+        @exception Exception::InvalidValue if @p relative_accuracy is not in (0, 1)
+      */
+      explicit QuantileSketch(double relative_accuracy = 0.01);
+
+      /**
+        @brief Constructor from the content of a sketch (e.g. loaded from a file)
+
+        @exception Exception::InvalidValue if @p relative_accuracy is not in (0, 1)
+      */
+      QuantileSketch(double relative_accuracy, const Bins& positive, const Bins& negative, UInt64 zero_count, double min, double max);
+
+      /// Equality operator
+      bool operator==(const QuantileSketch& rhs) const;
+
+      /// Adds @p value @p count times
+      void add(double value, UInt64 count = 1);
+
+      /**
+        @brief Adds all values of @p other
+
+        @exception Exception::IllegalArgument if the relative accuracies differ
+      */
+      void merge(const QuantileSketch& other);
+
+      /**
+        @brief The (approximate) @p q quantile, e.g. 0.5 for the median
+
+        The result is within the relative accuracy of the exact quantile (the value at rank q * (n - 1) of the
+        sorted values) and within [getMin(), getMax()].
+
+        @exception Exception::InvalidValue if @p q is not in [0, 1]
+        @exception Exception::Precondition if the sketch is empty
+      */
+      double getQuantile(double q) const;
+
+      /// Number of values
+      UInt64 getCount() const;
+
+      /// No values added?
+      bool empty() const;
+
+      /// Smallest value (0 if empty)
+      double getMin() const;
+
+      /// Largest value (0 if empty)
+      double getMax() const;
+
+      /// The relative accuracy given at construction
+      double getRelativeAccuracy() const;
+
+      /// Bins of the positive values
+      const Bins& getPositiveBins() const;
+
+      /// Bins of the negative values (by index of their absolute value)
+      const Bins& getNegativeBins() const;
+
+      /// Number of zeros
+      UInt64 getZeroCount() const;
+
+protected:
+      /// Bin index of a positive value
+      Int index_(double value) const;
+
+      /// Representative value of bin @p index (with at most relative_accuracy_ error for all values of the bin)
+      double value_(Int index) const;
+
+      double relative_accuracy_;
+      double gamma_;
+      double log_gamma_;
+      Bins positive_;
+      Bins negative_;
+      UInt64 zero_count_ = 0;
+      UInt64 count_ = 0;
+      double min_ = 0.0;
+      double max_ = 0.0;
+    };
+  } // namespace Math
+} // namespace OpenMS
@@ -15,6 +15,7 @@
 #include <cmath>
 #include <iterator>
 #include <numeric>
+#include <utility>
 
 namespace OpenMS
 {
@@ -641,6 +642,259 @@ namespace OpenMS
       return sum_model_data / (std::sqrt(sqsum_data) * std::sqrt(sqsum_model));
     }
 
+    /**
+      @name Overloads for contiguous data
+
+      The following overloads take a std::vector instead of an iterator range.
+      Their reductions use independent partial sums, which the compiler can
+      vectorize (a single running sum cannot be reordered without -ffast-math),
+      so results may differ in the last digits from the iterator versions.
+      The order statistics (median and quantiles) select instead of sorting
+      and take their input by value: pass an rvalue if the data is not needed
+      any more.
+    */
+    ///@{
+
+    namespace Detail
+    {
+      /// Sum of @p f(0), ..., @p f(n - 1) in four partial sums
+      template <typename Function>
+      inline double laneSum(Size n, const Function& f)
+      {
+        double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+        Size i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+          s0 += f(i);
+          s1 += f(i + 1);
+          s2 += f(i + 2);
+          s3 += f(i + 3);
+        }
+        for (; i < n; ++i)
+        {
+          s0 += f(i);
+        }
+        return (s0 + s1) + (s2 + s3);
+      }
+
+      /// Median of the unsorted range [@p begin, @p end) by selection; reorders the range
+      template <typename IteratorType>
+      double selectMedian(IteratorType begin, IteratorType end)
+      {
+        checkIteratorsNotNULL(begin, end);
+        const Size size = std::distance(begin, end);
+        IteratorType upper = begin + size / 2;
+        std::nth_element(begin, upper, end);
+        if (size % 2 == 0) // even size => average two middle values
+        {
+          // the lower middle value is the largest value before the upper one
+          return (*std::max_element(begin, upper) + *upper) / 2.0;
+        }
+        return *upper;
+      }
+    }
+
+    /**
+       @brief Calculates the sum of the values
+
+       @ingroup MathFunctionsStatistics
+    */
+    template <typename T>
+    static double sum(const std::vector<T>& values)
+    {
+      const T* x = values.data();
+      return Detail::laneSum(values.size(), [x](Size i) { return double(x[i]); });
+    }
+
+    /**
+       @brief Calculates the mean of the values
+
+       @exception Exception::InvalidRange is thrown if @p values is empty
+
+       @ingroup MathFunctionsStatistics
+    */
+    template <typename T>
+    static double mean(const std::vector<T>& values)
+    {
+      checkIteratorsNotNULL(values.begin(), values.end());
+      return sum(values) / values.size();
+    }
+
+    /**
+       @brief Calculates the mean and the (sample) variance of the values in a single pass
+
+       Sums up the values and their squares after subtracting the first value
+       (which keeps the cancellation of the variance formula small).
+
+       @return The pair (mean, variance); the variance is 'nan' for a single value (as variance())
+
+       @exception Exception::InvalidRange is thrown if @p values is empty
+
+       @ingroup MathFunctionsStatistics
+    */
+    template <typename T>
+    static std::pair<double, double> meanAndVariance(const std::vector<T>& values)
+    {
+      checkIteratorsNotNULL(values.begin(), values.end());
+      const T* x = values.data();
+      const Size n = values.size();
+      const double shift = x[0];
+      double s[4] = {0.0, 0.0, 0.0, 0.0};
+      double sq[4] = {0.0, 0.0, 0.0, 0.0};
+      Size i = 0;
+      for (; i + 4 <= n; i += 4)
+      {
+        for (Size k = 0; k < 4; ++k)
+        {
+          const double d = x[i + k] - shift;
+          s[k] += d;
+          sq[k] += d * d;
+        }
+      }
+      for (; i < n; ++i)
+      {
+        const double d = x[i] - shift;
+        s[0] += d;
+        sq[0] += d * d;
+      }
+      const double sum_d = (s[0] + s[1]) + (s[2] + s[3]);
+      const double sum_sq = (sq[0] + sq[1]) + (sq[2] + sq[3]);
+      return {shift + sum_d / n, std::max(0.0, sum_sq - sum_d * sum_d / n) / (n - 1.0)};
+    }
+
+    /**
+       @brief Calculates the (sample) variance of the values
+
+       @exception Exception::InvalidRange is thrown if @p values is empty
+
+       @ingroup MathFunctionsStatistics
+    */
+    template <typename T>
+    static double variance(const std::vector<T>& values)
+    {
+      return meanAndVariance(values).second;
+    }
+
+    /**
+       @brief Calculates the (sample) standard deviation of the values
+
+       @exception Exception::InvalidRange is thrown if @p values is empty
+
+       @ingroup MathFunctionsStatistics
+    */
+    template <typename T>
+    static double sd(const std::vector<T>& values)
+    {
+      return std::sqrt(variance(values));
+    }
+
+    /**
+       @brief Calculates the median of the values (in linear time, by selection)
+
+       The result is identical to median(begin, end).
+
+       @exception Exception::InvalidRange is thrown if @p values is empty
+
+       @ingroup MathFunctionsStatistics
+    */
+    template <typename T>
+    static double median(std::vector<T> values)
+    {
+      return Detail::selectMedian(values.begin(), values.end());
+    }
+
+    /**
+       @brief Calculates the first quantile of the values (in linear time, by selection)
+
+       The result is identical to quantile1st(begin, end).
+
+       @exception Exception::InvalidRange is thrown if there are less than three values
+
+       @ingroup MathFunctionsStatistics
+    */
+    template <typename T>
+    static double quantile1st(std::vector<T> values)
+    {
+      checkIteratorsNotNULL(values.begin(), values.end());
+      const Size size = values.size();
+      // the median of the lower half (without the median values)
+      typename std::vector<T>::iterator half_end = values.begin() + (size % 2 == 0 ? size / 2 - 1 : size / 2);
+      std::nth_element(values.begin(), half_end, values.end());
+      return Detail::selectMedian(values.begin(), half_end);
+    }
+
+    /**
+       @brief Calculates the third quantile of the values (in linear time, by selection)
+
+       The result is identical to quantile3rd(begin, end).
+
+       @exception Exception::InvalidRange is thrown if there are less than three values
+
+       @ingroup MathFunctionsStatistics
+    */
+    template <typename T>
+    static double quantile3rd(std::vector<T> values)
+    {
+      checkIteratorsNotNULL(values.begin(), values.end());
+      // the median of the upper half (without the median values)
+      typename std::vector<T>::iterator half_begin = values.begin() + (values.size() / 2 + 1);
+      std::nth_element(values.begin(), half_begin, values.end());
+      return Detail::selectMedian(half_begin, values.end());
+    }
+
+    /**
+       @brief Calculates the Pearson correlation coefficient of the values in @p a and @p b
+
+       If one of them contains only the same values 'nan' is returned.
+
+       @exception Exception::InvalidRange is thrown if @p a and @p b are not of the same length or empty.
+
+       @ingroup MathFunctionsStatistics
+    */
+    template <typename T1, typename T2>
+    static double pearsonCorrelationCoefficient(const std::vector<T1>& a, const std::vector<T2>& b)
+    {
+      checkIteratorsNotNULL(a.begin(), a.end());
+      if (a.size() != b.size())
+      {
+        throw Exception::InvalidRange(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
+      }
+      const T1* x = a.data();
+      const T2* y = b.data();
+      const Size n = a.size();
+      const double avg_a = sum(a) / n;
+      const double avg_b = sum(b) / n;
+
+      double num[4] = {0.0, 0.0, 0.0, 0.0};
+      double den_a[4] = {0.0, 0.0, 0.0, 0.0};
+      double den_b[4] = {0.0, 0.0, 0.0, 0.0};
+      Size i = 0;
+      for (; i + 4 <= n; i += 4)
+      {
+        for (Size k = 0; k < 4; ++k)
+        {
+          const double temp_a = x[i + k] - avg_a;
+          const double temp_b = y[i + k] - avg_b;
+          num[k] += temp_a * temp_b;
+          den_a[k] += temp_a * temp_a;
+          den_b[k] += temp_b * temp_b;
+        }
+      }
+      for (; i < n; ++i)
+      {
+        const double temp_a = x[i] - avg_a;
+        const double temp_b = y[i] - avg_b;
+        num[0] += temp_a * temp_b;
+        den_a[0] += temp_a * temp_a;
+        den_b[0] += temp_b * temp_b;
+      }
+      const double numerator = (num[0] + num[1]) + (num[2] + num[3]);
+      const double denominator_a = (den_a[0] + den_a[1]) + (den_a[2] + den_a[3]);
+      const double denominator_b = (den_b[0] + den_b[1]) + (den_b[2] + den_b[3]);
+      return numerator / std::sqrt(denominator_a * denominator_b);
+    }
+    ///@}
+
     /// Helper class to gather (and dump) some statistics from a e.g. vector<double>.
     template<typename T>
     struct SummaryStatistics
@@ -0,0 +1,261 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/DATASTRUCTURES/DataValue.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/METADATA/MetaInfoInterface.h>
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Column-oriented storage of the meta values of a collection of objects
+
+    Every object deriving from MetaInfoInterface owns a separate MetaInfo
+    (a map of DataValue) on the heap. For large collections with the same keys
+    on every element (e.g. the PeptideHit objects of an idXML file with
+    Percolator features, or the features of a FeatureMap) this is a lot of
+    memory. This class stores the meta values of a collection in one column per
+    key and row per element instead:
+
+    - double and integer values are stored in plain typed vectors,
+    - string values are dictionary encoded (each distinct string is stored once),
+    - all other values (lists, values with units, keys with mixed types) are
+      stored as DataValue.
+
+    Use compact() to move the meta values of a container into the store (the
+    MetaInfo of each element is freed) and expand() to write them back. While
+    compacted, the values can be accessed per row with the usual
+    MetaInfoInterface methods (getMetaValue(), setMetaValue(), ...) which take
+    the row index as additional first argument.
+
+    @code
+    MetaValueColumns columns;
+    columns.compact(hits); // e.g. std::vector<PeptideHit>
+    double score = columns.getMetaValue(0, "MS:1001492");
+    ...
+    columns.expand(hits);
+    @endcode
+
+    @ingroup Metadata
+  */
+  class OPENMS_DLLAPI MetaValueColumns
+  {
+public:
+    /// Storage type of a column
+    enum class ColumnType : unsigned char
+    {
+      DOUBLE, ///< double values
+      INT, ///< integer values
+      STRING, ///< dictionary encoded string values
+      GENERIC ///< any DataValue
+    };
+
+    /// Default constructor
+    MetaValueColumns() = default;
+
+    /// Constructor for @p rows empty rows
+    explicit MetaValueColumns(Size rows);
+
+    /// Equality operator (compares keys, types and values of all rows)
+    bool operator==(const MetaValueColumns& rhs) const;
+
+    /// Equality operator
+    bool operator!=(const MetaValueColumns& rhs) const;
+
+    /// Number of rows
+    Size size() const
+    {
+      return rows_;
+    }
+
+    /// Sets the number of rows (new rows have no values)
+    void resize(Size rows);
+
+    /// Removes all rows and columns
+    void clear();
+
+    /**
+      @brief Moves the meta values of all elements of @p objects into the store
+
+      The store is resized to the size of @p objects (previous content is
+      removed) and row i holds the meta values of element i. Afterwards, the
+      meta information of all elements is cleared.
+
+      @tparam Container A container (e.g. std::vector or FeatureMap) of objects implementing MetaInfoInterface
+    */
+    template <typename Container>
+    void compact(Container& objects)
+    {
+      clear();
+      resize(objects.size());
+      std::vector<UInt> keys;
+      Size row = 0;
+      for (auto& object : objects)
+      {
+        object.getKeys(keys);
+        for (UInt key : keys)
+        {
+          setMetaValue(row, key, object.getMetaValue(key));
+        }
+        object.clearMetaInfo();
+        ++row;
+      }
+    }
+
+    /**
+      @brief Writes the meta values of row i back into element i of @p objects
+
+      Existing meta values of the elements are kept (or overwritten for keys
+      present in the store). The store itself is not changed.
+
+      @exception Exception::InvalidSize is thrown if the size of @p objects differs from size()
+    */
+    template <typename Container>
+    void expand(Container& objects) const
+    {
+      if (objects.size() != rows_)
+      {
+        throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, objects.size());
+      }
+      for (const auto& [key, column] : columns_)
+      {
+        Size row = 0;
+        for (auto& object : objects)
+        {
+          if (column.present[row])
+          {
+            object.setMetaValue(key, getValue_(column, row));
+          }
+          ++row;
+        }
+      }
+    }
+
+    /// @name MetaInfoInterface methods for a single row
+    //@{
+    /**
+      @brief Returns the value of @p row for key @p name, or @p default_value if not set
+
+      @exception Exception::IndexOverflow is thrown if @p row is not smaller than size()
+    */
+    DataValue getMetaValue(Size row, const String& name, const DataValue& default_value = DataValue::EMPTY) const;
+
+    /// Returns the value of @p row for the key with index @p index, or @p default_value if not set
+    DataValue getMetaValue(Size row, UInt index, const DataValue& default_value = DataValue::EMPTY) const;
+
+    /// Returns whether @p row has a value for key @p name
+    bool metaValueExists(Size row, const String& name) const;
+
+    /// Returns whether @p row has a value for the key with index @p index
+    bool metaValueExists(Size row, UInt index) const;
+
+    /**
+      @brief Sets the value of @p row for key @p name
+
+      Setting an empty DataValue removes the value.
+
+      @exception Exception::IndexOverflow is thrown if @p row is not smaller than size()
+    */
+    void setMetaValue(Size row, const String& name, const DataValue& value);
+
+    /// Sets the value of @p row for the key with index @p index
+    void setMetaValue(Size row, UInt index, const DataValue& value);
+
+    /// Removes the value of @p row for key @p name if it exists
+    void removeMetaValue(Size row, const String& name);
+
+    /// Removes the value of @p row for the key with index @p index if it exists
+    void removeMetaValue(Size row, UInt index);
+
+    /// Fills @p keys with the names of all keys for which @p row has a value
+    void getKeys(Size row, std::vector<String>& keys) const;
+
+    /// Fills @p keys with the indices of all keys for which @p row has a value
+    void getKeys(Size row, std::vector<UInt>& keys) const;
+    //@}
+
+    /// @name Column access
+    //@{
+    /// Returns the names of all keys with a column
+    std::vector<String> getColumnNames() const;
+
+    /// Returns whether a column for @p name exists
+    bool hasColumn(const String& name) const;
+
+    /**
+      @brief Returns the storage type of the column for @p name
+
+      @exception Exception::ElementNotFound is thrown if there is no such column
+    */
+    ColumnType getColumnType(const String& name) const;
+
+    /**
+      @brief Copies the column for @p name into @p values as doubles (one value per row)
+
+      Rows without a value are set to @p missing.
+
+      @exception Exception::ElementNotFound is thrown if there is no such column
+      @exception Exception::ConversionError is thrown if the column holds values which are neither double nor integer
+    */
+    void getDoubleColumn(const String& name, std::vector<double>& values, double missing = 0.0) const;
+    //@}
+
+protected:
+    /// Values of one key for all rows
+    struct Column
+    {
+      ColumnType type = ColumnType::DOUBLE;
+      /// whether a row has a value
+      std::vector<bool> present;
+      /// values of DOUBLE columns
+      std::vector<double> doubles;
+      /// values of INT columns
+      std::vector<SignedSize> ints;
+      /// dictionary codes of STRING columns
+      std::vector<UInt> codes;
+      /// distinct strings of STRING columns
+      std::vector<String> dictionary;
+      /// lookup from string to dictionary code (STRING columns)
+      std::unordered_map<std::string, UInt> lookup;
+      /// values of GENERIC columns
+      std::vector<DataValue> values;
+    };
+
+    /// Returns the column for @p index or nullptr
+    const Column* findColumn_(UInt index) const;
+
+    /// Returns the value of @p row (which must be present)
+    static DataValue getValue_(const Column& column, Size row);
+
+    /// Stores @p value (not empty) in @p row of @p column, converting the column to GENERIC if needed
+    static void setValue_(Column& column, Size row, const DataValue& value);
+
+    /// Resizes all value vectors of @p column to @p rows
+    static void resizeColumn_(Column& column, Size rows);
+
+    /// Converts @p column to GENERIC storage
+    static void makeGeneric_(Column& column);
+
+    /// Throws Exception::IndexOverflow if @p row is out of range
+    void checkRow_(Size row) const;
+
+    /// number of rows
+    Size rows_ = 0;
+
+    /// columns by meta info registry index (ordered for deterministic iteration)
+    std::map<UInt, Column> columns_;
+  };
+
+} // namespace OpenMS
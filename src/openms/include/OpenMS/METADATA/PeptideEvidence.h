@@ -9,6 +9,7 @@
 #pragma once
 
 #include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/InternedString.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
 
 namespace OpenMS
@@ -98,7 +99,7 @@ public:
     char getAAAfter() const;
 
 protected:
-    String accession_;
+    InternedString accession_;
 
     Int start_;
 
@@ -16,6 +16,7 @@
 
 #include <OpenMS/CHEMISTRY/ResidueModification.h>
 #include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/InternedString.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
 #include <OpenMS/METADATA/MetaInfoInterface.h>
 
@@ -182,7 +183,7 @@ public:
 protected:
     double score_;       ///< the score of the protein hit
     UInt rank_;          ///< the position(rank) where the hit appeared in the hit list
-    String accession_;   ///< the protein identifier
+    InternedString accession_; ///< the protein identifier
     String sequence_;    ///< the amino acid sequence of the protein hit
     double coverage_;    ///< coverage of the protein based upon the matched peptide sequences
     std::set<std::pair<Size, ResidueModification> > modifications_; ///< modified positions in a protein
@@ -15,6 +15,8 @@
 
 namespace OpenMS
 {
+  class OffsetIndexFile;
+
   /**
     @brief Helper class for looking up spectra based on different attributes
 
@@ -99,6 +101,19 @@ namespace OpenMS
       }
     }
 
+    /**
+       @brief Read and index the spectra of an offset index for later look-up
+
+       Like readSpectra() for a spectrum container, but uses the native IDs and
+       retention times recorded in an OffsetIndexFile, so the spectra of a
+       file can be looked up without loading them. Indices refer to the
+       position in OffsetIndexFile::getSpectra().
+
+       @throw Exception::IllegalArgument if @p scan_regexp does not contain "?<SCAN>" (and is not empty)
+    */
+    void readSpectra(const OffsetIndexFile& index,
+                     const String& scan_regexp = default_scan_regexp);
+
     /**
        @brief Look up spectrum by retention time (RT).
 
@@ -29,6 +29,7 @@ MetaInfoDescription.h
 MetaInfoInterface.h
 MetaInfoInterfaceUtils.h
 MetaInfoRegistry.h
+MetaValueColumns.h
 Modification.h
 PeptideEvidence.h
 PeptideHit.h
@@ -12,6 +12,7 @@
 #include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/ML/CLUSTERING/ClusterAnalyzer.h>
 
+#include <functional>
 #include <vector>
 
 namespace OpenMS
@@ -44,6 +45,14 @@ public:
     };
 
 
+    /// Distance of a pair of elements (e.g. one entry of sparse distance input)
+    struct OPENMS_DLLAPI PairDistance
+    {
+      Size i;
+      Size j;
+      float distance;
+    };
+
     /// default constructor
     ClusterFunctor();
 
@@ -70,7 +79,58 @@ public:
     */
     virtual void operator()(DistanceMatrix<float> & original_distance, std::vector<BinaryTreeNode> & cluster_tree, const float threshold = 1) const = 0;
 
+    /**
+        @brief clusters @p n elements given only the distances of some pairs
+
+        Pairs not contained in @p distances are considered to be at least @p threshold apart; typically @p distances
+        only contains the pairs closer than @p threshold (see ClusterHierarchical::clusterSparse).
+        The default implementation fills a DistanceMatrix (missing distances set to @p threshold) and calls the dense
+        operator(). This is exact for single and complete linkage; for average linkage, missing distances enter the averages as @p threshold.
+        Subclasses may provide implementations that do not need quadratic memory (e.g. SingleLinkage).
+
+        @param n number of elements
+        @param distances distances of element pairs (i != j, both < @p n), may be reordered
+        @param cluster_tree see above
+        @param threshold see above
+        @throw ClusterFunctor::InsufficientInput thrown if @p n < 2
+        @throw Exception::IndexOverflow if an element index is not below @p n
+    */
+    virtual void operator()(Size n, std::vector<PairDistance> & distances, std::vector<BinaryTreeNode> & cluster_tree, const float threshold = 1) const;
+
+protected:
+
+    /**
+        @brief Lance-Williams update: distance of the union of clusters @e i and @e j to cluster @e k
+
+        Parameters: d(i,k), d(j,k), size of @e i, size of @e j, size of @e k
+    */
+    typedef std::function<float(float, float, Size, Size, Size)> LinkageUpdate;
 
+    /**
+        @brief merges all clusters with the nearest-neighbor chain algorithm
+
+        Needs O(n^2) time and (besides @p distance) O(n) memory. Produces the same merges as always merging the globally
+        closest pair for all linkages that satisfy the reducibility property (single, complete, average, ...).
+
+        @param distance distances of the elements; will be changed
+        @param update Lance-Williams update rule of the linkage
+        @param merges output: the merges (in no particular order), each identified by one element of either cluster
+    */
+    static void nearestNeighborChain_(DistanceMatrix<float> & distance, const LinkageUpdate & update, std::vector<PairDistance> & merges);
+
+    /**
+        @brief builds the cluster tree from merges given in any order
+
+        Merges are sorted by distance and applied in order; merges within one cluster are skipped. Every node names its
+        clusters by their smallest element. Merges with a distance of at least @p threshold are not applied;
+        the tree is instead filled with dummy nodes (distance -1) connecting the cluster of element 0 to all others.
+
+        @param n number of elements
+        @param merges merges of elements or clusters (sorted by this function)
+        @param cluster_tree output
+        @param threshold merge limit
+    */
+    static void buildTree_(Size n, std::vector<PairDistance> & merges, std::vector<BinaryTreeNode> & cluster_tree, float threshold);
 
   };
 
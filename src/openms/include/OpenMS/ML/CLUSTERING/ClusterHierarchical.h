@@ -22,6 +22,7 @@
 #include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/DATASTRUCTURES/DistanceMatrix.h>
 #include <OpenMS/KERNEL/StandardTypes.h>
+#include <exception>
 #include <vector>
 
 namespace OpenMS
@@ -62,6 +63,7 @@ public:
 
       Creates a DistanceMatrix (if an empty matrix is passed) and the clustering is started.
       Clustering stops if the ClusterHierarchical::threshold_ is reached by the ClusterFunctor.
+      The distances are computed in parallel, so @p comparator must be thread-safe (const operator()).
 
       First template parameter is the cluster object type,
       Second template parameter is the similarity functor applicable to the type.
@@ -92,14 +94,12 @@ public:
       // create distance matrix for data using comparator
       original_distance.clear();
       original_distance.resize(data.size(), 1);
-      for (Size i = 0; i < data.size(); i++)
+      forAllPairs_(data.size(), [&](Size i, Size j)
       {
-        for (Size j = 0; j < i; j++)
-        {
-          // distance value is 1-similarity value, since similarity is in range of [0,1]
-          original_distance.setValueQuick(i, j, 1 - comparator(data[i], data[j]));
-        }
-      }
+        // distance value is 1-similarity value, since similarity is in range of [0,1]
+        original_distance.setValueQuick(i, j, 1 - comparator(data[i], data[j]));
+      });
+      original_distance.updateMinElement();
     }
 
     // create clustering with ClusterMethod, DistanceMatrix and Data
@@ -149,19 +149,62 @@ public:
     original_distance.clear();
     original_distance.resize(data.size(), 1);
 
-    for (Size i = 0; i < binned_data.size(); i++)
+    forAllPairs_(binned_data.size(), [&](Size i, Size j)
     {
-      for (Size j = 0; j < i; j++)
-      {
-        // distance value is 1-similarity value, since similarity is in range of [0,1]
-        original_distance.setValue(i, j, 1 - comparator(binned_data[i], binned_data[j]));
-      }
-    }
+      // distance value is 1-similarity value, since similarity is in range of [0,1]
+      original_distance.setValueQuick(i, j, 1 - comparator(binned_data[i], binned_data[j]));
+    });
+    original_distance.updateMinElement();
 
     // create Clustering with ClusterMethod, DistanceMatrix and Data
     clusterer(original_distance, cluster_tree, threshold_);
   }
 
+  /**
+      @brief Clustering function for large data: only distances below the threshold are kept
+
+      Like cluster(), but no DistanceMatrix is created: distances are computed (in parallel) only for pairs accepted by
+      @p is_candidate, and only those closer than ClusterHierarchical::threshold_ are passed on to the sparse
+      interface of @p clusterer. All other pairs are considered too far apart to be merged. With a cheap candidate test
+      (e.g. precursor m/z or RT tolerance) this needs memory linear in the number of close pairs instead of quadratic
+      in the number of elements; SingleLinkage then needs O(n) additional memory.
+
+      @param data Values to be clustered
+      @param comparator Similarity functor (thread-safe) which returns a similarity in [0, 1] for any pair of values in @p data
+      @param is_candidate Predicate (thread-safe) for two elements of @p data; the similarity is only computed if it returns true
+      @param clusterer A cluster method implementation, e.g. SingleLinkage or CompleteLinkage. See base class ClusterFunctor.
+      @param cluster_tree The vector that will hold the BinaryTreeNodes representing the clustering
+
+      @see ClusterFunctor::operator()(Size, std::vector<ClusterFunctor::PairDistance>&, std::vector<BinaryTreeNode>&, const float) const
+  */
+  template<typename Data, typename SimilarityComparator, typename CandidatePredicate>
+  void clusterSparse(const std::vector<Data>& data,
+                     const SimilarityComparator& comparator,
+                     const CandidatePredicate& is_candidate,
+                     const ClusterFunctor& clusterer,
+                     std::vector<BinaryTreeNode>& cluster_tree) const
+  {
+    // each row is handled by one thread
+    std::vector<std::vector<ClusterFunctor::PairDistance>> rows(data.size());
+    forAllPairs_(data.size(), [&](Size i, Size j)
+    {
+      if (!is_candidate(data[i], data[j])) return;
+      // distance value is 1-similarity value, since similarity is in range of [0,1]
+      float distance = 1 - comparator(data[i], data[j]);
+      if (distance < threshold_)
+      {
+        rows[i].push_back({i, j, distance});
+      }
+    });
+    std::vector<ClusterFunctor::PairDistance> distances;
+    for (std::vector<ClusterFunctor::PairDistance>& row : rows)
+    {
+      distances.insert(distances.end(), row.begin(), row.end());
+      std::vector<ClusterFunctor::PairDistance>().swap(row);
+    }
+    clusterer(data.size(), distances, cluster_tree, threshold_);
+  }
+
   /// get the threshold
   double getThreshold() const
   {
@@ -175,6 +218,38 @@ public:
   {
     threshold_ = x;
   }
+
+protected:
+  /**
+      @brief calls @p function(i, j) for all pairs j < i < @p n, distributing the rows over threads
+
+      @param n number of elements
+      @param function called for each pair; must be thread-safe for distinct rows @e i
+
+      Exceptions thrown by @p function are passed on (the first one).
+  */
+  template<typename Function>
+  static void forAllPairs_(Size n, const Function& function)
+  {
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < SignedSize(n); i++)
+    {
+      try
+      {
+        for (Size j = 0; j < Size(i); j++)
+        {
+          function(Size(i), j);
+        }
+      }
+      catch (...)
+      {
+#pragma omp critical (ClusterHierarchical_forAllPairs)
+        if (!error) error = std::current_exception();
+      }
+    }
+    if (error) std::rethrow_exception(error);
+  }
 };
 
 /** @brief Exception thrown if clustering is attempted without a normalized compare functor
@@ -13,6 +13,7 @@
 #include <OpenMS/CONCEPT/Types.h>
 #include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/CONCEPT/Macros.h>
+#include <OpenMS/ML/CLUSTERING/OpenHashGrid.h>
 
 #include <map>
 #include <vector>
@@ -114,6 +115,20 @@ class OPENMS_DLLAPI ClusteringGrid
     */
     int getCellCount() const;
 
+    /**
+    * @brief calls @p f for all clusters in this grid cell and its 8 neighbouring cells
+    *
+    * Cells are visited row by row (i-1,j-1), (i-1,j), ..., (i+1,j+1), clusters of a cell in the order they were added.
+    *
+    * @param cell_index    cell index (i,j) on the grid
+    * @param f    functor called as f(int cluster_index)
+    */
+    template <typename Functor>
+    void forEachClusterInNeighbourhood(const CellIndex &cell_index, Functor&& f) const
+    {
+      cells_.forEachNeighbor(OpenHashGrid<int>::CellIndex(cell_index.first, cell_index.second), f);
+    }
+
     private:
     /**
     * @brief spacing of the grid in x and y direction
@@ -128,9 +143,9 @@ class OPENMS_DLLAPI ClusteringGrid
     std::pair <double,double> range_y_;  
 
     /**
-    * @brief grid cell index mapped to a list of clusters in it
+    * @brief grid cell index mapped to the clusters in it
     */
-    std::map<CellIndex, std::list<int> > cells_;
+    OpenHashGrid<int> cells_;
 
 };
 
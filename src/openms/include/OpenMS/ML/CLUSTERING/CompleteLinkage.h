@@ -63,6 +63,9 @@ public:
   */
   void operator()(DistanceMatrix<float>& original_distance, std::vector<BinaryTreeNode>& cluster_tree, const float threshold = 1) const override;
 
+  /// sparse input, see ClusterFunctor
+  using ClusterFunctor::operator();
+
 };
 
 } // namespace OpenMS
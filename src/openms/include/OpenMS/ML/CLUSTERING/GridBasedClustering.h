@@ -12,10 +12,12 @@
 #include <OpenMS/DATASTRUCTURES/DRange.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/DATASTRUCTURES/DAryHeap.h>
 #include <OpenMS/ML/CLUSTERING/ClusteringGrid.h>
 #include <OpenMS/ML/CLUSTERING/GridBasedCluster.h>
 
 #include <cmath>
+#include <exception>
 #include <limits>
 #include <map>
 #include <set>
@@ -94,6 +96,10 @@ private:
   * Each data point can have two additional properties A and B.
   * In each cluster all properties A need to be the same,
   * all properties B different.
+  *
+  * Since clusters only interact with clusters in the neighbouring cells,
+  * clusterParallel() can solve regions of the grid that are separated by
+  * empty columns of cells independently and in parallel.
   */
   template <typename Metric>
   class GridBasedClustering :
@@ -106,8 +112,6 @@ public:
     typedef GridBasedCluster::Point Point; // DPosition<2>
     typedef GridBasedCluster::Rectangle Rectangle; // DBoundingBox<2>
     typedef ClusteringGrid::CellIndex CellIndex; // std::pair<int,int>
-    typedef std::multiset<MinimumDistance>::const_iterator MultisetIterator;
-    typedef std::unordered_multimap<int, MultisetIterator>::const_iterator NNIterator;
 
     /**
      * @brief initialises all data structures
@@ -163,19 +167,22 @@ public:
       Size clusters_start = clusters_.size();
       startProgress(0, clusters_start, OpenMS::String("clustering"));
 
-      MinimumDistance zero_distance(-1, -1, 0);
-
       // combine clusters until all have been moved to the final list
       while (!clusters_.empty())
       {
         setProgress(clusters_start - clusters_.size());
 
-        MultisetIterator smallest_distance_it = distances_.lower_bound(zero_distance);
+        // skip distances that are out of date (lazy invalidation)
+        while (!isCurrent_(distances_.top()))
+        {
+          distances_.pop();
+        }
 
-        int cluster_index1 = smallest_distance_it->getClusterIndex();
-        int cluster_index2 = smallest_distance_it->getNearestNeighbourIndex();
+        int cluster_index1 = distances_.top().cluster_index;
+        int cluster_index2 = distances_.top().nearest_neighbour_index;
 
-        eraseMinDistance_(smallest_distance_it);
+        distances_.pop();
+        nearest_neighbours_.erase(cluster_index1);
 
         // update cluster list
         std::map<int, GridBasedCluster>::iterator cluster1_it = clusters_.find(cluster_index1);
@@ -231,23 +238,13 @@ public:
         std::set<int> clusters_to_be_updated;
         clusters_to_be_updated.insert(cluster_index1);
 
-        // erase distance object of cluster with cluster_index2 without updating (does not exist anymore!)
-        // (the one with cluster_index1 has already been erased at the top of the while loop)
-        eraseMinDistance_(distance_it_for_cluster_idx_[cluster_index2]);
+        // invalidate distance of cluster with cluster_index2 without updating (does not exist anymore!)
+        // (the one with cluster_index1 has already been invalidated at the top of the while loop)
+        nearest_neighbours_.erase(cluster_index2);
 
         // find out which clusters need to be updated
-        std::pair<NNIterator, NNIterator> nn_range = reverse_nns_.equal_range(cluster_index1);
-        for (NNIterator nn_it = nn_range.first; nn_it != nn_range.second;)
-        {
-          clusters_to_be_updated.insert(nn_it->second->getClusterIndex());
-          eraseMinDistance_((nn_it++)->second);
-        }
-        nn_range = reverse_nns_.equal_range(cluster_index2);
-        for (NNIterator nn_it = nn_range.first; nn_it != nn_range.second;)
-        {
-          clusters_to_be_updated.insert(nn_it->second->getClusterIndex());
-          eraseMinDistance_((nn_it++)->second);
-        }
+        collectReverseNearestNeighbours_(cluster_index1, clusters_to_be_updated);
+        collectReverseNearestNeighbours_(cluster_index2, clusters_to_be_updated);
 
         // update clusters
         for (std::set<int>::const_iterator cluster_index = clusters_to_be_updated.begin(); cluster_index != clusters_to_be_updated.end(); ++cluster_index)
@@ -265,6 +262,160 @@ public:
       endProgress();
     }
 
+    /**
+     * @brief performs the hierarchical clustering like cluster(), but on independent regions of the grid in parallel
+     *
+     * The grid is split into regions of adjacent columns (cells in x-direction) at empty columns. Clusters
+     * in two such regions are never neighbours (a merged cluster lies between its parts), so the regions
+     * are clustered independently and the result is the same as that of cluster().
+     *
+     * Regions without empty columns that contain more than @p max_region_size clusters are cut between two
+     * columns as well. Clusters that end up next to such a cut are stitched afterwards, i.e. clustered
+     * again together with the clusters on the other side of the cut. This result can differ slightly
+     * from cluster() (clusters next to a cut can no longer merge with clusters further inside), hence
+     * only use it when single dense regions dominate the run time.
+     *
+     * @param max_region_size    maximal number of clusters in a region that is not separated by empty columns
+     */
+    void clusterParallel(Size max_region_size = std::numeric_limits<Size>::max())
+    {
+      // sort the clusters by column
+      std::vector<std::pair<int, int> > columns; // (column, cluster index)
+      columns.reserve(clusters_.size());
+      for (const std::pair<const int, GridBasedCluster>& c : clusters_)
+      {
+        columns.emplace_back(grid_.getIndex(c.second.getCentre()).first, c.first);
+      }
+      std::sort(columns.begin(), columns.end());
+
+      // split into regions (at most about 64 of them are needed for parallelism)
+      const Size target_size = std::max(Size(256), columns.size() / 64);
+      std::vector<std::vector<int> > regions;
+      std::vector<Size> cuts; // regions r and r + 1 are separated by a cut without empty column
+      std::vector<int> cut_columns; // last column left of such a cut
+      int region_begin = 0; // first column of the current region
+      for (Size i = 0; i < columns.size(); ++i)
+      {
+        const int current = columns[i].first;
+        if (i == 0)
+        {
+          regions.emplace_back();
+          region_begin = current;
+        }
+        else
+        {
+          const Size region_size = regions.back().size();
+          const int previous = columns[i - 1].first;
+          if (current > previous + 1 && region_size >= target_size)
+          {
+            regions.emplace_back();
+            region_begin = current;
+          }
+          // cut a large region between two columns (not right after its first column, so that the clusters
+          // to stitch at different cuts never overlap)
+          else if (current == previous + 1 && region_size >= max_region_size && previous > region_begin)
+          {
+            cuts.push_back(regions.size() - 1);
+            cut_columns.push_back(previous);
+            regions.emplace_back();
+            region_begin = current;
+          }
+        }
+        regions.back().push_back(columns[i].second);
+      }
+
+      // cluster the regions
+      std::vector<std::map<int, GridBasedCluster> > region_results(regions.size());
+      std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize r = 0; r < (SignedSize)regions.size(); ++r)
+      {
+        try
+        {
+          std::map<int, GridBasedCluster> region_clusters;
+          for (int cluster_index : regions[r])
+          {
+            region_clusters.insert(*clusters_.find(cluster_index));
+          }
+          GridBasedClustering region_clustering(metric_, grid_.getGridSpacingX(), grid_.getGridSpacingY(), std::move(region_clusters));
+          region_clustering.cluster();
+          region_results[r] = std::move(region_clustering.clusters_final_);
+        }
+        catch (...)
+        {
+#pragma omp critical (GridBasedClustering_error)
+          if (!error)
+          {
+            error = std::current_exception();
+          }
+        }
+      }
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+
+      // stitch the clusters next to the cuts
+      std::vector<std::map<int, GridBasedCluster> > stitched(cuts.size());
+      for (Size k = 0; k < cuts.size(); ++k)
+      {
+        for (Size r = cuts[k]; r <= cuts[k] + 1; ++r)
+        {
+          for (std::map<int, GridBasedCluster>::iterator it = region_results[r].begin(); it != region_results[r].end();)
+          {
+            const int column = grid_.getIndex(it->second.getCentre()).first;
+            if (column == cut_columns[k] || column == cut_columns[k] + 1)
+            {
+              stitched[k].insert(*it);
+              region_results[r].erase(it++);
+            }
+            else
+            {
+              ++it;
+            }
+          }
+        }
+      }
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize k = 0; k < (SignedSize)cuts.size(); ++k)
+      {
+        try
+        {
+          GridBasedClustering stitch_clustering(metric_, grid_.getGridSpacingX(), grid_.getGridSpacingY(), std::move(stitched[k]));
+          stitch_clustering.cluster();
+          stitched[k] = std::move(stitch_clustering.clusters_final_);
+        }
+        catch (...)
+        {
+#pragma omp critical (GridBasedClustering_error)
+          if (!error)
+          {
+            error = std::current_exception();
+          }
+        }
+      }
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+
+      for (const std::map<int, GridBasedCluster>& result : region_results)
+      {
+        clusters_final_.insert(result.begin(), result.end());
+      }
+      for (const std::map<int, GridBasedCluster>& result : stitched)
+      {
+        clusters_final_.insert(result.begin(), result.end());
+      }
+
+      // same state as after cluster()
+      clusters_.clear();
+      grid_.removeAllClusters();
+      distances_.clear();
+      reverse_nns_.clear();
+      nearest_neighbours_.clear();
+    }
+
     /**
      * @brief extends clusters in y-direction if possible
      * (merges clusters further in y-direction, i.e. clusters can now span multiple cells)
@@ -423,6 +574,44 @@ public:
 
 private:
 
+    /**
+     * @brief distance between a cluster and its nearest neighbour
+     * (outdated once the cluster has a newer entry or none in nearest_neighbours_)
+     */
+    struct NearestNeighbourDistance_
+    {
+      double distance;
+      UInt64 order; // insertion order, breaks ties (and identifies the entry)
+      int cluster_index;
+      int nearest_neighbour_index;
+
+      bool operator<(const NearestNeighbourDistance_& other) const
+      {
+        return distance < other.distance || (distance == other.distance && order < other.order);
+      }
+    };
+
+    /**
+     * @brief initialises the clustering of existing clusters (e.g. a region of another clustering)
+     *
+     * @param metric Metric for measuring the distance between points in the 2D plane
+     * @param grid_spacing_x    grid spacing in x-direction
+     * @param grid_spacing_y    grid spacing in y-direction
+     * @param clusters    clusters to be merged further
+     */
+    GridBasedClustering(Metric metric, const std::vector<double>& grid_spacing_x, const std::vector<double>& grid_spacing_y,
+                        std::map<int, GridBasedCluster> clusters) :
+      metric_(metric),
+      grid_(grid_spacing_x, grid_spacing_y),
+      clusters_(std::move(clusters))
+    {
+      for (const std::pair<const int, GridBasedCluster>& c : clusters_)
+      {
+        grid_.addCluster(grid_.getIndex(c.second.getCentre()), c.first);
+      }
+      initNearestNeighbours_();
+    }
+
     /**
      * @brief metric for measuring the distance between points in the 2D plane
      */
@@ -447,22 +636,27 @@ private:
     std::map<int, GridBasedCluster> clusters_final_;
 
     /**
-    * @brief list of minimum distances
-    * stores the smallest of the distances in the head
+    * @brief heap of minimum distances
+    * stores the smallest of the distances in the head, outdated distances are skipped when they reach the head
     */
-    std::multiset<MinimumDistance> distances_;
+    DAryHeap<NearestNeighbourDistance_> distances_;
+
+    /**
+     * @brief cluster index to (order of its current distance entry, nearest neighbour) lookup table
+     * (clusters without an entry have no valid distance)
+     */
+    std::unordered_map<int, std::pair<UInt64, int> > nearest_neighbours_;
 
     /**
-     * @brief reverse nearest neighbor lookup table
-     * for finding out which clusters need to be updated faster
+     * @brief reverse nearest neighbor lookup table (nearest neighbour -> cluster)
+     * for finding out which clusters need to be updated faster; may contain outdated pairs
      */
-    std::unordered_multimap<int, std::multiset<MinimumDistance>::const_iterator> reverse_nns_;
+    std::unordered_multimap<int, int> reverse_nns_;
 
     /**
-     * @brief cluster index to distance iterator lookup table
-     * for finding out which clusters need to be updated faster
+     * @brief number of distances inserted so far
      */
-    std::unordered_map<int, std::multiset<MinimumDistance>::const_iterator> distance_it_for_cluster_idx_;
+    UInt64 distance_count_ = 0;
 
     /**
      * @brief initialises all data structures
@@ -494,7 +688,15 @@ private:
         grid_.addCluster(grid_.getIndex(position), i);
       }
 
-      // fill list of minimum distances
+      initNearestNeighbours_();
+    }
+
+    /**
+     * @brief fills the list of minimum distances
+     * (and moves clusters without neighbours to the final results)
+     */
+    void initNearestNeighbours_()
+    {
       std::map<int, GridBasedCluster>::iterator iterator = clusters_.begin();
       while (iterator != clusters_.end())
       {
@@ -582,38 +784,25 @@ private:
       int nearest_neighbour = -1;
 
       // search in the grid cell and its 8 neighbouring cells for the nearest neighbouring cluster
-      for (int i = -1; i <= 1; ++i)
+      grid_.forEachClusterInNeighbourhood(cell_index, [&](int cluster_index2)
       {
-        for (int j = -1; j <= 1; ++j)
+        if (cluster_index2 != cluster_index)
         {
-          CellIndex cell_index2(cell_index);
-          cell_index2.first += i;
-          cell_index2.second += j;
-          if (grid_.isNonEmptyCell(cell_index2))
+          const GridBasedCluster& cluster2 = clusters_.find(cluster_index2)->second;
+          const Point& centre2 = cluster2.getCentre();
+          double distance = metric_(centre, centre2);
+
+          if (distance < min_dist || nearest_neighbour == -1)
           {
-            const std::list<int>& cluster_indices = grid_.getClusters(cell_index2);
-            for (std::list<int>::const_iterator cluster_index2 = cluster_indices.begin(); cluster_index2 != cluster_indices.end(); ++cluster_index2)
+            bool veto = mergeVeto_(cluster, cluster2); // If clusters cannot be merged anyhow, they are no nearest neighbours.
+            if (!veto)
             {
-              if (*cluster_index2 != cluster_index)
-              {
-                const GridBasedCluster& cluster2 = clusters_.find(*cluster_index2)->second;
-                const Point& centre2 = cluster2.getCentre();
-                double distance = metric_(centre, centre2);
-
-                if (distance < min_dist || nearest_neighbour == -1)
-                {
-                  bool veto = mergeVeto_(cluster, cluster2); // If clusters cannot be merged anyhow, they are no nearest neighbours.
-                  if (!veto)
-                  {
-                      min_dist = distance;
-                      nearest_neighbour = *cluster_index2;
-                  }
-                }
-              }
+                min_dist = distance;
+                nearest_neighbour = cluster_index2;
             }
           }
         }
-      }
+      });
 
       if (nearest_neighbour == -1)
       {
@@ -623,42 +812,41 @@ private:
       }
 
       // add to the list of minimal distances
-      std::multiset<MinimumDistance>::const_iterator it = distances_.insert(MinimumDistance(cluster_index, nearest_neighbour, min_dist));
+      const UInt64 order = distance_count_++;
+      distances_.push(NearestNeighbourDistance_{min_dist, order, cluster_index, nearest_neighbour});
       // add to reverse nearest neighbor lookup table
-      reverse_nns_.insert(std::make_pair(nearest_neighbour, it));
+      reverse_nns_.insert(std::make_pair(nearest_neighbour, cluster_index));
       // add to cluster index -> distance lookup table
-      distance_it_for_cluster_idx_[cluster_index] = it;
+      nearest_neighbours_[cluster_index] = std::make_pair(order, nearest_neighbour);
 
       return false;
     }
 
     /**
-     * @brief remove minimum distance object and its related data
-     *
-     * Remove the distance object behind @p it from distances_ and remove all
-     * corresponding data from the auxiliary data structures reverse_nns_ and
-     * distance_it_for_cluster_idx_.
-     *
-     * @param it    Iterator of distance to be removed from distances_
+     * @brief is @p d the current distance of its cluster?
      */
-    void eraseMinDistance_(const std::multiset<MinimumDistance>::const_iterator it)
+    bool isCurrent_(const NearestNeighbourDistance_& d) const
     {
-      // remove corresponding entries from nearest neighbor lookup table
-      std::pair<NNIterator, NNIterator> nn_range = reverse_nns_.equal_range(it->getNearestNeighbourIndex());
-      for (NNIterator nn_it = nn_range.first; nn_it != nn_range.second; ++nn_it)
+      auto it = nearest_neighbours_.find(d.cluster_index);
+      return it != nearest_neighbours_.end() && it->second.first == d.order;
+    }
+
+    /**
+     * @brief adds all clusters whose nearest neighbour is @p cluster_index to @p clusters and invalidates their distances
+     */
+    void collectReverseNearestNeighbours_(int cluster_index, std::set<int>& clusters)
+    {
+      auto nn_range = reverse_nns_.equal_range(cluster_index);
+      for (auto nn_it = nn_range.first; nn_it != nn_range.second; ++nn_it)
       {
-        if (nn_it->second == it)
+        auto it = nearest_neighbours_.find(nn_it->second);
+        if (it != nearest_neighbours_.end() && it->second.second == cluster_index)
         {
-          reverse_nns_.erase(nn_it);
-          break;
+          clusters.insert(nn_it->second);
+          nearest_neighbours_.erase(it);
         }
       }
-
-      // remove corresponding entry from cluster index -> distance lookup table
-      distance_it_for_cluster_idx_.erase(it->getClusterIndex());
-
-      // remove from distances_
-      distances_.erase(it);
+      reverse_nns_.erase(nn_range.first, nn_range.second);
     }
   };
 }
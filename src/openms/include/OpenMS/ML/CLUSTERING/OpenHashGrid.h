@@ -0,0 +1,237 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Lars Nilse $
+// $Authors: Lars Nilse $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/DPosition.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+   * @brief Grid of values in integer-indexed cells for dynamic updates, with an open-addressing cell table.
+   *
+   * Counterpart of StaticHashGrid for clusterings that move values between cells: the cell indices are
+   * hashed into one flat table with linear probing (no nodes, no pointers), which refers to the contents
+   * of the cells. The values of a cell are kept in a vector in insertion order, so iterating over a cell
+   * reads contiguous memory.
+   *
+   * Cells whose values have all been erased stay in the table (empty) until clear(), which avoids
+   * tombstones and keeps lookups of recently emptied cells cheap.
+   *
+   * @tparam Value Type stored in the cells (e.g. a cluster index); needs operator== for erase()
+   */
+  template<typename Value>
+  class OpenHashGrid
+  {
+  public:
+    /// Index for cells
+    typedef DPosition<2, Int64> CellIndex;
+
+    /// Contents of a cell
+    typedef std::vector<Value> CellContent;
+
+    /// Adds @p value to cell @p x.
+    void insert(const CellIndex& x, const Value& value)
+    {
+      CellContent& cell = cells_[findOrInsertSlot_(x)];
+      if (cell.empty())
+      {
+        ++non_empty_cells_;
+      }
+      cell.push_back(value);
+      ++size_;
+    }
+
+    /**
+     * @brief Removes all values equal to @p value from cell @p x (keeping the order of the others).
+     *
+     * @return Number of values removed.
+     */
+    Size erase(const CellIndex& x, const Value& value)
+    {
+      const Size slot = findSlot_(x);
+      if (slot == npos_)
+      {
+        return 0;
+      }
+      CellContent& cell = cells_[slots_[slot].cell];
+      const Size old_size = cell.size();
+      cell.erase(std::remove(cell.begin(), cell.end(), value), cell.end());
+      const Size removed = old_size - cell.size();
+      size_ -= removed;
+      if (removed > 0 && cell.empty())
+      {
+        --non_empty_cells_;
+      }
+      return removed;
+    }
+
+    /// Removes all cells and values.
+    void clear()
+    {
+      slots_.clear();
+      cells_.clear();
+      size_ = 0;
+      non_empty_cells_ = 0;
+    }
+
+    /// Returns the contents of cell @p x, or nullptr if the cell is empty.
+    const CellContent* find(const CellIndex& x) const
+    {
+      const Size slot = findSlot_(x);
+      if (slot == npos_ || cells_[slots_[slot].cell].empty())
+      {
+        return nullptr;
+      }
+      return &cells_[slots_[slot].cell];
+    }
+
+    /**
+     * @brief Calls @p f for all values in cell @p x and its 8 neighboring cells.
+     *
+     * The cells are visited in the order (i - 1, j - 1), (i - 1, j), ..., (i + 1, j + 1) and their values in
+     * insertion order.
+     *
+     * @param x Index of the center cell
+     * @param f Functor called as f(const Value&)
+     */
+    template<typename Functor>
+    void forEachNeighbor(const CellIndex& x, Functor&& f) const
+    {
+      for (Int64 i = x[0] - 1; i <= x[0] + 1; ++i)
+      {
+        for (Int64 j = x[1] - 1; j <= x[1] + 1; ++j)
+        {
+          const CellContent* cell = find(CellIndex(i, j));
+          if (cell != nullptr)
+          {
+            for (const Value& value : *cell)
+            {
+              f(value);
+            }
+          }
+        }
+      }
+    }
+
+    /// Number of values
+    Size size() const
+    {
+      return size_;
+    }
+
+    /// No values?
+    bool empty() const
+    {
+      return size_ == 0;
+    }
+
+    /// Number of non-empty cells
+    Size cellCount() const
+    {
+      return non_empty_cells_;
+    }
+
+  private:
+    /// Entry of the open-addressing table; cell == npos_ marks a free slot
+    struct Slot
+    {
+      CellIndex index;
+      Size cell;
+    };
+
+    static constexpr Size npos_ = std::numeric_limits<Size>::max();
+
+    /// Position of @p x in a table of size @p table_size (a power of two)
+    static Size hash_(const CellIndex& x, Size table_size)
+    {
+      // multiplicative hashing of both coordinates
+      UInt64 h = UInt64(x[0]) * 0x9E3779B97F4A7C15ULL ^ UInt64(x[1]) * 0xC2B2AE3D27D4EB4FULL;
+      h ^= h >> 29;
+      return Size(h) & (table_size - 1);
+    }
+
+    /// Slot of cell @p x, or npos_ if the cell is not in the table
+    Size findSlot_(const CellIndex& x) const
+    {
+      if (slots_.empty())
+      {
+        return npos_;
+      }
+      for (Size s = hash_(x, slots_.size()); ; s = (s + 1) & (slots_.size() - 1))
+      {
+        if (slots_[s].cell == npos_)
+        {
+          return npos_;
+        }
+        if (slots_[s].index == x)
+        {
+          return s;
+        }
+      }
+    }
+
+    /// Position of the contents of cell @p x in cells_ (added if new)
+    Size findOrInsertSlot_(const CellIndex& x)
+    {
+      // keep the load factor at most 1/2
+      if (2 * (cells_.size() + 1) > slots_.size())
+      {
+        rehash_(std::max(Size(16), 2 * slots_.size()));
+      }
+      Size s = hash_(x, slots_.size());
+      for (; slots_[s].cell != npos_; s = (s + 1) & (slots_.size() - 1))
+      {
+        if (slots_[s].index == x)
+        {
+          return slots_[s].cell;
+        }
+      }
+      slots_[s] = Slot{x, cells_.size()};
+      cells_.emplace_back();
+      return slots_[s].cell;
+    }
+
+    /// Rebuild the table with @p table_size slots
+    void rehash_(Size table_size)
+    {
+      std::vector<Slot> old_slots(table_size, Slot{CellIndex(), npos_});
+      old_slots.swap(slots_);
+      for (const Slot& slot : old_slots)
+      {
+        if (slot.cell != npos_)
+        {
+          Size s = hash_(slot.index, table_size);
+          while (slots_[s].cell != npos_)
+          {
+            s = (s + 1) & (table_size - 1);
+          }
+          slots_[s] = slot;
+        }
+      }
+    }
+
+    /// Open-addressing table: cell index -> position in cells_
+    std::vector<Slot> slots_;
+
+    /// Contents of the cells (in order of their creation)
+    std::vector<CellContent> cells_;
+
+    /// Number of values
+    Size size_ = 0;
+
+    /// Number of non-empty cells
+    Size non_empty_cells_ = 0;
+  };
+
+} // namespace OpenMS
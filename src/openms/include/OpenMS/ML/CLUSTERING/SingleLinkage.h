@@ -55,6 +55,15 @@ public:
     */
     void operator()(DistanceMatrix<float> & original_distance, std::vector<BinaryTreeNode> & cluster_tree, const float threshold = 1) const override;
 
+    /**
+        @brief clusters @p n elements given only the distances of some pairs (see ClusterFunctor)
+
+        Single linkage merges are the edges of a minimum spanning tree, so the clustering is computed from the sorted
+        @p distances only (Kruskal's algorithm): O(m log m) time for m distances and O(n) additional memory.
+        Merges at distances of at least @p threshold are replaced by dummy nodes (distance -1).
+    */
+    void operator()(Size n, std::vector<PairDistance> & distances, std::vector<BinaryTreeNode> & cluster_tree, const float threshold = 1) const override;
+
   };
 
 
@@ -0,0 +1,219 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Lars Nilse $
+// $Authors: Lars Nilse $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/CONCEPT/Macros.h>
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/DPosition.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+   * @brief Immutable grid of (2-dimensional coordinate, value) pairs, stored cell by cell in one array.
+   *
+   * Build-once/query-many counterpart of HashGrid: all pairs are given at construction, sorted by their
+   * cell index (and by insertion order within a cell) and stored contiguously, like a matrix in
+   * compressed sparse row (CSR) format. A sorted array of the non-empty cells holds the offsets of their
+   * elements. Since cells are sorted by their first and then their second index, the three cells
+   * (i, j - 1), (i, j) and (i, j + 1) of a row of a 3x3 neighborhood are adjacent: forEachNeighbor()
+   * finds each row with one binary search and then scans a contiguous range of elements.
+   *
+   * Iteration (begin(), end()) visits the elements in cell order.
+   *
+   * @tparam Cluster Type to be stored in the grid (e.g. a pointer to a GridFeature)
+   */
+  template<typename Cluster>
+  class StaticHashGrid
+  {
+  public:
+    /// Coordinate for stored pairs
+    typedef DPosition<2, double> ClusterCenter;
+
+    /// Index for cells
+    typedef DPosition<2, Int64> CellIndex;
+
+    typedef ClusterCenter key_type;
+    typedef Cluster mapped_type;
+    typedef std::pair<ClusterCenter, Cluster> value_type;
+    typedef typename std::vector<value_type>::const_iterator const_iterator;
+    typedef typename std::vector<value_type>::size_type size_type;
+
+    /// A non-empty cell: its index and the range [begin, end) of its elements
+    struct Cell
+    {
+      CellIndex index;
+      size_type begin;
+      size_type end;
+    };
+
+    /**
+     * @brief Dimension of cells.
+     */
+    const ClusterCenter cell_dimension;
+
+    /**
+     * @brief Sorts @p elements into the cells of dimension @p c_dimension.
+     *
+     * @exception Exception::OutOfRange if the cell index of an element does not fit into Int64
+     */
+    StaticHashGrid(const ClusterCenter& c_dimension, std::vector<value_type> elements) :
+      cell_dimension(c_dimension)
+    {
+      // sort (stable, to keep the insertion order within each cell) by cell index once
+      std::vector<std::pair<CellIndex, size_type> > order;
+      order.reserve(elements.size());
+      for (size_type i = 0; i < elements.size(); ++i)
+      {
+        order.emplace_back(cellIndex(elements[i].first), i);
+      }
+      std::sort(order.begin(), order.end(),
+                [](const std::pair<CellIndex, size_type>& a, const std::pair<CellIndex, size_type>& b) {
+                  return a.first < b.first || (a.first == b.first && a.second < b.second);
+                });
+
+      elements_.reserve(elements.size());
+      for (const std::pair<CellIndex, size_type>& o : order)
+      {
+        if (cells_.empty() || !(cells_.back().index == o.first))
+        {
+          if (!cells_.empty())
+          {
+            cells_.back().end = elements_.size();
+          }
+          cells_.push_back(Cell{o.first, elements_.size(), elements_.size()});
+        }
+        elements_.push_back(std::move(elements[o.second]));
+      }
+      if (!cells_.empty())
+      {
+        cells_.back().end = elements_.size();
+      }
+    }
+
+    /**
+     * @brief Returns the index of the cell containing @p key.
+     *
+     * @exception Exception::OutOfRange if the index does not fit into Int64
+     */
+    CellIndex cellIndex(const ClusterCenter& key) const
+    {
+      CellIndex ret;
+      for (UInt d = 0; d < 2; ++d)
+      {
+        double t = std::floor(key[d] / cell_dimension[d]);
+        if (t < double(std::numeric_limits<Int64>::min()) || t > double(std::numeric_limits<Int64>::max()))
+        {
+          throw Exception::OutOfRange(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
+        }
+        ret[d] = static_cast<Int64>(t);
+      }
+      return ret;
+    }
+
+    /// Returns iterator to first element (in cell order).
+    const_iterator begin() const
+    {
+      return elements_.begin();
+    }
+
+    /// Returns iterator to one after the last element.
+    const_iterator end() const
+    {
+      return elements_.end();
+    }
+
+    /// Return true if the grid is empty.
+    bool empty() const
+    {
+      return elements_.empty();
+    }
+
+    /// Return number of elements.
+    size_type size() const
+    {
+      return elements_.size();
+    }
+
+    /// All elements (in cell order)
+    const std::vector<value_type>& getElements() const
+    {
+      return elements_;
+    }
+
+    /// All non-empty cells (sorted by their index)
+    const std::vector<Cell>& getCells() const
+    {
+      return cells_;
+    }
+
+    /// Returns the non-empty cell with index @p x, or nullptr if it is empty.
+    const Cell* findCell(const CellIndex& x) const
+    {
+      typename std::vector<Cell>::const_iterator it = lowerBound_(x);
+      if (it == cells_.end() || !(it->index == x))
+      {
+        return nullptr;
+      }
+      return &(*it);
+    }
+
+    /**
+     * @brief Calls @p f for all elements in cell @p x and its 8 neighboring cells.
+     *
+     * The cells are visited in the order (i - 1, j - 1), (i - 1, j), ..., (i + 1, j + 1) and their elements in
+     * insertion order, as by nested loops over the 3x3 cells.
+     *
+     * @param x Index of the center cell
+     * @param f Functor called as f(const value_type&)
+     */
+    template<typename Functor>
+    void forEachNeighbor(const CellIndex& x, Functor&& f) const
+    {
+      for (Int64 i = x[0] - 1; i <= x[0] + 1; ++i)
+      {
+        // the cells (i, j - 1) to (i, j + 1) are adjacent in cells_, and so are their elements
+        typename std::vector<Cell>::const_iterator first = lowerBound_(CellIndex(i, x[1] - 1));
+        typename std::vector<Cell>::const_iterator last = first;
+        while (last != cells_.end() && last->index[0] == i && last->index[1] <= x[1] + 1)
+        {
+          ++last;
+        }
+        if (first == last)
+        {
+          continue;
+        }
+        for (size_type e = first->begin; e < (last - 1)->end; ++e)
+        {
+          f(elements_[e]);
+        }
+      }
+    }
+
+  private:
+    /// First cell with an index not less than @p x
+    typename std::vector<Cell>::const_iterator lowerBound_(const CellIndex& x) const
+    {
+      return std::lower_bound(cells_.begin(), cells_.end(), x, [](const Cell& cell, const CellIndex& index) { return cell.index < index; });
+    }
+
+    /// Elements, sorted by cell
+    std::vector<value_type> elements_;
+
+    /// Non-empty cells, sorted by index
+    std::vector<Cell> cells_;
+  };
+
+} // namespace OpenMS
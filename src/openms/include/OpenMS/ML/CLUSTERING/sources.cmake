@@ -13,7 +13,9 @@ EuclideanSimilarity.h
 GridBasedCluster.h
 GridBasedClustering.h
 HashGrid.h
+OpenHashGrid.h
 SingleLinkage.h
+StaticHashGrid.h
 )
 
 ### add path to the filenames
@@ -8,10 +8,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <vector>
 #include <cmath>
 #include <tuple>
+#include <utility>
 
 namespace OpenMS
 {
@@ -106,6 +108,68 @@ namespace OpenMS
     }
 
 
+    /**
+      @brief Evaluates all combinations in batches of (at most) @p batch_size combinations
+
+      @p evaluator is called with a vector of parameter tuples and has to return a vector with their results
+      in the same order. Since the combinations of a batch are handed over at once, the evaluator can
+      evaluate them concurrently. The combinations are visited in the same order as in evaluate() and the
+      first combination with the best (greater than @p startValue) result is reported in @p resultIndices.
+    */
+    template <typename BatchFunctor, typename EvalResult>
+    EvalResult evaluateInBatches(BatchFunctor evaluator,
+                                 size_t batch_size,
+                                 EvalResult startValue,
+                                 std::array<size_t,std::tuple_size<std::tuple<std::vector<TupleTypes>...>>::value>& resultIndices)
+    {
+      constexpr size_t grid_size = sizeof...(TupleTypes);
+      using Indices = std::array<size_t, grid_size>;
+      const Indices sizes = sizes_(std::index_sequence_for<TupleTypes...>{});
+      for (size_t s : sizes)
+      {
+        if (s == 0) return startValue;
+      }
+
+      EvalResult bestValue = startValue;
+      std::vector<Indices> batch_indices;
+      std::vector<std::tuple<TupleTypes...>> batch;
+      Indices curr{};
+      bool done = false;
+      while (!done)
+      {
+        batch_indices.push_back(curr);
+        batch.push_back(combination_(curr, std::index_sequence_for<TupleTypes...>{}));
+
+        // next combination, the last parameter changes fastest (as in evaluate())
+        done = true;
+        for (size_t p = grid_size; p-- > 0;)
+        {
+          if (++curr[p] < sizes[p])
+          {
+            done = false;
+            break;
+          }
+          curr[p] = 0;
+        }
+
+        if (done || batch.size() >= std::max<size_t>(batch_size, 1))
+        {
+          const std::vector<EvalResult> results = evaluator(batch);
+          for (size_t i = 0; i < batch.size(); ++i)
+          {
+            if (results[i] > bestValue)
+            {
+              bestValue = results[i];
+              resultIndices = batch_indices[i];
+            }
+          }
+          batch.clear();
+          batch_indices.clear();
+        }
+      }
+      return bestValue;
+    }
+
     unsigned int getNrCombos()
     {
       if (combos_ready_)
@@ -123,6 +187,18 @@ namespace OpenMS
     unsigned int combos_ = 1;
     bool combos_ready_ = false;
 
+    template<std::size_t... I>
+    std::array<size_t, sizeof...(TupleTypes)> sizes_(std::index_sequence<I...>) const
+    {
+      return {{std::get<I>(grid_).size()...}};
+    }
+
+    template<std::size_t... I>
+    std::tuple<TupleTypes...> combination_(const std::array<size_t, sizeof...(TupleTypes)>& indices, std::index_sequence<I...>) const
+    {
+      return std::tuple<TupleTypes...>(std::get<I>(grid_)[indices[I]]...);
+    }
+
     template<std::size_t I = 0>
     typename std::enable_if<I == sizeof...(TupleTypes), unsigned int>::type
     nrCombos()
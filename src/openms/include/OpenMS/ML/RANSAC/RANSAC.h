@@ -17,6 +17,8 @@
 #include <OpenMS/ML/RANSAC/RANSACModelLinear.h>
 #include <OpenMS/MATH/MathFunctions.h>
 
+#include <algorithm>    // std::min
+#include <exception>    // std::exception_ptr
 #include <limits>       // std::numeric_limits
 #include <vector>       // std::vector
 #include <sstream>      // stringstream
@@ -143,62 +145,81 @@ public:
                                         String("RANSAC: Number of total data points (") + String(pairs.size()) + ") must be larger than number of initial points (n=" + String(n) + ").");
         }
 
-        TModelType model;
-
-        std::vector< std::pair<double, double> > alsoinliers, betterdata, bestdata;
+        std::vector<std::pair<double, double> > bestdata;
         std::vector<std::pair<double, double> > pairs_shuffled = pairs;  // mutable data. will be shuffled in every iteration
         double besterror = std::numeric_limits<double>::max();
-        typename TModelType::ModelParameters coeff;
-    #ifdef DEBUG_RANSAC
-        std::pair<double, double > bestcoeff;
-        double betterrsq = 0;
-        double bestrsq = 0;
-    #endif
 
-        for (size_t ransac_int=0; ransac_int<k; ransac_int++)
+        // Hypotheses are drawn in batches: the shuffles are done sequentially (so the random sequence and thus
+        // the result is the same as for one hypothesis at a time), the models are fitted and evaluated in
+        // parallel and the best model is picked in the order of the iterations.
+        struct Hypothesis
+        {
+          bool better = false; ///< passed the inlier threshold 'd'
+          std::vector<std::pair<double, double> > data;
+          double error = 0;
+          std::exception_ptr exception;
+        };
+        const size_t batch_size = std::min(k, BATCH_SIZE);
+        std::vector<std::vector<std::pair<double, double> > > samples(batch_size);
+        std::vector<Hypothesis> hypotheses(batch_size);
+
+        for (size_t batch_start = 0; batch_start < k; batch_start += batch_size)
         {
           // check if the model already includes all points
           if (bestdata.size() == pairs.size()) break;
 
-          // use portable RNG in test mode
-          shuffler_.portable_random_shuffle(pairs_shuffled.begin(), pairs_shuffled.end());
-
-          // test 'maybeinliers'
-          try
-          { // fitting might throw UnableToFit if points are 'unfortunate'
-            coeff = model.rm_fit(pairs_shuffled.begin(), pairs_shuffled.begin()+n);
-          }
-          catch (...)
+          const size_t batch_n = std::min(batch_size, k - batch_start);
+          const boost::mt19937_64 batch_rng = shuffler_.rng_; // to rewind, if we stop within the batch
+          for (size_t i = 0; i < batch_n; ++i)
           {
-            continue;
+            // use portable RNG in test mode
+            shuffler_.portable_random_shuffle(pairs_shuffled.begin(), pairs_shuffled.end());
+            samples[i] = pairs_shuffled;
           }
-          // apply model to remaining data; pick inliers
-          alsoinliers = model.rm_inliers(pairs_shuffled.begin()+n, pairs_shuffled.end(), coeff, t);
-          // ... and add data
-          if (alsoinliers.size() > d 
-              || alsoinliers.size() >= (pairs_shuffled.size()-n)) // maximum number of inliers we can possibly have (i.e. remaining data)
+
+#pragma omp parallel for schedule(dynamic, 1)
+          for (SignedSize i = 0; i < SignedSize(batch_n); ++i)
           {
-            betterdata.clear();
-            std::copy( pairs_shuffled.begin(), pairs_shuffled.begin()+n, back_inserter(betterdata) );
-            betterdata.insert( betterdata.end(), alsoinliers.begin(), alsoinliers.end() );
-            typename TModelType::ModelParameters bettercoeff = model.rm_fit(betterdata.begin(), betterdata.end());
-            double bettererror = model.rm_rss(betterdata.begin(), betterdata.end(), bettercoeff);
-    #ifdef DEBUG_RANSAC
-            betterrsq = model.rm_rsq(betterdata);
-    #endif
+            Hypothesis& h = hypotheses[i];
+            h = Hypothesis();
+            try
+            {
+              evaluate_(samples[i], n, t, d, h.better, h.data, h.error);
+            }
+            catch (...)
+            {
+              h.exception = std::current_exception();
+            }
+          }
 
+          for (size_t i = 0; i < batch_n; ++i)
+          {
+            if (bestdata.size() == pairs.size())
+            {
+              // iteration 'i' would not have happened: rewind the random generator to the state after iteration 'i - 1'
+              shuffler_.rng_ = batch_rng;
+              std::vector<char> replay(pairs.size());
+              for (size_t j = 0; j < i; ++j)
+              {
+                shuffler_.portable_random_shuffle(replay.begin(), replay.end());
+              }
+              break;
+            }
+            Hypothesis& h = hypotheses[i];
+            if (h.exception)
+            {
+              std::rethrow_exception(h.exception);
+            }
             // If the current model explains more points, we assume its better (these points pass the error threshold 't', so they should be ok);
             // If the number of points is equal, we trust rss.
             // E.g. imagine gaining a zillion more points (which pass the threshold!) -- then rss will automatically be worse, no matter how good
             //      these points fit, since its a simple absolute SUM() of residual error over all points.
-            if (betterdata.size() > bestdata.size() || (betterdata.size() == bestdata.size() && (bettererror < besterror)))
+            if (h.better && (h.data.size() > bestdata.size() || (h.data.size() == bestdata.size() && (h.error < besterror))))
             {
-              besterror = bettererror;
-              bestdata = betterdata;
+              besterror = h.error;
+              bestdata.swap(h.data);
     #ifdef DEBUG_RANSAC
-              bestcoeff = bettercoeff;
-              bestrsq = betterrsq;
-              std::cout << "RANSAC " << ransac_int << ": Points: " << betterdata.size() << " RSQ: " << bestrsq << " Error: " << besterror << " c0: " << bestcoeff.first << " c1: " << bestcoeff.second << std::endl;
+              std::cout << "RANSAC " << batch_start + i << ": Points: " << bestdata.size() << " RSQ: " << TModelType().rm_rsq(bestdata.begin(), bestdata.end()) << " Error: " << besterror << std::endl;
     #endif
             }
           }
@@ -217,6 +238,48 @@ public:
       } // ransac()
 
     private:
+      /// Number of hypotheses which are evaluated in parallel
+      static constexpr size_t BATCH_SIZE = 64;
+
+      /**
+        @brief Fits a model to the first @p n points of @p sample and, if the model has more than @p d inliers
+        (or all remaining points are inliers), refits it to all inliers
+
+        @param[out] better Did the model pass the inlier threshold @p d? (false if the initial fit failed)
+        @param[out] data The initial points and the inliers (if @p better)
+        @param[out] error The RSS of the refitted model (if @p better)
+      */
+      static void evaluate_(const std::vector<std::pair<double, double> >& sample, size_t n, double t, size_t d,
+                            bool& better, std::vector<std::pair<double, double> >& data, double& error)
+      {
+        TModelType model;
+        typename TModelType::ModelParameters coeff;
+        // test 'maybeinliers'
+        try
+        { // fitting might throw UnableToFit if points are 'unfortunate'
+          coeff = model.rm_fit(sample.begin(), sample.begin() + n);
+        }
+        catch (...)
+        {
+          better = false;
+          return;
+        }
+        // apply model to remaining data; pick inliers
+        std::vector<std::pair<double, double> > alsoinliers = model.rm_inliers(sample.begin() + n, sample.end(), coeff, t);
+        // ... and add data
+        better = alsoinliers.size() > d
+                 || alsoinliers.size() >= (sample.size() - n); // maximum number of inliers we can possibly have (i.e. remaining data)
+        if (!better)
+        {
+          return;
+        }
+        data.reserve(n + alsoinliers.size());
+        data.assign(sample.begin(), sample.begin() + n);
+        data.insert(data.end(), alsoinliers.begin(), alsoinliers.end());
+        typename TModelType::ModelParameters bettercoeff = model.rm_fit(data.begin(), data.end());
+        error = model.rm_rss(data.begin(), data.end(), bettercoeff);
+      }
+
       Math::RandomShuffler shuffler_{};
     }; // class
   
@@ -170,7 +170,24 @@ namespace OpenMS
     /// Choose best SVM parameters based on cross-validation results
     std::tuple<double, double, double> chooseBestParameters_(bool higher_better) const;
 
-    /// Run cross-validation to optimize SVM parameters
+    /**
+       @brief Select the training observations for cross-validation and assign them to partitions
+
+       Observations are shuffled (with a fixed seed) and, for classification, assigned to partitions separately for
+       each class to keep the class proportions. If parameter @p xval_samples is set, only a (stratified) sample is used.
+
+       @param classification Stratify by class label?
+       @param xval_obs Output: indexes of the selected observations in the training data
+       @param partitions Output: for each partition, positions (in @p xval_obs) of its observations
+    */
+    void preparePartitions_(bool classification, std::vector<Size>& xval_obs, std::vector<std::vector<Size>>& partitions) const;
+
+    /**
+       @brief Run cross-validation to optimize SVM parameters
+
+       All values of @e C and @e p and all partitions are evaluated in parallel for each value of @e gamma.
+       If it fits into the kernel cache, the kernel matrix is computed only once per @e gamma.
+    */
     void optimizeParameters_(bool classification);
   };
 }
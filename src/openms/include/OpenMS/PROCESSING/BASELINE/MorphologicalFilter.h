@@ -133,7 +133,7 @@ namespace OpenMS
   {
   public:
     /// Constructor
-    MorphologicalFilter() : ProgressLogger(), DefaultParamHandler("MorphologicalFilter"), struct_size_in_datapoints_(0)
+    MorphologicalFilter() : ProgressLogger(), DefaultParamHandler("MorphologicalFilter")
     {
       // structuring element
       defaults_.setValue("struc_elem_length", 3.0, "Length of the structuring element. This should be wider than the expected peak width.");
@@ -165,83 +165,9 @@ namespace OpenMS
     @exception Exception::IllegalArgument The given method is not one of the values defined in the @em method parameter.
     */
     template<typename InputIterator, typename OutputIterator>
-    void filterRange(InputIterator input_begin, InputIterator input_end, OutputIterator output_begin)
+    void filterRange(InputIterator input_begin, InputIterator input_end, OutputIterator output_begin) const
     {
-      // the buffer is static only to avoid reallocation
-      static std::vector<typename InputIterator::value_type> buffer;
-      const UInt size = input_end - input_begin;
-
-      // determine the struct size in data points if not already set
-      if (struct_size_in_datapoints_ == 0)
-      {
-        struct_size_in_datapoints_ = (UInt)(double)param_.getValue("struc_elem_length");
-      }
-
-      // apply the filtering
-      std::string method = param_.getValue("method");
-      if (method == "identity")
-      {
-        std::copy(input_begin, input_end, output_begin);
-      }
-      else if (method == "erosion")
-      {
-        applyErosion_(struct_size_in_datapoints_, input_begin, input_end, output_begin);
-      }
-      else if (method == "dilation")
-      {
-        applyDilation_(struct_size_in_datapoints_, input_begin, input_end, output_begin);
-      }
-      else if (method == "opening")
-      {
-        if (buffer.size() < size)
-          buffer.resize(size);
-        applyErosion_(struct_size_in_datapoints_, input_begin, input_end, buffer.begin());
-        applyDilation_(struct_size_in_datapoints_, buffer.begin(), buffer.begin() + size, output_begin);
-      }
-      else if (method == "closing")
-      {
-        if (buffer.size() < size)
-          buffer.resize(size);
-        applyDilation_(struct_size_in_datapoints_, input_begin, input_end, buffer.begin());
-        applyErosion_(struct_size_in_datapoints_, buffer.begin(), buffer.begin() + size, output_begin);
-      }
-      else if (method == "gradient")
-      {
-        if (buffer.size() < size)
-          buffer.resize(size);
-        applyErosion_(struct_size_in_datapoints_, input_begin, input_end, buffer.begin());
-        applyDilation_(struct_size_in_datapoints_, input_begin, input_end, output_begin);
-        for (UInt i = 0; i < size; ++i)
-          output_begin[i] -= buffer[i];
-      }
-      else if (method == "tophat")
-      {
-        if (buffer.size() < size)
-          buffer.resize(size);
-        applyErosion_(struct_size_in_datapoints_, input_begin, input_end, buffer.begin());
-        applyDilation_(struct_size_in_datapoints_, buffer.begin(), buffer.begin() + size, output_begin);
-        for (UInt i = 0; i < size; ++i)
-          output_begin[i] = input_begin[i] - output_begin[i];
-      }
-      else if (method == "bothat")
-      {
-        if (buffer.size() < size)
-          buffer.resize(size);
-        applyDilation_(struct_size_in_datapoints_, input_begin, input_end, buffer.begin());
-        applyErosion_(struct_size_in_datapoints_, buffer.begin(), buffer.begin() + size, output_begin);
-        for (UInt i = 0; i < size; ++i)
-          output_begin[i] = input_begin[i] - output_begin[i];
-      }
-      else if (method == "erosion_simple")
-      {
-        applyErosionSimple_(struct_size_in_datapoints_, input_begin, input_end, output_begin);
-      }
-      else if (method == "dilation_simple")
-      {
-        applyDilationSimple_(struct_size_in_datapoints_, input_begin, input_end, output_begin);
-      }
-
-      struct_size_in_datapoints_ = 0;
+      filterRange_((UInt)(double)param_.getValue("struc_elem_length"), input_begin, input_end, output_begin);
     }
 
     /**
@@ -258,7 +184,7 @@ namespace OpenMS
                 number.
         </ul>
     */
-    void filter(MSSpectrum& spectrum)
+    void filter(MSSpectrum& spectrum) const
     {
       // make sure the right peak type is set
       spectrum.setType(SpectrumSettings::PROFILE);
@@ -270,23 +196,24 @@ namespace OpenMS
       }
 
       // Determine structuring element size in datapoints (depending on the unit)
+      UInt struct_size_in_datapoints;
       if (param_.getValue("struc_elem_unit") == "Thomson")
       {
         const double struc_elem_length = (double)param_.getValue("struc_elem_length");
         const double mz_diff = spectrum.back().getMZ() - spectrum.begin()->getMZ();
-        struct_size_in_datapoints_ = (UInt)(ceil(struc_elem_length * (double)(spectrum.size() - 1) / mz_diff));
+        struct_size_in_datapoints = (UInt)(ceil(struc_elem_length * (double)(spectrum.size() - 1) / mz_diff));
       }
       else
       {
-        struct_size_in_datapoints_ = (UInt)(double)param_.getValue("struc_elem_length");
+        struct_size_in_datapoints = (UInt)(double)param_.getValue("struc_elem_length");
       }
       // make it odd (needed for the algorithm)
-      if (!Math::isOdd(struct_size_in_datapoints_))
-        ++struct_size_in_datapoints_;
+      if (!Math::isOdd(struct_size_in_datapoints))
+        ++struct_size_in_datapoints;
 
       // apply the filtering and overwrite the input data
       std::vector<Peak1D::IntensityType> output(spectrum.size());
-      filterRange(Internal::intensityIteratorWrapper(spectrum.begin()), Internal::intensityIteratorWrapper(spectrum.end()), output.begin());
+      filterRange_(struct_size_in_datapoints, Internal::intensityIteratorWrapper(spectrum.begin()), Internal::intensityIteratorWrapper(spectrum.end()), output.begin());
 
       // overwrite output with data
       for (Size i = 0; i < spectrum.size(); ++i)
@@ -299,246 +226,166 @@ namespace OpenMS
         @brief Applies the morphological filtering operation to an MSExperiment.
 
         The size of the structuring element is computed for each spectrum individually, if it is given in 'Thomson'.
-        See the filtering method for MSSpectrum for details.
+        See the filtering method for MSSpectrum for details. Spectra are filtered in parallel.
     */
     void filterExperiment(PeakMap& exp)
     {
       startProgress(0, exp.size(), "filtering baseline");
-      for (UInt i = 0; i < exp.size(); ++i)
+      Size progress = 0;
+#pragma omp parallel for schedule(dynamic, 100)
+      for (SignedSize i = 0; i < (SignedSize)exp.size(); ++i)
       {
         filter(exp[i]);
-        setProgress(i);
+#pragma omp critical (progress)
+        setProgress(++progress);
       }
       endProgress();
     }
 
   protected:
-    /// Member for struct size in data points
-    UInt struct_size_in_datapoints_;
-
-    /** @brief Applies erosion.  This implementation uses van Herk's method.
-    Only 3 min/max comparisons are required per data point, independent of
-    struc_size.
-    */
+    /// Applies the filtering operation with a structuring element of @p struc_size data points (see filterRange())
     template<typename InputIterator, typename OutputIterator>
-    void applyErosion_(Int struc_size, InputIterator input, InputIterator input_end, OutputIterator output)
+    void filterRange_(UInt struc_size, InputIterator input_begin, InputIterator input_end, OutputIterator output_begin) const
     {
-      typedef typename InputIterator::value_type ValueType;
-      const Int size = input_end - input;
-      const Int struc_size_half = struc_size / 2; // yes, integer division
-
-      static std::vector<ValueType> buffer;
-      if (Int(buffer.size()) < struc_size)
-        buffer.resize(struc_size);
-
-      Int anchor;        // anchoring position of the current block
-      Int i;             // index relative to anchor, used for 'for' loops
-      Int ii = 0;        // input index
-      Int oi = 0;        // output index
-      ValueType current; // current value
+      std::vector<typename InputIterator::value_type> buffer;
+      const UInt size = input_end - input_begin;
 
-      // we just can't get the case distinctions right in these cases, resorting to simple method.
-      if (size <= struc_size || size <= 5)
+      // apply the filtering
+      std::string method = param_.getValue("method");
+      if (method == "identity")
       {
-        applyErosionSimple_(struc_size, input, input_end, output);
-        return;
+        std::copy(input_begin, input_end, output_begin);
       }
+      else if (method == "erosion")
       {
-        // lower margin area
-        current = input[0];
-        for (++ii; ii < struc_size_half; ++ii)
-          if (current > input[ii])
-            current = input[ii];
-        for (; ii < std::min(Int(struc_size), size); ++ii, ++oi)
-        {
-          if (current > input[ii])
-            current = input[ii];
-          output[oi] = current;
-        }
+        applyErosion_(struc_size, input_begin, input_end, output_begin);
       }
+      else if (method == "dilation")
       {
-        // middle (main) area
-        for (anchor = struc_size; anchor <= size - struc_size; anchor += struc_size)
-        {
-          ii = anchor;
-          current = input[ii];
-          buffer[0] = current;
-          for (i = 1; i < struc_size; ++i, ++ii)
-          {
-            if (current > input[ii])
-              current = input[ii];
-            buffer[i] = current;
-          }
-          ii = anchor - 1;
-          oi = ii + struc_size_half;
-          current = input[ii];
-          for (i = 1; i < struc_size; ++i, --ii, --oi)
-          {
-            if (current > input[ii])
-              current = input[ii];
-            output[oi] = std::min(buffer[struc_size - i], current);
-          }
-          if (current > input[ii])
-            current = input[ii];
-          output[oi] = current;
-        }
+        applyDilation_(struc_size, input_begin, input_end, output_begin);
       }
+      else if (method == "opening")
       {
-        // higher margin area
-        ii = size - 1;
-        oi = ii;
-        current = input[ii];
-        for (--ii; ii >= size - struc_size_half; --ii)
-          if (current > input[ii])
-            current = input[ii];
-        for (; ii >= std::max(size - Int(struc_size), 0); --ii, --oi)
-        {
-          if (current > input[ii])
-            current = input[ii];
-          output[oi] = current;
-        }
-        anchor = size - struc_size;
-        ii = anchor;
-        current = input[ii];
-        buffer[0] = current;
-        for (i = 1; i < struc_size; ++i, ++ii)
-        {
-          if (current > input[ii])
-            current = input[ii];
-          buffer[i] = current;
-        }
-        ii = anchor - 1;
-        oi = ii + struc_size_half;
-        current = input[ii];
-        for (i = 1; (ii >= 0) && (i < struc_size); ++i, --ii, --oi)
-        {
-          if (current > input[ii])
-            current = input[ii];
-          output[oi] = std::min(buffer[struc_size - i], current);
-        }
-        if (ii >= 0)
-        {
-          if (current > input[ii])
-            current = input[ii];
-          output[oi] = current;
-        }
+        buffer.resize(size);
+        applyErosion_(struc_size, input_begin, input_end, buffer.begin());
+        applyDilation_(struc_size, buffer.begin(), buffer.end(), output_begin);
+      }
+      else if (method == "closing")
+      {
+        buffer.resize(size);
+        applyDilation_(struc_size, input_begin, input_end, buffer.begin());
+        applyErosion_(struc_size, buffer.begin(), buffer.end(), output_begin);
+      }
+      else if (method == "gradient")
+      {
+        buffer.resize(size);
+        applyErosion_(struc_size, input_begin, input_end, buffer.begin());
+        applyDilation_(struc_size, input_begin, input_end, output_begin);
+        for (UInt i = 0; i < size; ++i)
+          output_begin[i] -= buffer[i];
+      }
+      else if (method == "tophat")
+      {
+        buffer.resize(size);
+        applyErosion_(struc_size, input_begin, input_end, buffer.begin());
+        applyDilation_(struc_size, buffer.begin(), buffer.end(), output_begin);
+        for (UInt i = 0; i < size; ++i)
+          output_begin[i] = input_begin[i] - output_begin[i];
+      }
+      else if (method == "bothat")
+      {
+        buffer.resize(size);
+        applyDilation_(struc_size, input_begin, input_end, buffer.begin());
+        applyErosion_(struc_size, buffer.begin(), buffer.end(), output_begin);
+        for (UInt i = 0; i < size; ++i)
+          output_begin[i] = input_begin[i] - output_begin[i];
+      }
+      else if (method == "erosion_simple")
+      {
+        applyErosionSimple_(struc_size, input_begin, input_end, output_begin);
+      }
+      else if (method == "dilation_simple")
+      {
+        applyDilationSimple_(struc_size, input_begin, input_end, output_begin);
       }
-      return;
     }
 
-    /** @brief Applies dilation.  This implementation uses van Herk's method.
+    /** @brief Applies erosion.  This implementation uses van Herk's method.
     Only 3 min/max comparisons are required per data point, independent of
     struc_size.
     */
     template<typename InputIterator, typename OutputIterator>
-    void applyDilation_(Int struc_size, InputIterator input, InputIterator input_end, OutputIterator output)
+    void applyErosion_(Int struc_size, InputIterator input, InputIterator input_end, OutputIterator output) const
     {
       typedef typename InputIterator::value_type ValueType;
-      const Int size = input_end - input;
-      const Int struc_size_half = struc_size / 2; // yes, integer division
+      applyVanHerk_(struc_size, input, input_end, output, [](ValueType a, ValueType b) { return std::min(a, b); });
+    }
 
-      static std::vector<ValueType> buffer;
-      if (Int(buffer.size()) < struc_size)
-        buffer.resize(struc_size);
+    /** @brief Applies dilation.  This implementation uses van Herk's method.
+    Only 3 min/max comparisons are required per data point, independent of
+    struc_size.
+    */
+    template<typename InputIterator, typename OutputIterator>
+    void applyDilation_(Int struc_size, InputIterator input, InputIterator input_end, OutputIterator output) const
+    {
+      typedef typename InputIterator::value_type ValueType;
+      applyVanHerk_(struc_size, input, input_end, output, [](ValueType a, ValueType b) { return std::max(a, b); });
+    }
 
-      Int anchor;        // anchoring position of the current block
-      Int i;             // index relative to anchor, used for 'for' loops
-      Int ii = 0;        // input index
-      Int oi = 0;        // output index
-      ValueType current; // current value
+    /** @brief van Herk/Gil-Werman sliding window for erosion (@p select is min) and dilation (@p select is max).
 
-      // we just can't get the case distinctions right in these cases, resorting to simple method.
-      if (size <= struc_size || size <= 5)
-      {
-        applyDilationSimple_(struc_size, input, input_end, output);
-        return;
-      }
-      {
-        // lower margin area
-        current = input[0];
-        for (++ii; ii < struc_size_half; ++ii)
-          if (current < input[ii])
-            current = input[ii];
-        for (; ii < std::min(Int(struc_size), size); ++ii, ++oi)
-        {
-          if (current < input[ii])
-            current = input[ii];
-          output[oi] = current;
-        }
-      }
-      {
-        // middle (main) area
-        for (anchor = struc_size; anchor <= size - struc_size; anchor += struc_size)
-        {
-          ii = anchor;
-          current = input[ii];
-          buffer[0] = current;
-          for (i = 1; i < struc_size; ++i, ++ii)
-          {
-            if (current < input[ii])
-              current = input[ii];
-            buffer[i] = current;
-          }
-          ii = anchor - 1;
-          oi = ii + struc_size_half;
-          current = input[ii];
-          for (i = 1; i < struc_size; ++i, --ii, --oi)
-          {
-            if (current < input[ii])
-              current = input[ii];
-            output[oi] = std::max(buffer[struc_size - i], current);
-          }
-          if (current < input[ii])
-            current = input[ii];
-          output[oi] = current;
-        }
-      }
-      {
-        // higher margin area
-        ii = size - 1;
-        oi = ii;
-        current = input[ii];
-        for (--ii; ii >= size - struc_size_half; --ii)
-          if (current < input[ii])
-            current = input[ii];
-        for (; ii >= std::max(size - Int(struc_size), 0); --ii, --oi)
-        {
-          if (current < input[ii])
-            current = input[ii];
-          output[oi] = current;
-        }
-        anchor = size - struc_size;
-        ii = anchor;
-        current = input[ii];
-        buffer[0] = current;
-        for (i = 1; i < struc_size; ++i, ++ii)
-        {
-          if (current < input[ii])
-            current = input[ii];
-          buffer[i] = current;
-        }
-        ii = anchor - 1;
-        oi = ii + struc_size_half;
-        current = input[ii];
-        for (i = 1; (ii >= 0) && (i < struc_size); ++i, --ii, --oi)
-        {
-          if (current < input[ii])
-            current = input[ii];
-          output[oi] = std::max(buffer[struc_size - i], current);
-        }
-        if (ii >= 0)
-        {
-          if (current < input[ii])
-            current = input[ii];
-          output[oi] = current;
-        }
-      }
-      return;
+    The input is split into blocks of the window length; the result for each window is the combination of
+    the running extremum from its start to the end of its block and from the start of the next block to
+    its end. The windows are the same as in the simple methods, i.e. clipped at the borders.
+    */
+    template<typename InputIterator, typename OutputIterator, typename Select>
+    void applyVanHerk_(Int struc_size, InputIterator input, InputIterator input_end, OutputIterator output, Select select) const
+    {
+      typedef typename InputIterator::value_type ValueType;
+      const Int size = input_end - input;
+      const Int struc_size_half = struc_size / 2; // yes, integer division
+      const Int block = 2 * struc_size_half + 1; // window length
+
+      // running extrema within each block, forward from its start and backward from its end
+      std::vector<ValueType> forward(size), backward(size);
+      for (Int start = 0; start < size; start += block)
+      {
+        const Int stop = std::min(start + block, size);
+        forward[start] = input[start];
+        for (Int i = start + 1; i < stop; ++i)
+          forward[i] = select(forward[i - 1], input[i]);
+        backward[stop - 1] = input[stop - 1];
+        for (Int i = stop - 2; i >= start; --i)
+          backward[i] = select(backward[i + 1], input[i]);
+      }
+
+      // windows that are clipped at the borders
+      auto clipped = [&](Int index)
+      {
+        const Int lo = std::max(0, index - struc_size_half);
+        const Int hi = std::min(size - 1, index + struc_size_half);
+        if (lo % block == 0)
+          return forward[hi];
+        if (lo / block == hi / block) // only at the upper border
+          return backward[lo];
+        return select(backward[lo], forward[hi]);
+      };
+
+      const Int lower_end = std::min(struc_size_half, size);
+      const Int middle_end = std::max(lower_end, size - struc_size_half);
+      Int index = 0;
+      for (; index < lower_end; ++index)
+        output[index] = clipped(index);
+      // full windows span two blocks (or exactly one, where both terms are equal)
+      for (; index < middle_end; ++index)
+        output[index] = select(backward[index - struc_size_half], forward[index + struc_size_half]);
+      for (; index < size; ++index)
+        output[index] = clipped(index);
     }
 
     /// Applies erosion.  Simple implementation, possibly faster if struc_size is very small, and used in some special cases.
     template<typename InputIterator, typename OutputIterator>
-    void applyErosionSimple_(Int struc_size, InputIterator input_begin, InputIterator input_end, OutputIterator output_begin)
+    void applyErosionSimple_(Int struc_size, InputIterator input_begin, InputIterator input_end, OutputIterator output_begin) const
     {
       typedef typename InputIterator::value_type ValueType;
       const int size = input_end - input_begin;
@@ -558,7 +405,7 @@ namespace OpenMS
 
     /// Applies dilation.  Simple implementation, possibly faster if struc_size is very small, and used in some special cases.
     template<typename InputIterator, typename OutputIterator>
-    void applyDilationSimple_(Int struc_size, InputIterator input_begin, InputIterator input_end, OutputIterator output_begin)
+    void applyDilationSimple_(Int struc_size, InputIterator input_begin, InputIterator input_end, OutputIterator output_begin) const
     {
       typedef typename InputIterator::value_type ValueType;
       const int size = input_end - input_begin;
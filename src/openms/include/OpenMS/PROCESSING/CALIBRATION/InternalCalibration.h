@@ -16,6 +16,7 @@
 #include <OpenMS/PROCESSING/CALIBRATION/MZTrafoModel.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 
+#include <map>
 #include <vector>
 
 namespace OpenMS
@@ -171,6 +172,17 @@ namespace OpenMS
                    const String& file_residuals_plot = "",
                    const String& rscript_executable = "Rscript");
 
+    /**
+      @brief Get the models applied by the last call of calibrate()
+
+      Maps the native ID of each calibrated spectrum to the model which was applied to it (its data or its precursors).
+      This allows to compute the calibration on a map without (or with only some) peak data, e.g. one loaded using
+      PeakFileOptions::setFillData(false), and to apply it to the full data while streaming it.
+
+      @return Models by native ID of the spectrum (spectra which were not calibrated are not contained)
+    */
+    const std::map<String, MZTrafoModel>& getSpectrumModels() const;
+
     /**
       @brief Transform a precursor's m/z
 
@@ -270,6 +282,7 @@ namespace OpenMS
 
   private:
     CalibrationData cal_data_;
+    std::map<String, MZTrafoModel> spectrum_models_;
   }; // class InternalCalibration
   
 } // namespace OpenMS
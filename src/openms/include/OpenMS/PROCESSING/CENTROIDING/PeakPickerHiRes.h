@@ -18,6 +18,7 @@
 //#undef DEBUG_DECONV
 namespace OpenMS
 {
+  class ColumnarSpectrum;
   class MSChromatogram;
   class OnDiscMSExperiment;
 
@@ -112,6 +113,25 @@ public:
      */
     void pick(const MSChromatogram& input, MSChromatogram& output, std::vector<PeakBoundary>& boundaries, bool check_spacings = false) const;
 
+    /**
+      @brief Applies the peak-picking algorithm to a single spectrum in
+      column-oriented layout. The resulting picked peaks are written to the
+      output spectrum, the ion mobility of each picked peak (if the input has
+      an ion mobility column) is written to the ion mobility column.
+
+      @note The input is converted to an MSSpectrum for picking (the signal-to-noise
+      estimator operates on MSSpectrum). FWHM values (see parameter 'report_FWHM')
+      are not reported.
+
+      @param input  input spectrum in profile mode
+      @param output  output spectrum with picked peaks
+      @param boundaries  boundaries of the picked peaks
+     */
+    void pick(const ColumnarSpectrum& input, ColumnarSpectrum& output, std::vector<PeakBoundary>& boundaries) const;
+
+    /// Same as above, without returning the peak boundaries
+    void pick(const ColumnarSpectrum& input, ColumnarSpectrum& output) const;
+
     /**
       @brief Applies the peak-picking algorithm to a map (MSExperiment). This
       method picks peaks for each scan in the map consecutively. The resulting
@@ -34,12 +34,22 @@ namespace OpenMS
               If the FeatureOverlapCallback returns false, the overlapping feature will be treated as not overlapping with best_in_cluster (and not removed).
               Default: function that just returns true.
 
+        @param check_overlap_at_trace_level If true, features overlap only if the bounding boxes of (at least) two of their mass traces overlap.
+               Requires the convex hulls of the mass traces.
+
+        @param parallel If true, clusters of (transitively) overlapping features are resolved in parallel.
+               The result is the same as for serial processing, but FeatureOverlapCallback is called concurrently (for features of different clusters),
+               so it must not modify state other than its arguments without synchronization.
+
+        @exception Exception::MissingInformation is thrown if @p check_overlap_at_trace_level is set and convex hulls of mass traces are missing
+
         @ingroup Datareduction
     */
     static void filter(FeatureMap& fmap, 
       std::function<bool(const Feature&, const Feature&)> FeatureComparator = [](const Feature& left, const Feature& right){ return left.getOverallQuality() > right.getOverallQuality(); },
       std::function<bool(Feature&, Feature&)> FeatureOverlapCallback = [](Feature&, Feature&){ return true; },
-      bool check_overlap_at_trace_level = true);
+      bool check_overlap_at_trace_level = true,
+      bool parallel = false);
   };
 
 }
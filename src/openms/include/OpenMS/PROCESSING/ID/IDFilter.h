@@ -21,7 +21,9 @@
 #include <OpenMS/config.h>
 #include <algorithm>
 #include <climits>
+#include <exception>
 #include <functional>
+#include <limits>
 #include <map>
 #include <set>
 #include <unordered_set>
@@ -41,6 +43,8 @@ namespace OpenMS
     A few filters work on the ID level instead, i.e. they remove peptide or protein IDs from vectors thereof.
     Independent of this, the inputs for all filter functions are vectors of IDs, because the data most often comes in this form.
     This design also allows many helper objects to be set up only once per vector, rather than once per ID.
+    Filters on the hit level process the IDs of a vector in parallel (if OpenMP is enabled) and compact the hits of each ID in place.
+    Several such filters can be combined into a HitFilterPipeline, which applies all of them in a single traversal of the IDs.
 
     The filter functions for vectors of peptide/protein IDs do not include clean-up steps (e.g. removal of IDs without hits, reassignment of hit ranks, ...).
     They only carry out their specific filtering operations.
@@ -480,6 +484,42 @@ namespace OpenMS
     */
     ///@{
 
+    /**
+       @brief Apply @p f to every item of a container (e.g. vector of IDs, feature map), in parallel if OpenMP is enabled
+
+       @p f must only modify the item it is given.
+       If @p f throws for some items, all other items are still processed; afterwards the exception of the first failing item (in container order) is re-thrown.
+    */
+    template<class Container, class Function>
+    static void parallelForEach(Container& items, const Function& f)
+    {
+      std::exception_ptr error;
+      SignedSize error_index = std::numeric_limits<SignedSize>::max();
+#pragma omp parallel for schedule(dynamic, 256)
+      for (SignedSize i = 0; i < (SignedSize)items.size(); ++i)
+      {
+        try
+        {
+          f(items[i]);
+        }
+        catch (...)
+        {
+#pragma omp critical (IDFilter_parallelForEach)
+          {
+            if (i < error_index)
+            {
+              error_index = i;
+              error = std::current_exception();
+            }
+          }
+        }
+      }
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+    }
+
     /// Remove items that satisfy a condition from a container (e.g. vector)
     template<class Container, class Predicate>
     static void removeMatchingItems(Container& items, const Predicate& pred)
@@ -507,55 +547,179 @@ namespace OpenMS
     template<class IDContainer, class Predicate>
     static void removeMatchingItemsUnroll(IDContainer& items, const Predicate& pred)
     {
-      for (auto& item : items)
-      {
-        removeMatchingItems(item.getHits(), pred);
-      }
+      parallelForEach(items, [&pred](auto& item) { removeMatchingItems(item.getHits(), pred); });
     }
 
     /// Keep Hit items that satisfy a condition in one of our ID containers (e.g. vector of Peptide or ProteinIDs)
     template<class IDContainer, class Predicate>
     static void keepMatchingItemsUnroll(IDContainer& items, const Predicate& pred)
     {
-      for (auto& item : items)
-      {
-        keepMatchingItems(item.getHits(), pred);
-      }
+      parallelForEach(items, [&pred](auto& item) { keepMatchingItems(item.getHits(), pred); });
     }
 
     template<class MapType, class Predicate>
     static void keepMatchingPeptideHits(MapType& prot_and_pep_ids, Predicate& pred)
     {
-      for (auto& feat : prot_and_pep_ids)
-      {
-        keepMatchingItemsUnroll(feat.getPeptideIdentifications(), pred);
-      }
+      // parallel over features (each has only a few IDs)
+      parallelForEach(prot_and_pep_ids, [&pred](auto& feat) {
+        for (auto& pep : feat.getPeptideIdentifications())
+        {
+          keepMatchingItems(pep.getHits(), pred);
+        }
+      });
       keepMatchingItemsUnroll(prot_and_pep_ids.getUnassignedPeptideIdentifications(), pred);
     }
 
     template<class MapType, class Predicate>
     static void removeMatchingPeptideHits(MapType& prot_and_pep_ids, Predicate& pred)
     {
-      for (auto& feat : prot_and_pep_ids)
-      {
-        removeMatchingItemsUnroll(feat.getPeptideIdentifications(), pred);
-      }
+      parallelForEach(prot_and_pep_ids, [&pred](auto& feat) {
+        for (auto& pep : feat.getPeptideIdentifications())
+        {
+          removeMatchingItems(pep.getHits(), pred);
+        }
+      });
       removeMatchingItemsUnroll(prot_and_pep_ids.getUnassignedPeptideIdentifications(), pred);
     }
 
     template<class MapType, class Predicate>
     static void removeMatchingPeptideIdentifications(MapType& prot_and_pep_ids, Predicate& pred)
     {
-      for (auto& feat : prot_and_pep_ids)
-      {
-        removeMatchingItems(feat.getPeptideIdentifications(), pred);
-      }
+      parallelForEach(prot_and_pep_ids, [&pred](auto& feat) { removeMatchingItems(feat.getPeptideIdentifications(), pred); });
       removeMatchingItems(prot_and_pep_ids.getUnassignedPeptideIdentifications(), pred);
     }
 
     ///@}
 
 
+    /// @name Filter pipeline
+    ///@{
+
+    /**
+       @brief Chain of hit filters that is applied to a vector of peptide or protein IDs in a single traversal.
+
+       The filters are collected first and then applied by apply(): for every ID (in parallel), each hit is tested against all filters in the order they were added (stopping at the first one it fails), and the hits of the ID are compacted in place once.
+       The result is the same as applying the corresponding filter functions one after the other, but the IDs are traversed only once.
+
+       Example:
+       @code
+       IDFilter::HitFilterPipeline<PeptideIdentification> pipeline;
+       pipeline.keepByScore(0.01).removeDecoys().keepMatching(IDFilter::HasMetaValue<PeptideHit>("protein_references", "unique"));
+       pipeline.apply(peptides);
+       @endcode
+
+       @note The ranks of the hits may be invalidated.
+    */
+    template<class IdentificationType>
+    class HitFilterPipeline
+    {
+    public:
+      /// Type of the hits (PeptideHit or ProteinHit)
+      typedef typename IdentificationType::HitType HitType;
+
+      /// Filter for a hit and its ID: returns true if the hit is kept (must not access the hits of the ID)
+      typedef std::function<bool(const IdentificationType&, const HitType&)> HitPredicate;
+
+      /// Keeps hits for which @p pred returns true
+      HitFilterPipeline& keepIf(HitPredicate pred)
+      {
+        filters_.push_back(std::move(pred));
+        return *this;
+      }
+
+      /// Keeps hits that satisfy @p pred (a predicate for hits, e.g. HasMetaValue; copied, so it must not refer to temporaries)
+      template<class Predicate>
+      HitFilterPipeline& keepMatching(const Predicate& pred)
+      {
+        return keepIf([pred](const IdentificationType&, const HitType& hit) { return bool(pred(hit)); });
+      }
+
+      /// Removes hits that satisfy @p pred (a predicate for hits, e.g. HasMetaValue)
+      template<class Predicate>
+      HitFilterPipeline& removeMatching(const Predicate& pred)
+      {
+        return keepIf([pred](const IdentificationType&, const HitType& hit) { return !pred(hit); });
+      }
+
+      /// Keeps hits with a score at least as good as @p threshold_score (as filterHitsByScore())
+      HitFilterPipeline& keepByScore(double threshold_score)
+      {
+        return keepIf([threshold_score](const IdentificationType& id, const HitType& hit) {
+          return HasGoodScore<HitType>(threshold_score, id.isHigherScoreBetter())(hit);
+        });
+      }
+
+      /// Removes hits annotated as decoys (as removeDecoyHits())
+      HitFilterPipeline& removeDecoys()
+      {
+        return removeMatching(HasDecoyAnnotation<HitType>());
+      }
+
+      /// Keeps hits with a matching protein accession (as keepHitsMatchingProteins(); @p accessions is copied)
+      HitFilterPipeline& keepMatchingProteins(const std::set<String>& accessions)
+      {
+        // HasMatchingAccession only refers to the accessions, so the filter keeps its own copy
+        return keepIf([accessions](const IdentificationType&, const HitType& hit) { return HasMatchingAccession<HitType>(accessions)(hit); });
+      }
+
+      /// Removes hits with a matching protein accession (as removeHitsMatchingProteins(); @p accessions is copied)
+      HitFilterPipeline& removeMatchingProteins(const std::set<String>& accessions)
+      {
+        return keepIf([accessions](const IdentificationType&, const HitType& hit) { return !HasMatchingAccession<HitType>(accessions)(hit); });
+      }
+
+      /// Should IDs without hits be removed at the end of apply()? (default: no)
+      HitFilterPipeline& setRemoveEmptyIdentifications(bool remove)
+      {
+        remove_empty_ = remove;
+        return *this;
+      }
+
+      /// Number of filters
+      Size size() const
+      {
+        return filters_.size();
+      }
+
+      /// Applies all filters to the hits of @p ids
+      void apply(std::vector<IdentificationType>& ids) const
+      {
+        if (!filters_.empty())
+        {
+          parallelForEach(ids, [this](IdentificationType& id) {
+            std::vector<HitType>& hits = id.getHits();
+            hits.erase(std::remove_if(hits.begin(), hits.end(), [this, &id](const HitType& hit) { return !keep_(id, hit); }), hits.end());
+          });
+        }
+        if (remove_empty_)
+        {
+          IDFilter::removeEmptyIdentifications(ids);
+        }
+      }
+
+    private:
+      bool keep_(const IdentificationType& id, const HitType& hit) const
+      {
+        for (const HitPredicate& filter : filters_)
+        {
+          if (!filter(id, hit))
+          {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      /// Filters, in the order they were added
+      std::vector<HitPredicate> filters_;
+
+      /// Remove IDs without hits after filtering?
+      bool remove_empty_ = false;
+    };
+
+    ///@}
+
+
     /// @name Helper functions
     ///@{
 
@@ -674,10 +838,7 @@ namespace OpenMS
     template<class IdentificationType>
     static void updateHitRanks(std::vector<IdentificationType>& ids)
     {
-      for (typename std::vector<IdentificationType>::iterator it = ids.begin(); it != ids.end(); ++it)
-      {
-        it->assignRanks();
-      }
+      parallelForEach(ids, [](IdentificationType& id) { id.assignRanks(); });
     }
 
     /// Removes protein hits from the protein IDs in a @p cmap that are not referenced by a peptide in the features
@@ -716,6 +877,15 @@ namespace OpenMS
     */
     static void updateProteinReferences(ConsensusMap& cmap, const ProteinIdentification& ref_run, bool remove_peptides_without_reference = false);
 
+    /**
+       @brief Removes references to missing proteins from the peptide IDs of all spectra
+
+       Only PeptideEvidence entries that reference protein hits in the protein IDs of @p experiment are kept in the peptide hits.
+
+       If @p remove_peptides_without_reference is set, peptide hits without any remaining protein reference are removed.
+    */
+    static void updateProteinReferences(PeakMap& experiment, bool remove_peptides_without_reference = false);
+
     /**
        @brief Update protein groups after protein hits were filtered
 
@@ -755,11 +925,10 @@ namespace OpenMS
     template<class IdentificationType>
     static void filterHitsByScore(std::vector<IdentificationType>& ids, double threshold_score)
     {
-      for (typename std::vector<IdentificationType>::iterator id_it = ids.begin(); id_it != ids.end(); ++id_it)
-      {
-        struct HasGoodScore<typename IdentificationType::HitType> score_filter(threshold_score, id_it->isHigherScoreBetter());
-        keepMatchingItems(id_it->getHits(), score_filter);
-      }
+      parallelForEach(ids, [threshold_score](IdentificationType& id) {
+        struct HasGoodScore<typename IdentificationType::HitType> score_filter(threshold_score, id.isHigherScoreBetter());
+        keepMatchingItems(id.getHits(), score_filter);
+      });
     }
 
     /**
@@ -790,12 +959,11 @@ namespace OpenMS
     template<class IdentificationType>
     static void keepNBestHits(std::vector<IdentificationType>& ids, Size n)
     {
-      for (typename std::vector<IdentificationType>::iterator id_it = ids.begin(); id_it != ids.end(); ++id_it)
-      {
-        id_it->sort();
-        if (n < id_it->getHits().size())
-          id_it->getHits().resize(n);
-      }
+      parallelForEach(ids, [n](IdentificationType& id) {
+        id.sort();
+        if (n < id.getHits().size())
+          id.getHits().resize(n);
+      });
     }
 
     /**
@@ -819,18 +987,12 @@ namespace OpenMS
       if (min_rank > 1)
       {
         struct HasMaxRank<typename IdentificationType::HitType> rank_filter(min_rank - 1);
-        for (typename std::vector<IdentificationType>::iterator id_it = ids.begin(); id_it != ids.end(); ++id_it)
-        {
-          removeMatchingItems(id_it->getHits(), rank_filter);
-        }
+        removeMatchingItemsUnroll(ids, rank_filter);
       }
       if (max_rank >= min_rank)
       {
         struct HasMaxRank<typename IdentificationType::HitType> rank_filter(max_rank);
-        for (typename std::vector<IdentificationType>::iterator id_it = ids.begin(); id_it != ids.end(); ++id_it)
-        {
-          keepMatchingItems(id_it->getHits(), rank_filter);
-        }
+        keepMatchingItemsUnroll(ids, rank_filter);
       }
     }
 
@@ -845,10 +1007,7 @@ namespace OpenMS
     static void removeDecoyHits(std::vector<IdentificationType>& ids)
     {
       struct HasDecoyAnnotation<typename IdentificationType::HitType> decoy_filter;
-      for (typename std::vector<IdentificationType>::iterator id_it = ids.begin(); id_it != ids.end(); ++id_it)
-      {
-        removeMatchingItems(id_it->getHits(), decoy_filter);
-      }
+      removeMatchingItemsUnroll(ids, decoy_filter);
     }
 
     /**
@@ -862,10 +1021,7 @@ namespace OpenMS
     static void removeHitsMatchingProteins(std::vector<IdentificationType>& ids, const std::set<String> accessions)
     {
       struct HasMatchingAccession<typename IdentificationType::HitType> acc_filter(accessions);
-      for (auto& id_it : ids)
-      {
-        removeMatchingItems(id_it.getHits(), acc_filter);
-      }
+      removeMatchingItemsUnroll(ids, acc_filter);
     }
 
     /**
@@ -879,10 +1035,7 @@ namespace OpenMS
     static void keepHitsMatchingProteins(std::vector<IdentificationType>& ids, const std::set<String>& accessions)
     {
       struct HasMatchingAccession<typename IdentificationType::HitType> acc_filter(accessions);
-      for (auto& id_it : ids)
-      {
-        keepMatchingItems(id_it.getHits(), acc_filter);
-      }
+      keepMatchingItemsUnroll(ids, acc_filter);
     }
 
     ///@}
@@ -1012,14 +1165,16 @@ namespace OpenMS
       // don't remove empty protein IDs - they contain search metadata and may
       // be referenced by peptide IDs (via run ID)
 
-      // filter peptide hits:
-      for (PeakMap::Iterator exp_it = experiment.begin(); exp_it != experiment.end(); ++exp_it)
-      {
-        filterHitsByScore(exp_it->getPeptideIdentifications(), peptide_threshold_score);
-        removeEmptyIdentifications(exp_it->getPeptideIdentifications());
-        // TODO super-duper inefficient.
-        updateProteinReferences(exp_it->getPeptideIdentifications(), experiment.getProteinIdentifications());
-      }
+      // filter peptide hits (in parallel over spectra):
+      parallelForEach(experiment, [peptide_threshold_score](MSSpectrum& spectrum) {
+        std::vector<PeptideIdentification>& peptides = spectrum.getPeptideIdentifications();
+        for (PeptideIdentification& pep : peptides)
+        {
+          filterHitsByScore(pep, peptide_threshold_score);
+        }
+        removeEmptyIdentifications(peptides);
+      });
+      updateProteinReferences(experiment);
       // @TODO: remove proteins that aren't referenced by peptides any more?
     }
 
@@ -1030,14 +1185,21 @@ namespace OpenMS
       // and update the protein hits!
       std::vector<PeptideIdentification> all_peptides; // IDs from all spectra
 
-      // filter peptide hits:
-      for (PeakMap::Iterator exp_it = experiment.begin(); exp_it != experiment.end(); ++exp_it)
-      {
-        std::vector<PeptideIdentification>& peptides = exp_it->getPeptideIdentifications();
-        keepNBestHits(peptides, n);
+      // filter peptide hits (in parallel over spectra):
+      parallelForEach(experiment, [n](MSSpectrum& spectrum) {
+        std::vector<PeptideIdentification>& peptides = spectrum.getPeptideIdentifications();
+        for (PeptideIdentification& pep : peptides)
+        {
+          pep.sort();
+          if (n < pep.getHits().size())
+            pep.getHits().resize(n);
+        }
         removeEmptyIdentifications(peptides);
-        updateProteinReferences(peptides, experiment.getProteinIdentifications());
-        all_peptides.insert(all_peptides.end(), peptides.begin(), peptides.end());
+      });
+      updateProteinReferences(experiment);
+      for (const MSSpectrum& spectrum : experiment)
+      {
+        all_peptides.insert(all_peptides.end(), spectrum.getPeptideIdentifications().begin(), spectrum.getPeptideIdentifications().end());
       }
       // update protein hits:
       removeUnreferencedProteins(experiment.getProteinIdentifications(), all_peptides);
@@ -1268,6 +1430,16 @@ namespace OpenMS
     */
     static void removeDecoys(IdentificationData& id_data);
     ///@}
+
+  protected:
+    /// Valid protein accessions of the ID run @p run_id (empty if there is no such run); safe to call from several threads
+    static const std::unordered_set<String>& accessionsOfRun_(const std::map<String, std::unordered_set<String>>& run_to_accessions, const String& run_id);
+
+    /// Keeps only peptide evidences with protein accessions in @p accessions in the hits of @p pep (and optionally removes hits without evidences)
+    static void keepMatchingEvidences_(PeptideIdentification& pep, const std::unordered_set<String>& accessions, bool remove_peptides_without_reference);
+
+    /// Applies @p f to all peptide IDs (assigned and unassigned) of @p cmap, in parallel
+    static void applyOnPeptideIDs_(ConsensusMap& cmap, const std::function<void(PeptideIdentification&)>& f);
   };
 
 } // namespace OpenMS
@@ -15,6 +15,8 @@
 #include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 #include <vector>
+#include <set>
+#include <exception>
 #include <algorithm> //for std::max_element
 
 namespace OpenMS
@@ -39,6 +41,13 @@ namespace OpenMS
     case you should increase <i>max_intensity</i> (and optionally the
     <i>bin_count</i>).
 
+    Alternatively, the median of each window can be computed exactly (param:
+    <i>exact_median</i>). The window content is then kept in two balanced
+    ordered sets (lower and upper half), so sliding the window costs
+    O(log w) per data point and neither <i>max_intensity</i> nor
+    <i>bin_count</i> are used. As for the histogram, the lower median (the
+    ceil(n/2)-th smallest intensity) is reported for windows with an even number of elements.
+
     Changing any of the parameters will invalidate the S/N values (which will invoke a recomputation on the next request).
 
     @note If more than 20 percent of windows have less than <i>min_required_elements</i> of elements, a warning is issued to <i>OPENMS_LOG_WARN</i> and noise estimates in those windows are set to the constant <i>noise_for_empty_window</i>.
@@ -107,6 +116,9 @@ public:
 
       defaults_.setValue("noise_for_empty_window", std::pow(10.0, 20), "noise value used for sparse windows", {"advanced"});
 
+      defaults_.setValue("exact_median", "false", "Compute the exact median intensity of each window (using ordered sets) instead of the histogram based approximation. 'max_intensity', 'auto_mode' and 'bin_count' are ignored in this case.", {"advanced"});
+      defaults_.setValidStrings("exact_median", {"true","false"});
+
       defaults_.setValue("write_log_messages", "true", "Write out log messages in case of sparse windows or median in rightmost histogram bin");
       defaults_.setValidStrings("write_log_messages", {"true","false"});
 
@@ -151,6 +163,55 @@ public:
       return histogram_oob_percent_;
     }
 
+    /**
+      @brief Computes the S/N values of all data points of all @p containers (e.g. MSExperiment::getSpectra() or MSExperiment::getChromatograms()) in parallel
+
+      Each container is processed independently by a copy of this estimator
+      (using its current parameters), so the result equals calling init() and
+      getSignalToNoise() for each container in turn. The state of this
+      estimator is not changed.
+
+      @return One vector of S/N values per container (in the order of @p containers)
+      @exception Throws Exception::InvalidValue (see init())
+    */
+    std::vector<std::vector<double>> estimateAll(const std::vector<Container>& containers) const
+    {
+      std::vector<std::vector<double>> result(containers.size());
+      std::exception_ptr error;
+      SignedSize error_index = (SignedSize)containers.size();
+
+#pragma omp parallel
+      {
+        SignalToNoiseEstimatorMedian sne(*this);
+        sne.setLogType(ProgressLogger::NONE);
+
+#pragma omp for schedule(dynamic)
+        for (SignedSize i = 0; i < (SignedSize)containers.size(); ++i)
+        {
+          try
+          {
+            sne.computeSTN_(containers[i]);
+            result[i].swap(sne.stn_estimates_);
+          }
+          catch (...)
+          {
+#pragma omp critical (SignalToNoiseEstimatorMedian_estimateAll)
+            {
+              // report the first failing container, independent of the thread schedule
+              if (i < error_index)
+              {
+                error_index = i;
+                error = std::current_exception();
+              }
+            }
+          }
+        }
+      }
+
+      if (error) std::rethrow_exception(error);
+      return result;
+    }
+
 protected:
 
 
@@ -175,6 +236,12 @@ protected:
       stn_estimates_.clear();
       stn_estimates_.resize(c.size());
 
+      if (exact_median_)
+      {
+        computeSTNExact_(c);
+        return;
+      }
+
       // maximal range of histogram needs to be calculated first
       if (auto_mode_ == AUTOMAXBYSTDEV)
       {
@@ -346,14 +413,7 @@ protected:
       sparse_window_percent_ = sparse_window_percent_ * 100 / window_count;
       histogram_oob_percent_ = histogram_oob_percent_ * 100 / window_count;
 
-      // warn if percentage of sparse windows is above 20%
-      if (sparse_window_percent_ > 20 && write_log_messages_)
-      {
-        OPENMS_LOG_WARN << "WARNING in SignalToNoiseEstimatorMedian: "
-                 << sparse_window_percent_
-                 << "% of all windows were sparse. You should consider increasing 'win_len' or decreasing 'min_required_elements'"
-                 << std::endl;
-      }
+      warnSparseWindows_();
 
       // warn if percentage of possibly wrong median estimates is above 1%
       if (histogram_oob_percent_ > 1 && write_log_messages_)
@@ -367,6 +427,119 @@ protected:
 
     } // end of shiftWindow_
 
+    /**
+      @brief Sliding window S/N with the exact median of each window (see param 'exact_median')
+
+      The window is split into two ordered sets: @p lower holds the ceil(n/2)
+      smallest intensities, @p upper the rest. Elements entering or leaving the
+      window are inserted into/erased from the respective half, followed by
+      moving at most one element to restore the balance. The median is then
+      the largest element of @p lower.
+    */
+    void computeSTNExact_(const Container& c)
+    {
+      std::multiset<double> lower, upper;
+
+      auto rebalance = [&lower, &upper]()
+      {
+        if (lower.size() > upper.size() + 1)
+        {
+          auto it = std::prev(lower.end());
+          upper.insert(upper.begin(), *it);
+          lower.erase(it);
+        }
+        else if (lower.size() < upper.size())
+        {
+          lower.insert(lower.end(), *upper.begin());
+          upper.erase(upper.begin());
+        }
+      };
+
+      PeakIterator window_pos_center = c.begin();
+      PeakIterator window_pos_borderleft = c.begin();
+      PeakIterator window_pos_borderright = c.begin();
+
+      double window_half_size = win_len_ / 2;
+      int window_count = 0;
+
+      SignalToNoiseEstimator<Container>::startProgress(0, c.size(), "noise estimation of data");
+
+      while (window_pos_center != c.end())
+      {
+        // erase all elements that leave the window on the LEFT side
+        while ((*window_pos_borderleft).getMZ() < (*window_pos_center).getMZ() - window_half_size)
+        {
+          double intensity = (*window_pos_borderleft).getIntensity();
+          // all elements of 'upper' are >= the largest element of 'lower', so an equal value may be taken from 'lower'
+          if (intensity <= *lower.rbegin())
+          {
+            lower.erase(lower.find(intensity));
+          }
+          else
+          {
+            upper.erase(upper.find(intensity));
+          }
+          rebalance();
+          ++window_pos_borderleft;
+        }
+
+        // add all elements that enter the window on the RIGHT side
+        while ((window_pos_borderright != c.end())
+              && ((*window_pos_borderright).getMZ() <= (*window_pos_center).getMZ() + window_half_size))
+        {
+          double intensity = (*window_pos_borderright).getIntensity();
+          if (lower.empty() || intensity <= *lower.rbegin())
+          {
+            lower.insert(intensity);
+          }
+          else
+          {
+            upper.insert(intensity);
+          }
+          rebalance();
+          ++window_pos_borderright;
+        }
+
+        double noise;
+        if ((int)(lower.size() + upper.size()) < min_required_elements_)
+        {
+          noise = noise_for_empty_window_;
+          ++sparse_window_percent_;
+        }
+        else
+        {
+          // just avoid division by 0
+          noise = std::max(1.0, *lower.rbegin());
+        }
+
+        stn_estimates_[window_count] = (*window_pos_center).getIntensity() / noise;
+
+        ++window_pos_center;
+        ++window_count;
+        SignalToNoiseEstimator<Container>::setProgress(window_count);
+      }
+
+      SignalToNoiseEstimator<Container>::endProgress();
+
+      if (window_count > 0)
+      {
+        sparse_window_percent_ = sparse_window_percent_ * 100 / window_count;
+      }
+      warnSparseWindows_();
+    }
+
+    /// warn if percentage of sparse windows is above 20%
+    void warnSparseWindows_() const
+    {
+      if (sparse_window_percent_ > 20 && write_log_messages_)
+      {
+        OPENMS_LOG_WARN << "WARNING in SignalToNoiseEstimatorMedian: "
+                 << sparse_window_percent_
+                 << "% of all windows were sparse. You should consider increasing 'win_len' or decreasing 'min_required_elements'"
+                 << std::endl;
+      }
+    }
+
     /// overridden function from DefaultParamHandler to keep members up to date, when a parameter is changed
     void updateMembers_() override
     {
@@ -379,6 +552,7 @@ protected:
       min_required_elements_   = param_.getValue("min_required_elements");
       noise_for_empty_window_  = (double)param_.getValue("noise_for_empty_window");
       write_log_messages_      = (bool)param_.getValue("write_log_messages").toBool();
+      exact_median_            = param_.getValue("exact_median").toBool();
       stn_estimates_.clear();
     }
 
@@ -403,6 +577,9 @@ protected:
     // whether to write out log messages in the case of failure
     bool write_log_messages_;
 
+    /// compute the exact median of each window instead of using a histogram
+    bool exact_median_;
+
     // counter for sparse windows
     double sparse_window_percent_;
     // counter for histogram overflow
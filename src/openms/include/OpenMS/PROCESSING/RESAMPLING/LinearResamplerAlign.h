@@ -11,6 +11,10 @@
 #include <OpenMS/PROCESSING/RESAMPLING/LinearResampler.h>
 #include <OpenMS/CONCEPT/Macros.h>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 namespace OpenMS
 {
 
@@ -116,6 +120,128 @@ public:
       container.swap(resampled_peak_container);
     }
 
+    /**
+        @brief Number of raster points that raster_align() generates between @p start_pos and @p end_pos
+
+        Use it to allocate the output of the batch version of raster_align().
+    */
+    Size raster_size(double start_pos, double end_pos) const
+    {
+      if (end_pos < start_pos) return 0;
+      if (!ppm_) return (Size)(int)(ceil((end_pos - start_pos) / spacing_ + 1));
+      std::vector<Peak1D> raster;
+      populate_raster_(raster, start_pos, end_pos, 0);
+      return raster.size();
+    }
+
+    /**
+        @brief Resamples many containers (MSSpectrum or MSChromatogram) onto one shared raster at once.
+
+        Row @em r of @p output receives the intensities that raster_align(containers[r], start_pos, end_pos)
+        would produce (at the raster positions, see raster_size()). The raster is generated once and
+        the two raster points next to each input point are located directly instead of walking the raster,
+        so the cost per container only depends on its own size. Containers are processed in parallel.
+
+        The containers need to be sorted by position. Empty containers leave their row unchanged.
+
+        @param containers The containers to be resampled
+        @param start_pos The start position of the raster
+        @param end_pos The end position of the raster
+        @param output Preallocated row-major matrix of containers.size() rows with raster_size(start_pos, end_pos) columns; the intensities are added to it
+    */
+    template <typename SpecT, typename ValueT>
+    void raster_align(const std::vector<SpecT>& containers, double start_pos, double end_pos, ValueT* output) const
+    {
+      if (end_pos < start_pos) return;
+
+      // the shared raster
+      std::vector<double> raster_mz;
+      if (!ppm_)
+      {
+        raster_mz.resize(raster_size(start_pos, end_pos));
+        for (Size i = 0; i < raster_mz.size(); ++i)
+        {
+          raster_mz[i] = start_pos + i * spacing_;
+        }
+      }
+      else
+      {
+        std::vector<Peak1D> raster;
+        populate_raster_(raster, start_pos, end_pos, 0);
+        for (const Peak1D& p : raster) raster_mz.push_back(p.getMZ());
+      }
+      const Size size = raster_mz.size();
+      if (size == 0) return;
+
+      // first raster point at or after @p mz
+      auto locate = [&](double mz)
+      {
+        if (ppm_)
+        {
+          return (Size)(std::lower_bound(raster_mz.begin(), raster_mz.end(), mz) - raster_mz.begin());
+        }
+        const double pos = ceil((mz - start_pos) / spacing_);
+        Size j = pos <= 0 ? 0 : (pos >= (double)size ? size : (Size)pos);
+        while (j > 0 && raster_mz[j - 1] >= mz) --j;
+        while (j < size && raster_mz[j] < mz) ++j;
+        return j;
+      };
+
+#pragma omp parallel for schedule(dynamic, 100)
+      for (SignedSize r = 0; r < (SignedSize)containers.size(); ++r)
+      {
+        const SpecT& container = containers[r];
+        if (container.empty()) continue;
+
+        // the points between start_pos and end_pos
+        auto first = container.begin();
+        auto last = container.end();
+        while (first != container.end() && (first)->getMZ() < start_pos) {++first;}
+        while (last != first && (last - 1)->getMZ() > end_pos) {--last;}
+
+        raster_located_(Size(last - first),
+                        [first](Size i) { return (first + i)->getMZ(); },
+                        [first](Size i) { return (first + i)->getIntensity(); },
+                        [&raster_mz](Size i) { return raster_mz[i]; }, size, locate, output + r * size);
+      }
+    }
+
+    /**
+        @brief Resample points (with m/z and intensity in separate containers) onto an equally spaced raster.
+
+        Gives the same result as the corresponding raster() with separate m/z and intensity ranges when the
+        raster m/z are @p start_pos + i * @p spacing, but locates the two raster points next to each input
+        point directly instead of walking the raster.
+
+        @param mz_raw_it Start of the input m/z (sorted)
+        @param mz_raw_end End of the input m/z
+        @param int_raw_it Start of the input intensities
+        @param start_pos Position of the first raster point
+        @param spacing Distance of the raster points
+        @param int_resample_it Start of the raster intensities (the intensities are added to it)
+        @param int_resample_end End of the raster intensities
+    */
+    template <typename ValueT>
+    void raster_uniform(const double* mz_raw_it, const double* mz_raw_end, const double* int_raw_it,
+                        double start_pos, double spacing, ValueT* int_resample_it, ValueT* int_resample_end) const
+    {
+      OPENMS_PRECONDITION(int_resample_it != int_resample_end, "Output iterators cannot be identical") // as we use +1
+      const Size size = int_resample_end - int_resample_it;
+      auto raster_mz = [start_pos, spacing](Size i) { return start_pos + i * spacing; };
+      auto locate = [&](double mz)
+      {
+        const double pos = ceil((mz - start_pos) / spacing);
+        Size j = pos <= 0 ? 0 : (pos >= (double)size ? size : (Size)pos);
+        while (j > 0 && raster_mz(j - 1) >= mz) --j;
+        while (j < size && raster_mz(j) < mz) ++j;
+        return j;
+      };
+      raster_located_(Size(mz_raw_end - mz_raw_it),
+                      [mz_raw_it](Size i) { return mz_raw_it[i]; },
+                      [int_raw_it](Size i) { return int_raw_it[i]; },
+                      raster_mz, size, locate, int_resample_it);
+    }
+
     /**
         @brief Resample points (e.g. Peak1D) from an input range onto a prepopulated output range with given m/z, modifying the output intensities.
 
@@ -314,6 +440,46 @@ protected:
     /// Spacing of the resampled data
     bool ppm_;
 
+    /**
+        @brief Core of raster() for inputs and rasters accessed by index, with @p locate returning the first raster point at or after an m/z
+    */
+    template <typename RawMz, typename RawIntensity, typename RasterMz, typename Locate, typename OutputIterator>
+    static void raster_located_(Size raw_size, RawMz raw_mz, RawIntensity raw_intensity,
+                                RasterMz raster_mz, Size raster_size, Locate locate, OutputIterator output)
+    {
+      Size i = 0;
+      // add the intensity before the raster to the first point
+      while (i < raw_size && raw_mz(i) < raster_mz(0))
+      {
+        output[0] = output[0] + raw_intensity(i);
+        ++i;
+      }
+
+      Size left = 0;
+      for (; i < raw_size; ++i)
+      {
+        const double mz = raw_mz(i);
+        const Size j = locate(mz);
+        left = j > 0 ? j - 1 : 0;
+
+        // if we have the last datapoint we break
+        if (left + 1 == raster_size) {break;}
+
+        double dist_left = fabs(mz - raster_mz(left));
+        double dist_right = fabs(mz - raster_mz(left + 1));
+
+        // distribute the intensity of the raw point according to the distance to the raster points left and right of it
+        output[left] = output[left] + raw_intensity(i) * dist_right / (dist_left + dist_right);
+        output[left + 1] = output[left + 1] + raw_intensity(i) * dist_left / (dist_left + dist_right);
+      }
+
+      // add the final intensity to the right
+      for (; i < raw_size; ++i)
+      {
+        output[left] = output[left] + raw_intensity(i);
+      }
+    }
+
     void updateMembers_() override
     {
       spacing_ =  param_.getValue("spacing");
@@ -323,7 +489,7 @@ protected:
     /// Generate raster for resampled peak container
     template <typename PeakType>
     void populate_raster_(std::vector<PeakType>& resampled_peak_container,
-        double start_pos, double end_pos, int number_resampled_points)
+        double start_pos, double end_pos, int number_resampled_points) const
     {
       if (!ppm_)
       {
@@ -13,6 +13,7 @@
 #include <OpenMS/INTERFACES/DataStructures.h>
 #include <OpenMS/MATH/MathFunctions.h>
 
+#include <algorithm>
 #include <cmath>
 #include <vector>
 
@@ -37,6 +38,12 @@ namespace OpenMS
 
     @note The data must be sorted according to ascending m/z!
 
+    For (nearly) equidistant data (and a fixed Gaussian width, i.e. no ppm
+    tolerance), the kernel is sampled only once at multiples of the data
+    spacing and the filter becomes a plain discrete convolution, which is
+    computed for all data points at once (vectorizable). For all other data the
+    kernel is interpolated for every pair of data points.
+
     @ingroup SignalProcessing
   */
 
@@ -112,6 +119,13 @@ public:
         IterT mz_out,
         IterT int_out)
     {
+      // fixed kernel on (nearly) equidistant data
+      double uniform_spacing;
+      if (!use_ppm_tolerance_ && isUniform_(mz_in_start, mz_in_end, uniform_spacing))
+      {
+        return filterUniform_(mz_in_start, mz_in_end, int_in_start, mz_out, int_out, uniform_spacing);
+      }
+
       bool found_signal = false;
 
       ConstIterT mz_it = mz_in_start;
@@ -152,6 +166,144 @@ protected:
     bool use_ppm_tolerance_;
     double ppm_tolerance_;
 
+    /// Maximal relative deviation of a gap between data points from the mean spacing for the data to be treated as equidistant
+    static constexpr double UNIFORM_SPACING_TOLERANCE = 1e-4;
+
+    /// Returns the value of the Gaussian kernel at the distance @p distance from its center (linear interpolation between the tabulated coefficients)
+    double coefficientAt_(double distance) const
+    {
+      const Size middle = coeffs_.size();
+      const Size left_position = (Size)floor(distance / spacing_);
+      if (left_position + 1 >= middle)
+      {
+        return coeffs_[std::min(left_position, middle - 1)];
+      }
+      const double d = (distance - left_position * spacing_) / spacing_;
+      return (1 - d) * coeffs_[left_position] + d * coeffs_[left_position + 1];
+    }
+
+    /// Checks if the positions [@p first, @p last) are equidistant (see UNIFORM_SPACING_TOLERANCE) and returns their mean @p spacing
+    template <typename ConstIterT>
+    static bool isUniform_(ConstIterT first, ConstIterT last, double& spacing)
+    {
+      const SignedSize n = std::distance(first, last);
+      if (n < 3) return false;
+      spacing = (*(last - 1) - *first) / (n - 1);
+      if (!(spacing > 0)) return false;
+      const double tolerance = UNIFORM_SPACING_TOLERANCE * spacing;
+      for (ConstIterT it = first + 1; it != last; ++it)
+      {
+        if (fabs((*it - *(it - 1)) - spacing) > tolerance) return false;
+      }
+      return true;
+    }
+
+    /**
+      @brief Smoothes equidistant data with a fixed (pre-sampled) kernel
+
+      Uses the same integration range (and trapezoidal weights) as integrate_(),
+      but with the kernel sampled at multiples of @p spacing. Data points whose
+      window covers the full kernel are convolved in one pass over the data.
+    */
+    template <typename ConstIterT, typename IterT>
+    bool filterUniform_(
+        ConstIterT mz_in_start,
+        ConstIterT mz_in_end,
+        ConstIterT int_in_start,
+        IterT mz_out,
+        IterT int_out,
+        const double spacing)
+    {
+      const SignedSize n = std::distance(mz_in_start, mz_in_end);
+      // half width of the kernel, as in integrate_()
+      const double half_width = coeffs_.size() * spacing_;
+      // number of data points on each side of the center covered by the full kernel
+      const SignedSize full_points = std::max<SignedSize>(0, (SignedSize)ceil(half_width / spacing) - 1);
+      // allow one more point for the rounding of the positions
+      const SignedSize max_points = full_points + 1;
+
+      std::vector<double> kernel(max_points + 1);
+      for (SignedSize k = 0; k <= max_points; ++k)
+      {
+        kernel[k] = coefficientAt_(k * spacing);
+      }
+
+      const std::vector<double> x(mz_in_start, mz_in_end);
+      const std::vector<double> y(int_in_start, int_in_start + n);
+
+      // convolution with the full (trapezoidal) kernel for all data points that are far enough from the borders
+      std::vector<double> full(n, 0.0);
+      double full_norm = 0;
+      if (full_points > 0 && n > 2 * full_points)
+      {
+        for (SignedSize k = -full_points; k <= full_points; ++k)
+        {
+          const SignedSize abs_k = std::abs(k);
+          const double w = (abs_k == full_points) ? 0.5 * kernel[abs_k] : kernel[abs_k];
+          full_norm += w;
+          const double* src = y.data() + full_points + k;
+          double* dst = full.data() + full_points;
+          for (SignedSize i = 0; i < n - 2 * full_points; ++i)
+          {
+            dst[i] += w * src[i];
+          }
+        }
+      }
+
+      bool found_signal = false;
+      SignedSize lo = 0; // first data point inside the integration range (left of the center)
+      SignedSize hi = 0; // last data point inside the integration range (right of the center)
+      for (SignedSize i = 0; i < n; ++i)
+      {
+        // same integration range as in integrate_()
+        const double start_pos = ((x[i] - half_width) > x[0]) ? (x[i] - half_width) : x[0];
+        const double end_pos = ((x[i] + half_width) < x[n - 1]) ? (x[i] + half_width) : x[n - 1];
+        while (lo < n && x[lo] <= start_pos) ++lo;
+        hi = std::max(hi, i);
+        while (hi + 1 < n && x[hi + 1] < end_pos) ++hi;
+        const SignedSize points_left = std::max<SignedSize>(0, i - lo);
+        const SignedSize points_right = hi - i;
+
+        double new_int;
+        if (points_left == full_points && points_right == full_points && full_norm > 0)
+        {
+          new_int = full[i] > 0 ? full[i] / full_norm : 0;
+        }
+        else if (points_left > max_points || points_right > max_points)
+        {
+          new_int = integrate_(mz_in_start + i, int_in_start + i, mz_in_start, mz_in_end);
+        }
+        else
+        {
+          double v = 0;
+          double norm = 0;
+          for (const SignedSize dir : {-1, 1})
+          {
+            const SignedSize points = (dir < 0) ? points_left : points_right;
+            if (points == 0) continue;
+            v += 0.5 * kernel[0] * y[i];
+            norm += 0.5 * kernel[0];
+            for (SignedSize k = 1; k < points; ++k)
+            {
+              v += kernel[k] * y[i + dir * k];
+              norm += kernel[k];
+            }
+            v += 0.5 * kernel[points] * y[i + dir * points];
+            norm += 0.5 * kernel[points];
+          }
+          new_int = v > 0 ? v / norm : 0;
+        }
+
+        *mz_out = x[i];
+        *int_out = new_int;
+        ++mz_out;
+        ++int_out;
+
+        if (fabs(new_int) > 0) found_signal = true;
+      }
+      return found_signal;
+    }
+
     /// Computes the convolution of the raw data at position x and the gaussian kernel
     template <typename InputPeakIterator>
     double integrate_(InputPeakIterator x /* mz */, InputPeakIterator y /* int */, InputPeakIterator first, InputPeakIterator last)
@@ -86,74 +86,65 @@ public:
     // low level template to filters spectra and chromatograms
     // raw data and meta data needs to be copied to the output container before calling this function
     template<class InputIt, class OutputIt>
-    void filter(InputIt first, InputIt last, OutputIt d_first)
+    void filter(InputIt first, InputIt last, OutputIt d_first) const
     {
       size_t n = std::distance(first, last);
 
       if (frame_size_ > n) { return; }
 
-      int i;
-      UInt j;
-      int mid = (frame_size_ / 2);
-      double help;
+      // gather the intensities, so the convolution runs on contiguous memory
+      std::vector<double> intensities(n);
+      InputIt it = first;
+      for (size_t k = 0; k < n; ++k, ++it)
+      {
+        intensities[k] = it->getIntensity();
+      }
+      std::vector<double> smoothed(n, 0.0);
 
-      // compute the transient on
-      OutputIt out_it = d_first;
+      const size_t mid = (frame_size_ / 2);
 
-      for (i = 0; i <= mid; ++i)
+      // compute the transient on (the first mid + 1 data points use the first frame)
+      for (size_t i = 0; i <= mid; ++i)
       {
-        InputIt it_forward = (first - i);
-        help = 0;
-        for (j = 0; j < frame_size_; ++j)
+        double help = 0;
+        for (size_t j = 0; j < frame_size_; ++j)
         {
-          help += it_forward->getIntensity() * coeffs_[(i + 1) * frame_size_ - 1 - j];
-          ++it_forward;
+          help += intensities[j] * coeffs_[(i + 1) * frame_size_ - 1 - j];
         }
-
-        out_it->setPosition(first->getPosition());
-        out_it->setIntensity(std::max(0.0, help));
-        ++out_it;
-        ++first;
+        smoothed[i] = help;
       }
 
       // compute the steady state output
-      InputIt it_help = (last - mid);
-
-      while (first != it_help)
+      // (loop over the coefficients outside: every output point still sums up its products
+      // in the same order, while the inner loop over the data points can be vectorized)
+      const size_t steady_begin = mid + 1;
+      const size_t steady_end = n - mid;
+      for (size_t j = 0; j < frame_size_; ++j)
       {
-        InputIt it_forward = (first - mid);
-        help = 0;
-
-        for (j = 0; j < frame_size_; ++j)
+        const double c = coeffs_[mid * frame_size_ + j];
+        for (size_t i = steady_begin; i < steady_end; ++i)
         {
-          help += it_forward->getIntensity() * coeffs_[mid * frame_size_ + j];
-          ++it_forward;
+          smoothed[i] += intensities[i - mid + j] * c;
         }
-
-        out_it->setPosition(first->getPosition());
-        out_it->setIntensity(std::max(0.0, help));
-        ++out_it;
-        ++first;
       }
 
-      // compute the transient off
-      for (i = (mid - 1); i >= 0; --i)
+      // compute the transient off (the last mid data points use the last frame)
+      for (size_t i = 0; i < mid; ++i)
       {
-        InputIt it_forward = (first - (frame_size_ - i - 1));
-        help = 0;
-
-        for (j = 0; j < frame_size_; ++j)
+        double help = 0;
+        for (size_t j = 0; j < frame_size_; ++j)
         {
-          help += it_forward->getIntensity() * coeffs_[i * frame_size_ + j];
-          ++it_forward;
+          help += intensities[n - frame_size_ + j] * coeffs_[i * frame_size_ + j];
         }
+        smoothed[n - 1 - i] = help;
+      }
 
+      OutputIt out_it = d_first;
+      for (size_t k = 0; k < n; ++k, ++first, ++out_it)
+      {
         out_it->setPosition(first->getPosition());
-        out_it->setIntensity(std::max(0.0, help));
-        ++out_it;
-        ++first;
+        out_it->setIntensity(std::max(0.0, smoothed[k]));
       }
-
     }
 
     /**
@@ -187,17 +178,19 @@ public:
     */
     void filterExperiment(PeakMap & map)
     {
-      Size progress = 0;
       startProgress(0, map.size() + map.getChromatograms().size(), "smoothing data");
-      for (Size i = 0; i < map.size(); ++i)
+      // spectra and chromatograms are smoothed independently
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)map.size(); ++i)
       {
         filter(map[i]);
-        setProgress(++progress);
+        nextProgress();
       }
-      for (Size i = 0; i < map.getChromatograms().size(); ++i)
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)map.getChromatograms().size(); ++i)
       {
         filter(map.getChromatogram(i));
-        setProgress(++progress);
+        nextProgress();
       }
       endProgress();
     }
@@ -18,6 +18,7 @@
 #include <OpenMS/PROCESSING/MISC/SplineInterpolatedPeaks.h>
 #include <OpenMS/KERNEL/BaseFeature.h>
 
+#include <exception>
 #include <vector>
 
 namespace OpenMS
@@ -185,74 +186,52 @@ public:
       exp.sortSpectra();
     }
 
-    /// merges spectra with similar precursors (must have MS2 level)
+    /**
+      @brief merges spectra with similar precursors (must have MS2 level)
+
+      Two spectra are similar if their precursors are within
+      @p precursor_method:rt_tolerance and @p precursor_method:mz_tolerance.
+      Groups of transitively similar spectra (as found by single linkage
+      clustering) are merged. Similar pairs are searched by an RT sweep over
+      m/z buckets, so memory is linear in the number of spectra.
+    */
     template <typename MapType>
     void mergeSpectraPrecursors(MapType& exp)
     {
-
       // convert spectra's precursors to clusterizable data
-      Size data_size;
-      std::vector<BinaryTreeNode> tree;
-      std::map<Size, Size> index_mapping;
-      // local scope to save memory - we do not need the clustering stuff later
-      {
-        std::vector<BaseFeature> data;
+      std::vector<BaseFeature> data;
+      // index in data ==> experiment index
+      std::vector<Size> index_mapping;
 
-        for (Size i = 0; i < exp.size(); ++i)
+      for (Size i = 0; i < exp.size(); ++i)
+      {
+        if (exp[i].getMSLevel() != 2)
         {
-          if (exp[i].getMSLevel() != 2)
-          {
-            continue;
-          }
-
-          // remember which index in distance data ==> experiment index
-          index_mapping[data.size()] = i;
-
-          // make cluster element
-          BaseFeature bf;
-          bf.setRT(exp[i].getRT());
-          const auto& pcs = exp[i].getPrecursors(); 
-          // keep the first Precursor
-          if (pcs.empty())
-          {
-            throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Scan #") + String(i) + " does not contain any precursor information! Unable to cluster!");
-          }
-          if (pcs.size() > 1)
-          {
-            OPENMS_LOG_WARN << "More than one precursor found. Using first one!" << std::endl;
-          }
-          bf.setMZ(pcs[0].getMZ());
-          data.push_back(bf);
+          continue;
         }
-        data_size = data.size();
 
-        SpectraDistance_ llc;
-        llc.setParameters(param_.copy("precursor_method:", true));
-        SingleLinkage sl;
-        DistanceMatrix<float> dist; // will be filled
-        ClusterHierarchical ch;
+        // remember which index in distance data ==> experiment index
+        index_mapping.push_back(i);
 
-        // clustering ; threshold is implicitly at 1.0, i.e. distances of 1.0 (== similarity 0) will not be clustered
-        ch.cluster<BaseFeature, SpectraDistance_>(data, llc, sl, tree, dist);
-      }
-
-      // extract the clusters
-      ClusterAnalyzer ca;
-      std::vector<std::vector<Size> > clusters;
-      // count number of real tree nodes (not the -1 ones):
-      Size node_count = 0;
-      for (Size ii = 0; ii < tree.size(); ++ii)
-      {
-        if (tree[ii].distance >= 1)
+        // make cluster element
+        BaseFeature bf;
+        bf.setRT(exp[i].getRT());
+        const auto& pcs = exp[i].getPrecursors(); 
+        // keep the first Precursor
+        if (pcs.empty())
         {
-          tree[ii].distance = -1;  // manually set to disconnect, as SingleLinkage does not support it
+          throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Scan #") + String(i) + " does not contain any precursor information! Unable to cluster!");
         }
-        if (tree[ii].distance != -1)
+        if (pcs.size() > 1)
         {
-          ++node_count;
+          OPENMS_LOG_WARN << "More than one precursor found. Using first one!" << std::endl;
         }
+        bf.setMZ(pcs[0].getMZ());
+        data.push_back(bf);
       }
-      ca.cut(data_size - node_count, tree, clusters);
+
+      std::vector<std::vector<Size> > clusters = clusterPrecursors_(data);
+      data.clear();
 
       // convert to blocks
       MergeBlocks spectra_to_merge;
@@ -279,6 +258,17 @@ public:
       exp.sortSpectra();
     }
 
+    /**
+      @brief Merges one block of spectra into a consensus spectrum, in the same way as mergeSpectraBlockWise() does for each of its blocks
+
+      The first spectrum of @p block is the master spectrum (which provides the meta data), all others are merged into it.
+      This allows to merge blocks which were collected elsewhere, e.g. while streaming the data (see MSDataBlockMergingConsumer).
+
+      @param block The spectra to merge (at least one)
+      @param ms_level MS level of the consensus spectrum
+    */
+    MSSpectrum mergeBlock(const std::vector<MSSpectrum>& block, const UInt ms_level) const;
+
     /**
      * @brief check if the first and second mzs might be from the same mass
      *
@@ -572,147 +562,56 @@ protected:
     template <typename MapType>
     void mergeSpectra_(MapType& exp, const MergeBlocks& spectra_to_merge, const UInt ms_level)
     {
-      double mz_binning_width(param_.getValue("mz_binning_width"));
-      std::string mz_binning_unit(param_.getValue("mz_binning_width_unit"));
-
-      // merge spectra
-      MapType merged_spectra;
+      // set up alignment
+      const SpectrumAlignment sas = getMergeAlignment_();
 
       std::map<Size, Size> cluster_sizes;
-      std::set<Size> merged_indices;
-
-      // set up alignment
-      SpectrumAlignment sas;
-      Param p;
-      p.setValue("tolerance", mz_binning_width);
-      if (!(mz_binning_unit == "Da" || mz_binning_unit == "ppm"))
+      std::vector<bool> merged_indices(exp.size(), false);
+      std::vector<MergeBlocks::const_iterator> blocks;
+      blocks.reserve(spectra_to_merge.size());
+      for (auto it = spectra_to_merge.begin(); it != spectra_to_merge.end(); ++it)
       {
-        throw Exception::IllegalSelfOperation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);  // sanity check
+        ++cluster_sizes[it->second.size() + 1]; // for stats
+        merged_indices[it->first] = true;
+        for (const Size s : it->second)
+        {
+          merged_indices[s] = true;
+        }
+        blocks.push_back(it);
       }
 
-      p.setValue("is_relative_tolerance", mz_binning_unit == "Da" ? "false" : "true");
-      sas.setParameters(p);
-      std::vector<std::pair<Size, Size> > alignment;
-
       Size count_peaks_aligned(0);
       Size count_peaks_overall(0);
 
-      // each BLOCK
-      for (auto it = spectra_to_merge.begin(); it != spectra_to_merge.end(); ++it)
+      // merge spectra (each block independently)
+      std::vector<typename MapType::SpectrumType> consensus_spectra(blocks.size());
+      std::exception_ptr error;
+      SignedSize error_index = (SignedSize)blocks.size();
+#pragma omp parallel for schedule(dynamic) reduction(+: count_peaks_aligned, count_peaks_overall)
+      for (SignedSize b = 0; b < (SignedSize)blocks.size(); ++b)
       {
-        ++cluster_sizes[it->second.size() + 1]; // for stats
-
-        typename MapType::SpectrumType consensus_spec = exp[it->first];
-        consensus_spec.setMSLevel(ms_level);
-
-        merged_indices.insert(it->first);
-
-        double rt_average = consensus_spec.getRT();
-        double precursor_mz_average = 0.0;
-        Size precursor_count(0);
-        if (!consensus_spec.getPrecursors().empty())
+        try
         {
-          precursor_mz_average = consensus_spec.getPrecursors()[0].getMZ();
-          ++precursor_count;
+          mergeBlock_(exp, blocks[b]->first, blocks[b]->second, ms_level, sas, consensus_spectra[b], count_peaks_aligned, count_peaks_overall);
         }
-
-        count_peaks_overall += consensus_spec.size();
-
-        String consensus_native_id = consensus_spec.getNativeID();
-
-        // block elements
-        for (auto sit = it->second.begin(); sit != it->second.end(); ++sit)
+        catch (...)
         {
-          consensus_spec.unify(exp[*sit]); // append meta info
-          merged_indices.insert(*sit);
-
-          rt_average += exp[*sit].getRT();
-          if (ms_level >= 2 && exp[*sit].getPrecursors().size() > 0)
+#pragma omp critical (SpectraMerger_mergeSpectra)
           {
-            precursor_mz_average += exp[*sit].getPrecursors()[0].getMZ();
-            ++precursor_count;
-          }
-
-          // add native ID to consensus native ID, comma separated
-          consensus_native_id += ",";
-          consensus_native_id += exp[*sit].getNativeID();
-
-          // merge data points
-          sas.getSpectrumAlignment(alignment, consensus_spec, exp[*sit]);
-          count_peaks_aligned += alignment.size();
-          count_peaks_overall += exp[*sit].size();
-
-          Size align_index(0);
-          Size spec_b_index(0);
-
-          // sanity check for number of peaks
-          Size spec_a = consensus_spec.size(), spec_b = exp[*sit].size(), align_size = alignment.size();
-          for (auto pit = exp[*sit].begin(); pit != exp[*sit].end(); ++pit)
-          {
-            if (alignment.empty() || alignment[align_index].second != spec_b_index)
-              // ... add unaligned peak
-            {
-              consensus_spec.push_back(*pit);
-            }
-            // or add aligned peak height to ALL corresponding existing peaks
-            else
+            if (b < error_index)
             {
-              Size counter(0);
-              Size copy_of_align_index(align_index);
-
-              while (!alignment.empty() && 
-                     copy_of_align_index < alignment.size() && 
-                     alignment[copy_of_align_index].second == spec_b_index)
-              {
-                ++copy_of_align_index;
-                ++counter;
-              } // Count the number of peaks which correspond to a single b peak.
-
-              while (!alignment.empty() &&
-                     align_index < alignment.size() &&  
-                     alignment[align_index].second == spec_b_index)
-              {
-                consensus_spec[alignment[align_index].first].setIntensity(consensus_spec[alignment[align_index].first].getIntensity() +
-                    (pit->getIntensity() / (double)counter)); // add the intensity divided by the number of peaks
-                ++align_index; // this aligned peak was explained, wait for next aligned peak ...
-                if (align_index == alignment.size())
-                {
-                  alignment.clear();  // end reached -> avoid going into this block again
-                }
-              }
-              align_size = align_size + 1 - counter; //Decrease align_size by number of
+              error_index = b;
+              error = std::current_exception();
             }
-            ++spec_b_index;
           }
-          consensus_spec.sortByPosition(); // sort, otherwise next alignment will fail
-          if (spec_a + spec_b - align_size != consensus_spec.size())
-          {
-            OPENMS_LOG_WARN << "wrong number of features after merge. Expected: " << spec_a + spec_b - align_size << " got: " << consensus_spec.size() << "\n";
-          }
-        }
-        rt_average /= it->second.size() + 1;
-        consensus_spec.setRT(rt_average);
-        
-        // set new consensus native ID
-        consensus_spec.setNativeID(consensus_native_id);
-
-        if (ms_level >= 2)
-        {
-          if (precursor_count)
-          {
-            precursor_mz_average /= precursor_count;
-          }
-          auto& pcs = consensus_spec.getPrecursors();
-          pcs.resize(1);
-          pcs[0].setMZ(precursor_mz_average);
-          consensus_spec.setPrecursors(pcs);
         }
+      }
+      if (error) std::rethrow_exception(error);
 
-        if (consensus_spec.empty())
-        {
-          continue;
-        }
-        else
+      MapType merged_spectra;
+      for (auto& consensus_spec : consensus_spectra)
+      {
+        if (!consensus_spec.empty())
         {
           merged_spectra.addSpectrum(std::move(consensus_spec));
         }
@@ -730,14 +629,12 @@ protected:
       OPENMS_LOG_INFO << "Number of merged peaks: " << String(buffer) << "\n";
 
       // remove all spectra that were within a cluster
-      typename MapType::SpectrumType empty_spec;
       MapType exp_tmp;
       for (Size i = 0; i < exp.size(); ++i)
       {
-        if (merged_indices.count(i) == 0) // save unclustered ones
+        if (!merged_indices[i]) // save unclustered ones
         {
-          exp_tmp.addSpectrum(exp[i]);
-          exp[i] = empty_spec;
+          exp_tmp.addSpectrum(std::move(exp[i]));
         }
       }
 
@@ -752,6 +649,138 @@ protected:
 
     }
 
+    /// Returns the alignment used to match peaks of merged spectra (see 'mz_binning_width')
+    SpectrumAlignment getMergeAlignment_() const;
+
+    /**
+      @brief Groups transitively similar precursors (see mergeSpectraPrecursors())
+
+      Gives the same groups as single linkage clustering of the similarities
+      of SpectraDistance_ (cut at similarity 0), without a distance matrix:
+      precursors are visited in order of RT and only compared to the earlier
+      ones within the RT tolerance in the neighbouring m/z buckets.
+
+      @return The groups (indices into @p data, ascending), ordered by their first element
+    */
+    std::vector<std::vector<Size> > clusterPrecursors_(const std::vector<BaseFeature>& data) const;
+
+    /**
+        @brief merges the spectra @p sacrifices into the spectrum @p master (indices into @p spectra), giving @p consensus_spec
+
+        @p consensus_spec is empty, if the spectra do not contain any peaks.
+        The peak counts (for statistics) are added to @p count_peaks_aligned and @p count_peaks_overall.
+    */
+    template <typename SpectraType, typename SpectrumType>
+    void mergeBlock_(const SpectraType& spectra, const Size master, const std::vector<Size>& sacrifices, const UInt ms_level,
+                     const SpectrumAlignment& sas, SpectrumType& consensus_spec, Size& count_peaks_aligned, Size& count_peaks_overall) const
+    {
+      std::vector<std::pair<Size, Size> > alignment;
+
+      consensus_spec = spectra[master];
+      consensus_spec.setMSLevel(ms_level);
+
+      double rt_average = consensus_spec.getRT();
+      double precursor_mz_average = 0.0;
+      Size precursor_count(0);
+      if (!consensus_spec.getPrecursors().empty())
+      {
+        precursor_mz_average = consensus_spec.getPrecursors()[0].getMZ();
+        ++precursor_count;
+      }
+
+      count_peaks_overall += consensus_spec.size();
+
+      String consensus_native_id = consensus_spec.getNativeID();
+
+      // block elements
+      for (auto sit = sacrifices.begin(); sit != sacrifices.end(); ++sit)
+      {
+        const SpectrumType& sacrifice = spectra[*sit];
+        consensus_spec.unify(sacrifice); // append meta info
+
+        rt_average += sacrifice.getRT();
+        if (ms_level >= 2 && sacrifice.getPrecursors().size() > 0)
+        {
+          precursor_mz_average += sacrifice.getPrecursors()[0].getMZ();
+          ++precursor_count;
+        }
+
+        // add native ID to consensus native ID, comma separated
+        consensus_native_id += ",";
+        consensus_native_id += sacrifice.getNativeID();
+
+        // merge data points
+        sas.getSpectrumAlignment(alignment, consensus_spec, sacrifice);
+        count_peaks_aligned += alignment.size();
+        count_peaks_overall += sacrifice.size();
+
+        Size align_index(0);
+        Size spec_b_index(0);
+
+        // sanity check for number of peaks
+        Size spec_a = consensus_spec.size(), spec_b = sacrifice.size(), align_size = alignment.size();
+        for (auto pit = sacrifice.begin(); pit != sacrifice.end(); ++pit)
+        {
+          if (alignment.empty() || alignment[align_index].second != spec_b_index)
+            // ... add unaligned peak
+          {
+            consensus_spec.push_back(*pit);
+          }
+          // or add aligned peak height to ALL corresponding existing peaks
+          else
+          {
+            Size counter(0);
+            Size copy_of_align_index(align_index);
+
+            while (!alignment.empty() && 
+                   copy_of_align_index < alignment.size() && 
+                   alignment[copy_of_align_index].second == spec_b_index)
+            {
+              ++copy_of_align_index;
+              ++counter;
+            } // Count the number of peaks which correspond to a single b peak.
+
+            while (!alignment.empty() &&
+                   align_index < alignment.size() &&  
+                   alignment[align_index].second == spec_b_index)
+            {
+              consensus_spec[alignment[align_index].first].setIntensity(consensus_spec[alignment[align_index].first].getIntensity() +
+                  (pit->getIntensity() / (double)counter)); // add the intensity divided by the number of peaks
+              ++align_index; // this aligned peak was explained, wait for next aligned peak ...
+              if (align_index == alignment.size())
+              {
+                alignment.clear();  // end reached -> avoid going into this block again
+              }
+            }
+            align_size = align_size + 1 - counter; //Decrease align_size by number of
+          }
+          ++spec_b_index;
+        }
+        consensus_spec.sortByPosition(); // sort, otherwise next alignment will fail
+        if (spec_a + spec_b - align_size != consensus_spec.size())
+        {
+          OPENMS_LOG_WARN << "wrong number of features after merge. Expected: " << spec_a + spec_b - align_size << " got: " << consensus_spec.size() << "\n";
+        }
+      }
+      rt_average /= sacrifices.size() + 1;
+      consensus_spec.setRT(rt_average);
+      
+      // set new consensus native ID
+      consensus_spec.setNativeID(consensus_native_id);
+
+      if (ms_level >= 2)
+      {
+        if (precursor_count)
+        {
+          precursor_mz_average /= precursor_count;
+        }
+        auto& pcs = consensus_spec.getPrecursors();
+        pcs.resize(1);
+        pcs[0].setMZ(precursor_mz_average);
+        consensus_spec.setPrecursors(pcs);
+      }
+    }
+
     /**
      * @brief average spectra (profile mode)
      *
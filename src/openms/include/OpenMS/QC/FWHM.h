@@ -12,7 +12,10 @@
 
 namespace OpenMS
 {
+  class Feature;
   class FeatureMap;
+  class PeptideIdentification;
+  class QCEngine;
 
   /**
     @brief QC metric calculating (un)calibrated m/z error
@@ -43,10 +46,17 @@ namespace OpenMS
     **/
     void compute(FeatureMap& features);
 
+    /// Registers a (thread safe) PSM visitor at @p engine which does the same as compute()
+    void addVisitors(QCEngine& engine) const;
+
 
     const String& getName() const override;
 
     Status requirements() const override;
+
+  private:
+    /// copies the FWHM of @p feature to @p pep_id (if the feature has one)
+    static void copyFWHM_(const Feature& feature, PeptideIdentification& pep_id);
   };
 
 } // namespace OpenMS
@@ -18,6 +18,7 @@
 namespace OpenMS
 {
   class FeatureMap;
+  class QCEngine;
   /**
    * @brief This class is a metric for the QualityControl TOPP Tool.
    *
@@ -54,6 +55,17 @@ namespace OpenMS
     void compute(FeatureMap& fmap);
     void compute(std::vector<ProteinIdentification>& prot_ids, std::vector<PeptideIdentification>& pep_ids);
 
+    /**
+     * @brief Registers a (thread safe) PSM visitor at @p engine which does the same as compute(FeatureMap&)
+     *
+     * The result is stored when the engine finishes. The visitor refers to this object, which therefore needs to exist until the engine ran.
+     *
+     * @param engine The engine
+     * @param fmap FeatureMap which will be given to QCEngine::run() (provides the digestion parameters)
+     * @throws Exception::MissingInformation if the digestion parameters are missing
+     */
+    void addVisitors(QCEngine& engine, const FeatureMap& fmap);
+
     /// returns the name of the metric
     const String& getName() const override;
 
@@ -15,7 +15,9 @@ namespace OpenMS
 {
   class FeatureMap;
   class MSExperiment;
+  class MSSpectrum;
   class PeptideIdentification;
+  class QCEngine;
 
   /**
     @brief QC metric calculating (un)calibrated m/z error
@@ -48,6 +50,15 @@ namespace OpenMS
      **/
     void compute(FeatureMap& features, const MSExperiment& exp, const QCBase::SpectraMap& map_to_spectrum);
 
+    /**
+     * @brief Registers a (thread safe) PSM visitor at @p engine which does the same as compute()
+     *
+     * The visitor refers to this object, which therefore needs to exist until the engine ran.
+     * @param engine The engine
+     * @param exp PeakMap of the original experiment (as given to QCEngine::run()). Can be empty (i.e. not available).
+     **/
+    void addVisitors(QCEngine& engine, const MSExperiment& exp);
+
     /// define the required input files
     /// only FeatureXML after FDR is ultimately necessary
     Status requirements() const override;
@@ -57,10 +68,8 @@ namespace OpenMS
 
   private:
     /// calculate the m/z values and m/z errors and add them to the PeptideIdentification
-    void addMzMetaValues_(PeptideIdentification& peptide_ID, const MSExperiment& exp, const QCBase::SpectraMap& map_to_spectrum);
+    void addMzMetaValues_(PeptideIdentification& peptide_ID, const MSSpectrum* spectrum) const;
 
-    double mz_raw_;
-    double mz_ref_;
     bool no_mzml_;
   };
 } // namespace OpenMS
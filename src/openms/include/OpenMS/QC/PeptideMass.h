@@ -13,6 +13,8 @@
 namespace OpenMS
 {
   class FeatureMap;
+  class PeptideIdentification;
+  class QCEngine;
 
   /**
     @brief QC metric calculating theoretical mass of a peptide sequence
@@ -36,10 +38,17 @@ namespace OpenMS
     **/
     void compute(FeatureMap& features);
 
+    /// Registers a (thread safe) PSM visitor at @p engine which does the same as compute()
+    void addVisitors(QCEngine& engine) const;
+
 
     const String& getName() const override;
 
     Status requirements() const override;
+
+  private:
+    /// sets the 'mass' metavalue of the first hit of @p pep_id
+    static void annotateMass_(PeptideIdentification& pep_id);
   };
 
 } // namespace OpenMS
@@ -78,6 +78,9 @@ namespace OpenMS
       /// @throws Exception::ElementNotFound if @p identifier is unknown
       UInt64 at(const String& identifier) const;
 
+      /// is there a spectrum with this identifier?
+      bool contains(const String& identifier) const;
+
       /// clear the map
       void clear();
 
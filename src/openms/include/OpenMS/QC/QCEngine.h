@@ -0,0 +1,112 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/QC/QCBase.h>
+
+#include <functional>
+#include <vector>
+
+namespace OpenMS
+{
+  class Feature;
+  class FeatureMap;
+  class MSSpectrum;
+  class PeptideIdentification;
+
+  /**
+    @brief Computes several QC metrics in a single traversal of the data
+
+    Most metrics only look at one spectrum or one PSM (PeptideIdentification) at a time. Instead of every metric
+    iterating over the whole MSExperiment / FeatureMap on its own (and looking up the spectrum of each PSM again),
+    metrics register visitors here, see e.g. PeptideMass::addVisitors(). run() then iterates the spectra and the PSMs
+    once and calls all visitors for each item, in the order in which they were added.
+
+    For PSM visitors, the spectrum referenced by the PSM ('spectrum_reference' meta value) is looked up once.
+    Visitors receive nullptr if the PSM has no reference or the spectrum is not available (e.g. no mzML given).
+
+    Visitors which only modify the item they are called for can be marked as thread safe. If all visitors of a kind
+    are thread safe, the respective pass runs in parallel.
+
+    Spectra can also be streamed, e.g. from MzMLFile::transform() via an MSDataTransformingConsumer:
+    @code
+    Size index = 0;
+    MSDataTransformingConsumer consumer;
+    consumer.setSpectraProcessingFunc([&](MSSpectrum& s) { engine.visitSpectrum(s, index++); });
+    MzMLFile().transform(in, &consumer);
+    engine.finish();
+    @endcode
+  */
+  class OPENMS_DLLAPI QCEngine
+  {
+  public:
+    /// Called for each spectrum, with its index in the map
+    using SpectrumVisitor = std::function<void(const MSSpectrum& spectrum, Size index)>;
+
+    /// Called for each PSM, with the feature it is assigned to (nullptr for unassigned PSMs) and its spectrum (or nullptr)
+    using PSMVisitor = std::function<void(PeptideIdentification& pep_id, const Feature* feature, const MSSpectrum* spectrum)>;
+
+    /// Called once after all items were visited (e.g. to store aggregated results)
+    using FinishCallback = std::function<void()>;
+
+    /// Registers a spectrum visitor
+    void addSpectrumVisitor(const SpectrumVisitor& visitor, bool thread_safe = false);
+
+    /// Registers a PSM visitor
+    void addPSMVisitor(const PSMVisitor& visitor, bool thread_safe = false);
+
+    /// Registers a callback for finish()
+    void addFinishCallback(const FinishCallback& callback);
+
+    /// Number of registered spectrum visitors
+    Size getNrSpectrumVisitors() const;
+
+    /// Number of registered PSM visitors
+    Size getNrPSMVisitors() const;
+
+    /// Removes all visitors and callbacks
+    void clear();
+
+    /**
+      @brief Visits all spectra of @p exp and all PSMs of @p fmap, then calls finish()
+
+      @param exp The map (may be empty, e.g. if no mzML is given)
+      @param fmap Features with PSMs (assigned and unassigned)
+      @param map_to_spectrum Index of @p exp by native ID, to find the spectra of the PSMs
+
+      @throws Any exception thrown by a visitor
+    */
+    void run(const MSExperiment& exp, FeatureMap& fmap, const QCBase::SpectraMap& map_to_spectrum) const;
+
+    /// Visits all spectra of @p exp, then calls finish()
+    void run(const MSExperiment& exp) const;
+
+    /// Calls all spectrum visitors for @p spectrum (for streaming)
+    void visitSpectrum(const MSSpectrum& spectrum, Size index) const;
+
+    /// Calls all PSM visitors for @p pep_id
+    void visitPSM(PeptideIdentification& pep_id, const Feature* feature, const MSSpectrum* spectrum) const;
+
+    /// Calls all finish callbacks
+    void finish() const;
+
+  private:
+    /// Visits all spectra of @p exp
+    void visitSpectra_(const MSExperiment& exp) const;
+
+    /// Visits all PSMs of @p fmap
+    void visitPSMs_(const MSExperiment& exp, FeatureMap& fmap, const QCBase::SpectraMap& map_to_spectrum) const;
+
+    std::vector<SpectrumVisitor> spectrum_visitors_;
+    std::vector<PSMVisitor> psm_visitors_;
+    std::vector<FinishCallback> finish_callbacks_;
+    bool spectrum_visitors_thread_safe_ = true;
+    bool psm_visitors_thread_safe_ = true;
+  };
+} // namespace OpenMS
@@ -0,0 +1,150 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Axel Walter $
+// $Authors: Axel Walter $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/MATH/STATISTICS/QuantileSketch.h>
+
+#include <map>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Mergeable summaries of QC metrics over many runs
+
+    For each metric (by CV accession, e.g. "QC:4000059" for the number of MS1 spectra) the values of all runs
+    are summarized by their count, mean, variance, minimum, maximum and a Math::QuantileSketch for approximate
+    quantiles. All of these can be merged exactly (mean and variance via the parallel algorithm of Chan et al.),
+    so accumulators of single runs can be stored (store()) and later combined (merge()) into a summary of a
+    whole cohort without recomputing the metrics or loading any spectra. MzQCFile::storeSetQualities() writes
+    such a summary as mzQC.
+
+    @code
+    // per run (e.g. QCCalculator -out_accumulator)
+    QCMetricAccumulator run;
+    MzQCFile().store(..., &run);
+    run.store("run1.qcacc.json");
+    // cohort
+    QCMetricAccumulator cohort;
+    for (const String& f : files) { QCMetricAccumulator a; a.load(f); cohort.merge(a); }
+    MzQCFile().storeSetQualities("cohort.mzQC", cohort, ...);
+    @endcode
+  */
+  class OPENMS_DLLAPI QCMetricAccumulator
+  {
+  public:
+    /// Mergeable summary of the values of one metric
+    class OPENMS_DLLAPI Summary
+    {
+    public:
+      /// Constructor (see Math::QuantileSketch for @p relative_accuracy)
+      explicit Summary(double relative_accuracy = 0.01);
+
+      /// Constructor from the content of a summary (e.g. loaded from a file)
+      Summary(double mean, double m2, const Math::QuantileSketch& sketch);
+
+      /// Equality operator
+      bool operator==(const Summary& rhs) const;
+
+      /// Adds a value (NaN is ignored)
+      void add(double value);
+
+      /**
+        @brief Adds all values of @p other
+
+        @exception Exception::IllegalArgument if the relative accuracies differ
+      */
+      void merge(const Summary& other);
+
+      /// Number of values
+      UInt64 getCount() const;
+
+      /// Mean of the values (0 if empty)
+      double getMean() const;
+
+      /// Sum of the squared differences to the mean
+      double getM2() const;
+
+      /// Sample variance of the values (0 for less than two values)
+      double getVariance() const;
+
+      /// Smallest value (0 if empty)
+      double getMin() const;
+
+      /// Largest value (0 if empty)
+      double getMax() const;
+
+      /// Approximate quantile, see Math::QuantileSketch::getQuantile()
+      double getQuantile(double q) const;
+
+      /// The sketch of the values
+      const Math::QuantileSketch& getSketch() const;
+
+    private:
+      double mean_ = 0.0;
+      double m2_ = 0.0;
+      Math::QuantileSketch sketch_;
+    };
+
+    /// Metric accession -> summary
+    using Metrics = std::map<String, Summary>;
+
+    /// Constructor (see Math::QuantileSketch for @p relative_accuracy)
+    explicit QCMetricAccumulator(double relative_accuracy = 0.01);
+
+    /// Equality operator
+    bool operator==(const QCMetricAccumulator& rhs) const;
+
+    /// Records that a run (identified by @p label, e.g. its file name) contributes to the summaries
+    void addRun(const String& label);
+
+    /// Adds a value of metric @p accession
+    void add(const String& accession, double value);
+
+    /**
+      @brief Adds all runs and values of @p other
+
+      @exception Exception::IllegalArgument if the relative accuracies differ
+    */
+    void merge(const QCMetricAccumulator& other);
+
+    /// Labels of the runs (in order of addition / merging)
+    const std::vector<String>& getRuns() const;
+
+    /// Summaries of all metrics
+    const Metrics& getMetrics() const;
+
+    /// The relative accuracy of the quantiles
+    double getRelativeAccuracy() const;
+
+    /// No runs and no metrics?
+    bool empty() const;
+
+    /**
+      @brief Writes the accumulator to @p filename (JSON)
+
+      @exception Exception::UnableToCreateFile if the file cannot be written
+    */
+    void store(const String& filename) const;
+
+    /**
+      @brief Replaces the content by the accumulator stored in @p filename
+
+      @exception Exception::FileNotFound if the file does not exist
+      @exception Exception::ParseError if the file is not a valid accumulator
+    */
+    void load(const String& filename);
+
+  private:
+    double relative_accuracy_;
+    std::vector<String> runs_;
+    Metrics metrics_;
+  };
+} // namespace OpenMS
@@ -18,6 +18,8 @@ set(sources_list_h
   PeptideMass.h
   PSMExplainedIonCurrent.h
   QCBase.h
+  QCEngine.h
+  QCMetricAccumulator.h
   RTAlignment.h
   SpectrumCount.h
   DBSuitability.h
@@ -222,6 +222,14 @@ public:
     ///   3. user home directory
     static String getUserDirectory();
 
+    /// The OpenMS cache path (for data that is derived from other files and can be rebuilt at any time, e.g. binary snapshots of the controlled vocabularies)
+    /// Looks up the following locations, taking the first one which is non-null:
+    ///   - environment variable OPENMS_CACHE_DIR
+    ///   - environment variable XDG_CACHE_HOME, followed by 'OpenMS' (only on unix identifying systems)
+    ///   - '.cache/OpenMS' (unix identifying systems) or '.OpenMS/cache' (other systems) in the OpenMS home path
+    /// The directory is not created. The returned path ends with '/'.
+    static String getCacheDirectory();
+
     /// get the system's default OpenMS.ini file in the users home directory (&lt;home&gt;/OpenMS/OpenMS.ini)
     /// or create/repair it if required
     /// order:
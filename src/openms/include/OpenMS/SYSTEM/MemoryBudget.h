@@ -0,0 +1,48 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/config.h>
+#include <OpenMS/CONCEPT/Types.h>
+
+namespace OpenMS
+{
+  /**
+    @brief Process-wide memory budget which large containers can query
+
+    The budget is a limit on the resident memory of the process (as reported by
+    SysInfo::getProcessMemoryConsumption()). It is set once, e.g. by TOPPBase from
+    the '-memory_limit' option. Containers which can hold their data elsewhere
+    (see SpillableSpectrumList) check isExceeded() when they grow and move cold data
+    to disk instead of exhausting the memory.
+
+    Without a limit (the default), or if the memory usage cannot be determined on
+    this platform, the budget is never exceeded.
+
+    @ingroup System
+  */
+  class OPENMS_DLLAPI MemoryBudget
+  {
+public:
+    /// Sets the limit in bytes (0 for no limit)
+    static void setLimit(UInt64 bytes);
+
+    /// Limit in bytes (0 if there is no limit)
+    static UInt64 getLimit();
+
+    /// Whether a limit is set
+    static bool hasLimit();
+
+    /// Current resident memory of the process in bytes (0 if unknown)
+    static UInt64 getUsage();
+
+    /// Whether the current memory usage plus @p additional_bytes exceeds the limit
+    static bool isExceeded(UInt64 additional_bytes = 0);
+  };
+}
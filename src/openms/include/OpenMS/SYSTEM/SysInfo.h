@@ -20,7 +20,7 @@ namespace OpenMS
 	/**
 	@brief Some functions to get system information
 
-	Supports current memory and peak memory consumption.
+	Supports current memory and peak memory consumption, and the NUMA topology.
 
 	*/
 	class OPENMS_DLLAPI SysInfo
@@ -42,6 +42,13 @@ namespace OpenMS
       /// @return True on success, false otherwise. If false is returned, then @p mem_virtual is set to 0.
       static bool getProcessPeakMemoryConsumption(size_t& mem_virtual);
 
+      /// Get the number of NUMA nodes (sockets) with cores this process may use (1 on systems without NUMA information)
+      static Size getNumaNodeCount();
+
+      /// Get a human readable description of the NUMA topology, e.g. "2 NUMA nodes (16 + 16 cores)"
+      /// @see TaskScheduler::getNumaTopology() for the cores of each node
+      static String getNumaTopologyInfo();
+
       /**
         @brief A convenience class to report either absolute or delta (between two timepoints) RAM usage
 
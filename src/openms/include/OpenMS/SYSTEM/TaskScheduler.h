@@ -0,0 +1,415 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/config.h>
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Composable task parallelism on top of the OpenMP runtime
+
+    parallelFor() and TaskGroup distribute work as OpenMP tasks. Called outside of a parallel
+    region, they open one (with getNumThreads() threads). Called from within a parallel region or
+    from within another task (e.g. the body of an outer parallelFor()), they create tasks in the
+    already running team instead of a nested team. This way nested parallelism neither
+    oversubscribes the cores nor needs to be tuned by hand (like distributing threads between
+    an outer and an inner loop): idle threads pick up (steal) pending tasks of any level.
+
+    Exceptions thrown by a task are rethrown (the first one only) in the calling thread once all
+    tasks are done, following the usual pattern for OpenMP loops in OpenMS.
+
+    The number of threads is shared with plain OpenMP regions (see setNumThreads()). Threads can be
+    bound to cores (setThreadAffinity()), optionally spread over the NUMA nodes of multi-socket machines.
+    On such machines, placeMemory() moves the pages of large data structures (e.g. the spectra of
+    an MSExperiment) to the nodes of the threads processing them, or interleaves them over all nodes.
+
+    Results of parallel loops which are merged as the threads finish (e.g. written to a shared
+    output) can be merged in the order of the loop indices with OrderedMerge. It does so if the
+    deterministic mode is on (see setDeterministic()), which makes the output independent of the
+    number of threads and of the schedule at the cost of buffering results which finish early.
+
+    @note Without OpenMP support (or with compilers supporting OpenMP < 4.5, which lacks 'taskloop'),
+    parallelFor() falls back to a dynamically scheduled 'parallel for' at the outermost
+    level and runs nested calls serially; TaskGroup then runs its tasks serially.
+
+    @ingroup System
+  */
+  class OPENMS_DLLAPI TaskScheduler
+  {
+public:
+    /// Binding of threads to cores
+    enum class ThreadAffinity
+    {
+      NONE, ///< no binding (threads may run on any core the process is allowed to use)
+      COMPACT, ///< thread i is bound to the i-th allowed core (fills one NUMA node after the other)
+      SPREAD ///< threads are distributed round-robin over the NUMA nodes, then bound to the next free core of the node
+    };
+
+    /// Placement of memory on the NUMA nodes, see placeMemory()
+    enum class MemoryPlacement
+    {
+      DEFAULT, ///< leave the memory where it is (usually on the node of the thread which allocated it first)
+      FIRST_TOUCH, ///< element i is copied by the thread processing it in a statically scheduled loop (i.e. placed on the node of that thread)
+      INTERLEAVE ///< pages are distributed round-robin over all NUMA nodes (balanced bandwidth for dynamically scheduled loops)
+    };
+
+    /**
+      @brief A group of tasks which are waited for together
+
+      Tasks added with run() from within a parallel region start immediately; otherwise they start
+      when wait() is called. wait() must be called from the thread (task) which added the tasks.
+      The destructor waits for outstanding tasks, but drops their exceptions.
+    */
+    class OPENMS_DLLAPI TaskGroup
+    {
+public:
+      TaskGroup() = default;
+      TaskGroup(const TaskGroup&) = delete;
+      TaskGroup& operator=(const TaskGroup&) = delete;
+
+      /// Waits for outstanding tasks
+      ~TaskGroup();
+
+      /// Adds a task (any callable without arguments)
+      template <typename Function>
+      void run(Function&& task)
+      {
+        tasks_.emplace_back(std::forward<Function>(task));
+        if (TaskScheduler::inParallel_())
+        {
+          startPending_();
+        }
+      }
+
+      /**
+        @brief Waits for all tasks added so far
+
+        @exception Rethrows the first exception thrown by a task
+      */
+      void wait();
+
+private:
+      /// starts all tasks which were not started yet (as OpenMP tasks)
+      void startPending_();
+
+      /// runs @p task, storing its exception (if any)
+      void execute_(const std::function<void()>& task);
+
+      std::deque<std::function<void()> > tasks_; ///< all tasks (deque: references stay valid while adding)
+      Size started_ = 0; ///< tasks [0, started_) have been started already
+      std::exception_ptr error_;
+    };
+
+    /**
+      @brief Merges results of parallel loop iterations in the order of their indices
+
+      Each iteration hands its result over with add(). In ordered mode (the default in the
+      deterministic mode, see setDeterministic()), the consumer is called for the results in the order
+      of their indices, starting with @p first: results which are ready before all their predecessors
+      are buffered. Otherwise, the consumer is called for every result right away (i.e. in the order in
+      which the iterations finish, like a critical section). Either way, the consumer is called by one
+      thread at a time.
+
+      Every index should be added exactly once (add an empty result for iterations without output);
+      finish() consumes the buffered results of indices after a gap.
+    */
+    template <typename Result>
+    class OrderedMerge
+    {
+public:
+      /// Called with the index and the result of an iteration
+      typedef std::function<void(Size index, Result& result)> Consumer;
+
+      /**
+        @brief Constructor
+
+        @param consumer Called for each result
+        @param first The first index
+        @param ordered Call the consumer in the order of the indices (see above)
+      */
+      explicit OrderedMerge(Consumer consumer, Size first = 0, bool ordered = TaskScheduler::isDeterministic()) :
+        consumer_(std::move(consumer)),
+        next_(first),
+        ordered_(ordered)
+      {
+      }
+
+      OrderedMerge(const OrderedMerge&) = delete;
+      OrderedMerge& operator=(const OrderedMerge&) = delete;
+
+      /**
+        @brief Hands over the result of iteration @p index (may be called concurrently)
+
+        @exception Passes on exceptions of the consumer
+      */
+      void add(Size index, Result result)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!ordered_)
+        {
+          consumer_(index, result);
+          return;
+        }
+        if (index != next_)
+        {
+          pending_.emplace(index, std::move(result));
+          return;
+        }
+        consumer_(index, result);
+        ++next_;
+        consumePending_(false);
+      }
+
+      /**
+        @brief Consumes all buffered results (in the order of their indices); call it after the loop
+
+        @exception Passes on exceptions of the consumer
+      */
+      void finish()
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        consumePending_(true);
+      }
+
+      /// Whether the consumer is called in the order of the indices
+      bool isOrdered() const
+      {
+        return ordered_;
+      }
+
+      /// Number of buffered results (waiting for their predecessors)
+      Size pendingCount() const
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pending_.size();
+      }
+
+private:
+      /// consumes the buffered results which are next in order (or all of them if @p all), provided the lock is held
+      void consumePending_(bool all)
+      {
+        while (!pending_.empty() && (all || pending_.begin()->first == next_))
+        {
+          auto it = pending_.begin();
+          next_ = it->first + 1;
+          Result result = std::move(it->second);
+          pending_.erase(it);
+          consumer_(next_ - 1, result);
+        }
+      }
+
+      Consumer consumer_;
+      Size next_; ///< the next index to consume
+      bool ordered_;
+      std::map<Size, Result> pending_; ///< results which are ready before their predecessors
+      mutable std::mutex mutex_;
+    };
+
+    /**
+      @brief Calls @p body(i) for all @p i in [@p begin, @p end) in parallel
+
+      @param begin First index
+      @param end One past the last index
+      @param body Callable taking a SignedSize index; must be safe to call concurrently
+      @param grain_size Minimal number of consecutive indices processed by one task (increase for cheap bodies)
+
+      @exception Rethrows the first exception thrown by @p body
+    */
+    template <typename Function>
+    static void parallelFor(SignedSize begin, SignedSize end, const Function& body, SignedSize grain_size = 1)
+    {
+      if (end <= begin)
+      {
+        return;
+      }
+      grain_size = std::max(grain_size, SignedSize(1));
+      std::exception_ptr error;
+#if defined(_OPENMP) && _OPENMP >= 201511
+      if (inParallel_())
+      {
+        taskLoop_(begin, end, body, grain_size, error);
+      }
+      else
+      {
+#pragma omp parallel
+#pragma omp single
+        taskLoop_(begin, end, body, grain_size, error);
+      }
+#else
+      if (inParallel_())
+      {
+        for (SignedSize i = begin; i < end; ++i)
+        {
+          body(i);
+        }
+      }
+      else
+      {
+#pragma omp parallel for schedule(dynamic, grain_size)
+        for (SignedSize i = begin; i < end; ++i)
+        {
+          try
+          {
+            body(i);
+          }
+          catch (...)
+          {
+#pragma omp critical (TaskScheduler_error)
+            if (!error) error = std::current_exception();
+          }
+        }
+      }
+#endif
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+    }
+
+    /// Sets the maximal number of threads used by parallelFor(), TaskGroup and OpenMP parallel regions (at least 1)
+    static void setNumThreads(int num_threads);
+
+    /// Returns the maximal number of threads (1 without OpenMP)
+    static int getNumThreads();
+
+    /**
+      @brief Binds the threads of subsequent parallel regions to cores
+
+      The binding is applied to the threads of the OpenMP thread pool (i.e. the current getNumThreads()
+      threads), so call it again after changing the number of threads.
+      Only supported on Linux; on other systems (or if the binding fails) nothing is changed.
+
+      @return true if the binding was applied
+    */
+    static bool setThreadAffinity(ThreadAffinity affinity);
+
+    /**
+      @brief Re-allocates all elements of @p elements with the given NUMA @p placement
+
+      Every element is copied (in parallel) and the copy replaces the original. With FIRST_TOUCH,
+      the elements are partitioned between the threads exactly like a 'parallel for schedule(static)'
+      loop over the container does, so this pays off most when the threads are bound to cores
+      (setThreadAffinity()). INTERLEAVE suits dynamically scheduled loops. Only memory which the copies
+      obtain as fresh pages from the operating system (i.e. large allocations) is affected.
+      Without OpenMP or on single-node machines, this only costs time.
+
+      @param elements Random access container (its value type must be copy-constructible and move-assignable)
+      @param placement The placement (nothing is done for DEFAULT)
+
+      @exception Rethrows exceptions of the copies (e.g. std::bad_alloc)
+    */
+    template <typename Container>
+    static void placeMemory(Container& elements, MemoryPlacement placement)
+    {
+      if (placement == MemoryPlacement::DEFAULT)
+      {
+        return;
+      }
+      const SignedSize size = SignedSize(elements.size());
+      std::exception_ptr error;
+#pragma omp parallel
+      {
+        const bool interleaved = (placement == MemoryPlacement::INTERLEAVE) && setMemoryInterleaving(true);
+#pragma omp for schedule(static)
+        for (SignedSize i = 0; i < size; ++i)
+        {
+          try
+          {
+            typename Container::value_type copy(elements[i]); // new memory, written by this thread
+            elements[i] = std::move(copy);
+          }
+          catch (...)
+          {
+#pragma omp critical (TaskScheduler_error)
+            if (!error) error = std::current_exception();
+          }
+        }
+        if (interleaved)
+        {
+          setMemoryInterleaving(false);
+        }
+      }
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+    }
+
+    /// Sets the placement used by default for loaded data (e.g. by MzMLFile::load()); DEFAULT initially
+    static void setMemoryPlacement(MemoryPlacement placement);
+
+    /// Returns the placement used by default for loaded data
+    static MemoryPlacement getMemoryPlacement();
+
+    /**
+      @brief Switches the deterministic mode on or off (off initially)
+
+      In the deterministic mode, algorithms merge the results of their threads in a fixed order
+      (e.g. with OrderedMerge) and derive random values like unique ids from the work item instead
+      of the thread (see UniqueIdGenerator::ItemScope), so the output does not depend on the
+      number of threads. This may cost some memory for buffered results.
+    */
+    static void setDeterministic(bool deterministic);
+
+    /// Returns whether the deterministic mode is on
+    static bool isDeterministic();
+
+    /**
+      @brief Interleaves memory allocated subsequently by the calling thread over all NUMA nodes (or stops doing so)
+
+      Only supported on Linux.
+
+      @return true if the memory policy of the thread was changed
+    */
+    static bool setMemoryInterleaving(bool interleave);
+
+    /**
+      @brief Returns the cores the process may use, grouped by NUMA node
+
+      On Linux, NUMA nodes are read from /sys/devices/system/node. If unavailable (or on other systems),
+      all cores form a single node.
+    */
+    static std::vector<std::vector<int> > getNumaTopology();
+
+private:
+    /// are we inside of a parallel region (or a task of it)?
+    static bool inParallel_();
+
+    template <typename Function>
+    static void taskLoop_(SignedSize begin, SignedSize end, const Function& body, SignedSize grain_size, std::exception_ptr& error)
+    {
+#if defined(_OPENMP) && _OPENMP >= 201511
+#pragma omp taskloop grainsize(grain_size) shared(body, error)
+#endif
+      for (SignedSize i = begin; i < end; ++i)
+      {
+        try
+        {
+          body(i);
+        }
+        catch (...)
+        {
+#pragma omp critical (TaskScheduler_error)
+          if (!error) error = std::current_exception();
+        }
+      }
+    }
+  };
+}
@@ -24,12 +24,14 @@ ExternalProcess.h
 File.h
 FileWatcher.h
 JavaInfo.h
+MemoryBudget.h
 NetworkGetRequest.h
 PythonInfo.h
 RWrapper.h
 SIMDe.h
 StopWatch.h
 SysInfo.h
+TaskScheduler.h
 UpdateCheck.h
 )
 
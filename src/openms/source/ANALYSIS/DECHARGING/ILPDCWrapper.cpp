@@ -37,6 +37,7 @@ namespace OpenMS
     pairs_clique_ordered.reserve(pairs.size());
     typedef std::vector<std::pair<Size, Size> > BinType;
     BinType bins;
+    std::pair<Size, Size> conflict_free_range(0, 0);
     // check number of components for complete putative edge graph (usually not all will be set to 'active' during ILP):
     {
       //
@@ -119,8 +120,15 @@ namespace OpenMS
 
       Size start(0);
       Size count(0);
+      // components without conflicting edges do not need the ILP; they are appended after all bins
+      std::vector<const std::set<Size>*> conflict_free;
       for (std::map<Size, std::set<Size> >::const_iterator it = g2pairs.begin(); it != g2pairs.end(); ++it)
       {
+        if (isConflictFree_(pairs, it->second))
+        {
+          conflict_free.push_back(&it->second);
+          continue;
+        }
         Size clique_size = it->second.size();
         if (count > pairs_per_bin || clique_size > big_clique_bin_threshold)
         {
@@ -153,6 +161,20 @@ namespace OpenMS
       }
       if (count > 0)
         bins.push_back(std::make_pair(start, pairs_clique_ordered.size()));
+
+      conflict_free_range.first = pairs_clique_ordered.size();
+      for (const std::set<Size>* component : conflict_free)
+      {
+        for (Size i_p : *component)
+        {
+          pairs_clique_ordered.push_back(pairs[i_p]);
+        }
+      }
+      conflict_free_range.second = pairs_clique_ordered.size();
+      if (verbose_level > 1)
+      {
+        OPENMS_LOG_INFO << "  " << conflict_free.size() << " component(s) without conflicting edges do not require the ILP\n";
+      }
     }
 
     if (pairs_clique_ordered.size() != pairs.size())
@@ -167,14 +189,14 @@ namespace OpenMS
     time1.start();
 
     // split problem into slices and have each one solved by the ILPS
-    double score = 0;
+    double score = computeConflictFreeSlice_(fm, pairs, conflict_free_range.first, conflict_free_range.second);
 // OMP currently causes spurious segfaults in Release mode; OMP fix applied, however: disable if problem persists
 //#ifdef _OPENMP
 //#pragma omp parallel for schedule(dynamic, 1), reduction(+: score)
 //#endif
     for (SignedSize i = 0; i < static_cast<SignedSize>(bins.size()); ++i)
     {
-      score = computeSlice_(fm, pairs, bins[i].first, bins[i].second, verbose_level);
+      score += computeSlice_(fm, pairs, bins[i].first, bins[i].second, verbose_level);
     }
     time1.stop();
     OPENMS_LOG_INFO << " Branch and cut took " << time1.getClockTime() << " seconds, "
@@ -189,6 +211,49 @@ namespace OpenMS
     f_set[rota_l].insert(v);
   }
 
+  String ILPDCWrapper::getFeatureVariant_(const PairsType::value_type& pair, UInt side) const
+  {
+    return String(pair.getElementIndex(side)) + pair.getCompomer().getAdductsAsString(side) + "_" + pair.getCharge(side);
+  }
+
+  bool ILPDCWrapper::isConflictFree_(const PairsType& pairs, const std::set<Size>& pair_indices) const
+  {
+    std::map<Size, String> variants; // feature --> its only variant so far
+    for (Size i : pair_indices)
+    {
+      for (UInt side = 0; side < 2; ++side)
+      {
+        String variant = getFeatureVariant_(pairs[i], side);
+        auto pos = variants.emplace(pairs[i].getElementIndex(side), variant);
+        if (!pos.second && pos.first->second != variant)
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  double ILPDCWrapper::computeConflictFreeSlice_(const FeatureMap& fm,
+                                                 PairsType& pairs,
+                                                 const PairsIndex margin_left,
+                                                 const PairsIndex margin_right) const
+  {
+    // the ILP would fix the single variant of each feature and could then choose every edge independently
+    double objective = 0;
+    for (PairsIndex i = margin_left; i < margin_right; ++i)
+    {
+      double score = exp(getLogScore_(pairs[i], fm));
+      pairs[i].setEdgeScore(score * pairs[i].getEdgeScore()); // multiply with preset score (as in computeSlice_)
+      if (pairs[i].getEdgeScore() > 0)
+      {
+        pairs[i].setActive(true);
+        objective += pairs[i].getEdgeScore();
+      }
+    }
+    return objective;
+  }
+
   double ILPDCWrapper::computeSlice_(const FeatureMap& fm,
                                      PairsType& pairs,
                                      const PairsIndex margin_left,
@@ -218,9 +283,9 @@ namespace OpenMS
       build.setObjective(index, pairs[i].getEdgeScore());
 
       // create feature variants set
-      String rota_l = String(pairs[i].getElementIndex(0)) + pairs[i].getCompomer().getAdductsAsString(0) + "_" + pairs[i].getCharge(0);
+      String rota_l = getFeatureVariant_(pairs[i], 0);
       updateFeatureVariant_(features[pairs[i].getElementIndex(0)], rota_l, index);
-      String rota_r = String(pairs[i].getElementIndex(1)) + pairs[i].getCompomer().getAdductsAsString(1) + "_" + pairs[i].getCharge(1);
+      String rota_r = getFeatureVariant_(pairs[i], 1);
       updateFeatureVariant_(features[pairs[i].getElementIndex(1)], rota_r, index);
     }
 
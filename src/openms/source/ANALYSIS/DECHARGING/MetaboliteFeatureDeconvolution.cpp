@@ -18,6 +18,7 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 
 //DEBUG:
+#include <exception>
 #include <fstream>
 #include <map>
 
@@ -138,6 +139,8 @@ namespace OpenMS
     map_label_inverse_[param_.getValue("default_map_label").toString()] = 0; // default virtual map (for unlabeled experiments)
     map_label_[0] = param_.getValue("default_map_label").toString();
 
+    negative_mode_ = (param_.getValue("negative_mode") == "true");
+
     if (param_.getValue("q_try") == "feature")
       q_try_ = QFROMFEATURE;
     else if (param_.getValue("q_try") == "heuristic")
@@ -408,221 +411,271 @@ namespace OpenMS
     OPENMS_LOG_INFO << "done\n";
 
 
-    // holds query results for a mass difference
-    MassExplainer::CompomerIterator md_s, md_e;
     Compomer null_compomer(0, 0, -std::numeric_limits<double>::max());
-    SignedSize hits(0);
 
-    CoordinateType mz1, mz2, m1;
     Size possibleEdges(0), overallHits(0);
 
     // # compomer results that either passed or failed the feature charge constraints
     Size no_cmp_hit(0), cmp_hit(0);
 
-    for (Size i_RT = 0; i_RT < fm_out.size(); ++i_RT) // ** RT-sweep line
-    {
-      mz1 = fm_out[i_RT].getMZ();
-
-      for (Size i_RT_window = i_RT + 1
-           ; (i_RT_window < fm_out.size())
-          && ((fm_out[i_RT_window].getRT() - fm_out[i_RT].getRT()) <= rt_diff_max)
-           ; ++i_RT_window)
-      { // ** RT-window
-
-        // knock-out criterion first: RT overlap
-        // use sorted structure and use 2nd start--1st end / 1st start--2nd end
-        const Feature& f1 = fm_out[i_RT];
-        const Feature& f2 = fm_out[i_RT_window];
-
-        if (!(f1.getConvexHull().getBoundingBox().isEmpty() || f2.getConvexHull().getBoundingBox().isEmpty()))
-        {
-          double f_start1 = std::min(f1.getConvexHull().getBoundingBox().minX(), f2.getConvexHull().getBoundingBox().minX());
-          double f_start2 = std::max(f1.getConvexHull().getBoundingBox().minX(), f2.getConvexHull().getBoundingBox().minX());
-          double f_end1 = std::min(f1.getConvexHull().getBoundingBox().maxX(), f2.getConvexHull().getBoundingBox().maxX());
-          double f_end2 = std::max(f1.getConvexHull().getBoundingBox().maxX(), f2.getConvexHull().getBoundingBox().maxX());
+    const String unit = param_.getValue("unit").toString();
+    const bool unit_da = (unit == "Da"), unit_ppm = (unit == "ppm");
 
-          double union_length = f_end2 - f_start1;
-          double intersect_length = std::max(0., f_end1 - f_start2);
+    // RT extents of the features (computing them from the convex hulls on the fly is expensive and not thread-safe)
+    std::vector<DBoundingBox<2> > hull_boxes(fm_out.size());
+    for (Size i = 0; i < fm_out.size(); ++i)
+    {
+      hull_boxes[i] = fm_out[i].getConvexHull().getBoundingBox();
+    }
 
-          if (intersect_length / union_length < rt_min_overlap)
-            continue;
-        }
+    // edges found for each feature of the sweep line, merged in order afterwards (identical to a serial sweep)
+    struct SweepLineEdges_
+    {
+      PairsType edges;
+      std::vector<std::pair<Size, CmpInfo_> > adducts; ///< feature index and its adduct (edge index relative to 'edges')
+      Size possible_edges = 0, overall_hits = 0, no_cmp_hit = 0, cmp_hit = 0;
+    };
+    std::vector<SweepLineEdges_> sweep_line_edges(fm_out.size());
+    std::exception_ptr error;
+
+#pragma omp parallel for schedule(dynamic, 100)
+    for (SignedSize i_RT = 0; i_RT < (SignedSize)fm_out.size(); ++i_RT) // ** RT-sweep line
+    {
+      try
+      {
+        SweepLineEdges_& found = sweep_line_edges[i_RT];
+        // holds query results for a mass difference
+        MassExplainer::CompomerIterator md_s, md_e;
+        SignedSize hits(0);
+        CoordinateType mz1, mz2, m1;
+
+        mz1 = fm_out[i_RT].getMZ();
+
+        for (Size i_RT_window = i_RT + 1
+             ; (i_RT_window < fm_out.size())
+            && ((fm_out[i_RT_window].getRT() - fm_out[i_RT].getRT()) <= rt_diff_max)
+             ; ++i_RT_window)
+        { // ** RT-window
+
+          // knock-out criterion first: RT overlap
+          // use sorted structure and use 2nd start--1st end / 1st start--2nd end
+          const Feature& f1 = fm_out[i_RT];
+          const Feature& f2 = fm_out[i_RT_window];
+
+          const DBoundingBox<2>& bb1 = hull_boxes[i_RT];
+          const DBoundingBox<2>& bb2 = hull_boxes[i_RT_window];
+          if (!(bb1.isEmpty() || bb2.isEmpty()))
+          {
+            double f_start1 = std::min(bb1.minX(), bb2.minX());
+            double f_start2 = std::max(bb1.minX(), bb2.minX());
+            double f_end1 = std::min(bb1.maxX(), bb2.maxX());
+            double f_end2 = std::max(bb1.maxX(), bb2.maxX());
 
-        // start guessing charges ...
-        mz2 = fm_out[i_RT_window].getMZ();
+            double union_length = f_end2 - f_start1;
+            double intersect_length = std::max(0., f_end1 - f_start2);
 
-        for (Int q1 = q_min; q1 <= q_max; ++q1) // ** q1
-        {
-          //We assume that ionization modes won't get mixed in pipeline ->
-          //detected features should have same charge sign as provided to decharger settings for positive mode.
-          //For negative mode, this requirement is relaxed.
-          if (!chargeTestworthy_(f1.getCharge(), q1, true))
-            continue;
-
-          m1 = mz1 * abs(q1);
-          // additionally: forbid q1 and q2 with distance greater than q_span
-          for (Int q2 = std::max(q_min, q1 - q_span + 1)
-               ; (q2 <= q_max) && (q2 <= q1 + q_span - 1)
-               ; ++q2)
-          { // ** q2
-            //again, for negative mode relaxed, thus we consider the absolute of charge
-            if (!chargeTestworthy_(f2.getCharge(), q2, abs(f1.getCharge()) == abs(q1)))
+            if (intersect_length / union_length < rt_min_overlap)
               continue;
+          }
 
-            ++possibleEdges; // internal count, not vital
-
-            // Find possible adduct combinations.
-            // Masses and tolerances are multiplied with their charges to nullify charge influence on mass shift.
-            // Allows to remove compound mass M from both sides of compomer equation -> queried shift only due to different adducts.
-            // Tolerance must increase when looking at M instead of m/z, as error margins increase as well by multiplication.
-            CoordinateType naive_mass_diff = mz2 * abs(q2) - m1;
-
-            double abs_mass_diff;
-            if (param_.getValue("unit") == "Da")
-            {
-              abs_mass_diff = mz_diff_max * abs(q1) + mz_diff_max * abs(q2);
-            }
-            else if (param_.getValue("unit") == "ppm")
-            {
-              // For the ppm case, we multiply the respective experimental feature mz by its allowed ppm error before multiplication by charge.
-              // We look at the tolerance window with a simplified way: Just use the feature mz, and assume a symmetric window around it.
-              // Instead of answering the more complex/asymmetrical question: "which experimental mz can for given tolerance cause observed mz".
-              // (In the complex case we might have to consider different queries for different tolerance windows.)
-              // The expected error of this simplification is negligible:
-              // Assuming Y > X (X > Y is analog), given causative experimental mz Y and observed mz X with
-              // X = Y*(1 - d)
-              // for allowed tolerance d, the expected Error E between experimental mz and maximal mz in the tolerance window based on experimental mz is:
-              // E = (mz_exp - (mz_obs + max tolerance))/mz_exp = (Y - X*(1 + d))/Y = 1 - X*(1 + d)/Y = 1 - Y*(1 - d)*(1 + d)/Y = 1 - 1 - d*d = - d*d
-              // As d should be ppm sized, the error is something around 10 to the power of minus 12.
-              abs_mass_diff = mz1 * mz_diff_max * 1e-6 * abs(q1)   +   mz2 * mz_diff_max * 1e-6 * abs(q2);
-            }
-            else
-            {
-              throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "WARNING! Invalid tolerance unit! " + param_.getValue("unit").toString()  + "\n");
-            }
+          // start guessing charges ...
+          mz2 = fm_out[i_RT_window].getMZ();
 
-            //abs charge "3" to abs charge "1" -> simply invert charge delta for negative case?
-            hits = me.query(q2 - q1, naive_mass_diff, abs_mass_diff, thresh_logp, md_s, md_e);
-            OPENMS_PRECONDITION(hits >= 0, "MetaboliteFeatureDeconvolution querying #hits got negative result!");
+          for (Int q1 = q_min; q1 <= q_max; ++q1) // ** q1
+          {
+            //We assume that ionization modes won't get mixed in pipeline ->
+            //detected features should have same charge sign as provided to decharger settings for positive mode.
+            //For negative mode, this requirement is relaxed.
+            if (!chargeTestworthy_(f1.getCharge(), q1, true))
+              continue;
 
-            overallHits += hits;
-            // choose most probable hit (TODO think of something clever here)
-            // for now, we take the one that has highest p in terms of the compomer structure
-            if (hits > 0)
-            {
-              Compomer best_hit = null_compomer;
-              for (; md_s != md_e; ++md_s)
+            m1 = mz1 * abs(q1);
+            // additionally: forbid q1 and q2 with distance greater than q_span
+            for (Int q2 = std::max(q_min, q1 - q_span + 1)
+                 ; (q2 <= q_max) && (q2 <= q1 + q_span - 1)
+                 ; ++q2)
+            { // ** q2
+              //again, for negative mode relaxed, thus we consider the absolute of charge
+              if (!chargeTestworthy_(f2.getCharge(), q2, abs(f1.getCharge()) == abs(q1)))
+                continue;
+
+              ++found.possible_edges; // internal count, not vital
+
+              // Find possible adduct combinations.
+              // Masses and tolerances are multiplied with their charges to nullify charge influence on mass shift.
+              // Allows to remove compound mass M from both sides of compomer equation -> queried shift only due to different adducts.
+              // Tolerance must increase when looking at M instead of m/z, as error margins increase as well by multiplication.
+              CoordinateType naive_mass_diff = mz2 * abs(q2) - m1;
+
+              double abs_mass_diff;
+              if (unit_da)
+              {
+                abs_mass_diff = mz_diff_max * abs(q1) + mz_diff_max * abs(q2);
+              }
+              else if (unit_ppm)
               {
-                // post-filter hits by local RT
-                if (fabs(f1.getRT() - f2.getRT() + md_s->getRTShift()) > rt_diff_max_local)
-                  continue;
+                // For the ppm case, we multiply the respective experimental feature mz by its allowed ppm error before multiplication by charge.
+                // We look at the tolerance window with a simplified way: Just use the feature mz, and assume a symmetric window around it.
+                // Instead of answering the more complex/asymmetrical question: "which experimental mz can for given tolerance cause observed mz".
+                // (In the complex case we might have to consider different queries for different tolerance windows.)
+                // The expected error of this simplification is negligible:
+                // Assuming Y > X (X > Y is analog), given causative experimental mz Y and observed mz X with
+                // X = Y*(1 - d)
+                // for allowed tolerance d, the expected Error E between experimental mz and maximal mz in the tolerance window based on experimental mz is:
+                // E = (mz_exp - (mz_obs + max tolerance))/mz_exp = (Y - X*(1 + d))/Y = 1 - X*(1 + d)/Y = 1 - Y*(1 - d)*(1 + d)/Y = 1 - 1 - d*d = - d*d
+                // As d should be ppm sized, the error is something around 10 to the power of minus 12.
+                abs_mass_diff = mz1 * mz_diff_max * 1e-6 * abs(q1)   +   mz2 * mz_diff_max * 1e-6 * abs(q2);
+              }
+              else
+              {
+                throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "WARNING! Invalid tolerance unit! " + unit + "\n");
+              }
 
-                //std::cout << md_s->getAdductsAsString() << " neg: " << md_s->getNegativeCharges() << " pos: " << md_s->getPositiveCharges() << " p: " << md_s->getLogP() << " \n";
-                int left_charges, right_charges;
-                if (is_neg)
-                {
-                  left_charges = -md_s->getPositiveCharges();
-                  right_charges = -md_s->getNegativeCharges();//for negative, a pos charge means either losing an H-1 from the left (decreasing charge) or the Na  case. (We do H-1Na as neutral, because of the pos, neg charges)
-                }
-                else
-                {
-                  left_charges = md_s->getNegativeCharges();//for positive mode neutral switches still have to fulfill requirement that they have at most charge as each side
-                  right_charges = md_s->getPositiveCharges();
-                }
+              //abs charge "3" to abs charge "1" -> simply invert charge delta for negative case?
+              hits = me.query(q2 - q1, naive_mass_diff, abs_mass_diff, thresh_logp, md_s, md_e);
+              OPENMS_PRECONDITION(hits >= 0, "MetaboliteFeatureDeconvolution querying #hits got negative result!");
 
-                if ( // compomer fits charge assignment of left & right feature. doesn't consider charge sign switch over span!
-                  (abs(q1)  >= abs(left_charges)) && (abs(q2) >= abs(right_charges)))
+              found.overall_hits += hits;
+              // choose most probable hit (TODO think of something clever here)
+              // for now, we take the one that has highest p in terms of the compomer structure
+              if (hits > 0)
+              {
+                double best_log_p = null_compomer.getLogP();
+                for (; md_s != md_e; ++md_s)
                 {
-                  // compomer has better probability
-                  if (best_hit.getLogP() < md_s->getLogP())
-                    best_hit = *md_s;
-
+                  // post-filter hits by local RT
+                  if (fabs(f1.getRT() - f2.getRT() + md_s->getRTShift()) > rt_diff_max_local)
+                    continue;
 
-                  /** testing: we just add every explaining edge
-                      - a first estimate shows that 90% of hits are of |1|
-                      - the remaining 10% have |2|, so the additional overhead is minimal
-                  **/
-                  Compomer cmp = me.getCompomerById(md_s->getID());
+                  //std::cout << md_s->getAdductsAsString() << " neg: " << md_s->getNegativeCharges() << " pos: " << md_s->getPositiveCharges() << " p: " << md_s->getLogP() << " \n";
+                  int left_charges, right_charges;
                   if (is_neg)
                   {
-                    left_charges = -cmp.getPositiveCharges();
-                    right_charges = -cmp.getNegativeCharges();
+                    left_charges = -md_s->getPositiveCharges();
+                    right_charges = -md_s->getNegativeCharges();//for negative, a pos charge means either losing an H-1 from the left (decreasing charge) or the Na  case. (We do H-1Na as neutral, because of the pos, neg charges)
                   }
                   else
                   {
-                    left_charges = cmp.getNegativeCharges();
-                    right_charges = cmp.getPositiveCharges();
-                  }
-
-                  //this block should only be of interest if we have something multiply charges instead of protonation or deprotonation
-                  if (((q1 - left_charges) % default_adduct.getCharge() != 0) ||
-                      ((q2 - right_charges) % default_adduct.getCharge() != 0))
-                  {
-                    OPENMS_LOG_WARN << "Cannot add enough default adduct (" << default_adduct.getFormula() << ") to exactly fit feature charge! Next...)\n";
-                    continue;
-                  }
-
-                  int hc_left  = (q1 - left_charges) / default_adduct.getCharge();//this should always be positive! check!!
-                  int hc_right = (q2 - right_charges) / default_adduct.getCharge();//this should always be positive! check!!
-
-
-                  if (hc_left < 0 || hc_right < 0)
-                  {
-                    throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "WARNING!!! implicit number of default adduct is negative!!! left:" + String(hc_left) + " right: " + String(hc_right) + "\n");
-                  }
-
-                  // intensity constraint:
-                  // no edge is drawn if low-prob feature has higher intensity
-                  if (!intensityFilterPassed_(q1, q2, cmp, f1, f2))
-                    continue;
-
-                  // get non-default adducts of this edge
-                  Compomer cmp_stripped(cmp.removeAdduct(default_adduct));
-
-                  // save new adduct candidate
-                  if (!cmp_stripped.getComponent()[Compomer::LEFT].empty())
-                  {
-                    String tmp = cmp_stripped.getAdductsAsString(Compomer::LEFT);
-                    CmpInfo_ cmp_left(tmp, feature_relation.size(), Compomer::LEFT);
-                    feature_adducts[i_RT].insert(cmp_left);
-                  }
-                  if (!cmp_stripped.getComponent()[Compomer::RIGHT].empty())
-                  {
-                    String tmp = cmp_stripped.getAdductsAsString(Compomer::RIGHT);
-                    CmpInfo_ cmp_right(tmp, feature_relation.size(), Compomer::RIGHT);
-                    feature_adducts[i_RT_window].insert(cmp_right);
+                    left_charges = md_s->getNegativeCharges();//for positive mode neutral switches still have to fulfill requirement that they have at most charge as each side
+                    right_charges = md_s->getPositiveCharges();
                   }
 
-                  // add implicit default adduct (H+ or H-) (if != 0)
-                  if (hc_left > 0)
-                  {
-                    cmp.add(default_adduct * hc_left, Compomer::LEFT);
-                  }
-                  if (hc_right > 0)
+                  if ( // compomer fits charge assignment of left & right feature. doesn't consider charge sign switch over span!
+                    (abs(q1)  >= abs(left_charges)) && (abs(q2) >= abs(right_charges)))
                   {
-                    cmp.add(default_adduct * hc_right, Compomer::RIGHT);
+                    // compomer has better probability
+                    if (best_log_p < md_s->getLogP())
+                      best_log_p = md_s->getLogP();
+
+
+                    /** testing: we just add every explaining edge
+                        - a first estimate shows that 90% of hits are of |1|
+                        - the remaining 10% have |2|, so the additional overhead is minimal
+                    **/
+                    Compomer cmp = me.getCompomerById(md_s->getID());
+                    if (is_neg)
+                    {
+                      left_charges = -cmp.getPositiveCharges();
+                      right_charges = -cmp.getNegativeCharges();
+                    }
+                    else
+                    {
+                      left_charges = cmp.getNegativeCharges();
+                      right_charges = cmp.getPositiveCharges();
+                    }
+
+                    //this block should only be of interest if we have something multiply charges instead of protonation or deprotonation
+                    if (((q1 - left_charges) % default_adduct.getCharge() != 0) ||
+                        ((q2 - right_charges) % default_adduct.getCharge() != 0))
+                    {
+                      OPENMS_LOG_WARN << "Cannot add enough default adduct (" << default_adduct.getFormula() << ") to exactly fit feature charge! Next...)\n";
+                      continue;
+                    }
+
+                    int hc_left  = (q1 - left_charges) / default_adduct.getCharge();//this should always be positive! check!!
+                    int hc_right = (q2 - right_charges) / default_adduct.getCharge();//this should always be positive! check!!
+
+
+                    if (hc_left < 0 || hc_right < 0)
+                    {
+                      throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "WARNING!!! implicit number of default adduct is negative!!! left:" + String(hc_left) + " right: " + String(hc_right) + "\n");
+                    }
+
+                    // intensity constraint:
+                    // no edge is drawn if low-prob feature has higher intensity
+                    if (!intensityFilterPassed_(q1, q2, cmp, f1, f2))
+                      continue;
+
+                    // get non-default adducts of this edge
+                    Compomer cmp_stripped(cmp.removeAdduct(default_adduct));
+
+                    // save new adduct candidate
+                    if (!cmp_stripped.getComponent()[Compomer::LEFT].empty())
+                    {
+                      String tmp = cmp_stripped.getAdductsAsString(Compomer::LEFT);
+                      CmpInfo_ cmp_left(tmp, found.edges.size(), Compomer::LEFT);
+                      found.adducts.emplace_back(i_RT, cmp_left);
+                    }
+                    if (!cmp_stripped.getComponent()[Compomer::RIGHT].empty())
+                    {
+                      String tmp = cmp_stripped.getAdductsAsString(Compomer::RIGHT);
+                      CmpInfo_ cmp_right(tmp, found.edges.size(), Compomer::RIGHT);
+                      found.adducts.emplace_back(i_RT_window, cmp_right);
+                    }
+
+                    // add implicit default adduct (H+ or H-) (if != 0)
+                    if (hc_left > 0)
+                    {
+                      cmp.add(default_adduct * hc_left, Compomer::LEFT);
+                    }
+                    if (hc_right > 0)
+                    {
+                      cmp.add(default_adduct * hc_right, Compomer::RIGHT);
+                    }
+
+                    ChargePair cp(i_RT, i_RT_window, q1, q2, cmp, naive_mass_diff - md_s->getMass(), false);
+                    found.edges.push_back(cp);
                   }
+                } // ! hits loop
 
-                  ChargePair cp(i_RT, i_RT_window, q1, q2, cmp, naive_mass_diff - md_s->getMass(), false);
-                  feature_relation.push_back(cp);
+                if (best_log_p == null_compomer.getLogP())
+                {
+                  //std::cout << "MetaboliteFeatureDeconvolution.h:: could find no compomer complying with assumed q1 and q2 values!\n with q1: " << q1 << " q2: " << q2 << "\n";
+                  ++found.no_cmp_hit;
+                }
+                else
+                {
+                  ++found.cmp_hit;
                 }
-              } // ! hits loop
-
-              if (best_hit == null_compomer)
-              {
-                //std::cout << "MetaboliteFeatureDeconvolution.h:: could find no compomer complying with assumed q1 and q2 values!\n with q1: " << q1 << " q2: " << q2 << "\n";
-                ++no_cmp_hit;
-              }
-              else
-              {
-                ++cmp_hit;
               }
-            }
 
-          } // q2
-        } // q1
-      } // RT-window
+            } // q2
+          } // q1
+        } // RT-window
+      }
+      catch (...)
+      {
+#pragma omp critical (MetaboliteFeatureDeconvolution_candidateEdges)
+        if (!error) error = std::current_exception();
+      }
     } // RT sweep line
+    if (error) std::rethrow_exception(error);
+
+    for (SweepLineEdges_& found : sweep_line_edges)
+    {
+      Size offset = feature_relation.size();
+      for (std::pair<Size, CmpInfo_>& adduct : found.adducts)
+      {
+        adduct.second.idx_cp += offset;
+        feature_adducts[adduct.first].insert(adduct.second);
+      }
+      feature_relation.insert(feature_relation.end(), found.edges.begin(), found.edges.end());
+      possibleEdges += found.possible_edges;
+      overallHits += found.overall_hits;
+      no_cmp_hit += found.no_cmp_hit;
+      cmp_hit += found.cmp_hit;
+      found = SweepLineEdges_();
+    }
 
 
     OPENMS_LOG_INFO << no_cmp_hit << " of " << (no_cmp_hit + cmp_hit) << " valid net charge compomer results did not pass the feature charge constraints\n";
@@ -1248,8 +1301,7 @@ namespace OpenMS
     //Further, we have two scenarios: 1. The features come from FFM, then all charges are absolute.
     // 2. We iteratively decharge negative mode, leading to decharger featureXML outputs with new negative charges.
     //Thus, we restrict this check for test worthiness to positive mode, as for negative mode both charge signs are valid.
-    bool is_neg = (param_.getValue("negative_mode") == "true" ? true : false);
-    if (!is_neg && (feature_charge * putative_charge < 0))
+    if (!negative_mode_ && (feature_charge * putative_charge < 0))
     {
       throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("feature charge and putative positive mode charge switch charge direction!"), String(feature_charge)+" "+String(putative_charge));
     }
@@ -8,12 +8,15 @@
 
 #include <OpenMS/ANALYSIS/ID/AScore.h>
 
-#include <OpenMS/CHEMISTRY/TheoreticalSpectrumGenerator.h>
+#include <OpenMS/CHEMISTRY/Residue.h>
+#include <OpenMS/CONCEPT/Constants.h>
 #include <OpenMS/DATASTRUCTURES/MatchedIterator.h>
 #include <OpenMS/KERNEL/RangeUtils.h>
 
 #include <boost/math/special_functions/binomial.hpp>
 
+#include <algorithm>
+
 using namespace std;
 
 namespace OpenMS
@@ -99,12 +102,13 @@ namespace OpenMS
       real_spectrum.sortByPosition();
     }
     vector<PeakSpectrum> windows_top10 = peakPickingPerWindowsInSpectrum_(real_spectrum);
+    vector<vector<PeakSpectrum>> windows_by_depth = windowsByPeakDepth_(windows_top10);
 
     // compute match probability for a peak depth of 1
     base_match_probability_ = computeBaseProbability_(real_spectrum.back().getMZ());
 
     // calculate peptide score for each possible phospho site permutation
-    vector<vector<double>> peptide_site_scores = calculatePermutationPeptideScores_(th_spectra, windows_top10);
+    vector<vector<double>> peptide_site_scores = calculatePermutationPeptideScores_(th_spectra, windows_by_depth);
 
     // rank peptide permutations ascending
     multimap<double, Size> ranking = rankWeightedPermutationPeptideScores_(peptide_site_scores);
@@ -141,18 +145,12 @@ namespace OpenMS
         Size N = site_determining_ions[0].size(); // all possibilities have the same number so take the first one
         double p = static_cast<double>(s_it->peak_depth) * base_match_probability_;
 
-        Size n_first = 0; // number of matching peaks for first peptide
-        for (Size window_idx = 0; window_idx != windows_top10.size(); ++window_idx) // for each 100 m/z window
-        {
-          n_first += numberOfMatchedIons_(site_determining_ions[0], windows_top10[window_idx], s_it->peak_depth);        
-        }
+        // number of matching peaks for first peptide (over all 100 m/z windows)
+        Size n_first = numberOfMatchedIons_(site_determining_ions[0], windows_by_depth[s_it->peak_depth - 1]);
         double P_first = computeCumulativeScore_(N, n_first, p);
 
-        Size n_second = 0; // number of matching peaks for second peptide
-        for (Size window_idx = 0; window_idx <  windows_top10.size(); ++window_idx) //each 100 m/z window
-        {
-          n_second += numberOfMatchedIons_(site_determining_ions[1], windows_top10[window_idx], s_it->peak_depth);        
-        }
+        // number of matching peaks for second peptide
+        Size n_second = numberOfMatchedIons_(site_determining_ions[1], windows_by_depth[s_it->peak_depth - 1]);
         Size N2 = site_determining_ions[1].size(); // all possibilities have the same number so take the first one
         double P_second = computeCumulativeScore_(N2, n_second, p);
 
@@ -350,19 +348,44 @@ namespace OpenMS
     }
     
     window_reduced.sortByPosition();
+    return numberOfMatchedIons_(th, vector<PeakSpectrum>(1, window_reduced));
+  }
+
+  Size AScore::numberOfMatchedIons_(const PeakSpectrum& th, const vector<PeakSpectrum>& windows_at_depth) const
+  {
     Size matched_peaks(0);
-    if (fragment_tolerance_ppm_)
+    for (const PeakSpectrum& window : windows_at_depth)
     {
-      MatchedIterator<PeakSpectrum, PpmTrait> it(th, window_reduced, fragment_mass_tolerance_);
-      for (; it != it.end(); ++it) ++matched_peaks;
+      if (fragment_tolerance_ppm_)
+      {
+        MatchedIterator<PeakSpectrum, PpmTrait> it(th, window, fragment_mass_tolerance_);
+        for (; it != it.end(); ++it) ++matched_peaks;
+      }
+      else
+      {
+        MatchedIterator<PeakSpectrum, DaTrait> it(th, window, fragment_mass_tolerance_);
+        for (; it != it.end(); ++it) ++matched_peaks;
+      }
     }
-    else
+    return matched_peaks;
+  }
+
+  vector<vector<PeakSpectrum>> AScore::windowsByPeakDepth_(const vector<PeakSpectrum>& windows_top10) const
+  {
+    // the reduced windows only depend on the real spectrum, so they are sorted once for all permutations
+    vector<vector<PeakSpectrum>> windows_by_depth(10, windows_top10);
+    for (Size depth = 1; depth <= 10; ++depth)
     {
-      MatchedIterator<PeakSpectrum, DaTrait> it(th, window_reduced, fragment_mass_tolerance_);
-      for (; it != it.end(); ++it) ++matched_peaks;
+      for (PeakSpectrum& window : windows_by_depth[depth - 1])
+      {
+        if (window.size() > depth)
+        {
+          window.resize(depth);
+        }
+        window.sortByPosition();
+      }
     }
-    
-    return matched_peaks;
+    return windows_by_depth;
   }
 
   double AScore::peptideScore_(const std::vector<double>& scores) const
@@ -472,32 +495,66 @@ namespace OpenMS
   /// Create theoretical spectra
   vector<PeakSpectrum> AScore::createTheoreticalSpectra_(const vector<vector<Size>>& permutations, const AASequence& seq_without_phospho) const
   {
-    vector<PeakSpectrum> th_spectra;
-    TheoreticalSpectrumGenerator spectrum_generator;
-    
-    th_spectra.resize(permutations.size());
-    for (Size i = 0; i < permutations.size(); ++i)
+    vector<PeakSpectrum> th_spectra(permutations.size());
+    const Size n = seq_without_phospho.size();
+    if (n == 0)
     {
-      AASequence seq(seq_without_phospho);
-      Size permu = 0;
-      
-      for (Size as = 0; as < seq.size(); ++as)
+      return th_spectra;
+    }
+
+    // phosphorylated residues of all sites (looked up only once)
+    AASequence phospho_sites(seq_without_phospho);
+    vector<bool> is_site(n, false);
+    for (const vector<Size>& permutation : permutations)
+    {
+      for (Size site : permutation)
       {
-        if (as == permutations[i][permu])
+        if (!is_site[site])
         {
-          seq.setModification(as, "Phospho");
-          ++permu;
+          phospho_sites.setModification(site, "Phospho");
+          is_site[site] = true;
         }
-        
-        if (permu == permutations[i].size()) 
+      }
+    }
+
+    // same masses as the b- and y-ions (charge 1) of TheoreticalSpectrumGenerator
+    static const double b_shift = Constants::PROTON_MASS_U + Residue::getInternalToBIon().getMonoWeight();
+    static const double y_shift = Constants::PROTON_MASS_U + Residue::getInternalToYIon().getMonoWeight();
+    const double n_term_mass = seq_without_phospho.hasNTerminalModification() ? seq_without_phospho.getNTerminalModification()->getDiffMonoMass() : 0.0;
+    const double c_term_mass = seq_without_phospho.hasCTerminalModification() ? seq_without_phospho.getCTerminalModification()->getDiffMonoMass() : 0.0;
+
+    PeakSpectrum b_ions, y_ions;
+    for (Size i = 0; i < permutations.size(); ++i)
+    {
+      AASequence seq(seq_without_phospho);
+      for (Size site : permutations[i])
+      {
+        seq.setModification(site, &phospho_sites[site]);
+      }
+
+      b_ions.clear(true);
+      y_ions.clear(true);
+      double mass = n_term_mass;
+      for (Size k = 1; k < n; ++k) // the first prefix ion (b1) is not generated
+      {
+        mass += seq[k - 1].getMonoWeight(Residue::Internal);
+        if (k > 1)
         {
-          break;
+          b_ions.emplace_back(mass + b_shift, 1.0);
         }
       }
+      mass = c_term_mass;
+      for (Size k = 1; k < n; ++k)
+      {
+        mass += seq[n - k].getMonoWeight(Residue::Internal);
+        y_ions.emplace_back(mass + y_shift, 1.0);
+      }
 
-      // we mono-charge spectra, generating b- and y-ions is the default behavior of the TSG
-      spectrum_generator.getSpectrum(th_spectra[i], seq, 1, 1);
-      th_spectra[i].setName(seq.toString());
+      PeakSpectrum& spectrum = th_spectra[i];
+      spectrum.resize(b_ions.size() + y_ions.size());
+      std::merge(b_ions.begin(), b_ions.end(), y_ions.begin(), y_ions.end(), spectrum.begin(), Peak1D::PositionLess());
+      spectrum.setMSLevel(2);
+      spectrum.setName(seq.toString());
     }
     return th_spectra;
   }
@@ -535,25 +592,21 @@ namespace OpenMS
     return windows_top10;
   }
   
-  std::vector<std::vector<double>> AScore::calculatePermutationPeptideScores_(vector<PeakSpectrum>& th_spectra, const vector<PeakSpectrum>& windows_top10) const
+  std::vector<std::vector<double>> AScore::calculatePermutationPeptideScores_(const vector<PeakSpectrum>& th_spectra, const vector<vector<PeakSpectrum>>& windows_by_depth) const
   {
     //prepare peak depth for all windows in the actual spectrum
     vector<vector<double>> permutation_peptide_scores(th_spectra.size());
     vector<vector<double>>::iterator site_score = permutation_peptide_scores.begin();
     
     // for each phospho site assignment
-    for (vector<PeakSpectrum>::iterator it = th_spectra.begin(); it != th_spectra.end(); ++it, ++site_score)
+    for (vector<PeakSpectrum>::const_iterator it = th_spectra.begin(); it != th_spectra.end(); ++it, ++site_score)
     {
       // the number of theoretical peaks (all b- and y-ions) correspond to the number of trials N
       Size N = it->size();
       site_score->resize(10);
       for (Size i = 1; i <= 10; ++i)
       {
-        Size n = 0;
-        for (Size current_win = 0; current_win < windows_top10.size(); ++current_win) // count matched ions over all 100 Da windows
-        {
-          n += numberOfMatchedIons_(*it, windows_top10[current_win], i);
-        }
+        Size n = numberOfMatchedIons_(*it, windows_by_depth[i - 1]); // count matched ions over all 100 Da windows
         double p = static_cast<double>(i) * base_match_probability_;
         double cumulative_score = computeCumulativeScore_(N, n, p);
 
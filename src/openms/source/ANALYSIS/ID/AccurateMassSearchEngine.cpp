@@ -19,6 +19,7 @@
 #include <OpenMS/METADATA/ID/IdentificationDataConverter.h>
 #include <OpenMS/SYSTEM/File.h>
 
+#include <exception>
 #include <numeric>
 
 namespace OpenMS
@@ -319,15 +320,18 @@ namespace OpenMS
 
     // Depending on ion_mode_internal_, either positive or negative adducts are used
     std::vector<AdductInfo>::const_iterator it_s, it_e;
+    const std::vector<std::vector<bool>>* compatible = nullptr;
     if (ion_mode == "positive")
     {
       it_s = pos_adducts_.begin();
       it_e = pos_adducts_.end();
+      compatible = &pos_adducts_compatible_;
     }
     else if (ion_mode == "negative")
     {
       it_s = neg_adducts_.begin();
       it_e = neg_adducts_.end();
+      compatible = &neg_adducts_compatible_;
     }
     else
     {
@@ -378,6 +382,7 @@ namespace OpenMS
       double diff_mass = (diff_mz * std::abs(it->getCharge())) / it->getMolMultiplier(); // do not use observed charge (could be 0=unknown)
 
       searchMass_(neutral_mass, diff_mass, hit_idx);
+      const std::vector<bool>& adduct_compatible = (*compatible)[it - it_s];
 
       //std::cerr << ion_mode_internal_ << " adduct: " << adduct_name << ", " << adduct_mass << " Da, " << query_mass << " qm(against DB), " << charge << " q\n";
 
@@ -385,7 +390,7 @@ namespace OpenMS
       for (Size i = hit_idx.first; i < hit_idx.second; ++i)
       {
         // check if DB entry is compatible to the adduct
-        if (!it->isCompatible(EmpiricalFormula(mass_mappings_[i].formula)))
+        if (!adduct_compatible[i])
         {
           // only written if TOPP tool has --debug
           OPENMS_LOG_DEBUG << "'" << mass_mappings_[i].formula << "' cannot have adduct '" << it->getName() << "'. Omitting.\n";
@@ -514,6 +519,55 @@ namespace OpenMS
     }
   }
 
+  void AccurateMassSearchEngine::queryByFeatureMap(const FeatureMap& fmap, const String& ion_mode, std::vector<std::vector<AccurateMassSearchResult>>& results) const
+  {
+    results.clear();
+    results.resize(fmap.size());
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 100)
+    for (SignedSize i = 0; i < (SignedSize)fmap.size(); ++i)
+    {
+      try
+      {
+        queryByFeature(fmap[i], i, ion_mode, results[i]);
+      }
+      catch (...)
+      {
+#pragma omp critical (AccurateMassSearchEngine_query)
+        if (!error) error = std::current_exception();
+      }
+    }
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+
+  void AccurateMassSearchEngine::queryByConsensusMap(const ConsensusMap& cmap, const String& ion_mode, std::vector<std::vector<AccurateMassSearchResult>>& results) const
+  {
+    const Size number_of_maps = cmap.getColumnHeaders().size();
+    results.clear();
+    results.resize(cmap.size());
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 100)
+    for (SignedSize i = 0; i < (SignedSize)cmap.size(); ++i)
+    {
+      try
+      {
+        queryByConsensusFeature(cmap[i], i, number_of_maps, ion_mode, results[i]);
+      }
+      catch (...)
+      {
+#pragma omp critical (AccurateMassSearchEngine_query)
+        if (!error) error = std::current_exception();
+      }
+    }
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+
   void AccurateMassSearchEngine::init()
   {
     // Loads the default mapping file (chemical formulas -> HMDB IDs)
@@ -524,6 +578,9 @@ namespace OpenMS
     parseAdductsFile_(pos_adducts_fname_, pos_adducts_);
     parseAdductsFile_(neg_adducts_fname_, neg_adducts_);
 
+    pos_adducts_compatible_ = computeAdductCompatibility_(pos_adducts_);
+    neg_adducts_compatible_ = computeAdductCompatibility_(neg_adducts_);
+
     is_initialized_ = true;
   }
 
@@ -615,16 +672,15 @@ namespace OpenMS
     // map for storing overall results
     QueryResultsTable overall_results;
     Size dummy_count(0);
+    QueryResultsTable all_results = extractAllQueryResults_(fmap, ion_mode_internal, dummy_count);
     for (Size i = 0; i < fmap.size(); ++i)
     {
-      std::vector<AccurateMassSearchResult> query_results = extractQueryResults_(fmap[i], i, ion_mode_internal, dummy_count);
-      if (query_results.empty())
+      if (all_results[i].empty())
       {
         continue;
       }
-      overall_results.push_back(query_results);
-
-      addMatchesToID_(id, query_results, file_ref, mass_error_ppm_score_ref, mass_error_Da_score_ref, step_ref, fmap[i]); // MztabM
+      addMatchesToID_(id, all_results[i], file_ref, mass_error_ppm_score_ref, mass_error_Da_score_ref, step_ref, fmap[i]); // MztabM
+      overall_results.push_back(std::move(all_results[i]));
     }
 
     // filter FeatureMap to only have entries with an PrimaryID attached
@@ -680,16 +736,15 @@ namespace OpenMS
     // map for storing overall results
     QueryResultsTable overall_results;
     Size dummy_count(0);
+    QueryResultsTable all_results = extractAllQueryResults_(fmap, ion_mode_internal, dummy_count);
     for (Size i = 0; i < fmap.size(); ++i)
     {
-      std::vector<AccurateMassSearchResult> query_results = extractQueryResults_(fmap[i], i, ion_mode_internal, dummy_count);
-      if (query_results.empty())
+      if (all_results[i].empty())
       {
         continue;
       }
-      overall_results.push_back(query_results);
-
-      annotate_(query_results, fmap[i]);
+      annotate_(all_results[i], fmap[i]);
+      overall_results.push_back(std::move(all_results[i]));
     }
 
     // filter FeatureMap to only have entries with an identification
@@ -859,12 +914,10 @@ namespace OpenMS
 
     // map for storing overall results
     QueryResultsTable overall_results;
+    queryByConsensusMap(cmap, ion_mode_internal, overall_results);
     for (Size i = 0; i < cmap.size(); ++i)
     {
-      std::vector<AccurateMassSearchResult> query_results;
-      queryByConsensusFeature(cmap[i], i, num_of_maps, ion_mode_internal, query_results);
-      annotate_(query_results, cmap[i]);
-      overall_results.push_back(query_results);
+      annotate_(overall_results[i], cmap[i]);
     }
     // add dummy protein identification which is required to keep peptidehits alive during store()
     cmap.getProteinIdentifications().resize(cmap.getProteinIdentifications().size() + 1);
@@ -1318,9 +1371,10 @@ namespace OpenMS
           else if (word_count == 1)
           {
             entry.formula = *istr_it;
+            entry.formula_ef = EmpiricalFormula(entry.formula);
             if (entry.mass == 0)
             { // recompute mass from formula
-              entry.mass = EmpiricalFormula(entry.formula).getMonoWeight();
+              entry.mass = entry.formula_ef.getMonoWeight();
               //std::cerr << "mass of " << entry.formula << " is " << entry.mass << "\n";
             }
           }
@@ -1418,6 +1472,20 @@ namespace OpenMS
     return;
   }
 
+  std::vector<std::vector<bool>> AccurateMassSearchEngine::computeAdductCompatibility_(const std::vector<AdductInfo>& adducts) const
+  {
+    std::vector<std::vector<bool>> compatible(adducts.size(), std::vector<bool>(mass_mappings_.size()));
+    for (Size a = 0; a < adducts.size(); ++a)
+    {
+      const EmpiricalFormula removed = adducts[a].getEmpiricalFormula() * -1; // same test as AdductInfo::isCompatible()
+      for (Size i = 0; i < mass_mappings_.size(); ++i)
+      {
+        compatible[a][i] = mass_mappings_[i].formula_ef.contains(removed);
+      }
+    }
+    return compatible;
+  }
+
   void AccurateMassSearchEngine::searchMass_(double neutral_query_mass, double diff_mass, std::pair<Size, Size>& hit_indices) const
   {
     //OPENMS_LOG_INFO << "searchMass: neutral_query_mass=" << neutral_query_mass << " diff_mz=" << diff_mz << " ppm allowed:" << mass_error_value_ << std::endl;
@@ -1520,8 +1588,8 @@ namespace OpenMS
         // it is impossible to decide here which one is best
         for (Size hit_idx = 0; hit_idx < query_results.size(); ++hit_idx)
         {
-          String emp_formula(query_results[hit_idx].getFormulaString());
-          double iso_sim(computeIsotopePatternSimilarity_(feature, EmpiricalFormula(emp_formula)));
+          // the theoretical pattern of the (already parsed) DB formula is memoized by CoarseIsotopePatternGenerator
+          double iso_sim(computeIsotopePatternSimilarity_(feature, mass_mappings_[query_results[hit_idx].getMatchingIndex()].formula_ef));
           query_results[hit_idx].setIsotopesSimScore(iso_sim);
         }
       }
@@ -1529,4 +1597,30 @@ namespace OpenMS
     return query_results;
   }
 
+  AccurateMassSearchEngine::QueryResultsTable AccurateMassSearchEngine::extractAllQueryResults_(const FeatureMap& fmap, const String& ion_mode_internal, Size& dummy_count) const
+  {
+    QueryResultsTable results(fmap.size());
+    Size dummies(0);
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 100) reduction(+: dummies)
+    for (SignedSize i = 0; i < (SignedSize)fmap.size(); ++i)
+    {
+      try
+      {
+        results[i] = extractQueryResults_(fmap[i], i, ion_mode_internal, dummies);
+      }
+      catch (...)
+      {
+#pragma omp critical (AccurateMassSearchEngine_query)
+        if (!error) error = std::current_exception();
+      }
+    }
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+    dummy_count += dummies;
+    return results;
+  }
+
 } // closing namespace OpenMS
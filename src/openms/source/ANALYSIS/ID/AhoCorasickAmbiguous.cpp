@@ -12,6 +12,7 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 
 #include <cassert>
+#include <cstring> // for memchr
 #include <queue>
 
 namespace OpenMS
@@ -144,6 +145,12 @@ namespace OpenMS
     // switch to BFS trie
     trie_ = std::move(bfs_tree);
     umap_index2needles_ = std::move(bfs_index2_needles);
+    edge_labels_.resize(trie_.size());
+    for (size_t i = 0; i < trie_.size(); ++i)
+    {
+      edge_labels_[i] = trie_[i].edge();
+    }
+    dense_node_count_ = 0; // follow_ must not use the table until it is built below
 
     // compute suffix links (could also be done while creating the trie, but it would make the code more complex)
     // .. and hit flag
@@ -158,6 +165,28 @@ namespace OpenMS
       trie_[i].suffix = follow_(trie_[parent()].suffix(), trie_[i].edge);
       trie_[i].depth_and_hits.has_hit |= trie_[trie_[i].suffix()].depth_and_hits.has_hit;
     }
+
+    // dense transition table for the top levels of the trie, which are visited most often;
+    // in BFS order these are the first nodes and the suffix of a node always has a smaller index
+    Index::T dense_count = 0;
+    while (dense_count < trie_.size() && trie_[dense_count].depth_and_hits.depth <= DENSE_MAX_DEPTH)
+    {
+      ++dense_count;
+    }
+    dense_transitions_.assign(size_t(dense_count) * DENSE_ALPHABET, Index {0});
+    for (Index::T i = 0; i < dense_count; ++i)
+    {
+      for (AA aa = AA('A'); aa <= AA('$'); ++aa)
+      {
+        Index ch = findChildBFS_(i, aa);
+        if (ch.isInvalid())
+        { // root stays at root; otherwise use the (already computed) transition of the suffix
+          ch = (i == 0) ? Index {0} : dense_transitions_[size_t(trie_[i].suffix()) * DENSE_ALPHABET + aa()];
+        }
+        dense_transitions_[size_t(i) * DENSE_ALPHABET + aa()] = ch;
+      }
+    }
+    dense_node_count_ = dense_count;
     umap_index2children_naive_.clear(); // not needed anymore
   }
 
@@ -214,6 +243,50 @@ namespace OpenMS
     }
 
     // deal with spawns in queue
+    processSpawns_(state);
+
+    return false;
+  }
+
+  void ACTrie::getAllHits(std::vector<ACTrieState>& states) const
+  {
+    assert(umap_index2children_naive_.empty()); // make sure compressTrie was called
+    std::vector<ACTrieState*> active;
+    active.reserve(states.size());
+    for (auto& state : states)
+    {
+      state.hits.clear();
+      active.push_back(&state);
+    }
+
+    // advance all masters by one AA per round; the queries are independent, so their memory accesses overlap
+    while (!active.empty())
+    {
+      for (size_t k = 0; k < active.size();)
+      {
+        ACTrieState& state = *active[k];
+        const AA aa = state.nextValidAA();
+        if (!aa.isValid())
+        { // query is done
+          active[k] = active.back();
+          active.pop_back();
+          continue;
+        }
+        state.tree_pos = stepMaster_(state.tree_pos, aa, state);
+        addHits_(state.tree_pos, state.textPos(), state.hits);
+        prefetch_(state.tree_pos); // needed in the next round
+        ++k;
+      }
+    }
+
+    for (auto& state : states)
+    {
+      processSpawns_(state);
+    }
+  }
+
+  void ACTrie::processSpawns_(ACTrieState& state) const
+  {
     while (!state.spawns.empty())
     {
       ACSpawn& sp = state.spawns.front();
@@ -221,8 +294,22 @@ namespace OpenMS
       while (stepSpawn_(sp, state));
       state.spawns.pop();
     }
+  }
 
-    return false;
+  void ACTrie::prefetch_(const Index i) const
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    if (i() < dense_node_count_)
+    {
+      __builtin_prefetch(&dense_transitions_[size_t(i()) * DENSE_ALPHABET]);
+    }
+    else
+    {
+      __builtin_prefetch(&edge_labels_[trie_[i()].first_child()]);
+    }
+#else
+    (void)i;
+#endif
   }
 
   Index ACTrie::add_(const Index index, const AA label)
@@ -300,6 +387,13 @@ namespace OpenMS
   
   Index ACTrie::follow_(const Index i, const AA aa) const
   {
+    assert(aa() < DENSE_ALPHABET);
+    // top levels of the trie: direct lookup
+    if (i() < dense_node_count_)
+    {
+      return dense_transitions_[size_t(i()) * DENSE_ALPHABET + aa()];
+    }
+
     Index ch = findChildBFS_(i, aa);
     // has direct child (could also be an ambiguous AA - we don't care as long as a needle did contain that character)
     if (ch.isValid())
@@ -339,9 +433,6 @@ namespace OpenMS
 
   Index ACTrie::stepMaster_(const Index i, const AA edge, ACTrieState& state) const
   {
-    // has direct child (could also be an ambiguous AA - we don't care as long as a needle did contain that character)
-    Index ch = findChildBFS_(i, edge);
-    
     const bool consider_ambAA = max_aaa_ != 0;
     const bool consider_MM = max_mm_ != 0;
     
@@ -371,21 +462,8 @@ namespace OpenMS
     }
   
     // Master continues with the AA, no matter what it was...
-    
-    // has direct child (could also be an ambiguous AA - we don't care as long as a needle did contain that character)
-    if (ch.isValid())
-    {
-      return ch;
-    }
-    // are we at root?
-    if (i() == 0)
-    {
-      return i;
-    }
-    // follow from the suffix...
-    Index suf = trie_[i()].suffix;
-    assert(suf.isValid());
-    return follow_(suf, edge);
+    // (direct child, which could also be an ambiguous AA, or via suffix links)
+    return follow_(i, edge);
   }
 
   bool ACTrie::stepSpawn_(ACSpawn& spawn, ACTrieState& state) const
@@ -510,14 +588,19 @@ namespace OpenMS
 
   Index ACTrie::findChildBFS_(const Index parent, const AA child_label) const
   {
-    size_t start = trie_[parent()].first_child();
-    size_t end = start + trie_[parent()].nr_children;
-    for (size_t i = start; i < end; ++i)
+    const ACNode& node = trie_[parent()];
+    if (node.nr_children == 0)
     {
-      if (trie_[i].edge == child_label)
-        return Index::T(i);
+      return Index {};
     }
-    return Index {};
+    // the labels of all children are consecutive bytes: memchr is vectorized by the C library
+    const uint8_t* labels = edge_labels_.data();
+    const void* pos = std::memchr(labels + node.first_child(), child_label(), node.nr_children);
+    if (pos == nullptr)
+    {
+      return Index {};
+    }
+    return Index::T(static_cast<const uint8_t*>(pos) - labels);
   }
 
   void ACTrieState::setQuery(const std::string& haystack)
@@ -13,6 +13,7 @@
 #include <OpenMS/PROCESSING/ID/IDFilter.h>
 #include <OpenMS/METADATA/PeptideHit.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
 
 #include <algorithm>
 #include <iostream>
@@ -23,6 +24,33 @@ namespace OpenMS
 {
   using Internal::IDBoostGraph;
 
+  namespace
+  {
+    /// the score type of the first peptide (assumed for all of them)
+    void firstScoreType(const std::vector<PeptideIdentification>& pep_ids, String& score_type, bool& higher_better)
+    {
+      score_type = "";
+      higher_better = true;
+      //TODO check all pep IDs? this assumes equality
+      if (!pep_ids.empty())
+      {
+        score_type = pep_ids[0].getScoreType();
+        higher_better = pep_ids[0].isHigherScoreBetter();
+      }
+    }
+
+    std::vector<PeptideIdentification*> pointersTo(std::vector<PeptideIdentification>& pep_ids)
+    {
+      std::vector<PeptideIdentification*> pointers;
+      pointers.reserve(pep_ids.size());
+      for (auto& pep : pep_ids)
+      {
+        pointers.push_back(&pep);
+      }
+      return pointers;
+    }
+  }
+
   BasicProteinInferenceAlgorithm::BasicProteinInferenceAlgorithm():
       DefaultParamHandler("BasicProteinInferenceAlgorithm"),
       ProgressLogger()
@@ -67,15 +95,11 @@ namespace OpenMS
   {
     Size min_peptides_per_protein = static_cast<Size>(param_.getValue("min_peptides_per_protein"));
 
-    std::unordered_map<std::string, std::map<Int, PeptideHit*>> best_pep;
-    std::unordered_map<std::string, std::pair<ProteinHit*, Size>> acc_to_protein_hitP_and_count;
+    String overall_score_type;
+    bool higher_better;
+    firstScoreType(pep_ids, overall_score_type, higher_better);
 
-    processRun_(
-        acc_to_protein_hitP_and_count,
-        best_pep,
-        prot_id,
-        pep_ids
-    );
+    processRun_(prot_id, pep_ids, overall_score_type, higher_better);
 
     if (min_peptides_per_protein > 0) //potentially sth was filtered
     {
@@ -95,16 +119,12 @@ namespace OpenMS
     bool treat_modification_variants_separately(param_.getValue("treat_modification_variants_separately").toBool());
     bool use_shared_peptides(param_.getValue("use_shared_peptides").toBool());
 
-    std::unordered_map<std::string, std::map<Int, PeptideHit*>> best_pep;
-    std::unordered_map<std::string, std::pair<ProteinHit*, Size>> acc_to_protein_hitP_and_count;
+    SequenceToChargeToPSM best_pep;
+    ProteinIndex_ proteins;
 
     String agg_method_string(param_.getValue("score_aggregation_method").toString());
     AggregationMethod aggregation_method = aggFromString_(agg_method_string);
 
-    //TODO think about only clearing values or using a big map for all runs together
-    acc_to_protein_hitP_and_count.clear();
-    best_pep.clear();
-
     prot_run.setInferenceEngine("TOPPProteinInference");
     prot_run.setInferenceEngineVersion(VersionInfo::getVersion());
     ProteinIdentification::SearchParameters sp = prot_run.getSearchParameters();
@@ -148,23 +168,31 @@ namespace OpenMS
     for (auto& prothit : prot_hits)
     {
       prothit.setScore(initScore);
-      acc_to_protein_hitP_and_count[prothit.getAccession()] = std::make_pair<ProteinHit*, Size>(&prothit, 0);
+      proteins.insert(prothit);
     }
 
     checkCompat_(overall_score_type, aggregation_method);
 
+    // aggregate over the peptides of all features at once (in the order of the features)
+    std::vector<PeptideIdentification*> pep_ids;
     for (auto& cf : cmap)
     {
-      aggregatePeptideScores_(best_pep, cf.getPeptideIdentifications(), overall_score_type, higher_better, "");
+      for (auto& pep : cf.getPeptideIdentifications())
+      {
+        pep_ids.push_back(&pep);
+      }
     }
-
     if (include_unassigned)
     {
-      aggregatePeptideScores_(best_pep, cmap.getUnassignedPeptideIdentifications(), overall_score_type, higher_better, "");
+      for (auto& pep : cmap.getUnassignedPeptideIdentifications())
+      {
+        pep_ids.push_back(&pep);
+      }
     }
+    aggregatePeptideScores_(best_pep, pep_ids, overall_score_type, higher_better, "");
 
     updateProteinScores_(
-        acc_to_protein_hitP_and_count,
+        proteins,
         best_pep,
         pep_scores,
         higher_better
@@ -238,17 +266,72 @@ namespace OpenMS
   {
     Size min_peptides_per_protein = static_cast<Size>(param_.getValue("min_peptides_per_protein"));
     IDFilter::keepNBestHits(pep_ids,1); // we should filter for best psm per spec only, since those will be the psms used, also filterUnreferencedProteins depends on it (e.g. after resolution)
-    std::unordered_map<std::string, std::map<Int, PeptideHit*>> best_pep;
-    std::unordered_map<std::string, std::pair<ProteinHit*, Size>> acc_to_protein_hitP_and_count;
 
-    for (auto &prot_run : prot_ids)
+    String overall_score_type;
+    bool higher_better;
+    firstScoreType(pep_ids, overall_score_type, higher_better);
+
+    std::unordered_map<std::string, Size> run_to_index;
+    for (Size r = 0; r < prot_ids.size(); ++r)
     {
-      processRun_(
-          acc_to_protein_hitP_and_count,
-          best_pep,
-          prot_run,
-          pep_ids
-          );
+      run_to_index.emplace(prot_ids[r].getIdentifier(), r);
+    }
+
+    if (prot_ids.size() > 1 && run_to_index.size() == prot_ids.size())
+    {
+      // every step of a run only considers the peptides with its identifier, so with unique identifiers the runs can
+      // be processed independently on a partition of the peptides
+      for (const auto& pep : pep_ids)
+      {
+        if (pep.getScoreType() != overall_score_type)
+        {
+          throw OpenMS::Exception::InvalidParameter(
+              __FILE__,
+              __LINE__,
+              OPENMS_PRETTY_FUNCTION,
+              "Differing score_types in the PeptideHits. Aborting...");
+        }
+      }
+
+      // last partition: peptides without a run
+      std::vector<std::vector<PeptideIdentification>> run_peps(prot_ids.size() + 1);
+      std::vector<Size> pep_to_run(pep_ids.size());
+      for (Size i = 0; i < pep_ids.size(); ++i)
+      {
+        auto it = run_to_index.find(pep_ids[i].getIdentifier());
+        pep_to_run[i] = (it == run_to_index.end()) ? prot_ids.size() : it->second;
+        run_peps[pep_to_run[i]].push_back(std::move(pep_ids[i]));
+      }
+
+      auto restore_order = [&]()
+      {
+        std::vector<Size> next(run_peps.size(), 0);
+        for (Size i = 0; i < pep_ids.size(); ++i)
+        {
+          pep_ids[i] = std::move(run_peps[pep_to_run[i]][next[pep_to_run[i]]++]);
+        }
+      };
+
+      try
+      {
+        TaskScheduler::parallelFor(0, prot_ids.size(), [&](SignedSize r)
+        {
+          processRun_(prot_ids[r], run_peps[r], overall_score_type, higher_better);
+        });
+      }
+      catch (...)
+      {
+        restore_order();
+        throw;
+      }
+      restore_order();
+    }
+    else
+    {
+      for (auto &prot_run : prot_ids)
+      {
+        processRun_(prot_run, pep_ids, overall_score_type, higher_better);
+      }
     }
 
     if (min_peptides_per_protein > 0) //potentially sth was filtered
@@ -258,8 +341,8 @@ namespace OpenMS
   }
 
   void BasicProteinInferenceAlgorithm::aggregatePeptideScores_(
-      std::unordered_map<std::string, std::map<Int, PeptideHit*>>& best_pep,
-      std::vector<PeptideIdentification>& pep_ids,
+      SequenceToChargeToPSM& best_pep,
+      const std::vector<PeptideIdentification*>& pep_ids,
       const String& overall_score_type,
       bool higher_better,
       const std::string& run_id) const
@@ -267,9 +350,14 @@ namespace OpenMS
     bool treat_charge_variants_separately(param_.getValue("treat_charge_variants_separately").toBool());
     bool treat_modification_variants_separately(param_.getValue("treat_modification_variants_separately").toBool());
     bool use_shared_peptides(param_.getValue("use_shared_peptides").toBool());
+    const UInt protein_references = MetaInfoInterface::metaRegistry().registerName("protein_references");
 
-    for (auto &pep : pep_ids)
+    // sort the spectra and compute the lookup keys of their best PSMs in parallel (empty sequence: spectrum is skipped)
+    std::vector<String> lookup_seqs(pep_ids.size());
+    std::vector<int> lookup_charges(pep_ids.size(), 0);
+    TaskScheduler::parallelFor(0, pep_ids.size(), [&](SignedSize i)
     {
+      PeptideIdentification& pep = *pep_ids[i];
       if (pep.getScoreType() != overall_score_type)
       {
         throw OpenMS::Exception::InvalidParameter(
@@ -280,52 +368,56 @@ namespace OpenMS
       }
       //skip if it does not belong to run
       if (!run_id.empty() && pep.getIdentifier() != run_id)
-        continue;
+        return;
       //skip if no hits (which almost could be considered and error or warning)
       if (pep.getHits().empty())
-        continue;
+        return;
       //make sure that first = best hit
       pep.sort();
 
       //TODO think about if using any but the best PSM per spectrum makes sense in such a simple aggregation scheme
-      //for (auto& hit : pep.getHits())
-      //{
-      PeptideHit &hit = pep.getHits()[0];
+      const PeptideHit& hit = pep.getHits()[0];
       //skip if shared and option not enabled
       //TODO warn if not present but requested?
       //TODO use nr of evidences to re-calculate sharedness?
       if (!use_shared_peptides &&
-      (!hit.metaValueExists("protein_references") || (hit.getMetaValue("protein_references") == "non-unique")))
-        continue;
+      (!hit.metaValueExists(protein_references) || (hit.getMetaValue(protein_references) == "non-unique")))
+        return;
 
       //TODO refactor: this is very similar to IDFilter best per peptide functionality
-      String lookup_seq;
       if (!treat_modification_variants_separately)
       {
-        lookup_seq = hit.getSequence().toUnmodifiedString();
+        lookup_seqs[i] = hit.getSequence().toUnmodifiedString();
       }
       else
       {
-        lookup_seq = hit.getSequence().toString();
+        lookup_seqs[i] = hit.getSequence().toString();
       }
 
-      int lookup_charge = 0;
       if (treat_charge_variants_separately)
       {
-        lookup_charge = hit.getCharge();
+        lookup_charges[i] = hit.getCharge();
       }
+    }, 64);
+
+    // update the best PSMs in the order of the spectra
+    for (Size i = 0; i < pep_ids.size(); ++i)
+    {
+      if (lookup_seqs[i].empty())
+        continue;
+      PeptideHit &hit = pep_ids[i]->getHits()[0];
 
-      auto current_best_pep_it = best_pep.find(lookup_seq);
+      auto current_best_pep_it = best_pep.find(lookup_seqs[i]);
       if (current_best_pep_it == best_pep.end())
       { // no entry exist for sequence? initialize seq->charge->&hit
-        best_pep[lookup_seq][lookup_charge] = &hit;
+        best_pep[lookup_seqs[i]][lookup_charges[i]] = &hit;
       }
       else
       { // a peptide hit for the current sequence exists
-        auto current_best_pep_charge_it = current_best_pep_it->second.find(lookup_charge);
+        auto current_best_pep_charge_it = current_best_pep_it->second.find(lookup_charges[i]);
         if (current_best_pep_charge_it == current_best_pep_it->second.end())
         { // no entry for charge? add hit
-          current_best_pep_it->second[lookup_charge] = &hit;
+          current_best_pep_it->second[lookup_charges[i]] = &hit;
         }
         else if (
             (higher_better && (hit.getScore() > current_best_pep_charge_it->second->getScore())) ||
@@ -334,14 +426,13 @@ namespace OpenMS
           current_best_pep_charge_it->second = &hit;
         }
       }
-      //}
     }
   }
 
 
   void BasicProteinInferenceAlgorithm::updateProteinScores_(
-      std::unordered_map<std::string, std::pair<ProteinHit*, Size>>& acc_to_protein_hitP_and_count,
-      const std::unordered_map<std::string, std::map<Int, PeptideHit*>>& best_pep,
+      const ProteinIndex_& proteins,
+      const SequenceToChargeToPSM& best_pep,
       bool pep_scores,
       bool higher_better) const
   {
@@ -359,7 +450,17 @@ namespace OpenMS
     AggregationMethod aggregation_method = aggFromString_(agg_method_string);
     const auto& aggregation_fun = aggFunFromEnum_(aggregation_method, higher_better);
 
-    // update protein scores
+    // aggregate into flat arrays indexed by protein id
+    const Size n_proteins = proteins.hits.size();
+    std::vector<double> scores(n_proteins);
+    std::vector<Size> counts(n_proteins, 0);
+    for (Size p = 0; p < n_proteins; ++p)
+    {
+      scores[p] = proteins.hits[p]->getScore();
+    }
+
+    std::vector<Size> protein_ids;
+    std::vector<String> missing_accessions;
     for (const auto &seq_to_map_from_charge_to_pep_hit : best_pep)
     {
       // The next line assumes that PeptideHits of different charge states necessarily share the same
@@ -367,47 +468,68 @@ namespace OpenMS
       // TODO this could be done for mods, too (first hashing AASeq, then the mods)
       const std::map<Int, PeptideHit*>& charge_to_peptide_hit = seq_to_map_from_charge_to_pep_hit.second;
       const PeptideHit& first_peptide_hit = *charge_to_peptide_hit.begin()->second;
-      for (const auto &acc : first_peptide_hit.extractProteinAccessionsSet())
+
+      // distinct proteins of the peptide (each one counts once)
+      protein_ids.clear();
+      missing_accessions.clear();
+      for (const auto& ev : first_peptide_hit.getPeptideEvidences())
       {
-        for (const auto &charge_pep_hit_pair : charge_to_peptide_hit)
+        const String& acc = ev.getProteinAccession();
+        if (acc.empty())
         {
-          auto prot_count_pair_it = acc_to_protein_hitP_and_count.find(std::string(acc));
-          if (prot_count_pair_it == acc_to_protein_hitP_and_count.end())
-          {
-            OPENMS_LOG_WARN << "Warning, skipping pep that maps to a non existent protein accession. "
-            << first_peptide_hit.getSequence().toUnmodifiedString() << std::endl;
-            continue; // very weird, has an accession that was not in the proteins loaded in the beginning
-            //TODO error? Suppress log?
-          }
+          continue;
+        }
+        auto id_it = proteins.acc_to_id.find(acc);
+        if (id_it == proteins.acc_to_id.end())
+        {
+          missing_accessions.push_back(acc);
+        }
+        else
+        {
+          protein_ids.push_back(id_it->second);
+        }
+      }
+      std::sort(protein_ids.begin(), protein_ids.end());
+      protein_ids.erase(std::unique(protein_ids.begin(), protein_ids.end()), protein_ids.end());
+      std::sort(missing_accessions.begin(), missing_accessions.end());
+      missing_accessions.erase(std::unique(missing_accessions.begin(), missing_accessions.end()), missing_accessions.end());
 
-          ProteinHit *protein = prot_count_pair_it->second.first;
-          prot_count_pair_it->second.second++;
+      for (Size m = 0; m < missing_accessions.size() * charge_to_peptide_hit.size(); ++m)
+      {
+        OPENMS_LOG_WARN << "Warning, skipping pep that maps to a non existent protein accession. "
+        << first_peptide_hit.getSequence().toUnmodifiedString() << std::endl;
+        // very weird, has an accession that was not in the proteins loaded in the beginning
+        //TODO error? Suppress log?
+      }
 
-          const PeptideHit& pep_hit = *charge_pep_hit_pair.second;
-          double new_score = pep_hit.getScore();
+      for (Size p : protein_ids)
+      {
+        counts[p] += charge_to_peptide_hit.size();
+        for (const auto &charge_pep_hit_pair : charge_to_peptide_hit)
+        {
+          double new_score = charge_pep_hit_pair.second->getScore();
 
           if (pep_scores) // convert PEP to PP
             new_score = 1. - new_score;
 
-          protein->setScore(aggregation_fun(protein->getScore(), new_score));
+          scores[p] = aggregation_fun(scores[p], new_score);
         }
       }
     }
-    if (!skip_count_annotation)
+
+    const UInt nr_found_peptides = MetaInfoInterface::metaRegistry().registerName("nr_found_peptides");
+    for (Size p = 0; p < n_proteins; ++p)
     {
-      for (auto& entry : acc_to_protein_hitP_and_count)
+      ProteinHit* phitp = proteins.hits[p];
+      //normalize in case of SUM
+      if (aggregation_method == AggregationMethod::SUM)
       {
-        entry.second.first->setMetaValue("nr_found_peptides", entry.second.second);
+        scores[p] /= counts[p];
       }
-    }
-
-    //normalize in case of SUM
-    if (aggregation_method == AggregationMethod::SUM)
-    {
-      for (auto& entry : acc_to_protein_hitP_and_count)
+      phitp->setScore(scores[p]);
+      if (!skip_count_annotation)
       {
-        ProteinHit* phitp = entry.second.first;
-        phitp->setScore(phitp->getScore() / entry.second.second);
+        phitp->setMetaValue(nr_found_peptides, counts[p]);
       }
     }
   }
@@ -502,10 +624,10 @@ namespace OpenMS
 
 
   void BasicProteinInferenceAlgorithm::processRun_(
-      std::unordered_map<std::string, std::pair<ProteinHit*, Size>>& acc_to_protein_hitP_and_count,
-      std::unordered_map<std::string, std::map<Int, PeptideHit*>>& best_pep,
       ProteinIdentification& prot_run,
-      std::vector<PeptideIdentification>& pep_ids) const
+      std::vector<PeptideIdentification>& pep_ids,
+      const String& overall_score_type,
+      bool higher_better) const
   {
     // TODO actually clearing the scores should be enough, since this algorithm does not change the grouping
     prot_run.getProteinGroups().clear();
@@ -521,9 +643,8 @@ namespace OpenMS
     String agg_method_string(param_.getValue("score_aggregation_method").toString());
     AggregationMethod aggregation_method = aggFromString_(agg_method_string);
 
-    //TODO think about only clearing values or using a big map for all runs together
-    acc_to_protein_hitP_and_count.clear();
-    best_pep.clear();
+    SequenceToChargeToPSM best_pep;
+    ProteinIndex_ proteins;
 
     prot_run.setInferenceEngine("TOPPProteinInference");
     prot_run.setInferenceEngineVersion(VersionInfo::getVersion());
@@ -534,32 +655,22 @@ namespace OpenMS
     sp.setMetaValue("TOPPProteinInference:treat_modification_variants_separately", treat_modification_variants_separately);
     prot_run.setSearchParameters(sp);
 
-    String overall_score_type = "";
-    bool higher_better = true;
-
-    //TODO check all pep IDs? this assumes equality
-    if (!pep_ids.empty())
-    {
-      overall_score_type = pep_ids[0].getScoreType();
-      higher_better = pep_ids[0].isHigherScoreBetter();
-    }
-
     bool pep_scores = IDScoreSwitcherAlgorithm().isScoreType(overall_score_type,IDScoreSwitcherAlgorithm::ScoreType::PEP);
     double initScore = getInitScoreForAggMethod_(aggregation_method, pep_scores || higher_better); // if we have pep scores, we will complement to pp during aggregation
 
-    //create Accession to ProteinHit and peptide count map. To have quick access later.
-    //If a protein occurs in multiple runs, it picks the last
+    //intern the accessions of the ProteinHits. To have quick access later.
+    //If an accession occurs repeatedly, it picks the last
     for (auto &phit : prot_run.getHits())
     {
-      acc_to_protein_hitP_and_count[phit.getAccession()] = std::make_pair<ProteinHit*, Size>(&phit, 0);
+      proteins.insert(phit);
       phit.setScore(initScore);
     }
 
     checkCompat_(overall_score_type, aggregation_method);
 
-    aggregatePeptideScores_(best_pep, pep_ids, overall_score_type, higher_better, prot_run.getIdentifier());
+    aggregatePeptideScores_(best_pep, pointersTo(pep_ids), overall_score_type, higher_better, prot_run.getIdentifier());
 
-    updateProteinScores_(acc_to_protein_hitP_and_count, best_pep, pep_scores, higher_better);
+    updateProteinScores_(proteins, best_pep, pep_scores, higher_better);
 
     if (pep_scores) // we converted/ will convert
     {
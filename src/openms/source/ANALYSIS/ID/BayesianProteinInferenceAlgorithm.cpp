@@ -23,6 +23,10 @@
 
 #include <set>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace OpenMS::Internal;
 
@@ -38,11 +42,19 @@ namespace OpenMS
     const Param& param_;
     unsigned int debug_lvl_;
     unsigned long cnt_;
-
-    explicit GraphInferenceFunctor(const Param& param, unsigned int debug_lvl):
+    /// if set, protein posteriors are written into this vector (indexed by the position of the hit after
+    /// @p first_protein_) instead of into the hits, and other posteriors are not stored. This way several
+    /// functors (e.g. for different parameters) can run concurrently on the same graph.
+    std::vector<double>* protein_posteriors_;
+    const ProteinHit* first_protein_;
+
+    explicit GraphInferenceFunctor(const Param& param, unsigned int debug_lvl,
+                                   std::vector<double>* protein_posteriors = nullptr, const ProteinHit* first_protein = nullptr):
         param_(param),
         debug_lvl_(debug_lvl),
-        cnt_(0)
+        cnt_(0),
+        protein_posteriors_(protein_posteriors),
+        first_protein_(first_protein)
     {}
 
     unsigned long operator() (IDBoostGraph::Graph& fg, unsigned int idx) {
@@ -252,6 +264,14 @@ namespace OpenMS
             {
               posterior = 1. - pmf.table()[0ul];
             }
+            if (protein_posteriors_ != nullptr)
+            {
+              if (fg[nodeId].which() == 0) // prot
+              {
+                (*protein_posteriors_)[boost::get<ProteinHit*>(fg[nodeId]) - first_protein_] = posterior;
+              }
+              continue;
+            }
             auto bound_visitor = std::bind(pv, std::placeholders::_1, posterior);
             boost::apply_visitor(bound_visitor, fg[nodeId]);
           }
@@ -469,19 +489,56 @@ namespace OpenMS
         debug_lvl_(debug_lvl)
     {}
 
-    double operator() (double alpha, double beta, double gamma)
+    /// Evaluates a batch of (alpha, beta, gamma) combinations concurrently. Every combination gets its own
+    /// parameters and protein posteriors, the graph is shared. Only protein level posteriors are evaluated
+    /// (group and PSM level annotation are disabled during the grid search).
+    std::vector<double> operator() (const std::vector<std::tuple<double, double, double>>& combos)
     {
-      OPENMS_LOG_INFO << "Evaluating: " << alpha << " " << beta << " " << gamma << std::endl;
-      if (beta - alpha >= 0.3 && alpha + beta <= 1.0)
+      const ProteinIdentification& prots = ibg_.getProteinIDs();
+      // The following assumes that ALL proteins in the ID structure are used in the graph.
+      // Proteins in CCs without a result keep their current score.
+      ScoreToTgtDecLabelPairs current_scores_and_tgt{};
+      IDScoreGetterSetter::getScores_(current_scores_and_tgt, prots);
+
+      std::vector<double> results(combos.size(), 0.);
+      std::vector<Size> evaluated;
+      std::vector<Param> params;
+      params.reserve(combos.size()); // functors keep references
+      std::vector<std::vector<double>> protein_posteriors;
+      protein_posteriors.reserve(combos.size());
+      for (Size c = 0; c < combos.size(); ++c)
+      {
+        double alpha, beta, gamma;
+        std::tie(alpha, beta, gamma) = combos[c];
+        OPENMS_LOG_INFO << "Evaluating: " << alpha << " " << beta << " " << gamma << std::endl;
+        if (beta - alpha >= 0.3 && alpha + beta <= 1.0)
+        {
+          OPENMS_LOG_INFO << "Skipping improbable parameter combination.. " << std::endl;
+          continue;
+        }
+        params.push_back(param_);
+        params.back().setValue("model_parameters:prot_prior", gamma);
+        params.back().setValue("model_parameters:pep_emission", alpha);
+        params.back().setValue("model_parameters:pep_spurious_emission", beta);
+        protein_posteriors.emplace_back(current_scores_and_tgt.size());
+        for (Size i = 0; i < current_scores_and_tgt.size(); ++i)
+        {
+          protein_posteriors.back()[i] = current_scores_and_tgt[i].first;
+        }
+        evaluated.push_back(c);
+      }
+      if (evaluated.empty())
       {
-        OPENMS_LOG_INFO << "Skipping improbable parameter combination.. " << std::endl;
-        return 0.;
+        return results;
       }
-      param_.setValue("model_parameters:prot_prior", gamma);
-      param_.setValue("model_parameters:pep_emission", alpha);
-      param_.setValue("model_parameters:pep_spurious_emission", beta);
-      GraphInferenceFunctor gif {param_, debug_lvl_};
-      ibg_.applyFunctorOnCCs(gif);
+
+      const ProteinHit* first_protein = prots.getHits().empty() ? nullptr : &prots.getHits()[0];
+      std::vector<std::function<unsigned long(IDBoostGraph::Graph&, unsigned int)>> functors;
+      for (Size k = 0; k < evaluated.size(); ++k)
+      {
+        functors.emplace_back(GraphInferenceFunctor{params[k], debug_lvl_, &protein_posteriors[k], first_protein});
+      }
+      ibg_.applyFunctorsOnCCs(functors);
 
       FalseDiscoveryRate fdr;
       Param fdrparam = fdr.getParameters();
@@ -489,14 +546,16 @@ namespace OpenMS
       fdrparam.setValue("add_decoy_proteins","true");
       fdr.setParameters(fdrparam);
 
-      if (param_.getValue("annotate_group_probabilities").toBool())
+      for (Size k = 0; k < evaluated.size(); ++k)
       {
-        ScoreToTgtDecLabelPairs scores_and_tgt_fraction{};
-        ibg_.getProteinGroupScoresAndTgtFraction(scores_and_tgt_fraction);
-        return fdr.applyEvaluateProteinIDs(scores_and_tgt_fraction, 1.0, 100, static_cast<double>(param_.getValue("param_optimize:aucweight")));
+        ScoreToTgtDecLabelPairs scores_and_tgt = current_scores_and_tgt;
+        for (Size i = 0; i < scores_and_tgt.size(); ++i)
+        {
+          scores_and_tgt[i].first = protein_posteriors[k][i];
+        }
+        results[evaluated[k]] = fdr.applyEvaluateProteinIDs(scores_and_tgt, 1.0, 100, static_cast<double>(param_.getValue("param_optimize:aucweight")));
       }
-      // The following line assumes that ALL proteins in the ID structure are used in the graph
-      return fdr.applyEvaluateProteinIDs(ibg_.getProteinIDs(), 1.0, 100, static_cast<double>(param_.getValue("param_optimize:aucweight")));
+      return results;
     }
   };
 
@@ -896,12 +955,18 @@ namespace OpenMS
     param_.setValue("annotate_group_probabilities","false");
 
     //TODO run grid search on reduced graph? Then make sure, untouched protein/peps do not affect evaluation results.
-    //TODO if not, think about storing results temporary (file? mem?) and only keep the best in the end
     //TODO think about running grid search on the small CCs only (maybe it's enough)
     if (gs.getNrCombos() > 1)
     {
      OPENMS_LOG_INFO << "Testing " << gs.getNrCombos() << " param combinations." << std::endl;
-      /*double res =*/ gs.evaluate(GridSearchEvaluator(param_, ibg, debug_lvl_), -1.0, bestParams);
+      // evaluate as many combinations at once as there are threads (parallel over combinations and CCs),
+      // each combination needs a copy of the protein scores
+      #ifdef _OPENMP
+      Size batch_size = omp_get_max_threads();
+      #else
+      Size batch_size = 1;
+      #endif
+      /*double res =*/ gs.evaluateInBatches(GridSearchEvaluator(param_, ibg, debug_lvl_), batch_size, -1.0, bestParams);
     }
     else
     {
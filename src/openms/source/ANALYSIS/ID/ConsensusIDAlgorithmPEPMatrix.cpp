@@ -46,28 +46,48 @@ namespace OpenMS
     }
     // new parameters may affect the similarity calculation, so clear cache:
     similarities_.clear();
+    self_alignment_scores_.clear();
+  }
+
+  double ConsensusIDAlgorithmPEPMatrix::getSelfAlignmentScore_(const String& unmod_seq)
+  {
+    auto pos = self_alignment_scores_.find(unmod_seq);
+    if (pos != self_alignment_scores_.end()) return pos->second;
+    double score = alignment_.align(unmod_seq, unmod_seq);
+    self_alignment_scores_.emplace(unmod_seq, score);
+    return score;
   }
 
   double ConsensusIDAlgorithmPEPMatrix::getSimilarity_(AASequence seq1,
                                                        AASequence seq2)
   {
+    if (seq1 == seq2) return 1.0;
+    // order of sequences matters for cache look-up:
+    if (seq2 < seq1) std::swap(seq1, seq2); // "operator>" not defined
+    pair<AASequence, AASequence> seq_pair = make_pair(seq1, seq2);
+    SimilarityCache::iterator pos = similarities_.find(seq_pair);
+    if (pos != similarities_.end()) return pos->second; // score found in cache
+
     // here we cannot take modifications into account:
     String unmod_seq1 = seq1.toUnmodifiedString();
     String unmod_seq2 = seq2.toUnmodifiedString();
-    if (unmod_seq1 == unmod_seq2) return 1.0;
-
-    double score_sim = alignment_.align(unmod_seq1, unmod_seq2);
-
-    if (score_sim < 0)
+    double score_sim = 1.0;
+    if (unmod_seq1 != unmod_seq2)
     {
-      score_sim = 0;
-    }
-    else
-    {
-      double score_self1 = alignment_.align(unmod_seq1, unmod_seq1);
-      double score_self2 = alignment_.align(unmod_seq2, unmod_seq2);
-      score_sim /= min(score_self1, score_self2); // normalize
+      score_sim = alignment_.align(unmod_seq1, unmod_seq2);
+
+      if (score_sim < 0)
+      {
+        score_sim = 0;
+      }
+      else
+      {
+        double score_self1 = getSelfAlignmentScore_(unmod_seq1);
+        double score_self2 = getSelfAlignmentScore_(unmod_seq2);
+        score_sim /= min(score_self1, score_self2); // normalize
+      }
     }
+    similarities_[seq_pair] = score_sim; // cache the similarity score
     return score_sim;
   }
 
@@ -11,9 +11,119 @@
 #include <OpenMS/PROCESSING/NOISEESTIMATION/SignalToNoiseEstimatorMedianRapid.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/SpectrumAddition.h>
 #include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
+
+#include <algorithm>
+#include <cmath>
 
 namespace OpenMS {
 
+  namespace
+  {
+    /**
+      @brief The points of SpectrumAddition::addUpSpectra(@p spectra, @p sampling_rate, false) with m/z in [@p lo, @p hi]
+
+      The raster of addUpSpectra() has @p size points at @p min + k * @p sampling_rate. Only its points in the
+      window are computed: the points of each spectrum next to the window are distributed onto them in the same
+      order and with the same arithmetic as LinearResamplerAlign::raster() (including the intensity outside of
+      the raster, which is added to its first or last point), so the intensities are identical.
+
+      The spectra need to be sorted by position.
+    */
+    void addUpWindow(const std::vector<const MSSpectrum*>& spectra, double min, int size, double sampling_rate,
+                     double lo, double hi, std::vector<Peak1D>& output)
+    {
+      auto raster_mz = [min, sampling_rate](int k) { return min + k * sampling_rate; };
+      // first raster point with m/z not less than (if !strict) or greater than (if strict) @p mz
+      auto locate = [&](double mz, bool strict)
+      {
+        auto before = [&](int k) { return strict ? raster_mz(k) <= mz : raster_mz(k) < mz; };
+        const double pos = std::ceil((mz - min) / sampling_rate);
+        int k = pos <= 0 ? 0 : (pos >= size ? size : static_cast<int>(pos));
+        while (k > 0 && !before(k - 1)) --k;
+        while (k < size && before(k)) ++k;
+        return k;
+      };
+      auto by_mz = [](double mz, const Peak1D& p) { return mz < p.getMZ(); };
+
+      // the window is the raster points [first, last)
+      const int first = locate(lo, false);
+      const int last = locate(hi, true);
+      if (first >= last) return;
+
+      const Size n = last - first;
+      std::vector<float> master(n, 0.0f);
+      std::vector<float> current(n, 0.0f);
+      std::vector<Size> touched;
+      std::vector<char> is_touched(n, 0);
+      auto touch = [&](int k)
+      {
+        if (!is_touched[k - first])
+        {
+          is_touched[k - first] = 1;
+          touched.push_back(k - first);
+        }
+      };
+
+      for (const MSSpectrum* spectrum : spectra)
+      {
+        // the points distributed onto the window (their left raster point is in [first - 1, last - 1])
+        MSSpectrum::ConstIterator it = first == 0 ? spectrum->begin() :
+          std::upper_bound(spectrum->begin(), spectrum->end(), raster_mz(first - 1), by_mz);
+        MSSpectrum::ConstIterator end = last == size ? spectrum->end() :
+          std::upper_bound(it, spectrum->end(), raster_mz(last), by_mz);
+
+        for (; it != end; ++it)
+        {
+          const double mz = it->getMZ();
+          if (mz < raster_mz(0))
+          {
+            touch(0);
+            current[0] = current[0] + it->getIntensity();
+            continue;
+          }
+          const int left = std::max(locate(mz, false) - 1, 0);
+          if (left + 1 == size)
+          {
+            touch(left);
+            current[left - first] = current[left - first] + it->getIntensity();
+            continue;
+          }
+          const double dist_left = std::fabs(mz - raster_mz(left));
+          const double dist_right = std::fabs(mz - raster_mz(left + 1));
+          if (left >= first)
+          {
+            touch(left);
+            current[left - first] = current[left - first] + it->getIntensity() * dist_right / (dist_left + dist_right);
+          }
+          if (left + 1 < last)
+          {
+            touch(left + 1);
+            current[left + 1 - first] = current[left + 1 - first] + it->getIntensity() * dist_left / (dist_left + dist_right);
+          }
+        }
+
+        // add to the master spectrum
+        for (Size i : touched)
+        {
+          master[i] = master[i] + current[i];
+          current[i] = 0.0f;
+          is_touched[i] = 0;
+        }
+        touched.clear();
+      }
+
+      output.reserve(output.size() + n);
+      for (Size i = 0; i < n; ++i)
+      {
+        Peak1D p;
+        p.setMZ(raster_mz(first + static_cast<int>(i)));
+        p.setIntensity(master[i]);
+        output.push_back(p);
+      }
+    }
+  }
+
   FIAMSDataProcessor::FIAMSDataProcessor() :
       DefaultParamHandler("FIAMSDataProcessor"),
       mzs_(),
@@ -74,6 +184,7 @@ namespace OpenMS {
     p.setValue("frame_length", param_.getValue("sgf:frame_length"));
     p.setValue("polynomial_order", param_.getValue("sgf:polynomial_order"));
     sgfilter_.setParameters(p);
+    ams_.reset();
   }
 
   void FIAMSDataProcessor::cutForTime(const MSExperiment& experiment, const float n_seconds, std::vector<MSSpectrum>& output)
@@ -86,18 +197,70 @@ namespace OpenMS {
   MSSpectrum FIAMSDataProcessor::mergeAlongTime(
     const std::vector<MSSpectrum> & input
     ) {
-      MSSpectrum output;
-      for (Size i = 0; i < mzs_.size() - 1; i++) {
-          OpenMS::MSSpectrum full_spectrum = OpenMS::SpectrumAddition::addUpSpectra(
-              input, bin_sizes_[i], false
-          );
-          for (auto it = full_spectrum.begin(); it != full_spectrum.end(); ++it) {
-              if (it->getMZ() > mzs_[i+1]) break;
-              if (it->getMZ() >= mzs_[i]) output.push_back(*it);
-          }
+      std::vector<const MSSpectrum*> spectra;
+      spectra.reserve(input.size());
+      for (const auto & s : input) spectra.push_back(&s);
+      return mergeAlongTime_(spectra);
+  }
+
+  MSSpectrum FIAMSDataProcessor::mergeAlongTime_(const std::vector<const MSSpectrum*>& input) const
+  {
+    MSSpectrum output;
+    // SpectrumAddition::addUpSpectra returns a single spectrum as is and nothing if the first one is empty
+    if (mzs_.size() < 2 || input.empty() || input[0]->empty()) return output;
+    const Size n_windows = mzs_.size() - 1;
+    std::vector<std::vector<Peak1D>> windows(n_windows);
+
+    if (input.size() == 1)
+    {
+      for (Size i = 0; i < n_windows; ++i)
+      {
+        for (const auto & p : *input[0]) {
+          if (p.getMZ() > mzs_[i+1]) break;
+          if (p.getMZ() >= mzs_[i]) windows[i].push_back(p);
+        }
       }
-      output.sortByPosition();
-      return output;
+    }
+    else if (!std::all_of(input.begin(), input.end(), [](const MSSpectrum* s) { return s->isSorted(); }))
+    {
+      // the rasters of unsorted spectra depend on the order of their points, use the full addition
+      std::vector<MSSpectrum> spectra;
+      spectra.reserve(input.size());
+      for (const MSSpectrum* s : input) spectra.push_back(*s);
+      TaskScheduler::parallelFor(0, n_windows, [&](SignedSize i)
+      {
+        MSSpectrum full_spectrum = SpectrumAddition::addUpSpectra(spectra, bin_sizes_[i], false);
+        for (const auto & p : full_spectrum) {
+          if (p.getMZ() > mzs_[i+1]) break;
+          if (p.getMZ() >= mzs_[i]) windows[i].push_back(p);
+        }
+      });
+    }
+    else
+    {
+      // global m/z range (the origin of the rasters)
+      double min = input[0]->front().getMZ();
+      double max = input[0]->back().getMZ();
+      for (const MSSpectrum* s : input)
+      {
+        if (s->empty()) continue;
+        min = std::min(min, s->front().getMZ());
+        max = std::max(max, s->back().getMZ());
+      }
+      TaskScheduler::parallelFor(0, n_windows, [&](SignedSize i)
+      {
+        const double sampling_rate = bin_sizes_[i];
+        const int size = (max - min) / sampling_rate + 1;
+        addUpWindow(input, min, size, sampling_rate, mzs_[i], mzs_[i+1], windows[i]);
+      });
+    }
+
+    Size n_points = 0;
+    for (const auto & w : windows) n_points += w.size();
+    output.reserve(n_points);
+    for (const auto & w : windows) output.insert(output.end(), w.begin(), w.end());
+    output.sortByPosition();
+    return output;
   }
 
   MSSpectrum FIAMSDataProcessor::extractPeaks(const MSSpectrum& input)
@@ -125,7 +288,7 @@ namespace OpenMS {
     return output;
   }
 
-  void FIAMSDataProcessor::runAccurateMassSearch(FeatureMap& input, OpenMS::MzTab& output)
+  Param FIAMSDataProcessor::getAccurateMassSearchParameters() const
   {
     Param ams_param;
     ams_param.setValue("ionization_mode", "auto");
@@ -135,12 +298,37 @@ namespace OpenMS {
     ams_param.setValue("positive_adducts", param_.getValue("positive_adducts"));
     ams_param.setValue("negative_adducts", param_.getValue("negative_adducts"));
     ams_param.setValue("keep_unidentified_masses", "false"); // only report IDs
+    return ams_param;
+  }
 
-    AccurateMassSearchEngine ams;
-    ams.setParameters(ams_param);
-    ams.init();
+  void FIAMSDataProcessor::setAccurateMassSearchEngine(std::shared_ptr<const AccurateMassSearchEngine> engine)
+  {
+    if (engine)
+    {
+      const Param expected = getAccurateMassSearchParameters();
+      const Param& actual = engine->getParameters();
+      for (auto it = expected.begin(); it != expected.end(); ++it)
+      {
+        if (!actual.exists(it.getName()) || actual.getValue(it.getName()) != it->value)
+        {
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+            "The accurate mass search engine was set up with a different value of '" + it.getName() + "'.");
+        }
+      }
+    }
+    ams_ = std::move(engine);
+  }
 
-    ams.run(input, output);
+  void FIAMSDataProcessor::runAccurateMassSearch(FeatureMap& input, OpenMS::MzTab& output)
+  {
+    if (!ams_)
+    {
+      auto ams = std::make_shared<AccurateMassSearchEngine>();
+      ams->setParameters(getAccurateMassSearchParameters());
+      ams->init();
+      ams_ = std::move(ams);
+    }
+    ams_->run(input, output);
   }
 
   MSSpectrum FIAMSDataProcessor::trackNoise(const MSSpectrum& input)
@@ -187,9 +375,12 @@ namespace OpenMS {
       is_cached = true;
     } else {
       OPENMS_LOG_INFO << "Started calculating picked spectrum " << filepath_picked << std::endl;
-      std::vector<MSSpectrum> output_cut;
-      cutForTime(experiment, n_seconds, output_cut);
-      MSSpectrum merged_spectrum = mergeAlongTime(output_cut);
+      // the spectra are merged without copying them (see cutForTime)
+      std::vector<const MSSpectrum*> spectra_cut;
+      for (const auto & s : experiment.getSpectra()) {
+          if (s.getRT() < n_seconds) spectra_cut.push_back(&s);
+      }
+      MSSpectrum merged_spectrum = mergeAlongTime_(spectra_cut);
       picked_spectrum = extractPeaks(merged_spectrum);
       if (param_.getValue("store_progress").toBool()) {
         storeSpectrum_(merged_spectrum, dir_output_ + "/" + filename_ + "_merged_" + postfix + ".mzML");
@@ -8,12 +8,15 @@
 
 #include <OpenMS/ANALYSIS/ID/FIAMSScheduler.h>
 
+#include <OpenMS/ANALYSIS/ID/AccurateMassSearchEngine.h>
 #include <OpenMS/ANALYSIS/ID/FIAMSDataProcessor.h>
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/FORMAT/FileHandler.h>
 
 #include <QDir>
 
+#include <algorithm>
+
 namespace OpenMS {
   /// default constructor
   FIAMSScheduler::FIAMSScheduler(
@@ -48,12 +51,12 @@ namespace OpenMS {
   }
 
   void FIAMSScheduler::run() {
-    #pragma omp parallel for
-    for (int i = 0; i < (int)samples_.size(); ++i) {
-      MSExperiment exp;
-      FileHandler().loadExperiment(base_dir_ + samples_[i].at("dir_input") + "/" + samples_[i].at("filename") + ".mzML", exp, {FileTypes::MZML});
-
-      FIAMSDataProcessor fia_processor;
+    // the data processors are set up first: samples with the same accurate mass search settings share one
+    // (read-only) engine, so that each database is loaded only once for the whole batch
+    std::vector<FIAMSDataProcessor> processors(samples_.size());
+    std::vector<std::pair<Param, std::shared_ptr<const AccurateMassSearchEngine>>> engines;
+    for (Size i = 0; i < samples_.size(); ++i) {
+      FIAMSDataProcessor& fia_processor = processors[i];
       Param p;
       p.setValue("filename", samples_[i].at("filename"));
       p.setValue("dir_output", output_dir_ + samples_[i].at("dir_output"));
@@ -67,6 +70,24 @@ namespace OpenMS {
       p.setValue("negative_adducts", base_dir_ + samples_[i].at("negative_adducts"));
       fia_processor.setParameters(p);
 
+      Param ams_param = fia_processor.getAccurateMassSearchParameters();
+      auto engine = std::find_if(engines.begin(), engines.end(), [&ams_param](const auto& e) { return e.first == ams_param; });
+      if (engine == engines.end()) {
+        auto ams = std::make_shared<AccurateMassSearchEngine>();
+        ams->setParameters(ams_param);
+        ams->init();
+        engines.emplace_back(ams_param, std::move(ams));
+        engine = engines.end() - 1;
+      }
+      fia_processor.setAccurateMassSearchEngine(engine->second);
+    }
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < (int)samples_.size(); ++i) {
+      MSExperiment exp;
+      FileHandler().loadExperiment(base_dir_ + samples_[i].at("dir_input") + "/" + samples_[i].at("filename") + ".mzML", exp, {FileTypes::MZML});
+
+      FIAMSDataProcessor& fia_processor = processors[i];
       String time = samples_[i].at("time");
       std::vector<String> times;
       time.split(";", times);
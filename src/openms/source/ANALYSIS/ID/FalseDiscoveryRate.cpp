@@ -25,6 +25,52 @@ using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /**
+      @brief Fills @p score_to_fdr from (score, FDR) pairs, given in the order they were computed
+
+      For equal scores, the last pair wins if @p last_wins is true, otherwise the first one (i.e. the same
+      result as assigning or inserting them into a std::map one by one) - but with a single sort instead of
+      a tree insertion per pair.
+    */
+    void fillScoreToFDRMap_(ScoreToFDRMap& score_to_fdr, vector<pair<double, double>>& entries, bool last_wins)
+    {
+      stable_sort(entries.begin(), entries.end(), [](const pair<double, double>& a, const pair<double, double>& b) { return a.first < b.first; });
+      Size n = 0;
+      for (Size i = 0; i < entries.size(); ++i)
+      {
+        if (n > 0 && entries[n - 1].first == entries[i].first)
+        {
+          if (last_wins)
+          {
+            entries[n - 1].second = entries[i].second;
+          }
+          continue;
+        }
+        entries[n++] = entries[i];
+      }
+      entries.resize(n);
+      if (score_to_fdr.empty())
+      {
+        score_to_fdr = ScoreToFDRMap(boost::container::ordered_unique_range, entries.begin(), entries.end());
+        return;
+      }
+      // merge into existing entries (not used by the FDR calculations, which start with an empty map)
+      for (const auto& e : entries)
+      {
+        if (last_wins)
+        {
+          score_to_fdr[e.first] = e.second;
+        }
+        else
+        {
+          score_to_fdr.insert(e);
+        }
+      }
+    }
+  }
+
   FalseDiscoveryRate::FalseDiscoveryRate() :
     DefaultParamHandler("FalseDiscoveryRate")
   {
@@ -289,7 +335,7 @@ namespace OpenMS
         }
 
         // calculate fdr for the forward scores
-        map<double, double> score_to_fdr;
+        ScoreToFDRMap score_to_fdr;
         calculateFDRs_(score_to_fdr, target_scores, decoy_scores, q_value, higher_score_better);
 
         // calculate peptide FDR
@@ -304,7 +350,7 @@ namespace OpenMS
           {
             target_peptide_scores.push_back(ps.second);
           }      
-          map<double, double> score_to_peptide_fdr;
+          ScoreToFDRMap score_to_peptide_fdr;
           calculateFDRs_(score_to_peptide_fdr, target_peptide_scores, decoy_peptide_scores, q_value, higher_score_better);
           // overwrite best peptide score with peptide q-value
           for (auto& ps : peptide_to_best_decoy_score)
@@ -327,14 +373,15 @@ namespace OpenMS
           }
 
           String score_type = it->getScoreType() + "_score";
-          vector<PeptideHit> hits;
-          for (vector<PeptideHit>::const_iterator pit = it->getHits().begin(); pit != it->getHits().end(); ++pit)
+          // annotate the hits in place (no copies); decoys which are not kept are removed afterwards
+          vector<PeptideHit>& hits = it->getHits();
+          vector<bool> remove_hit(hits.size(), false);
+          for (Size h = 0; h < hits.size(); ++h)
           {
-            PeptideHit hit = *pit;
+            PeptideHit& hit = hits[h];
 
-            if (split_charge_variants && pit->getCharge() != *zit)
+            if (split_charge_variants && hit.getCharge() != *zit)
             {
-              hits.push_back(*pit);
               continue;
             }
             if (hit.metaValueExists("target_decoy"))
@@ -342,6 +389,7 @@ namespace OpenMS
               String meta_value = (String)hit.getMetaValue("target_decoy");
               if (meta_value == "decoy" && !add_decoy_peptides)
               {
+                remove_hit[h] = true;
                 continue;
               }
 
@@ -367,11 +415,22 @@ namespace OpenMS
                 }
               }              
             }
-            hit.setMetaValue(score_type, pit->getScore());
-            hit.setScore(score_to_fdr[pit->getScore()]);
-            hits.push_back(hit);
+            hit.setMetaValue(score_type, hit.getScore());
+            hit.setScore(score_to_fdr[hit.getScore()]);
+          }
+          Size kept = 0;
+          for (Size h = 0; h < hits.size(); ++h)
+          {
+            if (!remove_hit[h])
+            {
+              if (kept != h)
+              {
+                hits[kept] = std::move(hits[h]);
+              }
+              ++kept;
+            }
           }
-          it->getHits().swap(hits);
+          hits.erase(hits.begin() + kept, hits.end());
         }
       }
       if (!split_charge_variants)
@@ -432,7 +491,7 @@ namespace OpenMS
     bool higher_score_better = fwd_ids.begin()->isHigherScoreBetter();
     bool add_decoy_peptides = param_.getValue("add_decoy_peptides").toBool();
     // calculate fdr for the forward scores
-    map<double, double> score_to_fdr;
+    ScoreToFDRMap score_to_fdr;
     calculateFDRs_(score_to_fdr, target_scores, decoy_scores, q_value, higher_score_better);
 
     // annotate fdr
@@ -533,7 +592,7 @@ namespace OpenMS
 
 
     // calculate fdr for the forward scores
-    map<double, double> score_to_fdr;
+    ScoreToFDRMap score_to_fdr;
     calculateFDRs_(score_to_fdr, target_scores, decoy_scores, q_value, higher_score_better);
 
     // annotate fdr
@@ -591,7 +650,7 @@ namespace OpenMS
     bool q_value = !param_.getValue("no_qvalues").toBool();
     bool higher_score_better = fwd_ids.begin()->isHigherScoreBetter();
     // calculate fdr for the forward scores
-    map<double, double> score_to_fdr;
+    ScoreToFDRMap score_to_fdr;
     calculateFDRs_(score_to_fdr, target_scores, decoy_scores, q_value, higher_score_better);
 
     // annotate fdr
@@ -646,7 +705,7 @@ namespace OpenMS
       }
     }
 
-    map<double, double> score_to_fdr;
+    ScoreToFDRMap score_to_fdr;
     bool higher_better = score_ref->higher_better;
     bool use_qvalue = !param_.getValue("no_qvalues").toBool();
     calculateFDRs_(score_to_fdr, target_scores, decoy_scores, use_qvalue,
@@ -729,7 +788,7 @@ namespace OpenMS
   }
 
 
-  void FalseDiscoveryRate::calculateFDRs_(map<double, double>& score_to_fdr, vector<double>& target_scores, vector<double>& decoy_scores, bool q_value, bool higher_score_better) const
+  void FalseDiscoveryRate::calculateFDRs_(ScoreToFDRMap& score_to_fdr, vector<double>& target_scores, vector<double>& decoy_scores, bool q_value, bool higher_score_better) const
   {
     Size number_of_target_scores = target_scores.size();
     // sort the scores
@@ -754,6 +813,9 @@ namespace OpenMS
       sort(decoy_scores.begin(), decoy_scores.end());
     }
 
+    // FDR of each target score (same order as target_scores); collected in a flat array and
+    // converted to the lookup map once at the end
+    vector<double> target_fdr(target_scores.size(), 0.);
     Size j = 0;
 
     if (q_value)
@@ -809,7 +871,7 @@ namespace OpenMS
 #ifdef FALSE_DISCOVERY_RATE_DEBUG
         cerr << fdr << endl;
 #endif
-        score_to_fdr[target_scores[i]] = fdr;
+        target_fdr[i] = fdr;
 
       }
     }
@@ -834,50 +896,80 @@ namespace OpenMS
 #ifdef FALSE_DISCOVERY_RATE_DEBUG
         cerr << fdr << endl;
 #endif
-        score_to_fdr[target_scores[i]] = fdr;
+        target_fdr[i] = fdr;
       }
     }
 
+    // equal target scores share one map entry, i.e. the value computed last
+    for (Size i = target_scores.size(); i > 1; --i)
+    {
+      if (target_scores[i - 2] == target_scores[i - 1])
+      {
+        target_fdr[i - 2] = target_fdr[i - 1];
+      }
+    }
+
+    // targets are sorted ascending if exactly one of q_value/higher_score_better is false
+    const bool targets_ascending = (q_value == higher_score_better);
+    // is the target score not better than the decoy score?
+    auto not_better = [higher_score_better](double target, double decoy) { return higher_score_better ? target <= decoy : target >= decoy; };
+
     // assign q-value of decoy_score to closest target_score
+    vector<pair<double, double>> entries;
+    entries.reserve(target_scores.size() + decoy_scores.size());
+    vector<pair<double, double>> decoy_entries;
+    decoy_entries.reserve(decoy_scores.size());
     for (Size i = 0; i != decoy_scores.size(); ++i)
     {
       const double& ds = decoy_scores[i];
 
       // advance target index until score is better than decoy score
+      // (for q-values, 'not better' holds for a prefix of the sorted targets; otherwise for all or none since the first target is the best)
       size_t k{0};
-      while (k != target_scores.size() &&
-             ((target_scores[k] <= ds && higher_score_better) ||
-              (target_scores[k] >= ds && !higher_score_better)))
+      if (q_value)
+      {
+        k = partition_point(target_scores.begin(), target_scores.end(), [&](double t) { return not_better(t, ds); }) - target_scores.begin();
+      }
+      else if (!target_scores.empty() && not_better(target_scores[0], ds))
       {
-        ++k;
+        k = target_scores.size();
       }
 
+      double fdr;
       // corner cases
       if (k == 0)
       {
-        if (!target_scores.empty())
-        {
-          score_to_fdr[ds] = score_to_fdr[target_scores[0]];
-          continue;
-        }
-        else
-        {
-          score_to_fdr[ds] = 1.0;
-          continue;
-        }
+        fdr = target_scores.empty() ? 1.0 : target_fdr[0];
       }
-
-      if (k == target_scores.size()) { score_to_fdr[ds] = score_to_fdr[target_scores.back()]; continue; }
-
-      if (fabs(target_scores[k] - ds) < fabs(target_scores[k - 1] - ds))
+      else if (k == target_scores.size())
+      {
+        fdr = target_fdr.back();
+      }
+      else if (fabs(target_scores[k] - ds) < fabs(target_scores[k - 1] - ds))
       {
-        score_to_fdr[ds] = score_to_fdr[target_scores[k]];
+        fdr = target_fdr[k];
       }
       else
       {
-        score_to_fdr[ds] = score_to_fdr[target_scores[k - 1]];
+        fdr = target_fdr[k - 1];
+      }
+      decoy_entries.emplace_back(ds, fdr);
+
+      // a decoy with the same score as targets overwrites their (shared) entry
+      auto same = targets_ascending ? equal_range(target_scores.begin(), target_scores.end(), ds)
+                                    : equal_range(target_scores.begin(), target_scores.end(), ds, greater<double>());
+      for (auto it = same.first; it != same.second; ++it)
+      {
+        target_fdr[it - target_scores.begin()] = fdr;
       }
     }
+
+    for (Size i = 0; i != target_scores.size(); ++i)
+    {
+      entries.emplace_back(target_scores[i], target_fdr[i]);
+    }
+    entries.insert(entries.end(), decoy_entries.begin(), decoy_entries.end());
+    fillScoreToFDRMap_(score_to_fdr, entries, true);
   }
 
   //TODO does not support "by run" and/or "by charge"
@@ -1046,7 +1138,7 @@ namespace OpenMS
             IDScoreGetterSetter::getPeptideScoresFromMap_(scores_labels, cmap, include_unassigned_peptides,
              [&protID](const PeptideIdentification& id){return protID.getIdentifier() == id.getIdentifier();}, all_hits,
              [&c](const PeptideHit& hit){return c == hit.getCharge();});
-            map<double, double> scores_to_fdr;
+            ScoreToFDRMap scores_to_fdr;
             calculateFDRBasic_(scores_to_fdr, scores_labels, q_value, higher_score_better);
             IDScoreGetterSetter::setPeptideScoresForMap_(scores_to_fdr, cmap, include_unassigned_peptides, score_type, higher_score_better, add_decoy_peptides, c, protID.getIdentifier());
           }
@@ -1054,7 +1146,7 @@ namespace OpenMS
         else
         {
           IDScoreGetterSetter::getPeptideScoresFromMap_(scores_labels, cmap, include_unassigned_peptides, [&protID](const PeptideIdentification& id){return protID.getIdentifier() == id.getIdentifier();}, all_hits);
-          map<double, double> scores_to_fdr;
+          ScoreToFDRMap scores_to_fdr;
           calculateFDRBasic_(scores_to_fdr, scores_labels, q_value, higher_score_better);
           IDScoreGetterSetter::setPeptideScoresForMap_(scores_to_fdr, cmap, include_unassigned_peptides, score_type, higher_score_better, add_decoy_peptides, protID.getIdentifier());
         }
@@ -1063,7 +1155,7 @@ namespace OpenMS
     else
     {
       IDScoreGetterSetter::getPeptideScoresFromMap_(scores_labels, cmap, include_unassigned_peptides, all_hits);
-      map<double, double> scores_to_fdr;
+      ScoreToFDRMap scores_to_fdr;
       calculateFDRBasic_(scores_to_fdr, scores_labels, q_value, higher_score_better);
       IDScoreGetterSetter::setPeptideScoresForMap_(scores_to_fdr, cmap, include_unassigned_peptides, score_type, higher_score_better, add_decoy_peptides);
     }
@@ -1082,7 +1174,7 @@ namespace OpenMS
 
     ScoreToTgtDecLabelPairs scores_labels;
     scores_labels.reserve(id.getHits().size());
-    std::map<double,double> scores_to_FDR;
+    ScoreToFDRMap scores_to_FDR;
 
     // TODO this could be a separate function.. And it could actually be sped up.
     //  We could store the number of decoys/targets in the group, or we only update the
@@ -1214,7 +1306,7 @@ namespace OpenMS
     {
       pairs.push_back(seq_to_score_label.second);
     }
-    std::map<double,double> score_to_fdr;
+    ScoreToFDRMap score_to_fdr;
     calculateFDRBasic_(score_to_fdr, pairs, q_value, higher_better);
     // convert scores in unordered map to FDR/qvalues
     for (auto & seq_to_score_label : seq_to_score_labels)
@@ -1251,7 +1343,7 @@ namespace OpenMS
     {
       pairs.push_back(seq_to_score_label.second);
     }
-    map<double,double> score_to_fdr;
+    ScoreToFDRMap score_to_fdr;
     calculateFDRBasic_(score_to_fdr, pairs, q_value, higher_better);
     // convert scores in unordered map to FDR/qvalues
     for (auto & seq_to_score_label : seq_to_score_labels)
@@ -1283,7 +1375,7 @@ namespace OpenMS
     bool add_decoy_peptides = param_.getValue("add_decoy_peptides").toBool();
 
     ScoreToTgtDecLabelPairs scores_labels;
-    std::map<double,double> scores_to_FDR;
+    ScoreToFDRMap scores_to_FDR;
     auto idcheck = [&identifier](const PeptideIdentification& id){return identifier == id.getIdentifier();};
     
     if (charge == 0 && !only_best_per_pep)
@@ -1368,7 +1460,7 @@ namespace OpenMS
     }
 
     ScoreToTgtDecLabelPairs scores_labels;
-    std::map<double,double> scores_to_FDR;
+    ScoreToFDRMap scores_to_FDR;
     //TODO actually we do not need the labels for estimated FDR and it currently fails if we do not have TD annotations
     //TODO maybe separate getScores and getScoresAndLabels
     IDScoreGetterSetter::getScores_(scores_labels, ids[0]);
@@ -1458,7 +1550,7 @@ namespace OpenMS
     }
 
     ScoreToTgtDecLabelPairs scores_labels;
-    std::map<double,double> scores_to_FDR;
+    ScoreToFDRMap scores_to_FDR;
     std::unordered_map<String, ScoreToTgtDecLabelPair> picked_scores;
     IDScoreGetterSetter::getPickedProteinScores_(picked_scores, id, decoy_string, prefix);
     scores_labels.reserve(picked_scores.size());
@@ -1615,7 +1707,7 @@ namespace OpenMS
 
   // Actually this does not need the bool entries in the scores_labels, but leads to less code
   // Assumes P(E)Probabilities as scores
-  void FalseDiscoveryRate::calculateEstimatedQVal_(std::map<double, double> &scores_to_FDR,
+  void FalseDiscoveryRate::calculateEstimatedQVal_(ScoreToFDRMap &scores_to_FDR,
                                                    ScoreToTgtDecLabelPairs &scores_labels,
                                                    bool higher_score_better) const
   {
@@ -1635,8 +1727,7 @@ namespace OpenMS
     }
 
     //TODO I think we can just do it "in-place" to save space
-    std::vector<double> estimatedFDR;
-    estimatedFDR.reserve(scores_labels.size());
+    std::vector<double> estimatedFDR(scores_labels.size());
 
     // Basically a running average
     double sum = 0.0;
@@ -1652,14 +1743,19 @@ namespace OpenMS
       std::transform(estimatedFDR.begin(), estimatedFDR.end(), estimatedFDR.begin(), [&](double d) { return 1 - d; });
     }
 
-    // In case of multiple equal scores, this will add the _last_ fdr that it finds. Since fdrs are decreasing
-    // in either way in estimatedFDR, this adds the minimal FDR to the map for this score.
-    std::transform(scores_labels.begin(), scores_labels.end(), estimatedFDR.begin(), std::inserter(scores_to_FDR, scores_to_FDR.begin()), [&](std::pair<double,bool> sl, double fdr){return make_pair(sl.first, fdr);});
+    // In case of multiple equal scores, the first fdr that is found is used (as when inserting into a map).
+    std::vector<std::pair<double, double>> entries;
+    entries.reserve(scores_labels.size());
+    for (size_t j = 0; j < scores_labels.size(); ++j)
+    {
+      entries.emplace_back(scores_labels[j].first, estimatedFDR[j]);
+    }
+    fillScoreToFDRMap_(scores_to_FDR, entries, false);
   }
 
   /*
    void FalseDiscoveryRate::calculateFDRBasic_(
-    std::map<double,double>& scores_to_FDR,
+    ScoreToFDRMap& scores_to_FDR,
     ScoreToTgtDecLabelPairs& scores_labels,
     std::vector<size_t>& ordering,
     bool qvalue,
@@ -1669,7 +1765,7 @@ namespace OpenMS
   }
 
   void FalseDiscoveryRate::calculateFDRBasicOnSorted_(
-  std::map<double,double>& scores_to_FDR,
+  ScoreToFDRMap& scores_to_FDR,
   ScoreToTgtDecLabelPairs& scores_labels,
   bool qvalue,
   bool higher_score_better) const
@@ -1678,7 +1774,7 @@ namespace OpenMS
   }*/
 
   void FalseDiscoveryRate::calculateFDRBasic_(
-      std::map<double,double>& scores_to_FDR,
+      ScoreToFDRMap& scores_to_FDR,
       ScoreToTgtDecLabelPairs& scores_labels,
       bool qvalue,
       bool higher_score_better) const
@@ -1701,6 +1797,8 @@ namespace OpenMS
     }
 
     //uniquify scores and add decoy proportions
+    //(collected in sorted order in a flat array and converted to the lookup map once at the end)
+    std::vector<std::pair<double, double>> entries;
     double decoys = 0.; // double to account for "partial" decoys
     double last_score = scores_labels[0].first;
 
@@ -1716,11 +1814,11 @@ namespace OpenMS
         //we are using the conservative formula (Decoy + 1) / (Tgts)
         if (conservative)
         {
-          scores_to_FDR[last_score] = (decoys+1.0)/(double(j)+1.0-decoys);
+          entries.emplace_back(last_score, (decoys+1.0)/(double(j)+1.0-decoys));
         }
         else
         {
-          scores_to_FDR[last_score] = (decoys+1.0)/(double(j)+1.0);
+          entries.emplace_back(last_score, (decoys+1.0)/(double(j)+1.0));
         }
 
         last_score = scores_labels[j].first;
@@ -1739,12 +1837,13 @@ namespace OpenMS
     // in case there is only one score and generally to include the last score, I guess we need to do this
     if (conservative)
     {
-      scores_to_FDR[last_score] = (decoys+1.0)/(double(j)+1.0-decoys);
+      entries.emplace_back(last_score, (decoys+1.0)/(double(j)+1.0-decoys));
     }
     else
     {
-      scores_to_FDR[last_score] = (decoys+1.0)/(double(j)+1.0);
+      entries.emplace_back(last_score, (decoys+1.0)/(double(j)+1.0));
     }
+    fillScoreToFDRMap_(scores_to_FDR, entries, true);
 
     if (qvalue) //apply a cumulative minimum on the map (from low to high fdrs)
     {
@@ -29,6 +29,13 @@ namespace OpenMS
   }
 
 
+  double HyperScore::computeFromMatches(size_t matched_b_ions, size_t matched_y_ions, double dot_product)
+  {
+    const int i_min = (int)std::min(matched_y_ions, matched_b_ions);
+    const int i_max = (int)std::max(matched_y_ions, matched_b_ions);
+    return log1p(dot_product) + 2*logfactorial_(i_min) + logfactorial_(i_max, i_min + 1);
+  }
+
   double HyperScore::compute(double fragment_mass_tolerance, bool fragment_mass_tolerance_unit_ppm, const PeakSpectrum& exp_spectrum, const PeakSpectrum& theo_spectrum)
   {
     if (exp_spectrum.empty() || theo_spectrum.empty())
@@ -93,9 +100,7 @@ namespace OpenMS
     //const double bFact = logfactorial_(b_ion_count);
     //const double hyperScore = log1p(dot_product) + yFact + bFact;
 
-    const int i_min = std::min(y_ion_count, b_ion_count);
-    const int i_max = std::max(y_ion_count, b_ion_count);
-    const double hyperScore = log1p(dot_product) + 2*logfactorial_(i_min) + logfactorial_(i_max, i_min + 1);
+    const double hyperScore = computeFromMatches(b_ion_count, y_ion_count, dot_product);
     return hyperScore;
   }
 
@@ -174,9 +179,7 @@ namespace OpenMS
     //const double bFact = logfactorial_(b_ion_count);
     //const double hyperScore = log1p(dot_product) + yFact + bFact;
 
-    const int i_min = std::min(y_ion_count, b_ion_count);
-    const int i_max = std::max(y_ion_count, b_ion_count);
-    const double hyperScore = log1p(dot_product) + 2*logfactorial_(i_min) + logfactorial_(i_max, i_min + 1);
+    const double hyperScore = computeFromMatches(b_ion_count, y_ion_count, dot_product);
     d.matched_b_ions = b_ion_count;
     d.matched_y_ions = y_ion_count;
     d.mean_error = (b_ion_count + y_ion_count) > 0 ? abs_error / (double)(b_ion_count + y_ion_count) : 0.0;
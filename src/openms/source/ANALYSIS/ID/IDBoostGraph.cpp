@@ -20,6 +20,7 @@
 #include <boost/graph/graph_utility.hpp>
 #include <boost/graph/connected_components.hpp>
 
+#include <numeric>
 #include <ostream>
 #ifdef _OPENMP
 #include <omp.h>
@@ -592,10 +593,15 @@ namespace OpenMS
       throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No connected components annotated. Run computeConnectedComponents first!");
     }
 
+    // Start with the big CCs since they take much longer (otherwise a few giant CCs picked up
+    // at the end keep single threads busy while the others are idle)
+    const std::vector<int> order = getCCsBySize_();
+
     // Use dynamic schedule because big CCs take much longer!
-    #pragma omp parallel for schedule(dynamic) default(none) shared(functor)
-    for (int i = 0; i < static_cast<int>(ccs_.size()); i += 1)
+    #pragma omp parallel for schedule(dynamic) default(none) shared(functor, order)
+    for (int j = 0; j < static_cast<int>(order.size()); j += 1)
     {
+      const int i = order[j];
       #ifdef INFERENCE_BENCH
       StopWatch sw;
       sw.start();
@@ -641,6 +647,36 @@ namespace OpenMS
     #endif
   }
 
+  void IDBoostGraph::applyFunctorsOnCCs(const std::vector<std::function<unsigned long(Graph&, unsigned int)>>& functors)
+  {
+    if (ccs_.empty()) {
+      throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No connected components annotated. Run computeConnectedComponents first!");
+    }
+
+    // one task per pair of CC and functor, big CCs first (see applyFunctorOnCCs)
+    const std::vector<int> order = getCCsBySize_();
+    const int nr_functors = static_cast<int>(functors.size());
+    const int nr_tasks = static_cast<int>(order.size()) * nr_functors;
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int t = 0; t < nr_tasks; t += 1)
+    {
+      const int i = order[t / nr_functors];
+      functors[t % nr_functors](ccs_.at(i), i);
+    }
+  }
+
+  std::vector<int> IDBoostGraph::getCCsBySize_() const
+  {
+    std::vector<int> order(ccs_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b)
+    {
+      return boost::num_vertices(ccs_[a]) + boost::num_edges(ccs_[a]) > boost::num_vertices(ccs_[b]) + boost::num_edges(ccs_[b]);
+    });
+    return order;
+  }
+
   /// Do sth on ccs single-threaded
   void IDBoostGraph::applyFunctorOnCCsST(const std::function<void(Graph&)>& functor)
   {
@@ -1492,7 +1528,8 @@ namespace OpenMS
     #ifdef INFERENCE_BENCH
     sizes_and_times_.resize(ccs_.size());
     #endif
-    g.clear();
+    // release the memory of the full graph (clear() keeps the capacity)
+    Graph().swap(g);
   }
 
   const IDBoostGraph::Graph& IDBoostGraph::getComponent(Size cc)
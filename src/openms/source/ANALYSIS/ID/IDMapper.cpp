@@ -265,14 +265,6 @@ namespace OpenMS
     // keep track of assigned/unassigned precursors
     std::unordered_map<Size, Size> assigned_precursors;
 
-    // store which peptides fit which feature (and avoid double entries)
-    // consensusMap -> {peptide_index}
-    vector<set<size_t>> mapping(map.size());
-
-    DoubleList mz_values;
-    double rt_pep;
-    IntList charges;
-
     // for statistics
     Size id_matches_none(0), id_matches_single(0), id_matches_multiple(0);
 
@@ -386,17 +378,53 @@ namespace OpenMS
     }
     else
     { // non TMT data (e.g., label-free)
-      for (Size i = 0; i < ids.size(); ++i)
+      // sort the consensus features (or their subelements) by RT, so only the ones within the RT
+      // tolerance of an ID need to be checked
+      vector<pair<double, Size>> rt_index; // RT, consensus feature index
+      for (Size cm_index = 0; cm_index < map.size(); ++cm_index)
+      {
+        if (!measure_from_subelements)
+        {
+          rt_index.emplace_back(map[cm_index].getRT(), cm_index);
+        }
+        else
+        {
+          for (const FeatureHandle& handle : map[cm_index].getFeatures())
+          {
+            rt_index.emplace_back(handle.getRT(), cm_index);
+          }
+        }
+      }
+      std::sort(rt_index.begin(), rt_index.end());
+      // widen the RT window a bit, so no candidate is lost to rounding (isMatch_ does the exact check)
+      const double rt_window = rt_tolerance_ * (1.0 + 1e-9) + 1e-9;
+
+      // find the matching consensus features of all IDs in parallel:
+      // (consensus feature index, map index of the matching subelement if measured from subelements)
+      vector<vector<pair<Size, Size>>> matches(ids.size());
+#pragma omp parallel for schedule(dynamic, 64)
+      for (SignedSize i = 0; i < (SignedSize)ids.size(); ++i)
       {
         // skip IDs without peptide annotations
         if (ids[i].getHits().empty()) continue;
 
+        DoubleList mz_values;
+        double rt_pep;
+        IntList charges;
         getIDDetails_(ids[i], rt_pep, mz_values, charges);
 
-        bool id_mapped(false);
+        // candidates in order of their index (as the IDs are added to them in that order)
+        vector<Size> candidates;
+        for (auto it = std::lower_bound(rt_index.begin(), rt_index.end(), make_pair(rt_pep - rt_window, Size(0)));
+             it != rt_index.end() && it->first <= rt_pep + rt_window; ++it)
+        {
+          candidates.push_back(it->second);
+        }
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
 
         // iterate over the features
-        for (Size cm_index = 0; cm_index < map.size(); ++cm_index)
+        for (Size cm_index : candidates)
         {
           // if set to TRUE, we leave the i_mz-loop as we added the whole ID with all hits
           bool was_added = false; // was current pep-m/z matched?!
@@ -431,10 +459,8 @@ namespace OpenMS
                   (ignore_charge_ || ListUtils::contains(current_charges, map[cm_index].getCharge()))  
                   ) 
               {
-                id_mapped = true;
                 was_added = true;
-                map[cm_index].getPeptideIdentifications().push_back(ids[i]);
-                ++assigned_ids[i];
+                matches[i].emplace_back(cm_index, 0);
               }
             }
             else
@@ -446,21 +472,8 @@ namespace OpenMS
                 if (isMatch_(rt_pep - it_handle->getRT(), mz_pep, it_handle->getMZ()) && 
                     (ignore_charge_ || ListUtils::contains(current_charges, it_handle->getCharge())))
                 {
-                  id_mapped = true;
                   was_added = true;
-                  if (mapping[cm_index].count(i) == 0)
-                  {
-                    // Store the map index of the peptide feature in the id the feature was mapped to.
-                    PeptideIdentification id_pep = ids[i];
-                    if (annotate_ids_with_subelements)
-                    {
-                      id_pep.setMetaValue("map_index", it_handle->getMapIndex());
-                    }
-
-                    map[cm_index].getPeptideIdentifications().push_back(id_pep);
-                    ++assigned_ids[i];
-                    mapping[cm_index].insert(i);
-                  }
+                  matches[i].emplace_back(cm_index, it_handle->getMapIndex());
                   break; // we added this peptide already.. no need to check other handles
                 }
               }
@@ -474,14 +487,39 @@ namespace OpenMS
           // break to here
 
         } // features
+      } // Identifications
+
+      // annotate sequentially in the order of the IDs
+      for (Size i = 0; i < ids.size(); ++i)
+      {
+        if (ids[i].getHits().empty()) continue;
 
         // the id has not been mapped to any consensus feature
-        if (!id_mapped)
+        if (matches[i].empty())
         {
           map.getUnassignedPeptideIdentifications().push_back(ids[i]);
           ++id_matches_none;
+          continue;
         }
-      } // Identifications
+        for (const auto& match : matches[i])
+        {
+          if (!measure_from_subelements)
+          {
+            map[match.first].getPeptideIdentifications().push_back(ids[i]);
+          }
+          else
+          {
+            // Store the map index of the peptide feature in the id the feature was mapped to.
+            PeptideIdentification id_pep = ids[i];
+            if (annotate_ids_with_subelements)
+            {
+              id_pep.setMetaValue("map_index", match.second);
+            }
+            map[match.first].getPeptideIdentifications().push_back(id_pep);
+          }
+        }
+        assigned_ids[i] = matches[i].size();
+      }
 
       for (auto aid : assigned_ids)
       {
@@ -496,7 +534,8 @@ namespace OpenMS
       }
     }
 
-    vector<Size> unidentified = mapPrecursorsToIdentifications(spectra, ids).unidentified;
+    const SpectraIdentificationState spectra_state = mapPrecursorsToIdentifications(spectra, ids);
+    const vector<Size>& unidentified = spectra_state.unidentified;
 
     if (!ids.empty() && !spectra.empty())
     {
@@ -505,8 +544,8 @@ namespace OpenMS
 
       OPENMS_LOG_INFO << "Identification state of spectra: \n"
                << "Unidentified: " << unidentified.size() << "\n"
-               << "Identified:   " << mapPrecursorsToIdentifications(spectra, ids).identified.size() << "\n"
-               << "No precursor: " << mapPrecursorsToIdentifications(spectra, ids).no_precursors.size() << endl;
+               << "Identified:   " << spectra_state.identified.size() << "\n"
+               << "No precursor: " << spectra_state.no_precursors.size() << endl;
     }
 
     // we need a valid search run identifier so we try to:
@@ -738,10 +777,13 @@ namespace OpenMS
     Size matches_none = 0, matches_single = 0, matches_multi = 0;
 
     // cout << "Finding matches..." << endl;
-    // iterate over peptide IDs:
-    for (const PeptideIdentification& id_it : ids)
+    // find the matching features of all peptide IDs in parallel (the IDs are added to the features afterwards,
+    // in their original order)
+    vector<vector<Size>> id_matches(ids.size());
+#pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize id_index = 0; id_index < (SignedSize)ids.size(); ++id_index)
     {
-      // cout << "Peptide ID: " << id_it - ids.begin() << endl;
+      const PeptideIdentification& id_it = ids[id_index];
 
       if (id_it.getHits().empty()) continue;
 
@@ -752,17 +794,14 @@ namespace OpenMS
 
       if ((rt_value < min_rt) || (rt_value > max_rt)) // RT out of bounds
       {
-        map.getUnassignedPeptideIdentifications().push_back(id_it);
-        ++matches_none;
         continue;
       }
 
       // iterate over candidate features:
       Size index = SignedSize(floor(rt_value)) - offset;
-      Size matching_features = 0;
-      for (SignedSize& hash_it : hash_table[index])
+      for (const SignedSize& hash_it : hash_table[index])
       {
-        Feature & feat = map[hash_it];
+        const Feature & feat = map[hash_it];
 
         // need to check the charge state?
         bool check_charge = !ignore_charge_;
@@ -789,13 +828,12 @@ namespace OpenMS
             {
               // only one m/z value to check, which was already incorporated
               // into the overall bounding box -> success!
-              feat.getPeptideIdentifications().push_back(id_it);
-              ++matching_features;
+              id_matches[id_index].push_back(hash_it);
               break;                     // "mz_it" loop
             }
             // else: check all the mass traces
             bool found_match = false;
-            for (vector<ConvexHull2D>::iterator ch_it =
+            for (vector<ConvexHull2D>::const_iterator ch_it =
                  feat.getConvexHulls().begin(); ch_it !=
                  feat.getConvexHulls().end(); ++ch_it)
             {
@@ -808,8 +846,7 @@ namespace OpenMS
               increaseBoundingBox_(box);
               if (box.encloses(id_pos)) // success!
               {
-                feat.getPeptideIdentifications().push_back(id_it);
-                ++matching_features;
+                id_matches[id_index].push_back(hash_it);
                 found_match = true;
                 break; // "ch_it" loop
               }
@@ -818,6 +855,18 @@ namespace OpenMS
           }
         }
       }
+    }
+
+    for (Size id_index = 0; id_index < ids.size(); ++id_index)
+    {
+      const PeptideIdentification& id_it = ids[id_index];
+      if (id_it.getHits().empty()) continue;
+
+      for (Size feature_index : id_matches[id_index])
+      {
+        map[feature_index].getPeptideIdentifications().push_back(id_it);
+      }
+      Size matching_features = id_matches[id_index].size();
       if (matching_features == 0)
       {
         map.getUnassignedPeptideIdentifications().push_back(id_it);
@@ -1045,7 +1094,7 @@ namespace OpenMS
     }
   }
 
-  void IDMapper::increaseBoundingBox_(DBoundingBox<2>& box)
+  void IDMapper::increaseBoundingBox_(DBoundingBox<2>& box) const
   {
     DPosition<2> sub_min(rt_tolerance_,
                          getAbsoluteMZTolerance_(box.minPosition().getY())),
@@ -8,8 +8,11 @@
 
 #include <OpenMS/ANALYSIS/ID/IDMergerAlgorithm.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
-#include <unordered_map>
+#include <algorithm>
 #include <array>
+#include <exception>
+#include <limits>
+#include <unordered_map>
 
 using namespace std;
 namespace OpenMS
@@ -71,28 +74,10 @@ namespace OpenMS
       const std::vector<PeptideIdentification>& peps
   )
   {
-    //copy
-    std::vector<ProteinIdentification> pr = prots;
-    std::vector<PeptideIdentification> pep = peps;
     if (prots.empty() || peps.empty()) return; //error?
 
-    //TODO instead of only checking consistency, merge if possible (especially for SILAC mods)
-    if (!filled_)
-    {
-      if (prots.size() > 1)
-      {
-        //Without any exp. design we assume label-free for checking mods
-        checkOldRunConsistency_(prots, "label-free");
-      }
-      copySearchParams_(prots[0], prot_result_);
-      filled_ = true;
-    }
-    else
-    {
-      //Without any exp. design we assume label-free for checking mods
-      checkOldRunConsistency_(prots, this->prot_result_, "label-free");
-    }
-    movePepIDsAndRefProteinsToResultFaster_(std::move(pep), std::move(pr));
+    // copy, then insert the copies
+    insertRuns(std::vector<ProteinIdentification>(prots), std::vector<PeptideIdentification>(peps));
   }
 
   void IDMergerAlgorithm::returnResultsAndClear(
@@ -141,14 +126,26 @@ namespace OpenMS
       vector<ProteinIdentification>&& old_protRuns
   )
   {
-    typedef std::vector<ProteinHit>::iterator iter_t;
+    const auto& collected = collected_protein_hits_;
     for (auto& protRun : old_protRuns) //TODO check run ID when option is added
     {
       auto& hits = protRun.getHits();
-      collected_protein_hits_.insert(
-          std::move_iterator<iter_t>(hits.begin()),
-          std::move_iterator<iter_t>(hits.end())
-      );
+      // when merging many runs against the same database, most hits are already
+      // known: look them up in parallel (read-only), then only insert the new ones
+      vector<char> is_new(hits.size());
+#pragma omp parallel for schedule(static)
+      for (SignedSize i = 0; i < (SignedSize)hits.size(); ++i)
+      {
+        is_new[i] = (collected.find(hits[i]) == collected.end());
+      }
+      collected_protein_hits_.reserve(collected_protein_hits_.size() + std::count(is_new.begin(), is_new.end(), 1));
+      for (Size i = 0; i < hits.size(); ++i)
+      {
+        if (is_new[i])
+        {
+          collected_protein_hits_.insert(std::move(hits[i])); // no-op for duplicates within the run
+        }
+      }
       hits.clear();
     }
   }
@@ -163,64 +160,108 @@ namespace OpenMS
     // then use the iterator to update and move
     // the IDs, then erase them so we don't encounter them in
     // subsequent calls of this function
-    for (auto &pid : pepIDs)
+
+    // update the IDs in parallel (all origins are already in file_origin_to_idx_,
+    // so it is only read), then move the ones to keep in their original order
+    vector<char> keep(pepIDs.size(), 0);
+    std::exception_ptr error;
+    SignedSize error_idx = std::numeric_limits<SignedSize>::max();
+#pragma omp parallel for schedule(dynamic, 256)
+    for (SignedSize i = 0; i < (SignedSize)pepIDs.size(); ++i)
     {
-      const String &runID = pid.getIdentifier();
+      try
+      {
+        keep[i] = updatePepID_(pepIDs[i], runID_to_runIdx, originFiles, annotate_origin);
+      }
+      catch (...)
+      {
+#pragma omp critical (IDMergerAlgorithm_updateAndMovePepIDs)
+        {
+          // report the error of the first ID (as a sequential run would)
+          if (i < error_idx)
+          {
+            error_idx = i;
+            error = std::current_exception();
+          }
+        }
+      }
+    }
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
 
-      const auto& runIdxIt = runID_to_runIdx.find(runID);
+    pep_result_.reserve(pep_result_.size() + std::count(keep.begin(), keep.end(), 1));
+    for (Size i = 0; i < pepIDs.size(); ++i)
+    {
+      if (keep[i])
+      {
+        //move peptides into right vector
+        pep_result_.emplace_back(std::move(pepIDs[i]));
+      }
+    }
+  }
 
-      if (runIdxIt == runID_to_runIdx.end())
+  bool IDMergerAlgorithm::updatePepID_(
+      PeptideIdentification& pid,
+      const map<String, Size>& runID_to_runIdx,
+      const vector<StringList>& originFiles,
+      bool annotate_origin) const
+  {
+    const String &runID = pid.getIdentifier();
+
+    const auto& runIdxIt = runID_to_runIdx.find(runID);
+
+    if (runIdxIt == runID_to_runIdx.end())
+    {
+      //This is an easy way to just merge peptides from a certain run
+      return false;
+      /*
+      throw Exception::MissingInformation(
+          __FILE__,
+          __LINE__,
+          OPENMS_PRETTY_FUNCTION,
+          "Old IdentificationRun not found for PeptideIdentification "
+          "(" + String(pid.getMZ()) + ", " + String(pid.getRT()) + ").");
+      */
+    }
+
+    bool annotated = pid.metaValueExists(Constants::UserParam::ID_MERGE_INDEX);
+    if (annotate_origin || annotated)
+    {
+      Size oldFileIdx(0);
+      const StringList& origins = originFiles[runIdxIt->second];
+      if (annotated)
       {
-        //This is an easy way to just merge peptides from a certain run
-        continue;
-        /*
+        oldFileIdx = pid.getMetaValue(Constants::UserParam::ID_MERGE_INDEX);
+      }
+      else if (origins.size() > 1)
+      {
+        // If there is more than one possible file it might be from
+        // and it is not annotated -> fail
         throw Exception::MissingInformation(
             __FILE__,
             __LINE__,
             OPENMS_PRETTY_FUNCTION,
-            "Old IdentificationRun not found for PeptideIdentification "
-            "(" + String(pid.getMZ()) + ", " + String(pid.getRT()) + ").");
-        */
+            "Trying to annotate new id_merge_index for PeptideIdentification "
+            "(" + String(pid.getMZ()) + ", " + String(pid.getRT()) + ") but"
+            "no old id_merge_index present");
       }
 
-      bool annotated = pid.metaValueExists(Constants::UserParam::ID_MERGE_INDEX);
-      if (annotate_origin || annotated)
+      if (oldFileIdx >= origins.size())
       {
-        Size oldFileIdx(0);
-        const StringList& origins = originFiles[runIdxIt->second];
-        if (annotated)
-        {
-          oldFileIdx = pid.getMetaValue(Constants::UserParam::ID_MERGE_INDEX);
-        }
-        else if (origins.size() > 1)
-        {
-          // If there is more than one possible file it might be from
-          // and it is not annotated -> fail
-          throw Exception::MissingInformation(
-              __FILE__,
-              __LINE__,
-              OPENMS_PRETTY_FUNCTION,
-              "Trying to annotate new id_merge_index for PeptideIdentification "
-              "(" + String(pid.getMZ()) + ", " + String(pid.getRT()) + ") but"
-              "no old id_merge_index present");
-        }
-
-        if (oldFileIdx >= origins.size())
-        {
-          throw Exception::MissingInformation(
-              __FILE__,
-              __LINE__,
-              OPENMS_PRETTY_FUNCTION,
-              "Trying to annotate new id_merge_index for PeptideIdentification "
-              "(" + String(pid.getMZ()) + ", " + String(pid.getRT()) + ") but"
-              " the index exceeds the number of files in the run.");
-        }
-        pid.setMetaValue(Constants::UserParam::ID_MERGE_INDEX, file_origin_to_idx_[origins[oldFileIdx]]);
+        throw Exception::MissingInformation(
+            __FILE__,
+            __LINE__,
+            OPENMS_PRETTY_FUNCTION,
+            "Trying to annotate new id_merge_index for PeptideIdentification "
+            "(" + String(pid.getMZ()) + ", " + String(pid.getRT()) + ") but"
+            " the index exceeds the number of files in the run.");
       }
-      pid.setIdentifier(prot_result_.getIdentifier());
-      //move peptides into right vector
-      pep_result_.emplace_back(std::move(pid));
+      pid.setMetaValue(Constants::UserParam::ID_MERGE_INDEX, file_origin_to_idx_.at(origins[oldFileIdx]));
     }
+    pid.setIdentifier(prot_result_.getIdentifier());
+    return true;
   }
 
 
@@ -12,6 +12,8 @@
 
 #include <QtCore/QDir>
 #include <array>
+#include <exception>
+#include <memory>
 #include <unordered_set>
 
 using namespace std;
@@ -138,6 +140,30 @@ namespace OpenMS
           vector<PeptideIdentification>& peptides,
           bool numeric_filenames,
           bool split_ident_runs)
+  {
+    ripped.clear();
+    auto collect = [&ripped](const RipFileIdentifier& rfi, RipFileContent&& rfc) { ripped.emplace(rfi, std::move(rfc)); };
+    rip_(collect, proteins, peptides, numeric_filenames, split_ident_runs, false);
+  }
+
+  void IDRipper::rip(
+          const RipFileConsumer& consumer,
+          vector<ProteinIdentification>& proteins,
+          vector<PeptideIdentification>& peptides,
+          bool numeric_filenames,
+          bool split_ident_runs)
+  {
+    rip_(consumer, proteins, peptides, numeric_filenames, split_ident_runs, true);
+    peptides.clear();
+  }
+
+  void IDRipper::rip_(
+          const RipFileConsumer& consumer,
+          vector<ProteinIdentification>& proteins,
+          vector<PeptideIdentification>& peptides,
+          bool numeric_filenames,
+          bool split_ident_runs,
+          bool move_peptides)
   {
     // Detect file format w.r.t. origin annotation
     map<String, UInt> file_origin_map;
@@ -166,18 +192,63 @@ namespace OpenMS
       }
     }
 
+    // Route all peptide identifications (in parallel): output file identifier and referenced protein hits.
+    // Only pointers to the representative protein hits are kept; hits are copied once per output file.
+    struct Route
+    {
+      std::unique_ptr<RipFileIdentifier> rfi;
+      std::exception_ptr error; // from the construction of rfi
+      vector<const ProteinHit*> protein_hits;
+      bool has_accessions = false;
+    };
+    vector<Route> routes(peptides.size());
+#pragma omp parallel for schedule(dynamic, 256)
+    for (SignedSize i = 0; i < (SignedSize)peptides.size(); ++i)
+    {
+      Route& route = routes[i];
+      try
+      {
+        route.rfi.reset(new RipFileIdentifier(id_runs, peptides[i], file_origin_map, origin_annotation_fmt, split_ident_runs));
+      }
+      catch (...)
+      {
+        route.error = std::current_exception();
+        continue;
+      }
+      const vector<PeptideHit>& peptide_hits = peptides[i].getHits();
+      if (peptide_hits.empty())
+      {
+        continue;
+      }
+      // collect all protein accessions that are stored in the peptide hits
+      set<String> protein_accessions = getProteinAccessions_(peptide_hits);
+      route.has_accessions = !protein_accessions.empty();
+      for (const String& acc : protein_accessions)
+      {
+        if (auto it = acc2protein_hits.find(acc); it != acc2protein_hits.end())
+        {
+          route.protein_hits.push_back(it->second);
+        }
+      }
+    }
+
     size_t protein_identifier_not_found{};
 
     map<String, pair<UInt, UInt> > basename_to_numeric;
 
-    // map run identifier to protein accessions that were already added
-    map<IDRipper::RipFileIdentifier, unordered_map<String, unordered_set<String>>, RipFileIdentifierIdxComparator> ripped_prot_map;
+    // peptide identifications (indices, in input order) of each output file
+    map<IDRipper::RipFileIdentifier, vector<Size>, RipFileIdentifierIdxComparator> rip_file_peptides;
 
-    //store protein and peptides identifications for each file origin
-    for (PeptideIdentification& pep : peptides)
+    // checks in input order, so errors and warnings are reported as for a sequential pass
+    for (Size i = 0; i < peptides.size(); ++i)
     {
-      // Build the output file identifier
-      const IDRipper::RipFileIdentifier rfi(id_runs, pep, file_origin_map, origin_annotation_fmt, split_ident_runs);
+      PeptideIdentification& pep = peptides[i];
+      Route& route = routes[i];
+      if (route.error)
+      {
+        std::rethrow_exception(route.error);
+      }
+      const IDRipper::RipFileIdentifier& rfi = *route.rfi;
 
       // If we are inferring the output file names from the spectra_data or
       // file_origin, make sure they are unique
@@ -191,147 +262,105 @@ namespace OpenMS
       pep.removeMetaValue(names_of_OriginAnnotationFormat[origin_annotation_fmt]);
 
       // get peptide hits (PSMs) for each peptide identification (spectrum)
-      const vector<PeptideHit>& peptide_hits = pep.getHits();
-      if (peptide_hits.empty())
+      if (pep.getHits().empty())
       {
         continue;
       }
-      // collect all protein accessions that are stored in the peptide hits
-      set<String> protein_accessions = getProteinAccessions_(peptide_hits);
-      if (protein_accessions.empty())
+      if (!route.has_accessions)
       {
         OPENMS_LOG_WARN << "Peptide hits with empty protein accession." << std::endl;
         continue;
       }
-
-      // returns all protein hits that are associated with the accessions of current peptide hits
-      vector<ProteinHit> proteins_of_accessions;
-      getProteinHits_(proteins_of_accessions, acc2protein_hits, protein_accessions);
-      if (proteins_of_accessions.empty())
+      if (route.protein_hits.empty())
       {
         OPENMS_LOG_WARN << "No proteins found for given accessions." << std::endl;
         continue;
       }
 
       // search for the protein identification of the peptide identification
-      int prot_ident_index = getProteinIdentification_(pep, id_runs);
-      if (prot_ident_index == -1)
+      if (getProteinIdentification_(pep, id_runs) == -1)
       {
         ++protein_identifier_not_found;
         OPENMS_LOG_WARN << "Run identifier: " << pep.getIdentifier() << " was not found in protein identification runs." << std::endl;
         continue;
       }
 
-      const ProteinIdentification& merged_protein_id_run = proteins[prot_ident_index]; // protein identification run in the merged file
-      const String& merged_prot_identifier = merged_protein_id_run.getIdentifier();        // protein identification run identifier in merged file
-    
-      if (RipFileMap::iterator it = ripped.find(rfi); it == ripped.end())
-      { // file identifier does not exist yet. We need to create it.
-        OPENMS_LOG_INFO << "Creating entry for file identifier:\n" 
-                        << "File origin: " << rfi.getOriginFullname() << "\n"
-                        // << "Identification run index: " << rfi.getIdentRunIdx() << "\n" // not set here?
-                        << "Basename: " << rfi.getOutputBasename() << "\n"
-                        << "Merged identification file run identifier: " << merged_prot_identifier << "\n"
-                        << std::endl;
-        // create the protein run but only set the protein hits that are needed for the current peptide identification
-        ProteinIdentification p;
-        p.copyMetaDataOnly(merged_protein_id_run);
-        p.setHits(proteins_of_accessions); // TODO: what about protein groups?
-        for (const ProteinHit& prot : proteins_of_accessions)
-        { // register protein so we don't add it twice          
-          const String& acc = prot.getAccession();
-          ripped_prot_map[rfi][merged_prot_identifier].insert(acc);
-        }
+      rip_file_peptides[rfi].push_back(i);
+    }
 
-        vector<ProteinIdentification> protein_idents;
-        protein_idents.push_back(std::move(p));
-
-        //create new peptide identification
-        vector<PeptideIdentification> peptide_idents;
-        peptide_idents.push_back(pep);
-
-        //create and insert new map entry
-        ripped.insert(make_pair(rfi, RipFileContent(protein_idents, peptide_idents)));
-      }    
-      else
-      { // if file identifier already exists we attach
-        // query all protein identification runs for file identifier in the Ripped data structure
-        vector<ProteinIdentification>& ripped_protein_id_runs = it->second.prot_idents;
-
-        bool ripped_protein_identifier_exists{false};
-
-        for (auto& ripped_protein_id_run : ripped_protein_id_runs)
-        { // for all protein identification runs associated with the current file identifier...
-          const String& ripped_prot_identifier = ripped_protein_id_run.getIdentifier();
-          if (merged_prot_identifier == ripped_prot_identifier)
-          { // protein identification run already exists in ripped map. just add protein hits if not already present            
-            for (const ProteinHit& prot : proteins_of_accessions)
-            {               
-              // check if protein has already been added              
-              const String& acc = prot.getAccession();
-              auto& acc_set = ripped_prot_map[rfi][merged_prot_identifier];
-              if (auto ri = acc_set.find(acc); ri == acc_set.end())
-              { // only add protein once to the run identifier
-                ripped_protein_id_run.insertHit(prot);
-                acc_set.insert(acc);
-                #ifdef DEBUG_IDRIPPER
-                  std::cout << "ripped/merged identifier: " << ripped_prot_identifier << " " << prot << std::endl;
-                #endif
-              }                
-            }
-            ripped_protein_identifier_exists = true;
-            break;
-          }
-        }
+    // assemble and hand over one output file at a time
+    for (auto& rip_file : rip_file_peptides)
+    {
+      const RipFileIdentifier& rfi = rip_file.first;
+      vector<ProteinIdentification> protein_idents;
+      vector<PeptideIdentification> peptide_idents;
+      peptide_idents.reserve(rip_file.second.size());
+
+      // protein accessions that were already added, for each protein identification run (by index into protein_idents)
+      unordered_map<String, pair<Size, unordered_set<String>>> run_to_accessions;
 
-        // file identifier exists but not the protein identification run identifier -  we did not add anything so far to it
-        if (!ripped_protein_identifier_exists) 
-        {    
+      for (Size i : rip_file.second)
+      {
+        PeptideIdentification& pep = peptides[i];
+        const ProteinIdentification& merged_protein_id_run = proteins[getProteinIdentification_(pep, id_runs)]; // protein identification run in the merged file
+        const String& merged_prot_identifier = merged_protein_id_run.getIdentifier();        // protein identification run identifier in merged file
+
+        auto run_it = run_to_accessions.find(merged_prot_identifier);
+        if (run_it == run_to_accessions.end())
+        { // protein identification run does not exist yet for this file identifier. We need to create it.
+          if (protein_idents.empty())
+          {
+            OPENMS_LOG_INFO << "Creating entry for file identifier:\n"
+                            << "File origin: " << rfi.getOriginFullname() << "\n"
+                            << "Basename: " << rfi.getOutputBasename() << "\n"
+                            << "Merged identification file run identifier: " << merged_prot_identifier << "\n"
+                            << std::endl;
+          }
           ProteinIdentification p;
           p.copyMetaDataOnly(merged_protein_id_run);
+          protein_idents.push_back(std::move(p));
+          run_it = run_to_accessions.emplace(merged_prot_identifier, make_pair(protein_idents.size() - 1, unordered_set<String>())).first;
+        }
 
-          for (const ProteinHit& prot : proteins_of_accessions)
-          {              
-            // check if protein has already been added
-            const String& acc = prot.getAccession();
-             auto& acc_set = ripped_prot_map[rfi][merged_prot_identifier];
-            if (auto ri = acc_set.find(acc); ri == acc_set.end())
-            { // only add protein once to the run identifier
-              p.insertHit(prot);;
-              acc_set.insert(acc);
-              #ifdef DEBUG_IDRIPPER
-                std::cout << "ripped/merged identifier: " << ripped_prot_identifier << " " << prot << std::endl;
-              #endif
-            }                
+        // add protein hits if not already present
+        ProteinIdentification& ripped_protein_id_run = protein_idents[run_it->second.first];
+        unordered_set<String>& acc_set = run_it->second.second;
+        for (const ProteinHit* prot : routes[i].protein_hits)
+        {
+          if (acc_set.insert(prot->getAccession()).second)
+          { // only add protein once to the run identifier
+            ripped_protein_id_run.insertHit(*prot); // TODO: what about protein groups?
+            #ifdef DEBUG_IDRIPPER
+              std::cout << "ripped/merged identifier: " << merged_prot_identifier << " " << *prot << std::endl;
+            #endif
           }
-          ripped_protein_id_runs.push_back(std::move(p));
         }
 
         // add current peptide identification
-        vector<PeptideIdentification>& ripped_pep = it->second.pep_idents;
-        ripped_pep.push_back(pep);
+        if (move_peptides)
+        {
+          peptide_idents.push_back(std::move(pep));
+        }
+        else
+        {
+          peptide_idents.push_back(pep);
+        }
       }
-    }
 
-    // Reduce the spectra data string list if that's what we ripped by
-    if (origin_annotation_fmt == MAP_INDEX || origin_annotation_fmt == ID_MERGE_INDEX)
-    {
-      RipFileMap::iterator it;
-      for (it = ripped.begin(); it != ripped.end(); ++it)
+      // Reduce the spectra data string list if that's what we ripped by
+      if (origin_annotation_fmt == MAP_INDEX || origin_annotation_fmt == ID_MERGE_INDEX)
       {
-        const RipFileIdentifier& rfi = it->first;
-        RipFileContent& rfc = it->second;
-
-        for (ProteinIdentification& prot_id : rfc.prot_idents)
+        for (ProteinIdentification& prot_id : protein_idents)
         {
-          StringList old_list;
-          prot_id.getPrimaryMSRunPath(old_list);
           StringList new_list;
           new_list.push_back(rfi.origin_fullname);
           prot_id.setPrimaryMSRunPath(new_list);
         }
       }
+
+      consumer(rfi, RipFileContent(std::move(protein_idents), std::move(peptide_idents)));
     }
+
     if (protein_identifier_not_found > 0)
     {
       OPENMS_LOG_ERROR << "Some protein identification runs referenced in peptide identifications were not found." << std::endl;
@@ -354,7 +383,7 @@ namespace OpenMS
       for (RipFileMap::iterator it = rfm.begin(); it != rfm.end(); ++it)
       {
           rfis.push_back(it->first);
-          rfcs.push_back(it->second);
+          rfcs.push_back(std::move(it->second));
       }
   }
 
@@ -420,18 +449,6 @@ IDRipper::OriginAnnotationFormat IDRipper::detectOriginAnnotationFormat_(map<Str
     }
   }
 
-  void IDRipper::getProteinHits_(vector<ProteinHit>& result, const unordered_map<String, const ProteinHit*>& acc2protein_hits, const set<String>& protein_accessions)
-  {
-    for (const String& s : protein_accessions)
-    {
-      if (auto it = acc2protein_hits.find(s); it != acc2protein_hits.end())
-      {
-        const ProteinHit* prot_ptr = it->second;
-        result.push_back(*prot_ptr);
-      }
-    }
-  }
-
   std::set<String> IDRipper::getProteinAccessions_(const vector<PeptideHit>& peptide_hits)
   {
     std::set<String> accession_set;
@@ -12,6 +12,8 @@
 
 #include <OpenMS/FORMAT/FileHandler.h>
 
+#include <exception>
+#include <limits>
 #include <numeric>
 #include <boost/math/special_functions/factorials.hpp>
 
@@ -335,10 +337,17 @@ namespace OpenMS
 
     // for every DB (theoretical) peak in the valid m/z range, find the closest
     // matching experimental (observed) peak within the allowed tolerance;
-    // in principle, multiple DB peaks can match to the same exp. peak:
-    map<Size, vector<MSSpectrum::ConstIterator>> peak_matches;
-    for (auto db_it = db_spectrum.MZBegin(mz_lower_bound);
-         db_it != db_spectrum.MZEnd(mz_upper_bound); ++db_it)
+    // in principle, multiple DB peaks can match to the same exp. peak.
+    // Both spectra are sorted by m/z, so instead of a binary search per DB peak
+    // (MSSpectrum::findNearest) a single cursor is advanced through the
+    // experimental peaks (giving the same nearest peak):
+    vector<pair<Size, Size>> peak_matches; // (exp. peak index, DB peak index)
+    const Size n_exp = exp_spectrum.size();
+    Size exp_idx = 0; // first exp. peak with m/z >= current DB m/z
+    double last_db_mz = -numeric_limits<double>::max();
+    bool matches_sorted = true;
+    const auto db_end = db_spectrum.MZEnd(mz_upper_bound);
+    for (auto db_it = db_spectrum.MZBegin(mz_lower_bound); db_it != db_end; ++db_it)
     {
       double db_mz = db_it->getMZ();
 
@@ -347,19 +356,55 @@ namespace OpenMS
         mz_offset = db_mz * fragment_mass_error * 1e-6;
       }
 
-      Int index = exp_spectrum.findNearest(db_mz, mz_offset);
-      if (index >= 0) peak_matches[index].push_back(db_it);
+      if (db_mz < last_db_mz) // DB spectrum not sorted - restart the search
+      {
+        exp_idx = exp_spectrum.MZBegin(db_mz) - exp_spectrum.begin();
+      }
+      last_db_mz = db_mz;
+      while (exp_idx < n_exp && exp_spectrum[exp_idx].getMZ() < db_mz)
+      {
+        ++exp_idx;
+      }
+
+      // the peak before or the current peak are closest:
+      Size nearest = exp_idx;
+      if (exp_idx == n_exp)
+      {
+        nearest = n_exp - 1;
+      }
+      else if ((exp_idx > 0) &&
+               !(fabs(exp_spectrum[exp_idx].getMZ() - db_mz) < fabs(exp_spectrum[exp_idx - 1].getMZ() - db_mz)))
+      {
+        nearest = exp_idx - 1;
+      }
+      double found_mz = exp_spectrum[nearest].getMZ();
+      if (found_mz >= db_mz - mz_offset && found_mz <= db_mz + mz_offset)
+      {
+        if (!peak_matches.empty() && (nearest < peak_matches.back().first))
+        {
+          matches_sorted = false;
+        }
+        peak_matches.emplace_back(nearest, db_it - db_spectrum.begin());
+      }
+    }
+    if (!matches_sorted)
+    {
+      stable_sort(peak_matches.begin(), peak_matches.end(),
+                  [](const pair<Size, Size>& a, const pair<Size, Size>& b) { return a.first < b.first; });
     }
 
+    Size matched_ions_count = 0; // count obs. peaks only once
     double dot_product = 0.0;
-    for (const auto& match : peak_matches)
+    for (Size i = 0; i < peak_matches.size(); )
     {
+      const Size exp_index = peak_matches[i].first;
       double db_intensity = 0.0;
-      for (const auto& db_it : match.second)
+      for (; (i < peak_matches.size()) && (peak_matches[i].first == exp_index); ++i)
       {
-        db_intensity = max(db_intensity, double(db_it->getIntensity()));
+        db_intensity = max(db_intensity, double(db_spectrum[peak_matches[i].second].getIntensity()));
       }
-      dot_product += db_intensity * exp_spectrum[match.first].getIntensity();
+      dot_product += db_intensity * exp_spectrum[exp_index].getIntensity();
+      ++matched_ions_count;
     }
 
     // return annotations for matching peaks?
@@ -367,25 +412,20 @@ namespace OpenMS
         !db_spectrum.getStringDataArrays().empty() &&
         !db_spectrum.getIntegerDataArrays().empty())
     {
+      // potentially add several annotations for the same peak if there are
+      // multiple matches for that peak:
       for (const auto& match : peak_matches)
       {
         const auto& exp_peak = exp_spectrum[match.first];
-        // potentially add several annotations for the same peak if there are
-        // multiple matches for that peak:
-        for (const auto& db_it : match.second)
-        {
-          PeptideHit::PeakAnnotation ann;
-          Size index = db_it - db_spectrum.begin();
-          ann.annotation = db_spectrum.getStringDataArrays()[0].at(index);
-          ann.charge = db_spectrum.getIntegerDataArrays()[0].at(index);
-          ann.mz = exp_peak.getMZ();
-          ann.intensity = exp_peak.getIntensity();
-          annotations->push_back(ann);
-        }
+        PeptideHit::PeakAnnotation ann;
+        ann.annotation = db_spectrum.getStringDataArrays()[0].at(match.second);
+        ann.charge = db_spectrum.getIntegerDataArrays()[0].at(match.second);
+        ann.mz = exp_peak.getMZ();
+        ann.intensity = exp_peak.getIntensity();
+        annotations->push_back(ann);
       }
     }
 
-    Size matched_ions_count = peak_matches.size(); // count obs. peaks only once
     double matched_ions_term = 0.0;
 
     // return score 0 if too few matched ions
@@ -448,120 +488,140 @@ namespace OpenMS
     }
 
 
-    // container storing results
-    vector<SpectralMatch> matching_results;
-
     bool fragment_error_unit_ppm(true);
     if (mz_error_unit_ == "Da") { fragment_error_unit_ppm = false; }
+    const bool positive_mode = (ion_mode_ == "positive");
+    const bool negative_mode = (ion_mode_ == "negative");
+
+    // results per query spectrum (filled in parallel, collected in order afterwards)
+    vector<vector<SpectralMatch>> results_per_spectrum(msexp.size());
+    std::exception_ptr error;
 
-    for (Size spec_idx = 0; spec_idx < msexp.size(); ++spec_idx)
+#pragma omp parallel for schedule(dynamic, 1)
+    for (SignedSize spec_idx = 0; spec_idx < (SignedSize)msexp.size(); ++spec_idx)
     {
       // cout << "merged spectrum no. " << spec_idx << " with #fragment ions: " << msexp[spec_idx].size() << endl;
-
-      // iterate over all precursor masses
-      for (Size prec_idx = 0; prec_idx < msexp[spec_idx].getPrecursors().size(); ++prec_idx)
+      try
       {
-        // get precursor m/z
-        double precursor_mz(msexp[spec_idx].getPrecursors()[prec_idx].getMZ());
+        vector<SpectralMatch>& matching_results = results_per_spectrum[spec_idx];
 
-        // cout << "precursor no. " << prec_idx << ": mz " << precursor_mz << " ";
-
-        double prec_mz_lowerbound, prec_mz_upperbound;
-
-        if (!fragment_error_unit_ppm) // Da
+        // iterate over all precursor masses
+        for (Size prec_idx = 0; prec_idx < msexp[spec_idx].getPrecursors().size(); ++prec_idx)
         {
-          prec_mz_lowerbound = precursor_mz - precursor_mz_error_;
-          prec_mz_upperbound = precursor_mz + precursor_mz_error_;
-        }
-        else // ppm
-        {
-          double ppm_offset(precursor_mz * 1e-6 * precursor_mz_error_);
-          prec_mz_lowerbound = precursor_mz - ppm_offset;
-          prec_mz_upperbound = precursor_mz + ppm_offset;
-        }
+          // get precursor m/z
+          double precursor_mz(msexp[spec_idx].getPrecursors()[prec_idx].getMZ());
 
-        // cout << "lower mz: " << prec_mz_lowerbound << " ";
-        // cout << "upper mz: " << prec_mz_upperbound << endl;
+          // cout << "precursor no. " << prec_idx << ": mz " << precursor_mz << " ";
 
-        vector<double>::const_iterator lower_it = lower_bound(mz_keys.begin(), mz_keys.end(), prec_mz_lowerbound);
-        vector<double>::const_iterator upper_it = upper_bound(mz_keys.begin(), mz_keys.end(), prec_mz_upperbound);
+          double prec_mz_lowerbound, prec_mz_upperbound;
 
-        Size start_idx(lower_it - mz_keys.begin());
-        Size end_idx(upper_it - mz_keys.begin());
+          if (!fragment_error_unit_ppm) // Da
+          {
+            prec_mz_lowerbound = precursor_mz - precursor_mz_error_;
+            prec_mz_upperbound = precursor_mz + precursor_mz_error_;
+          }
+          else // ppm
+          {
+            double ppm_offset(precursor_mz * 1e-6 * precursor_mz_error_);
+            prec_mz_lowerbound = precursor_mz - ppm_offset;
+            prec_mz_upperbound = precursor_mz + ppm_offset;
+          }
 
-        //cout << "identifying " << msexp[spec_idx].getMetaValue("Massbank_Accession_ID") << endl;
+          // cout << "lower mz: " << prec_mz_lowerbound << " ";
+          // cout << "upper mz: " << prec_mz_upperbound << endl;
 
-        vector<SpectralMatch> partial_results;
+          vector<double>::const_iterator lower_it = lower_bound(mz_keys.begin(), mz_keys.end(), prec_mz_lowerbound);
+          vector<double>::const_iterator upper_it = upper_bound(mz_keys.begin(), mz_keys.end(), prec_mz_upperbound);
 
-        for (Size search_idx = start_idx; search_idx < end_idx; ++search_idx)
-        {
-          // do spectral matching
-          // cout << "scanning " << spec_db[search_idx].getPrecursors()[0].getMZ() << " " << spec_db[search_idx].getMetaValue("Metabolite_Name") << endl;
+          Size start_idx(lower_it - mz_keys.begin());
+          Size end_idx(upper_it - mz_keys.begin());
 
-          // check for charge state of precursor ions: do they match?
-          if ( (ion_mode_ == "positive" && spec_db[search_idx].getPrecursors()[0].getCharge() < 0) || (ion_mode_ == "negative" && spec_db[search_idx].getPrecursors()[0].getCharge() > 0))
-          {
-            continue;
-          }
+          //cout << "identifying " << msexp[spec_idx].getMetaValue("Massbank_Accession_ID") << endl;
 
-          double hyperscore(computeHyperScore(fragment_mz_error_, fragment_error_unit_ppm, msexp[spec_idx], spec_db[search_idx], 0.0));
+          vector<SpectralMatch> partial_results;
 
-          // cout << " scored with " << hyperScore << endl;
-          if (hyperscore > 0)
+          for (Size search_idx = start_idx; search_idx < end_idx; ++search_idx)
           {
-            // cout << "  ** detected " << spec_db[search_idx].getMetaValue("Massbank_Accession_ID") << " " << spec_db[search_idx].getMetaValue("Metabolite_Name") << " scored with " << hyperscore << endl;
-
-            // score result temporarily
-            SpectralMatch tmp_match;
-            tmp_match.setObservedPrecursorMass(precursor_mz);
-            tmp_match.setFoundPrecursorMass(spec_db[search_idx].getPrecursors()[0].getMZ());
-            double obs_rt = floor(msexp[spec_idx].getRT() * 10)/10.0;
-            tmp_match.setObservedPrecursorRT(obs_rt);
-            tmp_match.setFoundPrecursorCharge(spec_db[search_idx].getPrecursors()[0].getCharge());
-            tmp_match.setMatchingScore(hyperscore);
-            tmp_match.setObservedSpectrumIndex(spec_idx);
-            tmp_match.setMatchingSpectrumIndex(search_idx);
-            tmp_match.setObservedSpectrumNativeID(msexp[spec_idx].getNativeID());
-
-            tmp_match.setPrimaryIdentifier(spec_db[search_idx].getMetaValue("Massbank_Accession_ID"));
-            tmp_match.setSecondaryIdentifier(spec_db[search_idx].getMetaValue("HMDB_ID"));
-            tmp_match.setSumFormula(spec_db[search_idx].getMetaValue(Constants::UserParam::MSM_SUM_FORMULA));
-            tmp_match.setCommonName(spec_db[search_idx].getMetaValue(Constants::UserParam::MSM_METABOLITE_NAME));
-            tmp_match.setInchiString(spec_db[search_idx].getMetaValue(Constants::UserParam::MSM_INCHI_STRING));
-            tmp_match.setSMILESString(spec_db[search_idx].getMetaValue(Constants::UserParam::MSM_SMILES_STRING));
-            tmp_match.setPrecursorAdduct(spec_db[search_idx].getMetaValue(Constants::UserParam::MSM_PRECURSOR_ADDUCT));
-
-            partial_results.push_back(tmp_match);
+            // do spectral matching
+            // cout << "scanning " << spec_db[search_idx].getPrecursors()[0].getMZ() << " " << spec_db[search_idx].getMetaValue("Metabolite_Name") << endl;
+
+            // check for charge state of precursor ions: do they match?
+            if ( (positive_mode && spec_db[search_idx].getPrecursors()[0].getCharge() < 0) || (negative_mode && spec_db[search_idx].getPrecursors()[0].getCharge() > 0))
+            {
+              continue;
+            }
+
+            double hyperscore(computeHyperScore(fragment_mz_error_, fragment_error_unit_ppm, msexp[spec_idx], spec_db[search_idx], 0.0));
+
+            // cout << " scored with " << hyperScore << endl;
+            if (hyperscore > 0)
+            {
+              // cout << "  ** detected " << spec_db[search_idx].getMetaValue("Massbank_Accession_ID") << " " << spec_db[search_idx].getMetaValue("Metabolite_Name") << " scored with " << hyperscore << endl;
+
+              // score result temporarily
+              SpectralMatch tmp_match;
+              tmp_match.setObservedPrecursorMass(precursor_mz);
+              tmp_match.setFoundPrecursorMass(spec_db[search_idx].getPrecursors()[0].getMZ());
+              double obs_rt = floor(msexp[spec_idx].getRT() * 10)/10.0;
+              tmp_match.setObservedPrecursorRT(obs_rt);
+              tmp_match.setFoundPrecursorCharge(spec_db[search_idx].getPrecursors()[0].getCharge());
+              tmp_match.setMatchingScore(hyperscore);
+              tmp_match.setObservedSpectrumIndex(spec_idx);
+              tmp_match.setMatchingSpectrumIndex(search_idx);
+              tmp_match.setObservedSpectrumNativeID(msexp[spec_idx].getNativeID());
+
+              tmp_match.setPrimaryIdentifier(spec_db[search_idx].getMetaValue("Massbank_Accession_ID"));
+              tmp_match.setSecondaryIdentifier(spec_db[search_idx].getMetaValue("HMDB_ID"));
+              tmp_match.setSumFormula(spec_db[search_idx].getMetaValue(Constants::UserParam::MSM_SUM_FORMULA));
+              tmp_match.setCommonName(spec_db[search_idx].getMetaValue(Constants::UserParam::MSM_METABOLITE_NAME));
+              tmp_match.setInchiString(spec_db[search_idx].getMetaValue(Constants::UserParam::MSM_INCHI_STRING));
+              tmp_match.setSMILESString(spec_db[search_idx].getMetaValue(Constants::UserParam::MSM_SMILES_STRING));
+              tmp_match.setPrecursorAdduct(spec_db[search_idx].getMetaValue(Constants::UserParam::MSM_PRECURSOR_ADDUCT));
+
+              partial_results.push_back(tmp_match);
+            }
           }
-        }
 
-        // sort results by decreasing store
-        sort(partial_results.begin(), partial_results.end(), SpectralMatchScoreGreater);
+          // sort results by decreasing store
+          sort(partial_results.begin(), partial_results.end(), SpectralMatchScoreGreater);
 
-        // report mode: top3 or best?
-        if (report_mode_ == "top3")
-        {
-          Size num_results(partial_results.size());
+          // report mode: top3 or best?
+          if (report_mode_ == "top3")
+          {
+            Size num_results(partial_results.size());
 
-          Size last_result_idx = (num_results >= 3) ? 3 : num_results;
+            Size last_result_idx = (num_results >= 3) ? 3 : num_results;
 
-          for (Size result_idx = 0; result_idx < last_result_idx; ++result_idx)
-          {
-            // cout << "score: " << partial_results[result_idx].getMatchingScore() << " " << partial_results[result_idx].getMatchingSpectrumIndex() << endl;
-            matching_results.push_back(partial_results[result_idx]);
+            for (Size result_idx = 0; result_idx < last_result_idx; ++result_idx)
+            {
+              // cout << "score: " << partial_results[result_idx].getMatchingScore() << " " << partial_results[result_idx].getMatchingSpectrumIndex() << endl;
+              matching_results.push_back(partial_results[result_idx]);
+            }
           }
-        }
 
-        if (report_mode_ == "best")
-        {
-          if (!partial_results.empty())
+          if (report_mode_ == "best")
           {
-            matching_results.push_back(partial_results[0]);
+            if (!partial_results.empty())
+            {
+              matching_results.push_back(partial_results[0]);
+            }
           }
-        }
 
-      } // end precursor loop
+        } // end precursor loop
+      }
+      catch (...)
+      {
+#pragma omp critical (MetaboliteSpectralMatching_run)
+        if (!error) error = std::current_exception();
+      }
     } // end spectra loop
+    if (error) std::rethrow_exception(error);
+
+    vector<SpectralMatch> matching_results;
+    for (vector<SpectralMatch>& partial : results_per_spectrum)
+    {
+      matching_results.insert(matching_results.end(), make_move_iterator(partial.begin()), make_move_iterator(partial.end()));
+    }
 
     // write final results to MzTab
     exportMzTab_(matching_results, mztab_out);
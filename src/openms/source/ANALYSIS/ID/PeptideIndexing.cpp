@@ -17,6 +17,7 @@
 
 #include <atomic>
 #include <map>
+#include <unordered_map>
 #include <array>
 
 
@@ -395,7 +396,7 @@ PeptideIndexing::ExitCodes PeptideIndexing::run_(FASTAContainer<T>& proteins, st
   FoundProteinFunctor func(enzyme, xtandem_fix_parameters); // store the matches
   std::map<String, Size> acc_to_prot; // map: accessions --> FASTA protein index
   std::vector<bool> protein_is_decoy; // protein index -> is decoy?
-  std::vector<std::string> protein_accessions; // protein index -> accession
+  std::unordered_map<Hit::T, std::string> protein_accessions; // protein index -> accession (only for proteins with hits, the DB can be huge)
 
   bool invalid_protein_sequence = false; // check for proteins with modifications, i.e. '[' or '(', and throw an exception
 
@@ -450,11 +451,22 @@ PeptideIndexing::ExitCodes PeptideIndexing::run_(FASTAContainer<T>& proteins, st
     // use very large target value for progress if DB size is unknown (did not fit into first chunk)
     this->startProgress(0, proteins.size() == PROTEIN_CACHE_SIZE ? std::numeric_limits<SignedSize>::max() : proteins.size(), "Aho-Corasick");
     std::atomic<int> progress_prots(0);
+
+    // results of each thread, merged after the search (no synchronization between threads while searching)
+#ifdef _OPENMP
+    const int nr_threads = omp_get_max_threads();
+#else
+    const int nr_threads = 1;
+#endif
+    std::vector<FoundProteinFunctor::MapType> thread_hits(nr_threads);
+    std::vector<std::vector<std::pair<Hit::T, std::string> > > thread_accessions(nr_threads);
+    std::vector<std::map<String, Size> > thread_acc_to_prot(nr_threads);
     
     #pragma omp parallel
     {
       FoundProteinFunctor func_threads(enzyme, xtandem_fix_parameters);
       std::map<String, Size> acc_to_prot_thread; // map: accessions --> FASTA protein index
+      std::vector<std::pair<Hit::T, std::string> > accessions_thread; // protein index --> accession of found proteins
       ACTrieState ac_state;
       String prot;
 
@@ -464,7 +476,6 @@ PeptideIndexing::ExitCodes PeptideIndexing::run_(FASTAContainer<T>& proteins, st
         #pragma omp single
         {
           has_active_data = proteins.activateCache(); // swap in last cache
-          protein_accessions.resize(proteins.getChunkOffset() + proteins.chunkSize());
         } // implicit barrier here
         
         if (!has_active_data) break; // leave while-loop
@@ -551,27 +562,55 @@ PeptideIndexing::ExitCodes PeptideIndexing::run_(FASTAContainer<T>& proteins, st
           // was protein found?
           if (hits_total < func_threads.filter_passed + func_threads.filter_rejected)
           {
-            protein_accessions[prot_idx] = proteins.chunkAt(i).identifier;
-            acc_to_prot_thread[protein_accessions[prot_idx]] = prot_idx;
+            accessions_thread.emplace_back(prot_idx, proteins.chunkAt(i).identifier);
+            acc_to_prot_thread[proteins.chunkAt(i).identifier] = prot_idx;
           }
         } // end parallel FOR
-
-        // join results
-        #pragma omp critical(PeptideIndexer_joinAC)
-        {
-          s.start();
-          // hits
-          func.merge(func_threads);
-          // sort hits by peptide index
-          std::sort(func.pep_to_prot.begin(), func.pep_to_prot.end());
-          // accession -> index
-          acc_to_prot.insert(acc_to_prot_thread.begin(), acc_to_prot_thread.end());
-          acc_to_prot_thread.clear();
-          s.stop();
-        } // OMP end critical
       } // end readChunk
+
+      // sort the hits of this thread by peptide index (in parallel), the sorted runs are merged below
+      std::sort(func_threads.pep_to_prot.begin(), func_threads.pep_to_prot.end());
+      #ifdef _OPENMP
+      const int thread_num = omp_get_thread_num();
+      #else
+      const int thread_num = 0;
+      #endif
+      thread_hits[thread_num] = std::move(func_threads.pep_to_prot);
+      thread_accessions[thread_num] = std::move(accessions_thread);
+      thread_acc_to_prot[thread_num] = std::move(acc_to_prot_thread);
+      #pragma omp atomic
+      func.filter_passed += func_threads.filter_passed;
+      #pragma omp atomic
+      func.filter_rejected += func_threads.filter_rejected;
     } // OMP end parallel
     this->endProgress();
+
+    // join results: each protein was searched by exactly one thread, so merging the sorted runs gives all hits sorted by peptide index
+    s.start();
+    for (auto& hits : thread_hits)
+    {
+      const Size middle = func.pep_to_prot.size();
+      func.pep_to_prot.insert(func.pep_to_prot.end(), hits.begin(), hits.end());
+      FoundProteinFunctor::MapType().swap(hits);
+      std::inplace_merge(func.pep_to_prot.begin(), func.pep_to_prot.begin() + middle, func.pep_to_prot.end());
+    }
+    for (Size t = 0; t < thread_accessions.size(); ++t)
+    {
+      for (auto& idx_acc : thread_accessions[t])
+      {
+        protein_accessions[idx_acc.first] = std::move(idx_acc.second);
+      }
+      // duplicate accessions keep their last protein in the database (like a single thread), whichever thread found them
+      for (const auto& acc_idx : thread_acc_to_prot[t])
+      {
+        auto ins = acc_to_prot.insert(acc_idx);
+        if (!ins.second && ins.first->second < acc_idx.second)
+        {
+          ins.first->second = acc_idx.second;
+        }
+      }
+    }
+    s.stop();
     std::cout << "Merge took: " << s.toString() << "\n";
     mu.after();
     std::cout << mu.delta("Aho-Corasick") << "\n\n";
@@ -662,7 +701,7 @@ PeptideIndexing::ExitCodes PeptideIndexing::run_(FASTAContainer<T>& proteins, st
           ++prot_count_of_current_pep;
         }
 
-        const String& accession = protein_accessions[pe.protein_index];
+        const String& accession = protein_accessions.at(pe.protein_index);
         it_hit->addPeptideEvidence(PeptideEvidence(accession, pe.position, pe.position + (int)it_hit->getSequence().size() - 1, pe.AABefore, pe.AAAfter));
 
         runidx_to_protidx[run_idx].insert(pe.protein_index); // fill protein hits
@@ -777,7 +816,7 @@ PeptideIndexing::ExitCodes PeptideIndexing::run_(FASTAContainer<T>& proteins, st
     for (std::set<Size>::const_iterator it = masterset.begin(); it != masterset.end(); ++it)
     {
       ProteinHit hit;
-      hit.setAccession(protein_accessions[*it]);
+      hit.setAccession(protein_accessions.at(Hit::T(*it)));
       
       if (write_protein_sequence_ || write_protein_description_)
       {
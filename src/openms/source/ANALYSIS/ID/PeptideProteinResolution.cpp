@@ -7,6 +7,7 @@
 // --------------------------------------------------------------------------
 #include <OpenMS/ANALYSIS/ID/PeptideProteinResolution.h>
 #include <OpenMS/PROCESSING/ID/IDFilter.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
 
 #include <queue>
 #include <unordered_set>
@@ -101,10 +102,12 @@ namespace OpenMS
       }
     }
 
-    // Go through PeptideIDs
-    for (PeptideIdentification& pep : peptides)
+    // Go through PeptideIDs (independently of each other, the log messages are written in their order afterwards)
+    vector<String> tie_messages(peptides.size());
+    vector<char> without_hits(peptides.size(), 0);
+    TaskScheduler::parallelFor(0, peptides.size(), [&](SignedSize pep_idx)
     {
-
+      PeptideIdentification& pep = peptides[pep_idx];
       vector<PeptideHit>& hits = pep.getHits();
       if (!hits.empty())
       {
@@ -118,7 +121,7 @@ namespace OpenMS
         for (vector<PeptideEvidence>::const_iterator pepev_it = pepev.begin();
              pepev_it != pepev.end(); ++pepev_it, ++ev_idx)
         {
-          String acc = pepev_it->getProteinAccession();
+          const String& acc = pepev_it->getProteinAccession();
 
           auto found = prot_acc_to_indist_prot_grp.find(acc);
           if (found == prot_acc_to_indist_prot_grp.end())
@@ -208,21 +211,19 @@ namespace OpenMS
           evToKeep = grpIdxToEvIdx[*toResolve->begin()];
           if (toResolve->size() > 1)
           {
-           OPENMS_LOG_INFO << "Resolution: Peptide " << pep.getHits()[0].getSequence().toString() << " had groups:" << std::endl;
-
-           OPENMS_LOG_INFO << "tgt: ";
+            String& msg = tie_messages[pep_idx];
+            msg = "Resolution: Peptide " + pep.getHits()[0].getSequence().toString() + " had groups:\n";
+            msg += "tgt: ";
             for (const auto& g : bestNonDecoyGrpTie)
             {
-              OPENMS_LOG_INFO << g << "=" << groups[g].probability << ", ";
+              msg += String(g) + "=" + String(groups[g].probability) + ", ";
             }
-           OPENMS_LOG_INFO << std::endl;
-           OPENMS_LOG_INFO << "dec: ";
+            msg += "\ndec: ";
             for (const auto& g : bestDecoyGrpTie)
             {
-              OPENMS_LOG_INFO << g << "=" << groups[g].probability << ", ";
+              msg += String(g) + "=" + String(groups[g].probability) + ", ";
             }
-           OPENMS_LOG_INFO << std::endl;
-           OPENMS_LOG_INFO << "Kept: " << *toResolve->begin() << std::endl;
+            msg += "\nKept: " + String(*toResolve->begin());
           }
         }
         else
@@ -239,12 +240,24 @@ namespace OpenMS
         {
           newEv.push_back(pepev[idx]);
         }
-        best_hit.setPeptideEvidences(newEv);
+        best_hit.setPeptideEvidences(std::move(newEv));
       }
       else
+      {
+        without_hits[pep_idx] = 1;
+      }
+    }, 64);
+
+    for (Size pep_idx = 0; pep_idx < peptides.size(); ++pep_idx)
+    {
+      if (without_hits[pep_idx])
       {
        OPENMS_LOG_WARN << "Warning PeptideProteinResolution: Skipping spectrum without hits." << std::endl;
       }
+      else if (!tie_messages[pep_idx].empty())
+      {
+       OPENMS_LOG_INFO << tie_messages[pep_idx] << std::endl;
+      }
     }
   }
 
@@ -303,13 +316,13 @@ namespace OpenMS
       const vector<PeptideHit>& hits = pep_it->getHits();
       if (!hits.empty())
       {
-        PeptideHit best_hit = hits[0];
+        const PeptideHit& best_hit = hits[0];
         const vector<PeptideEvidence>& pepev = best_hit.getPeptideEvidences();
 
         for (vector<PeptideEvidence>::const_iterator pepev_it = pepev.begin();
              pepev_it != pepev.end(); ++pepev_it)
         {
-          String acc = pepev_it->getProteinAccession();
+          const String& acc = pepev_it->getProteinAccession();
           auto found = prot_acc_to_indist_prot_grp_.find(acc);
           if (found == prot_acc_to_indist_prot_grp_.end())
           {
@@ -323,7 +336,6 @@ namespace OpenMS
           {
             Size prot_group_index = found->second;
             pep_to_indist_prot_grp_[pep_index].insert(prot_group_index);
-            indist_prot_grp_to_pep_[prot_group_index];
             indist_prot_grp_to_pep_[prot_group_index].insert(pep_index);
           }
         }
@@ -341,30 +353,40 @@ namespace OpenMS
   {
     //Debugging
     Size old_size = indist_prot_grp_to_pep_.size();
+    Size remaining = old_size;
     
     //Statistics
     ConnectedComponent most_peps;
     ConnectedComponent most_grps;
     ConnectedComponent most_both;
     
-    // Traverse every connected component, remove visited "nodes" in each step
-    while (!indist_prot_grp_to_pep_.empty())
+    // Collect every connected component, starting each BFS from the first
+    // protein group not visited yet. Resolution only changes the edges within
+    // a component, so this gives the same components as resolving in between.
+    vector<ConnectedComponent> components;
+    unordered_set<Size> visited;
+    for (const auto& grp_to_peps : indist_prot_grp_to_pep_)
     {
-      if (statistics_ && (old_size - indist_prot_grp_to_pep_.size() > 1))
+      if (visited.count(grp_to_peps.first))
+      {
+        continue;
+      }
+
+      if (statistics_ && (old_size - remaining > 1))
       {
         OPENMS_LOG_INFO << "resolved group of size "
-        << old_size - indist_prot_grp_to_pep_.size() << " in last step "
+        << old_size - remaining << " in last step "
         << endl;
-        old_size = indist_prot_grp_to_pep_.size();
+        old_size = remaining;
       }
-      
-      // We take any (= first) protein from map that is still left,
-      // to start the next BFS from it
-      Size root_prot_grp = indist_prot_grp_to_pep_.begin()->first;
-      
+
       // do BFS, return connected proteins and peptides
-      ConnectedComponent curr_component =
-      PeptideProteinResolution::findConnectedComponent(root_prot_grp);
+      Size root_prot_grp = grp_to_peps.first;
+      components.push_back(PeptideProteinResolution::findConnectedComponent(root_prot_grp));
+      const ConnectedComponent& curr_component = components.back();
+      visited.insert(curr_component.prot_grp_indices.begin(), curr_component.prot_grp_indices.end());
+      remaining -= curr_component.prot_grp_indices.size();
+
       // For debugging and statistics
       if (statistics_)
       {
@@ -395,22 +417,27 @@ namespace OpenMS
           OPENMS_LOG_INFO << endl << "Processing ..." << endl;
         }
       }
-      
-      // resolve shared peptides based on posterior probabilities
-      // -> modifies PeptideIDs in peptides
-      PeptideProteinResolution::resolveConnectedComponent(curr_component,
-                                                           protein,
-                                                           peptides);
-      
-      // mark proteins of this component as visited by removing them
-      for (set<Size>::iterator grp_it =
-           curr_component.prot_grp_indices.begin();
-           grp_it != curr_component.prot_grp_indices.end();
-           ++grp_it)
+    }
+
+    // resolve shared peptides based on posterior probabilities
+    // -> modifies PeptideIDs in peptides, components are disjoint
+    vector<ProteinIdentification::ProteinGroup> ambiguity_grps(components.size());
+    vector<char> has_ambiguity_grp(components.size(), 0);
+    TaskScheduler::parallelFor(0, components.size(), [&](SignedSize c)
+    {
+      has_ambiguity_grp[c] = resolveConnectedComponent_(components[c], protein, peptides, ambiguity_grps[c]);
+    }, 16);
+
+    for (Size c = 0; c < components.size(); ++c)
+    {
+      if (has_ambiguity_grp[c])
       {
-        indist_prot_grp_to_pep_.erase(*grp_it);
+        protein.insertProteinGroup(ambiguity_grps[c]);
       }
     }
+
+    // every protein group was visited
+    indist_prot_grp_to_pep_.clear();
     
     //TODO maybe extend statistics of connected components!
     if (statistics_)
@@ -451,21 +478,16 @@ namespace OpenMS
       pair<bool, Size> curr_node = my_queue.front();
       my_queue.pop();
     
-      // initialize neighbors
-      set<Size> neighbors;
-    
       // Choose correct map, depending on if we deal with protGrp or peptide
-      if (curr_node.first)
+      const IndexMap_& adjacency = curr_node.first ? indist_prot_grp_to_pep_ : pep_to_indist_prot_grp_;
+      IndexMap_::const_iterator neighbors = adjacency.find(curr_node.second);
+      if (neighbors == adjacency.end())
       {
-        neighbors = indist_prot_grp_to_pep_[curr_node.second];
-      }
-      else
-      {
-        neighbors = pep_to_indist_prot_grp_[curr_node.second];
+        continue;
       }
     
-      for (set<Size>::iterator nb_it = neighbors.begin();
-         nb_it != neighbors.end();
+      for (set<Size>::const_iterator nb_it = neighbors->second.begin();
+         nb_it != neighbors->second.end();
          ++nb_it)
       {
         // If current node is protein, its neighbors are peptides and
@@ -672,32 +694,49 @@ namespace OpenMS
       ConnectedComponent& conn_comp,
       ProteinIdentification& protein,
       vector<PeptideIdentification>& peptides)
+  {
+    ProteinIdentification::ProteinGroup ambiguity_grp;
+    if (resolveConnectedComponent_(conn_comp, protein, peptides, ambiguity_grp))
+    {
+      //Finally insert ambiguity group
+      protein.insertProteinGroup(ambiguity_grp);
+    }
+  }
+
+  bool PeptideProteinResolution::resolveConnectedComponent_(
+      ConnectedComponent& conn_comp,
+      const ProteinIdentification& protein,
+      vector<PeptideIdentification>& peptides,
+      ProteinIdentification::ProteinGroup& ambiguity_grp)
   {
     // TODO think about ignoring decoy proteins (at least when resolving ties!)
 
     // Nothing to resolve in a singleton group (will not be added to output though)
-    if (conn_comp.prot_grp_indices.size() <= 1) return;
-
-    // Add proteins from a connected component to ambiguity groups
-    ProteinIdentification::ProteinGroup ambiguity_grp;
+    if (conn_comp.prot_grp_indices.size() <= 1) return false;
 
-    vector<ProteinIdentification::ProteinGroup>& origin_groups = protein.getIndistinguishableProteins();
+    const vector<ProteinIdentification::ProteinGroup>& origin_groups = protein.getIndistinguishableProteins();
 
     // Save the max probability in this component to add it (should be first one, since groups were sorted and
     // lower index means higher score and set is sorted by index)
     size_t best_grp_index = *conn_comp.prot_grp_indices.begin();
     ambiguity_grp.probability = origin_groups[best_grp_index].probability;
     
-    // copy group indices so we can reorder them for tie resolution
+    // copy group indices so we can reorder them for tie resolution. The peptide sets are looked up once;
+    // only the sets of this component are modified below (the map itself is not).
     vector<Size> prot_grp_indices(conn_comp.prot_grp_indices.begin(), conn_comp.prot_grp_indices.end());
+    unordered_map<Size, set<Size>*> grp_to_peps;
+    for (Size grp : prot_grp_indices)
+    {
+      grp_to_peps[grp] = &indist_prot_grp_to_pep_.at(grp);
+    }
 
     // groups are currently only sorted by probability.
     // in the presence of ties we need to resolve them by the number of peptides.
     std::sort(prot_grp_indices.begin(), prot_grp_indices.end(), 
       [&](const Size & a, const Size & b) -> bool
       { 
-        size_t as = indist_prot_grp_to_pep_[a].size();
-        size_t bs = indist_prot_grp_to_pep_[b].size();
+        size_t as = grp_to_peps[a]->size();
+        size_t bs = grp_to_peps[b]->size();
         return std::tie(origin_groups[a].probability, as) > std::tie(origin_groups[b].probability, bs);
       });   
 
@@ -714,6 +753,7 @@ namespace OpenMS
       }
 
       const vector<String>& accessions = origin_groups[*grp_it].accessions;
+      const set<Size>& grp_peps = *grp_to_peps[*grp_it];
 
       // Put the accessions of the indist. groups into the subsuming
       // ambiguity group
@@ -722,21 +762,19 @@ namespace OpenMS
                                       accessions.end());
       if (statistics_)
       {
-        OPENMS_LOG_DEBUG << "Group: ";
+        String group_accessions;
         for (const String& s : accessions)
         {
-          OPENMS_LOG_DEBUG << s << ", ";
+          group_accessions += s + ", ";
         }
-        OPENMS_LOG_DEBUG << " steals " << indist_prot_grp_to_pep_[*grp_it].size() << " peptides for itself." << std::endl;
+        OPENMS_LOG_DEBUG << "Group: " << group_accessions << " steals " << grp_peps.size() << " peptides for itself." << std::endl;
       }
 
       // Update all the peptides the current best point to
-      for (set<Size>::iterator pepid_it = indist_prot_grp_to_pep_[*grp_it].begin();
-           pepid_it != indist_prot_grp_to_pep_[*grp_it].end(); ++pepid_it)
+      for (set<Size>::const_iterator pepid_it = grp_peps.begin();
+           pepid_it != grp_peps.end(); ++pepid_it)
       {
-        vector<PeptideHit> pep_id_hits = peptides[*pepid_it].getHits();
-        vector<PeptideEvidence> best_hit_ev =
-            pep_id_hits[0].getPeptideEvidences();
+        PeptideHit& best_hit = peptides[*pepid_it].getHits()[0];
 
         // Go through all _remaining_ proteins of the component and remove this
         // peptide from their mapping
@@ -745,37 +783,22 @@ namespace OpenMS
         for (; grp_it_cont != prot_grp_indices.end();
                               ++grp_it_cont)
         {
-          indist_prot_grp_to_pep_[*grp_it_cont].erase(*pepid_it);
+          grp_to_peps[*grp_it_cont]->erase(*pepid_it);
         }
 
         // go through all the evidence of this peptide and remove all
         // proteins but the ones from the current indist. group
-        for (vector<PeptideEvidence>::iterator pepev_it = best_hit_ev.begin();
-             pepev_it != best_hit_ev.end();
-          //don't increase index, will be done by case
-            )
-        {
-          // if its accession is not in the current best group, remove evidence
-          if (find(accessions.begin(),
-                   accessions.end(),
-                   pepev_it->getProteinAccession()) == accessions.end())
+        vector<PeptideEvidence> best_hit_ev = best_hit.getPeptideEvidences();
+        best_hit_ev.erase(std::remove_if(best_hit_ev.begin(), best_hit_ev.end(),
+          [&accessions](const PeptideEvidence& ev)
           {
-            // we get valid iterator from erase with shifted objects
-            pepev_it = best_hit_ev.erase(pepev_it);
-          }
-          else
-          { // iterate further
-            ++pepev_it;
-          }
-        }
+            return find(accessions.begin(), accessions.end(), ev.getProteinAccession()) == accessions.end();
+          }), best_hit_ev.end());
         // Set the remaining evidences as new evidence
-        pep_id_hits[0].setPeptideEvidences(best_hit_ev);
-        peptides[*pepid_it].setHits(pep_id_hits);
+        best_hit.setPeptideEvidences(std::move(best_hit_ev));
       }
     }
-
-    //Finally insert ambiguity group
-    protein.insertProteinGroup(ambiguity_grp);
+    return true;
   }
 
 
@@ -14,10 +14,52 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include <exception>
+
 using namespace std;
 
 namespace OpenMS
-{    
+{
+    namespace
+    {
+      /// Index of meta value @p name (registered if new), to access meta values without name lookups in parallel loops
+      UInt metaIndex(const String& name)
+      {
+        return MetaInfoInterface::metaRegistry().registerName(name);
+      }
+
+      /// Calls @p f(i) for all i in [0, n) in parallel and rethrows the exception of the smallest i (as a sequential loop would)
+      template<typename Function>
+      void parallelFor(SignedSize n, const Function& f)
+      {
+        std::exception_ptr error;
+        SignedSize error_idx = n;
+#pragma omp parallel for schedule(dynamic, 256)
+        for (SignedSize i = 0; i < n; ++i)
+        {
+          try
+          {
+            f(i);
+          }
+          catch (...)
+          {
+#pragma omp critical (PercolatorFeatureSetHelper_parallelFor)
+            {
+              if (i < error_idx)
+              {
+                error_idx = i;
+                error = std::current_exception();
+              }
+            }
+          }
+        }
+        if (error)
+        {
+          std::rethrow_exception(error);
+        }
+      }
+    }
+
     void PercolatorFeatureSetHelper::addMSGFFeatures(vector<PeptideIdentification>& peptide_ids, StringList& feature_set)
     {
       feature_set.push_back("MS:1002049"); // unchanged RawScore
@@ -34,18 +76,42 @@ namespace OpenMS
       feature_set.push_back("MSGF:sqMeanErrorTop7");
       feature_set.push_back("MSGF:StdevErrorTop7");
       
-      for (vector<PeptideIdentification>::iterator it = peptide_ids.begin(); it != peptide_ids.end(); ++it)
+      // meta value indices, so the hits are accessed without name lookups in the (parallel) loop
+      const UInt num_matched_main_ions_idx = metaIndex("NumMatchedMainIons");
+      const UInt mean_error_top7_idx = metaIndex("MeanErrorTop7");
+      const UInt stdev_error_top7_idx = metaIndex("StdevErrorTop7");
+      const UInt raw_score_idx = metaIndex("MS:1002049");
+      const UInt denovo_score_idx = metaIndex("MS:1002050");
+      const UInt evalue_idx = metaIndex("MS:1002053");
+      const UInt explained_ion_current_ratio_idx = metaIndex("ExplainedIonCurrentRatio");
+      const UInt nterm_ion_current_ratio_idx = metaIndex("NTermIonCurrentRatio");
+      const UInt cterm_ion_current_ratio_idx = metaIndex("CTermIonCurrentRatio");
+      const UInt ms2_ion_current_idx = metaIndex("MS2IonCurrent");
+      const UInt score_ratio_idx = metaIndex("MSGF:ScoreRatio");
+      const UInt energy_idx = metaIndex("MSGF:Energy");
+      const UInt ln_evalue_idx = metaIndex("MSGF:lnEValue");
+      const UInt ln_explained_ion_current_ratio_idx = metaIndex("MSGF:lnExplainedIonCurrentRatio");
+      const UInt ln_nterm_ion_current_ratio_idx = metaIndex("MSGF:lnNTermIonCurrentRatio");
+      const UInt ln_cterm_ion_current_ratio_idx = metaIndex("MSGF:lnCTermIonCurrentRatio");
+      const UInt ln_ms2_ion_current_idx = metaIndex("MSGF:lnMS2IonCurrent");
+      const UInt msgf_mean_error_top7_idx = metaIndex("MSGF:MeanErrorTop7");
+      const UInt msgf_sq_mean_error_top7_idx = metaIndex("MSGF:sqMeanErrorTop7");
+      const UInt msgf_stdev_error_top7_idx = metaIndex("MSGF:StdevErrorTop7");
+
+      Size nan_stdev_count = 0;
+      Size missing_ions_count = 0;
+      parallelFor(peptide_ids.size(), [&](SignedSize i)
       {
-        for (vector<PeptideHit>::iterator hit = it->getHits().begin(); hit != it->getHits().end(); ++hit)
+        for (PeptideHit& hit : peptide_ids[i].getHits())
         {
           // Some Hits have no NumMatchedMainIons, and MeanError, etc. values. Have to ignore them!
-          if (hit->metaValueExists("NumMatchedMainIons"))
+          if (hit.metaValueExists(num_matched_main_ions_idx))
           {
             // only take features from first ranked entries and only with meanerrortop7 != 0.0
-            if (hit->getMetaValue("MeanErrorTop7").toString().toDouble() != 0.0)
+            if (hit.getMetaValue(mean_error_top7_idx).toString().toDouble() != 0.0)
             {
-              double raw_score = hit->getMetaValue("MS:1002049").toString().toDouble();
-              double denovo_score = hit->getMetaValue("MS:1002050").toString().toDouble();
+              double raw_score = hit.getMetaValue(raw_score_idx).toString().toDouble();
+              double denovo_score = hit.getMetaValue(denovo_score_idx).toString().toDouble();
               
               double energy = denovo_score - raw_score;
               double score_ratio = raw_score * 10000;
@@ -53,29 +119,29 @@ namespace OpenMS
               {
                 score_ratio = (raw_score / denovo_score);
               }
-              hit->setMetaValue("MSGF:ScoreRatio", score_ratio);
-              hit->setMetaValue("MSGF:Energy", energy);
+              hit.setMetaValue(score_ratio_idx, score_ratio);
+              hit.setMetaValue(energy_idx, energy);
               
-              double ln_eval = -log(hit->getMetaValue("MS:1002053").toString().toDouble());
-              hit->setMetaValue("MSGF:lnEValue", ln_eval);
+              double ln_eval = -log(hit.getMetaValue(evalue_idx).toString().toDouble());
+              hit.setMetaValue(ln_evalue_idx, ln_eval);
               
-              double ln_explained_ion_current_ratio = log(hit->getMetaValue("ExplainedIonCurrentRatio").toString().toDouble() + 0.0001);
-              double ln_NTerm_ion_current_ratio = log(hit->getMetaValue("NTermIonCurrentRatio").toString().toDouble() + 0.0001);
-              double ln_CTerm_ion_current_ratio = log(hit->getMetaValue("CTermIonCurrentRatio").toString().toDouble() + 0.0001);
-              hit->setMetaValue("MSGF:lnExplainedIonCurrentRatio", ln_explained_ion_current_ratio);
-              hit->setMetaValue("MSGF:lnNTermIonCurrentRatio", ln_NTerm_ion_current_ratio);
-              hit->setMetaValue("MSGF:lnCTermIonCurrentRatio", ln_CTerm_ion_current_ratio);
+              double ln_explained_ion_current_ratio = log(hit.getMetaValue(explained_ion_current_ratio_idx).toString().toDouble() + 0.0001);
+              double ln_NTerm_ion_current_ratio = log(hit.getMetaValue(nterm_ion_current_ratio_idx).toString().toDouble() + 0.0001);
+              double ln_CTerm_ion_current_ratio = log(hit.getMetaValue(cterm_ion_current_ratio_idx).toString().toDouble() + 0.0001);
+              hit.setMetaValue(ln_explained_ion_current_ratio_idx, ln_explained_ion_current_ratio);
+              hit.setMetaValue(ln_nterm_ion_current_ratio_idx, ln_NTerm_ion_current_ratio);
+              hit.setMetaValue(ln_cterm_ion_current_ratio_idx, ln_CTerm_ion_current_ratio);
               
-              double ln_MS2_ion_current = log(hit->getMetaValue("MS2IonCurrent").toString().toDouble());
-              hit->setMetaValue("MSGF:lnMS2IonCurrent", ln_MS2_ion_current);
+              double ln_MS2_ion_current = log(hit.getMetaValue(ms2_ion_current_idx).toString().toDouble());
+              hit.setMetaValue(ln_ms2_ion_current_idx, ln_MS2_ion_current);
               
-              double mean_error_top7 = hit->getMetaValue("MeanErrorTop7").toString().toDouble();
-              int num_matched_main_ions =  hit->getMetaValue("NumMatchedMainIons").toString().toInt();
+              double mean_error_top7 = hit.getMetaValue(mean_error_top7_idx).toString().toDouble();
+              int num_matched_main_ions =  hit.getMetaValue(num_matched_main_ions_idx).toString().toInt();
 
               double stdev_error_top7 = 0.0;
-              if (hit->getMetaValue("StdevErrorTop7").toString() != "NaN")
+              if (hit.getMetaValue(stdev_error_top7_idx).toString() != "NaN")
               {
-                stdev_error_top7 = hit->getMetaValue("StdevErrorTop7").toString().toDouble();
+                stdev_error_top7 = hit.getMetaValue(stdev_error_top7_idx).toString().toDouble();
                 if (stdev_error_top7 == 0.0)
                 {
                   stdev_error_top7 = mean_error_top7;
@@ -84,19 +150,32 @@ namespace OpenMS
               else
               {
                 stdev_error_top7 = mean_error_top7;
-                OPENMS_LOG_WARN << "StdevErrorTop7 is NaN, setting as MeanErrorTop7 instead." << endl;
+#pragma omp atomic
+                ++nan_stdev_count;
               }
               
               mean_error_top7 = rescaleFragmentFeature_(mean_error_top7, num_matched_main_ions);
               double sq_mean_error_top7 = rescaleFragmentFeature_(mean_error_top7 * mean_error_top7, num_matched_main_ions);
               stdev_error_top7 = rescaleFragmentFeature_(stdev_error_top7, num_matched_main_ions);
-              hit->setMetaValue("MSGF:MeanErrorTop7", mean_error_top7);
-              hit->setMetaValue("MSGF:sqMeanErrorTop7", sq_mean_error_top7);
-              hit->setMetaValue("MSGF:StdevErrorTop7", stdev_error_top7);
+              hit.setMetaValue(msgf_mean_error_top7_idx, mean_error_top7);
+              hit.setMetaValue(msgf_sq_mean_error_top7_idx, sq_mean_error_top7);
+              hit.setMetaValue(msgf_stdev_error_top7_idx, stdev_error_top7);
             }
           }
-          else OPENMS_LOG_WARN << "MS-GF+ PSM with missing NumMatchedMainIons skipped." << endl;
+          else
+          {
+#pragma omp atomic
+            ++missing_ions_count;
+          }
         }
+      });
+      if (nan_stdev_count > 0)
+      {
+        OPENMS_LOG_WARN << "StdevErrorTop7 is NaN, setting as MeanErrorTop7 instead (" << nan_stdev_count << " PSMs)." << endl;
+      }
+      if (missing_ions_count > 0)
+      {
+        OPENMS_LOG_WARN << "MS-GF+ PSMs with missing NumMatchedMainIons skipped: " << missing_ions_count << endl;
       }
     }
     
@@ -118,28 +197,35 @@ namespace OpenMS
       feature_set.push_back("XTANDEM:hyperscore");
       feature_set.push_back("XTANDEM:deltascore");
       
-      for (vector<PeptideIdentification>::iterator it = peptide_ids.begin(); it != peptide_ids.end(); ++it)
+      // meta value indices, so the hits are accessed without name lookups in the (parallel) loop
+      const UInt nextscore_idx = metaIndex("nextscore");
+      const UInt hyperscore_idx = metaIndex("XTANDEM:hyperscore");
+      const UInt deltascore_idx = metaIndex("XTANDEM:deltascore");
+      vector<pair<UInt, UInt> > ion_idx; // ions, fraction of ions
+      for (const String& ion : ion_types_found)
       {
-        double hyper_score = it->getHits().front().getScore();
-        double delta_score = hyper_score - it->getHits().front().getMetaValue("nextscore").toString().toDouble();
-        it->getHits().front().setMetaValue("XTANDEM:hyperscore", hyper_score);
-        it->getHits().front().setMetaValue("XTANDEM:deltascore", delta_score);
+        ion_idx.emplace_back(metaIndex(ion + "_ions"), metaIndex("XTANDEM:frac_ion_" + ion));
+      }
+
+      parallelFor(peptide_ids.size(), [&](SignedSize i)
+      {
+        PeptideHit& hit = peptide_ids[i].getHits().front();
+        double hyper_score = hit.getScore();
+        double delta_score = hyper_score - hit.getMetaValue(nextscore_idx).toString().toDouble();
+        hit.setMetaValue(hyperscore_idx, hyper_score);
+        hit.setMetaValue(deltascore_idx, delta_score);
         
-        String sequence = it->getHits().front().getSequence().toUnmodifiedString();
+        String sequence = hit.getSequence().toUnmodifiedString();
         int length = sequence.length();
 
-        // Find out correct ion types and get its Values
-        for (StringList::const_iterator ion = ion_types_found.begin(); ion != ion_types_found.end(); ++ion)
+        // Get the values of the ion types found (in the first hit)
+        for (const pair<UInt, UInt>& idx : ion_idx)
         {
-          if (!peptide_ids.front().getHits().front().getMetaValue(*ion + "_score").toString().empty() &&
-              !peptide_ids.front().getHits().front().getMetaValue(*ion + "_ions").toString().empty())
-          {
-            // recalculate ion score
-            double ion_score = it->getHits().front().getMetaValue(*ion + "_ions").toString().toDouble() / length;
-            it->getHits().front().setMetaValue("XTANDEM:frac_ion_" + *ion, ion_score);
-          }
+          // recalculate ion score
+          double ion_score = hit.getMetaValue(idx.first).toString().toDouble() / length;
+          hit.setMetaValue(idx.second, ion_score);
         }
-      }
+      });
     }
 
     void PercolatorFeatureSetHelper::addMSFRAGGERFeatures(StringList& feature_set)
@@ -163,68 +249,84 @@ namespace OpenMS
       feature_set.push_back("COMET:lnRankSP"); // log(rank based on Sp score)
       feature_set.push_back("COMET:IonFrac"); // matched_ions / total_ions
       
-      for (vector<PeptideIdentification>::iterator it = peptide_ids.begin(); it != peptide_ids.end(); ++it)
+      // meta value indices, so the hits are accessed without name lookups in the (parallel) loop
+      const UInt xcorr_idx = metaIndex("MS:1002252");
+      const UInt sp_idx = metaIndex("MS:1002255");
+      const UInt rank_sp_idx = metaIndex("MS:1002256");
+      const UInt expect_idx = metaIndex("MS:1002257");
+      const UInt matched_ions_idx = metaIndex("MS:1002258");
+      const UInt total_ions_idx = metaIndex("MS:1002259");
+      const UInt num_matched_peptides_idx = metaIndex("num_matched_peptides");
+      const UInt delta_cn_idx = metaIndex("COMET:deltaCn");
+      const UInt delta_lcn_idx = metaIndex("COMET:deltaLCn");
+      const UInt ln_expect_idx = metaIndex("COMET:lnExpect");
+      const UInt ln_num_sp_idx = metaIndex("COMET:lnNumSP");
+      const UInt ln_rank_sp_idx = metaIndex("COMET:lnRankSP");
+      const UInt ion_frac_idx = metaIndex("COMET:IonFrac");
+
+      parallelFor(peptide_ids.size(), [&](SignedSize i)
       {
+        vector<PeptideHit>& hits = peptide_ids[i].getHits();
         double worst_xcorr = 0, second_xcorr = 0;
         Int cnt = 0;
-        for (vector<PeptideHit>::iterator hit = it->getHits().begin(); hit != it->getHits().end(); ++hit)
+        for (const PeptideHit& hit : hits)
         {
-          double xcorr = hit->getMetaValue("MS:1002252").toString().toDouble();
+          double xcorr = hit.getMetaValue(xcorr_idx).toString().toDouble();
           worst_xcorr = xcorr;
           if (cnt == 1) { second_xcorr = xcorr; }
           ++cnt;
         }
         
-        for (vector<PeptideHit>::iterator hit = it->getHits().begin(); hit != it->getHits().end(); ++hit)
+        for (PeptideHit& hit : hits)
         {
 
-          double xcorr = hit->getMetaValue("MS:1002252").toString().toDouble();
+          double xcorr = hit.getMetaValue(xcorr_idx).toString().toDouble();
 
-          if (!hit->metaValueExists("COMET:deltaCn"))
+          if (!hit.metaValueExists(delta_cn_idx))
           {
             double delta_cn = (xcorr - second_xcorr) / max(1.0, xcorr);
-            hit->setMetaValue("COMET:deltaCn", delta_cn);
+            hit.setMetaValue(delta_cn_idx, delta_cn);
           }
 
-          if (!hit->metaValueExists("COMET:deltaLCn"))
+          if (!hit.metaValueExists(delta_lcn_idx))
           {
             double delta_last_cn = (xcorr - worst_xcorr) / max(1.0, xcorr);
-            hit->setMetaValue("COMET:deltaLCn", delta_last_cn);
+            hit.setMetaValue(delta_lcn_idx, delta_last_cn);
           }
           
-          double ln_expect = log(hit->getMetaValue("MS:1002257").toString().toDouble());
-          hit->setMetaValue("COMET:lnExpect", ln_expect);
+          double ln_expect = log(hit.getMetaValue(expect_idx).toString().toDouble());
+          hit.setMetaValue(ln_expect_idx, ln_expect);
 
-          if (!hit->metaValueExists("COMET:lnNumSP"))
+          if (!hit.metaValueExists(ln_num_sp_idx))
           {
             double ln_num_sp;   
-            if (hit->metaValueExists("num_matched_peptides"))
+            if (hit.metaValueExists(num_matched_peptides_idx))
             {
-              double num_sp = hit->getMetaValue("num_matched_peptides").toString().toDouble();
+              double num_sp = hit.getMetaValue(num_matched_peptides_idx).toString().toDouble();
               ln_num_sp = log(max(1.0, num_sp));  // if recorded, one can be safely assumed
             }
             else // fallback TODO: remove?
             {
-              ln_num_sp = hit->getMetaValue("MS:1002255").toString().toDouble();
+              ln_num_sp = hit.getMetaValue(sp_idx).toString().toDouble();
             }  
-            hit->setMetaValue("COMET:lnNumSP", ln_num_sp);
+            hit.setMetaValue(ln_num_sp_idx, ln_num_sp);
           }
 
-          if (!hit->metaValueExists("COMET:lnRankSP"))
+          if (!hit.metaValueExists(ln_rank_sp_idx))
           {          
-            double ln_rank_sp = log(max(1.0, hit->getMetaValue("MS:1002256").toString().toDouble()));
-            hit->setMetaValue("COMET:lnRankSP", ln_rank_sp);
+            double ln_rank_sp = log(max(1.0, hit.getMetaValue(rank_sp_idx).toString().toDouble()));
+            hit.setMetaValue(ln_rank_sp_idx, ln_rank_sp);
           }
 
-          if (!hit->metaValueExists("COMET:IonFrac"))
+          if (!hit.metaValueExists(ion_frac_idx))
           {
-            double num_matched_ions = hit->getMetaValue("MS:1002258").toString().toDouble();
-            double num_total_ions = hit->getMetaValue("MS:1002259").toString().toDouble();
+            double num_matched_ions = hit.getMetaValue(matched_ions_idx).toString().toDouble();
+            double num_total_ions = hit.getMetaValue(total_ions_idx).toString().toDouble();
             double ion_frac = num_matched_ions / num_total_ions;
-            hit->setMetaValue("COMET:IonFrac", ion_frac);
+            hit.setMetaValue(ion_frac_idx, ion_frac);
           }
         }
-      }
+      });
     }
 
     /**
@@ -260,8 +362,9 @@ namespace OpenMS
       feature_set.push_back("MASCOT:delta_score"); // delta score based on mScore
       feature_set.push_back("MASCOT:hasMod"); // bool: has post translational modification
       
-      for (vector<PeptideIdentification>::iterator it = peptide_ids.begin(); it != peptide_ids.end(); ++it)
+      parallelFor(peptide_ids.size(), [&](SignedSize i)
       {
+        vector<PeptideIdentification>::iterator it = peptide_ids.begin() + i;
         it->sort();
         it->assignRanks();
         std::vector<PeptideHit> hits = it->getHits();
@@ -272,7 +375,7 @@ namespace OpenMS
           bool has_mod = hit->getSequence().isModified();
           hit->setMetaValue("MASCOT:hasMod", has_mod);
         }
-      }
+      });
     }
 
     void PercolatorFeatureSetHelper::addCONCATSEFeatures(vector<PeptideIdentification>& peptide_ids, StringList& search_engines_used, StringList& feature_set)
@@ -285,12 +388,13 @@ namespace OpenMS
       feature_set.push_back("CONCAT:deltaLnEvalue");
       
       // feature values have been set in concatMULTISEids
-      for (vector<PeptideIdentification>::iterator it = peptide_ids.begin(); it != peptide_ids.end(); ++it)
+      parallelFor(peptide_ids.size(), [&](SignedSize i)
       {
+        vector<PeptideIdentification>::iterator it = peptide_ids.begin() + i;
         it->sort();
         it->assignRanks();
         assignDeltaScore_(it->getHits(), "CONCAT:lnEvalue", "CONCAT:deltaLnEvalue");
-      }
+      });
     }
 
     void PercolatorFeatureSetHelper::mergeMULTISEPeptideIds(vector<PeptideIdentification>& all_peptide_ids, vector<PeptideIdentification>& new_peptide_ids, const String& search_engine)
@@ -0,0 +1,258 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/ANALYSIS/ID/ProteinSuffixIndex.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string_view>
+#include <tuple>
+
+namespace OpenMS
+{
+  namespace
+  {
+    const char INDEX_MAGIC[8] = {'O', 'M', 'S', 'P', 'S', 'I', 'X', '1'};
+    const char PROTEIN_SEPARATOR = '$';
+
+    template<typename T>
+    void writeValue(std::ofstream& os, const T& value)
+    {
+      os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    void writeVector(std::ofstream& os, const std::vector<T>& values)
+    {
+      writeValue(os, uint64_t(values.size()));
+      os.write(reinterpret_cast<const char*>(values.data()), std::streamsize(values.size() * sizeof(T)));
+    }
+
+    void writeString(std::ofstream& os, const std::string& s)
+    {
+      writeValue(os, uint64_t(s.size()));
+      os.write(s.data(), std::streamsize(s.size()));
+    }
+
+    template<typename T>
+    void readValue(std::ifstream& is, T& value)
+    {
+      is.read(reinterpret_cast<char*>(&value), sizeof(T));
+    }
+
+    /// reads the size of a container and checks it against the remaining file size (to fail early on corrupt files)
+    uint64_t readSize(std::ifstream& is, uint64_t element_size, uint64_t file_size, const String& filename)
+    {
+      uint64_t n = 0;
+      readValue(is, n);
+      if (!is || n > (file_size - uint64_t(is.tellg())) / element_size)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Truncated or corrupt protein index file.");
+      }
+      return n;
+    }
+
+    template<typename T>
+    void readVector(std::ifstream& is, std::vector<T>& values, uint64_t file_size, const String& filename)
+    {
+      values.resize(readSize(is, sizeof(T), file_size, filename));
+      is.read(reinterpret_cast<char*>(values.data()), std::streamsize(values.size() * sizeof(T)));
+    }
+
+    void readString(std::ifstream& is, std::string& s, uint64_t file_size, const String& filename)
+    {
+      s.resize(readSize(is, 1, file_size, filename));
+      is.read(&s[0], std::streamsize(s.size()));
+    }
+  }
+
+  void ProteinSuffixIndex::build(const std::vector<FASTAFile::FASTAEntry>& proteins, bool IL_equivalent)
+  {
+    IL_equivalent_ = IL_equivalent;
+    text_.clear();
+    protein_starts_.clear();
+    accessions_.clear();
+    suffix_array_.clear();
+
+    Size total_size = 0;
+    for (const auto& p : proteins)
+    {
+      total_size += p.sequence.size() + 1;
+    }
+    if (total_size >= std::numeric_limits<uint32_t>::max())
+    {
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Protein database is too large for the suffix index (at most 2^32 - 1 residues).", String(total_size));
+    }
+    text_.reserve(total_size);
+    protein_starts_.reserve(proteins.size());
+    accessions_.reserve(proteins.size());
+    for (const auto& p : proteins)
+    {
+      protein_starts_.push_back(uint32_t(text_.size()));
+      accessions_.push_back(p.identifier);
+      text_ += normalize_(p.sequence);
+      text_ += PROTEIN_SEPARATOR;
+    }
+
+    // suffix array by prefix doubling: after the round for 'k', suffixes are sorted by their first 2k characters
+    const uint32_t n = uint32_t(text_.size());
+    suffix_array_.resize(n);
+    std::vector<uint32_t> rank(n), new_rank(n);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+      suffix_array_[i] = i;
+      rank[i] = uint8_t(text_[i]);
+    }
+    for (uint32_t k = 1; n > 0; k *= 2)
+    {
+      // second key: rank of the suffix k characters later (shorter suffixes come first)
+      auto key = [&rank, n, k](uint32_t i) { return (uint64_t(rank[i]) << 32) | (i + k < n ? uint64_t(rank[i + k]) + 1 : 0); };
+      std::sort(suffix_array_.begin(), suffix_array_.end(), [&key](uint32_t a, uint32_t b) { return key(a) < key(b); });
+      new_rank[suffix_array_[0]] = 0;
+      for (uint32_t i = 1; i < n; ++i)
+      {
+        new_rank[suffix_array_[i]] = new_rank[suffix_array_[i - 1]] + (key(suffix_array_[i - 1]) < key(suffix_array_[i]) ? 1 : 0);
+      }
+      rank.swap(new_rank);
+      if (rank[suffix_array_[n - 1]] == n - 1 || k >= n)
+      { // all ranks are unique
+        break;
+      }
+    }
+  }
+
+  void ProteinSuffixIndex::store(const String& filename) const
+  {
+    std::ofstream os(filename.c_str(), std::ios::binary | std::ios::trunc);
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    os.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    writeValue(os, uint8_t(IL_equivalent_));
+    writeString(os, text_);
+    writeVector(os, suffix_array_);
+    writeVector(os, protein_starts_);
+    writeValue(os, uint64_t(accessions_.size()));
+    for (const auto& acc : accessions_)
+    {
+      writeString(os, acc);
+    }
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+  }
+
+  void ProteinSuffixIndex::load(const String& filename)
+  {
+    if (!File::exists(filename))
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    std::ifstream is(filename.c_str(), std::ios::binary | std::ios::ate);
+    const uint64_t file_size = uint64_t(is.tellg());
+    is.seekg(0);
+
+    char magic[sizeof(INDEX_MAGIC)];
+    is.read(magic, sizeof(magic));
+    if (!is || std::memcmp(magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Not a protein index file.");
+    }
+    uint8_t IL_equivalent = 0;
+    readValue(is, IL_equivalent);
+    IL_equivalent_ = IL_equivalent != 0;
+    readString(is, text_, file_size, filename);
+    readVector(is, suffix_array_, file_size, filename);
+    readVector(is, protein_starts_, file_size, filename);
+    accessions_.resize(readSize(is, sizeof(uint64_t), file_size, filename));
+    for (auto& acc : accessions_)
+    {
+      readString(is, acc, file_size, filename);
+    }
+    if (!is || suffix_array_.size() != text_.size() || protein_starts_.size() != accessions_.size())
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Truncated or corrupt protein index file.");
+    }
+  }
+
+  std::vector<ProteinSuffixIndex::Occurrence> ProteinSuffixIndex::findPeptide(const String& peptide) const
+  {
+    std::vector<Occurrence> result;
+    const auto range = findRange_(normalize_(peptide));
+    result.reserve(range.second - range.first);
+    for (Size i = range.first; i < range.second; ++i)
+    {
+      const uint32_t pos = suffix_array_[i];
+      const Size protein = std::upper_bound(protein_starts_.begin(), protein_starts_.end(), pos) - protein_starts_.begin() - 1;
+      result.push_back({uint32_t(protein), pos - protein_starts_[protein]});
+    }
+    std::sort(result.begin(), result.end(), [](const Occurrence& a, const Occurrence& b) {
+      return std::tie(a.protein_index, a.position) < std::tie(b.protein_index, b.position);
+    });
+    return result;
+  }
+
+  Size ProteinSuffixIndex::countOccurrences(const String& peptide) const
+  {
+    const auto range = findRange_(normalize_(peptide));
+    return range.second - range.first;
+  }
+
+  Size ProteinSuffixIndex::getNumberOfProteins() const
+  {
+    return accessions_.size();
+  }
+
+  const String& ProteinSuffixIndex::getAccession(Size index) const
+  {
+    return accessions_.at(index);
+  }
+
+  bool ProteinSuffixIndex::isILEquivalent() const
+  {
+    return IL_equivalent_;
+  }
+
+  std::string ProteinSuffixIndex::normalize_(const String& sequence) const
+  {
+    std::string result(sequence);
+    for (char& c : result)
+    {
+      c = char(toupper(c));
+      if (IL_equivalent_ && c == 'I')
+      {
+        c = 'L';
+      }
+    }
+    return result;
+  }
+
+  std::pair<Size, Size> ProteinSuffixIndex::findRange_(const std::string& peptide) const
+  {
+    if (peptide.empty() || peptide.find(PROTEIN_SEPARATOR) != std::string::npos)
+    {
+      return {0, 0};
+    }
+    const std::string_view text(text_);
+    const std::string_view pep(peptide);
+    // compare only the first |peptide| characters of a suffix, so all suffixes starting with the peptide are 'equal'
+    auto first = std::lower_bound(suffix_array_.begin(), suffix_array_.end(), pep,
+                                  [&text](uint32_t pos, std::string_view p) { return text.substr(pos, p.size()) < p; });
+    auto last = std::upper_bound(first, suffix_array_.end(), pep,
+                                 [&text](std::string_view p, uint32_t pos) { return p < text.substr(pos, p.size()); });
+    return {Size(first - suffix_array_.begin()), Size(last - suffix_array_.begin())};
+  }
+}
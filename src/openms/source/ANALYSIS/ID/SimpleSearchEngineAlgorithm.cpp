@@ -17,6 +17,7 @@
 #include <OpenMS/CHEMISTRY/TheoreticalSpectrumGenerator.h>
 #include <OpenMS/COMPARISON/SpectrumAlignment.h>
 #include <OpenMS/CONCEPT/Constants.h>
+#include <OpenMS/CONCEPT/PerfCounters.h>
 #include <OpenMS/CONCEPT/VersionInfo.h>
 #include <OpenMS/DATASTRUCTURES/Param.h>
 #include <OpenMS/DATASTRUCTURES/StringView.h>
@@ -37,7 +38,9 @@
 #include <OpenMS/METADATA/SpectrumSettings.h>
 
 #include <algorithm>
+#include <limits>
 #include <map>
+#include <numeric>
 #ifdef _OPENMP
   #include <omp.h>
 #endif
@@ -78,6 +81,9 @@ namespace OpenMS
     defaults_.setValue("fragment:mass_tolerance_unit", "ppm", "Unit of fragment m");
     defaults_.setValidStrings("fragment:mass_tolerance_unit", fragment_mass_tolerance_unit_valid_strings);
 
+    defaults_.setValue("fragment:index", "false", "Score spectra by looking up their peaks in an index of the fragments of all candidate peptides instead of matching each candidate against all spectra in its precursor window. Faster for wide precursor mass tolerances (open searches), needs memory for the fragments of all candidates.");
+    defaults_.setValidStrings("fragment:index", {"true","false"} );
+
     defaults_.setSectionDescription("fragment", "Fragments (Product Ion) Options");
 
     vector<String> all_mods;
@@ -137,6 +143,8 @@ namespace OpenMS
 
     fragment_mass_tolerance_unit_ = param_.getValue("fragment:mass_tolerance_unit").toString();
 
+    fragment_index_ = param_.getValue("fragment:index") == "true";
+
     modifications_fixed_ = ListUtils::toStringList<std::string>(param_.getValue("modifications:fixed"));
     set<String> fixed_unique(modifications_fixed_.begin(), modifications_fixed_.end());
     if (fixed_unique.size() != modifications_fixed_.size())
@@ -260,6 +268,8 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
       annotation_suffix_fraction = true;
     }
 
+    // one slot per scan, collected in scan order below (same output in the idXML-file for any number of threads)
+    vector<PeptideIdentification> scan_peptide_ids(annotated_hits.size());
 #pragma omp parallel for
     for (SignedSize scan_index = 0; scan_index < (SignedSize)annotated_hits.size(); ++scan_index)
     {
@@ -288,12 +298,19 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
           AASequence aas = AASequence::fromString(ah.sequence.getString());
 
           // reapply modifications (because for memory reasons we only stored the index and recreation is fast)
-          vector<AASequence> all_modified_peptides;
           ModifiedPeptideGenerator::applyFixedModifications(fixed_modifications, aas);
-          ModifiedPeptideGenerator::applyVariableModifications(variable_modifications, aas, max_variable_mods_per_peptide, all_modified_peptides);
+          vector<ModifiedPeptideGenerator::ModificationSite> sites;
+          ModifiedPeptideGenerator::getVariableModificationSites(variable_modifications, aas, sites);
+          SignedSize mod_pep_idx(0);
+          vector<Size> hit_sites;
+          ModifiedPeptideGenerator::enumerateVariableModifications(sites, 0.0, max_variable_mods_per_peptide,
+            [&](double, const vector<Size>& chosen_sites)
+            {
+              if (mod_pep_idx++ == ah.peptide_mod_index) { hit_sites = chosen_sites; }
+            });
 
           // reannotate much more memory heavy AASequence object
-          AASequence fixed_and_variable_modified_peptide = all_modified_peptides[ah.peptide_mod_index]; 
+          AASequence fixed_and_variable_modified_peptide = ModifiedPeptideGenerator::applyVariableModificationSites(variable_modifications, aas, sites, hit_sites);
           ph.setScore(ah.score);
           ph.setSequence(fixed_and_variable_modified_peptide);
 
@@ -340,24 +357,17 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
         pi.setHits(phs);
         pi.assignRanks();
 
-#pragma omp critical (peptide_ids_access)
-        {
-          //clang-tidy: seems to be a false-positive in combination with omp
-          peptide_ids.push_back(std::move(pi));
-        }
+        scan_peptide_ids[scan_index] = std::move(pi);
       }
     }
 
-#ifdef _OPENMP
-    // we need to sort the peptide_ids by scan_index in order to have the same output in the idXML-file
-    if (omp_get_max_threads() > 1)
+    for (SignedSize scan_index = 0; scan_index < (SignedSize)annotated_hits.size(); ++scan_index)
     {
-      std::sort(peptide_ids.begin(), peptide_ids.end(), [](const PeptideIdentification& a, const PeptideIdentification& b)
+      if (!annotated_hits[scan_index].empty())
       {
-        return a.getMetaValue("scan_index") < b.getMetaValue("scan_index");
-      });
+        peptide_ids.push_back(std::move(scan_peptide_ids[scan_index]));
+      }
     }
-#endif
 
     // protein identifications (leave as is...)
     protein_ids = vector<ProteinIdentification>(1);
@@ -397,6 +407,190 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
     protein_ids[0].setSearchParameters(std::move(search_parameters));
   }
 
+  void SimpleSearchEngineAlgorithm::scoreFragmentIndex_(const PeakMap& spectra,
+    const vector<vector<double> >& precursor_masses,
+    vector<IndexedCandidate_>& candidates,
+    vector<vector<AnnotatedHit_> >& annotated_hits,
+    bool precursor_mass_tolerance_unit_ppm,
+    bool fragment_mass_tolerance_unit_ppm) const
+  {
+    if (candidates.empty())
+    {
+      return;
+    }
+    if (candidates.size() > std::numeric_limits<UInt32>::max())
+    {
+      throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, candidates.size());
+    }
+
+    // candidates sorted by mass: the candidates of a precursor window are a consecutive range
+    std::sort(candidates.begin(), candidates.end(), IndexedCandidate_::hasSmallerMass);
+    vector<double> candidate_masses;
+    candidate_masses.reserve(candidates.size());
+    double max_mz = 0;
+    for (const auto& ic : candidates)
+    {
+      candidate_masses.push_back(ic.mass);
+      for (double mz : ic.fragment_mz) { max_mz = std::max(max_mz, mz); }
+    }
+
+    // bin all fragments by m/z, within a bin the fragments are sorted by candidate (counting sort)
+    const double bin_width = fragment_mass_tolerance_unit_ppm ?
+      std::max(Math::ppmToMass(fragment_mass_tolerance_, 1000.0), 0.01) : std::max(fragment_mass_tolerance_, 0.01);
+    const Size nr_bins = static_cast<Size>(max_mz / bin_width) + 1;
+    vector<Size> bin_start(nr_bins + 1, 0);
+    for (const auto& ic : candidates)
+    {
+      for (double mz : ic.fragment_mz) { ++bin_start[static_cast<Size>(mz / bin_width) + 1]; }
+    }
+    std::partial_sum(bin_start.begin(), bin_start.end(), bin_start.begin());
+
+    vector<IndexedFragment_> fragments(bin_start.back());
+    vector<Size> bin_cursor(bin_start.begin(), bin_start.end() - 1);
+    for (Size i = 0; i < candidates.size(); ++i)
+    {
+      IndexedCandidate_& ic = candidates[i];
+      for (Size k = 0; k < ic.fragment_mz.size(); ++k)
+      {
+        const double mz = ic.fragment_mz[k];
+        fragments[bin_cursor[static_cast<Size>(mz / bin_width)]++] = IndexedFragment_{mz, static_cast<UInt32>(i), k < ic.nr_prefix_ions};
+      }
+      vector<double>().swap(ic.fragment_mz); // stored in the index now
+    }
+
+    // a fragment matching a peak of the spectrum
+    struct FragmentMatch
+    {
+      Size fragment;
+      double distance;
+      double intensity;
+      double error; ///< absolute error in ppm or Da
+    };
+
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize scan_index = 0; scan_index < (SignedSize)spectra.size(); ++scan_index)
+    {
+      // candidate ranges of all precursor windows of the spectrum (merged, so each candidate is scored once)
+      vector<pair<UInt32, UInt32> > ranges;
+      for (double precursor_mass : precursor_masses[scan_index])
+      {
+        // same window as in search(): ppm tolerances are relative to the candidate mass
+        double min_mass = precursor_mass - precursor_mass_tolerance_;
+        double max_mass = precursor_mass + precursor_mass_tolerance_;
+        if (precursor_mass_tolerance_unit_ppm)
+        {
+          min_mass = precursor_mass / (1.0 + precursor_mass_tolerance_ * 1e-6);
+          max_mass = precursor_mass / (1.0 - precursor_mass_tolerance_ * 1e-6);
+        }
+        const auto lo = std::lower_bound(candidate_masses.begin(), candidate_masses.end(), min_mass);
+        const auto up = std::upper_bound(lo, candidate_masses.end(), max_mass);
+        if (lo != up)
+        {
+          ranges.emplace_back(UInt32(lo - candidate_masses.begin()), UInt32(up - candidate_masses.begin()));
+        }
+      }
+      if (ranges.empty())
+      {
+        continue;
+      }
+      std::sort(ranges.begin(), ranges.end());
+      Size nr_ranges = 0;
+      for (const auto& r : ranges)
+      {
+        if (nr_ranges > 0 && r.first <= ranges[nr_ranges - 1].second)
+        {
+          ranges[nr_ranges - 1].second = std::max(ranges[nr_ranges - 1].second, r.second);
+        }
+        else
+        {
+          ranges[nr_ranges++] = r;
+        }
+      }
+      ranges.resize(nr_ranges);
+
+      // look up all peaks in the index (as in HyperScore, tolerances in ppm are relative to the theoretical m/z)
+      vector<FragmentMatch> matches;
+      for (const Peak1D& peak : spectra[scan_index])
+      {
+        const double mz = peak.getMZ();
+        const double max_distance = fragment_mass_tolerance_unit_ppm ?
+          Math::ppmToMass(fragment_mass_tolerance_, mz) / (1.0 - fragment_mass_tolerance_ * 1e-6) : fragment_mass_tolerance_;
+        const Size first_bin = static_cast<Size>(std::max(mz - max_distance, 0.0) / bin_width);
+        const Size last_bin = std::min(nr_bins - 1, static_cast<Size>((mz + max_distance) / bin_width));
+        for (Size bin = first_bin; bin <= last_bin; ++bin)
+        {
+          const auto bin_begin = fragments.begin() + bin_start[bin];
+          const auto bin_end = fragments.begin() + bin_start[bin + 1];
+          for (const auto& r : ranges)
+          {
+            auto f = std::lower_bound(bin_begin, bin_end, r.first,
+              [](const IndexedFragment_& fragment, UInt32 candidate) { return fragment.candidate < candidate; });
+            for (; f != bin_end && f->candidate < r.second; ++f)
+            {
+              const double distance = fabs(f->mz - mz);
+              const double allowed = fragment_mass_tolerance_unit_ppm ? Math::ppmToMass(fragment_mass_tolerance_, f->mz) : fragment_mass_tolerance_;
+              if (distance <= allowed)
+              {
+                const double error = fragment_mass_tolerance_unit_ppm ? Math::getPPMAbs(f->mz, mz) : distance;
+                matches.push_back(FragmentMatch{Size(f - fragments.begin()), distance, peak.getIntensity(), error});
+              }
+            }
+          }
+        }
+      }
+      if (matches.empty())
+      {
+        continue;
+      }
+
+      // each fragment is matched to its closest peak (the peak with smaller m/z on ties)
+      std::stable_sort(matches.begin(), matches.end(), [](const FragmentMatch& a, const FragmentMatch& b)
+      {
+        return a.fragment != b.fragment ? a.fragment < b.fragment : a.distance < b.distance;
+      });
+      matches.erase(std::unique(matches.begin(), matches.end(), [](const FragmentMatch& a, const FragmentMatch& b)
+      {
+        return a.fragment == b.fragment;
+      }), matches.end());
+      std::stable_sort(matches.begin(), matches.end(), [&fragments](const FragmentMatch& a, const FragmentMatch& b)
+      {
+        return fragments[a.fragment].candidate < fragments[b.fragment].candidate;
+      });
+
+      vector<AnnotatedHit_>& hits = annotated_hits[scan_index];
+      for (auto m = matches.begin(); m != matches.end(); )
+      {
+        const UInt32 candidate = fragments[m->fragment].candidate;
+        size_t matched_b_ions = 0, matched_y_ions = 0;
+        double dot_product = 0.0, abs_error = 0.0;
+        for (; m != matches.end() && fragments[m->fragment].candidate == candidate; ++m)
+        {
+          dot_product += m->intensity; // theoretical intensities are 1
+          abs_error += m->error;
+          if (fragments[m->fragment].is_prefix) ++matched_b_ions; else ++matched_y_ions;
+        }
+
+        const IndexedCandidate_& ic = candidates[candidate];
+        AnnotatedHit_ ah;
+        ah.sequence = ic.sequence;
+        ah.peptide_mod_index = ic.peptide_mod_index;
+        ah.score = HyperScore::computeFromMatches(matched_b_ions, matched_y_ions, dot_product);
+        PerfCounters::add(PerfCounters::CANDIDATES_SCORED);
+        ah.prefix_fraction = (double)matched_b_ions/(double)ic.sequence.size();
+        ah.suffix_fraction = (double)matched_y_ions/(double)ic.sequence.size();
+        ah.mean_error = abs_error / (double)(matched_b_ions + matched_y_ions);
+        hits.push_back(ah);
+
+        // prevent vector from growing indefinitely (memory) but don't shrink the vector every time
+        if (hits.size() >= 2 * report_top_hits_)
+        {
+          std::partial_sort(hits.begin(), hits.begin() + report_top_hits_, hits.end(), AnnotatedHit_::hasBetterScore);
+          hits.resize(report_top_hits_);
+        }
+      }
+    }
+  }
+
   SimpleSearchEngineAlgorithm::ExitCodes SimpleSearchEngineAlgorithm::search(const String& in_mzML, const String& in_db, vector<ProteinIdentification>& protein_ids, vector<PeptideIdentification>& peptide_ids) const
   {
     boost::regex peptide_motif_regex(peptide_motif_);
@@ -423,8 +617,8 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
     preprocessSpectra_(spectra, fragment_mass_tolerance_, fragment_mass_tolerance_unit_ppm);
     endProgress();
 
-    // build multimap of precursor mass to scan index
-    multimap<double, Size> multimap_mass_2_scan_index;
+    // collect precursor masses and their scan index
+    vector<pair<double, Size> > mass_2_scan_index;
     for (PeakMap::ConstIterator s_it = spectra.begin(); s_it != spectra.end(); ++s_it)
     {
       int scan_index = s_it - spectra.begin();
@@ -451,11 +645,26 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
           // correct for monoisotopic misassignments of the precursor annotation
           if (isotope_number != 0) { precursor_mass -= isotope_number * Constants::C13C12_MASSDIFF_U; }
 
-          multimap_mass_2_scan_index.insert(make_pair(precursor_mass, scan_index));
+          mass_2_scan_index.emplace_back(precursor_mass, scan_index);
         }
       }
     }
 
+    // flat index of precursor masses (sorted) and scan indices, so candidate masses are looked up by
+    // a binary search over contiguous memory (stable sort keeps the scan order for equal masses)
+    std::stable_sort(mass_2_scan_index.begin(), mass_2_scan_index.end(),
+      [](const pair<double, Size>& a, const pair<double, Size>& b) { return a.first < b.first; });
+    vector<double> sorted_precursor_masses;
+    vector<Size> sorted_scan_indices;
+    sorted_precursor_masses.reserve(mass_2_scan_index.size());
+    sorted_scan_indices.reserve(mass_2_scan_index.size());
+    for (const auto& mass_scan : mass_2_scan_index)
+    {
+      sorted_precursor_masses.push_back(mass_scan.first);
+      sorted_scan_indices.push_back(mass_scan.second);
+    }
+    vector<pair<double, Size> >().swap(mass_2_scan_index);
+
     // create spectrum generator
     TheoreticalSpectrumGenerator spectrum_generator;
     Param param(spectrum_generator.getParameters());
@@ -463,6 +672,20 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
     param.setValue("add_metainfo", "true");
     spectrum_generator.setParameters(param);
 
+    // unannotated b- and y-ions (in this order) for the fragment index
+    TheoreticalSpectrumGenerator index_generator;
+    param = index_generator.getParameters();
+    param.setValue("add_first_prefix_ion", "true");
+    param.setValue("add_metainfo", "false");
+    param.setValue("sort_by_position", "false");
+    index_generator.setParameters(param);
+
+#ifdef _OPENMP
+    vector<vector<IndexedCandidate_> > thread_candidates(omp_get_max_threads());
+#else
+    vector<vector<IndexedCandidate_> > thread_candidates(1);
+#endif
+
     // preallocate storage for PSMs
     vector<vector<AnnotatedHit_> > annotated_hits(spectra.size(), vector<AnnotatedHit_>());
     for (auto & a : annotated_hits) { a.reserve(2 * report_top_hits_); }
@@ -506,12 +729,22 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
     digestor.setMissedCleavages(peptide_missed_cleavages_);
     startProgress(0, fasta_db.size(), "Scoring peptide models against spectra...");
 
-    // lookup for processed peptides. must be defined outside of omp section and synchronized
-    set<StringView> processed_petides;
+    // lookup for processed peptides. must be defined outside of omp section and synchronized.
+    // It is split into shards (selected by the hash of the sequence) with a lock each, so
+    // threads only wait for each other if they look up peptides of the same shard.
+    const size_t nr_peptide_shards = 64;
+    vector<set<StringView> > processed_peptides(nr_peptide_shards);
+#ifdef _OPENMP
+    vector<omp_lock_t> processed_peptides_lock(nr_peptide_shards);
+    for (size_t i = 0; i != processed_peptides_lock.size(); i++)
+    {
+      omp_init_lock(&(processed_peptides_lock[i]));
+    }
+#endif
 
     Size count_proteins(0), count_peptides(0);
 
-#pragma omp parallel for schedule(static) default(none) shared(annotated_hits, spectrum_generator, multimap_mass_2_scan_index, fixed_modifications, variable_modifications, fasta_db, digestor, processed_petides, count_proteins, count_peptides, precursor_mass_tolerance_unit_ppm, fragment_mass_tolerance_unit_ppm, peptide_motif_regex, spectra, annotated_hits_lock)
+#pragma omp parallel for schedule(static) default(none) shared(annotated_hits, spectrum_generator, index_generator, thread_candidates, sorted_precursor_masses, sorted_scan_indices, fixed_modifications, variable_modifications, fasta_db, digestor, processed_peptides, processed_peptides_lock, count_proteins, count_peptides, precursor_mass_tolerance_unit_ppm, fragment_mass_tolerance_unit_ppm, peptide_motif_regex, spectra, annotated_hits_lock)
       for (SignedSize fasta_index = 0; fasta_index < (SignedSize)fasta_db.size(); ++fasta_index)
       {
 
@@ -540,19 +773,17 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
           continue;
         }          
       
-        bool already_processed = false;
-        #pragma omp critical (processed_peptides_access)
-        {
-          // peptide (and all modified variants) already processed so skip it
-          if (processed_petides.find(c) != processed_petides.end())
-          {
-            already_processed = true;
-          }
-          else
-          {
-            processed_petides.insert(c);
-          }
-        }
+        // peptide (and all modified variants) already processed so skip it
+        const size_t shard = std::hash<std::string>()(current_peptide) % nr_peptide_shards;
+        PerfCounters::LockWait processed_wait;
+#ifdef _OPENMP
+        omp_set_lock(&(processed_peptides_lock[shard]));
+#endif
+        processed_wait.acquired();
+        const bool already_processed = !processed_peptides[shard].insert(c).second;
+#ifdef _OPENMP
+        omp_unset_lock(&(processed_peptides_lock[shard]));
+#endif
 
         // skip peptides that have already been processed
         if (already_processed) { continue; }
@@ -560,40 +791,59 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
         #pragma omp atomic
         ++count_peptides;
 
-        vector<AASequence> all_modified_peptides;
-
-        // this critical section is because ResidueDB is not thread safe and new residues are created based on the PTMs
-        #pragma omp critical (residuedb_access)
-        {
-          AASequence aas = AASequence::fromString(current_peptide);
-          ModifiedPeptideGenerator::applyFixedModifications(fixed_modifications, aas);
-          ModifiedPeptideGenerator::applyVariableModifications(variable_modifications, aas, modifications_max_variable_mods_per_peptide_, all_modified_peptides);
-        }
-
-        for (SignedSize mod_pep_idx = 0; mod_pep_idx < (SignedSize)all_modified_peptides.size(); ++mod_pep_idx)
+        // no synchronization needed: the sequence is unmodified (unmodified residues are looked up
+        // without locking the ResidueDB) and the modified residues were resolved in advance
+        // by ModifiedPeptideGenerator::getModifications()
+        AASequence aas = AASequence::fromString(current_peptide);
+        ModifiedPeptideGenerator::applyFixedModifications(fixed_modifications, aas);
+        vector<ModifiedPeptideGenerator::ModificationSite> sites;
+        ModifiedPeptideGenerator::getVariableModificationSites(variable_modifications, aas, sites);
+
+        // the masses of the variants are updated incrementally, only variants with a matching precursor are created
+        SignedSize mod_pep_idx(-1);
+        ModifiedPeptideGenerator::enumerateVariableModifications(sites, aas.getMonoWeight(), modifications_max_variable_mods_per_peptide_,
+          [&](double current_peptide_mass, const vector<Size>& chosen_sites)
         {
-          const AASequence& candidate = all_modified_peptides[mod_pep_idx];
-          double current_peptide_mass = candidate.getMonoWeight();
+          ++mod_pep_idx;
 
           // determine MS2 precursors that match to the current peptide mass
-          multimap<double, Size>::const_iterator low_it;
-          multimap<double, Size>::const_iterator up_it;
-
+          double min_mass = current_peptide_mass - precursor_mass_tolerance_;
+          double max_mass = current_peptide_mass + precursor_mass_tolerance_;
           if (precursor_mass_tolerance_unit_ppm) // ppm
           {
-            low_it = multimap_mass_2_scan_index.lower_bound(current_peptide_mass - current_peptide_mass * precursor_mass_tolerance_ * 1e-6);
-            up_it = multimap_mass_2_scan_index.upper_bound(current_peptide_mass + current_peptide_mass * precursor_mass_tolerance_ * 1e-6);
-          }
-          else // Dalton
-          {
-            low_it = multimap_mass_2_scan_index.lower_bound(current_peptide_mass - precursor_mass_tolerance_);
-            up_it = multimap_mass_2_scan_index.upper_bound(current_peptide_mass + precursor_mass_tolerance_);
+            min_mass = current_peptide_mass - current_peptide_mass * precursor_mass_tolerance_ * 1e-6;
+            max_mass = current_peptide_mass + current_peptide_mass * precursor_mass_tolerance_ * 1e-6;
           }
+          const auto low_it = std::lower_bound(sorted_precursor_masses.begin(), sorted_precursor_masses.end(), min_mass);
+          const auto up_it = std::upper_bound(low_it, sorted_precursor_masses.end(), max_mass);
 
           // no matching precursor in data
           if (low_it == up_it)
           { 
-            continue;
+            return;
+          }
+
+          const AASequence candidate = ModifiedPeptideGenerator::applyVariableModificationSites(variable_modifications, aas, sites, chosen_sites);
+
+          if (fragment_index_)
+          {
+            // only collect the fragments here, all candidates are scored at once using the fragment index
+            PeakSpectrum theo_spectrum;
+            index_generator.getSpectrum(theo_spectrum, candidate, 1, 1);
+
+            IndexedCandidate_ ic;
+            ic.sequence = c;
+            ic.peptide_mod_index = mod_pep_idx;
+            ic.mass = current_peptide_mass;
+            ic.nr_prefix_ions = theo_spectrum.size() / 2;
+            ic.fragment_mz.reserve(theo_spectrum.size());
+            for (const auto& p : theo_spectrum) { ic.fragment_mz.push_back(p.getMZ()); }
+#ifdef _OPENMP
+            thread_candidates[omp_get_thread_num()].push_back(std::move(ic));
+#else
+            thread_candidates[0].push_back(std::move(ic));
+#endif
+            return;
           }
 
           // create theoretical spectrum
@@ -604,10 +854,11 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
 
           // sort by mz
           theo_spectrum.sortByPosition();
+          PerfCounters::add(PerfCounters::CANDIDATES_SCORED, up_it - low_it);
 
-          for (; low_it != up_it; ++low_it)
+          for (Size k = low_it - sorted_precursor_masses.begin(); k < Size(up_it - sorted_precursor_masses.begin()); ++k)
           {
-            const Size& scan_index = low_it->second;
+            const Size& scan_index = sorted_scan_indices[k];
             const PeakSpectrum& exp_spectrum = spectra[scan_index];
             // const int& charge = exp_spectrum.getPrecursors()[0].getCharge();
             HyperScore::PSMDetail detail;
@@ -626,10 +877,12 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
             ah.suffix_fraction = (double)detail.matched_y_ions/(double)c.size();
             ah.mean_error = detail.mean_error;
 
+            PerfCounters::LockWait hits_wait;
 #ifdef _OPENMP
             omp_set_lock(&(annotated_hits_lock[scan_index]));
             {
 #endif
+              hits_wait.acquired();
               annotated_hits[scan_index].push_back(ah);
 
               // prevent vector from growing indefinitely (memory) but don't shrink the vector every time
@@ -643,14 +896,44 @@ void SimpleSearchEngineAlgorithm::postProcessHits_(const PeakMap& exp,
             omp_unset_lock(&(annotated_hits_lock[scan_index]));
 #endif
           }
-        }
+        });
       }
     }
     endProgress();
 
+#ifdef _OPENMP
+    for (size_t i = 0; i != processed_peptides_lock.size(); i++)
+    {
+      omp_destroy_lock(&(processed_peptides_lock[i]));
+    }
+#endif
+
+    if (fragment_index_)
+    {
+      vector<IndexedCandidate_> candidates;
+      for (auto& tc : thread_candidates)
+      {
+        candidates.insert(candidates.end(), make_move_iterator(tc.begin()), make_move_iterator(tc.end()));
+        vector<IndexedCandidate_>().swap(tc);
+      }
+
+      vector<vector<double> > precursor_masses(spectra.size());
+      for (Size k = 0; k < sorted_precursor_masses.size(); ++k)
+      {
+        precursor_masses[sorted_scan_indices[k]].push_back(sorted_precursor_masses[k]);
+      }
+
+      startProgress(0, 1, "Scoring spectra using the fragment index...");
+      scoreFragmentIndex_(spectra, precursor_masses, candidates, annotated_hits, precursor_mass_tolerance_unit_ppm, fragment_mass_tolerance_unit_ppm);
+      endProgress();
+      OPENMS_LOG_INFO << "Indexed candidates: " << candidates.size() << endl;
+    }
+
     OPENMS_LOG_INFO << "Proteins: " << count_proteins << endl;
     OPENMS_LOG_INFO << "Peptides: " << count_peptides << endl;
-    OPENMS_LOG_INFO << "Processed peptides: " << processed_petides.size() << endl;
+    Size count_processed_peptides(0);
+    for (const auto& shard : processed_peptides) { count_processed_peptides += shard.size(); }
+    OPENMS_LOG_INFO << "Processed peptides: " << count_processed_peptides << endl;
 
     startProgress(0, 1, "Post-processing PSMs...");
     SimpleSearchEngineAlgorithm::postProcessHits_(spectra, 
@@ -13,11 +13,32 @@
 #include <OpenMS/METADATA/SourceFile.h>
 #include <OpenMS/SYSTEM/File.h>
 
+#include <array>
+#include <exception>
+#include <iterator>
+#include <sstream>
+
 using namespace OpenMS;
 using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// Input of one SiriusMSFile::writeMsFile_ call: the MS2 spectra of a feature (or without feature)
+    struct MsFileEntry
+    {
+      std::vector<size_t> ms2_spectra_index;
+      StringList adducts;
+      std::vector<String> v_description = {"UNKNOWN"};
+      std::vector<String> v_sumformula = {"UNKNOWN"};
+      std::vector<std::pair<double, double>> f_isotopes;
+      int feature_charge = 0;
+      uint64_t feature_id = 0;
+      double feature_rt = 0;
+      double feature_mz = 0;
+    };
+  }
 
   // precursor correction (highest intensity)
   Int SiriusMSFile::getHighestIntensityPeakInMZRange_(double test_mz,
@@ -90,7 +111,7 @@ namespace OpenMS
     return isotopes;
   }
 
-  void SiriusMSFile::writeMsFile_(ofstream& os,
+  void SiriusMSFile::writeMsFile_(ostream& os,
                                   const MSExperiment& spectra,
                                   const std::vector<size_t>& ms2_spectra_index,
                                   const SiriusMSFile::AccessionInfo& ainfo,
@@ -193,8 +214,7 @@ namespace OpenMS
           double precursor_rt = 0.0;
 
           vector<Peak1D> isotopes;
-          isotopes.clear();
-          vector<Peak1D> precursor_spec;
+          const MSSpectrum* precursor_spec = nullptr;
 
           // getPrecursorSpectrum returns past-the-end iterator if spectrum is not found.
           if (s_it2 == spectra.end() || s_it2->getMSLevel() != 1)
@@ -216,11 +236,7 @@ namespace OpenMS
             {
               isotopes = SiriusMSFile::extractPrecursorIsotopePattern_(test_mz, precursor_spectrum, interations, precursor_charge);
             }
-            for (Size i = 0; i < precursor_spectrum.size(); ++i)
-            {
-              const Peak1D &peak = precursor_spectrum[i];
-              precursor_spec.push_back(peak);
-            }
+            precursor_spec = &precursor_spectrum;
           }
 
           // construct query_id; remove spaces from string
@@ -351,12 +367,12 @@ namespace OpenMS
             writecompound = false;
           }
 
-          if (!precursor_spec.empty())
+          if (precursor_spec != nullptr && !precursor_spec->empty())
           {
             os << ">ms1peaks" << endl;
-            for (auto iter = precursor_spec.begin(); iter != precursor_spec.end(); ++iter)
+            for (const Peak1D& peak : *precursor_spec)
             {
-              os << iter->getMZ() << " " << iter->getIntensity() << "\n";
+              os << peak.getMZ() << " " << peak.getIntensity() << "\n";
             }
           }
 
@@ -465,8 +481,7 @@ namespace OpenMS
     }
  
     // extract accession by name
-    ControlledVocabulary cv;
-    cv.loadFromOBO("MS", File::find("/CV/psi-ms.obo"));
+    const ControlledVocabulary& cv = ControlledVocabulary::getPSIMSCV();
     auto lambda = [&ainfo, &cv] (const String& child)
     {
       const ControlledVocabulary::CVTerm& c = cv.getTerm(child);
@@ -484,13 +499,11 @@ namespace OpenMS
     String sumformula;
     vector<String> v_description;
     vector<String> v_sumformula;
-
-    uint64_t feature_id;
-    int feature_charge;
-    double feature_rt;
-    double feature_mz;
     vector<pair<double, double>> f_isotopes;
 
+    // compounds to write (in order); the feature information is collected first, the .ms text is formatted later
+    vector<MsFileEntry> entries;
+
     // if feature information is available to this first (write features in one compound)
     if (use_feature_information)
     { 
@@ -502,12 +515,7 @@ namespace OpenMS
         f_isotopes.clear();
 
         const BaseFeature* feature = it->first;
-        const vector<size_t> feature_associated_ms2 = it->second;
-
-        feature_id = feature->getUniqueId();
-        feature_charge = feature->getCharge();
-        feature_rt = feature->getRT();
-        feature_mz = feature->getMZ();
+        const int feature_charge = feature->getCharge();
 
         // multiple charged compounds are not allowed in sirius
         if (feature_charge > 1 || feature_charge < -1)
@@ -592,82 +600,36 @@ namespace OpenMS
           v_sumformula.emplace_back("UNKNOWN");
         }
 
-        bool writecompound = true;
-        // call function to writeMsFile to os
-        writeMsFile_(os,
-                    spectra,
-                    feature_associated_ms2,
-                    ainfo,
-                    adducts,
-                    v_description,
-                    v_sumformula,
-                    f_isotopes,
-                    feature_charge,
-                    feature_id,
-                    feature_rt,
-                    feature_mz,
-                    writecompound,
-                    no_masstrace_info_isotope_pattern,
-                    isotope_pattern_iterations,
-                    count_skipped_spectra,
-                    count_assume_mono,
-                    count_no_ms1,
-                    v_cmpinfo,
-                    file_index);
-        }
+        MsFileEntry entry;
+        entry.ms2_spectra_index = it->second;
+        entry.adducts = adducts;
+        entry.v_description = v_description;
+        entry.v_sumformula = v_sumformula;
+        entry.f_isotopes = f_isotopes;
+        entry.feature_charge = feature_charge;
+        entry.feature_id = feature->getUniqueId();
+        entry.feature_rt = feature->getRT();
+        entry.feature_mz = feature->getMZ();
+        entries.push_back(std::move(entry));
+      }
     }
 
     // ms2 spectra without an associated feature based on the provided featureXML
+    // (each spectrum is a compound of its own, so it gets its own entry)
     if (use_unassigned_ms2)
     {
-      bool writecompound = true;
-      v_description = {"UNKNOWN"};
-      v_sumformula = {"UNKNOWN"};
-      f_isotopes.clear();
-      adducts.clear();
-      feature_charge = 0;
-      feature_id = 0;
-      feature_mz = 0;
-      feature_rt = 0;
-
-      writeMsFile_(os,
-                   spectra,
-                   unassigned_ms2,
-                   ainfo,
-                   adducts,
-                   v_description,
-                   v_sumformula,
-                   f_isotopes,
-                   feature_charge,
-                   feature_id,
-                   feature_rt,
-                   feature_mz,
-                   writecompound,
-                   no_masstrace_info_isotope_pattern,
-                   isotope_pattern_iterations,
-                   count_skipped_spectra,
-                   count_assume_mono,
-                   count_no_ms1,
-                   v_cmpinfo,
-                   file_index);
+      for (size_t scan_index : unassigned_ms2)
+      {
+        MsFileEntry entry;
+        entry.ms2_spectra_index = {scan_index};
+        entries.push_back(std::move(entry));
+      }
     }
 
     // no feature information was provided
     if (no_feature_information)
     {
-      bool writecompound = true;
-      v_description = {"UNKNOWN"};
-      v_sumformula = {"UNKNOWN"};
-      f_isotopes.clear();
-      adducts.clear();
-      feature_charge = 0;
-      feature_id = 0;
-      feature_mz = 0;
-      feature_rt = 0;
-
-      // fill vector with index of all ms2 of the mzml
-      vector<size_t> all_ms2;
-
+      // one entry for each ms2 of the mzml
       for (PeakMap::ConstIterator s_it = spectra.begin(); s_it != spectra.end(); ++s_it)
       {
         // process only MS2 spectra
@@ -676,31 +638,76 @@ namespace OpenMS
           continue;
         }
 
-        int scan_index = s_it - spectra.begin();
+        MsFileEntry entry;
+        entry.ms2_spectra_index = {size_t(s_it - spectra.begin())};
+        entries.push_back(std::move(entry));
+      }
+    }
 
-        all_ms2.push_back(scan_index);
+    // format the compounds of a batch of entries in parallel (one buffer per entry) and write them in order
+    const Size batch_size = 1000;
+    for (Size batch_start = 0; batch_start < entries.size(); batch_start += batch_size)
+    {
+      const Size batch_end = std::min(entries.size(), batch_start + batch_size);
+      vector<String> texts(batch_end - batch_start);
+      vector<vector<SiriusMSFile::CompoundInfo>> cmpinfos(texts.size());
+      vector<std::array<int, 3>> counts(texts.size(), {0, 0, 0}); // skipped spectra, assumed mono charge, no MS1
+      std::exception_ptr error;
+
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)texts.size(); ++i)
+      {
+        try
+        {
+          MsFileEntry& entry = entries[batch_start + i];
+          std::ostringstream buffer;
+          buffer.precision(os.precision());
+          buffer.flags(os.flags());
+          bool writecompound = true;
+          writeMsFile_(buffer,
+                       spectra,
+                       entry.ms2_spectra_index,
+                       ainfo,
+                       entry.adducts,
+                       entry.v_description,
+                       entry.v_sumformula,
+                       entry.f_isotopes,
+                       entry.feature_charge,
+                       entry.feature_id,
+                       entry.feature_rt,
+                       entry.feature_mz,
+                       writecompound,
+                       no_masstrace_info_isotope_pattern,
+                       isotope_pattern_iterations,
+                       counts[i][0],
+                       counts[i][1],
+                       counts[i][2],
+                       cmpinfos[i],
+                       file_index);
+          texts[i] = buffer.str();
+        }
+        catch (...)
+        {
+#pragma omp critical (SiriusMSFile_store)
+          if (!error) error = std::current_exception();
+        }
+      }
+      if (error)
+      {
+        std::rethrow_exception(error);
       }
 
-      writeMsFile_(os,
-                   spectra,
-                   all_ms2,
-                   ainfo,
-                   adducts,
-                   v_description,
-                   v_sumformula,
-                   f_isotopes,
-                   feature_charge,
-                   feature_id,
-                   feature_rt,
-                   feature_mz,
-                   writecompound,
-                   no_masstrace_info_isotope_pattern,
-                   isotope_pattern_iterations,
-                   count_skipped_spectra,
-                   count_assume_mono,
-                   count_no_ms1,
-                   v_cmpinfo,
-                   file_index);
+      for (Size i = 0; i < texts.size(); ++i)
+      {
+        if (!texts[i].empty())
+        {
+          os << texts[i] << fixed; // the compounds are written in fixed notation
+        }
+        std::move(cmpinfos[i].begin(), cmpinfos[i].end(), std::back_inserter(v_cmpinfo));
+        count_skipped_spectra += counts[i][0];
+        count_assume_mono += counts[i][1];
+        count_no_ms1 += counts[i][2];
+      }
     }
 
     OPENMS_LOG_WARN << "No MS1 spectrum for this precursor. Occurred " << count_no_ms1 << " times." << endl;
@@ -37,6 +37,7 @@ MorpheusScore.cpp
 NeighborSeq.cpp
 PeptideProteinResolution.cpp
 PeptideIndexing.cpp
+ProteinSuffixIndex.cpp
 PercolatorFeatureSetHelper.cpp
 PrecursorPurity.cpp
 PScore.cpp
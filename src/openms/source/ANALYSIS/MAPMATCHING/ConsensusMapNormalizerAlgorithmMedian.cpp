@@ -10,9 +10,11 @@
 
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/KERNEL/ColumnarConsensusMap.h>
 #include <OpenMS/MATH/StatisticFunctions.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <OpenMS/METADATA/ProteinIdentification.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
 #include <boost/regex.hpp>
 
 using namespace std;
@@ -25,6 +27,16 @@ namespace OpenMS
 
   Size ConsensusMapNormalizerAlgorithmMedian::computeMedians(const ConsensusMap & map, vector<double>& medians, const String& acc_filter, const String& desc_filter)
   {
+    return computeMedians(map, ColumnarConsensusMap(map), medians, acc_filter, desc_filter);
+  }
+
+  Size ConsensusMapNormalizerAlgorithmMedian::computeMedians(const ConsensusMap & map, const ColumnarConsensusMap & columns, vector<double>& medians, const String& acc_filter, const String& desc_filter)
+  {
+    if (columns.featureCount() != map.size())
+    {
+      throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, columns.featureCount());
+    }
+
     Size number_of_maps = map.getColumnHeaders().size();
     vector<vector<double> > feature_int(number_of_maps);
     medians.resize(number_of_maps);
@@ -54,21 +66,37 @@ namespace OpenMS
       }
     }
 
+    // evaluate the filters (regular expressions on the identifications) for all consensus features
+    vector<char> passes(map.size(), 1);
+    if (!acc_filter.empty() || !desc_filter.empty())
+    {
+      TaskScheduler::parallelFor(0, map.size(), [&](SignedSize i)
+      {
+        passes[i] = passesFilters_(map.begin() + i, map, acc_filter, desc_filter);
+      });
+    }
+
     // fill feature_int with intensities
     Size pass_counter = 0;
-    ConsensusMap::ConstIterator cf_it;
-    for (cf_it = map.begin(); cf_it != map.end(); ++cf_it)
+    const vector<Size>& feature_offsets = columns.getFeatureOffsets();
+    const vector<UInt64>& map_indices = columns.getMapIndices();
+    const vector<float>& intensities = columns.getIntensities();
+    for (Size i = 0; i < map.size(); ++i)
     {
-      if (!passesFilters_(cf_it, map, acc_filter, desc_filter))
+      if (!passes[i])
       {
         continue;
       }
       ++pass_counter;
 
-      ConsensusFeature::HandleSetType::const_iterator f_it;
-      for (f_it = cf_it->getFeatures().begin(); f_it != cf_it->getFeatures().end(); ++f_it)
+      for (Size e = feature_offsets[i]; e < feature_offsets[i + 1]; ++e)
       {
-        feature_int[f_it->getMapIndex()].push_back(f_it->getIntensity());
+        if (map_indices[e] >= number_of_maps)
+        {
+          throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
+            String(map_indices[e]) + " exceeds map number");
+        }
+        feature_int[map_indices[e]].push_back(intensities[e]);
       }
     }
 
@@ -96,11 +124,10 @@ namespace OpenMS
     else
     {
       //compute medians
-      for (UInt j = 0; j < number_of_maps; j++)
+      TaskScheduler::parallelFor(0, number_of_maps, [&](SignedSize j)
       {
-        vector<double>& ints_j = feature_int[j];
-        medians[j] = Math::median(ints_j.begin(), ints_j.end());
-      }
+        medians[j] = Math::median(std::move(feature_int[j]));
+      });
     }
 
     return map_with_most_features_idx;
@@ -113,48 +140,54 @@ namespace OpenMS
       OPENMS_LOG_WARN << endl << "WARNING: normalization using median shifting is not recommended for regular log-normal MS data. Use this only if you know exactly what you're doing!" << endl << endl;
     }
 
-    ConsensusMap::Iterator cf_it;
     ProgressLogger progresslogger;
     progresslogger.setLogType(ProgressLogger::CMD);
     progresslogger.startProgress(0, map.size(), "normalizing maps");
 
+    // work on contiguous columns instead of the handle sets of the features
+    ColumnarConsensusMap columns(map);
+
     vector<double> medians;
-    Size index_of_largest_map = computeMedians(map, medians, acc_filter, desc_filter);
+    Size index_of_largest_map = computeMedians(map, columns, medians, acc_filter, desc_filter);
 
-    for (cf_it = map.begin(); cf_it != map.end(); ++cf_it)
+    // shift to median of map with largest median in order to avoid negative intensities
+    double max_median(numeric_limits<double>::min());
+    Size max_median_index(0);
+    for (Size i = 0; i < medians.size(); ++i)
     {
-      progresslogger.setProgress(cf_it - map.begin());
-      ConsensusFeature::HandleSetType::const_iterator f_it;
-      for (f_it = cf_it->getFeatures().begin(); f_it != cf_it->getFeatures().end(); ++f_it)
+      if (medians[i] > max_median)
       {
-        Size map_index = f_it->getMapIndex();
-        if (method == NM_SCALE)
-        {
-          // scale to median of map with largest number of features
-          f_it->asMutable().setIntensity(f_it->getIntensity() * medians[index_of_largest_map] / medians[map_index]);
-        }
-        else // method == NM_SHIFT
-        {
-          // shift to median of map with largest median in order to avoid negative intensities
-          double max_median(numeric_limits<double>::min());
-          Size max_median_index(0);
-          for (Size i = 0; i < medians.size(); ++i)
-          {
-            if (medians[i] > max_median)
-            {
-              max_median = medians[i];
-              max_median_index = i;
-            }
-          }
-          f_it->asMutable().setIntensity(f_it->getIntensity() + medians[max_median_index] - medians[map_index]);
-        }
+        max_median = medians[i];
+        max_median_index = i;
+      }
+    }
+
+    vector<float>& intensities = columns.getIntensities();
+    const vector<UInt64>& map_indices = columns.getMapIndices();
+    for (Size e = 0; e < columns.entryCount(); ++e)
+    {
+      Size map_index = map_indices[e];
+      if (method == NM_SCALE)
+      {
+        // scale to median of map with largest number of features
+        intensities[e] = intensities[e] * medians[index_of_largest_map] / medians[map_index];
+      }
+      else // method == NM_SHIFT
+      {
+        intensities[e] = intensities[e] + medians[max_median_index] - medians[map_index];
       }
     }
+    columns.applyIntensities(map);
     progresslogger.endProgress();
   }
 
   bool ConsensusMapNormalizerAlgorithmMedian::passesFilters_(ConsensusMap::ConstIterator cf_it, const ConsensusMap& map, const String& acc_filter, const String& desc_filter)
   {
+    if (acc_filter.empty() && desc_filter.empty())
+    {
+      // no need to compile the expressions
+      return true;
+    }
     boost::regex acc_regexp(acc_filter);
     boost::regex desc_regexp(desc_filter);
     boost::cmatch m;
@@ -9,6 +9,11 @@
 #include <OpenMS/ANALYSIS/MAPMATCHING/ConsensusMapNormalizerAlgorithmQuantile.h>
 
 #include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/KERNEL/ColumnarConsensusMap.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
+
+#include <algorithm>
+#include <cmath>
 
 using namespace std;
 
@@ -18,83 +23,112 @@ namespace OpenMS
 
   ConsensusMapNormalizerAlgorithmQuantile::~ConsensusMapNormalizerAlgorithmQuantile() = default;
 
-  void ConsensusMapNormalizerAlgorithmQuantile::normalizeMaps(ConsensusMap& map)
+  namespace
   {
-    //extract feature intensities
-    vector<vector<double> > feature_ints;
-    extractIntensityVectors(map, feature_ints);
-    Size number_of_maps = feature_ints.size();
-
-    //determine largest number of features in any map
-    Size largest_number_of_features = 0;
-    for (Size i = 0; i < number_of_maps; ++i)
+    /// point @p i of resampling @p data_in to @p n_resampling_points points (see ConsensusMapNormalizerAlgorithmQuantile::resample)
+    inline double resampledPoint(const vector<double>& data_in, UInt n_resampling_points, UInt i)
     {
-      if (feature_ints[i].size() > largest_number_of_features)
+      if (i == n_resampling_points - 1)
       {
-        largest_number_of_features = feature_ints[i].size();
+        return data_in.back();
       }
+      if (i == 0)
+      {
+        return data_in.front();
+      }
+      double delta = (double)(data_in.size() - 1) / (double)(n_resampling_points - 1);
+      double pseudo_index = (double)i * delta;
+      double left_index = (UInt)floor(pseudo_index);
+      double right_index = (UInt)ceil(pseudo_index);
+      if (left_index == right_index)
+      {
+        return data_in[left_index];
+      }
+      double weight_left = 1.0 - (pseudo_index - (double)left_index);
+      double weight_right = 1.0 - ((double)right_index - pseudo_index);
+      return weight_left * data_in[left_index] + weight_right * data_in[right_index];
     }
+  }
 
-    //resample n data points from each sorted intensity distribution (from the different maps), n = maximum number of features in any map
-    vector<vector<double> > resampled_sorted_data;
-    for (Size i = 0; i < number_of_maps; ++i)
+  void ConsensusMapNormalizerAlgorithmQuantile::normalizeMaps(ConsensusMap& map)
+  {
+    Size number_of_maps = map.getColumnHeaders().size();
+    for (UInt i = 0; i < number_of_maps; i++)
     {
-      vector<double> sorted = feature_ints[i];
-      std::sort(sorted.begin(), sorted.end());
-      vector<double> resampled(largest_number_of_features);
-      resample(sorted, resampled, static_cast<UInt>(largest_number_of_features));
-      resampled_sorted_data.push_back(resampled);
+      if (map.getColumnHeaders().find(i) == map.getColumnHeaders().end()) throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String(i));
     }
+    ColumnarConsensusMap columns(map);
+    normalizeMaps(columns);
+    columns.applyIntensities(map);
+  }
 
-    //compute reference distribution from all resampled distributions
-    vector<double> reference_distribution(largest_number_of_features);
-    for (Size i = 0; i < number_of_maps; ++i)
-    {
-      for (Size j = 0; j < largest_number_of_features; ++j)
-      {
-        reference_distribution[j] += (resampled_sorted_data[i][j] / (double)number_of_maps);
-      }
-    }
+  void ConsensusMapNormalizerAlgorithmQuantile::normalizeMaps(ColumnarConsensusMap& columns)
+  {
+    const Size number_of_maps = columns.mapCount();
+    const vector<Size>& map_offsets = columns.getMapOffsets();
+    const vector<Size>& map_entries = columns.getMapEntries();
+    vector<float>& intensities = columns.getIntensities();
 
-    //for each map: resample from the reference distribution down to the respective original size again
-    vector<vector<double> > normalized_sorted_ints(number_of_maps);
+    //determine largest number of features in any map
+    Size largest_number_of_features = 0;
     for (Size i = 0; i < number_of_maps; ++i)
     {
-      vector<double> ints;
-      resample(reference_distribution, ints, static_cast<UInt>(feature_ints[i].size()));
-      normalized_sorted_ints[i] = ints;
+      largest_number_of_features = std::max(largest_number_of_features, map_offsets[i + 1] - map_offsets[i]);
     }
 
-    //set the intensities of feature_ints to the normalized intensities
-    for (Size i = 0; i < number_of_maps; ++i)
+    //sort the intensities of each map; the rank of each feature (ties in feature order) is kept for writing back
+    vector<vector<double> > sorted_ints(number_of_maps);
+    vector<vector<UInt> > sort_indices(number_of_maps);
+    TaskScheduler::parallelFor(0, number_of_maps, [&](SignedSize i)
     {
-      // We do not want to change the order in feature_ints[i] but normalized_sorted_ints
-      // comes sorted, so we transfer the values in feature_ints[i] into pairs that store
-      // the value and the index in feature_ints[i]. Then we sort the vector of pair and as
-      // a result store the indexes of feature_ints[i] in a sorted order in sort_indices.
+      const Size offset = map_offsets[i];
+      const Size n = map_offsets[i + 1] - offset;
       std::vector<std::pair<double, UInt> > sort_pairs;
-      sort_pairs.reserve(feature_ints[i].size());
-      for (Size j = 0; j < feature_ints[i].size(); ++j)
+      sort_pairs.reserve(n);
+      for (Size j = 0; j < n; ++j)
       {
-        sort_pairs.emplace_back(feature_ints[i][j], j);
+        sort_pairs.emplace_back(intensities[map_entries[offset + j]], j);
       }
       std::sort(sort_pairs.begin(), sort_pairs.end());
-      vector<Size> sort_indices;
-      sort_indices.reserve(sort_pairs.size());
-      for (Size j = 0; j < sort_pairs.size(); ++j)
+      sorted_ints[i].reserve(n);
+      sort_indices[i].reserve(n);
+      for (const std::pair<double, UInt>& p : sort_pairs)
       {
-        sort_indices.push_back(sort_pairs.at(j).second);
+        sorted_ints[i].push_back(p.first);
+        sort_indices[i].push_back(p.second);
       }
-      Size k = 0;
-      for (Size j = 0; j < sort_indices.size(); ++j)
+    });
+
+    //compute reference distribution from the sorted intensity distributions (from the different maps), each
+    //resampled to n data points, n = maximum number of features in any map; the resampled distributions are not
+    //stored, blocks of the reference distribution are accumulated over all maps instead
+    vector<double> reference_distribution(largest_number_of_features);
+    const Size block_size = 1024;
+    TaskScheduler::parallelFor(0, (largest_number_of_features + block_size - 1) / block_size, [&](SignedSize b)
+    {
+      const Size begin = b * block_size;
+      const Size end = std::min(begin + block_size, largest_number_of_features);
+      for (Size i = 0; i < number_of_maps; ++i)
       {
-        Size idx = sort_indices[j];
-        feature_ints[i][idx] = normalized_sorted_ints[i][k++];
+        for (Size j = begin; j < end; ++j)
+        {
+          reference_distribution[j] += (resampledPoint(sorted_ints[i], static_cast<UInt>(largest_number_of_features), static_cast<UInt>(j)) / (double)number_of_maps);
+        }
       }
-    }
+    });
 
-    //write new feature intensities to the consensus map
-    setNormalizedIntensityValues(feature_ints, map);
+    //for each map: resample from the reference distribution down to the respective original size again and
+    //assign the normalized intensities by rank
+    TaskScheduler::parallelFor(0, number_of_maps, [&](SignedSize i)
+    {
+      vector<double> normalized_sorted_ints;
+      resample(reference_distribution, normalized_sorted_ints, static_cast<UInt>(sort_indices[i].size()));
+      const Size offset = map_offsets[i];
+      for (Size k = 0; k < sort_indices[i].size(); ++k)
+      {
+        intensities[map_entries[offset + sort_indices[i][k]]] = normalized_sorted_ints[k];
+      }
+    });
   }
 
   void ConsensusMapNormalizerAlgorithmQuantile::resample(const vector<double>& data_in, vector<double>& data_out, UInt n_resampling_points)
@@ -107,24 +141,9 @@ namespace OpenMS
       return;
     }
 
-    data_out[0] = data_in.front();
-    data_out[n_resampling_points - 1] = data_in.back();
-    double delta = (double)(data_in.size() - 1) / (double)(n_resampling_points - 1);
-    for (UInt i = 1; i < n_resampling_points - 1; ++i)
+    for (UInt i = 0; i < n_resampling_points; ++i)
     {
-      double pseudo_index = (double)i * delta;
-      double left_index = (UInt)floor(pseudo_index);
-      double right_index = (UInt)ceil(pseudo_index);
-      if (left_index == right_index)
-      {
-        data_out[i] = data_in[left_index];
-      }
-      else
-      {
-        double weight_left = 1.0 - (pseudo_index - (double)left_index);
-        double weight_right = 1.0 - ((double)right_index - pseudo_index);
-        data_out[i] = weight_left * data_in[left_index] + weight_right * data_in[right_index];
-      }
+      data_out[i] = resampledPoint(data_in, n_resampling_points, i);
     }
   }
 
@@ -16,6 +16,8 @@
 #include <OpenMS/METADATA/ProteinIdentification.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
 
+#include <exception>
+
 using namespace std;
 
 namespace OpenMS
@@ -93,6 +95,8 @@ namespace OpenMS
     mz_ppm_ = mz_unit == "ppm";
     mz_tol_ = (double)(param_.getValue("link:mz_tol"));
     rt_tol_secs_ = (double)(param_.getValue("link:rt_tol"));
+    merge_charge_ = param_.getValue("link:charge_merging").toString();
+    merge_adduct_ = param_.getValue("link:adduct_merging").toString();
 
     // check that the number of maps is ok:
     if (input_maps.size() < 2)
@@ -159,6 +163,30 @@ namespace OpenMS
     }
     // add last partition (a bit more since we use "smaller than" below)
     partition_boundaries.push_back(massrange.back() + 1.0);
+    const Size n_partitions = partition_boundaries.size() - 1;
+
+    // assign every feature to its partition once; the kd-trees of the
+    // partitions reference the features of the input maps (no copies)
+    vector<vector<pair<Size, Size> > > partition_features(n_partitions); // (map index, feature index)
+    for (size_t k = 0; k < input_maps.size(); k++)
+    {
+      for (size_t m = 0; m < input_maps[k].size(); m++)
+      {
+        Size j = upper_bound(partition_boundaries.begin(), partition_boundaries.end(), input_maps[k][m].getMZ()) - partition_boundaries.begin() - 1;
+        if (j < n_partitions)
+        {
+          partition_features[j].emplace_back(k, m);
+        }
+      }
+    }
+    auto fillPartition = [&input_maps, &partition_features](Size j, KDTreeFeatureMaps& kd_data)
+    {
+      for (const pair<Size, Size>& feature : partition_features[j])
+      {
+        kd_data.addFeature(feature.first, &(input_maps[feature.first][feature.second]));
+      }
+      kd_data.optimizeTree();
+    };
 
     // ------------ compute RT transformation models ------------
 
@@ -168,30 +196,11 @@ namespace OpenMS
     {
       Size progress = 0;
       startProgress(0, partition_boundaries.size(), "computing RT transformations");
-      for (size_t j = 0; j < partition_boundaries.size()-1; j++)
+      for (size_t j = 0; j < n_partitions; j++)
       {
-        double partition_start = partition_boundaries[j];
-        double partition_end = partition_boundaries[j+1];
-
-        std::vector<MapType> tmp_input_maps(input_maps.size());
-        for (size_t k = 0; k < input_maps.size(); k++)
-        {
-          // iterate over all features in the current input map and append
-          // matching features (within the current partition) to the temporary
-          // map
-          for (size_t m = 0; m < input_maps[k].size(); m++)
-          {
-            if (input_maps[k][m].getMZ() >= partition_start &&
-                input_maps[k][m].getMZ() < partition_end)
-            {
-              tmp_input_maps[k].push_back(input_maps[k][m]);
-            }
-          }
-          tmp_input_maps[k].updateRanges();
-        }
-
         // set up kd-tree
-        KDTreeFeatureMaps kd_data(tmp_input_maps, param_);
+        KDTreeFeatureMaps kd_data(input_maps.size(), param_);
+        fillPartition(j, kd_data);
         aligner.addRTFitData(kd_data);
         setProgress(progress++);
       }
@@ -211,44 +220,59 @@ namespace OpenMS
     }
 
     // ------------ run alignment + feature linking on individual partitions ------------
+    // partitions are linked in parallel, their consensus features are added in partition order
     Size progress = 0;
     startProgress(0, partition_boundaries.size(), "linking features");
-    for (size_t j = 0; j < partition_boundaries.size()-1; j++)
+    std::exception_ptr error;
+#pragma omp parallel
     {
-      double partition_start = partition_boundaries[j];
-      double partition_end = partition_boundaries[j+1];
+      // the distance functor caches normalization factors, so every thread needs its own
+      FeatureDistance feature_distance = feature_distance_;
 
-      std::vector<MapType> tmp_input_maps(input_maps.size());
-      for (size_t k = 0; k < input_maps.size(); k++)
+#pragma omp for schedule(dynamic) ordered
+      for (SignedSize j = 0; j < (SignedSize)n_partitions; j++)
       {
-        // iterate over all features in the current input map and append
-        // matching features (within the current partition) to the temporary
-        // map
-        for (size_t m = 0; m < input_maps[k].size(); m++)
+        ConsensusMap partition_out;
+        std::exception_ptr partition_error;
+        try
         {
-          if (input_maps[k][m].getMZ() >= partition_start &&
-              input_maps[k][m].getMZ() < partition_end)
+          // set up kd-tree
+          KDTreeFeatureMaps kd_data(input_maps.size(), param_);
+          fillPartition(j, kd_data);
+
+          // alignment
+          if (align)
           {
-            tmp_input_maps[k].push_back(input_maps[k][m]);
+            aligner.transform(kd_data);
           }
-        }
-        tmp_input_maps[k].updateRanges();
-      }
 
-      // set up kd-tree
-      KDTreeFeatureMaps kd_data(tmp_input_maps, param_);
+          // link features
+          runClustering_(kd_data, feature_distance, partition_out);
+        }
+        catch (...)
+        {
+          partition_error = std::current_exception();
+        }
 
-      // alignment
-      if (align)
-      {
-        aligner.transform(kd_data);
+#pragma omp ordered
+        {
+          if (partition_error && !error)
+          {
+            error = partition_error;
+          }
+          for (ConsensusFeature& cf : partition_out)
+          {
+            out.push_back(std::move(cf));
+          }
+          setProgress(progress++);
+        }
       }
-
-      // link features
-      runClustering_(kd_data, out);
-      setProgress(progress++);
     }
     endProgress();
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
     
     postprocess_(input_maps, out);
   }
@@ -265,7 +289,7 @@ namespace OpenMS
     group_(maps, out);
   }
 
-  void FeatureGroupingAlgorithmKD::runClustering_(const KDTreeFeatureMaps& kd_data, ConsensusMap& out)
+  void FeatureGroupingAlgorithmKD::runClustering_(const KDTreeFeatureMaps& kd_data, FeatureDistance& feature_distance, ConsensusMap& out) const
   {
     Size n = kd_data.size();
 
@@ -278,7 +302,7 @@ namespace OpenMS
     set<ClusterProxyKD> potential_clusters;
     vector<ClusterProxyKD> cluster_for_idx(n);
     vector<Int> assigned(n, false);
-    updateClusterProxies_(potential_clusters, cluster_for_idx, update_these, assigned, kd_data);
+    updateClusterProxies_(potential_clusters, cluster_for_idx, update_these, assigned, kd_data, feature_distance);
 
     // pass 2: construct consensus features until all points assigned.
     while (!potential_clusters.empty())
@@ -288,7 +312,7 @@ namespace OpenMS
 
       // compile the actual list of sub feature indices for cluster with center i
       vector<Size> cf_indices;
-      computeBestClusterForCenter_(i, cf_indices, assigned, kd_data);
+      computeBestClusterForCenter_(i, cf_indices, assigned, kd_data, feature_distance);
 
       // add consensus feature
       addConsensusFeature_(cf_indices, kd_data, out);
@@ -316,7 +340,7 @@ namespace OpenMS
       }
 
       // now that the points are marked assigned, update the neighborhoods of their neighbors
-      updateClusterProxies_(potential_clusters, cluster_for_idx, update_these, assigned, kd_data);
+      updateClusterProxies_(potential_clusters, cluster_for_idx, update_these, assigned, kd_data, feature_distance);
     }
   }
 
@@ -326,14 +350,15 @@ namespace OpenMS
                                                          vector<ClusterProxyKD>& cluster_for_idx,
                                                          const set<Size>& update_these,
                                                          const vector<Int>& assigned,
-                                                         const KDTreeFeatureMaps& kd_data)
+                                                         const KDTreeFeatureMaps& kd_data,
+                                                         FeatureDistance& feature_distance) const
   {
     for (set<Size>::const_iterator it = update_these.begin(); it != update_these.end(); ++it)
     {
       Size i = *it;
       const ClusterProxyKD& old_proxy = cluster_for_idx[i];
       vector<Size> unused;
-      ClusterProxyKD new_proxy = computeBestClusterForCenter_(i, unused, assigned, kd_data);
+      ClusterProxyKD new_proxy = computeBestClusterForCenter_(i, unused, assigned, kd_data, feature_distance);
 
       // only need to update if size and/or average distance have changed
       if (new_proxy != old_proxy)
@@ -345,11 +370,11 @@ namespace OpenMS
     }
   }
 
-  ClusterProxyKD FeatureGroupingAlgorithmKD::computeBestClusterForCenter_(Size i, vector<Size>& cf_indices, const vector<Int>& assigned, const KDTreeFeatureMaps& kd_data) const
+  ClusterProxyKD FeatureGroupingAlgorithmKD::computeBestClusterForCenter_(Size i, vector<Size>& cf_indices, const vector<Int>& assigned, const KDTreeFeatureMaps& kd_data, FeatureDistance& feature_distance) const
   {
     //Parameters how to use charge/adduct information
-    String merge_charge(param_.getValue("link:charge_merging").toString());
-    String merge_adduct(param_.getValue("link:adduct_merging").toString());
+    const String& merge_charge = merge_charge_;
+    const String& merge_adduct = merge_adduct_;
 
     // compute i's neighborhood, together with a look-up table
     // map index -> corresponding points
@@ -447,8 +472,7 @@ namespace OpenMS
       Size best_index = numeric_limits<Size>::max();
       for (vector<Size>::const_iterator c_it = candidates.begin(); c_it != candidates.end(); ++c_it)
       {
-        double dist = const_cast<FeatureDistance&>(feature_distance_)(*(kd_data.feature(*c_it)),
-                                                                      *(kd_data.feature(i))).second;
+        double dist = feature_distance(*(kd_data.feature(*c_it)), *(kd_data.feature(i))).second;
 
         if (dist < min_dist)
         {
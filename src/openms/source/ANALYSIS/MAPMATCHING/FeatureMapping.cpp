@@ -23,7 +23,9 @@ namespace OpenMS
     std::map<const BaseFeature*, std::vector<size_t>>  assigned_ms2;
     vector<size_t> unassigned_ms2;
 
-    // map precursors to closest feature and retrieve annotated metadata (if possible)
+    // collect the tolerance windows of all precursors and query them at once
+    vector<size_t> query_spectra;
+    vector<KDTreeFeatureMaps::Region> regions;
     for (size_t index = 0; index != spectra.size(); ++index)
     {
       if (spectra[index].getMSLevel() != 2) { continue; }
@@ -36,36 +38,46 @@ namespace OpenMS
         const double mz = pcs[0].getMZ();
         const double rt = spectra[index].getRT();
 
-        // query features in tolerance window
-        vector<Size> matches;
-
         // get mz tolerance window
         std::pair<double,double> mz_tolerance_window = Math::getTolWindow(mz, precursor_mz_tolerance, ppm);
-        fm_info.kd_tree.queryRegion(rt - precursor_rt_tolerance, rt + precursor_rt_tolerance, mz_tolerance_window.first, mz_tolerance_window.second, matches, true);
+        query_spectra.push_back(index);
+        regions.push_back({{rt - precursor_rt_tolerance, mz_tolerance_window.first}, {rt + precursor_rt_tolerance, mz_tolerance_window.second}});
+      }
+    }
+    vector<vector<Size>> all_matches;
+    fm_info.kd_tree.queryRegions(regions, all_matches, true);
 
-        // no precursor matches the feature information found
-        if (matches.empty())
-        {
-          unassigned_ms2.push_back(index);
-          continue;
-        }
+    // map precursors to closest feature and retrieve annotated metadata (if possible)
+    for (size_t q = 0; q != query_spectra.size(); ++q)
+    {
+      const size_t index = query_spectra[q];
+      const double mz = spectra[index].getPrecursors()[0].getMZ();
+
+      // features in tolerance window
+      const vector<Size>& matches = all_matches[q];
+
+      // no precursor matches the feature information found
+      if (matches.empty())
+      {
+        unassigned_ms2.push_back(index);
+        continue;
+      }
 
-        // in the case of multiple features in tolerance window, select the one closest in m/z to the precursor
-        Size min_distance_feature_index(0);
-        double min_distance(1e11);
-        for (auto const & k_idx : matches)
+      // in the case of multiple features in tolerance window, select the one closest in m/z to the precursor
+      Size min_distance_feature_index(0);
+      double min_distance(1e11);
+      for (auto const & k_idx : matches)
+      {
+        const double f_mz = fm_info.kd_tree.mz(k_idx);
+        const double distance = fabs(f_mz - mz);
+        if (distance < min_distance)
         {
-          const double f_mz = fm_info.kd_tree.mz(k_idx);
-          const double distance = fabs(f_mz - mz);
-          if (distance < min_distance)
-          {
-            min_distance = distance;
-            min_distance_feature_index = k_idx;
-          }
+          min_distance = distance;
+          min_distance_feature_index = k_idx;
         }
-        const BaseFeature* min_distance_feature = fm_info.kd_tree.feature(min_distance_feature_index);
-        assigned_ms2[min_distance_feature].push_back(index);
       }
+      const BaseFeature* min_distance_feature = fm_info.kd_tree.feature(min_distance_feature_index);
+      assigned_ms2[min_distance_feature].push_back(index);
     }
     FeatureMapping::FeatureToMs2Indices feature_mapping;
     feature_mapping.assignedMS2 = assigned_ms2;
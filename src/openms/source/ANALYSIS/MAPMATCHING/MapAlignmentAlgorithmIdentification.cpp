@@ -10,6 +10,7 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/MATH/StatisticFunctions.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
 
 using namespace std;
 
@@ -80,18 +81,26 @@ namespace OpenMS
                                                             bool sorted)
   {
     medians.clear();
+    medians.reserve(rt_data.size());
     for (SeqToList::iterator rt_it = rt_data.begin();
          rt_it != rt_data.end(); ++rt_it)
     {
       double median = Math::median(rt_it->second.begin(),
                                    rt_it->second.end(), sorted);
-      medians.insert(medians.end(), make_pair(rt_it->first, median));
+      medians.emplace(rt_it->first, median);
     }
   }
 
   // lists of peptide hits in "peptides" will be sorted
   bool MapAlignmentAlgorithmIdentification::getRetentionTimes_(
       vector<PeptideIdentification>& peptides, SeqToList& rt_data)
+  {
+    return getRetentionTimes_(peptides, rt_data, better_);
+  }
+
+  bool MapAlignmentAlgorithmIdentification::getRetentionTimes_(
+      vector<PeptideIdentification>& peptides, SeqToList& rt_data,
+      ScoreComparator better) const
   {
     for (vector<PeptideIdentification>::iterator pep_it = peptides.begin();
          pep_it != peptides.end(); ++pep_it)
@@ -99,7 +108,7 @@ namespace OpenMS
       if (!pep_it->getHits().empty())
       {
         pep_it->sort();
-        if (better_(pep_it->getHits()[0].getScore(), min_score_))
+        if (better(pep_it->getHits()[0].getScore(), min_score_))
         {
           const String& seq = pep_it->getHits()[0].getSequence().toString();
           rt_data[seq].push_back(pep_it->getRT());
@@ -179,11 +188,17 @@ namespace OpenMS
   // lists of peptide hits in "maps" will be sorted
   bool MapAlignmentAlgorithmIdentification::getRetentionTimes_(
       PeakMap& experiment, SeqToList& rt_data)
+  {
+    return getRetentionTimes_(experiment, rt_data, better_);
+  }
+
+  bool MapAlignmentAlgorithmIdentification::getRetentionTimes_(
+      PeakMap& experiment, SeqToList& rt_data, ScoreComparator better) const
   {
     for (PeakMap::Iterator exp_it = experiment.begin();
          exp_it != experiment.end(); ++exp_it)
     {
-      getRetentionTimes_(exp_it->getPeptideIdentifications(), rt_data);
+      getRetentionTimes_(exp_it->getPeptideIdentifications(), rt_data, better);
     }
     // duplicate annotations should not be possible -> no need to remove them
     return false;
@@ -202,11 +217,11 @@ namespace OpenMS
     // compute RT medians:
     OPENMS_LOG_DEBUG << "Computing RT medians..." << endl;
     vector<SeqToValue> medians_per_run(size);
-    for (Int i = 0; i < size; ++i)
+    TaskScheduler::parallelFor(0, size, [&](SignedSize i)
     {
       computeMedians_(rt_data[i], medians_per_run[i], sorted);
-    }
-    SeqToList medians_per_seq;
+    });
+    unordered_map<InternedString, DoubleList> medians_per_seq;
     for (vector<SeqToValue>::iterator run_it = medians_per_run.begin();
          run_it != medians_per_run.end(); ++run_it)
     {
@@ -228,11 +243,11 @@ namespace OpenMS
       for (SeqToValue::iterator ref_it = reference_.begin();
            ref_it != reference_.end(); ++ref_it)
       {
-        SeqToList::iterator med_it = medians_per_seq.find(ref_it->first);
+        auto med_it = medians_per_seq.find(ref_it->first);
         if ((med_it != medians_per_seq.end()) &&
             (med_it->second.size() + 1 >= min_run_occur_))
         {
-          temp.insert(temp.end(), *ref_it); // new items should go at the end
+          temp.insert(*ref_it);
         }
       }
       OPENMS_LOG_DEBUG << "Removed " << reference_.size() - temp.size() << " of "
@@ -245,19 +260,18 @@ namespace OpenMS
 
       // remove peptides that don't occur in enough runs (at least two):
       OPENMS_LOG_DEBUG << "Removing peptides that occur in too few runs..." << endl;
-      SeqToList temp;
-      for (SeqToList::iterator med_it = medians_per_seq.begin();
+      reference_.clear();
+      for (auto med_it = medians_per_seq.begin();
            med_it != medians_per_seq.end(); ++med_it)
       {
         if (med_it->second.size() >= min_run_occur_)
         {
-          temp.insert(temp.end(), *med_it);
+          reference_.emplace(med_it->first, Math::median(med_it->second.begin(),
+                                                         med_it->second.end()));
         }
       }
-      OPENMS_LOG_DEBUG << "Removed " << medians_per_seq.size() - temp.size() << " of "
+      OPENMS_LOG_DEBUG << "Removed " << medians_per_seq.size() - reference_.size() << " of "
                 << medians_per_seq.size() << " peptides." << endl;
-      temp.swap(medians_per_seq);
-      computeMedians_(medians_per_seq, reference_);
     }
 
     if (reference_.empty())
@@ -289,6 +303,37 @@ namespace OpenMS
 
     // generate RT transformations:
     OPENMS_LOG_DEBUG << "Generating RT transformations..." << endl;
+    // to be useful for the alignment, a peptide sequence has to occur in the
+    // current run ("medians_per_run[i]"), but also in at least one other run
+    // ("medians_overall"):
+    vector<TransformationDescription::DataPoints> data_per_run(size);
+    vector<Size> outliers_per_run(size, 0);
+    TaskScheduler::parallelFor(0, size, [&](SignedSize i)
+    {
+      TransformationDescription::DataPoints& data = data_per_run[i];
+      for (SeqToValue::iterator med_it = medians_per_run[i].begin();
+           med_it != medians_per_run[i].end(); ++med_it)
+      {
+        SeqToValue::const_iterator pos = reference_.find(med_it->first);
+        if (pos != reference_.end())
+        {
+          if (abs(med_it->second - pos->second) <= max_rt_shift)
+          { // found, and satisfies "max_rt_shift" condition!
+            data.emplace_back(med_it->second, pos->second, pos->first);
+          }
+          else
+          {
+            outliers_per_run[i]++;
+          }
+        }
+      }
+      // data points ordered by peptide sequence
+      sort(data.begin(), data.end(),
+           [](const TransformationDescription::DataPoint& a,
+              const TransformationDescription::DataPoint& b)
+           { return a.note < b.note; });
+    });
+
     OPENMS_LOG_INFO << "\nAlignment based on:" << endl; // diagnostic output
     Size offset = 0; // offset in case of internal reference
     for (Int i = 0; i < size + 1; ++i)
@@ -315,29 +360,8 @@ namespace OpenMS
         continue;
       }
                 
-      // to be useful for the alignment, a peptide sequence has to occur in the
-      // current run ("medians_per_run[i]"), but also in at least one other run
-      // ("medians_overall"):
-      TransformationDescription::DataPoints data;
-      Size n_outliers = 0;
-      for (SeqToValue::iterator med_it = medians_per_run[i].begin();
-           med_it != medians_per_run[i].end(); ++med_it)
-      {
-        SeqToValue::const_iterator pos = reference_.find(med_it->first);
-        if (pos != reference_.end())
-        {
-          if (abs(med_it->second - pos->second) <= max_rt_shift)
-          { // found, and satisfies "max_rt_shift" condition!
-            TransformationDescription::DataPoint point(med_it->second,
-                                                       pos->second, pos->first);
-            data.push_back(point);
-          }
-          else
-          {
-            n_outliers++;
-          }
-        }
-      }
+      const TransformationDescription::DataPoints& data = data_per_run[i];
+      Size n_outliers = outliers_per_run[i];
       transforms.emplace_back(data);
       OPENMS_LOG_INFO << "- " << data.size() << " data points for sample "
                << i + offset + 1;
@@ -98,11 +98,8 @@ void MapAlignmentAlgorithmKD::fitLOWESS()
 
 void MapAlignmentAlgorithmKD::transform(KDTreeFeatureMaps& kd_data) const
 {
-  // apply transformations to kd_data
+  // apply transformations to kd_data (rebuilds the kd-tree)
   kd_data.applyTransformations(transformations_);
-
-  // re-optimize kd-tree
-  kd_data.optimizeTree();
 }
 
 Size MapAlignmentAlgorithmKD::computeCCs_(const KDTreeFeatureMaps& kd_data, vector<Size>& result) const
@@ -62,9 +62,18 @@ namespace OpenMS
     const ConsensusMap & map_model = reference_;
     ConsensusMap map_scene = map;
 
+    // use local copies of the configured superimposer and pair finder, so that maps can be aligned
+    // to the same reference concurrently (the progress logging state is not thread-safe)
+    PoseClusteringAffineSuperimposer superimposer;
+    superimposer.setParameters(superimposer_.getParameters());
+    superimposer.setLogType(superimposer_.getLogType());
+    StablePairFinder pairfinder;
+    pairfinder.setParameters(pairfinder_.getParameters());
+    pairfinder.setLogType(pairfinder_.getLogType());
+
     // run superimposer to find the global transformation
     TransformationDescription si_trafo;
-    superimposer_.run(map_model, map_scene, si_trafo);
+    superimposer.run(map_model, map_scene, si_trafo);
 
     // apply transformation to consensus features and contained feature
     // handles
@@ -85,7 +94,7 @@ namespace OpenMS
     std::vector<ConsensusMap> input(2);
     input[0] = map_model;
     input[1] = map_scene;
-    pairfinder_.run(input, result);
+    pairfinder.run(input, result);
 
     // calculate the local transformation
     si_trafo.invert(); // to undo the transformation applied above
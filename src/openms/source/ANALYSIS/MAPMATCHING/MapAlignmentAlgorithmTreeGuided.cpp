@@ -22,6 +22,8 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <include/OpenMS/APPLICATIONS/MapAlignerBase.h>
 
+#include <exception>
+
 using namespace std;
 
 namespace OpenMS
@@ -123,7 +125,8 @@ namespace OpenMS
   void MapAlignmentAlgorithmTreeGuided::extractSeqAndRt_(const vector<FeatureMap>& feature_maps,
           vector<SeqAndRTList>& maps_seq_and_rt, vector<vector<double>>& maps_ranges)
   {
-    for (Size i = 0; i < feature_maps.size(); ++i)
+#pragma omp parallel for schedule(dynamic, 1)
+    for (SignedSize i = 0; i < (SignedSize)feature_maps.size(); ++i)
     {
       for (const BaseFeature& bf : feature_maps[i])
       {
@@ -145,9 +148,20 @@ namespace OpenMS
     extractSeqAndRt_(feature_maps, maps_seq_and_rt, maps_ranges);
     PeptideIdentificationsPearsonDistance_ pep_dist;
     AverageLinkage al;
-    DistanceMatrix<float> dist_matrix; // will be filled
     ClusterHierarchical ch;
 
+    // compute the pairwise distances in parallel (ClusterHierarchical only computes them if the matrix is empty)
+    DistanceMatrix<float> dist_matrix(maps_seq_and_rt.size(), 1);
+#pragma omp parallel for schedule(dynamic, 1)
+    for (SignedSize i = 0; i < (SignedSize)maps_seq_and_rt.size(); ++i)
+    {
+      for (SignedSize j = 0; j < i; ++j)
+      {
+        // distance value is 1-similarity value, since similarity is in range of [0,1]
+        dist_matrix.setValueQuick(i, j, 1 - pep_dist(maps_seq_and_rt[i], maps_seq_and_rt[j]));
+      }
+    }
+
     ch.cluster<SeqAndRTList, PeptideIdentificationsPearsonDistance_>(maps_seq_and_rt, pep_dist, al, tree, dist_matrix);
   }
 
@@ -159,8 +173,6 @@ namespace OpenMS
                                                             std::vector<Size>& trafo_order)
   {
     Size last_trafo = 0;  // to get final transformation order from map_sets
-    vector<TransformationDescription> transformations_align;  // temporary for aligner output
-    vector<FeatureMap> to_align;
 
     // helper to memorize rt transformation order
     vector<vector<Size>> map_sets(feature_maps_transformed.size());
@@ -169,9 +181,6 @@ namespace OpenMS
       map_sets[i].push_back(i);
     }
 
-    Size ref;
-    Size to_transform;
-
     // check RT ranges of IDs
     for (size_t i = 0; i < maps_ranges.size(); ++i)
     {
@@ -180,68 +189,137 @@ namespace OpenMS
       if (maps_ranges[i].empty()) throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "FeatureMap originating from '" + ListUtils::concatenate(p, "', '") + "' contains no Peptide Identifications. Cannot align!");
     }
 
-    for (const auto& node : tree)
+    // A node only needs the results of the nodes that last touched its two children, so nodes of the
+    // same level (different subtrees) use disjoint maps and can be aligned in parallel.
+    vector<vector<Size>> levels;
     {
-      // ----------------
-      // prepare alignment
-      // ----------------
-      //  determine the map with larger RT range for 10/90 percentile (->reference)
-      double left_range = maps_ranges[node.left_child][maps_ranges[node.left_child].size()*0.9] - maps_ranges[node.left_child][maps_ranges[node.left_child].size()*0.1];
-      double right_range = maps_ranges[node.right_child][maps_ranges[node.right_child].size()*0.9] - maps_ranges[node.right_child][maps_ranges[node.right_child].size()*0.1];
-
-      if (left_range > right_range)
+      vector<Size> map_level(feature_maps_transformed.size(), 0);
+      for (Size k = 0; k < tree.size(); ++k)
       {
-        ref = node.left_child;
-        to_transform = node.right_child;
+        Size level = max(map_level[tree[k].left_child], map_level[tree[k].right_child]);
+        if (level == levels.size())
+        {
+          levels.emplace_back();
+        }
+        levels[level].push_back(k);
+        map_level[tree[k].left_child] = map_level[tree[k].right_child] = level + 1;
       }
-      else
+    }
+    if (!tree.empty())
+    {
+      // combined maps are stored at the smaller index, because tree always calls smaller number
+      last_trafo = min(tree.back().left_child, tree.back().right_child);
+    }
+
+    std::exception_ptr error;
+    SignedSize error_node = tree.size(); // first node (in tree order) that failed
+    for (const vector<Size>& level_nodes : levels)
+    {
+      // nodes after a failed one are skipped (they might depend on it), as in a sequential run
+      const SignedSize max_node = error_node;
+#pragma omp parallel for schedule(dynamic, 1)
+      for (SignedSize n = 0; n < (SignedSize)level_nodes.size(); ++n)
       {
-        ref = node.right_child;
-        to_transform = node.left_child;
+        const SignedSize k = level_nodes[n];
+        if (k > max_node) continue;
+        try
+        {
+          alignTreeNode_(tree[k], feature_maps_transformed, maps_ranges, map_sets);
+        }
+        catch (...)
+        {
+#pragma omp critical (MapAlignmentAlgorithmTreeGuided_error)
+          if (k < error_node)
+          {
+            error = std::current_exception();
+            error_node = k;
+          }
+        }
       }
+    }
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
 
-      vector<double> tmp;
-      std::merge(maps_ranges[node.right_child].begin(), maps_ranges[node.right_child].end(), maps_ranges[node.left_child].begin(), maps_ranges[node.left_child].end(), std::back_inserter(tmp));
-
-      to_align.push_back(feature_maps_transformed[to_transform]);
-      to_align.push_back(feature_maps_transformed[ref]);
+    // copy last transformed FeatureMap for reference return
+    map_transformed = feature_maps_transformed[last_trafo];
+    trafo_order = map_sets[last_trafo];
+  }
 
-      // ----------------
-      // perform alignment
-      // ----------------
-      align_algorithm_.align(to_align, transformations_align, 1);
+  void MapAlignmentAlgorithmTreeGuided::alignTreeNode_(const BinaryTreeNode& node,
+                                                       std::vector<FeatureMap>& feature_maps_transformed,
+                                                       const std::vector<std::vector<double>>& maps_ranges,
+                                                       std::vector<std::vector<Size>>& map_sets) const
+  {
+    // ----------------
+    // prepare alignment
+    // ----------------
+    //  determine the map with larger RT range for 10/90 percentile (->reference)
+    double left_range = maps_ranges[node.left_child][maps_ranges[node.left_child].size()*0.9] - maps_ranges[node.left_child][maps_ranges[node.left_child].size()*0.1];
+    double right_range = maps_ranges[node.right_child][maps_ranges[node.right_child].size()*0.9] - maps_ranges[node.right_child][maps_ranges[node.right_child].size()*0.1];
 
-      // transform retention times of non-identity for next iteration
-      transformations_align[0].fitModel(model_type_, model_param_);
-      MapAlignmentTransformer::transformRetentionTimes(feature_maps_transformed[to_transform],
-              transformations_align[0], true);
+    Size ref;
+    Size to_transform;
+    if (left_range > right_range)
+    {
+      ref = node.left_child;
+      to_transform = node.right_child;
+    }
+    else
+    {
+      ref = node.right_child;
+      to_transform = node.left_child;
+    }
 
-      // combine aligned maps, store at smaller index, because tree always calls smaller number
-      // clear feature map at larger index to save memory
-      feature_maps_transformed[ref] += feature_maps_transformed[to_transform];
-      feature_maps_transformed[ref].updateRanges();
-      if (ref < to_transform)
-      {
-        feature_maps_transformed[to_transform].clear(true);
-        last_trafo = ref;
-      }
-      else
-      {
-        feature_maps_transformed[to_transform] = feature_maps_transformed[ref];
-        feature_maps_transformed[ref].clear(true);
-        last_trafo = to_transform;
-      }
+    // the aligner stores per-run state, so every node gets its own instance
+    MapAlignmentAlgorithmIdentification align_algorithm;
+    align_algorithm.setParameters(align_algorithm_.getParameters());
 
-      // update order of alignment for both aligned maps
-      map_sets[ref].insert(map_sets[ref].end(), map_sets[to_transform].begin(), map_sets[to_transform].end());
-      map_sets[to_transform] = map_sets[ref];
+    // move (instead of copy) the maps, align() only sorts peptide hits (stable)
+    vector<FeatureMap> to_align(2);
+    to_align[0].swap(feature_maps_transformed[to_transform]);
+    to_align[1].swap(feature_maps_transformed[ref]);
 
-      transformations_align.clear();
-      to_align.clear();
+    // ----------------
+    // perform alignment
+    // ----------------
+    vector<TransformationDescription> transformations_align;  // temporary for aligner output
+    try
+    {
+      align_algorithm.align(to_align, transformations_align, 1);
     }
-    // copy last transformed FeatureMap for reference return
-    map_transformed = feature_maps_transformed[last_trafo];
-    trafo_order = map_sets[last_trafo];
+    catch (...)
+    {
+      feature_maps_transformed[to_transform].swap(to_align[0]);
+      feature_maps_transformed[ref].swap(to_align[1]);
+      throw;
+    }
+    feature_maps_transformed[to_transform].swap(to_align[0]);
+    feature_maps_transformed[ref].swap(to_align[1]);
+
+    // transform retention times of non-identity for next iteration
+    transformations_align[0].fitModel(model_type_, model_param_);
+    MapAlignmentTransformer::transformRetentionTimes(feature_maps_transformed[to_transform],
+            transformations_align[0], true);
+
+    // combine aligned maps, store at smaller index, because tree always calls smaller number
+    // clear feature map at larger index to save memory
+    feature_maps_transformed[ref] += feature_maps_transformed[to_transform];
+    feature_maps_transformed[ref].updateRanges();
+    if (ref < to_transform)
+    {
+      feature_maps_transformed[to_transform].clear(true);
+    }
+    else
+    {
+      feature_maps_transformed[to_transform] = feature_maps_transformed[ref];
+      feature_maps_transformed[ref].clear(true);
+    }
+
+    // update order of alignment for both aligned maps
+    map_sets[ref].insert(map_sets[ref].end(), map_sets[to_transform].begin(), map_sets[to_transform].end());
+    map_sets[to_transform] = map_sets[ref];
   }
 
   void MapAlignmentAlgorithmTreeGuided::align(std::vector<FeatureMap>& feature_maps,
@@ -278,35 +356,63 @@ namespace OpenMS
                                                                   std::vector<TransformationDescription>& transformations,
                                                                   const std::vector<Size>& trafo_order)
   {
-    FeatureMap::const_iterator fit = map_transformed.begin();
-    TransformationDescription::DataPoints trafo_data_tmp;
-    for (auto& map_idx : trafo_order)
+    // the features of each map are stored consecutively (in trafo_order) in map_transformed
+    vector<Size> offsets(trafo_order.size() + 1, 0);
+    for (Size k = 0; k < trafo_order.size(); ++k)
     {
-      for (Size i = 0; i < feature_maps[map_idx].size(); ++i)
+      offsets[k + 1] = offsets[k] + feature_maps[trafo_order[k]].size();
+    }
+
+    // the transformation models are fitted independently for each map
+    std::exception_ptr error;
+    SignedSize error_index = trafo_order.size();
+#pragma omp parallel for schedule(dynamic, 1)
+    for (SignedSize k = 0; k < (SignedSize)trafo_order.size(); ++k)
+    {
+      const Size map_idx = trafo_order[k];
+      TransformationDescription::DataPoints trafo_data_tmp;
+      trafo_data_tmp.reserve(offsets[k + 1] - offsets[k]);
+      for (Size i = offsets[k]; i < offsets[k + 1]; ++i)
       {
+        const Feature& feature = map_transformed[i];
         TransformationDescription::DataPoint point;
-        if (fit->metaValueExists("original_RT"))
+        if (feature.metaValueExists("original_RT"))
         {
-          point.first = fit->getMetaValue("original_RT");
+          point.first = feature.getMetaValue("original_RT");
         }
         else
         {
-          point.first = fit->getRT();
+          point.first = feature.getRT();
         }
-        point.second = fit->getRT();
-        point.note = fit->getUniqueId();
+        point.second = feature.getRT();
+        point.note = feature.getUniqueId();
         trafo_data_tmp.push_back(point);
-        ++fit;
       }
-      transformations[map_idx] = TransformationDescription(trafo_data_tmp);
-      transformations[map_idx].fitModel(model_type_, model_param_);
-      trafo_data_tmp.clear();
+      try
+      {
+        transformations[map_idx] = TransformationDescription(trafo_data_tmp);
+        transformations[map_idx].fitModel(model_type_, model_param_);
+      }
+      catch (...)
+      {
+#pragma omp critical (MapAlignmentAlgorithmTreeGuided_error)
+        if (k < error_index)
+        {
+          error = std::current_exception();
+          error_index = k;
+        }
+      }
+    }
+    if (error)
+    {
+      std::rethrow_exception(error);
     }
   }
 
   void MapAlignmentAlgorithmTreeGuided::computeTransformedFeatureMaps(vector<FeatureMap>& feature_maps, const vector<TransformationDescription>& transformations)
   {
-    for (Size i = 0; i < feature_maps.size(); ++i)
+#pragma omp parallel for schedule(dynamic, 1)
+    for (SignedSize i = 0; i < (SignedSize)feature_maps.size(); ++i)
     {
       MapAlignmentTransformer::transformRetentionTimes(feature_maps[i], transformations[i], true);
     }
@@ -13,6 +13,8 @@
 
 #include <boost/math/special_functions/fpclassify.hpp> // isnan
 
+#include <atomic>
+
 // #define Debug_PoseClusteringAffineSuperimposer
 
 namespace OpenMS
@@ -120,6 +122,10 @@ namespace OpenMS
     round, only consider quadruplets where the scaling factor matches the
     estimated bounds of (scale_low_1,scale_high_1), discard all other data.
 
+    The m/z windows and weights of the points are computed once up front and
+    the first model point (i) is distributed over the available threads;
+    dumping the pairs disables the parallelization.
+
   */
   void affineTransformationHashing(const bool do_dump_pairs,
                                    const std::vector<Peak2D> & model_map,
@@ -139,6 +145,8 @@ namespace OpenMS
                                    const double scale_high_1,
                                    const double rt_low, const double rt_high)
   {
+    typedef Math::LinearInterpolation<double, double> LinearInterpolationType_;
+
     Size const model_map_size = model_map.size();   // i j
     Size const scene_map_size = scene_map.size();   // k l
 
@@ -151,135 +159,204 @@ namespace OpenMS
       dump_pairs_file << "#" << ' ' << "i" << ' ' << "j" << ' ' << "k" << ' ' << "l" << ' ' << std::endl;
     }
 
-    // first point in model map (i)
-    for (Size i = 0, i_low = 0, i_high = 0, k_low = 0, k_high = 0; i < model_map_size - 1; ++i)
+    if (model_map_size < 2)
+    {
+      return;
+    }
+
+    // Plain arrays of the coordinates used in the inner loops
+    std::vector<double> model_rt(model_map_size), model_int(model_map_size);
+    for (Size i = 0; i < model_map_size; ++i)
     {
-      // Adjust window around i in model map (get all features in a m/z range of item i in the model map)
-      while (i_low < model_map_size && model_map[i_low].getMZ() < model_map[i].getMZ() - mz_pair_max_distance)
+      model_rt[i] = model_map[i].getRT();
+      model_int[i] = model_map[i].getIntensity();
+    }
+    std::vector<double> scene_rt(scene_map_size), scene_int(scene_map_size);
+    for (Size k = 0; k < scene_map_size; ++k)
+    {
+      scene_rt[k] = scene_map[k].getRT();
+      scene_int[k] = scene_map[k].getIntensity() * total_intensity_ratio;
+    }
+
+    // For each point of the model map, find the features in a m/z range
+    // around it in the model map and in the scene map (both maps are sorted
+    // by m/z, so the windows move monotonically).  The weight of a point is
+    // inverse proportional to the number of elements with similar m/z; if
+    // there are too many features in a window, the point is not used.
+    // (The window of the second model point j is taken around i like the
+    // one of the first point, so it only depends on i.)
+    std::vector<double> model_winlength_factor(model_map_size);
+    std::vector<double> scene_winlength_factor(model_map_size);
+    std::vector<Size> scene_window_low(model_map_size), scene_window_high(model_map_size);
+    for (Size i = 0, i_low = 0, i_high = 0, k_low = 0, k_high = 0; i < model_map_size; ++i)
+    {
+      const double mz = model_map[i].getMZ();
+      while (i_low < model_map_size && model_map[i_low].getMZ() < mz - mz_pair_max_distance)
         ++i_low;
-      while (i_high < model_map_size && model_map[i_high].getMZ() <= model_map[i].getMZ() + mz_pair_max_distance)
+      while (i_high < model_map_size && model_map[i_high].getMZ() <= mz + mz_pair_max_distance)
         ++i_high;
-      // stop if there are too many features are in our window
-      double i_winlength_factor = 1. / (i_high - i_low);
-      i_winlength_factor -= winlength_factor_baseline;
-      if (i_winlength_factor <= 0)
-        continue;
-
-      // Adjust window around k in scene map (get all features in a m/z range of item i in the scene map)
-      while (k_low < scene_map_size && scene_map[k_low].getMZ() < model_map[i].getMZ() - mz_pair_max_distance)
+      model_winlength_factor[i] = 1. / (i_high - i_low) - winlength_factor_baseline;
+
+      while (k_low < scene_map_size && scene_map[k_low].getMZ() < mz - mz_pair_max_distance)
         ++k_low;
-      while (k_high < scene_map_size && scene_map[k_high].getMZ() <= model_map[i].getMZ() + mz_pair_max_distance)
+      while (k_high < scene_map_size && scene_map[k_high].getMZ() <= mz + mz_pair_max_distance)
         ++k_high;
+      scene_winlength_factor[i] = 1. / (k_high - k_low) - winlength_factor_baseline;
+      scene_window_low[i] = k_low;
+      scene_window_high[i] = k_high;
+    }
 
-      // Iterate through all matching features in the scene map that are
-      // within the m/z distance of item i from the model map.
-      // first point in scene map (k)
-      for (Size k = k_low; k < k_high; ++k)
+    // The votes are collected in separate histograms for fixed blocks of
+    // model points and added up in block order afterwards, so the result does
+    // not depend on the number of threads.
+    const Size block_count = std::min(model_map_size - 1, Size(256));
+    // round 1: scaling; round 2: scaling, rt_low and rt_high
+    std::vector<std::vector<LinearInterpolationType_> > block_hashes(block_count);
+
+#pragma omp parallel for schedule(dynamic, 1) if (!do_dump_pairs)
+    for (SignedSize block = 0; block < (SignedSize)block_count; ++block)
+    {
+      std::vector<LinearInterpolationType_>& hashes = block_hashes[block];
+      if (hashing_round == 1)
+      {
+        hashes.push_back(scaling_hash_1);
+      }
+      else
+      {
+        hashes.push_back(scaling_hash_2);
+        hashes.push_back(rt_low_hash_);
+        hashes.push_back(rt_high_hash_);
+      }
+      for (LinearInterpolationType_& hash : hashes)
       {
-        // stop if there are too many features are in our window
-        double k_winlength_factor = 1. / (k_high - k_low);
-        k_winlength_factor -= winlength_factor_baseline;
+        hash.getData().assign(hash.getData().size(), 0.);
+      }
+
+      const Size i_begin = (model_map_size - 1) * block / block_count;
+      const Size i_end = (model_map_size - 1) * (block + 1) / block_count;
+
+      // first point in model map (i)
+      for (Size i = i_begin; i < i_end; ++i)
+      {
+        // stop if there are too many features in our windows
+        const double i_winlength_factor = model_winlength_factor[i];
+        if (i_winlength_factor <= 0)
+          continue;
+        const double k_winlength_factor = scene_winlength_factor[i];
         if (k_winlength_factor <= 0)
           continue;
 
-        // compute similarity of intensities i k by taking the ratio of the two intensities
-        double similarity_ik;
+        // Iterate through all matching features in the scene map that are
+        // within the m/z distance of item i from the model map.
+        // first point in scene map (k)
+        for (Size k = scene_window_low[i]; k < scene_window_high[i]; ++k)
         {
-          const double int_i = model_map[i].getIntensity();
-          const double int_k = scene_map[k].getIntensity() * total_intensity_ratio;
-          similarity_ik = (int_i < int_k) ? int_i / int_k : int_k / int_i;
-          // weight is inverse proportional to number of elements with similar mz
-          similarity_ik *= i_winlength_factor;
-          similarity_ik *= k_winlength_factor;
-        }
+          // compute similarity of intensities i k by taking the ratio of the two intensities
+          double similarity_ik;
+          {
+            const double int_i = model_int[i];
+            const double int_k = scene_int[k];
+            similarity_ik = (int_i < int_k) ? int_i / int_k : int_k / int_i;
+            // weight is inverse proportional to number of elements with similar mz
+            similarity_ik *= i_winlength_factor;
+            similarity_ik *= k_winlength_factor;
+          }
 
-        // second point in model map (j)
-        for (Size j = i + 1, j_low = i_low, j_high = i_low, l_low = k_low, l_high = k_high; j < model_map_size; ++j)
-        {
-          // diff in model map -> skip features that are too far away in RT
-          double diff_model = model_map[j].getRT() - model_map[i].getRT();
-          if (fabs(diff_model) < rt_pair_min_distance)
-            continue;
-
-          // Adjust window around j in model map
-          while (j_low < model_map_size && model_map[j_low].getMZ() < model_map[i].getMZ() - mz_pair_max_distance)
-            ++j_low;
-          while (j_high < model_map_size && model_map[j_high].getMZ() <= model_map[i].getMZ() + mz_pair_max_distance)
-            ++j_high;
-          double j_winlength_factor = 1. / (j_high - j_low);
-          j_winlength_factor -= winlength_factor_baseline;
-          if (j_winlength_factor <= 0)
-            continue;
-
-          // Adjust window around l in scene map
-          while (l_low < scene_map_size && scene_map[l_low].getMZ() < model_map[j].getMZ() - mz_pair_max_distance)
-            ++l_low;
-          while (l_high < scene_map_size && scene_map[l_high].getMZ() <= model_map[j].getMZ() + mz_pair_max_distance)
-            ++l_high;
-
-          // second point in scene map (l)
-          for (Size l = l_low; l < l_high; ++l)
+          // second point in model map (j)
+          for (Size j = i + 1; j < model_map_size; ++j)
           {
-            double l_winlength_factor = 1. / (l_high - l_low);
-            l_winlength_factor -= winlength_factor_baseline;
-            if (l_winlength_factor <= 0)
+            // diff in model map -> skip features that are too far away in RT
+            const double diff_model = model_rt[j] - model_rt[i];
+            if (fabs(diff_model) < rt_pair_min_distance)
               continue;
 
-            // diff in scene map -> skip features that are too far away in RT
-            double diff_scene = scene_map[l].getRT() - scene_map[k].getRT();
-
-            // avoid cross mappings (i,j) -> (k,l) (e.g. i_rt < j_rt and k_rt > l_rt)
-            // and point pairs with equal retention times (e.g. i_rt == j_rt)
-            if (fabs(diff_scene) < rt_pair_min_distance || ((diff_model > 0) != (diff_scene > 0)))
+            const double l_winlength_factor = scene_winlength_factor[j];
+            if (l_winlength_factor <= 0)
               continue;
 
-            // compute the transformation (i,j) -> (k,l)
-            double scaling = diff_model / diff_scene;
-            double shift = model_map[i].getRT() - scene_map[k].getRT() * scaling;
-
-            // compute similarity of intensities i k j l
-            double similarity_ik_jl;
+            // second point in scene map (l)
+            for (Size l = scene_window_low[j]; l < scene_window_high[j]; ++l)
             {
-              // compute similarity of intensities j l
-              const double int_j = model_map[j].getIntensity();
-              const double int_l = scene_map[l].getIntensity() * total_intensity_ratio;
-              double similarity_jl = (int_j < int_l) ? int_j / int_l : int_l / int_j;
-              // weight is inverse proportional to number of elements with similar mz
-              similarity_jl *= j_winlength_factor;
-              similarity_jl *= l_winlength_factor;
-              similarity_ik_jl = similarity_ik * similarity_jl;
-            }
-
-            // hash the images of scaling, rt_low and rt_high into their respective hash tables
-            // store the scaling parameter and the (estimated) transformation of start/end of the maps in hashes
-            //   -> in round 2, discard values outside of scale_low_1 and
-            //   scale_high_1 (estimated before in scalingEstimate)
-            if (hashing_round == 1)
-            {
-              // hashing round 1 (estimate the scaling only)
-              scaling_hash_1.addValue(log(scaling), similarity_ik_jl);
-            }
-            else if (scaling >= scale_low_1 && scaling <= scale_high_1)
-            {
-              // hashing round 2 (estimate scaling and shift)
-              scaling_hash_2.addValue(log(scaling), similarity_ik_jl);
+              // diff in scene map -> skip features that are too far away in RT
+              const double diff_scene = scene_rt[l] - scene_rt[k];
 
-              const double rt_low_image = shift + rt_low * scaling;
-              rt_low_hash_.addValue(rt_low_image, similarity_ik_jl);
-              const double rt_high_image = shift + rt_high * scaling;
-              rt_high_hash_.addValue(rt_high_image, similarity_ik_jl);
+              // avoid cross mappings (i,j) -> (k,l) (e.g. i_rt < j_rt and k_rt > l_rt)
+              // and point pairs with equal retention times (e.g. i_rt == j_rt)
+              if (fabs(diff_scene) < rt_pair_min_distance || ((diff_model > 0) != (diff_scene > 0)))
+                continue;
 
-              if (do_dump_pairs)
+              // compute the transformation (i,j) -> (k,l)
+              const double scaling = diff_model / diff_scene;
+              const double shift = model_rt[i] - scene_rt[k] * scaling;
+
+              // compute similarity of intensities i k j l
+              double similarity_ik_jl;
               {
-                dump_pairs_file << i << ' ' << model_map[i].getRT() << ' ' << model_map[i].getMZ() << ' ' << j << ' ' << model_map[j].getRT() << ' '
-                                << model_map[j].getMZ() << ' ' << k << ' ' << scene_map[k].getRT() << ' ' << scene_map[k].getMZ() << ' ' << l << ' '
-                                << scene_map[l].getRT() << ' ' << scene_map[l].getMZ() << ' ' << similarity_ik_jl << ' ' << std::endl;
+                // compute similarity of intensities j l
+                const double int_j = model_int[j];
+                const double int_l = scene_int[l];
+                double similarity_jl = (int_j < int_l) ? int_j / int_l : int_l / int_j;
+                // weight is inverse proportional to number of elements with similar mz
+                similarity_jl *= i_winlength_factor;
+                similarity_jl *= l_winlength_factor;
+                similarity_ik_jl = similarity_ik * similarity_jl;
               }
-            }
-          }   // l
-        }   // j
-      }   // k
-    }   // i
+
+              // hash the images of scaling, rt_low and rt_high into their respective hash tables
+              // store the scaling parameter and the (estimated) transformation of start/end of the maps in hashes
+              //   -> in round 2, discard values outside of scale_low_1 and
+              //   scale_high_1 (estimated before in scalingEstimate)
+              if (hashing_round == 1)
+              {
+                // hashing round 1 (estimate the scaling only)
+                hashes[0].addValue(log(scaling), similarity_ik_jl);
+              }
+              else if (scaling >= scale_low_1 && scaling <= scale_high_1)
+              {
+                // hashing round 2 (estimate scaling and shift)
+                hashes[0].addValue(log(scaling), similarity_ik_jl);
+
+                const double rt_low_image = shift + rt_low * scaling;
+                hashes[1].addValue(rt_low_image, similarity_ik_jl);
+                const double rt_high_image = shift + rt_high * scaling;
+                hashes[2].addValue(rt_high_image, similarity_ik_jl);
+
+                if (do_dump_pairs)
+                {
+                  dump_pairs_file << i << ' ' << model_map[i].getRT() << ' ' << model_map[i].getMZ() << ' ' << j << ' ' << model_map[j].getRT() << ' '
+                                  << model_map[j].getMZ() << ' ' << k << ' ' << scene_map[k].getRT() << ' ' << scene_map[k].getMZ() << ' ' << l << ' '
+                                  << scene_map[l].getRT() << ' ' << scene_map[l].getMZ() << ' ' << similarity_ik_jl << ' ' << std::endl;
+                }
+              }
+            }   // l
+          }   // j
+        }   // k
+      }   // i
+    }
+
+    // add up the votes of all blocks
+    std::vector<LinearInterpolationType_*> targets;
+    if (hashing_round == 1)
+    {
+      targets = {&scaling_hash_1};
+    }
+    else
+    {
+      targets = {&scaling_hash_2, &rt_low_hash_, &rt_high_hash_};
+    }
+    for (std::vector<LinearInterpolationType_>& hashes : block_hashes)
+    {
+      for (Size h = 0; h < targets.size(); ++h)
+      {
+        std::vector<double>& target = targets[h]->getData();
+        const std::vector<double>& votes = hashes[h].getData();
+        for (Size b = 0; b < target.size(); ++b)
+        {
+          target[b] += votes[b];
+        }
+      }
+      hashes.clear();
+    }
   }
 
   /**
@@ -876,8 +953,9 @@ namespace OpenMS
 
     // The serial number is incremented for each invocation of this, to avoid
     // overwriting of hash table dumps.
-    static Int dump_buckets_serial = 0;
-    ++dump_buckets_serial;
+    // (atomic, since different maps may be superimposed concurrently)
+    static std::atomic<Int> dump_buckets_counter(0);
+    const Int dump_buckets_serial = ++dump_buckets_counter;
 
     //**************************************************************************
     // Step 4: Hashing
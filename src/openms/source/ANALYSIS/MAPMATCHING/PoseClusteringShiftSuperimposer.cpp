@@ -12,6 +12,8 @@
 #include <OpenMS/DATASTRUCTURES/ConstRefVector.h>
 #include <OpenMS/ML/INTERPOLATION/LinearInterpolation.h>
 
+#include <atomic>
+
 // #define Debug_PoseClusteringShiftSuperimposer
 #ifdef Debug_PoseClusteringShiftSuperimposer
 #define V_(bla) std::cout << __FILE__ ":" << __LINE__ << ": " << bla << std::endl;
@@ -206,8 +208,9 @@ namespace OpenMS
     setProgress((actual_progress = 20));
 
     /// The serial number is incremented for each invocation of this, to avoid overwriting of hash table dumps.
-    static Int dump_buckets_serial = 0;
-    ++dump_buckets_serial;
+    // (atomic, since different maps may be superimposed concurrently)
+    static std::atomic<Int> dump_buckets_counter(0);
+    const Int dump_buckets_serial = ++dump_buckets_counter;
 
     //**************************************************************************
     // Hashing
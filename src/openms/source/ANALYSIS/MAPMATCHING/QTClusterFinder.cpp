@@ -14,6 +14,7 @@
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <OpenMS/KERNEL/FeatureHandle.h>
 #include <OpenMS/MATH/MathFunctions.h>
+#include <exception>
 
 //#define DEBUG_QTCLUSTERFINDER_IDS
 
@@ -367,7 +368,7 @@ namespace OpenMS
     // create the hash grid and fill it with features:
     // std::cout << "Hashing..." << std::endl;
     list<OpenMS::GridFeature> grid_features;
-    Grid grid(Grid::ClusterCenter(max_diff_rt_, max_diff_mz_));
+    vector<Grid::value_type> grid_elements;
     for (Size map_index = 0; map_index < num_maps_; ++map_index)
     {
       for (Size feature_index = 0; feature_index < input_maps[map_index].size();
@@ -383,10 +384,11 @@ namespace OpenMS
         {
           pep.sort();
         }
-        grid.insert(make_pair(Grid::ClusterCenter(gfeat.getRT(), gfeat.getMZ()),
-                              &gfeat));
+        grid_elements.emplace_back(Grid::ClusterCenter(gfeat.getRT(), gfeat.getMZ()),
+                                   &gfeat);
       }
     }
+    const Grid grid(Grid::ClusterCenter(max_diff_rt_, max_diff_mz_), std::move(grid_elements));
 
     // compute QT clustering:
     // std::cout << "Clustering..." << std::endl;
@@ -555,82 +557,140 @@ void QTClusterFinder::createConsensusFeature_(ConsensusFeature& feature,
     // we cannot pop at the end since update_lazy may theoretically change top_element immediately.
     cluster_heads.pop();
 
-    for (const auto& element : elements)
+    // Collect all clusters that may potentially need updating, i.e. clusters that contain a feature of
+    // the current best cluster, in the order in which they would be updated one after the other.
+    // Every cluster only needs to be updated once: afterwards it cannot contain any of these features.
+    vector<vector<Size>> ids_per_element(elements.size());
+    vector<Size> update_ids;
+    unordered_set<Size> update_id_set;
+    for (Size e = 0; e < elements.size(); ++e)
     {
-      const GridFeature* const curr_feature = element.feature;
-
       // ids of clusters the current feature belonged to
-      unordered_set<Size>& cluster_ids = element_mapping[curr_feature];
+      unordered_set<Size>& cluster_ids = element_mapping[elements[e].feature];
 
       // delete the id of the current best cluster
       // we do not want to unnecessarily update it in the loop below
       cluster_ids.erase(best_id);
 
-      // Identify all features that could potentially have been touched by this
-      // Get all clusters that may potentially need updating
+      for (const Size curr_id : cluster_ids)
+      {
+        if (update_id_set.insert(curr_id).second)
+        {
+          ids_per_element[e].push_back(curr_id);
+          update_ids.push_back(curr_id);
+        }
+      }
+    }
 
-      ElementMapping tmp_element_mapping; // modify copy, then update
+    // Step 1: update the clusters in parallel. This works on copies of the cluster heads (the bulk data
+    // of different clusters is independent), so the heap does not see any changes until step 2.
+    vector<QTCluster> updated;
+    updated.reserve(update_ids.size());
+    for (const Size curr_id : update_ids)
+    {
+      updated.push_back(*handles[curr_id]);
+    }
+    // elements of changed clusters before new elements were added (empty if unchanged)
+    vector<QTCluster::Elements> removed_elements(update_ids.size());
+    vector<char> changed(update_ids.size(), false);
 
-      for (const Size curr_id : cluster_ids)
+    std::exception_ptr error;
+    SignedSize error_index = 0;
+#pragma omp parallel if (update_ids.size() > 1)
+    {
+      // the distance functor caches normalization factors, so every thread needs its own
+      FeatureDistance feature_distance = feature_distance_;
+
+#pragma omp for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)update_ids.size(); ++i)
       {
-        QTCluster& cluster = *handles[curr_id]; 
+        QTCluster& cluster = updated[i];
 
         // we do not want to update invalid features
         // (saves time and does not recompute the quality)
-        if (!cluster.isInvalid())
+        // remove the elements of the new feature from the cluster
+        if (cluster.isInvalid() || !cluster.update(elements))
+        {
+          continue;
+        }
+        // If update returns true, it means that at least one element was
+        // removed from the cluster and we need to update that cluster
+        try
+        {
+          /*
+          Before re-adding elements, we must remember the remaining elements of the cluster,
+          to delete this clusters id from the element mapping for them (important!; in step 2).
+          It is possible that addClusterElements_() removes features from the cluster 
+          we are updating. (Through finalizeCluster_ -> computeQuality_ -> optimizeAnnotations).
+          These are not to be confused with the features we removed
+          because they are part of the current best cluster. Those are removed in 
+          QTCluster::update (above).
+
+          If this happens, the element mapping for the additionally removed features 
+          (which are valid and unused!) still contains the id of the cluster which 
+          we are currently updating. But the cluster does not contain the feature anymore. 
+          When the cluster is deleted, the element mapping for the removed feature doesn't 
+          get updated. The element mapping for the feature then contains an id of a 
+          deleted cluster, which will surely lead to a segfault when the feature is actually 
+          used in another cluster later.
+
+          TODO Check guarantee that addClusterElements does not add a feature that was removed
+           earlier in the loop. Should not happen because they are in the already_used set by now.
+          */
+          changed[i] = true;
+          removed_elements[i] = cluster.getElements();
+
+          // re-add closest cluster elements that were not used yet.
+          addClusterElements_(grid, cluster, feature_distance);
+        }
+        catch (...)
+        {
+#pragma omp critical (QTClusterFinder_error)
+          if (!error || i < error_index) // report the first error, as a sequential run would
+          {
+            error = std::current_exception();
+            error_index = i;
+          }
+        }
+      }
+    }
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+
+    // Step 2: write the updated clusters back (in the same order as step 1 would have processed them
+    // sequentially) and reinsert the updated cluster's features into the element mapping.
+    Size i = 0;
+    for (const vector<Size>& cluster_ids : ids_per_element)
+    {
+      ElementMapping tmp_element_mapping; // modify copy, then update
+
+      for (const Size curr_id : cluster_ids)
+      {
+        *handles[curr_id] = updated[i];
+        if (changed[i])
         {
-          // remove the elements of the new feature from the cluster
+          // see removeFromElementMapping_()
+          for (const auto& element : removed_elements[i])
+          {
+            element_mapping[element.feature].erase(curr_id);
+          }
 
-          if (cluster.update(elements))
+          // update the heap, because the quality has changed
+          // compares with top_element to see if a different node needs to be popped now.
+          // for comparison getQuality() is called for the clusters here
+          // TODO check if we can guarantee cluster_heads.increase/decrease since they may have
+          //  better theoretical runtimes although a lazy update until the next pop is probably not bad
+          cluster_heads.update_lazy(handles[curr_id]);
+
+          // reinsert the updated cluster's features into a temporary element mapping.
+          for (const auto& neighbor : (*handles[curr_id]).getElements())
           {
-            // If update returns true, it means that at least one element was
-            // removed from the cluster and we need to update that cluster
-
-            /*
-            ////////////////////////////////////////
-            Step 1: Iterate through all neighboring grid features and try to
-            add elements to the current cluster to replace the ones we just
-            removed
-
-            Before that we must delete this clusters id from the element mapping. (important!)
-            It is possible that addClusterElements_() removes features from the cluster 
-            we are updating. (Through finalizeCluster_ -> computeQuality_ -> optimizeAnnotations).
-            These are not to be confused with the features we removed
-            because they are part of the current best cluster. Those are removed in 
-            QTCluster::update (above).
-
-            If this happens, the element mapping for the additionally removed features 
-            (which are valid and unused!) still contains the id of the cluster which 
-            we are currently updating. But the cluster does not contain the feature anymore. 
-            When the cluster is deleted, the element mapping for the removed feature doesn't 
-            get updated. The element mapping for the feature then contains an id of a 
-            deleted cluster, which will surely lead to a segfault when the feature is actually 
-            used in another cluster later.
-
-            TODO Check guarantee that addClusterElements does not add a feature that was removed
-             earlier in the loop. Should not happen because they are in the already_used set by now.
-            */
-            removeFromElementMapping_(cluster, element_mapping);
-
-            // re-add closest cluster elements that were not used yet.
-            addClusterElements_(grid, cluster);
-
-            // update the heap, because the quality has changed
-            // compares with top_element to see if a different node needs to be popped now.
-            // for comparison getQuality() is called for the clusters here
-            // TODO check if we can guarantee cluster_heads.increase/decrease since they may have
-            //  better theoretical runtimes although a lazy update until the next pop is probably not bad
-            cluster_heads.update_lazy(handles[curr_id]);
-
-            ////////////////////////////////////////
-            // Step 2: reinsert the updated cluster's features into a temporary element mapping.
-            // This can be merged later since the methods called in the loop here seem not to access the mapping.
-            for (const auto& neighbor : cluster.getElements())
-            {
-              tmp_element_mapping[neighbor.feature].insert(curr_id);
-            }
+            tmp_element_mapping[neighbor.feature].insert(curr_id);
           }
         }
+        ++i;
       }
 
       // we merge the tmp_element_mapping into the element_mapping after all clusters
@@ -646,7 +706,7 @@ void QTClusterFinder::createConsensusFeature_(ConsensusFeature& feature,
     }
   }
 
-  void QTClusterFinder::addClusterElements_(const Grid& grid, QTCluster& cluster)
+  void QTClusterFinder::addClusterElements_(const Grid& grid, QTCluster& cluster, FeatureDistance& feature_distance) const
   {
     cluster.initializeCluster();
 
@@ -662,57 +722,44 @@ void QTClusterFinder::createConsensusFeature_(ConsensusFeature& feature,
     const int y = cluster.getYCoord(); 
     const GridFeature* center_feature = cluster.getCenterPoint();
 
-    // iterate over neighboring grid cells (1st dimension):
-    for (int i = x - 1; i <= x + 1; ++i)
+    // iterate over the features in the neighboring grid cells:
+    grid.forEachNeighbor(Grid::CellIndex(x, y), [&](const Grid::value_type& element)
     {
-      // iterate over neighboring grid cells (2nd dimension):
-      for (int j = y - 1; j <= y + 1; ++j)
-      {
-        auto act_pos = grid.grid_find(Grid::CellIndex(i, j));
-
-        if (act_pos != grid.grid_end())
-        {
-          for (Grid::const_cell_iterator it_cell = act_pos->second.begin();
-               it_cell != act_pos->second.end(); ++it_cell)
-          {
-            OpenMS::GridFeature* neighbor_feature = it_cell->second;
+      OpenMS::GridFeature* neighbor_feature = element.second;
 
 #ifdef DEBUG_QTCLUSTERFINDER
-            std::cout << " considering to add feature " << neighbor_feature->getFeature().getUniqueId() << " to cluster " <<  center_feature->getFeature().getUniqueId()<< std::endl;
+      std::cout << " considering to add feature " << neighbor_feature->getFeature().getUniqueId() << " to cluster " <<  center_feature->getFeature().getUniqueId()<< std::endl;
 #endif
 
-            // Skip features that we have already used -> we cannot add them to
-            // be neighbors any more
-            if (already_used_.find(neighbor_feature) != already_used_.end() )
-            {
-              continue;
-            }
+      // Skip features that we have already used -> we cannot add them to
+      // be neighbors any more
+      if (already_used_.find(neighbor_feature) != already_used_.end() )
+      {
+        return;
+      }
 
-            // consider only "real" neighbors, not the element itself:
-            if (center_feature != neighbor_feature)
-            {
-              // NOTE: this actually caches the distance -> memory problem
-              double dist = getDistance_(center_feature, neighbor_feature);
+      // consider only "real" neighbors, not the element itself:
+      if (center_feature != neighbor_feature)
+      {
+        // NOTE: this actually caches the distance -> memory problem
+        double dist = getDistance_(feature_distance, center_feature, neighbor_feature);
 
-              if (dist == FeatureDistance::infinity)
-              {
-                continue; // conditions not satisfied
-              }
-              // if IDs are used during linking, check if unidentified features are too far off from "usual" RT shifts
-              // in that region
-              if (use_IDs_ && neighbor_feature->getAnnotations().empty())
-              {
-                double rt_dist = std::fabs(neighbor_feature->getRT() - center_feature->getRT());
-                if (distIsOutlier_(rt_dist, center_feature->getRT())) continue;
-                dist += noID_penalty_;
-              }
-              // if neighbor point is a possible cluster point, add it:
-              cluster.add(neighbor_feature, dist);
-            }
-          }
+        if (dist == FeatureDistance::infinity)
+        {
+          return; // conditions not satisfied
+        }
+        // if IDs are used during linking, check if unidentified features are too far off from "usual" RT shifts
+        // in that region
+        if (use_IDs_ && neighbor_feature->getAnnotations().empty())
+        {
+          double rt_dist = std::fabs(neighbor_feature->getRT() - center_feature->getRT());
+          if (distIsOutlier_(rt_dist, center_feature->getRT())) return;
+          dist += noID_penalty_;
         }
+        // if neighbor point is a possible cluster point, add it:
+        cluster.add(neighbor_feature, dist);
       }
-    }
+    });
 
     cluster.finalizeCluster();
 
@@ -773,43 +820,80 @@ void QTClusterFinder::createConsensusFeature_(ConsensusFeature& feature,
     const double max_distance = 1.0 + noID_penalty_;
 
     // iterate over all grid cells:
-    for (Grid::const_iterator it = grid.begin(); it != grid.end(); ++it)
+    std::vector<QTCluster> clusters;
+    clusters.reserve(grid.size());
+    for (const Grid::Cell& cell : grid.getCells())
     {
-      const Grid::CellIndex& act_coords = it.index();
-      const Int x = act_coords[0], y = act_coords[1];
+      const Int x = cell.index[0], y = cell.index[1];
 
-      const OpenMS::GridFeature* const center_feature = it->second;
+      for (Size e = cell.begin; e < cell.end; ++e)
+      {
+        const OpenMS::GridFeature* const center_feature = grid.getElements()[e].second;
 
-      // construct empty data body for the new cluster and create the head afterwards
-      cluster_data.emplace_back(center_feature, num_maps_, 
-                                max_distance, x, y, id);
+        // construct empty data body for the new cluster and create the head afterwards
+        cluster_data.emplace_back(center_feature, num_maps_, 
+                                  max_distance, x, y, id);
       
-      QTCluster cluster(&cluster_data.back(), use_IDs_);
+        clusters.emplace_back(&cluster_data.back(), use_IDs_);
 
-      addClusterElements_(grid, cluster);
+        // next cluster gets the next id
+        ++id;
+      }
+    }
+
+    // fill the clusters (independent of each other, as long as already_used_ does not change)
+    std::exception_ptr error;
+    SignedSize error_index = 0;
+#pragma omp parallel
+    {
+      // the distance functor caches normalization factors, so every thread needs its own
+      FeatureDistance feature_distance = feature_distance_;
 
+#pragma omp for schedule(dynamic, 100)
+      for (SignedSize i = 0; i < (SignedSize)clusters.size(); ++i)
+      {
+        try
+        {
+          addClusterElements_(grid, clusters[i], feature_distance);
+        }
+        catch (...)
+        {
+#pragma omp critical (QTClusterFinder_error)
+          if (!error || i < error_index) // report the first error, as a sequential run would
+          {
+            error = std::current_exception();
+            error_index = i;
+          }
+        }
+      }
+    }
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+
+    for (const QTCluster& cluster : clusters)
+    {
       // push the cluster head of the new cluster into the heap
       // and the returned handle into our handle vector
       handles.push_back(cluster_heads.push(cluster));
 
       // register the new cluster for all its elements in the element mapping
-      for (const auto& element : (*handles.back()).getElements())
+      for (const auto& element : cluster.getElements())
       {
-        element_mapping[element.feature].insert(id);
+        element_mapping[element.feature].insert(cluster.getId());
       }
-
-      // next cluster gets the next id
-      ++id;
     }
   }
 
-  double QTClusterFinder::getDistance_(const OpenMS::GridFeature* left,
-                                       const OpenMS::GridFeature* right)
+  double QTClusterFinder::getDistance_(FeatureDistance& feature_distance,
+                                       const OpenMS::GridFeature* left,
+                                       const OpenMS::GridFeature* right) const
   {
-    return feature_distance_(left->getFeature(), right->getFeature()).second;
+    return feature_distance(left->getFeature(), right->getFeature()).second;
   }
 
-  bool QTClusterFinder::distIsOutlier_(double dist, double rt)
+  bool QTClusterFinder::distIsOutlier_(double dist, double rt) const
   {
     if (bin_tolerances_.empty()) return false;
     auto it = bin_tolerances_.upper_bound(rt);
@@ -61,6 +61,14 @@ namespace OpenMS
     return value;
   }
 
+  void TransformationModel::evaluate(std::vector<double>& values) const
+  {
+    for (double& value : values)
+    {
+      value = evaluate(value);
+    }
+  }
+
   const Param& TransformationModel::getParameters() const
   {
     return params_;
@@ -15,6 +15,7 @@
 // Spline2dInterpolator
 #include <OpenMS/MATH/MISC/CubicSpline2d.h>
 
+#include <limits>
 #include <numeric>
 
 // AkimaInterpolator
@@ -47,6 +48,11 @@ public:
       return spline_->eval(x);
     }
 
+    void eval(std::vector<double>& x) const override
+    {
+      spline_->eval(x);
+    }
+
     ~Spline2dInterpolator() override
     {
       delete spline_;
@@ -80,6 +86,8 @@ public:
       return (* interpolator_)(x);
     }
 
+    using TransformationModelInterpolated::Interpolator::eval;
+
     ~AkimaInterpolator() override
     {
       delete interpolator_;
@@ -139,6 +147,40 @@ public:
       }
     }
 
+    void eval(std::vector<double>& x) const override
+    {
+      // same as above, but the search for the nearest pair of points
+      // continues from the previous position if the positions are increasing
+      Size idx = 0; // position of the upper bound of the previous position
+      double previous = -std::numeric_limits<double>::infinity();
+      for (double& value : x)
+      {
+        if (value >= previous)
+        {
+          while (idx < x_.size() && x_[idx] <= value) ++idx;
+        }
+        else
+        {
+          idx = std::upper_bound(x_.begin(), x_.begin() + idx, value) - x_.begin();
+        }
+        previous = value;
+
+        if (idx == x_.size())
+        {
+          value = y_.back();
+        }
+        else
+        {
+          const double x_0 = x_[idx - 1];
+          const double x_1 = x_[idx];
+          const double y_0 = y_[idx - 1];
+          const double y_1 = y_[idx];
+
+          value = y_0 + (y_1 - y_0) * (value - x_0) / (x_1 - x_0);
+        }
+      }
+    }
+
     ~LinearInterpolator() override
     = default;
 
@@ -393,6 +435,37 @@ private:
     return interp_->eval(value);
   }
 
+  void TransformationModelInterpolated::evaluate(std::vector<double>& values) const
+  {
+    // extrapolate directly, collect the values to interpolate for a single
+    // call of the interpolator
+    std::vector<double> inside;
+    std::vector<Size> inside_pos;
+    for (Size i = 0; i < values.size(); ++i)
+    {
+      const double value = values[i];
+      if (value < x_.front()) // extrapolate front
+      {
+        values[i] = lm_front_->evaluate(value);
+      }
+      else if (value > x_.back()) // extrapolate back
+      {
+        values[i] = lm_back_->evaluate(value);
+      }
+      else
+      {
+        inside.push_back(value);
+        inside_pos.push_back(i);
+      }
+    }
+    // interpolate:
+    interp_->eval(inside);
+    for (Size i = 0; i < inside.size(); ++i)
+    {
+      values[inside_pos[i]] = inside[i];
+    }
+  }
+
   void TransformationModelInterpolated::getDefaultParameters(Param& params)
   {
     params.clear();
@@ -98,6 +98,24 @@ namespace OpenMS
     return eval;
   }
 
+  void TransformationModelLinear::evaluate(std::vector<double>& values) const
+  {
+    if (!weighting_)
+    {
+      const double slope = slope_, intercept = intercept_;
+      for (double& value : values)
+      {
+        value = slope * value + intercept;
+      }
+      return;
+    }
+
+    for (double& value : values)
+    {
+      value = TransformationModelLinear::evaluate(value);
+    }
+  }
+
   void TransformationModelLinear::invert()
   {
     if (slope_ == 0)
@@ -11,16 +11,24 @@
 #include <OpenMS/DATASTRUCTURES/String.h>
 
 #include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/KERNEL/ColumnarSpectrum.h>
+
+#include <algorithm>
+#include <exception>
 #include <iostream>
+#include <limits>
 
 namespace OpenMS
 {
 
-  void ChromatogramExtractorAlgorithm::extract_value_tophat(
-      const std::vector<double>::const_iterator& mz_start,
-            std::vector<double>::const_iterator& mz_it,
-      const std::vector<double>::const_iterator& mz_end,
-            std::vector<double>::const_iterator& int_it,
+  namespace
+  {
+
+  template <typename MZIterator, typename IntIterator>
+  void extractValueTophat_(const MZIterator& mz_start,
+                                 MZIterator& mz_it,
+                           const MZIterator& mz_end,
+                                 IntIterator& int_it,
       const double mz,
       double& integrated_intensity,
       const double mz_extraction_window,
@@ -45,8 +53,8 @@ namespace OpenMS
       right = mz + mz_extraction_window / 2.0;
     }
 
-    std::vector<double>::const_iterator mz_walker;
-    std::vector<double>::const_iterator int_walker;
+    MZIterator mz_walker;
+    IntIterator int_walker;
 
     // advance the mz / int iterator until we hit the m/z value of the next transition
     while (mz_it != mz_end && (*mz_it) < mz)
@@ -118,12 +126,12 @@ namespace OpenMS
     }
   }
 
-  void ChromatogramExtractorAlgorithm::extract_value_tophat(
-      const std::vector<double>::const_iterator& mz_start,
-            std::vector<double>::const_iterator& mz_it,
-      const std::vector<double>::const_iterator& mz_end,
-            std::vector<double>::const_iterator& int_it,
-            std::vector<double>::const_iterator& im_it,
+  template <typename MZIterator, typename IntIterator, typename IMIterator>
+  void extractValueTophat_(const MZIterator& mz_start,
+                                 MZIterator& mz_it,
+                           const MZIterator& mz_end,
+                                 IntIterator& int_it,
+                                 IMIterator& im_it,
       const double mz,
       const double im,
       double& integrated_intensity,
@@ -158,9 +166,9 @@ namespace OpenMS
     double left_im  = im - im_extraction_window / 2.0;
     double right_im = im + im_extraction_window / 2.0;
 
-    std::vector<double>::const_iterator mz_walker;
-    std::vector<double>::const_iterator im_walker;
-    std::vector<double>::const_iterator int_walker;
+    MZIterator mz_walker;
+    IMIterator im_walker;
+    IntIterator int_walker;
 
     // advance the mz / int iterator until we hit the m/z value of the next transition
     while (mz_it != mz_end && (*mz_it) < mz)
@@ -241,34 +249,158 @@ namespace OpenMS
     }
   }
 
-  void ChromatogramExtractorAlgorithm::extractChromatograms(const OpenSwath::SpectrumAccessPtr& input,
-      std::vector< OpenSwath::ChromatogramPtr >& output,
-      const std::vector<ExtractionCoordinates>& extraction_coordinates,
-      double mz_extraction_window,
-      bool ppm,
-      double im_extraction_window,
-      const String& filter)
+  /**
+   * @brief Extract all coordinates from a single spectrum and append the result to the output chromatograms
+   *
+   * The spectrum is given as contiguous m/z, intensity and (if @p has_im) ion
+   * mobility columns of length @p size. All extraction windows are processed
+   * in a single merge-style pass: since the coordinates are sorted by m/z,
+   * the left window boundaries are non-decreasing (also for ppm windows) and
+   * the first peak inside the current window is found by a binary search
+   * which starts at the first peak of the previous window. Each window then
+   * sums the peaks with left < m/z < right (and, if ion mobility is used,
+   * left_im < IM < right_im).
+  */
+  template <typename IntType, typename IMType>
+  void extractSpectrum_(const double* mz,
+                        const IntType* intensity,
+                        const IMType* im,
+                        const Size size,
+                        const bool has_im,
+                        const double current_rt,
+                        std::vector< OpenSwath::ChromatogramPtr >& output,
+                        const std::vector<ChromatogramExtractorAlgorithm::ExtractionCoordinates>& extraction_coordinates,
+                        const double mz_extraction_window,
+                        const bool ppm,
+                        const double im_extraction_window,
+                        const int used_filter)
   {
-    Size input_size = input->getNrSpectra();
-    if (input_size < 1)
+    const double* const mz_end = mz + size;
+    // first peak with m/z > left of the previous window
+    const double* lower = mz;
+
+    for (Size k = 0; k < extraction_coordinates.size(); ++k)
     {
-      return;
+      const ChromatogramExtractorAlgorithm::ExtractionCoordinates& coord = extraction_coordinates[k];
+      if (coord.rt_end - coord.rt_start > 0 &&
+           (current_rt < coord.rt_start || current_rt > coord.rt_end) )
+      {
+        continue;
+      }
+
+      if (used_filter == 2)
+      {
+        throw Exception::NotImplemented(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
+      }
+
+      // calculate extraction window
+      double left, right;
+      if (ppm)
+      {
+        left  = coord.mz - coord.mz * mz_extraction_window / 2.0 * 1.0e-6;
+        right = coord.mz + coord.mz * mz_extraction_window / 2.0 * 1.0e-6;
+      }
+      else
+      {
+        left  = coord.mz - mz_extraction_window / 2.0;
+        right = coord.mz + mz_extraction_window / 2.0;
+      }
+
+      lower = std::upper_bound(lower, mz_end, left);
+      Size i = lower - mz;
+
+      double integrated_intensity = 0;
+      const bool use_im = (coord.ion_mobility >= 0.0 && has_im);
+      if (use_im)
+      {
+        const double left_im  = coord.ion_mobility - im_extraction_window / 2.0;
+        const double right_im = coord.ion_mobility + im_extraction_window / 2.0;
+        for (; i < size && mz[i] < right; ++i)
+        {
+          // branch-free masking, the IM values of neighbouring peaks are not correlated
+          const bool inside = (double(im[i]) > left_im) & (double(im[i]) < right_im);
+          integrated_intensity += inside ? double(intensity[i]) : 0.0;
+        }
+      }
+      else
+      {
+        for (; i < size && mz[i] < right; ++i)
+        {
+          integrated_intensity += intensity[i];
+        }
+      }
+
+      output[k]->getTimeArray()->data.push_back(current_rt);
+      output[k]->getIntensityArray()->data.push_back(integrated_intensity);
     }
+  }
 
+  void checkExtractionInput_(const std::vector< OpenSwath::ChromatogramPtr >& output,
+                             const std::vector<ChromatogramExtractorAlgorithm::ExtractionCoordinates>& extraction_coordinates)
+  {
     if (output.size() != extraction_coordinates.size())
     {
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
         "Output and extraction coordinates need to have the same size: "+ String(output.size()) + " != " + String(extraction_coordinates.size()) );
     }
 
-    int used_filter = getFilterNr_(filter);
     // assert that they are sorted!
     if (std::adjacent_find(extraction_coordinates.begin(), extraction_coordinates.end(),
-          ExtractionCoordinates::SortExtractionCoordinatesReverseByMZ) != extraction_coordinates.end())
+          ChromatogramExtractorAlgorithm::ExtractionCoordinates::SortExtractionCoordinatesReverseByMZ) != extraction_coordinates.end())
     {
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
         "Input to extractChromatogram needs to be sorted by m/z");
     }
+  }
+
+  } // anonymous namespace
+
+  void ChromatogramExtractorAlgorithm::extract_value_tophat(
+      const std::vector<double>::const_iterator& mz_start,
+            std::vector<double>::const_iterator& mz_it,
+      const std::vector<double>::const_iterator& mz_end,
+            std::vector<double>::const_iterator& int_it,
+      const double mz,
+      double& integrated_intensity,
+      const double mz_extraction_window,
+      const bool ppm)
+  {
+    extractValueTophat_(mz_start, mz_it, mz_end, int_it, mz, integrated_intensity, mz_extraction_window, ppm);
+  }
+
+  void ChromatogramExtractorAlgorithm::extract_value_tophat(
+      const std::vector<double>::const_iterator& mz_start,
+            std::vector<double>::const_iterator& mz_it,
+      const std::vector<double>::const_iterator& mz_end,
+            std::vector<double>::const_iterator& int_it,
+            std::vector<double>::const_iterator& im_it,
+      const double mz,
+      const double im,
+      double& integrated_intensity,
+      const double mz_extraction_window,
+      const double im_extraction_window,
+      const bool ppm)
+  {
+    extractValueTophat_(mz_start, mz_it, mz_end, int_it, im_it, mz, im,
+                        integrated_intensity, mz_extraction_window, im_extraction_window, ppm);
+  }
+
+  void ChromatogramExtractorAlgorithm::extractChromatograms(const OpenSwath::SpectrumAccessPtr& input,
+      std::vector< OpenSwath::ChromatogramPtr >& output,
+      const std::vector<ExtractionCoordinates>& extraction_coordinates,
+      double mz_extraction_window,
+      bool ppm,
+      double im_extraction_window,
+      const String& filter)
+  {
+    Size input_size = input->getNrSpectra();
+    if (input_size < 1)
+    {
+      return;
+    }
+
+    checkExtractionInput_(output, extraction_coordinates);
+    int used_filter = getFilterNr_(filter);
 
     //go through all spectra
     startProgress(0, input_size, "Extracting chromatograms");
@@ -281,11 +413,7 @@ namespace OpenMS
 
       OpenSwath::BinaryDataArrayPtr mz_arr = sptr->getMZArray();
       OpenSwath::BinaryDataArrayPtr int_arr = sptr->getIntensityArray();
-      std::vector<double>::const_iterator mz_start = mz_arr->data.begin();
-      std::vector<double>::const_iterator mz_end = mz_arr->data.end();
-      std::vector<double>::const_iterator mz_it = mz_arr->data.begin();
-      std::vector<double>::const_iterator int_it = int_arr->data.begin();
-      std::vector<double>::const_iterator im_it;
+      const double* im = nullptr;
 
       if (sptr->getMZArray()->data.empty())
       {
@@ -299,7 +427,7 @@ namespace OpenMS
         OpenSwath::BinaryDataArrayPtr im_arr = sptr->getDriftTimeArray();
         if (im_arr != nullptr)
         {
-          im_it = im_arr->data.begin();
+          im = im_arr->data.data();
         }
         else
         {
@@ -308,44 +436,162 @@ namespace OpenMS
         }
       }
 
-      // go through all transitions / chromatograms which are sorted by
-      // ProductMZ. We can use this to step through the spectrum and at the
-      // same time step through the transitions. We increase the peak counter
-      // until we hit the next transition and then extract the signal.
-      for (Size k = 0; k < extraction_coordinates.size(); ++k)
+      extractSpectrum_(mz_arr->data.data(), int_arr->data.data(), im, mz_arr->data.size(), has_im, s_meta.RT, output, extraction_coordinates,
+                       mz_extraction_window, ppm, im_extraction_window, used_filter);
+    }
+    endProgress();
+  }
+
+  void ChromatogramExtractorAlgorithm::extractChromatograms(const std::vector<ColumnarSpectrum>& input,
+      std::vector< OpenSwath::ChromatogramPtr >& output,
+      const std::vector<ExtractionCoordinates>& extraction_coordinates,
+      double mz_extraction_window,
+      bool ppm,
+      double im_extraction_window,
+      const String& filter)
+  {
+    if (input.empty())
+    {
+      return;
+    }
+
+    checkExtractionInput_(output, extraction_coordinates);
+    int used_filter = getFilterNr_(filter);
+
+    //go through all spectra
+    startProgress(0, input.size(), "Extracting chromatograms");
+    for (Size scan_idx = 0; scan_idx < input.size(); ++scan_idx)
+    {
+      setProgress(scan_idx);
+
+      const ColumnarSpectrum& spectrum = input[scan_idx];
+      if (spectrum.empty())
+      {
+        continue;
+      }
+
+      // Look for ion mobility column
+      bool has_im = (im_extraction_window > 0.0);
+      if (has_im && !spectrum.hasIonMobility())
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Requested ion mobility extraction but no ion mobility array found.");
+      }
+
+      // walk the contiguous columns directly
+      extractSpectrum_(spectrum.getMZArray().data(), spectrum.getIntensityArray().data(),
+                       spectrum.getIonMobilityArray().data(), spectrum.size(), has_im, spectrum.getRT(), output, extraction_coordinates,
+                       mz_extraction_window, ppm, im_extraction_window, used_filter);
+    }
+    endProgress();
+  }
+
+  void ChromatogramExtractorAlgorithm::extractChromatograms(const OpenSwath::SpectrumAccessPtr& input,
+      std::vector< std::vector< OpenSwath::ChromatogramPtr > >& outputs,
+      const std::vector< std::vector<ExtractionCoordinates> >& extraction_coordinates,
+      double mz_extraction_window,
+      bool ppm,
+      double im_extraction_window,
+      const String& filter,
+      Size block_size)
+  {
+    if (outputs.size() != extraction_coordinates.size())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Need one output per batch of extraction coordinates: "+ String(outputs.size()) + " != " + String(extraction_coordinates.size()) );
+    }
+    Size input_size = input->getNrSpectra();
+    if (input_size < 1)
+    {
+      return;
+    }
+
+    // RT range covered by each batch (the whole RT range if a single coordinate has no RT window)
+    std::vector<std::pair<double, double> > batch_rt(extraction_coordinates.size());
+    for (Size b = 0; b < extraction_coordinates.size(); ++b)
+    {
+      checkExtractionInput_(outputs[b], extraction_coordinates[b]);
+      batch_rt[b] = std::make_pair(std::numeric_limits<double>::max(), -std::numeric_limits<double>::max());
+      for (const ExtractionCoordinates& coord : extraction_coordinates[b])
+      {
+        if (coord.rt_end - coord.rt_start > 0)
+        {
+          batch_rt[b].first = std::min(batch_rt[b].first, coord.rt_start);
+          batch_rt[b].second = std::max(batch_rt[b].second, coord.rt_end);
+        }
+        else
+        {
+          batch_rt[b] = std::make_pair(-std::numeric_limits<double>::max(), std::numeric_limits<double>::max());
+          break;
+        }
+      }
+    }
+    int used_filter = getFilterNr_(filter);
+    block_size = std::max(block_size, Size(1));
+
+    std::vector<OpenSwath::SpectrumPtr> block;
+    std::vector<double> block_rt;
+    startProgress(0, input_size, "Extracting chromatograms");
+    for (Size block_start = 0; block_start < input_size; block_start += block_size)
+    {
+      setProgress(block_start);
+
+      // read (and decode) each spectrum of the block exactly once
+      const Size block_end = std::min(block_start + block_size, input_size);
+      block.clear();
+      block_rt.clear();
+      for (Size scan_idx = block_start; scan_idx < block_end; ++scan_idx)
       {
-        double integrated_intensity = 0;
-        double current_rt = s_meta.RT;
-        if (extraction_coordinates[k].rt_end - extraction_coordinates[k].rt_start > 0 &&
-             (current_rt < extraction_coordinates[k].rt_start ||
-              current_rt > extraction_coordinates[k].rt_end) )
+        OpenSwath::SpectrumPtr sptr = input->getSpectrumById(scan_idx);
+        if (sptr->getMZArray()->data.empty())
         {
           continue;
         }
+        if (im_extraction_window > 0.0 && sptr->getDriftTimeArray() == nullptr)
+        {
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+            "Requested ion mobility extraction but no ion mobility array found.");
+        }
+        block.push_back(sptr);
+        block_rt.push_back(input->getSpectrumMetaById(scan_idx).RT);
+      }
+      if (block.empty())
+      {
+        continue;
+      }
+      const double block_rt_min = *std::min_element(block_rt.begin(), block_rt.end());
+      const double block_rt_max = *std::max_element(block_rt.begin(), block_rt.end());
 
-        const bool use_im = (extraction_coordinates[k].ion_mobility >= 0.0 && has_im);
-        if (!use_im && used_filter == 1)
+      // extract all batches from the block, reading no data from input
+      std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 1)
+      for (SignedSize b = 0; b < (SignedSize)extraction_coordinates.size(); ++b)
+      {
+        if (batch_rt[b].second < block_rt_min || batch_rt[b].first > block_rt_max)
         {
-          extract_value_tophat(mz_start, mz_it, mz_end, int_it,
-                               extraction_coordinates[k].mz, integrated_intensity, mz_extraction_window, ppm);
+          continue;
         }
-        else if (use_im && used_filter == 1)
+        try
         {
-          if (extraction_coordinates[k].ion_mobility < 0)
+          for (Size k = 0; k < block.size(); ++k)
           {
-            std::cerr << "WARNING : Drift time of ion is negative!" << std::endl;
+            const bool has_im = (im_extraction_window > 0.0);
+            const std::vector<double>& mz = block[k]->getMZArray()->data;
+            extractSpectrum_(mz.data(), block[k]->getIntensityArray()->data.data(),
+                             has_im ? block[k]->getDriftTimeArray()->data.data() : (const double*)nullptr,
+                             mz.size(), has_im, block_rt[k], outputs[b], extraction_coordinates[b],
+                             mz_extraction_window, ppm, im_extraction_window, used_filter);
           }
-          extract_value_tophat(mz_start, mz_it, mz_end, int_it, im_it,
-                               extraction_coordinates[k].mz, extraction_coordinates[k].ion_mobility,
-                               integrated_intensity, mz_extraction_window, im_extraction_window, ppm);
         }
-        else if (used_filter == 2)
+        catch (...)
         {
-          throw Exception::NotImplemented(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
+#pragma omp critical (ChromatogramExtractorAlgorithm_extractBatches)
+          if (!error) error = std::current_exception();
         }
-
-        output[k]->getTimeArray()->data.push_back(current_rt);
-        output[k]->getIntensityArray()->data.push_back(integrated_intensity);
+      }
+      if (error)
+      {
+        std::rethrow_exception(error);
       }
     }
     endProgress();
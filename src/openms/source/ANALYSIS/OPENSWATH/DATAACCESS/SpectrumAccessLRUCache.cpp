@@ -0,0 +1,199 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessLRUCache.h>
+
+#include <OpenMS/ANALYSIS/OPENSWATH/SpectrumAddition.h>
+#include <OpenMS/CONCEPT/PerfCounters.h>
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+namespace OpenMS
+{
+
+  namespace
+  {
+    /// Least-recently-used list of spectra with a lookup table from key to list position
+    template <typename Key, typename Map>
+    struct LRUList
+    {
+      using List = std::list<std::pair<Key, OpenSwath::SpectrumPtr> >;
+
+      explicit LRUList(Size capacity) :
+        capacity_(capacity)
+      {}
+
+      /// Returns the cached spectrum (and marks it as most recently used) or a nullptr
+      OpenSwath::SpectrumPtr find(const Key& key)
+      {
+        auto it = lookup_.find(key);
+        if (it == lookup_.end())
+        {
+          return OpenSwath::SpectrumPtr();
+        }
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return it->second->second;
+      }
+
+      /// Inserts a spectrum as most recently used, evicting the least recently used one if the list is full
+      void insert(const Key& key, const OpenSwath::SpectrumPtr& spectrum)
+      {
+        if (capacity_ == 0)
+        {
+          return;
+        }
+        auto it = lookup_.find(key);
+        if (it != lookup_.end())
+        {
+          // another thread decoded the same spectrum in the meantime
+          entries_.splice(entries_.begin(), entries_, it->second);
+          return;
+        }
+        if (lookup_.size() >= capacity_)
+        {
+          lookup_.erase(entries_.back().first);
+          entries_.pop_back();
+        }
+        entries_.emplace_front(key, spectrum);
+        lookup_[key] = entries_.begin();
+      }
+
+      void clear()
+      {
+        entries_.clear();
+        lookup_.clear();
+      }
+
+      Size capacity_;
+      List entries_;
+      Map lookup_;
+    };
+
+    /// Key of an added up spectrum: closest spectrum, number of spectra, whether there is a mobility window, its bounds and the sampling rate
+    using SummedKey = std::tuple<int, int, bool, double, double, double>;
+
+    using SpectrumList = LRUList<int, std::unordered_map<int, std::list<std::pair<int, OpenSwath::SpectrumPtr> >::iterator> >;
+    using SummedList = LRUList<SummedKey, std::map<SummedKey, std::list<std::pair<SummedKey, OpenSwath::SpectrumPtr> >::iterator> >;
+  }
+
+  struct SpectrumAccessLRUCache::CacheData_
+  {
+    CacheData_(Size max_spectra, Size max_summed) :
+      spectra(max_spectra),
+      summed(max_summed)
+    {}
+
+    std::mutex mutex;
+    SpectrumList spectra;
+    SummedList summed;
+    CacheStatistics statistics;
+  };
+
+  double SpectrumAccessLRUCache::CacheStatistics::getHitRate() const
+  {
+    const Size total = hits + misses + summed_hits + summed_misses;
+    if (total == 0)
+    {
+      return 0.0;
+    }
+    return double(hits + summed_hits) / double(total);
+  }
+
+  SpectrumAccessLRUCache::SpectrumAccessLRUCache(OpenSwath::SpectrumAccessPtr sptr, Size max_spectra, Size max_summed) :
+    SpectrumAccessTransforming(std::move(sptr)),
+    cache_(new CacheData_(max_spectra, max_summed))
+  {}
+
+  SpectrumAccessLRUCache::SpectrumAccessLRUCache(OpenSwath::SpectrumAccessPtr sptr, boost::shared_ptr<CacheData_> cache) :
+    SpectrumAccessTransforming(std::move(sptr)),
+    cache_(std::move(cache))
+  {}
+
+  SpectrumAccessLRUCache::~SpectrumAccessLRUCache() = default;
+
+  boost::shared_ptr<OpenSwath::ISpectrumAccess> SpectrumAccessLRUCache::lightClone() const
+  {
+    return boost::shared_ptr<SpectrumAccessLRUCache>(new SpectrumAccessLRUCache(sptr_->lightClone(), cache_));
+  }
+
+  OpenSwath::SpectrumPtr SpectrumAccessLRUCache::getSpectrumById(int id)
+  {
+    {
+      PerfCounters::LockWait wait;
+      std::lock_guard<std::mutex> lock(cache_->mutex);
+      wait.acquired();
+      OpenSwath::SpectrumPtr spectrum = cache_->spectra.find(id);
+      if (spectrum)
+      {
+        ++cache_->statistics.hits;
+        PerfCounters::add(PerfCounters::CACHE_HITS);
+        return spectrum;
+      }
+      ++cache_->statistics.misses;
+      PerfCounters::add(PerfCounters::CACHE_MISSES);
+    }
+
+    // decode outside of the lock, other threads may use the cache meanwhile
+    OpenSwath::SpectrumPtr spectrum = sptr_->getSpectrumById(id);
+
+    std::lock_guard<std::mutex> lock(cache_->mutex);
+    cache_->spectra.insert(id, spectrum);
+    return spectrum;
+  }
+
+  OpenSwath::SpectrumPtr SpectrumAccessLRUCache::getSummedSpectrum(double RT, int nr_spectra_to_add, const RangeMobility& im_range, double sampling_rate)
+  {
+    // getMultipleSpectra() only depends on the closest spectrum
+    const int closest_idx = getClosestSpectrumId_(RT);
+    const bool has_im = !im_range.isEmpty();
+    const SummedKey key(closest_idx, nr_spectra_to_add, has_im,
+                        has_im ? im_range.getMin() : 0.0,
+                        has_im ? im_range.getMax() : 0.0,
+                        sampling_rate);
+    {
+      PerfCounters::LockWait wait;
+      std::lock_guard<std::mutex> lock(cache_->mutex);
+      wait.acquired();
+      OpenSwath::SpectrumPtr spectrum = cache_->summed.find(key);
+      if (spectrum)
+      {
+        ++cache_->statistics.summed_hits;
+        PerfCounters::add(PerfCounters::CACHE_HITS);
+        return spectrum;
+      }
+      ++cache_->statistics.summed_misses;
+      PerfCounters::add(PerfCounters::CACHE_MISSES);
+    }
+
+    OpenSwath::SpectrumPtr spectrum = SpectrumAddition::addUpSpectra(getMultipleSpectra(RT, nr_spectra_to_add), im_range, sampling_rate, true);
+
+    std::lock_guard<std::mutex> lock(cache_->mutex);
+    cache_->summed.insert(key, spectrum);
+    return spectrum;
+  }
+
+  SpectrumAccessLRUCache::CacheStatistics SpectrumAccessLRUCache::getStatistics() const
+  {
+    std::lock_guard<std::mutex> lock(cache_->mutex);
+    return cache_->statistics;
+  }
+
+  void SpectrumAccessLRUCache::clearCache()
+  {
+    std::lock_guard<std::mutex> lock(cache_->mutex);
+    cache_->spectra.clear();
+    cache_->summed.clear();
+    cache_->statistics = CacheStatistics();
+  }
+
+}
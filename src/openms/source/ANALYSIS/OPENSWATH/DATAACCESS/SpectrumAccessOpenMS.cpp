@@ -16,12 +16,21 @@ namespace OpenMS
   {
     // store shared pointer to the actual MSExperiment
     ms_experiment_ = std::move(ms_experiment);
+
+    std::vector<double> rts;
+    rts.reserve(ms_experiment_->size());
+    for (const auto& spectrum : *ms_experiment_)
+    {
+      rts.push_back(spectrum.getRT());
+    }
+    rt_index_.reset(new OpenSwath::SpectrumRTIndex(rts));
   }
 
   SpectrumAccessOpenMS::~SpectrumAccessOpenMS() = default;
 
   SpectrumAccessOpenMS::SpectrumAccessOpenMS(const SpectrumAccessOpenMS & rhs) :
-    ms_experiment_(rhs.ms_experiment_)
+    ms_experiment_(rhs.ms_experiment_),
+    rt_index_(rhs.rt_index_)
   {
     // this only copies the pointers and not the actual data ... 
   }
@@ -140,23 +149,13 @@ namespace OpenMS
   std::vector<std::size_t> SpectrumAccessOpenMS::getSpectraByRT(double RT, double deltaRT) const
   {
     OPENMS_PRECONDITION(deltaRT >= 0, "Delta RT needs to be a positive number");
+    OPENMS_PRECONDITION(rt_index_->size() == ms_experiment_->size(), "The experiment was changed after creating the spectrum access");
+    return rt_index_->getSpectraByRT(RT, deltaRT);
+  }
 
-    // we first perform a search for the spectrum that is past the
-    // beginning of the RT domain. Then we add this spectrum and try to add
-    // further spectra as long as they are below RT + deltaRT.
-    std::vector<std::size_t> result;
-    auto spectrum = ms_experiment_->RTBegin(RT - deltaRT);
-    if (spectrum == ms_experiment_->end()) return result;
-
-    result.push_back(std::distance(ms_experiment_->begin(), spectrum));
-    spectrum++;
-
-    while (spectrum != ms_experiment_->end() && spectrum->getRT() <= RT + deltaRT)
-    {
-      result.push_back(spectrum - ms_experiment_->begin());
-      spectrum++;
-    }
-    return result;
+  const OpenSwath::SpectrumRTIndex* SpectrumAccessOpenMS::getRTIndex() const
+  {
+    return rt_index_.get();
   }
 
   size_t SpectrumAccessOpenMS::getNrChromatograms() const
@@ -16,12 +16,20 @@ namespace OpenMS
   SpectrumAccessOpenMSCached::SpectrumAccessOpenMSCached(const String& filename) :
     CachedmzML(filename)
   {
+    std::vector<double> rts;
+    rts.reserve(meta_ms_experiment_.size());
+    for (const auto& spectrum : meta_ms_experiment_)
+    {
+      rts.push_back(spectrum.getRT());
+    }
+    rt_index_.reset(new OpenSwath::SpectrumRTIndex(rts));
   }
 
   SpectrumAccessOpenMSCached::~SpectrumAccessOpenMSCached() = default;
 
   SpectrumAccessOpenMSCached::SpectrumAccessOpenMSCached(const SpectrumAccessOpenMSCached & rhs) :
-    CachedmzML(rhs)
+    CachedmzML(rhs),
+    rt_index_(rhs.rt_index_)
   {
     // this only copies the indices and meta-data
   }
@@ -39,6 +47,15 @@ namespace OpenMS
     int ms_level = -1;
     double rt = -1.0;
 
+    OpenSwath::SpectrumPtr sptr(new OpenSwath::Spectrum);
+    std::string buffer;
+    Size record_size = 0;
+    if (const char* record = getRecord_(spectra_index_[id], buffer, record_size))
+    {
+      sptr->getDataArrays() = Internal::CachedMzMLHandler::readSpectrumFast(record, record_size, ms_level, rt);
+      return sptr;
+    }
+
     if ( !ifs_.seekg(spectra_index_[id]) )
     {
       std::cerr << "Error while reading spectrum " << id << " - seekg created an error when trying to change position to " << spectra_index_[id] << "." << std::endl;
@@ -47,7 +64,6 @@ namespace OpenMS
         "Error while changing position of input stream pointer.", filename_cached_);
     }
 
-    OpenSwath::SpectrumPtr sptr(new OpenSwath::Spectrum);
     sptr->getDataArrays() = Internal::CachedMzMLHandler::readSpectrumFast(ifs_, ms_level, rt);
 
     return sptr;
@@ -69,6 +85,15 @@ namespace OpenMS
     OPENMS_PRECONDITION(id >= 0, "Id needs to be larger than zero");
     OPENMS_PRECONDITION(id < (int)getNrChromatograms(), "Id cannot be larger than number of chromatograms");
 
+    OpenSwath::ChromatogramPtr cptr(new OpenSwath::Chromatogram);
+    std::string buffer;
+    Size record_size = 0;
+    if (const char* record = getRecord_(chrom_index_[id], buffer, record_size))
+    {
+      cptr->getDataArrays() = Internal::CachedMzMLHandler::readChromatogramFast(record, record_size);
+      return cptr;
+    }
+
     if ( !ifs_.seekg(chrom_index_[id]) )
     {
       std::cerr << "Error while reading chromatogram " << id << " - seekg created an error when trying to change position to " << chrom_index_[id] << "." << std::endl;
@@ -77,7 +102,6 @@ namespace OpenMS
         "Error while changing position of input stream pointer.", filename_cached_);
     }
 
-    OpenSwath::ChromatogramPtr cptr(new OpenSwath::Chromatogram);
     cptr->getDataArrays() = Internal::CachedMzMLHandler::readChromatogramFast(ifs_);
     return cptr;
   }
@@ -85,23 +109,12 @@ namespace OpenMS
   std::vector<std::size_t> SpectrumAccessOpenMSCached::getSpectraByRT(double RT, double deltaRT) const
   {
     OPENMS_PRECONDITION(deltaRT >= 0, "Delta RT needs to be a positive number");
+    return rt_index_->getSpectraByRT(RT, deltaRT);
+  }
 
-    // we first perform a search for the spectrum that is past the
-    // beginning of the RT domain. Then we add this spectrum and try to add
-    // further spectra as long as they are below RT + deltaRT.
-    std::vector<std::size_t> result;
-    auto spectrum = meta_ms_experiment_.RTBegin(RT - deltaRT);
-    if (spectrum == meta_ms_experiment_.end()) return result;
-
-    result.push_back(std::distance(meta_ms_experiment_.begin(), spectrum));
-    spectrum++;
-
-    while (spectrum != meta_ms_experiment_.end() && spectrum->getRT() < RT + deltaRT)
-    {
-      result.push_back(spectrum - meta_ms_experiment_.begin());
-      spectrum++;
-    }
-    return result;
+  const OpenSwath::SpectrumRTIndex* SpectrumAccessOpenMSCached::getRTIndex() const
+  {
+    return rt_index_.get();
   }
 
   size_t SpectrumAccessOpenMSCached::getNrSpectra() const
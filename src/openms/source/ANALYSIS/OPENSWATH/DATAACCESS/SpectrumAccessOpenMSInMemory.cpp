@@ -8,6 +8,7 @@
 
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessOpenMSInMemory.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessSqMass.h>
+#include <OpenMS/OPENSWATHALGO/DATAACCESS/SpectrumMobilityIndex.h>
 
 #include <algorithm>    // std::lower_bound, std::upper_bound, std::sort
 
@@ -36,6 +37,27 @@ namespace OpenMS
       }
     }
 
+    // index the peaks of ion mobility spectra (e.g. diaPASEF frames) by ion
+    // mobility, so that filtering them by ion mobility does not need to look
+    // at all peaks (spectra without ion mobility array are skipped)
+#pragma omp parallel for schedule(dynamic, 16)
+    for (SignedSize i = 0; i < (SignedSize)spectra_.size(); ++i)
+    {
+      const OpenSwath::SpectrumPtr& spectrum = spectra_[i];
+      if (spectrum && !(spectrum->getMobilityIndex() && spectrum->getMobilityIndex()->isIndexOf(*spectrum)))
+      {
+        OpenSwath::SpectrumMobilityIndex::addToSpectrum(*spectrum);
+      }
+    }
+
+    std::vector<double> rts;
+    rts.reserve(spectra_meta_.size());
+    for (const auto& meta : spectra_meta_)
+    {
+      rts.push_back(meta.RT);
+    }
+    rt_index_.reset(new OpenSwath::SpectrumRTIndex(rts));
+
     OPENMS_POSTCONDITION(spectra_.size() == spectra_meta_.size(), "Spectra and meta data needs to match")
     OPENMS_POSTCONDITION(chromatogram_ids_.size() == chromatograms_.size(), "Chromatograms and meta data needs to match")
   }
@@ -46,7 +68,8 @@ namespace OpenMS
     spectra_(rhs.spectra_),
     spectra_meta_(rhs.spectra_meta_),
     chromatograms_(rhs.chromatograms_),
-    chromatogram_ids_(rhs.chromatogram_ids_)
+    chromatogram_ids_(rhs.chromatogram_ids_),
+    rt_index_(rhs.rt_index_)
   {
     // this only copies the pointers and not the actual data ... 
   }
@@ -73,24 +96,12 @@ namespace OpenMS
   std::vector<std::size_t> SpectrumAccessOpenMSInMemory::getSpectraByRT(double RT, double deltaRT) const
   {
     OPENMS_PRECONDITION(deltaRT >= 0, "Delta RT needs to be a positive number");
+    return rt_index_->getSpectraByRT(RT, deltaRT);
+  }
 
-    // we first perform a search for the spectrum that is past the
-    // beginning of the RT domain. Then we add this spectrum and try to add
-    // further spectra as long as they are below RT + deltaRT.
-    std::vector<std::size_t> result;
-    OpenSwath::SpectrumMeta s;
-    s.RT = RT - deltaRT;
-    auto spectrum = std::lower_bound(spectra_meta_.begin(), spectra_meta_.end(), s, OpenSwath::SpectrumMeta::RTLess());
-    if (spectrum == spectra_meta_.end()) return result;
-
-    result.push_back(std::distance(spectra_meta_.begin(), spectrum));
-    ++spectrum;
-    while (spectrum->RT < RT + deltaRT && spectrum != spectra_meta_.end())
-    {
-      result.push_back(std::distance(spectra_meta_.begin(), spectrum));
-      ++spectrum;
-    }
-    return result;
+  const OpenSwath::SpectrumRTIndex* SpectrumAccessOpenMSInMemory::getRTIndex() const
+  {
+    return rt_index_.get();
   }
 
   size_t SpectrumAccessOpenMSInMemory::getNrSpectra() const
@@ -16,12 +16,16 @@ namespace OpenMS
     /// Constructor
   SpectrumAccessSqMass::SpectrumAccessSqMass(const OpenMS::Internal::MzMLSqliteHandler& handler) :
       handler_(handler)
-    {}
+    {
+      buildRTIndex_();
+    }
 
     SpectrumAccessSqMass::SpectrumAccessSqMass(const OpenMS::Internal::MzMLSqliteHandler& handler, const std::vector<int> & indices) :
       handler_(handler),
       sidx_(indices)
-    {}
+    {
+      buildRTIndex_();
+    }
 
 
     SpectrumAccessSqMass::SpectrumAccessSqMass(const SpectrumAccessSqMass& sp, const std::vector<int>& indices) :
@@ -45,6 +49,7 @@ namespace OpenMS
           sidx_.push_back( sp.sidx_[ indices[k] ] );
         }
       }
+      buildRTIndex_();
     }
 
     /// Destructor
@@ -53,10 +58,24 @@ namespace OpenMS
     /// Copy constructor
     SpectrumAccessSqMass::SpectrumAccessSqMass(const SpectrumAccessSqMass & rhs) :
       handler_(rhs.handler_),
-      sidx_(rhs.sidx_)
+      sidx_(rhs.sidx_),
+      rt_index_(rhs.rt_index_)
     {
     }
 
+    void SpectrumAccessSqMass::buildRTIndex_()
+    {
+      try
+      {
+        rt_index_.reset(new OpenSwath::SpectrumRTIndex(handler_.getSpectraRT(sidx_)));
+      }
+      catch (Exception::IllegalArgument&)
+      {
+        // not consecutive spectrum ids, fall back to SQL queries
+        rt_index_.reset();
+      }
+    }
+
     /// Light clone operator (actual data will not get copied)
     boost::shared_ptr<OpenSwath::ISpectrumAccess> SpectrumAccessSqMass::lightClone() const
     {
@@ -166,6 +185,11 @@ namespace OpenMS
     std::vector<std::size_t> SpectrumAccessSqMass::getSpectraByRT(double RT, double deltaRT) const
     {
       OPENMS_PRECONDITION(deltaRT >= 0, "Delta RT needs to be a positive number");
+      if (rt_index_)
+      {
+        return rt_index_->getSpectraByRT(RT, deltaRT);
+      }
+
       std::vector<std::size_t> res = handler_.getSpectraIndicesbyRT(RT, deltaRT, sidx_);
 
       if (sidx_.empty())
@@ -187,6 +211,11 @@ namespace OpenMS
       }
     }
 
+    const OpenSwath::SpectrumRTIndex* SpectrumAccessSqMass::getRTIndex() const
+    {
+      return rt_index_.get();
+    }
+
     size_t SpectrumAccessSqMass::getNrSpectra() const
     {
       size_t res;
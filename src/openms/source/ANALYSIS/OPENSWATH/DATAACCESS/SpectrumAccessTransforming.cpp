@@ -40,6 +40,11 @@ namespace OpenMS
     return sptr_->getSpectraByRT(RT, deltaRT);
   }
 
+  const OpenSwath::SpectrumRTIndex* SpectrumAccessTransforming::getRTIndex() const
+  {
+    return sptr_->getRTIndex();
+  }
+
   size_t SpectrumAccessTransforming::getNrSpectra() const
   {
     return sptr_->getNrSpectra();
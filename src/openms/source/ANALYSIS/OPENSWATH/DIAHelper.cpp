@@ -15,6 +15,7 @@
 #include <OpenMS/KERNEL/MSSpectrum.h>
 #include <OpenMS/MATH/MathFunctions.h>
 
+#include <map>
 #include <utility>
 
 #include <OpenMS/CONCEPT/LogStream.h>
@@ -377,6 +378,40 @@ namespace OpenMS::DIAHelpers
       }
     } // end getBYSeries
 
+    const IsotopeDistribution& getCoarseIsotopeDistribution(const EmpiricalFormula& formula, Size nr_isotopes)
+    {
+      // all distributions computed so far; nodes of the map are never removed so references stay valid
+      static std::map<std::pair<EmpiricalFormula, Size>, IsotopeDistribution> table;
+
+      std::pair<EmpiricalFormula, Size> key(formula, nr_isotopes);
+      const IsotopeDistribution* result = nullptr;
+      #pragma omp critical (OpenMS_DIAHelpers_IsotopeTable)
+      {
+        auto it = table.find(key);
+        if (it != table.end()) result = &it->second;
+      }
+      if (result != nullptr)
+      {
+        return *result;
+      }
+
+      // compute outside of the critical section, another thread may have inserted it meanwhile (then the first one is kept)
+      IsotopeDistribution dist = formula.getIsotopeDistribution(CoarseIsotopePatternGenerator(nr_isotopes));
+      #pragma omp critical (OpenMS_DIAHelpers_IsotopeTable)
+      {
+        result = &table.emplace(std::move(key), std::move(dist)).first->second;
+      }
+      return *result;
+    }
+
+    const IsotopeDistribution& getCoarseAveragineDistribution(double average_weight, Size nr_isotopes)
+    {
+      // same composition as CoarseIsotopePatternGenerator::estimateFromPeptideWeight() (Senko's averagine model)
+      EmpiricalFormula formula;
+      formula.estimateFromWeightAndComp(average_weight, 4.9384, 7.7583, 1.3577, 1.4773, 0.0417, 0);
+      return getCoarseIsotopeDistribution(formula, nr_isotopes);
+    }
+
     void  getAveragineIsotopeDistribution(const double product_mz,
                                          std::vector<std::pair<double, double> >& isotopes_spec,
                                          int charge,
@@ -384,15 +419,12 @@ namespace OpenMS::DIAHelpers
                                          const double mannmass)
     {
       charge = std::abs(charge);
-      typedef OpenMS::FeatureFinderAlgorithmPickedHelperStructs::TheoreticalIsotopePattern TheoreticalIsotopePattern;
       // create the theoretical distribution
-      CoarseIsotopePatternGenerator solver(nr_isotopes);
-      TheoreticalIsotopePattern isotopes;
       //Note: this is a rough estimate of the weight, usually the protons should be deducted first, left for backwards compatibility.
-      auto d = solver.estimateFromPeptideWeight(product_mz * charge);
+      const IsotopeDistribution& d = getCoarseAveragineDistribution(product_mz * charge, nr_isotopes);
 
       double mass = product_mz;
-      for (IsotopeDistribution::Iterator it = d.begin(); it != d.end(); ++it)
+      for (IsotopeDistribution::ConstIterator it = d.begin(); it != d.end(); ++it)
       {
         isotopes_spec.emplace_back(mass, it->getIntensity());
         mass += mannmass / charge;
@@ -11,7 +11,6 @@
 #include <OpenMS/CONCEPT/Constants.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternGenerator.h>
 
-#include <OpenMS/FEATUREFINDER/FeatureFinderAlgorithmPickedHelperStructs.h>
 #include <OpenMS/OPENSWATHALGO/ALGO/StatsHelpers.h>
 #include <OpenMS/OPENSWATHALGO/DATAACCESS/SpectrumHelpers.h> // integrateWindow
 #include <OpenMS/ANALYSIS/OPENSWATH/DIAHelper.h>
@@ -105,7 +104,39 @@ namespace OpenMS
     // first compute a map of relative intensities from the feature, then compute the score
     std::map<std::string, double> intensities;
     getFirstIsotopeRelativeIntensities_(transitions, mrmfeature, intensities);
-    diaIsotopeScoresSub_(transitions, spectrum, intensities, im_range, isotope_corr, isotope_overlap);
+    diaIsotopeScoresSub_(transitions, spectrum, intensities, im_range, nullptr, isotope_corr, isotope_overlap);
+  }
+
+  void DIAScoring::dia_isotope_scores(const std::vector<TransitionType>& transitions, SpectrumSequence& spectrum,
+                                      OpenSwath::IMRMFeature* mrmfeature, const RangeMobility& im_range, const TheoreticalPatterns& patterns,
+                                      double& isotope_corr, double& isotope_overlap) const
+  {
+    OPENMS_PRECONDITION(patterns.isotopes.size() == transitions.size(), "Need one theoretical isotope pattern per transition");
+    isotope_corr = 0;
+    isotope_overlap = 0;
+    std::map<std::string, double> intensities;
+    getFirstIsotopeRelativeIntensities_(transitions, mrmfeature, intensities);
+    diaIsotopeScoresSub_(transitions, spectrum, intensities, im_range, &patterns.isotopes, isotope_corr, isotope_overlap);
+  }
+
+  void DIAScoring::prepareTheoreticalPatterns(const std::vector<TransitionType>& transitions, const AASequence& sequence,
+                                              int by_charge, TheoreticalPatterns& patterns) const
+  {
+    patterns.isotopes.resize(transitions.size());
+    for (Size k = 0; k < transitions.size(); k++)
+    {
+      // If no charge is given, we assume it to be 1
+      int putative_fragment_charge = transitions[k].fragment_charge != 0 ? transitions[k].fragment_charge : 1;
+      getTheoreticalIsotopes_(transitions[k].getProductMZ(), putative_fragment_charge, patterns.isotopes[k]);
+    }
+
+    patterns.bseries.clear();
+    patterns.yseries.clear();
+    if (!sequence.empty())
+    {
+      OPENMS_PRECONDITION(by_charge > 0, "Charge is a positive integer");
+      OpenMS::DIAHelpers::getBYSeries(sequence, patterns.bseries, patterns.yseries, generator, by_charge);
+    }
   }
 
   void DIAScoring::dia_massdiff_score(const std::vector<TransitionType>& transitions,
@@ -212,9 +243,8 @@ namespace OpenMS
   {
     std::vector<double> exp_isotopes_int;
     getIsotopeIntysFromExpSpec_(precursor_mz, spectrum, charge_state, im_range, exp_isotopes_int);
-    CoarseIsotopePatternGenerator solver(dia_nr_isotopes_ + 1);
     // NOTE: this is a rough estimate of the neutral mz value since we would not know the charge carrier for negative ions
-    IsotopeDistribution isotope_dist = solver.estimateFromPeptideWeight(std::fabs(precursor_mz * charge_state));
+    const IsotopeDistribution& isotope_dist = DIAHelpers::getCoarseAveragineDistribution(std::fabs(precursor_mz * charge_state), dia_nr_isotopes_ + 1);
 
     double max_ratio;
     int nr_occurrences;
@@ -233,9 +263,23 @@ namespace OpenMS
     yseries_score = 0;
     OPENMS_PRECONDITION(charge > 0, "Charge is a positive integer"); // for peptides, charge should be positive
 
-    double mz, intensity, im;
     std::vector<double> yseries, bseries;
     OpenMS::DIAHelpers::getBYSeries(sequence, bseries, yseries, generator, charge);
+    scoreBYSeries_(spectrum, bseries, yseries, im_range, bseries_score, yseries_score);
+  }
+
+  void DIAScoring::dia_by_ion_score(const SpectrumSequence& spectrum, const TheoreticalPatterns& patterns,
+                                    const RangeMobility& im_range, double& bseries_score, double& yseries_score) const
+  {
+    bseries_score = 0;
+    yseries_score = 0;
+    scoreBYSeries_(spectrum, patterns.bseries, patterns.yseries, im_range, bseries_score, yseries_score);
+  }
+
+  void DIAScoring::scoreBYSeries_(const SpectrumSequence& spectrum, const std::vector<double>& bseries, const std::vector<double>& yseries,
+                                  const RangeMobility& im_range, double& bseries_score, double& yseries_score) const
+  {
+    double mz, intensity, im;
     for (const auto& b_ion_mz : bseries)
     {
       RangeMZ mz_range = DIAHelpers::createMZRangePPM(b_ion_mz, dia_extract_window_, dia_extraction_ppm_);
@@ -285,10 +329,12 @@ namespace OpenMS
   void DIAScoring::diaIsotopeScoresSub_(const std::vector<TransitionType>& transitions, const SpectrumSequence& spectrum,
                                         std::map<std::string, double>& intensities, //relative intensities
                                         const RangeMobility& im_range,
+                                        const std::vector<std::vector<double> >* theoretical_isotopes,
                                         double& isotope_corr,
                                         double& isotope_overlap) const
   {
     std::vector<double> isotopes_int;
+    std::vector<double> computed_isotopes;
     double max_ratio;
     int nr_occurences;
     for (Size k = 0; k < transitions.size(); k++)
@@ -316,7 +362,11 @@ namespace OpenMS
 
       // calculate the scores:
       // isotope correlation (forward) and the isotope overlap (backward) scores
-      double score = scoreIsotopePattern_(isotopes_int, transitions[k].getProductMZ(), putative_fragment_charge);
+      if (theoretical_isotopes == nullptr)
+      {
+        getTheoreticalIsotopes_(transitions[k].getProductMZ(), putative_fragment_charge, computed_isotopes);
+      }
+      double score = scoreIsotopePattern_(isotopes_int, theoretical_isotopes == nullptr ? computed_isotopes : (*theoretical_isotopes)[k]);
       isotope_corr += score * rel_intensity;
       largePeaksBeforeFirstIsotope_(spectrum, transitions[k].getProductMZ(), isotopes_int[0], nr_occurences, max_ratio, im_range);
       isotope_overlap += nr_occurences * rel_intensity;
@@ -374,59 +424,66 @@ namespace OpenMS
                                           double product_mz,
                                           int putative_fragment_charge) const
   {
-    OPENMS_PRECONDITION(putative_fragment_charge != 0, "Charge needs to be set to != 0"); // charge can be positive and negative
+    std::vector<double> theoretical_isotopes;
+    getTheoreticalIsotopes_(product_mz, putative_fragment_charge, theoretical_isotopes);
+    return scoreIsotopePattern_(isotopes_int, theoretical_isotopes);
+  } //end of dia_isotope_corr_sub
 
-    IsotopeDistribution isotope_dist;
+  void DIAScoring::getTheoreticalIsotopes_(double product_mz, int putative_fragment_charge, std::vector<double>& theoretical_isotopes) const
+  {
+    OPENMS_PRECONDITION(putative_fragment_charge != 0, "Charge needs to be set to != 0"); // charge can be positive and negative
 
-    // create the theoretical distribution from the peptide weight
-    CoarseIsotopePatternGenerator solver(dia_nr_isotopes_ + 1);
+    // create the theoretical distribution from the peptide weight (looked up, the same weights come up for every feature)
     // NOTE: this is a rough estimate of the neutral mz value since we would not know the charge carrier for negative ions
-    isotope_dist = solver.estimateFromPeptideWeight(std::fabs(product_mz * putative_fragment_charge));
-
-    return scoreIsotopePattern_(isotopes_int, isotope_dist);
-  } //end of dia_isotope_corr_sub
+    scaleIsotopeDistribution_(DIAHelpers::getCoarseAveragineDistribution(std::fabs(product_mz * putative_fragment_charge), dia_nr_isotopes_ + 1),
+                              theoretical_isotopes);
+  }
 
   double DIAScoring::scoreIsotopePattern_(const std::vector<double>& isotopes_int,
                                           const EmpiricalFormula& empf) const
   {
     return scoreIsotopePattern_(isotopes_int,
-                                empf.getIsotopeDistribution(CoarseIsotopePatternGenerator(dia_nr_isotopes_ + 1)));
+                                DIAHelpers::getCoarseIsotopeDistribution(empf, dia_nr_isotopes_ + 1));
   }
 
   double DIAScoring::scoreIsotopePattern_(const std::vector<double>& isotopes_int,
                                           const IsotopeDistribution& isotope_dist) const
   {
-    typedef OpenMS::FeatureFinderAlgorithmPickedHelperStructs::TheoreticalIsotopePattern TheoreticalIsotopePattern;
-
-    TheoreticalIsotopePattern isotopes;
+    std::vector<double> theoretical_isotopes;
+    scaleIsotopeDistribution_(isotope_dist, theoretical_isotopes);
+    return scoreIsotopePattern_(isotopes_int, theoretical_isotopes);
+  }
 
+  void DIAScoring::scaleIsotopeDistribution_(const IsotopeDistribution& isotope_dist, std::vector<double>& theoretical_isotopes) const
+  {
+    theoretical_isotopes.clear();
     for (IsotopeDistribution::ConstIterator it = isotope_dist.begin(); it != isotope_dist.end(); ++it)
     {
-      isotopes.intensity.push_back(it->getIntensity());
+      theoretical_isotopes.push_back(it->getIntensity());
     }
-    isotopes.optional_begin = 0;
-    isotopes.optional_end = dia_nr_isotopes_;
 
     // scale the distribution to a maximum of 1
     double max = 0.0;
-    for (Size i = 0; i < isotopes.intensity.size(); ++i)
+    for (Size i = 0; i < theoretical_isotopes.size(); ++i)
     {
-      if (isotopes.intensity[i] > max)
+      if (theoretical_isotopes[i] > max)
       {
-        max = isotopes.intensity[i];
+        max = theoretical_isotopes[i];
       }
     }
-    isotopes.max = max;
     if (max == 0.) max = 1.;
-    for (Size i = 0; i < isotopes.intensity.size(); ++i)
+    for (Size i = 0; i < theoretical_isotopes.size(); ++i)
     {
-      isotopes.intensity[i] /= max;
+      theoretical_isotopes[i] /= max;
     }
-    isotopes.trimmed_left = 0;
+  }
 
+  double DIAScoring::scoreIsotopePattern_(const std::vector<double>& isotopes_int,
+                                          const std::vector<double>& theoretical_isotopes) const
+  {
     // score the pattern against a theoretical one
-    OPENMS_POSTCONDITION(isotopes_int.size() == isotopes.intensity.size(), "Vectors for pearson correlation do not have the same size.");
-    double int_score = OpenSwath::cor_pearson(isotopes_int.begin(), isotopes_int.end(), isotopes.intensity.begin());
+    OPENMS_POSTCONDITION(isotopes_int.size() == theoretical_isotopes.size(), "Vectors for pearson correlation do not have the same size.");
+    double int_score = OpenSwath::cor_pearson(isotopes_int.begin(), isotopes_int.end(), theoretical_isotopes.begin());
     if (std::isnan(int_score))
     {
       int_score = 0;
@@ -11,6 +11,8 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 
 #include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <exception>
 #include <regex>
 #include <unordered_set>
 #include <map>
@@ -19,6 +21,143 @@ using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// Alternative peptidoforms of a peptide (see MRMAssay::generateTheoreticalPeptidoforms_())
+    struct Peptidoforms
+    {
+      int precursor_charge = 1;
+      double precursor_mz = 0;
+      int precursor_swath = -1;
+      bool skipped = false; ///< too many alternative localizations
+      std::vector<AASequence> sequences;
+      std::vector<String> unmodified; ///< unmodified string of each sequence
+      std::vector<String> modified; ///< string of each sequence
+      std::vector<Size> ion_series; ///< index of the ion series of each sequence (see computeIonSeries())
+
+      void setSequences(std::vector<AASequence>&& alternatives)
+      {
+        sequences = std::move(alternatives);
+        unmodified.clear();
+        modified.clear();
+        for (const AASequence& seq : sequences)
+        {
+          unmodified.push_back(seq.toUnmodifiedString());
+          modified.push_back(seq.toString());
+        }
+      }
+    };
+
+    /// Calls @p f(i) for all i in [0, n) in parallel; the first exception thrown by @p f is rethrown afterwards
+    template<typename Function>
+    void parallelFor(Size n, Function f)
+    {
+      std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 100)
+      for (SignedSize i = 0; i < SignedSize(n); ++i)
+      {
+        try
+        {
+          f(Size(i));
+        }
+        catch (...)
+        {
+#pragma omp critical (MRMAssay_parallelFor)
+          if (!error)
+          {
+            error = std::current_exception();
+          }
+        }
+      }
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+    }
+
+    /**
+      @brief Computes the ion series of each distinct peptidoform and precursor charge once
+
+      The localization variants of a modified peptide share all their
+      alternative peptidoforms, so each of them is only fragmented once (in
+      parallel). Sets Peptidoforms::ion_series to the indices in the returned
+      table.
+    */
+    std::vector<MRMIonSeries::IonSeries> computeIonSeries(std::vector<Peptidoforms>& peptidoforms,
+                                                          const std::vector<String>& fragment_types,
+                                                          const std::vector<size_t>& fragment_charges,
+                                                          bool enable_specific_losses,
+                                                          bool enable_unspecific_losses)
+    {
+      std::map<std::pair<String, int>, Size> index;
+      std::vector<std::pair<Size, Size> > first_occurrence; // peptide and peptidoform
+      for (Size i = 0; i < peptidoforms.size(); ++i)
+      {
+        Peptidoforms& p = peptidoforms[i];
+        p.ion_series.clear();
+        for (Size k = 0; k < p.modified.size(); ++k)
+        {
+          auto it = index.emplace(std::make_pair(p.modified[k], p.precursor_charge), first_occurrence.size());
+          if (it.second)
+          {
+            first_occurrence.emplace_back(i, k);
+          }
+          p.ion_series.push_back(it.first->second);
+        }
+      }
+
+      std::vector<MRMIonSeries::IonSeries> table(first_occurrence.size());
+      parallelFor(table.size(), [&](Size t)
+      {
+        const Peptidoforms& p = peptidoforms[first_occurrence[t].first];
+        MRMIonSeries mrmis;
+        table[t] = mrmis.getIonSeries(p.sequences[first_occurrence[t].second], p.precursor_charge,
+            fragment_types, fragment_charges, enable_specific_losses, enable_unspecific_losses);
+      });
+      return table;
+    }
+
+    /// Sorts all fragment maps of @p ion_map by m/z and removes duplicates (for getMatchingPeptidoformsSorted())
+    void sortIonMap(MRMAssay::IonMapT& ion_map)
+    {
+      std::vector<MRMAssay::FragmentSeqMap*> fragment_maps;
+      for (auto& swath : ion_map)
+      {
+        for (auto& sequence : swath.second)
+        {
+          fragment_maps.push_back(&sequence.second);
+        }
+      }
+      parallelFor(fragment_maps.size(), [&fragment_maps](Size i)
+      {
+        MRMAssay::FragmentSeqMap& ions = *fragment_maps[i];
+        std::sort(ions.begin(), ions.end());
+        ions.erase(std::unique(ions.begin(), ions.end()), ions.end());
+      });
+    }
+
+    /// Same result as MRMAssay::getMatchingPeptidoforms_(), for @p ions sorted by m/z (see sortIonMap())
+    std::vector<std::string> getMatchingPeptidoformsSorted(const double fragment_ion,
+                                                           const MRMAssay::FragmentSeqMap& ions,
+                                                           const double mz_threshold)
+    {
+      // both conditions of the linear search are monotonic in the fragment m/z, so the matches are a contiguous range
+      auto begin = std::partition_point(ions.begin(), ions.end(),
+          [&](const std::pair<double, std::string>& ion) { return !(ion.first + mz_threshold >= fragment_ion); });
+      auto end = std::partition_point(begin, ions.end(),
+          [&](const std::pair<double, std::string>& ion) { return ion.first - mz_threshold <= fragment_ion; });
+
+      std::vector<std::string> isoforms;
+      for (auto it = begin; it != end; ++it)
+      {
+        isoforms.push_back(it->second);
+      }
+      std::sort(isoforms.begin(), isoforms.end());
+      isoforms.erase(std::unique(isoforms.begin(), isoforms.end()), isoforms.end());
+      return isoforms;
+    }
+  }
+
   MRMAssay::MRMAssay() = default;
 
   MRMAssay::~MRMAssay() = default;
@@ -334,51 +473,69 @@ namespace OpenMS
                                             IonMapT & TargetIonMap,
                                             PeptideMapT& TargetPeptideMap)
   {
-    OpenMS::MRMIonSeries mrmis;
-
     // Step 1: Generate target in silico peptide map containing theoretical transitions
+    const PeptideVectorType& peptides = exp.getPeptides();
+    std::vector<Peptidoforms> peptidoforms(peptides.size());
     Size progress = 0;
-    startProgress(0, exp.getPeptides().size(), "Generation of target in silico peptide map");
-    for (size_t i = 0; i < exp.getPeptides().size(); ++i)
+    startProgress(0, peptides.size(), "Generation of target in silico peptide map");
+    parallelFor(peptides.size(), [&](Size i)
     {
-      setProgress(progress++);
-
-      TargetedExperiment::Peptide peptide = exp.getPeptides()[i];
+      const TargetedExperiment::Peptide& peptide = peptides[i];
+      Peptidoforms& p = peptidoforms[i];
       OpenMS::AASequence peptide_sequence = TargetedExperimentHelper::getAASequence(peptide);
-      int precursor_charge = 1;
-      if (peptide.hasCharge()) 
+      if (peptide.hasCharge())
       {
-        precursor_charge = peptide.getChargeState();
+        p.precursor_charge = peptide.getChargeState();
       }
-      double precursor_mz = peptide_sequence.getMZ(precursor_charge);
-      int precursor_swath = getSwath_(swathes, precursor_mz);
+      p.precursor_mz = peptide_sequence.getMZ(p.precursor_charge);
+      p.precursor_swath = getSwath_(swathes, p.precursor_mz);
 
       // Compute all alternative peptidoforms compatible with ModificationsDB
-      const vector<AASequence> alternative_peptide_sequences = generateTheoreticalPeptidoforms_(peptide_sequence);  
+      std::vector<AASequence> alternative_peptide_sequences = generateTheoreticalPeptidoforms_(peptide_sequence);
 
       // Some permutations might be too complex, skip if threshold is reached
       if (alternative_peptide_sequences.size() > max_num_alternative_localizations)
       {
         OPENMS_LOG_DEBUG << "[uis] Peptide skipped (too many permutations possible): " << peptide.id << std::endl;
+        p.skipped = true;
+      }
+      else
+      {
+        p.setSequences(std::move(alternative_peptide_sequences));
+      }
+#pragma omp critical (progress)
+      setProgress(progress++);
+    });
+    const std::vector<MRMIonSeries::IonSeries> ion_series = computeIonSeries(peptidoforms,
+        fragment_types, fragment_charges, enable_specific_losses, enable_unspecific_losses);
+
+    for (Size i = 0; i < peptides.size(); ++i)
+    {
+      const Peptidoforms& p = peptidoforms[i];
+      if (p.skipped)
+      {
         continue;
       }
 
       // Iterate over all peptidoforms
-      for (const auto& alt_aa : alternative_peptide_sequences)
-      { 
+      for (Size k = 0; k < p.sequences.size(); ++k)
+      {
         // Append peptidoform to index
-        TargetSequenceMap[precursor_swath][alt_aa.toUnmodifiedString()].insert(alt_aa.toString());
-        // Generate theoretical ion series
-        auto ionseries = mrmis.getIonSeries(alt_aa, precursor_charge,
-            fragment_types, fragment_charges, enable_specific_losses,
-            enable_unspecific_losses);
+        TargetSequenceMap[p.precursor_swath][p.unmodified[k]].insert(p.modified[k]);
+        const MRMIonSeries::IonSeries& ionseries = ion_series[p.ion_series[k]];
+        if (!enable_ms2_precursors && ionseries.empty())
+        {
+          continue;
+        }
+        FragmentSeqMap& ions = TargetIonMap[p.precursor_swath][p.unmodified[k]];
+        IonSeries& peptide_ions = TargetPeptideMap[peptides[i].id];
 
         if (enable_ms2_precursors)
         {
           // Add precursor to theoretical transitions
-          double prec_mz = Math::roundDecimal(precursor_mz, round_decPow);
-          TargetIonMap[precursor_swath][alt_aa.toUnmodifiedString()].emplace_back(prec_mz, alt_aa.toString());
-          TargetPeptideMap[peptide.id].emplace_back("MS2_Precursor_i0", prec_mz);
+          double prec_mz = Math::roundDecimal(p.precursor_mz, round_decPow);
+          ions.emplace_back(prec_mz, p.modified[k]);
+          peptide_ions.emplace_back("MS2_Precursor_i0", prec_mz);
         }
 
         // Iterate over all theoretical transitions
@@ -386,11 +543,12 @@ namespace OpenMS
         {
           // Append transition to indices to find interfering transitions
           double fragment_mz = Math::roundDecimal(im_it.second, round_decPow);
-          TargetIonMap[precursor_swath][alt_aa.toUnmodifiedString()].emplace_back(fragment_mz, alt_aa.toString());
-          TargetPeptideMap[peptide.id].emplace_back(im_it.first, fragment_mz);
+          ions.emplace_back(fragment_mz, p.modified[k]);
+          peptide_ions.emplace_back(im_it.first, fragment_mz);
         }
       }
     }
+    sortIonMap(TargetIonMap);
     endProgress();
   }
 
@@ -473,21 +631,12 @@ namespace OpenMS
                                            IonMapT & DecoyIonMap,
                                            PeptideMapT& DecoyPeptideMap)
   {
-    MRMIonSeries mrmis;
-
     // Step 2b: Generate decoy in silico peptide map containing theoretical transitions
-    Size progress = 0;
-    startProgress(0, exp.getPeptides().size(), "Generation of decoy in silico peptide map");
-    for (size_t i = 0; i < exp.getPeptides().size(); ++i)
+    const PeptideVectorType& peptides = exp.getPeptides();
+    std::vector<const TargetedExperiment::Peptide*> decoy_peptides(peptides.size(), nullptr);
+    for (Size i = 0; i < peptides.size(); ++i)
     {
-      setProgress(progress++);
-
-      TargetedExperiment::Peptide peptide = exp.getPeptides()[i];
-      int precursor_charge = 1;
-      if (peptide.hasCharge()) 
-      {
-        precursor_charge = peptide.getChargeState();
-      }
+      const TargetedExperiment::Peptide& peptide = peptides[i];
 
       // Skip if target peptide is not in map, e.g. permutation threshold was reached
       if (TargetPeptideMap.find(peptide.id) == TargetPeptideMap.end())
@@ -495,34 +644,64 @@ namespace OpenMS
         continue;
       }
 
-      OpenMS::AASequence peptide_sequence = TargetedExperimentHelper::getAASequence(peptide);
-      double precursor_mz = peptide_sequence.getMZ(precursor_charge);
-      int precursor_swath = getSwath_(swathes, precursor_mz);
-
       // Copy properties of target peptide to decoy and get sequence from map
       TargetedExperiment::Peptide decoy_peptide = peptide;
       decoy_peptide.sequence = DecoySequenceMap[peptide.sequence];
 
-      TargetDecoyMap[peptide.id] = decoy_peptide;
-      OpenMS::AASequence decoy_peptide_sequence = TargetedExperimentHelper::getAASequence(decoy_peptide);
+      TargetedExperiment::Peptide& stored = TargetDecoyMap[peptide.id];
+      stored = std::move(decoy_peptide);
+      decoy_peptides[i] = &stored;
+    }
 
-      // Compute all alternative peptidoforms compatible with ModificationsDB
-      // Infers residue specificity from target sequence but is applied to decoy sequence
-      const vector<AASequence> alternative_decoy_peptide_sequences = generateTheoreticalPeptidoformsDecoy_(peptide_sequence, decoy_peptide_sequence);
+    std::vector<Peptidoforms> peptidoforms(peptides.size());
+    Size progress = 0;
+    startProgress(0, peptides.size(), "Generation of decoy in silico peptide map");
+    parallelFor(peptides.size(), [&](Size i)
+    {
+      if (decoy_peptides[i] != nullptr)
+      {
+        const TargetedExperiment::Peptide& peptide = peptides[i];
+        Peptidoforms& p = peptidoforms[i];
+        if (peptide.hasCharge())
+        {
+          p.precursor_charge = peptide.getChargeState(); // use same charge state as target
+        }
+
+        OpenMS::AASequence peptide_sequence = TargetedExperimentHelper::getAASequence(peptide);
+        p.precursor_mz = peptide_sequence.getMZ(p.precursor_charge);
+        p.precursor_swath = getSwath_(swathes, p.precursor_mz);
+        OpenMS::AASequence decoy_peptide_sequence = TargetedExperimentHelper::getAASequence(*decoy_peptides[i]);
+
+        // Compute all alternative peptidoforms compatible with ModificationsDB
+        // Infers residue specificity from target sequence but is applied to decoy sequence
+        p.setSequences(generateTheoreticalPeptidoformsDecoy_(peptide_sequence, decoy_peptide_sequence));
+      }
+#pragma omp critical (progress)
+      setProgress(progress++);
+    });
+    const std::vector<MRMIonSeries::IonSeries> ion_series = computeIonSeries(peptidoforms,
+        fragment_types, fragment_charges, enable_specific_losses, enable_unspecific_losses);
+
+    for (Size i = 0; i < peptides.size(); ++i)
+    {
+      const Peptidoforms& p = peptidoforms[i];
 
       // Iterate over all peptidoforms
-      for (const auto& alt_aa : alternative_decoy_peptide_sequences)
+      for (Size k = 0; k < p.sequences.size(); ++k)
       {
-        // Generate theoretical ion series
-        MRMIonSeries::IonSeries ionseries = mrmis.getIonSeries(alt_aa, precursor_charge, // use same charge state as target
-                                                               fragment_types, fragment_charges, enable_specific_losses, enable_unspecific_losses);  
+        const MRMIonSeries::IonSeries& ionseries = ion_series[p.ion_series[k]];
+        if (!enable_ms2_precursors && ionseries.empty())
+        {
+          continue;
+        }
+        FragmentSeqMap& ions = DecoyIonMap[p.precursor_swath][p.unmodified[k]];
 
         if (enable_ms2_precursors)
         {
           // Add precursor to theoretical transitions
-          double prec_mz = Math::roundDecimal(precursor_mz, round_decPow);
-          DecoyIonMap[precursor_swath][alt_aa.toUnmodifiedString()].emplace_back(prec_mz, alt_aa.toString());
-          DecoyPeptideMap[peptide.id].emplace_back("MS2_Precursor_i0", prec_mz);
+          double prec_mz = Math::roundDecimal(p.precursor_mz, round_decPow);
+          ions.emplace_back(prec_mz, p.modified[k]);
+          DecoyPeptideMap[peptides[i].id].emplace_back("MS2_Precursor_i0", prec_mz);
         }
 
         // Iterate over all theoretical transitions
@@ -530,11 +709,12 @@ namespace OpenMS
         {
           // Append transition to indices to find interfering transitions
           double fragment_mz = Math::roundDecimal(im_it.second, round_decPow);
-          DecoyIonMap[precursor_swath][alt_aa.toUnmodifiedString()].emplace_back(fragment_mz, alt_aa.toString());
-          DecoyPeptideMap[decoy_peptide.id].emplace_back(im_it.first, fragment_mz);
+          ions.emplace_back(fragment_mz, p.modified[k]);
+          DecoyPeptideMap[decoy_peptides[i]->id].emplace_back(im_it.first, fragment_mz);
         }
       }
     }
+    sortIonMap(DecoyIonMap);
     endProgress();
   }
 
@@ -546,19 +726,26 @@ namespace OpenMS
                                       const PeptideMapT& TargetPeptideMap,
                                       const IonMapT & TargetIonMap)
   {
-    MRMIonSeries mrmis;
-
     // Step 3: Generate target identification transitions
-    Size progress = 0;
-    startProgress(0, TargetPeptideMap.size(), "Generation of target identification transitions");
+    std::vector<PeptideMapT::const_iterator> target_peptides;
+    std::vector<const TargetedExperiment::Peptide*> peptides;
+    for (auto pep_it = TargetPeptideMap.begin(); pep_it != TargetPeptideMap.end(); ++pep_it)
+    {
+      target_peptides.push_back(pep_it);
+      peptides.push_back(&exp.getPeptideByRef(pep_it->first));
+    }
 
-    // Iterate over all target peptides
-    int transition_index = 0;
-    for (const auto& pep_it : TargetPeptideMap)
-    { 
-      setProgress(progress++);
+    // transitions of each peptide with their index among the transitions of the peptide (the transition
+    // names only contain the part after the index)
+    std::vector<std::vector<std::pair<int, ReactionMonitoringTransition> > > peptide_transitions(target_peptides.size());
+    std::vector<int> nr_indices(target_peptides.size(), 0);
 
-      TargetedExperiment::Peptide peptide = exp.getPeptideByRef(pep_it.first);
+    Size progress = 0;
+    startProgress(0, TargetPeptideMap.size(), "Generation of target identification transitions");
+    parallelFor(target_peptides.size(), [&](Size p)
+    {
+      MRMIonSeries mrmis;
+      const TargetedExperiment::Peptide& peptide = *peptides[p];
       int precursor_charge = 1;
       if (peptide.hasCharge()) 
       {
@@ -566,18 +753,19 @@ namespace OpenMS
       }
       AASequence peptide_sequence = TargetedExperimentHelper::getAASequence(peptide);
       int target_precursor_swath = getSwath_(swathes, peptide_sequence.getMZ(precursor_charge));
+      const FragmentSeqMap& ions = TargetIonMap.at(target_precursor_swath).at(peptide_sequence.toUnmodifiedString());
 
       // Sort all transitions and make them unique
-      auto transition_vector = pep_it.second;
+      auto transition_vector = target_peptides[p]->second;
       std::sort(transition_vector.begin(), transition_vector.end());
       auto tr_vec_end = std::unique(transition_vector.begin(), transition_vector.end());
 
       // Iterate over all transitions
+      int transition_index = 0;
       for (auto tr_it = transition_vector.begin(); tr_it != tr_vec_end; ++tr_it)
       { 
         // Compute the set of peptidoforms mapping to this transition
-        vector<string> isoforms = getMatchingPeptidoforms_(
-            tr_it->second, TargetIonMap.at(target_precursor_swath).at(peptide_sequence.toUnmodifiedString()), mz_threshold);
+        vector<string> isoforms = getMatchingPeptidoformsSorted(tr_it->second, ions, mz_threshold);
 
         // Check that transition maps to at least one peptidoform
         if (!isoforms.empty())
@@ -593,22 +781,38 @@ namespace OpenMS
           trn.setQuantifyingTransition(false);
 
           // Set transition name containing mapping to peptidoforms with potential peptidoforms enumerated in brackets
-          String identifier = String(transition_index) + "_" + String("UIS") +  \
+          // (the transition index is prepended below)
+          String identifier = "_" + String("UIS") +  \
             "_{" + ListUtils::concatenate(isoforms, "|") + "}_" +  \
             String(trn.getPrecursorMZ()) + "_" + String(trn.getProductMZ()) + "_" + 
             String(peptide.getRetentionTime()) + "_" + tr_it->first; 
           trn.setName(identifier); 
-          trn.setNativeID(identifier);
           trn.setMetaValue("Peptidoforms", ListUtils::concatenate(isoforms, "|"));
 
-          OPENMS_LOG_DEBUG << "[uis] Transition " << trn.getNativeID() << std::endl;
-
-          // Append transition
-          transitions.push_back(trn);
+          peptide_transitions[p].emplace_back(transition_index, std::move(trn));
         }
         transition_index++;
       }
-      OPENMS_LOG_DEBUG << "[uis] Peptide " << peptide.id << std::endl;
+      nr_indices[p] = transition_index;
+#pragma omp critical (progress)
+      setProgress(progress++);
+    });
+
+    // Append transitions
+    int first_index = 0;
+    for (Size p = 0; p < target_peptides.size(); ++p)
+    {
+      for (auto& indexed_transition : peptide_transitions[p])
+      {
+        ReactionMonitoringTransition& trn = indexed_transition.second;
+        String identifier = String(first_index + indexed_transition.first) + trn.getName();
+        trn.setName(identifier);
+        trn.setNativeID(identifier);
+        OPENMS_LOG_DEBUG << "[uis] Transition " << trn.getNativeID() << std::endl;
+        transitions.push_back(std::move(trn));
+      }
+      first_index += nr_indices[p];
+      OPENMS_LOG_DEBUG << "[uis] Peptide " << peptides[p]->id << std::endl;
     }
     endProgress();
   }
@@ -623,18 +827,26 @@ namespace OpenMS
                                      const IonMapT& DecoyIonMap,
                                      const IonMapT& TargetIonMap)
   {
-    MRMIonSeries mrmis;
-
     // Step 4: Generate decoy identification transitions
+    std::vector<PeptideMapT::const_iterator> decoy_peptides;
+    std::vector<std::pair<const TargetedExperiment::Peptide*, const TargetedExperiment::Peptide*> > peptides; // target and decoy
+    for (auto decoy_pep_it = DecoyPeptideMap.begin(); decoy_pep_it != DecoyPeptideMap.end(); ++decoy_pep_it)
+    {
+      decoy_peptides.push_back(decoy_pep_it);
+      peptides.emplace_back(&exp.getPeptideByRef(decoy_pep_it->first), &TargetDecoyMap[decoy_pep_it->first]);
+    }
+
+    // transitions of each peptide with their index among the transitions of the peptide (the transition
+    // names only contain the part after the index)
+    std::vector<std::vector<std::pair<int, ReactionMonitoringTransition> > > peptide_transitions(decoy_peptides.size());
+    std::vector<int> nr_indices(decoy_peptides.size(), 0);
+
     Size progress = 0;
     startProgress(0, DecoyPeptideMap.size(), "Generation of decoy identification transitions");
-
-    // Iterate over all decoy peptides
-    int transition_index = 0;
-    for (const auto & decoy_pep_it : DecoyPeptideMap)
+    parallelFor(decoy_peptides.size(), [&](Size p)
     {
-      setProgress(progress++);
-      const TargetedExperiment::Peptide& target_peptide = exp.getPeptideByRef(decoy_pep_it.first);
+      MRMIonSeries mrmis;
+      const TargetedExperiment::Peptide& target_peptide = *peptides[p].first;
       int precursor_charge = 1;
       if (target_peptide.hasCharge()) 
       {
@@ -643,24 +855,35 @@ namespace OpenMS
       AASequence target_peptide_sequence = TargetedExperimentHelper::getAASequence(target_peptide);
       int target_precursor_swath = getSwath_(swathes, target_peptide_sequence.getMZ(precursor_charge));
 
-      TargetedExperiment::Peptide decoy_peptide = TargetDecoyMap[decoy_pep_it.first];
+      const TargetedExperiment::Peptide& decoy_peptide = *peptides[p].second;
       OpenMS::AASequence decoy_peptide_sequence = TargetedExperimentHelper::getAASequence(decoy_peptide);
+      const FragmentSeqMap& decoy_ions = DecoyIonMap.at(target_precursor_swath).at(decoy_peptide_sequence.toUnmodifiedString());
+      const FragmentSeqMap& target_ions = TargetIonMap.at(target_precursor_swath).at(target_peptide_sequence.toUnmodifiedString());
 
       // Sort all transitions and make them unique
-      auto transition_vector = decoy_pep_it.second;
+      auto transition_vector = decoy_peptides[p]->second;
       std::sort(transition_vector.begin(), transition_vector.end());
       auto tr_vec_end = std::unique(transition_vector.begin(), transition_vector.end());
 
       // Iterate over all transitions
+      int transition_index = 0;
       for (auto decoy_tr_it = transition_vector.begin(); decoy_tr_it != tr_vec_end; ++decoy_tr_it)
       {
         // Check mapping of transitions to other peptidoforms
-        vector<string> decoy_isoforms = getMatchingPeptidoforms_(
-            decoy_tr_it->second, DecoyIonMap.at(target_precursor_swath).at(decoy_peptide_sequence.toUnmodifiedString()), mz_threshold);
+        vector<string> decoy_isoforms = getMatchingPeptidoformsSorted(decoy_tr_it->second, decoy_ions, mz_threshold);
 
         // Check that transition maps to at least one peptidoform
         if (!decoy_isoforms.empty())
         {
+          // Check if decoy transition is overlapping with target transition
+          vector<string> target_isoforms_overlap = getMatchingPeptidoformsSorted(decoy_tr_it->second, target_ions, mz_threshold);
+
+          if (!target_isoforms_overlap.empty())
+          {
+            OPENMS_LOG_DEBUG << "[uis] Skipping overlapping decoy transition of " << decoy_peptide.id << " at " << decoy_tr_it->second << std::endl;
+            continue;
+          }
+
           ReactionMonitoringTransition trn;
           trn.setDecoyTransitionType(ReactionMonitoringTransition::DECOY);
           trn.setDetectingTransition(false);
@@ -673,33 +896,37 @@ namespace OpenMS
           trn.setQuantifyingTransition(false);
 
           // Set transition name containing mapping to peptidoforms with potential peptidoforms enumerated in brackets
-          String identifier = String(transition_index) + "_" + String("UISDECOY") +
+          // (the transition index is prepended below)
+          String identifier = "_" + String("UISDECOY") +
                 "_{" + ListUtils::concatenate(decoy_isoforms, "|") + "}_" +
                 String(trn.getPrecursorMZ()) + "_" + String(trn.getProductMZ()) + "_" +
                 String(decoy_peptide.getRetentionTime()) + "_" + decoy_tr_it->first;
           trn.setName(identifier); 
-          trn.setNativeID(identifier);
           trn.setMetaValue("Peptidoforms", ListUtils::concatenate(decoy_isoforms, "|"));
 
-          OPENMS_LOG_DEBUG << "[uis] Decoy transition " << trn.getNativeID() << std::endl;
-
-          // Check if decoy transition is overlapping with target transition
-          vector<string> target_isoforms_overlap = getMatchingPeptidoforms_(
-              decoy_tr_it->second, TargetIonMap.at(target_precursor_swath).at(target_peptide_sequence.toUnmodifiedString()), mz_threshold);
-
-          if (!target_isoforms_overlap.empty())
-          {
-            OPENMS_LOG_DEBUG << "[uis] Skipping overlapping decoy transition " << trn.getNativeID() << std::endl;
-            continue;
-          }
-          else
-          {
-            // Append transition
-            transitions.push_back(trn);
-          }
+          peptide_transitions[p].emplace_back(transition_index, std::move(trn));
         }
         transition_index++;
       }
+      nr_indices[p] = transition_index;
+#pragma omp critical (progress)
+      setProgress(progress++);
+    });
+
+    // Append transitions
+    int first_index = 0;
+    for (Size p = 0; p < decoy_peptides.size(); ++p)
+    {
+      for (auto& indexed_transition : peptide_transitions[p])
+      {
+        ReactionMonitoringTransition& trn = indexed_transition.second;
+        String identifier = String(first_index + indexed_transition.first) + trn.getName();
+        trn.setName(identifier);
+        trn.setNativeID(identifier);
+        OPENMS_LOG_DEBUG << "[uis] Decoy transition " << trn.getNativeID() << std::endl;
+        transitions.push_back(std::move(trn));
+      }
+      first_index += nr_indices[p];
     }
     endProgress();
   }
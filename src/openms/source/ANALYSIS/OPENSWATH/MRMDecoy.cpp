@@ -19,6 +19,8 @@
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/variate_generator.hpp>
 #include <boost/unordered_map.hpp>
+#include <exception>
+#include <iterator>
 #include <unordered_set>
 
 namespace OpenMS
@@ -380,7 +382,6 @@ namespace OpenMS
                                 const std::vector<String>& fragment_types, const std::vector<size_t>& fragment_charges,
                                 const bool enable_specific_losses, const bool enable_unspecific_losses, const int round_decPow) const
   {
-    MRMIonSeries mrmis;
     MRMDecoy::PeptideVectorType peptides, decoy_peptides;
     MRMDecoy::ProteinVectorType proteins, decoy_proteins;
     MRMDecoy::TransitionVectorType decoy_transitions;
@@ -430,57 +431,79 @@ namespace OpenMS
     // Go through all peptides and apply the decoy method to the sequence
     // (pseudo-reverse, reverse or shuffle). Then set the peptides and proteins of the decoy
     // experiment.
+    // The (expensive) sequence permutations are computed in parallel; switchKR() draws from a
+    // shared random generator and is applied afterwards in input order.
+    std::vector<OpenMS::TargetedExperiment::Peptide> permuted(selection_list.size());
+    std::vector<char> has_terminal_mods(selection_list.size(), false);
     Size progress = 0;
     startProgress(0, selection_list.size(), "Generating decoy peptides");
-    for (const auto& pep_idx : selection_list)
+    std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 100)
+    for (SignedSize k = 0; k < SignedSize(selection_list.size()); ++k)
     {
-      setProgress(++progress);
-
-      OpenMS::TargetedExperiment::Peptide peptide = exp.getPeptides()[pep_idx];
-
-      peptide.id = decoy_tag + peptide.id;
-
-      if (!peptide.getPeptideGroupLabel().empty())
+      try
       {
-        peptide.setPeptideGroupLabel(decoy_tag + peptide.getPeptideGroupLabel());
-      }
+        OpenMS::TargetedExperiment::Peptide peptide = exp.getPeptides()[selection_list[k]];
 
-      if (method == "pseudo-reverse")
-      {
-        // exclude peptide if it has C/N terminal modifications because we can't do a (partial) reverse
-        if (MRMDecoy::hasCNterminalMods_(peptide, do_switchKR))
+        peptide.id = decoy_tag + peptide.id;
+
+        if (!peptide.getPeptideGroupLabel().empty())
         {
-          OPENMS_LOG_DEBUG << "[peptide] Skipping " << peptide.id << " due to C/N-terminal modifications" << std::endl;
-          exclusion_peptides.insert(peptide.id);
+          peptide.setPeptideGroupLabel(decoy_tag + peptide.getPeptideGroupLabel());
         }
-        else
+
+        if (method == "pseudo-reverse")
         {
-          peptide = MRMDecoy::pseudoreversePeptide_(peptide);
-          if (do_switchKR) { switchKR(peptide); }
+          // exclude peptide if it has C/N terminal modifications because we can't do a (partial) reverse
+          has_terminal_mods[k] = MRMDecoy::hasCNterminalMods_(peptide, do_switchKR);
+          if (!has_terminal_mods[k])
+          {
+            peptide = MRMDecoy::pseudoreversePeptide_(peptide);
+          }
         }
-      }
-      else if (method == "reverse")
-      {
-        // exclude peptide if it has C/N terminal modifications because we can't do a (partial) reverse
-        if (MRMDecoy::hasCNterminalMods_(peptide, false))
+        else if (method == "reverse")
         {
-          OPENMS_LOG_DEBUG << "[peptide] Skipping " << peptide.id << " due to C/N-terminal modifications" << std::endl;
-          exclusion_peptides.insert(peptide.id);
+          // exclude peptide if it has C/N terminal modifications because we can't do a (partial) reverse
+          has_terminal_mods[k] = MRMDecoy::hasCNterminalMods_(peptide, false);
+          if (!has_terminal_mods[k])
+          {
+            peptide = MRMDecoy::reversePeptide_(peptide);
+          }
         }
-        else
+        else if (method == "shuffle")
         {
-          peptide = MRMDecoy::reversePeptide_(peptide);
+          peptide = MRMDecoy::shufflePeptide(peptide, identity_threshold, -1, max_attempts);
+          has_terminal_mods[k] = do_switchKR && MRMDecoy::hasCNterminalMods_(peptide, do_switchKR);
         }
+        permuted[k] = std::move(peptide);
       }
-      else if (method == "shuffle")
+      catch (...)
       {
-        peptide = MRMDecoy::shufflePeptide(peptide, identity_threshold, -1, max_attempts);
-        if (do_switchKR && MRMDecoy::hasCNterminalMods_(peptide, do_switchKR))
+#pragma omp critical (MRMDecoy_generateDecoys)
+        if (!error)
         {
-          OPENMS_LOG_DEBUG << "[peptide] Skipping " << peptide.id << " due to C/N-terminal modifications" << std::endl;
-          exclusion_peptides.insert(peptide.id);
+          error = std::current_exception();
         }
-        else if (do_switchKR) { switchKR(peptide); }
+      }
+#pragma omp critical (progress)
+      setProgress(++progress);
+    }
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+
+    for (Size k = 0; k < permuted.size(); ++k)
+    {
+      OpenMS::TargetedExperiment::Peptide& peptide = permuted[k];
+      if (has_terminal_mods[k])
+      {
+        OPENMS_LOG_DEBUG << "[peptide] Skipping " << peptide.id << " due to C/N-terminal modifications" << std::endl;
+        exclusion_peptides.insert(peptide.id);
+      }
+      else if (do_switchKR && (method == "pseudo-reverse" || method == "shuffle"))
+      {
+        switchKR(peptide);
       }
 
       // Check that the decoy precursor does not happen to be a target precursor AND is not already present
@@ -501,7 +524,7 @@ namespace OpenMS
         peptide.protein_refs[prot_idx] = decoy_tag + peptide.protein_refs[prot_idx];
       }
 
-      peptides.push_back(peptide);
+      peptides.push_back(std::move(peptide));
     }
     endProgress();
     dec.setPeptides(peptides); // temporary set peptides, overwrite later again!
@@ -513,81 +536,111 @@ namespace OpenMS
       peptide_trans_map[exp.getTransitions()[i].getPeptideRef()].push_back(&exp.getTransitions()[i]);
     }
 
-    progress = 0;
-    startProgress(0, peptide_trans_map.size(), "Generating decoy transitions");
-    for (MRMDecoy::PeptideTransitionMapType::iterator pep_it = peptide_trans_map.begin();
-         pep_it != peptide_trans_map.end(); ++pep_it)
+    // resolve the peptides first (the peptide lookup of TargetedExperiment is built lazily)
+    std::vector<MRMDecoy::PeptideTransitionMapType::const_iterator> decoy_entries;
+    std::vector<std::pair<const TargetedExperiment::Peptide*, const TargetedExperiment::Peptide*> > entry_peptides; // target and decoy
+    for (auto pep_it = peptide_trans_map.cbegin(); pep_it != peptide_trans_map.cend(); ++pep_it)
     {
-      setProgress(++progress);
-
-      String peptide_ref = pep_it->first;
       String decoy_peptide_ref = decoy_tag + pep_it->first; // see above, the decoy peptide id is computed deterministically from the target id
       if (!dec.hasPeptide(decoy_peptide_ref)) { continue; }
-      const TargetedExperiment::Peptide& target_peptide = exp.getPeptideByRef(peptide_ref);
-
-      const TargetedExperiment::Peptide& decoy_peptide = dec.getPeptideByRef(decoy_peptide_ref);
-      OpenMS::AASequence target_peptide_sequence = TargetedExperimentHelper::getAASequence(target_peptide);
-      OpenMS::AASequence decoy_peptide_sequence = TargetedExperimentHelper::getAASequence(decoy_peptide);
-
-      int decoy_charge = 1;
-      int target_charge = 1;
-      if (decoy_peptide.hasCharge()) { decoy_charge = decoy_peptide.getChargeState(); }
-      if (target_peptide.hasCharge()) { target_charge = target_peptide.getChargeState(); }
-
-      MRMIonSeries::IonSeries decoy_ionseries = mrmis.getIonSeries(decoy_peptide_sequence, decoy_charge,
-                                                                   fragment_types, fragment_charges, enable_specific_losses,
-                                                                   enable_unspecific_losses, round_decPow);
-      MRMIonSeries::IonSeries target_ionseries = mrmis.getIonSeries(target_peptide_sequence, target_charge,
-                                                                    fragment_types, fragment_charges, enable_specific_losses,
-                                                                    enable_unspecific_losses, round_decPow);
-
-      // Compute (new) decoy precursor m/z based on the K/R replacement and the AA changes in the shuffle algorithm
-      double decoy_precursor_mz = decoy_peptide_sequence.getMZ(decoy_charge);
-      decoy_precursor_mz += precursor_mz_shift; // fix for TOPPView: Duplicate precursor MZ is not displayed.
+      decoy_entries.push_back(pep_it);
+      entry_peptides.emplace_back(&exp.getPeptideByRef(pep_it->first), &dec.getPeptideByRef(decoy_peptide_ref));
+    }
 
-      for (Size i = 0; i < pep_it->second.size(); i++)
+    std::vector<MRMDecoy::TransitionVectorType> entry_transitions(decoy_entries.size());
+    std::vector<std::vector<String> > entry_exclusions(decoy_entries.size());
+    progress = 0;
+    startProgress(0, peptide_trans_map.size(), "Generating decoy transitions");
+#pragma omp parallel for schedule(dynamic, 100)
+    for (SignedSize e = 0; e < SignedSize(decoy_entries.size()); ++e)
+    {
+      try
       {
-        const ReactionMonitoringTransition tr = *(pep_it->second[i]);
-
-        if (!tr.isDetectingTransition() || tr.getDecoyTransitionType() == ReactionMonitoringTransition::DECOY)
+        MRMIonSeries mrmis;
+        const TargetedExperiment::Peptide& target_peptide = *entry_peptides[e].first;
+        const TargetedExperiment::Peptide& decoy_peptide = *entry_peptides[e].second;
+        OpenMS::AASequence target_peptide_sequence = TargetedExperimentHelper::getAASequence(target_peptide);
+        OpenMS::AASequence decoy_peptide_sequence = TargetedExperimentHelper::getAASequence(decoy_peptide);
+
+        int decoy_charge = 1;
+        int target_charge = 1;
+        if (decoy_peptide.hasCharge()) { decoy_charge = decoy_peptide.getChargeState(); }
+        if (target_peptide.hasCharge()) { target_charge = target_peptide.getChargeState(); }
+
+        MRMIonSeries::IonSeries decoy_ionseries = mrmis.getIonSeries(decoy_peptide_sequence, decoy_charge,
+                                                                     fragment_types, fragment_charges, enable_specific_losses,
+                                                                     enable_unspecific_losses, round_decPow);
+        MRMIonSeries::IonSeries target_ionseries = mrmis.getIonSeries(target_peptide_sequence, target_charge,
+                                                                      fragment_types, fragment_charges, enable_specific_losses,
+                                                                      enable_unspecific_losses, round_decPow);
+
+        // Compute (new) decoy precursor m/z based on the K/R replacement and the AA changes in the shuffle algorithm
+        double decoy_precursor_mz = decoy_peptide_sequence.getMZ(decoy_charge);
+        decoy_precursor_mz += precursor_mz_shift; // fix for TOPPView: Duplicate precursor MZ is not displayed.
+
+        for (const ReactionMonitoringTransition* tr_ptr : decoy_entries[e]->second)
         {
-          continue;
-        }
+          const ReactionMonitoringTransition& tr = *tr_ptr;
 
-        ReactionMonitoringTransition decoy_tr = tr; // copy the target transition
+          if (!tr.isDetectingTransition() || tr.getDecoyTransitionType() == ReactionMonitoringTransition::DECOY)
+          {
+            continue;
+          }
 
-        decoy_tr.setNativeID(decoy_tag + tr.getNativeID());
-        decoy_tr.setDecoyTransitionType(ReactionMonitoringTransition::DECOY);
-        decoy_tr.setPrecursorMZ(decoy_precursor_mz);
+          ReactionMonitoringTransition decoy_tr = tr; // copy the target transition
 
-        // determine the current annotation for the target ion and then select
-        // the appropriate decoy ion for this target transition
-        std::pair<String, double> targetion = mrmis.annotateIon(target_ionseries, tr.getProductMZ(), product_mz_threshold);
-        std::pair<String, double> decoyion = mrmis.getIon(decoy_ionseries, targetion.first);
+          decoy_tr.setNativeID(decoy_tag + tr.getNativeID());
+          decoy_tr.setDecoyTransitionType(ReactionMonitoringTransition::DECOY);
+          decoy_tr.setPrecursorMZ(decoy_precursor_mz);
 
-        if (method == "shift")
-        {
-          decoy_tr.setProductMZ(decoyion.second + product_mz_shift);
-        }
-        else
-        {
-          decoy_tr.setProductMZ(decoyion.second);
-        }
-        decoy_tr.setPeptideRef(decoy_tag + tr.getPeptideRef());
+          // determine the current annotation for the target ion and then select
+          // the appropriate decoy ion for this target transition
+          std::pair<String, double> targetion = mrmis.annotateIon(target_ionseries, tr.getProductMZ(), product_mz_threshold);
+          std::pair<String, double> decoyion = mrmis.getIon(decoy_ionseries, targetion.first);
 
-        if (decoyion.second > 0)
-        {
-          decoy_transitions.push_back(decoy_tr);
-        }
-        else
+          if (method == "shift")
+          {
+            decoy_tr.setProductMZ(decoyion.second + product_mz_shift);
+          }
+          else
+          {
+            decoy_tr.setProductMZ(decoyion.second);
+          }
+          decoy_tr.setPeptideRef(decoy_tag + tr.getPeptideRef());
+
+          if (decoyion.second > 0)
+          {
+            entry_transitions[e].push_back(std::move(decoy_tr));
+          }
+          else
+          {
+            // transition could not be annotated, remove whole peptide
+            entry_exclusions[e].push_back(decoy_tr.getPeptideRef());
+            OPENMS_LOG_DEBUG << "[peptide] Skipping " << decoy_tr.getPeptideRef() << " due to missing annotation" << std::endl;
+          }
+        } // end loop over transitions
+      }
+      catch (...)
+      {
+#pragma omp critical (MRMDecoy_generateDecoys)
+        if (!error)
         {
-          // transition could not be annotated, remove whole peptide
-          exclusion_peptides.insert(decoy_tr.getPeptideRef());
-          OPENMS_LOG_DEBUG << "[peptide] Skipping " << decoy_tr.getPeptideRef() << " due to missing annotation" << std::endl;
+          error = std::current_exception();
         }
-      } // end loop over transitions
-
+      }
+#pragma omp critical (progress)
+      setProgress(++progress);
     } // end loop over peptides
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+
+    for (Size e = 0; e < decoy_entries.size(); ++e)
+    {
+      exclusion_peptides.insert(entry_exclusions[e].begin(), entry_exclusions[e].end());
+      std::move(entry_transitions[e].begin(), entry_transitions[e].end(), std::back_inserter(decoy_transitions));
+    }
     endProgress();
 
     decoy_transitions.erase(std::remove_if(
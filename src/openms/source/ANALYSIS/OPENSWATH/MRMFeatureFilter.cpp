@@ -19,10 +19,115 @@
 
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 #include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
+
+#include <unordered_map>
 
 namespace OpenMS
 {
 
+  namespace
+  {
+    /// Indices of the QCs by component (group) name, in the order of the QCs
+    template <typename QCType, typename NameFunction>
+    std::unordered_map<String, std::vector<Size>> indexQCs(const std::vector<QCType>& qcs, NameFunction name)
+    {
+      std::unordered_map<String, std::vector<Size>> index;
+      for (Size i = 0; i < qcs.size(); ++i)
+      {
+        index[name(qcs[i])].push_back(i);
+      }
+      return index;
+    }
+
+    /// The QCs matching @p name (none if there are none)
+    const std::vector<Size>& findQCs(const std::unordered_map<String, std::vector<Size>>& index, const String& name)
+    {
+      static const std::vector<Size> none;
+      auto it = index.find(name);
+      return it == index.end() ? none : it->second;
+    }
+
+    /// A metaValue QC with its key resolved in the MetaInfoRegistry
+    struct MetaValueQC
+    {
+      String key;
+      UInt index; ///< UInt(-1) if the key is not registered (i.e. no feature has it)
+      double lower;
+      double upper;
+    };
+
+    std::vector<MetaValueQC> resolveMetaValueQCs(const std::map<String, std::pair<double, double>>& meta_value_qc)
+    {
+      std::vector<MetaValueQC> resolved;
+      for (const auto& kv : meta_value_qc)
+      {
+        resolved.push_back({kv.first, MetaInfoInterface::metaRegistry().getIndex(kv.first), kv.second.first, kv.second.second});
+      }
+      return resolved;
+    }
+
+    /// Transitions by native ID (the first transition of each ID)
+    using TransitionIndex = std::unordered_map<String, const ReactionMonitoringTransition*>;
+
+    TransitionIndex indexTransitions(const TargetedExperiment& transitions)
+    {
+      TransitionIndex index;
+      for (const ReactionMonitoringTransition& transition : transitions.getTransitions())
+      {
+        index.emplace(transition.getNativeID(), &transition);
+      }
+      return index;
+    }
+
+    std::map<String, int> countLabelsAndTypes(const Feature& component_group, const TransitionIndex& transitions)
+    {
+      static const ReactionMonitoringTransition no_transition;
+      int n_heavy(0), n_light(0), n_quant(0), n_detect(0), n_ident(0), n_trans(0);
+      for (const Feature& subordinate : component_group.getSubordinates())
+      {
+        // extract out the matching transition
+        const DataValue& native_id = subordinate.getMetaValue("native_id");
+        auto it = native_id.valueType() == DataValue::STRING_VALUE ? transitions.find(native_id.toString()) : transitions.end();
+        const ReactionMonitoringTransition& transition = it == transitions.end() ? no_transition : *it->second;
+
+        // count labels and transition types
+        String label_type = (String)subordinate.getMetaValue("LabelType");
+        if (label_type == "Heavy")
+        {
+          ++n_heavy;
+        }
+        else if (label_type == "Light")
+        {
+          ++n_light;
+        }
+        if (transition.isQuantifyingTransition())
+        {
+          ++n_quant;
+        }
+        if (transition.isIdentifyingTransition())
+        {
+          ++n_ident;
+        }
+        if (transition.isDetectingTransition())
+        {
+          ++n_detect;
+        }
+        ++n_trans;
+      }
+
+      // record
+      std::map<String, int> output;
+      output["n_heavy"] = n_heavy;
+      output["n_light"] = n_light;
+      output["n_quantifying"] = n_quant;
+      output["n_identifying"] = n_ident;
+      output["n_detecting"] = n_detect;
+      output["n_transitions"] = n_trans;
+      return output;
+    }
+  }
+
   MRMFeatureFilter::MRMFeatureFilter() :
     DefaultParamHandler("MRMFeatureFilter")
   {
@@ -50,253 +155,242 @@ namespace OpenMS
     const TargetedExperiment& transitions
   )
   {
-    // initialize QC variables
-    FeatureMap features_filtered;
+    // compile the QCs: look up QCs by name and metaValues by registry index
+    const std::unordered_map<String, std::vector<Size>> cg_qcs_by_name = indexQCs(filter_criteria.component_group_qcs,
+      [](const MRMFeatureQC::ComponentGroupQCs& qc) { return qc.component_group_name; });
+    const std::unordered_map<String, std::vector<Size>> c_qcs_by_name = indexQCs(filter_criteria.component_qcs,
+      [](const MRMFeatureQC::ComponentQCs& qc) { return qc.component_name; });
+    std::vector<std::vector<MetaValueQC>> cg_meta_value_qcs, c_meta_value_qcs;
+    for (const MRMFeatureQC::ComponentGroupQCs& qc : filter_criteria.component_group_qcs)
+    {
+      cg_meta_value_qcs.push_back(resolveMetaValueQCs(qc.meta_value_qc));
+    }
+    for (const MRMFeatureQC::ComponentQCs& qc : filter_criteria.component_qcs)
+    {
+      c_meta_value_qcs.push_back(resolveMetaValueQCs(qc.meta_value_qc));
+    }
+    const TransitionIndex transition_index = indexTransitions(transitions);
+    const UInt native_id_index = MetaInfoInterface::metaRegistry().registerName("native_id");
+    const UInt peptide_ref_index = MetaInfoInterface::metaRegistry().registerName("PeptideRef");
+    const UInt transition_score_index = MetaInfoInterface::metaRegistry().registerName("QC_transition_score");
+    const UInt transition_pass_index = MetaInfoInterface::metaRegistry().registerName("QC_transition_pass");
+    const UInt transition_message_index = MetaInfoInterface::metaRegistry().registerName("QC_transition_message");
+    const UInt group_score_index = MetaInfoInterface::metaRegistry().registerName("QC_transition_group_score");
+    const UInt group_pass_index = MetaInfoInterface::metaRegistry().registerName("QC_transition_group_pass");
+    const UInt group_message_index = MetaInfoInterface::metaRegistry().registerName("QC_transition_group_message");
+
+    const auto check_meta_value = [this, native_id_index](const Feature& component, const MetaValueQC& qc, bool& key_exists)
+    {
+      if (!component.metaValueExists(qc.index))
+      {
+        key_exists = false;
+        OPENMS_LOG_DEBUG << "Warning: no metaValue found for transition_id " << component.getMetaValue(native_id_index) << " for metaValue key " << qc.key << ".";
+        return true;
+      }
+      key_exists = true;
+      return checkRange((double)component.getMetaValue(qc.index), qc.lower, qc.upper);
+    };
 
-    // iterate through each component_group/feature
-    for (size_t feature_it = 0; feature_it < features.size(); ++feature_it)
+    // the features are independent of each other; passing subordinates are collected per feature if filtering
+    const bool filter = flag_or_filter_ == "filter";
+    std::vector<std::vector<Feature>> subordinates_filtered(features.size());
+    std::vector<char> cg_qc_passed(features.size(), false);
+
+    TaskScheduler::parallelFor(0, features.size(), [&](SignedSize feature_it)
     {
-      String component_group_name = (String)features.at(feature_it).getMetaValue("PeptideRef");
+      Feature& feature = features[feature_it];
+      const String component_group_name = (String)feature.getMetaValue(peptide_ref_index);
 
-      std::map<String, int> labels_and_transition_types = countLabelsAndTransitionTypes(features.at(feature_it), transitions);
+      std::map<String, int> labels_and_transition_types = countLabelsAndTypes(feature, transition_index);
 
-      // initialize the new feature and subordinates
-      std::vector<Feature> subordinates_filtered;
+      std::vector<String> component_names;
+      for (const Feature& subordinate : feature.getSubordinates())
+      {
+        component_names.push_back((String)subordinate.getMetaValue(native_id_index));
+      }
+
+      // the QCs of the component group which do not depend on the subordinate
+      // (they are counted once per subordinate)
+      const std::vector<Size>& cg_qcs = findQCs(cg_qcs_by_name, component_group_name);
       bool cg_qc_pass = true;
       StringList cg_qc_fail_message_vec;
       UInt cg_tests_count{ 0 };
+      StringList cg_subordinate_fail_messages;
+      UInt cg_subordinate_tests_count{ 0 };
+      for (Size cg_qc_it : cg_qcs)
+      {
+        const MRMFeatureQC::ComponentGroupQCs& qc = filter_criteria.component_group_qcs[cg_qc_it];
+        if (!checkRange(feature.getRT(), qc.retention_time_l, qc.retention_time_u))
+        {
+          cg_subordinate_fail_messages.push_back("retention_time");
+        }
+        if (!checkRange((double)feature.getIntensity(), qc.intensity_l, qc.intensity_u))
+        {
+          cg_subordinate_fail_messages.push_back("intensity");
+        }
+        if (!checkRange((double)feature.getOverallQuality(), qc.overall_quality_l, qc.overall_quality_u))
+        {
+          cg_subordinate_fail_messages.push_back("overall_quality");
+        }
+        // labels and transition counts QC
+        if (!checkRange(labels_and_transition_types["n_heavy"], qc.n_heavy_l, qc.n_heavy_u))
+        {
+          cg_subordinate_fail_messages.push_back("n_heavy");
+        }
+        if (!checkRange(labels_and_transition_types["n_light"], qc.n_light_l, qc.n_light_u))
+        {
+          cg_subordinate_fail_messages.push_back("n_light");
+        }
+        if (!checkRange(labels_and_transition_types["n_detecting"], qc.n_detecting_l, qc.n_detecting_u))
+        {
+          cg_subordinate_fail_messages.push_back("n_detecting");
+        }
+        if (!checkRange(labels_and_transition_types["n_quantifying"], qc.n_quantifying_l, qc.n_quantifying_u))
+        {
+          cg_subordinate_fail_messages.push_back("n_quantifying");
+        }
+        if (!checkRange(labels_and_transition_types["n_identifying"], qc.n_identifying_l, qc.n_identifying_u))
+        {
+          cg_subordinate_fail_messages.push_back("n_identifying");
+        }
+        if (!checkRange(labels_and_transition_types["n_transitions"], qc.n_transitions_l, qc.n_transitions_u))
+        {
+          cg_subordinate_fail_messages.push_back("n_transitions");
+        }
+        cg_subordinate_tests_count += 9;
+
+        for (const MetaValueQC& meta_value_qc : cg_meta_value_qcs[cg_qc_it])
+        {
+          bool metavalue_exists{ false };
+          if (!check_meta_value(feature, meta_value_qc, metavalue_exists))
+          {
+            cg_subordinate_fail_messages.push_back(meta_value_qc.key);
+          }
+          if (metavalue_exists) ++cg_subordinate_tests_count;
+        }
+      }
+      if (!cg_subordinate_fail_messages.empty() && !feature.getSubordinates().empty())
+      {
+        cg_qc_pass = false;
+      }
 
       // iterate through each component/sub-feature
-      for (size_t sub_it = 0; sub_it < features.at(feature_it).getSubordinates().size(); ++sub_it)
+      for (size_t sub_it = 0; sub_it < feature.getSubordinates().size(); ++sub_it)
       {
-        String component_name = (String)features.at(feature_it).getSubordinates().at(sub_it).getMetaValue("native_id");
+        Feature& subordinate = feature.getSubordinates()[sub_it];
+        const String& component_name = component_names[sub_it];
         bool c_qc_pass = true;
         StringList c_qc_fail_message_vec;
 
-        // iterate through multi-feature/multi-sub-feature QCs/filters
-        // iterate through component_groups
-        for (size_t cg_qc_it = 0; cg_qc_it < filter_criteria.component_group_qcs.size(); ++cg_qc_it)
+        cg_qc_fail_message_vec.insert(cg_qc_fail_message_vec.end(), cg_subordinate_fail_messages.begin(), cg_subordinate_fail_messages.end());
+        cg_tests_count += cg_subordinate_tests_count;
+
+        // ion ratio QC
+        for (Size cg_qc_it : cg_qcs)
         {
-          if (filter_criteria.component_group_qcs.at(cg_qc_it).component_group_name == component_group_name)
+          const MRMFeatureQC::ComponentGroupQCs& qc = filter_criteria.component_group_qcs[cg_qc_it];
+          if (qc.ion_ratio_pair_name_1.empty() || qc.ion_ratio_pair_name_2.empty() || qc.ion_ratio_pair_name_1 != component_name)
           {
-            const double rt = features.at(feature_it).getRT();
-            if (!checkRange(rt,
-              filter_criteria.component_group_qcs.at(cg_qc_it).retention_time_l,
-              filter_criteria.component_group_qcs.at(cg_qc_it).retention_time_u))
-            {
-              cg_qc_pass = false;
-              cg_qc_fail_message_vec.push_back("retention_time");
-            }
-
-            const double intensity = features.at(feature_it).getIntensity();
-            if (!checkRange(intensity,
-              filter_criteria.component_group_qcs.at(cg_qc_it).intensity_l,
-              filter_criteria.component_group_qcs.at(cg_qc_it).intensity_u))
-            {
-              cg_qc_pass = false;
-              cg_qc_fail_message_vec.push_back("intensity");
-            }
-
-            const double quality = features.at(feature_it).getOverallQuality();
-            if (!checkRange(quality,
-              filter_criteria.component_group_qcs.at(cg_qc_it).overall_quality_l,
-              filter_criteria.component_group_qcs.at(cg_qc_it).overall_quality_u))
-            {
-              cg_qc_pass = false;
-              cg_qc_fail_message_vec.push_back("overall_quality");
-            }
-            // labels and transition counts QC
-            if (!checkRange(labels_and_transition_types["n_heavy"],
-              filter_criteria.component_group_qcs.at(cg_qc_it).n_heavy_l,
-              filter_criteria.component_group_qcs.at(cg_qc_it).n_heavy_u))
-            {
-              cg_qc_pass = false;
-              cg_qc_fail_message_vec.push_back("n_heavy");
-            }
-            if (!checkRange(labels_and_transition_types["n_light"],
-              filter_criteria.component_group_qcs.at(cg_qc_it).n_light_l,
-              filter_criteria.component_group_qcs.at(cg_qc_it).n_light_u))
-            {
-              cg_qc_pass = false;
-              cg_qc_fail_message_vec.push_back("n_light");
-            }
-            if (!checkRange(labels_and_transition_types["n_detecting"],
-              filter_criteria.component_group_qcs.at(cg_qc_it).n_detecting_l,
-              filter_criteria.component_group_qcs.at(cg_qc_it).n_detecting_u))
-            {
-              cg_qc_pass = false;
-              cg_qc_fail_message_vec.push_back("n_detecting");
-            }
-            if (!checkRange(labels_and_transition_types["n_quantifying"],
-              filter_criteria.component_group_qcs.at(cg_qc_it).n_quantifying_l,
-              filter_criteria.component_group_qcs.at(cg_qc_it).n_quantifying_u))
-            {
-              cg_qc_pass = false;
-              cg_qc_fail_message_vec.push_back("n_quantifying");
-            }
-            if (!checkRange(labels_and_transition_types["n_identifying"],
-              filter_criteria.component_group_qcs.at(cg_qc_it).n_identifying_l,
-              filter_criteria.component_group_qcs.at(cg_qc_it).n_identifying_u))
-            {
-              cg_qc_pass = false;
-              cg_qc_fail_message_vec.push_back("n_identifying");
-            }
-            if (!checkRange(labels_and_transition_types["n_transitions"],
-              filter_criteria.component_group_qcs.at(cg_qc_it).n_transitions_l,
-              filter_criteria.component_group_qcs.at(cg_qc_it).n_transitions_u))
-            {
-              cg_qc_pass = false;
-              cg_qc_fail_message_vec.push_back("n_transitions");
-            }
-
-            cg_tests_count += 9;
-
-            // ion ratio QC
-            for (size_t sub_it2 = 0; sub_it2 < features.at(feature_it).getSubordinates().size(); ++sub_it2)
-            {
-              String component_name2 = (String)features.at(feature_it).getSubordinates().at(sub_it2).getMetaValue("native_id");
-              // find the ion ratio pair
-              if (!filter_criteria.component_group_qcs.at(cg_qc_it).ion_ratio_pair_name_1.empty()
-               && !filter_criteria.component_group_qcs.at(cg_qc_it).ion_ratio_pair_name_2.empty()
-               && filter_criteria.component_group_qcs.at(cg_qc_it).ion_ratio_pair_name_1 == component_name
-               && filter_criteria.component_group_qcs.at(cg_qc_it).ion_ratio_pair_name_2 == component_name2)
-              {
-                double ion_ratio = calculateIonRatio(features.at(feature_it).getSubordinates().at(sub_it), features.at(feature_it).getSubordinates().at(sub_it2), filter_criteria.component_group_qcs.at(cg_qc_it).ion_ratio_feature_name);
-
-                if (!checkRange(ion_ratio,
-                  filter_criteria.component_group_qcs.at(cg_qc_it).ion_ratio_l,
-                  filter_criteria.component_group_qcs.at(cg_qc_it).ion_ratio_u))
-                {
-                  cg_qc_pass = false;
-                  cg_qc_fail_message_vec.push_back("ion_ratio_pair[" + component_name + "/" + component_name2 + "]");
-                }
-                ++cg_tests_count;
-              }
-            }
-
-            //std::pair<const String, std::pair<double, double>>
-            for (const auto& kv : filter_criteria.component_group_qcs.at(cg_qc_it).meta_value_qc)
+            continue;
+          }
+          for (size_t sub_it2 = 0; sub_it2 < component_names.size(); ++sub_it2)
+          {
+            const String& component_name2 = component_names[sub_it2];
+            // find the ion ratio pair
+            if (qc.ion_ratio_pair_name_2 == component_name2)
             {
-              bool metavalue_exists{ false };
-              if (!checkMetaValue(features.at(feature_it), kv.first, kv.second.first, kv.second.second, metavalue_exists))
+              double ion_ratio = calculateIonRatio(subordinate, feature.getSubordinates()[sub_it2], qc.ion_ratio_feature_name);
+              if (!checkRange(ion_ratio, qc.ion_ratio_l, qc.ion_ratio_u))
               {
                 cg_qc_pass = false;
-                cg_qc_fail_message_vec.push_back(kv.first);
+                cg_qc_fail_message_vec.push_back("ion_ratio_pair[" + component_name + "/" + component_name2 + "]");
               }
-              if (metavalue_exists) ++cg_tests_count;
+              ++cg_tests_count;
             }
           }
         }
 
         UInt c_tests_count{ 0 };
         // iterate through feature/sub-feature QCs/filters
-        for (size_t c_qc_it = 0; c_qc_it < filter_criteria.component_qcs.size(); ++c_qc_it)
+        for (Size c_qc_it : findQCs(c_qcs_by_name, component_name))
         {
-          if (filter_criteria.component_qcs.at(c_qc_it).component_name == component_name)
+          const MRMFeatureQC::ComponentQCs& qc = filter_criteria.component_qcs[c_qc_it];
+          // RT check
+          if (!checkRange(subordinate.getRT(), qc.retention_time_l, qc.retention_time_u))
           {
-            // RT check
-            const double rt = features.at(feature_it).getSubordinates().at(sub_it).getRT();
-            if (!checkRange(rt,
-              filter_criteria.component_qcs.at(c_qc_it).retention_time_l,
-              filter_criteria.component_qcs.at(c_qc_it).retention_time_u))
-            {
-              c_qc_pass = false;
-              c_qc_fail_message_vec.push_back("retention_time");
-            }
+            c_qc_pass = false;
+            c_qc_fail_message_vec.push_back("retention_time");
+          }
 
-            // intensity check
-            double intensity = features.at(feature_it).getSubordinates().at(sub_it).getIntensity();
-            if (!checkRange(intensity,
-              filter_criteria.component_qcs.at(c_qc_it).intensity_l,
-              filter_criteria.component_qcs.at(c_qc_it).intensity_u))
-            {
-              c_qc_pass = false;
-              c_qc_fail_message_vec.push_back("intensity");
-            }
+          // intensity check
+          if (!checkRange((double)subordinate.getIntensity(), qc.intensity_l, qc.intensity_u))
+          {
+            c_qc_pass = false;
+            c_qc_fail_message_vec.push_back("intensity");
+          }
 
-            // overall quality check getQuality
-            double quality = features.at(feature_it).getSubordinates().at(sub_it).getOverallQuality();
-            if (!checkRange(quality,
-              filter_criteria.component_qcs.at(c_qc_it).overall_quality_l,
-              filter_criteria.component_qcs.at(c_qc_it).overall_quality_u))
-            {
-              c_qc_pass = false;
-              c_qc_fail_message_vec.push_back("overall_quality");
-            }
+          // overall quality check getQuality
+          if (!checkRange((double)subordinate.getOverallQuality(), qc.overall_quality_l, qc.overall_quality_u))
+          {
+            c_qc_pass = false;
+            c_qc_fail_message_vec.push_back("overall_quality");
+          }
 
-            c_tests_count += 3;
+          c_tests_count += 3;
 
-            // metaValue checks
-            for (auto const& kv : filter_criteria.component_qcs.at(c_qc_it).meta_value_qc)
+          // metaValue checks
+          for (const MetaValueQC& meta_value_qc : c_meta_value_qcs[c_qc_it])
+          {
+            bool metavalue_exists{ false };
+            if (!check_meta_value(subordinate, meta_value_qc, metavalue_exists))
             {
-              bool metavalue_exists{ false };
-              if (!checkMetaValue(features.at(feature_it).getSubordinates().at(sub_it), kv.first, kv.second.first, kv.second.second, metavalue_exists))
-              {
-                c_qc_pass = false;
-                c_qc_fail_message_vec.push_back(kv.first);
-              }
-              if (metavalue_exists) ++c_tests_count;
+              c_qc_pass = false;
+              c_qc_fail_message_vec.push_back(meta_value_qc.key);
             }
+            if (metavalue_exists) ++c_tests_count;
           }
         }
 
         const double c_score = c_tests_count ? 1.0 - c_qc_fail_message_vec.size() / (double)c_tests_count : 1.0;
-        features.at(feature_it).getSubordinates().at(sub_it).setMetaValue("QC_transition_score", c_score);
+        subordinate.setMetaValue(transition_score_index, c_score);
 
         // Copy or Flag passing/failing subordinates
-        if (c_qc_pass && flag_or_filter_ == "filter")
-        {
-          subordinates_filtered.push_back(features.at(feature_it).getSubordinates().at(sub_it));
-        }
-        else if (c_qc_pass && flag_or_filter_ == "flag")
+        if (c_qc_pass && filter)
         {
-          features.at(feature_it).getSubordinates().at(sub_it).setMetaValue("QC_transition_pass", true);
-          features.at(feature_it).getSubordinates().at(sub_it).setMetaValue("QC_transition_message", StringList());
+          subordinates_filtered[feature_it].push_back(subordinate);
         }
-        else if (!c_qc_pass && flag_or_filter_ == "filter")
-        {
-          // do nothing
-        }
-        else if (!c_qc_pass && flag_or_filter_ == "flag")
+        else if (!filter)
         {
-          features.at(feature_it).getSubordinates().at(sub_it).setMetaValue("QC_transition_pass", false);
-          features.at(feature_it).getSubordinates().at(sub_it).setMetaValue("QC_transition_message", getUniqueSorted(c_qc_fail_message_vec));
+          subordinate.setMetaValue(transition_pass_index, c_qc_pass);
+          subordinate.setMetaValue(transition_message_index, c_qc_pass ? StringList() : getUniqueSorted(c_qc_fail_message_vec));
         }
       }
 
       const double cg_score = cg_tests_count ? 1.0 - cg_qc_fail_message_vec.size() / (double)cg_tests_count : 1.0;
-      features.at(feature_it).setMetaValue("QC_transition_group_score", cg_score);
+      feature.setMetaValue(group_score_index, cg_score);
 
-      // Copy or Flag passing/failing Features
-      if (cg_qc_pass && flag_or_filter_ == "filter" && !subordinates_filtered.empty())
-      {
-        Feature feature_filtered(features.at(feature_it));
-        feature_filtered.setSubordinates(subordinates_filtered);
-        features_filtered.push_back(feature_filtered);
-      }
-      else if (cg_qc_pass && flag_or_filter_ == "filter" && subordinates_filtered.empty())
-      {
-        // do nothing
-      }
-      else if (cg_qc_pass && flag_or_filter_ == "flag")
-      {
-        features.at(feature_it).setMetaValue("QC_transition_group_pass", true);
-        features.at(feature_it).setMetaValue("QC_transition_group_message", StringList());
-      }
-      else if (!cg_qc_pass && flag_or_filter_ == "filter")
+      // Flag passing/failing Features
+      cg_qc_passed[feature_it] = cg_qc_pass;
+      if (!filter)
       {
-        // do nothing
+        feature.setMetaValue(group_pass_index, cg_qc_pass);
+        feature.setMetaValue(group_message_index, cg_qc_pass ? StringList() : getUniqueSorted(cg_qc_fail_message_vec));
       }
-      else if (!cg_qc_pass && flag_or_filter_ == "flag")
-      {
-        features.at(feature_it).setMetaValue("QC_transition_group_pass", false);
-        features.at(feature_it).setMetaValue("QC_transition_group_message", getUniqueSorted(cg_qc_fail_message_vec));
-      }
-    }
+    });
 
     // replace with the filtered featureMap
-    if (flag_or_filter_ == "filter")
+    if (filter)
     {
+      FeatureMap features_filtered;
+      for (size_t feature_it = 0; feature_it < features.size(); ++feature_it)
+      {
+        if (cg_qc_passed[feature_it] && !subordinates_filtered[feature_it].empty())
+        {
+          Feature feature_filtered(features[feature_it]);
+          feature_filtered.setSubordinates(subordinates_filtered[feature_it]);
+          features_filtered.push_back(feature_filtered);
+        }
+      }
       features = features_filtered;
     }
   }
@@ -618,185 +712,129 @@ namespace OpenMS
 
   void MRMFeatureFilter::EstimateDefaultMRMFeatureQCValues(const std::vector<FeatureMap>& samples, MRMFeatureQC& filter_template, const TargetedExperiment& transitions, const bool& init_template_values) const
   {
+    const std::unordered_map<String, std::vector<Size>> cg_qcs_by_name = indexQCs(filter_template.component_group_qcs,
+      [](const MRMFeatureQC::ComponentGroupQCs& qc) { return qc.component_group_name; });
+    const std::unordered_map<String, std::vector<Size>> c_qcs_by_name = indexQCs(filter_template.component_qcs,
+      [](const MRMFeatureQC::ComponentQCs& qc) { return qc.component_name; });
+    const TransitionIndex transition_index = indexTransitions(transitions);
+
     // iterate through each sample and accumulate the min/max values in the samples in the filter_template
     for (size_t sample_it = 0; sample_it < samples.size(); sample_it++) {
+      const bool init = sample_it == 0 && init_template_values;
 
       // iterate through each component_group/feature
-      for (size_t feature_it = 0; feature_it < samples.at(sample_it).size(); ++feature_it)
+      for (const Feature& feature : samples[sample_it])
       {
-        String component_group_name = (String)samples.at(sample_it).at(feature_it).getMetaValue("PeptideRef");
-        std::map<String, int> labels_and_transition_types = countLabelsAndTransitionTypes(samples.at(sample_it).at(feature_it), transitions);
+        if (feature.getSubordinates().empty()) continue;
 
-        // iterate through each component/sub-feature
-        for (size_t sub_it = 0; sub_it < samples.at(sample_it).at(feature_it).getSubordinates().size(); ++sub_it)
+        String component_group_name = (String)feature.getMetaValue("PeptideRef");
+        std::map<String, int> labels_and_transition_types = countLabelsAndTypes(feature, transition_index);
+        const std::vector<Size>& cg_qcs = findQCs(cg_qcs_by_name, component_group_name);
+
+        // the component group values which do not depend on the subordinate
+        for (Size cg_qc_it : cg_qcs)
         {
-          String component_name = (String)samples.at(sample_it).at(feature_it).getSubordinates().at(sub_it).getMetaValue("native_id");
+          MRMFeatureQC::ComponentGroupQCs& qc = filter_template.component_group_qcs[cg_qc_it];
+          const double rt = feature.getRT();
+          const double intensity = feature.getIntensity();
+          const double quality = feature.getOverallQuality();
+          if (init) {
+            initRange(rt, qc.retention_time_l, qc.retention_time_u);
+            initRange(intensity, qc.intensity_l, qc.intensity_u);
+            initRange(quality, qc.overall_quality_l, qc.overall_quality_u);
 
-          // iterate through multi-feature/multi-sub-feature QCs/filters
-          // iterate through component_groups
-          for (size_t cg_qc_it = 0; cg_qc_it < filter_template.component_group_qcs.size(); ++cg_qc_it)
-          {
-            if (filter_template.component_group_qcs.at(cg_qc_it).component_group_name == component_group_name)
-            {
-              const double rt = samples.at(sample_it).at(feature_it).getRT();
-              if (sample_it == 0 && init_template_values) {
-                initRange(rt,
-                  filter_template.component_group_qcs.at(cg_qc_it).retention_time_l,
-                  filter_template.component_group_qcs.at(cg_qc_it).retention_time_u);
-              } else {
-                updateRange(rt,
-                  filter_template.component_group_qcs.at(cg_qc_it).retention_time_l,
-                  filter_template.component_group_qcs.at(cg_qc_it).retention_time_u);
-              }
+            // labels and transition counts QC
+            initRange(labels_and_transition_types["n_heavy"], qc.n_heavy_l, qc.n_heavy_u);
+            initRange(labels_and_transition_types["n_light"], qc.n_light_l, qc.n_light_u);
+            initRange(labels_and_transition_types["n_detecting"], qc.n_detecting_l, qc.n_detecting_u);
+            initRange(labels_and_transition_types["n_quantifying"], qc.n_quantifying_l, qc.n_quantifying_u);
+            initRange(labels_and_transition_types["n_identifying"], qc.n_identifying_l, qc.n_identifying_u);
+            initRange(labels_and_transition_types["n_transitions"], qc.n_transitions_l, qc.n_transitions_u);
+          } else {
+            updateRange(rt, qc.retention_time_l, qc.retention_time_u);
+            updateRange(intensity, qc.intensity_l, qc.intensity_u);
+            updateRange(quality, qc.overall_quality_l, qc.overall_quality_u);
 
-              const double intensity = samples.at(sample_it).at(feature_it).getIntensity();
-              if (sample_it == 0 && init_template_values) {
-                initRange(intensity,
-                  filter_template.component_group_qcs.at(cg_qc_it).intensity_l,
-                  filter_template.component_group_qcs.at(cg_qc_it).intensity_u);
-              } else {
-                updateRange(intensity,
-                  filter_template.component_group_qcs.at(cg_qc_it).intensity_l,
-                  filter_template.component_group_qcs.at(cg_qc_it).intensity_u);
-              }
+            // labels and transition counts QC
+            updateRange(labels_and_transition_types["n_heavy"], qc.n_heavy_l, qc.n_heavy_u);
+            updateRange(labels_and_transition_types["n_light"], qc.n_light_l, qc.n_light_u);
+            updateRange(labels_and_transition_types["n_detecting"], qc.n_detecting_l, qc.n_detecting_u);
+            updateRange(labels_and_transition_types["n_quantifying"], qc.n_quantifying_l, qc.n_quantifying_u);
+            updateRange(labels_and_transition_types["n_identifying"], qc.n_identifying_l, qc.n_identifying_u);
+            updateRange(labels_and_transition_types["n_transitions"], qc.n_transitions_l, qc.n_transitions_u);
+          }
 
-              const double quality = samples.at(sample_it).at(feature_it).getOverallQuality();
-              if (sample_it == 0 && init_template_values) {
-                initRange(quality,
-                  filter_template.component_group_qcs.at(cg_qc_it).overall_quality_l,
-                  filter_template.component_group_qcs.at(cg_qc_it).overall_quality_u);
-              } else {
-                updateRange(quality,
-                  filter_template.component_group_qcs.at(cg_qc_it).overall_quality_l,
-                  filter_template.component_group_qcs.at(cg_qc_it).overall_quality_u);
-              }
+          for (auto& kv : qc.meta_value_qc)
+          {
+            bool metavalue_exists{ false };
+            if (init) {
+              updateMetaValue(feature, kv.first, kv.second.first, kv.second.second, metavalue_exists);
+            } else {
+              initMetaValue(feature, kv.first, kv.second.first, kv.second.second, metavalue_exists);
+            }
+          }
+        }
 
-              // labels and transition counts QC
-              if (sample_it == 0 && init_template_values) {
-                initRange(labels_and_transition_types["n_heavy"],
-                  filter_template.component_group_qcs.at(cg_qc_it).n_heavy_l,
-                  filter_template.component_group_qcs.at(cg_qc_it).n_heavy_u);
-                initRange(labels_and_transition_types["n_light"],
-                  filter_template.component_group_qcs.at(cg_qc_it).n_light_l,
-                  filter_template.component_group_qcs.at(cg_qc_it).n_light_u);
-                initRange(labels_and_transition_types["n_detecting"],
-                  filter_template.component_group_qcs.at(cg_qc_it).n_detecting_l,
-                  filter_template.component_group_qcs.at(cg_qc_it).n_detecting_u);
-                initRange(labels_and_transition_types["n_quantifying"],
-                  filter_template.component_group_qcs.at(cg_qc_it).n_quantifying_l,
-                  filter_template.component_group_qcs.at(cg_qc_it).n_quantifying_u);
-                initRange(labels_and_transition_types["n_identifying"],
-                  filter_template.component_group_qcs.at(cg_qc_it).n_identifying_l,
-                  filter_template.component_group_qcs.at(cg_qc_it).n_identifying_u);
-                initRange(labels_and_transition_types["n_transitions"],
-                  filter_template.component_group_qcs.at(cg_qc_it).n_transitions_l,
-                  filter_template.component_group_qcs.at(cg_qc_it).n_transitions_u);
-              } else {
-                updateRange(labels_and_transition_types["n_heavy"],
-                  filter_template.component_group_qcs.at(cg_qc_it).n_heavy_l,
-                  filter_template.component_group_qcs.at(cg_qc_it).n_heavy_u);
-                updateRange(labels_and_transition_types["n_light"],
-                  filter_template.component_group_qcs.at(cg_qc_it).n_light_l,
-                  filter_template.component_group_qcs.at(cg_qc_it).n_light_u);
-                updateRange(labels_and_transition_types["n_detecting"],
-                  filter_template.component_group_qcs.at(cg_qc_it).n_detecting_l,
-                  filter_template.component_group_qcs.at(cg_qc_it).n_detecting_u);
-                updateRange(labels_and_transition_types["n_quantifying"],
-                  filter_template.component_group_qcs.at(cg_qc_it).n_quantifying_l,
-                  filter_template.component_group_qcs.at(cg_qc_it).n_quantifying_u);
-                updateRange(labels_and_transition_types["n_identifying"],
-                  filter_template.component_group_qcs.at(cg_qc_it).n_identifying_l,
-                  filter_template.component_group_qcs.at(cg_qc_it).n_identifying_u);
-                updateRange(labels_and_transition_types["n_transitions"],
-                  filter_template.component_group_qcs.at(cg_qc_it).n_transitions_l,
-                  filter_template.component_group_qcs.at(cg_qc_it).n_transitions_u);
-              }
+        std::vector<String> component_names;
+        for (const Feature& subordinate : feature.getSubordinates())
+        {
+          component_names.push_back((String)subordinate.getMetaValue("native_id"));
+        }
 
-              // ion ratio QC
-              for (size_t sub_it2 = 0; sub_it2 < samples.at(sample_it).at(feature_it).getSubordinates().size(); ++sub_it2)
-              {
-                String component_name2 = (String)samples.at(sample_it).at(feature_it).getSubordinates().at(sub_it2).getMetaValue("native_id");
-                // find the ion ratio pair
-                if (!filter_template.component_group_qcs.at(cg_qc_it).ion_ratio_pair_name_1.empty()
-                 && !filter_template.component_group_qcs.at(cg_qc_it).ion_ratio_pair_name_2.empty()
-                 && filter_template.component_group_qcs.at(cg_qc_it).ion_ratio_pair_name_1 == component_name
-                 && filter_template.component_group_qcs.at(cg_qc_it).ion_ratio_pair_name_2 == component_name2)
-                {
-                  double ion_ratio = calculateIonRatio(samples.at(sample_it).at(feature_it).getSubordinates().at(sub_it), samples.at(sample_it).at(feature_it).getSubordinates().at(sub_it2), filter_template.component_group_qcs.at(cg_qc_it).ion_ratio_feature_name);
-                  if (sample_it == 0 && init_template_values) {
-                    initRange(ion_ratio,
-                      filter_template.component_group_qcs.at(cg_qc_it).ion_ratio_l,
-                      filter_template.component_group_qcs.at(cg_qc_it).ion_ratio_u);
-                  } else {
-                    updateRange(ion_ratio,
-                      filter_template.component_group_qcs.at(cg_qc_it).ion_ratio_l,
-                      filter_template.component_group_qcs.at(cg_qc_it).ion_ratio_u);
-                  }
-                }
-              }
+        // iterate through each component/sub-feature
+        for (size_t sub_it = 0; sub_it < feature.getSubordinates().size(); ++sub_it)
+        {
+          const Feature& subordinate = feature.getSubordinates()[sub_it];
+          const String& component_name = component_names[sub_it];
 
-              for (auto& kv : filter_template.component_group_qcs.at(cg_qc_it).meta_value_qc)
+          // ion ratio QC
+          for (Size cg_qc_it : cg_qcs)
+          {
+            MRMFeatureQC::ComponentGroupQCs& qc = filter_template.component_group_qcs[cg_qc_it];
+            if (qc.ion_ratio_pair_name_1.empty() || qc.ion_ratio_pair_name_2.empty() || qc.ion_ratio_pair_name_1 != component_name)
+            {
+              continue;
+            }
+            for (size_t sub_it2 = 0; sub_it2 < component_names.size(); ++sub_it2)
+            {
+              // find the ion ratio pair
+              if (qc.ion_ratio_pair_name_2 == component_names[sub_it2])
               {
-                bool metavalue_exists{ false };
-                if (sample_it == 0 && init_template_values) {
-                  updateMetaValue(samples.at(sample_it).at(feature_it), kv.first, kv.second.first, kv.second.second, metavalue_exists);
+                double ion_ratio = calculateIonRatio(subordinate, feature.getSubordinates()[sub_it2], qc.ion_ratio_feature_name);
+                if (init) {
+                  initRange(ion_ratio, qc.ion_ratio_l, qc.ion_ratio_u);
                 } else {
-                  initMetaValue(samples.at(sample_it).at(feature_it), kv.first, kv.second.first, kv.second.second, metavalue_exists);
+                  updateRange(ion_ratio, qc.ion_ratio_l, qc.ion_ratio_u);
                 }
               }
             }
           }
 
           // iterate through feature/sub-feature QCs/filters
-          for (size_t c_qc_it = 0; c_qc_it < filter_template.component_qcs.size(); ++c_qc_it)
+          for (Size c_qc_it : findQCs(c_qcs_by_name, component_name))
           {
-            if (filter_template.component_qcs.at(c_qc_it).component_name == component_name)
-            {
-              // RT check
-              const double rt = samples.at(sample_it).at(feature_it).getSubordinates().at(sub_it).getRT();
-              if (sample_it == 0 && init_template_values) {
-                initRange(rt,
-                  filter_template.component_qcs.at(c_qc_it).retention_time_l,
-                  filter_template.component_qcs.at(c_qc_it).retention_time_u);
-              } else {
-                updateRange(rt,
-                  filter_template.component_qcs.at(c_qc_it).retention_time_l,
-                  filter_template.component_qcs.at(c_qc_it).retention_time_u);
-              }
-
-              // intensity check
-              double intensity = samples.at(sample_it).at(feature_it).getSubordinates().at(sub_it).getIntensity();
-              if (sample_it == 0 && init_template_values) {
-                initRange(intensity,
-                  filter_template.component_qcs.at(c_qc_it).intensity_l,
-                  filter_template.component_qcs.at(c_qc_it).intensity_u);
-              } else {
-                updateRange(intensity,
-                  filter_template.component_qcs.at(c_qc_it).intensity_l,
-                  filter_template.component_qcs.at(c_qc_it).intensity_u);
-              }
+            MRMFeatureQC::ComponentQCs& qc = filter_template.component_qcs[c_qc_it];
+            const double rt = subordinate.getRT();
+            const double intensity = subordinate.getIntensity();
+            const double quality = subordinate.getOverallQuality();
+            if (init) {
+              initRange(rt, qc.retention_time_l, qc.retention_time_u);
+              initRange(intensity, qc.intensity_l, qc.intensity_u);
+              initRange(quality, qc.overall_quality_l, qc.overall_quality_u);
+            } else {
+              updateRange(rt, qc.retention_time_l, qc.retention_time_u);
+              updateRange(intensity, qc.intensity_l, qc.intensity_u);
+              updateRange(quality, qc.overall_quality_l, qc.overall_quality_u);
+            }
 
-              // overall quality check getQuality
-              double quality = samples.at(sample_it).at(feature_it).getSubordinates().at(sub_it).getOverallQuality();
-              if (sample_it == 0 && init_template_values) {
-                initRange(quality,
-                  filter_template.component_qcs.at(c_qc_it).overall_quality_l,
-                  filter_template.component_qcs.at(c_qc_it).overall_quality_u);
+            // metaValue checks
+            for (auto& kv : qc.meta_value_qc)
+            {
+              bool metavalue_exists{ false };
+              if (init) {
+                initMetaValue(subordinate, kv.first, kv.second.first, kv.second.second, metavalue_exists);
               } else {
-                updateRange(quality,
-                  filter_template.component_qcs.at(c_qc_it).overall_quality_l,
-                  filter_template.component_qcs.at(c_qc_it).overall_quality_u);
-              }
-
-              // metaValue checks
-              for (auto& kv : filter_template.component_qcs.at(c_qc_it).meta_value_qc)
-              {
-                bool metavalue_exists{ false };
-                if (sample_it == 0 && init_template_values) {
-                  initMetaValue(samples.at(sample_it).at(feature_it).getSubordinates().at(sub_it), kv.first, kv.second.first, kv.second.second, metavalue_exists);
-                } else {
-                  updateMetaValue(samples.at(sample_it).at(feature_it).getSubordinates().at(sub_it), kv.first, kv.second.first, kv.second.second, metavalue_exists);
-                }
+                updateMetaValue(subordinate, kv.first, kv.second.first, kv.second.second, metavalue_exists);
               }
             }
           }
@@ -855,57 +893,7 @@ namespace OpenMS
     const Feature& component_group,
     const TargetedExperiment& transitions) const
   {
-    int n_heavy(0), n_light(0), n_quant(0), n_detect(0), n_ident(0), n_trans(0);
-    std::map<String, int> output;
-
-    for (size_t cg_it = 0; cg_it < component_group.getSubordinates().size(); ++cg_it)
-    {
-
-      // extract out the matching transition
-      ReactionMonitoringTransition transition;
-      for (size_t trans_it = 0; trans_it < transitions.getTransitions().size(); ++trans_it)
-      {
-        if (transitions.getTransitions()[trans_it].getNativeID() == component_group.getSubordinates()[cg_it].getMetaValue("native_id"))
-        {
-          transition = transitions.getTransitions()[trans_it];
-          break;
-        }
-      }
-
-      // count labels and transition types
-      String label_type = (String)component_group.getSubordinates()[cg_it].getMetaValue("LabelType");
-      if (label_type == "Heavy")
-      {
-        ++n_heavy;
-      } 
-      else if (label_type == "Light")
-      {
-        ++n_light;
-      }
-      if (transition.isQuantifyingTransition())
-      {
-        ++n_quant;
-      }
-      if (transition.isIdentifyingTransition())
-      {
-        ++n_ident;
-      }
-      if (transition.isDetectingTransition())
-      {
-        ++n_detect;
-      }
-      ++n_trans;
-    }
-
-    // record
-    output["n_heavy"] = n_heavy;
-    output["n_light"] = n_light;
-    output["n_quantifying"] = n_quant;
-    output["n_identifying"] = n_ident;
-    output["n_detecting"] = n_detect;
-    output["n_transitions"] = n_trans;
-
-    return output;
+    return countLabelsAndTypes(component_group, indexTransitions(transitions));
   }
 
   double MRMFeatureFilter::calculateIonRatio(const Feature& component_1, const Feature& component_2, const String& feature_name) const
@@ -26,6 +26,9 @@
 #include <boost/make_shared.hpp>
 #include <boost/foreach.hpp>
 
+#include <exception>
+#include <iterator>
+
 #define run_identifier "unique_run_identifier"
 
 bool SortDoubleDoublePairFirst(const std::pair<double, double>& left, const std::pair<double, double>& right)
@@ -211,31 +214,68 @@ namespace OpenMS
     // Step 3
     //
     // Go through all transition groups: first create consensus features, then score them
-    MRMTransitionGroupPicker trgroup_picker;
     Param trgroup_picker_param = param_.copy("TransitionGroupPicker:", true);
     // If use_total_mi_score is defined, we need to instruct MRMTransitionGroupPicker to compute the score
     if (su_.use_total_mi_score_)
     {
       trgroup_picker_param.setValue("compute_total_mi", "true");
     }
-    trgroup_picker.setParameters(trgroup_picker_param);
 
+    std::vector<MRMTransitionGroupType*> transition_groups;
+    for (auto& trgroup : transition_group_map)
+    {
+      if (!trgroup.second.getChromatograms().empty() && !trgroup.second.getTransitions().empty())
+      {
+        transition_groups.push_back(&trgroup.second);
+      }
+    }
+
+    // Pick and score the transition groups in parallel (unless we are
+    // already inside a parallel region, e.g. one per SWATH window): each
+    // thread uses its own picker and each group its own feature buffer, the
+    // buffers are appended to the output in map order so that the output
+    // does not depend on the number of threads. With only a single group,
+    // scorePeakgroups() parallelizes over its peak groups instead.
+    std::vector<FeatureMap> group_features(transition_groups.size());
+    std::exception_ptr error;
     Size progress = 0;
-    startProgress(0, transition_group_map.size(), "picking peaks");
-    for (TransitionGroupMapType::iterator trgroup_it = transition_group_map.begin(); trgroup_it != transition_group_map.end(); ++trgroup_it)
+    startProgress(0, transition_groups.size(), "picking peaks");
+    #ifdef _OPENMP
+    int in_parallel = omp_in_parallel();
+    #endif
+    #pragma omp parallel if (in_parallel == 0 && transition_groups.size() > 1)
     {
+      MRMTransitionGroupPicker trgroup_picker;
+      trgroup_picker.setParameters(trgroup_picker_param);
 
-      setProgress(++progress);
-      MRMTransitionGroupType& transition_group = trgroup_it->second;
-      if (transition_group.getChromatograms().empty() || transition_group.getTransitions().empty())
+      #pragma omp for schedule(dynamic, 1)
+      for (SignedSize i = 0; i < (SignedSize) transition_groups.size(); ++i)
       {
-        continue;
-      }
+        try
+        {
+          trgroup_picker.pickTransitionGroup(*transition_groups[i]);
+          scorePeakgroups(*transition_groups[i], trafo, swath_maps, group_features[i]);
+        }
+        catch (...)
+        {
+          #pragma omp critical (MRMFeatureFinderScoring_pickExperiment)
+          if (!error) error = std::current_exception();
+        }
 
-      trgroup_picker.pickTransitionGroup(transition_group);
-      scorePeakgroups(trgroup_it->second, trafo, swath_maps, output);
+        #pragma omp critical (progress)
+        setProgress(++progress);
+      }
     }
     endProgress();
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+
+    for (FeatureMap& features : group_features)
+    {
+      output.insert(output.end(), std::make_move_iterator(features.begin()), std::make_move_iterator(features.end()));
+    }
 
     //output.sortByPosition(); // if the exact same order is needed
     return;
@@ -558,11 +598,20 @@ namespace OpenMS
 
     auto& mrmfeatures = transition_group_detection.getFeaturesMuteable();
 
-    // Go through all peak groups (found MRM features) and score them
+    // theoretical isotope patterns and b/y ion series only depend on the
+    // transition group: compute them once for all its peak groups
+    DIAScoring::TheoreticalPatterns theoretical_patterns;
+    if (!ms1only && su_.use_dia_scores_ && !swath_maps.empty() && !mrmfeatures.empty())
+    {
+      scorer.prepareTheoreticalPatterns(transition_group_detection.getTransitions(), diascoring_, *pep, theoretical_patterns);
+    }
+
+    // Go through all peak groups (found MRM features) and score them, each
+    // thread with its own copy of the scorer (which holds reused buffers)
     #ifdef _OPENMP
     int in_parallel = omp_in_parallel();
     #endif
-    #pragma omp parallel for if (in_parallel == 0)
+    #pragma omp parallel for if (in_parallel == 0) firstprivate(scorer)
     for (SignedSize feature_idx = 0; feature_idx < (SignedSize) mrmfeatures.size(); ++feature_idx)
     {
       auto& mrmfeature = mrmfeatures[feature_idx];
@@ -703,7 +752,7 @@ namespace OpenMS
           scorer.calculateDIAScores(imrmfeature,
                                     transition_group_detection.getTransitions(),
                                     swath_maps, ms1_map_, diascoring_, *pep, scores, masserror_ppm,
-                                    drift_target, im_range);
+                                    drift_target, im_range, &theoretical_patterns);
           mrmfeature.setMetaValue("masserror_ppm", masserror_ppm);
         }
         if (sonar_present && su_.use_sonar_scores)
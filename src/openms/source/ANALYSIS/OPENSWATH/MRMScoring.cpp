@@ -24,31 +24,59 @@ namespace OpenSwath
       return xcorr_matrix_;
     }
 
-    void MRMScoring::initializeXCorrMatrix(const std::vector< std::vector< double > >& data)
+    void MRMScoring::setStoreXCorrArrays(bool store)
     {
-      xcorr_matrix_.getEigenMatrix().resize(data.size(), data.size());
-      xcorr_matrix_max_peak_.getEigenMatrix().resize(data.size(), data.size());
-      xcorr_matrix_max_peak_sec_.getEigenMatrix().resize(data.size(), data.size());
+      store_xcorr_arrays_ = store;
+    }
 
-      std::vector< std::vector< double > > tmp_data = data;
-      for (std::size_t i = 0; i < tmp_data.size(); i++)
+    bool MRMScoring::getStoreXCorrArrays() const
+    {
+      return store_xcorr_arrays_;
+    }
+
+    void MRMScoring::computeXCorrMatrix_(std::vector<std::vector<double>>& data_i, std::vector<std::vector<double>>& data_j, bool upper_triangle,
+                                         XCorrMatrixType& xcorr_matrix, OpenMS::Matrix<int>& max_peak, OpenMS::Matrix<double>& max_peak_sec)
+    {
+      max_peak.getEigenMatrix().resize(data_i.size(), data_j.size());
+      max_peak_sec.getEigenMatrix().resize(data_i.size(), data_j.size());
+      if (store_xcorr_arrays_)
+      {
+        xcorr_matrix.getEigenMatrix().resize(data_i.size(), data_j.size());
+      }
+      else
       {
-        Scoring::standardize_data(tmp_data[i]);
+        xcorr_matrix.getEigenMatrix().resize(0, 0);
       }
 
-      for (std::size_t i = 0; i < data.size(); i++)
+      for (std::size_t i = 0; i < data_i.size(); i++)
       {
-        for (std::size_t j = i; j < data.size(); j++)
+        for (std::size_t j = (upper_triangle ? i : 0); j < data_j.size(); j++)
         {
           // compute normalized cross correlation
-          xcorr_matrix_(i, j) = Scoring::normalizedCrossCorrelationPost(tmp_data[i], tmp_data[j], static_cast<int>(data[i].size()), 1);
-          auto x = Scoring::xcorrArrayGetMaxPeak(xcorr_matrix_(i, j));
-          xcorr_matrix_max_peak_(i, j) = std::abs(x->first);
-          xcorr_matrix_max_peak_sec_(i, j) = x->second;
+          XCorrArrayType& xcorr = store_xcorr_arrays_ ? xcorr_matrix(i, j) : xcorr_buffer_;
+          Scoring::normalizedCrossCorrelationPost(data_i[i], data_j[j], static_cast<int>(data_i[i].size()), 1, xcorr);
+          auto x = Scoring::xcorrArrayGetMaxPeak(xcorr);
+          max_peak(i, j) = std::abs(x->first);
+          max_peak_sec(i, j) = x->second;
         }
       }
     }
 
+    void standardizeAll(std::vector<std::vector<double>>& intensity)
+    {
+      for (std::size_t i = 0; i < intensity.size(); i++)
+      {
+        Scoring::standardize_data(intensity[i]);
+      }
+    }
+
+    void MRMScoring::initializeXCorrMatrix(const std::vector< std::vector< double > >& data)
+    {
+      intensity_buffer_i_ = data;
+      standardizeAll(intensity_buffer_i_);
+      computeXCorrMatrix_(intensity_buffer_i_, intensity_buffer_i_, true, xcorr_matrix_, xcorr_matrix_max_peak_, xcorr_matrix_max_peak_sec_);
+    }
+
     const MRMScoring::XCorrMatrixType& MRMScoring::getXCorrContrastMatrix() const
     {
       return xcorr_contrast_matrix_;
@@ -70,6 +98,8 @@ namespace OpenSwath
       for (std::size_t i = 0; i < intensity.size(); i++)
       {
         MRMScoring::FeatureType fi = mrmfeature->getFeature(ids[i]);
+        // getIntensity() appends, the vectors may hold the traces of a previous peak group
+        intensity[i].clear();
         fi->getIntensity(intensity[i]);
       }
     }
@@ -80,165 +110,68 @@ namespace OpenSwath
       for (std::size_t i = 0; i < intensity.size(); i++)
       {
         MRMScoring::FeatureType fi = mrmfeature->getPrecursorFeature(ids[i]);
+        // getIntensity() appends, the vectors may hold the traces of a previous peak group
+        intensity[i].clear();
         fi->getIntensity(intensity[i]);
       }
     }
 
     void MRMScoring::initializeXCorrMatrix(OpenSwath::IMRMFeature* mrmfeature, const std::vector<std::string>& native_ids)
     {
-      std::vector<std::vector<double>> intensity;
-      fillIntensityFromFeature(mrmfeature, native_ids, intensity);
-      for (std::size_t i = 0; i < intensity.size(); i++)
-      {
-        Scoring::standardize_data(intensity[i]);
-      }
-
-      xcorr_matrix_.getEigenMatrix().resize(native_ids.size(), native_ids.size());
-      xcorr_matrix_max_peak_.getEigenMatrix().resize(native_ids.size(), native_ids.size());
-      xcorr_matrix_max_peak_sec_.getEigenMatrix().resize(native_ids.size(), native_ids.size());
-
-      for (std::size_t i = 0; i < native_ids.size(); i++)
-      {
-        for (std::size_t j = i; j < native_ids.size(); j++)
-        {
-          // compute normalized cross correlation
-          xcorr_matrix_(i, j) = Scoring::normalizedCrossCorrelationPost(intensity[i], intensity[j], static_cast<int>(intensity[i].size()), 1);
-          auto x = Scoring::xcorrArrayGetMaxPeak(xcorr_matrix_(i, j));
-          xcorr_matrix_max_peak_(i, j) = std::abs(x->first);
-          xcorr_matrix_max_peak_sec_(i, j) = x->second;
-        }
-      }
+      fillIntensityFromFeature(mrmfeature, native_ids, intensity_buffer_i_);
+      standardizeAll(intensity_buffer_i_);
+      computeXCorrMatrix_(intensity_buffer_i_, intensity_buffer_i_, true, xcorr_matrix_, xcorr_matrix_max_peak_, xcorr_matrix_max_peak_sec_);
     }
 
     void MRMScoring::initializeXCorrContrastMatrix(OpenSwath::IMRMFeature* mrmfeature, const std::vector<std::string>& native_ids_set1, const std::vector<std::string>& native_ids_set2)
     {
-      std::vector<std::vector<double>> intensityi, intensityj;
-      fillIntensityFromFeature(mrmfeature, native_ids_set1, intensityi);
-      for (std::size_t i = 0; i < intensityi.size(); i++)
-      {
-        Scoring::standardize_data(intensityi[i]);
-      }
-      fillIntensityFromFeature(mrmfeature, native_ids_set2, intensityj);
-      for (std::size_t i = 0; i < intensityj.size(); i++)
-      {
-        Scoring::standardize_data(intensityj[i]);
-      }
-
-      xcorr_contrast_matrix_.getEigenMatrix().resize(native_ids_set1.size(), native_ids_set2.size());
-      xcorr_contrast_matrix_max_peak_sec_.getEigenMatrix().resize(native_ids_set1.size(), native_ids_set2.size());
-            
-      for (std::size_t i = 0; i < native_ids_set1.size(); i++)
-      {
-        for (std::size_t j = 0; j < native_ids_set2.size(); j++)
-        {
-          // compute normalized cross correlation
-          xcorr_contrast_matrix_(i, j) = Scoring::normalizedCrossCorrelationPost(intensityi[i], intensityj[j], static_cast<int>(intensityi[i].size()), 1);
-          auto x = Scoring::xcorrArrayGetMaxPeak(xcorr_contrast_matrix_(i, j));
-          xcorr_contrast_matrix_max_peak_sec_(i, j) = x->second;
-        }
-      }
+      fillIntensityFromFeature(mrmfeature, native_ids_set1, intensity_buffer_i_);
+      standardizeAll(intensity_buffer_i_);
+      fillIntensityFromFeature(mrmfeature, native_ids_set2, intensity_buffer_j_);
+      standardizeAll(intensity_buffer_j_);
+      computeXCorrMatrix_(intensity_buffer_i_, intensity_buffer_j_, false, xcorr_contrast_matrix_, xcorr_contrast_matrix_max_peak_, xcorr_contrast_matrix_max_peak_sec_);
     }
 
     void MRMScoring::initializeXCorrPrecursorMatrix(OpenSwath::IMRMFeature* mrmfeature, const std::vector<std::string>& precursor_ids)
     {
-      std::vector<std::vector<double>> intensity;
-      fillIntensityFromPrecursorFeature(mrmfeature, precursor_ids, intensity);
-      for (std::size_t i = 0; i < intensity.size(); i++)
-      {
-        Scoring::standardize_data(intensity[i]);
-      }
-
-      xcorr_precursor_matrix_.getEigenMatrix().resize(precursor_ids.size(), precursor_ids.size());
-      for (std::size_t i = 0; i < precursor_ids.size(); i++)
-      {
-        for (std::size_t j = i; j < precursor_ids.size(); j++)
-        {
-          // compute normalized cross correlation
-          xcorr_precursor_matrix_(i, j) = Scoring::normalizedCrossCorrelationPost(intensity[i], intensity[j], static_cast<int>(intensity[i].size()), 1);
-        }
-      }
+      fillIntensityFromPrecursorFeature(mrmfeature, precursor_ids, intensity_buffer_i_);
+      standardizeAll(intensity_buffer_i_);
+      computeXCorrMatrix_(intensity_buffer_i_, intensity_buffer_i_, true, xcorr_precursor_matrix_, xcorr_precursor_matrix_max_peak_, xcorr_precursor_matrix_max_peak_sec_);
     }
 
     void MRMScoring::initializeXCorrPrecursorContrastMatrix(OpenSwath::IMRMFeature* mrmfeature, const std::vector<std::string>& precursor_ids, const std::vector<std::string>& native_ids)
     {
-      std::vector<std::vector<double>> intensityi, intensityj;
-      fillIntensityFromPrecursorFeature(mrmfeature, precursor_ids, intensityi);
-      for (std::size_t i = 0; i < intensityi.size(); i++)
-      {
-        Scoring::standardize_data(intensityi[i]);
-      }
-      fillIntensityFromFeature(mrmfeature, native_ids, intensityj);
-      for (std::size_t i = 0; i < intensityj.size(); i++)
-      {
-        Scoring::standardize_data(intensityj[i]);
-      }
-
-      xcorr_precursor_contrast_matrix_.getEigenMatrix().resize(precursor_ids.size(), native_ids.size());
-      for (std::size_t i = 0; i < precursor_ids.size(); i++)
-      {
-        for (std::size_t j = 0; j < native_ids.size(); j++)
-        {
-          // compute normalized cross correlation
-          xcorr_precursor_contrast_matrix_(i, j) = Scoring::normalizedCrossCorrelationPost(intensityi[i], intensityj[j], static_cast<int>(intensityi[i].size()), 1);
-        }
-      }
+      fillIntensityFromPrecursorFeature(mrmfeature, precursor_ids, intensity_buffer_i_);
+      standardizeAll(intensity_buffer_i_);
+      fillIntensityFromFeature(mrmfeature, native_ids, intensity_buffer_j_);
+      standardizeAll(intensity_buffer_j_);
+      computeXCorrMatrix_(intensity_buffer_i_, intensity_buffer_j_, false, xcorr_precursor_contrast_matrix_,
+                          xcorr_precursor_contrast_matrix_max_peak_, xcorr_precursor_contrast_matrix_max_peak_sec_);
     }
 
     void MRMScoring::initializeXCorrPrecursorContrastMatrix(const std::vector< std::vector< double > >& data_precursor, const std::vector< std::vector< double > >& data_fragments)
     {
-      xcorr_precursor_contrast_matrix_.getEigenMatrix().resize(data_precursor.size(), data_fragments.size());
-      std::vector< std::vector< double > > tmp_data_precursor = data_precursor;
-      std::vector< std::vector< double > > tmp_data_fragments = data_fragments;
-      for (std::size_t i = 0; i < tmp_data_precursor.size(); i++)
-      {
-        Scoring::standardize_data(tmp_data_precursor[i]);
-      }
-      for (std::size_t i = 0; i < tmp_data_fragments.size(); i++)
-      {
-        Scoring::standardize_data(tmp_data_fragments[i]);
-      }
-
-      for (std::size_t i = 0; i < data_precursor.size(); i++)
-      {
-        for (std::size_t j = 0; j < data_fragments.size(); j++)
-        {
-          // compute normalized cross correlation
-          xcorr_precursor_contrast_matrix_(i, j) = Scoring::normalizedCrossCorrelationPost(tmp_data_precursor[i], tmp_data_fragments[j], static_cast<int>(tmp_data_precursor[i].size()), 1);
-#ifdef MRMSCORING_TESTING
-          std::cout << " fill xcorr_precursor_contrast_matrix_ "<< tmp_data_precursor[i].size() << " / " << tmp_data_fragments[j].size() << " : " << xcorr_precursor_contrast_matrix_[i][j].data.size() << std::endl;
-#endif
-        }
-      }
+      intensity_buffer_i_ = data_precursor;
+      standardizeAll(intensity_buffer_i_);
+      intensity_buffer_j_ = data_fragments;
+      standardizeAll(intensity_buffer_j_);
+      computeXCorrMatrix_(intensity_buffer_i_, intensity_buffer_j_, false, xcorr_precursor_contrast_matrix_,
+                          xcorr_precursor_contrast_matrix_max_peak_, xcorr_precursor_contrast_matrix_max_peak_sec_);
     }
 
     void MRMScoring::initializeXCorrPrecursorCombinedMatrix(OpenSwath::IMRMFeature* mrmfeature, const std::vector<std::string>& precursor_ids, const std::vector<std::string>& native_ids)
     {
-      std::vector<std::vector<double>> intensityi, intensityj;
-      fillIntensityFromPrecursorFeature(mrmfeature, precursor_ids, intensityi);
-      fillIntensityFromFeature(mrmfeature, native_ids, intensityj);
-      std::vector<std::vector<double>> combined_intensity;
-      for (std::size_t i = 0; i < intensityi.size(); i++)
-      {
-        combined_intensity.push_back(intensityi[i]);
-      }
-      for (std::size_t j = 0; j < intensityj.size(); j++)
+      // the precursor traces followed by the fragment traces
+      fillIntensityFromFeature(mrmfeature, native_ids, intensity_buffer_j_);
+      fillIntensityFromPrecursorFeature(mrmfeature, precursor_ids, intensity_buffer_i_);
+      intensity_buffer_i_.resize(precursor_ids.size() + native_ids.size());
+      for (std::size_t j = 0; j < native_ids.size(); j++)
       {
-        combined_intensity.push_back(intensityj[j]);
-      }
-      for (std::size_t i = 0; i < combined_intensity.size(); i++)
-      {
-        Scoring::standardize_data(combined_intensity[i]);
-      }
-
-      xcorr_precursor_combined_matrix_.getEigenMatrix().resize(combined_intensity.size(), combined_intensity.size());
-      for (std::size_t i = 0; i < combined_intensity.size(); i++)
-      {
-        for (std::size_t j = i; j < combined_intensity.size(); j++)
-        {
-          // compute normalized cross correlation
-          xcorr_precursor_combined_matrix_(i, j) = Scoring::normalizedCrossCorrelationPost(combined_intensity[i], combined_intensity[j], static_cast<int>(combined_intensity[i].size()), 1);
-        }
+        intensity_buffer_i_[precursor_ids.size() + j].swap(intensity_buffer_j_[j]);
       }
+      standardizeAll(intensity_buffer_i_);
+      computeXCorrMatrix_(intensity_buffer_i_, intensity_buffer_i_, true, xcorr_precursor_combined_matrix_,
+                          xcorr_precursor_combined_matrix_max_peak_, xcorr_precursor_combined_matrix_max_peak_sec_);
     }
 
     // see /IMSB/users/reiterl/bin/code/biognosys/trunk/libs/mrm_libs/MRM_pgroup.pm
@@ -315,22 +248,21 @@ namespace OpenSwath
 
     std::vector<double> MRMScoring::calcSeparateXcorrContrastCoelutionScore()
     {
-      OPENSWATH_PRECONDITION(xcorr_contrast_matrix_.rows() > 0 && xcorr_contrast_matrix_.cols() > 1, "Expect cross-correlation matrix of at least 1x2");
+      OPENSWATH_PRECONDITION(xcorr_contrast_matrix_max_peak_.rows() > 0 && xcorr_contrast_matrix_max_peak_.cols() > 1, "Expect cross-correlation matrix of at least 1x2");
 
       std::vector<double > deltas;
-      for (long int i = 0; i < xcorr_contrast_matrix_.rows(); i++)
+      for (long int i = 0; i < xcorr_contrast_matrix_max_peak_.rows(); i++)
       {
         double deltas_id = 0;
-        for (long int  j = 0; j < xcorr_contrast_matrix_.cols(); j++)
+        for (long int  j = 0; j < xcorr_contrast_matrix_max_peak_.cols(); j++)
         {
           // first is the X value (RT), should be an int
-          auto x = Scoring::xcorrArrayGetMaxPeak(xcorr_contrast_matrix_(i, j));
-          deltas_id += std::abs(x->first);
+          deltas_id += xcorr_contrast_matrix_max_peak_(i, j);
 #ifdef MRMSCORING_TESTING
-          std::cout << "&&_xcoel append " << xcorr_contrast_matrix_max_peak_getValue(i, j) << std::endl;
+          std::cout << "&&_xcoel append " << xcorr_contrast_matrix_max_peak_(i, j) << std::endl;
 #endif
         }
-        deltas.push_back(deltas_id / xcorr_contrast_matrix_.cols());
+        deltas.push_back(deltas_id / xcorr_contrast_matrix_max_peak_.cols());
       }
 
       return deltas;
@@ -338,18 +270,17 @@ namespace OpenSwath
 
     double MRMScoring::calcXcorrPrecursorCoelutionScore()
     {
-      OPENSWATH_PRECONDITION(xcorr_precursor_matrix_.rows() > 1, "Expect cross-correlation matrix of at least 2x2");
+      OPENSWATH_PRECONDITION(xcorr_precursor_matrix_max_peak_.rows() > 1, "Expect cross-correlation matrix of at least 2x2");
 
       OpenSwath::mean_and_stddev msc;
-      for (long int i = 0; i < xcorr_precursor_matrix_.rows(); i++)
+      for (long int i = 0; i < xcorr_precursor_matrix_max_peak_.rows(); i++)
       {
-        for (long int  j = i; j < xcorr_precursor_matrix_.rows(); j++)
+        for (long int  j = i; j < xcorr_precursor_matrix_max_peak_.rows(); j++)
         {
           // first is the X value (RT), should be an int
-          auto x = Scoring::xcorrArrayGetMaxPeak(xcorr_precursor_matrix_(i, j));
-          msc(std::abs(x->first));
+          msc(xcorr_precursor_matrix_max_peak_(i, j));
 #ifdef MRMSCORING_TESTING
-          std::cout << "&&_xcoel append " << std::abs(Scoring::xcorrArrayGetMaxPeak(xcorr_precursor_matrix_[i][j])->first) << std::endl;
+          std::cout << "&&_xcoel append " << xcorr_precursor_matrix_max_peak_(i, j) << std::endl;
 #endif
         }
       }
@@ -363,19 +294,18 @@ namespace OpenSwath
 
     double MRMScoring::calcXcorrPrecursorContrastCoelutionScore()
     {
-      OPENSWATH_PRECONDITION(xcorr_precursor_contrast_matrix_.rows() > 0 && xcorr_precursor_contrast_matrix_.cols() > 1, "Expect cross-correlation matrix of at least 1x2");
+      OPENSWATH_PRECONDITION(xcorr_precursor_contrast_matrix_max_peak_.rows() > 0 && xcorr_precursor_contrast_matrix_max_peak_.cols() > 1, "Expect cross-correlation matrix of at least 1x2");
 
       OpenSwath::mean_and_stddev msc;
-      size_t n_entries = xcorr_precursor_contrast_matrix_.getEigenMatrix().size();
-      const auto& em = xcorr_precursor_contrast_matrix_.getEigenMatrix();
+      size_t n_entries = xcorr_precursor_contrast_matrix_max_peak_.getEigenMatrix().size();
+      const auto& em = xcorr_precursor_contrast_matrix_max_peak_.getEigenMatrix();
 
       for (size_t i = 0; i < n_entries; i++)
       {
         // first is the X value (RT), should be an int
-        auto e = *(em.data() + i);
-        msc(std::abs(Scoring::xcorrArrayGetMaxPeak(e)->first));
+        msc(*(em.data() + i));
 #ifdef MRMSCORING_TESTING
-        std::cout << "&&_xcoel append " << std::abs(Scoring::xcorrArrayGetMaxPeak(xcorr_precursor_contrast_matrix_[i][j])->first) << std::endl;
+        std::cout << "&&_xcoel append " << *(em.data() + i) << std::endl;
 #endif
       }
 
@@ -388,19 +318,18 @@ namespace OpenSwath
 
     double MRMScoring::calcXcorrPrecursorContrastSumFragCoelutionScore()
     {
-      OPENSWATH_PRECONDITION(xcorr_precursor_contrast_matrix_.rows() > 0 && xcorr_precursor_contrast_matrix_.cols() > 0, "Expect cross-correlation matrix of at least 1x1");
+      OPENSWATH_PRECONDITION(xcorr_precursor_contrast_matrix_max_peak_.rows() > 0 && xcorr_precursor_contrast_matrix_max_peak_.cols() > 0, "Expect cross-correlation matrix of at least 1x1");
 
       OpenSwath::mean_and_stddev msc;
-      size_t n_entries = xcorr_precursor_contrast_matrix_.getEigenMatrix().size();
-      auto& em = xcorr_precursor_contrast_matrix_.getEigenMatrix();
+      size_t n_entries = xcorr_precursor_contrast_matrix_max_peak_.getEigenMatrix().size();
+      const auto& em = xcorr_precursor_contrast_matrix_max_peak_.getEigenMatrix();
       for (size_t i = 0; i < n_entries; i++)
       {
         // first is the X value (RT), should be an int
-        auto e = *(em.data() + i);
-        msc(std::abs(Scoring::xcorrArrayGetMaxPeak(e)->first));
+        msc(*(em.data() + i));
 
 #ifdef MRMSCORING_TESTING
-        std::cout << "&&_xcoel append " << std::abs(Scoring::xcorrArrayGetMaxPeak(xcorr_precursor_contrast_matrix_[i][j])->first) << std::endl;
+        std::cout << "&&_xcoel append " << *(em.data() + i) << std::endl;
 #endif
       }
 
@@ -413,18 +342,17 @@ namespace OpenSwath
 
     double MRMScoring::calcXcorrPrecursorCombinedCoelutionScore()
     {
-      OPENSWATH_PRECONDITION(xcorr_precursor_combined_matrix_.rows() > 1, "Expect cross-correlation matrix of at least 2x2");
+      OPENSWATH_PRECONDITION(xcorr_precursor_combined_matrix_max_peak_.rows() > 1, "Expect cross-correlation matrix of at least 2x2");
 
       OpenSwath::mean_and_stddev msc;
-      for (long int i = 0; i < xcorr_precursor_combined_matrix_.rows(); i++)
+      for (long int i = 0; i < xcorr_precursor_combined_matrix_max_peak_.rows(); i++)
       {
-        for (long int  j = i; j < xcorr_precursor_combined_matrix_.rows(); j++)
+        for (long int  j = i; j < xcorr_precursor_combined_matrix_max_peak_.rows(); j++)
         {
           // first is the X value (RT), should be an int
-          auto x = Scoring::xcorrArrayGetMaxPeak(xcorr_precursor_combined_matrix_(i, j));
-          msc(std::abs(x->first));
+          msc(xcorr_precursor_combined_matrix_max_peak_(i, j));
 #ifdef MRMSCORING_TESTING
-          std::cout << "&&_xcoel append " << std::abs(Scoring::xcorrArrayGetMaxPeak(xcorr_precursor_combined_matrix_[i][j])->first) << std::endl;
+          std::cout << "&&_xcoel append " << xcorr_precursor_combined_matrix_max_peak_(i, j) << std::endl;
 #endif
         }
       }
@@ -520,33 +448,31 @@ namespace OpenSwath
 
     double MRMScoring::calcXcorrPrecursorShapeScore()
     {
-      OPENSWATH_PRECONDITION(xcorr_precursor_matrix_.rows() > 1, "Expect cross-correlation matrix of at least 2x2");
+      OPENSWATH_PRECONDITION(xcorr_precursor_matrix_max_peak_sec_.rows() > 1, "Expect cross-correlation matrix of at least 2x2");
 
       double intensities{0};
-      for(long int i = 0; i < xcorr_precursor_matrix_.rows(); i++)
+      for(long int i = 0; i < xcorr_precursor_matrix_max_peak_sec_.rows(); i++)
       {
-        for(long int j = i; j < xcorr_precursor_matrix_.cols(); j++)
+        for(long int j = i; j < xcorr_precursor_matrix_max_peak_sec_.cols(); j++)
         {
-          auto x = Scoring::xcorrArrayGetMaxPeak(xcorr_precursor_matrix_(i, j));
-          intensities += x->second;
+          intensities += xcorr_precursor_matrix_max_peak_sec_(i, j);
         }
       }
       //xcorr_precursor_matrix_ is a triangle matrix
-      size_t element_number = xcorr_precursor_matrix_.rows()*xcorr_precursor_matrix_.rows()/2 + (xcorr_precursor_matrix_.rows()+1)/2;
+      size_t element_number = xcorr_precursor_matrix_max_peak_sec_.rows()*xcorr_precursor_matrix_max_peak_sec_.rows()/2 + (xcorr_precursor_matrix_max_peak_sec_.rows()+1)/2;
       return intensities / element_number;
     }
 
     double MRMScoring::calcXcorrPrecursorContrastSumFragShapeScore()
     {
-      OPENSWATH_PRECONDITION(xcorr_precursor_contrast_matrix_.rows() > 0 && xcorr_precursor_contrast_matrix_.cols() > 0, "Expect cross-correlation matrix of at least 1x1");
+      OPENSWATH_PRECONDITION(xcorr_precursor_contrast_matrix_max_peak_sec_.rows() > 0 && xcorr_precursor_contrast_matrix_max_peak_sec_.cols() > 0, "Expect cross-correlation matrix of at least 1x1");
 
-      double intensities{0};
-      const auto& em = xcorr_precursor_contrast_matrix_.getEigenMatrix();
+      const auto& em = xcorr_precursor_contrast_matrix_max_peak_sec_.getEigenMatrix();
       size_t n_elements = em.size();
+      double intensities{0};
       for (size_t i = 0; i != n_elements; ++i)
       {
-        const auto& e = *(em.data() + i); 
-        intensities += Scoring::xcorrArrayGetMaxPeak(e)->second;;
+        intensities += *(em.data() + i);
       }
 
       return intensities / (double)n_elements;
@@ -554,35 +480,32 @@ namespace OpenSwath
 
     double MRMScoring::calcXcorrPrecursorContrastShapeScore()
     {
-      OPENSWATH_PRECONDITION(xcorr_precursor_contrast_matrix_.rows() > 0 && xcorr_precursor_contrast_matrix_.cols() > 1, "Expect cross-correlation matrix of at least 1x2");
+      OPENSWATH_PRECONDITION(xcorr_precursor_contrast_matrix_max_peak_sec_.rows() > 0 && xcorr_precursor_contrast_matrix_max_peak_sec_.cols() > 1, "Expect cross-correlation matrix of at least 1x2");
 
-      double intensities{0};
-
-      const auto& em = xcorr_precursor_contrast_matrix_.getEigenMatrix();
+      const auto& em = xcorr_precursor_contrast_matrix_max_peak_sec_.getEigenMatrix();
       size_t n_elements = em.size();
+      double intensities{0};
       for (size_t i = 0; i != n_elements; ++i)
       {
-        const auto& e = *(em.data() + i); 
-        intensities += Scoring::xcorrArrayGetMaxPeak(e)->second;
+        intensities += *(em.data() + i);
       }
       return intensities / (double)n_elements;      
     }
 
     double MRMScoring::calcXcorrPrecursorCombinedShapeScore()
     {
-      OPENSWATH_PRECONDITION(xcorr_precursor_combined_matrix_.rows() > 1, "Expect cross-correlation matrix of at least 2x2");
+      OPENSWATH_PRECONDITION(xcorr_precursor_combined_matrix_max_peak_sec_.rows() > 1, "Expect cross-correlation matrix of at least 2x2");
 
       double intensities{0};
-      for(long int i = 0; i < xcorr_precursor_combined_matrix_.rows(); i++)
+      for(long int i = 0; i < xcorr_precursor_combined_matrix_max_peak_sec_.rows(); i++)
       {
-        for(long int j = i; j < xcorr_precursor_combined_matrix_.cols(); j++)
+        for(long int j = i; j < xcorr_precursor_combined_matrix_max_peak_sec_.cols(); j++)
         {
-          auto x = Scoring::xcorrArrayGetMaxPeak(xcorr_precursor_combined_matrix_(i, j));
-          intensities += x->second;
+          intensities += xcorr_precursor_combined_matrix_max_peak_sec_(i, j);
         }
       }
       //xcorr_precursor-combined_matrix_ is a triangle matrix
-      size_t element_number = xcorr_precursor_combined_matrix_.rows()*xcorr_precursor_combined_matrix_.rows()/2 + (xcorr_precursor_combined_matrix_.rows()+1)/2;
+      size_t element_number = xcorr_precursor_combined_matrix_max_peak_sec_.rows()*xcorr_precursor_combined_matrix_max_peak_sec_.rows()/2 + (xcorr_precursor_combined_matrix_max_peak_sec_.rows()+1)/2;
       return intensities / element_number;
     }
 
@@ -9,6 +9,7 @@
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathOSWWriter.h>
 
 #include <OpenMS/FORMAT/SqliteConnector.h>
+#include <OpenMS/SYSTEM/File.h>
 
 #include <sqlite3.h>
 
@@ -19,7 +20,8 @@ namespace OpenMS
     input_filename_(input_filename),
     run_id_(Internal::SqliteHelper::clearSignBit(run_id)),
     doWrite_(!output_filename.empty()),
-    enable_uis_scoring_(uis_scores)
+    enable_uis_scoring_(uis_scores),
+    queue_([this](const std::vector<String>& lines) { writeLines(lines); })
   {}
 
   bool OpenSwathOSWWriter::isActive() const
@@ -27,7 +29,7 @@ namespace OpenMS
     return doWrite_;
   }
 
-  void OpenSwathOSWWriter::writeHeader()
+  void OpenSwathOSWWriter::writeHeader(bool checkpoints)
   {
     // Open database
     SqliteConnector conn(output_filename_);
@@ -170,6 +172,39 @@ namespace OpenMS
 
     // Execute SQL insert statement
     conn.executeStatement(sql_run.str());
+
+    if (checkpoints)
+    {
+      conn.executeStatement("CREATE TABLE CHECKPOINT(UNIT TEXT PRIMARY KEY NOT NULL);");
+    }
+  }
+
+  std::set<String> OpenSwathOSWWriter::readCheckpoints() const
+  {
+    std::set<String> units;
+    if (!File::exists(output_filename_))
+    {
+      return units;
+    }
+    SqliteConnector conn(output_filename_, SqliteConnector::SqlOpenMode::READONLY);
+    if (!conn.tableExists("CHECKPOINT"))
+    {
+      return units;
+    }
+    sqlite3_stmt* stmt;
+    conn.prepareStatement(&stmt, "SELECT UNIT FROM CHECKPOINT;");
+    Internal::SqliteHelper::SqlState state = Internal::SqliteHelper::SqlState::SQL_ROW;
+    while ((state = Internal::SqliteHelper::nextRow(stmt, state)) == Internal::SqliteHelper::SqlState::SQL_ROW)
+    {
+      units.insert(Internal::SqliteHelper::extractString(stmt, 0));
+    }
+    sqlite3_finalize(stmt);
+    return units;
+  }
+
+  String OpenSwathOSWWriter::prepareCheckpoint(const String& unit) const
+  {
+    return "INSERT INTO CHECKPOINT (UNIT) VALUES ('" + String(unit).substitute("'", "''") + "'); ";
   }
 
   String OpenSwathOSWWriter::getScore(const Feature& feature, const std::string& score_name) const
@@ -618,5 +653,14 @@ namespace OpenMS
     }
     conn.executeStatement("END TRANSACTION");
   }
-}
 
+  void OpenSwathOSWWriter::enqueueLines(std::vector<String>& to_osw_output)
+  {
+    queue_.push(to_osw_output);
+  }
+
+  void OpenSwathOSWWriter::flush()
+  {
+    queue_.flush();
+  }
+}
@@ -0,0 +1,74 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathOutputQueue.h>
+
+#include <iterator>
+#include <utility>
+
+namespace OpenMS
+{
+
+  OpenSwathOutputQueue::OpenSwathOutputQueue(Sink sink) :
+    sink_(std::move(sink))
+  {}
+
+  void OpenSwathOutputQueue::push(std::vector<String>& lines)
+  {
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      if (pending_.empty())
+      {
+        pending_.swap(lines);
+      }
+      else
+      {
+        pending_.insert(pending_.end(), std::make_move_iterator(lines.begin()), std::make_move_iterator(lines.end()));
+      }
+    }
+    lines.clear();
+
+    // another thread is writing: it will write our lines as well
+    std::unique_lock<std::mutex> writer(write_mutex_, std::try_to_lock);
+    if (writer.owns_lock())
+    {
+      drain_(writer);
+    }
+  }
+
+  void OpenSwathOutputQueue::flush()
+  {
+    std::unique_lock<std::mutex> writer(write_mutex_);
+    drain_(writer);
+  }
+
+  Size OpenSwathOutputQueue::pending() const
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    return pending_.size();
+  }
+
+  void OpenSwathOutputQueue::drain_(std::unique_lock<std::mutex>& /* writer */)
+  {
+    std::vector<String> batch;
+    while (true)
+    {
+      batch.clear();
+      {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        batch.swap(pending_);
+      }
+      if (batch.empty())
+      {
+        return;
+      }
+      sink_(batch);
+    }
+  }
+
+}
@@ -20,6 +20,7 @@
 
 // auxiliary
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/DataAccessHelper.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessLRUCache.h>
 #include <OpenMS/MATH/StatisticFunctions.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/SpectrumAddition.h>
 
@@ -35,6 +36,8 @@ namespace OpenMS
     spectra_addition_method_(SpectrumAdditionMethod::ADDITION),
     im_drift_extra_pcnt_(0.0)
   {
+    // the scores only need the maximum of each cross-correlation
+    mrmscore_.setStoreXCorrArrays(false);
   }
 
   /// Destructor
@@ -78,7 +81,8 @@ namespace OpenMS
                                             OpenSwath_Scores& scores,
                                             std::vector<double>& masserror_ppm,
                                             const double drift_target,// TODO is this needed
-                                            const RangeMobility& im_range)
+                                            const RangeMobility& im_range,
+                                            const DIAScoring::TheoreticalPatterns* patterns)
   {
     OPENMS_PRECONDITION(imrmfeature != nullptr, "Feature to be scored cannot be null");
     OPENMS_PRECONDITION(transitions.size() > 0, "There needs to be at least one transition.");
@@ -139,8 +143,14 @@ namespace OpenMS
       // Currently this is computed for an averagine model of a peptide so its
       // not optimal for metabolites - but better than nothing, given that for
       // most fragments we don't really know their composition
-      diascoring
-          .dia_isotope_scores(transitions, spectra, imrmfeature, im_range, scores.isotope_correlation, scores.isotope_overlap);
+      if (patterns != nullptr)
+      {
+        diascoring.dia_isotope_scores(transitions, spectra, imrmfeature, im_range, *patterns, scores.isotope_correlation, scores.isotope_overlap);
+      }
+      else
+      {
+        diascoring.dia_isotope_scores(transitions, spectra, imrmfeature, im_range, scores.isotope_correlation, scores.isotope_overlap);
+      }
     }
 
     // Peptide-specific scores (only useful, when product transitions are REAL fragments, e.g. not in FFID)
@@ -148,10 +158,17 @@ namespace OpenMS
     if (compound.isPeptide() && !compound.sequence.empty() && su_.use_ionseries_scores)
     {
       // Presence of b/y series score
-      OpenMS::AASequence aas;
-      int by_charge_state = 1; // for which charge states should we check b/y series
-      OpenSwathDataAccessHelper::convertPeptideToAASequence(compound, aas);
-      diascoring.dia_by_ion_score(spectra, aas, by_charge_state, im_range, scores.bseries_score, scores.yseries_score);
+      if (patterns != nullptr)
+      {
+        diascoring.dia_by_ion_score(spectra, *patterns, im_range, scores.bseries_score, scores.yseries_score);
+      }
+      else
+      {
+        OpenMS::AASequence aas;
+        int by_charge_state = 1; // for which charge states should we check b/y series
+        OpenSwathDataAccessHelper::convertPeptideToAASequence(compound, aas);
+        diascoring.dia_by_ion_score(spectra, aas, by_charge_state, im_range, scores.bseries_score, scores.yseries_score);
+      }
     }
 
 
@@ -314,6 +331,21 @@ namespace OpenMS
     diascoring.dia_ms1_massdiff_score(transition.getProductMZ(), spectrum, im_range, scores.massdev_score);
   }
 
+  void OpenSwathScoring::prepareTheoreticalPatterns(const std::vector<TransitionType>& transitions,
+                                                    const OpenMS::DIAScoring& diascoring,
+                                                    const CompoundType& compound,
+                                                    DIAScoring::TheoreticalPatterns& patterns) const
+  {
+    // same conditions as for the b/y ion scores in calculateDIAScores()
+    OpenMS::AASequence aas;
+    if (compound.isPeptide() && !compound.sequence.empty() && su_.use_ionseries_scores)
+    {
+      OpenSwathDataAccessHelper::convertPeptideToAASequence(compound, aas);
+    }
+    int by_charge_state = 1; // for which charge states should we check b/y series
+    diascoring.prepareTheoreticalPatterns(transitions, aas, by_charge_state, patterns);
+  }
+
   void OpenSwathScoring::calculateChromatographicScores(
         OpenSwath::IMRMFeature* imrmfeature,
         const std::vector<std::string>& native_ids,
@@ -323,7 +355,6 @@ namespace OpenMS
         OpenSwath_Scores & scores) const
   {
     OPENMS_PRECONDITION(imrmfeature != nullptr, "Feature to be scored cannot be null");
-    OpenSwath::MRMScoring mrmscore_;
     if (su_.use_coelution_score_ || su_.use_shape_score_ || (!imrmfeature->getPrecursorIDs().empty() && su_.use_ms1_correlation))
       mrmscore_.initializeXCorrMatrix(imrmfeature, native_ids);
 
@@ -416,7 +447,6 @@ namespace OpenMS
         OpenSwath_Ind_Scores & idscores) const
   {
     OPENMS_PRECONDITION(imrmfeature != nullptr, "Feature to be scored cannot be null");
-    OpenSwath::MRMScoring mrmscore_;
     mrmscore_.initializeXCorrContrastMatrix(imrmfeature, native_ids_identification, native_ids_detection);
 
     if (su_.use_coelution_score_)
@@ -499,6 +529,14 @@ namespace OpenMS
 
   SpectrumSequence OpenSwathScoring::fetchSpectrumSwath(OpenSwath::SpectrumAccessPtr swathmap, double RT, int nr_spectra_to_add, const RangeMobility& im_range)
   {
+    // overlapping peak groups often add up the same spectra: reuse them if the map caches them
+    if (spectra_addition_method_ == SpectrumAdditionMethod::RESAMPLE)
+    {
+      if (auto* cache = dynamic_cast<SpectrumAccessLRUCache*>(swathmap.get()))
+      {
+        return { cache->getSummedSpectrum(RT, nr_spectra_to_add, im_range, spacing_for_spectra_resampling_) };
+      }
+    }
 
     SpectrumSequence all_spectra = swathmap->getMultipleSpectra(RT, nr_spectra_to_add);
     if (spectra_addition_method_ == SpectrumAdditionMethod::ADDITION)
@@ -507,10 +545,14 @@ namespace OpenMS
     }
     else // (spectra_addition_method_ == SpectrumAdditionMethod::RESAMPLE)
     {
-      std::vector<OpenSwath::SpectrumPtr> spectrum_out;
-      //added_spec = SpectrumAddition::addUpSpectra(all_spectra, spacing_for_spectra_resampling_, true);
-      spectrum_out.push_back(SpectrumAddition::addUpSpectra(all_spectra, im_range, spacing_for_spectra_resampling_, true));
-      return spectrum_out;
+      if (all_spectra.size() <= 1)
+      {
+        // nothing to add up (only filtered by ion mobility)
+        return { SpectrumAddition::addUpSpectra(all_spectra, im_range, spacing_for_spectra_resampling_, true) };
+      }
+      OpenSwath::SpectrumPtr added_spec(new OpenSwath::Spectrum);
+      SpectrumAddition::addUpSpectra(all_spectra, im_range, spacing_for_spectra_resampling_, true, addition_workspace_, *added_spec);
+      return { added_spec };
     }
   }
 
@@ -544,10 +586,13 @@ namespace OpenMS
           for (size_t i = 0; i < swath_maps.size(); ++i)
           {
             SpectrumSequence spectrumSequence = swath_maps[i].sptr->getMultipleSpectra(RT, nr_spectra_to_add, im_range.getMin(), im_range.getMax());
-            all_spectra.push_back(SpectrumAddition::addUpSpectra(spectrumSequence, spacing_for_spectra_resampling_, true));
+            all_spectra.push_back(OpenSwath::SpectrumPtr(new OpenSwath::Spectrum));
+            SpectrumAddition::addUpSpectra(spectrumSequence, spacing_for_spectra_resampling_, true, addition_workspace_, *all_spectra.back());
           }
         }
-        return { SpectrumAddition::addUpSpectra(all_spectra, spacing_for_spectra_resampling_, true) };
+        OpenSwath::SpectrumPtr added_spec(new OpenSwath::Spectrum);
+        SpectrumAddition::addUpSpectra(all_spectra, spacing_for_spectra_resampling_, true, addition_workspace_, *added_spec);
+        return { added_spec };
       }
       else // im_range.isEmpty()
       {
@@ -559,7 +604,8 @@ namespace OpenMS
           for (size_t i = 0; i < swath_maps.size(); ++i)
           {
             SpectrumSequence spectrumSequence = swath_maps[i].sptr->getMultipleSpectra(RT, nr_spectra_to_add);
-            all_spectra.push_back(SpectrumAddition::concatenateSpectra(spectrumSequence));
+            all_spectra.push_back(OpenSwath::SpectrumPtr(new OpenSwath::Spectrum));
+            SpectrumAddition::concatenateSpectra(spectrumSequence, addition_workspace_, *all_spectra.back());
           }
         }
         else // (spectra_addition_method_ == SpectrumAdditionMethod::RESAMPLE)
@@ -567,10 +613,13 @@ namespace OpenMS
           for (size_t i = 0; i < swath_maps.size(); ++i)
           {
             SpectrumSequence spectrumSequence = swath_maps[i].sptr->getMultipleSpectra(RT, nr_spectra_to_add);
-            all_spectra.push_back(SpectrumAddition::addUpSpectra(spectrumSequence, spacing_for_spectra_resampling_, true));
+            all_spectra.push_back(OpenSwath::SpectrumPtr(new OpenSwath::Spectrum));
+            SpectrumAddition::addUpSpectra(spectrumSequence, spacing_for_spectra_resampling_, true, addition_workspace_, *all_spectra.back());
           }
         }
-        return { SpectrumAddition::addUpSpectra(all_spectra, spacing_for_spectra_resampling_, true) };
+        OpenSwath::SpectrumPtr added_spec(new OpenSwath::Spectrum);
+        SpectrumAddition::addUpSpectra(all_spectra, spacing_for_spectra_resampling_, true, addition_workspace_, *added_spec);
+        return { added_spec };
       }
     }
   }
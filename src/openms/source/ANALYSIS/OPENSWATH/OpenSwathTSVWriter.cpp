@@ -20,7 +20,8 @@ namespace OpenMS
     input_filename_(input_filename),
     doWrite_(!output_filename.empty()),
     use_ms1_traces_(ms1_scores),
-    sonar_(sonar)
+    sonar_(sonar),
+    queue_([this](const std::vector<String>& lines) { writeLines(lines); })
     {
     }
 
@@ -264,5 +265,16 @@ namespace OpenMS
       for (const auto& s : to_output) ofs << s;
     }
 
+    void OpenSwathTSVWriter::enqueueLines(std::vector<String>& to_output)
+    {
+      queue_.push(to_output);
+    }
+
+    void OpenSwathTSVWriter::flush()
+    {
+      queue_.flush();
+      ofs.flush();
+    }
+
 }
 
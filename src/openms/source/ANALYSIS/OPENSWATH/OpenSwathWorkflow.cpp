@@ -8,9 +8,38 @@
 
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathWorkflow.h>
 
+#include <OpenMS/CONCEPT/PerfCounters.h>
+#include <OpenMS/CONCEPT/UniqueIdGenerator.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
+
 // OpenSwathCalibrationWorkflow
 namespace OpenMS
 {
+  namespace
+  {
+    /// Output of a batch of compounds, buffered in the deterministic mode (see TaskScheduler::setDeterministic())
+    struct BatchOutput
+    {
+      std::vector<MSChromatogram> chromatograms;
+      std::vector<MSChromatogram> ms1_chromatograms;
+      FeatureMap features;
+      std::vector<String> tsv_lines;
+      std::vector<String> osw_lines;
+    };
+
+    /// Output of all batches of a window, merged in the order of the windows
+    struct WindowOutput
+    {
+      std::vector<BatchOutput> batches;
+      String checkpoint; ///< OSW checkpoint of the window (empty if none)
+    };
+
+    /// Work item of a batch (for reproducible unique ids of its features)
+    UInt64 batchItem(SignedSize window, SignedSize batch)
+    {
+      return (UInt64(window) << 32) + UInt64(batch);
+    }
+  }
 
   OpenSwath::SpectrumAccessPtr loadMS1Map(const std::vector< OpenSwath::SwathMap > & swath_maps, bool load_into_memory)
   {
@@ -311,6 +340,8 @@ namespace OpenMS
     }
 
     this->startProgress(0, 1, "Extract iRT chromatograms");
+    // chromatograms of each map, appended in the order of the maps (independent of the schedule)
+    std::vector<std::vector<MSChromatogram> > map_chromatograms(swath_maps.size());
 #ifdef _OPENMP
 #pragma omp parallel for schedule(dynamic,1)
 #endif
@@ -382,10 +413,12 @@ namespace OpenMS
           extractor.return_chromatogram(tmp_out, coordinates,
               transition_exp_used, SpectrumSettings(), tmp_chromatograms, false, cp.im_extraction_window);
 
+          PerfCounters::LockWait wait;
 #ifdef _OPENMP
 #pragma omp critical (osw_write_chroms)
 #endif
           {
+            wait.acquired();
             int nr_empty_chromatograms = 0;
             OPENMS_LOG_DEBUG << "[simple] Extracted "  << tmp_chromatograms.size() << " chromatograms from SWATH map " <<
               map_idx << " with m/z " << swath_maps[map_idx].lower << " to " << swath_maps[map_idx].upper << ":" << std::endl;
@@ -401,7 +434,7 @@ namespace OpenMS
               if (tic > 0.0)
               {
                 // add the chromatogram to the output
-                chromatograms.push_back(tmp_chromatograms[chrom_idx]);
+                map_chromatograms[map_idx].push_back(tmp_chromatograms[chrom_idx]);
               }
               else
               {
@@ -424,6 +457,10 @@ namespace OpenMS
         }
       }
     }
+    for (auto& map_chroms : map_chromatograms)
+    {
+      chromatograms.insert(chromatograms.end(), std::make_move_iterator(map_chroms.begin()), std::make_move_iterator(map_chroms.end()));
+    }
 
     if (sonar)
     {
@@ -472,6 +509,16 @@ namespace OpenMS
 namespace OpenMS
 {
 
+  namespace
+  {
+    /// Name of SWATH map @p index in the checkpoints of the OSW output (see OpenSwathWorkflow::setResume())
+    String checkpointUnit(const OpenSwath::SwathMap& map, Size index)
+    {
+      return (map.ms1 ? "MS1 " : "SWATH ") + String(index) + " (m/z " + String(map.lower) + "-" + String(map.upper)
+             + ", IM " + String(map.imLower) + "-" + String(map.imUpper) + ")";
+    }
+  }
+
   void OpenSwathWorkflow::performExtraction(
     const std::vector< OpenSwath::SwathMap > & swath_maps,
     const TransformationDescription& trafo,
@@ -488,11 +535,38 @@ namespace OpenMS
     int ms1_isotopes,
     bool load_into_memory)
   {
-    tsv_writer.writeHeader();
-    osw_writer.writeHeader();
-
     bool ms1_only = (swath_maps.size() == 1 && swath_maps[0].ms1);
 
+    // With checkpoints, skip the windows an interrupted run has completed already (see setResume())
+    const bool checkpoints = resume_ && osw_writer.isActive();
+    std::vector<String> units(swath_maps.size());
+    for (Size i = 0; i < swath_maps.size(); ++i)
+    {
+      units[i] = checkpointUnit(swath_maps[i], i);
+    }
+    std::set<String> completed;
+    if (checkpoints)
+    {
+      completed = osw_writer.readCheckpoints();
+      for (const String& unit : completed)
+      {
+        if (std::find(units.begin(), units.end(), unit) == units.end())
+        {
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+              "Error, the OSW output holds the checkpoint '" + unit + "' which does not match any SWATH window of the input. Cannot resume the analysis of a different input.");
+        }
+      }
+    }
+    if (completed.empty())
+    {
+      tsv_writer.writeHeader();
+      osw_writer.writeHeader(checkpoints);
+    }
+    else
+    {
+      std::cout << "Resuming an interrupted run: " << completed.size() << " SWATH windows are completed already." << std::endl;
+    }
+
     // Compute inversion of the transformation
     TransformationDescription trafo_inverse = trafo;
     trafo_inverse.invert();
@@ -512,8 +586,8 @@ namespace OpenMS
 
     if (use_ms1_traces_) ms1_map_ = loadMS1Map(swath_maps, load_into_memory);
 
-    // (ii) Precursor extraction only
-    if (ms1_only)
+    // (ii) Precursor extraction only (done by the first shard)
+    if (ms1_only && shard_index_ == 0 && completed.count(units[0]) == 0)
     {
       std::vector< MSChromatogram > ms1_chromatograms;
       MS1Extraction_(ms1_map_, swath_maps, ms1_chromatograms, ms1_cp,
@@ -523,9 +597,16 @@ namespace OpenMS
       boost::shared_ptr<MSExperiment> empty_exp = boost::shared_ptr<MSExperiment>(new MSExperiment);
 
       const OpenSwath::LightTargetedExperiment& transition_exp_used = transition_exp;
+      std::vector<String> osw_lines;
       scoreAllChromatograms_(std::vector<MSChromatogram>(), ms1_chromatograms, swath_maps, transition_exp_used,
                             feature_finder_param, trafo,
-                            cp.rt_extraction_window, featureFile, tsv_writer, osw_writer, ms1_isotopes, true);
+                            cp.rt_extraction_window, featureFile, tsv_writer, osw_writer, ms1_isotopes, true,
+                            checkpoints ? &osw_lines : nullptr);
+      if (checkpoints)
+      {
+        osw_lines.push_back(osw_writer.prepareCheckpoint(units[0]));
+        osw_writer.enqueueLines(osw_lines);
+      }
 
       // write features to output if so desired
       std::vector< OpenMS::MSChromatogram > chromatograms;
@@ -619,6 +700,33 @@ namespace OpenMS
     // We set dynamic scheduling such that the maps are worked on in the order
     // in which they were given to the program / acquired. This gives much
     // better load balancing than static allocation.
+    // With sharding (see setShard()), the MS2 maps are dealt round-robin to
+    // the shards and only the maps of this shard are processed.
+    std::vector<bool> in_shard(swath_maps.size(), false);
+    Size ms2_index = 0;
+    for (Size i = 0; i < swath_maps.size(); ++i)
+    {
+      if (!swath_maps[i].ms1) in_shard[i] = (ms2_index++ % shard_count_ == shard_index_);
+      if (completed.count(units[i]) > 0) in_shard[i] = false;
+    }
+
+    // In the deterministic mode, the output of each window is buffered and
+    // written in the order of the windows (otherwise each batch is written as
+    // soon as it is scored)
+    const bool deterministic = TaskScheduler::isDeterministic();
+    TaskScheduler::OrderedMerge<WindowOutput> window_merge([&](Size, WindowOutput& window)
+    {
+      std::vector<String> osw_lines;
+      for (BatchOutput& batch : window.batches)
+      {
+        writeOutFeaturesAndChroms_(batch.chromatograms, batch.ms1_chromatograms, batch.features, out_featureFile, store_features, chromConsumer);
+        if (tsv_writer.isActive()) tsv_writer.enqueueLines(batch.tsv_lines);
+        osw_lines.insert(osw_lines.end(), std::make_move_iterator(batch.osw_lines.begin()), std::make_move_iterator(batch.osw_lines.end()));
+      }
+      if (!window.checkpoint.empty()) osw_lines.push_back(window.checkpoint);
+      if (osw_writer.isActive() && !osw_lines.empty()) osw_writer.enqueueLines(osw_lines);
+    }, 0, true);
+
 #ifdef _OPENMP
 #ifdef MT_ENABLE_NESTED_OPENMP
     int total_nr_threads = omp_get_max_threads(); // store total number of threads we are allowed to use
@@ -638,8 +746,11 @@ namespace OpenMS
 #endif
     for (SignedSize i = 0; i < boost::numeric_cast<SignedSize>(swath_maps.size()); ++i)
     {
-      if (!swath_maps[i].ms1) // skip MS1
+      WindowOutput window_output; // only used in the deterministic mode
+      if (!swath_maps[i].ms1 && in_shard[i]) // skip MS1, maps of other shards and completed maps
       {
+        // with checkpoints, the lines of all batches are written together with the checkpoint of the window
+        std::vector<String> window_osw_lines;
 
         // Step 1: select which transitions to extract (proceed in batches)
         OpenSwath::LightTargetedExperiment transition_exp_used_all;
@@ -695,6 +806,17 @@ namespace OpenMS
             current_swath_map = boost::shared_ptr<SpectrumAccessOpenMSInMemory>( new SpectrumAccessOpenMSInMemory(*current_swath_map) );
           }
 
+          // Scoring fetches the same spectra around the apex of overlapping
+          // peak groups repeatedly, keep the most recent ones decoded (the
+          // extraction itself reads each spectrum once per pass and bypasses
+          // the cache)
+          OpenSwath::SpectrumAccessPtr scoring_swath_map = current_swath_map;
+          if (spectrum_cache_size_ > 0)
+          {
+            scoring_swath_map = boost::shared_ptr<SpectrumAccessLRUCache>(
+                new SpectrumAccessLRUCache(current_swath_map, spectrum_cache_size_, spectrum_cache_size_));
+          }
+
           int batch_size;
           if (batchSize <= 0 || batchSize >= (int)transition_exp_used_all.getCompounds().size())
           {
@@ -706,108 +828,177 @@ namespace OpenMS
           }
 
           SignedSize nr_batches = (transition_exp_used_all.getCompounds().size() / batch_size);
+          SignedSize pass_size = std::max(1, batches_per_pass_);
+          if (deterministic) window_output.batches.resize(nr_batches + 1);
+
+          // Extract the batches in passes of pass_size batches: all batches of
+          // a pass are extracted together in a single traversal of the SWATH
+          // map (each spectrum is read and decoded once per pass instead of
+          // once per batch), then each batch is scored individually.
+          for (SignedSize pass_start = 0; pass_start <= nr_batches; pass_start += pass_size)
+          {
+            const SignedSize pass_end = std::min(pass_start + pass_size, nr_batches + 1);
+
+            // Step 2.1: select the transitions of all batches in this pass
+            std::vector< OpenSwath::LightTargetedExperiment > pass_transitions(pass_end - pass_start);
+            std::vector< std::vector< OpenSwath::ChromatogramPtr > > pass_chrom_lists(pass_end - pass_start);
+            std::vector< std::vector< ChromatogramExtractor::ExtractionCoordinates > > pass_coordinates(pass_end - pass_start);
+            for (SignedSize pep_idx = pass_start; pep_idx < pass_end; pep_idx++)
+            {
+              selectCompoundsForBatch_(transition_exp_used_all, pass_transitions[pep_idx - pass_start], batch_size, pep_idx);
+              // chrom_list contains one entry for each fragment ion (transition) in the batch
+              prepareExtractionCoordinates_(pass_chrom_lists[pep_idx - pass_start], pass_coordinates[pep_idx - pass_start],
+                  pass_transitions[pep_idx - pass_start], trafo_inverse, cp);
+            }
 
 #ifdef _OPENMP
 #ifdef MT_ENABLE_NESTED_OPENMP
-          // If we have a multiple of threads_outer_loop_ here, then use nested
-          // parallelization here. E.g. if we use 8 threads for the outer loop,
-          // but we have a total of 24 cores available, each of the 8 threads
-          // will then create a team of 3 threads to work on the batches
-          // individually.
-          //
-          // We should avoid oversubscribing the CPUs, therefore we use integer division.
-          // -- see https://docs.oracle.com/cd/E19059-01/stud.10/819-0501/2_nested.html
-          int outer_thread_nr = omp_get_thread_num();
-          omp_set_num_threads(std::max(1, total_nr_threads / threads_outer_loop_) );
-#pragma omp parallel for schedule(dynamic, 1)
+            // If we have a multiple of threads_outer_loop_ here, then use nested
+            // parallelization here. E.g. if we use 8 threads for the outer loop,
+            // but we have a total of 24 cores available, each of the 8 threads
+            // will then create a team of 3 threads to work on the batches
+            // individually.
+            //
+            // We should avoid oversubscribing the CPUs, therefore we use integer division.
+            // -- see https://docs.oracle.com/cd/E19059-01/stud.10/819-0501/2_nested.html
+            int outer_thread_nr = omp_get_thread_num();
+            omp_set_num_threads(std::max(1, total_nr_threads / threads_outer_loop_) );
 #endif
 #endif
-          for (SignedSize pep_idx = 0; pep_idx <= nr_batches; pep_idx++)
-          {
-            OpenSwath::SpectrumAccessPtr current_swath_map_inner = current_swath_map;
+
+            // Step 2.2: extract the chromatograms of all batches of this pass
+            // (with nested parallelization, the batches of each block of spectra
+            // are distributed over the inner team of threads)
+            ChromatogramExtractorAlgorithm().extractChromatograms(current_swath_map, pass_chrom_lists, pass_coordinates,
+                cp.mz_extraction_window, cp.ppm, cp.im_extraction_window, cp.extraction_function);
 
 #ifdef _OPENMP
 #ifdef MT_ENABLE_NESTED_OPENMP
-            // To ensure multi-threading safe access to the individual spectra, we
-            // need to use a light clone of the spectrum access (if multiple threads
-            // share a single filestream and call seek on it, chaos will ensue).
-            if (total_nr_threads / threads_outer_loop_ > 1)
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+#endif
+            for (SignedSize pep_idx = pass_start; pep_idx < pass_end; pep_idx++)
             {
-              current_swath_map_inner = current_swath_map->lightClone();
-            }
+              OpenSwath::SpectrumAccessPtr current_swath_map_inner = scoring_swath_map;
+
+#ifdef _OPENMP
+#ifdef MT_ENABLE_NESTED_OPENMP
+              // To ensure multi-threading safe access to the individual spectra, we
+              // need to use a light clone of the spectrum access (if multiple threads
+              // share a single filestream and call seek on it, chaos will ensue).
+              if (total_nr_threads / threads_outer_loop_ > 1)
+              {
+                current_swath_map_inner = scoring_swath_map->lightClone();
+              }
 #endif
 #pragma omp critical (osw_write_stdout)
 #endif
-            {
-              std::cout << "Thread " <<
+              {
+                std::cout << "Thread " <<
 #ifdef _OPENMP
 #ifdef MT_ENABLE_NESTED_OPENMP
-              outer_thread_nr << "_" << omp_get_thread_num() << " " <<
+                outer_thread_nr << "_" << omp_get_thread_num() << " " <<
 #else
-              omp_get_thread_num() << "_0 " <<
+                omp_get_thread_num() << "_0 " <<
 #endif
 #else
-              "0" <<
+                "0" <<
 #endif
-              "will analyze " << transition_exp_used_all.getCompounds().size() <<  " compounds and "
-              << transition_exp_used_all.getTransitions().size() <<  " transitions "
-              "from SWATH " << i << " (batch " << pep_idx << " out of " << nr_batches << ")" << std::endl;
-            }
-
-            // Create the new, batch-size transition experiment
-            OpenSwath::LightTargetedExperiment transition_exp_used;
-            selectCompoundsForBatch_(transition_exp_used_all, transition_exp_used, batch_size, pep_idx);
+                "will analyze " << transition_exp_used_all.getCompounds().size() <<  " compounds and "
+                << transition_exp_used_all.getTransitions().size() <<  " transitions "
+                "from SWATH " << i << " (batch " << pep_idx << " out of " << nr_batches << ")" << std::endl;
+              }
 
-            // Extract MS1 chromatograms for this batch
-            std::vector< MSChromatogram > ms1_chromatograms;
-            if (ms1_map_ != nullptr)
-            {
-              OpenSwath::SpectrumAccessPtr threadsafe_ms1 = ms1_map_->lightClone();
-              MS1Extraction_(threadsafe_ms1, swath_maps, ms1_chromatograms, ms1_cp,
-                  transition_exp_used, trafo_inverse, ms1_only, ms1_isotopes);
-            }
+              const OpenSwath::LightTargetedExperiment& transition_exp_used = pass_transitions[pep_idx - pass_start];
+              std::vector< OpenSwath::ChromatogramPtr >& chrom_list = pass_chrom_lists[pep_idx - pass_start];
+              const std::vector< ChromatogramExtractor::ExtractionCoordinates >& coordinates = pass_coordinates[pep_idx - pass_start];
 
-            // Step 2.1: extract these transitions
-            ChromatogramExtractor extractor;
-            std::vector< OpenSwath::ChromatogramPtr > chrom_list;
-            std::vector< ChromatogramExtractor::ExtractionCoordinates > coordinates;
+              // ids of the features depend on the batch only (not on the thread scoring it)
+              UniqueIdGenerator::ItemScope batch_ids(batchItem(i, pep_idx), deterministic);
 
-            // Step 2.2: prepare the extraction coordinates and extract chromatograms
-            // chrom_list contains one entry for each fragment ion (transition) in transition_exp_used
-            prepareExtractionCoordinates_(chrom_list, coordinates, transition_exp_used, trafo_inverse, cp);
-            extractor.extractChromatograms(current_swath_map_inner, chrom_list, coordinates, cp.mz_extraction_window,
-                cp.ppm, cp.im_extraction_window, cp.extraction_function);
+              // Extract MS1 chromatograms for this batch
+              std::vector< MSChromatogram > ms1_chromatograms;
+              if (ms1_map_ != nullptr)
+              {
+                OpenSwath::SpectrumAccessPtr threadsafe_ms1 = ms1_map_->lightClone();
+                MS1Extraction_(threadsafe_ms1, swath_maps, ms1_chromatograms, ms1_cp,
+                    transition_exp_used, trafo_inverse, ms1_only, ms1_isotopes);
+              }
 
-            // Step 2.3: convert chromatograms back to OpenMS::MSChromatogram and write to output
-            PeakMap chrom_exp;
-            extractor.return_chromatogram(chrom_list, coordinates, transition_exp_used,  SpectrumSettings(),
-                                          chrom_exp.getChromatograms(), false, cp.im_extraction_window);
+              // Step 2.3: convert chromatograms back to OpenMS::MSChromatogram and write to output
+              PeakMap chrom_exp;
+              ChromatogramExtractor().return_chromatogram(chrom_list, coordinates, transition_exp_used,  SpectrumSettings(),
+                                            chrom_exp.getChromatograms(), false, cp.im_extraction_window);
 
 
-            // Step 3: score these extracted transitions
-            FeatureMap featureFile;
-            std::vector< OpenSwath::SwathMap > tmp = {swath_maps[i]};
-            tmp.back().sptr = current_swath_map_inner;
-            scoreAllChromatograms_(chrom_exp.getChromatograms(), ms1_chromatograms, tmp, transition_exp_used,
-                feature_finder_param, trafo, cp.rt_extraction_window, featureFile, tsv_writer, osw_writer, ms1_isotopes);
-
-            // Step 4: write all chromatograms and features out into an output object / file
-            // (this needs to be done in a critical section since we only have one
-            // output file and one output map).
-            #pragma omp critical (osw_write_out)
-            {
-              writeOutFeaturesAndChroms_(chrom_exp.getChromatograms(), ms1_chromatograms, featureFile, out_featureFile, store_features, chromConsumer);
+              // Step 3: score these extracted transitions
+              FeatureMap featureFile;
+              std::vector< OpenSwath::SwathMap > tmp = {swath_maps[i]};
+              tmp.back().sptr = current_swath_map_inner;
+              if (deterministic)
+              {
+                BatchOutput& batch = window_output.batches[pep_idx];
+                scoreAllChromatograms_(chrom_exp.getChromatograms(), ms1_chromatograms, tmp, transition_exp_used,
+                    feature_finder_param, trafo, cp.rt_extraction_window, batch.features, tsv_writer, osw_writer, ms1_isotopes,
+                    false, &batch.osw_lines, &batch.tsv_lines);
+                // Step 4: keep the output until the window is merged
+                batch.chromatograms = std::move(chrom_exp.getChromatograms());
+                batch.ms1_chromatograms = std::move(ms1_chromatograms);
+              }
+              else
+              {
+                scoreAllChromatograms_(chrom_exp.getChromatograms(), ms1_chromatograms, tmp, transition_exp_used,
+                    feature_finder_param, trafo, cp.rt_extraction_window, featureFile, tsv_writer, osw_writer, ms1_isotopes,
+                    false, checkpoints ? &window_osw_lines : nullptr);
+
+                // Step 4: write all chromatograms and features out into an output object / file
+                // (this needs to be done in a critical section since we only have one
+                // output file and one output map).
+                PerfCounters::LockWait wait;
+                #pragma omp critical (osw_write_out)
+                {
+                  wait.acquired();
+                  writeOutFeaturesAndChroms_(chrom_exp.getChromatograms(), ms1_chromatograms, featureFile, out_featureFile, store_features, chromConsumer);
+                }
+              }
             }
           }
 
+          if (auto* cache = dynamic_cast<SpectrumAccessLRUCache*>(scoring_swath_map.get()))
+          {
+            SpectrumAccessLRUCache::CacheStatistics stats = cache->getStatistics();
+            OPENMS_LOG_DEBUG << "Spectrum cache of SWATH " << i << ": " << stats.hits << " hits, " << stats.misses << " misses, "
+              << stats.summed_hits << " hits and " << stats.summed_misses << " misses of added up spectra (hit rate "
+              << stats.getHitRate() << ")" << std::endl;
+          }
+
         } // continue 2 (no continue due to OpenMP)
+
+        if (checkpoints && deterministic)
+        {
+          window_output.checkpoint = osw_writer.prepareCheckpoint(units[i]);
+        }
+        else if (checkpoints)
+        {
+          window_osw_lines.push_back(osw_writer.prepareCheckpoint(units[i]));
+          osw_writer.enqueueLines(window_osw_lines);
+        }
       } // continue 1 (no continue due to OpenMP)
+      if (deterministic)
+      {
+        window_merge.add(i, std::move(window_output));
+      }
 
       #pragma omp critical (progress)
       this->setProgress(++progress);
 
     }
     this->endProgress();
+    window_merge.finish();
+
+    // write the lines still queued by the scoring threads
+    if (tsv_writer.isActive()) tsv_writer.flush();
+    if (osw_writer.isActive()) osw_writer.flush();
 
 #ifdef _OPENMP
 #ifdef MT_ENABLE_NESTED_OPENMP
@@ -897,7 +1088,9 @@ namespace OpenMS
     OpenSwathTSVWriter & tsv_writer,
     OpenSwathOSWWriter & osw_writer,
     int nr_ms1_isotopes,
-    bool ms1only) const
+    bool ms1only,
+    std::vector<String>* osw_lines,
+    std::vector<String>* tsv_lines) const
   {
     TransformationDescription trafo_inv = trafo;
     trafo_inv.invert();
@@ -1033,6 +1226,7 @@ namespace OpenMS
 
       // 3. / 4. Process the MRMTransitionGroup: find peakgroups and score them
       trgroup_picker.pickTransitionGroup(transition_group);
+      PerfCounters::add(PerfCounters::CANDIDATES_SCORED, transition_group.getFeatures().size());
       featureFinder.scorePeakgroups(transition_group, trafo, swath_maps, output, ms1only);
 
       // Ensure that a detection transition is used to derive features for output
@@ -1060,25 +1254,34 @@ namespace OpenMS
       }
     }
 
-    // Only write at the very end since this is a step that needs a barrier
+    // Hand the lines over to the writers: they are written in batches by
+    // whichever thread finds the writer idle, the other threads continue
+    // scoring (see OpenSwathOutputQueue)
     if (tsv_writer.isActive())
     {
-#ifdef _OPENMP
-#pragma omp critical (osw_write_tsv)
-#endif
+      if (tsv_lines != nullptr)
       {
-        tsv_writer.writeLines(to_tsv_output);
+        tsv_lines->insert(tsv_lines->end(), std::make_move_iterator(to_tsv_output.begin()), std::make_move_iterator(to_tsv_output.end()));
+      }
+      else
+      {
+        tsv_writer.enqueueLines(to_tsv_output);
       }
     }
-
-    // Only write at the very end since this is a step that needs a barrier
     if (osw_writer.isActive())
     {
-#ifdef _OPENMP
-#pragma omp critical (osw_write_tsv)
-#endif
+      if (osw_lines != nullptr)
+      {
+        PerfCounters::LockWait wait;
+#pragma omp critical (osw_checkpoint_lines)
+        {
+          wait.acquired();
+          osw_lines->insert(osw_lines->end(), std::make_move_iterator(to_osw_output.begin()), std::make_move_iterator(to_osw_output.end()));
+        }
+      }
+      else
       {
-        osw_writer.writeLines(to_osw_output);
+        osw_writer.enqueueLines(to_osw_output);
       }
     }
   }
@@ -1199,6 +1402,20 @@ namespace OpenMS
       int progress = 0;
       this->startProgress(0, sonar_total_win, "Extracting and scoring transitions");
 
+      // In the deterministic mode, the output of each SONAR window is buffered
+      // and written in the order of the windows
+      const bool deterministic = TaskScheduler::isDeterministic();
+      TaskScheduler::OrderedMerge<WindowOutput> window_merge([&](Size, WindowOutput& window)
+      {
+        for (BatchOutput& batch : window.batches)
+        {
+          // the MS1 chromatograms are the same for all batches
+          writeOutFeaturesAndChroms_(batch.chromatograms, ms1_chromatograms, batch.features, out_featureFile, store_features, chromConsumer);
+          if (tsv_writer.isActive()) tsv_writer.enqueueLines(batch.tsv_lines);
+          if (osw_writer.isActive()) osw_writer.enqueueLines(batch.osw_lines);
+        }
+      }, 0, true);
+
       ///////////////////////////////////////////////////////////////////////////
       // Iterate through all SONAR windows
       // We set dynamic scheduling such that the SONAR windows are worked on in
@@ -1210,6 +1427,7 @@ namespace OpenMS
 #endif
       for (int sonar_idx = 0; sonar_idx < sonar_total_win; sonar_idx++)
       {
+        WindowOutput window_output; // only used in the deterministic mode
         double currwin_start = sonar_start + sonar_idx * sonar_winsize;
         double currwin_end = currwin_start + sonar_winsize;
         OPENMS_LOG_DEBUG << "   ====  sonar window " << sonar_idx << " from " << currwin_start << " to " << currwin_end << std::endl;
@@ -1289,8 +1507,12 @@ namespace OpenMS
             << transition_exp_used_all.getTransitions().size() <<  " transitions "
             "from SONAR SWATH " << sonar_idx << " in batches of " << batch_size << std::endl;
           }
+          if (deterministic) window_output.batches.resize(transition_exp_used_all.getCompounds().size() / batch_size + 1);
           for (size_t pep_idx = 0; pep_idx <= (transition_exp_used_all.getCompounds().size() / batch_size); pep_idx++)
           {
+            // ids of the features depend on the batch only (not on the thread scoring it)
+            UniqueIdGenerator::ItemScope batch_ids(batchItem(sonar_idx, pep_idx), deterministic);
+
             // Create the new, batch-size transition experiment
             OpenSwath::LightTargetedExperiment transition_exp_used;
             selectCompoundsForBatch_(transition_exp_used_all, transition_exp_used, batch_size, pep_idx);
@@ -1309,27 +1531,50 @@ namespace OpenMS
                                                         chrom_exp.getChromatograms(), false, cp.im_extraction_window);
 
             // Step 3: score these extracted transitions
-            FeatureMap featureFile;
-            scoreAllChromatograms_(chrom_exp.getChromatograms(), ms1_chromatograms, used_maps, transition_exp_used,
-                                   feature_finder_param, trafo, cp.rt_extraction_window, featureFile, tsv_writer, osw_writer);
-
-            // Step 4: write all chromatograms and features out into an output object / file
-            // (this needs to be done in a critical section since we only have one
-            // output file and one output map).
+            if (deterministic)
+            {
+              BatchOutput& batch = window_output.batches[pep_idx];
+              scoreAllChromatograms_(chrom_exp.getChromatograms(), ms1_chromatograms, used_maps, transition_exp_used,
+                                     feature_finder_param, trafo, cp.rt_extraction_window, batch.features, tsv_writer, osw_writer,
+                                     0, false, &batch.osw_lines, &batch.tsv_lines);
+              // Step 4: keep the output until the window is merged
+              batch.chromatograms = std::move(chrom_exp.getChromatograms());
+            }
+            else
+            {
+              FeatureMap featureFile;
+              scoreAllChromatograms_(chrom_exp.getChromatograms(), ms1_chromatograms, used_maps, transition_exp_used,
+                                     feature_finder_param, trafo, cp.rt_extraction_window, featureFile, tsv_writer, osw_writer);
+
+              // Step 4: write all chromatograms and features out into an output object / file
+              // (this needs to be done in a critical section since we only have one
+              // output file and one output map).
+              PerfCounters::LockWait wait;
 #ifdef _OPENMP
 #pragma omp critical (osw_write_out)
 #endif
-            {
-              writeOutFeaturesAndChroms_(chrom_exp.getChromatograms(), ms1_chromatograms, featureFile, out_featureFile, store_features, chromConsumer);
+              {
+                wait.acquired();
+                writeOutFeaturesAndChroms_(chrom_exp.getChromatograms(), ms1_chromatograms, featureFile, out_featureFile, store_features, chromConsumer);
+              }
             }
           }
         }
+        if (deterministic)
+        {
+          window_merge.add(sonar_idx, std::move(window_output));
+        }
 #ifdef _OPENMP
 #pragma omp critical (progress)
 #endif
         this->setProgress(++progress);
       }
       this->endProgress();
+      window_merge.finish();
+
+      // write the lines still queued by the scoring threads
+      if (tsv_writer.isActive()) tsv_writer.flush();
+      if (osw_writer.isActive()) osw_writer.flush();
     }
 
 
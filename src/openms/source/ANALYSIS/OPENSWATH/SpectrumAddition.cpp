@@ -11,6 +11,8 @@
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/PROCESSING/RESAMPLING/LinearResamplerAlign.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/DataAccessHelper.h>
+#include <algorithm>
+#include <functional>
 #include <numeric> // std::iota
 
 namespace OpenMS
@@ -51,53 +53,39 @@ namespace OpenMS
            "Postcondition violated: m/z vector needs to be sorted!" )
   }
 
-  OpenSwath::SpectrumPtr SpectrumAddition::addUpSpectra(const SpectrumSequence& all_spectra, double sampling_rate, bool filter_zeros)
+  void SpectrumAddition::addUpViews_(double sampling_rate, bool filter_zeros, Workspace& workspace, OpenSwath::Spectrum& output)
   {
+    const std::vector<Workspace::View>& views = workspace.views;
+    std::vector<double>& out_mz = output.getMZArray()->data;
+    std::vector<double>& out_int = output.getIntensityArray()->data;
+    out_mz.clear();
+    out_int.clear();
 
-    if (all_spectra.size() == 1) return all_spectra[0];
-    if (all_spectra.empty())
-    {
-      OpenSwath::SpectrumPtr sptr(new OpenSwath::Spectrum);
-      return sptr;
-    }
     // ensure first one is not empty
-    if (all_spectra[0]->getMZArray()->data.empty() )
+    if (views[0].size == 0)
     {
-      OpenSwath::SpectrumPtr sptr(new OpenSwath::Spectrum);
-      return sptr;
+      return;
     }
 
     // find global min and max -> use as start/endpoints for resampling
-    double min = all_spectra[0]->getMZArray()->data[0];
-    double max = all_spectra[0]->getMZArray()->data.back();
+    double min = views[0].mz[0];
+    double max = views[0].mz[views[0].size - 1];
     double min_spacing = max - min;
-    for (Size i = 0; i < all_spectra.size(); i++)
+    for (const Workspace::View& v : views)
     {
-      if (all_spectra[i]->getMZArray()->data.empty() )
+      if (v.size == 0)
       {
         continue;
       }
 
       // estimate sampling rate
-      for (Size k = 0; k < all_spectra[i]->getMZArray()->data.size() && sampling_rate < 0; k++)
+      for (Size k = 1; k < v.size && sampling_rate < 0; k++)
       {
-        if (k > 0)
-        {
-          if (min_spacing > all_spectra[i]->getMZArray()->data[k] - all_spectra[i]->getMZArray()->data[k-1] )
-          {
-            min_spacing = all_spectra[i]->getMZArray()->data[k] - all_spectra[i]->getMZArray()->data[k-1];
-          }
-        }
+        min_spacing = std::min(min_spacing, v.mz[k] - v.mz[k-1]);
       }
 
-      if (all_spectra[i]->getMZArray()->data[0] < min)
-      {
-        min = all_spectra[i]->getMZArray()->data[0];
-      }
-      if (all_spectra[i]->getMZArray()->data.back() > max)
-      {
-        max = all_spectra[i]->getMZArray()->data.back();
-      }
+      min = std::min(min, v.mz[0]);
+      max = std::max(max, v.mz[v.size - 1]);
     }
 
     // in case we are asked to estimate the resampling rate
@@ -105,61 +93,147 @@ namespace OpenMS
 
     // generate the resampled peaks at positions origin+i*spacing_
     int number_resampled_points = (max - min) / sampling_rate + 1;
-    OpenSwath::SpectrumPtr resampled_peak_container(new OpenSwath::Spectrum);
-    resampled_peak_container->getMZArray()->data.resize(number_resampled_points);
-    resampled_peak_container->getIntensityArray()->data.resize(number_resampled_points);
-    std::vector<double>::iterator it = resampled_peak_container->getMZArray()->data.begin();
-    int cnt = 0;
-    while (it != resampled_peak_container->getMZArray()->data.end())
+    std::vector<double>& grid_mz = workspace.grid_mz;
+    std::vector<double>& grid_int = workspace.grid_intensity;
+    grid_mz.resize(number_resampled_points);
+    grid_int.assign(number_resampled_points, 0.0);
+    for (int cnt = 0; cnt < number_resampled_points; ++cnt)
     {
-      *it = min + cnt * sampling_rate; // set mz (intensity is zero already)
-      ++it;
-      ++cnt;
+      grid_mz[cnt] = min + cnt * sampling_rate; // set mz (intensity is zero already)
     }
 
     LinearResamplerAlign lresampler;
     // resample all spectra and add to master spectrum
-    for (Size curr_sp = 0; curr_sp < all_spectra.size(); curr_sp++)
+    for (const Workspace::View& v : views)
     {
-      lresampler.raster(all_spectra[curr_sp]->getMZArray()->data.begin(),
-                        all_spectra[curr_sp]->getMZArray()->data.end(),
-                        all_spectra[curr_sp]->getIntensityArray()->data.begin(),
-                        all_spectra[curr_sp]->getIntensityArray()->data.end(),
-                        resampled_peak_container->getMZArray()->data.begin(),
-                        resampled_peak_container->getMZArray()->data.end(),
-                        resampled_peak_container->getIntensityArray()->data.begin(),
-                        resampled_peak_container->getIntensityArray()->data.end()
-      );
+      lresampler.raster_uniform(v.mz, v.mz + v.size, v.intensity, min, sampling_rate,
+                                grid_int.data(), grid_int.data() + grid_int.size());
     }
 
     if (!filter_zeros)
     {
-      OPENMS_POSTCONDITION(std::adjacent_find(resampled_peak_container->getMZArray()->data.begin(),
-           resampled_peak_container->getMZArray()->data.end(), std::greater<double>()) == resampled_peak_container->getMZArray()->data.end(),
-           "Postcondition violated: m/z vector needs to be sorted!" )
-
-
-      return resampled_peak_container;
+      out_mz.assign(grid_mz.begin(), grid_mz.end());
+      out_int.assign(grid_int.begin(), grid_int.end());
     }
     else
     {
-      OpenSwath::SpectrumPtr master_spectrum_filtered(new OpenSwath::Spectrum);
-      for (Size i = 0; i < resampled_peak_container->getIntensityArray()->data.size(); ++i)
+      for (Size i = 0; i < grid_int.size(); ++i)
       {
-        if (resampled_peak_container->getIntensityArray()->data[i] > 0)
+        if (grid_int[i] > 0)
         {
-          master_spectrum_filtered->getIntensityArray()->data.push_back(resampled_peak_container->getIntensityArray()->data[i]);
-          master_spectrum_filtered->getMZArray()->data.push_back(resampled_peak_container->getMZArray()->data[i]);
+          out_int.push_back(grid_int[i]);
+          out_mz.push_back(grid_mz[i]);
         }
       }
+    }
 
-      OPENMS_POSTCONDITION( std::adjacent_find(master_spectrum_filtered->getMZArray()->data.begin(),
-           master_spectrum_filtered->getMZArray()->data.end(), std::greater<double>()) == master_spectrum_filtered->getMZArray()->data.end(),
-           "Postcondition violated: m/z vector needs to be sorted!" )
+    OPENMS_POSTCONDITION(std::adjacent_find(out_mz.begin(), out_mz.end(), std::greater<double>()) == out_mz.end(),
+         "Postcondition violated: m/z vector needs to be sorted!" )
+  }
 
+  void SpectrumAddition::addUpSpectra(const SpectrumSequence& all_spectra, double sampling_rate, bool filter_zeros,
+                                      Workspace& workspace, OpenSwath::Spectrum& output)
+  {
+    output.getDataArrays().resize(2);
+    if (all_spectra.empty())
+    {
+      output.getMZArray()->data.clear();
+      output.getIntensityArray()->data.clear();
+      return;
+    }
+    if (all_spectra.size() == 1)
+    {
+      output.getMZArray()->data = all_spectra[0]->getMZArray()->data;
+      output.getIntensityArray()->data = all_spectra[0]->getIntensityArray()->data;
+      return;
+    }
 
-      return master_spectrum_filtered;
+    workspace.views.clear();
+    for (const auto& spec : all_spectra)
+    {
+      workspace.views.push_back({spec->getMZArray()->data.data(), spec->getIntensityArray()->data.data(), spec->getMZArray()->data.size()});
     }
+    addUpViews_(sampling_rate, filter_zeros, workspace, output);
+  }
+
+  void SpectrumAddition::addUpSpectra(const SpectrumSequence& all_spectra, const RangeMobility& im_range, double sampling_rate, bool filter_zeros,
+                                      Workspace& workspace, OpenSwath::Spectrum& output)
+  {
+    if (im_range.isEmpty())
+    {
+      addUpSpectra(all_spectra, sampling_rate, filter_zeros, workspace, output);
+      return;
+    }
+
+    // since resampling is not supported on 3D data first filter by drift time (if possible) and then add
+    const double drift_start = im_range.getMin();
+    const double drift_end = im_range.getMax();
+    if (workspace.filtered_mz.size() < all_spectra.size())
+    {
+      workspace.filtered_mz.resize(all_spectra.size());
+      workspace.filtered_intensity.resize(all_spectra.size());
+    }
+    workspace.views.clear();
+    for (Size i = 0; i < all_spectra.size(); ++i)
+    {
+      const std::vector<double>& mz = all_spectra[i]->getMZArray()->data;
+      const std::vector<double>& intensity = all_spectra[i]->getIntensityArray()->data;
+      OpenSwath::BinaryDataArrayPtr im_arr = all_spectra[i]->getDriftTimeArray();
+      if (im_arr == nullptr)
+      {
+        workspace.views.push_back({mz.data(), intensity.data(), mz.size()});
+        continue;
+      }
+
+      std::vector<double>& f_mz = workspace.filtered_mz[i];
+      std::vector<double>& f_int = workspace.filtered_intensity[i];
+      f_mz.clear();
+      f_int.clear();
+      const boost::shared_ptr<const OpenSwath::SpectrumMobilityIndex>& index = all_spectra[i]->getMobilityIndex();
+      if (index && index->isIndexOf(*all_spectra[i]))
+      {
+        // only visit the peaks in the ion mobility bins of the range
+        index->getPeaks(drift_start, drift_end, workspace.peaks);
+        for (Size k : workspace.peaks)
+        {
+          f_mz.push_back(mz[k]);
+          f_int.push_back(intensity[k]);
+        }
+      }
+      else
+      {
+        const std::vector<double>& im = im_arr->data;
+        for (Size k = 0; k < mz.size(); ++k)
+        {
+          if ( (drift_start <= im[k]) && (drift_end >= im[k]) )
+          {
+            f_mz.push_back(mz[k]);
+            f_int.push_back(intensity[k]);
+          }
+        }
+      }
+      workspace.views.push_back({f_mz.data(), f_int.data(), f_mz.size()});
+    }
+
+    output.getDataArrays().resize(2);
+    if (workspace.views.size() == 1)
+    {
+      const Workspace::View& v = workspace.views[0];
+      output.getMZArray()->data.assign(v.mz, v.mz + v.size);
+      output.getIntensityArray()->data.assign(v.intensity, v.intensity + v.size);
+      return;
+    }
+    addUpViews_(sampling_rate, filter_zeros, workspace, output);
+  }
+
+  OpenSwath::SpectrumPtr SpectrumAddition::addUpSpectra(const SpectrumSequence& all_spectra, double sampling_rate, bool filter_zeros)
+  {
+    if (all_spectra.size() == 1) return all_spectra[0];
+
+    Workspace workspace;
+    OpenSwath::SpectrumPtr added_spec(new OpenSwath::Spectrum);
+    addUpSpectra(all_spectra, sampling_rate, filter_zeros, workspace, *added_spec);
+    return added_spec;
   }
 
 
@@ -168,57 +242,111 @@ namespace OpenMS
                                              double sampling_rate,
                                              bool filter_zeros)
   {
-    OpenSwath::SpectrumPtr added_spec(new OpenSwath::Spectrum);
-
-    // If no spectra found return
-    if (all_spectra.empty())
-    {
-      return added_spec;
-    }
-
     if (im_range.isEmpty())
     {
       return addUpSpectra(all_spectra, sampling_rate, filter_zeros);
     }
-    // since resampling is not supported on 3D data first filter by drift time (if possible) and then add
-    // (!im_range.isEmpty())
-    SpectrumSequence filteredSpectra;
-    for (auto spec: all_spectra)
+    // a single spectrum is only filtered (keeping its ion mobility array)
+    if (all_spectra.size() == 1)
     {
-      filteredSpectra.push_back(OpenSwath::ISpectrumAccess::filterByDrift(spec, im_range.getMin(), im_range.getMax()));
+      return OpenSwath::ISpectrumAccess::filterByDrift(all_spectra[0], im_range.getMin(), im_range.getMax());
     }
-    return addUpSpectra(filteredSpectra, sampling_rate, filter_zeros);
-  }
 
-  OpenSwath::SpectrumPtr SpectrumAddition::concatenateSpectra(const SpectrumSequence& all_spectra)
+    Workspace workspace;
+    OpenSwath::SpectrumPtr added_spec(new OpenSwath::Spectrum);
+    addUpSpectra(all_spectra, im_range, sampling_rate, filter_zeros, workspace, *added_spec);
+    return added_spec;
+  }
 
+  void SpectrumAddition::concatenateSpectra(const SpectrumSequence& all_spectra, Workspace& workspace, OpenSwath::Spectrum& output)
   {
-    OpenSwath::SpectrumPtr added_spec(new OpenSwath::Spectrum);
     // Ensure that we have the same number of data arrays as in the input spectrum
     // copying the extra data arrays descriptions onto the added spectra
-    if (!all_spectra.empty() && all_spectra[0]->getDataArrays().size() > 2)
+    std::vector<OpenSwath::BinaryDataArrayPtr>& out_arrays = output.getDataArrays();
+    const Size nr_arrays = all_spectra.empty() ? 2 : std::max(Size(2), all_spectra[0]->getDataArrays().size());
+    out_arrays.resize(nr_arrays);
+    for (Size k = 0; k < nr_arrays; k++)
     {
-      for (Size k = 2; k < all_spectra[0]->getDataArrays().size(); k++)
+      if (out_arrays[k] == nullptr)
       {
-        OpenSwath::BinaryDataArrayPtr tmp (new OpenSwath::BinaryDataArray());
-        tmp->description = all_spectra[0]->getDataArrays()[k]->description;
-        added_spec->getDataArrays().push_back(tmp);
+        out_arrays[k].reset(new OpenSwath::BinaryDataArray);
+      }
+      out_arrays[k]->data.clear();
+      if (k >= 2)
+      {
+        out_arrays[k]->description = all_spectra[0]->getDataArrays()[k]->description;
       }
     }
 
-    // Simply concatenate all spectra together and sort in the end
+    Size total = 0;
+    bool sorted = true;
     for (const auto& s : all_spectra)
     {
-      for (Size k = 0; k < s->getDataArrays().size(); k++)
+      const std::vector<double>& mz = s->getMZArray()->data;
+      total += mz.size();
+      sorted = sorted && std::is_sorted(mz.begin(), mz.end());
+    }
+
+    if (!sorted)
+    {
+      // Simply concatenate all spectra together and sort in the end
+      for (const auto& s : all_spectra)
       {
-        auto& v1 = added_spec->getDataArrays()[k]->data;
-        auto& v2 = s->getDataArrays()[k]->data;
+        for (Size k = 0; k < nr_arrays; k++)
+        {
+          const std::vector<double>& v = s->getDataArrays()[k]->data;
+          out_arrays[k]->data.insert(out_arrays[k]->data.end(), v.begin(), v.end());
+        }
+      }
+      sortSpectrumByMZ(output);
+      return;
+    }
 
-        v1.reserve( v1.size() + v2.size() );
-        v1.insert( v1.end(), v2.begin(), v2.end() );
+    // k-way merge of the sorted spectra, ties are taken from the earlier spectrum
+    for (Size k = 0; k < nr_arrays; k++)
+    {
+      out_arrays[k]->data.resize(total);
+    }
+    std::vector<std::pair<double, Size> >& heap = workspace.heap;
+    std::vector<Size>& cursors = workspace.cursors;
+    auto cmp = std::greater<std::pair<double, Size> >();
+    heap.clear();
+    cursors.assign(all_spectra.size(), 0);
+    for (Size i = 0; i < all_spectra.size(); ++i)
+    {
+      if (!all_spectra[i]->getMZArray()->data.empty())
+      {
+        heap.emplace_back(all_spectra[i]->getMZArray()->data[0], i);
       }
     }
-    sortSpectrumByMZ(*added_spec);
+    std::make_heap(heap.begin(), heap.end(), cmp);
+    for (Size pos = 0; !heap.empty(); ++pos)
+    {
+      std::pop_heap(heap.begin(), heap.end(), cmp);
+      const Size i = heap.back().second;
+      const Size c = cursors[i]++;
+      const std::vector<OpenSwath::BinaryDataArrayPtr>& in_arrays = all_spectra[i]->getDataArrays();
+      for (Size k = 0; k < nr_arrays; k++)
+      {
+        out_arrays[k]->data[pos] = in_arrays[k]->data[c];
+      }
+      if (c + 1 < in_arrays[0]->data.size())
+      {
+        heap.back().first = in_arrays[0]->data[c + 1];
+        std::push_heap(heap.begin(), heap.end(), cmp);
+      }
+      else
+      {
+        heap.pop_back();
+      }
+    }
+  }
+
+  OpenSwath::SpectrumPtr SpectrumAddition::concatenateSpectra(const SpectrumSequence& all_spectra)
+  {
+    Workspace workspace;
+    OpenSwath::SpectrumPtr added_spec(new OpenSwath::Spectrum);
+    concatenateSpectra(all_spectra, workspace, *added_spec);
     return added_spec;
   }
 
@@ -12,10 +12,12 @@
 #include <OpenMS/ML/REGRESSION/LinearRegression.h>
 #include <OpenMS/ML/REGRESSION/QuadraticRegression.h>
 
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessLRUCache.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessQuadMZTransforming.h>
 #include <OpenMS/OPENSWATHALGO/DATAACCESS/SpectrumHelpers.h> // integrateWindow
 #include <OpenMS/ANALYSIS/OPENSWATH/DIAHelper.h>
 
+#include <algorithm>
 #include <fstream>
 
 #define SWATHMAPMASSCORRECTION_DEBUG
@@ -88,6 +90,89 @@ namespace OpenMS
     return used_maps;
   }
 
+  namespace
+  {
+    /// A transition group used for calibration and the spectrum it is extracted from
+    struct CalibrationTarget
+    {
+      const OpenMS::MRMFeatureFinderScoring::MRMTransitionGroupType* group;
+      double rt; ///< RT of the best feature
+      RangeMobility im_range; ///< ion mobility range used to fetch the spectrum
+      std::vector<OpenSwath::SwathMap> maps; ///< SWATH map(s) the spectrum is fetched from
+      double drift_target; ///< library ion mobility
+    };
+
+    /// Maximal number of targets fetched one after the other by the same thread
+    const Size CALIBRATION_BATCH_SIZE = 64;
+
+    /**
+      @brief Calls @p extract(i, spectrum) for all @p targets, with the spectrum of target i (null if there is none)
+
+      The targets are batched by the SWATH map(s) they use and sorted by RT
+      within a batch; batches are processed in parallel. Each batch fetches
+      (like OpenSwathScoring::fetchSpectrumSwath) from its own light clones of
+      the maps, which goes through a spectrum cache, so neighbouring targets
+      with the same closest spectrum decode it only once. If a map already is
+      a SpectrumAccessLRUCache, its cache is used.
+
+      @p extract is called concurrently for different targets.
+    */
+    template<typename ExtractFunction>
+    void forEachCalibrationSpectrum(const std::vector<CalibrationTarget>& targets, ExtractFunction extract)
+    {
+      std::map<std::vector<const OpenSwath::ISpectrumAccess*>, std::vector<Size> > targets_by_maps;
+      for (Size i = 0; i < targets.size(); ++i)
+      {
+        std::vector<const OpenSwath::ISpectrumAccess*> key;
+        for (const auto& m : targets[i].maps)
+        {
+          key.push_back(m.sptr.get());
+        }
+        targets_by_maps[key].push_back(i);
+      }
+      std::vector<std::vector<Size> > batches;
+      for (auto& entry : targets_by_maps)
+      {
+        std::vector<Size>& indices = entry.second;
+        std::stable_sort(indices.begin(), indices.end(), [&targets](Size a, Size b) { return targets[a].rt < targets[b].rt; });
+        for (Size start = 0; start < indices.size(); start += CALIBRATION_BATCH_SIZE)
+        {
+          batches.emplace_back(indices.begin() + start, indices.begin() + std::min(start + CALIBRATION_BATCH_SIZE, indices.size()));
+        }
+      }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+      for (SignedSize b = 0; b < (SignedSize)batches.size(); ++b)
+      {
+        const std::vector<Size>& batch = batches[b];
+        std::vector<OpenSwath::SwathMap> maps = targets[batch[0]].maps;
+#ifdef _OPENMP
+#pragma omp critical (SwathMapMassCorrection_lightClone)
+#endif
+        for (auto& m : maps)
+        {
+          if (dynamic_cast<SpectrumAccessLRUCache*>(m.sptr.get()) != nullptr)
+          {
+            m.sptr = m.sptr->lightClone();
+          }
+          else
+          {
+            m.sptr = boost::shared_ptr<SpectrumAccessLRUCache>(new SpectrumAccessLRUCache(m.sptr->lightClone(), 1, 0));
+          }
+        }
+
+        OpenSwathScoring scoring; // holds the buffers of the spectrum addition
+        for (Size i : batch)
+        {
+          std::vector<OpenSwath::SpectrumPtr> spectra = scoring.fetchSpectrumSwath(maps, targets[i].rt, 1, targets[i].im_range);
+          extract(i, spectra.empty() ? OpenSwath::SpectrumPtr() : spectra[0]);
+        }
+      }
+    }
+  }
+
   SwathMapMassCorrection::SwathMapMassCorrection() :
     DefaultParamHandler("SwathMapMassCorrection")
   {
@@ -154,29 +239,20 @@ namespace OpenMS
       os_im.precision(writtenDigits(double()));
     }
 
-    std::vector<String> trgr_ids;
     std::map<std::string, double> pep_im_map;
-    trgr_ids.reserve(transition_group_map.size());
-    for (const auto& trgroup_it : transition_group_map)
-    {
-      trgr_ids.push_back(trgroup_it.first);
-    }
     for (const auto& cmp : targeted_exp.getCompounds())
     {
       pep_im_map[cmp.id] = cmp.drift_time;
     }
 
-    TransformationDescription::DataPoints data_im;
-    std::vector<double> exp_im;
-    std::vector<double> theo_im;
+    std::vector<OpenSwath::SwathMap> ms1_maps;
+    for (const auto& m : swath_maps) {if (m.ms1) ms1_maps.push_back(m);}
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for (SignedSize k = 0; k < (SignedSize)trgr_ids.size(); k++)
+    std::vector<CalibrationTarget> targets;
+    for (const auto& trgroup_it : transition_group_map)
     {
       // we need at least one feature to find the best one
-      auto transition_group = transition_group_map.at(trgr_ids[k]);
+      auto transition_group = trgroup_it.second;
       if (transition_group->getFeatures().empty()) continue;
 
       // Find the feature with the highest score
@@ -194,66 +270,68 @@ namespace OpenMS
         used_maps = findSwathMapsPasef(*transition_group, swath_maps);
       }
 
-      std::vector<OpenSwath::SwathMap> ms1_maps;
-      for (const auto& m : swath_maps) {if (m.ms1) ms1_maps.push_back(m);}
-
-      if (used_maps.empty())
+      if (used_maps.empty() || (ms1_im_ && ms1_maps.empty()))
       {
         continue;
       }
 
-      // Get the spectrum for this RT and extract raw data points for all the
-      // calibrating transitions (fragment m/z values) from the spectrum
-      // Note that we are not using light clones of the underlying data here,
-      // so access to the data needs to be in a critical section.
-      OpenSwath::SpectrumPtr sp_ms1;
-      OpenSwath::SpectrumPtr sp_ms2;
-#ifdef _OPENMP
-#pragma omp critical
-#endif
+      // Get the spectrum for this RT (MS1 or the SWATH map of the precursor)
+      // and extract raw data points for all the calibrating transitions
+      // (fragment m/z values) or the precursor from the spectrum
+      targets.push_back({transition_group, bestRT, RangeMobility(), ms1_im_ ? ms1_maps : used_maps, 0.0});
+    }
+
+    // extracted points of each target, merged in the order of the targets below
+    struct IMPoint
+    {
+      double mz;
+      double im;
+      double theo_im;
+      double intensity;
+    };
+    std::vector<std::vector<IMPoint> > points(targets.size());
+    forEachCalibrationSpectrum(targets, [&](Size i, const OpenSwath::SpectrumPtr& sp)
+    {
+      const CalibrationTarget& target = targets[i];
+      const auto& transitions = target.group->getTransitions();
+
+      // Check that the spectrum really has a drift time array
+      if (sp == nullptr || sp->getDriftTimeArray() == nullptr)
       {
-        RangeMobility im_range;
-        if (ms1_im_)
-        {
-          std::vector<OpenSwath::SpectrumPtr> fetchSpectrumArr = OpenSwathScoring().fetchSpectrumSwath(ms1_maps, bestRT, 1, im_range);
-          sp_ms1 = (!fetchSpectrumArr.empty()) ? fetchSpectrumArr[0] : *new(OpenSwath::SpectrumPtr);
-        }
-        else
+        OPENMS_LOG_DEBUG << "Did not find a drift time array for peptide " << transitions[0].getPeptideRef() << " at RT " << target.rt  << std::endl;
+        for (const auto& m : target.maps)
         {
-          std::vector<OpenSwath::SpectrumPtr> fetchSpectrumArr = OpenSwathScoring().fetchSpectrumSwath(used_maps, bestRT, 1, im_range);
-          sp_ms2 = (!fetchSpectrumArr.empty()) ? fetchSpectrumArr[0] : *new(OpenSwath::SpectrumPtr);
+          OPENMS_LOG_DEBUG << " -- Used maps " << m.lower << " to " << m.upper << " MS1 : " << m.ms1 << true << std::endl;
         }
+        return;
       }
 
-      for (const auto& tr : transition_group->getTransitions())
+      // MS1 extraction uses the precursor of the first transition only
+      Size nr_extracted = ms1_im_ ? std::min<Size>(1, transitions.size()) : transitions.size();
+      for (Size k = 0; k < nr_extracted; ++k)
       {
-        if (ms1_im_) {continue;}
+        const auto& tr = transitions[k];
         double intensity(0), im(0), mz(0);
-        RangeMZ mz_range = DIAHelpers::createMZRangePPM(tr.product_mz, mz_extr_window, ppm);
+        RangeMZ mz_range = DIAHelpers::createMZRangePPM(ms1_im_ ? tr.precursor_mz : tr.product_mz, mz_extr_window, ppm);
 
         // get drift time upper/lower offset (this assumes that all chromatograms
         // are derived from the same precursor with the same drift time)
-        auto pepref = tr.getPeptideRef();
-        double drift_target = pep_im_map[pepref];
+        auto pep_im = pep_im_map.find(tr.getPeptideRef());
+        double drift_target = (pep_im != pep_im_map.end()) ? pep_im->second : 0.0;
         RangeMobility im_range;
-        if (im_extraction_win != -1 ) // im_extraction_win is set
+        if (ms1_im_)
         {
-          im_range.setMax(drift_target);
+          // do not need to check for IM because we are correcting IM
+          im_range = RangeMobility(drift_target);
           im_range.minSpanIfSingular(im_extraction_win);
         }
-
-        // Check that the spectrum really has a drift time array
-        if (sp_ms2->getDriftTimeArray() == nullptr)
+        else if (im_extraction_win != -1 ) // im_extraction_win is set
         {
-          OPENMS_LOG_DEBUG << "Did not find a drift time array for peptide " << pepref << " at RT " << bestRT  << std::endl;
-          for (const auto& m : used_maps)
-          {
-            OPENMS_LOG_DEBUG << " -- Used maps " << m.lower << " to " << m.upper << " MS1 : " << m.ms1 << true << std::endl;
-          }
-          continue;
+          im_range.setMax(drift_target);
+          im_range.minSpanIfSingular(im_extraction_win);
         }
 
-        DIAHelpers::integrateWindow(sp_ms2, mz, im, intensity, mz_range, im_range);
+        DIAHelpers::integrateWindow(sp, mz, im, intensity, mz_range, im_range);
 
         // skip empty windows
         if (im <= 0)
@@ -261,71 +339,26 @@ namespace OpenMS
           continue;
         }
 
-#ifdef _OPENMP
-#pragma omp critical
-#endif
-        {
-          // store result drift time
-          data_im.push_back(std::make_pair(im, drift_target));
-          exp_im.push_back(im);
-          theo_im.push_back(drift_target);
-          if (!debug_im_file_.empty())
-          {
-            os_im << tr.precursor_mz << "\t" << im << "\t" << drift_target << "\t" << bestRT << "\t" << intensity << std::endl;
-          }
-        }
-        OPENMS_LOG_DEBUG << tr.precursor_mz << "\t" << im << "\t" << drift_target << "\t" << bestRT << "\t" << intensity << std::endl;
+        // store result drift time
+        points[i].push_back({tr.precursor_mz, im, drift_target, intensity});
+        OPENMS_LOG_DEBUG << tr.precursor_mz << "\t" << im << "\t" << drift_target << "\t" << target.rt << "\t" << intensity << std::endl;
       }
+    });
 
-      // Do MS1 extraction
-      if (!transition_group->getTransitions().empty() && ms1_im_)
+    TransformationDescription::DataPoints data_im;
+    std::vector<double> exp_im;
+    std::vector<double> theo_im;
+    for (Size i = 0; i < targets.size(); ++i)
+    {
+      for (const IMPoint& pt : points[i])
       {
-        const auto& tr = transition_group->getTransitions()[0];
-        double intensity(0), im(0), mz(0);
-        RangeMZ mz_range = DIAHelpers::createMZRangePPM(tr.precursor_mz, mz_extr_window, ppm);
-
-        // get drift time upper/lower offset (this assumes that all chromatograms
-        // are derived from the same precursor with the same drift time)
-        auto pepref = tr.getPeptideRef();
-        double drift_target = pep_im_map[pepref];
-
-        // do not need to check for IM because we are correcting IM
-        RangeMobility im_range(drift_target);
-        im_range.minSpanIfSingular(im_extraction_win);
-
-        // Check that the spectrum really has a drift time array
-        if (sp_ms1->getDriftTimeArray() == nullptr)
-        {
-          OPENMS_LOG_DEBUG << "Did not find a drift time array for peptide " << pepref << " at RT " << bestRT  << std::endl;
-          for (const auto& m : used_maps)
-          {
-            OPENMS_LOG_DEBUG << " -- Used maps " << m.lower << " to " << m.upper << " MS1 : " << m.ms1 << true << std::endl;
-          }
-          continue;
-        }
-
-        DIAHelpers::integrateWindow(sp_ms1, mz, im, intensity, mz_range, im_range);
-
-        // skip empty windows
-        if (im <= 0)
+        data_im.push_back(std::make_pair(pt.im, pt.theo_im));
+        exp_im.push_back(pt.im);
+        theo_im.push_back(pt.theo_im);
+        if (!debug_im_file_.empty())
         {
-          continue;
+          os_im << pt.mz << "\t" << pt.im << "\t" << pt.theo_im << "\t" << targets[i].rt << "\t" << pt.intensity << std::endl;
         }
-
-#ifdef _OPENMP
-#pragma omp critical
-#endif
-        {
-          // store result drift time
-          data_im.push_back(std::make_pair(im, drift_target));
-          exp_im.push_back(im);
-          theo_im.push_back(drift_target);
-          if (!debug_im_file_.empty())
-          {
-            os_im << tr.precursor_mz << "\t" << im << "\t" << drift_target << "\t" << bestRT << "\t" << intensity << std::endl;
-          }
-        }
-        OPENMS_LOG_DEBUG << tr.precursor_mz << "\t" << im << "\t" << drift_target << "\t" << bestRT << "\t" << intensity << std::endl;
       }
     }
 
@@ -389,18 +422,13 @@ namespace OpenMS
       os.precision(writtenDigits(double()));
     }
 
-    TransformationDescription::DataPoints data_all;
-    std::vector<double> weights;
-    std::vector<double> exp_mz;
-    std::vector<double> theo_mz;
-    std::vector<double> delta_ppm;
-
     std::map<std::string, double> pep_im_map;
     for (const auto& cmp : targeted_exp.getCompounds())
     {
       pep_im_map[cmp.id] = cmp.drift_time;
     }
 
+    std::vector<CalibrationTarget> targets;
     for (auto & trgroup_it : transition_group_map)
     {
       // we need at least one feature to find the best one
@@ -442,39 +470,68 @@ namespace OpenMS
 
       // Get the spectrum for this RT and extract raw data points for all the
       // calibrating transitions (fragment m/z values) from the spectrum
-      std::vector<OpenSwath::SpectrumPtr> spArr = OpenSwathScoring().fetchSpectrumSwath(used_maps, bestRT, 1, im_range);
-      OpenSwath::SpectrumPtr sp = (!spArr.empty()) ? spArr[0] : *new(OpenSwath::SpectrumPtr);
-      for (const auto& tr : transition_group->getTransitions())
+      targets.push_back({transition_group, bestRT, im_range, used_maps, drift_target});
+    }
+
+    // extracted points of each target, merged in the order of the targets below
+    struct MZPoint
+    {
+      double mz;
+      double theo_mz;
+      double intensity;
+    };
+    std::vector<std::vector<MZPoint> > points(targets.size());
+    forEachCalibrationSpectrum(targets, [&](Size i, const OpenSwath::SpectrumPtr& sp)
+    {
+      if (sp == nullptr)
+      {
+        return;
+      }
+      for (const auto& tr : targets[i].group->getTransitions())
       {
         double mz, intensity, im;
         RangeMZ mz_range = DIAHelpers::createMZRangePPM(tr.product_mz, mz_extr_window, ppm);
         bool centroided = false;
 
         // integrate spectrum at the position of the theoretical mass
-        DIAHelpers::integrateWindow(sp, mz, im, intensity, mz_range, im_range, centroided); // Correct using the irt_im
+        DIAHelpers::integrateWindow(sp, mz, im, intensity, mz_range, targets[i].im_range, centroided); // Correct using the irt_im
 
         // skip empty windows
         if (mz == -1)
         {
           continue;
         }
+        points[i].push_back({mz, tr.product_mz, intensity});
+      }
+    });
 
+    TransformationDescription::DataPoints data_all;
+    std::vector<double> weights;
+    std::vector<double> exp_mz;
+    std::vector<double> theo_mz;
+    std::vector<double> delta_ppm;
+    for (Size i = 0; i < targets.size(); ++i)
+    {
+      for (const MZPoint& pt : points[i])
+      {
+        double mz = pt.mz;
+        double intensity = pt.intensity;
         // store result masses
-        data_all.push_back(std::make_pair(mz, tr.product_mz));
+        data_all.push_back(std::make_pair(mz, pt.theo_mz));
         // regression weight is the log2 intensity
         weights.push_back( log(intensity) / log(2.0) );
         exp_mz.push_back( mz );
         // y = target = theoretical
-        theo_mz.push_back( tr.product_mz );
-        double diff_ppm = (mz - tr.product_mz) * 1000000 / mz;
+        theo_mz.push_back( pt.theo_mz );
+        double diff_ppm = (mz - pt.theo_mz) * 1000000 / mz;
         // y = target = delta-ppm
         delta_ppm.push_back(diff_ppm);
 
         if (!debug_mz_file_.empty())
         {
-          os << mz << "\t" << tr.product_mz << "\t" << drift_target << "\t" << diff_ppm << "\t" << log(intensity) / log(2.0) << "\t" << bestRT << std::endl;
+          os << mz << "\t" << pt.theo_mz << "\t" << targets[i].drift_target << "\t" << diff_ppm << "\t" << log(intensity) / log(2.0) << "\t" << targets[i].rt << std::endl;
         }
-        OPENMS_LOG_DEBUG << mz << "\t" << tr.product_mz << "\t" << diff_ppm << "\t" << log(intensity) / log(2.0) << "\t" << bestRT << std::endl;
+        OPENMS_LOG_DEBUG << mz << "\t" << pt.theo_mz << "\t" << diff_ppm << "\t" << log(intensity) / log(2.0) << "\t" << targets[i].rt << std::endl;
       }
     }
 
@@ -20,9 +20,56 @@
 #include <OpenMS/KERNEL/RangeUtils.h>
 #include <OpenMS/ANALYSIS/ID/AccurateMassSearchEngine.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionTSVFile.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// a target (transition or feature) of annotateSpectra(), see indexByRT()
+    struct RTTarget
+    {
+      double rt;
+      Size index; ///< index of the target in the input
+    };
+
+    /// the @p n targets (RT given by @p rt_of(index)) sorted by RT; targets without a valid RT cannot match any window and are left out
+    template <typename RTOf>
+    std::vector<RTTarget> indexByRT(Size n, const RTOf& rt_of)
+    {
+      std::vector<RTTarget> targets;
+      targets.reserve(n);
+      for (Size i = 0; i < n; ++i)
+      {
+        const double rt = rt_of(i);
+        if (!std::isnan(rt))
+        {
+          targets.push_back({rt, i});
+        }
+      }
+      std::sort(targets.begin(), targets.end(), [](const RTTarget& a, const RTTarget& b) { return a.rt < b.rt; });
+      return targets;
+    }
+
+    /// input indices of the targets with rt_left_lim <= RT <= rt_right_lim, in input order
+    std::vector<Size> targetsInRTWindow(const std::vector<RTTarget>& targets, double rt_left_lim, double rt_right_lim)
+    {
+      auto first = std::lower_bound(targets.begin(), targets.end(), rt_left_lim, [](const RTTarget& t, double rt) { return t.rt < rt; });
+      auto last = std::upper_bound(first, targets.end(), rt_right_lim, [](double rt, const RTTarget& t) { return rt < t.rt; });
+      std::vector<Size> indices;
+      for (; first < last; ++first)
+      {
+        indices.push_back(first->index);
+      }
+      std::sort(indices.begin(), indices.end());
+      return indices;
+    }
+  }
+
   TargetedSpectraExtractor::TargetedSpectraExtractor() :
     DefaultParamHandler("TargetedSpectraExtractor")
   {
@@ -179,83 +226,100 @@ namespace OpenMS
       std::vector<MSSpectrum>& annotated_spectra) const
   {
     annotated_spectra.clear();
-    for (const auto& spectrum : spectra)
+
+    // the annotated features (subordinates, if present), indexed by RT
+    std::vector<const Feature*> targets;
+    for (const auto& feature : ms1_features)
+    {
+      if (!feature.getSubordinates().empty())
+      {
+        // iterate through the subordinate level
+        for (const auto& subordinate : feature.getSubordinates())
+        {
+          targets.push_back(&subordinate);
+        }
+      }
+      else
+      {
+        targets.push_back(&feature);
+      }
+    }
+    // check for null annotations resulting from unnanotated features
+    targets.erase(std::remove_if(targets.begin(), targets.end(),
+      [](const Feature* f) { return f->getMetaValue("PeptideRef") == "null"; }), targets.end());
+    const std::vector<RTTarget> rt_index = indexByRT(targets.size(), [&targets](Size i) { return targets[i]->getRT(); });
+
+    // Lambda to check the mz/rt thresholds
+    auto checkRtAndMzTol = [](const double& spectrum_mz, const double& spectrum_rt,
+      const double& target_mz, const double& target_rt, const double& mz_window, const double& rt_window)
     {
+      const double rt_left_lim = spectrum_rt - rt_window / 2.0;
+      const double rt_right_lim = spectrum_rt + rt_window / 2.0;
+      const double mz_left_lim = spectrum_mz - mz_window / 2.0;
+      const double mz_right_lim = spectrum_mz + mz_window / 2.0;
+      if (spectrum_mz != 0.0)
+      {
+        return target_rt >= rt_left_lim && target_rt <= rt_right_lim && target_mz >= mz_left_lim && target_mz <= mz_right_lim;
+      }
+      else
+      {
+        return target_rt >= rt_left_lim && target_rt <= rt_right_lim;
+      }
+    };
+
+    // the annotations of each spectrum (in the order of the targets), found in parallel
+    std::vector<std::vector<MSSpectrum>> spectrum_annotations(spectra.size());
+    std::vector<std::vector<Feature>> spectrum_features(spectra.size());
+    TaskScheduler::parallelFor(0, spectra.size(), [&](SignedSize s)
+    {
+      const MSSpectrum& spectrum = spectra[s];
       if (spectrum.getMSLevel() == 1)
       {
-        continue; // we want to annotate MS2 spectra only
+        return; // we want to annotate MS2 spectra only
       }
 
       const double spectrum_rt = spectrum.getRT();
       const std::vector<Precursor>& precursors = spectrum.getPrecursors();
-      if (precursors.empty())
-      {
-        OPENMS_LOG_WARN << "annotateSpectra(): No precursor MZ found. Setting spectrum_mz to 0." << std::endl;
-      }
       const double spectrum_mz = precursors.empty() ? 0.0 : precursors.front().getMZ();
 
-      // Lambda to check the mz/rt thresholds
-      auto checkRtAndMzTol = [](const double& spectrum_mz, const double& spectrum_rt, 
-        const double& target_mz, const double& target_rt, const double& mz_window, const double& rt_window) 
+      for (Size t : targetsInRTWindow(rt_index, spectrum_rt - rt_window_ / 2.0, spectrum_rt + rt_window_ / 2.0))
       {
-        const double rt_left_lim = spectrum_rt - rt_window / 2.0;
-        const double rt_right_lim = spectrum_rt + rt_window / 2.0;
-        const double mz_left_lim = spectrum_mz - mz_window / 2.0;
-        const double mz_right_lim = spectrum_mz + mz_window / 2.0;
-        if (spectrum_mz != 0.0)
-        {
-          return target_rt >= rt_left_lim && target_rt <= rt_right_lim && target_mz >= mz_left_lim && target_mz <= mz_right_lim;
-        }
-        else
+        const Feature& feature = *targets[t];
+        const double target_mz = feature.getMZ();
+        const double target_rt = feature.getRT();
+        if (!checkRtAndMzTol(spectrum_mz, spectrum_rt, target_mz, target_rt, mz_tolerance_, rt_window_))
         {
-          return target_rt >= rt_left_lim && target_rt <= rt_right_lim;
+          continue;
         }
-      };
-
-      // Lambda to create the feature
-      auto construct_feature = [checkRtAndMzTol, spectrum_rt, spectrum_mz, &ms2_features, &annotated_spectra, &spectrum](
-        const OpenMS::Feature& feature, const double& mz_tol, const double& rt_win) {
         const auto& peptide_ref_s = feature.getMetaValue("PeptideRef");
         const auto& native_id_s = feature.getMetaValue("native_id");
-        // check for null annotations resulting from unnanotated features
-        if (peptide_ref_s != "null")
-        {
-          const double target_mz = feature.getMZ();
-          const double target_rt = feature.getRT();
-          if (checkRtAndMzTol(spectrum_mz, spectrum_rt, target_mz, target_rt, mz_tol, rt_win))
-          {
-            OPENMS_LOG_DEBUG << "annotateSpectra(): " << peptide_ref_s << "]";
-            OPENMS_LOG_DEBUG << " (target_rt: " << target_rt << ") (target_mz: " << target_mz << ")" << std::endl;
-            MSSpectrum annotated_spectrum = spectrum;
-            annotated_spectrum.setName(peptide_ref_s);
-            annotated_spectra.push_back(std::move(annotated_spectrum));
-            // fill the ms2 features map
-            Feature ms2_feature;
-            ms2_feature.setUniqueId();
-            ms2_feature.setRT(spectrum_rt);
-            ms2_feature.setMZ(spectrum_mz);
-            ms2_feature.setIntensity(feature.getIntensity());
-            ms2_feature.setMetaValue("native_id", native_id_s);
-            ms2_feature.setMetaValue("PeptideRef", peptide_ref_s);
-            ms2_features.push_back(std::move(ms2_feature));
-          }
-        }
-      };
+        OPENMS_LOG_DEBUG << "annotateSpectra(): " << peptide_ref_s << "]";
+        OPENMS_LOG_DEBUG << " (target_rt: " << target_rt << ") (target_mz: " << target_mz << ")" << std::endl;
+        MSSpectrum annotated_spectrum = spectrum;
+        annotated_spectrum.setName(peptide_ref_s);
+        spectrum_annotations[s].push_back(std::move(annotated_spectrum));
+        // fill the ms2 features map
+        Feature ms2_feature;
+        ms2_feature.setRT(spectrum_rt);
+        ms2_feature.setMZ(spectrum_mz);
+        ms2_feature.setIntensity(feature.getIntensity());
+        ms2_feature.setMetaValue("native_id", native_id_s);
+        ms2_feature.setMetaValue("PeptideRef", peptide_ref_s);
+        spectrum_features[s].push_back(std::move(ms2_feature));
+      }
+    });
 
-      for (const auto& feature : ms1_features)
+    for (Size s = 0; s < spectra.size(); ++s)
+    {
+      if (spectra[s].getMSLevel() != 1 && spectra[s].getPrecursors().empty())
       {
-        if (!feature.getSubordinates().empty())
-        {
-          // iterate through the subordinate level
-          for (const auto& subordinate : feature.getSubordinates())
-          {
-            construct_feature(subordinate, mz_tolerance_, rt_window_);
-          }
-        }
-        else
-        {
-          construct_feature(feature, mz_tolerance_, rt_window_);
-        }
+        OPENMS_LOG_WARN << "annotateSpectra(): No precursor MZ found. Setting spectrum_mz to 0." << std::endl;
+      }
+      for (Size a = 0; a < spectrum_annotations[s].size(); ++a)
+      {
+        annotated_spectra.push_back(std::move(spectrum_annotations[s][a]));
+        spectrum_features[s][a].setUniqueId(); // the unique ID generator is not thread-safe
+        ms2_features.push_back(std::move(spectrum_features[s][a]));
       }
     }
   }
@@ -353,19 +417,38 @@ namespace OpenMS
     annotated_spectra.clear();
     features.clear(true);
     const std::vector<ReactionMonitoringTransition>& transitions = targeted_exp.getTransitions();
-    for (Size i = 0; i < spectra.size(); ++i)
+
+    // the target RT of each transition, indexed by RT
+    // (looked up serially, since the peptide reference map of `targeted_exp` is built lazily)
+    std::vector<double> target_rts;
+    if (!spectra.empty())
+    {
+      target_rts.reserve(transitions.size());
+      for (const ReactionMonitoringTransition& transition : transitions)
+      {
+        const TargetedExperimentHelper::Peptide& peptide = targeted_exp.getPeptideByRef(transition.getPeptideRef());
+        double target_rt = peptide.getRetentionTime();
+        if (peptide.getRetentionTimeUnit() == TargetedExperimentHelper::RetentionTime::RTUnit::MINUTE)
+        {
+          target_rt *= 60.0;
+        }
+        target_rts.push_back(target_rt);
+      }
+    }
+    const std::vector<RTTarget> rt_index = indexByRT(target_rts.size(), [&target_rts](Size j) { return target_rts[j]; });
+    const double mz_tolerance = mz_unit_is_Da_ ? mz_tolerance_ : mz_tolerance_ / 1e6;
+
+    // the annotations of each spectrum (in the order of the transitions), found in parallel
+    std::vector<std::vector<MSSpectrum>> spectrum_annotations(spectra.size());
+    std::vector<std::vector<Feature>> spectrum_features(spectra.size());
+    TaskScheduler::parallelFor(0, spectra.size(), [&](SignedSize i)
     {
       const MSSpectrum& spectrum = spectra[i];
       const double spectrum_rt = spectrum.getRT();
       const double rt_left_lim = spectrum_rt - rt_window_ / 2.0;
       const double rt_right_lim = spectrum_rt + rt_window_ / 2.0;
       const std::vector<Precursor>& precursors = spectrum.getPrecursors();
-      if (precursors.empty())
-      {
-        OPENMS_LOG_WARN << "annotateSpectra(): No precursor MZ found. Setting spectrum_mz to 0." << std::endl;
-      }
       const double spectrum_mz = precursors.empty() ? 0.0 : precursors.front().getMZ();
-      const double mz_tolerance = mz_unit_is_Da_ ? mz_tolerance_ : mz_tolerance_ / 1e6;
 
       // When spectrum_mz is 0, the mz check on transitions is inhibited
       const double mz_left_lim = spectrum_mz ? spectrum_mz - mz_tolerance : std::numeric_limits<double>::min();
@@ -373,33 +456,39 @@ namespace OpenMS
 
       OPENMS_LOG_DEBUG << "annotateSpectra(): [" << i << "] (RT: " << spectrum_rt << ") (MZ: " << spectrum_mz << ")" << std::endl;
 
-      for (Size j = 0; j < transitions.size(); ++j)
+      for (Size j : targetsInRTWindow(rt_index, rt_left_lim, rt_right_lim))
       {
-        const TargetedExperimentHelper::Peptide& peptide = targeted_exp.getPeptideByRef(transitions[j].getPeptideRef());
-        double target_rt = peptide.getRetentionTime();
-        if (peptide.getRetentionTimeUnit() == TargetedExperimentHelper::RetentionTime::RTUnit::MINUTE)
-        {
-          target_rt *= 60.0;
-        }
         const double target_mz = transitions[j].getPrecursorMZ();
-        if (target_rt >= rt_left_lim && target_rt <= rt_right_lim &&
-            target_mz >= mz_left_lim && target_mz <= mz_right_lim)
+        if (target_mz >= mz_left_lim && target_mz <= mz_right_lim)
         {
           OPENMS_LOG_DEBUG << "annotateSpectra(): [" << j << "][" << transitions[j].getPeptideRef() << "]";
-          OPENMS_LOG_DEBUG << " (target_rt: " << target_rt << ") (target_mz: " << target_mz << ")" << std::endl << std::endl;
+          OPENMS_LOG_DEBUG << " (target_rt: " << target_rts[j] << ") (target_mz: " << target_mz << ")" << std::endl << std::endl;
           MSSpectrum annotated_spectrum = spectrum;
           annotated_spectrum.setName(transitions[j].getPeptideRef());
-          annotated_spectra.push_back(annotated_spectrum);
+          spectrum_annotations[i].push_back(std::move(annotated_spectrum));
           if (compute_features)
           {
             Feature feature;
             feature.setRT(spectrum_rt);
             feature.setMZ(spectrum_mz);
             feature.setMetaValue("transition_name", transitions[j].getPeptideRef());
-            features.push_back(feature);
+            spectrum_features[i].push_back(std::move(feature));
           }
         }
       }
+    });
+
+    for (Size i = 0; i < spectra.size(); ++i)
+    {
+      if (spectra[i].getPrecursors().empty())
+      {
+        OPENMS_LOG_WARN << "annotateSpectra(): No precursor MZ found. Setting spectrum_mz to 0." << std::endl;
+      }
+      std::move(spectrum_annotations[i].begin(), spectrum_annotations[i].end(), std::back_inserter(annotated_spectra));
+      for (Feature& feature : spectrum_features[i])
+      {
+        features.push_back(std::move(feature));
+      }
     }
     OPENMS_LOG_DEBUG << "annotateSpectra(): (input size: " << spectra.size() << ") (annotated spectra: " << annotated_spectra.size() << ")\n" << std::endl;
   }
@@ -498,7 +587,7 @@ namespace OpenMS
     {
       throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
     }
-    for (Size i = 0; i < annotated_spectra.size(); ++i)
+    TaskScheduler::parallelFor(0, annotated_spectra.size(), [&](SignedSize i)
     {
       double total_tic { 0 };
       for (Size j = 0; j < annotated_spectra[i].size(); ++j)
@@ -562,7 +651,7 @@ namespace OpenMS
         }
         features[i].setSubordinates(subordinates);
       }
-    }
+    });
   }
 
   void TargetedSpectraExtractor::scoreSpectra(
@@ -648,10 +737,7 @@ namespace OpenMS
 
     // pick peaks from annotate spectra
     std::vector<MSSpectrum> picked(annotated.size());
-    for (Size i = 0; i < annotated.size(); ++i)
-    {
-      pickSpectrum(annotated[i], picked[i]);
-    }
+    TaskScheduler::parallelFor(0, annotated.size(), [&](SignedSize i) { pickSpectrum(annotated[i], picked[i]); });
 
     // remove empty picked<> spectra, and accordingly update annotated<> and features
     for (Int i = annotated.size() - 1; i >= 0; --i)
@@ -718,10 +804,7 @@ namespace OpenMS
 
     // pickSpectra
     std::vector<MSSpectrum> picked_spectra(annotated_spectra.size());
-    for (Size i = 0; i < annotated_spectra.size(); ++i)
-    {
-      pickSpectrum(annotated_spectra[i], picked_spectra[i]);
-    }
+    TaskScheduler::parallelFor(0, annotated_spectra.size(), [&](SignedSize i) { pickSpectrum(annotated_spectra[i], picked_spectra[i]); });
 
     // score and select
     std::vector<OpenMS::MSSpectrum> scored_spectra;
@@ -776,11 +859,11 @@ namespace OpenMS
       throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
     }
 
-    std::vector<Size> no_matches_idx; // to keep track of those features without a match
+    std::vector<char> has_match(spectra.size(), true);
     const Size tmp = top_matches_to_report_;
     top_matches_to_report_ = 1;
 
-    for (Size i = 0; i < spectra.size(); ++i)
+    TaskScheduler::parallelFor(0, spectra.size(), [&](SignedSize i)
     {
       std::vector<Match> matches;
       matchSpectrum(spectra[i], cmp, matches);
@@ -794,15 +877,21 @@ namespace OpenMS
       }
       else
       {
-        no_matches_idx.push_back(i);
+        has_match[i] = false;
         features[i].setMetaValue("spectral_library_name", "");
         features[i].setMetaValue("spectral_library_score", 0.0);
         features[i].setMetaValue("spectral_library_comments", "");
       }
-    }
+    });
 
     top_matches_to_report_ = tmp;
 
+    std::vector<Size> no_matches_idx; // to keep track of those features without a match
+    for (Size i = 0; i < spectra.size(); ++i)
+    {
+      if (!has_match[i]) no_matches_idx.push_back(i);
+    }
+
     if (!no_matches_idx.empty())
     {
       String warn_msg = "No match was found for " + std::to_string(no_matches_idx.size()) + " `Feature`s. Indices: ";
@@ -823,10 +912,7 @@ namespace OpenMS
     features.clear(true);
 
     std::vector<MSSpectrum> picked(spectra.size());
-    for (Size i = 0; i < spectra.size(); ++i)
-    {
-      pickSpectrum(spectra[i], picked[i]);
-    }
+    TaskScheduler::parallelFor(0, spectra.size(), [&](SignedSize i) { pickSpectrum(spectra[i], picked[i]); });
 
     // remove empty picked<> spectra
     for (Int i = spectra.size() - 1; i >= 0; --i)
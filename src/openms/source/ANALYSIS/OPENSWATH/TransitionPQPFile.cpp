@@ -9,11 +9,20 @@
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionPQPFile.h>
 
 #include <sqlite3.h>
+#include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/FORMAT/SqliteConnector.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFileInfo>
 
 #include <boost/range/algorithm.hpp>
 #include <boost/range/algorithm_ext/erase.hpp>
 
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
 #include <sstream>
 #include <unordered_map>
 #include <iostream>
@@ -23,6 +32,123 @@ namespace OpenMS
 
   namespace Sql = Internal::SqliteHelper;
 
+  namespace
+  {
+    using UInt8 = std::uint8_t;
+
+    /*
+      Snapshot file layout (all numbers in the byte order of the writing machine):
+
+      header:      magic[8] | UInt32 version | UInt32 byte order mark |
+                   UInt64 PQP file size | Int64 PQP modification time | string reader options
+      strings:     UInt64 n_strings | n_strings x string
+      proteins:    UInt64 n_proteins | n_proteins x (UInt32 id, UInt32 sequence)
+      compounds:   UInt64 n_compounds | n_compounds x compound record
+      transitions: UInt64 n_transitions | n_transitions x fixed size transition record
+
+      Apart from the reader options, strings are written as UInt32 length followed by the characters.
+      All strings in the records are stored as UInt32 ids into the string table.
+    */
+    const char SNAPSHOT_MAGIC[8] = {'O', 'S', 'W', 'L', 'I', 'G', 'H', 'T'};
+    const UInt32 SNAPSHOT_VERSION = 1;
+    const UInt32 BYTE_ORDER_MARK = 0x01020304;
+    const Size TRANSITION_RECORD_SIZE = 2 * sizeof(UInt32) + 4 * sizeof(double) + sizeof(Int32) + sizeof(UInt8);
+
+    /// Modification time of @p filename in ms since epoch
+    qint64 modificationTime(const String& filename)
+    {
+      return QFileInfo(filename.toQString()).lastModified().toMSecsSinceEpoch();
+    }
+
+    /// Serializes a LightTargetedExperiment into a memory buffer and interns all strings
+    class SnapshotWriter
+    {
+    public:
+      std::string buffer;
+      std::vector<const std::string*> strings;
+
+      template <typename T>
+      void put(T value)
+      {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+      }
+
+      void putRawString(const std::string& s)
+      {
+        put<UInt32>(UInt32(s.size()));
+        buffer.append(s);
+      }
+
+      void putString(const std::string& s)
+      {
+        auto it = ids_.find(s);
+        if (it == ids_.end())
+        {
+          it = ids_.emplace(s, UInt32(strings.size())).first;
+          strings.push_back(&it->first); // node based map: the pointer stays valid
+        }
+        put<UInt32>(it->second);
+      }
+
+    private:
+      std::unordered_map<std::string, UInt32> ids_;
+    };
+
+    /// Reads values from a snapshot buffer
+    struct SnapshotCursor
+    {
+      const char* data;
+      Size size;
+      Size pos;
+      const std::vector<std::string>* strings;
+
+      void require(Size n) const
+      {
+        if (pos > size || n > size - pos)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "", "Unexpected end of snapshot at offset " + String(pos));
+        }
+      }
+
+      void requireRecords(UInt64 n, Size record_size) const
+      {
+        if (pos > size || n > (size - pos) / record_size)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "", "Unexpected end of snapshot at offset " + String(pos));
+        }
+      }
+
+      template <typename T>
+      T get()
+      {
+        require(sizeof(T));
+        T value;
+        memcpy(&value, data + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+      }
+
+      std::string getRawString()
+      {
+        const UInt32 length = get<UInt32>();
+        require(length);
+        std::string s(data + pos, length);
+        pos += length;
+        return s;
+      }
+
+      const std::string& getString()
+      {
+        const UInt32 id = get<UInt32>();
+        if (id >= strings->size())
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "", "Invalid string id " + String(id));
+        }
+        return (*strings)[id];
+      }
+    };
+  }
+
   TransitionPQPFile::TransitionPQPFile() :
     TransitionTSVFile()
   {
@@ -187,6 +313,7 @@ namespace OpenMS
 
     Size progress = 0;
     startProgress(0, num_transitions, "reading PQP file");
+    transition_list.reserve(transition_list.size() + num_transitions);
     // Convert SQLite data to TSVTransition data structure
     while (sqlite3_column_type(stmt, 0) != SQLITE_NULL)
     {
@@ -229,7 +356,7 @@ namespace OpenMS
 
       if (mytransition.GeneName == "NA") mytransition.GeneName = "";
 
-      transition_list.push_back(mytransition);
+      transition_list.push_back(std::move(mytransition));
       sqlite3_step( stmt );
     }
     endProgress();
@@ -698,4 +825,248 @@ namespace OpenMS
     TSVToTargetedExperiment_(transition_list, targeted_exp);
   }
 
+  void TransitionPQPFile::convertPQPToTargetedExperimentCached(const char* filename,
+                                                               OpenSwath::LightTargetedExperiment& targeted_exp,
+                                                               bool legacy_traml_id,
+                                                               bool write_snapshot)
+  {
+    const String snapshot_file = getSnapshotName(filename);
+    if (loadSnapshot(snapshot_file, filename, targeted_exp, legacy_traml_id))
+    {
+      return;
+    }
+    convertPQPToTargetedExperiment(filename, targeted_exp, legacy_traml_id);
+    if (!write_snapshot)
+    {
+      return;
+    }
+    try
+    {
+      storeSnapshot(snapshot_file, filename, targeted_exp, legacy_traml_id);
+    }
+    catch (Exception::UnableToCreateFile&)
+    {
+      OPENMS_LOG_DEBUG << "Could not write snapshot file '" << snapshot_file << "'." << std::endl;
+    }
+  }
+
+  void TransitionPQPFile::storeSnapshot(const String& snapshot_file, const String& pqp_file,
+                                        const OpenSwath::LightTargetedExperiment& targeted_exp, bool legacy_traml_id) const
+  {
+    SnapshotWriter w;
+    w.buffer.reserve(64 * targeted_exp.transitions.size());
+    w.put<UInt64>(targeted_exp.proteins.size());
+    for (const OpenSwath::LightProtein& protein : targeted_exp.proteins)
+    {
+      w.putString(protein.id);
+      w.putString(protein.sequence);
+    }
+    w.put<UInt64>(targeted_exp.compounds.size());
+    for (const OpenSwath::LightCompound& compound : targeted_exp.compounds)
+    {
+      w.putString(compound.id);
+      w.putString(compound.sequence);
+      w.putString(compound.peptide_group_label);
+      w.putString(compound.gene_name);
+      w.putString(compound.sum_formula);
+      w.putString(compound.compound_name);
+      w.put<double>(compound.drift_time);
+      w.put<double>(compound.rt);
+      w.put<Int32>(compound.charge);
+      w.put<UInt32>(UInt32(compound.protein_refs.size()));
+      for (const std::string& ref : compound.protein_refs)
+      {
+        w.putString(ref);
+      }
+      w.put<UInt32>(UInt32(compound.modifications.size()));
+      for (const OpenSwath::LightModification& mod : compound.modifications)
+      {
+        w.put<Int32>(mod.location);
+        w.put<Int32>(mod.unimod_id);
+      }
+    }
+    w.put<UInt64>(targeted_exp.transitions.size());
+    for (const OpenSwath::LightTransition& tr : targeted_exp.transitions)
+    {
+      w.putString(tr.transition_name);
+      w.putString(tr.peptide_ref);
+      w.put<double>(tr.library_intensity);
+      w.put<double>(tr.product_mz);
+      w.put<double>(tr.precursor_mz);
+      w.put<double>(tr.precursor_im);
+      w.put<Int32>(tr.fragment_charge);
+      w.put<UInt8>(UInt8(tr.decoy) | UInt8(tr.detecting_transition) << 1 |
+                   UInt8(tr.quantifying_transition) << 2 | UInt8(tr.identifying_transition) << 3);
+    }
+
+    SnapshotWriter header;
+    header.buffer.append(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.put<UInt32>(SNAPSHOT_VERSION);
+    header.put<UInt32>(BYTE_ORDER_MARK);
+    header.put<UInt64>(File::fileSize(pqp_file));
+    header.put<Int64>(modificationTime(pqp_file));
+    header.putRawString(getSnapshotOptions_(legacy_traml_id));
+    header.put<UInt64>(w.strings.size());
+    for (const std::string* str : w.strings)
+    {
+      header.putRawString(*str);
+    }
+
+    std::ofstream os(snapshot_file.c_str(), std::ios::binary);
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, snapshot_file);
+    }
+    os.write(header.buffer.data(), header.buffer.size());
+    os.write(w.buffer.data(), w.buffer.size());
+    os.close();
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, snapshot_file);
+    }
+  }
+
+  bool TransitionPQPFile::loadSnapshot(const String& snapshot_file, const String& pqp_file,
+                                       OpenSwath::LightTargetedExperiment& targeted_exp, bool legacy_traml_id) const
+  {
+    targeted_exp = OpenSwath::LightTargetedExperiment();
+    std::ifstream is(snapshot_file.c_str(), std::ios::binary);
+    if (!is || !File::exists(pqp_file))
+    {
+      return false;
+    }
+    const std::string buffer((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+    std::vector<std::string> strings;
+    SnapshotCursor c{buffer.data(), buffer.size(), 0, &strings};
+    try
+    {
+      c.require(sizeof(SNAPSHOT_MAGIC));
+      if (memcmp(buffer.data(), SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0)
+      {
+        return false;
+      }
+      c.pos += sizeof(SNAPSHOT_MAGIC);
+      if (c.get<UInt32>() != SNAPSHOT_VERSION || c.get<UInt32>() != BYTE_ORDER_MARK)
+      {
+        return false;
+      }
+      if (c.get<UInt64>() != File::fileSize(pqp_file) ||
+          c.get<Int64>() != modificationTime(pqp_file) ||
+          c.getRawString() != getSnapshotOptions_(legacy_traml_id))
+      {
+        return false; // outdated or written with different settings
+      }
+
+      const UInt64 n_strings = c.get<UInt64>();
+      c.requireRecords(n_strings, sizeof(UInt32));
+      strings.reserve(n_strings);
+      for (UInt64 i = 0; i < n_strings; ++i)
+      {
+        strings.push_back(c.getRawString());
+      }
+
+      const UInt64 n_proteins = c.get<UInt64>();
+      c.requireRecords(n_proteins, 2 * sizeof(UInt32));
+      targeted_exp.proteins.resize(n_proteins);
+      for (OpenSwath::LightProtein& protein : targeted_exp.proteins)
+      {
+        protein.id = c.getString();
+        protein.sequence = c.getString();
+      }
+
+      const UInt64 n_compounds = c.get<UInt64>();
+      c.requireRecords(n_compounds, 1);
+      targeted_exp.compounds.resize(n_compounds);
+      for (OpenSwath::LightCompound& compound : targeted_exp.compounds)
+      {
+        compound.id = c.getString();
+        compound.sequence = c.getString();
+        compound.peptide_group_label = c.getString();
+        compound.gene_name = c.getString();
+        compound.sum_formula = c.getString();
+        compound.compound_name = c.getString();
+        compound.drift_time = c.get<double>();
+        compound.rt = c.get<double>();
+        compound.charge = c.get<Int32>();
+        const UInt32 n_refs = c.get<UInt32>();
+        c.requireRecords(n_refs, sizeof(UInt32));
+        compound.protein_refs.reserve(n_refs);
+        for (UInt32 i = 0; i < n_refs; ++i)
+        {
+          compound.protein_refs.push_back(c.getString());
+        }
+        const UInt32 n_mods = c.get<UInt32>();
+        c.requireRecords(n_mods, 2 * sizeof(Int32));
+        compound.modifications.resize(n_mods);
+        for (OpenSwath::LightModification& mod : compound.modifications)
+        {
+          mod.location = c.get<Int32>();
+          mod.unimod_id = c.get<Int32>();
+        }
+      }
+
+      // transition records have a fixed size: decode them in parallel
+      const UInt64 n_transitions = c.get<UInt64>();
+      c.requireRecords(n_transitions, TRANSITION_RECORD_SIZE);
+      targeted_exp.transitions.resize(n_transitions);
+      const Size first_transition = c.pos;
+      std::exception_ptr decoding_error;
+      #pragma omp parallel for schedule(dynamic, 10000)
+      for (SignedSize i = 0; i < SignedSize(n_transitions); ++i)
+      {
+        try
+        {
+          SnapshotCursor tc{c.data, c.size, first_transition + i * TRANSITION_RECORD_SIZE, &strings};
+          OpenSwath::LightTransition& tr = targeted_exp.transitions[i];
+          tr.transition_name = tc.getString();
+          tr.peptide_ref = tc.getString();
+          tr.library_intensity = tc.get<double>();
+          tr.product_mz = tc.get<double>();
+          tr.precursor_mz = tc.get<double>();
+          tr.precursor_im = tc.get<double>();
+          tr.fragment_charge = tc.get<Int32>();
+          const UInt8 flags = tc.get<UInt8>();
+          tr.decoy = flags & 1;
+          tr.detecting_transition = flags & 2;
+          tr.quantifying_transition = flags & 4;
+          tr.identifying_transition = flags & 8;
+        }
+        catch (...)
+        {
+          #pragma omp critical(TransitionPQPFile_loadSnapshot)
+          if (!decoding_error)
+          {
+            decoding_error = std::current_exception();
+          }
+        }
+      }
+      if (decoding_error)
+      {
+        std::rethrow_exception(decoding_error);
+      }
+    }
+    catch (Exception::ParseError&)
+    {
+      // truncated or corrupt: not a valid snapshot
+      targeted_exp = OpenSwath::LightTargetedExperiment();
+      return false;
+    }
+    return true;
+  }
+
+  String TransitionPQPFile::getSnapshotName(const String& pqp_file)
+  {
+    return pqp_file + ".snapshot";
+  }
+
+  String TransitionPQPFile::getSnapshotOptions_(bool legacy_traml_id) const
+  {
+    String options = "legacy_traml_id=" + String(legacy_traml_id ? "true" : "false");
+    for (auto it = param_.begin(); it != param_.end(); ++it)
+    {
+      options += ";" + it.getName() + "=" + it->value.toString();
+    }
+    return options;
+  }
+
 }
@@ -14,6 +14,8 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/FORMAT/TextFile.h>
 
+#include <exception>
+#include <unordered_set>
 #include <utility>
 
 namespace OpenMS
@@ -648,13 +650,16 @@ namespace OpenMS
 
   void TransitionTSVFile::TSVToTargetedExperiment_(std::vector<TSVTransition>& transition_list, OpenSwath::LightTargetedExperiment& exp)
   {
-    std::map<String, int> compound_map;
-    std::map<String, int> protein_map;
+    std::unordered_set<std::string> compound_ids;
+    std::unordered_set<std::string> protein_ids;
+    // first transition of each compound (in order of appearance), converted in parallel below
+    std::vector<std::vector<TSVTransition>::const_iterator> compound_transitions;
 
     resolveMixedSequenceGroups_(transition_list);
 
     Size progress = 0;
     startProgress(0, transition_list.size(), "conversion to internal data representation");
+    exp.transitions.reserve(exp.transitions.size() + transition_list.size());
     for (auto tr_it = transition_list.cbegin(); tr_it != transition_list.cend(); ++tr_it)
     {
       OpenSwath::LightTransition transition;
@@ -675,12 +680,44 @@ namespace OpenMS
       transition.identifying_transition = tr_it->identifying_transition;
       transition.quantifying_transition = tr_it->quantifying_transition;
 
-      exp.transitions.push_back(transition);
+      exp.transitions.push_back(std::move(transition));
 
       // check whether we need a new compound
-      if (compound_map.find(tr_it->group_id) == compound_map.end())
+      if (compound_ids.insert(tr_it->group_id).second)
       {
-        OpenSwath::LightCompound compound;
+        compound_transitions.push_back(tr_it);
+      }
+
+      // check whether we need new proteins
+      if (tr_it->isPeptide())
+      {
+        for (const String& protein_name : tr_it->ProteinName)
+        {
+          if (protein_ids.insert(protein_name).second)
+          {
+            OpenSwath::LightProtein protein;
+            protein.id = protein_name;
+            protein.sequence = "";
+            exp.proteins.push_back(std::move(protein));
+          }
+        }
+      }
+
+      setProgress(progress++);
+    }
+    endProgress();
+
+    // parsing the (modified) peptide sequences is the expensive part: do it in parallel
+    const Size first_compound = exp.compounds.size();
+    exp.compounds.resize(first_compound + compound_transitions.size());
+    std::exception_ptr conversion_error;
+    #pragma omp parallel for schedule(dynamic, 100)
+    for (SignedSize i = 0; i < SignedSize(compound_transitions.size()); ++i)
+    {
+      try
+      {
+        const auto& tr_it = compound_transitions[i];
+        OpenSwath::LightCompound& compound = exp.compounds[first_compound + i];
         if (tr_it->isPeptide())
         {
           OpenMS::TargetedExperiment::Peptide tramlpeptide;
@@ -693,26 +730,20 @@ namespace OpenMS
           createCompound_(tr_it, tramlcompound);
           OpenSwathDataAccessHelper::convertTargetedCompound(tramlcompound, compound);
         }
-        exp.compounds.push_back(compound);
-        compound_map[compound.id] = 0;
       }
-
-      // check whether we need new proteins
-      for (Size i = 0; i < tr_it->ProteinName.size(); ++i)
+      catch (...)
       {
-        if (tr_it->isPeptide() && protein_map.find(tr_it->ProteinName[i]) == protein_map.end())
+        #pragma omp critical(TransitionTSVFile_convertCompounds)
+        if (!conversion_error)
         {
-          OpenSwath::LightProtein protein;
-          protein.id = tr_it->ProteinName[i];
-          protein.sequence = "";
-          exp.proteins.push_back(protein);
-          protein_map[tr_it->ProteinName[i]] = 0;
+          conversion_error = std::current_exception();
         }
       }
-
-      setProgress(progress++);
     }
-    endProgress();
+    if (conversion_error)
+    {
+      std::rethrow_exception(conversion_error);
+    }
 
     OPENMS_POSTCONDITION(exp.transitions.size() == transition_list.size(), "Input and output list need to have equal size.")
   }
@@ -28,6 +28,7 @@ set(sources_list
   OpenSwathScoring.cpp
   OpenSwathTSVWriter.cpp
   OpenSwathOSWWriter.cpp
+  OpenSwathOutputQueue.cpp
   OpenSwathWorkflow.cpp
   PeakIntegrator.cpp
   PeakPickerChromatogram.cpp
@@ -33,6 +33,8 @@
 //Math classes
 #include <OpenMS/MATH/StatisticFunctions.h>
 
+#include <OpenMS/SYSTEM/TaskScheduler.h>
+
 //Standard library
 #include <cstddef> // for size_t & ptrdiff_t
 #include <vector>
@@ -200,26 +202,28 @@ namespace OpenMS
     std::vector<double> concentration_ratios, feature_amounts_ratios;
     TransformationModel::DataPoints data;
     TransformationModel::DataPoint point;
+
+    // the inverted calibration curve (as in applyCalibration(), but set up once for all points)
+    TransformationModel::DataPoints no_data;
+    TransformationDescription calibration(no_data);
+    calibration.fitModel(transformation_model, transformation_model_params);
+    calibration.invert();
+
     for (size_t i = 0; i < component_concentrations.size(); ++i)
     {
+      // extract out the feature amount ratios
+      double feature_amount_ratio = calculateRatio(component_concentrations[i].feature,
+        component_concentrations[i].IS_feature,
+        feature_name);
+      feature_amounts_ratios.push_back(feature_amount_ratio);
 
       // calculate the actual and calculated concentration ratios
-      double calculated_concentration_ratio = applyCalibration(component_concentrations[i].feature,
-        component_concentrations[i].IS_feature,
-        feature_name,
-        transformation_model,
-        transformation_model_params);
+      double calculated_concentration_ratio = std::max(calibration.apply(feature_amount_ratio), 0.0);
 
       double actual_concentration_ratio = component_concentrations[i].actual_concentration/
         component_concentrations[i].IS_actual_concentration / component_concentrations[i].dilution_factor;
       concentration_ratios.push_back(component_concentrations[i].actual_concentration);
 
-      // extract out the feature amount ratios
-      double feature_amount_ratio = calculateRatio(component_concentrations[i].feature,
-        component_concentrations[i].IS_feature,
-        feature_name);
-      feature_amounts_ratios.push_back(feature_amount_ratio);
-
       // calculate the bias
       double bias = calculateBias(actual_concentration_ratio, calculated_concentration_ratio);
       biases.push_back(bias);
@@ -530,32 +534,50 @@ namespace OpenMS
     // the data points with one removed pair. The combination resulting in
     // highest rsq is considered corresponding to the outlier candidate. The
     // corresponding iterator position is then returned.
-    std::vector<double> rsq_tmp;
-    Param optimized_params = transformation_model_params;
 
-    for (Size i = 0; i < component_concentrations.size(); i++)
-    {
-      std::vector<AbsoluteQuantitationStandards::featureConcentration> component_concentrations_tmp = component_concentrations;
-      component_concentrations_tmp.erase(component_concentrations_tmp.begin() + i);
+    // The correlation coefficient of calculateBiasAndR() only depends on the
+    // weighted calibration points (not on the fitted curve), so the one of each
+    // subset follows in closed form from the co-moments of all points: removing
+    // point k changes the co-moment C_xy by n / (n - 1) * (x_k - mean_x) * (y_k - mean_y).
+    // The model is fitted once for its (weighting) parameters.
+    const Param optimized_params = fitCalibration(component_concentrations,
+      feature_name,
+      transformation_model,
+      transformation_model_params);
 
-      // fit the model
-      optimized_params = fitCalibration(component_concentrations_tmp,
-        feature_name,
-        transformation_model,
-        optimized_params);
+    TransformationModel::DataPoints data;
+    for (const AbsoluteQuantitationStandards::featureConcentration& fc : component_concentrations)
+    {
+      data.emplace_back(fc.actual_concentration / fc.IS_actual_concentration / fc.dilution_factor,
+        calculateRatio(fc.feature, fc.IS_feature, feature_name));
+    }
+    TransformationModel tm(data, optimized_params);
+    tm.weightData(data);
 
-      // calculate the R2 and bias
-      std::vector<double> biases;
-      double correlation_coefficient = 0.0;
-      calculateBiasAndR(
-        component_concentrations_tmp,
-        feature_name,
-        transformation_model,
-        optimized_params,
-        biases,
-        correlation_coefficient);
+    const double n = data.size();
+    double mean_x = 0.0, mean_y = 0.0;
+    for (const TransformationModel::DataPoint& p : data)
+    {
+      mean_x += p.first;
+      mean_y += p.second;
+    }
+    mean_x /= n;
+    mean_y /= n;
+    double c_xx = 0.0, c_yy = 0.0, c_xy = 0.0;
+    for (const TransformationModel::DataPoint& p : data)
+    {
+      c_xx += (p.first - mean_x) * (p.first - mean_x);
+      c_yy += (p.second - mean_y) * (p.second - mean_y);
+      c_xy += (p.first - mean_x) * (p.second - mean_y);
+    }
 
-      rsq_tmp.push_back(correlation_coefficient);
+    std::vector<double> rsq_tmp;
+    const double f = n / (n - 1.0);
+    for (const TransformationModel::DataPoint& p : data)
+    {
+      const double dx = p.first - mean_x;
+      const double dy = p.second - mean_y;
+      rsq_tmp.push_back((c_xy - f * dx * dy) / std::sqrt((c_xx - f * dx * dx) * (c_yy - f * dy * dy)));
     }
     return max_element(rsq_tmp.begin(), rsq_tmp.end()) - rsq_tmp.begin();
   }
@@ -593,79 +615,86 @@ namespace OpenMS
   void AbsoluteQuantitation::optimizeCalibrationCurves(
     std::map<String, std::vector<AbsoluteQuantitationStandards::featureConcentration>> & components_concentrations)
   {
-    std::map<String, std::vector<AbsoluteQuantitationStandards::featureConcentration>>& cc = components_concentrations;
+    if (!quant_methods_.empty() && optimization_method_ != "iterative")
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Unsupported calibration curve optimization method '" + optimization_method_ + "'.");
+    }
+
+    // the calibration curves of the components are independent of each other
+    std::vector<std::pair<AbsoluteQuantitationMethod*, std::vector<AbsoluteQuantitationStandards::featureConcentration>*>> components;
     for (std::pair<const String, AbsoluteQuantitationMethod>& quant_method : quant_methods_)
     {
-      const String& component_name = quant_method.first;
-      AbsoluteQuantitationMethod& component_aqm = quant_method.second;
-      if (cc.count(component_name) && optimization_method_ == "iterative")
+      auto cc_it = components_concentrations.find(quant_method.first);
+      if (cc_it == components_concentrations.end())
       {
-        // optimize the calibration curve for the component
-        Param optimized_params;
-        bool optimal_calibration_found = optimizeCalibrationCurveIterative(
-          cc[component_name],
-          component_aqm.getFeatureName(),
-          component_aqm.getTransformationModel(),
-          component_aqm.getTransformationModelParams(),
-          optimized_params);
+        OPENMS_LOG_DEBUG << "Warning: Standards not found for component " << quant_method.first << ".";
+        continue;
+      }
+      components.emplace_back(&quant_method.second, &cc_it->second);
+    }
 
-        // order component concentrations and update the lloq and uloq
-        std::vector<AbsoluteQuantitationStandards::featureConcentration>::const_iterator it;
-        it = std::min_element(cc[component_name].begin(), cc[component_name].end(), [](
-            const AbsoluteQuantitationStandards::featureConcentration& lhs,
-            const AbsoluteQuantitationStandards::featureConcentration& rhs
-          )
-          {
-            return lhs.actual_concentration < rhs.actual_concentration;
-          }
-        );
-        component_aqm.setLLOQ(it->actual_concentration);
-        it = std::max_element(cc[component_name].begin(), cc[component_name].end(), [](
-            const AbsoluteQuantitationStandards::featureConcentration& lhs,
-            const AbsoluteQuantitationStandards::featureConcentration& rhs
-          )
-          {
-            return lhs.actual_concentration < rhs.actual_concentration;
-          }
-        );
-        component_aqm.setULOQ(it->actual_concentration);
+    TaskScheduler::parallelFor(0, components.size(), [&](SignedSize i)
+    {
+      AbsoluteQuantitationMethod& component_aqm = *components[i].first;
+      std::vector<AbsoluteQuantitationStandards::featureConcentration>& component_concentrations = *components[i].second;
+
+      // optimize the calibration curve for the component
+      Param optimized_params;
+      bool optimal_calibration_found = optimizeCalibrationCurveIterative(
+        component_concentrations,
+        component_aqm.getFeatureName(),
+        component_aqm.getTransformationModel(),
+        component_aqm.getTransformationModelParams(),
+        optimized_params);
 
-        if (optimal_calibration_found)
+      // order component concentrations and update the lloq and uloq
+      std::vector<AbsoluteQuantitationStandards::featureConcentration>::const_iterator it;
+      it = std::min_element(component_concentrations.begin(), component_concentrations.end(), [](
+          const AbsoluteQuantitationStandards::featureConcentration& lhs,
+          const AbsoluteQuantitationStandards::featureConcentration& rhs
+        )
         {
-          // calculate the R2 and bias
-          std::vector<double> biases;
-          double correlation_coefficient = 0.0;
-          calculateBiasAndR(
-            cc[component_name],
-            component_aqm.getFeatureName(),
-            component_aqm.getTransformationModel(),
-            optimized_params,
-            biases,
-            correlation_coefficient);
-
-          // record the updated information
-          component_aqm.setCorrelationCoefficient(correlation_coefficient);
-          component_aqm.setTransformationModelParams(optimized_params);
-          component_aqm.setNPoints(cc[component_name].size());
+          return lhs.actual_concentration < rhs.actual_concentration;
         }
-        else 
+      );
+      component_aqm.setLLOQ(it->actual_concentration);
+      it = std::max_element(component_concentrations.begin(), component_concentrations.end(), [](
+          const AbsoluteQuantitationStandards::featureConcentration& lhs,
+          const AbsoluteQuantitationStandards::featureConcentration& rhs
+        )
         {
-          component_aqm.setCorrelationCoefficient(0.0);
-          component_aqm.setNPoints(0);
-          component_aqm.setLLOQ(0.0);
-          component_aqm.setULOQ(0.0);
+          return lhs.actual_concentration < rhs.actual_concentration;
         }
-      }
-      else if (optimization_method_ != "iterative")
+      );
+      component_aqm.setULOQ(it->actual_concentration);
+
+      if (optimal_calibration_found)
       {
-        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-          "Unsupported calibration curve optimization method '" + optimization_method_ + "'.");
+        // calculate the R2 and bias
+        std::vector<double> biases;
+        double correlation_coefficient = 0.0;
+        calculateBiasAndR(
+          component_concentrations,
+          component_aqm.getFeatureName(),
+          component_aqm.getTransformationModel(),
+          optimized_params,
+          biases,
+          correlation_coefficient);
+
+        // record the updated information
+        component_aqm.setCorrelationCoefficient(correlation_coefficient);
+        component_aqm.setTransformationModelParams(optimized_params);
+        component_aqm.setNPoints(component_concentrations.size());
       }
       else
       {
-        OPENMS_LOG_DEBUG << "Warning: Standards not found for component " << component_name << ".";
+        component_aqm.setCorrelationCoefficient(0.0);
+        component_aqm.setNPoints(0);
+        component_aqm.setLLOQ(0.0);
+        component_aqm.setULOQ(0.0);
       }
-    }
+    });
   }
 
   void AbsoluteQuantitation::optimizeSingleCalibrationCurve(
@@ -17,6 +17,8 @@
 #include <OpenMS/KERNEL/ConsensusMap.h>
 #include <OpenMS/MATH/StatisticFunctions.h>
 
+#include <exception>
+
 // #define ISOBARIC_CHANNEL_EXTRACTOR_DEBUG
 // #undef ISOBARIC_CHANNEL_EXTRACTOR_DEBUG
 
@@ -488,8 +490,16 @@ namespace OpenMS
 
     Size number_of_channels = quant_method_->getNumberOfChannels();
 
-    PeakMap::ConstIterator it_last_MS2 = ms_exp_data.end(); // remember last MS2 spec, to get precursor in MS1 (also if quant is in MS3)
-    bool ms3 = false;
+    // collect the spectra to quantify together with the state of the purity computation (i.e. the surrounding MS1 scans)
+    struct QuantScan
+    {
+      PeakMap::ConstIterator spec; ///< the MSn spectrum holding the reporter ions
+      PuritySate_ state; ///< the precursor and follow up MS1 scan of the spectrum
+      double precursor_purity = -1.0;
+      PeakMap::ConstIterator ms2_spec; ///< MS2 spectrum holding the precursor information (the spectrum itself, unless it is a MS3 spectrum)
+      std::exception_ptr error; ///< error raised while processing the spectrum
+    };
+    std::vector<QuantScan> quant_scans;
     for (PeakMap::ConstIterator it = ms_exp_data.begin(); it != ms_exp_data.end(); ++it)
     {
       // remember the last MS1 spectra as we assume it to be the precursor spectrum
@@ -497,8 +507,6 @@ namespace OpenMS
       {
         // remember potential precursor and continue
         pState.precursorScan = it;
-        // reset last MS2 -- we expect to see a new one soon and the old one should not be used for the following MS3 (if any)
-        it_last_MS2 = ms_exp_data.end();
         continue;
       }
 
@@ -520,146 +528,166 @@ namespace OpenMS
         continue;
       }
 
-      // check precursor purity if we have a valid precursor ..
-      double precursor_purity = -1.0;
-      if (pState.precursorScan != ms_exp_data.end())
+      quant_scans.push_back(QuantScan{it, pState});
+    }
+
+    // the spectra are processed in blocks: purity and reporter ion signals are computed in parallel,
+    // the consensus features are created sequentially in the order of the spectra
+    const SignedSize block_size = 10000;
+    std::vector<ChannelSignal_> block_signals;
+    bool ms3 = false;
+    for (SignedSize block_begin = 0; block_begin < (SignedSize)quant_scans.size(); block_begin += block_size)
+    {
+      const SignedSize block_end = std::min(block_begin + block_size, (SignedSize)quant_scans.size());
+      block_signals.assign((block_end - block_begin) * number_of_channels, ChannelSignal_());
+
+#pragma omp parallel for schedule(dynamic, 100)
+      for (SignedSize i = block_begin; i < block_end; ++i)
       {
-        precursor_purity = computePrecursorPurity_(it, pState);
-        // check if purity is high enough
-        if (precursor_purity < min_precursor_purity_)
+        QuantScan& scan = quant_scans[i];
+        try
         {
-          OPENMS_LOG_DEBUG << "Skip spectrum " << it->getNativeID() << ": Precursor purity is below the threshold. [purity = " << precursor_purity << "]" << std::endl;
-          continue;
-        }
-      }
-      else
-      {
-        OPENMS_LOG_INFO << "No precursor available for spectrum: " << it->getNativeID() << std::endl;
-      }
+          // check precursor purity if we have a valid precursor ..
+          if (scan.state.precursorScan != ms_exp_data.end())
+          {
+            scan.precursor_purity = computePrecursorPurity_(scan.spec, scan.state);
+            // the spectrum is skipped (see below) if the purity is not high enough
+            if (scan.precursor_purity < min_precursor_purity_) continue;
+          }
 
-      if (it->getMSLevel() == 3)
-      {
-        ms3 = true;
-        // we cannot save just the last MS2 but need to compare to the precursor info stored in the (potential MS3 spectrum)
-        it_last_MS2 = ms_exp_data.getPrecursorSpectrum(it);
+          // we cannot save just the last MS2 but need to compare to the precursor info stored in the (potential MS3 spectrum)
+          scan.ms2_spec = scan.spec->getMSLevel() == 3 ? ms_exp_data.getPrecursorSpectrum(scan.spec) : scan.spec;
 
-        if (it_last_MS2 == ms_exp_data.end())
-        { // this only happens if an MS3 spec does not have a preceding MS2
-          throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("No MS2 precursor information given for MS3 scan native ID ") + it->getNativeID() + " with RT " + String(it->getRT()));
+          findChannelSignals_(*scan.spec, qc_dist_mz, block_signals.begin() + (i - block_begin) * number_of_channels);
+        }
+        catch (...)
+        {
+          scan.error = std::current_exception();
         }
-      }
-      else
-      {
-        it_last_MS2 = it;
       }
 
-      // check if MS1 precursor info is available
-      if (it_last_MS2->getPrecursors().empty())
+      for (SignedSize i = block_begin; i < block_end; ++i)
       {
-        throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("No precursor information given for scan native ID ") + it->getNativeID() + " with RT " + String(it->getRT()));
-      }
+        const QuantScan& scan = quant_scans[i];
+        PeakMap::ConstIterator it = scan.spec;
+        if (scan.error)
+        {
+          std::rethrow_exception(scan.error);
+        }
 
-      // store RT of MS2 scan and MZ of MS1 precursor ion as centroid of ConsensusFeature
-      ConsensusFeature cf;
-      cf.setUniqueId();
-      cf.setRT(it_last_MS2->getRT());
-      cf.setMZ(it_last_MS2->getPrecursors()[0].getMZ());
-
-      Peak2D channel_value;
-      channel_value.setRT(it->getRT());
-      // for each each channel
-      UInt64 map_index = 0;
-      Peak2D::IntensityType overall_intensity = 0;
-
-      for (IsobaricQuantitationMethod::IsobaricChannelList::const_iterator cl_it = quant_method_->getChannelInformation().begin();
-            cl_it != quant_method_->getChannelInformation().end();
-            ++cl_it)
-      {
-        // set mz-position of channel
-        channel_value.setMZ(cl_it->center);
-        // reset intensity
-        channel_value.setIntensity(0);
-
-        // as every evaluation requires time, we cache the MZEnd iterator
-        const PeakMap::SpectrumType::ConstIterator mz_end = it->MZEnd(cl_it->center + qc_dist_mz);
-
-        // search for the non-zero signal closest to theoretical position
-        // & check for closest signal within reasonable distance (0.5 Da) -- might find neighbouring TMT channel, but that should not confuse anyone
-        int peak_count(0); // count peaks in user window -- should be only one, otherwise Window is too large
-        PeakMap::SpectrumType::ConstIterator idx_nearest(mz_end);
-        for (PeakMap::SpectrumType::ConstIterator mz_it = it->MZBegin(cl_it->center - qc_dist_mz);
-              mz_it != mz_end;
-              ++mz_it)
+        const double precursor_purity = scan.precursor_purity;
+        if (scan.state.precursorScan != ms_exp_data.end())
         {
-          if (mz_it->getIntensity() == 0) continue; // ignore 0-intensity shoulder peaks -- could be detrimental when de-calibrated
-          double dist_mz = fabs(mz_it->getMZ() - cl_it->center);
-          if (dist_mz < reporter_mass_shift_) ++peak_count;
-          if (idx_nearest == mz_end // first peak
-              || ((dist_mz < fabs(idx_nearest->getMZ() - cl_it->center)))) // closer to best candidate
+          // check if purity is high enough
+          if (precursor_purity < min_precursor_purity_)
           {
-            idx_nearest = mz_it;
+            OPENMS_LOG_DEBUG << "Skip spectrum " << it->getNativeID() << ": Precursor purity is below the threshold. [purity = " << precursor_purity << "]" << std::endl;
+            continue;
           }
         }
-        if (idx_nearest != mz_end)
+        else
         {
-          double mz_delta = cl_it->center - idx_nearest->getMZ();
-          // stats: we don't care what shift the user specified
-          channel_mz_delta[cl_it->name].mz_deltas.push_back(mz_delta);
-          if (peak_count > 1) ++channel_mz_delta[cl_it->name].signal_not_unique;
-          // pass user threshold
-          if (std::fabs(mz_delta) < reporter_mass_shift_)
-          {
-            channel_value.setIntensity(idx_nearest->getIntensity());
+          OPENMS_LOG_INFO << "No precursor available for spectrum: " << it->getNativeID() << std::endl;
+        }
+
+        PeakMap::ConstIterator it_last_MS2 = scan.ms2_spec; // the MS2 spec, to get precursor in MS1 (also if quant is in MS3)
+        if (it->getMSLevel() == 3)
+        {
+          ms3 = true;
+          if (it_last_MS2 == ms_exp_data.end())
+          { // this only happens if an MS3 spec does not have a preceding MS2
+            throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("No MS2 precursor information given for MS3 scan native ID ") + it->getNativeID() + " with RT " + String(it->getRT()));
           }
         }
 
-        // discard contribution of this channel as it is below the required intensity threshold
-        if (channel_value.getIntensity() < min_reporter_intensity_)
+        // check if MS1 precursor info is available
+        if (it_last_MS2->getPrecursors().empty())
         {
-          channel_value.setIntensity(0);
+          throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("No precursor information given for scan native ID ") + it->getNativeID() + " with RT " + String(it->getRT()));
         }
 
-        overall_intensity += channel_value.getIntensity();
-        // add channel to ConsensusFeature
-        cf.insert(map_index, channel_value, element_index);
-        ++map_index;
-      } // ! channel_iterator
+        // store RT of MS2 scan and MZ of MS1 precursor ion as centroid of ConsensusFeature
+        ConsensusFeature cf;
+        cf.setUniqueId();
+        cf.setRT(it_last_MS2->getRT());
+        cf.setMZ(it_last_MS2->getPrecursors()[0].getMZ());
+
+        Peak2D channel_value;
+        channel_value.setRT(it->getRT());
+        // for each each channel
+        UInt64 map_index = 0;
+        Peak2D::IntensityType overall_intensity = 0;
+
+        std::vector<ChannelSignal_>::const_iterator signal = block_signals.begin() + (i - block_begin) * number_of_channels;
+        for (IsobaricQuantitationMethod::IsobaricChannelList::const_iterator cl_it = quant_method_->getChannelInformation().begin();
+              cl_it != quant_method_->getChannelInformation().end();
+              ++cl_it, ++signal)
+        {
+          // set mz-position of channel
+          channel_value.setMZ(cl_it->center);
+          // reset intensity
+          channel_value.setIntensity(0);
 
-      // check if we keep this feature or if it contains low-intensity quantifications
-      if (remove_low_intensity_quantifications_ && hasLowIntensityReporter_(cf))
-      {
-        continue;
-      }
+          if (signal->found)
+          {
+            // stats: we don't care what shift the user specified
+            channel_mz_delta[cl_it->name].mz_deltas.push_back(signal->mz_delta);
+            if (signal->peak_count > 1) ++channel_mz_delta[cl_it->name].signal_not_unique;
+            // pass user threshold
+            if (std::fabs(signal->mz_delta) < reporter_mass_shift_)
+            {
+              channel_value.setIntensity(signal->intensity);
+            }
+          }
 
-      // check featureHandles are not empty
-      if (overall_intensity <= 0)
-      {
-        cf.setMetaValue("all_empty", String("true"));
-      }
-      // add purity information if we could compute it
-      if (precursor_purity > 0.0)
-      {
-        cf.setMetaValue("precursor_purity", precursor_purity);
-      }
+          // discard contribution of this channel as it is below the required intensity threshold
+          if (channel_value.getIntensity() < min_reporter_intensity_)
+          {
+            channel_value.setIntensity(0);
+          }
 
-      // embed the id of the scan from which the quantitative information was extracted
-      cf.setMetaValue("scan_id", it->getNativeID());
-      // embed the id of the scan from which the ID information should be extracted
-      // helpful for mapping later
-      if (ms3)
-      {
-        cf.setMetaValue("id_scan_id", it_last_MS2->getNativeID());
-      }
-      // ...as well as additional meta information
-      cf.setMetaValue("precursor_intensity", it->getPrecursors()[0].getIntensity());
+          overall_intensity += channel_value.getIntensity();
+          // add channel to ConsensusFeature
+          cf.insert(map_index, channel_value, element_index);
+          ++map_index;
+        } // ! channel_iterator
+
+        // check if we keep this feature or if it contains low-intensity quantifications
+        if (remove_low_intensity_quantifications_ && hasLowIntensityReporter_(cf))
+        {
+          continue;
+        }
+
+        // check featureHandles are not empty
+        if (overall_intensity <= 0)
+        {
+          cf.setMetaValue("all_empty", String("true"));
+        }
+        // add purity information if we could compute it
+        if (precursor_purity > 0.0)
+        {
+          cf.setMetaValue("precursor_purity", precursor_purity);
+        }
 
-      cf.setCharge(it_last_MS2->getPrecursors()[0].getCharge());
-      cf.setIntensity(overall_intensity);
-      consensus_map.push_back(cf);
+        // embed the id of the scan from which the quantitative information was extracted
+        cf.setMetaValue("scan_id", it->getNativeID());
+        // embed the id of the scan from which the ID information should be extracted
+        // helpful for mapping later
+        if (ms3)
+        {
+          cf.setMetaValue("id_scan_id", it_last_MS2->getNativeID());
+        }
+        // ...as well as additional meta information
+        cf.setMetaValue("precursor_intensity", it->getPrecursors()[0].getIntensity());
 
-      // the tandem-scan in the order they appear in the experiment
-      ++element_index;
-    } // ! Experiment iterator
+        cf.setCharge(it_last_MS2->getPrecursors()[0].getCharge());
+        cf.setIntensity(overall_intensity);
+        consensus_map.push_back(cf);
+
+        // the tandem-scan in the order they appear in the experiment
+        ++element_index;
+      } // ! spectra of block
+    } // ! blocks
 
     // print stats about m/z calibration / presence of signal
     OPENMS_LOG_INFO << "Calibration stats: Median distance of observed reporter ions m/z to expected position (up to " << qc_dist_mz << " Th):\n";
@@ -704,6 +732,42 @@ namespace OpenMS
     registerChannelsInOutputMap_(consensus_map);
   }
 
+  void IsobaricChannelExtractor::findChannelSignals_(const PeakMap::SpectrumType& spec, const double qc_dist_mz, std::vector<ChannelSignal_>::iterator signals) const
+  {
+    for (IsobaricQuantitationMethod::IsobaricChannelList::const_iterator cl_it = quant_method_->getChannelInformation().begin();
+          cl_it != quant_method_->getChannelInformation().end();
+          ++cl_it, ++signals)
+    {
+      // as every evaluation requires time, we cache the MZEnd iterator
+      const PeakMap::SpectrumType::ConstIterator mz_end = spec.MZEnd(cl_it->center + qc_dist_mz);
+
+      // search for the non-zero signal closest to theoretical position
+      // & check for closest signal within reasonable distance (0.5 Da) -- might find neighbouring TMT channel, but that should not confuse anyone
+      int peak_count(0); // count peaks in user window -- should be only one, otherwise Window is too large
+      PeakMap::SpectrumType::ConstIterator idx_nearest(mz_end);
+      for (PeakMap::SpectrumType::ConstIterator mz_it = spec.MZBegin(cl_it->center - qc_dist_mz);
+            mz_it != mz_end;
+            ++mz_it)
+      {
+        if (mz_it->getIntensity() == 0) continue; // ignore 0-intensity shoulder peaks -- could be detrimental when de-calibrated
+        double dist_mz = fabs(mz_it->getMZ() - cl_it->center);
+        if (dist_mz < reporter_mass_shift_) ++peak_count;
+        if (idx_nearest == mz_end // first peak
+            || ((dist_mz < fabs(idx_nearest->getMZ() - cl_it->center)))) // closer to best candidate
+        {
+          idx_nearest = mz_it;
+        }
+      }
+      if (idx_nearest != mz_end)
+      {
+        signals->found = true;
+        signals->mz_delta = cl_it->center - idx_nearest->getMZ();
+        signals->intensity = idx_nearest->getIntensity();
+        signals->peak_count = peak_count;
+      }
+    }
+  }
+
   void IsobaricChannelExtractor::registerChannelsInOutputMap_(ConsensusMap& consensus_map)
   {
     // register the individual channels in the output consensus map
@@ -19,6 +19,8 @@
 #include <Eigen/Core>
 #include <Eigen/LU>
 
+#include <exception>
+
 // #define ISOBARIC_QUANT_DEBUG
 
 namespace OpenMS
@@ -49,11 +51,8 @@ namespace OpenMS
                                           "Please provide a valid isotope_correction matrix as it was provided with the sample kit!");      
     }
     
-    Eigen::FullPivLU<Eigen::MatrixXd> ludecomp(correction_matrix.getEigenMatrix());
-    Eigen::VectorXd b;
-    b.resize(quant_method->getNumberOfChannels());
-    b.setZero();
-    std::vector<double> x(quant_method->getNumberOfChannels(), 0);
+    // the LU decomposition is computed once and shared by all consensus features
+    const Eigen::FullPivLU<Eigen::MatrixXd> ludecomp(correction_matrix.getEigenMatrix());
 
     if (!ludecomp.isInvertible())
     {
@@ -61,50 +60,105 @@ namespace OpenMS
       throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "IsobaricIsotopeCorrector: The given isotope correction matrix is not invertible!");
     }
 
-    // data structures for NNLS
-    Matrix<double> m_b(quant_method->getNumberOfChannels(), 1);
-    Matrix<double> m_x(quant_method->getNumberOfChannels(), 1);
-
-    // correct all consensus elements
-    for (ConsensusMap::size_type i = 0; i < consensus_map_out.size(); ++i)
+    // look up the channel_id of each map index once (instead of once per element)
+    std::map<Size, Int> in_channel_ids;
+    for (const auto& header : consensus_map_in.getColumnHeaders())
     {
-#ifdef ISOBARIC_QUANT_DEBUG
-      std::cout << "\nMAP element  #### " << i << " #### \n" << std::endl;
-#endif
-      // delete only the consensus handles from the output map
-      consensus_map_out[i].clear();
+      if (header.second.metaValueExists("channel_id")) in_channel_ids[header.first] = Int(header.second.getMetaValue("channel_id"));
+    }
+    std::map<Size, Int> out_channel_ids;
+    for (const auto& header : consensus_map_out.getColumnHeaders())
+    {
+      if (header.second.metaValueExists("channel_id")) out_channel_ids[header.first] = Int(header.second.getMetaValue("channel_id"));
+    }
 
-      // fill b vector
-      fillInputVector_(b, m_b, consensus_map_in[i], consensus_map_in);
+    // correct all consensus elements; the stats are collected afterwards in the order of the map
+    std::vector<SolutionComparison_> comparisons(consensus_map_out.size());
+    std::exception_ptr error;
+    SignedSize error_index = consensus_map_out.size();
+#pragma omp parallel
+    {
+      // data structures for Eigen and NNLS (one set per thread)
+      Eigen::VectorXd b(quant_method->getNumberOfChannels());
+      Matrix<double> m_b(quant_method->getNumberOfChannels(), 1);
+      Matrix<double> m_x(quant_method->getNumberOfChannels(), 1);
 
-      //solve
-      Eigen::MatrixXd e_mx = ludecomp.solve(b);
-      if (!(correction_matrix.getEigenMatrix() * e_mx).isApprox(b))
+#pragma omp for schedule(dynamic, 100)
+      for (SignedSize i = 0; i < (SignedSize)consensus_map_out.size(); ++i)
       {
-        throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "IsobaricIsotopeCorrector: Cannot multiply!");
+#ifdef ISOBARIC_QUANT_DEBUG
+        std::cout << "\nMAP element  #### " << i << " #### \n" << std::endl;
+#endif
+        try
+        {
+          // delete only the consensus handles from the output map
+          consensus_map_out[i].clear();
+
+          // fill b vector (channels missing in this feature are zero)
+          b.setZero();
+          m_b.getEigenMatrix().setZero();
+          fillInputVector_(b, m_b, consensus_map_in[i], in_channel_ids);
+
+          //solve
+          Eigen::MatrixXd e_mx = ludecomp.solve(b);
+          if (!(correction_matrix.getEigenMatrix() * e_mx).isApprox(b))
+          {
+            throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "IsobaricIsotopeCorrector: Cannot multiply!");
+          }
+          solveNNLS_(correction_matrix, m_b, m_x);
+
+          // update the output consensus map with the corrected intensities
+          float cf_intensity = updateOutpuMap_(consensus_map_in, consensus_map_out, i, m_x, out_channel_ids);
+
+          // check consistency
+          comparisons[i] = compareSolutions_(m_x, e_mx, cf_intensity, quant_method);
+        }
+        catch (...)
+        {
+          // report the error of the first feature that failed, as the serial loop would
+#pragma omp critical (IsobaricIsotopeCorrector_error)
+          if (i < error_index)
+          {
+            error_index = i;
+            error = std::current_exception();
+          }
+        }
       }
-      solveNNLS_(correction_matrix, m_b, m_x);
-
-      // update the output consensus map with the corrected intensities
-      float cf_intensity = updateOutpuMap_(consensus_map_in, consensus_map_out, i, m_x);
+    }
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
 
-      // check consistency
-      computeStats_(m_x, e_mx, cf_intensity, quant_method, stats);    
+    for (const SolutionComparison_& comparison : comparisons)
+    {
+      computeStats_(comparison, stats);
     }
 
     return stats;
   }
 
+  Int
+  IsobaricIsotopeCorrector::channelIdOf_(const std::map<Size, Int>& channel_ids, Size map_index)
+  {
+    std::map<Size, Int>::const_iterator it = channel_ids.find(map_index);
+    if (it == channel_ids.end())
+    {
+      throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "IsobaricIsotopeCorrector: No channel_id given for map index " + String(map_index) + "!");
+    }
+    return it->second;
+  }
+
   void
   IsobaricIsotopeCorrector::fillInputVector_(Eigen::VectorXd& b,
-                                             Matrix<double>& m_b, const ConsensusFeature& cf, const ConsensusMap& cm)
+                                             Matrix<double>& m_b, const ConsensusFeature& cf, const std::map<Size, Int>& channel_ids)
   {
     for (ConsensusFeature::HandleSetType::const_iterator it_elements = cf.getFeatures().begin();
          it_elements != cf.getFeatures().end();
          ++it_elements)
     {
       //find channel_id of current element
-      Int index = Int(cm.getColumnHeaders().find(it_elements->getMapIndex())->second.getMetaValue("channel_id"));
+      Int index = channelIdOf_(channel_ids, it_elements->getMapIndex());
 #ifdef ISOBARIC_QUANT_DEBUG
       std::cout << "  map_index " << it_elements->getMapIndex() << "-> id " << index << " with intensity " << it_elements->getIntensity() << "\n" << std::endl;
 #endif
@@ -125,50 +179,54 @@ namespace OpenMS
     }
   }
 
-  void
-  IsobaricIsotopeCorrector::computeStats_(const Matrix<double>& m_x,
-                                          const Eigen::MatrixXd& x, const float cf_intensity,
-                                          const IsobaricQuantitationMethod* quant_method, IsobaricQuantifierStatistics& stats)
+  IsobaricIsotopeCorrector::SolutionComparison_
+  IsobaricIsotopeCorrector::compareSolutions_(const Matrix<double>& m_x,
+                                              const Eigen::MatrixXd& x, const float cf_intensity,
+                                              const IsobaricQuantitationMethod* quant_method)
   {
-    Size s_negative(0);
-    Size s_different_count(0); // happens when naive solution is negative in other channels
-    double s_different_intensity(0);
+    SolutionComparison_ comparison;
+    comparison.cf_intensity = cf_intensity;
 
     // ISOTOPE CORRECTION: compare solutions of Matrix inversion vs. NNLS
     for (Size index = 0; index < quant_method->getNumberOfChannels(); ++index)
     {
       if (x(index) < 0.0)
       {
-        ++s_negative;
+        ++comparison.negative;
       }
       else if ((((std::fabs(m_x(index, 0) - x(index)))/m_x(index, 0))*100) > 1)
       {
-        ++s_different_count;
-        s_different_intensity += std::fabs(m_x(index, 0) - x(index));
+        ++comparison.different_count; // happens when naive solution is negative in other channels
+        comparison.different_intensity += std::fabs(m_x(index, 0) - x(index));
       }
     }
+    return comparison;
+  }
 
-    if (s_negative == 0 && s_different_count > 0) //some solutions are inconsistent, despite being positive
+  void
+  IsobaricIsotopeCorrector::computeStats_(const SolutionComparison_& comparison, IsobaricQuantifierStatistics& stats)
+  {
+    if (comparison.negative == 0 && comparison.different_count > 0) //some solutions are inconsistent, despite being positive
     {
       OPENMS_LOG_WARN << "IsobaricIsotopeCorrector: Isotope correction values of alternative method differ!" << std::endl;
     }
 
     // update global stats
-    stats.iso_number_reporter_negative += s_negative;
-    stats.iso_number_reporter_different += s_different_count;
-    stats.iso_solution_different_intensity += s_different_intensity;
+    stats.iso_number_reporter_negative += comparison.negative;
+    stats.iso_number_reporter_different += comparison.different_count;
+    stats.iso_solution_different_intensity += comparison.different_intensity;
 
-    if (s_negative > 0)
+    if (comparison.negative > 0)
     {
       ++stats.iso_number_ms2_negative;
-      stats.iso_total_intensity_negative += cf_intensity;
+      stats.iso_total_intensity_negative += comparison.cf_intensity;
     }
   }
 
   float
   IsobaricIsotopeCorrector::updateOutpuMap_(
     const ConsensusMap& consensus_map_in, ConsensusMap& consensus_map_out,
-    ConsensusMap::size_type current_cf, const Matrix<double>& m_x)
+    ConsensusMap::size_type current_cf, const Matrix<double>& m_x, const std::map<Size, Int>& channel_ids)
   {
     float cf_intensity(0);
     for (ConsensusFeature::HandleSetType::const_iterator it_elements = consensus_map_in[current_cf].begin();
@@ -177,7 +235,7 @@ namespace OpenMS
     {
       FeatureHandle handle = *it_elements;
       //find channel_id of current element
-      Int index = Int(consensus_map_out.getColumnHeaders()[it_elements->getMapIndex()].getMetaValue("channel_id"));
+      Int index = channelIdOf_(channel_ids, it_elements->getMapIndex());
       handle.setIntensity(float(m_x(index, 0)));
 
       consensus_map_out[current_cf].insert(handle);
@@ -9,6 +9,8 @@
 #include <OpenMS/ANALYSIS/QUANTITATION/KDTreeFeatureMaps.h>
 #include <OpenMS/MATH/MathFunctions.h>
 
+#include <algorithm>
+
 using namespace std;
 
 namespace OpenMS
@@ -20,8 +22,7 @@ void KDTreeFeatureMaps::addFeature(Size mt_map_index, const BaseFeature* feature
   features_.push_back(feature);
   rt_.push_back(feature->getRT());
 
-  KDTreeFeatureNode mt_node(this, size() - 1);
-  kd_tree_.insert(mt_node);
+  kd_tree_.insert(feature->getRT(), feature->getMZ(), size() - 1);
 }
 
 const BaseFeature* KDTreeFeatureMaps::feature(Size i) const
@@ -73,12 +74,13 @@ void KDTreeFeatureMaps::clear()
 {
   features_.clear();
   map_index_.clear();
+  rt_.clear();
   kd_tree_.clear();
 }
 
 void KDTreeFeatureMaps::optimizeTree()
 {
-  kd_tree_.optimize();
+  kd_tree_.build();
 }
 
 void KDTreeFeatureMaps::getNeighborhood(Size index, vector<Size>& result_indices, double rt_tol, double mz_tol, bool mz_ppm, bool include_features_from_same_map, double max_pairwise_log_fc) const
@@ -117,27 +119,28 @@ void KDTreeFeatureMaps::getNeighborhood(Size index, vector<Size>& result_indices
 
 void KDTreeFeatureMaps::queryRegion(double rt_low, double rt_high, double mz_low, double mz_high, vector<Size>& result_indices, Size ignored_map_index) const
 {
-  // set up tolerance window as region for the 2D tree
-  FeatureKDTree::_Region_ region;
-  region._M_low_bounds[0] = rt_low;
-  region._M_high_bounds[0] = rt_high;
-  region._M_low_bounds[1] = mz_low;
-  region._M_high_bounds[1] = mz_high;
-
   // range-query tolerance window
-  vector<KDTreeFeatureNode> tmp_result;
-  kd_tree_.find_within_range(region, back_insert_iterator<vector<KDTreeFeatureNode> >(tmp_result));
-
-  // add indices to result
   result_indices.clear();
-  for (vector<KDTreeFeatureNode>::const_iterator it = tmp_result.begin(); it != tmp_result.end(); ++it)
+  kd_tree_.queryRange({{rt_low, mz_low}, {rt_high, mz_high}}, result_indices);
+  filterMapIndex_(result_indices, ignored_map_index);
+}
+
+void KDTreeFeatureMaps::queryRegions(const vector<Region>& regions, vector<vector<Size> >& result_indices, Size ignored_map_index) const
+{
+  kd_tree_.queryRanges(regions, result_indices);
+  for (vector<Size>& result : result_indices)
   {
-    Size found_index = it->getIndex();
-    if (ignored_map_index == numeric_limits<Size>::max() || map_index_[found_index] != ignored_map_index)
-    {
-      result_indices.push_back(found_index);
-    }
+    filterMapIndex_(result, ignored_map_index);
+  }
+}
+
+void KDTreeFeatureMaps::filterMapIndex_(vector<Size>& indices, Size ignored_map_index) const
+{
+  if (ignored_map_index == numeric_limits<Size>::max())
+  {
+    return;
   }
+  indices.erase(remove_if(indices.begin(), indices.end(), [&](Size i) { return map_index_[i] == ignored_map_index; }), indices.end());
 }
 
 void KDTreeFeatureMaps::applyTransformations(const vector<TransformationModelLowess*>& trafos)
@@ -146,6 +149,14 @@ void KDTreeFeatureMaps::applyTransformations(const vector<TransformationModelLow
   {
     rt_[i] = trafos[map_index_[i]]->evaluate(features_[i]->getRT());
   }
+
+  // the tree stores copies of the coordinates
+  kd_tree_.clear();
+  for (Size i = 0; i < size(); ++i)
+  {
+    kd_tree_.insert(rt_[i], mz(i), i);
+  }
+  kd_tree_.build();
 }
 
 void KDTreeFeatureMaps::updateMembers_()
@@ -102,19 +102,16 @@ namespace OpenMS
   void PeptideAndProteinQuant::quantifyFeature_(const FeatureHandle& feature,
                                                 const size_t fraction,
                                                 const size_t sample,
-                                                const PeptideHit& hit)
+                                                const PeptideHit& hit,
+                                                PeptideData& data)
   {
-    // return if annotation for the feature is ambiguous or missing
-    if (hit == PeptideHit()) { return; }
-
     stats_.quant_features++;
-    const AASequence& seq = hit.getSequence();
     //TODO The practice of inserting elements with the [] should be forbidden.
     // It is a debugging nightmare because if you try to access it and it is
     // not there, you are adding another element. In a next iteration this whole
     // class should be rewritten to use insert/emplace and find or better yet,
     // since we have "normal" 0-based values for samples now, vectors.
-    pep_quant_[seq].abundances[fraction][hit.getCharge()][sample] +=
+    data.abundances[fraction][hit.getCharge()][sample] +=
       feature.getIntensity(); // new map element is initialized with 0
   }
 
@@ -221,10 +218,18 @@ namespace OpenMS
     }
 
     //////////////////////////////////////////////////////
-    // second, perform the actual peptide quantification:
-    for (auto & pep_q : pep_quant_)
+    // second, perform the actual peptide quantification (peptides are independent of each other):
+    const bool best_charge_and_fraction = param_.getValue("best_charge_and_fraction") == "true";
+    vector<PeptideQuant::value_type*> pep_quant_entries;
+    pep_quant_entries.reserve(pep_quant_.size());
+    for (auto & pep_q : pep_quant_) { pep_quant_entries.push_back(&pep_q); }
+
+    Size quant_peptides(0);
+#pragma omp parallel for schedule(dynamic, 100) reduction(+: quant_peptides)
+    for (SignedSize i = 0; i < (SignedSize)pep_quant_entries.size(); ++i)
     {
-      if (param_.getValue("best_charge_and_fraction") == "true")
+      auto & pep_q = *pep_quant_entries[i];
+      if (best_charge_and_fraction)
       { // quantify according to the best charge state only:
 
         // determine which fraction and charge state yields the maximum number of abundances 
@@ -274,8 +279,9 @@ namespace OpenMS
       }
 
       // count quantified peptide
-      if (!pep_q.second.total_abundances.empty()) { stats_.quant_peptides++; }
+      if (!pep_q.second.total_abundances.empty()) { quant_peptides++; }
     }
+    stats_.quant_peptides += quant_peptides;
 
     //////////////////////////////////////////////////////
     // normalize (optional):
@@ -426,18 +432,27 @@ namespace OpenMS
       // proteotypic peptide
       const String peptide = pep_q.first.toUnmodifiedString();
 
-      prot_quant_[accession].psm_count += pep_q.second.psm_count;
+      ProteinData& prot_data = prot_quant_[accession];
+      prot_data.psm_count += pep_q.second.psm_count;
 
       // transfer abundances and counts from peptides->protein
       // summarize abundances and counts between different peptidoforms
-      for (auto const& sta : pep_q.second.total_abundances)
+      if (!pep_q.second.total_abundances.empty())
       {
-        prot_quant_[accession].abundances[peptide][sta.first] += sta.second;
+        SampleAbundances& abundances = prot_data.abundances[peptide];
+        for (auto const& sta : pep_q.second.total_abundances)
+        {
+          abundances[sta.first] += sta.second;
+        }
       }
 
-      for (auto const& sta : pep_q.second.total_psm_counts)
+      if (!pep_q.second.total_psm_counts.empty())
       {
-        prot_quant_[accession].psm_counts[peptide][sta.first] += sta.second;
+        SampleAbundances& psm_counts = prot_data.psm_counts[peptide];
+        for (auto const& sta : pep_q.second.total_psm_counts)
+        {
+          psm_counts[sta.first] += sta.second;
+        }
       }
     }
 
@@ -463,8 +478,16 @@ namespace OpenMS
       aggregate = "sum";
     }
 
-    for (auto& prot_q : prot_quant_)
+    // proteins are aggregated independently of each other
+    vector<ProteinQuant::value_type*> prot_quant_entries;
+    prot_quant_entries.reserve(prot_quant_.size());
+    for (auto& prot_q : prot_quant_) { prot_quant_entries.push_back(&prot_q); }
+
+    Size too_few_peptides(0), quant_proteins(0);
+#pragma omp parallel for schedule(dynamic, 100) reduction(+: too_few_peptides, quant_proteins)
+    for (SignedSize i = 0; i < (SignedSize)prot_quant_entries.size(); ++i)
     {
+      auto& prot_q = *prot_quant_entries[i];
       const ProteinData& pd = prot_q.second;
 
       // calculate PSM counts based on all (!) peptides of a protein (group)
@@ -484,7 +507,7 @@ namespace OpenMS
       // select which peptides of the current protein (group) are quantified
       if ((top_n > 0) && (prot_q.second.abundances.size() < top_n))
       { // not enough proteotypic peptides? skip protein (except if user chose to include the nevertheless)
-        stats_.too_few_peptides++;
+        too_few_peptides++;
         if (!include_all)
         {
           continue;
@@ -575,13 +598,15 @@ namespace OpenMS
       // update statistics:
       if (prot_q.second.total_abundances.empty())
       {
-        stats_.too_few_peptides++;
+        too_few_peptides++;
       }
       else
       {
-        stats_.quant_proteins++;
+        quant_proteins++;
       }
     }
+    stats_.too_few_peptides += too_few_peptides;
+    stats_.quant_proteins += quant_proteins;
     if (method == "iBAQ")
     {
       EnzymaticDigestion digest{};
@@ -634,9 +659,12 @@ namespace OpenMS
        
       countPeptides_(f.getPeptideIdentifications());
       PeptideHit hit = getAnnotation_(f.getPeptideIdentifications());
+      // skip if annotation for the feature is ambiguous or missing
+      if (hit == PeptideHit()) { continue; }
+
       FeatureHandle handle(0, f);
       const size_t fraction(1), sample(0);
-      quantifyFeature_(handle, fraction, sample, hit); // updates "stats_.quant_features"
+      quantifyFeature_(handle, fraction, sample, hit, pep_quant_[hit.getSequence()]); // updates "stats_.quant_features"
     }
     countPeptides_(features.getUnassignedPeptideIdentifications());
     stats_.total_peptides = pep_quant_.size();
@@ -679,6 +707,21 @@ namespace OpenMS
       fileAndLabel2MSFileSectionEntry[ed_filename + ed_label] = e;
     }
 
+    // resolve the experimental design entry of each column header (map index) once, not for every feature
+    std::unordered_map<UInt64, const ExperimentalDesign::MSFileSectionEntry*> mapIndex2MSFileSectionEntry;
+    for (const auto& h : consensus.getColumnHeaders())
+    {
+      //TODO MULTIPLEXED: needs to be adapted for multiplexed experiments
+      const String c_fn = FileHandler::stripExtension(File::basename(h.second.filename)); // filename according to experimental design in consensus map
+      const size_t c_lab = h.second.getLabelAsUInt(consensus.getExperimentType());
+
+      // find entry in experimental design (ignore extension and folder) that corresponds to current column header entry
+      if (auto it = fileAndLabel2MSFileSectionEntry.find(c_fn + String(c_lab)); it != fileAndLabel2MSFileSectionEntry.end())
+      {
+        mapIndex2MSFileSectionEntry[h.first] = &it->second;
+      }
+    }
+
     for (auto & c : consensus)
     {
       stats_.total_features += c.getFeatures().size();
@@ -692,23 +735,24 @@ namespace OpenMS
 
       countPeptides_(c.getPeptideIdentifications());
       PeptideHit hit = getAnnotation_(c.getPeptideIdentifications());
+      // skip if annotation for the feature is ambiguous or missing
+      if (hit == PeptideHit()) { continue; }
+
+      PeptideData& data = pep_quant_[hit.getSequence()];
       for (auto const & f : c.getFeatures())
       {
-        //TODO MULTIPLEXED: needs to be adapted for multiplexed experiments
         size_t row = f.getMapIndex();
-        const auto& h = consensus.getColumnHeaders().at(row);
-        const String c_fn = FileHandler::stripExtension(File::basename(h.filename)); // filename according to experimental design in consensus map
-        const size_t c_lab = h.getLabelAsUInt(consensus.getExperimentType());
-
-        // find entry in experimental design (ignore extension and folder) that corresponds to current column header entry
-        if (auto it = fileAndLabel2MSFileSectionEntry.find(c_fn + String(c_lab)); it != fileAndLabel2MSFileSectionEntry.end())
+        if (auto it = mapIndex2MSFileSectionEntry.find(row); it != mapIndex2MSFileSectionEntry.end())
         {
-          const size_t fraction = it->second.fraction;
-          const size_t sample = it->second.sample;
-          quantifyFeature_(f, fraction, sample, hit); // updates "stats_.quant_features"          
+          const size_t fraction = it->second->fraction;
+          const size_t sample = it->second->sample;
+          quantifyFeature_(f, fraction, sample, hit, data); // updates "stats_.quant_features"
         }
         else
         {
+          const auto& h = consensus.getColumnHeaders().at(row);
+          const String c_fn = FileHandler::stripExtension(File::basename(h.filename));
+          const size_t c_lab = h.getLabelAsUInt(consensus.getExperimentType());
           OPENMS_LOG_FATAL_ERROR << "File+Label referenced in consensus header not found in experimental design.\n"  
                                  << "File+Label:" << c_fn << "\t" << c_lab << std::endl;
         }
@@ -762,6 +806,10 @@ namespace OpenMS
       OPENMS_LOG_DEBUG << "  run index : MS file " << i << " : " << ListUtils::concatenate(ms_files, ", ") << endl;
     }
 
+    // experimental design entry of each MS file (looked up once per file)
+    const ExperimentalDesign::MSFileSection& run_section = ed.getMSFileSection();
+    std::unordered_map<String, ExperimentalDesign::MSFileSection::const_iterator> ms_file_to_row;
+
     for (auto & p : peptides)
     {
       if (p.getHits().empty()) { continue; }
@@ -776,12 +824,18 @@ namespace OpenMS
       const String& ms_file_path = identifier_idmergeidx_to_ms_file[{p.getIdentifier(),id_merge_idx}];
 
       // determine sample and fraction by MS file name (stored in protein identification)
-      const ExperimentalDesign::MSFileSection& run_section = ed.getMSFileSection();
-      auto row = find_if(begin(run_section), end(run_section), 
-        [&ms_file_path](const ExperimentalDesign::MSFileSectionEntry& r)
-          { 
-            return File::basename(r.path) == File::basename(ms_file_path); 
-          });
+      auto cached = ms_file_to_row.find(ms_file_path);
+      if (cached == ms_file_to_row.end())
+      {
+        const String ms_file_basename = File::basename(ms_file_path);
+        auto found = find_if(begin(run_section), end(run_section), 
+          [&ms_file_basename](const ExperimentalDesign::MSFileSectionEntry& r)
+            { 
+              return File::basename(r.path) == ms_file_basename; 
+            });
+        cached = ms_file_to_row.emplace(ms_file_path, found).first;
+      }
+      auto row = cached->second;
 
       if (row == end(run_section))
       {
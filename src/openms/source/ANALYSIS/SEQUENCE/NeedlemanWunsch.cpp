@@ -10,7 +10,11 @@
 
 #include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
+#include <OpenMS/SYSTEM/SIMDe.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 #include <utility>
 
 using namespace std;
@@ -146,15 +150,136 @@ namespace OpenMS
 
     for (unsigned i = 1;i <= seq1_len; ++i)
     {
-      (*p_secondrow) = i * (-gap_penalty_); // the first value in a row
+      // substitution scores of the current residue of seq1 (row lookup only once per row)
+      const int* scores = (*matrix_ptr)[seq1[i-1] - 'A'];
+      int left = i * (-gap_penalty_); // the first value in a row
+      (*p_secondrow) = left;
       for (unsigned j = 1; j <= seq2_len; ++j)
       {
-        (*(p_secondrow+j)) = max(max(((*(p_secondrow+j-1)) - gap_penalty_), ((*(p_firstrow+j)) - gap_penalty_)),
-                                  ((*(p_firstrow+j-1)) + (*matrix_ptr)[seq1[i-1] - 'A'] [seq2[j-1] - 'A']));
+        // keep the value to the left in a register instead of reloading it
+        left = max(max(left - gap_penalty_, (*(p_firstrow+j)) - gap_penalty_),
+                   (*(p_firstrow+j-1)) + scores[seq2[j-1] - 'A']);
+        (*(p_secondrow+j)) = left;
       }
       swap(p_firstrow, p_secondrow);
     }
     return (*(p_firstrow + seq2_len));
   }
 
+  /// true if all residues of @p seq have a valid (not INT16_MAX) score in @p matrix
+  static bool hasValidScores_(const String& seq, const int (&matrix)[26][26])
+  {
+    for (const char c : seq)
+    {
+      if (c < 'A' || c > 'Z' || matrix[c - 'A'][c - 'A'] == INT16_MAX) return false;
+    }
+    return true;
+  }
+
+  std::vector<int> NeedlemanWunsch::align(const String& seq1, const std::vector<String>& seqs2)
+  {
+    constexpr Size lanes = 8; // 16 bit scores in a 128 bit register
+    std::vector<int> result(seqs2.size());
+    const int (&matrix)[26][26] = matrices[static_cast<int>(my_matrix_)];
+
+    // largest change of a score in one step of the recursion (substitution or gap):
+    long long max_step = std::llabs(static_cast<long long>(gap_penalty_));
+    for (Size a = 0; a < 26; ++a)
+    {
+      for (Size b = 0; b < 26; ++b)
+      {
+        if (matrix[a][b] != INT16_MAX) max_step = std::max(max_step, std::llabs(static_cast<long long>(matrix[a][b])));
+      }
+    }
+
+    // sequences that can be aligned with 16 bit scores (every cell is reached in at most len1 + len2 steps):
+    std::vector<Size> vectorized;
+    const bool query_valid = hasValidScores_(seq1, matrix);
+    for (Size k = 0; k < seqs2.size(); ++k)
+    {
+      if (query_valid && hasValidScores_(seqs2[k], matrix) &&
+          (static_cast<long long>(seq1.size() + seqs2[k].size()) + 2) * max_step <= INT16_MAX)
+      {
+        vectorized.push_back(k);
+      }
+      else
+      {
+        result[k] = align(seq1, seqs2[k]);
+      }
+    }
+    if (vectorized.empty()) return result;
+
+    // similar lengths in one batch keep the lanes busy:
+    std::stable_sort(vectorized.begin(), vectorized.end(),
+                     [&seqs2](Size a, Size b) { return seqs2[a].size() < seqs2[b].size(); });
+
+    const Size len1 = seq1.size();
+    std::vector<simde__m128i> column(len1 + 1); // scores of the current row (over the positions of seq1)
+    std::vector<simde__m128i> profile(26); // substitution scores of the current residues of the batch, per residue of seq1
+    std::vector<int16_t> profile_values(26 * lanes);
+    std::vector<Size> query(len1);
+    for (Size i = 0; i < len1; ++i) query[i] = seq1[i] - 'A';
+    const simde__m128i gap = simde_mm_set1_epi16(static_cast<int16_t>(gap_penalty_));
+    alignas(16) int16_t last[lanes];
+
+    for (Size start = 0; start < vectorized.size(); start += lanes)
+    {
+      const Size batch_size = std::min(lanes, vectorized.size() - start);
+      const String* batch[lanes];
+      Size lengths[lanes];
+      for (Size k = 0; k < lanes; ++k)
+      {
+        batch[k] = (k < batch_size) ? &seqs2[vectorized[start + k]] : nullptr;
+        lengths[k] = (k < batch_size) ? batch[k]->size() : 0;
+      }
+      const Size max_len = lengths[batch_size - 1];
+
+      for (Size i = 0; i <= len1; ++i) // initialize using gap-penalty
+      {
+        column[i] = simde_mm_set1_epi16(static_cast<int16_t>(i * (-gap_penalty_)));
+      }
+      Size next = 0; // next lane whose alignment is complete (lanes are sorted by length)
+      for (Size j = 0; ; ++j)
+      {
+        if (next < batch_size && lengths[next] == j)
+        {
+          simde_mm_store_si128(reinterpret_cast<simde__m128i*>(last), column[len1]);
+          while (next < batch_size && lengths[next] == j)
+          {
+            result[vectorized[start + next]] = last[next];
+            ++next;
+          }
+        }
+        if (j == max_len) break;
+
+        // substitution scores of residue j of each sequence in the batch (zero for finished lanes):
+        for (Size k = 0; k < lanes; ++k)
+        {
+          const Size b = (j < lengths[k]) ? Size((*batch[k])[j] - 'A') : 26;
+          for (Size a = 0; a < 26; ++a)
+          {
+            profile_values[a * lanes + k] = (b < 26) ? static_cast<int16_t>(matrix[a][b]) : int16_t(0);
+          }
+        }
+        for (Size a = 0; a < 26; ++a)
+        {
+          profile[a] = simde_mm_loadu_si128(reinterpret_cast<const simde__m128i*>(&profile_values[a * lanes]));
+        }
+
+        simde__m128i diag = column[0];
+        simde__m128i left = simde_mm_set1_epi16(static_cast<int16_t>((j + 1) * (-gap_penalty_)));
+        column[0] = left;
+        for (Size i = 1; i <= len1; ++i)
+        {
+          const simde__m128i up = column[i];
+          left = simde_mm_max_epi16(simde_mm_adds_epi16(diag, profile[query[i - 1]]),
+                                    simde_mm_max_epi16(simde_mm_subs_epi16(up, gap), simde_mm_subs_epi16(left, gap)));
+          column[i] = left;
+          diag = up;
+        }
+      }
+    }
+    return result;
+  }
+
 }
@@ -196,9 +196,13 @@ namespace OpenMS
   // generate filters
   void FLASHDeconvAlgorithm::setFilters_()
   {
+    int charge_range = current_max_charge_;
+    if ((int)filter_.size() >= charge_range)
+    {
+      return; // the patterns of the first charge_range charges are already there
+    }
     filter_.clear();
 
-    int charge_range = current_max_charge_;
     for (int i = 0; i < charge_range; i++)
     {
       filter_.push_back(-log(i + 1)); //+
@@ -304,15 +308,18 @@ namespace OpenMS
     size_t h_charge_size = harmonic_charges_.size();
     long bin_end = (long)mass_bins_.size();
 
-    auto support_peak_count = std::vector<unsigned short>(mass_bins_.size(), 0); // per mass bin how many peaks are present
+    auto& support_peak_count = support_peak_count_; // per mass bin how many peaks are present
+    support_peak_count.assign(mass_bins_.size(), 0);
 
     // to calculate continuous charges, the previous charge value per mass should be stored
-    auto prev_charges = std::vector<unsigned short>(mass_bins_.size(), charge_range + 2);
+    auto& prev_charges = prev_charges_;
+    prev_charges.assign(mass_bins_.size(), charge_range + 2);
 
     // not just charges but intensities are stored to see the intensity fold change
-    auto prev_intensities = std::vector<float>(mass_bins_.size(), 1.0f);
+    auto& prev_intensities = prev_intensities_;
+    prev_intensities.assign(mass_bins_.size(), 1.0f);
 
-    mass_intensities = std::vector<float>(mass_bins_.size(), .0f);
+    mass_intensities.assign(mass_bins_.size(), .0f);
 
     double bin_mul_factor = bin_mul_factors_[ms_level_ - 1];
     std::vector<float> sub_max_h_intensity(h_charge_size, .0f);
@@ -389,9 +396,10 @@ namespace OpenMS
             bool iso_exist = false;
             double diff = d * iso_da_distance_ / abs_charge / mz;
             int next_iso_bin = 0;
+            const int iso_bin = (int)getBinNumber_(log_mz + diff, mz_bin_min_value_, bin_mul_factor);
             for (int t = -1; t < 2; t++)
             {
-              int nib = (int)getBinNumber_(log_mz + diff, mz_bin_min_value_, bin_mul_factor) + t;
+              int nib = iso_bin + t;
               if (nib != (int)mz_bin_index && nib > 0 && nib < (int)mz_bins_.size() && mz_bins_[nib])
               {
                 iso_exist = true;
@@ -419,11 +427,12 @@ namespace OpenMS
                 }
 
                 double hdiff = diff / hc;
+                const int harmonic_iso_bin = (int)getBinNumber_(log_mz + hdiff, mz_bin_min_value_, bin_mul_factor);
 
                 // check if there are harmonic peaks between the current peak and the next isotope peak.
                 for (int t = -1; t < 2; t++)
                 {
-                  int next_harmonic_iso_bin = (int)getBinNumber_(log_mz + hdiff, mz_bin_min_value_, bin_mul_factor) + t;
+                  int next_harmonic_iso_bin = harmonic_iso_bin + t;
 
                   // no perfect filtration. Just obvious ones are filtered out by checking if a peak is in the harmonic position and the intensity ratio is within two folds from the current peak
                   // (specified by mz_bin_index)
@@ -636,10 +645,9 @@ namespace OpenMS
   // update mass bins which will be used to select peaks in the input spectrum...
   Matrix<int> FLASHDeconvAlgorithm::updateMassBins_(const std::vector<float>& mz_intensities)
   {
-    std::vector<float> mass_intensities;
-    updateCandidateMassBins_(mass_intensities, mz_intensities);
+    updateCandidateMassBins_(mass_intensities_, mz_intensities);
 
-    auto per_mass_abs_charge_ranges = filterMassBins_(mass_intensities);
+    auto per_mass_abs_charge_ranges = filterMassBins_(mass_intensities_);
 
     return per_mass_abs_charge_ranges;
   }
@@ -29,15 +29,64 @@ using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    // does at least one of the tags (or its reverse) occur in one of the two sequences?
+    bool matchesTags_(const OPXLDataStructs::XLPrecursor& candidate, const std::vector<std::string>& tags)
+    {
+      // iterate over copies, so that we can reverse them
+      for (std::string tag : tags)
+      {
+        if (candidate.alpha_seq.hasSubstring(tag) || candidate.beta_seq.hasSubstring(tag))
+        {
+          return true;
+        }
+        std::reverse(tag.begin(), tag.end());
+        if (candidate.alpha_seq.hasSubstring(tag) || candidate.beta_seq.hasSubstring(tag))
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+  }
+
   vector<OPXLDataStructs::XLPrecursor> OPXLHelper::enumerateCrossLinksAndMasses(const vector<OPXLDataStructs::AASeqWithMass>& peptides, double cross_link_mass, const DoubleList& cross_link_mass_mono_link, const StringList& cross_link_residue1, const StringList& cross_link_residue2, const vector< double >& spectrum_precursors, vector< int >& precursor_correction_positions, double precursor_mass_tolerance, bool precursor_mass_tolerance_unit_ppm)
   {
     // initialize empty vector for the results
     vector<OPXLDataStructs::XLPrecursor> mass_to_candidates;
 
+    enumerateCrossLinksAndMasses(peptides, cross_link_mass, cross_link_mass_mono_link, cross_link_residue1, cross_link_residue2, spectrum_precursors, precursor_mass_tolerance, precursor_mass_tolerance_unit_ppm,
+      [&](const OPXLDataStructs::XLPrecursor& precursor, int pm)
+      {
+        mass_to_candidates.push_back(precursor);
+        precursor_correction_positions.push_back(pm);
+      });
+    return mass_to_candidates;
+  }
+
+  void OPXLHelper::enumerateCrossLinksAndMasses(const vector<OPXLDataStructs::AASeqWithMass>& peptides, double cross_link_mass, const DoubleList& cross_link_mass_mono_link, const StringList& cross_link_residue1, const StringList& cross_link_residue2, const vector< double >& spectrum_precursors, double precursor_mass_tolerance, bool precursor_mass_tolerance_unit_ppm, const std::function<void(const OPXLDataStructs::XLPrecursor&, int)>& callback)
+  {
+    if (peptides.empty() || spectrum_precursors.empty())
+    {
+      return;
+    }
+
     double max_precursor = spectrum_precursors[spectrum_precursors.size()-1];
 
     Size peptides_size = peptides.size();
 
+    // residues (one-letter codes) the two sides of the linker can attach to, for the loop-link test
+    std::vector<bool> first_residues(256, false), second_residues(256, false);
+    for (const String& res : cross_link_residue1)
+    {
+      if (res.size() == 1) first_residues[static_cast<unsigned char>(res[0])] = true;
+    }
+    for (const String& res : cross_link_residue2)
+    {
+      if (res.size() == 1) second_residues[static_cast<unsigned char>(res[0])] = true;
+    }
+
     // compute a very conservative total upper bound, based on the heaviest possible linear peptide
     // can be used instead of peptides.end() in all cases for this precursor mass
     vector<OPXLDataStructs::AASeqWithMass>::const_iterator conservative_upper_bound = upper_bound(peptides.cbegin(), peptides.cend(), max_precursor, OPXLDataStructs::AASeqWithMassComparator());
@@ -53,6 +102,8 @@ namespace OpenMS
 
     vector<OPXLDataStructs::AASeqWithMass>::const_iterator last_alpha = peptides.cbegin();
 
+    OPXLDataStructs::XLPrecursor precursor;
+
     for (Size pm = 0; pm < spectrum_precursors.size(); ++pm)
     {
       double precursor_mass = spectrum_precursors[pm];
@@ -75,55 +126,35 @@ namespace OpenMS
       first_loop = lower_bound(first_loop, conservative_upper_bound, min_peptide_mass, OPXLDataStructs::AASeqWithMassComparator());
       last_loop = upper_bound(last_loop, conservative_upper_bound, max_peptide_mass, OPXLDataStructs::AASeqWithMassComparator());
 
-      int first_index = first_loop - peptides.cbegin();
-      int last_index = last_loop - peptides.cbegin();
+      Size first_index = first_loop - peptides.cbegin();
+      Size last_index = last_loop - peptides.cbegin();
 
-#pragma omp parallel for
-      for (int p1 = first_index; p1 < last_index; ++p1)
+      for (Size p1 = first_index; p1 < last_index; ++p1)
       {
         const String& seq_first = peptides[p1].unmodified_seq;
         // test if this peptide could have loop-links: one cross-link with both sides attached to the same peptide
         bool first_res = false; // is there a residue the first side of the linker can attach to?
         bool second_res = false; // is there a residue the second side of the linker can attach to?
-        for (Size k = 0; k < seq_first.size()-1; ++k)
+        for (Size k = 0; k + 1 < seq_first.size(); ++k)
         {
-         for (Size i = 0; i < cross_link_residue1.size(); ++i)
-         {
-           if (cross_link_residue1[i].size() == 1 && string(1, seq_first[k]) == cross_link_residue1[i])
-           {
-             first_res = true;
-           }
-         }
-         for (Size i = 0; i < cross_link_residue2.size(); ++i)
-         {
-           if (cross_link_residue2[i].size() == 1 && string(1, seq_first[k]) == cross_link_residue2[i])
-           {
-             second_res = true;
-           }
-         }
+          const unsigned char aa = static_cast<unsigned char>(seq_first[k]);
+          first_res = first_res || first_residues[aa];
+          second_res = second_res || second_residues[aa];
         }
 
         // If both sides of a cross-linker can link to this peptide, generate the loop-link
         if (first_res && second_res)
         {
-         // Monoisotopic weight of the peptide + cross-linker
-         double cross_linked_peptide_mass = peptides[p1].peptide_mass + cross_link_mass;
-
-         // also only one peptide
-         OPXLDataStructs::XLPrecursor precursor;
-         precursor.precursor_mass = cross_linked_peptide_mass;
-         precursor.alpha_index = p1;
-         precursor.beta_index = peptides_size + 1; // an out-of-range index to represent an empty index
-         precursor.alpha_seq = seq_first;
-         precursor.beta_seq = "";
-
-#pragma omp critical (mass_to_candidates_access)
-         {
-           mass_to_candidates.push_back(precursor);
-           precursor_correction_positions.push_back(pm);
-         }
+          // Monoisotopic weight of the peptide + cross-linker
+          precursor.precursor_mass = peptides[p1].peptide_mass + cross_link_mass;
+          // also only one peptide
+          precursor.alpha_index = p1;
+          precursor.beta_index = peptides_size + 1; // an out-of-range index to represent an empty index
+          precursor.alpha_seq = seq_first;
+          precursor.beta_seq = "";
+          callback(precursor, static_cast<int>(pm));
         }
-      } // end of parallel loop over loop-link candidates
+      } // end of loop over loop-link candidates
 
       // ################################ Enumerate Mono-Links #################
       for (Size i = 0; i < cross_link_mass_mono_link.size(); i++)
@@ -141,25 +172,16 @@ namespace OpenMS
         first_index = first_mono - peptides.cbegin();
         last_index = last_mono - peptides.cbegin();
 
-#pragma omp parallel for
-        for (int p1 = first_index; p1 < last_index; ++p1)
+        for (Size p1 = first_index; p1 < last_index; ++p1)
         {
           // Monoisotopic weight of the peptide + cross-linker
-          double cross_linked_peptide_mass = peptides[p1].peptide_mass + mono_link_mass;
-
+          precursor.precursor_mass = peptides[p1].peptide_mass + mono_link_mass;
           // Make sure it is clear only one peptide is considered here. Use an out-of-range value for the second peptide.
-          OPXLDataStructs::XLPrecursor precursor;
-          precursor.precursor_mass = cross_linked_peptide_mass;
           precursor.alpha_index = p1;
           precursor.beta_index = peptides_size + 1; // an out-of-range index to represent an empty index
           precursor.alpha_seq = peptides[p1].unmodified_seq;
           precursor.beta_seq = "";
-
-#pragma omp critical (mass_to_candidates_access)
-         {
-           mass_to_candidates.push_back(precursor);
-           precursor_correction_positions.push_back(pm);
-         }
+          callback(precursor, static_cast<int>(pm));
         } // end of loop over candidates for a specific mono-link mass
       } // end of loop over mono-link masses
 
@@ -169,49 +191,46 @@ namespace OpenMS
       // maximal mass: difference between precursor mass and the smallest peptide + cross-linker
       max_peptide_mass = precursor_mass - cross_link_mass - peptides[0].peptide_mass + allowed_error;
       last_alpha = upper_bound(last_alpha, conservative_upper_bound, max_peptide_mass, OPXLDataStructs::AASeqWithMassComparator());
-      int last_alpha_index = last_alpha - peptides.cbegin();
-
-#pragma omp parallel for
-      for (int p1 = 0; p1 < last_alpha_index; ++p1)
+      Size last_alpha_index = last_alpha - peptides.cbegin();
+
+      // As the alpha mass increases, the window of matching beta masses moves to lighter peptides,
+      // so both of its borders only ever move down: first_beta is the first peptide not lighter than the window,
+      // last_beta the first peptide heavier than the window (within [0, last_alpha_index)).
+      Size first_beta = last_alpha_index;
+      Size last_beta = last_alpha_index;
+      for (Size p1 = 0; p1 < last_alpha_index; ++p1)
       {
         // Constrain search for beta
         double min_peptide_mass_beta = precursor_mass - cross_link_mass - peptides[p1].peptide_mass - allowed_error;
         double max_peptide_mass_beta = precursor_mass - cross_link_mass - peptides[p1].peptide_mass + allowed_error;
 
-        // the last_alpha upper bound is also a conservative upper bound here
-        vector<OPXLDataStructs::AASeqWithMass>::const_iterator first_beta = lower_bound(peptides.cbegin()+p1, last_alpha, min_peptide_mass_beta, OPXLDataStructs::AASeqWithMassComparator());
-        vector<OPXLDataStructs::AASeqWithMass>::const_iterator last_beta = upper_bound(peptides.cbegin()+p1, last_alpha, max_peptide_mass_beta, OPXLDataStructs::AASeqWithMassComparator());
-
-        if (first_beta == last_beta)
+        while (last_beta > 0 && peptides[last_beta - 1].peptide_mass > max_peptide_mass_beta)
         {
-          continue;
+          --last_beta;
+        }
+        // the beta peptide is never lighter than the alpha peptide, so no later alpha can have betas
+        if (last_beta <= p1)
+        {
+          break;
+        }
+        while (first_beta > 0 && !(peptides[first_beta - 1].peptide_mass < min_peptide_mass_beta))
+        {
+          --first_beta;
         }
 
-        Size first_beta_index = first_beta - peptides.begin();
-        Size last_beta_index = last_beta - peptides.begin();
-
-        for (Size p2 = first_beta_index; p2 < last_beta_index; ++p2)
+        for (Size p2 = max(first_beta, p1); p2 < last_beta; ++p2)
         {
           // Monoisotopic weight of the first peptide + the second peptide + cross-linker
-          double cross_linked_pair_mass = peptides[p1].peptide_mass + peptides[p2].peptide_mass + cross_link_mass;
-
+          precursor.precursor_mass = peptides[p1].peptide_mass + peptides[p2].peptide_mass + cross_link_mass;
           // this time both peptides have valid indices
-          OPXLDataStructs::XLPrecursor precursor;
-          precursor.precursor_mass = cross_linked_pair_mass;
           precursor.alpha_index = p1;
           precursor.beta_index = p2;
           precursor.alpha_seq = peptides[p1].unmodified_seq;
           precursor.beta_seq = peptides[p2].unmodified_seq;
-
-#pragma omp critical (mass_to_candidates_access)
-         {
-           mass_to_candidates.push_back(precursor);
-           precursor_correction_positions.push_back(pm);
-         }
+          callback(precursor, static_cast<int>(pm));
         } // end of loop over betas
-      } // end of parallel loop over alphas
+      } // end of loop over alphas
     } // end of loop over precursor masses
-    return mass_to_candidates;
   }
 
   std::vector<OPXLDataStructs::AASeqWithMass> OPXLHelper::digestDatabase(
@@ -1331,17 +1350,24 @@ namespace OpenMS
 
     std::vector< int > precursor_correction_positions;
     // if sequence tags are used and no tags were found, don't bother combining peptide pairs
-    if ( (use_sequence_tags && !tags.empty()) ||
-         !use_sequence_tags)
+    if (!use_sequence_tags)
     {
       candidates = OPXLHelper::enumerateCrossLinksAndMasses(filtered_peptide_masses, cross_link_mass, cross_link_mass_mono_link, cross_link_residue1, cross_link_residue2, spectrum_precursor_vector, precursor_correction_positions, precursor_mass_tolerance, precursor_mass_tolerance_unit_ppm);
     }
-
-    // an empty vector of sequence tags implies no filtering should be done in this case
-    if (use_sequence_tags)
+    else if (!tags.empty())
     {
-      Size candidates_size = candidates.size();
-      OPXLHelper::filterPrecursorsByTags(candidates, precursor_correction_positions, tags);
+      // filter by the sequence tags during the enumeration, so that rejected candidates are never stored
+      Size candidates_size = 0;
+      OPXLHelper::enumerateCrossLinksAndMasses(filtered_peptide_masses, cross_link_mass, cross_link_mass_mono_link, cross_link_residue1, cross_link_residue2, spectrum_precursor_vector, precursor_mass_tolerance, precursor_mass_tolerance_unit_ppm,
+        [&](const OPXLDataStructs::XLPrecursor& precursor, int pm)
+        {
+          ++candidates_size;
+          if (matchesTags_(precursor, tags))
+          {
+            candidates.push_back(precursor);
+            precursor_correction_positions.push_back(pm);
+          }
+        });
 
       OPENMS_LOG_DEBUG << "Number of sequence tags: " << tags.size() << std::endl;
       OPENMS_LOG_DEBUG << "Candidate Peptide Pairs before sequence tag filtering: " << candidates_size << std::endl;
@@ -1405,35 +1431,23 @@ namespace OpenMS
     std::vector< int > filtered_precursor_correction_positions;
 
     // brute force string comparisons for now, faster than Aho-Corasick for small tag sets
+    std::vector<char> keep(candidates.size(), 0);
 #pragma omp parallel for
     for (int i = 0; i < static_cast<int>(candidates.size()); ++i)
     {
-      // iterate over copies, so that we can reverse them
-      for (std::string tag : tags)
-      {
-        if (candidates[i].alpha_seq.hasSubstring(tag) || candidates[i].beta_seq.hasSubstring(tag))
-        {
- #pragma omp critical (filtered_candidates_access)
-          {
-            filtered_candidates.push_back(candidates[i]);
-            filtered_precursor_correction_positions.push_back(precursor_correction_positions[i]);
-          }
-          break;
-        }
+      keep[i] = matchesTags_(candidates[i], tags);
+    } // end of parallel loop over candidates
 
-        std::reverse(tag.begin(), tag.end());
-        if (candidates[i].alpha_seq.hasSubstring(tag) || candidates[i].beta_seq.hasSubstring(tag))
-        {
- #pragma omp critical (filtered_candidates_access)
-          {
-            filtered_candidates.push_back(candidates[i]);
-            filtered_precursor_correction_positions.push_back(precursor_correction_positions[i]);
-          }
-          break;
-        }
+    // keep the candidates in their original order
+    for (Size i = 0; i < candidates.size(); ++i)
+    {
+      if (keep[i])
+      {
+        filtered_candidates.push_back(std::move(candidates[i]));
+        filtered_precursor_correction_positions.push_back(precursor_correction_positions[i]);
       }
-    } // end of parallel loop over candidates
-    candidates = filtered_candidates;
-    precursor_correction_positions = filtered_precursor_correction_positions;
+    }
+    candidates = std::move(filtered_candidates);
+    precursor_correction_positions = std::move(filtered_precursor_correction_positions);
   }
 }
@@ -25,6 +25,9 @@
 #include <OpenMS/PROCESSING/CENTROIDING/PeakPickerHiRes.h>
 
 #include <iostream>
+#include <limits>
+#include <map>
+#include <tuple>
 
 using namespace std;
 using namespace OpenMS;
@@ -36,6 +39,19 @@ using namespace OpenMS;
 #include <omp.h>
 #endif
 
+namespace
+{
+  /// Key of a linear ion spectrum: peptide, link position and second link position (loop-links only)
+  typedef std::tuple<const AASequence*, SignedSize, Size> LinearIonKey_;
+
+  /// Linear ion spectrum of a peptide with fixed link position(s) and its alignment to the experimental spectrum
+  struct LinearIonMatch_
+  {
+    std::vector< SimpleTSGXLMS::SimplePeak > theoretical_spec;
+    std::vector< std::pair< Size, Size > > matched_spec;
+  };
+}
+
   OpenPepXLLFAlgorithm::OpenPepXLLFAlgorithm()
     : DefaultParamHandler("OpenPepXLLFAlgorithm")
   {
@@ -411,14 +427,60 @@ using namespace OpenMS;
       vector< OPXLDataStructs::CrossLinkSpectrumMatch > all_csms_spectrum;
       vector< OPXLDataStructs::CrossLinkSpectrumMatch > mainscore_csms_spectrum;
 
+      PeakSpectrum::IntegerDataArray exp_charges;
+      if (!spectrum.getIntegerDataArrays().empty())
+      {
+        exp_charges = spectrum.getIntegerDataArrays()[0];
+      }
+
+      // The linear ion spectra only depend on a peptide and its link position(s), not on the linked partner peptide.
+      // Index the distinct (peptide, link position) combinations of all candidates, so that their theoretical spectra
+      // and alignments are computed once for this spectrum instead of once for every pairing.
+      map< LinearIonKey_, Size > linear_ion_index;
+      vector< Size > linear_alpha_index(cross_link_candidates.size());
+      vector< Size > linear_beta_index(cross_link_candidates.size(), std::numeric_limits< Size >::max());
+      for (Size i = 0; i < cross_link_candidates.size(); ++i)
+      {
+        const OPXLDataStructs::ProteinProteinCrossLink& cross_link_candidate = cross_link_candidates[i];
+        OPXLDataStructs::ProteinProteinCrossLinkType type = cross_link_candidate.getType();
+        Size link_pos_B = 0;
+        if (type == OPXLDataStructs::LOOP)
+        {
+          link_pos_B = cross_link_candidate.cross_link_position.second;
+        }
+        LinearIonKey_ key_alpha(cross_link_candidate.alpha, cross_link_candidate.cross_link_position.first, link_pos_B);
+        linear_alpha_index[i] = linear_ion_index.emplace(key_alpha, linear_ion_index.size()).first->second;
+        if (type == OPXLDataStructs::CROSS)
+        {
+          LinearIonKey_ key_beta(cross_link_candidate.beta, cross_link_candidate.cross_link_position.second, 0);
+          linear_beta_index[i] = linear_ion_index.emplace(key_beta, linear_ion_index.size()).first->second;
+        }
+      }
+      vector< const LinearIonKey_* > linear_ion_keys(linear_ion_index.size());
+      for (const auto& entry : linear_ion_index)
+      {
+        linear_ion_keys[entry.second] = &entry.first;
+      }
+
+      vector< LinearIonMatch_ > linear_ion_matches(linear_ion_keys.size());
+#pragma omp parallel for schedule(guided)
+      for (SignedSize k = 0; k < static_cast<SignedSize>(linear_ion_keys.size()); ++k)
+      {
+        const LinearIonKey_& key = *linear_ion_keys[k];
+        AASequence peptide;
+        if (std::get<0>(key)) { peptide = *std::get<0>(key); }
+        LinearIonMatch_& linear_ions = linear_ion_matches[k];
+        linear_ions.theoretical_spec.reserve(1500);
+        specGen_mainscore.getLinearIonSpectrum(linear_ions.theoretical_spec, peptide, std::get<1>(key), 2, std::get<2>(key));
+        OPXLSpectrumProcessingAlgorithms::getSpectrumAlignmentSimple(linear_ions.matched_spec, fragment_mass_tolerance_, fragment_mass_tolerance_unit_ppm_, linear_ions.theoretical_spec, spectrum, exp_charges);
+      }
+      const LinearIonMatch_ no_linear_ions;
+
 #pragma omp parallel for schedule(guided)
       for (SignedSize i = 0; i < static_cast<SignedSize>(cross_link_candidates.size()); ++i)
       {
         OPXLDataStructs::ProteinProteinCrossLink cross_link_candidate = cross_link_candidates[i];
 
-        std::vector< SimpleTSGXLMS::SimplePeak > theoretical_spec_linear_alpha;
-        theoretical_spec_linear_alpha.reserve(1500);
-        std::vector< SimpleTSGXLMS::SimplePeak > theoretical_spec_linear_beta;
         std::vector< SimpleTSGXLMS::SimplePeak > theoretical_spec_xlinks_alpha;
         std::vector< SimpleTSGXLMS::SimplePeak > theoretical_spec_xlinks_beta;
 
@@ -430,16 +492,12 @@ using namespace OpenMS;
           link_pos_B = cross_link_candidate.cross_link_position.second;
         }
         AASequence alpha;
-        AASequence beta;
         if (cross_link_candidate.alpha) { alpha = *cross_link_candidate.alpha; }
-        if (cross_link_candidate.beta) { beta = *cross_link_candidate.beta; }
 
-        specGen_mainscore.getLinearIonSpectrum(theoretical_spec_linear_alpha, alpha, cross_link_candidate.cross_link_position.first, 2, link_pos_B);
-        if (type_is_cross_link)
-        {
-          theoretical_spec_linear_beta.reserve(1500);
-          specGen_mainscore.getLinearIonSpectrum(theoretical_spec_linear_beta, beta, cross_link_candidate.cross_link_position.second, 2);
-        }
+        const LinearIonMatch_& linear_alpha = linear_ion_matches[linear_alpha_index[i]];
+        const LinearIonMatch_& linear_beta = type_is_cross_link ? linear_ion_matches[linear_beta_index[i]] : no_linear_ions;
+        const std::vector< SimpleTSGXLMS::SimplePeak >& theoretical_spec_linear_alpha = linear_alpha.theoretical_spec;
+        const std::vector< SimpleTSGXLMS::SimplePeak >& theoretical_spec_linear_beta = linear_beta.theoretical_spec;
 
         // Something like this can happen, e.g. with a loop link connecting the first and last residue of a peptide
         if ( theoretical_spec_linear_alpha.empty() )
@@ -447,19 +505,11 @@ using namespace OpenMS;
           continue;
         }
 
-        vector< pair< Size, Size > > matched_spec_linear_alpha;
-        vector< pair< Size, Size > > matched_spec_linear_beta;
+        const vector< pair< Size, Size > >& matched_spec_linear_alpha = linear_alpha.matched_spec;
+        const vector< pair< Size, Size > >& matched_spec_linear_beta = linear_beta.matched_spec;
         vector< pair< Size, Size > > matched_spec_xlinks_alpha;
         vector< pair< Size, Size > > matched_spec_xlinks_beta;
 
-        PeakSpectrum::IntegerDataArray exp_charges;
-        if (!spectrum.getIntegerDataArrays().empty())
-        {
-          exp_charges = spectrum.getIntegerDataArrays()[0];
-        }
-        OPXLSpectrumProcessingAlgorithms::getSpectrumAlignmentSimple(matched_spec_linear_alpha, fragment_mass_tolerance_, fragment_mass_tolerance_unit_ppm_, theoretical_spec_linear_alpha, spectrum, exp_charges);
-        OPXLSpectrumProcessingAlgorithms::getSpectrumAlignmentSimple(matched_spec_linear_beta, fragment_mass_tolerance_, fragment_mass_tolerance_unit_ppm_, theoretical_spec_linear_beta, spectrum, exp_charges);
-
         // drop candidates with almost no linear fragment peak matches before making the more complex theoretical spectra and aligning them
         // this removes hits that no one would trust after manual validation anyway and reduces time wasted on really bad spectra or candidates without any matching peaks
         if (matched_spec_linear_alpha.size() < 2 || (type_is_cross_link && matched_spec_linear_beta.size() < 2) )
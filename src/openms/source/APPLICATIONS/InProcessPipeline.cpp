@@ -0,0 +1,85 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/APPLICATIONS/InProcessPipeline.h>
+
+#include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/FORMAT/InMemoryFileStore.h>
+
+#include <map>
+
+using namespace std;
+
+namespace OpenMS
+{
+  void InProcessPipeline::addStep(const String& name, const ToolFactory& factory, const StringList& arguments)
+  {
+    steps_.push_back(Step{name, factory, arguments});
+  }
+
+  Size InProcessPipeline::size() const
+  {
+    return steps_.size();
+  }
+
+  TOPPBase::ExitCodes InProcessPipeline::run()
+  {
+    // index of the last step referencing each in-memory file
+    map<String, Size> last_use;
+    for (Size i = 0; i < steps_.size(); ++i)
+    {
+      for (const String& arg : steps_[i].arguments)
+      {
+        if (InMemoryFileStore::isInMemory(arg))
+        {
+          last_use[arg] = i;
+        }
+      }
+    }
+
+    TOPPBase::ExitCodes result = TOPPBase::EXECUTION_OK;
+    for (Size i = 0; i < steps_.size(); ++i)
+    {
+      const Step& step = steps_[i];
+      OPENMS_LOG_INFO << "Pipeline step " << (i + 1) << "/" << steps_.size() << ": " << step.name << std::endl;
+
+      // argv as on the command line, with the step name as program name
+      vector<const char*> argv;
+      argv.push_back(step.name.c_str());
+      for (const String& arg : step.arguments)
+      {
+        argv.push_back(arg.c_str());
+      }
+      argv.push_back(nullptr);
+
+      unique_ptr<TOPPBase> tool = step.factory();
+      result = tool->main(int(argv.size()) - 1, argv.data());
+      tool.reset();
+      if (result != TOPPBase::EXECUTION_OK)
+      {
+        OPENMS_LOG_ERROR << "Pipeline step '" << step.name << "' failed (exit code " << int(result) << ")." << std::endl;
+        break;
+      }
+
+      // free intermediate results which are not needed anymore
+      for (const auto& use : last_use)
+      {
+        if (use.second == i)
+        {
+          InMemoryFileStore::remove(use.first);
+        }
+      }
+    }
+
+    for (const auto& use : last_use)
+    {
+      InMemoryFileStore::remove(use.first);
+    }
+    return result;
+  }
+}
@@ -14,6 +14,8 @@
 
 #include <OpenMS/CONCEPT/Colorizer.h>
 #include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/CONCEPT/PerfCounters.h>
+#include <OpenMS/CONCEPT/ProgressProfiler.h>
 #include <OpenMS/CONCEPT/UniqueIdGenerator.h>
 #include <OpenMS/CONCEPT/VersionInfo.h>
 
@@ -25,6 +27,7 @@
 #include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/FileTypes.h>
 #include <OpenMS/FORMAT/IndentedStream.h>
+#include <OpenMS/FORMAT/InMemoryFileStore.h>
 #include <OpenMS/FORMAT/ParamCTDFile.h>
 #include <OpenMS/FORMAT/ParamCWLFile.h>
 #include <OpenMS/FORMAT/ParamJSONFile.h>
@@ -36,8 +39,10 @@
 
 #include <OpenMS/SYSTEM/ExternalProcess.h>
 #include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/SYSTEM/MemoryBudget.h>
 #include <OpenMS/SYSTEM/StopWatch.h>
 #include <OpenMS/SYSTEM/SysInfo.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
 #include <OpenMS/SYSTEM/UpdateCheck.h>
 
 #include <QtCore/QDir>
@@ -77,7 +82,7 @@ namespace OpenMS
                                        )
   {
 #ifdef _OPENMP
-    omp_set_num_threads(num_threads);
+    TaskScheduler::setNumThreads(num_threads);
 #endif
   }
 
@@ -150,6 +155,19 @@ namespace OpenMS
     registerIntOption_("instance", "<n>", 1, "Instance number for the TOPP INI file", false, true);
     registerIntOption_("debug", "<n>", 0, "Sets the debug level", false, true);
     registerIntOption_("threads", "<n>", 1, "Sets the number of threads allowed to be used by the TOPP tool", false);
+    registerStringOption_("thread_affinity", "<mode>", "none", "Binds the threads to cores: 'compact' fills one NUMA node (socket) after the other, 'spread' distributes the threads over all NUMA nodes (Linux only)", false, true);
+    setValidStrings_("thread_affinity", {"none", "compact", "spread"});
+    registerStringOption_("memory_placement", "<mode>", "default", "Placement of loaded mzML data on the NUMA nodes (sockets): 'first_touch' moves each spectrum to the node of the thread processing it (best with -thread_affinity), "
+                                                                    "'interleave' spreads the data over all nodes (Linux only)", false, true);
+    setValidStrings_("memory_placement", {"default", "first_touch", "interleave"});
+    registerFlag_("deterministic", "Merges the results of the threads in a fixed order, so the output does not depend on the number of threads (costs some memory for buffered results)", true);
+    registerIntOption_("memory_limit", "<MiB>", 0, "Memory budget of the tool in MiB (0: no limit). Containers supporting it (e.g. SpillableSpectrumList) move cold data to a temporary cache file "
+                                                   "instead of exceeding the budget.", false, true);
+    setMinInt_("memory_limit", 0);
+    registerStringOption_("profile", "<file>", "", "Writes wall time, CPU time, peak memory and bytes processed of all progress sections to this JSON file (created only when specified). "
+                                                   "Files ending in '.trace.json' are written in Chrome trace-event format (e.g. for chrome://tracing or Perfetto).", false, true);
+    registerStringOption_("perf_counters", "<file>", "", "Writes counters of hot paths (spectra decoded, bytes decompressed, candidates scored, cache hits/misses, lock wait time), "
+                                                         "in total and per thread, to this JSON file (created only when specified).", false, true);
     registerStringOption_("write_ini", "<file>", "", "Writes the default configuration file", false);
     registerStringOption_("write_ctd", "<out_dir>", "", "Writes the common tool description file(s) (Toolname(s).ctd) to <out_dir>", false, true);
     registerStringOption_("write_nested_cwl", "<out_dir>", "", "Writes the Common Workflow Language file(s) (Toolname(s).cwl) to <out_dir>", false, true);
@@ -462,14 +480,67 @@ namespace OpenMS
       //threads
       //----------------------------------------------------------
       TOPPBase::setMaxNumberOfThreads(getParamAsInt_("threads", 1));
+      const String thread_affinity = getStringOption_("thread_affinity");
+      if (thread_affinity != "none")
+      {
+        if (!TaskScheduler::setThreadAffinity(thread_affinity == "compact" ? TaskScheduler::ThreadAffinity::COMPACT : TaskScheduler::ThreadAffinity::SPREAD))
+        {
+          writeLogWarn_("Warning: Could not bind threads to cores (thread_affinity '" + thread_affinity + "'). Continuing without binding.");
+        }
+      }
+      const String memory_placement = getStringOption_("memory_placement");
+      TaskScheduler::setMemoryPlacement(memory_placement == "first_touch" ? TaskScheduler::MemoryPlacement::FIRST_TOUCH :
+                                        memory_placement == "interleave" ? TaskScheduler::MemoryPlacement::INTERLEAVE : TaskScheduler::MemoryPlacement::DEFAULT);
+      TaskScheduler::setDeterministic(getFlag_("deterministic"));
+      writeDebug_("System: " + SysInfo::getNumaTopologyInfo(), 1);
+
+      //----------------------------------------------------------
+      //memory budget
+      //----------------------------------------------------------
+      MemoryBudget::setLimit(UInt64(getParamAsInt_("memory_limit", 0)) * 1024 * 1024);
 
       //----------------------------------------------------------
       //main
       //----------------------------------------------------------
+      //----------------------------------------------------------
+      //profiling
+      //----------------------------------------------------------
+      const String profile_file = getStringOption_("profile");
+      if (!profile_file.empty())
+      {
+        ProgressProfiler::setEnabled(true);
+        ProgressProfiler::beginScope(tool_name_);
+      }
+      const String perf_counters_file = getStringOption_("perf_counters");
+      if (!perf_counters_file.empty())
+      {
+        PerfCounters::reset();
+        PerfCounters::setEnabled(true);
+      }
+
       StopWatch sw;
       sw.start();
       result = main_(argc, argv);
       sw.stop();
+
+      if (!profile_file.empty())
+      {
+        ProgressProfiler::endScope();
+        ProgressProfiler::setEnabled(false);
+        if (profile_file.hasSuffix(".trace.json"))
+        {
+          ProgressProfiler::storeTraceEvents(profile_file);
+        }
+        else
+        {
+          ProgressProfiler::storeJSON(profile_file);
+        }
+      }
+      if (!perf_counters_file.empty())
+      {
+        PerfCounters::setEnabled(false);
+        PerfCounters::storeJSON(perf_counters_file, tool_name_);
+      }
       // useful for benchmarking and for execution on clusters with schedulers
       String mem_usage;
       {
@@ -1264,6 +1335,12 @@ namespace OpenMS
     parameters_.emplace_back(name, ParameterInformation::FLAG, "", "", description, false, advanced);
   }
 
+  void TOPPBase::registerResumeFlag_(const String& units)
+  {
+    registerFlag_("resume", "Records completed " + units + " as checkpoints in the output. If the output holds the checkpoints of an interrupted run "
+                            "(with the same input and parameters), this run is continued and the completed " + units + " are skipped.", true);
+  }
+
   void TOPPBase::addEmptyLine_()
   {
     parameters_.emplace_back("", ParameterInformation::NEWLINE, "", "", "", false, false);
@@ -1962,6 +2039,16 @@ namespace OpenMS
   {
     writeDebug_("Checking input file '" + filename + "'", 2);
 
+    if (InMemoryFileStore::isInMemory(filename))
+    {
+      if (!InMemoryFileStore::contains(filename))
+      {
+        OPENMS_LOG_ERROR << (param_name.empty() ? String("Cannot read input file!\n") : "Cannot read input file given from parameter '-" + param_name + "'!\n");
+        throw FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+      }
+      return;
+    }
+
     // prepare error message
     String message;
     if (param_name.empty())
@@ -1991,6 +2078,11 @@ namespace OpenMS
   {
     writeDebug_("Checking output file '" + filename + "'", 2);
 
+    if (InMemoryFileStore::isInMemory(filename))
+    {
+      return;
+    }
+
     // prepare error message
     String message;
     if (param_name.empty())
@@ -5,6 +5,7 @@ set(directory source/APPLICATIONS)
 set(sources_list
 ConsoleUtils.cpp
 INIUpdater.cpp
+InProcessPipeline.cpp
 ParameterInformation.cpp
 SearchEngineBase.cpp
 ToolHandler.cpp
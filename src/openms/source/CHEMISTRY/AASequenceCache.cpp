@@ -0,0 +1,50 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CHEMISTRY/AASequenceCache.h>
+
+namespace OpenMS
+{
+  AASequenceCache::AASequenceCache(Size max_size, bool permissive) :
+    max_size_(max_size),
+    permissive_(permissive)
+  {
+  }
+
+  const AASequence& AASequenceCache::fromString(const String& s)
+  {
+    return *intern(s);
+  }
+
+  std::shared_ptr<const AASequence> AASequenceCache::intern(const String& s)
+  {
+    auto it = sequences_.find(s);
+    if (it != sequences_.end())
+    {
+      return it->second;
+    }
+    // parse before inserting, so invalid strings (exception) are not cached
+    std::shared_ptr<const AASequence> seq = std::make_shared<const AASequence>(AASequence::fromString(s, permissive_));
+    if (max_size_ > 0 && sequences_.size() >= max_size_)
+    {
+      sequences_.clear();
+    }
+    sequences_.emplace(s, seq);
+    return seq;
+  }
+
+  Size AASequenceCache::size() const
+  {
+    return sequences_.size();
+  }
+
+  void AASequenceCache::clear()
+  {
+    sequences_.clear();
+  }
+}
@@ -34,18 +34,73 @@ namespace OpenMS
   EmpiricalFormula::EmpiricalFormula(const String& formula)
   {
     charge_ = parseFormula_(formula_, formula);
+    updateWeights_();
   }
 
   EmpiricalFormula::EmpiricalFormula(SignedSize number, const Element* element, SignedSize charge)
   {
     formula_[element] = number;
     charge_ = charge;
+    updateWeights_();
   }
 
   EmpiricalFormula::~EmpiricalFormula() = default;
 
+  void EmpiricalFormula::updateWeights_()
+  {
+    weights_valid_ = false; // compute from the counts
+    mono_weight_ = getMonoWeight();
+    average_weight_ = getAverageWeight();
+    weights_valid_ = true;
+  }
+
+  EmpiricalFormula::MapType_ EmpiricalFormula::merge_(const MapType_& a, const MapType_& b, SignedSize factor)
+  {
+    // both maps are sorted by element, so a single merge pass suffices
+    MapType_::sequence_type merged;
+    merged.reserve(a.size() + b.size());
+    std::less<const Element*> less;
+    auto a_it = a.begin();
+    auto b_it = b.begin();
+    while (a_it != a.end() || b_it != b.end())
+    {
+      const Element* element;
+      SignedSize count;
+      if (b_it == b.end() || (a_it != a.end() && less(a_it->first, b_it->first)))
+      {
+        element = a_it->first;
+        count = a_it->second;
+        ++a_it;
+      }
+      else if (a_it == a.end() || less(b_it->first, a_it->first))
+      {
+        element = b_it->first;
+        count = factor * b_it->second;
+        ++b_it;
+      }
+      else
+      {
+        element = a_it->first;
+        count = a_it->second + factor * b_it->second;
+        ++a_it;
+        ++b_it;
+      }
+      if (count != 0)
+      {
+        merged.emplace_back(element, count);
+      }
+    }
+    MapType_ result;
+    result.adopt_sequence(boost::container::ordered_unique_range, std::move(merged));
+    return result;
+  }
+
   double EmpiricalFormula::getMonoWeight() const
   {
+    if (weights_valid_)
+    {
+      return mono_weight_;
+    }
     double weight = Constants::PROTON_MASS_U * charge_;
     for (const auto& it : formula_)
     {
@@ -68,6 +123,10 @@ namespace OpenMS
 
   double EmpiricalFormula::getAverageWeight() const
   {
+    if (weights_valid_)
+    {
+      return average_weight_;
+    }
     double weight = Constants::PROTON_MASS_U * charge_;
     for (const auto& it : formula_)
     {
@@ -114,6 +173,7 @@ namespace OpenMS
     bool ret = estimateFromWeightAndComp(remaining_weight, C, H, N, O, 0.0, P);
 
     formula_.at(db->getElement("S")) = S;
+    updateWeights_();
 
     return ret;
   }
@@ -138,6 +198,7 @@ namespace OpenMS
     formula_.insert(make_pair(db->getElement("O"), (SignedSize) Math::round(O * factor)));
     formula_.insert(make_pair(db->getElement("S"), (SignedSize) Math::round(S * factor)));
     formula_.insert(make_pair(db->getElement("P"), (SignedSize) Math::round(P * factor)));
+    updateWeights_();
 
     double remaining_mass = average_weight-getAverageWeight();
     SignedSize adjusted_H = Math::round(remaining_mass / db->getElement("H")->getAverageWeight());
@@ -151,6 +212,7 @@ namespace OpenMS
 
     // Only insert hydrogens if their number is not negative.
     formula_.insert(make_pair(db->getElement("H"), adjusted_H));
+    updateWeights_();
     // The approximation had no issues.
     return true;
   }
@@ -175,6 +237,7 @@ namespace OpenMS
     formula_.insert(make_pair(db->getElement("O"), (SignedSize) Math::round(O * factor)));
     formula_.insert(make_pair(db->getElement("S"), (SignedSize) Math::round(S * factor)));
     formula_.insert(make_pair(db->getElement("P"), (SignedSize) Math::round(P * factor)));
+    updateWeights_();
 
     double remaining_mass = mono_weight-getMonoWeight();
     SignedSize adjusted_H = Math::round(remaining_mass / db->getElement("H")->getMonoWeight());
@@ -188,6 +251,7 @@ namespace OpenMS
 
     // Only insert hydrogens if their number is not negative.
     formula_.insert(make_pair(db->getElement("H"), adjusted_H));
+    updateWeights_();
     // The approximation had no issues.
     return true;
   }
@@ -238,6 +302,7 @@ namespace OpenMS
   void EmpiricalFormula::setCharge(Int charge)
   {
     charge_ = charge;
+    updateWeights_();
   }
 
   Int EmpiricalFormula::getCharge() const
@@ -269,91 +334,44 @@ namespace OpenMS
   EmpiricalFormula EmpiricalFormula::operator*(const SignedSize& times) const
   {
     EmpiricalFormula ef(*this);
-    for (const auto& it : formula_) ef.formula_[it.first] *= times;
+    for (auto& it : ef.formula_) it.second *= times;
     ef.charge_ *= times;
     ef.removeZeroedElements_();
+    ef.updateWeights_();
     return ef;
   }
 
   EmpiricalFormula EmpiricalFormula::operator+(const EmpiricalFormula& formula) const
   {
     EmpiricalFormula ef;
-    ef.formula_ = formula.formula_;
-    for (const auto& it : formula_)
-    {
-      auto ef_it  = ef.formula_.find(it.first);
-      if (ef_it != ef.formula_.end())
-      {
-        ef_it->second += it.second;
-      }
-      else
-      {
-        ef.formula_.insert(it);
-      }
-    }
+    ef.formula_ = merge_(formula_, formula.formula_, 1);
     ef.charge_ = charge_ + formula.charge_;
-    ef.removeZeroedElements_();
+    ef.updateWeights_();
     return ef;
   }
 
   EmpiricalFormula& EmpiricalFormula::operator+=(const EmpiricalFormula& formula)
   {
-    for (const auto& it : formula.formula_)
-    {
-      auto f_it  = formula_.find(it.first);
-      if (f_it != formula_.end())
-      {
-        f_it->second += it.second;
-      }
-      else
-      {
-        formula_.insert(it);
-      }
-    }
+    formula_ = merge_(formula_, formula.formula_, 1);
     charge_ += formula.charge_;
-    removeZeroedElements_();
+    updateWeights_();
     return *this;
   }
 
   EmpiricalFormula EmpiricalFormula::operator-(const EmpiricalFormula& formula) const
   {
-    EmpiricalFormula ef(*this);
-    for (const auto& it : formula.formula_)
-    {
-      const Element* e = it.first;
-      SignedSize num = it.second;
-      auto ef_it  = ef.formula_.find(e);
-      if (ef_it != ef.formula_.end())
-      {
-        ef_it->second -= num;
-      }
-      else
-      {
-        ef.formula_[e] = -num;
-      }
-    }
-
+    EmpiricalFormula ef;
+    ef.formula_ = merge_(formula_, formula.formula_, -1);
     ef.charge_ = charge_ - formula.charge_;
-    ef.removeZeroedElements_();
+    ef.updateWeights_();
     return ef;
   }
 
   EmpiricalFormula& EmpiricalFormula::operator-=(const EmpiricalFormula& formula)
   {
-    for (const auto& it : formula.formula_)
-    {
-      auto f_it  = formula_.find(it.first);
-      if (f_it != formula_.end())
-      {
-        f_it->second -= it.second;
-      }
-      else
-      {
-        formula_[it.first] = -it.second;
-      }
-    }
+    formula_ = merge_(formula_, formula.formula_, -1);
     charge_ -= formula.charge_;
-    removeZeroedElements_();
+    updateWeights_();
     return *this;
   }
 
@@ -437,7 +455,7 @@ namespace OpenMS
     return os;
   }
 
-  Int EmpiricalFormula::parseFormula_(std::map<const Element*, SignedSize>& ef, const String& input_formula) const
+  Int EmpiricalFormula::parseFormula_(MapType_& ef, const String& input_formula) const
   {
     Int charge{0};
     String formula(input_formula);
@@ -630,7 +648,7 @@ namespace OpenMS
     {
       if (it->second == 0)
       {
-        ef.erase(it++);   // Note: post increment needed! Otherwise iterator is invalidated
+        it = ef.erase(it);
       }
       else
       {
@@ -648,7 +666,7 @@ namespace OpenMS
     {
       if (it->second == 0)
       {
-        formula_.erase(it++);   // Note: post increment needed! Otherwise iterator is invalidated
+        it = formula_.erase(it);
       }
       else
       {
@@ -684,6 +702,7 @@ namespace OpenMS
     EmpiricalFormula formula;
     formula.formula_[db->getElement(1)] = n_molecules * 2; // hydrogen
     formula.formula_[db->getElement(8)] = n_molecules; // oxygen
+    formula.updateWeights_();
     return formula;
   }
 
@@ -13,10 +13,181 @@
 #include <OpenMS/SYSTEM/File.h>
 #include <boost/regex.hpp>
 
+#include <bitset>
+
 using namespace std;
 
 namespace OpenMS
 {
+  /**
+    @brief Matcher for cleavage regular expressions made of lookaround assertions only
+
+    Supports alternatives ('|') at the top level, each being a sequence of (?<=...), (?<!...), (?=...) and (?!...)
+    assertions (optionally wrapped in plain groups), and each assertion being a sequence of letters, '.' and
+    (negated) character classes like [KR] or [^P]. This covers the patterns of all enzymes we ship.
+    Like boost::regex on a [start, end) range, assertions never look beyond the range.
+  */
+  class EnzymaticDigestion::CleavageSiteMatcher_
+  {
+  public:
+    /// Returns null if @p regex uses unsupported syntax
+    static std::shared_ptr<const CleavageSiteMatcher_> compile(const String& regex)
+    {
+      auto m = std::make_shared<CleavageSiteMatcher_>();
+      Size pos = 0;
+      m->alternatives_.emplace_back();
+      while (pos < regex.size())
+      {
+        if (regex[pos] == '|')
+        {
+          if (m->alternatives_.back().empty()) return nullptr;
+          m->alternatives_.emplace_back();
+          ++pos;
+        }
+        else if (regex[pos] == ')' || regex[pos] == '(')
+        { // plain groups without alternatives inside are just a sequence of assertions
+          if (regex.compare(pos, 2, "(?") == 0)
+          {
+            if (!parseAssertion_(regex, pos, m->alternatives_.back())) return nullptr;
+          }
+          else
+          {
+            if (regex[pos] == '(' && !isPlainGroup_(regex, pos)) return nullptr;
+            ++pos;
+          }
+        }
+        else
+        {
+          return nullptr;
+        }
+      }
+      if (m->alternatives_.back().empty()) return nullptr;
+      return m;
+    }
+
+    /// Does the regex match (with zero width) at @p p, with assertions restricted to [begin, end)?
+    bool matches(const char* begin, const char* end, const char* p) const
+    {
+      for (const auto& alternative : alternatives_)
+      {
+        bool all = true;
+        for (const Assertion_& a : alternative)
+        {
+          if (a.match(begin, end, p) == a.negate)
+          {
+            all = false;
+            break;
+          }
+        }
+        if (all) return true;
+      }
+      return false;
+    }
+
+  private:
+    using CharClass_ = std::bitset<256>;
+
+    struct Assertion_
+    {
+      bool behind = false;
+      bool negate = false;
+      std::vector<CharClass_> classes;
+
+      bool match(const char* begin, const char* end, const char* p) const
+      {
+        const Size n = classes.size();
+        if (behind)
+        {
+          if (Size(p - begin) < n) return false;
+          p -= n;
+        }
+        else if (Size(end - p) < n)
+        {
+          return false;
+        }
+        for (Size i = 0; i < n; ++i)
+        {
+          if (!classes[i][(unsigned char)p[i]]) return false;
+        }
+        return true;
+      }
+    };
+
+    /// Is the group opening at @p pos free of alternatives?
+    static bool isPlainGroup_(const String& regex, Size pos)
+    {
+      int depth = 0;
+      for (; pos < regex.size(); ++pos)
+      {
+        if (regex[pos] == '(') ++depth;
+        else if (regex[pos] == ')' && --depth == 0) return true;
+        else if (regex[pos] == '|') return false;
+      }
+      return false;
+    }
+
+    /// Parses an assertion starting at "(?" at @p pos and appends it to @p out
+    static bool parseAssertion_(const String& regex, Size& pos, std::vector<Assertion_>& out)
+    {
+      Assertion_ a;
+      pos += 2;
+      if (regex.compare(pos, 1, "<") == 0)
+      {
+        a.behind = true;
+        ++pos;
+      }
+      if (pos >= regex.size() || (regex[pos] != '=' && regex[pos] != '!')) return false;
+      a.negate = (regex[pos] == '!');
+      ++pos;
+      while (pos < regex.size() && regex[pos] != ')')
+      {
+        CharClass_ cc;
+        const char ch = regex[pos];
+        if (ch == '.')
+        {
+          cc.set();
+          ++pos;
+        }
+        else if (isalpha((unsigned char)ch))
+        {
+          cc.set((unsigned char)ch);
+          ++pos;
+        }
+        else if (ch == '[')
+        {
+          ++pos;
+          bool invert = false;
+          if (pos < regex.size() && regex[pos] == '^')
+          {
+            invert = true;
+            ++pos;
+          }
+          while (pos < regex.size() && regex[pos] != ']')
+          {
+            if (!isalpha((unsigned char)regex[pos])) return false;
+            cc.set((unsigned char)regex[pos]);
+            ++pos;
+          }
+          if (pos >= regex.size() || cc.none()) return false;
+          ++pos; // skip ']'
+          if (invert) cc.flip();
+        }
+        else
+        {
+          return false;
+        }
+        a.classes.push_back(cc);
+      }
+      if (pos >= regex.size() || a.classes.empty()) return false;
+      ++pos; // skip ')'
+      out.push_back(std::move(a));
+      return true;
+    }
+
+    /// Alternatives, each of which matches if all its assertions hold
+    std::vector<std::vector<Assertion_>> alternatives_;
+  };
+
   const std::string EnzymaticDigestion::NamesOfSpecificity[] = {"none", "semi", "full", "unknown", "unknown", "unknown", "unknown", "unknown", "no-cterm", "no-nterm"};
   const std::string EnzymaticDigestion::NoCleavage = "no cleavage";
   const std::string EnzymaticDigestion::UnspecificCleavage = "unspecific cleavage";
@@ -24,15 +195,16 @@ namespace OpenMS
   EnzymaticDigestion::EnzymaticDigestion() :
       missed_cleavages_(0),
       enzyme_(ProteaseDB::getInstance()->getEnzyme("Trypsin")), // @TODO: keep trypsin as default?
-      re_(new boost::regex(enzyme_->getRegEx())),
       specificity_(SPEC_FULL)
   {
+    updateRegEx_();
   }
 
   EnzymaticDigestion::EnzymaticDigestion(const EnzymaticDigestion& rhs) :
       missed_cleavages_(rhs.missed_cleavages_),
       enzyme_(rhs.enzyme_),
       re_(new boost::regex(*rhs.re_)),
+      matcher_(rhs.matcher_),
       specificity_(rhs.specificity_)
   {
   }
@@ -42,6 +214,7 @@ namespace OpenMS
     missed_cleavages_ = rhs.missed_cleavages_;
     enzyme_ = rhs.enzyme_;
     re_.reset(new boost::regex(*rhs.re_));
+    matcher_ = rhs.matcher_;
     specificity_ = rhs.specificity_;
     return *this;
   }
@@ -61,7 +234,13 @@ namespace OpenMS
   void EnzymaticDigestion::setEnzyme(const DigestionEnzyme* enzyme)
   {
     enzyme_ = enzyme;
+    updateRegEx_();
+  }
+
+  void EnzymaticDigestion::updateRegEx_()
+  {
     re_.reset(new boost::regex(enzyme_->getRegEx()));
+    matcher_ = CleavageSiteMatcher_::compile(enzyme_->getRegEx());
   }
 
   String EnzymaticDigestion::getEnzymeName() const
@@ -97,7 +276,30 @@ namespace OpenMS
     if (end < 0 || end > (int)sequence.size())
       end = (int)sequence.size();
 
-    if (enzyme_->getRegEx() != "()") // if it's not "no cleavage"
+    if (enzyme_->getRegEx() == "()") // "no cleavage"
+    {
+      positions.push_back(start);
+    }
+    else if (matcher_)
+    { // same semantics as the token iterator below: every match closes a token (even an empty one at 'start'), and
+      // the remainder after the last match forms a token if it is not empty
+      const char* begin = sequence.c_str() + start;
+      const char* finish = sequence.c_str() + end;
+      const char* last = begin;
+      for (const char* p = begin; p <= finish; ++p)
+      {
+        if (matcher_->matches(begin, finish, p))
+        {
+          positions.push_back(int(last - sequence.c_str()));
+          last = p;
+        }
+      }
+      if (last != finish)
+      {
+        positions.push_back(int(last - sequence.c_str()));
+      }
+    }
+    else
     {
       boost::sregex_token_iterator i(sequence.begin() + start, sequence.begin() + end, *re_, -1);
       boost::sregex_token_iterator j;
@@ -108,10 +310,6 @@ namespace OpenMS
         ++i;
       }
     }
-    else
-    {
-      positions.push_back(start);
-    }
     return positions;
   }
 
@@ -433,4 +631,18 @@ namespace OpenMS
     return digestAfterTokenize_(fragment_positions, sequence, output, min_length, max_length);
   }
 
+  Size EnzymaticDigestion::digestUnmodified(const std::vector<StringView>& sequences, std::vector<std::vector<std::pair<Size, Size>>>& output, Size min_length, Size max_length) const
+  {
+    output.clear();
+    output.resize(sequences.size());
+    Size wrong_size(0);
+    // tokenize_() only reads from the (immutable) regex and matcher, so this is thread-safe
+#pragma omp parallel for schedule(dynamic, 16) reduction(+: wrong_size)
+    for (SignedSize i = 0; i < (SignedSize)sequences.size(); ++i)
+    {
+      wrong_size += digestUnmodified(sequences[i], output[i], min_length, max_length);
+    }
+    return wrong_size;
+  }
+
 } // namespace OpenMS
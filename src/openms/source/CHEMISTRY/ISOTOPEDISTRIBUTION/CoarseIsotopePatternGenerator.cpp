@@ -12,6 +12,7 @@
 #include <OpenMS/CHEMISTRY/EmpiricalFormula.h>
 #include <OpenMS/CHEMISTRY/Element.h>
 #include <include/OpenMS/CONCEPT/Constants.h>
+#include <OpenMS/CONCEPT/Exception.h>
 
 #include <cmath>
 #include <iostream>
@@ -19,12 +20,49 @@
 #include <algorithm>
 #include <limits>
 #include <functional>
+#include <map>
+#include <mutex>
 #include <numeric>
+#include <shared_mutex>
+#include <tuple>
 
 using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// key of the global memo table of CoarseIsotopePatternGenerator::run()
+    struct CoarseMemoKey
+    {
+      std::vector<std::pair<const Element*, SignedSize>> atoms;
+      Int charge; ///< shifts the lightest isotope weight
+      Size max_isotope;
+      bool round_masses;
+
+      bool operator<(const CoarseMemoKey& rhs) const
+      {
+        return std::tie(max_isotope, round_masses, charge, atoms) < std::tie(rhs.max_isotope, rhs.round_masses, rhs.charge, rhs.atoms);
+      }
+    };
+
+    /// the global memo table; it is cleared when it holds more than MAX_PEAKS peaks (ca. 64 MB)
+    struct CoarseMemo
+    {
+      static constexpr Size MAX_PEAKS = Size(1) << 22;
+
+      std::shared_mutex mutex;
+      std::map<CoarseMemoKey, IsotopeDistribution::ContainerType> table;
+      Size stored_peaks = 0;
+    };
+
+    CoarseMemo& coarseMemo()
+    {
+      static CoarseMemo memo;
+      return memo;
+    }
+  }
+
   CoarseIsotopePatternGenerator::CoarseIsotopePatternGenerator(const Size max_isotope, const bool round_masses) :
     IsotopePatternGenerator(),
     max_isotope_(max_isotope),
@@ -37,6 +75,10 @@ namespace OpenMS
 
   void CoarseIsotopePatternGenerator::setMaxIsotope(const Size& max_isotope)
   {
+    if (max_isotope != max_isotope_)
+    {
+      clearAveragineGrid();
+    }
     max_isotope_ = max_isotope;
   }
 
@@ -47,6 +89,10 @@ namespace OpenMS
 
   void CoarseIsotopePatternGenerator::setRoundMasses(const bool round_masses)
   {
+    if (round_masses != round_masses_)
+    {
+      clearAveragineGrid();
+    }
     round_masses_ = round_masses;
   }
 
@@ -55,7 +101,80 @@ namespace OpenMS
     return round_masses_;
   }
 
+  void CoarseIsotopePatternGenerator::setAveragineGrid(double bin_width, double max_weight)
+  {
+    if (!(bin_width > 0.0) || !(max_weight >= bin_width))
+    {
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "The averagine grid needs a positive bin width and a maximal weight of at least one bin width.",
+        String(bin_width) + " / " + String(max_weight));
+    }
+    clearAveragineGrid(); // estimate the grid points exactly
+
+    auto grid = std::make_shared<std::vector<IsotopeDistribution::ContainerType>>(Size(max_weight / bin_width));
+    #pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < (SignedSize)grid->size(); ++i)
+    {
+      EmpiricalFormula ef;
+      // Element counts are from Senko's Averagine model
+      ef.estimateFromWeightAndComp((i + 1) * bin_width, 4.9384, 7.7583, 1.3577, 1.4773, 0.0417, 0);
+      (*grid)[i] = run(ef).getContainer();
+    }
+
+    averagine_grid_ = grid;
+    averagine_bin_width_ = bin_width;
+  }
+
+  void CoarseIsotopePatternGenerator::clearAveragineGrid()
+  {
+    averagine_grid_.reset();
+    averagine_bin_width_ = 0.0;
+  }
+
+  double CoarseIsotopePatternGenerator::getAveragineGridBinWidth() const
+  {
+    return averagine_bin_width_;
+  }
+
+  void CoarseIsotopePatternGenerator::clearCache()
+  {
+    CoarseMemo& memo = coarseMemo();
+    std::unique_lock<std::shared_mutex> lock(memo.mutex);
+    memo.table.clear();
+    memo.stored_peaks = 0;
+  }
+
   IsotopeDistribution CoarseIsotopePatternGenerator::run(const EmpiricalFormula& formula) const
+  {
+    CoarseMemoKey key{{formula.begin(), formula.end()}, formula.getCharge(), max_isotope_, round_masses_};
+    CoarseMemo& memo = coarseMemo();
+    IsotopeDistribution result;
+    {
+      std::shared_lock<std::shared_mutex> lock(memo.mutex);
+      auto it = memo.table.find(key);
+      if (it != memo.table.end())
+      {
+        result.set(it->second);
+        return result;
+      }
+    }
+
+    result = convolveFormula_(formula);
+
+    std::unique_lock<std::shared_mutex> lock(memo.mutex);
+    if (memo.stored_peaks + result.size() > CoarseMemo::MAX_PEAKS)
+    {
+      memo.table.clear();
+      memo.stored_peaks = 0;
+    }
+    if (memo.table.emplace(std::move(key), result.getContainer()).second)
+    {
+      memo.stored_peaks += result.size();
+    }
+    return result;
+  }
+
+  IsotopeDistribution CoarseIsotopePatternGenerator::convolveFormula_(const EmpiricalFormula& formula) const
   {
     IsotopeDistribution result;
 
@@ -77,10 +196,50 @@ namespace OpenMS
 
   IsotopeDistribution CoarseIsotopePatternGenerator::estimateFromPeptideWeight(double average_weight)
   {
+    if (averagine_grid_ && average_weight >= averagine_bin_width_ &&
+        average_weight <= averagine_bin_width_ * averagine_grid_->size())
+    {
+      return interpolateAveragine_(average_weight);
+    }
     // Element counts are from Senko's Averagine model
     return estimateFromWeightAndComp(average_weight, 4.9384, 7.7583, 1.3577, 1.4773, 0.0417, 0);
   }
 
+  IsotopeDistribution CoarseIsotopePatternGenerator::interpolateAveragine_(double average_weight) const
+  {
+    const std::vector<IsotopeDistribution::ContainerType>& grid = *averagine_grid_;
+    // grid point i holds the distribution at weight (i + 1) * bin width
+    double pos = average_weight / averagine_bin_width_ - 1.0;
+    Size lower = std::min(Size(std::max(pos, 0.0)), grid.size() - 1);
+    IsotopeDistribution result;
+    if (lower + 1 == grid.size())
+    {
+      result.set(grid[lower]);
+      return result;
+    }
+    double t = pos - lower;
+    const IsotopeDistribution::ContainerType& left = grid[lower];
+    const IsotopeDistribution::ContainerType& right = grid[lower + 1];
+
+    // masses as in correctMass_(), starting from the interpolated lightest isotope
+    double lightest = (1.0 - t) * left[0].getMZ() + t * right[0].getMZ();
+    IsotopeDistribution::ContainerType interpolated(std::max(left.size(), right.size()));
+    for (Size i = 0; i < interpolated.size(); ++i)
+    {
+      double mass = lightest + (i * Constants::C13C12_MASSDIFF_U);
+      if (getRoundMasses())
+      {
+        mass = round(mass);
+      }
+      double intensity = (i < left.size() ? (1.0 - t) * left[i].getIntensity() : 0.0) +
+                         (i < right.size() ? t * right[i].getIntensity() : 0.0);
+      interpolated[i] = Peak1D(mass, intensity);
+    }
+    result.set(std::move(interpolated));
+    result.renormalize();
+    return result;
+  }
+
   IsotopeDistribution CoarseIsotopePatternGenerator::estimateFromPeptideMonoWeight(double mono_weight)
   {
     // Element counts are from Senko's Averagine model
@@ -188,7 +347,14 @@ namespace OpenMS
 
   std::vector<double> CoarseIsotopePatternGenerator::approximateIntensities(double mass, UInt num_peaks)
   {
-    std::vector<double> result(num_peaks, 1.0);
+    std::vector<double> result;
+    approximateIntensities(mass, num_peaks, result);
+    return result;
+  }
+
+  void CoarseIsotopePatternGenerator::approximateIntensities(double mass, UInt num_peaks, std::vector<double>& result)
+  {
+    result.assign(num_peaks, 1.0);
 
     // lambda * mass. Lambda is the parameter of Poisson distribution. Value (1/1800) taken from Bellew et al
     double factor = mass / 1800.0;
@@ -209,8 +375,6 @@ namespace OpenMS
     {
       result[k] /= sum;
     }
-
-    return result;
   }
 
   IsotopeDistribution CoarseIsotopePatternGenerator::estimateForFragmentFromRNAWeight(double average_weight_precursor, double average_weight_fragment, const std::set<UInt>& precursor_isotopes)
@@ -10,9 +10,49 @@
 
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsotopeDistribution.h>
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/IsoSpecWrapper.h>
+#include <OpenMS/CHEMISTRY/EmpiricalFormula.h>
+#include <OpenMS/CHEMISTRY/Element.h>
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <unordered_map>
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// IsoSpec input (isotope masses and probabilities) of an element
+    struct ElementIsotopes
+    {
+      std::vector<double> masses;
+      std::vector<double> probabilities;
+    };
+
+    ElementIsotopes isotopesOf(const Element* element)
+    {
+      ElementIsotopes result;
+      for (const auto& iso : element->getIsotopeDistribution())
+      {
+        if (iso.getIntensity() <= 0.0) continue; // IsoSpec does not accept zero probabilities
+        result.masses.push_back(iso.getMZ());
+        result.probabilities.push_back(iso.getIntensity());
+      }
+      return result;
+    }
+
+    /// header line of a runBatch() cache file, encodes the settings the distributions were computed with
+    String cacheHeader(double stop_condition, bool use_total_prob, bool absolute)
+    {
+      std::ostringstream os;
+      os << std::setprecision(17) << "#FineIsotopePatternGenerator\t" << stop_condition << '\t' << use_total_prob << '\t' << absolute;
+      return os.str();
+    }
+  }
 
   IsotopeDistribution FineIsotopePatternGenerator::run(const EmpiricalFormula& formula) const
   {
@@ -31,5 +71,171 @@ namespace OpenMS
     }
   }
 
-}
+  std::vector<IsotopeDistribution> FineIsotopePatternGenerator::runBatch(const std::vector<EmpiricalFormula>& formulas, const String& cache_file) const
+  {
+    const String header = cacheHeader(stop_condition_, use_total_prob_, absolute_);
+
+    // distributions by formula string: read from the cache first
+    std::map<String, IsotopeDistribution::ContainerType> cache;
+    std::ifstream is;
+    if (!cache_file.empty())
+    {
+      is.open(cache_file.c_str()); // a missing cache file is created below
+    }
+    if (is)
+    {
+      std::string line;
+      if (std::getline(is, line) && String(line).trim() == header)
+      {
+        Size line_nr = 1;
+        std::vector<String> fields;
+        while (std::getline(is, line))
+        {
+          ++line_nr;
+          if (!line.empty() && line.back() == '\r')
+          {
+            line.pop_back();
+          }
+          if (line.empty())
+          {
+            continue;
+          }
+          // no trimming: the formula in the first field may be empty
+          String(line).split('\t', fields);
+          IsotopeDistribution::ContainerType dist;
+          bool valid = (fields.size() % 2 == 1);
+          for (Size i = 1; valid && i < fields.size(); i += 2)
+          {
+            // strtod reads back the written values exactly
+            char* mz_end;
+            char* int_end;
+            double mz = std::strtod(fields[i].c_str(), &mz_end);
+            double intensity = std::strtod(fields[i + 1].c_str(), &int_end);
+            valid = (*mz_end == '\0' && *int_end == '\0' && !fields[i].empty() && !fields[i + 1].empty());
+            dist.push_back(Peak1D(mz, intensity));
+          }
+          if (!valid)
+          {
+            throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, line,
+                                        "in " + cache_file + ", line " + String(line_nr) + ": expected a formula followed by m/z and intensity pairs");
+          }
+          cache[fields[0]] = std::move(dist);
+        }
+      }
+    }
+
+    // formulas that still need to be computed (first occurrence of each formula string)
+    std::vector<String> keys(formulas.size());
+    std::vector<Size> todo;
+    {
+      std::map<String, Size> seen;
+      for (Size i = 0; i < formulas.size(); ++i)
+      {
+        keys[i] = formulas[i].toString();
+        if (cache.find(keys[i]) == cache.end() && seen.emplace(keys[i], i).second)
+        {
+          todo.push_back(i);
+        }
+      }
+    }
+
+    // convert the isotope tables of all involved elements once
+    std::unordered_map<const Element*, ElementIsotopes> element_isotopes;
+    for (Size i : todo)
+    {
+      for (const auto& elem : formulas[i])
+      {
+        if (element_isotopes.find(elem.first) == element_isotopes.end())
+        {
+          element_isotopes.emplace(elem.first, isotopesOf(elem.first));
+        }
+      }
+    }
+
+    std::vector<IsotopeDistribution::ContainerType> computed(todo.size());
+    std::exception_ptr error;
+    SignedSize error_index = todo.size();
+    #pragma omp parallel for schedule(dynamic)
+    for (SignedSize t = 0; t < (SignedSize)todo.size(); ++t)
+    {
+      try
+      {
+        const EmpiricalFormula& formula = formulas[todo[t]];
+        std::vector<int> isotope_numbers, atom_counts;
+        std::vector<std::vector<double>> isotope_masses, isotope_probabilities;
+        for (const auto& elem : formula)
+        {
+          const ElementIsotopes& isotopes = element_isotopes.at(elem.first);
+          atom_counts.push_back(elem.second);
+          isotope_numbers.push_back(isotopes.masses.size());
+          isotope_masses.push_back(isotopes.masses);
+          isotope_probabilities.push_back(isotopes.probabilities);
+        }
 
+        IsotopeDistribution result;
+        if (use_total_prob_)
+        {
+          result = IsoSpecTotalProbWrapper(isotope_numbers, atom_counts, isotope_masses, isotope_probabilities, 1.0 - stop_condition_, true).run();
+        }
+        else
+        {
+          result = IsoSpecThresholdWrapper(isotope_numbers, atom_counts, isotope_masses, isotope_probabilities, stop_condition_, absolute_).run();
+        }
+        result.sortByMass();
+        computed[t] = result.getContainer();
+      }
+      catch (...)
+      {
+        #pragma omp critical (FineIsotopePatternGenerator_runBatch)
+        {
+          if (t < error_index)
+          {
+            error_index = t;
+            error = std::current_exception();
+          }
+        }
+      }
+    }
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+
+    for (Size t = 0; t < todo.size(); ++t)
+    {
+      cache[keys[todo[t]]] = std::move(computed[t]);
+    }
+
+    std::vector<IsotopeDistribution> results(formulas.size());
+    for (Size i = 0; i < formulas.size(); ++i)
+    {
+      results[i].set(cache[keys[i]]);
+    }
+
+    if (!cache_file.empty())
+    {
+      std::ofstream os(cache_file.c_str());
+      if (!os)
+      {
+        throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, cache_file);
+      }
+      os << header << '\n' << std::setprecision(17);
+      for (const auto& entry : cache)
+      {
+        os << entry.first;
+        for (const Peak1D& peak : entry.second)
+        {
+          os << '\t' << peak.getMZ() << '\t' << peak.getIntensity();
+        }
+        os << '\n';
+      }
+      if (!os)
+      {
+        throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, cache_file);
+      }
+    }
+
+    return results;
+  }
+
+}
@@ -23,7 +23,7 @@ namespace OpenMS::ims
       weights);
   }
 
-  RealMassDecomposer::decompositions_type RealMassDecomposer::getDecompositions(double mass, double error)
+  RealMassDecomposer::decompositions_type RealMassDecomposer::getDecompositions(double mass, double error) const
   {
     // defines the range of integers to be decomposed
     integer_value_type start_integer_mass = static_cast<integer_value_type>(
@@ -36,32 +36,23 @@ namespace OpenMS::ims
     // loops and finds decompositions for every integer mass,
     // then checks if real mass of decomposition lays in the allowed
     // error interval [mass-error; mass+error]
-    for (integer_value_type integer_mass = start_integer_mass;
-         integer_mass < end_integer_mass; ++integer_mass)
+    auto collect = [&](const integer_decomposer_type::decomposition_type & decomposition)
     {
-      decompositions_type decompositions =
-        decomposer_->getAllDecompositions(integer_mass);
-      for (decompositions_type::iterator pos = decompositions.begin();
-           pos != decompositions.end(); )
+      if (fabs(weights_.getParentMass(decomposition) - mass) <= error)
       {
-        double parent_mass = weights_.getParentMass(*pos);
-        if (fabs(parent_mass - mass) > error)
-        {
-          pos = decompositions.erase(pos);
-        }
-        else
-        {
-          ++pos;
-        }
+        all_decompositions_from_range.push_back(decomposition);
       }
-      all_decompositions_from_range.insert(all_decompositions_from_range.end(),
-                                           decompositions.begin(), decompositions.end());
+    };
+    for (integer_value_type integer_mass = start_integer_mass;
+         integer_mass < end_integer_mass; ++integer_mass)
+    {
+      decomposer_->visitDecompositions(integer_mass, collect);
     }
     return all_decompositions_from_range;
   }
 
   RealMassDecomposer::decompositions_type RealMassDecomposer::getDecompositions(double mass, double error,
-                                                                                const constraints_type & constraints)
+                                                                                const constraints_type & constraints) const
   {
 
     // defines the range of integers to be decomposed
@@ -75,52 +66,31 @@ namespace OpenMS::ims
     // loops and finds decompositions for every integer mass,
     // then checks if real mass of decomposition lays in the allowed
     // error interval [mass-error; mass+error]
-    for (integer_value_type integer_mass = start_integer_mass;
-         integer_mass < end_integer_mass; ++integer_mass)
+    auto collect = [&](const integer_decomposer_type::decomposition_type & decomposition)
     {
-      decompositions_type decompositions =
-        decomposer_->getAllDecompositions(integer_mass);
-      for (decompositions_type::iterator pos = decompositions.begin();
-           pos != decompositions.end(); )
-        {
-        double parent_mass = weights_.getParentMass(*pos);
-        if (fabs(parent_mass - mass) > error)
-        {
-          pos = decompositions.erase(pos);
-        }
-        else
+      if (fabs(weights_.getParentMass(decomposition) - mass) > error)
+      {
+        return;
+      }
+      for (constraints_type::const_iterator it = constraints.begin(); it != constraints.end(); ++it)
+      {
+        if (decomposition[it->first] < it->second.first ||
+            decomposition[it->first] > it->second.second)
         {
-          bool to_erase = false;
-          if (!constraints.empty())
-          {
-            for (constraints_type::const_iterator it =
-                   constraints.begin(); it != constraints.end(); ++it)
-              {
-              if ((*pos)[it->first] < it->second.first ||
-                  (*pos)[it->first] > it->second.second)
-              {
-                to_erase = true;
-                break;
-              }
-            }
-          }
-          if (to_erase)
-          {
-            pos = decompositions.erase(pos);
-          }
-          else
-          {
-            ++pos;
-          }
+          return;
         }
       }
-      all_decompositions_from_range.insert(all_decompositions_from_range.end(),
-                                           decompositions.begin(), decompositions.end());
+      all_decompositions_from_range.push_back(decomposition);
+    };
+    for (integer_value_type integer_mass = start_integer_mass;
+         integer_mass < end_integer_mass; ++integer_mass)
+    {
+      decomposer_->visitDecompositions(integer_mass, collect);
     }
     return all_decompositions_from_range;
   }
 
-  RealMassDecomposer::number_of_decompositions_type RealMassDecomposer::getNumberOfDecompositions(double mass, double error)
+  RealMassDecomposer::number_of_decompositions_type RealMassDecomposer::getNumberOfDecompositions(double mass, double error) const
   {
     // defines the range of integers to be decomposed
     integer_value_type start_integer_mass = static_cast<integer_value_type>(1);
@@ -134,23 +104,20 @@ namespace OpenMS::ims
 
     number_of_decompositions_type number_of_decompositions = static_cast<number_of_decompositions_type>(0);
 
-    // loops and finds decompositions for every integer mass,
-    // then checks if real mass of decomposition lays in the allowed
-    // error interval [mass-error; mass+error]
-    for (integer_value_type integer_mass = start_integer_mass;
-         integer_mass < end_integer_mass; ++integer_mass)
+    // loops and counts decompositions for every integer mass (without
+    // storing them) whose real mass lays in the allowed error interval
+    // [mass-error; mass+error]
+    auto count = [&](const integer_decomposer_type::decomposition_type & decomposition)
     {
-      decompositions_type decompositions =
-        decomposer_->getAllDecompositions(integer_mass);
-      for (decompositions_type::iterator pos = decompositions.begin();
-           pos != decompositions.end(); ++pos)
+      if (fabs(weights_.getParentMass(decomposition) - mass) <= error)
       {
-        double parent_mass = weights_.getParentMass(*pos);
-        if (fabs(parent_mass - mass) <= error)
-        {
-          ++number_of_decompositions;
-        }
+        ++number_of_decompositions;
       }
+    };
+    for (integer_value_type integer_mass = start_integer_mass;
+         integer_mass < end_integer_mass; ++integer_mass)
+    {
+      decomposer_->visitDecompositions(integer_mass, count);
     }
     return number_of_decompositions;
   }
@@ -52,8 +52,43 @@ namespace OpenMS
   void MassDecompositionAlgorithm::getDecompositions(vector<MassDecomposition> & decomps, double mass)
   {
     double tolerance((double) param_.getValue("tolerance"));
-    ims::RealMassDecomposer::decompositions_type decompositions = decomposer_->getDecompositions(mass, tolerance);
+    appendDecompositions_(decomposer_->getDecompositions(mass, tolerance), decomps);
+  }
+
+  void MassDecompositionAlgorithm::getDecompositions(vector<vector<MassDecomposition> > & decomps, const vector<double> & weights) const
+  {
+    double tolerance((double) param_.getValue("tolerance"));
+    decomps.clear();
+    decomps.resize(weights.size());
+
+    #pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < (SignedSize)weights.size(); ++i)
+    {
+      appendDecompositions_(decomposer_->getDecompositions(weights[i], tolerance), decomps[i]);
+    }
+  }
+
+  Size MassDecompositionAlgorithm::getNumberOfDecompositions(double weight) const
+  {
+    double tolerance((double) param_.getValue("tolerance"));
+    return decomposer_->getNumberOfDecompositions(weight, tolerance);
+  }
+
+  vector<Size> MassDecompositionAlgorithm::getNumberOfDecompositions(const vector<double> & weights) const
+  {
+    double tolerance((double) param_.getValue("tolerance"));
+    vector<Size> counts(weights.size());
 
+    #pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < (SignedSize)weights.size(); ++i)
+    {
+      counts[i] = decomposer_->getNumberOfDecompositions(weights[i], tolerance);
+    }
+    return counts;
+  }
+
+  void MassDecompositionAlgorithm::appendDecompositions_(const ims::RealMassDecomposer::decompositions_type & decompositions, vector<MassDecomposition> & decomps) const
+  {
     for (ims::RealMassDecomposer::decompositions_type::const_iterator pos = decompositions.begin(); pos != decompositions.end(); ++pos)
     {
       String d;
@@ -68,8 +103,6 @@ namespace OpenMS
       MassDecomposition decomp(d);
       decomps.push_back(decomp);
     }
-
-    return;
   }
 
   void MassDecompositionAlgorithm::updateMembers_()
@@ -18,6 +18,7 @@
 
 #include <fstream>
 #include <limits>
+#include <mutex>
 #include <utility>
 
 using namespace std;
@@ -107,8 +108,8 @@ namespace OpenMS
   Size ModificationsDB::getNumberOfModifications() const
   {
     Size s;
-    #pragma omp critical (OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       s = mods_.size();
     }
     return s;
@@ -128,8 +129,8 @@ namespace OpenMS
     char res = '?'; // empty
     if (!residue.empty()) res = residue[0];
 
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       bool found = true;
       auto modifications = modification_names_.find(mod_name);
       if (modifications == modification_names_.end())
@@ -173,8 +174,8 @@ namespace OpenMS
 
     const String& mod_name = mod_in.getFullId();
 
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       bool found = true;
       auto modifications = modification_names_.find(mod_name);
 
@@ -217,8 +218,8 @@ namespace OpenMS
     char res = '?'; // empty
     if (!residue.empty()) res = residue[0];
 
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       bool found = true;
       auto modifications = modification_names_.find(mod_name);
       if (modifications == modification_names_.end())
@@ -287,8 +288,8 @@ namespace OpenMS
   bool ModificationsDB::has(const String & modification) const
   {
     bool has_mod;
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       has_mod = (modification_names_.find(modification) != modification_names_.end());
     }
     return has_mod;
@@ -302,8 +303,8 @@ namespace OpenMS
     }
 
     bool one_mod(true);
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       if (modification_names_.find(mod_name)->second.size() > 1)
       {
         one_mod = false;
@@ -315,8 +316,8 @@ namespace OpenMS
     }
 
     Size index(numeric_limits<Size>::max());
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       const ResidueModification* mod = *(modification_names_.find(mod_name)->second.begin());
       for (Size i = 0; i != mods_.size(); ++i)
       {
@@ -340,8 +341,8 @@ namespace OpenMS
     mods.clear();
     char res = '?'; // empty
     if (!residue.empty()) res = residue[0];
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       for (auto const & m : mods_)
       {
         if ((fabs(m->getDiffMonoMass() - mass) <= max_error) &&
@@ -360,8 +361,8 @@ namespace OpenMS
     mods.clear();
     char res = '?'; // empty
     if (!residue.empty()) res = residue[0];
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       for (auto const & m : mods_)
       {
         if ((fabs(m->getDiffMonoMass() - mass) <= max_error) &&
@@ -383,8 +384,8 @@ namespace OpenMS
     if (!residue.empty()) res = residue[0];
     double diff = 0;
     Size cnt = 0;
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       for (auto const & m : mods_)
       {
         diff = fabs(m->getDiffMonoMass() - mass);
@@ -411,8 +412,8 @@ namespace OpenMS
     if (!residue.empty()) res = residue[0];
     double diff = 0;
     Size cnt = 0;
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       for (auto const & m : mods_)
       {
         diff = fabs(m->getDiffMonoMass() - mass);
@@ -441,8 +442,8 @@ namespace OpenMS
     {
       res = residue[0];
     }
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       for (auto const & m : mods_)
       {
         // using less instead of less-or-equal will pick the first matching
@@ -472,8 +473,8 @@ namespace OpenMS
       // create full ID based on other information:
       m->setFullId();
 
-      #pragma omp critical(OpenMS_ModificationsDB)
       {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
         // e.g. Oxidation (M)
         modification_names_[m->getFullId()].insert(m);
         // e.g. Oxidation
@@ -490,13 +491,13 @@ namespace OpenMS
   const ResidueModification* ModificationsDB::addModification(std::unique_ptr<ResidueModification> new_mod)
   {
     const ResidueModification* ret;
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::unique_lock<std::shared_mutex> lock(mutex_);
       auto it = modification_names_.find(new_mod->getFullId());
       if (it != modification_names_.end())
       {
         OPENMS_LOG_WARN << "Modification already exists in ModificationsDB. Skipping." << new_mod->getFullId() << endl;
-        ret = *(it->second.begin()); // returning from omp critical is not allowed
+        ret = *(it->second.begin());
       }
       else
       {
@@ -515,13 +516,13 @@ namespace OpenMS
   const ResidueModification* ModificationsDB::addModification(const ResidueModification& new_mod)
   {
     const ResidueModification* ret = new ResidueModification(new_mod);
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::unique_lock<std::shared_mutex> lock(mutex_);
       auto it = modification_names_.find(new_mod.getFullId());
       if (it != modification_names_.end())
       {
         OPENMS_LOG_WARN << "Modification already exists in ModificationsDB. Skipping." << new_mod.getFullId() << endl;
-        ret = *(it->second.begin()); // returning from omp critical is not allowed
+        ret = *(it->second.begin());
       }
       else
       {
@@ -539,8 +540,8 @@ namespace OpenMS
   const ResidueModification* ModificationsDB::addNewModification_(const ResidueModification& new_mod)
   {
     const ResidueModification* ret = new ResidueModification(new_mod);
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::unique_lock<std::shared_mutex> lock(mutex_);
       modification_names_[ret->getFullId()].insert(ret);
       modification_names_[ret->getId()].insert(ret);
       modification_names_[ret->getFullName()].insert(ret);
@@ -806,8 +807,8 @@ namespace OpenMS
     }
 
     // now use the term and all synonyms to build the database
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::unique_lock<std::shared_mutex> lock(mutex_);
       for (multimap<String, ResidueModification>::const_iterator it = all_mods.begin(); it != all_mods.end(); ++it)
       {
         // check whether a unimod definition already exists, then simply add synonyms to it
@@ -857,8 +858,8 @@ namespace OpenMS
   {
     modifications.clear();
 
-    #pragma omp critical(OpenMS_ModificationsDB)
     {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
       for (auto const & m : mods_)
       {
         if (m->getUniModRecordId() > 0)
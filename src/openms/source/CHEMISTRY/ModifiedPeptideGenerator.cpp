@@ -159,7 +159,55 @@ namespace OpenMS
     // iterate over each residue and build compatibility mapping describing
     // which amino acid (peptide index) is compatible with which modification
     map<int, vector<const ResidueModification*> > mod_compatibility;
+    getModificationCompatibility_(var_mods, peptide, mod_compatibility);
 
+    Size max_placements = std::min(max_variable_mods_per_peptide, mod_compatibility.size());
+
+    // stores all variants with how many modifications they already have
+    vector<pair<size_t, vector<AASequence>>> mod_peps_w_depth = {{0, {peptide}}};
+    Size num_res = 0;
+    for (Size s(0); s <= max_placements; ++s)
+    {
+      num_res += boost::math::binomial_coefficient<double>(mod_compatibility.size(), s);
+    }
+    mod_peps_w_depth.reserve(num_res);
+    auto rit = mod_compatibility.rbegin();
+    for (; rit != mod_compatibility.rend(); ++rit)
+    {
+      const auto& idx = rit->first;
+      const auto& mods = rit->second;
+      // copy the complete sequences from last iteration
+      auto tmp = mod_peps_w_depth;
+      for (auto& [old_depth, old_variants] : tmp)
+      {
+        // extends mod_peps_w_depth by adding variants with the next mod, if max_placements is not reached
+        if (old_depth < max_placements)
+        {
+          applyAllModsAtIdxAndExtend_(old_variants, idx, mods, var_mods);
+          mod_peps_w_depth.emplace_back(old_depth + 1, std::move(old_variants));
+        }
+      }
+    }
+    
+    // move sequences from mod_peps_w_depth into result. Skip the initial peptide if desired.
+    for (auto& [depth, seqs] : mod_peps_w_depth)
+    {
+      if (depth != 0 || keep_unmodified)
+      {
+        all_modified_peptides.insert(
+          all_modified_peptides.end(), 
+          make_move_iterator(seqs.begin()), 
+          make_move_iterator(seqs.end())); 
+      }
+    }
+  }
+
+  // static
+  void ModifiedPeptideGenerator::getModificationCompatibility_(
+    const MapToResidueType& var_mods,
+    const AASequence& peptide,
+    map<int, vector<const ResidueModification*> >& mod_compatibility)
+  {
     // set terminal modifications for modifications without amino acid preference
     for (auto const& mr : var_mods.val)
     {
@@ -223,45 +271,99 @@ namespace OpenMS
         }
       }
     }
+  }
 
-    Size max_placements = std::min(max_variable_mods_per_peptide, mod_compatibility.size());
+  // static
+  void ModifiedPeptideGenerator::getVariableModificationSites(
+    const MapToResidueType& var_mods,
+    const AASequence& peptide,
+    vector<ModificationSite>& sites)
+  {
+    sites.clear();
+    map<int, vector<const ResidueModification*> > mod_compatibility;
+    getModificationCompatibility_(var_mods, peptide, mod_compatibility);
 
-    // stores all variants with how many modifications they already have
-    vector<pair<size_t, vector<AASequence>>> mod_peps_w_depth = {{0, {peptide}}};
-    Size num_res = 0;
-    for (Size s(0); s <= max_placements; ++s)
+    for (const auto& [idx, mods] : mod_compatibility)
     {
-      num_res += boost::math::binomial_coefficient<double>(mod_compatibility.size(), s);
-    }
-    mod_peps_w_depth.reserve(num_res);
-    auto rit = mod_compatibility.rbegin();
-    for (; rit != mod_compatibility.rend(); ++rit)
-    {
-      const auto& idx = rit->first;
-      const auto& mods = rit->second;
-      // copy the complete sequences from last iteration
-      auto tmp = mod_peps_w_depth;
-      for (auto& [old_depth, old_variants] : tmp)
+      for (const ResidueModification* m : mods)
       {
-        // extends mod_peps_w_depth by adding variants with the next mod, if max_placements is not reached
-        if (old_depth < max_placements)
+        ModificationSite site;
+        site.index = idx;
+        site.modification = m;
+        if (idx == C_TERM_MODIFICATION_INDEX || idx == N_TERM_MODIFICATION_INDEX)
         {
-          applyAllModsAtIdxAndExtend_(old_variants, idx, mods, var_mods);
-          mod_peps_w_depth.emplace_back(old_depth + 1, std::move(old_variants));
+          site.mono_mass_delta = m->getDiffMonoMass();
+        }
+        else
+        {
+          // the modified residue replaces the unmodified one (see applyModToPep_)
+          site.mono_mass_delta = var_mods.val.at(m)->getMonoWeight(Residue::Internal) - peptide[idx].getMonoWeight(Residue::Internal);
         }
+        sites.push_back(site);
       }
     }
-    
-    // move sequences from mod_peps_w_depth into result. Skip the initial peptide if desired.
-    for (auto& [depth, seqs] : mod_peps_w_depth)
+  }
+
+  // static
+  void ModifiedPeptideGenerator::enumerateVariableModifications(
+    const vector<ModificationSite>& sites,
+    double mono_weight,
+    Size max_variable_mods_per_peptide,
+    const VariantCallback& callback,
+    bool keep_original)
+  {
+    vector<Size> chosen;
+    chosen.reserve(max_variable_mods_per_peptide);
+    if (keep_original)
     {
-      if (depth != 0 || keep_unmodified)
+      callback(mono_weight, chosen);
+    }
+    if (max_variable_mods_per_peptide != 0)
+    {
+      enumerateVariants_(sites, 0, mono_weight, max_variable_mods_per_peptide, chosen, callback);
+    }
+  }
+
+  // static
+  AASequence ModifiedPeptideGenerator::applyVariableModificationSites(
+    const MapToResidueType& var_mods,
+    const AASequence& peptide,
+    const vector<ModificationSite>& sites,
+    const vector<Size>& chosen)
+  {
+    AASequence modified_peptide = peptide;
+    for (Size s : chosen)
+    {
+      applyModToPep_(modified_peptide, sites[s].index, sites[s].modification, var_mods);
+    }
+    return modified_peptide;
+  }
+
+  // static
+  void ModifiedPeptideGenerator::enumerateVariants_(
+    const vector<ModificationSite>& sites,
+    Size first_site,
+    double mono_weight,
+    Size max_variable_mods_per_peptide,
+    vector<Size>& chosen,
+    const VariantCallback& callback)
+  {
+    for (Size s = first_site; s < sites.size(); ++s)
+    {
+      chosen.push_back(s);
+      const double weight = mono_weight + sites[s].mono_mass_delta;
+      callback(weight, chosen);
+      if (chosen.size() < max_variable_mods_per_peptide)
       {
-        all_modified_peptides.insert(
-          all_modified_peptides.end(), 
-          make_move_iterator(seqs.begin()), 
-          make_move_iterator(seqs.end())); 
+        // at most one modification per position: continue after all sites of the current position
+        Size next = s + 1;
+        while (next < sites.size() && sites[next].index == sites[s].index)
+        {
+          ++next;
+        }
+        enumerateVariants_(sites, next, weight, max_variable_mods_per_peptide, chosen, callback);
       }
+      chosen.pop_back();
     }
   }
 
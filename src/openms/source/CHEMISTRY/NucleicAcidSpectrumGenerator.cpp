@@ -175,6 +175,8 @@ namespace OpenMS
     static const double x_ion_offset = c_ion_offset;
     static const double y_ion_offset = b_ion_offset;
     static const double z_ion_offset = a_ion_offset;
+    // mass shift of a phosphorothioate linkage:
+    static const double thiol_mass = EmpiricalFormula("SO-1").getMonoWeight();
 
     // a a-B w x ions have different offsets if we have phosphorothioate linkages,
 
@@ -203,7 +205,7 @@ namespace OpenMS
       // * at the end means phosphorothioate
       if (ribo.getCode().back() == '*')
       {
-        thiols[index] = EmpiricalFormula("SO-1").getMonoWeight();
+        thiols[index] = thiol_mass;
       }
       ++index;
     }
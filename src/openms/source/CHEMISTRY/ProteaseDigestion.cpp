@@ -10,7 +10,6 @@
 #include <OpenMS/CHEMISTRY/ProteaseDB.h>
 #include <OpenMS/SYSTEM/File.h>
 #include <algorithm>
-#include <boost/regex.hpp>
 
 #include <limits>
 
@@ -21,7 +20,7 @@ namespace OpenMS
   void ProteaseDigestion::setEnzyme(const String& enzyme_name)
   {
     enzyme_ = ProteaseDB::getInstance()->getEnzyme(enzyme_name);
-    re_.reset(new boost::regex(enzyme_->getRegEx()));
+    updateRegEx_();
   }
 
   bool ProteaseDigestion::isValidProduct(const String& protein,
@@ -14,6 +14,7 @@
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 
 #include <iostream>
+#include <mutex>
 
 using namespace std;
 
@@ -44,20 +45,13 @@ namespace OpenMS
       throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No residue specified.", "");
     }
 
-    const Residue* r{};
-    #pragma omp critical (ResidueDB)
-    {   
-      auto it = residue_names_.find(name);
-      if (it != residue_names_.end()) 
-      { 
-        r = it->second; 
-      }
-    }
-    if (r == nullptr)
+    // no lock required here because read only and the names are initialized in thread-safe constructor
+    auto it = residue_names_.find(name);
+    if (it == residue_names_.end())
     {
       throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Residue not found: ", name);
     }
-    return r;
+    return it->second;
   }
 
   const Residue* ResidueDB::getResidue(const unsigned char& one_letter_code) const
@@ -69,35 +63,23 @@ namespace OpenMS
 
   Size ResidueDB::getNumberOfResidues() const
   {
-    Size s;
-    #pragma omp critical (ResidueDB)
-    {
-      s = const_residues_.size();
-    } 
-    return s;
+    return const_residues_.size();
   }
 
   Size ResidueDB::getNumberOfModifiedResidues() const
   {
-    Size s;
-    #pragma omp critical (ResidueDB)
-    {
-      s = const_modified_residues_.size();
-    } 
-    return s;
+    std::shared_lock<std::shared_mutex> lock(modified_residues_mutex_);
+    return const_modified_residues_.size();
   }
 
   const set<const Residue*> ResidueDB::getResidues(const String& residue_set) const
   {
     set<const Residue*> s;
-    #pragma omp critical (ResidueDB)
+    auto it = residues_by_set_.find(residue_set);
+    if (it != residues_by_set_.end())
     {
-      auto it = residues_by_set_.find(residue_set);
-      if (it != residues_by_set_.end())
-      {
-        s = it->second;
-      }
-    } 
+      s = it->second;
+    }
 
     if (s.empty()) 
     {
@@ -128,23 +110,17 @@ namespace OpenMS
 
   bool ResidueDB::hasResidue(const String& res_name) const
   {
-    bool found = false;
-    #pragma omp critical (ResidueDB)
-    {
-      found = residue_names_.find(res_name) != residue_names_.end();
-    }  
-    return found;
+    return residue_names_.find(res_name) != residue_names_.end();
   }
 
   bool ResidueDB::hasResidue(const Residue* residue) const
   {
-    bool found = false;
-    #pragma omp critical (ResidueDB)
+    if (const_residues_.find(residue) != const_residues_.end())
     {
-      found = (const_residues_.find(residue) != const_residues_.end() ||
-          const_modified_residues_.find(residue) != const_modified_residues_.end());
-    } 
-    return found;
+      return true;
+    }
+    std::shared_lock<std::shared_mutex> lock(modified_residues_mutex_);
+    return const_modified_residues_.find(residue) != const_modified_residues_.end();
   }
 
   void ResidueDB::buildResidues_()
@@ -273,12 +249,7 @@ namespace OpenMS
 
   const set<String> ResidueDB::getResidueSets() const
   {
-    set<String> rs;
-    #pragma omp critical (ResidueDB)
-    {
-      rs = residue_sets_; 
-    }
-    return rs;
+    return residue_sets_;
   }
 
   void ResidueDB::addModifiedResidueNames_(const Residue* r)
@@ -357,102 +328,51 @@ namespace OpenMS
   const Residue* ResidueDB::getModifiedResidue(const Residue* residue, const String& modification)
   {
     OPENMS_PRECONDITION(!modification.empty(), "Modification cannot be empty")
-    // search if the mod already exists
     const String & res_name = residue->getName();
-    Residue* res{};
-    bool residue_found(true), mod_found(true);
-    #pragma omp critical (ResidueDB)
+    if (!hasResidue(res_name))
     {
-      // Perform a single lookup of the residue name in our database, we assume
-      // that if it is present in residue_mod_names_ then we have seen it
-      // before and can directly grab it. If its not present, we may have as
-      // unmodified residue in residue_names_ but need to create a new entry as
-      // modified residue. If the residue itself is unknown, we will throw (see
-      // below).
-      const auto& rm_entry = residue_mod_names_.find(res_name);
-      if (rm_entry == residue_mod_names_.end())
-      {
-        if (residue_names_.find(res_name) == residue_names_.end())
-        {
-          residue_found = false;
-        }
-      }
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Residue not found: ", res_name);
+    }
 
-      if (residue_found)
+    // the modification is looked up without holding a lock of the ResidueDB
+    const ResidueModification* mod{};
+    try
+    {
+      static const ModificationsDB* mdb = ModificationsDB::getInstance();
+      if (modification.hasSubstring("-term "))
       {
-        const ResidueModification* mod{};
-                  
-        try
+        // handle terminal modifications of format: "MOD_NAME (Protein {N|C}-term RESIDUE_NAME)"
+        if (modification.hasSubstring("Protein N-term"))
         {
-          static const ModificationsDB* mdb = ModificationsDB::getInstance();
-          if (modification.hasSubstring("-term "))
-          {
-            // handle terminal modifications of format: "MOD_NAME (Protein {N|C}-term RESIDUE_NAME)"
-            if (modification.hasSubstring("Protein N-term"))
-            {
-              mod = mdb->getModification(modification, residue->getOneLetterCode(), ResidueModification::PROTEIN_N_TERM); 
-            } 
-            else if (modification.hasSubstring("Protein C-term"))
-            {
-              mod = mdb->getModification(modification, residue->getOneLetterCode(), ResidueModification::PROTEIN_C_TERM); 
-            }
-            // handle terminal modifications of format: "MOD_NAME ({N|C}-term RESIDUE_NAME)"
-            else if (modification.hasSubstring("N-term"))
-            {
-              mod = mdb->getModification(modification, residue->getOneLetterCode(), ResidueModification::N_TERM); 
-            } 
-            else if (modification.hasSubstring("C-term"))
-            {
-              mod = mdb->getModification(modification, residue->getOneLetterCode(), ResidueModification::C_TERM); 
-            }
-          }
-          else
-          {
-            mod = mdb->getModification(modification, residue->getOneLetterCode(), ResidueModification::ANYWHERE);
-          }  
-        }
-        catch (...)
+          mod = mdb->getModification(modification, residue->getOneLetterCode(), ResidueModification::PROTEIN_N_TERM); 
+        } 
+        else if (modification.hasSubstring("Protein C-term"))
         {
-          mod_found = false;
+          mod = mdb->getModification(modification, residue->getOneLetterCode(), ResidueModification::PROTEIN_C_TERM); 
         }
-
-        // check if modification in ResidueDB
-        if (mod_found)
+        // handle terminal modifications of format: "MOD_NAME ({N|C}-term RESIDUE_NAME)"
+        else if (modification.hasSubstring("N-term"))
         {
-          // check if modified residue is already present in ResidueDB
-          bool found = false;
-          if (rm_entry != residue_mod_names_.end())
-          {
-            const String& id = mod->getId().empty() ? mod->getFullId() : mod->getId();
-            const auto& inner = rm_entry->second.find(id);
-            if (inner != rm_entry->second.end())
-            {
-              res = const_cast<Residue*>(inner->second);
-              found = true;
-            }
-          }
-          if (!found)
-          {
-            // create and register this modified residue
-            res = new Residue(*residue_names_.at(res_name));
-            res->setModification(mod);
-            addResidue_(res);            
-          }
+          mod = mdb->getModification(modification, residue->getOneLetterCode(), ResidueModification::N_TERM); 
+        } 
+        else if (modification.hasSubstring("C-term"))
+        {
+          mod = mdb->getModification(modification, residue->getOneLetterCode(), ResidueModification::C_TERM); 
         }
       }
+      else
+      {
+        mod = mdb->getModification(modification, residue->getOneLetterCode(), ResidueModification::ANYWHERE);
+      }  
     }
-
-    // throwing (uncaught) exceptions needs to happen outside of critical section (see OpenMP reference manual)
-    if (!residue_found)
+    catch (...)
     {
-      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Residue not found: ", res_name);
     }
-    else if (!mod_found)
+    if (mod == nullptr)
     {
       throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Modification not found: ", modification);
     }
-    
-    return res;
+    return getOrAddModifiedResidue_(res_name, mod);
   }
 
   const Residue* ResidueDB::getModifiedResidue(const Residue* residue, const ResidueModification* mod)
@@ -460,62 +380,54 @@ namespace OpenMS
     OPENMS_PRECONDITION(mod != nullptr, "Mod cannot be nullptr")
     OPENMS_PRECONDITION(mod->getTermSpecificity() == ResidueModification::ANYWHERE, "Mod's term specificity needs to be ANYWHERE to attach it to Residues");
     OPENMS_PRECONDITION(mod->getOrigin() == residue->getOneLetterCode()[0], "Mod's AA origin needs to match residues one-letter-code");
-    // search if the mod already exists
     const String & res_name = residue->getName();
-    Residue* res{};
-    bool residue_found(true);
-    #pragma omp critical (ResidueDB)
+    if (!hasResidue(res_name))
     {
-      // Perform a single lookup of the residue name in our database, we assume
-      // that if it is present in residue_mod_names_ then we have seen it
-      // before and can directly grab it. If its not present, we may have as
-      // unmodified residue in residue_names_ but need to create a new entry as
-      // modified residue. If the residue itself is unknown, we will throw (see
-      // below).
-      const auto& rm_entry = residue_mod_names_.find(res_name);
-      if (rm_entry == residue_mod_names_.end())
-      {
-        if (residue_names_.find(res_name) == residue_names_.end())
-        {
-          residue_found = false;
-        }
-      }
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Residue not found: ", res_name);
+    }
+    if (mod == nullptr)
+    {
+      return nullptr;
+    }
+    return getOrAddModifiedResidue_(res_name, mod);
+  }
 
-      if (residue_found)
-      {
+  const Residue* ResidueDB::findModifiedResidue_(const String& res_name, const String& mod_id) const
+  {
+    auto rm_entry = residue_mod_names_.find(res_name);
+    if (rm_entry == residue_mod_names_.end())
+    {
+      return nullptr;
+    }
+    auto inner = rm_entry->second.find(mod_id);
+    return inner == rm_entry->second.end() ? nullptr : inner->second;
+  }
 
-        // check if modification in ResidueDB
-        if (mod != nullptr)
-        {
-          // check if modified residue is already present in ResidueDB
-          bool found = false;
-          if (rm_entry != residue_mod_names_.end())
-          {
-            const String& id = mod->getId().empty() ? mod->getFullId() : mod->getId();
-            const auto& inner = rm_entry->second.find(id);
-            if (inner != rm_entry->second.end())
-            {
-              res = const_cast<Residue*>(inner->second);
-              found = true;
-            }
-          }
-          if (!found)
-          {
-            // create and register this modified residue
-            res = new Residue(*residue_names_.at(res_name));
-            res->setModification(mod);
-            addResidue_(res);            
-          }
-        }
+  const Residue* ResidueDB::getOrAddModifiedResidue_(const String& res_name, const ResidueModification* mod)
+  {
+    const String& id = mod->getId().empty() ? mod->getFullId() : mod->getId();
+
+    // fast path: modified residues are only created once, all later lookups are concurrent reads
+    {
+      std::shared_lock<std::shared_mutex> lock(modified_residues_mutex_);
+      const Residue* res = findModifiedResidue_(res_name, id);
+      if (res != nullptr)
+      {
+        return res;
       }
     }
 
-    // throwing (uncaught) exceptions needs to happen outside of critical section (see OpenMP reference manual)
-    if (!residue_found)
+    std::unique_lock<std::shared_mutex> lock(modified_residues_mutex_);
+    // another thread may have created it in the meantime
+    const Residue* res = findModifiedResidue_(res_name, id);
+    if (res == nullptr)
     {
-      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Residue not found: ", res_name);
+      // create and register this modified residue
+      Residue* new_res = new Residue(*residue_names_.at(res_name));
+      new_res->setModification(mod);
+      addResidue_(new_res);
+      res = new_res;
     }
-    
     return res;
   }
 }
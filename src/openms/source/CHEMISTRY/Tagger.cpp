@@ -13,6 +13,8 @@
 #include <OpenMS/MATH/MathFunctions.h>
 #include <OpenMS/KERNEL/MSSpectrum.h>
 
+#include <algorithm>
+
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -25,31 +27,48 @@ namespace OpenMS
     if (m < min_gap_ || m > max_gap_) return ' ';
 
     const double delta = Math::ppmToMass(ppm_, m);
-    auto left = mass2aa_.lower_bound(m - delta);
-    //if (left == mass2aa_.end()) return ' '; // cannot happen, since we checked boundaries above
+    auto left = std::lower_bound(aa_masses_.begin(), aa_masses_.end(), m - delta);
+    //if (left == aa_masses_.end()) return ' '; // cannot happen, since we checked boundaries above
 
-    if (fabs(left->first - m) < delta) return left->second;
+    if (fabs(*left - m) < delta) return aa_codes_[left - aa_masses_.begin()];
     return ' ';
   }
 
-  void Tagger::getTag_(std::string & tag, const std::vector<double>& mzs, const size_t i, std::vector<std::string>& tags, const size_t charge) const
+  void Tagger::buildPeakGraph_(const std::vector<double>& mzs, const size_t charge, PeakGraph_& graph) const
   {
     const size_t N = mzs.size();
-    size_t j = i + 1;
-    while (j < N)
+    graph.first_edge.assign(N + 1, 0);
+    graph.edges.clear();
+    for (size_t i = 0; i < N; ++i)
+    {
+      graph.first_edge[i] = graph.edges.size();
+      for (size_t j = i + 1; j < N; ++j)
+      {
+        const double gap = mzs[j] - mzs[i];
+        if ((gap * charge) > max_gap_)
+        {
+          break; // already too far away - continue with next parent
+        }
+        const char aa = getAAByMass_(gap * charge);
+        if (aa != ' ')
+        {
+          graph.edges.emplace_back(j, aa);
+        }
+      }
+    }
+    graph.first_edge[N] = graph.edges.size();
+  }
+
+  void Tagger::getTag_(std::string & tag, const PeakGraph_& graph, const size_t i, std::vector<std::string>& tags) const
+  {
+    for (size_t e = graph.first_edge[i]; e < graph.first_edge[i + 1]; ++e)
     {
       if (tag.size() == max_tag_length_) 
       { 
         return; // maximum tag size reached? - continue with next parent
       }
-      const double gap = mzs[j] - mzs[i];
-      if ((gap * charge) > max_gap_) 
-      { 
-        return; // already too far away - continue with next parent 
-      } 
-
-      const char aa = getAAByMass_(gap * charge);
-      if (aa == ' ') { ++j; continue; } // can't extend tag
+      const size_t j = graph.edges[e].first;
+      const char aa = graph.edges[e].second;
 
       tag += aa;
 
@@ -58,7 +77,7 @@ namespace OpenMS
           tags.push_back(tag);
       }
 
-      getTag_(tag, mzs, j, tags, charge);
+      getTag_(tag, graph, j, tags);
 
       // if aa is "L", then also add "I" as an alternative residue and extend the tag again
       // this will add redundancy, (and redundant runtime) but we avoid dealing with J and ambiguous matching to I and L later on
@@ -71,10 +90,9 @@ namespace OpenMS
         {
           tags.push_back(tag);
         }
-        getTag_(tag, mzs, j, tags, charge);
+        getTag_(tag, graph, j, tags);
       }
       tag.pop_back();  // remove last string
-      ++j;
     }
   }
 
@@ -123,6 +141,12 @@ namespace OpenMS
       mass2aa_[mass] = name;
     }
 
+    for (const auto& m2a : mass2aa_)
+    {
+      aa_masses_.push_back(m2a.first);
+      aa_codes_.push_back(m2a.second);
+    }
+
     min_gap_ = mass2aa_.begin()->first - Math::ppmToMass(ppm, mass2aa_.begin()->first);
     max_gap_ = mass2aa_.rbegin()->first + Math::ppmToMass(ppm, mass2aa_.rbegin()->first);
   }
@@ -132,16 +156,25 @@ namespace OpenMS
     // start peak
     if (min_tag_length_ > mzs.size()) return; // avoid segfault
 
+    // residue matches between all peak pairs, per charge; the tag search below extends
+    // tags along these edges instead of comparing the peaks again for every partial tag
+    std::vector<PeakGraph_> graphs(max_charge_ >= min_charge_ ? max_charge_ - min_charge_ + 1 : 0);
+#pragma omp parallel for schedule(dynamic, 1) if (graphs.size() > 1)
+    for (int c = 0; c < static_cast<int>(graphs.size()); ++c)
+    {
+      buildPeakGraph_(mzs, min_charge_ + c, graphs[c]);
+    }
+
 #pragma omp parallel
     {
       std::vector<std::string> tags_local;
 #pragma omp for schedule(guided)
       for (int i = 0; i < static_cast<int>(mzs.size() - min_tag_length_); ++i)
       {
-        for (size_t charge = min_charge_; charge <= max_charge_; ++charge)
+        for (const PeakGraph_& graph : graphs)
         {
           std::string tag;
-          getTag_(tag, mzs, i, tags_local, charge);
+          getTag_(tag, graph, i, tags_local);
         }
       } // end of loop over starting peaks
 #pragma omp critical (join_tags)
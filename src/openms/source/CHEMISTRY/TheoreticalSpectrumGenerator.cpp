@@ -15,7 +15,6 @@
 #include <OpenMS/CHEMISTRY/AASequence.h>
 #include <OpenMS/CHEMISTRY/ResidueDB.h>
 #include <OpenMS/KERNEL/MSSpectrum.h>
-#include <OpenMS/CONCEPT/RAIICleanup.h>
 
 using namespace std;
 
@@ -132,22 +131,13 @@ namespace OpenMS
     PeakSpectrum::StringDataArray* ion_names;
     PeakSpectrum::IntegerDataArray* charges;
 
-    bool charges_dynamic = false;
-    bool ion_names_dynamic = false;
-
-    // Assure memory is freed even if an exception occurs.
-    RAIICleanup _(
-      [&]
-        {
-          if (charges_dynamic) delete charges;
-          if (ion_names_dynamic) delete ion_names;
-        }
-    );
+    // local arrays are used (and moved into the spectrum) if the spectrum has none yet
+    PeakSpectrum::StringDataArray local_ion_names;
+    PeakSpectrum::IntegerDataArray local_charges;
 
     if (spectrum.getIntegerDataArrays().empty())
     {
-      charges = new PeakSpectrum::IntegerDataArray();
-      charges_dynamic = true;
+      charges = &local_charges;
     }
     else
     {
@@ -155,8 +145,7 @@ namespace OpenMS
     }
     if (spectrum.getStringDataArrays().empty())
     {
-      ion_names = new PeakSpectrum::StringDataArray();
-      ion_names_dynamic = true;
+      ion_names = &local_ion_names;
     }
     else
     {
@@ -165,16 +154,24 @@ namespace OpenMS
     ion_names->setName(Constants::UserParam::IonNames);
     charges->setName("Charges");
 
-    for (Int z = min_charge; z <= max_charge; ++z)
+    if (!add_metainfo_ && !add_isotopes_ && !add_losses_)
     {
-      if (add_b_ions_) addPeaks_(spectrum, peptide, *ion_names, *charges, chunks, Residue::BIon, z);
-      if (add_y_ions_) addPeaks_(spectrum, peptide, *ion_names, *charges, chunks, Residue::YIon, z);
-      if (add_a_ions_) addPeaks_(spectrum, peptide, *ion_names, *charges, chunks, Residue::AIon, z);
-      if (add_c_ions_) addPeaks_(spectrum, peptide, *ion_names, *charges, chunks, Residue::CIon, z);
-      if (add_x_ions_) addPeaks_(spectrum, peptide, *ion_names, *charges, chunks, Residue::XIon, z);
-      if (add_z_ions_) addPeaks_(spectrum, peptide, *ion_names, *charges, chunks, Residue::ZIon, z);
-      if (add_zp1_ions_) addPeaks_(spectrum, peptide, *ion_names, *charges, chunks, Residue::Zp1Ion, z);
-      if (add_zp2_ions_) addPeaks_(spectrum, peptide, *ion_names, *charges, chunks, Residue::Zp2Ion, z);
+      // plain, unannotated ion ladders
+      addPeaksFast_(spectrum, peptide, chunks, min_charge, max_charge);
+    }
+    else
+    {
+      for (Int z = min_charge; z <= max_charge; ++z)
+      {
+        if (add_b_ions_) addPeaks_(spectrum, peptide, *ion_names, *charges, chunks, Residue::BIon, z);
+        if (add_y_ions_) addPeaks_(spectrum, peptide, *ion_names, *charges, chunks, Residue::YIon, z);
+        if (add_a_ions_) addPeaks_(spectrum, peptide, *ion_names, *charges, chunks, Residue::AIon, z);
+        if (add_c_ions_) addPeaks_(spectrum, peptide, *ion_names, *charges, chunks, Residue::CIon, z);
+        if (add_x_ions_) addPeaks_(spectrum, peptide, *ion_names, *charges, chunks, Residue::XIon, z);
+        if (add_z_ions_) addPeaks_(spectrum, peptide, *ion_names, *charges, chunks, Residue::ZIon, z);
+        if (add_zp1_ions_) addPeaks_(spectrum, peptide, *ion_names, *charges, chunks, Residue::Zp1Ion, z);
+        if (add_zp2_ions_) addPeaks_(spectrum, peptide, *ion_names, *charges, chunks, Residue::Zp2Ion, z);
+      }
     }
 
     if (add_precursor_peaks_)
@@ -538,6 +535,83 @@ namespace OpenMS
     }
   }
 
+  void TheoreticalSpectrumGenerator::addPeaksFast_(PeakSpectrum& spectrum,
+                                                   const AASequence& peptide,
+                                                   MSSpectrum::Chunks& chunks,
+                                                   Int min_charge,
+                                                   Int max_charge) const
+  {
+    const Size n = peptide.size();
+    if ((add_c_ions_ || add_x_ions_) && n < 2)
+    {
+      throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 1);
+    }
+
+    // residue masses of the N-terminal fragments (prefix[k]: first k residues)
+    // and the C-terminal fragments (suffix[k]: last k residues), computed
+    // once instead of for every ion type and charge
+    std::vector<double> prefix(n), suffix(n);
+    double mass = peptide.hasNTerminalModification() ? peptide.getNTerminalModification()->getDiffMonoMass() : 0.0;
+    for (Size k = 1; k < n; ++k)
+    {
+      mass += peptide[k - 1].getMonoWeight(Residue::Internal); // standard internal residue including named modifications
+      prefix[k] = mass;
+    }
+    mass = peptide.hasCTerminalModification() ? peptide.getCTerminalModification()->getDiffMonoMass() : 0.0;
+    for (Size k = 1; k < n; ++k)
+    {
+      mass += peptide[n - k].getMonoWeight(Residue::Internal);
+      suffix[k] = mass;
+    }
+
+    static const double stat_a = Residue::getInternalToAIon().getMonoWeight();
+    static const double stat_b = Residue::getInternalToBIon().getMonoWeight();
+    static const double stat_c = Residue::getInternalToCIon().getMonoWeight();
+    static const double stat_x = Residue::getInternalToXIon().getMonoWeight();
+    static const double stat_y = Residue::getInternalToYIon().getMonoWeight();
+    static const double stat_z = Residue::getInternalToZIon().getMonoWeight();
+    static const double stat_zp1 = Residue::getInternalToZp1Ion().getMonoWeight();
+    static const double stat_zp2 = Residue::getInternalToZp2Ion().getMonoWeight();
+
+    const Size nr_ion_types = Size(add_b_ions_) + Size(add_y_ions_) + Size(add_a_ions_) + Size(add_c_ions_) +
+                              Size(add_x_ions_) + Size(add_z_ions_) + Size(add_zp1_ions_) + Size(add_zp2_ions_);
+    if (max_charge >= min_charge)
+    {
+      spectrum.reserve(spectrum.size() + nr_ion_types * (max_charge - min_charge + 1) * n);
+    }
+
+    // appends the ions of the given ordinals as one sorted chunk
+    auto addLadder = [&](const std::vector<double>& ladder, Size first, double ion_offset, double intensity, Int charge)
+    {
+      const Size start = spectrum.size();
+      if (first < n)
+      {
+        spectrum.resize(start + n - first);
+      }
+      const double shift = Constants::PROTON_MASS_U * charge + ion_offset;
+      for (Size k = first; k < n; ++k)
+      {
+        Peak1D& p = spectrum[start + k - first];
+        p.setMZ((ladder[k] + shift) / charge);
+        p.setIntensity(intensity);
+      }
+      chunks.add(true);
+    };
+
+    // same ion types and order as in getSpectrum (without losses and isotopes)
+    const Size first_prefix = add_first_prefix_ion_ ? 1 : 2;
+    for (Int z = min_charge; z <= max_charge; ++z)
+    {
+      if (add_b_ions_) addLadder(prefix, first_prefix, stat_b, b_intensity_, z);
+      if (add_y_ions_) addLadder(suffix, 1, stat_y, y_intensity_, z);
+      if (add_a_ions_) addLadder(prefix, first_prefix, stat_a, a_intensity_, z);
+      if (add_c_ions_) addLadder(prefix, first_prefix, stat_c, c_intensity_, z);
+      if (add_x_ions_) addLadder(suffix, 1, stat_x, x_intensity_, z);
+      if (add_z_ions_) addLadder(suffix, 1, stat_z, z_intensity_, z);
+      if (add_zp1_ions_) addLadder(suffix, 1, stat_zp1, z_intensity_, z);
+      if (add_zp2_ions_) addLadder(suffix, 1, stat_zp2, z_intensity_, z);
+    }
+  }
 
   void TheoreticalSpectrumGenerator::addPeaks_(PeakSpectrum& spectrum,
                                                const AASequence& peptide,
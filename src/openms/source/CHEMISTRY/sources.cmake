@@ -5,6 +5,7 @@ set(directory source/CHEMISTRY)
 set(sources_list
 AAIndex.cpp
 AASequence.cpp
+AASequenceCache.cpp
 AdductInfo.cpp
 CrossLinksDB.cpp
 DecoyGenerator.cpp
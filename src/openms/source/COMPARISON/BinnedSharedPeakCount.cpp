@@ -61,4 +61,27 @@ namespace OpenMS
     return static_cast<double>(s.nonZeros()) / denominator;
   }
 
+  std::vector<double> BinnedSharedPeakCount::scoreAll(const BinnedSpectrum& query, const std::vector<BinnedSpectrum>& library) const
+  {
+    const DenseQuery_ dense(query);
+    const SignedSize dense_size = dense.filled.size();
+    const size_t query_peaks = query.getBins()->nonZeros();
+    std::vector<double> scores(library.size());
+#pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize i = 0; i < (SignedSize)library.size(); ++i)
+    {
+      OPENMS_PRECONDITION(BinnedSpectrum::isCompatible(query, library[i]), "Binned spectra have different bin size or spread");
+      const BinnedSpectrum::SparseVectorType& bins = *library[i].getBins();
+      const int* index = bins.innerIndexPtr();
+      size_t shared(0);
+      for (SignedSize k = 0; k < (SignedSize)bins.nonZeros(); ++k)
+      {
+        if (index[k] < dense_size) shared += dense.filled[index[k]];
+      }
+      const size_t denominator(max(query_peaks, size_t(bins.nonZeros())));
+      scores[i] = static_cast<double>(shared) / denominator;
+    }
+    return scores;
+  }
+
 }
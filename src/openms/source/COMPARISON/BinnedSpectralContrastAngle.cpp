@@ -59,5 +59,29 @@ namespace OpenMS
 
     return score;
   }
+
+  std::vector<double> BinnedSpectralContrastAngle::scoreAll(const BinnedSpectrum& query, const std::vector<BinnedSpectrum>& library) const
+  {
+    const DenseQuery_ dense(query);
+    const SignedSize dense_size = dense.intensity.size();
+    const double sum1 = query.getBins()->dot(*query.getBins());
+    std::vector<double> scores(library.size());
+#pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize i = 0; i < (SignedSize)library.size(); ++i)
+    {
+      OPENMS_PRECONDITION(BinnedSpectrum::isCompatible(query, library[i]), "Binned spectra have different bin size or spread");
+      const BinnedSpectrum::SparseVectorType& bins = *library[i].getBins();
+      const int* index = bins.innerIndexPtr();
+      const float* value = bins.valuePtr();
+      double sum2(0), numerator(0);
+      for (SignedSize k = 0; k < (SignedSize)bins.nonZeros(); ++k)
+      {
+        sum2 += double(value[k]) * value[k];
+        if (index[k] < dense_size) numerator += double(value[k]) * dense.intensity[index[k]];
+      }
+      scores[i] = numerator / (sqrt(sum1 * sum2));
+    }
+    return scores;
+  }
 }
 
@@ -11,6 +11,11 @@
 #include <OpenMS/COMPARISON/BinnedSpectralContrastAngle.h>
 #include <OpenMS/COMPARISON/BinnedSumAgreeingIntensities.h>
 
+#include <Eigen/Sparse>
+
+#include <algorithm>
+#include <limits>
+
 using namespace std;
 
 namespace OpenMS
@@ -33,4 +38,52 @@ namespace OpenMS
     return *this;
   }
 
+  std::vector<double> BinnedSpectrumCompareFunctor::scoreAll(const BinnedSpectrum& query, const std::vector<BinnedSpectrum>& library) const
+  {
+    std::vector<double> scores(library.size());
+#pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize i = 0; i < (SignedSize)library.size(); ++i)
+    {
+      scores[i] = operator()(query, library[i]);
+    }
+    return scores;
+  }
+
+  std::vector<std::pair<Size, double>> BinnedSpectrumCompareFunctor::topK(const BinnedSpectrum& query, const std::vector<BinnedSpectrum>& library, Size k) const
+  {
+    const std::vector<double> scores = scoreAll(query, library);
+    std::vector<std::pair<Size, double>> hits;
+    hits.reserve(scores.size());
+    for (Size i = 0; i < scores.size(); ++i)
+    {
+      hits.emplace_back(i, scores[i]);
+    }
+    auto rank = [](double score) { return std::isnan(score) ? -std::numeric_limits<double>::infinity() : score; };
+    k = std::min(k, hits.size());
+    std::partial_sort(hits.begin(), hits.begin() + k, hits.end(),
+      [&rank](const std::pair<Size, double>& a, const std::pair<Size, double>& b)
+      {
+        const double ra = rank(a.second), rb = rank(b.second);
+        return ra > rb || (ra == rb && a.first < b.first);
+      });
+    hits.resize(k);
+    return hits;
+  }
+
+  BinnedSpectrumCompareFunctor::DenseQuery_::DenseQuery_(const BinnedSpectrum& spec)
+  {
+    const BinnedSpectrum::SparseVectorType& bins = *spec.getBins();
+    const int* index = bins.innerIndexPtr();
+    const float* value = bins.valuePtr();
+    const SignedSize n = bins.nonZeros();
+    const Size size = (n == 0) ? 0 : Size(*std::max_element(index, index + n)) + 1;
+    intensity.assign(size, 0.0f);
+    filled.assign(size, 0);
+    for (SignedSize k = 0; k < n; ++k)
+    {
+      intensity[index[k]] = value[k];
+      filled[index[k]] = 1;
+    }
+  }
+
 }
@@ -64,5 +64,34 @@ namespace OpenMS
     // resulting score normalized to interval [0,1]
     return min(sum_nn / ((sum1 + sum2) / 2.0), 1.0);
   }
+
+  std::vector<double> BinnedSumAgreeingIntensities::scoreAll(const BinnedSpectrum& query, const std::vector<BinnedSpectrum>& library) const
+  {
+    const DenseQuery_ dense(query);
+    const SignedSize dense_size = dense.filled.size();
+    const double sum1 = query.getBins()->sum();
+    std::vector<double> scores(library.size());
+#pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize i = 0; i < (SignedSize)library.size(); ++i)
+    {
+      OPENMS_PRECONDITION(BinnedSpectrum::isCompatible(query, library[i]), "Binned spectra have different bin size or spread");
+      const BinnedSpectrum::SparseVectorType& bins = *library[i].getBins();
+      const int* index = bins.innerIndexPtr();
+      const float* value = bins.valuePtr();
+      double sum2(0), sum_nn(0);
+      for (SignedSize k = 0; k < (SignedSize)bins.nonZeros(); ++k)
+      {
+        sum2 += value[k];
+        // bins filled in only one of the spectra have a negative contribution (which is truncated)
+        if (index[k] < dense_size && dense.filled[index[k]])
+        {
+          const float a = dense.intensity[index[k]];
+          sum_nn += max(0.0f, (a + value[k]) * 0.5f - fabs(a - value[k]));
+        }
+      }
+      scores[i] = min(sum_nn / ((sum1 + sum2) / 2.0), 1.0);
+    }
+    return scores;
+  }
 }
 
@@ -14,10 +14,59 @@
 #include <OpenMS/KERNEL/MSSpectrum.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 
+#include <algorithm>
+
 using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /**
+      @brief Mean and variance of the m/z distances |pos1 - pos2| of all peak pairs of @p spec1 and @p spec2
+
+      Uses sorted positions and prefix sums instead of visiting all pairs, i.e. O((n + m) log m) instead of O(n * m).
+    */
+    void peakDistanceMoments(const PeakSpectrum& spec1, const PeakSpectrum& spec2, double& mid, double& var)
+    {
+      vector<double> pos2;
+      pos2.reserve(spec2.size());
+      double mean2(0);
+      for (const Peak1D& p : spec2)
+      {
+        pos2.push_back(p.getMZ());
+        mean2 += p.getMZ();
+      }
+      mean2 /= spec2.size();
+      sort(pos2.begin(), pos2.end());
+
+      // prefix[k] = sum of the k smallest positions of spec2
+      vector<double> prefix(pos2.size() + 1, 0);
+      double squares2(0);
+      for (Size j = 0; j < pos2.size(); ++j)
+      {
+        prefix[j + 1] = prefix[j] + pos2[j];
+        squares2 += (pos2[j] - mean2) * (pos2[j] - mean2);
+      }
+
+      // sum of |pos1 - pos2| and of (pos1 - pos2)^2 over all pairs
+      const double m(pos2.size());
+      double sum(0), sum_squares(spec1.size() * squares2);
+      for (const Peak1D& p : spec1)
+      {
+        const double pos1(p.getMZ());
+        const Size k = upper_bound(pos2.begin(), pos2.end(), pos1) - pos2.begin();
+        sum += pos1 * k - prefix[k] + (prefix.back() - prefix[k]) - pos1 * (m - k);
+        sum_squares += m * (pos1 - mean2) * (pos1 - mean2);
+      }
+
+      const double pairs(spec1.size() * spec2.size());
+      mid = sum / pairs;
+      // a single distance has no variance (avoids rounding noise)
+      var = pairs == 1 ? 0 : max(0.0, sum_squares / pairs - mid * mid);
+    }
+  }
+
   PeakAlignment::PeakAlignment() :
     PeakSpectrumCompareFunctor()
   {
@@ -49,8 +98,6 @@ namespace OpenMS
   double PeakAlignment::operator()(const PeakSpectrum& spec1, const PeakSpectrum& spec2) const
   {
 
-    PeakSpectrum s1(spec1), s2(spec2);
-
     // shortcut similarity calculation by comparing PrecursorPeaks (PrecursorPeaks more than delta away from each other are supposed to be from another peptide)
     double pre_mz1 = 0.0;
     if (!spec1.getPrecursors().empty())
@@ -73,6 +120,7 @@ namespace OpenMS
     bool heuristic_filters(true);
     if (heuristic_level)
     {
+      PeakSpectrum s1(spec1), s2(spec2);
       s1.sortByIntensity(true);
       s2.sortByIntensity(true);
 
@@ -109,37 +157,12 @@ namespace OpenMS
       matrix(0, i) = -gap * i;
     }
 
-    //get sigma - the standard deviation (sqrt of variance)
-    double mid(0);
-    for (Size i = 0; i < spec1.size(); ++i)
-    {
-      for (Size j = 0; j < spec2.size(); ++j)
-      {
-        double pos1(spec1[i].getMZ()), pos2(spec2[j].getMZ());
-        mid += fabs(pos1 - pos2);
-      }
-    }
-    // average peak distance
-    mid /= (spec1.size() * spec2.size());
+    //get sigma - the standard deviation (sqrt of variance) of the peak distances
+    double mid(0), var(0);
+    peakDistanceMoments(spec1, spec2, mid, var);
 
     /* to manually retrace
     cout << "average peak distance " << mid << endl;
-    */
-
-
-    double var(0);
-    for (Size i = 0; i < spec1.size(); ++i)
-    {
-      for (Size j = 0; j < spec2.size(); ++j)
-      {
-        double pos1(spec1[i].getMZ()), pos2(spec2[j].getMZ());
-        var += (fabs(pos1 - pos2) - mid) * (fabs(pos1 - pos2) - mid);
-      }
-    }
-    // peak distance variance
-    var /= (spec1.size() * spec2.size());
-
-    /* to manually retrace
     cout << "peak distance variance " << var << endl;
     */
 
@@ -249,35 +272,12 @@ namespace OpenMS
     // so traceback(i,j) represents matrix(i+1,j+1) and contains a "1"-from diagonal, a "0"-from left or a "2"-from above
     Matrix<Size> traceback(spec1.size(), spec2.size());
 
-    //get sigma - the standard deviation (sqrt of variance)
-    double mid(0);
-    for (Size i = 0; i < spec1.size(); ++i)
-    {
-      for (Size j = 0; j < spec2.size(); ++j)
-      {
-        double pos1(spec1[i].getMZ()), pos2(spec2[j].getMZ());
-        mid += fabs(pos1 - pos2);
-      }
-    }
-    mid /= (spec1.size() * spec2.size());
-
-    /* to manually retrace
-        cout << mid << endl;
-    */
-
-    double var(0);
-    for (Size i = 0; i < spec1.size(); ++i)
-    {
-      for (Size j = 0; j < spec2.size(); ++j)
-      {
-        double pos1(spec1[i].getMZ()), pos2(spec2[j].getMZ());
-        var += (fabs(pos1 - pos2) - mid) * (fabs(pos1 - pos2) - mid);
-      }
-    }
-    var /= (spec1.size() * spec2.size());
+    //get sigma - the standard deviation (sqrt of variance) of the peak distances
+    double mid(0), var(0);
+    peakDistanceMoments(spec1, spec2, mid, var);
 
     /* to manually retrace
-        cout << var << endl;
+        cout << mid << endl << var << endl;
     */
 
     const double sigma(sqrt(var));
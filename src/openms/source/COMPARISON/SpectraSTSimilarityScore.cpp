@@ -90,7 +90,7 @@ namespace OpenMS
     return spec.size() >= min_peak_number;
   }
 
-  BinnedSpectrum SpectraSTSimilarityScore::transform(const PeakSpectrum & spec)
+  BinnedSpectrum SpectraSTSimilarityScore::transform(const PeakSpectrum & spec) const
   {
     // TODO: resolution seems rather low. Check with current original implementations.
     BinnedSpectrum bin(spec, 1, false, 1, BinnedSpectrum::DEFAULT_BIN_OFFSET_LOWRES);
@@ -112,7 +112,7 @@ namespace OpenMS
     }
   }
 
-  double SpectraSTSimilarityScore::delta_D(double top_hit, double runner_up)
+  double SpectraSTSimilarityScore::delta_D(double top_hit, double runner_up) const
   {
     if (top_hit == 0)
     {
@@ -124,7 +124,7 @@ namespace OpenMS
     }
   }
 
-  double SpectraSTSimilarityScore::compute_F(double dot_product, double delta_D, double dot_bias)
+  double SpectraSTSimilarityScore::compute_F(double dot_product, double delta_D, double dot_bias) const
   {
     double b(0);
     if (dot_bias < 0.1 || (0.35 < dot_bias && dot_bias <= 0.4))
@@ -37,6 +37,9 @@ namespace OpenMS
   SpectrumCheapDPCorr::SpectrumCheapDPCorr(const SpectrumCheapDPCorr & source) :
     PeakSpectrumCompareFunctor(source),
     lastconsensus_(source.lastconsensus_),
+    variation_(source.variation_),
+    int_cnt_(source.int_cnt_),
+    keeppeaks_(source.keeppeaks_),
     factor_(source.factor_)
   {
   }
@@ -50,10 +53,18 @@ namespace OpenMS
       PeakSpectrumCompareFunctor::operator=(source);
       lastconsensus_ = source.lastconsensus_;
       factor_ = source.factor_;
+      updateMembers_();
     }
     return *this;
   }
 
+  void SpectrumCheapDPCorr::updateMembers_()
+  {
+    variation_ = (double)param_.getValue("variation");
+    int_cnt_ = (unsigned int)param_.getValue("int_cnt");
+    keeppeaks_ = (int)param_.getValue("keeppeaks");
+  }
+
   void SpectrumCheapDPCorr::setFactor(double f)
   {
     if (f < 1 && f > 0)
@@ -77,9 +88,8 @@ namespace OpenMS
   */
   double SpectrumCheapDPCorr::operator()(const PeakSpectrum & x, const PeakSpectrum & y) const
   {
-    double var = (double)param_.getValue("variation");
+    const double var = variation_;
     double score(0);
-    bool keeppeaks_ = (int)param_.getValue("keeppeaks");
 
     lastconsensus_ = PeakSpectrum();
     Precursor p1, p2;
@@ -205,7 +215,7 @@ namespace OpenMS
 #ifdef SPECTRUMCHEAPDPCORR_DEBUG
     cerr << "SpectrumCheapDPCorr::dynprog_(const DDiscreteSpectrum<1>& x, const DDiscreteSpectrum<1>& y, " << xstart << ", " << xend << ", " <<  ystart << ", " << yend << ")" <<  endl;
 #endif
-    double var = (double)param_.getValue("variation");
+    const double var = variation_;
     vector<vector<double> > dparray(xend - xstart + 2, vector<double>(yend - ystart + 2));
     vector<vector<int> > trace(xend - xstart + 2, vector<int>(yend - ystart + 2));
     double align;
@@ -317,11 +327,10 @@ namespace OpenMS
    */
   double SpectrumCheapDPCorr::comparepeaks_(double posa, double posb, double inta, double intb) const
   {
-    double variation = (posa + posb) / 2 * (double)param_.getValue("variation");
+    double variation = (posa + posb) / 2 * variation_;
     boost::math::normal_distribution<double> normal(0., variation);
 
-
-    unsigned int int_cnt = (unsigned int)param_.getValue("int_cnt");
+    const unsigned int int_cnt = int_cnt_;
     if (int_cnt == 0)
     {
       double p = boost::math::pdf(normal, posa - posb);
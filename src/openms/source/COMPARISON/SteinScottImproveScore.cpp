@@ -35,10 +35,17 @@ namespace OpenMS
     if (this != &source)
     {
       PeakSpectrumCompareFunctor::operator=(source);
+      updateMembers_();
     }
     return *this;
   }
 
+  void SteinScottImproveScore::updateMembers_()
+  {
+    epsilon_ = (double)param_.getValue("tolerance");
+    threshold_ = (float)param_.getValue("threshold");
+  }
+
   /**
   @brief Similarity pairwise score itself
 
@@ -63,7 +70,7 @@ namespace OpenMS
   */
   double SteinScottImproveScore::operator()(const PeakSpectrum & s1, const PeakSpectrum & s2) const
   {
-    const double epsilon = (double)param_.getValue("tolerance");
+    const double epsilon = epsilon_;
     const double constant = epsilon / 10000;
 
     //const double c(0.0004);
@@ -112,7 +119,7 @@ namespace OpenMS
     //std::cout<< sum << " Sum " << z << " z " << std::endl;
     score = (sum - z) / (std::sqrt((sum1 * sum2)));
     // std::cout<<score<< " score" << std::endl;
-    if (score < (float)param_.getValue("threshold"))
+    if (score < threshold_)
     {
       score = 0;
     }
@@ -40,10 +40,19 @@ namespace OpenMS
     if (this != &source)
     {
       PeakSpectrumCompareFunctor::operator=(source);
+      updateMembers_();
     }
     return *this;
   }
 
+  void ZhangSimilarityScore::updateMembers_()
+  {
+    tolerance_ = (double)param_.getValue("tolerance");
+    is_relative_tolerance_ = param_.getValue("is_relative_tolerance").toBool();
+    use_linear_factor_ = param_.getValue("use_linear_factor").toBool();
+    use_gaussian_factor_ = param_.getValue("use_gaussian_factor").toBool();
+  }
+
   double ZhangSimilarityScore::operator()(const PeakSpectrum & spec) const
   {
     return operator()(spec, spec);
@@ -51,13 +60,11 @@ namespace OpenMS
 
   double ZhangSimilarityScore::operator()(const PeakSpectrum & s1, const PeakSpectrum & s2) const
   {
-    const double tolerance = (double)param_.getValue("tolerance");
-    bool use_linear_factor = param_.getValue("use_linear_factor").toBool();
-    bool use_gaussian_factor = param_.getValue("use_gaussian_factor").toBool();
+    const double tolerance = tolerance_;
     double score(0), sum(0), sum1(0), sum2(0) /*, squared_sum1(0), squared_sum2(0)*/;
 
     // TODO remove parameter 
-    if (param_.getValue("is_relative_tolerance").toBool() )
+    if (is_relative_tolerance_)
     {
       throw Exception::NotImplemented(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
     }
@@ -152,9 +159,9 @@ for (PeakSpectrum::ConstIterator it2 = s2.begin(); it2 != s2.end(); ++it2)
           //double factor((tolerance - fabs(pos1 - pos2)) / tolerance);
           double factor = 1.0;
 
-          if (use_linear_factor || use_gaussian_factor)
+          if (use_linear_factor_ || use_gaussian_factor_)
           {
-            factor = getFactor_(tolerance, fabs(pos1 - pos2), use_gaussian_factor);
+            factor = getFactor_(tolerance, fabs(pos1 - pos2), use_gaussian_factor_);
           }
           sum += sqrt(s1[i].getIntensity() * s2[j].getIntensity() * factor);
         }
@@ -197,7 +204,7 @@ for (PeakSpectrum::ConstIterator it1 = s1.begin(); it1 != s1.end(); ++it1)
 
     if (is_gaussian)
     {
-      static const double denominator = mz_tolerance * 3.0 * sqrt(2.0);
+      const double denominator = mz_tolerance * 3.0 * sqrt(2.0);
       factor = std::erfc(mz_difference / denominator);
       //cerr << "Factor: " << factor << " " << mz_tolerance << " " << mz_difference << endl;
     }
@@ -26,6 +26,8 @@
 
 #include <sstream>
 #include <iostream>
+#include <memory>
+#include <vector>
 
 #define BUFFER_LENGTH 32768
 
@@ -446,6 +448,7 @@ namespace OpenMS
       LogStreamBuf::StreamStruct s_struct;
       s_struct.stream = &stream;
       rdbuf()->stream_list_.push_back(s_struct);
+      rdbuf()->active_ = true;
     }
 
     void LogStream::remove(std::ostream & stream)
@@ -460,6 +463,7 @@ namespace OpenMS
         // HINT: we do NOT clear the cache (because we cannot access it from here)
         //       and we do not flush incomplete_line_!!!
         rdbuf()->stream_list_.erase(it);
+        rdbuf()->active_ = !rdbuf()->stream_list_.empty();
       }
     }
 
@@ -470,6 +474,7 @@ namespace OpenMS
 
       rdbuf()->sync();
       rdbuf()->stream_list_.clear();
+      rdbuf()->active_ = false;
     }
 
     void LogStream::insertNotification(std::ostream & s, LogStreamNotifier & target)
@@ -544,6 +549,72 @@ namespace OpenMS
       std::ostream::flush();
     }
 
+    namespace
+    {
+      /// Buffers of the log statements of a thread (a stack, since formatting a message may log itself)
+      struct StatementBuffers
+      {
+        std::vector<std::unique_ptr<std::ostringstream>> buffers;
+        Size depth = 0;
+
+        ~StatementBuffers();
+      };
+
+      /// set when the buffers of the thread are gone (logging from destructors of static objects at exit)
+      thread_local bool statement_buffers_destroyed = false;
+
+      StatementBuffers::~StatementBuffers()
+      {
+        statement_buffers_destroyed = true;
+      }
+
+      StatementBuffers& statementBuffers()
+      {
+        thread_local StatementBuffers buffers;
+        return buffers;
+      }
+    }
+
+    LogStatement::LogStatement(LogStream& target) :
+      target_(target)
+    {
+      if (statement_buffers_destroyed)
+      {
+        buffer_ = new std::ostringstream();
+        owned_ = true;
+        return;
+      }
+      StatementBuffers& buffers = statementBuffers();
+      if (buffers.depth == buffers.buffers.size())
+      {
+        buffers.buffers.push_back(std::make_unique<std::ostringstream>());
+      }
+      buffer_ = buffers.buffers[buffers.depth++].get();
+    }
+
+    LogStatement::~LogStatement()
+    {
+      const std::string text = buffer_->str();
+      OPENMS_THREAD_CRITICAL(LOGSTREAM)
+      {
+        target_.write(text.data(), text.size());
+        target_.flush();
+      }
+      if (owned_)
+      {
+        delete buffer_;
+        return;
+      }
+      // reset the buffer (content and format) for the next statement
+      buffer_->str(std::string());
+      buffer_->clear();
+      buffer_->flags(std::ios_base::skipws | std::ios_base::dec);
+      buffer_->precision(6);
+      buffer_->width(0);
+      buffer_->fill(' ');
+      --statementBuffers().depth;
+    }
+
   }   // namespace Logger
 
 
@@ -0,0 +1,178 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg$
+// $Authors: Timo Sachsenberg$
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/PerfCounters.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+using namespace std;
+
+namespace OpenMS
+{
+  using json = nlohmann::ordered_json;
+
+  const std::string PerfCounters::NamesOfCounter[] = {"spectra_decoded", "chromatograms_decoded", "bytes_decompressed", "candidates_scored",
+                                                      "cache_hits", "cache_misses", "lock_acquisitions", "lock_wait_ns"};
+
+  std::atomic<bool> PerfCounters::enabled_{false};
+
+  namespace
+  {
+    /// counters of one thread; only the owning thread writes them (on its own cache line)
+    struct alignas(64) ThreadCounters_
+    {
+      array<atomic<UInt64>, PerfCounters::SIZE_OF_COUNTER> counts{};
+    };
+
+    /// counters of all threads (kept after a thread ended)
+    struct CountersState_
+    {
+      mutex threads_mutex;
+      vector<shared_ptr<ThreadCounters_>> threads;
+    };
+
+    CountersState_& state_()
+    {
+      static CountersState_ state;
+      return state;
+    }
+
+    ThreadCounters_& threadCounters_()
+    {
+      thread_local shared_ptr<ThreadCounters_> counters = []()
+      {
+        auto c = make_shared<ThreadCounters_>();
+        CountersState_& state = state_();
+        lock_guard<mutex> lock(state.threads_mutex);
+        state.threads.push_back(c);
+        return c;
+      }();
+      return *counters;
+    }
+
+    UInt64 nowNs_()
+    {
+      return UInt64(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    json toJSON_(const PerfCounters::Counts& counts)
+    {
+      json j;
+      for (Size i = 0; i < PerfCounters::SIZE_OF_COUNTER; ++i)
+      {
+        j[PerfCounters::NamesOfCounter[i]] = counts[i];
+      }
+      return j;
+    }
+  }
+
+  PerfCounters::LockWait::LockWait() :
+    start_(PerfCounters::isEnabled() ? nowNs_() : 0)
+  {
+  }
+
+  void PerfCounters::LockWait::acquired()
+  {
+    if (start_ == 0)
+    {
+      return;
+    }
+    PerfCounters::add_(LOCK_WAIT_NS, nowNs_() - start_);
+    PerfCounters::add_(LOCK_ACQUISITIONS, 1);
+    start_ = 0;
+  }
+
+  void PerfCounters::setEnabled(bool enabled)
+  {
+    enabled_ = enabled;
+  }
+
+  void PerfCounters::add_(Counter counter, UInt64 count)
+  {
+    // single writer: no read-modify-write instruction needed
+    atomic<UInt64>& c = threadCounters_().counts[counter];
+    c.store(c.load(memory_order_relaxed) + count, memory_order_relaxed);
+  }
+
+  std::vector<PerfCounters::Counts> PerfCounters::getThreadCounts()
+  {
+    CountersState_& state = state_();
+    lock_guard<mutex> lock(state.threads_mutex);
+    vector<Counts> result;
+    result.reserve(state.threads.size());
+    for (const auto& thread : state.threads)
+    {
+      Counts counts;
+      for (Size i = 0; i < SIZE_OF_COUNTER; ++i)
+      {
+        counts[i] = thread->counts[i].load(memory_order_relaxed);
+      }
+      result.push_back(counts);
+    }
+    return result;
+  }
+
+  PerfCounters::Counts PerfCounters::getTotalCounts()
+  {
+    Counts total{};
+    for (const Counts& counts : getThreadCounts())
+    {
+      for (Size i = 0; i < SIZE_OF_COUNTER; ++i)
+      {
+        total[i] += counts[i];
+      }
+    }
+    return total;
+  }
+
+  void PerfCounters::reset()
+  {
+    CountersState_& state = state_();
+    lock_guard<mutex> lock(state.threads_mutex);
+    for (const auto& thread : state.threads)
+    {
+      for (auto& c : thread->counts)
+      {
+        c.store(0, memory_order_relaxed);
+      }
+    }
+  }
+
+  void PerfCounters::storeJSON(const String& filename, const String& tool)
+  {
+    const vector<Counts> thread_counts = getThreadCounts();
+    json threads = json::array();
+    for (Size t = 0; t < thread_counts.size(); ++t)
+    {
+      json thread;
+      thread["thread"] = t;
+      thread["counters"] = toJSON_(thread_counts[t]);
+      threads.push_back(std::move(thread));
+    }
+
+    json doc;
+    doc["tool"] = tool;
+    doc["totals"] = toJSON_(getTotalCounts());
+    doc["threads"] = std::move(threads);
+
+    ofstream os(filename.c_str());
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    os << doc.dump(2) << "\n";
+  }
+
+} // namespace OpenMS
@@ -9,6 +9,7 @@
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 
 #include <OpenMS/CONCEPT/Macros.h>
+#include <OpenMS/CONCEPT/ProgressProfiler.h>
 
 #include <OpenMS/SYSTEM/StopWatch.h>
 #include <OpenMS/SYSTEM/SysInfo.h>
@@ -235,6 +236,7 @@ public:
     last_invoke_ = time(nullptr);
     current_logger_->startProgress(begin, end, label, recursion_depth_);
     ++recursion_depth_;
+    ProgressProfiler::beginScope(label);
   }
 
   void ProgressLogger::setProgress(SignedSize value) const
@@ -267,6 +269,7 @@ public:
       --recursion_depth_;
     }
     current_logger_->endProgress(recursion_depth_, bytes_processed);
+    ProgressProfiler::endScope(bytes_processed);
   }
 
 } //namespace OpenMS
@@ -0,0 +1,252 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg$
+// $Authors: Timo Sachsenberg$
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ProgressProfiler.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/SYSTEM/StopWatch.h>
+#include <OpenMS/SYSTEM/SysInfo.h>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <tuple>
+
+using namespace std;
+
+namespace OpenMS
+{
+  using json = nlohmann::ordered_json;
+
+  namespace
+  {
+    /// a scope which was opened, but not closed yet
+    struct OpenScope_
+    {
+      String label;
+      double start;
+      StopWatch cpu_watch;
+    };
+
+    /// per-thread state: index of the thread and its stack of open scopes
+    struct ThreadScopes_
+    {
+      Size index;
+      vector<OpenScope_> open;
+    };
+
+    /// state shared by all threads
+    struct ProfilerState_
+    {
+      atomic<bool> enabled{false};
+      atomic<chrono::steady_clock::rep> epoch{chrono::steady_clock::now().time_since_epoch().count()};
+      atomic<Size> thread_count{0};
+      mutex records_mutex;
+      vector<ProgressProfiler::Record> records;
+    };
+
+    ProfilerState_& state_()
+    {
+      static ProfilerState_ state;
+      return state;
+    }
+
+    ThreadScopes_& threadScopes_()
+    {
+      thread_local ThreadScopes_ scopes{state_().thread_count++, {}};
+      return scopes;
+    }
+
+    /// wall time in seconds since enabling the profiler
+    double elapsed_()
+    {
+      const chrono::steady_clock::duration since_epoch(chrono::steady_clock::now().time_since_epoch().count() - state_().epoch.load());
+      return chrono::duration<double>(since_epoch).count();
+    }
+
+    /// nests the scopes of a single thread (sorted by start) whose depth is at least @p depth
+    json nestScopes_(const vector<ProgressProfiler::Record>& records, Size& i, Size depth)
+    {
+      json scopes = json::array();
+      while (i < records.size() && records[i].depth >= depth)
+      {
+        const ProgressProfiler::Record& r = records[i];
+        ++i;
+        json scope;
+        scope["label"] = r.label;
+        scope["start"] = r.start;
+        scope["wall_time"] = r.wall_time;
+        scope["cpu_time"] = r.cpu_time;
+        scope["peak_memory_kb"] = r.peak_memory;
+        scope["bytes_processed"] = r.bytes_processed;
+        scope["children"] = nestScopes_(records, i, r.depth + 1);
+        scopes.push_back(std::move(scope));
+      }
+      return scopes;
+    }
+
+    void storeJSONDocument_(const String& filename, const json& doc)
+    {
+      ofstream os(filename.c_str());
+      if (!os)
+      {
+        throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+      }
+      os << doc.dump(2) << "\n";
+    }
+  }
+
+  ProgressProfiler::Scope::Scope(const String& label)
+  {
+    ProgressProfiler::beginScope(label);
+  }
+
+  ProgressProfiler::Scope::~Scope()
+  {
+    ProgressProfiler::endScope(bytes_processed_);
+  }
+
+  void ProgressProfiler::Scope::setBytesProcessed(UInt64 bytes)
+  {
+    bytes_processed_ = bytes;
+  }
+
+  void ProgressProfiler::setEnabled(bool enabled)
+  {
+    ProfilerState_& state = state_();
+    if (enabled && !state.enabled)
+    {
+      state.epoch = chrono::steady_clock::now().time_since_epoch().count();
+    }
+    state.enabled = enabled;
+  }
+
+  bool ProgressProfiler::isEnabled()
+  {
+    return state_().enabled;
+  }
+
+  void ProgressProfiler::beginScope(const String& label)
+  {
+    if (!isEnabled())
+    {
+      return;
+    }
+    ThreadScopes_& scopes = threadScopes_();
+    scopes.open.push_back(OpenScope_{label, elapsed_(), StopWatch()});
+    scopes.open.back().cpu_watch.start();
+  }
+
+  void ProgressProfiler::endScope(UInt64 bytes_processed)
+  {
+    if (!isEnabled())
+    {
+      return;
+    }
+    ThreadScopes_& scopes = threadScopes_();
+    if (scopes.open.empty())
+    {
+      return;
+    }
+    OpenScope_& scope = scopes.open.back();
+    scope.cpu_watch.stop();
+
+    Record r;
+    r.label = scope.label;
+    r.depth = scopes.open.size() - 1;
+    r.thread = scopes.index;
+    r.start = scope.start;
+    r.wall_time = elapsed_() - scope.start;
+    r.cpu_time = scope.cpu_watch.getCPUTime();
+    SysInfo::getProcessPeakMemoryConsumption(r.peak_memory);
+    r.bytes_processed = bytes_processed;
+    scopes.open.pop_back();
+
+    ProfilerState_& state = state_();
+    lock_guard<mutex> lock(state.records_mutex);
+    state.records.push_back(std::move(r));
+  }
+
+  std::vector<ProgressProfiler::Record> ProgressProfiler::getRecords()
+  {
+    vector<Record> records;
+    {
+      ProfilerState_& state = state_();
+      lock_guard<mutex> lock(state.records_mutex);
+      records = state.records;
+    }
+    // records are added when closed; order them by opening (outer scopes first if they started at the same time)
+    stable_sort(records.begin(), records.end(), [](const Record& a, const Record& b)
+    {
+      return tie(a.thread, a.start, a.depth) < tie(b.thread, b.start, b.depth);
+    });
+    return records;
+  }
+
+  void ProgressProfiler::clear()
+  {
+    ProfilerState_& state = state_();
+    lock_guard<mutex> lock(state.records_mutex);
+    state.records.clear();
+  }
+
+  void ProgressProfiler::storeJSON(const String& filename)
+  {
+    const vector<Record> records = getRecords();
+
+    json threads = json::array();
+    for (Size i = 0; i < records.size(); )
+    {
+      // records of one thread are contiguous
+      Size end = i;
+      while (end < records.size() && records[end].thread == records[i].thread)
+      {
+        ++end;
+      }
+      vector<Record> thread_records(records.begin() + i, records.begin() + end);
+      Size pos = 0;
+      json thread;
+      thread["thread"] = records[i].thread;
+      thread["scopes"] = nestScopes_(thread_records, pos, 0);
+      threads.push_back(std::move(thread));
+      i = end;
+    }
+
+    json doc;
+    doc["threads"] = std::move(threads);
+    storeJSONDocument_(filename, doc);
+  }
+
+  void ProgressProfiler::storeTraceEvents(const String& filename)
+  {
+    json events = json::array();
+    for (const Record& r : getRecords())
+    {
+      json event;
+      event["name"] = r.label;
+      event["cat"] = "OpenMS";
+      event["ph"] = "X";
+      event["ts"] = r.start * 1e6; // microseconds
+      event["dur"] = r.wall_time * 1e6;
+      event["pid"] = 0;
+      event["tid"] = r.thread;
+      event["args"] = {{"cpu_time", r.cpu_time}, {"peak_memory_kb", r.peak_memory}, {"bytes_processed", r.bytes_processed}};
+      events.push_back(std::move(event));
+    }
+
+    json doc;
+    doc["traceEvents"] = std::move(events);
+    doc["displayTimeUnit"] = "ms";
+    storeJSONDocument_(filename, doc);
+  }
+
+} // namespace OpenMS
@@ -10,91 +10,177 @@
 
 #include <boost/date_time/posix_time/posix_time_types.hpp> //no i/o just types
 
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <set>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace OpenMS
 {
-  UInt64 UniqueIdGenerator::seed_ = 0;
-  UniqueIdGenerator* UniqueIdGenerator::instance_ = nullptr;
-  boost::mt19937_64* UniqueIdGenerator::rng_ = nullptr;
-  boost::uniform_int<UInt64>* UniqueIdGenerator::dist_ = nullptr;
-
-  UInt64 UniqueIdGenerator::getUniqueId()
+  namespace
   {
-    UniqueIdGenerator& instance = getInstance_();
-#ifdef _OPENMP
-    UInt64 val;
-#pragma omp critical (OPENMS_UniqueIdGenerator_getUniqueId)
+    /// Default seed, taken from the clock on first use
+    UInt64 clockSeed()
+    {
+      // get something with high resolution (around microseconds) -- its hard to do better on Windows --
+      // which has absolute system time (there is higher resolution available for the time since program startup, but
+      // we do not want this here since this seed usually gets initialized at the same program uptime).
+      // Reason for high-res: in pipelines, instances of TOPP tools can get initialized almost simultaneously (i.e., resolution in seconds is not enough),
+      // leading to identical random numbers (e.g. feature-IDs) in two or more distinct files.
+      boost::posix_time::ptime t(boost::posix_time::microsec_clock::local_time());
+      return t.time_of_day().ticks(); // independent of implementation; as opposed to nanoseconds(), which need not be available on every platform
+    }
+
+    /// The global seed and a counter of setSeed() calls, so threads notice that they need to reseed
+    struct GlobalState
+    {
+      std::atomic<UInt64> seed{clockSeed()};
+      std::atomic<UInt64> epoch{1};
+
+      /// Streams (generator numbers) claimed by live threads
+      std::mutex streams_mutex;
+      std::set<UInt64> streams;
+      /// Next stream for threads whose thread number is taken (above all OpenMP thread numbers)
+      UInt64 next_extra_stream = UInt64(1) << 32;
+    };
+
+    GlobalState& globalState()
     {
-      val = (*instance.dist_)(*instance.rng_);
+      static GlobalState state;
+      return state;
     }
-    // note: OpenMP can only work on a structured block, return needs to be outside that block
-    return val; 
+
+    /// SplitMix64 finalizer: decorrelates the seeds of the streams
+    UInt64 mixSeed(UInt64 x)
+    {
+      x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+      return x ^ (x >> 31);
+    }
+
+    /// Random generator of a thread
+    struct ThreadGenerator
+    {
+      static constexpr UInt64 NO_STREAM = std::numeric_limits<UInt64>::max();
+
+      UInt64 epoch = 0; // never a valid epoch: seeds on first use
+      UInt64 stream = NO_STREAM;
+      boost::mt19937_64 rng;
+      boost::uniform_int<UInt64> dist{0, std::numeric_limits<UInt64>::max()};
+
+      /// generator of the innermost ItemScope (if any)
+      bool scoped = false;
+      boost::mt19937_64 scoped_rng;
+
+      ~ThreadGenerator()
+      {
+        if (stream != NO_STREAM)
+        {
+          GlobalState& state = globalState();
+          std::lock_guard<std::mutex> lock(state.streams_mutex);
+          state.streams.erase(stream);
+        }
+      }
+
+      void seed(UInt64 current_epoch)
+      {
+        GlobalState& state = globalState();
+        if (stream == NO_STREAM)
+        {
+#ifdef _OPENMP
+          UInt64 wanted = UInt64(omp_get_thread_num());
 #else
-    return (*instance.dist_)(*instance.rng_);
+          UInt64 wanted = 0;
 #endif
+          std::lock_guard<std::mutex> lock(state.streams_mutex);
+          if (state.streams.count(wanted))
+          {
+            wanted = state.next_extra_stream++;
+          }
+          state.streams.insert(wanted);
+          stream = wanted;
+        }
+        const UInt64 global_seed = state.seed.load(std::memory_order_acquire);
+        // stream 0 uses the global seed as it is (same ids as a single generator for single threaded code)
+        rng.seed(stream == 0 ? global_seed : mixSeed(global_seed + stream * 0x9e3779b97f4a7c15ULL));
+        dist.reset();
+        epoch = current_epoch;
+      }
+    };
+
+    ThreadGenerator& threadGenerator()
+    {
+      thread_local ThreadGenerator generator;
+      return generator;
+    }
   }
 
-  UInt64 UniqueIdGenerator::getSeed()
+  UniqueIdGenerator::ItemScope::ItemScope(UInt64 item, bool enabled) :
+    enabled_(enabled)
   {
-    return getInstance_().seed_;
+    if (!enabled_)
+    {
+      return;
+    }
+    ThreadGenerator& generator = threadGenerator();
+    previous_scoped_ = generator.scoped;
+    if (previous_scoped_)
+    {
+      previous_rng_ = generator.scoped_rng;
+    }
+    const UInt64 global_seed = globalState().seed.load(std::memory_order_acquire);
+    generator.scoped_rng.seed(mixSeed(global_seed ^ mixSeed(item + 0x632be59bd9b4e019ULL)));
+    generator.scoped = true;
   }
 
-  void UniqueIdGenerator::setSeed(UInt64 seed)
+  UniqueIdGenerator::ItemScope::~ItemScope()
   {
-  // modifies static members
-#ifdef _OPENMP
-#pragma omp critical (OPENMS_UniqueIdGenerator_setSeed)
-#endif
+    if (!enabled_)
+    {
+      return;
+    }
+    ThreadGenerator& generator = threadGenerator();
+    generator.scoped = previous_scoped_;
+    if (previous_scoped_)
     {
-      UniqueIdGenerator& instance = getInstance_();
-      instance.seed_ = seed;
-      instance.rng_->seed( instance.seed_ );
-      instance.dist_->reset();
+      generator.scoped_rng = previous_rng_;
     }
   }
 
-  UniqueIdGenerator::UniqueIdGenerator() = default;
-
-  UniqueIdGenerator & UniqueIdGenerator::getInstance_()
+  UInt64 UniqueIdGenerator::getUniqueId()
   {
-  // modifies static members
-#ifdef _OPENMP
-#pragma omp critical (OPENMS_UniqueIdGenerator_getInstance_)
-#endif
+    ThreadGenerator& generator = threadGenerator();
+    if (generator.scoped)
     {
-      if (!instance_)
-      {
-        instance_ = new UniqueIdGenerator();
-        instance_->init_();
-      }
+      return generator.dist(generator.scoped_rng);
+    }
+    const UInt64 epoch = globalState().epoch.load(std::memory_order_acquire);
+    if (generator.epoch != epoch)
+    {
+      generator.seed(epoch);
     }
-    return *instance_;
+    return generator.dist(generator.rng);
   }
 
-  void UniqueIdGenerator::init_()
+  UInt64 UniqueIdGenerator::getSeed()
   {
-  // modifies static members
-#ifdef _OPENMP
-#pragma omp critical (OPENMS_UniqueIdGenerator_init_)
-#endif
-    { 
-      // find a seed:
-      // get something with high resolution (around microseconds) -- its hard to do better on Windows --
-      // which has absolute system time (there is higher resolution available for the time since program startup, but 
-      // we do not want this here since this seed usually gets initialized at the same program uptime).
-      // Reason for high-res: in pipelines, instances of TOPP tools can get initialized almost simultaneously (i.e., resolution in seconds is not enough),
-      // leading to identical random numbers (e.g. feature-IDs) in two or more distinct files.
-      // C++11 note: C++ build-in alternative once C++11 can be presumed: 'std::chrono::high_resolution_clock'
-      boost::posix_time::ptime t(boost::posix_time::microsec_clock::local_time() );
-      seed_ = t.time_of_day().ticks();  // independent of implementation; as opposed to nanoseconds(), which need not be available on every platform
-      rng_ = new boost::mt19937_64 (seed_);
-      dist_ = new boost::uniform_int<UInt64> (0, std::numeric_limits<UInt64>::max());
-    }
+    return globalState().seed.load(std::memory_order_acquire);
   }
 
-  UniqueIdGenerator::~UniqueIdGenerator()
+  void UniqueIdGenerator::setSeed(UInt64 seed)
   {
-    delete rng_;
-    delete dist_;
+    GlobalState& state = globalState();
+    state.seed.store(seed, std::memory_order_release);
+    // all threads (including the calling one) reseed before their next id
+    state.epoch.fetch_add(1, std::memory_order_acq_rel);
   }
 
+  UniqueIdGenerator::UniqueIdGenerator() = default;
+
+  UniqueIdGenerator::~UniqueIdGenerator() = default;
+
 }
@@ -13,8 +13,10 @@ GlobalExceptionHandler.cpp
 Init.cpp
 LogConfigHandler.cpp
 LogStream.cpp
+PerfCounters.cpp
 PrecisionWrapper.cpp
 ProgressLogger.cpp
+ProgressProfiler.cpp
 RAIICleanup.cpp
 StreamHandler.cpp
 Types.cpp
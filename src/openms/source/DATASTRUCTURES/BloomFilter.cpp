@@ -0,0 +1,91 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/DATASTRUCTURES/BloomFilter.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace OpenMS
+{
+  namespace
+  {
+    /// SplitMix64 finalizer (decorrelates the second hash from the first)
+    UInt64 mix(UInt64 x)
+    {
+      x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+      return x ^ (x >> 31);
+    }
+  }
+
+  BloomFilter::BloomFilter(Size expected_keys, double false_positive_rate)
+  {
+    if (!(false_positive_rate > 0.0 && false_positive_rate < 1.0))
+    {
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "The false positive rate must be in (0, 1).", String(false_positive_rate));
+    }
+    // optimal size and number of hashes: m = -n ln(p) / ln(2)^2, k = m / n ln(2)
+    const double ln2 = std::log(2.0);
+    const double n = double(std::max(expected_keys, Size(1)));
+    const double bits = std::ceil(-n * std::log(false_positive_rate) / (ln2 * ln2));
+    bit_count_ = std::max(Size(64), Size(bits));
+    hash_count_ = Size(std::clamp(std::round(double(bit_count_) / n * ln2), 1.0, 30.0));
+    word_count_ = (bit_count_ + 63) / 64;
+    words_.reset(new std::atomic<UInt64>[word_count_]);
+    clear();
+  }
+
+  std::pair<UInt64, UInt64> BloomFilter::hash_(std::string_view key)
+  {
+    const UInt64 h1 = std::hash<std::string_view>()(key);
+    return {h1, mix(h1)};
+  }
+
+  void BloomFilter::insert(std::string_view key)
+  {
+    const auto h = hash_(key);
+    UInt64 bit = h.first % bit_count_;
+    const UInt64 step = std::max(h.second % bit_count_, UInt64(1));
+    for (Size i = 0; i < hash_count_; ++i)
+    {
+      words_[bit / 64].fetch_or(UInt64(1) << (bit % 64), std::memory_order_relaxed);
+      bit += step;
+      if (bit >= bit_count_) bit -= bit_count_;
+    }
+  }
+
+  bool BloomFilter::mayContain(std::string_view key) const
+  {
+    const auto h = hash_(key);
+    UInt64 bit = h.first % bit_count_;
+    const UInt64 step = std::max(h.second % bit_count_, UInt64(1));
+    for (Size i = 0; i < hash_count_; ++i)
+    {
+      if ((words_[bit / 64].load(std::memory_order_relaxed) & (UInt64(1) << (bit % 64))) == 0)
+      {
+        return false;
+      }
+      bit += step;
+      if (bit >= bit_count_) bit -= bit_count_;
+    }
+    return true;
+  }
+
+  void BloomFilter::clear()
+  {
+    for (Size w = 0; w < word_count_; ++w)
+    {
+      words_[w].store(0, std::memory_order_relaxed);
+    }
+  }
+}
@@ -58,7 +58,7 @@ namespace OpenMS
 
   void DefaultParamHandler::setParameters(const Param& param)
   {
-    //set defaults and apply new parameters
+    //set defaults and apply new parameters (the copies share the data with param until they are modified)
     Param tmp(param);
     tmp.setDefaults(defaults_);
     param_ = tmp;
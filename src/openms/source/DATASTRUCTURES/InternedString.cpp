@@ -0,0 +1,78 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/DATASTRUCTURES/InternedString.h>
+
+#include <ostream>
+#include <unordered_set>
+
+using namespace std;
+
+namespace OpenMS
+{
+  namespace
+  {
+    /// Hash of the characters (without converting to std::string first)
+    struct PoolHash
+    {
+      size_t operator()(const String& s) const noexcept
+      {
+        return hash<string>()(static_cast<const string&>(s));
+      }
+    };
+
+    /// The global pool; elements of an unordered_set keep their address when the set grows
+    unordered_set<String, PoolHash>& pool()
+    {
+      static unordered_set<String, PoolHash> pool_;
+      return pool_;
+    }
+  }
+
+  InternedString::InternedString(const String& s) :
+    value_(intern_(s))
+  {
+  }
+
+  InternedString::InternedString(const char* s) :
+    value_(intern_(String(s)))
+  {
+  }
+
+  InternedString& InternedString::operator=(const String& s)
+  {
+    value_ = intern_(s);
+    return *this;
+  }
+
+  Size InternedString::poolSize()
+  {
+    Size size;
+#pragma omp critical (InternedString)
+    size = pool().size();
+    return size;
+  }
+
+  const String* InternedString::intern_(const String& s)
+  {
+    if (s.empty())
+    {
+      return &String::EMPTY;
+    }
+    const String* value;
+#pragma omp critical (InternedString)
+    value = &(*pool().insert(s).first);
+    return value;
+  }
+
+  ostream& operator<<(ostream& os, const InternedString& s)
+  {
+    return os << s.str();
+  }
+
+} // namespace OpenMS
@@ -9,10 +9,23 @@
 #include <OpenMS/DATASTRUCTURES/Param.h>
 
 #include <OpenMS/CONCEPT/LogStream.h>
+
 #include <algorithm>
+#include <atomic>
+#include <limits>
+#include <unordered_map>
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// Does @p root contain the node with name @p name?
+    bool hasSubnode_(const Param::ParamNode& root, const std::string& name)
+    {
+      const Param::ParamNode* parent = root.findParentOf(name);
+      return parent != nullptr && parent->findNode(parent->suffix(name)) != parent->nodes.end();
+    }
+  }
 
   //********************************* ParamEntry **************************************
   Param::ParamEntry::ParamEntry() :
@@ -220,7 +233,12 @@ namespace OpenMS
 
   Param::ParamNode::EntryIterator Param::ParamNode::findEntry(const std::string& local_name)
   {
-    for (EntryIterator it = entries.begin(); it != entries.end(); ++it)
+    return entries.begin() + (static_cast<const ParamNode*>(this)->findEntry(local_name) - entries.cbegin());
+  }
+
+  Param::ParamNode::ConstEntryIterator Param::ParamNode::findEntry(const std::string& local_name) const
+  {
+    for (ConstEntryIterator it = entries.begin(); it != entries.end(); ++it)
     {
       if (it->name == local_name)
       {
@@ -232,7 +250,12 @@ namespace OpenMS
 
   Param::ParamNode::NodeIterator Param::ParamNode::findNode(const std::string& local_name)
   {
-    for (NodeIterator it = nodes.begin(); it != nodes.end(); ++it)
+    return nodes.begin() + (static_cast<const ParamNode*>(this)->findNode(local_name) - nodes.cbegin());
+  }
+
+  Param::ParamNode::ConstNodeIterator Param::ParamNode::findNode(const std::string& local_name) const
+  {
+    for (ConstNodeIterator it = nodes.begin(); it != nodes.end(); ++it)
     {
       if (it->name == local_name)
       {
@@ -244,59 +267,77 @@ namespace OpenMS
 
   Param::ParamNode* Param::ParamNode::findParentOf(const std::string& local_name)
   {
-    //cout << "findParentOf nodename: " << this->name << " - nodes: " << this->nodes.size() << " - find: "<< name << std::endl;
-    if (local_name.find(':') != std::string::npos) //several subnodes to browse through
-    {
-        size_t pos = local_name.find(':');
-        std::string prefix = local_name.substr(0, pos);
+    return const_cast<ParamNode*>(static_cast<const ParamNode*>(this)->findParentOf(local_name));
+  }
 
-        //cout << " - Prefix: '" << prefix << "'" << std::endl;
-        NodeIterator it = findNode(prefix);
-        if (it == nodes.end()) //subnode not found
-        {
-          return nullptr;
-        }
-        //recursively call findNode for the rest of the path
-        std::string new_name = local_name.substr(it->name.size() + 1);
-        //cout << " - Next name: '" << new_name << "'" << std::endl;
-        return it->findParentOf(new_name);
-    }
-    else // we are in the right child
+  const Param::ParamNode* Param::ParamNode::findParentOf(const std::string& local_name) const
+  {
+    // browse through the subnodes named by the sections of the path (without copying them)
+    const ParamNode* node = this;
+    size_t begin = 0;
+    for (size_t pos = local_name.find(':'); pos != std::string::npos; pos = local_name.find(':', begin))
     {
-        //check if a node or entry prefix match
-        for (size_t i = 0; i < nodes.size(); ++i)
-        {
-            if (nodes[i].name.compare(0, local_name.size(), local_name) == 0)
-            {
-              return this;
-            }
-        }
-        for (size_t i = 0; i < entries.size(); ++i)
+      const size_t length = pos - begin;
+      const ParamNode* child = nullptr;
+      for (const ParamNode& n : node->nodes)
+      {
+        if (n.name.size() == length && local_name.compare(begin, length, n.name) == 0)
         {
-            if (entries[i].name.compare(0, local_name.size(), local_name) == 0)
-            {
-            return this;
-            }
+          child = &n;
+          break;
         }
+      }
+      if (child == nullptr) //subnode not found
+      {
         return nullptr;
+      }
+      node = child;
+      begin = pos + 1;
     }
+
+    // we are in the right child: check if a node or entry prefix matches
+    const size_t length = local_name.size() - begin;
+    for (const ParamNode& n : node->nodes)
+    {
+      if (n.name.compare(0, length, local_name, begin, length) == 0)
+      {
+        return node;
+      }
+    }
+    for (const ParamEntry& e : node->entries)
+    {
+      if (e.name.compare(0, length, local_name, begin, length) == 0)
+      {
+        return node;
+      }
+    }
+    return nullptr;
   }
 
   Param::ParamEntry* Param::ParamNode::findEntryRecursive(const std::string& local_name)
   {
-    ParamNode* parent = findParentOf(local_name);
+    return const_cast<ParamEntry*>(static_cast<const ParamNode*>(this)->findEntryRecursive(local_name));
+  }
+
+  const Param::ParamEntry* Param::ParamNode::findEntryRecursive(const std::string& local_name) const
+  {
+    const ParamNode* parent = findParentOf(local_name);
     if (parent == nullptr)
     {
       return nullptr;
     }
 
-    EntryIterator it = parent->findEntry(suffix(local_name));
-    if (it == parent->entries.end())
+    const size_t pos = local_name.rfind(':');
+    const size_t begin = (pos == std::string::npos) ? 0 : pos + 1;
+    const size_t length = local_name.size() - begin;
+    for (const ParamEntry& e : parent->entries)
     {
-      return nullptr;
+      if (e.name.size() == length && local_name.compare(begin, length, e.name) == 0)
+      {
+        return &e;
+      }
     }
-
-    return &(*it);
+    return nullptr;
   }
 
   void Param::ParamNode::insert(const ParamNode& node, const std::string& prefix)
@@ -421,33 +462,172 @@ namespace OpenMS
 
   //********************************* Param **************************************
 
+  /// Root node of a Param and a hash table of its entries by their full name
+  struct Param::Tree
+  {
+    typedef std::unordered_map<std::string, const ParamEntry*> Index;
+
+    Tree() :
+      root("ROOT", "")
+    {
+    }
+
+    explicit Tree(const ParamNode& node) :
+      root(node)
+    {
+      root.name = "ROOT";
+      root.description = "";
+    }
+
+    /// Copies the tree only (the lookup table of the copy is built when needed)
+    Tree(const Tree& rhs) :
+      root(rhs.root)
+    {
+    }
+
+    ~Tree()
+    {
+      delete index.load();
+    }
+
+    /// Discards the lookup table (called before modifications of the tree)
+    void invalidate()
+    {
+      delete index.exchange(nullptr);
+      lookups.store(0, std::memory_order_relaxed);
+      min_lookups.store(std::numeric_limits<size_t>::max(), std::memory_order_relaxed);
+    }
+
+    /**
+      @brief Looks up the entry with full name @p key (nullptr if it does not exist)
+
+      Thread safe for concurrent readers. The tree is searched until it was queried more often than it has
+      entries since its last modification, afterwards the lookup table is built (once) and used. This bounds
+      the cost of building the table by that of the searches, also if lookups and modifications alternate.
+    */
+    const ParamEntry* find(const std::string& key) const
+    {
+      const Index* table = index.load(std::memory_order_acquire);
+      if (table == nullptr)
+      {
+        const size_t count = lookups.fetch_add(1, std::memory_order_relaxed);
+        if (count == 16)
+        {
+          min_lookups.store(std::max(size_t(16), root.size()), std::memory_order_relaxed);
+        }
+        if (count < 16 || count < min_lookups.load(std::memory_order_relaxed))
+        {
+          return root.findEntryRecursive(key);
+        }
+        table = buildIndex_();
+      }
+      Index::const_iterator it = table->find(key);
+      return it == table->end() ? nullptr : it->second;
+    }
+
+    ParamNode root;
+
+  private:
+    /// Adds the entries of @p node and its subnodes (with names prefixed by @p path) to @p table
+    static void addToIndex_(const ParamNode& node, std::string& path, Index& table)
+    {
+      for (const ParamEntry& entry : node.entries)
+      {
+        table.emplace(path + entry.name, &entry);
+      }
+      for (const ParamNode& child : node.nodes)
+      {
+        const size_t length = path.size();
+        path += child.name;
+        path += ':';
+        addToIndex_(child, path, table);
+        path.resize(length);
+      }
+    }
+
+    /// Builds the lookup table (if no other thread did so in the meantime)
+    const Index* buildIndex_() const
+    {
+      Index* table = new Index();
+      table->reserve(root.size());
+      std::string path;
+      addToIndex_(root, path, *table);
+      const Index* expected = nullptr;
+      if (!index.compare_exchange_strong(expected, table, std::memory_order_acq_rel, std::memory_order_acquire))
+      {
+        delete table;
+        return expected;
+      }
+      return table;
+    }
+
+    /// Lookup table by full name; built on demand, owned by the tree
+    mutable std::atomic<const Index*> index{nullptr};
+    /// Number of searches since the last modification
+    mutable std::atomic<size_t> lookups{0};
+    /// Number of searches after which the lookup table is built (the number of entries, once known)
+    mutable std::atomic<size_t> min_lookups{std::numeric_limits<size_t>::max()};
+  };
+
   Param::Param() :
-    root_("ROOT", "")
+    tree_(std::make_shared<Tree>())
   {
   }
 
   Param::~Param() = default;
 
   Param::Param(const ParamNode& node) :
-    root_(node)
+    tree_(std::make_shared<Tree>(node))
   {
-    root_.name = "ROOT";
-    root_.description = "";
+  }
+
+  const Param::ParamNode& Param::getRoot_() const
+  {
+    if (tree_ == nullptr) // moved from
+    {
+      static const ParamNode empty("ROOT", "");
+      return empty;
+    }
+    return tree_->root;
+  }
+
+  Param::ParamNode& Param::getMutableRoot_()
+  {
+    if (tree_ == nullptr) // moved from
+    {
+      tree_ = std::make_shared<Tree>();
+    }
+    else if (tree_.use_count() > 1) // shared with other Params: copy on write
+    {
+      tree_ = std::make_shared<Tree>(*tree_);
+    }
+    else
+    {
+      // synchronize with the release of the tree by other Params (in other threads)
+      std::atomic_thread_fence(std::memory_order_acquire);
+      tree_->invalidate();
+    }
+    return tree_->root;
+  }
+
+  const Param::ParamEntry* Param::findEntry_(const std::string& key) const
+  {
+    return (tree_ == nullptr) ? nullptr : tree_->find(key);
   }
 
   bool Param::operator==(const Param& rhs) const
   {
-    return root_ == rhs.root_;
+    return tree_ == rhs.tree_ || getRoot_() == rhs.getRoot_();
   }
 
   void Param::setValue(const std::string& key, const ParamValue& value, const std::string& description, const std::vector<std::string>& tags)
   {
-    root_.insert(ParamEntry("", value, description, tags), key);
+    getMutableRoot_().insert(ParamEntry("", value, description, tags), key);
   }
 
   void Param::setValidStrings(const std::string& key, const std::vector<std::string>& strings)
   {
-    ParamEntry& entry = getEntry_(key);
+    ParamEntry& entry = getMutableEntry_(key);
     //check if correct parameter type
     if (entry.value.valueType() != ParamValue::STRING_VALUE && entry.value.valueType() != ParamValue::STRING_LIST)
     {
@@ -466,7 +646,7 @@ namespace OpenMS
 
   const std::vector<std::string>& Param::getValidStrings(const std::string& key) const
   {
-    ParamEntry& entry = getEntry_(key);
+    const ParamEntry& entry = getEntry_(key);
     // check if correct parameter type
     if (entry.value.valueType() != ParamValue::STRING_VALUE && entry.value.valueType() != ParamValue::STRING_LIST)
     {
@@ -477,7 +657,7 @@ namespace OpenMS
 
   void Param::setMinInt(const std::string& key, int min)
   {
-    ParamEntry& entry = getEntry_(key);
+    ParamEntry& entry = getMutableEntry_(key);
     if (entry.value.valueType() != ParamValue::INT_VALUE && entry.value.valueType() != ParamValue::INT_LIST)
     {
       throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, key);
@@ -487,7 +667,7 @@ namespace OpenMS
 
   void Param::setMaxInt(const std::string& key, int max)
   {
-    ParamEntry& entry = getEntry_(key);
+    ParamEntry& entry = getMutableEntry_(key);
     if (entry.value.valueType() != ParamValue::INT_VALUE && entry.value.valueType() != ParamValue::INT_LIST)
     {
       throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, key);
@@ -497,7 +677,7 @@ namespace OpenMS
 
   void Param::setMinFloat(const std::string& key, double min)
   {
-    ParamEntry& entry = getEntry_(key);
+    ParamEntry& entry = getMutableEntry_(key);
     if (entry.value.valueType() != ParamValue::DOUBLE_VALUE && entry.value.valueType() != ParamValue::DOUBLE_LIST)
     {
       throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, key);
@@ -507,7 +687,7 @@ namespace OpenMS
 
   void Param::setMaxFloat(const std::string& key, double max)
   {
-    ParamEntry& entry = getEntry_(key);
+    ParamEntry& entry = getMutableEntry_(key);
     if (entry.value.valueType() != ParamValue::DOUBLE_VALUE && entry.value.valueType() != ParamValue::DOUBLE_LIST)
     {
       throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, key);
@@ -526,13 +706,13 @@ namespace OpenMS
     //static initialization and thus cannot rely on String::EMPTY been initialized.
     static std::string empty;
 
-    ParamNode* node = root_.findParentOf(key);
+    const ParamNode* node = getRoot_().findParentOf(key);
     if (node == nullptr)
     {
       return empty;
     }
 
-    Param::ParamNode::NodeIterator it = node->findNode(node->suffix(key));
+    Param::ParamNode::ConstNodeIterator it = node->findNode(node->suffix(key));
     if (it == node->nodes.end())
     {
       return empty;
@@ -544,13 +724,17 @@ namespace OpenMS
   void Param::insert(const std::string& prefix, const Param& param)
   {
     //std::cerr << "INSERT PARAM (" << prefix << ")" << std::endl;
-    for (Param::ParamNode::NodeIterator it = param.root_.nodes.begin(); it != param.root_.nodes.end(); ++it)
+    // keep a reference to the data of param, which might be this Param
+    std::shared_ptr<Tree> data = param.tree_;
+    const ParamNode& root = param.getRoot_();
+    ParamNode& target = getMutableRoot_();
+    for (Param::ParamNode::ConstNodeIterator it = root.nodes.begin(); it != root.nodes.end(); ++it)
     {
-      root_.insert(*it, prefix);
+      target.insert(*it, prefix);
     }
-    for (Param::ParamNode::EntryIterator it = param.root_.entries.begin(); it != param.root_.entries.end(); ++it)
+    for (Param::ParamNode::ConstEntryIterator it = root.entries.begin(); it != root.entries.end(); ++it)
     {
-      root_.insert(*it, prefix);
+      target.insert(*it, prefix);
     }
   }
 
@@ -573,7 +757,7 @@ namespace OpenMS
         if (showMessage)
           std::cerr << "Setting " << prefix2 + it.getName() << " to " << it->value << std::endl;
         std::string name = prefix2 + it.getName();
-        root_.insert(ParamEntry("", it->value, it->description), name);
+        getMutableRoot_().insert(ParamEntry("", it->value, it->description), name);
         //copy tags
         for (std::set<std::string>::const_iterator tag_it = it->tags.begin(); tag_it != it->tags.end(); ++tag_it)
         {
@@ -613,7 +797,8 @@ namespace OpenMS
         {
           std::string description_old = getSectionDescription(prefix + real_pathname);
           const std::string& description_new = defaults.getSectionDescription(real_pathname);
-          if (description_old.empty())
+          // (replacing an empty description by an empty one would only unshare the data)
+          if (description_old.empty() && !description_new.empty())
           {
             //std::cerr << "## Setting description of " << prefix+real_pathname << " to"<< std::endl;
             //std::cerr << "## " << description_new << std::endl;
@@ -630,8 +815,12 @@ namespace OpenMS
     if (!key.empty() && key.back() == ':') // delete section
     {
       keyname = key.substr(0, key.length() - 1);
+      if (!hasSubnode_(getRoot_(), keyname))
+      {
+        return; // nothing to remove (keep sharing the data)
+      }
 
-      ParamNode* node_parent = root_.findParentOf(keyname);
+      ParamNode* node_parent = getMutableRoot_().findParentOf(keyname);
       if (node_parent != nullptr)
       {
         Param::ParamNode::NodeIterator it = node_parent->findNode(node_parent->suffix(keyname));
@@ -649,7 +838,12 @@ namespace OpenMS
     }
     else
     {
-      ParamNode* node = root_.findParentOf(keyname);
+      if (getRoot_().findEntryRecursive(keyname) == nullptr)
+      {
+        return; // nothing to remove (keep sharing the data)
+      }
+
+      ParamNode* node = getMutableRoot_().findParentOf(keyname);
       if (node != nullptr)
       {
         std::string entryname = node->suffix(keyname); // get everything beyond last ':'
@@ -671,7 +865,12 @@ namespace OpenMS
   {
     if (!prefix.empty() && prefix.back() == ':')//we have to delete one node only (and its subnodes)
     {
-      ParamNode* node = root_.findParentOf(prefix.substr(0, prefix.length() - 1));
+      if (!hasSubnode_(getRoot_(), prefix.substr(0, prefix.length() - 1)))
+      {
+        return; // nothing to remove (keep sharing the data)
+      }
+
+      ParamNode* node = getMutableRoot_().findParentOf(prefix.substr(0, prefix.length() - 1));
       if (node != nullptr)
       {
         Param::ParamNode::NodeIterator it = node->findNode(node->suffix(prefix.substr(0, prefix.length() - 1)));
@@ -689,7 +888,12 @@ namespace OpenMS
     }
     else //we have to delete all entries and nodes starting with the prefix
     {
-      ParamNode* node = root_.findParentOf(prefix);
+      if (getRoot_().findParentOf(prefix) == nullptr)
+      {
+        return; // nothing to remove (keep sharing the data)
+      }
+
+      ParamNode* node = getMutableRoot_().findParentOf(prefix);
       if (node != nullptr)
       {
         std::string suffix = node->suffix(prefix); // name behind last ":"
@@ -730,10 +934,11 @@ namespace OpenMS
   {
     ParamNode out("ROOT", "");
 
-    for (const auto& entry : subset.root_.entries)
+    const ParamNode& root = getRoot_();
+    for (const auto& entry : subset.getRoot_().entries)
     {
-      const auto& n = root_.findEntry(entry.name);
-      if (n == root_.entries.end())
+      const auto& n = root.findEntry(entry.name);
+      if (n == root.entries.end())
       {
         OPENMS_LOG_WARN << "Warning: Trying to copy non-existent parameter entry " << entry.name << std::endl;
       }
@@ -743,10 +948,10 @@ namespace OpenMS
       }
     }
 
-    for (const auto& node : subset.root_.nodes)
+    for (const auto& node : subset.getRoot_().nodes)
     {
-      const auto& n = root_.findNode(node.name);
-      if (n == root_.nodes.end())
+      const auto& n = root.findNode(node.name);
+      if (n == root.nodes.end())
       {
         OPENMS_LOG_WARN << "Warning: Trying to copy non-existent parameter node " << node.name << std::endl;
       }
@@ -762,7 +967,7 @@ namespace OpenMS
   {
     ParamNode out("ROOT", "");
 
-    ParamNode* node = root_.findParentOf(prefix);
+    const ParamNode* node = getRoot_().findParentOf(prefix);
     if (node == nullptr)
     {
       return Param();
@@ -782,7 +987,7 @@ namespace OpenMS
     else //we have to copy all entries and nodes starting with the right suffix
     {
       std::string suffix = node->suffix(prefix);
-      for (Param::ParamNode::NodeIterator it = node->nodes.begin(); it != node->nodes.end(); ++it)
+      for (Param::ParamNode::ConstNodeIterator it = node->nodes.begin(); it != node->nodes.end(); ++it)
       {
         if (it->name.compare(0, suffix.size(), suffix) == 0)
         {
@@ -798,7 +1003,7 @@ namespace OpenMS
           }
         }
       }
-      for (Param::ParamNode::EntryIterator it = node->entries.begin(); it != node->entries.end(); ++it)
+      for (Param::ParamNode::ConstEntryIterator it = node->entries.begin(); it != node->entries.end(); ++it)
       {
         if (it->name.compare(0, suffix.size(), suffix) == 0)
         {
@@ -860,25 +1065,25 @@ namespace OpenMS
       //flag (option without text argument)
       if (arg_is_option && arg1_is_option)
       {
-        root_.insert(ParamEntry(arg, std::string(), ""), prefix2);
+        getMutableRoot_().insert(ParamEntry(arg, std::string(), ""), prefix2);
       }
       //option with argument
       else if (arg_is_option && !arg1_is_option)
       {
-        root_.insert(ParamEntry(arg, arg1, ""), prefix2);
+        getMutableRoot_().insert(ParamEntry(arg, arg1, ""), prefix2);
         ++i;
       }
       //just text arguments (not preceded by an option)
       else
       {
 
-        ParamEntry* misc_entry = root_.findEntryRecursive(prefix2 + "misc");
+        ParamEntry* misc_entry = getMutableRoot_().findEntryRecursive(prefix2 + "misc");
         if (misc_entry == nullptr)
         {
           std::vector<std::string> sl;
           sl.push_back(arg);
           // create "misc"-Node:
-          root_.insert(ParamEntry("misc", sl, ""), prefix2);
+          getMutableRoot_().insert(ParamEntry("misc", sl, ""), prefix2);
         }
         else
         {
@@ -926,7 +1131,7 @@ namespace OpenMS
         //next argument is an option
         if (arg1_is_option)
         {
-          root_.insert(ParamEntry("", std::vector<std::string>(), ""), options_with_multiple_argument.find(arg)->second);
+          getMutableRoot_().insert(ParamEntry("", std::vector<std::string>(), ""), options_with_multiple_argument.find(arg)->second);
         }
         //next argument is not an option
         else
@@ -943,14 +1148,14 @@ namespace OpenMS
             }
           }
 
-          root_.insert(ParamEntry("", sl, ""), options_with_multiple_argument.find(arg)->second);
+          getMutableRoot_().insert(ParamEntry("", sl, ""), options_with_multiple_argument.find(arg)->second);
           i = j - 1;
         }
       }
       //without argument
       else if (options_without_argument.find(arg) != options_without_argument.end())
       {
-        root_.insert(ParamEntry("", "true", ""), options_without_argument.find(arg)->second);
+        getMutableRoot_().insert(ParamEntry("", "true", ""), options_without_argument.find(arg)->second);
       }
       //with one argument
       else if (options_with_one_argument.find(arg) != options_with_one_argument.end())
@@ -958,25 +1163,25 @@ namespace OpenMS
         //next argument is not an option
         if (!arg1_is_option)
         {
-          root_.insert(ParamEntry("", arg1, ""), options_with_one_argument.find(arg)->second);
+          getMutableRoot_().insert(ParamEntry("", arg1, ""), options_with_one_argument.find(arg)->second);
           ++i;
         }
         //next argument is an option
         else
         {
 
-          root_.insert(ParamEntry("", std::string(), ""), options_with_one_argument.find(arg)->second);
+          getMutableRoot_().insert(ParamEntry("", std::string(), ""), options_with_one_argument.find(arg)->second);
         }
       }
       //unknown option
       else if (arg_is_option)
       {
-        ParamEntry* unknown_entry = root_.findEntryRecursive(unknown);
+        ParamEntry* unknown_entry = getMutableRoot_().findEntryRecursive(unknown);
         if (unknown_entry == nullptr)
         {
           std::vector<std::string> sl;
           sl.push_back(arg);
-          root_.insert(ParamEntry("", sl, ""), unknown);
+          getMutableRoot_().insert(ParamEntry("", sl, ""), unknown);
         }
         else
         {
@@ -988,13 +1193,13 @@ namespace OpenMS
       //just text argument
       else
       {
-        ParamEntry* misc_entry = root_.findEntryRecursive(misc);
+        ParamEntry* misc_entry = getMutableRoot_().findEntryRecursive(misc);
         if (misc_entry == nullptr)
         {
           std::vector<std::string> sl;
           sl.push_back(arg);
           // create "misc"-Node:
-          root_.insert(ParamEntry("", sl, ""), misc);
+          getMutableRoot_().insert(ParamEntry("", sl, ""), misc);
         }
         else
         {
@@ -1027,7 +1232,7 @@ namespace OpenMS
 
   size_t Param::size() const
   {
-    return root_.size();
+    return getRoot_().size();
   }
 
   bool Param::empty() const
@@ -1037,7 +1242,7 @@ namespace OpenMS
 
   void Param::clear()
   {
-    root_ = ParamNode("ROOT", "");
+    tree_ = std::make_shared<Tree>();
   }
 
   void Param::checkDefaults(const std::string& name, const Param& defaults, const std::string& prefix) const
@@ -1068,7 +1273,7 @@ namespace OpenMS
       }
 
       //different types
-      ParamEntry* default_value = defaults.root_.findEntryRecursive(prefix2 + it.getName());
+      const ParamEntry* default_value = defaults.findEntry_(prefix2 + it.getName());
       if (default_value == nullptr)
       {
         continue;
@@ -1275,7 +1480,7 @@ OPENMS_THREAD_CRITICAL(LOGSTREAM)
             {
               prefix = it.getName().substr(0, 1 + it.getName().find_last_of(':'));
             }
-            this->root_.insert(local_entry, prefix); //->setValue(it.getName(), local_entry.value, local_entry.description, local_entry.tags);
+            getMutableRoot_().insert(local_entry, prefix); //->setValue(it.getName(), local_entry.value, local_entry.description, local_entry.tags);
           }
           else if (verbose)
           {
@@ -1367,7 +1572,7 @@ OPENMS_THREAD_CRITICAL(LOGSTREAM)
       {
         Param::ParamEntry entry = *it;
         OPENMS_LOG_DEBUG << "[Param::merge] merging " << it.getName() << std::endl;
-        this->root_.insert(entry, prefix);
+        getMutableRoot_().insert(entry, prefix);
       }
 
       //copy section descriptions
@@ -1403,7 +1608,7 @@ OPENMS_THREAD_CRITICAL(LOGSTREAM)
 
   void Param::setSectionDescription(const std::string& key, const std::string& description)
   {
-    ParamNode* node = root_.findParentOf(key);
+    ParamNode* node = getMutableRoot_().findParentOf(key);
     if (node == nullptr)
     {
       throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, key);
@@ -1419,12 +1624,12 @@ OPENMS_THREAD_CRITICAL(LOGSTREAM)
 
   void Param::addSection(const std::string& key, const std::string& description)
   {
-    root_.insert(ParamNode("",description),key);
+    getMutableRoot_().insert(ParamNode("",description),key);
   }
 
   Param::ParamIterator Param::begin() const
   {
-    return ParamIterator(root_);
+    return ParamIterator(getRoot_());
   }
 
   Param::ParamIterator Param::end() const
@@ -1601,12 +1806,12 @@ OPENMS_THREAD_CRITICAL(LOGSTREAM)
     {
       throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Param tags may not contain comma characters", tag);
     }
-    getEntry_(key).tags.insert(tag);
+    getMutableEntry_(key).tags.insert(tag);
   }
 
   void Param::addTags(const std::string& key, const std::vector<std::string>& tags)
   {
-    ParamEntry& entry = getEntry_(key);
+    ParamEntry& entry = getMutableEntry_(key);
     for (size_t i = 0; i != tags.size(); ++i)
     {
       if (tags[i].find(',') != std::string::npos)
@@ -1619,7 +1824,7 @@ OPENMS_THREAD_CRITICAL(LOGSTREAM)
 
   std::vector<std::string> Param::getTags(const std::string& key) const
   {
-    ParamEntry& entry = getEntry_(key);
+    const ParamEntry& entry = getEntry_(key);
     std::vector<std::string> list;
     for (std::set<std::string>::const_iterator it = entry.tags.begin(); it != entry.tags.end(); ++it)
     {
@@ -1630,7 +1835,7 @@ OPENMS_THREAD_CRITICAL(LOGSTREAM)
 
   void Param::clearTags(const std::string& key)
   {
-    getEntry_(key).tags.clear();
+    getMutableEntry_(key).tags.clear();
   }
 
   bool Param::hasTag(const std::string& key, const std::string& tag) const
@@ -1640,7 +1845,7 @@ OPENMS_THREAD_CRITICAL(LOGSTREAM)
 
   bool Param::exists(const std::string& key) const
   {
-    return root_.findEntryRecursive(key);
+    return findEntry_(key) != nullptr;
   }
 
   bool Param::hasSection(const std::string &key) const
@@ -1648,17 +1853,17 @@ OPENMS_THREAD_CRITICAL(LOGSTREAM)
     if (key.back() == ':')
     {
       // Remove trailing colon from key
-      return root_.findParentOf(key.substr(0, key.size() - 1)) != nullptr;
+      return getRoot_().findParentOf(key.substr(0, key.size() - 1)) != nullptr;
     }
     else
     {
-      return root_.findParentOf(key) != nullptr;
+      return getRoot_().findParentOf(key) != nullptr;
     }
   }
 
-  Param::ParamEntry& Param::getEntry_(const std::string& key) const
+  const Param::ParamEntry& Param::getEntry_(const std::string& key) const
   {
-    ParamEntry* entry = root_.findEntryRecursive(key);
+    const ParamEntry* entry = findEntry_(key);
     if (entry == nullptr)
     {
       throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, key);
@@ -1667,4 +1872,13 @@ OPENMS_THREAD_CRITICAL(LOGSTREAM)
     return *entry;
   }
 
+  Param::ParamEntry& Param::getMutableEntry_(const std::string& key)
+  {
+    if (findEntry_(key) == nullptr) // keep sharing the data
+    {
+      throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, key);
+    }
+    return *getMutableRoot_().findEntryRecursive(key);
+  }
+
 } //namespace
@@ -10,7 +10,7 @@
 #include <OpenMS/CONCEPT/Macros.h>
 #include <OpenMS/DATASTRUCTURES/GridFeature.h>
 #include <OpenMS/DATASTRUCTURES/QTCluster.h>
-#include <algorithm> // for set_intersection
+#include <algorithm> // for set_intersection, lower_bound, stable_sort
 #include <iterator>  // for inserter
 #include <numeric>   // for make_pair
 
@@ -90,11 +90,14 @@ namespace OpenMS
     return quality_ < rhs.quality_;
   }
 
-  void QTCluster::add(const OpenMS::GridFeature* const element, double distance)
+  QTCluster::NeighborMap::iterator QTCluster::findNeighbor_(Size map_index) const
   {
-    // get reference on member that is used in this function
-    NeighborMapMulti& tmp_neighbors_ = data_->tmp_neighbors_;
+    return std::lower_bound(data_->neighbors_.begin(), data_->neighbors_.end(), map_index,
+                            [](const std::pair<Size, Neighbor>& neighbor, Size index) { return neighbor.first < index; });
+  }
 
+  void QTCluster::add(const OpenMS::GridFeature* const element, double distance)
+  {
     OPENMS_PRECONDITION(!finalized_, "Cannot perform operation on cluster that is not initialized")
     // ensure we only add compatible peptide annotations
     OPENMS_PRECONDITION(distance <= data_->max_distance_, "Distance cannot be larger than max_distance")
@@ -126,7 +129,7 @@ namespace OpenMS
     // annotations
     if (collect_annotations_ && map_index != center_point.getMapIndex())
     {
-      tmp_neighbors_[map_index].insert(make_pair(distance, element));
+      data_->tmp_neighbors_.push_back({map_index, distance, element});
       changed_ = true;
     }
 
@@ -138,11 +141,16 @@ namespace OpenMS
     //  On the other hand this just fills data_->neighbors_ which says it only stores the BEST feature per map.
     if (map_index != center_point.getMapIndex())
     {
-      NeighborMap& neighbors_ = data_->neighbors_;
+      NeighborMap::iterator pos = findNeighbor_(map_index);
 
-      if (neighbors_.find(map_index) == neighbors_.end() || distance < neighbors_[map_index].distance)
+      if (pos == data_->neighbors_.end() || pos->first != map_index)
+      {
+        data_->neighbors_.insert(pos, make_pair(map_index, Neighbor {distance, element}));
+        changed_ = true;
+      }
+      else if (distance < pos->second.distance)
       {
-        neighbors_[map_index] = Neighbor {distance, element};
+        pos->second = Neighbor {distance, element};
         changed_ = true;
       }
     }
@@ -184,8 +192,8 @@ namespace OpenMS
     // update cluster contents, remove those elements we find in our cluster
     for (const auto& removed_element : removed)
     {
-      NeighborMap::iterator pos = neighbors_.find(removed_element.map_index);
-      if (pos == neighbors_.end())
+      NeighborMap::iterator pos = findNeighbor_(removed_element.map_index);
+      if (pos == neighbors_.end() || pos->first != removed_element.map_index)
       {
         continue; // no points from this map
       }
@@ -261,6 +269,7 @@ namespace OpenMS
 
     // copy the important info about the neighbors
     Elements elements;
+    elements.reserve(data_->neighbors_.size() + 1); // + 1 for the center (see getElements)
     for (const auto& neighbor : data_->neighbors_)
     {
       elements.push_back({neighbor.first, neighbor.second.feature});
@@ -285,6 +294,12 @@ namespace OpenMS
     OPENMS_PRECONDITION(!data_->tmp_neighbors_.empty(), "QTCluster::optimizeAnnotations_ needs to have working tmp_neighbors_")
     OPENMS_PRECONDITION(!finalized_, "QTCluster::optimizeAnnotations_ cannot work on finalized cluster")
 
+    // group the candidates by input map, closest first (stable: ties keep the order they were added in)
+    std::stable_sort(data_->tmp_neighbors_.begin(), data_->tmp_neighbors_.end(), [](const Candidate& a, const Candidate& b)
+    {
+      return (a.map_index < b.map_index) || (a.map_index == b.map_index && a.distance < b.distance);
+    });
+
     // mapping: peptides -> best distance per input map
     map<AASequence, map<Size, double>> seq_table;
 
@@ -358,23 +373,24 @@ namespace OpenMS
   {
     // get references on members that are used in this function
     NeighborMap& neighbors_ = data_->neighbors_;
-    NeighborMapMulti& tmp_neighbors_ = data_->tmp_neighbors_;
+    const CandidateList& tmp_neighbors_ = data_->tmp_neighbors_;
     std::set<AASequence>& annotations_ = data_->annotations_;
 
+    // candidates are sorted by map index, so the neighbors stay sorted as well
     neighbors_.clear();
-    for (NeighborMapMulti::const_iterator n_it = tmp_neighbors_.begin(); n_it != tmp_neighbors_.end(); ++n_it)
+    for (CandidateList::const_iterator df_it = tmp_neighbors_.begin(); df_it != tmp_neighbors_.end(); ++df_it)
     {
-      for (std::multimap<double, const GridFeature*>::const_iterator df_it = n_it->second.begin(); df_it != n_it->second.end(); ++df_it)
+      if (!neighbors_.empty() && neighbors_.back().first == df_it->map_index)
       {
-        std::set<AASequence> intersect;
-        const std::set<AASequence>& current = df_it->second->getAnnotations();
-        std::set_intersection(current.begin(), current.end(), annotations_.begin(), annotations_.end(), std::inserter(intersect, intersect.begin()));
-        // if no overlap with the re-calculated IDs in the center, do not re-add neighbor to the updated neighbors anymore.
-        if (!intersect.empty() || current.empty())
-        {
-          neighbors_[n_it->first] = Neighbor {df_it->first, df_it->second};
-          break; // found the best element for this input map
-        }
+        continue; // already found the best element for this input map
+      }
+      std::set<AASequence> intersect;
+      const std::set<AASequence>& current = df_it->feature->getAnnotations();
+      std::set_intersection(current.begin(), current.end(), annotations_.begin(), annotations_.end(), std::inserter(intersect, intersect.begin()));
+      // if no overlap with the re-calculated IDs in the center, do not re-add neighbor to the updated neighbors anymore.
+      if (!intersect.empty() || current.empty())
+      {
+        neighbors_.emplace_back(df_it->map_index, Neighbor {df_it->distance, df_it->feature});
       }
     }
   }
@@ -382,18 +398,18 @@ namespace OpenMS
   void QTCluster::makeSeqTable_(map<AASequence, map<Size, double>>& seq_table) const
   {
     // get reference on member that is used in this function
-    NeighborMapMulti& tmp_neighbors_ = data_->tmp_neighbors_;
+    const CandidateList& tmp_neighbors_ = data_->tmp_neighbors_;
 
-    // for all maps contributing to this cluster
-    for (NeighborMapMulti::iterator n_it = tmp_neighbors_.begin(); n_it != tmp_neighbors_.end(); ++n_it)
+    // for all neighbors relevant for this cluster (grouped by map, closest first)
+    CandidateList::const_iterator df_it = tmp_neighbors_.begin();
+    while (df_it != tmp_neighbors_.end())
     {
-      // for all neighbors relevant for this cluster in this map
-      Size map_index = n_it->first;
-      for (NeighborList::iterator df_it = n_it->second.begin(); df_it != n_it->second.end(); ++df_it)
+      Size map_index = df_it->map_index;
+      for (; df_it != tmp_neighbors_.end() && df_it->map_index == map_index; ++df_it)
       {
-        double dist = df_it->first;
+        double dist = df_it->distance;
         // for all IDs/annotations of the neighboring feature (skipped if empty)
-        for (const auto& current : df_it->second->getAnnotations())
+        for (const auto& current : df_it->feature->getAnnotations())
         {
           auto seqit_inserted = seq_table.emplace(current, map<Size, double> {{map_index, dist}});
           // check if a minimum distance was already set for this ID
@@ -412,7 +428,7 @@ namespace OpenMS
           }
         }
 
-        if (df_it->second->getAnnotations().empty()) // unannotated feature
+        if (df_it->feature->getAnnotations().empty()) // unannotated feature
         {
           auto seqit_inserted = seq_table.emplace(AASequence(), map<Size, double> {{map_index, dist}});
           // check if a minimum distance was already set for empty ID = unannotated
@@ -434,6 +450,7 @@ namespace OpenMS
           // than this unspecific one, since multimap is sorted & dists are already corrected
           // with noID_penalty. If you don't want this to happen, set the penalty to one and unIDed ones
           // will always be added at the end):
+          df_it = std::find_if(df_it, tmp_neighbors_.end(), [map_index](const Candidate& c) { return c.map_index != map_index; });
           break;
         }
       }
@@ -451,7 +468,8 @@ namespace OpenMS
 
     finalized_ = true;
 
-    data_->tmp_neighbors_.clear();
+    // release the memory, the candidates are collected anew for every initialization
+    CandidateList().swap(data_->tmp_neighbors_);
   }
 
   void QTCluster::initializeCluster()
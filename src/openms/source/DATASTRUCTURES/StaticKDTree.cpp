@@ -0,0 +1,162 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Johannes Veit $
+// $Authors: Johannes Veit $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/DATASTRUCTURES/StaticKDTree.h>
+
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+namespace OpenMS
+{
+
+void StaticKDTree::insert(double x, double y, Size index)
+{
+  points_.push_back({{x, y}, index});
+}
+
+void StaticKDTree::build()
+{
+  if (isBuilt())
+  {
+    return;
+  }
+
+  // partition level by level; the ranges of one level are independent of each other
+  vector<pair<Size, Size> > ranges;
+  if (points_.size() > leaf_size_)
+  {
+    ranges.emplace_back(0, points_.size());
+  }
+  UInt dim = 0;
+  while (!ranges.empty())
+  {
+    vector<pair<Size, Size> > children(2 * ranges.size());
+#pragma omp parallel for schedule(dynamic) if (ranges.size() > 1)
+    for (SignedSize r = 0; r < (SignedSize)ranges.size(); ++r)
+    {
+      const Size begin = ranges[r].first;
+      const Size end = ranges[r].second;
+      const Size median = begin + (end - begin) / 2;
+      nth_element(points_.begin() + begin, points_.begin() + median, points_.begin() + end,
+                  [dim](const Point& a, const Point& b) { return a.coords[dim] < b.coords[dim]; });
+      children[2 * r] = make_pair(begin, median);
+      children[2 * r + 1] = make_pair(median + 1, end);
+    }
+
+    // only ranges that are too large for a linear scan are partitioned further
+    ranges.clear();
+    for (const pair<Size, Size>& child : children)
+    {
+      if (child.second - child.first > leaf_size_)
+      {
+        ranges.push_back(child);
+      }
+    }
+    dim = 1 - dim;
+  }
+  built_ = points_.size();
+}
+
+void StaticKDTree::clear()
+{
+  points_.clear();
+  built_ = 0;
+}
+
+Size StaticKDTree::size() const
+{
+  return points_.size();
+}
+
+bool StaticKDTree::empty() const
+{
+  return points_.empty();
+}
+
+bool StaticKDTree::isBuilt() const
+{
+  return built_ == points_.size();
+}
+
+void StaticKDTree::queryRange(const Box& box, vector<Size>& result) const
+{
+  queryNode_(0, built_, 0, box, result);
+
+  // points inserted since the last build()
+  for (Size i = built_; i < points_.size(); ++i)
+  {
+    if (contains_(box, points_[i]))
+    {
+      result.push_back(points_[i].index);
+    }
+  }
+}
+
+void StaticKDTree::queryRanges(const vector<Box>& boxes, vector<vector<Size> >& results) const
+{
+  results.assign(boxes.size(), vector<Size>());
+#pragma omp parallel for schedule(dynamic, 64)
+  for (SignedSize i = 0; i < (SignedSize)boxes.size(); ++i)
+  {
+    queryRange(boxes[i], results[i]);
+  }
+}
+
+const vector<StaticKDTree::Point>& StaticKDTree::getPoints() const
+{
+  return points_;
+}
+
+void StaticKDTree::queryNode_(Size begin, Size end, UInt dim, const Box& box, vector<Size>& result) const
+{
+  // descend iteratively into one subtree, recursively into the other one if both overlap the box
+  while (end - begin > leaf_size_)
+  {
+    const Size median = begin + (end - begin) / 2;
+    const Point& node = points_[median];
+    if (contains_(box, node))
+    {
+      result.push_back(node.index);
+    }
+
+    // points left of the median are <= the split value, points right of it >= the split value
+    const double split = node.coords[dim];
+    const bool left = box.low[dim] <= split;
+    const bool right = box.high[dim] >= split;
+    if (left && right)
+    {
+      queryNode_(median + 1, end, 1 - dim, box, result);
+      end = median;
+    }
+    else if (left)
+    {
+      end = median;
+    }
+    else if (right)
+    {
+      begin = median + 1;
+    }
+    else // empty box
+    {
+      return;
+    }
+    dim = 1 - dim;
+  }
+
+  for (Size i = begin; i < end; ++i)
+  {
+    if (contains_(box, points_[i]))
+    {
+      result.push_back(points_[i].index);
+    }
+  }
+}
+
+}
@@ -5,6 +5,7 @@ set(directory source/DATASTRUCTURES)
 set(sources_list
 Adduct.cpp
 BinaryTreeNode.cpp
+BloomFilter.cpp
 CalibrationData.cpp
 ChargePair.cpp
 Compomer.cpp
@@ -27,6 +28,7 @@ ExposedVector.cpp
 FASTAContainer.cpp
 FlagSet.cpp
 GridFeature.cpp
+InternedString.cpp
 #IsotopeCluster.h
 #KDTree.h
 ListUtils.cpp
@@ -39,6 +41,7 @@ OSWData.cpp
 Param.cpp
 ParamValue.cpp
 QTCluster.cpp
+StaticKDTree.cpp
 String.cpp
 StringView.cpp
 StringListUtils.cpp
@@ -39,36 +39,34 @@ namespace OpenMS
     double sigma = x(2);
     double tau = x(3);
 
-    double t_diff, t_diff2, denominator = 0.0;
+    const double baseline = m_data->traces_ptr->baseline;
+    const double* rts = m_data->rts.data();
+    const double* intensities = m_data->intensities.data();
+    const double* theoretical_ints = m_data->theoretical_ints.data();
+    const double* weights = m_data->weights.data();
 
-    double fegh = 0.0;
+    exp_terms_.resize(m_data->rts.size());
+    setExpTermsParameters_(x);
 
-    UInt count = 0;
-    for (Size t = 0; t < m_data->traces_ptr->size(); ++t)
+    for (Size i = 0; i < m_data->rts.size(); ++i)
     {
-      const FeatureFinderAlgorithmPickedHelperStructs::MassTrace& trace = m_data->traces_ptr->at(t);
-      double weight = m_data->weighted ? trace.theoretical_int : 1.0;
-      for (Size i = 0; i < trace.peaks.size(); ++i)
-      {
-        double rt = trace.peaks[i].first;
-
-        t_diff = rt - tR;
-        t_diff2 = t_diff * t_diff; // -> (t - t_R)^2
+      double t_diff = rts[i] - tR;
+      double t_diff2 = t_diff * t_diff; // -> (t - t_R)^2
 
-        denominator = 2 * sigma * sigma + tau * t_diff; // -> 2\sigma_{g}^{2} + \tau \left(t - t_R\right)
+      double denominator = 2 * sigma * sigma + tau * t_diff; // -> 2\sigma_{g}^{2} + \tau \left(t - t_R\right)
 
-        if (denominator > 0.0)
-        {
-          fegh =  m_data->traces_ptr->baseline + trace.theoretical_int * H * exp(-t_diff2 / denominator);
-        }
-        else
-        {
-          fegh = 0.0;
-        }
-
-        fvec(count) = (fegh - trace.peaks[i].second->getIntensity()) * weight;
-        ++count;
+      double fegh = 0.0;
+      if (denominator > 0.0)
+      {
+        exp_terms_[i] = exp(-t_diff2 / denominator);
+        fegh = baseline + theoretical_ints[i] * H * exp_terms_[i];
       }
+      else
+      {
+        exp_terms_[i] = 0.0;
+      }
+
+      fvec(i) = (fegh - intensities[i]) * weights[i];
     }
     return 0;
   }
@@ -80,58 +78,53 @@ namespace OpenMS
     double sigma = fabs(x(2)); // must be non-negative!
     double tau = x(3);
 
+    // exponentials from the last residual evaluation can be reused if it was at the same parameters
+    // (sigma only enters the exponent squared, so its sign is irrelevant there)
+    const bool reuse_exp = hasExpTerms_(x);
+
+    const double* rts = m_data->rts.data();
+    const double* theoretical_ints = m_data->theoretical_ints.data();
+    const double* weights = m_data->weights.data();
+
     double derivative_H, derivative_tR, derivative_sigma, derivative_tau = 0.0;
-    double t_diff, t_diff2, exp1, denominator = 0.0;
 
-    UInt count = 0;
-    for (Size t = 0; t < m_data->traces_ptr->size(); ++t)
+    for (Size i = 0; i < m_data->rts.size(); ++i)
     {
-      const FeatureFinderAlgorithmPickedHelperStructs::MassTrace& trace = m_data->traces_ptr->at(t);
-      double weight = m_data->weighted ? trace.theoretical_int : 1.0;
-      for (Size i = 0; i < trace.peaks.size(); ++i)
+      double t_diff = rts[i] - tR;
+      double t_diff2 = t_diff * t_diff; // -> (t - t_R)^2
+
+      double denominator = 2 * sigma * sigma + tau * t_diff; // -> 2\sigma_{g}^{2} + \tau \left(t - t_R\right)
+
+      if (denominator > 0)
       {
-        double rt = trace.peaks[i].first;
-
-        t_diff = rt - tR;
-        t_diff2 = t_diff * t_diff; // -> (t - t_R)^2
-
-        denominator = 2 * sigma * sigma + tau * t_diff; // -> 2\sigma_{g}^{2} + \tau \left(t - t_R\right)
-
-        if (denominator > 0)
-        {
-          exp1 = exp(-t_diff2 / denominator);
-
-          // \partial H f_{egh}(t) = \exp\left( \frac{-\left(t-t_R \right)}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right)
-          derivative_H = trace.theoretical_int * exp1;
-
-          // \partial t_R f_{egh}(t) &=& H \exp \left( \frac{-\left(t-t_R \right)}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right) \left( \frac{\left( 4 \sigma_{g}^{2} + \tau \left(t-t_R \right) \right) \left(t-t_R \right)}{\left( 2\sigma_{g}^{2} + \tau \left(t - t_R\right) \right)^2} \right)
-          derivative_tR = trace.theoretical_int * H * exp1 * ((4 * sigma * sigma + tau * t_diff) * t_diff) / (denominator * denominator);
-
-          // \partial \sigma_{g}^{2} f_{egh}(t) &=& H \exp \left( \frac{-\left(t-t_R \right)^2}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right) \left( \frac{ 2 \left(t - t_R\right)^2}{\left( 2\sigma_{g}^{2} + \tau \left(t - t_R\right) \right)^2} \right)
-          // // \partial \sigma_{g}^{2} f_{egh}(t) &=& H \exp \left( \frac{-\left(t-t_R \right)^2}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right) \left( \frac{ 2 \left(t - t_R\right)^2}{\left( 2\sigma_{g}^{2} + \tau \left(t - t_R\right) \right)^2} \right)
-          // derivative_sigma_square = trace.theoretical_int * H * exp1 * 2 * t_diff2 / (denominator * denominator));
-
-          // \partial \sigma_{g} f_{egh}(t) &=& H \exp \left( \frac{-\left(t-t_R \right)^2}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right) \left( \frac{ 4 \sigma_{g} \left(t - t_R\right)^2}{\left( 2\sigma_{g}^{2} + \tau \left(t - t_R\right) \right)^2} \right)
-          derivative_sigma = trace.theoretical_int * H * exp1 * 4 * sigma * t_diff2 / (denominator * denominator);
-
-          // \partial \tau f_{egh}(t) &=& H \exp \left( \frac{-\left(t-t_R \right)^2}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right) \left( \frac{ \left(t - t_R\right)^3}{\left( 2\sigma_{g}^{2} + \tau \left(t - t_R\right) \right)^2} \right)
-          derivative_tau = trace.theoretical_int * H * exp1 * t_diff * t_diff2 / (denominator * denominator);
-        }
-        else
-        {
-          derivative_H = 0.0;
-          derivative_tR = 0.0;
-          derivative_sigma = 0.0;
-          derivative_tau = 0.0;
-        }
-
-        // set the jacobian matrix
-        J(count, 0) = derivative_H * weight;
-        J(count, 1) = derivative_tR * weight;
-        J(count, 2) = derivative_sigma * weight;
-        J(count, 3) = derivative_tau * weight;
-        ++count;
+        double exp1 = reuse_exp ? exp_terms_[i] : exp(-t_diff2 / denominator);
+        double theo_H_exp = theoretical_ints[i] * H * exp1;
+
+        // \partial H f_{egh}(t) = \exp\left( \frac{-\left(t-t_R \right)}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right)
+        derivative_H = theoretical_ints[i] * exp1;
+
+        // \partial t_R f_{egh}(t) &=& H \exp \left( \frac{-\left(t-t_R \right)}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right) \left( \frac{\left( 4 \sigma_{g}^{2} + \tau \left(t-t_R \right) \right) \left(t-t_R \right)}{\left( 2\sigma_{g}^{2} + \tau \left(t - t_R\right) \right)^2} \right)
+        derivative_tR = theo_H_exp * ((4 * sigma * sigma + tau * t_diff) * t_diff) / (denominator * denominator);
+
+        // \partial \sigma_{g} f_{egh}(t) &=& H \exp \left( \frac{-\left(t-t_R \right)^2}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right) \left( \frac{ 4 \sigma_{g} \left(t - t_R\right)^2}{\left( 2\sigma_{g}^{2} + \tau \left(t - t_R\right) \right)^2} \right)
+        derivative_sigma = theo_H_exp * 4 * sigma * t_diff2 / (denominator * denominator);
+
+        // \partial \tau f_{egh}(t) &=& H \exp \left( \frac{-\left(t-t_R \right)^2}{2\sigma_{g}^{2} + \tau \left(t - t_R\right)} \right) \left( \frac{ \left(t - t_R\right)^3}{\left( 2\sigma_{g}^{2} + \tau \left(t - t_R\right) \right)^2} \right)
+        derivative_tau = theo_H_exp * t_diff * t_diff2 / (denominator * denominator);
+      }
+      else
+      {
+        derivative_H = 0.0;
+        derivative_tR = 0.0;
+        derivative_sigma = 0.0;
+        derivative_tau = 0.0;
       }
+
+      // set the jacobian matrix
+      J(i, 0) = derivative_H * weights[i];
+      J(i, 1) = derivative_tR * weights[i];
+      J(i, 2) = derivative_sigma * weights[i];
+      J(i, 3) = derivative_tau * weights[i];
     }
     return 0;
   }
@@ -184,6 +177,7 @@ namespace OpenMS
     TraceFitter::ModelData data{};
     data.traces_ptr = &traces;
     data.weighted = this->weighted_;
+    data.packPeaks();
     EGHTraceFunctor functor(NUM_PARAMS_, &data);
 
     TraceFitter::optimize_(x_init, functor);
@@ -9,7 +9,6 @@
 
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 #include <OpenMS/FEATUREFINDER/ElutionPeakDetection.h>
-#include <OpenMS/PROCESSING/SMOOTHING/SavitzkyGolayFilter.h>
 #include <OpenMS/MATH/StatisticFunctions.h>
 
 #include <boost/dynamic_bitset.hpp>
@@ -102,7 +101,7 @@ namespace OpenMS
   void ElutionPeakDetection::findLocalExtrema(const MassTrace& tr, const Size& num_neighboring_peaks,
                                               std::vector<Size>& chrom_maxes, std::vector<Size>& chrom_mins) const
   {
-    std::vector<double> smoothed_ints_vec(tr.getSmoothedIntensities());
+    const std::vector<double>& smoothed_ints_vec = tr.getSmoothedIntensities();
 
     Size mt_length(smoothed_ints_vec.size());
 
@@ -121,14 +120,17 @@ namespace OpenMS
 
     // Extract RTs from the chromatogram and store them into vectors for index access
     // Store indices along with smoothed_ints to keep track of the peak order
-    std::multimap<double, Size> intensity_indices;
+    // (sorted by intensity, then index - the same order as a multimap filled by index)
+    std::vector<std::pair<double, Size> > intensity_indices;
+    intensity_indices.reserve(mt_length);
     for (Size idx = 0; idx < mt_length; ++idx)
     {
-      intensity_indices.insert(std::make_pair(smoothed_ints_vec[idx], idx));
+      intensity_indices.emplace_back(smoothed_ints_vec[idx], idx);
     }
+    std::sort(intensity_indices.begin(), intensity_indices.end());
 
     // Step 1: Identify maxima
-    for (std::multimap<double, Size>::const_iterator c_it = intensity_indices.begin(); c_it != intensity_indices.end(); ++c_it)
+    for (std::vector<std::pair<double, Size> >::const_iterator c_it = intensity_indices.begin(); c_it != intensity_indices.end(); ++c_it)
     {
       double ref_int = c_it->first;
       Size ref_idx = c_it->second;
@@ -537,30 +539,75 @@ namespace OpenMS
     return;
   }
 
+  namespace
+  {
+    /// Output "iterator" for SavitzkyGolayFilter::filter() which only stores the smoothed intensities
+    struct SmoothedIntensityOutput
+    {
+      double* pos;
+
+      SmoothedIntensityOutput* operator->()
+      {
+        return this;
+      }
+
+      SmoothedIntensityOutput& operator++()
+      {
+        ++pos;
+        return *this;
+      }
+
+      template <typename PositionType>
+      void setPosition(const PositionType&)
+      {
+      }
+
+      void setIntensity(double intensity)
+      {
+        // same precision as the peak intensities
+        *pos = static_cast<Peak1D::IntensityType>(intensity);
+      }
+    };
+  }
+
+  const SavitzkyGolayFilter& ElutionPeakDetection::getSmoothingFilter_(int frame_length) const
+  {
+    const SavitzkyGolayFilter* sg = nullptr;
+#ifdef _OPENMP
+#pragma omp critical (OPENMS_ElutionPeakDetection_filters)
+#endif
+    {
+      auto it = sg_filters_.find(frame_length);
+      if (it == sg_filters_.end())
+      {
+        SavitzkyGolayFilter filter;
+        Param param;
+        param.setValue("polynomial_order", 2);
+        param.setValue("frame_length", frame_length);
+        filter.setParameters(param);
+        it = sg_filters_.emplace(frame_length, filter).first;
+      }
+      sg = &it->second;
+    }
+    return *sg;
+  }
+
   void ElutionPeakDetection::smoothData(MassTrace& mt, int win_size) const
   {
     // alternative smoothing using SavitzkyGolay
     // looking at the unit test, this method gives better fits than lowess smoothing
     // reference paper uses lowess smoothing
 
-    MSSpectrum spectrum;
-    for (Size i = 0; i != mt.getSize(); ++i)
-    {
-      spectrum.push_back(Peak1D(mt[i].getRT(), mt[i].getIntensity()));
-    }
+    // frame length must be at least polynomial_order+1, otherwise SG will fail
+    const SavitzkyGolayFilter& sg = getSmoothingFilter_(std::max(3, win_size));
 
-    SavitzkyGolayFilter sg;
-    Param param;
-    param.setValue("polynomial_order", 2);
-    param.setValue("frame_length", std::max(3, win_size)); // frame length must be at least polynomial_order+1, otherwise SG will fail
-    sg.setParameters(param);
-    sg.filter(spectrum);
-    MSSpectrum::iterator iter = spectrum.begin();
-    std::vector<double> smoothed_intensities;
-    for (; iter != spectrum.end(); ++iter)
+    // traces shorter than the frame are not smoothed
+    std::vector<double> smoothed_intensities(mt.getSize());
+    for (Size i = 0; i != mt.getSize(); ++i)
     {
-      smoothed_intensities.push_back(iter->getIntensity());
+      smoothed_intensities[i] = mt[i].getIntensity();
     }
+    sg.filter(mt.begin(), mt.end(), SmoothedIntensityOutput{smoothed_intensities.data()});
     mt.setSmoothedIntensities(smoothed_intensities);
     //alternative end
 
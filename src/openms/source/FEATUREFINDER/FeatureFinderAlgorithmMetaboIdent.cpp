@@ -318,7 +318,8 @@ namespace OpenMS
         return true;
       };
 
-    FeatureOverlapFilter::filter(features, FeatureComparator, FeatureOverlapCallback, CHECK_TRACES_FOR_OVERLAP);
+    // the callback only modifies the two features passed to it, so clusters can be resolved in parallel
+    FeatureOverlapFilter::filter(features, FeatureComparator, FeatureOverlapCallback, CHECK_TRACES_FOR_OVERLAP, true);
     std::stable_sort(features.begin(), features.end(), feature_compare_); // sort by ref and rt
 
     if (features.empty())
@@ -436,8 +436,21 @@ namespace OpenMS
     // Step 3:
     // Charge loop (create seeds and features for each charge separately)
     //-------------------------------------------------------------------------
-    Int plot_nr_global = -1;   // counter for the number of plots (debug info)
+    Int plot_nr_offset = 0;    // number of the first plot of the current charge (debug info)
     Int feature_nr_global = 0; // counter for the number of features (debug info)
+
+    // one trace fitter per thread, reused for all seeds (the fit does not depend on earlier fits)
+#ifdef _OPENMP
+    std::vector<std::shared_ptr<TraceFitter> > fitters(omp_get_max_threads());
+#else
+    std::vector<std::shared_ptr<TraceFitter> > fitters(1);
+#endif
+    double egh_tau_init = 0.0; // non-zero for EGH
+    for (std::shared_ptr<TraceFitter>& fitter : fitters)
+    {
+      fitter = chooseTraceFitter_(egh_tau_init);
+      fitter->setParameters(trace_fitter_params);
+    }
     for (SignedSize c = charge_low; c <= charge_high; ++c)
     {
       UInt meta_index_isotope = 3 + c - charge_low;
@@ -588,13 +601,23 @@ namespace OpenMS
       // The features are stored in an temporary feature map until it is
       // decided whether they are contained within a seed of higher
       // intensity.
-      std::map<Size, std::vector<Size>> seeds_in_features;
-      typedef std::map<Size, Feature> FeatureMapType;
-      FeatureMapType tmp_feature_map;
+      //
+      // Each seed writes only to its own entries, so no synchronization is needed.
+      std::vector<std::vector<Size> > seeds_in_features(seeds.size());
+      std::vector<std::unique_ptr<Feature> > tmp_features(seeds.size());
       int gl_progress = 0;
       startProgress(0, seeds.size(), String("Extending seeds for charge ") + String(c));
 
-#pragma omp parallel for
+      // seeds sorted by m/z, to find the seeds inside a feature
+      std::vector<std::pair<double, Size> > seeds_by_mz;
+      seeds_by_mz.reserve(seeds.size());
+      for (Size j = 0; j < seeds.size(); ++j)
+      {
+        seeds_by_mz.emplace_back(map_[seeds[j].spectrum][seeds[j].peak].getMZ(), j);
+      }
+      std::sort(seeds_by_mz.begin(), seeds_by_mz.end());
+
+#pragma omp parallel for schedule(dynamic)
       for (SignedSize i = 0; i < (SignedSize)seeds.size(); ++i)
       {
         //------------------------------------------------------------------
@@ -647,13 +670,8 @@ namespace OpenMS
         // Step 3.3.2:
         // Gauss/EGH fit (first fit to find the feature boundaries)
         //------------------------------------------------------------------
-        Int plot_nr = -1;
-
-
-#pragma omp critical(FeatureFinderAlgorithmPicked_PLOTNR)
-        {
-          plot_nr = ++plot_nr_global;
-        }
+        // numbered by seed (not by the order in which the threads get here), so the plots are reproducible
+        const Int plot_nr = plot_nr_offset + Int(i);
 
         //------------------------------------------------------------------
 
@@ -664,11 +682,13 @@ namespace OpenMS
 
         traces[traces.max_trace].updateMaximum();
 
-        //choose fitter
-        double egh_tau = 0.0;
-        std::shared_ptr<TraceFitter> fitter = chooseTraceFitter_(egh_tau);
-
-        fitter->setParameters(trace_fitter_params);
+        //fitter of this thread
+        double egh_tau = egh_tau_init;
+#ifdef _OPENMP
+        const std::shared_ptr<TraceFitter>& fitter = fitters[omp_get_thread_num()];
+#else
+        const std::shared_ptr<TraceFitter>& fitter = fitters[0];
+#endif
         fitter->fit(traces);
 
 #if 0
@@ -797,59 +817,52 @@ namespace OpenMS
           f.getConvexHulls().push_back(traces[j].getConvexhull());
         }
 
-#pragma omp critical(FeatureFinderAlgorithmPicked_TMPFEATUREMAP)
-        {
-          tmp_feature_map[i] = f;
-        }
-
         //----------------------------------------------------------------
         //Remember all seeds that lie inside the convex hull of the new feature
+        //(only seeds in the m/z range of the bounding box need to be checked)
         DBoundingBox<2> bb = f.getConvexHull().getBoundingBox();
-        for (Size j = i + 1; j < seeds.size(); ++j)
+        std::vector<Size>& contained = seeds_in_features[i];
+        for (auto it = std::lower_bound(seeds_by_mz.begin(), seeds_by_mz.end(), std::make_pair(bb.minPosition()[1], Size(0)));
+             it != seeds_by_mz.end() && it->first <= bb.maxPosition()[1]; ++it)
         {
+          Size j = it->second;
+          if (j <= (Size)i) continue;
           double rt = map_[seeds[j].spectrum].getRT();
-          double mz = map_[seeds[j].spectrum][seeds[j].peak].getMZ();
+          double mz = it->first;
           if (bb.encloses(rt, mz) && f.encloses(rt, mz))
           {
-#pragma omp critical(FeatureFinderAlgorithmPicked_SEEDSINFEATURES)
-            {
-              seeds_in_features[i].push_back(j);
-            }
+            contained.push_back(j);
           }
         }
+        std::sort(contained.begin(), contained.end());
+
+        tmp_features[i] = std::make_unique<Feature>(std::move(f));
       } //end of OPENMP over seeds
+      plot_nr_offset += Int(seeds.size());
 
       // Here we have to evaluate which seeds are already contained in
       // features of seeds with higher intensities. Only if the seed is not
       // used in any feature with higher intensity, we can add it to the
       // features_ list.
-      std::vector<Size> seeds_contained;
-      for (auto& f : tmp_feature_map)
+      std::vector<bool> seeds_contained(seeds.size(), false);
+      for (Size seed_nr = 0; seed_nr < seeds.size(); ++seed_nr)
       {
-        Size seed_nr = f.first;
-        bool is_used = false;
-        for (Size i : seeds_contained)
+        if (tmp_features[seed_nr] == nullptr || seeds_contained[seed_nr])
         {
-          if (seed_nr == i)
-          {
-            is_used = true;
-            break;
-          }
+          continue;
         }
-        if (!is_used)
-        {
-          ++feature_candidates;
+        ++feature_candidates;
 
-          //re-set label
-          f.second.setMetaValue(3, feature_nr_global);
-          ++feature_nr_global;
-          features_->push_back(f.second);
+        //re-set label
+        Feature& f = *tmp_features[seed_nr];
+        f.setMetaValue(3, feature_nr_global);
+        ++feature_nr_global;
+        features_->push_back(std::move(f));
+        tmp_features[seed_nr].reset();
 
-          std::vector<Size> curr_seed = seeds_in_features[seed_nr];
-          for (Size k : curr_seed)
-          {
-            seeds_contained.push_back(k);
-          }
+        for (Size k : seeds_in_features[seed_nr])
+        {
+          seeds_contained[k] = true;
         }
       }
 
@@ -1125,14 +1138,18 @@ namespace OpenMS
   /// Writes the abort reason to the log file and counts occurrences for each reason
   void FeatureFinderAlgorithmPicked::abort_(const Seed& seed, const String& reason)
   {
-    if (debug_)
+    // called from the parallel seed extension
+#pragma omp critical(FeatureFinderAlgorithmPicked_ABORT)
     {
-      log_ << "Abort: " << reason << std::endl;
-    }
-    aborts_[reason]++;
-    if (debug_)
-    {
-      abort_reasons_[seed] = reason;
+      if (debug_)
+      {
+        log_ << "Abort: " << reason << std::endl;
+      }
+      aborts_[reason]++;
+      if (debug_)
+      {
+        abort_reasons_[seed] = reason;
+      }
     }
   }
 
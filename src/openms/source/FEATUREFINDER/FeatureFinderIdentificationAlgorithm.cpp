@@ -15,6 +15,7 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/CONCEPT/UniqueIdGenerator.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/ChromatogramExtractor.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/ChromatogramExtractorAlgorithm.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
 #include <OpenMS/ML/SVM/SimpleSVM.h>
 #include <OpenMS/ANALYSIS/MAPMATCHING/MapAlignmentAlgorithmIdentification.h>
@@ -29,6 +30,7 @@
 #include <numeric>
 #include <fstream>
 #include <algorithm>
+#include <exception>
 #include <random>
 
 #ifdef _OPENMP
@@ -529,7 +531,7 @@ namespace OpenMS
       OPENMS_LOG_INFO << "Creating full assay library for debugging." << endl;
       // Warning: this step is pretty inefficient, since it does the whole library generation twice
       // Really use for debug only
-      createAssayLibrary_(peptide_map_.begin(), peptide_map_.end(), ref_rt_map, false);
+      createAssayLibrary_(peptide_map_.begin(), peptide_map_.end(), ref_rt_map, library_, isotope_probs_, false);
       cout << "Writing debug.traml file." << endl;
       FileHandler().storeTransitions("debug.traml", library_);
       ref_rt_map.clear();
@@ -541,53 +543,86 @@ namespace OpenMS
     //-------------------------------------------------------------
     //Note: progress only works in non-debug when no logs come in-between
     getProgressLogger().startProgress(0, chunks.size(), "Creating assay library and extracting chromatograms");
+    // The assay libraries of several chunks are created in parallel and their chromatograms are extracted
+    // together in a single pass over the spectra (peak picking still runs chunk by chunk, in order):
+    const Size chunks_per_pass = std::max(omp_get_max_threads(), 1);
     Size chunk_count = 0;
-    for (auto& chunk : chunks)
-    {
-      //TODO since ref_rt_map is only used after chunking, we could create
-      // maps per chunk and merge them in the end. Would help in parallelizing as well.
-      createAssayLibrary_(chunk.first, chunk.second, ref_rt_map);
-      OPENMS_LOG_DEBUG << "#Transitions: " << library_.getTransitions().size() << endl;
-
-      ChromatogramExtractor extractor;
-      // extractor.setLogType(ProgressLogger::NONE);
+    for (Size pass_start = 0; pass_start < chunks.size(); pass_start += chunks_per_pass)
+    {
+      const Size pass_size = std::min(chunks_per_pass, chunks.size() - pass_start);
+      vector<TargetedExperiment> libraries(pass_size);
+      vector<PeptideRefRTMap> ref_rt_maps(pass_size);
+      vector<map<String, double> > iso_probs(pass_size);
+      vector<vector<OpenSwath::ChromatogramPtr> > chrom_temp(pass_size);
+      vector<vector<ChromatogramExtractor::ExtractionCoordinates> > coords(pass_size);
+
+      std::exception_ptr library_error;
+#pragma omp parallel for schedule(dynamic, 1)
+      for (SignedSize i = 0; i < SignedSize(pass_size); ++i)
       {
-        vector<OpenSwath::ChromatogramPtr> chrom_temp;
-        vector<ChromatogramExtractor::ExtractionCoordinates> coords;
-        // take entries in library_ and put to chrom_temp and coords
-        extractor.prepare_coordinates(chrom_temp, coords, library_,
-                                      numeric_limits<double>::quiet_NaN(), false);
-
-
-        extractor.extractChromatograms(spec_temp, chrom_temp, coords, mz_window_,
-                                       mz_window_ppm_, "tophat");
-        extractor.return_chromatogram(chrom_temp, coords, library_, (*shared)[0],
-                                      chrom_data_.getChromatograms(), false);
+        try
+        {
+          const auto& chunk = chunks[pass_start + i];
+          createAssayLibrary_(chunk.first, chunk.second, ref_rt_maps[i], libraries[i], iso_probs[i]);
+          OPENMS_LOG_DEBUG << "#Transitions: " << libraries[i].getTransitions().size() << endl;
+          // take entries in the library and put to chrom_temp and coords
+          ChromatogramExtractor::prepare_coordinates(chrom_temp[i], coords[i], libraries[i],
+                                                     numeric_limits<double>::quiet_NaN(), false);
+        }
+        catch (...)
+        {
+#pragma omp critical (FeatureFinderIdentificationAlgorithm_library)
+          if (!library_error) library_error = std::current_exception();
+        }
       }
-
-      OPENMS_LOG_DEBUG << "Extracted " << chrom_data_.getNrChromatograms()
-                       << " chromatogram(s)." << endl;
-
-      OPENMS_LOG_DEBUG << "Detecting chromatographic peaks..." << endl;
-      // suppress status output from OpenSWATH, unless in debug mode:
-      if (debug_level_ < 1)
+      if (library_error)
       {
-        OpenMS_Log_info.remove(cout);
+        std::rethrow_exception(library_error);
       }
-      feat_finder_.pickExperiment(chrom_data_, features, library_,
-                                  TransformationDescription(), ms_data_);
-      if (debug_level_ < 1)
+
+      ChromatogramExtractorAlgorithm().extractChromatograms(spec_temp, chrom_temp, coords, mz_window_,
+                                                            mz_window_ppm_, -1, "tophat");
+
+      for (Size i = 0; i < pass_size; ++i)
       {
-        OpenMS_Log_info.insert(cout); // revert logging change
+        for (auto& entry : ref_rt_maps[i])
+        {
+          pair<RTMap, RTMap>& ids = ref_rt_map[entry.first];
+          ids.first.insert(entry.second.first.begin(), entry.second.first.end());
+          ids.second.insert(entry.second.second.begin(), entry.second.second.end());
+        }
+        ref_rt_maps[i].clear();
+        isotope_probs_.insert(iso_probs[i].begin(), iso_probs[i].end());
+
+        ChromatogramExtractor::return_chromatogram(chrom_temp[i], coords[i], libraries[i], (*shared)[0],
+                                                   chrom_data_.getChromatograms(), false);
+        chrom_temp[i].clear();
+        coords[i].clear();
+
+        OPENMS_LOG_DEBUG << "Extracted " << chrom_data_.getNrChromatograms()
+                         << " chromatogram(s)." << endl;
+
+        OPENMS_LOG_DEBUG << "Detecting chromatographic peaks..." << endl;
+        // suppress status output from OpenSWATH, unless in debug mode:
+        if (debug_level_ < 1)
+        {
+          OpenMS_Log_info.remove(cout);
+        }
+        feat_finder_.pickExperiment(chrom_data_, features, libraries[i],
+                                    TransformationDescription(), ms_data_);
+        if (debug_level_ < 1)
+        {
+          OpenMS_Log_info.insert(cout); // revert logging change
+        }
+        chrom_data_.clear(true);
+        libraries[i].clear(true);
+        // since chrom_data_ here is just a container for the chromatograms and identifications will be empty,
+        // pickExperiment above will only add empty ProteinIdentification runs with colliding identifiers.
+        // Usually we could sanitize the identifiers or merge the runs, but since they are empty and we add the
+        // "real" proteins later -> just clear them
+        features.getProteinIdentifications().clear();
+        getProgressLogger().setProgress(++chunk_count);
       }
-      chrom_data_.clear(true);
-      library_.clear(true);
-      // since chrom_data_ here is just a container for the chromatograms and identifications will be empty,
-      // pickExperiment above will only add empty ProteinIdentification runs with colliding identifiers.
-      // Usually we could sanitize the identifiers or merge the runs, but since they are empty and we add the
-      // "real" proteins later -> just clear them
-      features.getProteinIdentifications().clear();
-      getProgressLogger().setProgress(++chunk_count);
     }
     getProgressLogger().endProgress();
 
@@ -824,7 +859,8 @@ namespace OpenMS
 
   }
 
-  void FeatureFinderIdentificationAlgorithm::createAssayLibrary_(const PeptideMap::iterator& begin, const PeptideMap::iterator& end, PeptideRefRTMap& ref_rt_map, bool clear_IDs)
+  void FeatureFinderIdentificationAlgorithm::createAssayLibrary_(const PeptideMap::iterator& begin, const PeptideMap::iterator& end, PeptideRefRTMap& ref_rt_map,
+                                                                 TargetedExperiment& library, std::map<String, double>& isotope_probs, bool clear_IDs) const
   {
     std::set<String> protein_accessions;
 
@@ -899,8 +935,8 @@ namespace OpenMS
             peptide.rts.clear();
             addPeptideRT_(peptide, rt - rt_tolerance);
             addPeptideRT_(peptide, rt + rt_tolerance);
-            library_.addPeptide(peptide);
-            generateTransitions_(peptide.id, mz, charge, iso_dist);
+            library.addPeptide(peptide);
+            generateTransitions_(peptide.id, mz, charge, iso_dist, library, isotope_probs);
             internal_ids.emplace(rt_pep);
           }
         }
@@ -979,8 +1015,8 @@ namespace OpenMS
               peptide.rts.clear();
               addPeptideRT_(peptide, reg.start);
               addPeptideRT_(peptide, reg.end);
-              library_.addPeptide(peptide);
-              generateTransitions_(peptide.id, mz, charge, iso_dist);
+              library.addPeptide(peptide);
+              generateTransitions_(peptide.id, mz, charge, iso_dist, library, isotope_probs);
             }
             internal_ids.insert(reg.ids[charge].first.begin(),
                                 reg.ids[charge].first.end());
@@ -995,7 +1031,7 @@ namespace OpenMS
     {
       TargetedExperiment::Protein protein;
       protein.id = acc;
-      library_.addProtein(protein);
+      library.addProtein(protein);
     }
   }
 
@@ -1082,7 +1118,9 @@ namespace OpenMS
     const String& peptide_id, 
     double mz, 
     Int charge,
-    const IsotopeDistribution& iso_dist)
+    const IsotopeDistribution& iso_dist,
+    TargetedExperiment& library,
+    std::map<String, double>& isotope_probs) const
   {
     // go through different isotopes:
     Size counter = 0;
@@ -1100,8 +1138,8 @@ namespace OpenMS
       transition.setPeptideRef(peptide_id);
 
       //TODO what about transition charge? A lot of DIA scores depend on it and default to charge 1 otherwise.
-      library_.addTransition(transition);
-      isotope_probs_[transition_name] = iso.getIntensity();
+      library.addTransition(transition);
+      isotope_probs[transition_name] = iso.getIntensity();
       ++counter;
     }
   }
@@ -12,10 +12,13 @@
 #include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternGenerator.h>
 #include <OpenMS/CONCEPT/Constants.h>
 #include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/CONCEPT/PerfCounters.h>
 #include <OpenMS/CONCEPT/UniqueIdGenerator.h>
 #include <OpenMS/SYSTEM/File.h>
 
+#include <algorithm>
 #include <fstream>
+#include <unordered_map>
 
 #include <boost/dynamic_bitset.hpp>
 
@@ -327,6 +330,14 @@ namespace OpenMS
     use_mz_scoring_by_element_range_ = param_.getValue("mz_scoring_by_elements").toBool();
     std::string elements_list_ = param_.getValue("elements");
     elements_ = elementsFromString_(elements_list_);
+
+    // the windows only depend on the isotopic position, so compute them once for all hypotheses
+    isotope_windows_.clear();
+    Size iso_pos_max(static_cast<Size>(std::floor(charge_upper_bound_ * local_mz_range_)));
+    for (Size iso_pos = 1; iso_pos <= iso_pos_max; ++iso_pos)
+    {
+      isotope_windows_.push_back(getTheoreticIsotopicMassWindow_(elements_, iso_pos));
+    }
   }
 
 
@@ -609,8 +620,6 @@ namespace OpenMS
 
     // continue to check overlap and cosine similarity
     // ...
-    std::map<double, std::vector<double> > coinciding_rts;
-
     std::pair<Size, Size> tr1_fwhm_idx(tr1.getFWHMborders());
     std::pair<Size, Size> tr2_fwhm_idx(tr2.getFWHMborders());
 
@@ -628,26 +637,39 @@ namespace OpenMS
 
     // std::cout << "tr1 " << tr1_length << " tr2 " << tr2_length << std::endl;
 
-    // Extract peak shape between FWHM borders for both peaks
-    for (Size i = tr1_fwhm_idx.first; i <= tr1_fwhm_idx.second; ++i)
-    {
-      coinciding_rts[tr1[i].getRT()].push_back(tr1[i].getIntensity());
-    }
-    for (Size i = tr2_fwhm_idx.first; i <= tr2_fwhm_idx.second; ++i)
-    {
-      coinciding_rts[tr2[i].getRT()].push_back(tr2[i].getIntensity());
-    }
-
-    // Look at peaks at the same RT 
+    // Extract peak shape between FWHM borders for both peaks and look at
+    // peaks at the same RT (the peaks of a mass trace are sorted by RT, so
+    // both ranges can be merged; an RT counts if exactly two peaks have it)
     // TODO: this only works if both traces are sampled with equal rate at the same RT
     std::vector<double> x, y, overlap_rts;
-    for (std::map<double, std::vector<double> >::const_iterator m_it = coinciding_rts.begin(); m_it != coinciding_rts.end(); ++m_it)
+    Size i1(tr1_fwhm_idx.first), end1(tr1_fwhm_idx.second + 1);
+    Size i2(tr2_fwhm_idx.first), end2(tr2_fwhm_idx.second + 1);
+    while (i1 < end1 || i2 < end2)
     {
-      if (m_it->second.size() == 2)
+      double rt;
+      if (i2 >= end2 || (i1 < end1 && tr1[i1].getRT() <= tr2[i2].getRT()))
+      {
+        rt = tr1[i1].getRT();
+      }
+      else
+      {
+        rt = tr2[i2].getRT();
+      }
+      double ints[2];
+      Size count(0);
+      for (; i1 < end1 && tr1[i1].getRT() == rt; ++i1, ++count)
+      {
+        if (count < 2) ints[count] = tr1[i1].getIntensity();
+      }
+      for (; i2 < end2 && tr2[i2].getRT() == rt; ++i2, ++count)
+      {
+        if (count < 2) ints[count] = tr2[i2].getIntensity();
+      }
+      if (count == 2)
       {
-        x.push_back(m_it->second[0]);
-        y.push_back(m_it->second[1]);
-        overlap_rts.push_back(m_it->first);
+        x.push_back(ints[0]);
+        y.push_back(ints[1]);
+        overlap_rts.push_back(rt);
       }
     }
 
@@ -741,14 +763,21 @@ namespace OpenMS
     tmp_hypo.addMassTrace(*candidates[0]);
     tmp_hypo.setScore((candidates[0]->getIntensity(use_smoothed_intensities_)) / total_intensity);
 
+    {
+      PerfCounters::LockWait wait;
 #ifdef _OPENMP
 #pragma omp critical (OPENMS_FFMetabo_output_hypos)
 #endif
-    {
-      // pushing back to shared vector needs to be synchronized
-      output_hypotheses.push_back(tmp_hypo);
+      {
+        wait.acquired();
+        // pushing back to shared vector needs to be synchronized
+        output_hypotheses.push_back(tmp_hypo);
+      }
     }
 
+    // mass trace pairs scored (reported once, at the end)
+    UInt64 pairs_scored(0);
+
     for (Size charge = charge_lower_bound_; charge <= charge_upper_bound_; ++charge)
     {
       FeatureHypothesis fh_tmp;
@@ -763,8 +792,8 @@ namespace OpenMS
       Size iso_pos_max(static_cast<Size>(std::floor(charge * local_mz_range_)));
       for (Size iso_pos = 1; iso_pos <= iso_pos_max; ++iso_pos)
       {
-        //estimate expected m/z window for iso_pos
-        Range isotope_window = getTheoreticIsotopicMassWindow_(elements_, iso_pos);
+        //expected m/z window for iso_pos
+        const Range& isotope_window = isotope_windows_[iso_pos - 1];
         // Find mass trace that best agrees with current hypothesis of charge
         // and isotopic position
         double best_so_far(0.0);
@@ -781,6 +810,7 @@ namespace OpenMS
 #endif
 
           // Score current mass trace candidates against hypothesis
+          ++pairs_scored;
           double rt_score(scoreRT_(*candidates[0], *candidates[mt_idx]));
           double mz_score(scoreMZ_(*candidates[0], *candidates[mt_idx], iso_pos, charge, isotope_window));
 
@@ -824,10 +854,12 @@ namespace OpenMS
           fh_tmp.setCharge(charge);
           last_iso_idx = best_idx;
 
+          PerfCounters::LockWait wait;
 #ifdef _OPENMP
 #pragma omp critical (OPENMS_FFMetabo_output_hypos)
 #endif
           {
+            wait.acquired();
             // pushing back to shared vector needs to be synchronized
             output_hypotheses.push_back(fh_tmp);
           }
@@ -842,6 +874,7 @@ namespace OpenMS
       std::cout << "best found for ch " << charge << ":" << fh_tmp.getLabel() << " score: " << fh_tmp.getScore() << std::endl;
 #endif
     } // end for charge
+    PerfCounters::add(PerfCounters::CANDIDATES_SCORED, pairs_scored);
   } // end of findLocalFeatures_(...)
 
   void FeatureFindingMetabo::run(std::vector<MassTrace>& input_mtraces, FeatureMap& output_featmap, std::vector<std::vector< OpenMS::MSChromatogram > >& output_chromatograms)
@@ -893,10 +926,22 @@ namespace OpenMS
     // and generate isotopic / charge hypotheses
     // *********************************************************** //
 
+    // index the traces by RT bin (each bin in m/z order), so only traces
+    // close in RT are visited; with bins of twice the RT range, all
+    // candidates are in the neighboring bins
+    const double rt_bin_width = (local_rt_range_ > 0.0) ? 2.0 * local_rt_range_ : 1.0;
+    std::vector<Int64> rt_bin_of_trace(input_mtraces.size());
+    std::unordered_map<Int64, std::vector<Size> > traces_by_rt_bin;
+    for (Size i = 0; i < input_mtraces.size(); ++i)
+    {
+      rt_bin_of_trace[i] = static_cast<Int64>(std::floor(input_mtraces[i].getCentroidRT() / rt_bin_width));
+      traces_by_rt_bin[rt_bin_of_trace[i]].push_back(i);
+    }
+
     std::vector<FeatureHypothesis> feat_hypos;
     Size progress(0);
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for schedule(dynamic, 100)
 #endif
     for (SignedSize i = 0; i < (SignedSize)input_mtraces.size(); ++i)
     {
@@ -906,27 +951,42 @@ namespace OpenMS
 #endif
       ++progress;
 
-      std::vector<const MassTrace*> local_traces;
       double ref_trace_mz(input_mtraces[i].getCentroidMZ());
       double ref_trace_rt(input_mtraces[i].getCentroidRT());
 
-      local_traces.push_back(&input_mtraces[i]);
-
-      for (Size ext_idx = i + 1; ext_idx < input_mtraces.size(); ++ext_idx)
+      std::vector<Size> local_idx;
+      for (Int64 bin = rt_bin_of_trace[i] - 1; bin <= rt_bin_of_trace[i] + 1; ++bin)
       {
-        // traces are sorted by m/z, so we can break when we leave the allowed window
-        double diff_mz = std::fabs(input_mtraces[ext_idx].getCentroidMZ() - ref_trace_mz);
-        if (diff_mz > local_mz_range_)
+        auto bin_it = traces_by_rt_bin.find(bin);
+        if (bin_it == traces_by_rt_bin.end())
         {
-          break;
+          continue;
         }
-        double diff_rt = std::fabs(input_mtraces[ext_idx].getCentroidRT() - ref_trace_rt);
-        if (diff_rt <= local_rt_range_)
+        const std::vector<Size>& bin_traces = bin_it->second;
+        for (auto it = std::upper_bound(bin_traces.begin(), bin_traces.end(), Size(i)); it != bin_traces.end(); ++it)
         {
-          // std::cout << " accepted!" << std::endl;
-          local_traces.push_back(&input_mtraces[ext_idx]);
+          // traces are sorted by m/z, so we can break when we leave the allowed window
+          double diff_mz = std::fabs(input_mtraces[*it].getCentroidMZ() - ref_trace_mz);
+          if (diff_mz > local_mz_range_)
+          {
+            break;
+          }
+          double diff_rt = std::fabs(input_mtraces[*it].getCentroidRT() - ref_trace_rt);
+          if (diff_rt <= local_rt_range_)
+          {
+            local_idx.push_back(*it);
+          }
         }
       }
+      std::sort(local_idx.begin(), local_idx.end());
+
+      std::vector<const MassTrace*> local_traces;
+      local_traces.reserve(local_idx.size() + 1);
+      local_traces.push_back(&input_mtraces[i]);
+      for (Size ext_idx : local_idx)
+      {
+        local_traces.push_back(&input_mtraces[ext_idx]);
+      }
       findLocalFeatures_(local_traces, total_intensity, feat_hypos);
     }
     this->endProgress();
@@ -57,9 +57,10 @@ namespace OpenMS
     x_init(1) = x0_;
     x_init(2) = sigma_;
 
-    TraceFitter::ModelData data;
+    TraceFitter::ModelData data{};
     data.traces_ptr = &traces;
     data.weighted = this->weighted_;
+    data.packPeaks();
     GaussTraceFunctor functor(NUM_PARAMS_, &data);
 
     TraceFitter::optimize_(x_init, functor);
@@ -146,17 +147,20 @@ namespace OpenMS
     double sig = x(2);
     double c_fac = -0.5 / pow(sig, 2);
 
-    Size count = 0;
-    for (Size t = 0; t < m_data->traces_ptr->size(); ++t)
+    const double baseline = m_data->traces_ptr->baseline;
+    const double* rts = m_data->rts.data();
+    const double* intensities = m_data->intensities.data();
+    const double* theoretical_ints = m_data->theoretical_ints.data();
+    const double* weights = m_data->weights.data();
+
+    exp_terms_.resize(m_data->rts.size());
+    setExpTermsParameters_(x);
+
+    for (Size i = 0; i < m_data->rts.size(); ++i)
     {
-      const FeatureFinderAlgorithmPickedHelperStructs::MassTrace& trace = (*m_data->traces_ptr)[t];
-      double weight = m_data->weighted ? trace.theoretical_int : 1.0;
-      for (Size i = 0; i < trace.peaks.size(); ++i)
-      {
-        fvec(count) = (m_data->traces_ptr->baseline + trace.theoretical_int * height
-                       * exp(c_fac * pow(trace.peaks[i].first - x0, 2)) - trace.peaks[i].second->getIntensity()) * weight;
-        ++count;
-      }
+      double diff = rts[i] - x0;
+      exp_terms_[i] = exp(c_fac * (diff * diff));
+      fvec(i) = (baseline + theoretical_ints[i] * height * exp_terms_[i] - intensities[i]) * weights[i];
     }
 
     return 0;
@@ -172,20 +176,21 @@ namespace OpenMS
     double sig_3 = pow(sig, 3);
     double c_fac = -0.5 / sig_sq;
 
-    Size count = 0;
-    for (Size t = 0; t < m_data->traces_ptr->size(); ++t)
+    // exponentials from the last residual evaluation can be reused if it was at the same parameters
+    const bool reuse_exp = hasExpTerms_(x);
+
+    const double* rts = m_data->rts.data();
+    const double* theoretical_ints = m_data->theoretical_ints.data();
+    const double* weights = m_data->weights.data();
+
+    for (Size i = 0; i < m_data->rts.size(); ++i)
     {
-      const FeatureFinderAlgorithmPickedHelperStructs::MassTrace& trace = (*m_data->traces_ptr)[t];
-      double weight = m_data->weighted ? trace.theoretical_int : 1.0;
-      for (Size i = 0; i < trace.peaks.size(); ++i)
-      {
-        double rt = trace.peaks[i].first;
-        double e = exp(c_fac * pow(rt - x0, 2));
-        J(count, 0) = trace.theoretical_int * e * weight;
-        J(count, 1) = trace.theoretical_int * height * e * (rt - x0) / sig_sq * weight;
-        J(count, 2) = 0.125* trace.theoretical_int* height* e* pow(rt - x0, 2) / sig_3 * weight;
-        ++count;
-      }
+      double diff = rts[i] - x0;
+      double diff_sq = diff * diff;
+      double e = reuse_exp ? exp_terms_[i] : exp(c_fac * diff_sq);
+      J(i, 0) = theoretical_ints[i] * e * weights[i];
+      J(i, 1) = theoretical_ints[i] * height * e * diff / sig_sq * weights[i];
+      J(i, 2) = 0.125 * theoretical_ints[i] * height * e * diff_sq / sig_3 * weights[i];
     }
     return 0;
   }
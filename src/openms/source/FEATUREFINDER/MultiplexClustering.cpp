@@ -156,7 +156,8 @@ namespace OpenMS
       setProgress(++progress);
         
       GridBasedClustering<MultiplexDistance> clustering(MultiplexDistance(rt_scaling_), filter_results[i].getMZ(), filter_results[i].getRT(), grid_spacing_mz_, grid_spacing_rt_);
-      clustering.cluster();
+      // regions separated by empty m/z columns are clustered in parallel (same result as cluster())
+      clustering.clusterParallel();
       //clustering.extendClustersY();
       cluster_results.push_back(clustering.getResults());
     }
@@ -75,6 +75,8 @@ namespace OpenMS
     // reset both the white MS experiment and the corresponding mapping to the complete i.e. original MS experiment
     exp_centroided_white_.clear(true);
     exp_centroided_mapping_.clear();
+    exp_centroided_white_.reserve(exp_centroided_.size());
+    exp_centroided_mapping_.reserve(exp_centroided_.size());
     
     // loop over spectra
     for (const auto &it_rt : exp_centroided_)
@@ -82,8 +84,7 @@ namespace OpenMS
       MSSpectrum spectrum_picked_white;
       spectrum_picked_white.setRT(it_rt.getRT());
       
-      std::map<int, int> mapping_spectrum;
-      int count = 0;
+      std::vector<int> mapping_spectrum;
       // loop over m/z
       for (const auto &it_mz : it_rt)
       {
@@ -91,12 +92,11 @@ namespace OpenMS
         {
           spectrum_picked_white.push_back(it_mz);
           
-          mapping_spectrum[count] = &it_mz - &it_rt[0];
-          ++count;
+          mapping_spectrum.push_back(&it_mz - &it_rt[0]);
         }
       }
-      exp_centroided_white_.addSpectrum(spectrum_picked_white);
-      exp_centroided_mapping_.push_back(mapping_spectrum);
+      exp_centroided_white_.addSpectrum(std::move(spectrum_picked_white));
+      exp_centroided_mapping_.push_back(std::move(mapping_spectrum));
     }
     exp_centroided_white_.updateRanges();
   }
@@ -317,7 +317,7 @@ namespace OpenMS
     }
     
     // Determine the RT boundaries for each of the mass traces.
-    std::multimap<size_t, MultiplexSatelliteCentroided > satellites = peak.getSatellites();
+    const std::multimap<size_t, MultiplexSatelliteCentroided >& satellites = peak.getSatellites();
     // <rt_boundaries> is a map from the mass trace index to the spectrum indices for beginning and end of the mass trace.
     std::map<size_t, std::pair<size_t, size_t> > rt_boundaries;
     // loop over satellites
@@ -401,28 +401,28 @@ namespace OpenMS
     return exp_blacklist;
   }
   
-  bool MultiplexFiltering::filterAveragineModel_(const MultiplexIsotopicPeakPattern& pattern, const MultiplexFilteredPeak& peak) const
+  IsotopeDistribution MultiplexFiltering::getAveragineDistribution_(double mass) const
   {
-    // construct averagine distribution
-    double mass = peak.getMZ() * pattern.getCharge();
     CoarseIsotopePatternGenerator solver(isotopes_per_peptide_max_);
-    IsotopeDistribution distribution;
     if (averagine_type_ == "peptide")
     {
-      distribution = solver.estimateFromPeptideWeight(mass);
+      return solver.estimateFromPeptideWeight(mass);
     }
     else if (averagine_type_ == "RNA")
     {
-      distribution = solver.estimateFromRNAWeight(mass);
+      return solver.estimateFromRNAWeight(mass);
     }
     else if (averagine_type_ == "DNA")
     {
-      distribution = solver.estimateFromDNAWeight(mass);
-    }
-    else
-    {
-      throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Invalid averagine type.");
+      return solver.estimateFromDNAWeight(mass);
     }
+    throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Invalid averagine type.");
+  }
+
+  bool MultiplexFiltering::filterAveragineModel_(const MultiplexIsotopicPeakPattern& pattern, const MultiplexFilteredPeak& peak) const
+  {
+    // construct averagine distribution
+    IsotopeDistribution distribution = getAveragineDistribution_(peak.getMZ() * pattern.getCharge());
     
     // loop over peptides
     for (size_t peptide = 0; peptide < pattern.getMassShiftCount(); ++peptide)
@@ -444,18 +444,9 @@ namespace OpenMS
         // loop over satellites in mass trace
         for (std::multimap<size_t, MultiplexSatelliteCentroided >::const_iterator satellite_it = satellites.first; satellite_it != satellites.second; ++satellite_it)
         {
-          // find indices of the peak
-          size_t rt_idx = (satellite_it->second).getRTidx();
-          size_t mz_idx = (satellite_it->second).getMZidx();
-          
-          // find peak itself
-          MSExperiment::ConstIterator it_rt = exp_centroided_.begin();
-          std::advance(it_rt, rt_idx);
-          MSSpectrum::ConstIterator it_mz = it_rt->begin();
-          std::advance(it_mz, mz_idx);
-                    
+          // find the peak itself
           ++count;
-          sum_intensities += it_mz->getIntensity();
+          sum_intensities += exp_centroided_[(satellite_it->second).getRTidx()][(satellite_it->second).getMZidx()].getIntensity();
         }
         
         if (count > 0)
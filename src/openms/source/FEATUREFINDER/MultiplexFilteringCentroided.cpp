@@ -49,7 +49,7 @@ namespace OpenMS
     for (unsigned pattern_idx = 0; pattern_idx < patterns_.size(); ++pattern_idx)
     {
       // current pattern
-      MultiplexIsotopicPeakPattern pattern = patterns_[pattern_idx];
+      const MultiplexIsotopicPeakPattern& pattern = patterns_[pattern_idx];
       
       // data structure storing peaks which pass all filters for this pattern
       MultiplexFilteredMSExperiment result;
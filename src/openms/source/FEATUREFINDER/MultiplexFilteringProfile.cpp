@@ -17,6 +17,10 @@
 #include <sstream>
 #include <utility>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 //#define DEBUG_FFMULTIPLEX
 
 using namespace std;
@@ -108,17 +112,20 @@ namespace OpenMS
     
     // construct navigators for all spline spectra
     std::vector<SplineInterpolatedPeaks::Navigator> navigators;
+    navigators.reserve(exp_spline_profile_.size());
     for (SplineInterpolatedPeaks& spl : exp_spline_profile_)
     {
-      SplineInterpolatedPeaks::Navigator nav = spl.getNavigator();
-      navigators.push_back(nav);
+      navigators.push_back(spl.getNavigator());
     }
+    // Navigators remember the last spline package accessed, so each thread needs its own copies.
+    // They are reused for all patterns.
+    std::vector<std::vector<SplineInterpolatedPeaks::Navigator> > thread_navigators(omp_get_max_threads(), navigators);
     
     // loop over all patterns
     for (unsigned pattern_idx = 0; pattern_idx < patterns_.size(); ++pattern_idx)
     {
       // current pattern
-      MultiplexIsotopicPeakPattern pattern = patterns_[pattern_idx];
+      const MultiplexIsotopicPeakPattern& pattern = patterns_[pattern_idx];
       
       // data structure storing peaks which pass all filters
       MultiplexFilteredMSExperiment result;
@@ -150,6 +157,7 @@ namespace OpenMS
         #pragma omp parallel for
         for (SignedSize s = 0; s < (SignedSize) it_rt.size(); s++)
         {
+          std::vector<SplineInterpolatedPeaks::Navigator>& navs = thread_navigators[omp_get_thread_num()];
           double mz = it_rt[s].getMZ();
           MultiplexFilteredPeak peak(mz, rt, exp_centroided_mapping_[idx_rt][s], idx_rt);
           
@@ -165,10 +173,13 @@ namespace OpenMS
           //double rt_peak = peak.getRT();
           double mz_peak = peak.getMZ();
 
-          std::multimap<size_t, MultiplexSatelliteCentroided > satellites = peak.getSatellites();
+          const std::multimap<size_t, MultiplexSatelliteCentroided >& satellites = peak.getSatellites();
+
+          // The averagine model depends only on the peak, not on the profile position, so compute it just once.
+          const IsotopeDistribution averagine = getAveragineDistribution_(peak.getMZ() * pattern.getCharge());
           
           // Arrangement of peaks looks promising. Now scan through the spline fitted profile data around the peak i.e. from peak boundary to peak boundary.
-          for (double mz_profile = peak_min; mz_profile < peak_max; mz_profile = navigators[idx_rt].getNextPos(mz_profile))
+          for (double mz_profile = peak_min; mz_profile < peak_max; mz_profile = navs[idx_rt].getNextPos(mz_profile))
           {
             // determine m/z shift relative to the centroided peak at which the profile data will be sampled
             double mz_shift = mz_profile - mz_peak;
@@ -176,29 +187,24 @@ namespace OpenMS
             std::multimap<size_t, MultiplexSatelliteProfile > satellites_profile;
 
             // construct the set of spline-interpolated satellites for this specific mz_profile
+            // (satellites are sorted by their key, so inserting at the end keeps the order of equal keys)
             for (const auto &satellite_it : satellites)
             {
               // find indices of the peak
               size_t rt_idx = (satellite_it.second).getRTidx();
               size_t mz_idx = (satellite_it.second).getMZidx();
               
-              // find peak itself
-              MSExperiment::ConstIterator it_rt = exp_centroided_.begin();
-              std::advance(it_rt, rt_idx);
-              MSSpectrum::ConstIterator it_mz = it_rt->begin();
-              std::advance(it_mz, mz_idx);
-              
-              double rt_satellite = it_rt->getRT();
-              double mz_satellite = it_mz->getMZ();
+              double rt_satellite = exp_centroided_[rt_idx].getRT();
+              double mz_satellite = exp_centroided_[rt_idx][mz_idx].getMZ();
               
               // determine m/z and corresponding intensity
               double mz = mz_satellite + mz_shift;
-              double intensity = navigators[rt_idx].eval(mz);
+              double intensity = navs[rt_idx].eval(mz);
               
-              satellites_profile.insert(std::make_pair(satellite_it.first, MultiplexSatelliteProfile(rt_satellite, mz, intensity)));
+              satellites_profile.emplace_hint(satellites_profile.end(), satellite_it.first, MultiplexSatelliteProfile(rt_satellite, mz, intensity));
             }
             
-            if (!(filterAveragineModel_(pattern, peak, satellites_profile)))
+            if (!(filterAveragineModel_(pattern, averagine, satellites_profile)))
             {
               continue;
             }
@@ -260,29 +266,9 @@ namespace OpenMS
     return boundaries_;
   }
 
-  bool MultiplexFilteringProfile::filterAveragineModel_(const MultiplexIsotopicPeakPattern& pattern, const MultiplexFilteredPeak& peak, const std::multimap<size_t, MultiplexSatelliteProfile >& satellites_profile) const
+  bool MultiplexFilteringProfile::filterAveragineModel_(const MultiplexIsotopicPeakPattern& pattern, const IsotopeDistribution& distribution, const std::multimap<size_t, MultiplexSatelliteProfile >& satellites_profile) const
   {
-    // construct averagine distribution
-    // Note that the peptide(s) are very close in mass. We therefore calculate the averagine distribution only once (for the lightest peptide).
-    double mass = peak.getMZ() * pattern.getCharge();
-    CoarseIsotopePatternGenerator solver(isotopes_per_peptide_max_);
-    IsotopeDistribution distribution;
-    if (averagine_type_ == "peptide")
-    {
-      distribution = solver.estimateFromPeptideWeight(mass);
-    }
-    else if (averagine_type_ == "RNA")
-    {
-      distribution = solver.estimateFromRNAWeight(mass);
-    }
-    else if (averagine_type_ == "DNA")
-    {
-      distribution = solver.estimateFromDNAWeight(mass);
-    }
-    else
-    {
-      throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Invalid averagine type.");
-    }   
+    // Note that the peptide(s) are very close in mass. The averagine distribution is therefore calculated only once (for the lightest peptide).
     
     // loop over peptides
     for (size_t peptide = 0; peptide < pattern.getMassShiftCount(); ++peptide)
@@ -11,6 +11,8 @@
 #include <unsupported/Eigen/NonLinearOptimization>
 #include <Eigen/Core>
 
+#include <algorithm>
+
 namespace OpenMS
 {
 
@@ -31,6 +33,41 @@ namespace OpenMS
 
   TraceFitter::GenericFunctor::~GenericFunctor() = default;
 
+  void TraceFitter::GenericFunctor::setExpTermsParameters_(const Eigen::VectorXd& x)
+  {
+    exp_terms_params_.assign(x.data(), x.data() + x.size());
+  }
+
+  bool TraceFitter::GenericFunctor::hasExpTerms_(const Eigen::VectorXd& x) const
+  {
+    return (exp_terms_params_.size() == Size(x.size())) &&
+      std::equal(exp_terms_params_.begin(), exp_terms_params_.end(), x.data());
+  }
+
+  void TraceFitter::ModelData::packPeaks()
+  {
+    const Size n_peaks = traces_ptr->getPeakCount();
+    rts.clear();
+    intensities.clear();
+    theoretical_ints.clear();
+    weights.clear();
+    rts.reserve(n_peaks);
+    intensities.reserve(n_peaks);
+    theoretical_ints.reserve(n_peaks);
+    weights.reserve(n_peaks);
+    for (const FeatureFinderAlgorithmPickedHelperStructs::MassTrace& trace : *traces_ptr)
+    {
+      const double weight = weighted ? trace.theoretical_int : 1.0;
+      for (const std::pair<double, const Peak1D*>& peak : trace.peaks)
+      {
+        rts.push_back(peak.first);
+        intensities.push_back(peak.second->getIntensity());
+        theoretical_ints.push_back(trace.theoretical_int);
+        weights.push_back(weight);
+      }
+    }
+  }
+
   TraceFitter::TraceFitter() :
     DefaultParamHandler("TraceFitter")
   {
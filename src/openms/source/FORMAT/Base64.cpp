@@ -164,44 +164,69 @@ namespace OpenMS
     }
   }
 
-  void Base64::stringSimdDecoder_(const std::string& in, std::string& out)
+  Size Base64::decodedSize_(const char* in, const Size in_size)
   {
-    out.clear();
-    const char* inPtr = &in[0];
-
-    // padding count:
-    uint8_t g = 0;
-    if (in[in.size() - 1] == '=')
-      g++;
-    if (in[in.size() - 2] == '=')
-      g++;
-
-    unsigned outsize = (in.size() / 16) * 12 + 16;
-    // not final size (final rezize later to cutoff unwanted characters)
-    out.resize(outsize);
-    char* outPtr = &out[0];
-    int loop = in.size() / 16;
+    if (in_size < 4)
+    {
+      return 0;
+    }
+    Size padding = 0;
+    if (in[in_size - 1] == '=') padding++;
+    if (in[in_size - 2] == '=') padding++;
+    return (in_size / 4) * 3 - padding;
+  }
 
-    for (int i = 0; i < loop; i++)
+  void Base64::stringSimdDecoder_(const char* in, const Size in_size, char* out)
+  {
+    const Size out_size = decodedSize_(in, in_size);
+    // every 16 input characters yield 12 bytes, but each store writes a full register (16 bytes):
+    // only blocks whose store stays within @p out are stored directly, the tail goes through a buffer
+    Size read = 0;
+    Size written = 0;
+    // two independent registers per iteration to keep the vector units busy
+    while (read + 32 <= in_size && written + 28 <= out_size)
     {
-      simde__m128i data = simde_mm_lddqu_si128((simde__m128i*)(inPtr + i * 16));
+      simde__m128i data1 = simde_mm_lddqu_si128((const simde__m128i*)(in + read));
+      simde__m128i data2 = simde_mm_lddqu_si128((const simde__m128i*)(in + read + 16));
+      registerDecoder_(data1);
+      registerDecoder_(data2);
+      simde_mm_storeu_si128((simde__m128i*)(out + written), data1);
+      simde_mm_storeu_si128((simde__m128i*)(out + written + 12), data2);
+      read += 32;
+      written += 24;
+    }
+    while (read + 16 <= in_size && written + 16 <= out_size)
+    {
+      simde__m128i data = simde_mm_lddqu_si128((const simde__m128i*)(in + read));
       registerDecoder_(data);
-      simde_mm_storeu_si128((simde__m128*)(outPtr + i * 12), data);
+      simde_mm_storeu_si128((simde__m128i*)(out + written), data);
+      read += 16;
+      written += 12;
     }
-
-    size_t read = loop * 16;
     std::array<char, 16> rest;
-    std::fill(rest.begin(), rest.end(), 'x');
-    std::copy(in.begin() + read, in.end(), rest.begin());
-
-    simde__m128i data = simde_mm_lddqu_si128((simde__m128i*)&rest[0]);
-    registerDecoder_(data);
-    size_t written = loop * 12;
-    simde_mm_storeu_si128((simde__m128*)(outPtr + written), data);
+    while (read < in_size && written < out_size)
+    {
+      const Size n_in = std::min(Size(16), in_size - read);
+      std::fill(rest.begin(), rest.end(), 'A');
+      std::copy(in + read, in + read + n_in, rest.begin());
+      simde__m128i data = simde_mm_lddqu_si128((const simde__m128i*)&rest[0]);
+      registerDecoder_(data);
+      simde_mm_storeu_si128((simde__m128i*)&rest[0], data);
+      const Size n_out = std::min(Size(12), out_size - written);
+      std::copy(rest.begin(), rest.begin() + n_out, out + written);
+      read += 16;
+      written += n_out;
+    }
+  }
 
-    // cutting off decoding of appendix
-    outsize = (in.size() / 4) * 3 - g;
-    out.resize(outsize);
+  void Base64::stringSimdDecoder_(const std::string& in, std::string& out)
+  {
+    out.resize(decodedSize_(in.data(), in.size()));
+    if (out.empty())
+    {
+      return;
+    }
+    stringSimdDecoder_(in.data(), in.size(), &out[0]);
   }
 
   const char Base64::encoder_[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
@@ -273,19 +298,7 @@ namespace OpenMS
     base64_uncompressed = QByteArray::fromBase64(herewego);
     if (zlib_compression)
     {
-      QByteArray czip;
-      czip.resize(4);
-      czip[0] = (base64_uncompressed.size() & 0xff000000) >> 24;
-      czip[1] = (base64_uncompressed.size() & 0x00ff0000) >> 16;
-      czip[2] = (base64_uncompressed.size() & 0x0000ff00) >> 8;
-      czip[3] = (base64_uncompressed.size() & 0x000000ff);
-      czip += base64_uncompressed;
-      base64_uncompressed = qUncompress(czip);
-
-      if (base64_uncompressed.isEmpty())
-      {
-        throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
-      }
+      ZlibCompression::uncompressString(base64_uncompressed, base64_uncompressed);
     }
   }
 
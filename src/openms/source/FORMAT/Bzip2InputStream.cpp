@@ -17,11 +17,13 @@ namespace OpenMS
   Bzip2InputStream::Bzip2InputStream(const String & file_name) :
     bzip2_(new Bzip2Ifstream(file_name.c_str())), file_current_index_(0)
   {
+    startReading_();
   }
 
   Bzip2InputStream::Bzip2InputStream(const char * file_name) :
     bzip2_(new Bzip2Ifstream(file_name)), file_current_index_(0)
   {
+    startReading_();
   }
 
 /*	Bzip2InputStream::Bzip2InputStream()
@@ -32,19 +34,24 @@ namespace OpenMS
 
   Bzip2InputStream::~Bzip2InputStream()
   {
+    read_ahead_.reset(); // stop decompressing before the stream is deleted
     delete bzip2_;
   }
 
-  XMLSize_t Bzip2InputStream::readBytes(XMLByte * const to_fill, const XMLSize_t max_to_read)
+  void Bzip2InputStream::startReading_()
   {
-    //  Figure out whether we can really read.
-    if (bzip2_->streamEnd())
+    Bzip2Ifstream* stream = bzip2_;
+    read_ahead_ = std::make_unique<ReadAheadBuffer>([stream](char* s, size_t n, bool& end)
     {
-      return 0;
-    }
+      size_t count = stream->streamEnd() ? 0 : stream->read(s, n);
+      end = stream->streamEnd() || count == 0;
+      return count;
+    });
+  }
 
-    unsigned char * fill_it = static_cast<unsigned char *>(to_fill);
-    XMLSize_t actual_read = (XMLSize_t) bzip2_->read((char *)fill_it, static_cast<size_t>(max_to_read));
+  XMLSize_t Bzip2InputStream::readBytes(XMLByte * const to_fill, const XMLSize_t max_to_read)
+  {
+    XMLSize_t actual_read = (XMLSize_t) read_ahead_->read((char *)to_fill, static_cast<size_t>(max_to_read));
     file_current_index_ += actual_read;
     return actual_read;
   }
@@ -16,6 +16,8 @@
 
 #include <OpenMS/FORMAT/HANDLERS/CachedMzMLHandler.h>
 
+#include <QtCore/QFile>
+
 namespace OpenMS
 {
 
@@ -33,11 +35,20 @@ namespace OpenMS
 
   CachedmzML::CachedmzML(const CachedmzML & rhs) :
     meta_ms_experiment_(rhs.meta_ms_experiment_),
-    ifs_(rhs.filename_cached_.c_str(), std::ios::binary),
     filename_(rhs.filename_),
+    filename_cached_(rhs.filename_cached_),
     spectra_index_(rhs.spectra_index_),
-    chrom_index_(rhs.chrom_index_)
+    chrom_index_(rhs.chrom_index_),
+    mapped_file_(rhs.mapped_file_),
+    mapped_data_(rhs.mapped_data_),
+    mapped_size_(rhs.mapped_size_),
+    compressed_(rhs.compressed_)
   {
+    // a shared mapping is safe for concurrent reads; only fall back to a private stream if there is none
+    if (mapped_data_ == nullptr)
+    {
+      ifs_.open(rhs.filename_cached_.c_str(), std::ios::binary);
+    }
   }
 
   void CachedmzML::load_(const String& filename)
@@ -49,19 +60,98 @@ namespace OpenMS
     Internal::CachedMzMLHandler cache;
     cache.createMemdumpIndex(filename_cached_);
     spectra_index_ = cache.getSpectraIndex();
-    chrom_index_ = cache.getChromatogramIndex();;
+    chrom_index_ = cache.getChromatogramIndex();
+    compressed_ = cache.isCompressed();
 
-    // open the filestream
-    ifs_.open(filename_cached_.c_str(), std::ios::binary);
+    // map the file into memory, use a filestream if that is not possible
+    mapCachedFile_();
+    if (mapped_data_ == nullptr)
+    {
+      ifs_.open(filename_cached_.c_str(), std::ios::binary);
+    }
 
     // load the meta data from disk
     FileHandler().loadExperiment(filename, meta_ms_experiment_, {OpenMS::FileTypes::MZML});
   }
 
+  void CachedmzML::mapCachedFile_()
+  {
+    mapped_file_.reset();
+    mapped_data_ = nullptr;
+    mapped_size_ = 0;
+
+    auto file = std::make_shared<QFile>(filename_cached_.toQString());
+    if (!file->open(QIODevice::ReadOnly) || file->size() <= 0)
+    {
+      return;
+    }
+    uchar* data = file->map(0, file->size());
+    if (data == nullptr)
+    {
+      return;
+    }
+    mapped_size_ = static_cast<Size>(file->size());
+    mapped_data_ = reinterpret_cast<const char*>(data);
+    mapped_file_ = file;
+  }
+
+  const char* CachedmzML::getRecord_(std::streamoff offset, std::string& buffer, Size& record_size)
+  {
+    if (mapped_data_ != nullptr)
+    {
+      if (offset < 0 || static_cast<Size>(offset) >= mapped_size_)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Index position " + String(offset) + " is outside of the mapped file.", filename_cached_);
+      }
+      if (!compressed_)
+      {
+        record_size = mapped_size_ - offset;
+        return mapped_data_ + offset;
+      }
+      Internal::CachedMzMLHandler::uncompressRecord(mapped_data_ + offset, mapped_size_ - offset, buffer);
+    }
+    else if (compressed_)
+    {
+      if ( !ifs_.seekg(offset) )
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Error while changing position of input stream pointer.", filename_cached_);
+      }
+      Internal::CachedMzMLHandler::uncompressRecord(ifs_, buffer);
+    }
+    else
+    {
+      // plain file, read directly from the stream
+      return nullptr;
+    }
+    record_size = buffer.size();
+    return buffer.data();
+  }
+
+  bool CachedmzML::isMemoryMapped() const
+  {
+    return mapped_data_ != nullptr;
+  }
+
+  bool CachedmzML::isCompressed() const
+  {
+    return compressed_;
+  }
+
   MSSpectrum CachedmzML::getSpectrum(Size id)
   {
     OPENMS_PRECONDITION(id < getNrSpectra(), "Id cannot be larger than number of spectra");
 
+    std::string buffer;
+    Size record_size = 0;
+    if (const char* record = getRecord_(spectra_index_[id], buffer, record_size))
+    {
+      MSSpectrum s = meta_ms_experiment_.getSpectrum(id);
+      Internal::CachedMzMLHandler::readSpectrum(s, record, record_size);
+      return s;
+    }
+
     if ( !ifs_.seekg(spectra_index_[id]) )
     {
       std::cerr << "Error while reading spectrum " << id << " - seekg created an error when trying to change position to " << spectra_index_[id] << "." << std::endl;
@@ -79,6 +169,15 @@ namespace OpenMS
   {
     OPENMS_PRECONDITION(id < getNrChromatograms(), "Id cannot be larger than number of chromatograms");
 
+    std::string buffer;
+    Size record_size = 0;
+    if (const char* record = getRecord_(chrom_index_[id], buffer, record_size))
+    {
+      MSChromatogram c = meta_ms_experiment_.getChromatogram(id);
+      Internal::CachedMzMLHandler::readChromatogram(c, record, record_size);
+      return c;
+    }
+
     if ( !ifs_.seekg(chrom_index_[id]) )
     {
       std::cerr << "Error while reading chromatogram " << id << " - seekg created an error when trying to change position to " << chrom_index_[id] << "." << std::endl;
@@ -102,9 +201,9 @@ namespace OpenMS
     return meta_ms_experiment_.getChromatograms().size();
   }
 
-  void CachedmzML::store(const String& filename, const PeakMap& map)
+  void CachedmzML::store(const String& filename, const PeakMap& map, bool compress)
   {
-    Internal::CachedMzMLHandler().writeMemdump(map, filename + ".cached");
+    Internal::CachedMzMLHandler().writeMemdump(map, filename + ".cached", compress);
     Internal::CachedMzMLHandler().writeMetadata_x(map, filename, true);
   }
 
@@ -100,4 +100,18 @@ namespace OpenMS
 
   }
 
+  void ConsensusXMLFile::transform(const String& filename, Interfaces::IConsensusDataConsumer* consumer)
+  {
+    // receives the meta data only
+    ConsensusMap consensus_map;
+    consensus_map.setLoadedFileType(filename);
+    consensus_map.setLoadedFilePath(filename);
+
+    Internal::ConsensusXMLHandler handler(consensus_map, filename);
+    handler.setOptions(options_);
+    handler.setConsensusConsumer(consumer);
+    handler.setLogType(getLogType());
+    parse_(filename, &handler);
+  }
+
 } // namespace OpenMS
@@ -8,18 +8,138 @@
 
 #include <OpenMS/FORMAT/ControlledVocabulary.h>
 
+#include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/DATASTRUCTURES/DataValue.h>
 #include <OpenMS/FORMAT/HANDLERS/XMLHandler.h>
 #include <OpenMS/SYSTEM/File.h>
 
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iostream>
 #include <fstream>
 #include <map>
+#include <memory>
 
 using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    using UInt8 = std::uint8_t;
+
+    /*
+      Snapshot layout (all numbers in the byte order of the writing machine):
+
+      header:  magic[8] | UInt32 version | UInt32 byte order mark |
+               UInt32 n_sources | n_sources x (string path | UInt64 size | Int64 modification time)
+      CV:      string name | string label | string version | string url |
+               UInt64 n_terms | n_terms terms (in the order of terms_) |
+               UInt64 n_names | n_names x (string name | string id) (in the order of namesToIds_)
+      term:    string name | string id | string set parents | string set children | UInt8 obsolete |
+               string description | string list synonyms | string list unparsed | UInt32 xref_type |
+               string list xref_binary | string set units
+
+      Strings are stored as UInt32 length followed by the characters, sets and lists as UInt32 size followed by the strings.
+    */
+    const char SNAPSHOT_MAGIC[8] = {'O', 'M', 'S', 'C', 'V', 'B', 'I', 'N'};
+    const UInt32 SNAPSHOT_VERSION = 1;
+    const UInt32 SNAPSHOT_BYTE_ORDER_MARK = 0x01020304;
+
+    /// Modification time of @p filename in ms since epoch
+    qint64 modificationTime(const String& filename)
+    {
+      return QFileInfo(filename.toQString()).lastModified().toMSecsSinceEpoch();
+    }
+
+    /// Serializes the snapshot into a memory buffer
+    struct SnapshotWriter
+    {
+      std::string buffer;
+
+      template <typename T>
+      void put(T value)
+      {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+      }
+
+      void putString(const std::string& s)
+      {
+        put<UInt32>(UInt32(s.size()));
+        buffer.append(s);
+      }
+
+      template <typename Container>
+      void putStrings(const Container& strings)
+      {
+        put<UInt32>(UInt32(strings.size()));
+        for (const String& s : strings)
+        {
+          putString(s);
+        }
+      }
+    };
+
+    /// Bounds checked reading from the snapshot; throws Exception::ParseError if the data ends early
+    struct SnapshotReader
+    {
+      const char* data;
+      Size size;
+      Size pos;
+
+      void require(Size n) const
+      {
+        if (n > size - pos)
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "", "Truncated CV snapshot");
+        }
+      }
+
+      template <typename T>
+      T get()
+      {
+        require(sizeof(T));
+        T value;
+        memcpy(&value, data + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+      }
+
+      String getString()
+      {
+        const Size length = get<UInt32>();
+        require(length);
+        String s(data + pos, length);
+        pos += length;
+        return s;
+      }
+
+      void getStrings(std::set<String>& strings)
+      {
+        strings.clear();
+        for (UInt32 n = get<UInt32>(); n > 0; --n)
+        {
+          strings.insert(strings.end(), getString()); // stored in sorted order
+        }
+      }
+
+      void getStrings(StringList& strings)
+      {
+        const UInt32 n = get<UInt32>();
+        strings.clear();
+        strings.reserve(std::min<Size>(n, size - pos));
+        for (UInt32 i = 0; i < n; ++i)
+        {
+          strings.push_back(getString());
+        }
+      }
+    };
+  }
 
   ControlledVocabulary::CVTerm::CVTerm() :
     name(),
@@ -507,6 +627,156 @@ namespace OpenMS
     }
   }
 
+  void ControlledVocabulary::storeSnapshot(const String& snapshot_file, const StringList& sources) const
+  {
+    SnapshotWriter w;
+    w.buffer.append(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    w.put<UInt32>(SNAPSHOT_VERSION);
+    w.put<UInt32>(SNAPSHOT_BYTE_ORDER_MARK);
+    w.put<UInt32>(UInt32(sources.size()));
+    for (const String& source : sources)
+    {
+      w.putString(source);
+      w.put<UInt64>(File::fileSize(source));
+      w.put<Int64>(modificationTime(source));
+    }
+    w.putString(name_);
+    w.putString(label_);
+    w.putString(version_);
+    w.putString(url_);
+    w.put<UInt64>(terms_.size());
+    for (const auto& [id, term] : terms_)
+    {
+      w.putString(term.name);
+      w.putString(id);
+      w.putStrings(term.parents);
+      w.putStrings(term.children);
+      w.put<UInt8>(term.obsolete ? 1 : 0);
+      w.putString(term.description);
+      w.putStrings(term.synonyms);
+      w.putStrings(term.unparsed);
+      w.put<UInt32>(UInt32(term.xref_type));
+      w.putStrings(term.xref_binary);
+      w.putStrings(term.units);
+    }
+    w.put<UInt64>(namesToIds_.size());
+    for (const auto& [name, id] : namesToIds_)
+    {
+      w.putString(name);
+      w.putString(id);
+    }
+
+    ofstream os(snapshot_file.c_str(), ios::binary);
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, snapshot_file);
+    }
+    os.write(w.buffer.data(), w.buffer.size());
+    os.close();
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, snapshot_file);
+    }
+  }
+
+  bool ControlledVocabulary::loadSnapshot(const String& snapshot_file, const StringList& sources)
+  {
+    QFile file(snapshot_file.toQString());
+    if (!file.open(QIODevice::ReadOnly))
+    {
+      return false;
+    }
+    const qint64 file_size = file.size();
+    std::string buffer;
+    const char* data = file_size > 0 ? reinterpret_cast<const char*>(file.map(0, file_size)) : nullptr;
+    if (data == nullptr)
+    {
+      // e.g. address space exhaustion on 32 bit systems: read the file instead
+      file.close();
+      ifstream ifs(snapshot_file.c_str(), ios::binary);
+      buffer.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+      data = buffer.data();
+    }
+
+    ControlledVocabulary cv;
+    try
+    {
+      SnapshotReader r{data, Size(file_size), 0};
+      r.require(sizeof(SNAPSHOT_MAGIC));
+      if (memcmp(data, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0)
+      {
+        return false;
+      }
+      r.pos = sizeof(SNAPSHOT_MAGIC);
+      if (r.get<UInt32>() != SNAPSHOT_VERSION || r.get<UInt32>() != SNAPSHOT_BYTE_ORDER_MARK)
+      {
+        return false;
+      }
+      // outdated?
+      if (r.get<UInt32>() != sources.size())
+      {
+        return false;
+      }
+      for (const String& source : sources)
+      {
+        if (r.getString() != source || !File::exists(source) ||
+            r.get<UInt64>() != File::fileSize(source) ||
+            r.get<Int64>() != modificationTime(source))
+        {
+          return false;
+        }
+      }
+
+      cv.name_ = r.getString();
+      cv.label_ = r.getString();
+      cv.version_ = r.getString();
+      cv.url_ = r.getString();
+      for (UInt64 n = r.get<UInt64>(); n > 0; --n)
+      {
+        CVTerm term;
+        term.name = r.getString();
+        term.id = r.getString();
+        r.getStrings(term.parents);
+        r.getStrings(term.children);
+        term.obsolete = r.get<UInt8>() != 0;
+        term.description = r.getString();
+        r.getStrings(term.synonyms);
+        r.getStrings(term.unparsed);
+        const UInt32 xref_type = r.get<UInt32>();
+        if (xref_type > CVTerm::NONE)
+        {
+          return false;
+        }
+        term.xref_type = CVTerm::XRefType(xref_type);
+        r.getStrings(term.xref_binary);
+        r.getStrings(term.units);
+        String id = term.id;
+        cv.terms_.emplace_hint(cv.terms_.end(), std::move(id), std::move(term)); // stored in sorted order
+      }
+      for (UInt64 n = r.get<UInt64>(); n > 0; --n)
+      {
+        String name = r.getString();
+        cv.namesToIds_.emplace_hint(cv.namesToIds_.end(), std::move(name), r.getString());
+      }
+      if (r.pos != r.size)
+      {
+        return false;
+      }
+    }
+    catch (Exception::ParseError&)
+    {
+      return false;
+    }
+
+    terms_.swap(cv.terms_);
+    namesToIds_.swap(cv.namesToIds_);
+    name_.swap(cv.name_);
+    label_.swap(cv.label_);
+    version_.swap(cv.version_);
+    url_.swap(cv.url_);
+    return true;
+  }
+
   const ControlledVocabulary::CVTerm& ControlledVocabulary::getTerm(const String& id) const
   {
     std::map<String, CVTerm>::const_iterator it = terms_.find(id);
@@ -636,12 +906,39 @@ namespace OpenMS
   const ControlledVocabulary& ControlledVocabulary::getPSIMSCV()
   {
     static const ControlledVocabulary cv = []() {
+      const StringList names = {"MS", "PATO", "UO", "BTO", "GO"};
+      const StringList sources = {File::find("/CV/psi-ms.obo"), File::find("/CV/quality.obo"), File::find("/CV/unit.obo"),
+                                  File::find("/CV/brenda.obo"), File::find("/CV/goslim_goa.obo")};
+
+      // one snapshot per set of OBO files (e.g. for several installations)
+      const String snapshot = File::getCacheDirectory() + "psi-ms_" +
+        String(Size(std::hash<std::string>()(ListUtils::concatenate(sources, "\n")))) + ".cvbin";
       ControlledVocabulary cv;
-      cv.loadFromOBO("MS", File::find("/CV/psi-ms.obo"));
-      cv.loadFromOBO("PATO", File::find("/CV/quality.obo"));
-      cv.loadFromOBO("UO", File::find("/CV/unit.obo"));
-      cv.loadFromOBO("BTO", File::find("/CV/brenda.obo"));
-      cv.loadFromOBO("GO", File::find("/CV/goslim_goa.obo"));
+      if (cv.loadSnapshot(snapshot, sources))
+      {
+        return cv;
+      }
+      for (Size i = 0; i < sources.size(); ++i)
+      {
+        cv.loadFromOBO(names[i], sources[i]);
+      }
+
+      // write to a unique file first, so concurrent processes never read a partial snapshot
+      const String tmp_snapshot = snapshot + "." + File::getUniqueName(false);
+      try
+      {
+        File::makeDir(File::path(snapshot));
+        cv.storeSnapshot(tmp_snapshot, sources);
+        if (!File::rename(tmp_snapshot, snapshot, true, false))
+        {
+          File::remove(tmp_snapshot);
+        }
+      }
+      catch (Exception::UnableToCreateFile&)
+      {
+        OPENMS_LOG_DEBUG << "Could not write CV snapshot '" << snapshot << "', the OBO files will be parsed again next time." << std::endl;
+        File::remove(tmp_snapshot);
+      }
       return cv;
     }();
     return cv;
@@ -0,0 +1,86 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/DATAACCESS/ConsensusXMLWritingConsumer.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+
+namespace OpenMS
+{
+
+  ConsensusXMLWritingConsumer::ConsensusXMLWritingConsumer(const String& filename) :
+    Internal::ConsensusXMLHandler(static_cast<const ConsensusMap&>(meta_), filename),
+    started_writing_(false),
+    features_written_(0)
+  {
+    // open file in binary mode to avoid any line ending conversions
+    ofs_.open(filename.c_str(), std::ios::out | std::ios::binary);
+    if (!ofs_)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    ofs_.precision(writtenDigits(double()));
+  }
+
+  ConsensusXMLWritingConsumer::~ConsensusXMLWritingConsumer()
+  {
+    startWriting_(); // an empty map is still a valid file
+    ofs_ << "\t</consensusElementList>\n";
+    ofs_ << "</consensusXML>\n";
+    ofs_.close();
+  }
+
+  void ConsensusXMLWritingConsumer::setExpectedSize(Size /* expected_features */)
+  {
+  }
+
+  void ConsensusXMLWritingConsumer::setMapMetaData(const ConsensusMap& map)
+  {
+    if (started_writing_)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Cannot set meta data after writing consensus features.");
+    }
+    // copy everything but the consensus features
+    meta_ = ConsensusMap();
+    meta_.DocumentIdentifier::operator=(map);
+    meta_.UniqueIdInterface::operator=(map);
+    meta_.MetaInfoInterface::operator=(map);
+    meta_.setColumnHeaders(map.getColumnHeaders());
+    meta_.setExperimentType(map.getExperimentType());
+    meta_.setProteinIdentifications(map.getProteinIdentifications());
+    meta_.setUnassignedPeptideIdentifications(map.getUnassignedPeptideIdentifications());
+    meta_.setDataProcessing(map.getDataProcessing());
+  }
+
+  void ConsensusXMLWritingConsumer::consumeConsensusFeature(ConsensusFeature& f)
+  {
+    startWriting_();
+    f.ensureUniqueId();
+    writeConsensusElement_(ofs_, f);
+    ++features_written_;
+  }
+
+  Size ConsensusXMLWritingConsumer::getNrFeaturesWritten() const
+  {
+    return features_written_;
+  }
+
+  void ConsensusXMLWritingConsumer::startWriting_()
+  {
+    if (started_writing_)
+    {
+      return;
+    }
+    // also fills the id maps needed to write the peptide identifications of the consensus features
+    writeHeader_(ofs_, meta_);
+    ofs_ << "\t<consensusElementList>\n";
+    started_writing_ = true;
+  }
+
+} // namespace OpenMS
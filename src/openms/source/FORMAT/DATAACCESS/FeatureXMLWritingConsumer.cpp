@@ -0,0 +1,86 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/DATAACCESS/FeatureXMLWritingConsumer.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+
+namespace OpenMS
+{
+
+  FeatureXMLWritingConsumer::FeatureXMLWritingConsumer(const String& filename) :
+    Internal::FeatureXMLHandler(static_cast<const FeatureMap&>(meta_), filename),
+    started_writing_(false),
+    features_written_(0),
+    features_expected_(0)
+  {
+    // open file in binary mode to avoid any line ending conversions
+    ofs_.open(filename.c_str(), std::ios::out | std::ios::binary);
+    if (!ofs_)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    ofs_.precision(writtenDigits(double()));
+  }
+
+  FeatureXMLWritingConsumer::~FeatureXMLWritingConsumer()
+  {
+    startWriting_(); // an empty map is still a valid file
+    ofs_ << "\t</featureList>\n";
+    ofs_ << "</featureMap>\n";
+    ofs_.close();
+  }
+
+  void FeatureXMLWritingConsumer::setExpectedSize(Size expected_features)
+  {
+    features_expected_ = expected_features;
+  }
+
+  void FeatureXMLWritingConsumer::setMapMetaData(const FeatureMap& map)
+  {
+    if (started_writing_)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Cannot set meta data after writing features.");
+    }
+    // copy everything but the features
+    meta_ = FeatureMap();
+    meta_.DocumentIdentifier::operator=(map);
+    meta_.UniqueIdInterface::operator=(map);
+    meta_.MetaInfoInterface::operator=(map);
+    meta_.setProteinIdentifications(map.getProteinIdentifications());
+    meta_.setUnassignedPeptideIdentifications(map.getUnassignedPeptideIdentifications());
+    meta_.setDataProcessing(map.getDataProcessing());
+  }
+
+  void FeatureXMLWritingConsumer::consumeFeature(Feature& f)
+  {
+    startWriting_();
+    f.ensureUniqueId();
+    writeFeature_(file_, ofs_, f, "f_", f.getUniqueId(), 0);
+    ++features_written_;
+  }
+
+  Size FeatureXMLWritingConsumer::getNrFeaturesWritten() const
+  {
+    return features_written_;
+  }
+
+  void FeatureXMLWritingConsumer::startWriting_()
+  {
+    if (started_writing_)
+    {
+      return;
+    }
+    // also fills the id maps needed to write the peptide identifications of the features
+    writeHeader_(ofs_, meta_);
+    ofs_ << "\t<featureList count=\"" << features_expected_ << "\">\n";
+    started_writing_ = true;
+  }
+
+} // namespace OpenMS
@@ -0,0 +1,106 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataBlockMergingConsumer.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace OpenMS
+{
+
+  MSDataBlockMergingConsumer::MSDataBlockMergingConsumer(Interfaces::IMSDataConsumer* next_consumer, const SpectraMerger& merger) :
+    next_consumer_(next_consumer),
+    merger_(merger)
+  {
+    const Param& param = merger_.getParameters();
+    ms_levels_ = param.getValue("block_method:ms_levels");
+    if ((Int)param.getValue("block_method:rt_block_size") < 1)
+    {
+      throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "The parameter 'block_method:rt_block_size' must be greater than 0.");
+    }
+    rt_block_size_ = (UInt)param.getValue("block_method:rt_block_size");
+    rt_max_length_ = param.getValue("block_method:rt_max_length");
+    if (rt_max_length_ == 0) // no rt restriction set?
+    {
+      rt_max_length_ = (std::numeric_limits<double>::max)(); // set max rt span to very large value
+    }
+  }
+
+  MSDataBlockMergingConsumer::~MSDataBlockMergingConsumer()
+  {
+    flush();
+  }
+
+  void MSDataBlockMergingConsumer::consumeSpectrum(SpectrumType& s)
+  {
+    const UInt ms_level = s.getMSLevel();
+    if (std::find(ms_levels_.begin(), ms_levels_.end(), (Int)ms_level) == ms_levels_.end())
+    {
+      next_consumer_->consumeSpectrum(s);
+      return;
+    }
+
+    auto it = blocks_.find(ms_level);
+    if (it == blocks_.end())
+    {
+      it = blocks_.emplace(ms_level, Block_()).first;
+      it->second.size_count = rt_block_size_ + 1; // the first spectrum starts a new block
+    }
+    Block_& block = it->second;
+
+    // block full if it contains a maximum number of scans or if maximum rt length spanned
+    if (++block.size_count >= rt_block_size_ ||
+        s.getRT() - block.spectra.front().getRT() > rt_max_length_)
+    {
+      finishBlock_(block, ms_level, false);
+      block.size_count = 0;
+    }
+    block.spectra.push_back(s);
+  }
+
+  void MSDataBlockMergingConsumer::consumeChromatogram(ChromatogramType& c)
+  {
+    next_consumer_->consumeChromatogram(c);
+  }
+
+  void MSDataBlockMergingConsumer::setExperimentalSettings(const OpenMS::ExperimentalSettings& exp)
+  {
+    next_consumer_->setExperimentalSettings(exp);
+  }
+
+  void MSDataBlockMergingConsumer::flush()
+  {
+    for (auto& level_block : blocks_)
+    {
+      finishBlock_(level_block.second, level_block.first, true);
+    }
+    blocks_.clear();
+  }
+
+  void MSDataBlockMergingConsumer::finishBlock_(Block_& block, const UInt ms_level, const bool last)
+  {
+    if (block.spectra.empty()) return;
+
+    if (block.spectra.size() == 1 && !last)
+    {
+      // single spectra remain untouched
+      next_consumer_->consumeSpectrum(block.spectra.front());
+    }
+    else
+    {
+      MSSpectrum consensus_spec = merger_.mergeBlock(block.spectra, ms_level);
+      if (!consensus_spec.empty())
+      {
+        next_consumer_->consumeSpectrum(consensus_spec);
+      }
+    }
+    block.spectra.clear();
+  }
+
+} // namespace OpenMS
@@ -15,13 +15,14 @@
 
 namespace OpenMS
 {
-  MSDataCachedConsumer::MSDataCachedConsumer(const String& filename, bool clearData) :
+  MSDataCachedConsumer::MSDataCachedConsumer(const String& filename, bool clearData, bool compress) :
     ofs_(filename.c_str(), std::ios::binary),
     clearData_(clearData),
+    compress_(compress),
     spectra_written_(0),
     chromatograms_written_(0)
   {
-    int file_identifier = CACHED_MZML_FILE_IDENTIFIER;
+    int file_identifier = compress_ ? CACHED_MZML_ZLIB_FILE_IDENTIFIER : CACHED_MZML_FILE_IDENTIFIER;
     ofs_.write((char*)&file_identifier, sizeof(file_identifier));
   }
 
@@ -44,7 +45,14 @@ namespace OpenMS
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
         "Cannot write spectra after writing chromatograms.");
     }
-    writeSpectrum_(s, ofs_);
+    if (compress_)
+    {
+      writeCompressedSpectrum_(s, ofs_);
+    }
+    else
+    {
+      writeSpectrum_(s, ofs_);
+    }
     spectra_written_++;
 
     // Clear all spectral data including all float/int data arrays (but not string arrays)
@@ -61,7 +69,14 @@ namespace OpenMS
 
   void MSDataCachedConsumer::consumeChromatogram(ChromatogramType & c)
   {
-    writeChromatogram_(c, ofs_);
+    if (compress_)
+    {
+      writeCompressedChromatogram_(c, ofs_);
+    }
+    else
+    {
+      writeChromatogram_(c, ofs_);
+    }
     chromatograms_written_++;
 
     // Clear all chromatogram data including all float/int data arrays (but not string arrays)
@@ -0,0 +1,57 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataIMBinningConsumer.h>
+
+#include <OpenMS/IONMOBILITY/IMDataConverter.h>
+
+namespace OpenMS
+{
+
+  MSDataIMBinningConsumer::MSDataIMBinningConsumer(const std::vector<Interfaces::IMSDataConsumer*>& bin_consumers,
+                                                   const Math::BinContainer& bins,
+                                                   double mz_binning_width,
+                                                   MZ_UNITS mz_binning_width_unit) :
+    bin_consumers_(bin_consumers),
+    bins_(bins)
+  {
+    if (bin_consumers_.size() != bins_.size())
+    {
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Need one consumer per IM bin.", String(bin_consumers_.size()));
+    }
+    auto p = merger_.getParameters();
+    p.setValue("mz_binning_width", mz_binning_width);
+    p.setValue("mz_binning_width_unit", String(MZ_UNIT_NAMES[(int)mz_binning_width_unit]));
+    merger_.setParameters(p);
+  }
+
+  void MSDataIMBinningConsumer::consumeSpectrum(SpectrumType& s)
+  {
+    if (! s.containsIMData())
+    {
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Spectrum does not contain 'wide' IM data.", s.getNativeID());
+    }
+    std::vector<MSSpectrum> binned = IMDataConverter::binIMFrame(s, bins_, merger_);
+    for (Size i = 0; i < bins_.size(); ++i)
+    {
+      if (! binned[i].empty())
+      {
+        bin_consumers_[i]->consumeSpectrum(binned[i]);
+      }
+    }
+  }
+
+  void MSDataIMBinningConsumer::setExperimentalSettings(const OpenMS::ExperimentalSettings& exp)
+  {
+    for (Interfaces::IMSDataConsumer* consumer : bin_consumers_)
+    {
+      consumer->setExperimentalSettings(exp);
+    }
+  }
+
+} // namespace OpenMS
@@ -12,6 +12,29 @@
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// Appends the meta data of @p in to @p buffer and moves its peaks and data arrays there (no copy)
+    template <typename ContainerT>
+    void moveToBuffer(ContainerT& in, std::vector<ContainerT>& buffer)
+    {
+      typename ContainerT::ContainerType peaks;
+      in.swap(peaks);
+      auto fda = std::move(in.getFloatDataArrays());
+      auto sda = std::move(in.getStringDataArrays());
+      auto ida = std::move(in.getIntegerDataArrays());
+      in.getFloatDataArrays().clear();
+      in.getStringDataArrays().clear();
+      in.getIntegerDataArrays().clear();
+
+      buffer.push_back(in); // only meta data
+      buffer.back().swap(peaks);
+      buffer.back().getFloatDataArrays() = std::move(fda);
+      buffer.back().getStringDataArrays() = std::move(sda);
+      buffer.back().getIntegerDataArrays() = std::move(ida);
+      in.clear(false);
+    }
+  }
 
   MSDataSqlConsumer::MSDataSqlConsumer(const String& filename, UInt64 run_id, int flush_after, bool full_meta, bool lossy_compression, double linear_mass_acc) :
         filename_(filename),
@@ -56,8 +79,7 @@ namespace OpenMS
 
   void MSDataSqlConsumer::consumeSpectrum(SpectrumType & s)
   {
-    spectra_.push_back(s);
-    s.clear(false);
+    moveToBuffer(s, spectra_);
     if (full_meta_)
     {
       peak_meta_.addSpectrum(s);
@@ -70,8 +92,7 @@ namespace OpenMS
 
   void MSDataSqlConsumer::consumeChromatogram(ChromatogramType & c)
   {
-    chromatograms_.push_back(c);
-    c.clear(false);
+    moveToBuffer(c, chromatograms_);
     if (full_meta_)
     {
       peak_meta_.addChromatogram(c);
@@ -8,7 +8,247 @@
 
 #include <OpenMS/FORMAT/DATAACCESS/SwathFileConsumer.h>
 
+#include <utility>
+
 namespace OpenMS
 {
 
+  StreamingSwathFileConsumer::StreamingSwathFileConsumer(std::vector<OpenSwath::SwathMap> known_window_boundaries,
+      const String& cachedir, const String& basename, const std::vector<int>& nr_ms2_spectra,
+      Size memory_budget, WindowCallback window_ready) :
+    FullSwathFileConsumer(known_window_boundaries),
+    cachedir_(cachedir),
+    basename_(basename),
+    nr_ms2_spectra_(nr_ms2_spectra),
+    memory_budget_(memory_budget),
+    window_ready_(std::move(window_ready)),
+    memory_used_(0),
+    clock_(0)
+  {}
+
+  StreamingSwathFileConsumer::~StreamingSwathFileConsumer()
+  {
+    closeCaches_();
+  }
+
+  Size StreamingSwathFileConsumer::getMemoryUsage() const
+  {
+    return memory_used_;
+  }
+
+  Size StreamingSwathFileConsumer::getNrSpilledMaps() const
+  {
+    Size nr_spilled = ms1_buffer_.spilled ? 1 : 0;
+    for (const MapBuffer_& buffer : swath_buffers_)
+    {
+      if (buffer.spilled) ++nr_spilled;
+    }
+    return nr_spilled;
+  }
+
+  Size StreamingSwathFileConsumer::estimateMemory_(const SpectrumType& s)
+  {
+    Size bytes = sizeof(SpectrumType) + s.size() * sizeof(SpectrumType::PeakType);
+    for (const auto& arr : s.getFloatDataArrays())
+    {
+      bytes += arr.size() * sizeof(float);
+    }
+    for (const auto& arr : s.getIntegerDataArrays())
+    {
+      bytes += arr.size() * sizeof(Int);
+    }
+    return bytes;
+  }
+
+  void StreamingSwathFileConsumer::consumeSwathSpectrum_(MapType::SpectrumType& s, size_t swath_nr)
+  {
+    while (swath_maps_.size() <= swath_nr)
+    {
+      boost::shared_ptr<PeakMap > exp(new PeakMap(settings_));
+      swath_maps_.push_back(exp);
+      swath_buffers_.push_back(MapBuffer_());
+    }
+    if (swath_buffers_[swath_nr].complete)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        String("Received more spectra than expected for SWATH window ") + swath_nr + " which was already processed.");
+    }
+
+    addSpectrum_(s, swath_buffers_[swath_nr], swath_maps_[swath_nr]);
+    if (swath_nr < nr_ms2_spectra_.size() &&
+        swath_buffers_[swath_nr].nr_spectra == static_cast<Size>(nr_ms2_spectra_[swath_nr]))
+    {
+      completeWindow_(swath_nr);
+    }
+    enforceBudget_();
+  }
+
+  void StreamingSwathFileConsumer::consumeMS1Spectrum_(MapType::SpectrumType& s)
+  {
+    if (!ms1_map_)
+    {
+      boost::shared_ptr<PeakMap > exp(new PeakMap(settings_));
+      ms1_map_ = exp;
+    }
+    addSpectrum_(s, ms1_buffer_, ms1_map_);
+    enforceBudget_();
+  }
+
+  void StreamingSwathFileConsumer::ensureMapsAreFilled_()
+  {
+    if (ms1_map_ && ms1_buffer_.spilled)
+    {
+      finishCache_(ms1_buffer_, ms1_map_, ms1File_());
+    }
+    for (Size i = 0; i < swath_buffers_.size(); ++i)
+    {
+      if (!swath_buffers_[i].complete)
+      {
+        completeWindow_(i);
+      }
+    }
+  }
+
+  void StreamingSwathFileConsumer::addSpectrum_(MapType::SpectrumType& s, MapBuffer_& buffer, boost::shared_ptr<PeakMap>& map)
+  {
+    if (buffer.spilled)
+    {
+      buffer.cache->consumeSpectrum(s); // write data to cached file; clear data from spectrum s
+      map->addSpectrum(s); // append for the metadata (actual data was deleted)
+    }
+    else
+    {
+      Size bytes = estimateMemory_(s);
+      map->addSpectrum(s);
+      buffer.bytes += bytes;
+      memory_used_ += bytes;
+    }
+    buffer.nr_spectra++;
+    buffer.last_used = ++clock_;
+  }
+
+  void StreamingSwathFileConsumer::completeWindow_(Size swath_nr)
+  {
+    MapBuffer_& buffer = swath_buffers_[swath_nr];
+    if (buffer.spilled)
+    {
+      finishCache_(buffer, swath_maps_[swath_nr], windowFile_(swath_nr));
+    }
+    buffer.complete = true;
+    buffer.last_used = ++clock_;
+
+    if (window_ready_)
+    {
+      OpenSwath::SwathMap map;
+      map.sptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(swath_maps_[swath_nr]);
+      map.lower = swath_map_boundaries_[swath_nr].lower;
+      map.upper = swath_map_boundaries_[swath_nr].upper;
+      map.center = swath_map_boundaries_[swath_nr].center;
+      map.imLower = swath_map_boundaries_[swath_nr].imLower;
+      map.imUpper = swath_map_boundaries_[swath_nr].imUpper;
+      map.ms1 = false;
+      window_ready_(map);
+    }
+  }
+
+  void StreamingSwathFileConsumer::spill_(MapBuffer_& buffer, boost::shared_ptr<PeakMap>& map, const String& meta_file)
+  {
+    OPENMS_LOG_DEBUG << "Spilling " << buffer.nr_spectra << " spectra (" << buffer.bytes << " bytes) to " << meta_file << ".cached" << std::endl;
+
+    buffer.cache = new MSDataCachedConsumer(meta_file + ".cached", true);
+
+    // the in-memory map may already be in use (handed to the callback): write copies of the spectra
+    boost::shared_ptr<PeakMap > exp(new PeakMap(settings_));
+    for (const SpectrumType& spectrum : map->getSpectra())
+    {
+      SpectrumType s = spectrum;
+      buffer.cache->consumeSpectrum(s);
+      exp->addSpectrum(s);
+    }
+    map = exp;
+
+    memory_used_ -= buffer.bytes;
+    buffer.bytes = 0;
+    buffer.spilled = true;
+
+    // no more spectra will arrive for a complete map
+    if (buffer.complete)
+    {
+      finishCache_(buffer, map, meta_file);
+    }
+  }
+
+  void StreamingSwathFileConsumer::finishCache_(MapBuffer_& buffer, boost::shared_ptr<PeakMap>& map, const String& meta_file)
+  {
+    if (buffer.cache == nullptr)
+    {
+      return;
+    }
+
+    // Properly delete the MSDataCachedConsumer -> _close_ file stream before reading
+    delete buffer.cache;
+    buffer.cache = nullptr;
+
+    boost::shared_ptr<PeakMap > exp(new PeakMap);
+    // write metadata to disk and store the correct data processing tag
+    Internal::CachedMzMLHandler().writeMetadata(*map, meta_file, true);
+    FileHandler().loadExperiment(meta_file, *exp.get(), {FileTypes::MZML});
+    map = exp;
+  }
+
+  void StreamingSwathFileConsumer::enforceBudget_()
+  {
+    while (memory_budget_ > 0 && memory_used_ > memory_budget_)
+    {
+      // coldest in-memory window, preferring complete windows over incomplete ones
+      Size coldest = swath_buffers_.size();
+      for (Size i = 0; i < swath_buffers_.size(); ++i)
+      {
+        const MapBuffer_& buffer = swath_buffers_[i];
+        if (buffer.spilled || buffer.bytes == 0) continue;
+        if (coldest == swath_buffers_.size() ||
+            std::make_pair(!buffer.complete, buffer.last_used) <
+            std::make_pair(!swath_buffers_[coldest].complete, swath_buffers_[coldest].last_used))
+        {
+          coldest = i;
+        }
+      }
+
+      if (coldest < swath_buffers_.size())
+      {
+        spill_(swath_buffers_[coldest], swath_maps_[coldest], windowFile_(coldest));
+      }
+      else if (ms1_map_ && !ms1_buffer_.spilled && ms1_buffer_.bytes > 0)
+      {
+        spill_(ms1_buffer_, ms1_map_, ms1File_());
+      }
+      else
+      {
+        break; // nothing left to spill
+      }
+    }
+  }
+
+  String StreamingSwathFileConsumer::windowFile_(Size swath_nr) const
+  {
+    return cachedir_ + basename_ + "_" + String(swath_nr) + ".mzML";
+  }
+
+  String StreamingSwathFileConsumer::ms1File_() const
+  {
+    return cachedir_ + basename_ + "_ms1.mzML";
+  }
+
+  void StreamingSwathFileConsumer::closeCaches_()
+  {
+    // Properly delete the MSDataCachedConsumer -> free memory and _close_ file stream
+    for (MapBuffer_& buffer : swath_buffers_)
+    {
+      delete buffer.cache;
+      buffer.cache = nullptr;
+    }
+    delete ms1_buffer_.cache;
+    ms1_buffer_.cache = nullptr;
+  }
+
 } // namespace OpenMS
@@ -5,9 +5,13 @@ set(directory source/FORMAT/DATAACCESS)
 set(sources_list
   MSDataWritingConsumer.cpp
   MSDataTransformingConsumer.cpp
+  ConsensusXMLWritingConsumer.cpp
+  FeatureXMLWritingConsumer.cpp
   MSDataAggregatingConsumer.cpp
+  MSDataBlockMergingConsumer.cpp
   MSDataCachedConsumer.cpp
   MSDataChainingConsumer.cpp
+  MSDataIMBinningConsumer.cpp
   MSDataStoringConsumer.cpp
   MSDataSqlConsumer.cpp
   MSDataTransformingConsumer.cpp
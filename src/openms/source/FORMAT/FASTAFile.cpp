@@ -14,11 +14,147 @@
 
 #include <OpenMS/CONCEPT/LogStream.h>
 
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+
+#include <algorithm>
+#include <cstring>
 
 namespace OpenMS
 {
   using namespace std;
 
+  namespace
+  {
+    const char* const INDEX_HEADER = "#OpenMS FASTA index";
+    const char* const INDEX_VERSION = "1";
+
+    /// Read-only view of the bytes [offset, offset + length) of a file (up to its end if @p length is negative): memory mapped if possible, read into memory otherwise
+    struct FileRange
+    {
+      FileRange(const String& filename, Int64 offset, Int64 length)
+      {
+        file.setFileName(filename.toQString());
+        if (!file.open(QIODevice::ReadOnly))
+        {
+          throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+        }
+        if (length < 0)
+        {
+          length = file.size() - offset;
+        }
+        if (offset < 0 || offset + length > file.size())
+        {
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename,
+                                      "The FASTA file is smaller than its index. Was it modified after indexing?");
+        }
+        size = Size(length);
+        if (length == 0)
+        {
+          return;
+        }
+        const uchar* mapped = file.map(offset, length);
+        if (mapped != nullptr)
+        {
+          data = reinterpret_cast<const char*>(mapped);
+          return;
+        }
+        // e.g. address space exhaustion on 32 bit systems: read the range instead
+        file.close();
+        ifstream ifs(filename.c_str(), ios::binary);
+        ifs.seekg(offset);
+        buffer.resize(size);
+        ifs.read(&buffer[0], length);
+        data = buffer.data();
+      }
+
+      QFile file;
+      std::string buffer;
+      const char* data = nullptr;
+      Size size = 0;
+    };
+
+    /// Modification time of @p filename in ms since epoch
+    qint64 modificationTime(const String& filename)
+    {
+      return QFileInfo(filename.toQString()).lastModified().toMSecsSinceEpoch();
+    }
+
+    /**
+      @brief Parses the entry in [p, end), which must not contain the start of another entry (see FASTAFile::buildIndex())
+
+      Same rules as FASTAFile::readEntry_().
+    */
+    bool parseEntry(const char* p, const char* end, std::string& id, std::string& description, std::string& seq)
+    {
+      if (p == end || *p++ != '>')
+      {
+        return false; // was in wrong position for reading ID
+      }
+      bool description_exists = true;
+      for (;; ++p) // reading the ID
+      {
+        if (p == end)
+        {
+          return false;
+        }
+        const char c = *p;
+        if (c == ' ' || c == '\t')
+        {
+          if (!id.empty())
+          {
+            ++p;
+            break; // ID finished
+          }
+        }
+        else if (c == '\n') // ID finished and no description available
+        {
+          ++p;
+          description_exists = false;
+          break;
+        }
+        else if (c != '\r')
+        {
+          id += c;
+        }
+      }
+      if (id.empty())
+      {
+        return false;
+      }
+
+      while (description_exists) // reading the description
+      {
+        if (p == end)
+        {
+          return false;
+        }
+        const char c = *p++;
+        if (c == '\n')
+        {
+          break;
+        }
+        if (c != '\r' && c != '\t')
+        {
+          description += c;
+        }
+      }
+
+      // reading the sequence (up to the end of the entry), not saving white spaces
+      seq.reserve(end - p);
+      for (; p != end; ++p)
+      {
+        const char c = *p;
+        if (c != '\n' && c != '\r' && c != ' ' && c != '\t')
+        {
+          seq += c;
+        }
+      }
+      return !seq.empty();
+    }
+  }
+
   bool FASTAFile::readEntry_(std::string& id, std::string& description, std::string& seq)
   {
     std::streambuf* sb = infile_.rdbuf();
@@ -226,16 +362,188 @@ namespace OpenMS
   {
     startProgress(0, 1, "Loading FASTA file");
     data.clear();
-    FASTAEntry p;
-    FASTAFile f;
-    f.readStart(filename);
-    while (f.readNext(p))
+    const std::vector<Int64> offsets = buildIndex(filename);
+    if (offsets.size() < 2)
     {
-      data.push_back(std::move(p));
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename,
+                                  "Error while parsing FASTA file! The first entry could not be read! Please check the file!");
     }
+    readEntries(filename, offsets, 0, offsets.size() - 1, data);
     endProgress();
   }
 
+  std::vector<Int64> FASTAFile::buildIndex(const String& filename)
+  {
+    if (!File::exists(filename))
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    if (!File::readable(filename))
+    {
+      throw Exception::FileNotReadable(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    const FileRange file(filename, 0, -1);
+    const char* const begin = file.data;
+    const char* const end = begin + file.size;
+    const char* p = begin;
+    while (p != end && *p == '#') // Skip the header of PEFF files (http://www.psidev.info/peff)
+    {
+      const char* newline = static_cast<const char*>(memchr(p, '\n', end - p));
+      p = newline == nullptr ? end : newline + 1;
+    }
+
+    std::vector<Int64> offsets;
+    if (p != end)
+    {
+      // the first entry starts here, even if there is no '>' (reading it will fail, as with readNext())
+      offsets.push_back(p - begin);
+      while ((p = static_cast<const char*>(memchr(p, '\n', end - p))) != nullptr)
+      {
+        ++p;
+        if (p != end && *p == '>')
+        {
+          offsets.push_back(p - begin);
+        }
+      }
+    }
+    offsets.push_back(file.size);
+    return offsets;
+  }
+
+  void FASTAFile::storeIndex(const String& index_file, const String& filename, const std::vector<Int64>& offsets)
+  {
+    ofstream os(index_file.c_str());
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, index_file);
+    }
+    os << INDEX_HEADER << '\t' << INDEX_VERSION << '\n'
+       << "data_size\t" << File::fileSize(filename) << '\n'
+       << "data_modified\t" << modificationTime(filename) << '\n';
+    for (Int64 offset : offsets)
+    {
+      os << offset << '\n';
+    }
+    os.close();
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, index_file);
+    }
+  }
+
+  bool FASTAFile::loadIndex(const String& index_file, const String& filename, std::vector<Int64>& offsets)
+  {
+    offsets.clear();
+    ifstream is(index_file.c_str());
+    if (!is || !File::exists(filename))
+    {
+      return false;
+    }
+    try
+    {
+      std::string line;
+      std::vector<String> fields;
+      auto header = [&](const char* key) -> String
+      {
+        if (!std::getline(is, line)) return "";
+        String(line).split('\t', fields);
+        if (fields.size() != 2 || fields[0] != key) return "";
+        return fields[1];
+      };
+      if (header(INDEX_HEADER) != INDEX_VERSION) return false;
+      const Int64 file_size = Int64(File::fileSize(filename));
+      if (header("data_size").toInt64() != file_size ||
+          header("data_modified").toInt64() != modificationTime(filename))
+      {
+        return false; // outdated
+      }
+      while (std::getline(is, line))
+      {
+        offsets.push_back(String(line).toInt64());
+      }
+      if (offsets.empty() || offsets.back() != file_size || !std::is_sorted(offsets.begin(), offsets.end()))
+      {
+        offsets.clear();
+        return false;
+      }
+    }
+    catch (Exception::BaseException&)
+    {
+      // conversion errors: not a valid index
+      offsets.clear();
+      return false;
+    }
+    return true;
+  }
+
+  std::vector<Int64> FASTAFile::loadOrBuildIndex(const String& filename, bool write_index)
+  {
+    std::vector<Int64> offsets;
+    const String index_file = getIndexName(filename);
+    if (loadIndex(index_file, filename, offsets))
+    {
+      return offsets;
+    }
+    offsets = buildIndex(filename);
+    if (write_index)
+    {
+      try
+      {
+        storeIndex(index_file, filename, offsets);
+      }
+      catch (Exception::UnableToCreateFile&)
+      {
+        OPENMS_LOG_DEBUG << "Could not write FASTA index file '" << index_file << "'." << std::endl;
+      }
+    }
+    return offsets;
+  }
+
+  String FASTAFile::getIndexName(const String& filename)
+  {
+    return filename + ".offsets";
+  }
+
+  void FASTAFile::readEntries(const String& filename, const std::vector<Int64>& offsets, Size begin, Size end, std::vector<FASTAEntry>& data)
+  {
+    data.clear();
+    const Size n_entries = offsets.empty() ? 0 : offsets.size() - 1;
+    if (end > n_entries)
+    {
+      throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, end, n_entries);
+    }
+    if (begin >= end)
+    {
+      return;
+    }
+
+    const Int64 range_start = offsets[begin];
+    const FileRange range(filename, range_start, offsets[end] - range_start);
+    data.resize(end - begin);
+    Size first_failed = end;
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (SignedSize i = SignedSize(begin); i < SignedSize(end); ++i)
+    {
+      FASTAEntry& entry = data[i - begin];
+      if (!parseEntry(range.data + (offsets[i] - range_start), range.data + (offsets[i + 1] - range_start),
+                      entry.identifier, entry.description, entry.sequence))
+      {
+        #pragma omp critical(FASTAFile_readEntries)
+        first_failed = std::min(first_failed, Size(i));
+      }
+    }
+
+    if (first_failed != end)
+    {
+      data.clear();
+      const String reason = first_failed == 0 ? String("The first entry could not be read!") :
+                            "Only " + String(first_failed) + " proteins could be read. Parsing next record failed.";
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename,
+                                  "Error while parsing FASTA file! " + reason + " Please check the file!");
+    }
+  }
+
   void FASTAFile::writeStart(const String &filename)
   {
     if (!FileHandler::hasValidExtension(filename, FileTypes::FASTA))
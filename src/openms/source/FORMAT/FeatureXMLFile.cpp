@@ -51,23 +51,27 @@ namespace OpenMS
     Internal::FeatureXMLHandler handler(feature_map, filename);
     handler.setOptions(options_);
     handler.setLogType(getLogType());
+    // (the handler also sets the feature FWHM from the "FWHM" meta value)
     parse_(filename, &handler);
 
-    // !!! Hack: set feature FWHM from meta info entries as
-    // long as featureXML doesn't support a width entry.
-    // See also hack in BaseFeature::setWidth().
-    for (auto& feature : feature_map)
-    {
-      if (feature.metaValueExists("FWHM"))
-      {
-        feature.setWidth((double)feature.getMetaValue("FWHM"));
-      }
-    }
-
     // put ranges into defined state
     feature_map.updateRanges();
   }
 
+  void FeatureXMLFile::transform(const String& filename, Interfaces::IFeatureDataConsumer* consumer)
+  {
+    // receives the meta data only
+    FeatureMap feature_map;
+    feature_map.setLoadedFileType(filename);
+    feature_map.setLoadedFilePath(filename);
+
+    Internal::FeatureXMLHandler handler(feature_map, filename);
+    handler.setOptions(options_);
+    handler.setFeatureConsumer(consumer);
+    handler.setLogType(getLogType());
+    parse_(filename, &handler);
+  }
+
   void FeatureXMLFile::store(const String& filename, const FeatureMap& feature_map)
   {
 
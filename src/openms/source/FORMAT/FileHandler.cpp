@@ -29,7 +29,9 @@
 #include <OpenMS/FORMAT/SqMassFile.h>
 #include <OpenMS/FORMAT/XMassFile.h>
 #include <OpenMS/FORMAT/TraMLFile.h>
+#include <OpenMS/FORMAT/IdBinFile.h>
 #include <OpenMS/FORMAT/IdXMLFile.h>
+#include <OpenMS/FORMAT/InMemoryFileStore.h>
 #include <OpenMS/FORMAT/TransformationXMLFile.h>
 #include <OpenMS/FORMAT/XQuestResultXMLFile.h>
 #include <OpenMS/METADATA/ID/IdentificationData.h>
@@ -193,6 +195,12 @@ namespace OpenMS
 
   FileTypes::Type FileHandler::getTypeByContent(const String& filename)
   {
+    // binary formats are identified by their magic number
+    if (IdBinFile::isIdBinFile(filename))
+    {
+      return FileTypes::IDBIN;
+    }
+
     String first_line;
     String two_five;
     String all_simple;
@@ -680,6 +688,11 @@ namespace OpenMS
       }
     }
 
+    if (InMemoryFileStore::load(filename, exp))
+    {
+      return;
+    }
+
     // load right file
     switch (type)
     {
@@ -822,6 +835,11 @@ namespace OpenMS
       }
     }
 
+    if (InMemoryFileStore::store(filename, exp))
+    {
+      return;
+    }
+
     // load right file
     switch (type)
     {
@@ -928,6 +946,11 @@ namespace OpenMS
       }
     }
 
+    if (InMemoryFileStore::load(filename, map))
+    {
+      return;
+    }
+
     // load right file
     switch (type)
     {
@@ -990,6 +1013,11 @@ namespace OpenMS
       }
     }
 
+    if (InMemoryFileStore::store(filename, map))
+    {
+      return;
+    }
+
     //store right file
     switch (type)
     {
@@ -1056,6 +1084,11 @@ namespace OpenMS
       }
     }
 
+    if (InMemoryFileStore::load(filename, map))
+    {
+      return;
+    }
+
     switch (type)
     {
       case FileTypes::CONSENSUSXML:
@@ -1104,6 +1137,11 @@ namespace OpenMS
         throw Exception::InvalidFileType(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "type: " + FileTypes::typeToName(type) + " is not allowed for storing an Consensus Features. Allowed types are: " + allowedToString_(allowed_types));
       }
     }
+
+    if (InMemoryFileStore::store(filename, map))
+    {
+      return;
+    }
     switch (type)
     {
       case FileTypes::CONSENSUSXML:
@@ -1167,6 +1205,14 @@ namespace OpenMS
       }
       break;
 
+      case FileTypes::IDBIN:
+      {
+        IdBinFile f;
+        f.setLogType(log);
+        f.load(filename, additional_proteins, additional_peptides);
+      }
+      break;
+
       case FileTypes::OMS:
       {
         OMSFile f;
@@ -1247,6 +1293,14 @@ namespace OpenMS
       }
       break;
 
+      case FileTypes::IDBIN:
+      {
+        IdBinFile f;
+        f.setLogType(log);
+        f.store(filename, additional_proteins, additional_peptides);
+      }
+      break;
+
       case FileTypes::OMS:
       {
         OMSFile f;
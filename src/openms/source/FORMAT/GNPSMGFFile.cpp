@@ -17,8 +17,10 @@
 #include <OpenMS/KERNEL/OnDiscMSExperiment.h>
 #include <OpenMS/KERNEL/MSSpectrum.h>
 
+#include <exception>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 
 using namespace std;
 
@@ -132,7 +134,7 @@ namespace OpenMS
    * @param feature_rt ConsensusFeature's retention time specified in input mzXML file
    */
   void writeMSMSBlockHeader_(
-    ofstream &output_file,
+    ostream &output_file,
     const String &output_type,
     const int &scan_index,
     const String &feature_id,
@@ -142,9 +144,7 @@ namespace OpenMS
     const String &feature_rt
   )
   {
-    if (output_file.is_open())
-    {
-      output_file << "BEGIN IONS" << "\n"
+    output_file << "BEGIN IONS" << "\n"
                   << "OUTPUT=" << output_type << "\n"
                   << "SCANS=" << scan_index << "\n"
                   << "FEATURE_ID=e_" << feature_id << "\n"
@@ -152,8 +152,7 @@ namespace OpenMS
                   << "CHARGE=" << to_string(feature_charge == 0 ? 1 : abs(feature_charge))+(feature_charge >= 0 ? "+" : "-") << "\n"
                   << "PEPMASS=" << feature_mz << "\n"
                   << "FILE_INDEX=" << spec_index << "\n"
-                  << "RTINSECONDS=" << feature_rt << "\n";
-    }
+                << "RTINSECONDS=" << feature_rt << "\n";
   }
 
   /**
@@ -162,20 +161,17 @@ namespace OpenMS
    * @param peaks Vector of peaks that will be outputted
    */
   void writeMSMSBlock_(
-    ofstream &output_file,
+    ostream &output_file,
     const vector<Peak1D> &peaks
   )
   {
-    if (output_file.is_open())
+    output_file << setprecision(4) << fixed;
+    for (auto& peak : peaks)
     {
-      output_file << setprecision(4) << fixed;
-      for (auto& peak : peaks)
-      {
-        output_file << peak.getMZ() << "\t" << peak.getIntensity() << "\n";
-      }
-
-      output_file << "END IONS" << "\n" << endl;
+      output_file << peak.getMZ() << "\t" << peak.getIntensity() << "\n";
     }
+
+    output_file << "END IONS" << "\n" << "\n";
   }
 
   /**
@@ -215,8 +211,7 @@ namespace OpenMS
     for (pair<int,double>& element_pair : sorted_element_maps)
     {
       int element_map = element_pair.first;
-      vector<PeptideIdentification> feature_pepts = feature.getPeptideIdentifications();
-      for (PeptideIdentification& pept_id : feature_pepts)
+      for (const PeptideIdentification& pept_id : feature.getPeptideIdentifications())
       {
         if (pept_id.metaValueExists("spectrum_index") && pept_id.metaValueExists("map_index")
             && (int)pept_id.getMetaValue("map_index") == element_map)
@@ -263,113 +258,167 @@ namespace OpenMS
     //-------------------------------------------------------------
     startProgress(0, consensus_map.size(), "parsing features and ms2 identifications...");
 
-    for (Size cons_i = 0; cons_i < consensus_map.size(); ++cons_i)
+    // the spectra of a batch of features are read sequentially (on-disc access), then merged and
+    // formatted in parallel (one text block per feature) and written in order
+    const Size batch_size = 1000;
+    for (Size batch_start = 0; batch_start < consensus_map.size(); batch_start += batch_size)
     {
-      setProgress(cons_i);
-
-      const ConsensusFeature& feature = consensus_map[cons_i];
+      const Size batch_end = std::min(consensus_map.size(), batch_start + batch_size);
+      vector<int> charges(batch_end - batch_start);
+      vector<int> best_spec_indices(charges.size());
+      vector<vector<MSSpectrum>> pept_spectra(charges.size()); // most intense spectrum first; empty: skip feature
 
-      // determine feature's charge as maximum feature handle charge
-      int charge = feature.getCharge();
-      for (auto& fh : feature)
-      { 
-        if (fh.getCharge() > charge)
-        {
-          charge = fh.getCharge();
-        }
-      }
+      for (Size cons_i = batch_start; cons_i < batch_end; ++cons_i)
+      {
+        setProgress(cons_i);
 
-      // compute most intense peptide identifications (based on precursor intensity)
-      vector<pair<int,double>> element_maps;
-      sortElementMapsByIntensity_(feature, element_maps);
-      vector<pair<int, int>> pepts;
-      getElementPeptideIdentificationsByElementIntensity_(feature, element_maps, pepts);
+        const ConsensusFeature& feature = consensus_map[cons_i];
 
-      // discard poorer precursor spectra for 'merged_spectra' and 'full_spectra' output
-      if (pept_cutoff != -1 && pepts.size() > (unsigned long) pept_cutoff)
-      {
-        pepts.erase(pepts.begin()+pept_cutoff, pepts.end());
-      }
+        // determine feature's charge as maximum feature handle charge
+        int charge = feature.getCharge();
+        for (auto& fh : feature)
+        { 
+          if (fh.getCharge() > charge)
+          {
+            charge = fh.getCharge();
+          }
+        }
+        charges[cons_i - batch_start] = charge;
 
-      // validate all peptide annotation maps have been loaded
-      for (const auto& pep : pepts)
-      {
-        int map_index = pep.first;
+        // compute most intense peptide identifications (based on precursor intensity)
+        vector<pair<int,double>> element_maps;
+        sortElementMapsByIntensity_(feature, element_maps);
+        vector<pair<int, int>> pepts;
+        getElementPeptideIdentificationsByElementIntensity_(feature, element_maps, pepts);
 
-        // open on-disc experiments
-        if (map_index2file_index.find(map_index) == map_index2file_index.end())
+        // discard poorer precursor spectra for 'merged_spectra' and 'full_spectra' output
+        if (pept_cutoff != -1 && pepts.size() > (unsigned long) pept_cutoff)
         {
-          specs_list[num_msmaps_cached].openFile(mzml_file_paths[map_index], false); // open on-disc experiment and load meta-data
-          map_index2file_index[map_index] = num_msmaps_cached;
-          ++num_msmaps_cached;
+          pepts.erase(pepts.begin()+pept_cutoff, pepts.end());
         }
-      }
 
-      // identify most intense spectrum
-      const int best_mapi = pepts[0].first;
-      const int best_speci = pepts[0].second;
-      auto best_spec = specs_list[map_index2file_index[best_mapi]][best_speci];
-
-      if (best_spec.empty()) continue; // some Bruker files have MS2 spectra without peaks. skip those during exprot
+        // validate all peptide annotation maps have been loaded
+        for (const auto& pep : pepts)
+        {
+          int map_index = pep.first;
 
-      // write block output header
-      writeMSMSBlockHeader_(
-        output_file,
-        output_type,
-        (cons_i + 1),
-        feature.getUniqueId(),
-        charge,
-        feature.getMZ(),
-        best_speci,
-        best_spec.getRT()
-      );
+          // open on-disc experiments
+          if (map_index2file_index.find(map_index) == map_index2file_index.end())
+          {
+            specs_list[num_msmaps_cached].openFile(mzml_file_paths[map_index], false); // open on-disc experiment and load meta-data
+            map_index2file_index[map_index] = num_msmaps_cached;
+            ++num_msmaps_cached;
+          }
+        }
 
-      // OPENMS_LOG_DEBUG << "Best spectrum (index/RT): " << best_speci << "\t" << best_spec.getRT() << std::endl;
+        // identify most intense spectrum
+        const int best_mapi = pepts[0].first;
+        const int best_speci = pepts[0].second;
+        MSSpectrum best_spec = specs_list[map_index2file_index[best_mapi]][best_speci];
 
-      // store outputted spectra in MSExperiment
-      MSExperiment exp;
+        if (best_spec.empty()) continue; // some Bruker files have MS2 spectra without peaks. skip those during exprot
 
-      // add most intense spectrum to MSExperiment
-      exp.addSpectrum(best_spec);
+        best_spec_indices[cons_i - batch_start] = best_speci;
+        vector<MSSpectrum>& spectra = pept_spectra[cons_i - batch_start];
+        spectra.push_back(std::move(best_spec));
+        if (output_type == "merged_spectra")
+        {
+          for (pair<int,int> &pept : pepts)
+          {
+            spectra.push_back(specs_list[map_index2file_index[pept.first]][pept.second]);
+          }
+        }
+      }
 
-      if (output_type == "merged_spectra")
+      vector<String> blocks(charges.size());
+      std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)blocks.size(); ++i)
       {
-        // merge spectra that meet cosine similarity threshold to most intense spectrum
-        BinnedSpectrum binned_highest_int(best_spec, bin_width, false, 1, BinnedSpectrum::DEFAULT_BIN_OFFSET_HIRES);
-
-        // Retain peptide annotations that do not meet user-specified cosine similarity threshold
-        for (pair<int,int> &pept : pepts)
+        try
         {
-          int map_index = pept.first;
-          int spec_index = pept.second;
-          auto test_spec = specs_list[map_index2file_index[map_index]][spec_index];
+          const vector<MSSpectrum>& spectra = pept_spectra[i];
+          if (spectra.empty()) continue;
+
+          const Size cons_i = batch_start + i;
+          const ConsensusFeature& feature = consensus_map[cons_i];
+          const MSSpectrum& best_spec = spectra[0];
+
+          // write block output header
+          std::ostringstream block;
+          writeMSMSBlockHeader_(
+            block,
+            output_type,
+            (cons_i + 1),
+            feature.getUniqueId(),
+            charges[i],
+            feature.getMZ(),
+            best_spec_indices[i],
+            best_spec.getRT()
+          );
+
+          // OPENMS_LOG_DEBUG << "Best spectrum (index/RT): " << best_spec_indices[i] << "\t" << best_spec.getRT() << std::endl;
+
+          // store outputted spectra in MSExperiment
+          MSExperiment exp;
+
+          // add most intense spectrum to MSExperiment
+          exp.addSpectrum(best_spec);
+
+          if (output_type == "merged_spectra")
+          {
+            // merge spectra that meet cosine similarity threshold to most intense spectrum
+            BinnedSpectrum binned_highest_int(best_spec, bin_width, false, 1, BinnedSpectrum::DEFAULT_BIN_OFFSET_HIRES);
 
-          BinnedSpectrum binned_spectrum(test_spec, bin_width, false, 1, BinnedSpectrum::DEFAULT_BIN_OFFSET_HIRES);
+            // Retain peptide annotations that do not meet user-specified cosine similarity threshold
+            for (Size k = 1; k < spectra.size(); ++k)
+            {
+              const MSSpectrum& test_spec = spectra[k];
 
-          BinnedSpectralContrastAngle bsca;
-          double cos_sim = bsca(binned_highest_int, binned_spectrum);
+              BinnedSpectrum binned_spectrum(test_spec, bin_width, false, 1, BinnedSpectrum::DEFAULT_BIN_OFFSET_HIRES);
 
-          if (cos_sim >= cos_sim_threshold)
-          {
-            exp.addSpectrum(test_spec);
+              BinnedSpectralContrastAngle bsca;
+              double cos_sim = bsca(binned_highest_int, binned_spectrum);
+
+              if (cos_sim >= cos_sim_threshold)
+              {
+                exp.addSpectrum(test_spec);
+              }
+            }
           }
+
+          // store outputted peaks in vector<Peak1D>
+          vector<Peak1D> peaks;
+          flattenAndBinSpectra_(
+            exp,
+            bin_width,
+            peaks
+          );
+
+          // write peaks to output block
+          writeMSMSBlock_(
+            block,
+            peaks
+          );
+          blocks[i] = block.str();
+        }
+        catch (...)
+        {
+#pragma omp critical (GNPSMGFFile_store)
+          if (!error) error = std::current_exception();
         }
       }
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
 
-      // store outputted peaks in vector<Peak1D>
-      vector<Peak1D> peaks;
-      flattenAndBinSpectra_(
-        exp,
-        bin_width,
-        peaks
-      );
-
-      // write peaks to output block
-      writeMSMSBlock_(
-        output_file,
-        peaks
-      );
+      for (const String& block : blocks)
+      {
+        output_file << block;
+      }
     }
+    endProgress();
 
     output_file.close();
   }
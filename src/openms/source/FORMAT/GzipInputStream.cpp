@@ -18,28 +18,35 @@ namespace OpenMS
   GzipInputStream::GzipInputStream(const String & file_name) :
     gzip_(new GzipIfstream(file_name.c_str())), file_current_index_(0)
   {
+    startReading_();
   }
 
   GzipInputStream::GzipInputStream(const char * file_name) :
     gzip_(new GzipIfstream(file_name)), file_current_index_(0)
   {
+    startReading_();
   }
 
   GzipInputStream::~GzipInputStream()
   {
+    read_ahead_.reset(); // stop decompressing before the stream is deleted
     delete gzip_;
   }
 
-  XMLSize_t GzipInputStream::readBytes(XMLByte * const to_fill, const XMLSize_t max_to_read)
+  void GzipInputStream::startReading_()
   {
-    // Figure out whether we can really read.
-    if (gzip_->streamEnd())
+    GzipIfstream* stream = gzip_;
+    read_ahead_ = std::make_unique<ReadAheadBuffer>([stream](char* s, size_t n, bool& end)
     {
-      return 0;
-    }
+      size_t count = stream->streamEnd() ? 0 : stream->read(s, n);
+      end = stream->streamEnd() || count == 0;
+      return count;
+    });
+  }
 
-    unsigned char * fill_it = static_cast<unsigned char *>(to_fill);
-    XMLSize_t actual_read = (XMLSize_t) gzip_->read((char *)fill_it, static_cast<size_t>(max_to_read));
+  XMLSize_t GzipInputStream::readBytes(XMLByte * const to_fill, const XMLSize_t max_to_read)
+  {
+    XMLSize_t actual_read = (XMLSize_t) read_ahead_->read((char *)to_fill, static_cast<size_t>(max_to_read));
     file_current_index_ += actual_read;
     return actual_read;
   }
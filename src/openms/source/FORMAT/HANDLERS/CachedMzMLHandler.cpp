@@ -10,9 +10,31 @@
 
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/FORMAT/ZlibCompression.h>
+
+#include <cstring>
+#include <sstream>
 
 namespace OpenMS::Internal
 {
+  namespace
+  {
+    /// copy @p bytes from the buffer at @p pos into @p dest and advance @p pos (bounds checked against @p end)
+    void copyFromBuffer_(const char*& pos, const char* end, void* dest, Size bytes)
+    {
+      if (static_cast<Size>(end - pos) < bytes)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Cached data item extends past the end of the file, something is wrong here. Aborting.", "memory buffer");
+      }
+      if (bytes > 0)
+      {
+        std::memcpy(dest, pos, bytes);
+      }
+      pos += bytes;
+    }
+  }
+
   CachedMzMLHandler::CachedMzMLHandler() = default;
 
   CachedMzMLHandler::~CachedMzMLHandler() = default;
@@ -25,29 +47,44 @@ namespace OpenMS::Internal
     }
     spectra_index_ = rhs.spectra_index_;
     chrom_index_ = rhs.chrom_index_;
+    compressed_ = rhs.compressed_;
 
     return *this;
   }
 
-  void CachedMzMLHandler::writeMemdump(const MapType& exp, const String& out) const
+  void CachedMzMLHandler::writeMemdump(const MapType& exp, const String& out, bool compress) const
   {
     std::ofstream ofs(out.c_str(), std::ios::binary);
     Size exp_size = exp.size();
     Size chrom_size = exp.getChromatograms().size();
-    int file_identifier = CACHED_MZML_FILE_IDENTIFIER;
+    int file_identifier = compress ? CACHED_MZML_ZLIB_FILE_IDENTIFIER : CACHED_MZML_FILE_IDENTIFIER;
     ofs.write((char*)&file_identifier, sizeof(file_identifier));
 
     startProgress(0, exp.size() + exp.getChromatograms().size(), "storing binary data");
     for (Size i = 0; i < exp.size(); i++)
     {
       setProgress(i);
-      writeSpectrum_(exp[i], ofs);
+      if (compress)
+      {
+        writeCompressedSpectrum_(exp[i], ofs);
+      }
+      else
+      {
+        writeSpectrum_(exp[i], ofs);
+      }
     }
 
     for (Size i = 0; i < exp.getChromatograms().size(); i++)
     {
       setProgress(i);
-      writeChromatogram_(exp.getChromatograms()[i], ofs);
+      if (compress)
+      {
+        writeCompressedChromatogram_(exp.getChromatograms()[i], ofs);
+      }
+      else
+      {
+        writeChromatogram_(exp.getChromatograms()[i], ofs);
+      }
     }
 
     ofs.write((char*)&exp_size, sizeof(exp_size));
@@ -68,11 +105,13 @@ namespace OpenMS::Internal
 
     int file_identifier;
     ifs.read((char*)&file_identifier, sizeof(file_identifier));
-    if (file_identifier != CACHED_MZML_FILE_IDENTIFIER)
+    if (file_identifier != CACHED_MZML_FILE_IDENTIFIER && file_identifier != CACHED_MZML_ZLIB_FILE_IDENTIFIER)
     {
       throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
         "File might not be a cached mzML file (wrong file magic number). Aborting!", filename);
     }
+    const bool compressed = (file_identifier == CACHED_MZML_ZLIB_FILE_IDENTIFIER);
+    std::string record;
 
     ifs.seekg(0, ifs.end); // set file pointer to end
     ifs.seekg(ifs.tellg(), ifs.beg); // set file pointer to end, in forward direction
@@ -87,7 +126,15 @@ namespace OpenMS::Internal
     {
       setProgress(i);
       SpectrumType spectrum;
-      readSpectrum(spectrum, ifs);
+      if (compressed)
+      {
+        uncompressRecord(ifs, record);
+        readSpectrum(spectrum, record.data(), record.size());
+      }
+      else
+      {
+        readSpectrum(spectrum, ifs);
+      }
       exp_reading.addSpectrum(spectrum);
     }
     std::vector<ChromatogramType> chromatograms;
@@ -95,7 +142,15 @@ namespace OpenMS::Internal
     {
       setProgress(i);
       ChromatogramType chromatogram;
-      readChromatogram(chromatogram, ifs);
+      if (compressed)
+      {
+        uncompressRecord(ifs, record);
+        readChromatogram(chromatogram, record.data(), record.size());
+      }
+      else
+      {
+        readChromatogram(chromatogram, ifs);
+      }
       chromatograms.push_back(chromatogram);
     }
     exp_reading.setChromatograms(chromatograms);
@@ -114,6 +169,11 @@ namespace OpenMS::Internal
     return chrom_index_;
   }
 
+  bool CachedMzMLHandler::isCompressed() const
+  {
+    return compressed_;
+  }
+
   void CachedMzMLHandler::createMemdumpIndex(const String& filename)
   {
     std::ifstream ifs(filename.c_str(), std::ios::binary);
@@ -132,11 +192,12 @@ namespace OpenMS::Internal
     int chrom_offset = 0;
 
     ifs.read((char*)&file_identifier, sizeof(file_identifier));
-    if (file_identifier != CACHED_MZML_FILE_IDENTIFIER)
+    if (file_identifier != CACHED_MZML_FILE_IDENTIFIER && file_identifier != CACHED_MZML_ZLIB_FILE_IDENTIFIER)
     {
       throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
           "File might not be a cached mzML file (wrong file magic number). Aborting!", filename);
     }
+    compressed_ = (file_identifier == CACHED_MZML_ZLIB_FILE_IDENTIFIER);
 
     // For spectra and chromatograms go through file, read the size of the
     // spectrum/chromatogram and record the starting index of the element, then
@@ -150,6 +211,31 @@ namespace OpenMS::Internal
     ifs.seekg(sizeof(file_identifier), ifs.beg); // set file pointer to beginning (after identifier), start reading
 
     startProgress(0, exp_size + chrom_size, "Creating index for binary spectra");
+    if (compressed_)
+    {
+      // compressed records carry their own size, the index only needs to hop from header to header
+      for (Size i = 0; i < exp_size + chrom_size; i++)
+      {
+        setProgress(i);
+
+        Size raw_size, compressed_size;
+        if (i < exp_size)
+        {
+          spectra_index_.push_back(ifs.tellg());
+        }
+        else
+        {
+          chrom_index_.push_back(ifs.tellg());
+        }
+        ifs.read((char*)&raw_size, sizeof(raw_size));
+        ifs.read((char*)&compressed_size, sizeof(compressed_size));
+        ifs.seekg(compressed_size, ifs.cur);
+      }
+      ifs.close();
+      endProgress();
+      return;
+    }
+
     for (Size i = 0; i < exp_size; i++)
     {
       setProgress(i);
@@ -349,6 +435,128 @@ namespace OpenMS::Internal
     return;
   }
 
+  void CachedMzMLHandler::readDataFast_(const char*& pos,
+                                        const char* end,
+                                        std::vector<OpenSwath::BinaryDataArrayPtr>& data,
+                                        const Size& data_size,
+                                        const Size& nr_float_arrays)
+  {
+    OPENMS_PRECONDITION(data.size() == 2, "Input data needs to have 2 slots.")
+
+    // check before resizing so a corrupt length cannot trigger a huge allocation
+    if (static_cast<Size>(end - pos) / (2 * sizeof(DatumSingleton)) < data_size)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Cached data item extends past the end of the file, something is wrong here. Aborting.", "memory buffer");
+    }
+    data[0]->data.resize(data_size);
+    data[1]->data.resize(data_size);
+    copyFromBuffer_(pos, end, data[0]->data.data(), data_size * sizeof(DatumSingleton));
+    copyFromBuffer_(pos, end, data[1]->data.data(), data_size * sizeof(DatumSingleton));
+
+    for (Size k = 0; k < nr_float_arrays; k++)
+    {
+      data.push_back(OpenSwath::BinaryDataArrayPtr(new OpenSwath::BinaryDataArray));
+      Size len, len_name;
+      copyFromBuffer_(pos, end, &len, sizeof(len));
+      copyFromBuffer_(pos, end, &len_name, sizeof(len_name));
+      if (static_cast<Size>(end - pos) < len_name)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Cached data item extends past the end of the file, something is wrong here. Aborting.", "memory buffer");
+      }
+      data.back()->description.assign(pos, len_name);
+      pos += len_name;
+      if (static_cast<Size>(end - pos) / sizeof(DatumSingleton) < len)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Cached data item extends past the end of the file, something is wrong here. Aborting.", "memory buffer");
+      }
+      data.back()->data.resize(len);
+      copyFromBuffer_(pos, end, data.back()->data.data(), len * sizeof(DatumSingleton));
+    }
+  }
+
+  std::vector<OpenSwath::BinaryDataArrayPtr> CachedMzMLHandler::readSpectrumFast(const char* buffer, Size buffer_size, int& ms_level, double& rt)
+  {
+    std::vector<OpenSwath::BinaryDataArrayPtr> data;
+    data.push_back(OpenSwath::BinaryDataArrayPtr(new OpenSwath::BinaryDataArray));
+    data.push_back(OpenSwath::BinaryDataArrayPtr(new OpenSwath::BinaryDataArray));
+
+    const char* pos = buffer;
+    const char* end = buffer + buffer_size;
+    Size spec_size, nr_float_arrays;
+    copyFromBuffer_(pos, end, &spec_size, sizeof(spec_size));
+    copyFromBuffer_(pos, end, &nr_float_arrays, sizeof(nr_float_arrays));
+    copyFromBuffer_(pos, end, &ms_level, sizeof(ms_level));
+    copyFromBuffer_(pos, end, &rt, sizeof(rt));
+
+    readDataFast_(pos, end, data, spec_size, nr_float_arrays);
+    return data;
+  }
+
+  std::vector<OpenSwath::BinaryDataArrayPtr> CachedMzMLHandler::readChromatogramFast(const char* buffer, Size buffer_size)
+  {
+    std::vector<OpenSwath::BinaryDataArrayPtr> data;
+    data.push_back(OpenSwath::BinaryDataArrayPtr(new OpenSwath::BinaryDataArray));
+    data.push_back(OpenSwath::BinaryDataArrayPtr(new OpenSwath::BinaryDataArray));
+
+    const char* pos = buffer;
+    const char* end = buffer + buffer_size;
+    Size chrom_size, nr_float_arrays;
+    copyFromBuffer_(pos, end, &chrom_size, sizeof(chrom_size));
+    copyFromBuffer_(pos, end, &nr_float_arrays, sizeof(nr_float_arrays));
+
+    readDataFast_(pos, end, data, chrom_size, nr_float_arrays);
+    return data;
+  }
+
+  void CachedMzMLHandler::uncompressRecord(const char* buffer, Size buffer_size, std::string& record)
+  {
+    const char* pos = buffer;
+    const char* end = buffer + buffer_size;
+    Size raw_size, compressed_size;
+    copyFromBuffer_(pos, end, &raw_size, sizeof(raw_size));
+    copyFromBuffer_(pos, end, &compressed_size, sizeof(compressed_size));
+    if (static_cast<Size>(end - pos) < compressed_size)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Cached data item extends past the end of the file, something is wrong here. Aborting.", "memory buffer");
+    }
+
+    record.resize(raw_size);
+    try
+    {
+      ZlibCompression::uncompressData(pos, compressed_size, &record[0], raw_size);
+    }
+    catch (Exception::ConversionError&)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Could not decompress cached data item, something is wrong here. Aborting.", "memory buffer");
+    }
+  }
+
+  void CachedMzMLHandler::uncompressRecord(std::ifstream& ifs, std::string& record)
+  {
+    Size sizes[2] = {0, 0};
+    ifs.read((char*)sizes, sizeof(sizes));
+    if (!ifs)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Could not read cached data item header, something is wrong here. Aborting.", "filestream");
+    }
+
+    std::string compressed(sizeof(sizes) + sizes[1], '\0');
+    std::memcpy(&compressed[0], sizes, sizeof(sizes));
+    ifs.read(&compressed[sizeof(sizes)], sizes[1]);
+    if (!ifs)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Read an incomplete compressed data item, something is wrong here. Aborting.", "filestream");
+    }
+    uncompressRecord(compressed.data(), compressed.size(), record);
+  }
+
   std::vector<OpenSwath::BinaryDataArrayPtr> CachedMzMLHandler::readChromatogramFast(std::ifstream& ifs)
   {
     std::vector<OpenSwath::BinaryDataArrayPtr> data;
@@ -375,6 +583,31 @@ namespace OpenMS::Internal
     int ms_level;
     double rt;
     std::vector<OpenSwath::BinaryDataArrayPtr> data = readSpectrumFast(ifs, ms_level, rt);
+    fillSpectrum_(spectrum, data, ms_level, rt);
+  }
+
+  void CachedMzMLHandler::readSpectrum(SpectrumType& spectrum, const char* buffer, Size buffer_size)
+  {
+    int ms_level;
+    double rt;
+    std::vector<OpenSwath::BinaryDataArrayPtr> data = readSpectrumFast(buffer, buffer_size, ms_level, rt);
+    fillSpectrum_(spectrum, data, ms_level, rt);
+  }
+
+  void CachedMzMLHandler::readChromatogram(ChromatogramType& chromatogram, std::ifstream& ifs)
+  {
+    std::vector<OpenSwath::BinaryDataArrayPtr> data = readChromatogramFast(ifs);
+    fillChromatogram_(chromatogram, data);
+  }
+
+  void CachedMzMLHandler::readChromatogram(ChromatogramType& chromatogram, const char* buffer, Size buffer_size)
+  {
+    std::vector<OpenSwath::BinaryDataArrayPtr> data = readChromatogramFast(buffer, buffer_size);
+    fillChromatogram_(chromatogram, data);
+  }
+
+  void CachedMzMLHandler::fillSpectrum_(SpectrumType& spectrum, const std::vector<OpenSwath::BinaryDataArrayPtr>& data, int ms_level, double rt)
+  {
     spectrum.reserve(data[0]->data.size());
     spectrum.setMSLevel(ms_level);
     spectrum.setRT(rt);
@@ -396,9 +629,8 @@ namespace OpenMS::Internal
     }
   }
 
-  void CachedMzMLHandler::readChromatogram(ChromatogramType& chromatogram, std::ifstream& ifs)
+  void CachedMzMLHandler::fillChromatogram_(ChromatogramType& chromatogram, const std::vector<OpenSwath::BinaryDataArrayPtr>& data)
   {
-    std::vector<OpenSwath::BinaryDataArrayPtr> data = readChromatogramFast(ifs);
     chromatogram.reserve(data[0]->data.size());
 
     for (Size j = 0; j < data[0]->data.size(); j++)
@@ -414,14 +646,14 @@ namespace OpenMS::Internal
     {
       MSChromatogram::FloatDataArray fda;
       fda.reserve(data[j]->data.size());
-      for (const auto& k : fda) fda.push_back(k);
+      for (const auto& k : data[j]->data) fda.push_back(k);
       fda.setName(data[j]->description);
       fdas.push_back(fda);
     }
     chromatogram.setFloatDataArrays(fdas);
   }
 
-  void CachedMzMLHandler::writeSpectrum_(const SpectrumType& spectrum, std::ofstream& ofs) const
+  void CachedMzMLHandler::writeSpectrum_(const SpectrumType& spectrum, std::ostream& ofs) const
   {
     Size exp_size = spectrum.size();
     ofs.write((char*)&exp_size, sizeof(exp_size));
@@ -481,7 +713,7 @@ namespace OpenMS::Internal
     }
   }
 
-  void CachedMzMLHandler::writeChromatogram_(const ChromatogramType& chromatogram, std::ofstream& ofs) const
+  void CachedMzMLHandler::writeChromatogram_(const ChromatogramType& chromatogram, std::ostream& ofs) const
   {
     Size exp_size = chromatogram.size();
     ofs.write((char*)&exp_size, sizeof(exp_size));
@@ -542,5 +774,29 @@ namespace OpenMS::Internal
     }
   }
 
-}//namespace OpenMS  //namespace Internal
+  void CachedMzMLHandler::writeCompressedSpectrum_(const SpectrumType& spectrum, std::ostream& ofs) const
+  {
+    std::ostringstream record;
+    writeSpectrum_(spectrum, record);
+    writeCompressedRecord_(record.str(), ofs);
+  }
 
+  void CachedMzMLHandler::writeCompressedChromatogram_(const ChromatogramType& chromatogram, std::ostream& ofs) const
+  {
+    std::ostringstream record;
+    writeChromatogram_(chromatogram, record);
+    writeCompressedRecord_(record.str(), ofs);
+  }
+
+  void CachedMzMLHandler::writeCompressedRecord_(const std::string& record, std::ostream& ofs)
+  {
+    std::string compressed;
+    ZlibCompression::compressData(record.data(), record.size(), compressed);
+    Size raw_size = record.size();
+    Size compressed_size = compressed.size();
+    ofs.write((char*)&raw_size, sizeof(raw_size));
+    ofs.write((char*)&compressed_size, sizeof(compressed_size));
+    ofs.write(compressed.data(), compressed_size);
+  }
+
+}//namespace OpenMS  //namespace Internal
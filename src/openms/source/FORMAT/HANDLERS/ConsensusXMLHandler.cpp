@@ -12,6 +12,7 @@
 #include <OpenMS/CHEMISTRY/ProteaseDB.h>
 #include <OpenMS/CONCEPT/UniqueIdGenerator.h>
 #include <OpenMS/FORMAT/IdXMLFile.h>
+#include <OpenMS/INTERFACES/IConsensusDataConsumer.h>
 #include <OpenMS/METADATA/DataProcessing.h>
 #include <OpenMS/SYSTEM/File.h>
 
@@ -26,6 +27,7 @@ namespace OpenMS::Internal
     XMLHandler("", "1.7"),
     ProgressLogger(),
     act_cons_element_(),
+    consumer_(nullptr),
     last_meta_(nullptr)
   {
     consensus_map_ = &map;
@@ -36,6 +38,7 @@ namespace OpenMS::Internal
     XMLHandler("", "1.7"),
     ProgressLogger(),
     act_cons_element_(),
+    consumer_(nullptr),
     last_meta_(nullptr)
   {
     cconsensus_map_ = &map;
@@ -59,6 +62,11 @@ namespace OpenMS::Internal
     return options_;
   }
 
+  void ConsensusXMLHandler::setConsensusConsumer(Interfaces::IConsensusDataConsumer* consumer)
+  {
+    consumer_ = consumer;
+  }
+
   void ConsensusXMLHandler::endElement(const XMLCh* const /*uri*/, const XMLCh* const /*local_name*/, const XMLCh* const qname)
   {
     String tag = sm_.convert(qname);
@@ -69,7 +77,14 @@ namespace OpenMS::Internal
       if ((!options_.hasRTRange() || options_.getRTRange().encloses(act_cons_element_.getRT())) && (!options_.hasMZRange() || options_.getMZRange().encloses(
                                                                                                       act_cons_element_.getMZ())) && (!options_.hasIntensityRange() || options_.getIntensityRange().encloses(act_cons_element_.getIntensity())))
       {
-        consensus_map_->push_back(act_cons_element_);
+        if (consumer_ != nullptr)
+        {
+          consumer_->consumeConsensusFeature(act_cons_element_);
+        }
+        else
+        {
+          consensus_map_->push_back(act_cons_element_);
+        }
         act_cons_element_.getPeptideIdentifications().clear();
       }
       last_meta_ = nullptr;
@@ -137,7 +152,15 @@ namespace OpenMS::Internal
     const String& tag = open_tags_.back();
 
     String tmp_str;
-    if (tag == "map")
+    if (tag == "consensusElementList")
+    {
+      // everything before the consensus element list is meta data
+      if (consumer_ != nullptr)
+      {
+        consumer_->setMapMetaData(*consensus_map_);
+      }
+    }
+    else if (tag == "map")
     {
       setProgress(++progress_);
       Size last_map = attributeAsInt_(attributes, "id");
@@ -481,7 +504,7 @@ namespace OpenMS::Internal
       peptide_evidences_ = vector<PeptideEvidence>();
       pep_hit_.setCharge(attributeAsInt_(attributes, "charge"));
       pep_hit_.setScore(attributeAsDouble_(attributes, "score"));
-      pep_hit_.setSequence(AASequence::fromString(String(attributeAsString_(attributes, "sequence"))));
+      pep_hit_.setSequence(sequence_cache_.fromString(String(attributeAsString_(attributes, "sequence"))));
 
       //parse optional protein ids to determine accessions
       const XMLCh* refs = attributes.getValue(sm_.convert("protein_refs").c_str());
@@ -606,6 +629,27 @@ namespace OpenMS::Internal
     progress_ = 0;
     setProgress(++progress_);
 
+    writeHeader_(os, consensus_map);
+
+    // write all consensus elements
+    os << "\t<consensusElementList>\n";
+    for (Size i = 0; i < consensus_map.size(); ++i)
+    {
+      setProgress(++progress_);
+      writeConsensusElement_(os, consensus_map[i]);
+    }
+    os << "\t</consensusElementList>\n";
+
+    os << "</consensusXML>\n";
+
+    //Clear members
+    identifier_id_.clear();
+    accession_to_id_.clear();
+    endProgress();
+  }
+
+  void ConsensusXMLHandler::writeHeader_(std::ostream& os, const ConsensusMap& consensus_map)
+  {
     setProgress(++progress_);
     os << "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?>\n";
     os << "<?xml-stylesheet type=\"text/xsl\" href=\"https://www.openms.de/xml-stylesheet/ConsensusXML.xsl\" ?>\n";
@@ -772,58 +816,45 @@ namespace OpenMS::Internal
       os << "\t\t</map>\n";
     }
     os << "\t</mapList>\n";
+  }
 
-    // write all consensus elements
-    os << "\t<consensusElementList>\n";
-    for (Size i = 0; i < consensus_map.size(); ++i)
+  void ConsensusXMLHandler::writeConsensusElement_(std::ostream& os, const ConsensusFeature& elem)
+  {
+    os << "\t\t<consensusElement id=\"e_" << elem.getUniqueId() << "\" quality=\"" << precisionWrapper(elem.getQuality()) << "\"";
+    if (elem.getCharge() != 0)
     {
-      setProgress(++progress_);
-      // write a consensusElement
-      const ConsensusFeature& elem = consensus_map[i];
-      os << "\t\t<consensusElement id=\"e_" << elem.getUniqueId() << "\" quality=\"" << precisionWrapper(elem.getQuality()) << "\"";
-      if (elem.getCharge() != 0)
-      {
-        os << " charge=\"" << elem.getCharge() << "\"";
-      }
-      os << ">\n";
-      // write centroid
-      os << "\t\t\t<centroid rt=\"" << precisionWrapper(elem.getRT()) << "\" mz=\"" << precisionWrapper(elem.getMZ()) << "\" it=\"" << precisionWrapper(
-        elem.getIntensity()) << "\"/>\n";
-      // write groupedElementList
-      os << "\t\t\t<groupedElementList>\n";
-      for (ConsensusFeature::HandleSetType::const_iterator it = elem.begin(); it != elem.end(); ++it)
-      {
-        os << "\t\t\t\t<element"
-              " map=\"" << it->getMapIndex() << "\""
-                                                " id=\"" << it->getUniqueId() << "\""
-                                                                                 " rt=\"" << precisionWrapper(it->getRT()) << "\""
-                                                                                                                              " mz=\"" << precisionWrapper(it->getMZ()) << "\""
-                                                                                                                                                                           " it=\"" << precisionWrapper(it->getIntensity()) << "\"";
-        if (it->getCharge() != 0)
-        {
-          os << " charge=\"" << it->getCharge() << "\"";
-        }
-        os << "/>\n";
-      }
-      os << "\t\t\t</groupedElementList>\n";
-
-      // write PeptideIdentification
-      for (UInt j = 0; j < elem.getPeptideIdentifications().size(); ++j)
+      os << " charge=\"" << elem.getCharge() << "\"";
+    }
+    os << ">\n";
+    // write centroid
+    os << "\t\t\t<centroid rt=\"" << precisionWrapper(elem.getRT()) << "\" mz=\"" << precisionWrapper(elem.getMZ()) << "\" it=\"" << precisionWrapper(
+      elem.getIntensity()) << "\"/>\n";
+    // write groupedElementList
+    os << "\t\t\t<groupedElementList>\n";
+    for (ConsensusFeature::HandleSetType::const_iterator it = elem.begin(); it != elem.end(); ++it)
+    {
+      os << "\t\t\t\t<element"
+            " map=\"" << it->getMapIndex() << "\""
+                                              " id=\"" << it->getUniqueId() << "\""
+                                                                               " rt=\"" << precisionWrapper(it->getRT()) << "\""
+                                                                                                                            " mz=\"" << precisionWrapper(it->getMZ()) << "\""
+                                                                                                                                                                         " it=\"" << precisionWrapper(it->getIntensity()) << "\"";
+      if (it->getCharge() != 0)
       {
-        writePeptideIdentification_(file_, os, elem.getPeptideIdentifications()[j], "PeptideIdentification", 3);
+        os << " charge=\"" << it->getCharge() << "\"";
       }
-
-      writeUserParam_("UserParam", os, elem, 3);
-      os << "\t\t</consensusElement>\n";
+      os << "/>\n";
     }
-    os << "\t</consensusElementList>\n";
+    os << "\t\t\t</groupedElementList>\n";
 
-    os << "</consensusXML>\n";
+    // write PeptideIdentification
+    for (UInt j = 0; j < elem.getPeptideIdentifications().size(); ++j)
+    {
+      writePeptideIdentification_(file_, os, elem.getPeptideIdentifications()[j], "PeptideIdentification", 3);
+    }
 
-    //Clear members
-    identifier_id_.clear();
-    accession_to_id_.clear();
-    endProgress();
+    writeUserParam_("UserParam", os, elem, 3);
+    os << "\t\t</consensusElement>\n";
   }
 
   void ConsensusXMLHandler::writePeptideIdentification_(const String& filename, std::ostream& os, const PeptideIdentification& id, const String& tag_name,
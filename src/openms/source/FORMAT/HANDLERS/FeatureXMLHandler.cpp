@@ -12,6 +12,7 @@
 #include <OpenMS/CONCEPT/UniqueIdGenerator.h>
 #include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/IdXMLFile.h>
+#include <OpenMS/INTERFACES/IFeatureDataConsumer.h>
 #include <OpenMS/KERNEL/FeatureMap.h>
 #include <OpenMS/METADATA/DataProcessing.h>
 
@@ -47,6 +48,7 @@ namespace OpenMS::Internal
     //options_ = FeatureFileOptions(); do NOT reset this, since we need to preserve options!
     size_only_ = false;
     expected_size_ = 0;
+    consumer_ = nullptr;
     param_ = Param();
     current_chull_ = ConvexHull2D::PointArrayType();
     hull_position_ = DPosition<2>();
@@ -58,6 +60,7 @@ namespace OpenMS::Internal
     pep_id_ = PeptideIdentification();
     prot_hit_ = ProteinHit();
     pep_hit_ = PeptideHit();
+    sequence_cache_.clear();
     proteinid_to_accession_.clear();
     accession_to_id_.clear();
     identifier_id_.clear();
@@ -70,6 +73,29 @@ namespace OpenMS::Internal
   {
     const FeatureMap& feature_map = *(cmap_);
 
+    writeHeader_(os, feature_map);
+
+    // write features with their corresponding attributes
+    os << "\t<featureList count=\"" << feature_map.size() << "\">\n";
+    startProgress(0, feature_map.size(), "Storing featureXML file");
+    for (Size s = 0; s < feature_map.size(); s++)
+    {
+      writeFeature_(file_, os, feature_map[s], "f_", feature_map[s].getUniqueId(), 0);
+      setProgress(s);
+      // writeFeature_(file_, os, feature_map[s], "f_", s, 0);
+    }
+    endProgress();
+
+    os << "\t</featureList>\n";
+    os << "</featureMap>\n";
+
+    //Clear members
+    accession_to_id_.clear();
+    identifier_id_.clear();
+  }
+
+  void FeatureXMLHandler::writeHeader_(std::ostream& os, const FeatureMap& feature_map)
+  {
     os << "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?>\n"
        << "<featureMap version=\"" << version_ << "\"";
     // file id
@@ -202,24 +228,6 @@ namespace OpenMS::Internal
     {
       writePeptideIdentification_(file_, os, feature_map.getUnassignedPeptideIdentifications()[i], "UnassignedPeptideIdentification", 1);
     }
-
-    // write features with their corresponding attributes
-    os << "\t<featureList count=\"" << feature_map.size() << "\">\n";
-    startProgress(0, feature_map.size(), "Storing featureXML file");
-    for (Size s = 0; s < feature_map.size(); s++)
-    {
-      writeFeature_(file_, os, feature_map[s], "f_", feature_map[s].getUniqueId(), 0);
-      setProgress(s);
-      // writeFeature_(file_, os, feature_map[s], "f_", s, 0);
-    }
-    endProgress();
-
-    os << "\t</featureList>\n";
-    os << "</featureMap>\n";
-
-    //Clear members
-    accession_to_id_.clear();
-    identifier_id_.clear();
   }
 
   FeatureFileOptions& FeatureXMLHandler::getOptions()
@@ -308,7 +316,16 @@ namespace OpenMS::Internal
         expected_size_ = count;
         throw EndParsingSoftly(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
       }
-      map_->reserve(std::min(Size(1e5), count)); // reserve vector for faster push_back, but with upper boundary of 1e5 (as >1e5 is most likely an invalid feature count)
+      if (consumer_ != nullptr)
+      {
+        // everything before the feature list is meta data
+        consumer_->setExpectedSize(count);
+        consumer_->setMapMetaData(*map_);
+      }
+      else
+      {
+        map_->reserve(std::min(Size(1e5), count)); // reserve vector for faster push_back, but with upper boundary of 1e5 (as >1e5 is most likely an invalid feature count)
+      }
       startProgress(0, count, "Loading featureXML file");
     }
     else if (tag == "quality" || tag == "hposition" || tag == "position")
@@ -595,7 +612,7 @@ namespace OpenMS::Internal
 
       pep_hit_.setCharge(attributeAsInt_(attributes, "charge"));
       pep_hit_.setScore(attributeAsDouble_(attributes, "score"));
-      pep_hit_.setSequence(AASequence::fromString(String(attributeAsString_(attributes, "sequence"))));
+      pep_hit_.setSequence(sequence_cache_.fromString(String(attributeAsString_(attributes, "sequence"))));
 
       //parse optional protein ids to determine accessions
       const XMLCh* refs = attributes.getValue(sm_.convert("protein_refs").c_str());
@@ -734,6 +751,21 @@ namespace OpenMS::Internal
          &&  (!options_.hasMZRange() || options_.getMZRange().encloses(current_feature_->getMZ()))
          &&  (!options_.hasIntensityRange() || options_.getIntensityRange().encloses(current_feature_->getIntensity())))
       {
+        if (subordinate_feature_level_ == 0)
+        {
+          // !!! Hack: set feature FWHM from meta info entries as
+          // long as featureXML doesn't support a width entry.
+          // See also hack in BaseFeature::setWidth().
+          if (current_feature_->metaValueExists("FWHM"))
+          {
+            current_feature_->setWidth((double)current_feature_->getMetaValue("FWHM"));
+          }
+          if (consumer_ != nullptr)
+          {
+            consumer_->consumeFeature(*current_feature_);
+            map_->pop_back();
+          }
+        }
       }
       else
       {
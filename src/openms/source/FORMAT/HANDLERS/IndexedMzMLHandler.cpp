@@ -10,6 +10,10 @@
 
 #include <OpenMS/FORMAT/HANDLERS/IndexedMzMLDecoder.h>
 #include <OpenMS/FORMAT/HANDLERS/MzMLSpectrumDecoder.h>
+#include <OpenMS/FORMAT/OffsetIndexFile.h>
+#include <OpenMS/CONCEPT/LogStream.h>
+
+#include <QtCore/QFile>
 
 
 // #define DEBUG_READER
@@ -27,6 +31,10 @@ namespace OpenMS::Internal
     if (index_offset_ == (std::streampos)-1)
     {
       parsing_success_ = false;
+      if (offset_index_fallback_)
+      {
+        parseOffsetIndex_();
+      }
       return;
     }
 
@@ -61,30 +69,79 @@ namespace OpenMS::Internal
     parsing_success_ = (res == 0);
   }
 
+  void IndexedMzMLHandler::parseOffsetIndex_()
+  {
+    OffsetIndexFile index;
+    try
+    {
+      index.loadOrScan(filename_);
+    }
+    catch (Exception::BaseException& e)
+    {
+      OPENMS_LOG_DEBUG << "Could not index '" << filename_ << "': " << e.what() << std::endl;
+      return;
+    }
+    if (index.getFileType() != FileTypes::MZML)
+    {
+      return;
+    }
+
+    for (const auto& entry : index.getSpectra())
+    {
+      spectra_native_ids_.emplace(entry.native_id, spectra_offsets_.size());
+      spectra_offsets_.push_back(entry.offset);
+    }
+    for (const auto& entry : index.getChromatograms())
+    {
+      chromatograms_native_ids_.emplace(entry.native_id, chromatograms_offsets_.size());
+      chromatograms_offsets_.push_back(entry.offset);
+    }
+    // the last spectrum or chromatogram ends with the run (instead of the \<indexList\>)
+    index_offset_ = index.getRunEnd();
+
+    spectra_before_chroms_ = true;
+    if (!spectra_offsets_.empty() && !chromatograms_offsets_.empty())
+    {
+      spectra_before_chroms_ = spectra_offsets_[0] < chromatograms_offsets_[0];
+    }
+    parsing_success_ = true;
+  }
+
   IndexedMzMLHandler::IndexedMzMLHandler(const String& filename) :
     parsing_success_(false),
-    skip_xml_checks_(false) 
+    skip_xml_checks_(false),
+    offset_index_fallback_(false)
   {
     openFile(filename);
   }
 
   IndexedMzMLHandler::IndexedMzMLHandler() :
     parsing_success_(false),
-    skip_xml_checks_(false) 
+    skip_xml_checks_(false),
+    offset_index_fallback_(false)
   {}
 
   IndexedMzMLHandler::IndexedMzMLHandler(const IndexedMzMLHandler& source) :
     filename_(source.filename_),
     spectra_offsets_(source.spectra_offsets_),
+    spectra_native_ids_(source.spectra_native_ids_),
     chromatograms_offsets_(source.chromatograms_offsets_),
+    chromatograms_native_ids_(source.chromatograms_native_ids_),
     index_offset_(source.index_offset_),
     spectra_before_chroms_(source.spectra_before_chroms_),
-    // do not copy the filestream itself but open a new filestream using the same file
-    // this is critical for parallel access to the same file!
-    filestream_(source.filename_.c_str()),
     parsing_success_(source.parsing_success_),
-    skip_xml_checks_(source.skip_xml_checks_)
+    skip_xml_checks_(source.skip_xml_checks_),
+    offset_index_fallback_(source.offset_index_fallback_),
+    mapped_file_(source.mapped_file_),
+    mapped_data_(source.mapped_data_),
+    mapped_size_(source.mapped_size_)
   {
+    // do not copy the filestream itself but open a new filestream using the same file
+    // (only needed if the file is not mapped, the mapping itself can be shared)
+    if (mapped_data_ == nullptr)
+    {
+      filestream_.open(source.filename_.c_str());
+    }
   }
 
   IndexedMzMLHandler::~IndexedMzMLHandler() = default;
@@ -96,8 +153,67 @@ namespace OpenMS::Internal
       filestream_.close();
     }
     filename_ = filename;
-    filestream_.open(filename);
+    spectra_offsets_.clear();
+    spectra_native_ids_.clear();
+    chromatograms_offsets_.clear();
+    chromatograms_native_ids_.clear();
     parseFooter_();
+    mapFile_();
+    if (mapped_data_ == nullptr)
+    {
+      filestream_.open(filename);
+    }
+  }
+
+  void IndexedMzMLHandler::mapFile_()
+  {
+    mapped_file_.reset();
+    mapped_data_ = nullptr;
+    mapped_size_ = 0;
+
+    auto file = std::make_shared<QFile>(filename_.toQString());
+    if (!file->open(QIODevice::ReadOnly) || file->size() <= 0)
+    {
+      return;
+    }
+    uchar* data = file->map(0, file->size());
+    if (data == nullptr)
+    {
+      return;
+    }
+    mapped_size_ = static_cast<Size>(file->size());
+    mapped_data_ = reinterpret_cast<const char*>(data);
+    mapped_file_ = file;
+  }
+
+  std::string IndexedMzMLHandler::readRange_(std::streampos startidx, std::streampos endidx)
+  {
+    const std::streamoff start = startidx;
+    const std::streamoff end = endidx;
+    if (start < 0 || end < start)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Invalid offsets in index: " + String(start) + " - " + String(end), filename_);
+    }
+
+    if (mapped_data_ != nullptr)
+    {
+      // positional read from the shared read-only mapping, safe for concurrent access
+      if (static_cast<Size>(end) > mapped_size_)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+            "Offset " + String(end) + " is past the end of the file", filename_);
+      }
+      return std::string(mapped_data_ + start, end - start);
+    }
+
+    std::string text(end - start, '\0');
+    std::lock_guard<std::mutex> lock(filestream_mutex_);
+    filestream_.clear();
+    filestream_.seekg(startidx, filestream_.beg);
+    filestream_.read(&text[0], end - start);
+    text.resize(filestream_.gcount());
+    return text;
   }
 
   bool IndexedMzMLHandler::getParsingSuccess() const
@@ -159,13 +275,7 @@ namespace OpenMS::Internal
       endidx = chromatograms_offsets_[chromToGet + 1];
     }
 
-    std::streampos readl = endidx - startidx;
-    char* buffer = new char[readl + std::streampos(1)];
-    filestream_.seekg(startidx, filestream_.beg);
-    filestream_.read(buffer, readl);
-    buffer[readl] = '\0';
-    std::string text(buffer);
-    delete[] buffer;
+    std::string text = readRange_(startidx, endidx);
 
 #ifdef DEBUG_READER
     // print the full text we just read
@@ -219,13 +329,7 @@ namespace OpenMS::Internal
       endidx = spectra_offsets_[spectrumToGet + 1];
     }
 
-    std::streampos readl = endidx - startidx;
-    char* buffer = new char[readl + std::streampos(1)];
-    filestream_.seekg(startidx, filestream_.beg);
-    filestream_.read(buffer, readl);
-    buffer[readl] = '\0';
-    std::string text(buffer);
-    delete[] buffer;
+    std::string text = readRange_(startidx, endidx);
 
 #ifdef DEBUG_READER
     // print the full text we just read
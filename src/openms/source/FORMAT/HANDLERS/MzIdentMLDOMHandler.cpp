@@ -162,6 +162,7 @@ namespace OpenMS::Internal
       mzid_parser_.setDoNamespaces(false);
       mzid_parser_.setDoSchema(false);
       mzid_parser_.setLoadExternalDTD(false);
+      mzid_parser_.setCreateCommentNodes(false); // not used, saves DOM memory
 
       try
       {
@@ -266,6 +267,12 @@ namespace OpenMS::Internal
         {
           throw(runtime_error("No SpectrumIdentificationList nodes"));
         }
+        // one PeptideIdentification per SpectrumIdentificationResult (except for XL-MS): reserve
+        // instead of growing the vector, which may leave up to twice the capacity allocated
+        if (!xl_ms_search_)
+        {
+          pep_id_->reserve(pep_id_->size() + xmlDoc->getElementsByTagName(CONST_XMLCH("SpectrumIdentificationResult"))->getLength());
+        }
         parseSpectrumIdentificationListElements_(spectrumIdentificationListElements);
 
         // 6.2 ProteinDetection {0,1}
@@ -288,6 +295,14 @@ namespace OpenMS::Internal
         XMLString::release(&message);
       }
       xmlDoc->release();
+
+      // the lookup tables (e.g. with all protein sequences of the search database) are not needed any more
+      pep_map_.clear();
+      pe_ev_map_.clear();
+      pv_db_map_.clear();
+      p_pv_map_.clear();
+      db_sq_map_.clear();
+
       if (xl_ms_search_)
       {
         OPXLHelper::addProteinPositionMetaValues(*this->pep_id_);
@@ -10,6 +10,7 @@
 
 #include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/CONCEPT/PerfCounters.h>
 #include <OpenMS/CONCEPT/VersionInfo.h>
 #include <OpenMS/FORMAT/Base64.h>
 #include <OpenMS/FORMAT/CVMappingFile.h>
@@ -18,7 +19,10 @@
 #include <OpenMS/INTERFACES/IMSDataConsumer.h>
 #include <OpenMS/SYSTEM/File.h>
 
+#include <algorithm>
+#include <exception>
 #include <map>
+#include <sstream>
 
 namespace OpenMS::Internal
 {
@@ -57,7 +61,12 @@ namespace OpenMS::Internal
 
 
     /// Destructor
-    MzMLHandler::~MzMLHandler() = default;
+    MzMLHandler::~MzMLHandler()
+    {
+      // a parse error may leave a pool in flight; it must not outlive the members it works on
+      if (spectrum_decoding_.valid()) spectrum_decoding_.wait();
+      if (chromatogram_decoding_.valid()) chromatogram_decoding_.wait();
+    }
 
     /// Set the peak file options
     void MzMLHandler::setOptions(const PeakFileOptions& opt)
@@ -111,143 +120,248 @@ namespace OpenMS::Internal
 
     void MzMLHandler::populateSpectraWithData_()
     {
+      if (!options_.getFillData() || !options_.getPipelinedDecoding())
+      {
+        decodeSpectra_(spectrum_data_);
+        appendSpectra_(spectrum_data_);
+        return;
+      }
+
+      // only one pool may be in flight: wait for the previous one and deliver it before
+      // handing over the current pool, so memory stays bounded and order is preserved
+      if (spectrum_decoding_.valid())
+      {
+        spectrum_decoding_.get();
+        appendSpectra_(spectrum_data_in_flight_);
+      }
+      spectrum_data_in_flight_.swap(spectrum_data_);
+      spectrum_data_.reserve(options_.getMaxDataPoolSize());
+      spectrum_decoding_ = std::async(std::launch::async, [this]() { decodeSpectra_(spectrum_data_in_flight_); });
+    }
+
+    void MzMLHandler::populateChromatogramsWithData_()
+    {
+      if (!options_.getFillData() || !options_.getPipelinedDecoding())
+      {
+        decodeChromatograms_(chromatogram_data_);
+        appendChromatograms_(chromatogram_data_);
+        return;
+      }
+
+      if (chromatogram_decoding_.valid())
+      {
+        chromatogram_decoding_.get();
+        appendChromatograms_(chromatogram_data_in_flight_);
+      }
+      chromatogram_data_in_flight_.swap(chromatogram_data_);
+      chromatogram_data_.reserve(options_.getMaxDataPoolSize());
+      chromatogram_decoding_ = std::async(std::launch::async, [this]() { decodeChromatograms_(chromatogram_data_in_flight_); });
+    }
+
+    void MzMLHandler::flushSpectra_()
+    {
+      // first what is still decoded in the background, then the last (partial) pool
+      if (spectrum_decoding_.valid())
+      {
+        spectrum_decoding_.get();
+        appendSpectra_(spectrum_data_in_flight_);
+      }
+      decodeSpectra_(spectrum_data_);
+      appendSpectra_(spectrum_data_);
+    }
 
+    void MzMLHandler::flushChromatograms_()
+    {
+      if (chromatogram_decoding_.valid())
+      {
+        chromatogram_decoding_.get();
+        appendChromatograms_(chromatogram_data_in_flight_);
+      }
+      decodeChromatograms_(chromatogram_data_);
+      appendChromatograms_(chromatogram_data_);
+    }
+
+    void MzMLHandler::decodeSpectra_(std::vector<SpectrumData>& batch)
+    {
       // Whether spectrum should be populated with data
-      if (options_.getFillData())
+      if (!options_.getFillData())
       {
-        size_t errCount = 0;
-        String error_message;
+        return;
+      }
+
+      size_t errCount = 0;
+      String error_message;
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-        for (SignedSize i = 0; i < (SignedSize)spectrum_data_.size(); i++)
+      for (SignedSize i = 0; i < (SignedSize)batch.size(); i++)
+      {
+        // parallel exception catching and re-throwing business
+        if (!errCount) // no need to parse further if already an error was encountered
         {
-          // parallel exception catching and re-throwing business
-          if (!errCount) // no need to parse further if already an error was encountered
+          try
           {
-            try
+            populateSpectraWithData_(batch[i].data,
+                                     batch[i].default_array_length,
+                                     options_,
+                                     batch[i].spectrum);
+            if (options_.getSortSpectraByMZ() && !batch[i].spectrum.isSorted())
             {
-              populateSpectraWithData_(spectrum_data_[i].data,
-                                       spectrum_data_[i].default_array_length,
-                                       options_,
-                                       spectrum_data_[i].spectrum);
-              if (options_.getSortSpectraByMZ() && !spectrum_data_[i].spectrum.isSorted())
-              {
-                spectrum_data_[i].spectrum.sortByPosition();
-              }
+              batch[i].spectrum.sortByPosition();
             }
+          }
 
-            catch (OpenMS::Exception::BaseException& e)
-            {
+          catch (OpenMS::Exception::BaseException& e)
+          {
 #pragma omp critical(MZMLErrorHandling)
-              {
-                ++errCount;
-                error_message = e.what();
-              }
-            }
-            catch (...)
             {
-#pragma omp atomic
               ++errCount;
+              error_message = e.what();
             }
           }
-        }
-        if (errCount != 0)
-        {
-          std::cerr << "  Parsing error: '" << error_message  << "'" << std::endl;
-          std::cerr << "  You could try to disable sorting spectra while loading." << std::endl;
-          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, file_, "Error during parsing of binary data: '" + error_message + "'");
-        }
-      }
-
-      // Append all spectra to experiment / consumer
-      for (Size i = 0; i < spectrum_data_.size(); i++)
-      {
-        if (consumer_ != nullptr)
-        {
-          consumer_->consumeSpectrum(spectrum_data_[i].spectrum);
-          if (options_.getAlwaysAppendData())
+          catch (...)
           {
-            exp_->addSpectrum(std::move(spectrum_data_[i].spectrum));
+#pragma omp atomic
+            ++errCount;
           }
         }
-        else
-        {
-          exp_->addSpectrum(std::move(spectrum_data_[i].spectrum));
-        }
       }
-
-      // Delete batch
-      spectrum_data_.clear();
+      if (errCount != 0)
+      {
+        std::cerr << "  Parsing error: '" << error_message  << "'" << std::endl;
+        std::cerr << "  You could try to disable sorting spectra while loading." << std::endl;
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, file_, "Error during parsing of binary data: '" + error_message + "'");
+      }
     }
 
-    void MzMLHandler::populateChromatogramsWithData_()
+    void MzMLHandler::decodeChromatograms_(std::vector<ChromatogramData>& batch)
     {
       // Whether chromatogram should be populated with data
-      if (options_.getFillData())
+      if (!options_.getFillData())
       {
-        size_t errCount = 0;
-        String error_message;
+        return;
+      }
+
+      size_t errCount = 0;
+      String error_message;
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-        for (SignedSize i = 0; i < (SignedSize)chromatogram_data_.size(); i++)
+      for (SignedSize i = 0; i < (SignedSize)batch.size(); i++)
+      {
+        // parallel exception catching and re-throwing business
+        try
         {
-          // parallel exception catching and re-throwing business
-          try
+          populateChromatogramsWithData_(batch[i].data,
+                                         batch[i].default_array_length,
+                                         options_,
+                                         batch[i].chromatogram);
+          if (options_.getSortChromatogramsByRT() && !batch[i].chromatogram.isSorted())
           {
-            populateChromatogramsWithData_(chromatogram_data_[i].data,
-                                           chromatogram_data_[i].default_array_length,
-                                           options_,
-                                           chromatogram_data_[i].chromatogram);
-            if (options_.getSortChromatogramsByRT() && !chromatogram_data_[i].chromatogram.isSorted())
-            {
-              chromatogram_data_[i].chromatogram.sortByPosition();
-            }
+            batch[i].chromatogram.sortByPosition();
           }
-          catch (OpenMS::Exception::BaseException& e)
+        }
+        catch (OpenMS::Exception::BaseException& e)
+        {
+#pragma omp critical(MZMLErrorHandling)
           {
-#pragma omp critical
-            {
-              ++errCount;
-              error_message = e.what();
-            }
+            ++errCount;
+            error_message = e.what();
           }
-          catch (...)
-          {
+        }
+        catch (...)
+        {
 #pragma omp atomic
-            ++errCount;
+          ++errCount;
+        }
+      }
+      if (errCount != 0)
+      {
+        std::cerr << "  Parsing error: '" << error_message  << "'" << std::endl;
+        std::cerr << "  You could try to disable sorting spectra while loading." << std::endl;
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, file_, "Error during parsing of binary data: '" + error_message + "'");
+      }
+    }
+
+    void MzMLHandler::appendSpectra_(std::vector<SpectrumData>& batch)
+    {
+      // Append all spectra to experiment / consumer
+      for (Size i = 0; i < batch.size(); i++)
+      {
+        if (consumer_ != nullptr)
+        {
+          consumer_->consumeSpectrum(batch[i].spectrum);
+          if (options_.getAlwaysAppendData())
+          {
+            exp_->addSpectrum(std::move(batch[i].spectrum));
           }
         }
-        if (errCount != 0)
+        else
         {
-          // throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, file_, "Error during parsing of binary data.");
-          std::cerr << "  Parsing error: '" << error_message  << "'" << std::endl;
-          std::cerr << "  You could try to disable sorting spectra while loading." << std::endl;
-          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, file_, "Error during parsing of binary data: '" + error_message + "'");
+          exp_->addSpectrum(std::move(batch[i].spectrum));
         }
+      }
 
+      // Keep the binary data buffers for the next spectra, then delete batch
+      for (SpectrumData& sd : batch)
+      {
+        recycleBinaryData_(sd.data);
       }
+      batch.clear();
+    }
 
+    void MzMLHandler::appendChromatograms_(std::vector<ChromatogramData>& batch)
+    {
       // Append all chromatograms to experiment / consumer
-      for (Size i = 0; i < chromatogram_data_.size(); i++)
+      for (Size i = 0; i < batch.size(); i++)
       {
         if (consumer_ != nullptr)
         {
-          consumer_->consumeChromatogram(chromatogram_data_[i].chromatogram);
+          consumer_->consumeChromatogram(batch[i].chromatogram);
           if (options_.getAlwaysAppendData())
           {
-            exp_->addChromatogram(std::move(chromatogram_data_[i].chromatogram));
+            exp_->addChromatogram(std::move(batch[i].chromatogram));
           }
         }
         else
         {
-          exp_->addChromatogram(std::move(chromatogram_data_[i].chromatogram));
+          exp_->addChromatogram(std::move(batch[i].chromatogram));
+        }
+      }
+
+      // Keep the binary data buffers for the next chromatograms, then delete batch
+      for (ChromatogramData& cd : batch)
+      {
+        recycleBinaryData_(cd.data);
+      }
+      batch.clear();
+    }
+
+    void MzMLHandler::recycleBinaryData_(std::vector<BinaryData>& data)
+    {
+      // bound the memory held by the spare pool to about one data pool (with a handful of arrays per spectrum)
+      const Size max_spare = 4 * std::max(options_.getMaxDataPoolSize(), Size(1));
+      for (BinaryData& bd : data)
+      {
+        if (bin_data_spare_.size() >= max_spare)
+        {
+          break;
         }
+        bin_data_spare_.push_back(std::move(bd));
       }
+      data.clear();
+    }
 
-      // Delete batch
-      chromatogram_data_.clear();
+    void MzMLHandler::addBinaryData_()
+    {
+      if (bin_data_spare_.empty())
+      {
+        bin_data_.emplace_back();
+        return;
+      }
+      bin_data_.push_back(std::move(bin_data_spare_.back()));
+      bin_data_spare_.pop_back();
+      bin_data_.back().clear();
     }
 
     void MzMLHandler::addSpectrumMetaData_(const std::vector<MzMLHandlerHelper::BinaryData>& input_data,
@@ -303,6 +417,7 @@ namespace OpenMS::Internal
 
       // decode all base64 arrays
       MzMLHandlerHelper::decodeBase64Arrays(input_data, options_.getSkipXMLChecks());
+      PerfCounters::add(PerfCounters::SPECTRA_DECODED);
 
       //look up the precision and the index of the intensity and m/z array
       bool mz_precision_64 = true;
@@ -472,6 +587,7 @@ namespace OpenMS::Internal
 
       //decode all base64 arrays
       MzMLHandlerHelper::decodeBase64Arrays(input_data, options_.getSkipXMLChecks());
+      PerfCounters::add(PerfCounters::CHROMATOGRAMS_DECODED);
 
       //look up the precision and the index of the intensity and m/z array
       bool int_precision_64 = true;
@@ -841,7 +957,7 @@ namespace OpenMS::Internal
       }
       else if (tag == "binaryDataArray" /* && in_spectrum_list_*/)
       {
-        bin_data_.emplace_back();
+        addBinaryData_();
         bin_data_.back().np_compression = MSNumpressCoder::NONE; // ensure that numpress compression is initially set to none ...
         bin_data_.back().compression = false; // ensure that zlib compression is initially set to none ...
 
@@ -1258,7 +1374,7 @@ namespace OpenMS::Internal
 
         rt_set_ = false;
         logger_.nextProgress();
-        bin_data_.clear();
+        recycleBinaryData_(bin_data_);
         default_array_length_ = 0;
       }
       else if (equal_(qname, s_chromatogram))
@@ -1295,19 +1411,22 @@ namespace OpenMS::Internal
         }
 
         logger_.nextProgress();
-        bin_data_.clear();
+        recycleBinaryData_(bin_data_);
         default_array_length_ = 0;
       }
       else if (equal_(qname, s_spectrum_list))
       {
         skip_spectrum_ = false; // no more spectra to come, so stop skipping (for the LD_RAWCOUNTS case)
         in_spectrum_list_ = false;
+        // deliver all spectra before the first chromatogram reaches the consumer (e.g. MSDataWritingConsumer requires this order)
+        flushSpectra_();
         logger_.endProgress();
       }
       else if (equal_(qname, s_chromatogram_list))
       {
         skip_chromatogram_ = false; // no more chromatograms to come, so stop skipping
         in_spectrum_list_ = false;
+        flushChromatograms_();
         logger_.endProgress();
       }
       else if (equal_(qname, s_sourceFileList ))
@@ -1333,8 +1452,8 @@ namespace OpenMS::Internal
         processing_.clear();
 
         // Flush the remaining data
-        populateSpectraWithData_();
-        populateChromatogramsWithData_();
+        flushSpectra_();
+        flushChromatograms_();
         pg_outer.endProgress(File::fileSize(file_)); // we cannot query the offset within the file when SAX'ing it (Xerces does not support that)
                                                      // , so we can only report I/O at the very end
       }
@@ -3321,10 +3440,25 @@ namespace OpenMS::Internal
       // validateCV_() is called very often for the same path-term-combinations, so we save lots of repetitive computations
       // By caching these combinations we save about 99% of the runtime of validateCV_()
 
-      const auto it = cached_terms_.find(std::make_pair(path, c.id));
-      if (it != cached_terms_.end())
+      // (guarded, as spectra and chromatograms may be written in parallel)
+      const auto key = std::make_pair(path, c.id);
+      bool cached = false;
+      bool cached_valid = false;
+      PerfCounters::LockWait wait;
+#pragma omp critical(MzMLHandlerCachedTerms)
       {
-        return it->second;
+        wait.acquired();
+        const auto it = cached_terms_.find(key);
+        if (it != cached_terms_.end())
+        {
+          cached = true;
+          cached_valid = it->second;
+        }
+      }
+      PerfCounters::add(cached ? PerfCounters::CACHE_HITS : PerfCounters::CACHE_MISSES);
+      if (cached)
+      {
+        return cached_valid;
       }
 
       SemanticValidator::CVTerm sc;
@@ -3334,7 +3468,8 @@ namespace OpenMS::Internal
       sc.has_unit_name = false;
 
       bool isValid = validator.SemanticValidator::locateTerm(path, sc);
-      cached_terms_[std::make_pair(path, c.id)] = isValid;
+#pragma omp critical(MzMLHandlerCachedTerms)
+      cached_terms_[key] = isValid;
       return isValid;
     }
 
@@ -3916,6 +4051,11 @@ namespace OpenMS::Internal
       Internal::MzMLValidator validator(mapping_, cv_);
 
       std::vector<std::vector< ConstDataProcessingPtr > > dps;
+
+      // with parallel writing, a pool of spectra/chromatograms is formatted
+      // into separate buffers, which are then written (in order) to os
+      const Size pool_size = std::max(options_.getMaxDataPoolSize(), Size(1));
+      std::vector<std::string> buffers;
       //--------------------------------------------------------------------------------------------
       //header
       //--------------------------------------------------------------------------------------------
@@ -3950,12 +4090,35 @@ namespace OpenMS::Internal
         }
 
         // write actual data
-        for (Size s_idx = 0; s_idx < exp.size(); ++s_idx)
+        if (options_.getParallelWriting())
         {
-          logger_.setProgress(progress++);
-          const SpectrumType& spec = exp[s_idx];
-          writeSpectrum_(os, spec, s_idx, validator, renew_native_ids, dps);
-          ++stored_spectra;
+          for (Size begin = 0; begin < exp.size(); begin += pool_size)
+          {
+            const Size end = std::min(begin + pool_size, exp.size());
+            formatParallel_(os, begin, end, buffers, [&](std::ostream& buffer, Size s_idx)
+            {
+              const SpectrumType& spec = exp[s_idx];
+              formatSpectrum_(buffer, spec, renew_native_ids ? String("spectrum=") + s_idx : spec.getNativeID(), s_idx, validator, dps);
+            });
+            for (Size s_idx = begin; s_idx < end; ++s_idx)
+            {
+              logger_.setProgress(progress++);
+              const SpectrumType& spec = exp[s_idx];
+              spectra_offsets_.emplace_back(renew_native_ids ? String("spectrum=") + s_idx : spec.getNativeID(), Int64(os.tellp()) + 3);
+              os << buffers[s_idx - begin];
+              ++stored_spectra;
+            }
+          }
+        }
+        else
+        {
+          for (Size s_idx = 0; s_idx < exp.size(); ++s_idx)
+          {
+            logger_.setProgress(progress++);
+            const SpectrumType& spec = exp[s_idx];
+            writeSpectrum_(os, spec, s_idx, validator, renew_native_ids, dps);
+            ++stored_spectra;
+          }
         }
         os << "\t\t</spectrumList>\n";
       }
@@ -3970,12 +4133,34 @@ namespace OpenMS::Internal
         // meta information needs to be stored here but the actual data is
         // stored somewhere else).
         os << "\t\t<chromatogramList count=\"" << exp.getChromatograms().size() << "\" defaultDataProcessingRef=\"dp_sp_0\">\n";
-        for (Size c_idx = 0; c_idx != exp.getChromatograms().size(); ++c_idx)
+        const std::vector<ChromatogramType>& chromatograms = exp.getChromatograms();
+        if (options_.getParallelWriting())
+        {
+          for (Size begin = 0; begin < chromatograms.size(); begin += pool_size)
+          {
+            const Size end = std::min(begin + pool_size, chromatograms.size());
+            formatParallel_(os, begin, end, buffers, [&](std::ostream& buffer, Size c_idx)
+            {
+              formatChromatogram_(buffer, chromatograms[c_idx], c_idx, validator);
+            });
+            for (Size c_idx = begin; c_idx < end; ++c_idx)
+            {
+              logger_.setProgress(progress++);
+              chromatograms_offsets_.emplace_back(chromatograms[c_idx].getNativeID(), Int64(os.tellp()) + 3);
+              os << buffers[c_idx - begin];
+              ++stored_chromatograms;
+            }
+          }
+        }
+        else
         {
-          logger_.setProgress(progress++);
-          const ChromatogramType& chromatogram = exp.getChromatograms()[c_idx];
-          writeChromatogram_(os, chromatogram, c_idx, validator);
-          ++stored_chromatograms;
+          for (Size c_idx = 0; c_idx != chromatograms.size(); ++c_idx)
+          {
+            logger_.setProgress(progress++);
+            const ChromatogramType& chromatogram = chromatograms[c_idx];
+            writeChromatogram_(os, chromatogram, c_idx, validator);
+            ++stored_chromatograms;
+          }
         }
         os << "\t\t</chromatogramList>" << "\n";
       }
@@ -3987,6 +4172,48 @@ namespace OpenMS::Internal
       logger_.endProgress(os.tellp());
     }
 
+    void MzMLHandler::formatParallel_(const std::ostream& os,
+                                      Size begin,
+                                      Size end,
+                                      std::vector<std::string>& buffers,
+                                      const std::function<void(std::ostream&, Size)>& format) const
+    {
+      buffers.assign(end - begin, std::string());
+      // the buffers have to format numbers exactly like os
+      const std::streamsize precision = os.precision();
+      const std::ios_base::fmtflags flags = os.flags();
+
+      size_t errCount = 0;
+      std::exception_ptr error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (SignedSize i = (SignedSize)begin; i < (SignedSize)end; ++i)
+      {
+        // parallel exception catching and re-throwing business
+        if (errCount) continue; // no need to format further if already an error was encountered
+        try
+        {
+          std::ostringstream buffer;
+          buffer.precision(precision);
+          buffer.flags(flags);
+          format(buffer, (Size)i);
+          buffers[i - begin] = buffer.str();
+        }
+        catch (...)
+        {
+#pragma omp critical(MZMLErrorHandling)
+          {
+            if (!errCount++) error = std::current_exception();
+          }
+        }
+      }
+      if (errCount != 0)
+      {
+        std::rethrow_exception(error);
+      }
+    }
+
     void MzMLHandler::writeHeader_(std::ostream& os,
                                    const MapType& exp,
                                    std::vector<std::vector< ConstDataProcessingPtr > >& dps,
@@ -4943,7 +5170,17 @@ namespace OpenMS::Internal
       Int64 offset = os.tellp();
       spectra_offsets_.emplace_back(native_id, offset + 3);
 
-      // IMPORTANT make sure the offset (above) corresponds to the start of the <spectrum tag
+      formatSpectrum_(os, spec, native_id, s, validator, dps);
+    }
+
+    void MzMLHandler::formatSpectrum_(std::ostream& os,
+                                      const SpectrumType& spec,
+                                      const String& native_id,
+                                      Size s,
+                                      const Internal::MzMLValidator& validator,
+                                      const std::vector<std::vector< ConstDataProcessingPtr > >& dps)
+    {
+      // IMPORTANT make sure the offset (recorded by the caller) corresponds to the start of the <spectrum tag
       os << "\t\t\t<spectrum id=\"" << writeXMLEscape(native_id) << "\" index=\"" << s << "\" defaultArrayLength=\"" << spec.size() << "\"";
       if (spec.getSourceFile() != SourceFile())
       {
@@ -5523,8 +5760,16 @@ namespace OpenMS::Internal
       Int64 offset = os.tellp();
       chromatograms_offsets_.emplace_back(chromatogram.getNativeID(), offset + 3);
 
+      formatChromatogram_(os, chromatogram, c, validator);
+    }
+
+    void MzMLHandler::formatChromatogram_(std::ostream& os,
+                                          const ChromatogramType& chromatogram,
+                                          Size c,
+                                          const Internal::MzMLValidator& validator)
+    {
       // TODO native id with chromatogram=?? prefix?
-      // IMPORTANT make sure the offset (above) corresponds to the start of the <chromatogram tag
+      // IMPORTANT make sure the offset (recorded by the caller) corresponds to the start of the <chromatogram tag
       os << "\t\t\t<chromatogram id=\"" << writeXMLEscape(chromatogram.getNativeID()) << "\" index=\"" << c << "\" defaultArrayLength=\"" << chromatogram.size() << "\">" << "\n";
 
       // write cvParams (chromatogram type)
@@ -26,6 +26,7 @@
 #include <omp.h>
 #endif
 
+#include <algorithm>
 #include <cmath>
 
 namespace OpenMS::Internal
@@ -52,6 +53,37 @@ namespace OpenMS::Internal
       return tmp;
     }
 
+    /*
+     * @brief Decodes a single binary data blob read from the DATA table
+     *
+     * compression is one of 0 = no, 1 = zlib, 2 = np-linear, 3 = np-slof, 4 = np-pic, 5 = np-linear + zlib, 6 = np-slof + zlib, 7 = np-pic + zlib
+     * (only 1, 5 and 6 are supported)
+     *
+     */
+    void decodeDataBlob_(int compression, const std::string& blob, std::vector<double>& data)
+    {
+      data.clear();
+      std::string stemp;
+      OpenMS::ZlibCompression::uncompressString(blob.data(), blob.size(), stemp);
+      if (compression == 1)
+      {
+        if (stemp.size() % sizeof(double) != 0)
+        {
+          throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Bad BufferCount?");
+        }
+        const double* float_buffer = reinterpret_cast<const double *>(stemp.data());
+        Size float_count = stemp.size() / sizeof(double);
+        // copy values
+        data.assign(float_buffer, float_buffer + float_count);
+      }
+      else
+      {
+        MSNumpressCoder::NumpressConfig config;
+        config.setCompression(compression == 5 ? "linear" : "slof");
+        MSNumpressCoder().decodeNPRaw(stemp, data, config);
+      }
+    }
+
     /*
      *
      * This function populates a set of empty data containers (MSSpectrum or
@@ -68,18 +100,99 @@ namespace OpenMS::Internal
      * It is designed to work with containers of type MSSpectrum and
      * MSChromatogram to provide a single function for both use-cases.
      *
+     * Rows are read from the database in batches; the (comparatively
+     * expensive) decompression of the blobs of a batch is done in parallel,
+     * while stepping through the statement is done sequentially as an SQLite
+     * statement cannot be shared between threads.
+     *
      */
     template<class ContainerT>
     void populateContainer_sub_(sqlite3_stmt *stmt, std::vector<ContainerT>& containers)
     {
-      // perform first step
-      sqlite3_step(stmt);
+      // number of DATA rows which are decoded together
+      const Size decode_batch_size = 1024;
+
+      struct DataRow
+      {
+        Size container_index;
+        int compression;
+        int data_type;
+        std::string blob;
+        std::vector<double> data;
+      };
 
       std::vector<int> cont_data;
       cont_data.resize(containers.size());
       std::map<Size,Size> sql_container_map;
-      std::vector<double> data;
-      String stemp;
+      std::vector<DataRow> batch;
+      batch.reserve(decode_batch_size);
+
+      // decode all rows of the current batch and copy the data into the containers
+      auto flush_batch = [&]()
+      {
+        Size errCount = 0;
+        String error_message;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (SignedSize i = 0; i < (SignedSize)batch.size(); i++)
+        {
+          if (!errCount) // no need to decode further if already an error was encountered
+          {
+            try
+            {
+              decodeDataBlob_(batch[i].compression, batch[i].blob, batch[i].data);
+            }
+            catch (OpenMS::Exception::BaseException& e)
+            {
+#pragma omp critical(SqMassDecodeErrorHandling)
+              {
+                ++errCount;
+                error_message = e.what();
+              }
+            }
+            catch (...)
+            {
+#pragma omp atomic
+              ++errCount;
+            }
+          }
+        }
+        if (errCount != 0)
+        {
+          throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+              "Error during decoding of binary data: '" + error_message + "'");
+        }
+
+        for (DataRow& row : batch)
+        {
+          ContainerT& container = containers[row.container_index];
+          if (container.empty())
+          {
+            container.resize(row.data.size());
+          }
+          std::vector< double >::iterator data_it = row.data.begin();
+          for (auto it = container.begin(); it != container.end(); ++it, ++data_it)
+          {
+            if (row.data_type == 1)
+            {
+              // intensity
+              it->setIntensity(*data_it);
+            }
+            else
+            {
+              // mz (spectra) or rt (chromatograms)
+              it->setMZ(*data_it);
+            }
+          }
+          cont_data[row.container_index] += 1;
+        }
+        batch.clear();
+      };
+
+      // perform first step
+      sqlite3_step(stmt);
+
       while (sqlite3_column_type( stmt, 0 ) != SQLITE_NULL)
       {
         Size id_orig = sqlite3_column_int( stmt, 0 );
@@ -109,106 +222,43 @@ namespace OpenMS::Internal
         int compression = sqlite3_column_int( stmt, 2 );
         int data_type = sqlite3_column_int( stmt, 3 );
 
-        const void * raw_text = sqlite3_column_blob(stmt, 4);
-        size_t blob_bytes = sqlite3_column_bytes(stmt, 4);
-
         // data_type is one of 0 = mz, 1 = int, 2 = rt
         // compression is one of 0 = no, 1 = zlib, 2 = np-linear, 3 = np-slof, 4 = np-pic, 5 = np-linear + zlib, 6 = np-slof + zlib, 7 = np-pic + zlib
-        data.clear();
-        stemp.clear();
-        if (compression == 1)
-        {
-          OpenMS::ZlibCompression::uncompressString(raw_text, blob_bytes, stemp);
-
-          void* byte_buffer = reinterpret_cast<void *>(&stemp[0]);
-          Size buffer_size = stemp.size();
-          const double* float_buffer = reinterpret_cast<const double *>(byte_buffer);
-          if (buffer_size % sizeof(double) != 0)
-          {
-            throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Bad BufferCount?");
-          }
-          Size float_count = buffer_size / sizeof(double);
-          // copy values
-          data.assign(float_buffer, float_buffer + float_count);
-        }
-        else if (compression == 5)
-        {
-          OpenMS::ZlibCompression::uncompressString(raw_text, blob_bytes, stemp);
-          MSNumpressCoder::NumpressConfig config;
-          config.setCompression("linear");
-          MSNumpressCoder().decodeNPRaw(stemp, data, config);
-        }
-        else if (compression == 6)
-        {
-          OpenMS::ZlibCompression::uncompressString(raw_text, blob_bytes, stemp);
-          MSNumpressCoder::NumpressConfig config;
-          config.setCompression("slof");
-          MSNumpressCoder().decodeNPRaw(stemp, data, config);
-        }
-        else
+        if (compression != 1 && compression != 5 && compression != 6)
         {
           throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
               "Compression not supported");
         }
-
-        if (data_type == 1)
-        {
-          // intensity
-          if (containers[curr_id].empty())
-          {
-            containers[curr_id].resize(data.size());
-          }
-          std::vector< double >::iterator data_it = data.begin();
-          for (auto it = containers[curr_id].begin(); it != containers[curr_id].end(); ++it, ++data_it)
-          {
-            it->setIntensity(*data_it);
-          }
-          cont_data[curr_id] += 1;
-        }
-        else if (data_type == 0)
+        if (data_type == 0 && boost::is_same<ContainerT, MSChromatogram>::value)
         {
           // mz (should only occur in spectra)
-          if (boost::is_same<ContainerT, MSChromatogram>::value) 
-          {
-            throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
-                "Found m/z data type for chromatogram (instead of retention time)");
-          }
-
-          if (containers[curr_id].empty())
-          {
-            containers[curr_id].resize(data.size());
-          }
-          std::vector< double >::iterator data_it = data.begin();
-          for (auto it = containers[curr_id].begin(); it != containers[curr_id].end(); ++it, ++data_it)
-          {
-            it->setMZ(*data_it);
-          }
-          cont_data[curr_id] += 1;
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
+              "Found m/z data type for chromatogram (instead of retention time)");
         }
-        else if (data_type == 2)
+        if (data_type == 2 && boost::is_same<ContainerT, MSSpectrum>::value)
         {
           // rt (should only occur in chromatograms)
-          if (boost::is_same<ContainerT, MSSpectrum >::value) 
-          {
-            throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
-                "Found retention time data type for spectrum (instead of m/z)");
-          }
-          if (containers[curr_id].empty()) containers[curr_id].resize(data.size());
-          std::vector< double >::iterator data_it = data.begin();
-          for (auto it = containers[curr_id].begin(); it != containers[curr_id].end(); ++it, ++data_it)
-          {
-            it->setMZ(*data_it);
-          }
-          cont_data[curr_id] += 1;
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
+              "Found retention time data type for spectrum (instead of m/z)");
         }
-        else
+        if (data_type < 0 || data_type > 2)
         {
           throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
               "Found data type other than RT/Intensity for spectra");
         }
 
+        // the blob is only valid until the next step, so copy it
+        const char * raw_text = static_cast<const char*>(sqlite3_column_blob(stmt, 4));
+        size_t blob_bytes = sqlite3_column_bytes(stmt, 4);
+        batch.push_back({curr_id, compression, data_type, std::string(raw_text, blob_bytes), {}});
+        if (batch.size() >= decode_batch_size)
+        {
+          flush_batch();
+        }
+
         sqlite3_step( stmt );
       }
+      flush_batch();
 
       // ensure that all spectra/chromatograms have their data: we expect two data arrays per container (int and mz/rt)
       for (Size k = 0; k < cont_data.size(); k++)
@@ -453,6 +503,63 @@ namespace OpenMS::Internal
       return result;
     }
 
+    std::vector<double> MzMLSqliteHandler::getSpectraRT(const std::vector<int>& indices) const
+    {
+      SqliteConnector conn(filename_);
+
+      String select_sql = "SELECT " \
+                          "SPECTRUM.ID as spec_id," \
+                          "SPECTRUM.RETENTION_TIME as rt " \
+                          "FROM SPECTRUM ";
+      if (!indices.empty())
+      {
+        select_sql += "WHERE SPECTRUM.ID IN (" + integerConcatenateHelper(indices) + ")";
+      }
+      select_sql += ";";
+
+      sqlite3_stmt * stmt;
+      conn.prepareStatement(&stmt, select_sql);
+      sqlite3_step(stmt);
+
+      std::map<int, double> id_rt;
+      while (sqlite3_column_type( stmt, 0 ) != SQLITE_NULL)
+      {
+        id_rt[sqlite3_column_int(stmt, 0)] = sqlite3_column_double(stmt, 1);
+        sqlite3_step(stmt);
+      }
+      sqlite3_finalize(stmt);
+
+      std::vector<double> result;
+      if (indices.empty())
+      {
+        // spectrum ids run from zero to the number of spectra
+        result.resize(id_rt.size());
+        for (const auto& it : id_rt)
+        {
+          if (it.first < 0 || it.first >= (int)result.size())
+          {
+            throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+                String("Spectrum id ") + it.first + " is not consecutive in a file of size " + result.size());
+          }
+          result[it.first] = it.second;
+        }
+        return result;
+      }
+
+      result.reserve(indices.size());
+      for (int idx : indices)
+      {
+        auto it = id_rt.find(idx);
+        if (it == id_rt.end())
+        {
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+              String("Illegal spectral index detected ") + idx + " for file of size " + getNrSpectra());
+        }
+        result.push_back(it->second);
+      }
+      return result;
+    }
+
     Size MzMLSqliteHandler::getNrChromatograms() const
     {
       SqliteConnector conn(filename_);
@@ -820,30 +927,40 @@ namespace OpenMS::Internal
 
       if (write_full_meta)
       {
-        MSExperiment meta;
+        // The meta data archive of a consumer (see MSDataSqlConsumer) holds no
+        // peaks and is stored directly instead of being copied: for OpenSWATH
+        // output, these are millions of chromatograms.
+        auto no_data = [](const auto& c) { return c.empty() && c.getFloatDataArrays().empty() &&
+                                                  c.getStringDataArrays().empty() && c.getIntegerDataArrays().empty(); };
+        bool meta_only = std::all_of(exp.getSpectra().begin(), exp.getSpectra().end(), no_data) &&
+                         std::all_of(exp.getChromatograms().begin(), exp.getChromatograms().end(), no_data);
 
-        // copy experimental settings
-        meta.reserveSpaceSpectra(exp.getNrSpectra());
-        meta.reserveSpaceChromatograms(exp.getNrChromatograms());
-        static_cast<ExperimentalSettings &>(meta) = exp;
-        for (Size k = 0; k < exp.getNrSpectra(); k++)
-        {
-          MSSpectrum s = exp.getSpectra()[k];
-          s.clear(false);
-          meta.addSpectrum(s);
-        }
-        for (Size k = 0; k < exp.getNrChromatograms(); k++)
+        MSExperiment meta;
+        if (!meta_only)
         {
-          MSChromatogram c = exp.getChromatograms()[k];
-          c.clear(false);
-          meta.addChromatogram(c);
+          // copy experimental settings
+          meta.reserveSpaceSpectra(exp.getNrSpectra());
+          meta.reserveSpaceChromatograms(exp.getNrChromatograms());
+          static_cast<ExperimentalSettings &>(meta) = exp;
+          for (Size k = 0; k < exp.getNrSpectra(); k++)
+          {
+            MSSpectrum s = exp.getSpectra()[k];
+            s.clear(false);
+            meta.addSpectrum(std::move(s));
+          }
+          for (Size k = 0; k < exp.getNrChromatograms(); k++)
+          {
+            MSChromatogram c = exp.getChromatograms()[k];
+            c.clear(false);
+            meta.addChromatogram(std::move(c));
+          }
         }
         String prepare_statement = "INSERT INTO RUN_EXTRA (RUN_ID, DATA) VALUES ";
         prepare_statement += String("(") + run_id_ + ", ?)";
         std::vector<String> data;
 
         std::string output;
-        MzMLFile().storeBuffer(output, meta);
+        MzMLFile().storeBuffer(output, meta_only ? exp : meta);
 
         // write the full metadata into the sql file (compress with zlib before)
         std::string encoded_string;
@@ -1057,6 +1174,9 @@ namespace OpenMS::Internal
         }
       }
 
+      // write all data in a single transaction: the blobs are inserted in
+      // batches while the meta data is collected below
+      conn.executeStatement("BEGIN TRANSACTION");
       int nr_precursors = 0;
       int nr_products = 0;
       for (Size k = 0; k < spectra.size(); k++)
@@ -1134,7 +1254,7 @@ namespace OpenMS::Internal
 
         // encode mz data (zlib or np-linear + zlib)
         {
-          data.push_back(encoded_strings_mz[k]);
+          data.push_back(std::move(encoded_strings_mz[k]));
           if (use_lossy_compression_)
           {
             prepare_statement += String("(") + spec_id_ + ", 0, 5, ?" + sql_it++ + " ),";
@@ -1147,7 +1267,7 @@ namespace OpenMS::Internal
 
         // encode intensity data (zlib or np-slof + zlib)
         {
-          data.push_back(encoded_strings_int[k]);
+          data.push_back(std::move(encoded_strings_int[k]));
           if (use_lossy_compression_)
           {
             prepare_statement += String("(") + spec_id_ + ", 1, 6, ?" + sql_it++ + " ),";
@@ -1182,7 +1302,6 @@ namespace OpenMS::Internal
         conn.executeBindStatement(prepare_statement, data);
       }
 
-      conn.executeStatement("BEGIN TRANSACTION");
       conn.executeStatement(insert_spectra_sql.str());
       if (nr_precursors > 0)
       {
@@ -1227,73 +1346,65 @@ namespace OpenMS::Internal
       String prepare_statement = "INSERT INTO DATA (CHROMATOGRAM_ID, DATA_TYPE, COMPRESSION, DATA) VALUES ";
       int sql_it = 1;
 
-      // Perform encoding in parallel
+      // Perform encoding in parallel; each thread reuses its buffers and
+      // encodes directly into the output strings (no per-chromatogram copies)
       std::vector<String> encoded_strings_rt(chroms.size());
       std::vector<String> encoded_strings_int(chroms.size());
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel
 #endif
-      for (SignedSize k = 0; k < (SignedSize)chroms.size(); k++)
       {
-        const MSChromatogram& chrom = chroms[k];
-        // encode retention time data (zlib or np-linear + zlib)
+        std::vector<double> data_to_encode;
+        String uncompressed_str;
+        MSNumpressCoder coder;
+        auto encode = [&](const MSNumpressCoder::NumpressConfig& npconfig, String& encoded_string)
         {
-          std::vector<double> data_to_encode;
-          data_to_encode.resize(chrom.size());
-          for (Size p = 0; p < chrom.size(); ++p)
-          {
-            data_to_encode[p] = chrom[p].getRT();
-          }
-
-          String uncompressed_str;
-          String encoded_string;
           if (use_lossy_compression_)
           {
-            MSNumpressCoder().encodeNPRaw(data_to_encode, uncompressed_str, npconfig_mz);
+            coder.encodeNPRaw(data_to_encode, uncompressed_str, npconfig);
             OpenMS::ZlibCompression::compressString(uncompressed_str, encoded_string);
-            encoded_strings_rt[k] = encoded_string;
           }
           else
           {
-            std::string str_data = std::string((const char*) (&data_to_encode[0]), data_to_encode.size() * sizeof(double));
-            OpenMS::ZlibCompression::compressString(str_data, encoded_string);
-            encoded_strings_rt[k] = encoded_string;
+            uncompressed_str.assign((const char*) data_to_encode.data(), data_to_encode.size() * sizeof(double));
+            OpenMS::ZlibCompression::compressString(uncompressed_str, encoded_string);
           }
-        }
+        };
 
-        // encode intensity data (zlib or np-slof + zlib)
+#ifdef _OPENMP
+#pragma omp for
+#endif
+        for (SignedSize k = 0; k < (SignedSize)chroms.size(); k++)
         {
-          std::vector<double> data_to_encode;
+          const MSChromatogram& chrom = chroms[k];
           data_to_encode.resize(chrom.size());
+
+          // encode retention time data (zlib or np-linear + zlib)
           for (Size p = 0; p < chrom.size(); ++p)
           {
-            data_to_encode[p] = chrom[p].getIntensity();
+            data_to_encode[p] = chrom[p].getRT();
           }
+          encode(npconfig_mz, encoded_strings_rt[k]);
 
-          String uncompressed_str;
-          String encoded_string;
-          if (use_lossy_compression_)
-          {
-            MSNumpressCoder().encodeNPRaw(data_to_encode, uncompressed_str, npconfig_int);
-            OpenMS::ZlibCompression::compressString(uncompressed_str, encoded_string);
-            encoded_strings_int[k] = encoded_string;
-          }
-          else
+          // encode intensity data (zlib or np-slof + zlib)
+          for (Size p = 0; p < chrom.size(); ++p)
           {
-            std::string str_data = std::string((const char*) (&data_to_encode[0]), data_to_encode.size() * sizeof(double));
-            OpenMS::ZlibCompression::compressString(str_data, encoded_string);
-            encoded_strings_int[k] = encoded_string;
+            data_to_encode[p] = chrom[p].getIntensity();
           }
+          encode(npconfig_int, encoded_strings_int[k]);
         }
       }
 
+      // write all data in a single transaction: the blobs are inserted in
+      // batches while the meta data is collected below
+      conn.executeStatement("BEGIN TRANSACTION");
       std::vector<String> data;
       for (Size k = 0; k < chroms.size(); k++)
       {
         const MSChromatogram& chrom = chroms[k];
         insert_chrom_sql << "INSERT INTO CHROMATOGRAM (ID, RUN_ID, NATIVE_ID) VALUES (" << chrom_id_ << "," << run_id_ << ",'" << chrom.getNativeID() << "'); ";
 
-        OpenMS::Precursor prec = chrom.getPrecursor();
+        const OpenMS::Precursor& prec = chrom.getPrecursor();
         // see src/openms/include/OpenMS/METADATA/Precursor.h for activation modes
         int activation_method = -1;
         if (!prec.getActivationMethods().empty() )
@@ -1324,7 +1435,7 @@ namespace OpenMS::Internal
             "," << activation_method << "); ";
         }
 
-        OpenMS::Product prod = chrom.getProduct();
+        const OpenMS::Product& prod = chrom.getProduct();
         insert_product_sql << "INSERT INTO PRODUCT (CHROMATOGRAM_ID, CHARGE, ISOLATION_TARGET, " << 
           "ISOLATION_LOWER, ISOLATION_UPPER) VALUES (" << 
           chrom_id_ << "," << 0 << "," << prod.getMZ() << 
@@ -1335,7 +1446,7 @@ namespace OpenMS::Internal
 
         // encode retention time data (zlib or np-linear + zlib)
         {
-          data.push_back(encoded_strings_rt[k]);
+          data.push_back(std::move(encoded_strings_rt[k]));
           if (use_lossy_compression_)
           {
             prepare_statement += String("(") + chrom_id_ + ", 2, 5, ?" + sql_it++ + " ),";
@@ -1348,7 +1459,7 @@ namespace OpenMS::Internal
 
         // encode intensity data (zlib or np-slof + zlib)
         {
-          data.push_back(encoded_strings_int[k]);
+          data.push_back(std::move(encoded_strings_int[k]));
           if (use_lossy_compression_)
           {
             prepare_statement += String("(") + chrom_id_ + ", 1, 6, ?" + sql_it++ + " ),";
@@ -1383,7 +1494,6 @@ namespace OpenMS::Internal
         conn.executeBindStatement(prepare_statement, data);
       }
 
-      conn.executeStatement("BEGIN TRANSACTION");
       conn.executeStatement(insert_chrom_sql.str());
       conn.executeStatement(insert_precursor_sql.str());
       conn.executeStatement(insert_product_sql.str());
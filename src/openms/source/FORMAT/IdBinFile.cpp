@@ -0,0 +1,877 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/IdBinFile.h>
+
+#include <OpenMS/CHEMISTRY/ProteaseDB.h>
+#include <OpenMS/CONCEPT/Constants.h>
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <QtCore/QFile>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+using namespace std;
+
+namespace OpenMS
+{
+  namespace
+  {
+    using UInt8 = std::uint8_t;
+
+    /*
+      File layout (all numbers in the byte order of the writing machine):
+
+      header:   magic[8] | UInt32 version | UInt32 byte order mark |
+                UInt64 n_strings | UInt64 string offsets | UInt64 string data |
+                UInt64 n_proteins | UInt64 proteins |
+                UInt64 n_peptides | UInt64 peptide offsets |
+                UInt64 n_index | UInt64 index
+      proteins: n_proteins protein identification records
+      peptides: n_peptides peptide identification records
+      peptide offsets: n_peptides x UInt64 (file offset of each peptide record)
+      index:    n_index x (UInt32 string id of the spectrum reference, UInt32 0, UInt64 peptide index), sorted by reference
+      string offsets: (n_strings + 1) x UInt64 (relative to the string data)
+      string data: all strings, concatenated
+
+      All strings in the records are stored as UInt32 ids into the string table.
+    */
+    const char MAGIC[8] = {'O', 'M', 'S', 'I', 'D', 'B', 'I', 'N'};
+    const UInt32 VERSION = 1;
+    const UInt32 BYTE_ORDER_MARK = 0x01020304;
+    const Size HEADER_SIZE = sizeof(MAGIC) + 2 * sizeof(UInt32) + 9 * sizeof(UInt64);
+
+    /// Serializes records into a memory buffer and interns all strings
+    class Writer
+    {
+    public:
+      std::string buffer;
+      std::vector<const std::string*> strings;
+
+      template <typename T>
+      void put(T value)
+      {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+      }
+
+      template <typename T>
+      void putAt(Size pos, T value)
+      {
+        memcpy(&buffer[pos], &value, sizeof(T));
+      }
+
+      UInt32 intern(const std::string& s)
+      {
+        auto it = ids_.find(s);
+        if (it == ids_.end())
+        {
+          it = ids_.emplace(s, UInt32(strings.size())).first;
+          strings.push_back(&it->first); // node based map: the pointer stays valid
+        }
+        return it->second;
+      }
+
+      void putString(const std::string& s)
+      {
+        put<UInt32>(intern(s));
+      }
+
+      void putStringList(const std::vector<String>& list)
+      {
+        put<UInt32>(UInt32(list.size()));
+        for (const String& s : list)
+        {
+          putString(s);
+        }
+      }
+
+      void putDataValue(const DataValue& value)
+      {
+        put<UInt8>(UInt8(value.valueType()));
+        put<UInt8>(value.hasUnit() ? 1 : 0);
+        if (value.hasUnit())
+        {
+          put<UInt8>(UInt8(value.getUnitType()));
+          put<Int32>(value.getUnit());
+        }
+        switch (value.valueType())
+        {
+          case DataValue::STRING_VALUE:
+            putString(value.toString());
+            break;
+          case DataValue::INT_VALUE:
+            put<Int64>(Int64(SignedSize(value)));
+            break;
+          case DataValue::DOUBLE_VALUE:
+            put<double>(double(value));
+            break;
+          case DataValue::STRING_LIST:
+            putStringList(value.toStringList());
+            break;
+          case DataValue::INT_LIST:
+          {
+            const IntList list = value.toIntList();
+            put<UInt32>(UInt32(list.size()));
+            for (Int i : list)
+            {
+              put<Int64>(Int64(i));
+            }
+            break;
+          }
+          case DataValue::DOUBLE_LIST:
+          {
+            const DoubleList list = value.toDoubleList();
+            put<UInt32>(UInt32(list.size()));
+            for (double d : list)
+            {
+              put<double>(d);
+            }
+            break;
+          }
+          default: // empty
+            break;
+        }
+      }
+
+      void putMetaInfo(const MetaInfoInterface& meta)
+      {
+        std::vector<String> keys;
+        meta.getKeys(keys);
+        put<UInt32>(UInt32(keys.size()));
+        for (const String& key : keys)
+        {
+          putString(key);
+          putDataValue(meta.getMetaValue(key));
+        }
+      }
+
+      void putProteinGroups(const std::vector<ProteinIdentification::ProteinGroup>& groups)
+      {
+        put<UInt64>(groups.size());
+        for (const auto& group : groups)
+        {
+          put<double>(group.probability);
+          putStringList(group.accessions);
+        }
+      }
+
+      void putProteinIdentification(const ProteinIdentification& id)
+      {
+        putString(id.getIdentifier());
+        putString(id.getSearchEngine());
+        putString(id.getSearchEngineVersion());
+        putString(id.getDateTime().isValid() ? id.getDateTime().get() : String());
+        putString(id.getScoreType());
+        put<UInt8>(id.isHigherScoreBetter() ? 1 : 0);
+        put<double>(id.getSignificanceThreshold());
+
+        const ProteinIdentification::SearchParameters& sp = id.getSearchParameters();
+        putString(sp.db);
+        putString(sp.db_version);
+        putString(sp.taxonomy);
+        putString(sp.charges);
+        put<UInt8>(UInt8(sp.mass_type));
+        putStringList(sp.fixed_modifications);
+        putStringList(sp.variable_modifications);
+        put<UInt32>(sp.missed_cleavages);
+        put<double>(sp.fragment_mass_tolerance);
+        put<UInt8>(sp.fragment_mass_tolerance_ppm ? 1 : 0);
+        put<double>(sp.precursor_mass_tolerance);
+        put<UInt8>(sp.precursor_mass_tolerance_ppm ? 1 : 0);
+        putString(sp.digestion_enzyme.getName());
+        put<UInt8>(UInt8(sp.enzyme_term_specificity));
+        putMetaInfo(sp);
+
+        put<UInt64>(id.getHits().size());
+        for (const ProteinHit& hit : id.getHits())
+        {
+          put<double>(hit.getScore());
+          put<UInt32>(hit.getRank());
+          putString(hit.getAccession());
+          putString(hit.getSequence());
+          put<double>(hit.getCoverage());
+          putMetaInfo(hit);
+        }
+        putProteinGroups(id.getProteinGroups());
+        putProteinGroups(id.getIndistinguishableProteins());
+        putMetaInfo(id);
+      }
+
+      void putPeptideIdentification(const PeptideIdentification& id)
+      {
+        putString(id.getIdentifier());
+        putString(id.getScoreType());
+        putString(id.getBaseName());
+        put<UInt8>(id.isHigherScoreBetter() ? 1 : 0);
+        put<double>(id.getSignificanceThreshold());
+        put<double>(id.getMZ());
+        put<double>(id.getRT());
+        putMetaInfo(id);
+
+        put<UInt32>(UInt32(id.getHits().size()));
+        for (const PeptideHit& hit : id.getHits())
+        {
+          putString(hit.getSequence().toString());
+          put<double>(hit.getScore());
+          put<UInt32>(hit.getRank());
+          put<Int32>(hit.getCharge());
+
+          put<UInt32>(UInt32(hit.getPeptideEvidences().size()));
+          for (const PeptideEvidence& pe : hit.getPeptideEvidences())
+          {
+            putString(pe.getProteinAccession());
+            put<Int32>(pe.getStart());
+            put<Int32>(pe.getEnd());
+            put<char>(pe.getAABefore());
+            put<char>(pe.getAAAfter());
+          }
+
+          put<UInt32>(UInt32(hit.getAnalysisResults().size()));
+          for (const PeptideHit::PepXMLAnalysisResult& ar : hit.getAnalysisResults())
+          {
+            putString(ar.score_type);
+            put<UInt8>(ar.higher_is_better ? 1 : 0);
+            put<double>(ar.main_score);
+            put<UInt32>(UInt32(ar.sub_scores.size()));
+            for (const auto& [name, score] : ar.sub_scores)
+            {
+              putString(name);
+              put<double>(score);
+            }
+          }
+
+          put<UInt32>(UInt32(hit.getPeakAnnotations().size()));
+          for (const PeptideHit::PeakAnnotation& pa : hit.getPeakAnnotations())
+          {
+            putString(pa.annotation);
+            put<Int32>(pa.charge);
+            put<double>(pa.mz);
+            put<double>(pa.intensity);
+          }
+
+          putMetaInfo(hit);
+        }
+      }
+
+    private:
+      std::unordered_map<std::string, UInt32> ids_;
+    };
+  }
+
+  struct IdBinFile::Cursor
+  {
+    const char* data;
+    Size size;
+    Size pos;
+    const String& filename;
+
+    void require(Size n) const
+    {
+      if (pos > size || n > size - pos)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Unexpected end of file at offset " + String(pos));
+      }
+    }
+
+    template <typename T>
+    T get()
+    {
+      require(sizeof(T));
+      T value;
+      memcpy(&value, data + pos, sizeof(T));
+      pos += sizeof(T);
+      return value;
+    }
+  };
+
+  IdBinFile::IdBinFile() = default;
+
+  IdBinFile::~IdBinFile()
+  {
+    close();
+  }
+
+  bool IdBinFile::isIdBinFile(const String& filename)
+  {
+    ifstream ifs(filename.c_str(), ios::binary);
+    char magic[sizeof(MAGIC)];
+    if (!ifs.read(magic, sizeof(MAGIC)))
+    {
+      return false;
+    }
+    return memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+  }
+
+  void IdBinFile::store(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids)
+  {
+    Writer w;
+    w.buffer.reserve(HEADER_SIZE + 256 * peptide_ids.size());
+    w.buffer.resize(HEADER_SIZE); // filled at the end
+
+    startProgress(0, peptide_ids.size(), "storing idbin file");
+    const UInt64 proteins = w.buffer.size();
+    for (const ProteinIdentification& id : protein_ids)
+    {
+      w.putProteinIdentification(id);
+    }
+
+    std::vector<UInt64> peptide_offsets;
+    peptide_offsets.reserve(peptide_ids.size());
+    // (string id, peptide index) of all peptide ids with spectrum reference
+    std::vector<std::pair<UInt32, UInt64>> index;
+    for (Size i = 0; i < peptide_ids.size(); ++i)
+    {
+      setProgress(i);
+      peptide_offsets.push_back(w.buffer.size());
+      w.putPeptideIdentification(peptide_ids[i]);
+      if (peptide_ids[i].metaValueExists(Constants::UserParam::SPECTRUM_REFERENCE))
+      {
+        index.emplace_back(w.intern(peptide_ids[i].getSpectrumReference()), i);
+      }
+    }
+    endProgress();
+
+    const UInt64 peptide_offsets_pos = w.buffer.size();
+    for (UInt64 offset : peptide_offsets)
+    {
+      w.put<UInt64>(offset);
+    }
+
+    std::stable_sort(index.begin(), index.end(), [&w](const std::pair<UInt32, UInt64>& a, const std::pair<UInt32, UInt64>& b)
+    {
+      return *w.strings[a.first] < *w.strings[b.first];
+    });
+    const UInt64 index_pos = w.buffer.size();
+    for (const auto& [string_id, peptide] : index)
+    {
+      w.put<UInt32>(string_id);
+      w.put<UInt32>(0);
+      w.put<UInt64>(peptide);
+    }
+
+    const UInt64 string_offsets_pos = w.buffer.size();
+    UInt64 offset = 0;
+    for (const std::string* s : w.strings)
+    {
+      w.put<UInt64>(offset);
+      offset += s->size();
+    }
+    w.put<UInt64>(offset);
+    const UInt64 string_data_pos = w.buffer.size();
+    w.buffer.reserve(w.buffer.size() + offset);
+    for (const std::string* s : w.strings)
+    {
+      w.buffer.append(*s);
+    }
+
+    // header
+    memcpy(&w.buffer[0], MAGIC, sizeof(MAGIC));
+    Size pos = sizeof(MAGIC);
+    w.putAt<UInt32>(pos, VERSION); pos += sizeof(UInt32);
+    w.putAt<UInt32>(pos, BYTE_ORDER_MARK); pos += sizeof(UInt32);
+    for (UInt64 value : {UInt64(w.strings.size()), string_offsets_pos, string_data_pos,
+                         UInt64(protein_ids.size()), proteins,
+                         UInt64(peptide_ids.size()), peptide_offsets_pos,
+                         UInt64(index.size()), index_pos})
+    {
+      w.putAt<UInt64>(pos, value);
+      pos += sizeof(UInt64);
+    }
+
+    ofstream ofs(filename.c_str(), ios::binary | ios::trunc);
+    if (!ofs)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    ofs.write(w.buffer.data(), w.buffer.size());
+    if (!ofs)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Error while writing");
+    }
+  }
+
+  void IdBinFile::load(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids)
+  {
+    open(filename);
+
+    getProteinIdentifications(protein_ids);
+
+    // records are stored back to back, read them sequentially
+    peptide_ids.clear();
+    peptide_ids.resize(n_peptides_);
+    startProgress(0, n_peptides_, "loading idbin file");
+    if (n_peptides_ > 0)
+    {
+      Cursor offsets{data_, size_, Size(peptide_offsets_), filename_};
+      Cursor c{data_, size_, Size(offsets.get<UInt64>()), filename_};
+      for (Size i = 0; i < peptide_ids.size(); ++i)
+      {
+        setProgress(i);
+        readPeptideIdentification_(c, peptide_ids[i]);
+      }
+    }
+    endProgress();
+
+    close();
+  }
+
+  void IdBinFile::open(const String& filename)
+  {
+    close();
+    openFile_(filename);
+  }
+
+  void IdBinFile::close()
+  {
+    if (mapped_file_ != nullptr)
+    {
+      mapped_file_->close(); // also unmaps
+      mapped_file_.reset();
+    }
+    buffer_ = std::string();
+    data_ = nullptr;
+    size_ = 0;
+    n_strings_ = n_proteins_ = n_peptides_ = n_index_ = 0;
+    strings_ = std::vector<String>();
+    string_decoded_ = std::vector<bool>();
+    sequences_.clear();
+  }
+
+  bool IdBinFile::isOpen() const
+  {
+    return data_ != nullptr;
+  }
+
+  Size IdBinFile::getNrProteinIdentifications() const
+  {
+    return n_proteins_;
+  }
+
+  Size IdBinFile::getNrPeptideIdentifications() const
+  {
+    return n_peptides_;
+  }
+
+  void IdBinFile::getProteinIdentifications(std::vector<ProteinIdentification>& protein_ids)
+  {
+    checkOpen_();
+    protein_ids.clear();
+    protein_ids.resize(n_proteins_);
+    Cursor c{data_, size_, Size(proteins_), filename_};
+    for (ProteinIdentification& id : protein_ids)
+    {
+      readProteinIdentification_(c, id);
+    }
+  }
+
+  void IdBinFile::getPeptideIdentification(Size index, PeptideIdentification& peptide_id)
+  {
+    checkOpen_();
+    if (index >= n_peptides_)
+    {
+      throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, index, n_peptides_);
+    }
+    Cursor offsets{data_, size_, Size(peptide_offsets_ + index * sizeof(UInt64)), filename_};
+    Cursor c{data_, size_, Size(offsets.get<UInt64>()), filename_};
+    peptide_id = PeptideIdentification();
+    readPeptideIdentification_(c, peptide_id);
+  }
+
+  std::vector<Size> IdBinFile::findBySpectrumReference(const String& spectrum_reference)
+  {
+    checkOpen_();
+    const Size entry_size = 2 * sizeof(UInt32) + sizeof(UInt64);
+    auto entryAt = [this, entry_size](Size i, UInt32& string_id, UInt64& peptide)
+    {
+      Cursor c{data_, size_, Size(index_ + i * entry_size), filename_};
+      string_id = c.get<UInt32>();
+      c.get<UInt32>();
+      peptide = c.get<UInt64>();
+    };
+
+    // binary search for the first entry not less than the reference
+    Size first = 0, count = n_index_;
+    UInt32 string_id;
+    UInt64 peptide;
+    while (count > 0)
+    {
+      const Size step = count / 2;
+      entryAt(first + step, string_id, peptide);
+      if (string_(string_id) < spectrum_reference)
+      {
+        first += step + 1;
+        count -= step + 1;
+      }
+      else
+      {
+        count = step;
+      }
+    }
+
+    std::vector<Size> result;
+    for (Size i = first; i < n_index_; ++i)
+    {
+      entryAt(i, string_id, peptide);
+      if (string_(string_id) != spectrum_reference)
+      {
+        break;
+      }
+      result.push_back(peptide);
+    }
+    return result;
+  }
+
+  void IdBinFile::openFile_(const String& filename)
+  {
+    filename_ = filename;
+    auto file = std::make_unique<QFile>(filename.toQString());
+    if (!file->open(QIODevice::ReadOnly))
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    const qint64 file_size = file->size();
+    const uchar* mapped = file_size > 0 ? file->map(0, file_size) : nullptr;
+    if (mapped != nullptr)
+    {
+      data_ = reinterpret_cast<const char*>(mapped);
+      size_ = Size(file_size);
+      mapped_file_ = std::move(file);
+    }
+    else
+    {
+      // e.g. address space exhaustion on 32 bit systems: read the file instead
+      file->close();
+      ifstream ifs(filename.c_str(), ios::binary);
+      buffer_.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+      data_ = buffer_.data();
+      size_ = buffer_.size();
+    }
+
+    Cursor c{data_, size_, 0, filename_};
+    c.require(HEADER_SIZE);
+    if (memcmp(data_, MAGIC, sizeof(MAGIC)) != 0)
+    {
+      close();
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Not an idbin file");
+    }
+    c.pos = sizeof(MAGIC);
+    const UInt32 version = c.get<UInt32>();
+    const UInt32 byte_order = c.get<UInt32>();
+    if (byte_order != BYTE_ORDER_MARK || version != VERSION)
+    {
+      close();
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Unsupported idbin version or byte order");
+    }
+    n_strings_ = c.get<UInt64>();
+    string_offsets_ = c.get<UInt64>();
+    string_data_ = c.get<UInt64>();
+    n_proteins_ = c.get<UInt64>();
+    proteins_ = c.get<UInt64>();
+    n_peptides_ = c.get<UInt64>();
+    peptide_offsets_ = c.get<UInt64>();
+    n_index_ = c.get<UInt64>();
+    index_ = c.get<UInt64>();
+
+    // the tables need to fit into the file
+    auto checkTable = [this](UInt64 pos, UInt64 n, UInt64 entry_size)
+    {
+      if (pos > size_ || n > (size_ - pos) / entry_size)
+      {
+        const String filename = filename_;
+        close();
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Corrupt idbin file (table exceeds file size)");
+      }
+    };
+    checkTable(string_offsets_, n_strings_ + 1, sizeof(UInt64));
+    checkTable(peptide_offsets_, n_peptides_, sizeof(UInt64));
+    checkTable(index_, n_index_, 2 * sizeof(UInt32) + sizeof(UInt64));
+    checkTable(string_data_, 0, 1);
+
+    strings_.resize(n_strings_);
+    string_decoded_.assign(n_strings_, false);
+  }
+
+  void IdBinFile::checkOpen_() const
+  {
+    if (!isOpen())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No idbin file opened");
+    }
+  }
+
+  const String& IdBinFile::string_(UInt32 id)
+  {
+    if (id >= n_strings_)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_, "Invalid string id " + String(id));
+    }
+    if (!string_decoded_[id])
+    {
+      Cursor c{data_, size_, Size(string_offsets_ + id * sizeof(UInt64)), filename_};
+      const UInt64 begin = c.get<UInt64>();
+      const UInt64 end = c.get<UInt64>();
+      if (end < begin)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_, "Corrupt string table");
+      }
+      Cursor s{data_, size_, Size(string_data_ + begin), filename_};
+      s.require(end - begin);
+      strings_[id].assign(data_ + s.pos, end - begin);
+      string_decoded_[id] = true;
+    }
+    return strings_[id];
+  }
+
+  const AASequence& IdBinFile::sequence_(UInt32 id)
+  {
+    auto it = sequences_.find(id);
+    if (it == sequences_.end())
+    {
+      it = sequences_.emplace(id, AASequence::fromString(string_(id))).first;
+    }
+    return it->second;
+  }
+
+  void IdBinFile::readStringList_(Cursor& c, StringList& list)
+  {
+    const UInt32 n = c.get<UInt32>();
+    c.require(Size(n) * sizeof(UInt32));
+    list.resize(n);
+    for (String& s : list)
+    {
+      s = string_(c.get<UInt32>());
+    }
+  }
+
+  DataValue IdBinFile::readDataValue_(Cursor& c)
+  {
+    const UInt8 type = c.get<UInt8>();
+    const bool has_unit = c.get<UInt8>() != 0;
+    UInt8 unit_type = 0;
+    Int32 unit = -1;
+    if (has_unit)
+    {
+      unit_type = c.get<UInt8>();
+      unit = c.get<Int32>();
+    }
+
+    DataValue value;
+    switch (type)
+    {
+      case DataValue::STRING_VALUE:
+        value = DataValue(string_(c.get<UInt32>()));
+        break;
+      case DataValue::INT_VALUE:
+        value = DataValue(SignedSize(c.get<Int64>()));
+        break;
+      case DataValue::DOUBLE_VALUE:
+        value = DataValue(c.get<double>());
+        break;
+      case DataValue::STRING_LIST:
+      {
+        StringList list;
+        readStringList_(c, list);
+        value = DataValue(list);
+        break;
+      }
+      case DataValue::INT_LIST:
+      {
+        const UInt32 n = c.get<UInt32>();
+        c.require(Size(n) * sizeof(Int64));
+        IntList list(n);
+        for (Int& i : list)
+        {
+          i = Int(c.get<Int64>());
+        }
+        value = DataValue(list);
+        break;
+      }
+      case DataValue::DOUBLE_LIST:
+      {
+        const UInt32 n = c.get<UInt32>();
+        c.require(Size(n) * sizeof(double));
+        DoubleList list(n);
+        for (double& d : list)
+        {
+          d = c.get<double>();
+        }
+        value = DataValue(list);
+        break;
+      }
+      case DataValue::EMPTY_VALUE:
+        break;
+      default:
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_, "Invalid meta value type " + String(Int(type)));
+    }
+    if (has_unit)
+    {
+      value.setUnitType(DataValue::UnitType(unit_type));
+      value.setUnit(unit);
+    }
+    return value;
+  }
+
+  void IdBinFile::readMetaInfo_(Cursor& c, MetaInfoInterface& meta)
+  {
+    const UInt32 n = c.get<UInt32>();
+    for (UInt32 i = 0; i < n; ++i)
+    {
+      const String& key = string_(c.get<UInt32>());
+      meta.setMetaValue(key, readDataValue_(c));
+    }
+  }
+
+  void IdBinFile::readProteinIdentification_(Cursor& c, ProteinIdentification& id)
+  {
+    id.setIdentifier(string_(c.get<UInt32>()));
+    id.setSearchEngine(string_(c.get<UInt32>()));
+    id.setSearchEngineVersion(string_(c.get<UInt32>()));
+    const String& date = string_(c.get<UInt32>());
+    if (!date.empty())
+    {
+      DateTime dt;
+      dt.set(date);
+      id.setDateTime(dt);
+    }
+    id.setScoreType(string_(c.get<UInt32>()));
+    id.setHigherScoreBetter(c.get<UInt8>() != 0);
+    id.setSignificanceThreshold(c.get<double>());
+
+    ProteinIdentification::SearchParameters& sp = id.getSearchParameters();
+    sp.db = string_(c.get<UInt32>());
+    sp.db_version = string_(c.get<UInt32>());
+    sp.taxonomy = string_(c.get<UInt32>());
+    sp.charges = string_(c.get<UInt32>());
+    const UInt8 mass_type = c.get<UInt8>();
+    if (mass_type >= ProteinIdentification::SIZE_OF_PEAKMASSTYPE)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_, "Invalid mass type");
+    }
+    sp.mass_type = ProteinIdentification::PeakMassType(mass_type);
+    readStringList_(c, sp.fixed_modifications);
+    readStringList_(c, sp.variable_modifications);
+    sp.missed_cleavages = c.get<UInt32>();
+    sp.fragment_mass_tolerance = c.get<double>();
+    sp.fragment_mass_tolerance_ppm = c.get<UInt8>() != 0;
+    sp.precursor_mass_tolerance = c.get<double>();
+    sp.precursor_mass_tolerance_ppm = c.get<UInt8>() != 0;
+    const String& enzyme = string_(c.get<UInt32>());
+    if (enzyme != sp.digestion_enzyme.getName() && ProteaseDB::getInstance()->hasEnzyme(enzyme))
+    {
+      sp.digestion_enzyme = *(ProteaseDB::getInstance()->getEnzyme(enzyme));
+    }
+    const UInt8 specificity = c.get<UInt8>();
+    if (specificity >= EnzymaticDigestion::SIZE_OF_SPECIFICITY)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_, "Invalid enzyme specificity");
+    }
+    sp.enzyme_term_specificity = EnzymaticDigestion::Specificity(specificity);
+    readMetaInfo_(c, sp);
+
+    const UInt64 n_hits = c.get<UInt64>();
+    std::vector<ProteinHit>& hits = id.getHits();
+    hits.resize(n_hits);
+    for (ProteinHit& hit : hits)
+    {
+      hit.setScore(c.get<double>());
+      hit.setRank(c.get<UInt32>());
+      hit.setAccession(string_(c.get<UInt32>()));
+      hit.setSequence(string_(c.get<UInt32>()));
+      hit.setCoverage(c.get<double>());
+      readMetaInfo_(c, hit);
+    }
+
+    for (auto* groups : {&id.getProteinGroups(), &id.getIndistinguishableProteins()})
+    {
+      const UInt64 n_groups = c.get<UInt64>();
+      groups->resize(n_groups);
+      for (auto& group : *groups)
+      {
+        group.probability = c.get<double>();
+        readStringList_(c, group.accessions);
+      }
+    }
+    readMetaInfo_(c, id);
+  }
+
+  void IdBinFile::readPeptideIdentification_(Cursor& c, PeptideIdentification& id)
+  {
+    id.setIdentifier(string_(c.get<UInt32>()));
+    id.setScoreType(string_(c.get<UInt32>()));
+    id.setBaseName(string_(c.get<UInt32>()));
+    id.setHigherScoreBetter(c.get<UInt8>() != 0);
+    id.setSignificanceThreshold(c.get<double>());
+    id.setMZ(c.get<double>());
+    id.setRT(c.get<double>());
+    readMetaInfo_(c, id);
+
+    const UInt32 n_hits = c.get<UInt32>();
+    std::vector<PeptideHit>& hits = id.getHits();
+    hits.resize(n_hits);
+    for (PeptideHit& hit : hits)
+    {
+      hit.setSequence(sequence_(c.get<UInt32>()));
+      hit.setScore(c.get<double>());
+      hit.setRank(c.get<UInt32>());
+      hit.setCharge(c.get<Int32>());
+
+      const UInt32 n_evidences = c.get<UInt32>();
+      std::vector<PeptideEvidence> evidences;
+      evidences.reserve(n_evidences);
+      for (UInt32 i = 0; i < n_evidences; ++i)
+      {
+        const String& accession = string_(c.get<UInt32>());
+        const Int start = c.get<Int32>();
+        const Int end = c.get<Int32>();
+        const char aa_before = c.get<char>();
+        const char aa_after = c.get<char>();
+        evidences.emplace_back(accession, start, end, aa_before, aa_after);
+      }
+      hit.setPeptideEvidences(std::move(evidences));
+
+      const UInt32 n_results = c.get<UInt32>();
+      if (n_results > 0)
+      {
+        std::vector<PeptideHit::PepXMLAnalysisResult> results(n_results);
+        for (PeptideHit::PepXMLAnalysisResult& ar : results)
+        {
+          ar.score_type = string_(c.get<UInt32>());
+          ar.higher_is_better = c.get<UInt8>() != 0;
+          ar.main_score = c.get<double>();
+          const UInt32 n_sub = c.get<UInt32>();
+          for (UInt32 i = 0; i < n_sub; ++i)
+          {
+            const String& name = string_(c.get<UInt32>());
+            ar.sub_scores[name] = c.get<double>();
+          }
+        }
+        hit.setAnalysisResults(std::move(results));
+      }
+
+      const UInt32 n_annotations = c.get<UInt32>();
+      if (n_annotations > 0)
+      {
+        std::vector<PeptideHit::PeakAnnotation> annotations(n_annotations);
+        for (PeptideHit::PeakAnnotation& pa : annotations)
+        {
+          pa.annotation = string_(c.get<UInt32>());
+          pa.charge = c.get<Int32>();
+          pa.mz = c.get<double>();
+          pa.intensity = c.get<double>();
+        }
+        hit.setPeakAnnotations(std::move(annotations));
+      }
+
+      readMetaInfo_(c, hit);
+    }
+  }
+
+} // namespace OpenMS
@@ -67,6 +67,7 @@ namespace OpenMS
     pep_id_ = PeptideIdentification();
     prot_hit_ = ProteinHit();
     pep_hit_ = PeptideHit();
+    sequence_cache_.clear();
     proteinid_to_accession_.clear();
 
     endProgress();
@@ -430,6 +431,7 @@ namespace OpenMS
     pep_id_ = PeptideIdentification();
     prot_hit_ = ProteinHit();
     pep_hit_ = PeptideHit();
+    sequence_cache_.clear();
     proteinid_to_accession_.clear();
   }
 
@@ -640,7 +642,7 @@ namespace OpenMS
 
       pep_hit_.setCharge(attributeAsInt_(attributes, "charge"));
       pep_hit_.setScore(attributeAsDouble_(attributes, "score"));
-      pep_hit_.setSequence(AASequence::fromString(String(attributeAsString_(attributes, "sequence"))));
+      pep_hit_.setSequence(sequence_cache_.fromString(String(attributeAsString_(attributes, "sequence"))));
 
       //parse optional protein ids to determine accessions
       const XMLCh* refs = attributes.getValue(sm_.convert("protein_refs").c_str());
@@ -0,0 +1,152 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/InMemoryFileStore.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/KERNEL/ConsensusMap.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <variant>
+
+using namespace std;
+
+namespace OpenMS
+{
+  namespace
+  {
+    using StoredMap_ = variant<shared_ptr<const MSExperiment>, shared_ptr<const FeatureMap>, shared_ptr<const ConsensusMap> >;
+
+    mutex& storeMutex_()
+    {
+      static mutex m;
+      return m;
+    }
+
+    map<String, StoredMap_>& storedMaps_()
+    {
+      static map<String, StoredMap_> maps;
+      return maps;
+    }
+
+    template <typename MapType>
+    bool storeMap_(const String& filename, const MapType& data)
+    {
+      if (!InMemoryFileStore::isInMemory(filename))
+      {
+        return false;
+      }
+      StoredMap_ copy = make_shared<const MapType>(data); // copy outside of the lock
+      lock_guard<mutex> lock(storeMutex_());
+      storedMaps_()[filename] = std::move(copy);
+      return true;
+    }
+
+    template <typename MapType>
+    bool loadMap_(const String& filename, MapType& data)
+    {
+      if (!InMemoryFileStore::isInMemory(filename))
+      {
+        return false;
+      }
+      shared_ptr<const MapType> stored;
+      {
+        lock_guard<mutex> lock(storeMutex_());
+        auto it = storedMaps_().find(filename);
+        if (it == storedMaps_().end())
+        {
+          throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+        }
+        if (!holds_alternative<shared_ptr<const MapType> >(it->second))
+        {
+          throw Exception::InvalidFileType(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "in-memory file holds another kind of data");
+        }
+        stored = get<shared_ptr<const MapType> >(it->second);
+      }
+      data = *stored; // the stored map stays valid even if it is removed meanwhile
+      return true;
+    }
+  }
+
+  const String InMemoryFileStore::PREFIX = "mem://";
+
+  bool InMemoryFileStore::isInMemory(const String& filename)
+  {
+    return filename.hasPrefix(PREFIX);
+  }
+
+  bool InMemoryFileStore::contains(const String& filename)
+  {
+    lock_guard<mutex> lock(storeMutex_());
+    return storedMaps_().count(filename) > 0;
+  }
+
+  bool InMemoryFileStore::store(const String& filename, const MSExperiment& exp)
+  {
+    return storeMap_(filename, exp);
+  }
+
+  bool InMemoryFileStore::store(const String& filename, const FeatureMap& map)
+  {
+    return storeMap_(filename, map);
+  }
+
+  bool InMemoryFileStore::store(const String& filename, const ConsensusMap& map)
+  {
+    return storeMap_(filename, map);
+  }
+
+  bool InMemoryFileStore::load(const String& filename, MSExperiment& exp)
+  {
+    return loadMap_(filename, exp);
+  }
+
+  bool InMemoryFileStore::load(const String& filename, FeatureMap& map)
+  {
+    return loadMap_(filename, map);
+  }
+
+  bool InMemoryFileStore::load(const String& filename, ConsensusMap& map)
+  {
+    return loadMap_(filename, map);
+  }
+
+  void InMemoryFileStore::remove(const String& filename)
+  {
+    StoredMap_ removed; // destroyed after unlocking
+    lock_guard<mutex> lock(storeMutex_());
+    auto it = storedMaps_().find(filename);
+    if (it != storedMaps_().end())
+    {
+      removed = std::move(it->second);
+      storedMaps_().erase(it);
+    }
+  }
+
+  void InMemoryFileStore::clear()
+  {
+    map<String, StoredMap_> removed;
+    lock_guard<mutex> lock(storeMutex_());
+    removed.swap(storedMaps_());
+  }
+
+  vector<String> InMemoryFileStore::getFileNames()
+  {
+    vector<String> names;
+    lock_guard<mutex> lock(storeMutex_());
+    for (const auto& entry : storedMaps_())
+    {
+      names.push_back(entry.first);
+    }
+    return names;
+  }
+}
@@ -33,6 +33,7 @@
 #include <algorithm>  // for min() and max() in VS2013
 #include <climits>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <OpenMS/FORMAT/MSNUMPRESS/MSNumpress.h>
 
@@ -235,6 +236,59 @@ static void decodeInt(
 
 /////////////////////////////////////////////////////////////
 
+/**
+ * Fast path of decodeInt with identical results: instead of reading the
+ * int half byte by half byte, the next 8 bytes are loaded at once and the
+ * half bytes of the int are extracted with a few bit operations.
+ *
+ * Requires *di + 8 <= max_di (no bounds checks are necessary then).
+ */
+static inline void decodeIntFast(
+		const unsigned char *data,
+		size_t *di,
+		size_t *half,
+		unsigned int *res
+) {
+	const unsigned char *d = &data[*di];
+	// big endian load: the first half byte of the stream is the most significant one
+	uint64_t w = (uint64_t(d[0]) << 56) | (uint64_t(d[1]) << 48) | (uint64_t(d[2]) << 40) | (uint64_t(d[3]) << 32) |
+	             (uint64_t(d[4]) << 24) | (uint64_t(d[5]) << 16) | (uint64_t(d[6]) << 8) | uint64_t(d[7]);
+	w <<= 4 * (*half); // skip the half byte which was already consumed
+
+	unsigned int head = static_cast<unsigned int>(w >> 60);
+	unsigned int n = (head <= 8) ? head : head - 8;
+	unsigned int count = 8 - n; // number of half bytes stored for the int
+
+	// the 8 half bytes following the head in reversed order (the least
+	// significant half byte is stored first): swap the half bytes within
+	// each byte, then swap the bytes
+	uint32_t t = static_cast<uint32_t>(w >> 28);
+	t = ((t & 0x0f0f0f0fu) << 4) | ((t >> 4) & 0x0f0f0f0fu);
+	t = (t >> 24) | ((t >> 8) & 0x0000ff00u) | ((t << 8) & 0x00ff0000u) | (t << 24);
+
+	unsigned int r = 0;
+	if (count == 8)
+	{
+		r = t;
+	}
+	else if (count > 0)
+	{
+		r = t & ((1u << (4 * count)) - 1);
+	}
+	if (head > 8)
+	{ // leading ones in the n most significant half bytes
+		r |= 0xffffffffu << (4 * count);
+	}
+	*res = r;
+
+	size_t pos = 2 * (*di) + (*half) + 1 + count;
+	*di = pos / 2;
+	*half = pos % 2;
+}
+
+
+
+
 double optimalLinearFixedPointMass(
 		const double *data, 
 		size_t dataSize,
@@ -477,7 +531,14 @@ size_t decodeLinear(
 		
 		ints[0] = ints[1];
 		ints[1] = ints[2];
-		decodeInt(data, &di, dataSize, &half, &buff);
+		if (di + 8 <= dataSize)
+		{
+			decodeIntFast(data, &di, &half, &buff);
+		}
+		else
+		{
+			decodeInt(data, &di, dataSize, &half, &buff);
+		}
 		diff = static_cast<int>(buff);
 
 		extrapol = ints[1] + (ints[1] - ints[0]);
@@ -711,7 +772,14 @@ size_t decodePic(
 			}
 		}
 		
-		decodeInt(&data[0], &di, dataSize, &half, &x);
+		if (di + 8 <= dataSize)
+		{
+			decodeIntFast(&data[0], &di, &half, &x);
+		}
+		else
+		{
+			decodeInt(&data[0], &di, dataSize, &half, &x);
+		}
 		
 		//printf("%7d %7d %7d %7d %7d\n", ri, di, half, dataSize, count);
 		
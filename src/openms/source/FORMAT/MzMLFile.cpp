@@ -17,8 +17,14 @@
 #include <OpenMS/FORMAT/TextFile.h>
 #include <OpenMS/FORMAT/DATAACCESS/MSDataTransformingConsumer.h>
 #include <OpenMS/FORMAT/HANDLERS/IndexedMzMLDecoder.h>
+#include <OpenMS/FORMAT/OffsetIndexFile.h>
 #include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
 
+#include <QtCore/QFile>
+
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 
 namespace OpenMS
@@ -145,9 +151,135 @@ namespace OpenMS
     map.setLoadedFileType(filename);
     map.setLoadedFilePath(filename);
 
+    if (options_.getSkimBinaryData() && skim_(filename, map))
+    {
+      map.placeMemory(TaskScheduler::getMemoryPlacement());
+      return;
+    }
+
     Internal::MzMLHandler handler(map, filename, getVersion(), *this);
-    handler.setOptions(options_);
+    PeakFileOptions options = options_;
+    if (options.getSkimBinaryData())
+    {
+      options.setFillData(false);
+    }
+    handler.setOptions(options);
     safeParse_(filename, &handler);
+
+    // the parser fills the spectra from a few threads; move them to the nodes of the processing threads
+    map.placeMemory(TaskScheduler::getMemoryPlacement());
+  }
+
+  bool MzMLFile::skim_(const String& filename, PeakMap& map)
+  {
+    if (!File::exists(filename))
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    // start offsets of all spectra and chromatograms: from the index or a pre-scan of the file
+    std::vector<Int64> spectra, chromatograms;
+    Int64 end = -1;
+    bool indexed = false;
+    std::streampos index_offset = IndexedMzMLDecoder().findIndexListOffset(filename);
+    if (index_offset != std::streampos(-1))
+    {
+      IndexedMzMLDecoder::OffsetVector spectra_offsets, chromatograms_offsets;
+      if (IndexedMzMLDecoder().parseOffsets(filename, index_offset, spectra_offsets, chromatograms_offsets) == 0)
+      {
+        for (const auto& off : spectra_offsets) spectra.push_back(off.second);
+        for (const auto& off : chromatograms_offsets) chromatograms.push_back(off.second);
+        end = index_offset;
+        indexed = true;
+      }
+    }
+    if (!indexed)
+    {
+      OffsetIndexFile index;
+      index.loadOrScan(filename, false);
+      if (index.getFileType() != FileTypes::MZML)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Not an mzML file", filename);
+      }
+      for (const auto& e : index.getSpectra()) spectra.push_back(e.offset);
+      for (const auto& e : index.getChromatograms()) chromatograms.push_back(e.offset);
+      end = Int64(File::fileSize(filename));
+    }
+    if (spectra.empty() && chromatograms.empty())
+    {
+      return false; // nothing to skip
+    }
+
+    QFile file(filename.toQString());
+    if (!file.open(QIODevice::ReadOnly) || file.size() < end)
+    {
+      return false;
+    }
+    const char* data = reinterpret_cast<const char*>(file.map(0, file.size()));
+    if (data == nullptr)
+    {
+      return false;
+    }
+    // the binary data pages of the mapping are never touched below
+
+    // everything before the first element (header, run, list start), each element up to its
+    // <binaryDataArrayList> (the last child of spectrum and chromatogram) and everything after
+    // the last element of each list
+    std::string buffer;
+    auto appendElements = [&](const std::vector<Int64>& offsets, Int64 list_end, const std::string& tag)
+    {
+      static const std::string binary_list = "<binaryDataArrayList";
+      const std::string closing = "</" + tag + ">";
+      for (Size i = 0; i < offsets.size(); ++i)
+      {
+        const char* begin = data + offsets[i];
+        const char* stop = data + (i + 1 < offsets.size() ? offsets[i + 1] : list_end);
+        const char* binary = std::search(begin, stop, binary_list.begin(), binary_list.end());
+        if (binary == stop)
+        {
+          buffer.append(begin, stop);
+          continue;
+        }
+        buffer.append(begin, binary);
+        buffer += closing;
+        if (i + 1 == offsets.size())
+        {
+          // list end (and start of the next list), searched backwards from the end
+          const char* last = stop - closing.size();
+          while (last >= binary && std::memcmp(last, closing.data(), closing.size()) != 0) --last;
+          if (last < binary)
+          {
+            throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Missing " + closing + " at end of " + tag + " list", filename);
+          }
+          buffer.append(last + closing.size(), stop);
+        }
+        else
+        {
+          buffer += '\n';
+        }
+      }
+    };
+
+    const Int64 first = spectra.empty() ? chromatograms.front() : spectra.front();
+    buffer.append(data, first);
+    appendElements(spectra, chromatograms.empty() ? end : chromatograms.front(), "spectrum");
+    appendElements(chromatograms, end, "chromatogram");
+    if (indexed)
+    {
+      buffer += "</indexedmzML>\n";
+    }
+    file.close();
+
+    map.reset();
+    map.setLoadedFileType(filename);
+    map.setLoadedFilePath(filename);
+
+    Internal::MzMLHandler handler(map, filename, getVersion(), *this);
+    PeakFileOptions options = options_;
+    options.setFillData(false);
+    handler.setOptions(options);
+    parseBuffer_(buffer, &handler);
+    return true;
   }
 
   void MzMLFile::store(const String& filename, const PeakMap& map) const
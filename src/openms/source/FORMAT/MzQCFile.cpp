@@ -17,14 +17,76 @@
 #include <OpenMS/QC/SpectrumCount.h>
 #include <OpenMS/QC/FeatureSummary.h>
 #include <OpenMS/QC/IdentificationSummary.h>
+#include <OpenMS/QC/QCMetricAccumulator.h>
 #include <nlohmann/json.hpp>
-#include <map>
+#include <cmath>
 #include <fstream>
+#include <map>
+#include <type_traits>
 
 using namespace std;
 
 namespace OpenMS
-{ 
+{
+  namespace
+  {
+    using json = nlohmann::ordered_json;
+
+    // header shared by run and set qualities: creationDate, version, contact and description
+    json mzQCHeader(const String& contact_name, const String& contact_address, const String& description)
+    {
+      json header;
+      // required: creationDate, version
+      header["creationDate"] = DateTime::now().toString().c_str();
+      header["version"] = "1.0.0";
+      // optional: contact_name, contact_address, description
+      if (!contact_name.empty())
+      {
+        header["contactName"] = contact_name.c_str();
+      }
+      if (!contact_address.empty())
+      {
+        header["contactAddress"] = contact_address.c_str();
+      }
+      if (!description.empty())
+      {
+        header["description"] = description.c_str();
+      }
+      return header;
+    }
+
+    json analysisSoftware()
+    {
+      VersionInfo::VersionDetails version = VersionInfo::getVersionStruct();
+      return
+      {
+        {
+          {"accession", "MS:1009001" }, // create new qc-cv for QCCalculator: MS:1009001 quality control metrics generating software
+          {"name", "QCCalculator"},
+          {"version", (String(version.version_major)+"."+String(version.version_minor)+"."+String(version.version_patch)).c_str()},
+          {"uri", "https://www.openms.de"}
+        }
+      };
+    }
+
+    json controlledVocabularies()
+    {
+      return
+      {
+        {
+          {"name", "Proteomics Standards Initiative Quality Control Ontology"},
+          {"uri", "https://raw.githubusercontent.com/HUPO-PSI/mzQC/master/cv/qc-cv.obo"},
+          {"version", "0.1.2"},
+        },
+        {
+          {"name", "Proteomics Standards Initiative Mass Spectrometry Ontology"},
+          {"uri", "http://purl.obolibrary.org/obo/ms/psi-ms.obo"},
+          {"version", "4.1.155"}
+        }
+      };
+    }
+  } // namespace
+
   void MzQCFile::store(const String& input_file,
                        const String& output_file,
                        const MSExperiment& exp,
@@ -34,7 +96,8 @@ namespace OpenMS
                        const String& label,
                        const FeatureMap& feature_map,
                        vector<ProteinIdentification>& prot_ids,
-                       vector<PeptideIdentification>& pep_ids) const
+                       vector<PeptideIdentification>& pep_ids,
+                       QCMetricAccumulator* accumulator) const
   {
     // --------------------------------------------------------------------
     // preparing output stream, quality metrics json object, CV, status
@@ -46,7 +109,6 @@ namespace OpenMS
       throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, output_file);
     }
 
-    using json = nlohmann::ordered_json;
     json quality_metrics = {};
 
     ControlledVocabulary cv;
@@ -75,7 +137,11 @@ namespace OpenMS
     // ---------------------------------------------------------------
     // function to add quality metrics to quality_metrics
     // ---------------------------------------------------------------
-    auto addMetric = [&cv, &quality_metrics](const String& accession, const auto& value) -> void
+    if (accumulator != nullptr)
+    {
+      accumulator->addRun(File::absolutePath(input_file));
+    }
+    auto addMetric = [&cv, &quality_metrics, accumulator](const String& accession, const auto& value) -> void
       {
         json qm;
         qm["accession"] = accession.c_str();
@@ -90,6 +156,14 @@ namespace OpenMS
         }
         qm["value"] = value;
         quality_metrics.push_back(qm);
+        // only scalar metrics can be summarized over runs
+        if constexpr (is_arithmetic_v<decay_t<decltype(value)>>)
+        {
+          if (accumulator != nullptr)
+          {
+            accumulator->add(accession, double(value));
+          }
+        }
       };
 
     // ---------------------------------------------------------------
@@ -184,26 +258,7 @@ namespace OpenMS
     // writing mzQC file
     // ---------------------------------------------------------------
     json out;
-    // required: creationDate, version
-    DateTime currentTime = DateTime::now();
-    out["mzQC"]["creationDate"] = currentTime.toString().c_str();
-    out["mzQC"]["version"] = "1.0.0";
-
-    // optional: contact_name, contact_address, description
-    if (!contact_name.empty()) 
-    {
-      out["mzQC"]["contactName"] = contact_name.c_str();
-    }
-    if (!contact_address.empty()) 
-    {
-      out["mzQC"]["contactAddress"] = contact_address.c_str();
-    }
-    if (!description.empty()) 
-    {
-      out["mzQC"]["description"] = description.c_str();
-    }
-    // get OpenMS version for runQualities
-    VersionInfo::VersionDetails version = VersionInfo::getVersionStruct();
+    out["mzQC"] = mzQCHeader(contact_name, contact_address, description);
     out["mzQC"]["runQualities"] =
     {
       {
@@ -243,35 +298,88 @@ namespace OpenMS
                 }
               }
             },
-            {"analysisSoftware",
-              {
-                {
-                  {"accession", "MS:1009001" }, // create new qc-cv for QCCalculator: MS:1009001 quality control metrics generating software
-                  {"name", "QCCalculator"},
-                  {"version", (String(version.version_major)+"."+String(version.version_minor)+"."+String(version.version_patch)).c_str()},
-                  {"uri", "https://www.openms.de"}
-                }
-              }
-            }
+            {"analysisSoftware", analysisSoftware()}
           }
         },
         {"qualityMetrics", quality_metrics}
       }
     };
 
-    out["mzQC"]["controlledVocabularies"] = 
+    out["mzQC"]["controlledVocabularies"] = controlledVocabularies();
+    os << out.dump(2);
+  }
+
+  void MzQCFile::storeSetQualities(const String& output_file,
+                                   const QCMetricAccumulator& accumulator,
+                                   const String& contact_name,
+                                   const String& contact_address,
+                                   const String& description,
+                                   const String& label) const
+  {
+    ofstream os(output_file.c_str());
+    if (!os)
     {
-        {
-          {"name", "Proteomics Standards Initiative Quality Control Ontology"},
-          {"uri", "https://raw.githubusercontent.com/HUPO-PSI/mzQC/master/cv/qc-cv.obo"},
-          {"version", "0.1.2"},
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, output_file);
+    }
+
+    ControlledVocabulary cv;
+    cv.loadFromOBO("PSI-MS", File::find("/CV/psi-ms.obo"));
+    cv.loadFromOBO("QC", File::find("/CV/qc-cv.obo"));
+
+    // one summary per metric (all values over the runs are just summarized, never stored)
+    json quality_metrics = json::array();
+    for (const auto& metric : accumulator.getMetrics())
+    {
+      const QCMetricAccumulator::Summary& summary = metric.second;
+      if (summary.getCount() == 0)
+      {
+        continue;
+      }
+      json qm;
+      qm["accession"] = metric.first.c_str();
+      if (cv.exists(metric.first))
+      {
+        qm["name"] = cv.getTerm(metric.first).name.c_str();
+      }
+      json quantiles;
+      for (double q : {0.05, 0.25, 0.5, 0.75, 0.95})
+      {
+        quantiles[String(q).c_str()] = summary.getQuantile(q);
+      }
+      qm["value"] =
+      {
+        {"count", summary.getCount()},
+        {"mean", summary.getMean()},
+        {"std", sqrt(summary.getVariance())},
+        {"min", summary.getMin()},
+        {"max", summary.getMax()},
+        {"quantiles", quantiles}
+      };
+      quality_metrics.push_back(qm);
+    }
+
+    json input_files = json::array();
+    for (const String& run : accumulator.getRuns())
+    {
+      input_files.push_back({{"location", run.c_str()}, {"name", File::basename(run).c_str()}});
+    }
+
+    json out;
+    out["mzQC"] = mzQCHeader(contact_name, contact_address, description);
+    out["mzQC"]["setQualities"] =
+    {
+      {
+        {"metadata",
+          {
+            {"label", label.c_str()},
+            {"inputFiles", input_files},
+            {"analysisSoftware", analysisSoftware()}
+          }
         },
-        {
-          {"name", "Proteomics Standards Initiative Mass Spectrometry Ontology"},
-          {"uri", "http://purl.obolibrary.org/obo/ms/psi-ms.obo"},
-          {"version", "4.1.155"}
-        }
+        {"qualityMetrics", quality_metrics}
+      }
     };
+    out["mzQC"]["controlledVocabularies"] = controlledVocabularies();
     os << out.dump(2);
   }
 
@@ -28,6 +28,11 @@ using namespace std;
 
 namespace OpenMS
 {
+  namespace
+  {
+    // streamed rows are collected and formatted in batches of this size (see MzTabFile::generateMzTabSectionRows_())
+    constexpr Size STREAM_BATCH_SIZE = 10000;
+  }
 
   MzTabFile::MzTabFile():
   store_protein_reliability_(false),
@@ -2900,6 +2905,10 @@ namespace OpenMS
 
     ofstream tab_file;
     tab_file.open(filename, ios::out | ios::trunc);
+    if (!tab_file)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
 
     MzTab::IDMzTabStream s(
       prot_ids_ptr,
@@ -2923,6 +2932,7 @@ namespace OpenMS
 
     {
       MzTabProteinSectionRow row;
+      std::vector<MzTabProteinSectionRow> batch;
       bool first = true;
       size_t n_header_columns = 0;
       while (s.nextPRTRow(row))
@@ -2937,10 +2947,13 @@ namespace OpenMS
             n_header_columns) + "\n";
           first = false;
         }
-        size_t n_section_columns = 0;
-        tab_file << generateMzTabSectionRow_(row, s.getProteinOptionalColumnNames(), meta_data, n_section_columns) + "\n";
-        if (n_header_columns != n_section_columns)  throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Protein header and content differs in columns. Please report this bug to the OpenMS developers.");
+        batch.push_back(row);
+        if (batch.size() == STREAM_BATCH_SIZE)
+        {
+          writeMzTabSectionBatch_(tab_file, batch, s.getProteinOptionalColumnNames(), meta_data, n_header_columns);
+        }
       }
+      writeMzTabSectionBatch_(tab_file, batch, s.getProteinOptionalColumnNames(), meta_data, n_header_columns);
     }
 
     Size n_search_engine_scores = meta_data.psm_search_engine_score.size();
@@ -2952,6 +2965,7 @@ namespace OpenMS
 
     {
       MzTabPSMSectionRow row;
+      std::vector<MzTabPSMSectionRow> batch;
       bool first = true;
       size_t n_header_columns = 0;
       while (s.nextPSMRow(row))
@@ -2966,11 +2980,14 @@ namespace OpenMS
             tab_file << "\n" << generateMzTabPSMHeader_(n_search_engine_scores, s.getPSMOptionalColumnNames(), n_header_columns) + "\n";
             first = false;
           }
-          size_t n_section_columns = 0;
-          tab_file << generateMzTabSectionRow_(row, s.getPSMOptionalColumnNames(), meta_data, n_section_columns) + "\n";
-          if (n_header_columns != n_section_columns)  throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "PSM header and content differs in columns. Please report this bug to the OpenMS developers.");
+          batch.push_back(row);
+          if (batch.size() == STREAM_BATCH_SIZE)
+          {
+            writeMzTabSectionBatch_(tab_file, batch, s.getPSMOptionalColumnNames(), meta_data, n_header_columns);
+          }
         }
       }
+      writeMzTabSectionBatch_(tab_file, batch, s.getPSMOptionalColumnNames(), meta_data, n_header_columns);
     }
 
     tab_file.close();
@@ -2995,6 +3012,10 @@ namespace OpenMS
 
     ofstream tab_file;
     tab_file.open(filename, ios::out | ios::trunc);
+    if (!tab_file)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
 
     MzTab::CMMzTabStream s(
       cmap,
@@ -3021,6 +3042,7 @@ namespace OpenMS
     n_best_search_engine_score = std::min(n_best_search_engine_score, Size(1));
     {
       MzTabProteinSectionRow row;
+      std::vector<MzTabProteinSectionRow> batch;
       bool first = true;
       size_t n_header_columns = 0;
       while (s.nextPRTRow(row))
@@ -3035,16 +3057,20 @@ namespace OpenMS
             n_header_columns) + "\n";
           first = false;
         }
-        size_t n_section_columns = 0;
-        tab_file << generateMzTabSectionRow_(row, s.getProteinOptionalColumnNames(), meta_data, n_section_columns) + "\n";
-        if (n_header_columns != n_section_columns)  throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Protein header and content differs in columns. Please report this bug to the OpenMS developers.");
+        batch.push_back(row);
+        if (batch.size() == STREAM_BATCH_SIZE)
+        {
+          writeMzTabSectionBatch_(tab_file, batch, s.getProteinOptionalColumnNames(), meta_data, n_header_columns);
+        }
       }
+      writeMzTabSectionBatch_(tab_file, batch, s.getProteinOptionalColumnNames(), meta_data, n_header_columns);
     }
 
     Size assays(0);
     Size study_variables(0);
     {
       MzTabPeptideSectionRow row;
+      std::vector<MzTabPeptideSectionRow> batch;
       bool first = true;
       size_t n_header_columns = 0;
       while (s.nextPEPRow(row))
@@ -3062,14 +3088,13 @@ namespace OpenMS
           tab_file << "\n" << generateMzTabPeptideHeader_(search_ms_runs, n_best_search_engine_score, n_search_engine_score, assays, study_variables, s.getPeptideOptionalColumnNames(), n_header_columns) + "\n";
           first = false;
         }
-        size_t n_section_columns = 0;
-        tab_file << generateMzTabSectionRow_(row, s.getPeptideOptionalColumnNames(), meta_data, n_section_columns) + "\n";
-        if (n_header_columns != n_section_columns)
+        batch.push_back(row);
+        if (batch.size() == STREAM_BATCH_SIZE)
         {
-          OPENMS_LOG_ERROR << "Number of columns in header/section: " << n_header_columns << "/" << n_section_columns << endl;
-          throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Peptide header and content differs in columns. Please report this bug to the OpenMS developers.");
+          writeMzTabSectionBatch_(tab_file, batch, s.getPeptideOptionalColumnNames(), meta_data, n_header_columns);
         }
       }
+      writeMzTabSectionBatch_(tab_file, batch, s.getPeptideOptionalColumnNames(), meta_data, n_header_columns);
     } 
 
     Size n_search_engine_scores = meta_data.psm_search_engine_score.size();
@@ -3081,6 +3106,7 @@ namespace OpenMS
 
     {
       MzTabPSMSectionRow row;
+      std::vector<MzTabPSMSectionRow> batch;
       bool first = true;
 
       // TODO: we currently only store one search engine score per PSM so we need to limit the number to the main score      
@@ -3098,11 +3124,14 @@ namespace OpenMS
             tab_file << "\n" << generateMzTabPSMHeader_(n_search_engine_scores, s.getPSMOptionalColumnNames(), n_header_columns) + "\n";           
             first = false;
           }
-          size_t n_section_columns = 0;
-          tab_file << generateMzTabSectionRow_(row, s.getPSMOptionalColumnNames(), meta_data, n_section_columns) + "\n";
-          if (n_header_columns != n_section_columns)  throw Exception::Postcondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "PSM header and content differs in columns. Please report this bug to the OpenMS developers.");
+          batch.push_back(row);
+          if (batch.size() == STREAM_BATCH_SIZE)
+          {
+            writeMzTabSectionBatch_(tab_file, batch, s.getPSMOptionalColumnNames(), meta_data, n_header_columns);
+          }
         }
       }
+      writeMzTabSectionBatch_(tab_file, batch, s.getPSMOptionalColumnNames(), meta_data, n_header_columns);
     }
 
     tab_file.close();
@@ -3291,45 +3320,56 @@ namespace OpenMS
   }
 
     // insert comments (might provide critical cues for human reader) and empty lines
+  // (written directly instead of copying all lines into a TextFile first)
+  ofstream tab_file;
+  // not opened in binary mode, thus "\n" will be evaluated platform dependent (as in TextFile::store())
+  tab_file.open(filename.c_str(), ofstream::out);
+  if (!tab_file)
+  {
+    throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+  }
+
   Size line = 0;
   vector<Size> empty_rows = mz_tab.getEmptyRows();
   map<Size, String> comment_rows = mz_tab.getCommentRows();
 
-  if (empty_rows.empty() && comment_rows.empty())
+  auto write_line = [&tab_file](const String& l)
   {
-    TextFile tmp_out;
-    for (TextFile::ConstIterator it = out.begin(); it != out.end(); ++it)
+    if (!l.hasSuffix("\n"))
     {
-      tmp_out.addLine(*it);
+      tab_file << l << "\n";
     }
-    tmp_out.store(filename);
-  }
-  else
+    else if (l.hasSuffix("\r\n"))
+    {
+      tab_file << l.chop(2) << "\n";
+    }
+    else
+    {
+      tab_file << l;
+    }
+  };
+
+  for (StringList::const_iterator it = out.begin(); it != out.end(); )
   {
-    TextFile tmp_out;
-    for (TextFile::ConstIterator it = out.begin(); it != out.end(); )
+    if (std::binary_search(empty_rows.begin(), empty_rows.end(), line))  // check if current line was originally an empty line
     {
-      if (std::binary_search(empty_rows.begin(), empty_rows.end(), line))  // check if current line was originally an empty line
-      {
-        tmp_out.addLine("\n");
-        ++line;
-      }
-      else if (comment_rows.find(line) != comment_rows.end()) // check if current line was originally a comment line
-      {
-        tmp_out.addLine(comment_rows[line]);
-        ++line;
-      }
-      else   // no empty line, no comment => add row
-      {
-        tmp_out.addLine(*it);
-        ++line;
-        ++it;
-      }
+      write_line("\n");
+      ++line;
+    }
+    else if (comment_rows.find(line) != comment_rows.end()) // check if current line was originally a comment line
+    {
+      write_line(comment_rows[line]);
+      ++line;
+    }
+    else   // no empty line, no comment => add row
+    {
+      write_line(*it);
+      ++line;
+      ++it;
     }
-    tmp_out.store(filename);
   }
+  tab_file.close();
   }
-
 }
 
 #pragma clang diagnostic pop
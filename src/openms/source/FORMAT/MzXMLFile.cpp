@@ -9,6 +9,7 @@
 #include <OpenMS/FORMAT/MzXMLFile.h>
 
 #include <OpenMS/FORMAT/HANDLERS/MzXMLHandler.h>
+#include <OpenMS/FORMAT/OffsetIndexFile.h>
 
 using namespace std;
 
@@ -56,6 +57,29 @@ namespace OpenMS
     save_(filename, &handler);
   }
 
+  void MzXMLFile::loadSpectrum(const String& filename, const OffsetIndexFile& index, Size index_pos, MSSpectrum& spectrum)
+  {
+    if (index.getFileType() != FileTypes::MZXML)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "The offset index is not an index of an mzXML file");
+    }
+    if (index_pos >= index.getSpectra().size())
+    {
+      throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, index_pos, index.getSpectra().size());
+    }
+
+    // wrap the scan into a minimal document
+    std::string buffer = "<?xml version=\"1.0\" encoding=\"ISO-8859-1\"?>\n<mzXML>\n<msRun scanCount=\"1\">\n";
+    buffer += OffsetIndexFile::readElement(filename, index.getSpectra()[index_pos]);
+    buffer += "\n</msRun>\n</mzXML>\n";
+
+    MapType map;
+    Internal::MzXMLHandler handler(map, filename, schema_version_, *this);
+    handler.setOptions(options_);
+    parseBuffer_(buffer, &handler);
+    spectrum = map.empty() ? MSSpectrum() : std::move(map[0]);
+  }
+
   void MzXMLFile::transform(const String& filename_in, Interfaces::IMSDataConsumer * consumer, bool skip_full_count)
   {
     // First pass through the file -> get the meta-data and hand it to the consumer
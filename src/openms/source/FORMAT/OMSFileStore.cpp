@@ -63,8 +63,10 @@ namespace OpenMS::Internal
     // we don't have to worry about database consistency:
     db_->exec("PRAGMA synchronous = OFF");
     db_->exec("PRAGMA journal_mode = OFF");
-    db_->exec("PRAGMA foreign_keys = ON");
-    db_->exec("PRAGMA foreign_keys = ON");
+    // keep temporary data (e.g. for sorting during index creation) in memory
+    // and use a larger page cache (64 MB) for bulk inserts:
+    db_->exec("PRAGMA temp_store = MEMORY");
+    db_->exec("PRAGMA cache_size = -65536");
   }
 
   OMSFileStore::~OMSFileStore() = default;
@@ -78,6 +80,22 @@ namespace OpenMS::Internal
   }
 
 
+  void OMSFileStore::createIndex_(const String& table, const String& column)
+  {
+    deferred_indexes_.push_back("CREATE INDEX " + table + "_" + column + " ON " + table + " (" + column + ")");
+  }
+
+
+  void OMSFileStore::createDeferredIndexes_()
+  {
+    for (const String& sql_index : deferred_indexes_)
+    {
+      db_->exec(sql_index);
+    }
+    deferred_indexes_.clear();
+  }
+
+
   void OMSFileStore::storeVersionAndDate_()
   {
     createTable_("version",
@@ -695,6 +713,7 @@ namespace OpenMS::Internal
       "score REAL, "                                                    \
       "UNIQUE (id, score_type_id), "                                    \
       "FOREIGN KEY (grouping_id) REFERENCES ID_ParentGroupSet (id)");
+    createIndex_("ID_ParentGroup", "grouping_id");
 
     createTable_(
       "ID_ParentGroup_ParentSequence",
@@ -1102,8 +1121,7 @@ namespace OpenMS::Internal
           }
         }
       }
-      // create index on parent_id column
-      db_->exec("CREATE INDEX PeakAnnotation_parent_id ON ID_ObservationMatch_PeakAnnotation (parent_id)");
+      createIndex_("ID_ObservationMatch_PeakAnnotation", "parent_id");
     }
   }
 
@@ -1138,6 +1156,7 @@ namespace OpenMS::Internal
       storeAdducts_(id_data);
       nextProgress(); // 12
       storeObservationMatches_(id_data);
+      createDeferredIndexes_();
     };
 
     if (sqlite3_get_autocommit(db_->getHandle()) == 1)
@@ -1171,6 +1190,7 @@ namespace OpenMS::Internal
                  "FOREIGN KEY (primary_molecule_id) REFERENCES ID_IdentifiedMolecule (id), " \
                  "FOREIGN KEY (subordinate_of) REFERENCES FEAT_BaseFeature (id), " \
                  "CHECK (id > subordinate_of)"); // check to prevent cycles
+    createIndex_("FEAT_BaseFeature", "subordinate_of");
 
     auto query = make_unique<SQLite::Statement>(*db_,
                                                 "INSERT INTO FEAT_BaseFeature VALUES (" \
@@ -1197,6 +1217,7 @@ namespace OpenMS::Internal
                    "observation_match_id INTEGER NOT NULL, "            \
                    "FOREIGN KEY (feature_id) REFERENCES FEAT_BaseFeature (id), " \
                    "FOREIGN KEY (observation_match_id) REFERENCES ID_ObservationMatch (id)");
+      createIndex_("FEAT_ObservationMatch", "feature_id");
       query = make_unique<SQLite::Statement>(*db_,
                                              "INSERT INTO FEAT_ObservationMatch VALUES (" \
                                              ":feature_id, "            \
@@ -1312,6 +1333,7 @@ namespace OpenMS::Internal
                  "rt_quality REAL, "                                    \
                  "mz_quality REAL, "                                    \
                  "FOREIGN KEY (feature_id) REFERENCES FEAT_BaseFeature (id)");
+    createIndex_("FEAT_Feature", "feature_id");
     auto query = make_unique<SQLite::Statement>(*db_,
                                                 "INSERT INTO FEAT_Feature VALUES (" \
                                                 ":feature_id, "         \
@@ -1331,6 +1353,7 @@ namespace OpenMS::Internal
                    "point_x REAL, "                                     \
                    "point_y REAL, "                                     \
                    "FOREIGN KEY (feature_id) REFERENCES FEAT_BaseFeature (id)");
+      createIndex_("FEAT_ConvexHull", "feature_id");
       auto query2 = make_unique<SQLite::Statement>(*db_, "INSERT INTO FEAT_ConvexHull VALUES (" \
                                                    ":feature_id, "      \
                                                    ":hull_index, "      \
@@ -1450,6 +1473,7 @@ namespace OpenMS::Internal
     storeDataProcessing_(features.getDataProcessing());
     nextProgress();
     storeFeatures_(features);
+    createDeferredIndexes_();
     transaction.commit();
     endProgress();
   }
@@ -1515,6 +1539,7 @@ namespace OpenMS::Internal
                  "feature_id INTEGER NOT NULL, "                        \
                  "map_index INTEGER NOT NULL, "                                    \
                  "FOREIGN KEY (feature_id) REFERENCES FEAT_BaseFeature (id)");
+    createIndex_("FEAT_FeatureHandle", "feature_id");
     SQLite::Statement query_handle(*db_,
                                    "INSERT INTO FEAT_FeatureHandle VALUES (" \
                                    ":feature_id, "                      \
@@ -1534,6 +1559,7 @@ namespace OpenMS::Internal
                    "numerator_ref TEXT, "                               \
                    "description TEXT, "                                 \
                    "FOREIGN KEY (feature_id) REFERENCES FEAT_BaseFeature (id)");
+      createIndex_("FEAT_ConsensusRatio", "feature_id");
       query_ratio = make_unique<SQLite::Statement>(*db_, "INSERT INTO FEAT_ConsensusRatio VALUES (" \
                                                    ":feature_id, "      \
                                                    ":ratio_index, "     \
@@ -1592,6 +1618,7 @@ namespace OpenMS::Internal
     storeDataProcessing_(consensus.getDataProcessing());
     nextProgress();
     storeConsensusFeatures_(consensus);
+    createDeferredIndexes_();
     transaction.commit();
     endProgress();
   }
@@ -32,11 +32,14 @@ namespace OpenMS
     sort_spectra_by_mz_(true),
     sort_chromatograms_by_rt_(true),
     fill_data_(true),
+    skim_binary_data_(false),
     write_index_(true),
     np_config_mz_(),
     np_config_int_(),
     np_config_fda_(),
     maximal_data_pool_size_(100),
+    pipelined_decoding_(true),
+    parallel_writing_(true),
     precursor_mz_selected_ion_(true)
   {
   }
@@ -287,6 +290,16 @@ namespace OpenMS
     np_config_fda_ = config;
   }
 
+  bool PeakFileOptions::getSkimBinaryData() const
+  {
+    return skim_binary_data_;
+  }
+
+  void PeakFileOptions::setSkimBinaryData(bool skim)
+  {
+    skim_binary_data_ = skim;
+  }
+
   Size PeakFileOptions::getMaxDataPoolSize() const
   {
     return maximal_data_pool_size_;
@@ -297,6 +310,26 @@ namespace OpenMS
     maximal_data_pool_size_ = size;
   }
 
+  bool PeakFileOptions::getPipelinedDecoding() const
+  {
+    return pipelined_decoding_;
+  }
+
+  void PeakFileOptions::setPipelinedDecoding(bool pipelined)
+  {
+    pipelined_decoding_ = pipelined;
+  }
+
+  bool PeakFileOptions::getParallelWriting() const
+  {
+    return parallel_writing_;
+  }
+
+  void PeakFileOptions::setParallelWriting(bool parallel)
+  {
+    parallel_writing_ = parallel;
+  }
+
   bool PeakFileOptions::getPrecursorMZSelectedIon() const
   {
     return precursor_mz_selected_ion_;
@@ -9,9 +9,11 @@
 #include <OpenMS/FORMAT/OSWFile.h>
 
 #include <OpenMS/DATASTRUCTURES/StringListUtils.h>
+#include <OpenMS/SYSTEM/File.h>
 
 #include <sqlite3.h>
 
+#include <algorithm>
 #include <cstring> // for strcmp
 #include <sstream>
 #include <utility> // for std::move
@@ -21,6 +23,20 @@ namespace OpenMS
   namespace Sql = Internal::SqliteHelper;
   using namespace std;
 
+  namespace
+  {
+    /// whether @p table has an index whose first column is @p column
+    bool hasLeadingIndex(SqliteConnector& conn, const String& table, const String& column)
+    {
+      sqlite3_stmt* stmt;
+      conn.prepareStatement(&stmt, "SELECT COUNT(*) FROM pragma_index_list('" + table + "') AS il, pragma_index_info(il.name) AS ii "
+                                   "WHERE ii.seqno = 0 AND ii.name = '" + column + "';");
+      bool found = (Sql::nextRow(stmt) == Sql::SqlState::SQL_ROW && Sql::extractInt(stmt, 0) > 0);
+      sqlite3_finalize(stmt);
+      return found;
+    }
+  }
+
   const std::array<std::string, (Size)OSWFile::OSWLevel::SIZE_OF_OSWLEVEL> OSWFile::names_of_oswlevel = { "ms1", "ms2", "transition" };
 
   void OSWFile::readToPIN(const std::string& in_osw,
@@ -168,6 +184,45 @@ namespace OpenMS
 
     }
 
+    void OSWFile::merge(const StringList& in, const String& out)
+    {
+      for (const String& f : in)
+      {
+        if (!File::exists(f))
+        {
+          throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, f);
+        }
+      }
+      if (in.empty()) return;
+      if (std::find(in.begin(), in.end(), out) != in.end())
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "The merged file '" + out + "' must not be one of the inputs.");
+      }
+      if (!File::remove(out) || !File::copy(in[0], out))
+      {
+        throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, out);
+      }
+
+      SqliteConnector conn(out);
+      const StringList feature_tables = {"FEATURE", "FEATURE_MS1", "FEATURE_MS2", "FEATURE_PRECURSOR", "FEATURE_TRANSITION"};
+      for (Size i = 1; i < in.size(); ++i)
+      {
+        conn.executeStatement("ATTACH DATABASE '" + String(in[i]).substitute("'", "''") + "' AS shard;");
+        std::stringstream merge_sql;
+        merge_sql << "BEGIN TRANSACTION; INSERT OR IGNORE INTO RUN SELECT * FROM shard.RUN; ";
+        for (const String& table : feature_tables)
+        {
+          if (SqliteConnector::tableExists(conn.getDB(), table))
+          {
+            merge_sql << "INSERT INTO " << table << " SELECT * FROM shard." << table << "; ";
+          }
+        }
+        merge_sql << "COMMIT;";
+        conn.executeStatement(merge_sql.str());
+        conn.executeStatement("DETACH DATABASE shard;");
+      }
+    }
+
     void OSWFile::writeFromPercolator(const std::string& in_osw,
                         const OSWFile::OSWLevel osw_level,
                         const std::map< std::string, PercolatorFeature >& features)
@@ -252,8 +307,15 @@ namespace OpenMS
       has_SCOREMS2_ = conn_.tableExists("SCORE_MS2");
     }
 
+    OSWFile::~OSWFile()
+    {
+      // the prefetching thread uses conn_, it must finish before the connection is closed
+      stopPrefetch_();
+    }
+
     void OSWFile::readMinimal(OSWData& swath_result)
     {
+      std::lock_guard<std::mutex> lock(mutex_);
       readMeta_(swath_result);
 
       readTransitions_(swath_result);
@@ -299,6 +361,14 @@ namespace OpenMS
       { // already populated
         return;
       }
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto prefetched = prefetched_.find(swath_result.getProteins()[index].getID());
+      if (prefetched != prefetched_.end())
+      {
+        swath_result.setProtein(index, std::move(prefetched->second));
+        prefetched_.erase(prefetched);
+        return;
+      }
       getFullProteins_(swath_result, index);
       if (swath_result.getProteins()[index].getPeptidePrecursors().empty())
       {
@@ -306,8 +376,60 @@ namespace OpenMS
       }
     }
 
+    void OSWFile::prefetchProteins(const OSWData& swath_result, const std::vector<Size>& indices)
+    {
+      stopPrefetch_();
+
+      std::vector<Size> prot_ids;
+      for (Size index : indices)
+      {
+        if (index < swath_result.getProteins().size() && swath_result.getProteins()[index].getPeptidePrecursors().empty())
+        {
+          prot_ids.push_back(swath_result.getProteins()[index].getID());
+        }
+      }
+      if (prot_ids.empty())
+      {
+        return;
+      }
+
+      prefetch_ = std::async(std::launch::async, [this, prot_ids]()
+      {
+        for (Size prot_id : prot_ids)
+        {
+          if (stop_prefetch_)
+          {
+            return;
+          }
+          // lock per protein, so a readProtein() of the GUI does not wait for the whole prefetch
+          std::lock_guard<std::mutex> lock(mutex_);
+          if (prefetched_.count(prot_id) == 0)
+          {
+            OSWProtein prot;
+            if (readProteinByID_(prot_id, prot))
+            {
+              prefetched_.emplace(prot_id, std::move(prot));
+            }
+          }
+        }
+      });
+    }
+
+    void OSWFile::stopPrefetch_()
+    {
+      if (!prefetch_.valid())
+      {
+        return;
+      }
+      stop_prefetch_ = true;
+      prefetch_.wait(); // an error of the prefetch is dropped with the future; readProtein() will run into it again
+      prefetch_ = std::future<void>();
+      stop_prefetch_ = false;
+    }
+
     void OSWFile::read(OSWData& swath_result)
     {
+      std::lock_guard<std::mutex> lock(mutex_);
       readMeta_(swath_result);
       readTransitions_(swath_result);
       getFullProteins_(swath_result);      
@@ -506,77 +628,151 @@ namespace OpenMS
       throw Exception::SqlOperationFailed(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No rows available. Please report this as a bug!");
     }
 
-    void OSWFile::getFullProteins_(OSWData& swath_result, Size index)
+    /// executes @p select_sql and initializes @p current_line from its first row
+    /// @return false if the query has no rows (@p stmt is finalized then)
+    bool startProteinQuery(SqliteConnector& conn, const String& select_sql, sqlite3_stmt** stmt, Sql::SqlState& rc, LineState& current_line)
     {
-      String protein_subselect;
-      if (index == ALL_PROTEINS)
+      conn.prepareStatement(stmt, select_sql);
+
+      rc = Sql::nextRow(*stmt);
+      if (sqlite3_column_count(*stmt) != SIZE_OF_ColProteinSelect)
       {
-        swath_result.clearProteins();
-        protein_subselect = "PROTEIN";
+        sqlite3_finalize(*stmt);
+        throw Exception::SqlOperationFailed(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Query was changed! Please report this bug!");
       }
-      else
-      { //  do not use accession to filter -- its as slow as full query
-        protein_subselect = "(select * from PROTEIN  where ID = " + String(swath_result.getProteins().at(index).getID()) + ") as PROTEIN";
+
+      if (rc == Sql::SqlState::SQL_DONE)
+      { // no data
+        sqlite3_finalize(*stmt);
+        return false;
       }
-     
+
+      initLine(current_line, *stmt);
+      return true;
+    }
+
+    String OSWFile::proteinQuery_(const String& protein_table, bool use_lookup) const
+    {
+      auto table = [&](const String& name) -> String
+      {
+        return use_lookup ? lookup_tables_.at(name) : name;
+      };
 
       // check of SCORE_MS2 table is available (for OSW files which underwent pyProphet)
       // set q_value to -1 if missing
       String MS2_select = (has_SCOREMS2_ ? "SCORE_MS2.QVALUE as qvalue" : "-1 as qvalue");
-      String MS2_join = (has_SCOREMS2_ ? "inner join(select * from SCORE_MS2) as SCORE_MS2 on SCORE_MS2.FEATURE_ID = FEATURE.ID" : "");
+      String MS2_join = (has_SCOREMS2_ ? "inner join " + table("SCORE_MS2") + " as SCORE_MS2 on SCORE_MS2.FEATURE_ID = FEATURE.ID" : "");
 
       // assemble the protein-PeptidePrecursor-Feature hierarchy
       // note: when changing the query, make sure to keep the indices in ColProteinSelect in sync!!!
-      String select_sql = "select PROTEIN.ID as prot_id, PROTEIN_ACCESSION as prot_accession, PROTEIN.DECOY as decoy, "
-                          "       PEPTIDE.MODIFIED_SEQUENCE as modified_sequence,"
-                          "       PRECURSOR.ID as prec_id, PRECURSOR.PRECURSOR_MZ as pc_mz, PRECURSOR.CHARGE as pc_charge,"
-                          "       FEATURE.ID as feat_id, FEATURE.EXP_RT as rt_experimental, FEATURE.DELTA_RT as rt_delta, FEATURE.LEFT_WIDTH as rt_left_width, FEATURE.RIGHT_WIDTH as rt_right_width,"
-                          "       FeatTrMap.TRANSITION_ID as tr_id, " +
+      return "select PROTEIN.ID as prot_id, PROTEIN_ACCESSION as prot_accession, PROTEIN.DECOY as decoy, "
+             "       PEPTIDE.MODIFIED_SEQUENCE as modified_sequence,"
+             "       PRECURSOR.ID as prec_id, PRECURSOR.PRECURSOR_MZ as pc_mz, PRECURSOR.CHARGE as pc_charge,"
+             "       FEATURE.ID as feat_id, FEATURE.EXP_RT as rt_experimental, FEATURE.DELTA_RT as rt_delta, FEATURE.LEFT_WIDTH as rt_left_width, FEATURE.RIGHT_WIDTH as rt_right_width,"
+             "       FeatTrMap.TRANSITION_ID as tr_id, " +
         MS2_select +
-        " FROM " + protein_subselect +
-        " inner join(select* FROM PEPTIDE_PROTEIN_MAPPING) as PepProtMap on PepProtMap.PROTEIN_ID = PROTEIN.ID "
+        " FROM " + protein_table +
+        " inner join " + table("PEPTIDE_PROTEIN_MAPPING") + " as PepProtMap on PepProtMap.PROTEIN_ID = PROTEIN.ID "
         " inner join(select ID, MODIFIED_SEQUENCE FROM PEPTIDE) as PEPTIDE on PEPTIDE.ID = PepProtMap.PEPTIDE_ID "
-        " inner join(select * FROM PRECURSOR_PEPTIDE_MAPPING) as PrePepMap on PrePepMap.PEPTIDE_ID = PEPTIDE.ID "
+        " inner join " + table("PRECURSOR_PEPTIDE_MAPPING") + " as PrePepMap on PrePepMap.PEPTIDE_ID = PEPTIDE.ID "
         " inner join(select * from PRECURSOR) as PRECURSOR on PRECURSOR.ID = PrePepMap.PRECURSOR_ID "
-        " inner join(select * from FEATURE) as FEATURE on FEATURE.PRECURSOR_ID = PRECURSOR.ID "
-        " inner join(select * from FEATURE_TRANSITION) as FeatTrMap on FeatTrMap.FEATURE_ID = FEATURE.ID " +
+        " inner join " + table("FEATURE") + " as FEATURE on FEATURE.PRECURSOR_ID = PRECURSOR.ID "
+        " inner join " + table("FEATURE_TRANSITION") + " as FeatTrMap on FeatTrMap.FEATURE_ID = FEATURE.ID " +
         MS2_join +
         " order by prot_id, prec_id, feat_id, qvalue, tr_id ";
+    }
 
-
-      sqlite3_stmt* stmt;
-      conn_.prepareStatement(&stmt, select_sql);
-
-      Sql::SqlState rc = Sql::nextRow(stmt);
-      if (sqlite3_column_count(stmt) != SIZE_OF_ColProteinSelect)
+    void OSWFile::prepareProteinLookup_()
+    {
+      if (!lookup_tables_.empty())
       {
-        throw Exception::SqlOperationFailed(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Query was changed! Please report this bug!");
+        return;
+      }
+      // The OSW schema only indexes primary keys, so a query for a single protein would have to scan the mapping and
+      // feature tables (or let SQLite build a transient index for every query). Instead, copies of the required columns
+      // with an index on the join column are created once, in the temporary database of this connection.
+      struct Lookup
+      {
+        String table;
+        String key;     ///< the join column
+        String columns; ///< columns used by proteinQuery_()
+      };
+      std::vector<Lookup> lookups = {
+        {"PEPTIDE_PROTEIN_MAPPING", "PROTEIN_ID", "PROTEIN_ID, PEPTIDE_ID"},
+        {"PRECURSOR_PEPTIDE_MAPPING", "PEPTIDE_ID", "PEPTIDE_ID, PRECURSOR_ID"},
+        {"FEATURE", "PRECURSOR_ID", "PRECURSOR_ID, ID, EXP_RT, DELTA_RT, LEFT_WIDTH, RIGHT_WIDTH"},
+        {"FEATURE_TRANSITION", "FEATURE_ID", "FEATURE_ID, TRANSITION_ID"}};
+      if (has_SCOREMS2_)
+      {
+        lookups.push_back({"SCORE_MS2", "FEATURE_ID", "FEATURE_ID, QVALUE"});
       }
 
-      if (rc == Sql::SqlState::SQL_DONE)
-      { // no data
-        return;
+      std::map<String, String> lookup_tables;
+      for (const Lookup& l : lookups)
+      {
+        if (hasLeadingIndex(conn_, l.table, l.key))
+        { // e.g. created by pyProphet
+          lookup_tables[l.table] = l.table;
+          continue;
+        }
+        const String name = "OSW_LOOKUP_" + l.table;
+        conn_.executeStatement("CREATE TEMP TABLE " + name + " AS SELECT " + l.columns + " FROM main." + l.table + "; "
+                               "CREATE INDEX " + name + "_IDX ON " + name + "(" + l.key + ");");
+        lookup_tables[l.table] = name;
       }
+      lookup_tables_ = std::move(lookup_tables);
+    }
+
+    bool OSWFile::readProteinByID_(Size prot_id, OSWProtein& prot)
+    {
+      prepareProteinLookup_();
 
+      //  do not use accession to filter -- its as slow as full query
+      const String select_sql = proteinQuery_("(select * from PROTEIN where ID = " + String(prot_id) + ") as PROTEIN", true);
+
+      sqlite3_stmt* stmt;
+      Sql::SqlState rc;
       LineState current_line;
-      initLine(current_line, stmt);
-      OSWProtein prot;
+      if (!startProteinQuery(conn_, select_sql, &stmt, rc, current_line))
+      {
+        return false;
+      }
+      nextProtein(prot, stmt, rc, current_line);
+      sqlite3_finalize(stmt);
+      return true;
+    }
 
-      if (index == ALL_PROTEINS)
+    void OSWFile::getFullProteins_(OSWData& swath_result, Size index)
+    {
+      if (index != ALL_PROTEINS)
       {
-        bool has_more;
-        do
+        OSWProtein prot;
+        if (readProteinByID_(swath_result.getProteins().at(index).getID(), prot))
         {
-          has_more = nextProtein(prot, stmt, rc, current_line);
-          swath_result.addProtein(std::move(prot));
-        } while (has_more);
+          swath_result.setProtein(index, std::move(prot));
+        }
+        return;
       }
-      else // single protein
+
+      swath_result.clearProteins();
+
+      sqlite3_stmt* stmt;
+      Sql::SqlState rc;
+      LineState current_line;
+      // a full scan is the fastest way to get all proteins, so the lookup tables are not needed
+      if (!startProteinQuery(conn_, proteinQuery_("PROTEIN", false), &stmt, rc, current_line))
       {
-        nextProtein(prot, stmt, rc, current_line);
-        swath_result.setProtein(index, std::move(prot));
+        return;
       }
 
+      OSWProtein prot;
+      bool has_more;
+      do
+      {
+        has_more = nextProtein(prot, stmt, rc, current_line);
+        swath_result.addProtein(std::move(prot));
+      } while (has_more);
+
       sqlite3_finalize(stmt);
     }
 
@@ -0,0 +1,585 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/OffsetIndexFile.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <memory>
+
+using namespace std;
+
+namespace OpenMS
+{
+  namespace
+  {
+    const char* const INDEX_HEADER = "#OpenMS offset index";
+    const char* const INDEX_VERSION = "1";
+
+    /// Whether the tag starting at @p tag (just after '<' or '</') has the name @p name
+    bool tagIs(const char* tag, const char* tag_end, const char* name)
+    {
+      const Size len = strlen(name);
+      if (Size(tag_end - tag) < len || strncmp(tag, name, len) != 0)
+      {
+        return false;
+      }
+      const char next = tag[len];
+      return next == ' ' || next == '\t' || next == '\n' || next == '\r' || next == '>' || next == '/';
+    }
+
+    /// Position of the next "-->" in [@p begin, @p end), or @p end
+    const char* findCommentEnd(const char* begin, const char* end)
+    {
+      const char marker[] = "-->";
+      return std::search(begin, end, marker, marker + 3);
+    }
+
+    /// Decodes the predefined XML entities (and numeric character references below 128)
+    std::string decodeEntities(const char* begin, const char* end)
+    {
+      std::string result;
+      result.reserve(end - begin);
+      for (const char* c = begin; c < end; ++c)
+      {
+        if (*c != '&')
+        {
+          result += *c;
+          continue;
+        }
+        const char* semicolon = static_cast<const char*>(memchr(c, ';', end - c));
+        if (semicolon == nullptr)
+        {
+          result.append(c, end);
+          break;
+        }
+        const std::string entity(c + 1, semicolon);
+        if (entity == "amp") result += '&';
+        else if (entity == "lt") result += '<';
+        else if (entity == "gt") result += '>';
+        else if (entity == "quot") result += '"';
+        else if (entity == "apos") result += '\'';
+        else if (entity.size() > 1 && entity[0] == '#')
+        {
+          const long code = entity[1] == 'x' ? strtol(entity.c_str() + 2, nullptr, 16) : strtol(entity.c_str() + 1, nullptr, 10);
+          if (code <= 0 || code >= 128)
+          {
+            // not needed for native IDs, keep the reference as it is
+            result.append(c, semicolon + 1);
+          }
+          else
+          {
+            result += char(code);
+          }
+        }
+        else
+        {
+          result.append(c, semicolon + 1);
+        }
+        c = semicolon;
+      }
+      return result;
+    }
+
+    /// Extracts the (decoded) value of attribute @p name from the tag [@p tag, @p tag_end)
+    bool attribute(const char* tag, const char* tag_end, const char* name, std::string& value)
+    {
+      const Size len = strlen(name);
+      for (const char* c = tag; c + len + 2 < tag_end; ++c)
+      {
+        if ((c[-1] == ' ' || c[-1] == '\t' || c[-1] == '\n' || c[-1] == '\r') &&
+            strncmp(c, name, len) == 0 && c[len] == '=' && (c[len + 1] == '"' || c[len + 1] == '\''))
+        {
+          const char quote = c[len + 1];
+          const char* start = c + len + 2;
+          const char* stop = static_cast<const char*>(memchr(start, quote, tag_end - start));
+          if (stop == nullptr)
+          {
+            return false;
+          }
+          value = decodeEntities(start, stop);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /// Converts an xs:duration (as used by mzXML, e.g. "PT1H2M3.4S") to seconds, like MzXMLHandler
+    double durationToSeconds(String time_string)
+    {
+      double seconds = 0.0;
+      const bool negative = time_string.hasPrefix("-");
+      time_string = time_string.suffix('T');
+      if (time_string.has('H'))
+      {
+        seconds += 3600 * time_string.prefix('H').toDouble();
+        time_string = time_string.suffix('H');
+      }
+      if (time_string.has('M'))
+      {
+        seconds += 60 * time_string.prefix('M').toDouble();
+        time_string = time_string.suffix('M');
+      }
+      if (time_string.has('S'))
+      {
+        seconds += time_string.prefix('S').toDouble();
+      }
+      return negative ? -seconds : seconds;
+    }
+
+    /// Read-only view of a file: memory mapped if possible, read into memory otherwise
+    struct FileView
+    {
+      explicit FileView(const String& filename)
+      {
+        file = std::make_unique<QFile>(filename.toQString());
+        if (!file->open(QIODevice::ReadOnly))
+        {
+          throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+        }
+        const qint64 file_size = file->size();
+        const uchar* mapped = file_size > 0 ? file->map(0, file_size) : nullptr;
+        if (mapped != nullptr)
+        {
+          data = reinterpret_cast<const char*>(mapped);
+          size = Size(file_size);
+        }
+        else
+        {
+          // e.g. address space exhaustion on 32 bit systems: read the file instead
+          file->close();
+          ifstream ifs(filename.c_str(), ios::binary);
+          buffer.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+          data = buffer.data();
+          size = buffer.size();
+        }
+      }
+
+      std::unique_ptr<QFile> file;
+      std::string buffer;
+      const char* data = nullptr;
+      Size size = 0;
+    };
+
+    /// Modification time of @p filename in ms since epoch
+    qint64 modificationTime(const String& filename)
+    {
+      return QFileInfo(filename.toQString()).lastModified().toMSecsSinceEpoch();
+    }
+  }
+
+  bool OffsetIndexFile::Entry::operator==(const Entry& rhs) const
+  {
+    return native_id == rhs.native_id &&
+           offset == rhs.offset &&
+           length == rhs.length &&
+           unclosed == rhs.unclosed &&
+           rt == rhs.rt &&
+           ms_level == rhs.ms_level &&
+           precursor_mz == rhs.precursor_mz;
+  }
+
+  void OffsetIndexFile::scan(const String& data_file)
+  {
+    clear();
+    FileView view(data_file);
+
+    // detect the document type from the root element (after the XML declaration and comments)
+    const Size head_size = std::min(view.size, Size(4096));
+    const std::string head(view.data, head_size);
+    const Size mzml = std::min(head.find("<mzML"), head.find("<indexedmzML"));
+    const Size mzxml = head.find("<mzXML");
+    if (mzml != std::string::npos && (mzxml == std::string::npos || mzml < mzxml))
+    {
+      type_ = FileTypes::MZML;
+      scanMzML_(view.data, view.size);
+    }
+    else if (mzxml != std::string::npos)
+    {
+      type_ = FileTypes::MZXML;
+      scanMzXML_(view.data, view.size);
+    }
+    else
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Neither an mzML nor an mzXML file", data_file);
+    }
+    if (run_end_ < 0)
+    {
+      // truncated file: everything up to the end of the file belongs to the run
+      run_end_ = Int64(view.size);
+    }
+  }
+
+  void OffsetIndexFile::scanMzML_(const char* data, Size size)
+  {
+    const char* const end = data + size;
+    const char* p = data;
+    Entry* spectrum = nullptr;
+    Entry* chromatogram = nullptr;
+    std::string value;
+    while ((p = static_cast<const char*>(memchr(p, '<', end - p))) != nullptr)
+    {
+      if (end - p > 4 && strncmp(p, "<!--", 4) == 0)
+      {
+        const char* comment_end = findCommentEnd(p + 4, end);
+        if (comment_end == end) break;
+        p = comment_end + 3;
+        continue;
+      }
+      const char* tag_end = static_cast<const char*>(memchr(p, '>', end - p));
+      if (tag_end == nullptr) break;
+      const char* name = p + 1;
+      if (*name == '/')
+      {
+        ++name;
+        if (spectrum != nullptr && tagIs(name, tag_end, "spectrum"))
+        {
+          spectrum->length = (tag_end + 1 - data) - spectrum->offset;
+          spectrum = nullptr;
+        }
+        else if (chromatogram != nullptr && tagIs(name, tag_end, "chromatogram"))
+        {
+          chromatogram->length = (tag_end + 1 - data) - chromatogram->offset;
+          chromatogram = nullptr;
+        }
+        else if (tagIs(name, tag_end, "run"))
+        {
+          run_end_ = p - data;
+          break;
+        }
+      }
+      else if (spectrum != nullptr)
+      {
+        if (tagIs(name, tag_end, "cvParam") && attribute(name, tag_end, "accession", value))
+        {
+          if (value == "MS:1000511" && attribute(name, tag_end, "value", value))
+          {
+            spectrum->ms_level = String(value).toInt();
+          }
+          else if (value == "MS:1000016" && attribute(name, tag_end, "value", value))
+          {
+            spectrum->rt = String(value).toDouble();
+            std::string unit;
+            if ((attribute(name, tag_end, "unitAccession", unit) && unit == "UO:0000031") ||
+                (attribute(name, tag_end, "unitName", unit) && unit == "minute"))
+            {
+              spectrum->rt *= 60.0;
+            }
+          }
+          else if (value == "MS:1000744" && spectrum->precursor_mz == 0.0 && attribute(name, tag_end, "value", value))
+          {
+            spectrum->precursor_mz = String(value).toDouble();
+          }
+        }
+      }
+      else if (chromatogram == nullptr)
+      {
+        if (tagIs(name, tag_end, "spectrum"))
+        {
+          spectra_.emplace_back();
+          spectrum = &spectra_.back();
+          spectrum->offset = p - data;
+          attribute(name, tag_end, "id", spectrum->native_id);
+        }
+        else if (tagIs(name, tag_end, "chromatogram"))
+        {
+          chromatograms_.emplace_back();
+          chromatogram = &chromatograms_.back();
+          chromatogram->offset = p - data;
+          attribute(name, tag_end, "id", chromatogram->native_id);
+        }
+      }
+      p = tag_end + 1;
+    }
+  }
+
+  void OffsetIndexFile::scanMzXML_(const char* data, Size size)
+  {
+    const char* const end = data + size;
+    const char* p = data;
+    std::vector<Size> open_scans; // indices into spectra_
+    std::string value;
+    while ((p = static_cast<const char*>(memchr(p, '<', end - p))) != nullptr)
+    {
+      if (end - p > 4 && strncmp(p, "<!--", 4) == 0)
+      {
+        const char* comment_end = findCommentEnd(p + 4, end);
+        if (comment_end == end) break;
+        p = comment_end + 3;
+        continue;
+      }
+      const char* tag_end = static_cast<const char*>(memchr(p, '>', end - p));
+      if (tag_end == nullptr) break;
+      const char* name = p + 1;
+      if (*name == '/')
+      {
+        ++name;
+        if (!open_scans.empty() && tagIs(name, tag_end, "scan"))
+        {
+          Entry& scan = spectra_[open_scans.back()];
+          if (!scan.unclosed)
+          {
+            scan.length = (tag_end + 1 - data) - scan.offset;
+          }
+          open_scans.pop_back();
+        }
+        else if (tagIs(name, tag_end, "msRun"))
+        {
+          run_end_ = p - data;
+          break;
+        }
+      }
+      else if (tagIs(name, tag_end, "scan"))
+      {
+        if (!open_scans.empty())
+        {
+          // nested scan (e.g. MS2 scans inside their MS1 scan): the parent ends here
+          Entry& parent = spectra_[open_scans.back()];
+          if (!parent.unclosed)
+          {
+            parent.length = (p - data) - parent.offset;
+            parent.unclosed = true;
+          }
+        }
+        open_scans.push_back(spectra_.size());
+        spectra_.emplace_back();
+        Entry& scan = spectra_.back();
+        scan.offset = p - data;
+        if (attribute(name, tag_end, "num", value))
+        {
+          scan.native_id = String("scan=") + value;
+        }
+        if (attribute(name, tag_end, "msLevel", value))
+        {
+          scan.ms_level = String(value).toInt();
+        }
+        if (attribute(name, tag_end, "retentionTime", value))
+        {
+          scan.rt = durationToSeconds(value);
+        }
+        if (tag_end[-1] == '/')
+        {
+          // empty element
+          scan.length = (tag_end + 1 - data) - scan.offset;
+          open_scans.pop_back();
+        }
+      }
+      else if (!open_scans.empty() && tagIs(name, tag_end, "precursorMz"))
+      {
+        Entry& scan = spectra_[open_scans.back()];
+        const char* text_end = static_cast<const char*>(memchr(tag_end, '<', end - tag_end));
+        if (scan.precursor_mz == 0.0 && text_end != nullptr)
+        {
+          scan.precursor_mz = String(std::string(tag_end + 1, text_end)).trim().toDouble();
+        }
+      }
+      p = tag_end + 1;
+    }
+  }
+
+  void OffsetIndexFile::store(const String& index_file, const String& data_file) const
+  {
+    ofstream os(index_file.c_str());
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, index_file);
+    }
+    os << setprecision(numeric_limits<double>::max_digits10);
+    os << INDEX_HEADER << '\t' << INDEX_VERSION << '\n'
+       << "type\t" << FileTypes::typeToName(type_) << '\n'
+       << "data_size\t" << File::fileSize(data_file) << '\n'
+       << "data_modified\t" << modificationTime(data_file) << '\n'
+       << "run_end\t" << run_end_ << '\n';
+    for (const Entry& e : spectra_)
+    {
+      os << "S\t" << e.offset << '\t' << e.length << '\t' << int(e.unclosed) << '\t' << e.rt << '\t'
+         << e.ms_level << '\t' << e.precursor_mz << '\t' << e.native_id << '\n';
+    }
+    for (const Entry& e : chromatograms_)
+    {
+      os << "C\t" << e.offset << '\t' << e.length << '\t' << e.native_id << '\n';
+    }
+    os.close();
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, index_file);
+    }
+  }
+
+  bool OffsetIndexFile::load(const String& index_file, const String& data_file)
+  {
+    clear();
+    ifstream is(index_file.c_str());
+    if (!is || !File::exists(data_file))
+    {
+      return false;
+    }
+    try
+    {
+      std::string line;
+      std::vector<String> fields;
+      auto header = [&](const char* key) -> String
+      {
+        if (!std::getline(is, line)) return "";
+        String(line).split('\t', fields);
+        if (fields.size() != 2 || fields[0] != key) return "";
+        return fields[1];
+      };
+      if (header(INDEX_HEADER) != INDEX_VERSION) return false;
+      type_ = FileTypes::nameToType(header("type"));
+      if (type_ != FileTypes::MZML && type_ != FileTypes::MZXML) return false;
+      if (header("data_size").toInt64() != Int64(File::fileSize(data_file)) ||
+          header("data_modified").toInt64() != modificationTime(data_file))
+      {
+        // outdated
+        clear();
+        return false;
+      }
+      run_end_ = header("run_end").toInt64();
+      while (std::getline(is, line))
+      {
+        if (line.empty()) continue;
+        // the native ID is the last field and may contain any character but newline
+        Size n_fields = line[0] == 'S' ? 8 : 4;
+        fields.clear();
+        Size start = 0;
+        while (fields.size() + 1 < n_fields)
+        {
+          const Size tab = line.find('\t', start);
+          if (tab == std::string::npos) break;
+          fields.emplace_back(line.substr(start, tab - start));
+          start = tab + 1;
+        }
+        fields.emplace_back(line.substr(start));
+        if (fields.size() != n_fields || (fields[0] != "S" && fields[0] != "C"))
+        {
+          clear();
+          return false;
+        }
+        Entry e;
+        e.offset = fields[1].toInt64();
+        e.length = fields[2].toInt64();
+        if (fields[0] == "S")
+        {
+          e.unclosed = fields[3] == "1";
+          e.rt = fields[4].toDouble();
+          e.ms_level = fields[5].toInt();
+          e.precursor_mz = fields[6].toDouble();
+          e.native_id = fields[7];
+          spectra_.push_back(std::move(e));
+        }
+        else
+        {
+          e.native_id = fields[3];
+          chromatograms_.push_back(std::move(e));
+        }
+      }
+    }
+    catch (Exception::BaseException&)
+    {
+      // conversion errors: not a valid index
+      clear();
+      return false;
+    }
+    return true;
+  }
+
+  void OffsetIndexFile::loadOrScan(const String& data_file, bool write_sidecar)
+  {
+    const String sidecar = getSidecarName(data_file);
+    if (load(sidecar, data_file))
+    {
+      return;
+    }
+    scan(data_file);
+    if (!write_sidecar)
+    {
+      return;
+    }
+    try
+    {
+      store(sidecar, data_file);
+    }
+    catch (Exception::UnableToCreateFile&)
+    {
+      OPENMS_LOG_DEBUG << "Could not write offset index '" << sidecar << "', the index will be rebuilt next time." << std::endl;
+    }
+  }
+
+  String OffsetIndexFile::getSidecarName(const String& data_file)
+  {
+    return data_file + ".offsets";
+  }
+
+  std::string OffsetIndexFile::readElement(const String& data_file, const Entry& entry)
+  {
+    ifstream is(data_file.c_str(), ios::binary);
+    if (!is)
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, data_file);
+    }
+    std::string text;
+    if (entry.offset >= 0 && entry.length > 0)
+    {
+      text.resize(entry.length);
+      is.seekg(entry.offset);
+      is.read(&text[0], entry.length);
+    }
+    if (entry.offset < 0 || entry.length <= 0 || is.gcount() != entry.length)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "Element '" + entry.native_id + "' at offset " + String(entry.offset) + " is outside of the file", data_file);
+    }
+    if (entry.unclosed)
+    {
+      text += "</scan>";
+    }
+    return text;
+  }
+
+  void OffsetIndexFile::clear()
+  {
+    type_ = FileTypes::UNKNOWN;
+    spectra_.clear();
+    chromatograms_.clear();
+    run_end_ = -1;
+  }
+
+  FileTypes::Type OffsetIndexFile::getFileType() const
+  {
+    return type_;
+  }
+
+  const std::vector<OffsetIndexFile::Entry>& OffsetIndexFile::getSpectra() const
+  {
+    return spectra_;
+  }
+
+  const std::vector<OffsetIndexFile::Entry>& OffsetIndexFile::getChromatograms() const
+  {
+    return chromatograms_;
+  }
+
+  Int64 OffsetIndexFile::getRunEnd() const
+  {
+    return run_end_;
+  }
+
+} // namespace OpenMS
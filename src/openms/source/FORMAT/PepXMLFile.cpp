@@ -1011,25 +1011,7 @@ namespace OpenMS
     {
       fatalError(LOAD, "Found no experiment with name '" + experiment_name + "'");
     }
-    // clean up duplicate ProteinHits in each ProteinIdentification separately:
-    // (can't use "sort" and "unique" because no "op<" defined for ProteinHit)
-    for (ProteinIdentification& prot_it : proteins)
-    {
-      set<String> accessions;
-      // modeled after "remove_if" in STL header "algorithm":
-      vector<ProteinHit>::iterator first = prot_it.getHits().begin();
-      vector<ProteinHit>::iterator result = first;
-      for (; first != prot_it.getHits().end(); ++first)
-      {
-        String accession = first->getAccession();
-        bool new_element = accessions.insert(accession).second;
-        if (new_element) // don't remove
-        {
-          *result++ = *first;
-        }
-      }
-      prot_it.getHits().erase(result, first);
-    }
+    // duplicate ProteinHits were skipped during parsing (see insertProteinHit_)
 
     // reset members
     exp_name_.clear();
@@ -1039,6 +1021,20 @@ namespace OpenMS
     peptides_ = nullptr;
     lookup_ = nullptr;
     scan_map_.clear();
+    protein_accessions_.clear();
+    mod_db_cache_.clear(); // the database may change between calls
+  }
+
+  void PepXMLFile::insertProteinHit_(const ProteinHit& hit)
+  {
+    // depending on the numbering scheme used in the pepXML, "search_id_"
+    // may appear to be "out of bounds" - see NOTE above:
+    vector<ProteinIdentification>::iterator prot_it = current_proteins_[min(UInt(current_proteins_.size()), search_id_) - 1];
+    // (can't use "sort" and "unique" on the hits later because no "op<" defined for ProteinHit)
+    if (protein_accessions_[prot_it - proteins_->begin()].insert(hit.getAccession()).second)
+    {
+      prot_it->insertHit(hit);
+    }
   }
 
   /*
@@ -1359,9 +1355,7 @@ namespace OpenMS
       }
       peptide_hit_.addPeptideEvidence(pe);
 
-      // depending on the numbering scheme used in the pepXML, "search_id_"
-      // may appear to be "out of bounds" - see NOTE above:
-      current_proteins_[min(UInt(current_proteins_.size()), search_id_) - 1]->insertHit(hit);
+      insertProteinHit_(hit);
     }
     else if (element == "search_result") // parent: "spectrum_query"
     {
@@ -1660,10 +1654,7 @@ namespace OpenMS
       }
       peptide_hit_.addPeptideEvidence(pe);
 
-      // depending on the numbering scheme used in the pepXML, "search_id_"
-      // may appear to be "out of bounds" - see NOTE above:
-      current_proteins_[min(UInt(current_proteins_.size()), search_id_) - 1]->
-      insertHit(hit);
+      insertProteinHit_(hit);
     }
     else if (element == "mod_aminoacid_mass") // parent: "modification_info" (in "search_hit")
     {
@@ -1702,48 +1693,53 @@ namespace OpenMS
 
         if (!found)
         {
-          // Lookup in our DB
-          //TODO also here, maybe the static/variable attribute is better for diffmass if present?
-          double diffmass = modification_mass - ResidueDB::getInstance()->getResidue(origin)->getMonoWeight(Residue::Internal);
-          vector<const ResidueModification*> mods;
-          // try least specific search first:
-          ModificationsDB::getInstance()->searchModificationsByDiffMonoMass(mods, diffmass, mod_tol_, origin, ResidueModification::ANYWHERE);
-          if (mods.empty())
+          // Lookup in our DB (the same modification occurs in many search hits, so the result is cached)
+          int terminus = (modification_position == 1) ? 0 : (modification_position == current_sequence_.length()) ? 1 : 2;
+          auto key = make_tuple(origin[0], modification_mass, terminus);
+          auto cached = mod_db_cache_.find(key);
+          if (cached == mod_db_cache_.end())
           {
-            if (modification_position == 1)
+            //TODO also here, maybe the static/variable attribute is better for diffmass if present?
+            double diffmass = modification_mass - ResidueDB::getInstance()->getResidue(origin)->getMonoWeight(Residue::Internal);
+            vector<const ResidueModification*> mods;
+            // try least specific search first:
+            ModificationsDB::getInstance()->searchModificationsByDiffMonoMass(mods, diffmass, mod_tol_, origin, ResidueModification::ANYWHERE);
+            if (mods.empty())
             {
-              ModificationsDB::getInstance()->searchModificationsByDiffMonoMass(mods, diffmass, mod_tol_, origin, ResidueModification::N_TERM);
-              if (mods.empty()) ModificationsDB::getInstance()->searchModificationsByDiffMonoMass(mods, diffmass, mod_tol_, origin, ResidueModification::PROTEIN_N_TERM);
+              if (terminus == 0)
+              {
+                ModificationsDB::getInstance()->searchModificationsByDiffMonoMass(mods, diffmass, mod_tol_, origin, ResidueModification::N_TERM);
+                if (mods.empty()) ModificationsDB::getInstance()->searchModificationsByDiffMonoMass(mods, diffmass, mod_tol_, origin, ResidueModification::PROTEIN_N_TERM);
+              }
+              else if (terminus == 1)
+              {
+                ModificationsDB::getInstance()->searchModificationsByDiffMonoMass(mods, diffmass, mod_tol_, origin, ResidueModification::C_TERM);
+                if (mods.empty()) ModificationsDB::getInstance()->searchModificationsByDiffMonoMass(mods, diffmass, mod_tol_, origin, ResidueModification::PROTEIN_C_TERM);
+              }
             }
-            else if (modification_position == current_sequence_.length())
+            if (!mods.empty())
             {
-              ModificationsDB::getInstance()->searchModificationsByDiffMonoMass(mods, diffmass, mod_tol_, origin, ResidueModification::C_TERM);
-              if (mods.empty()) ModificationsDB::getInstance()->searchModificationsByDiffMonoMass(mods, diffmass, mod_tol_, origin, ResidueModification::PROTEIN_C_TERM);
+              cached = mod_db_cache_.emplace(key, make_pair(mods[0], mods.size() > 1)).first;
             }
-          }
-          if (!mods.empty())
-          {
-            if (mods.size() > 1)
+            else
             {
-              warning(LOAD, String("Modification '") + String(modification_mass) + "' of residue " + String(origin) + " at position "
-              + String(modification_position) + " in '" + current_sequence_ + "' not registered in pepXML header nor uniquely defined in DB." +
-              " Using " + mods[0]->getFullId());
-              current_modifications_.emplace_back(mods[0], modification_position - 1);
+              // still nothing found, register as unknown as last resort
+              const ResidueModification* unknown = ResidueModification::createUnknownFromMassString(
+                  String(modification_mass),
+                  modification_mass,
+                  false,
+                  ResidueModification::ANYWHERE, // since it is at an amino acid it is probably NOT a terminal mod
+                  ResidueDB::getInstance()->getResidue(current_sequence_[modification_position - 1]));
+              cached = mod_db_cache_.emplace(key, make_pair(unknown, false)).first;
             }
           }
-          else
+          if (cached->second.second)
           {
-            // still nothing found, register as unknown as last resort
-            current_modifications_.emplace_back(
-                ResidueModification::createUnknownFromMassString(
-                    String(modification_mass),
-                    modification_mass,
-                    false,
-                    ResidueModification::ANYWHERE, // since it is at an amino acid it is probably NOT a terminal mod
-                    ResidueDB::getInstance()->getResidue(current_sequence_[modification_position - 1])),
-                modification_position - 1
-            );
+            warning(LOAD, String("Modification '") + String(modification_mass) + "' of residue " + String(origin) + " at position "
+            + String(modification_position) + " in '" + current_sequence_ + "' not registered in pepXML header nor uniquely defined in DB." +
+            " Using " + cached->second.first->getFullId());
           }
+          current_modifications_.emplace_back(cached->second.first, modification_position - 1);
         }
       }
     }
@@ -10,18 +10,66 @@
 
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/CONCEPT/Constants.h>
+#include <OpenMS/DATASTRUCTURES/StringConversions.h>
+#include <OpenMS/METADATA/MetaInfoRegistry.h>
 #include <OpenMS/METADATA/SpectrumLookup.h>
 #include <OpenMS/FORMAT/CsvFile.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 
+#include <cmath>
+#include <exception>
+#include <limits>
 #include <regex>
 #include <functional>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace OpenMS
 {
   using namespace std;
 
+  namespace
+  {
+    /// Column of a pin file: a feature computed for the pin file or a meta value of the PeptideHit
+    struct PinColumn
+    {
+      enum Type
+      {
+        META_VALUE, SPEC_ID, SCAN_NR, LABEL, CALC_MASS, EXP_MASS, MASS, DELTA_MASS, ABS_DELTA_MASS,
+        RETENTION_TIME, SCORE, PEPLEN, CHARGE, ENZ_N, ENZ_C, ENZ_INT, PEPTIDE, PROTEINS
+      };
+      Type type;
+      UInt meta_index; ///< for META_VALUE
+      int charge; ///< for CHARGE
+    };
+
+    /// Features computed for the pin file (all others are meta values of the PeptideHit)
+    const unordered_map<String, PinColumn::Type> pin_builtin_columns = {
+      {"SpecId", PinColumn::SPEC_ID}, {"ScanNr", PinColumn::SCAN_NR}, {"Label", PinColumn::LABEL},
+      {"CalcMass", PinColumn::CALC_MASS}, {"ExpMass", PinColumn::EXP_MASS}, {"mass", PinColumn::MASS},
+      {"deltamass", PinColumn::DELTA_MASS}, {"dm", PinColumn::DELTA_MASS}, {"absdm", PinColumn::ABS_DELTA_MASS},
+      {"retentiontime", PinColumn::RETENTION_TIME}, {"score", PinColumn::SCORE}, {"peplen", PinColumn::PEPLEN},
+      {"enzN", PinColumn::ENZ_N}, {"enzC", PinColumn::ENZ_C}, {"enzInt", PinColumn::ENZ_INT},
+      {"Peptide", PinColumn::PEPTIDE}, {"Proteins", PinColumn::PROTEINS}};
+
+    /// Appends @p value to @p line, formatted like DataValue(value).toString()
+    void appendPinNumber(int value, String& line)
+    {
+      StringConversions::append(value, line);
+    }
+
+    /// Appends @p value to @p line, formatted like DataValue(value).toString()
+    void appendPinNumber(double value, String& line)
+    {
+      if (std::fabs(value) < std::numeric_limits<double>::min())
+      {
+        line += "0.0"; // as String(double)
+        return;
+      }
+      StringConversions::append(value, line);
+    }
+  }
+
   void PercolatorInfile::store(const String& pin_file,
     const vector<PeptideIdentification>& peptide_ids, 
     const StringList& feature_set, 
@@ -396,157 +444,227 @@ namespace OpenMS
     // determine RegEx to extract scan/index number
     boost::regex scan_regex = boost::regex(SpectrumLookup::getRegExFromNativeID(sid));
 
-    // keep track of errors
-    size_t missing_meta_value_count{};
-    set<String> missing_meta_values;
-
-    size_t index = 0;
-    for (const PeptideIdentification& pep_id : peptide_ids)
+    // Resolve the columns once: the pin specific features are computed and formatted directly into
+    // the line, all others are read by their meta value index (no registry lookups by name per hit,
+    // which would serialize the threads).
+    const MetaInfoRegistry& registry = MetaInfoInterface::metaRegistry();
+    vector<PinColumn> columns;
+    columns.reserve(feature_set.size());
+    for (const String& feat : feature_set)
     {
-      index++;
-      // try to make a file and scan unique identifier
-      String scan_identifier = getScanIdentifier(pep_id, index);
-      String file_identifier = pep_id.getMetaValue("file_origin", String());
-
-      file_identifier += (String)pep_id.getMetaValue("id_merge_index", String());
-
-      Int scan_number = SpectrumLookup::extractScanNumber(scan_identifier, scan_regex, true);
-      
-      double exp_mass = pep_id.getMZ();
-      double retention_time = pep_id.getRT();
-      for (const PeptideHit& psm : pep_id.getHits())
+      PinColumn column{PinColumn::META_VALUE, registry.getIndex(feat), 0};
+      if (const auto builtin = pin_builtin_columns.find(feat); builtin != pin_builtin_columns.end())
       {
-        if (psm.getPeptideEvidences().empty())
-        {
-          OPENMS_LOG_WARN << "PSM (PeptideHit) without protein reference found. "
-                  << "This may indicate incomplete mapping during PeptideIndexing (e.g., wrong enzyme settings)." 
-                  << "Will skip this PSM." << endl;
-          continue;
-        }
-        PeptideHit hit(psm); // make a copy of the hit to store temporary features
-        hit.setMetaValue("SpecId", file_identifier + scan_identifier);
-        hit.setMetaValue("ScanNr", scan_number);
-        
-        if (!hit.metaValueExists("target_decoy") 
-          || hit.getMetaValue("target_decoy").toString().empty()) 
-        {
-          continue;
-        }
-        
-        int label = 1;
-        if (hit.getMetaValue("target_decoy") == "decoy")
-        {
-          label = -1;
-        }
-        hit.setMetaValue("Label", label);
-        
-        int charge = hit.getCharge();
-        String unmodified_sequence = hit.getSequence().toUnmodifiedString();
-      
-        double calc_mass; 
-        if (!hit.metaValueExists("CalcMass"))
+        column.type = builtin->second;
+      }
+      else
+      {
+        // one-hot encoded charges of the requested range
+        for (int z = min_charge; z <= max_charge; ++z)
         {
-          calc_mass = hit.getSequence().getMZ(charge);
-          hit.setMetaValue("CalcMass", calc_mass); // Percolator calls is CalcMass instead of m/z
+          if (feat == "charge" + String(z))
+          {
+            column.type = PinColumn::CHARGE;
+            column.charge = z;
+            break;
+          }
         }
-        else
+      }
+      columns.push_back(column);
+    }
+    const UInt target_decoy_index = registry.getIndex("target_decoy");
+    const UInt calc_mass_index = registry.getIndex("CalcMass");
+    const UInt isotope_error_index = registry.getIndex("IsotopeError");
+    const UInt openms_isotope_error_index = registry.getIndex(Constants::UserParam::ISOTOPE_ERROR);
+    const UInt file_origin_index = registry.getIndex("file_origin");
+    const UInt id_merge_index_index = registry.getIndex("id_merge_index");
+
+    // format the lines of each peptide identification in parallel, then add them in input order
+    vector<vector<String>> lines(peptide_ids.size());
+    vector<vector<char>> missing_features(peptide_ids.size()); // per column, only filled if some are missing
+    vector<Size> missing_meta_value_counts(peptide_ids.size(), 0);
+    std::exception_ptr error;
+    SignedSize error_idx = std::numeric_limits<SignedSize>::max();
+
+#pragma omp parallel for schedule(dynamic, 256)
+    for (SignedSize p = 0; p < (SignedSize)peptide_ids.size(); ++p)
+    {
+      try
+      {
+        const PeptideIdentification& pep_id = peptide_ids[p];
+        const size_t index = p + 1;
+        // try to make a file and scan unique identifier
+        const String scan_identifier = getScanIdentifier(pep_id, index);
+        String file_identifier = pep_id.getMetaValue(file_origin_index, String()).toString();
+        file_identifier += pep_id.getMetaValue(id_merge_index_index, String()).toString();
+        const String spec_id = file_identifier + scan_identifier;
+
+        const Int scan_number = SpectrumLookup::extractScanNumber(scan_identifier, scan_regex, true);
+
+        double exp_mass = pep_id.getMZ();
+        const double retention_time = pep_id.getRT();
+        for (const PeptideHit& hit : pep_id.getHits())
         {
-          calc_mass = hit.getMetaValue("CalcMass");
-        }
+          if (hit.getPeptideEvidences().empty())
+          {
+            OPENMS_LOG_WARN << "PSM (PeptideHit) without protein reference found. "
+                    << "This may indicate incomplete mapping during PeptideIndexing (e.g., wrong enzyme settings)." 
+                    << "Will skip this PSM." << endl;
+            continue;
+          }
 
-        if (hit.metaValueExists("IsotopeError"))  // for backwards compatibility (generated by MSGFPlusAdaper OpenMS < 2.6)
-        {
-          float isoErr = hit.getMetaValue("IsotopeError").toString().toFloat();
-          exp_mass = exp_mass - (isoErr * Constants::C13C12_MASSDIFF_U) / charge;
-        }
-        else if (hit.metaValueExists(Constants::UserParam::ISOTOPE_ERROR)) // OpenMS user param name for isotope error
-        {
-          float isoErr = hit.getMetaValue(Constants::UserParam::ISOTOPE_ERROR).toString().toFloat();
-          exp_mass = exp_mass - (isoErr * Constants::C13C12_MASSDIFF_U) / charge;
-        }
-                
-        hit.setMetaValue("ExpMass", exp_mass);
+          if (!hit.metaValueExists(target_decoy_index)
+            || hit.getMetaValue(target_decoy_index).toString().empty()) 
+          {
+            continue;
+          }
 
-        // needed in case "description of correct" option is used
-        double delta_mass = exp_mass - calc_mass;
-        hit.setMetaValue("deltamass", delta_mass);
-        hit.setMetaValue("retentiontime", retention_time);
+          const int label = (hit.getMetaValue(target_decoy_index) == "decoy") ? -1 : 1;
 
-        hit.setMetaValue("mass", exp_mass);
-        
-        double score = hit.getScore();
-        // TODO better to use log scores for E-value based scores
-        hit.setMetaValue("score", score);
-        
-        int peptide_length = unmodified_sequence.size();
-        hit.setMetaValue("peplen", peptide_length);
-        
-        for (int i = min_charge; i <= max_charge; ++i)
-        {
-          hit.setMetaValue("charge" + String(i), charge == i);
-        }
+          const int charge = hit.getCharge();
+          const String unmodified_sequence = hit.getSequence().toUnmodifiedString();
 
-        // just first peptide evidence
-        char aa_before = hit.getPeptideEvidences().front().getAABefore();
-        char aa_after = hit.getPeptideEvidences().front().getAAAfter();
+          const bool has_calc_mass = hit.metaValueExists(calc_mass_index);
+          const double calc_mass = has_calc_mass ? double(hit.getMetaValue(calc_mass_index)) : hit.getSequence().getMZ(charge); // Percolator calls is CalcMass instead of m/z
 
-        bool enzN = isEnz_(aa_before, unmodified_sequence.prefix(1)[0], enz);
-        hit.setMetaValue("enzN", enzN);
-        bool enzC = isEnz_(unmodified_sequence.suffix(1)[0], aa_after, enz);
-        hit.setMetaValue("enzC", enzC);
-        int enzInt = countEnzymatic_(unmodified_sequence, enz);
-        hit.setMetaValue("enzInt", enzInt);
+          if (hit.metaValueExists(isotope_error_index))  // for backwards compatibility (generated by MSGFPlusAdaper OpenMS < 2.6)
+          {
+            float isoErr = hit.getMetaValue(isotope_error_index).toString().toFloat();
+            exp_mass = exp_mass - (isoErr * Constants::C13C12_MASSDIFF_U) / charge;
+          }
+          else if (hit.metaValueExists(openms_isotope_error_index)) // OpenMS user param name for isotope error
+          {
+            float isoErr = hit.getMetaValue(openms_isotope_error_index).toString().toFloat();
+            exp_mass = exp_mass - (isoErr * Constants::C13C12_MASSDIFF_U) / charge;
+          }
 
-        hit.setMetaValue("dm", delta_mass);
-        
-        double abs_delta_mass = abs(delta_mass);
-        hit.setMetaValue("absdm", abs_delta_mass);
-        
-        //peptide
-        String sequence = "";
-
-        aa_before = aa_before == '[' ? '-' : aa_before;
-        aa_after = aa_after == ']' ? '-' : aa_after;
-
-        sequence += aa_before;
-        sequence += "."; 
-        // Percolator uses square brackets to indicate PTMs
-        sequence += hit.getSequence().toBracketString(false, true);
-        sequence += "."; 
-        sequence += aa_after;
-        
-        hit.setMetaValue("Peptide", sequence);
-        
-        //proteinId1
-        StringList proteins;
-        for (const PeptideEvidence& pep : hit.getPeptideEvidences())
-        {
-          proteins.push_back(pep.getProteinAccession());
+          // needed in case "description of correct" option is used
+          const double delta_mass = exp_mass - calc_mass;
+
+          // just first peptide evidence
+          char aa_before = hit.getPeptideEvidences().front().getAABefore();
+          char aa_after = hit.getPeptideEvidences().front().getAAAfter();
+
+          const bool enzN = isEnz_(aa_before, unmodified_sequence.prefix(1)[0], enz);
+          const bool enzC = isEnz_(unmodified_sequence.suffix(1)[0], aa_after, enz);
+
+          String line;
+          bool complete = true;
+          for (Size c = 0; c < columns.size(); ++c)
+          {
+            if (c > 0)
+            {
+              line += '\t';
+            }
+            const PinColumn& column = columns[c];
+            switch (column.type)
+            {
+              case PinColumn::META_VALUE:
+                // Some Hits have no NumMatchedMainIons, and MeanError, etc. values. Have to ignore them!
+                if (hit.metaValueExists(column.meta_index))
+                {
+                  line += hit.getMetaValue(column.meta_index).toString();
+                }
+                else
+                {
+                  if (missing_features[p].empty())
+                  {
+                    missing_features[p].resize(columns.size(), 0);
+                  }
+                  missing_features[p][c] = 1;
+                  complete = false;
+                }
+                break;
+              case PinColumn::SPEC_ID: line += spec_id; break;
+              case PinColumn::SCAN_NR: appendPinNumber(scan_number, line); break;
+              case PinColumn::LABEL: appendPinNumber(label, line); break;
+              case PinColumn::CALC_MASS:
+                if (has_calc_mass)
+                {
+                  line += hit.getMetaValue(calc_mass_index).toString();
+                }
+                else
+                {
+                  appendPinNumber(calc_mass, line);
+                }
+                break;
+              case PinColumn::EXP_MASS: // fall through
+              case PinColumn::MASS: appendPinNumber(exp_mass, line); break;
+              case PinColumn::DELTA_MASS: appendPinNumber(delta_mass, line); break;
+              case PinColumn::ABS_DELTA_MASS: appendPinNumber(abs(delta_mass), line); break;
+              case PinColumn::RETENTION_TIME: appendPinNumber(retention_time, line); break;
+              // TODO better to use log scores for E-value based scores
+              case PinColumn::SCORE: appendPinNumber(hit.getScore(), line); break;
+              case PinColumn::PEPLEN: appendPinNumber(int(unmodified_sequence.size()), line); break;
+              case PinColumn::CHARGE: appendPinNumber(int(charge == column.charge), line); break;
+              case PinColumn::ENZ_N: appendPinNumber(int(enzN), line); break;
+              case PinColumn::ENZ_C: appendPinNumber(int(enzC), line); break;
+              case PinColumn::ENZ_INT: appendPinNumber(int(countEnzymatic_(unmodified_sequence, enz)), line); break;
+              case PinColumn::PEPTIDE:
+                line += aa_before == '[' ? '-' : aa_before;
+                line += '.';
+                // Percolator uses square brackets to indicate PTMs
+                line += hit.getSequence().toBracketString(false, true);
+                line += '.';
+                line += aa_after == ']' ? '-' : aa_after;
+                break;
+              case PinColumn::PROTEINS:
+                //proteinId1 <tab> .. <tab> proteinIdM
+                for (Size e = 0; e < hit.getPeptideEvidences().size(); ++e)
+                {
+                  if (e > 0)
+                  {
+                    line += '\t';
+                  }
+                  line += hit.getPeptideEvidences()[e].getProteinAccession();
+                }
+                break;
+            }
+          }
+
+          if (complete)
+          { // only if all feats were present add
+            lines[p].push_back(std::move(line));
+          }
+          else
+          { // at least one feature is missing in the current peptide hit
+            ++missing_meta_value_counts[p];
+          }
         }
-        hit.setMetaValue("Proteins", ListUtils::concatenate(proteins, '\t'));
-        
-        StringList feats;
-        for (const String& feat : feature_set)
+      }
+      catch (...)
+      {
+#pragma omp critical (PercolatorInfile_preparePin)
         {
-        // Some Hits have no NumMatchedMainIons, and MeanError, etc. values. Have to ignore them!
-          if (hit.metaValueExists(feat))
+          // report the error of the first peptide identification (as a sequential run would)
+          if (p < error_idx)
           {
-            feats.push_back(hit.getMetaValue(feat).toString());
+            error_idx = p;
+            error = std::current_exception();
           }
         }
-        // here: feats (metavalues in peptide hits) and feature_set are equal if they have same size (if no metavalue is missing)
+      }
+    }
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
 
-        if (feats.size() == feature_set.size())
-        { // only if all feats were present add
-          txt.addLine(ListUtils::concatenate(feats, '\t'));
-        }        
-        else
-        { // at least one feature is missing in the current peptide hit
-          missing_meta_value_count++;        
-          for (const auto& f : feature_set)
-          {
-            if (std::find(feats.begin(), feats.end(), f) == feats.end()) missing_meta_values.insert(f);
-          }
+    // keep track of errors
+    size_t missing_meta_value_count{};
+    set<String> missing_meta_values;
+    for (Size p = 0; p < peptide_ids.size(); ++p)
+    {
+      for (const String& line : lines[p])
+      {
+        txt.addLine(line);
+      }
+      missing_meta_value_count += missing_meta_value_counts[p];
+      for (Size c = 0; c < missing_features[p].size(); ++c)
+      {
+        if (missing_features[p][c])
+        {
+          missing_meta_values.insert(feature_set[c]);
         }
       }
     }
@@ -0,0 +1,123 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/ReadAheadBuffer.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+namespace OpenMS
+{
+
+  ReadAheadBuffer::ReadAheadBuffer(Producer producer, Size block_size, Size max_blocks) :
+    producer_(std::move(producer)),
+    block_size_(std::max(block_size, Size(1))),
+    max_blocks_(std::max(max_blocks, Size(1)))
+  {
+    thread_ = std::thread(&ReadAheadBuffer::run_, this);
+  }
+
+  ReadAheadBuffer::~ReadAheadBuffer()
+  {
+    {
+      lock_guard<mutex> lock(mutex_);
+      stop_ = true;
+    }
+    not_full_.notify_all();
+    thread_.join();
+  }
+
+  void ReadAheadBuffer::run_()
+  {
+    try
+    {
+      bool end = false;
+      while (!end)
+      {
+        vector<char> block(block_size_);
+        Size filled = 0;
+        while (filled < block_size_ && !end)
+        {
+          filled += producer_(block.data() + filled, block_size_ - filled, end);
+        }
+        block.resize(filled);
+
+        unique_lock<mutex> lock(mutex_);
+        not_full_.wait(lock, [this] { return stop_ || blocks_.size() < max_blocks_; });
+        if (stop_)
+        {
+          return;
+        }
+        if (!block.empty())
+        {
+          blocks_.push_back(std::move(block));
+        }
+        done_ = end;
+        lock.unlock();
+        not_empty_.notify_one();
+      }
+    }
+    catch (...)
+    {
+      {
+        lock_guard<mutex> lock(mutex_);
+        error_ = current_exception();
+        done_ = true;
+      }
+      not_empty_.notify_one();
+    }
+  }
+
+  bool ReadAheadBuffer::nextBlock_()
+  {
+    unique_lock<mutex> lock(mutex_);
+    not_empty_.wait(lock, [this] { return done_ || !blocks_.empty(); });
+    if (blocks_.empty())
+    {
+      return false;
+    }
+    current_ = std::move(blocks_.front());
+    blocks_.pop_front();
+    current_pos_ = 0;
+    lock.unlock();
+    not_full_.notify_one();
+    return true;
+  }
+
+  size_t ReadAheadBuffer::read(char* s, size_t n)
+  {
+    size_t copied = 0;
+    while (copied < n && !at_end_)
+    {
+      if (current_pos_ == current_.size() && !nextBlock_())
+      {
+        at_end_ = true;
+        break;
+      }
+      size_t count = std::min(n - copied, current_.size() - current_pos_);
+      memcpy(s + copied, current_.data() + current_pos_, count);
+      copied += count;
+      current_pos_ += count;
+    }
+    // detect the end right away, like a stream that is closed by the read which reached its end
+    if (!at_end_ && current_pos_ == current_.size() && !nextBlock_())
+    {
+      at_end_ = true;
+    }
+    if (at_end_ && error_ && copied == 0)
+    {
+      exception_ptr error = error_;
+      error_ = nullptr;
+      rethrow_exception(error);
+    }
+    return copied;
+  }
+
+} // namespace OpenMS
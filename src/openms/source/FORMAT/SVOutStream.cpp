@@ -20,7 +20,8 @@ namespace OpenMS
                            String::QuotingMethod quoting)
     :
     ostream(nullptr), ofs_(nullptr), sep_(sep), replacement_(replacement), nan_("nan"),
-    inf_("inf"), quoting_(quoting), modify_strings_(true), newline_(true)
+    inf_("inf"), quoting_(quoting), modify_strings_(true), newline_(true),
+    number_format_(NUMBER_STRING), precision_(6)
   {
     ofs_ = new std::ofstream;
     ofs_->open(file_out.c_str());
@@ -41,13 +42,23 @@ namespace OpenMS
                            const String& replacement,
                            String::QuotingMethod quoting) :
     ostream(out.rdbuf()), ofs_(nullptr), sep_(sep), replacement_(replacement), nan_("nan"),
-    inf_("inf"), quoting_(quoting), modify_strings_(true), newline_(true)
+    inf_("inf"), quoting_(quoting), modify_strings_(true), newline_(true),
+    number_format_(NUMBER_STRING), precision_(6)
   {
     // use high decimal precision (appropriate for double):
     precision(std::numeric_limits<double>::digits10);
   }
 
 
+  SVOutStream::SVOutStream(ostream& out, const SVOutStream& settings) :
+    ostream(out.rdbuf()), ofs_(nullptr), sep_(settings.sep_), replacement_(settings.replacement_),
+    nan_(settings.nan_), inf_(settings.inf_), quoting_(settings.quoting_),
+    modify_strings_(settings.modify_strings_), newline_(true),
+    number_format_(settings.number_format_), precision_(settings.precision_)
+  {
+    precision(settings.precision());
+  }
+
   SVOutStream::~SVOutStream()
   {
     if (ofs_)
@@ -64,14 +75,7 @@ namespace OpenMS
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "argument must not contain newline characters");
     }
 
-    if (!newline_)
-    {
-      (ostream&) *this << sep_;
-    }
-    else
-    {
-      newline_ = false;
-    }
+    writeSeparator_();
 
     if (!modify_strings_)
     {
@@ -139,4 +143,27 @@ namespace OpenMS
     return old;
   }
 
+  void SVOutStream::setNumberFormat(NumberFormat format, int precision)
+  {
+    if (precision < 0)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "precision must not be negative");
+    }
+    number_format_ = format;
+    precision_ = precision;
+  }
+
+  SVOutStream::NumberFormat SVOutStream::getNumberFormat() const
+  {
+    return number_format_;
+  }
+
+  void SVOutStream::checkLineStart_() const
+  {
+    if (!newline_)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "rows must start at the beginning of a line and end with a newline");
+    }
+  }
+
 } // namespace OpenMS
@@ -0,0 +1,182 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/SpillableSpectrumList.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/FORMAT/HANDLERS/CachedMzMLHandler.h>
+#include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/SYSTEM/MemoryBudget.h>
+
+#include <algorithm>
+
+namespace OpenMS
+{
+  namespace
+  {
+    /// gives access to the record writer of cached mzML
+    class SpillWriter :
+      public Internal::CachedMzMLHandler
+    {
+public:
+      void write(const MSSpectrum& spectrum, std::ostream& os) const
+      {
+        writeSpectrum_(spectrum, os);
+      }
+    };
+  }
+
+  SpillableSpectrumList::SpillableSpectrumList(const String& cache_file, Size block_size) :
+    block_size_(block_size)
+  {
+    if (block_size_ == 0)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Block size must be positive.");
+    }
+    cache_file_ = File::getTemporaryFile(cache_file);
+  }
+
+  SpillableSpectrumList::~SpillableSpectrumList()
+  {
+    if (ofs_.is_open())
+    {
+      ofs_.close();
+      ifs_.close();
+      File::remove(cache_file_);
+    }
+  }
+
+  void SpillableSpectrumList::push_back(MSSpectrum spectrum)
+  {
+    if (spectra_.size() % block_size_ == 0)
+    {
+      blocks_.emplace_back();
+    }
+    blocks_.back().last_access = ++access_counter_;
+    spectra_.push_back(std::move(spectrum));
+    offsets_.push_back(0);
+
+    if (spectra_.size() % block_size_ == 0 && MemoryBudget::isExceeded())
+    {
+      spillColdest_();
+    }
+  }
+
+  MSSpectrum SpillableSpectrumList::getSpectrum(Size index) const
+  {
+    if (index >= spectra_.size())
+    {
+      throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, index, spectra_.size());
+    }
+    const Block& block = blocks_[index / block_size_];
+    if (!block.spilled)
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        block.last_access = ++access_counter_;
+      }
+      return spectra_[index];
+    }
+
+    MSSpectrum spectrum = spectra_[index];
+    std::lock_guard<std::mutex> lock(mutex_);
+    block.last_access = ++access_counter_;
+    if (!ifs_.is_open())
+    {
+      ifs_.open(cache_file_.c_str(), std::ios::binary);
+    }
+    ifs_.clear();
+    ifs_.seekg(offsets_[index]);
+    Internal::CachedMzMLHandler::readSpectrum(spectrum, ifs_);
+    if (!ifs_)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, cache_file_, "Could not read spilled spectrum " + String(index));
+    }
+    return spectrum;
+  }
+
+  Size SpillableSpectrumList::getSpilledCount() const
+  {
+    Size count = 0;
+    for (Size b = 0; b < blocks_.size(); ++b)
+    {
+      if (blocks_[b].spilled)
+      {
+        count += std::min(block_size_, spectra_.size() - b * block_size_);
+      }
+    }
+    return count;
+  }
+
+  void SpillableSpectrumList::spill()
+  {
+    for (Size b = 0; b < spectra_.size() / block_size_; ++b)
+    {
+      if (!blocks_[b].spilled)
+      {
+        spillBlock_(b);
+      }
+    }
+  }
+
+  void SpillableSpectrumList::spillColdest_()
+  {
+    Size coldest = blocks_.size();
+    for (Size b = 0; b < spectra_.size() / block_size_; ++b)
+    {
+      if (!blocks_[b].spilled && (coldest == blocks_.size() || blocks_[b].last_access < blocks_[coldest].last_access))
+      {
+        coldest = b;
+      }
+    }
+    if (coldest != blocks_.size())
+    {
+      spillBlock_(coldest);
+    }
+  }
+
+  void SpillableSpectrumList::spillBlock_(Size block)
+  {
+    if (!ofs_.is_open())
+    {
+      ofs_.open(cache_file_.c_str(), std::ios::binary | std::ios::trunc);
+      if (!ofs_)
+      {
+        throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, cache_file_);
+      }
+    }
+
+    SpillWriter writer;
+    const Size end = std::min((block + 1) * block_size_, spectra_.size());
+    for (Size i = block * block_size_; i < end; ++i)
+    {
+      MSSpectrum& s = spectra_[i];
+      // integer and string data arrays stay in memory (the record would store integer arrays as float arrays)
+      MSSpectrum::IntegerDataArrays integer_arrays;
+      integer_arrays.swap(s.getIntegerDataArrays());
+      MSSpectrum::StringDataArrays string_arrays;
+      string_arrays.swap(s.getStringDataArrays());
+
+      offsets_[i] = ofs_.tellp();
+      writer.write(s, ofs_);
+
+      // a copy of the cleared spectrum does not hold on to the capacity of the peak container
+      s.clear(false);
+      MSSpectrum released(s);
+      s = std::move(released);
+      s.getIntegerDataArrays().swap(integer_arrays);
+      s.getStringDataArrays().swap(string_arrays);
+    }
+    ofs_.flush();
+    if (!ofs_)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, cache_file_);
+    }
+    blocks_[block].spilled = true;
+  }
+}
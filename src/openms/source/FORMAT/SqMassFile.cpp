@@ -9,6 +9,12 @@
 #include <OpenMS/FORMAT/SqMassFile.h>
 
 #include <OpenMS/FORMAT/HANDLERS/MzMLSqliteHandler.h>
+#include <OpenMS/FORMAT/SqliteConnector.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <sqlite3.h>
+
+#include <algorithm>
 
 namespace OpenMS
 {
@@ -32,6 +38,68 @@ namespace OpenMS
     sql_mass.writeExperiment(map);
   }
 
+  namespace Sql = Internal::SqliteHelper;
+
+  namespace
+  {
+    /// the first ID after all IDs of @p table in the main database of @p conn
+    Int64 nextID(SqliteConnector& conn, const String& table)
+    {
+      sqlite3_stmt* stmt;
+      conn.prepareStatement(&stmt, "SELECT IFNULL(MAX(ID) + 1, 0) FROM main." + table + ";");
+      Int64 id = 0;
+      if (Sql::nextRow(stmt) == Sql::SqlState::SQL_ROW)
+      {
+        id = Sql::extractInt64(stmt, 0);
+      }
+      sqlite3_finalize(stmt);
+      return id;
+    }
+  }
+
+  void SqMassFile::merge(const StringList& in, const String& out)
+  {
+    for (const String& f : in)
+    {
+      if (!File::exists(f))
+      {
+        throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, f);
+      }
+    }
+    if (in.empty()) return;
+    if (std::find(in.begin(), in.end(), out) != in.end())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "The merged file '" + out + "' must not be one of the inputs.");
+    }
+    if (!File::remove(out) || !File::copy(in[0], out))
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, out);
+    }
+
+    SqliteConnector conn(out);
+    for (Size i = 1; i < in.size(); ++i)
+    {
+      conn.executeStatement("ATTACH DATABASE '" + String(in[i]).substitute("'", "''") + "' AS shard;");
+      // IDs of the appended spectra and chromatograms start after the present ones (NULL IDs stay NULL)
+      const String spec_offset(nextID(conn, "SPECTRUM"));
+      const String chrom_offset(nextID(conn, "CHROMATOGRAM"));
+      const String spec_id = "SPECTRUM_ID + " + spec_offset;
+      const String chrom_id = "CHROMATOGRAM_ID + " + chrom_offset;
+      conn.executeStatement(
+        "BEGIN TRANSACTION; "
+        "INSERT INTO DATA SELECT " + spec_id + ", " + chrom_id + ", COMPRESSION, DATA_TYPE, DATA FROM shard.DATA; "
+        "INSERT INTO PRECURSOR SELECT " + spec_id + ", " + chrom_id + ", CHARGE, PEPTIDE_SEQUENCE, DRIFT_TIME, ACTIVATION_METHOD, "
+          "ACTIVATION_ENERGY, ISOLATION_TARGET, ISOLATION_LOWER, ISOLATION_UPPER FROM shard.PRECURSOR; "
+        "INSERT INTO PRODUCT SELECT " + spec_id + ", " + chrom_id + ", CHARGE, ISOLATION_TARGET, ISOLATION_LOWER, ISOLATION_UPPER FROM shard.PRODUCT; "
+        "INSERT INTO SPECTRUM SELECT ID + " + spec_offset + ", RUN_ID, MSLEVEL, RETENTION_TIME, SCAN_POLARITY, NATIVE_ID FROM shard.SPECTRUM; "
+        "INSERT INTO CHROMATOGRAM SELECT ID + " + chrom_offset + ", RUN_ID, NATIVE_ID FROM shard.CHROMATOGRAM; "
+        "INSERT INTO RUN_EXTRA SELECT * FROM shard.RUN_EXTRA WHERE RUN_ID NOT IN (SELECT ID FROM main.RUN); "
+        "INSERT OR IGNORE INTO RUN SELECT * FROM shard.RUN; "
+        "COMMIT;");
+      conn.executeStatement("DETACH DATABASE shard;");
+    }
+  }
+
   void SqMassFile::transform(const String& filename_in, Interfaces::IMSDataConsumer* consumer, bool /* skip_full_count */, bool /* skip_first_pass */) const
   {
     OpenMS::Internal::MzMLSqliteHandler sql_mass(filename_in, 0);
@@ -44,49 +112,40 @@ namespace OpenMS
     sql_mass.readExperiment(experimental_settings, true);
     consumer->setExperimentalSettings(experimental_settings);
 
+    // read spectra and chromatograms in batches (the data of each batch is decoded in parallel)
+    const int batch_size = 500;
+    std::vector<int> indices;
+    const int nr_spectra = (int)sql_mass.getNrSpectra();
+    for (int idx_start = 0; idx_start < nr_spectra; idx_start += batch_size)
     {
-      int batch_size = 500;
-      std::vector<int> indices;
-      for (size_t batch_idx = 0; batch_idx <= (sql_mass.getNrSpectra() / batch_size); batch_idx++)
+      int idx_end = std::min(idx_start + batch_size, nr_spectra);
+      indices.resize(idx_end - idx_start);
+      for (int k = 0; k < idx_end - idx_start; k++)
       {
-        int idx_start, idx_end;
-        idx_start = batch_idx * batch_size;
-        idx_end = std::max(batch_idx * (batch_size+1), sql_mass.getNrSpectra());
-
-        indices.resize(idx_end - idx_start);
-        for (int k = 0; k < idx_end-idx_start; k++)
-        {
-          indices[k] = idx_start + k;
-        }
-        std::vector<MSSpectrum> tmp_spectra;
-        sql_mass.readSpectra(tmp_spectra, indices, false);
-        for (Size k = 0; k < tmp_spectra.size(); k++)
-        {
-          consumer->consumeSpectrum(tmp_spectra[k]);
-        }
+        indices[k] = idx_start + k;
+      }
+      std::vector<MSSpectrum> tmp_spectra;
+      sql_mass.readSpectra(tmp_spectra, indices, false);
+      for (Size k = 0; k < tmp_spectra.size(); k++)
+      {
+        consumer->consumeSpectrum(tmp_spectra[k]);
       }
     }
 
+    const int nr_chromatograms = (int)sql_mass.getNrChromatograms();
+    for (int idx_start = 0; idx_start < nr_chromatograms; idx_start += batch_size)
     {
-      int batch_size = 500;
-      std::vector<int> indices;
-      for (size_t batch_idx = 0; batch_idx <= (sql_mass.getNrChromatograms() / batch_size); batch_idx++)
+      int idx_end = std::min(idx_start + batch_size, nr_chromatograms);
+      indices.resize(idx_end - idx_start);
+      for (int k = 0; k < idx_end - idx_start; k++)
+      {
+        indices[k] = idx_start + k;
+      }
+      std::vector<MSChromatogram> tmp_chroms;
+      sql_mass.readChromatograms(tmp_chroms, indices, false);
+      for (Size k = 0; k < tmp_chroms.size(); k++)
       {
-        int idx_start, idx_end;
-        idx_start = batch_idx * batch_size;
-        idx_end = std::max(batch_idx * (batch_size+1), sql_mass.getNrChromatograms());
-
-        indices.resize(idx_end - idx_start);
-        for (int k = 0; k < idx_end-idx_start; k++)
-        {
-          indices[k] = idx_start + k;
-        }
-        std::vector<MSChromatogram> tmp_chroms;
-        sql_mass.readChromatograms(tmp_chroms, indices, false);
-        for (Size k = 0; k < tmp_chroms.size(); k++)
-        {
-          consumer->consumeChromatogram(tmp_chroms[k]);
-        }
+        consumer->consumeChromatogram(tmp_chroms[k]);
       }
     }
   }
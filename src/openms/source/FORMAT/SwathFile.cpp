@@ -123,6 +123,27 @@ namespace OpenMS
                                                        boost::shared_ptr<ExperimentalSettings>& exp_meta,
                                                        const String& readoptions,
                                                        Interfaces::IMSDataConsumer* plugin_consumer)
+  {
+    return loadMzML_(file, tmp, exp_meta, readoptions, plugin_consumer, 0, {});
+  }
+
+  std::vector<OpenSwath::SwathMap> SwathFile::loadMzMLStreaming(const String& file,
+                                                                const String& tmp,
+                                                                boost::shared_ptr<ExperimentalSettings>& exp_meta,
+                                                                Size memory_budget,
+                                                                const std::function<void(const OpenSwath::SwathMap&)>& window_ready,
+                                                                Interfaces::IMSDataConsumer* plugin_consumer)
+  {
+    return loadMzML_(file, tmp, exp_meta, "stream", plugin_consumer, memory_budget, window_ready);
+  }
+
+  std::vector<OpenSwath::SwathMap> SwathFile::loadMzML_(const String& file,
+                                                        const String& tmp,
+                                                        boost::shared_ptr<ExperimentalSettings>& exp_meta,
+                                                        const String& readoptions,
+                                                        Interfaces::IMSDataConsumer* plugin_consumer,
+                                                        Size memory_budget,
+                                                        const std::function<void(const OpenSwath::SwathMap&)>& window_ready)
   {
     std::cout << "Loading mzML file " << file << " using readoptions " << readoptions << std::endl;
     String tmp_fname = tmp.hasSuffix('/') ? File::getUniqueName() : ""; // use tmp-filename if just a directory was given
@@ -160,6 +181,11 @@ namespace OpenMS
       dataConsumer = std::make_shared<MzMLSwathFileConsumer>(known_window_boundaries, tmp, tmp_fname, nr_ms1_spectra, swath_counter);
       dataConsumer->setExperimentalSettings(*exp_meta.get());
     }
+    else if (readoptions == "stream")
+    {
+      dataConsumer = std::make_shared<StreamingSwathFileConsumer>(known_window_boundaries, tmp, tmp_fname, swath_counter, memory_budget, window_ready);
+      dataConsumer->setExperimentalSettings(*exp_meta.get());
+    }
     else
     {
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
@@ -8,15 +8,173 @@
 
 #include <OpenMS/FORMAT/ZlibCompression.h>
 
+#include <OpenMS/CONCEPT/PerfCounters.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+
 #include <QtCore/QByteArray>
 
 #include <zlib.h>
 
+#ifdef OPENMS_HAS_LIBDEFLATE
+#include <libdeflate.h>
+#endif
+
+#include <algorithm>
+#include <limits>
+
 using namespace std;
 
 namespace OpenMS
 {
 
+  namespace
+  {
+    /// zlib deflate stream, initialized once per thread and reset for each buffer
+    struct DeflateStream
+    {
+      z_stream strm{};
+      bool initialized = false;
+
+      DeflateStream()
+      {
+        // same parameters as compress() uses, so the output is identical
+        initialized = (deflateInit(&strm, Z_DEFAULT_COMPRESSION) == Z_OK);
+      }
+
+      ~DeflateStream()
+      {
+        if (initialized) deflateEnd(&strm);
+      }
+    };
+
+    z_stream& deflateStream()
+    {
+      thread_local DeflateStream stream;
+      if (!stream.initialized)
+      {
+        throw Exception::OutOfMemory(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, sizeof(z_stream));
+      }
+      deflateReset(&stream.strm);
+      return stream.strm;
+    }
+
+#ifdef OPENMS_HAS_LIBDEFLATE
+    /// libdeflate decompressor, allocated once per thread
+    struct Decompressor
+    {
+      libdeflate_decompressor* d = libdeflate_alloc_decompressor();
+
+      ~Decompressor()
+      {
+        if (d != nullptr) libdeflate_free_decompressor(d);
+      }
+    };
+
+    libdeflate_decompressor* decompressor()
+    {
+      thread_local Decompressor decompressor;
+      if (decompressor.d == nullptr)
+      {
+        throw Exception::OutOfMemory(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 0);
+      }
+      return decompressor.d;
+    }
+#else
+    /// zlib inflate stream, initialized once per thread and reset for each buffer
+    struct InflateStream
+    {
+      z_stream strm{};
+      bool initialized = false;
+
+      InflateStream()
+      {
+        initialized = (inflateInit(&strm) == Z_OK);
+      }
+
+      ~InflateStream()
+      {
+        if (initialized) inflateEnd(&strm);
+      }
+    };
+
+    z_stream& inflateStream()
+    {
+      thread_local InflateStream stream;
+      if (!stream.initialized)
+      {
+        throw Exception::OutOfMemory(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, sizeof(z_stream));
+      }
+      inflateReset(&stream.strm);
+      return stream.strm;
+    }
+#endif
+
+    void checkLength(size_t length)
+    {
+      // zlib counts in (32 bit) uInt
+      if (length > std::numeric_limits<uInt>::max())
+      {
+        throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Data too large for zlib (" + String(length) + " bytes)");
+      }
+    }
+
+    /// Inflates @p nr_bytes of zlib data into @p raw, which needs not to be large enough (it grows as needed)
+    void inflateGrowing(const void* compressed_data, size_t nr_bytes, std::string& raw)
+    {
+      // compressed data arrays typically expand by a factor 2-4; start with a guess and grow
+      raw.resize(std::max<size_t>(nr_bytes * 4, 64));
+      size_t raw_length = 0;
+
+#ifdef OPENMS_HAS_LIBDEFLATE
+      while (true)
+      {
+        libdeflate_result res = libdeflate_zlib_decompress(decompressor(), compressed_data, nr_bytes, &raw[0], raw.size(), &raw_length);
+        if (res == LIBDEFLATE_SUCCESS)
+        {
+          break;
+        }
+        if (res != LIBDEFLATE_INSUFFICIENT_SPACE)
+        {
+          throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
+        }
+        raw.resize(raw.size() * 2);
+      }
+#else
+      checkLength(nr_bytes);
+      z_stream& strm = inflateStream();
+      strm.next_in = reinterpret_cast<Bytef*>(const_cast<void*>(compressed_data));
+      strm.avail_in = (uInt)nr_bytes;
+      while (true)
+      {
+        checkLength(raw.size() - raw_length);
+        strm.next_out = reinterpret_cast<Bytef*>(&raw[raw_length]);
+        strm.avail_out = (uInt)(raw.size() - raw_length);
+        int zlib_error = inflate(&strm, Z_FINISH);
+        raw_length = raw.size() - strm.avail_out;
+        if (zlib_error == Z_STREAM_END)
+        {
+          break;
+        }
+        if (zlib_error == Z_MEM_ERROR)
+        {
+          throw Exception::OutOfMemory(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, raw.size());
+        }
+        // anything but "output buffer full" means corrupt or truncated data
+        if ((zlib_error != Z_OK && zlib_error != Z_BUF_ERROR) || strm.avail_out != 0)
+        {
+          throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
+        }
+        raw.resize(raw.size() * 2);
+      }
+#endif
+      if (raw_length == 0)
+      {
+        throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
+      }
+      raw.resize(raw_length);
+    }
+  }
+
   void ZlibCompression::compressString(std::string& str, std::string& compressed)
   {
     compressData(reinterpret_cast<Bytef*>(&str[0]), str.size(), compressed);
@@ -25,32 +183,28 @@ namespace OpenMS
   void ZlibCompression::compressData(const void* raw_data, const size_t in_length, std::string& compressed)
   {
     compressed.clear();
+    checkLength(in_length);
 
-    const unsigned long sourceLen = (unsigned long)in_length;
-    unsigned long compressed_length =                         // compressBound((unsigned long)str.size());
-      sourceLen + (sourceLen >> 12) + (sourceLen >> 14) + 11; // taken from zlib's compress.c, as we cannot use compressBound*
+    z_stream& strm = deflateStream();
+    const uLong bound = deflateBound(&strm, (uLong)in_length);
+    checkLength(bound);
+    compressed.resize(bound); // reserve enough space -- we may not need all of it
 
-    int zlib_error;
-    do
-    {
-      compressed.resize(compressed_length); // reserve enough space -- we may not need all of it
-      zlib_error = compress(reinterpret_cast<Bytef*>(&compressed[0]), &compressed_length, (Bytef*)raw_data, sourceLen);
-
-      switch (zlib_error)
-      {
-        case Z_MEM_ERROR:
-          throw Exception::OutOfMemory(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, compressed_length);
-
-        case Z_BUF_ERROR:
-          compressed_length *= 2;
-      }
-    } while (zlib_error == Z_BUF_ERROR);
+    strm.next_in = reinterpret_cast<Bytef*>(const_cast<void*>(raw_data));
+    strm.avail_in = (uInt)in_length;
+    strm.next_out = reinterpret_cast<Bytef*>(&compressed[0]);
+    strm.avail_out = (uInt)bound;
+    int zlib_error = deflate(&strm, Z_FINISH);
 
-    if (zlib_error != Z_OK)
+    if (zlib_error == Z_MEM_ERROR)
+    {
+      throw Exception::OutOfMemory(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, bound);
+    }
+    if (zlib_error != Z_STREAM_END)
     {
       throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Compression error?");
     }
-    compressed.resize(compressed_length); // cut down to the actual data
+    compressed.resize(bound - strm.avail_out); // cut down to the actual data
   }
 
   void ZlibCompression::compressString(const QByteArray& raw_data, QByteArray& compressed_data)
@@ -61,33 +215,47 @@ namespace OpenMS
 
   void ZlibCompression::uncompressString(const void * tt, size_t blob_bytes, std::string& uncompressed)
   {
-    // take a leap of faith and assume the input is valid
-    QByteArray compressed_data = QByteArray::fromRawData((const char*)tt, (int)blob_bytes);
-    QByteArray raw_data;
-
-    ZlibCompression::uncompressString(compressed_data, raw_data);
-
     // Note that we may have zero bytes in the string, so we cannot use QString
-    uncompressed.clear();
-    uncompressed = std::string(raw_data.data(), raw_data.size());
+    inflateGrowing(tt, blob_bytes, uncompressed);
+    PerfCounters::add(PerfCounters::BYTES_DECOMPRESSED, uncompressed.size());
   }
 
   void ZlibCompression::uncompressString(const QByteArray& compressed_data, QByteArray& raw_data)
   {
-    QByteArray czip;
-    czip.resize(4);
-    czip[0] = (compressed_data.size() & 0xff000000) >> 24;
-    czip[1] = (compressed_data.size() & 0x00ff0000) >> 16;
-    czip[2] = (compressed_data.size() & 0x0000ff00) >> 8;
-    czip[3] = (compressed_data.size() & 0x000000ff);
-    czip += compressed_data;
-    raw_data = qUncompress(czip);
-
-    if (raw_data.isEmpty())
+    std::string uncompressed;
+    inflateGrowing(compressed_data.constData(), (size_t)compressed_data.size(), uncompressed);
+    PerfCounters::add(PerfCounters::BYTES_DECOMPRESSED, uncompressed.size());
+    raw_data = QByteArray(uncompressed.data(), (int)uncompressed.size());
+  }
+
+  void ZlibCompression::uncompressData(const void* compressed_data, size_t nr_bytes, void* raw_data, size_t raw_length)
+  {
+#ifdef OPENMS_HAS_LIBDEFLATE
+    // passing no actual_out_nbytes_ret requires the output to fill raw_length exactly
+    libdeflate_result res = libdeflate_zlib_decompress(decompressor(), compressed_data, nr_bytes, raw_data, raw_length, nullptr);
+    if (res != LIBDEFLATE_SUCCESS)
     {
       throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
     }
+#else
+    checkLength(nr_bytes);
+    checkLength(raw_length);
+    z_stream& strm = inflateStream();
+    strm.next_in = reinterpret_cast<Bytef*>(const_cast<void*>(compressed_data));
+    strm.avail_in = (uInt)nr_bytes;
+    strm.next_out = reinterpret_cast<Bytef*>(raw_data);
+    strm.avail_out = (uInt)raw_length;
+    int zlib_error = inflate(&strm, Z_FINISH);
+    if (zlib_error == Z_MEM_ERROR)
+    {
+      throw Exception::OutOfMemory(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, raw_length);
+    }
+    if (zlib_error != Z_STREAM_END || strm.avail_out != 0)
+    {
+      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Decompression error?");
+    }
+#endif
+    PerfCounters::add(PerfCounters::BYTES_DECOMPRESSED, raw_length);
   }
 
 }
-
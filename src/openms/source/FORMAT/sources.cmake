@@ -31,8 +31,10 @@ GNPSQuantificationFile.cpp
 GzipIfstream.cpp
 GzipInputStream.cpp
 IBSpectraFile.cpp
+IdBinFile.cpp
 IdXMLFile.cpp
 IndentedStream.cpp
+InMemoryFileStore.cpp
 IndexedMzMLFileLoader.cpp
 InspectInfile.cpp
 InspectOutfile.cpp
@@ -65,6 +67,7 @@ OMSFileStore.cpp
 OMSSACSVFile.cpp
 OMSSAXMLFile.cpp
 OSWFile.cpp
+OffsetIndexFile.cpp
 ParamCTDFile.cpp
 ParamCWLFile.cpp
 ParamJSONFile.cpp
@@ -79,9 +82,11 @@ PercolatorInfile.cpp
 PercolatorOutfile.cpp
 ProtXMLFile.cpp
 QcMLFile.cpp
+ReadAheadBuffer.cpp
 SequestInfile.cpp
 SequestOutfile.cpp
 SpecArrayFile.cpp
+SpillableSpectrumList.cpp
 SqliteConnector.cpp
 SqMassFile.cpp
 SwathFile.cpp
@@ -16,11 +16,28 @@
 #include <OpenMS/KERNEL/MSExperiment.h>
 
 
+#include <algorithm>
 #include <map>
 #include <OpenMS/PROCESSING/SPECTRAMERGING/SpectraMerger.h>
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// Copy of the meta data (RT, MS level, name, ...) of @p spec without the peaks and data arrays
+    MSSpectrum copyMetaData(const MSSpectrum& spec)
+    {
+      MSSpectrum copy;
+      copy.SpectrumSettings::operator=(spec);
+      copy.setRT(spec.getRT());
+      copy.setDriftTime(spec.getDriftTime());
+      copy.setDriftTimeUnit(spec.getDriftTimeUnit());
+      copy.setMSLevel(spec.getMSLevel());
+      copy.setName(spec.getName());
+      return copy;
+    }
+  }
+
   std::vector<PeakMap> IMDataConverter::splitByFAIMSCV(PeakMap&& exp)
   {
     std::vector<PeakMap> split_peakmap;
@@ -76,44 +93,95 @@ namespace OpenMS
     }
 
     // can throw if IM float data array is missing
-    const auto [im_data_index, im_unit] = im_frame.getIMData();
+    const DriftTimeUnit im_unit = im_frame.getIMData().second;
+
+    // Separate spec for each IM value (in order of IM, all with the RT of the frame)
+    const std::vector<IMFrameView> views = getIMFrameViews(im_frame);
+    out.getSpectra().reserve(views.size());
+    for (const IMFrameView& view : views)
+    {
+      out.getSpectra().push_back(extractIMFrameView(im_frame, view, im_unit));
+    }
+    out.updateRanges();
+    return out;
+  }
+
+  std::vector<IMDataConverter::IMFrameView> IMDataConverter::getIMFrameViews(const MSSpectrum& im_frame)
+  {
+    std::vector<IMFrameView> views;
+    if (im_frame.empty())
+    {
+      return views;
+    }
+
+    // can throw if IM float data array is missing
     // Capture IM array by Ref, because .getIMData() is expensive to call for every peak!
-    const auto& im_data = im_frame.getFloatDataArrays()[im_data_index];
-
-    // copy meta data (RT, name, ...) without the raw data and without the IM array
-    MSSpectrum prototype = im_frame;
-    prototype.clear(false);
-
-    // adds a new spectrum with drift time to `out`
-    auto addSpectrum = [&out, im_unit = im_unit, &prototype](double drift_time_avg) {
-      // keeps RT identical for all scans, since they are from the same IM-frame
-      // keeps MSlevel
-      out.addSpectrum(prototype);
-      auto& spec = out.getSpectra().back();
-      // copy drift-time unit from parent scan
-      spec.setDriftTime(drift_time_avg);
-      spec.setDriftTimeUnit(im_unit);
-      return &spec;
-    };
-
-    MSSpectrum* last_spec{};
-    // Separate spec for each IM value:
-    OPENMS_PRECONDITION(std::is_sorted(im_data.begin(), im_data.end()), "we sorted it... what happened???");
-    using IMV_t = MSSpectrum::FloatDataArray::value_type;
-    IMV_t im_last = std::numeric_limits<IMV_t>::max();
-    for (Size i = 0; i < im_data.size(); ++i)// is sorted now!
+    const auto& im_data = im_frame.getFloatDataArrays()[im_frame.getIMData().first];
+    if (! std::is_sorted(im_data.begin(), im_data.end()))
+    {
+      throw Exception::Precondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "IM frame must be sorted by ion mobility.");
+    }
+
+    for (Size begin = 0; begin < im_data.size();)
     {
-      const IMV_t im = im_data[i];
-      if (im != im_last)
+      Size end = begin + 1;
+      while (end < im_data.size() && im_data[end] == im_data[begin])
       {
-        im_last = im;
-        last_spec = addSpectrum(im);
+        ++end;
       }
-      last_spec->push_back(im_frame[i]);// copy the m/z of the peak
+      views.push_back({begin, end, im_data[begin]});
+      begin = end;
     }
-    out.sortSpectra(true);
-    out.updateRanges();
-    return out;
+    return views;
+  }
+
+  MSSpectrum IMDataConverter::extractIMFrameView(const MSSpectrum& im_frame, const IMFrameView& view, DriftTimeUnit im_unit)
+  {
+    // keeps RT and MS level of the frame
+    MSSpectrum spec = copyMetaData(im_frame);
+    spec.setDriftTime(view.drift_time);
+    spec.setDriftTimeUnit(im_unit);
+    spec.insert(spec.end(), im_frame.begin() + view.begin, im_frame.begin() + view.end);
+    spec.sortByPosition();
+    return spec;
+  }
+
+  std::vector<MSSpectrum> IMDataConverter::binIMFrame(MSSpectrum& im_frame, const Math::BinContainer& bins, const SpectraMerger& merger)
+  {
+    std::vector<MSSpectrum> binned(bins.size());
+    if (im_frame.empty())
+    {
+      return binned;
+    }
+    if (! im_frame.isSortedByIM())
+    {
+      im_frame.sortByIonMobility();
+    }
+    const DriftTimeUnit im_unit = im_frame.getIMData().second;
+    const std::vector<IMFrameView> views = getIMFrameViews(im_frame);
+
+    std::vector<MSSpectrum> block; // spectra of the current bin
+    for (Size i = 0; i < bins.size(); ++i)
+    {
+      // views are sorted by IM, so the ones of a bin are consecutive
+      auto view = std::lower_bound(views.begin(), views.end(), bins[i].getMin(),
+                                   [](const IMFrameView& v, double im) { return v.drift_time < im; });
+      block.clear();
+      for (; view != views.end() && bins[i].contains(view->drift_time); ++view)
+      {
+        block.push_back(extractIMFrameView(im_frame, *view, im_unit));
+      }
+      if (block.empty())
+      {
+        continue;
+      }
+      binned[i] = merger.mergeBlock(block, im_frame.getMSLevel());
+      if (! binned[i].empty())
+      {
+        binned[i].setDriftTime(bins[i].center());
+      }
+    }
+    return binned;
   }
 
   std::tuple<std::vector<MSExperiment>, Math::BinContainer> IMDataConverter::splitExperimentByIonMobility(MSExperiment&& in,
@@ -142,19 +210,12 @@ namespace OpenMS
     // compute the bins
     const auto bins = Math::createBins(range_IM.getMin(), range_IM.getMax(), number_of_bins, bin_extension_abs);
 
-    // results for each IM-frame: all spectra per bin, to get merged
-    MSExperiment binned_spectra;
-
-
+    // merges all spectra of a bin (from the same IM-frame)
     SpectraMerger merger;
     auto p = merger.getParameters();
-    const auto ms_levels = in.getMSLevels();
-    p.setValue("block_method:ms_levels", IntList(ms_levels.begin(), ms_levels.end())); // merge all MS levels
     p.setValue("mz_binning_width", mz_binning_width);
     p.setValue("mz_binning_width_unit", String(MZ_UNIT_NAMES[(int)mz_binning_width_unit]));
-    p.setValue("block_method:rt_block_size", INT_MAX);
-    p.setValue("block_method:rt_max_length", 10e10);
-
+    merger.setParameters(p);
 
     for (auto& frame : in)
     {
@@ -164,27 +225,14 @@ namespace OpenMS
       {
         throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Spectrum does not contain 'wide' IM data.", frame.getNativeID());
       }
-      
-      MSExperiment frame_melt = IMDataConverter::reshapeIMFrameToMany(std::move(frame));
-      for (int i = 0; i < bins.size(); ++i)
+
+      std::vector<MSSpectrum> binned = binIMFrame(frame, bins, merger);
+      frame.clear(true); // the frame is not needed anymore
+      for (Size i = 0; i < bins.size(); ++i)
       {
-        binned_spectra.clear(false);
-        // check if spectrum goes into this bin
-        for (auto&& spec : frame_melt)
-        {
-          if (bins[i].contains(spec.getDriftTime()))
-          { // spectrum goes into this bin
-            binned_spectra.addSpectrum(std::move(spec));
-          }
-        }
-        // collapse spectra in this bin
-        if (!binned_spectra.empty())
+        if (! binned[i].empty())
         {
-          merger.setParameters(p);
-          merger.mergeSpectraBlockWise(binned_spectra);
-          assert(binned_spectra.size() == 1);
-          results[i].addSpectrum(std::move(binned_spectra.getSpectra().back()));
-          results[i].getSpectra().back().setDriftTime(bins[i].center());
+          results[i].addSpectrum(std::move(binned[i]));
         }
       }
     }
@@ -221,12 +269,18 @@ namespace OpenMS
     if (stack.empty()) return;
 
     // copy meta data without the raw data and without the IM array
-    MSSpectrum new_spec = *stack[0];
-    new_spec.clear(false);
+    MSSpectrum new_spec = copyMetaData(*stack[0]);
+    Size frame_size(0);
+    for (const auto& s : stack)
+    {
+      frame_size += s->size();
+    }
+    new_spec.reserve(frame_size);
 
     // create new FDA
     OpenMS::DataArrays::FloatDataArray& fda = new_spec.getFloatDataArrays().emplace_back();
     IMDataConverter::setIMUnit(fda, new_spec.getDriftTimeUnit());
+    fda.reserve(frame_size);
     for (const auto& s : stack)
     {
       new_spec.insert(new_spec.end(), s->begin(), s->end()); // append data
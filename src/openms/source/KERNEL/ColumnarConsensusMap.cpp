@@ -0,0 +1,105 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/KERNEL/ColumnarConsensusMap.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/KERNEL/ConsensusMap.h>
+
+using namespace std;
+
+namespace OpenMS
+{
+
+  ColumnarConsensusMap::ColumnarConsensusMap(const ConsensusMap& map)
+  {
+    Size n_entries = 0;
+    for (const ConsensusFeature& cf : map)
+    {
+      n_entries += cf.size();
+    }
+    feature_offsets_.reserve(map.size() + 1);
+    map_indices_.reserve(n_entries);
+    rt_.reserve(n_entries);
+    mz_.reserve(n_entries);
+    intensities_.reserve(n_entries);
+
+    Size n_maps = map.getColumnHeaders().empty() ? 0 : map.getColumnHeaders().rbegin()->first + 1;
+    for (const ConsensusFeature& cf : map)
+    {
+      for (const FeatureHandle& fh : cf)
+      {
+        map_indices_.push_back(fh.getMapIndex());
+        rt_.push_back(fh.getRT());
+        mz_.push_back(fh.getMZ());
+        intensities_.push_back(fh.getIntensity());
+        if (fh.getMapIndex() >= n_maps)
+        {
+          n_maps = fh.getMapIndex() + 1;
+        }
+      }
+      feature_offsets_.push_back(map_indices_.size());
+    }
+
+    // index the entries by map (counting sort keeps the feature order)
+    map_offsets_.assign(n_maps + 1, 0);
+    for (UInt64 m : map_indices_)
+    {
+      ++map_offsets_[m + 1];
+    }
+    for (Size m = 0; m < n_maps; ++m)
+    {
+      map_offsets_[m + 1] += map_offsets_[m];
+    }
+    map_entries_.resize(n_entries);
+    vector<Size> next(map_offsets_.begin(), map_offsets_.end() - 1);
+    for (Size e = 0; e < n_entries; ++e)
+    {
+      map_entries_[next[map_indices_[e]]++] = e;
+    }
+  }
+
+  vector<float> ColumnarConsensusMap::getMapIntensities(UInt64 map_index) const
+  {
+    vector<float> result;
+    if (map_index >= mapCount())
+    {
+      return result;
+    }
+    result.reserve(map_offsets_[map_index + 1] - map_offsets_[map_index]);
+    for (Size i = map_offsets_[map_index]; i < map_offsets_[map_index + 1]; ++i)
+    {
+      result.push_back(intensities_[map_entries_[i]]);
+    }
+    return result;
+  }
+
+  void ColumnarConsensusMap::applyIntensities(ConsensusMap& map) const
+  {
+    if (map.size() != featureCount())
+    {
+      throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, map.size());
+    }
+    for (Size i = 0; i < map.size(); ++i)
+    {
+      if (map[i].size() != feature_offsets_[i + 1] - feature_offsets_[i])
+      {
+        throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, map[i].size());
+      }
+    }
+    for (Size i = 0; i < map.size(); ++i)
+    {
+      Size e = feature_offsets_[i];
+      for (const FeatureHandle& fh : map[i])
+      {
+        fh.asMutable().setIntensity(intensities_[e++]);
+      }
+    }
+  }
+
+} // namespace OpenMS
@@ -0,0 +1,292 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/KERNEL/ColumnarExperiment.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/CONCEPT/Macros.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+namespace OpenMS
+{
+
+  ColumnarExperiment::ColumnarExperiment(const MSExperiment& exp)
+  {
+    assign(exp);
+  }
+
+  bool ColumnarExperiment::operator==(const ColumnarExperiment& rhs) const
+  {
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wfloat-equal"
+    return mz_ == rhs.mz_ &&
+           intensity_ == rhs.intensity_ &&
+           spectrum_offsets_ == rhs.spectrum_offsets_ &&
+           rt_ == rhs.rt_ &&
+           ms_level_ == rhs.ms_level_ &&
+           chrom_rt_ == rhs.chrom_rt_ &&
+           chrom_intensity_ == rhs.chrom_intensity_ &&
+           chrom_offsets_ == rhs.chrom_offsets_;
+#pragma clang diagnostic pop
+  }
+
+  bool ColumnarExperiment::operator!=(const ColumnarExperiment& rhs) const
+  {
+    return !(operator==(rhs));
+  }
+
+  void ColumnarExperiment::assign(const MSExperiment& exp)
+  {
+    // offsets first (prefix sum), so each spectrum can be copied independently
+    const Size nr_spectra = exp.getNrSpectra();
+    spectrum_offsets_.resize(nr_spectra + 1);
+    rt_.resize(nr_spectra);
+    ms_level_.resize(nr_spectra);
+    spectrum_offsets_[0] = 0;
+    for (Size s = 0; s < nr_spectra; ++s)
+    {
+      spectrum_offsets_[s + 1] = spectrum_offsets_[s] + exp[s].size();
+      rt_[s] = exp[s].getRT();
+      ms_level_[s] = exp[s].getMSLevel();
+    }
+    mz_.resize(spectrum_offsets_.back());
+    intensity_.resize(spectrum_offsets_.back());
+
+#pragma omp parallel for schedule(dynamic, 16)
+    for (SignedSize s = 0; s < (SignedSize)nr_spectra; ++s)
+    {
+      const MSSpectrum& spectrum = exp[s];
+      Size offset = spectrum_offsets_[s];
+      for (const Peak1D& p : spectrum)
+      {
+        mz_[offset] = p.getMZ();
+        intensity_[offset] = p.getIntensity();
+        ++offset;
+      }
+    }
+
+    const Size nr_chroms = exp.getNrChromatograms();
+    const std::vector<MSChromatogram>& chroms = exp.getChromatograms();
+    chrom_offsets_.resize(nr_chroms + 1);
+    chrom_offsets_[0] = 0;
+    for (Size c = 0; c < nr_chroms; ++c)
+    {
+      chrom_offsets_[c + 1] = chrom_offsets_[c] + chroms[c].size();
+    }
+    chrom_rt_.resize(chrom_offsets_.back());
+    chrom_intensity_.resize(chrom_offsets_.back());
+
+#pragma omp parallel for schedule(dynamic, 16)
+    for (SignedSize c = 0; c < (SignedSize)nr_chroms; ++c)
+    {
+      Size offset = chrom_offsets_[c];
+      for (const ChromatogramPeak& p : chroms[c])
+      {
+        chrom_rt_[offset] = p.getRT();
+        chrom_intensity_[offset] = p.getIntensity();
+        ++offset;
+      }
+    }
+  }
+
+  void ColumnarExperiment::toMSExperiment(MSExperiment& exp) const
+  {
+    const Size nr_spectra = getNrSpectra();
+    exp.getSpectra().resize(nr_spectra);
+
+#pragma omp parallel for schedule(dynamic, 16)
+    for (SignedSize s = 0; s < (SignedSize)nr_spectra; ++s)
+    {
+      MSSpectrum& spectrum = exp[s];
+      spectrum.clear(false);
+      const Size begin = spectrum_offsets_[s];
+      const Size end = spectrum_offsets_[s + 1];
+      spectrum.reserve(end - begin);
+      for (Size i = begin; i < end; ++i)
+      {
+        spectrum.emplace_back(mz_[i], intensity_[i]);
+      }
+      spectrum.setRT(rt_[s]);
+      spectrum.setMSLevel(ms_level_[s]);
+    }
+
+    const Size nr_chroms = getNrChromatograms();
+    std::vector<MSChromatogram>& chroms = exp.getChromatograms();
+    chroms.resize(nr_chroms);
+
+#pragma omp parallel for schedule(dynamic, 16)
+    for (SignedSize c = 0; c < (SignedSize)nr_chroms; ++c)
+    {
+      MSChromatogram& chrom = chroms[c];
+      chrom.clear(false);
+      chrom.getFloatDataArrays().clear();
+      chrom.getStringDataArrays().clear();
+      chrom.getIntegerDataArrays().clear();
+      const Size begin = chrom_offsets_[c];
+      const Size end = chrom_offsets_[c + 1];
+      chrom.reserve(end - begin);
+      for (Size i = begin; i < end; ++i)
+      {
+        chrom.push_back(ChromatogramPeak(chrom_rt_[i], chrom_intensity_[i]));
+      }
+    }
+    exp.updateRanges();
+  }
+
+  void ColumnarExperiment::checkOffsets_(const std::vector<UInt64>& offsets, Size nr_peaks)
+  {
+    if (offsets.empty() || offsets.front() != 0)
+    {
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Offsets need to start at 0.", offsets.empty() ? String("") : String(offsets.front()));
+    }
+    for (Size i = 1; i < offsets.size(); ++i)
+    {
+      if (offsets[i] < offsets[i - 1])
+      {
+        throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Offsets need to be non-decreasing.", String(offsets[i]));
+      }
+    }
+    if (offsets.back() != nr_peaks)
+    {
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "The last offset needs to be the number of peaks.", String(offsets.back()));
+    }
+  }
+
+  void ColumnarExperiment::setSpectra(std::vector<double> mz, std::vector<float> intensity, std::vector<UInt64> offsets,
+                                      std::vector<double> rt, std::vector<UInt> ms_level)
+  {
+    if (intensity.size() != mz.size())
+    {
+      throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, intensity.size());
+    }
+    if (rt.size() + 1 != offsets.size())
+    {
+      throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, rt.size());
+    }
+    if (ms_level.size() != rt.size())
+    {
+      throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, ms_level.size());
+    }
+    checkOffsets_(offsets, mz.size());
+
+    mz_ = std::move(mz);
+    intensity_ = std::move(intensity);
+    spectrum_offsets_ = std::move(offsets);
+    rt_ = std::move(rt);
+    ms_level_ = std::move(ms_level);
+  }
+
+  void ColumnarExperiment::setChromatograms(std::vector<double> rt, std::vector<float> intensity, std::vector<UInt64> offsets)
+  {
+    if (intensity.size() != rt.size())
+    {
+      throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, intensity.size());
+    }
+    checkOffsets_(offsets, rt.size());
+
+    chrom_rt_ = std::move(rt);
+    chrom_intensity_ = std::move(intensity);
+    chrom_offsets_ = std::move(offsets);
+  }
+
+  void ColumnarExperiment::clear()
+  {
+    *this = ColumnarExperiment();
+  }
+
+  Size ColumnarExperiment::getNrSpectra() const
+  {
+    return spectrum_offsets_.size() - 1;
+  }
+
+  Size ColumnarExperiment::getNrSpectraPeaks() const
+  {
+    return mz_.size();
+  }
+
+  const std::vector<double>& ColumnarExperiment::getMZArray() const
+  {
+    return mz_;
+  }
+
+  std::vector<double>& ColumnarExperiment::getMZArray()
+  {
+    return mz_;
+  }
+
+  const std::vector<float>& ColumnarExperiment::getIntensityArray() const
+  {
+    return intensity_;
+  }
+
+  std::vector<float>& ColumnarExperiment::getIntensityArray()
+  {
+    return intensity_;
+  }
+
+  const std::vector<UInt64>& ColumnarExperiment::getSpectrumOffsets() const
+  {
+    return spectrum_offsets_;
+  }
+
+  const std::vector<double>& ColumnarExperiment::getRTArray() const
+  {
+    return rt_;
+  }
+
+  std::vector<double>& ColumnarExperiment::getRTArray()
+  {
+    return rt_;
+  }
+
+  const std::vector<UInt>& ColumnarExperiment::getMSLevelArray() const
+  {
+    return ms_level_;
+  }
+
+  std::vector<UInt>& ColumnarExperiment::getMSLevelArray()
+  {
+    return ms_level_;
+  }
+
+  Size ColumnarExperiment::getNrChromatograms() const
+  {
+    return chrom_offsets_.size() - 1;
+  }
+
+  Size ColumnarExperiment::getNrChromatogramPeaks() const
+  {
+    return chrom_rt_.size();
+  }
+
+  const std::vector<double>& ColumnarExperiment::getChromatogramRTArray() const
+  {
+    return chrom_rt_;
+  }
+
+  std::vector<double>& ColumnarExperiment::getChromatogramRTArray()
+  {
+    return chrom_rt_;
+  }
+
+  const std::vector<float>& ColumnarExperiment::getChromatogramIntensityArray() const
+  {
+    return chrom_intensity_;
+  }
+
+  std::vector<float>& ColumnarExperiment::getChromatogramIntensityArray()
+  {
+    return chrom_intensity_;
+  }
+
+  const std::vector<UInt64>& ColumnarExperiment::getChromatogramOffsets() const
+  {
+    return chrom_offsets_;
+  }
+
+} // namespace OpenMS
@@ -0,0 +1,258 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/KERNEL/ColumnarSpectrum.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/CONCEPT/Macros.h>
+#include <OpenMS/IONMOBILITY/IMDataConverter.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace OpenMS
+{
+
+  ColumnarSpectrum::ColumnarSpectrum(const MSSpectrum& spectrum)
+  {
+    assign(spectrum);
+  }
+
+  bool ColumnarSpectrum::operator==(const ColumnarSpectrum& rhs) const
+  {
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wfloat-equal"
+    return mz_ == rhs.mz_ &&
+           intensity_ == rhs.intensity_ &&
+           ion_mobility_ == rhs.ion_mobility_ &&
+           rt_ == rhs.rt_ &&
+           ms_level_ == rhs.ms_level_ &&
+           drift_time_ == rhs.drift_time_ &&
+           drift_time_unit_ == rhs.drift_time_unit_ &&
+           ion_mobility_name_ == rhs.ion_mobility_name_;
+#pragma clang diagnostic pop
+  }
+
+  bool ColumnarSpectrum::operator!=(const ColumnarSpectrum& rhs) const
+  {
+    return !(operator==(rhs));
+  }
+
+  void ColumnarSpectrum::assign(const MSSpectrum& spectrum)
+  {
+    const Size n = spectrum.size();
+    mz_.resize(n);
+    intensity_.resize(n);
+    for (Size i = 0; i < n; ++i)
+    {
+      mz_[i] = spectrum[i].getMZ();
+      intensity_[i] = spectrum[i].getIntensity();
+    }
+
+    ion_mobility_.clear();
+    ion_mobility_name_.clear();
+    if (spectrum.containsIMData())
+    {
+      const auto& fda = spectrum.getFloatDataArrays()[spectrum.getIMData().first];
+      if (fda.size() != n)
+      {
+        throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, fda.size());
+      }
+      ion_mobility_.assign(fda.begin(), fda.end());
+      ion_mobility_name_ = fda.getName();
+    }
+
+    rt_ = spectrum.getRT();
+    ms_level_ = spectrum.getMSLevel();
+    drift_time_ = spectrum.getDriftTime();
+    drift_time_unit_ = spectrum.getDriftTimeUnit();
+  }
+
+  void ColumnarSpectrum::toMSSpectrum(MSSpectrum& spectrum) const
+  {
+    spectrum.clear(false);
+    spectrum.resize(mz_.size());
+    for (Size i = 0; i < mz_.size(); ++i)
+    {
+      spectrum[i].setMZ(mz_[i]);
+      spectrum[i].setIntensity(intensity_[i]);
+    }
+
+    if (hasIonMobility())
+    {
+      MSSpectrum::FloatDataArray fda;
+      if (ion_mobility_name_.empty())
+      {
+        IMDataConverter::setIMUnit(fda, drift_time_unit_); // may throw
+      }
+      else
+      {
+        fda.setName(ion_mobility_name_);
+      }
+      fda.assign(ion_mobility_.begin(), ion_mobility_.end());
+      spectrum.getFloatDataArrays().push_back(std::move(fda));
+    }
+
+    spectrum.setRT(rt_);
+    spectrum.setMSLevel(ms_level_);
+    spectrum.setDriftTime(drift_time_);
+    spectrum.setDriftTimeUnit(drift_time_unit_);
+  }
+
+  MSSpectrum ColumnarSpectrum::toMSSpectrum() const
+  {
+    MSSpectrum spectrum;
+    toMSSpectrum(spectrum);
+    return spectrum;
+  }
+
+  void ColumnarSpectrum::reserve(Size n)
+  {
+    mz_.reserve(n);
+    intensity_.reserve(n);
+    if (!ion_mobility_.empty())
+    {
+      ion_mobility_.reserve(n);
+    }
+  }
+
+  void ColumnarSpectrum::clear()
+  {
+    mz_.clear();
+    intensity_.clear();
+    ion_mobility_.clear();
+  }
+
+  void ColumnarSpectrum::push_back(double mz, float intensity)
+  {
+    OPENMS_PRECONDITION(ion_mobility_.empty(), "Spectrum has an ion mobility column, use push_back(mz, intensity, ion_mobility)")
+    mz_.push_back(mz);
+    intensity_.push_back(intensity);
+  }
+
+  void ColumnarSpectrum::push_back(double mz, float intensity, float ion_mobility)
+  {
+    OPENMS_PRECONDITION(ion_mobility_.size() == mz_.size(), "Ion mobility column is not aligned with the m/z column")
+    mz_.push_back(mz);
+    intensity_.push_back(intensity);
+    ion_mobility_.push_back(ion_mobility);
+  }
+
+  void ColumnarSpectrum::erase(Size first, Size last)
+  {
+    OPENMS_PRECONDITION(first <= last && last <= mz_.size(), "Invalid index range")
+    mz_.erase(mz_.begin() + first, mz_.begin() + last);
+    intensity_.erase(intensity_.begin() + first, intensity_.begin() + last);
+    if (!ion_mobility_.empty())
+    {
+      ion_mobility_.erase(ion_mobility_.begin() + first, ion_mobility_.begin() + last);
+    }
+  }
+
+  bool ColumnarSpectrum::isSorted() const
+  {
+    return std::is_sorted(mz_.begin(), mz_.end());
+  }
+
+  void ColumnarSpectrum::sortByPosition()
+  {
+    if (isSorted())
+    {
+      return;
+    }
+
+    std::vector<Size> order(mz_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](Size a, Size b) { return mz_[a] < mz_[b]; });
+
+    std::vector<double> mz(mz_.size());
+    std::vector<float> intensity(intensity_.size());
+    for (Size i = 0; i < order.size(); ++i)
+    {
+      mz[i] = mz_[order[i]];
+      intensity[i] = intensity_[order[i]];
+    }
+    mz_.swap(mz);
+    intensity_.swap(intensity);
+
+    if (!ion_mobility_.empty())
+    {
+      std::vector<float> ion_mobility(ion_mobility_.size());
+      for (Size i = 0; i < order.size(); ++i)
+      {
+        ion_mobility[i] = ion_mobility_[order[i]];
+      }
+      ion_mobility_.swap(ion_mobility);
+    }
+  }
+
+  Size ColumnarSpectrum::MZBegin(double mz) const
+  {
+    return std::lower_bound(mz_.begin(), mz_.end(), mz) - mz_.begin();
+  }
+
+  Size ColumnarSpectrum::MZEnd(double mz) const
+  {
+    return std::upper_bound(mz_.begin(), mz_.end(), mz) - mz_.begin();
+  }
+
+  Size ColumnarSpectrum::findNearest(double mz) const
+  {
+    // no peak => no search
+    if (mz_.empty())
+    {
+      throw Exception::Precondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "There must be at least one peak to determine the nearest peak!");
+    }
+    // search for position for inserting
+    const Size i = MZBegin(mz);
+    // border cases
+    if (i == 0)
+    {
+      return 0;
+    }
+    if (i == mz_.size())
+    {
+      return mz_.size() - 1;
+    }
+    // the peak before or the current peak are closest
+    if (std::fabs(mz_[i] - mz) < std::fabs(mz_[i - 1] - mz))
+    {
+      return i;
+    }
+    return i - 1;
+  }
+
+  Int ColumnarSpectrum::findNearest(double mz, double tolerance) const
+  {
+    if (mz_.empty())
+    {
+      return -1;
+    }
+    const Size i = findNearest(mz);
+    if (std::fabs(mz_[i] - mz) <= tolerance)
+    {
+      return static_cast<Int>(i);
+    }
+    return -1;
+  }
+
+  double ColumnarSpectrum::sumIntensity(double mz_start, double mz_end) const
+  {
+    const Size first = MZBegin(mz_start);
+    const Size last = MZEnd(mz_end);
+    if (first >= last)
+    {
+      return 0.0;
+    }
+    // a single pass over the contiguous intensity column
+    return std::accumulate(intensity_.begin() + first, intensity_.begin() + last, 0.0);
+  }
+
+} // namespace OpenMS
@@ -254,24 +254,30 @@ namespace OpenMS
   void FeatureMap::updateRanges()
   {
     clearRanges();
-    for (const auto& f : *this)
+    // per-thread ranges, combined at the end (minima and maxima do not depend on the order)
+#pragma omp parallel
     {
-      extendRT(f.getRT());
-      extendMZ(f.getMZ());
-      extendIntensity(f.getIntensity());
-    }
-
-    // enlarge the range by the convex hull points
-    for (Size i = 0; i < this->size(); ++i)
-    {
-      const DBoundingBox<2>& box = this->operator[](i).getConvexHull().getBoundingBox();
-      if (!box.isEmpty())
+      RangeManagerType local;
+#pragma omp for schedule(dynamic, 256) nowait
+      for (SignedSize i = 0; i < SignedSize(this->size()); ++i)
       {
-        extendRT(box.minPosition()[Peak2D::RT]);
-        extendRT(box.maxPosition()[Peak2D::RT]);
-        extendMZ(box.minPosition()[Peak2D::MZ]);
-        extendMZ(box.maxPosition()[Peak2D::MZ]);
+        const Feature& f = this->operator[](i);
+        local.extendRT(f.getRT());
+        local.extendMZ(f.getMZ());
+        local.extendIntensity(f.getIntensity());
+
+        // enlarge the range by the convex hull points (computed lazily, per feature)
+        const DBoundingBox<2>& box = f.getConvexHull().getBoundingBox();
+        if (!box.isEmpty())
+        {
+          local.extendRT(box.minPosition()[Peak2D::RT]);
+          local.extendRT(box.maxPosition()[Peak2D::RT]);
+          local.extendMZ(box.minPosition()[Peak2D::MZ]);
+          local.extendMZ(box.maxPosition()[Peak2D::MZ]);
+        }
       }
+#pragma omp critical (FeatureMap_updateRanges)
+      extend(local);
     }
   }
 
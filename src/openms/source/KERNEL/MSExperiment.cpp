@@ -16,6 +16,7 @@
 #include <OpenMS/SYSTEM/File.h>
 
 #include <algorithm>
+#include <exception>
 #include <limits>
 
 namespace OpenMS
@@ -246,7 +247,40 @@ namespace OpenMS
       return;
     }
 
-    // update
+    // ranges of the spectra and chromatograms are independent of each other: update them in parallel
+    std::exception_ptr error;
+    SignedSize error_index = std::numeric_limits<SignedSize>::max();
+    const SignedSize n_spectra = spectra_.size(), n_total = n_spectra + chromatograms_.size();
+#pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize i = 0; i < n_total; ++i)
+    {
+      try
+      {
+        if (i >= n_spectra)
+        {
+          chromatograms_[i - n_spectra].updateRanges();
+        }
+        else if (ms_level < Int(0) || Int(spectra_[i].getMSLevel()) == ms_level)
+        {
+          spectra_[i].updateRanges();
+        }
+      }
+      catch (...)
+      {
+#pragma omp critical (MSExperiment_updateRanges)
+        if (i < error_index)
+        {
+          error_index = i;
+          error = std::current_exception();
+        }
+      }
+    }
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+
+    // combine
     for (Base::iterator it = spectra_.begin(); it != spectra_.end(); ++it)
     {
       if (ms_level < Int(0) || Int(it->getMSLevel()) == ms_level)
@@ -263,7 +297,6 @@ namespace OpenMS
         // ranges
         this->extendRT(it->getRT()); // RT
         // m/z, intensity and ion mobility from spectrum's range
-        it->updateRanges();
         this->extend(*it);
       }
       // for MS level = 1 we extend the range for all the MS2 precursors
@@ -285,10 +318,9 @@ namespace OpenMS
     }
 
     // update intensity, m/z and RT according to chromatograms as well:
-    for (ChromatogramType& cp : chromatograms_)
+    for (const ChromatogramType& cp : chromatograms_)
     {
-      // update range of EACH chrom, if we need them individually later
-      cp.updateRanges();
+      // (the range of EACH chrom was updated above, if we need them individually later)
 
       // ignore TICs and ECs for the whole experiments range (as these are usually positioned at 0 and therefor lead to a large white margin in plots if included)
       if (cp.getChromatogramType() == ChromatogramSettings::TOTAL_ION_CURRENT_CHROMATOGRAM ||
@@ -375,6 +407,12 @@ namespace OpenMS
     }
   }
 
+  void MSExperiment::placeMemory(TaskScheduler::MemoryPlacement placement)
+  {
+    TaskScheduler::placeMemory(spectra_, placement);
+    TaskScheduler::placeMemory(chromatograms_, placement);
+  }
+
   /**
   @brief Checks if all spectra are sorted with respect to ascending RT
 
@@ -13,6 +13,9 @@
 #include <OpenMS/FORMAT/PeakTypeEstimator.h>
 #include <OpenMS/IONMOBILITY/IMDataConverter.h>
 
+#include <algorithm>
+#include <limits>
+
 namespace OpenMS
 {
   MSSpectrum &MSSpectrum::select(const std::vector<Size> &indices)
@@ -528,10 +531,27 @@ namespace OpenMS
   void MSSpectrum::updateRanges()
   {
     clearRanges();
+    // one pass with local minima and maxima (which, unlike the members, can be kept in registers);
+    // like extend(), std::min/max ignore NaN values
+    double min_mz = std::numeric_limits<double>::max(), max_mz = std::numeric_limits<double>::lowest();
+    double min_int = std::numeric_limits<double>::max(), max_int = std::numeric_limits<double>::lowest();
     for (const auto& peak : (ContainerType&)*this)
     {
-      extendMZ(peak.getMZ()); 
-      extendIntensity(peak.getIntensity());
+      const double mz = peak.getMZ(), intensity = peak.getIntensity();
+      min_mz = std::min(min_mz, mz);
+      max_mz = std::max(max_mz, mz);
+      min_int = std::min(min_int, intensity);
+      max_int = std::max(max_int, intensity);
+    }
+    if (min_mz <= max_mz)
+    {
+      extendMZ(min_mz);
+      extendMZ(max_mz);
+    }
+    if (min_int <= max_int)
+    {
+      extendIntensity(min_int);
+      extendIntensity(max_int);
     }
     // IM
     // if this is an ion mobility frame, consider the binary data array as well
@@ -539,9 +559,16 @@ namespace OpenMS
     {
       auto [im_array_index, im_unit] = getIMData();
       const auto& im_data = getFloatDataArrays()[im_array_index];
-      for (const auto& im : im_data)
+      double min_im = std::numeric_limits<double>::max(), max_im = std::numeric_limits<double>::lowest();
+      for (const double im : im_data)
+      {
+        min_im = std::min(min_im, im);
+        max_im = std::max(max_im, im);
+      }
+      if (min_im <= max_im)
       {
-        this->extendMobility(im);
+        this->extendMobility(min_im);
+        this->extendMobility(max_im);
       }
     }
     else if (getDriftTime() != IMTypes::DRIFTTIME_NOT_SET) // != -1
@@ -28,11 +28,102 @@ namespace OpenMS
     indexed_mzml_file_.setSkipXMLChecks(skip);
   }
 
+  void OnDiscMSExperiment::setOffsetIndexFallback(bool fallback)
+  {
+    indexed_mzml_file_.setOffsetIndexFallback(fallback);
+  }
+
   OpenMS::Interfaces::ChromatogramPtr OnDiscMSExperiment::getChromatogramById(Size id)
   {
     return indexed_mzml_file_.getChromatogramById(id);
   }
 
+  std::vector<MSSpectrum> OnDiscMSExperiment::getSpectra(const std::vector<Size>& ids)
+  {
+    std::vector<MSSpectrum> result(ids.size());
+    size_t err_count = 0;
+    String error_message;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)ids.size(); ++i)
+    {
+      if (err_count) continue; // no need to read further if already an error was encountered
+      try
+      {
+        result[i] = getSpectrum(ids[i]);
+      }
+      catch (OpenMS::Exception::BaseException& e)
+      {
+#ifdef _OPENMP
+#pragma omp critical(OnDiscMSExperimentErrorHandling)
+#endif
+        {
+          ++err_count;
+          error_message = e.what();
+        }
+      }
+      catch (std::exception& e)
+      {
+#ifdef _OPENMP
+#pragma omp critical(OnDiscMSExperimentErrorHandling)
+#endif
+        {
+          ++err_count;
+          error_message = e.what();
+        }
+      }
+    }
+    if (err_count != 0)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_, "Error while reading spectra: '" + error_message + "'");
+    }
+    return result;
+  }
+
+  std::vector<MSChromatogram> OnDiscMSExperiment::getChromatograms(const std::vector<Size>& ids)
+  {
+    std::vector<MSChromatogram> result(ids.size());
+    size_t err_count = 0;
+    String error_message;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)ids.size(); ++i)
+    {
+      if (err_count) continue; // no need to read further if already an error was encountered
+      try
+      {
+        result[i] = getChromatogram(ids[i]);
+      }
+      catch (OpenMS::Exception::BaseException& e)
+      {
+#ifdef _OPENMP
+#pragma omp critical(OnDiscMSExperimentErrorHandling)
+#endif
+        {
+          ++err_count;
+          error_message = e.what();
+        }
+      }
+      catch (std::exception& e)
+      {
+#ifdef _OPENMP
+#pragma omp critical(OnDiscMSExperimentErrorHandling)
+#endif
+        {
+          ++err_count;
+          error_message = e.what();
+        }
+      }
+    }
+    if (err_count != 0)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_, "Error while reading chromatograms: '" + error_message + "'");
+    }
+    return result;
+  }
+
   void OnDiscMSExperiment::loadMetaData_(const String& filename)
   {
     meta_ms_experiment_ = boost::shared_ptr< PeakMap >(new PeakMap);
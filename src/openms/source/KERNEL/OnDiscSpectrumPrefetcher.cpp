@@ -0,0 +1,104 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/KERNEL/OnDiscSpectrumPrefetcher.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace OpenMS
+{
+  namespace
+  {
+    std::vector<Size> allIds(const OnDiscMSExperiment& exp)
+    {
+      std::vector<Size> ids(exp.getNrSpectra());
+      std::iota(ids.begin(), ids.end(), 0);
+      return ids;
+    }
+  }
+
+  OnDiscSpectrumPrefetcher::OnDiscSpectrumPrefetcher(OnDiscMSExperiment& exp, Size batch_size) :
+    OnDiscSpectrumPrefetcher(exp, allIds(exp), batch_size)
+  {
+  }
+
+  OnDiscSpectrumPrefetcher::OnDiscSpectrumPrefetcher(OnDiscMSExperiment& exp, const std::vector<Size>& ids, Size batch_size) :
+    exp_(exp),
+    ids_(ids),
+    batch_size_(batch_size)
+  {
+    if (batch_size_ == 0)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Batch size must be positive.");
+    }
+    prefetch_();
+  }
+
+  OnDiscSpectrumPrefetcher::~OnDiscSpectrumPrefetcher()
+  {
+    // the reading thread accesses exp_ and ids_, it must finish before they go away
+    if (pending_.valid())
+    {
+      pending_.wait();
+    }
+  }
+
+  void OnDiscSpectrumPrefetcher::prefetch_()
+  {
+    if (next_start_ >= ids_.size())
+    {
+      return;
+    }
+    const Size end = std::min(next_start_ + batch_size_, ids_.size());
+    std::vector<Size> batch_ids(ids_.begin() + next_start_, ids_.begin() + end);
+    pending_ = std::async(std::launch::async, [this, batch_ids]() { return exp_.getSpectra(batch_ids); });
+  }
+
+  bool OnDiscSpectrumPrefetcher::fetch_(std::vector<MSSpectrum>& batch)
+  {
+    if (!pending_.valid())
+    {
+      batch.clear();
+      return false;
+    }
+    batch = pending_.get(); // rethrows errors of the reading thread
+    batch_start_ = next_start_;
+    next_start_ += batch.size();
+    prefetch_();
+    return true;
+  }
+
+  bool OnDiscSpectrumPrefetcher::nextBatch(std::vector<MSSpectrum>& batch)
+  {
+    if (!fetch_(batch))
+    {
+      return false;
+    }
+    returned_ += batch.size();
+    return true;
+  }
+
+  bool OnDiscSpectrumPrefetcher::next(MSSpectrum& spectrum)
+  {
+    if (current_pos_ == current_.size())
+    {
+      current_pos_ = 0;
+      if (!fetch_(current_))
+      {
+        return false;
+      }
+    }
+    spectrum = std::move(current_[current_pos_++]);
+    ++returned_;
+    return true;
+  }
+
+} // namespace OpenMS
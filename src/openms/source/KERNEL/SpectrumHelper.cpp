@@ -8,6 +8,8 @@
 
 #include <OpenMS/KERNEL/SpectrumHelper.h>
 
+#include <algorithm>
+
 namespace OpenMS
 {
 
@@ -24,5 +26,25 @@ namespace OpenMS
     output.setMSLevel(input.getMSLevel());
     output.setName(input.getName());
   }
+
+  void removePeaks(ColumnarSpectrum& p, const double pos_start, const double pos_end)
+  {
+    const Size first = p.MZBegin(pos_start);
+    const Size last = std::max(first, p.MZEnd(pos_end));
+    p.erase(last, p.size());
+    p.erase(0, first);
+  }
+
+  void subtractMinimumIntensity(ColumnarSpectrum& p)
+  {
+    if (p.empty()) return;
+
+    std::vector<float>& intensities = p.getIntensityArray();
+    const float rebase = - *std::min_element(intensities.begin(), intensities.end());
+    for (float& intensity : intensities)
+    {
+      intensity += rebase;
+    }
+  }
 }
 
@@ -8,6 +8,9 @@ BaseFeature.cpp
 BinnedSpectrum.cpp
 ChromatogramPeak.cpp
 ChromatogramTools.cpp
+ColumnarConsensusMap.cpp
+ColumnarExperiment.cpp
+ColumnarSpectrum.cpp
 ConsensusFeature.cpp
 ConsensusMap.cpp
 ConversionHelper.cpp
@@ -26,6 +29,7 @@ MSChromatogram.cpp
 MSExperiment.cpp
 MSSpectrum.cpp
 OnDiscMSExperiment.cpp
+OnDiscSpectrumPrefetcher.cpp
 Peak1D.cpp
 Peak2D.cpp
 PeakIndex.cpp
@@ -79,6 +79,32 @@ namespace OpenMS
     return ((d_[i] * xx + c_[i]) * xx + b_[i]) * xx + a_[i];
   }
 
+  void CubicSpline2d::eval(std::vector<double>& x) const
+  {
+    // index of the closest node left of (or exactly at) the previous position
+    std::size_t i = 0;
+    const std::size_t last_segment = x_.size() - 2;
+    for (double& value : x)
+    {
+      if (value < x_.front() || value > x_.back())
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Argument out of range of spline interpolation.");
+      }
+
+      if (value >= x_[i])
+      {
+        while (i < last_segment && x_[i + 1] <= value) ++i;
+      }
+      else
+      {
+        i = std::upper_bound(x_.begin(), x_.begin() + i, value) - x_.begin() - 1;
+      }
+
+      const double xx = value - x_[i];
+      value = ((d_[i] * xx + c_[i]) * xx + b_[i]) * xx + a_[i];
+    }
+  }
+
   double CubicSpline2d::derivative(const double x) const
   {
     return derivatives(x, 1);
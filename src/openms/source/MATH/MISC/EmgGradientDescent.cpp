@@ -8,6 +8,7 @@
 
 #include <OpenMS/MATH/MISC/EmgGradientDescent.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
 
 #include <numeric>
 
@@ -233,6 +234,68 @@ namespace OpenMS
     return result;
   }
 
+  void EmgGradientDescent::Loss_and_gradient(
+    const std::vector<double>& xs,
+    const std::vector<double>& ys,
+    const double h,
+    const double mu,
+    const double sigma,
+    const double tau,
+    double& E,
+    double& diff_E_h,
+    double& diff_E_mu,
+    double& diff_E_sigma,
+    double& diff_E_tau
+  ) const
+  {
+    // Same terms as Loss_function() and E_wrt_h() ... E_wrt_tau(), but the
+    // exponentials and error functions common to the partial derivatives of a
+    // point are evaluated once (and summed in the same order, so the results are identical)
+    const double u = mu;
+    const double s = sigma;
+    const double t = tau;
+    E = diff_E_h = diff_E_mu = diff_E_sigma = diff_E_tau = 0.0;
+    for (Size i = 0; i < xs.size(); ++i)
+    {
+      const double x = xs[i];
+      const double y = ys[i];
+      E += std::pow(emg_point(x, h, mu, sigma, tau) - y, 2.0) / xs.size();
+      const double z = compute_z(x, mu, sigma, tau);
+      if (z < 0)
+      {
+        const double e1 = std::exp(x/t);
+        const double c1 = std::erfc((std::pow(s,2.0) + t * (u - x))/(std::sqrt(2.0) * s * t));
+        const double e2 = std::exp((std::pow(s,2.0) + 2 * t * u)/(2 * std::pow(t,2.0)));
+        const double e3 = std::exp((std::pow(s,2.0) + 2.0 * t * u - 4.0 * t * x)/(2.0 * std::pow(t,2.0)));
+        const double c2 = std::erfc((s/t - (x - u)/s)/std::sqrt(2.0));
+        const double e4 = std::exp(std::pow(s,2.0)/(2.0 * std::pow(t,2.0)) - (x - u)/t);
+        const double e5 = std::exp(std::pow(s,2.0)/(2.0 * std::pow(t,2.0)) - 1.0/2.0 * std::pow((s/t - (x - u)/s),2.0) - (x - u)/t);
+        diff_E_h += ((s * e3 * c1 * (PI * h * s * e2 * c1 - std::sqrt(2.0 * PI) * t * y * e1))/std::pow(t,2.0)) / static_cast<double>(xs.size());
+        diff_E_mu += (2 * ((std::sqrt(PI/2.0) * h * s * e4 * c2)/std::pow(t,2.0) - (h * e5)/t) * ((std::sqrt(PI/2.0) * h * s * e4 * c2)/t - y)) / static_cast<double>(xs.size());
+        diff_E_sigma += (2.0 * ((std::sqrt(PI/2.0) * h * e4 * c2)/t + (std::sqrt(PI/2.0) * h * std::pow(s,2.0) * e4 * c2)/std::pow(t,3.0) - (h * s * e5 * ((x - u)/std::pow(s,2.0) + 1.0/t))/t) * ((std::sqrt(PI/2.0) * h * s * e4 * c2)/t - y)) / static_cast<double>(xs.size());
+        diff_E_tau += (2 * (-(std::sqrt(PI/2.0) * h * s * e4 * c2)/std::pow(t,2.0) + (std::sqrt(PI/2.0) * h * s * e4 * ((x - u)/std::pow(t,2.0) - std::pow(s,2.0)/std::pow(t,3.0)) * c2)/t + (h * std::pow(s,2.0) * e5)/std::pow(t,3.0)) * ((std::sqrt(PI/2.0) * h * s * e4 * c2)/t - y)) / static_cast<double>(xs.size());
+      }
+      else if (z <= 6.71e7)
+      {
+        const double c1 = std::erfc((s/t - (x - u)/s)/std::sqrt(2.0));
+        const double e1 = std::exp(1.0/2.0 * std::pow((s/t - (x - u)/s), 2.0) - std::pow((x - u),2.0)/(2 * std::pow(s,2.0)));
+        const double e2 = std::exp(-std::pow((x - u),2.0)/(2.0 * std::pow(s,2.0)));
+        diff_E_h += ((std::sqrt(2.0 * PI) * s * e1 * c1 * ((std::sqrt(PI/2.0) * h * s * e1 * c1)/t - y))/t) / static_cast<double>(xs.size());
+        diff_E_mu += (2 * ((std::sqrt(PI/2.0) * h * s * e1 * ((x - u)/std::pow(s,2.0) + (s/t - (x - u)/s)/s) * c1)/t - (h * e2)/t) * ((std::sqrt(PI/2.0) * h * s * e1 * c1)/t - y)) / static_cast<double>(xs.size());
+        diff_E_sigma += (2.0 * ((std::sqrt(PI/2.0) * h * e1 * c1)/t + (std::sqrt(PI/2.0) * h * s * e1 * (std::pow((x - u),2.0)/std::pow(s,3.0) + ((x - u)/std::pow(s,2.0) + 1.0/t) * (s/t - (x - u)/s)) * c1)/t - (h * s * e2 * ((x - u)/std::pow(s,2.0) + 1.0/t))/t) * ((std::sqrt(PI/2.0) * h * s * e1 * c1)/t - y)) / static_cast<double>(xs.size());
+        diff_E_tau += (2 * (-(std::sqrt(PI/2.0) * h * std::pow(s,2.0) * e1 * (s/t - (x - u)/s) * c1)/std::pow(t,3.0) - (std::sqrt(PI/2.0) * h * s * e1 * c1)/std::pow(t,2.0) + (h * std::pow(s,2.0) * e2)/std::pow(t,3.0)) * ((std::sqrt(PI/2.0) * h * s * e1 * c1)/t - y)) / static_cast<double>(xs.size());
+      }
+      else
+      {
+        const double e1 = std::exp(-std::pow((x - u),2.0)/(2 * std::pow(s,2.0)));
+        diff_E_h += ((2 * e1 * ((h * e1)/(1 - (t * (x - u))/std::pow(s,2.0)) - y))/(1 - (t * (x - u))/std::pow(s,2.0))) / static_cast<double>(xs.size());
+        diff_E_mu += (2.0 * ((h * (x - u) * e1)/(std::pow(s,2.0) * (1.0 - (t * (x - u))/std::pow(s,2.0))) - (h * t * e1)/(std::pow(s,2.0) * std::pow((1.0 - (t * (x - u))/std::pow(s,2.0)),2.0))) * ((h * e1)/(1.0 - (t * (x - u))/std::pow(s,2.0)) - y)) / static_cast<double>(xs.size());
+        diff_E_sigma += (2.0 * ((h * std::pow((x - u),2.0) * e1)/(std::pow(s,3.0) * (1.0 - (t * (x - u))/std::pow(s,2.0))) - (2.0 * h * t * (x - u) * e1)/(std::pow(s,3.0) * std::pow((1.0 - (t * (x - u))/std::pow(s,2.0)),2.0))) * ((h * e1)/(1 - (t * (x - u))/std::pow(s,2.0)) - y)) / static_cast<double>(xs.size());
+        diff_E_tau += ((2.0 * h * (x - u) * e1 * ((h * e1)/(1.0 - (t * (x - u))/std::pow(s,2.0)) - y))/(std::pow(s,2.0) * std::pow((1.0 - (t * (x - u))/std::pow(s,2.0)),2.0))) / static_cast<double>(xs.size());
+      }
+    }
+  }
+
   double EmgGradientDescent::Loss_function(
     const std::vector<double>& xs,
     const std::vector<double>& ys,
@@ -628,8 +691,16 @@ namespace OpenMS
         break;
       }
 
-      // Compute the cost given the current parameters
-      const double current_E = Loss_function(TrX, TrY, h, mu, sigma, tau);
+      // Compute the cost (and its partial derivatives) given the current parameters
+      double current_E, diff_E_h, diff_E_mu, diff_E_sigma, diff_E_tau;
+      if (print_debug_ == 2)
+      {
+        current_E = Loss_function(TrX, TrY, h, mu, sigma, tau);
+      }
+      else
+      {
+        Loss_and_gradient(TrX, TrY, h, mu, sigma, tau, current_E, diff_E_h, diff_E_mu, diff_E_sigma, diff_E_tau);
+      }
 
       // Break if the computed cost is an invalid value
       if (std::isnan(current_E) || std::isinf(current_E))
@@ -650,11 +721,13 @@ namespace OpenMS
         best_iter = iter_idx;
       }
 
-      // Compute the partial derivatives given the current parameters
-      double diff_E_h = E_wrt_h(TrX, TrY, h, mu, sigma, tau);
-      double diff_E_mu = E_wrt_mu(TrX, TrY, h, mu, sigma, tau);
-      double diff_E_sigma = E_wrt_sigma(TrX, TrY, h, mu, sigma, tau);
-      double diff_E_tau = E_wrt_tau(TrX, TrY, h, mu, sigma, tau);
+      if (print_debug_ == 2)
+      {
+        diff_E_h = E_wrt_h(TrX, TrY, h, mu, sigma, tau);
+        diff_E_mu = E_wrt_mu(TrX, TrY, h, mu, sigma, tau);
+        diff_E_sigma = E_wrt_sigma(TrX, TrY, h, mu, sigma, tau);
+        diff_E_tau = E_wrt_tau(TrX, TrY, h, mu, sigma, tau);
+      }
 
       // Logging info to the terminal
       if (print_debug_ == 1 && iter_idx % info_iter_threshold == 0)
@@ -780,6 +853,43 @@ namespace OpenMS
     }
   }
 
+  template <typename PeakContainerT>
+  void EmgGradientDescent::fitEMGPeakModels(
+    const std::vector<PeakContainerT>& input_peaks,
+    std::vector<PeakContainerT>& output_peaks,
+    const std::vector<std::pair<double, double>>& boundaries
+  ) const
+  {
+    if (!boundaries.empty() && boundaries.size() != input_peaks.size())
+    {
+      throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, boundaries.size());
+    }
+    output_peaks.resize(input_peaks.size());
+    TaskScheduler::parallelFor(0, SignedSize(input_peaks.size()), [&](SignedSize i)
+    {
+      if (boundaries.empty())
+      {
+        fitEMGPeakModel(input_peaks[i], output_peaks[i]);
+      }
+      else
+      {
+        fitEMGPeakModel(input_peaks[i], output_peaks[i], boundaries[i].first, boundaries[i].second);
+      }
+    });
+  }
+
+  template void OPENMS_DLLAPI EmgGradientDescent::fitEMGPeakModels<MSChromatogram>(
+    const std::vector<MSChromatogram>& input_peaks,
+    std::vector<MSChromatogram>& output_peaks,
+    const std::vector<std::pair<double, double>>& boundaries
+  ) const;
+
+  template void OPENMS_DLLAPI EmgGradientDescent::fitEMGPeakModels<MSSpectrum>(
+    const std::vector<MSSpectrum>& input_peaks,
+    std::vector<MSSpectrum>& output_peaks,
+    const std::vector<std::pair<double, double>>& boundaries
+  ) const;
+
   template void OPENMS_DLLAPI EmgGradientDescent::fitEMGPeakModel<MSChromatogram>(
     const MSChromatogram& input_peak,
     MSChromatogram& output_peak,
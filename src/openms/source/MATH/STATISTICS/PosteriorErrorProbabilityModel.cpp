@@ -22,6 +22,7 @@
 #include <QtCore/QDir>
 
 #include <algorithm>
+#include <numeric>
 
 
 
@@ -42,6 +43,8 @@ namespace OpenMS::Math
       defaults_.setValue("incorrectly_assigned", "Gumbel", "for 'Gumbel', the Gumbel distribution is used to plot incorrectly assigned sequences. For 'Gauss', the Gauss distribution is used.", {"advanced"});
       defaults_.setValue("max_nr_iterations", 1000, "Bounds the number of iterations for the EM algorithm when convergence is slow.", {"advanced"});
       defaults_.setValidStrings("incorrectly_assigned", {"Gumbel","Gauss"});
+      defaults_.setValue("em_number_of_bins", 0, "Number of bins for a binned EM fit (0 = fit all scores exactly). If there are more scores than bins, the scores are binned into equal-width bins, each represented by the mean of its scores, and the EM algorithm runs on the weighted bins. This is much faster for large data sets, at a small loss of precision. Identical scores are always merged, which does not change the fit.", {"advanced"});
+      defaults_.setMinInt("em_number_of_bins", 0);
       defaults_.setValue("neg_log_delta",6, "The negative logarithm of the convergence threshold for the likelihood increase.");
       defaults_.setValue("outlier_handling","ignore_iqr_outliers", "What to do with outliers:\n"
                                                                    "- ignore_iqr_outliers: ignore outliers outside of 3*IQR from Q1/Q3 for fitting\n"
@@ -119,39 +122,36 @@ namespace OpenMS::Math
       int delta = param_.getValue("neg_log_delta");
       int itns = 0;
 
+      // data points for the EM: identical (or, if binned, similar) scores are merged into weighted points
+      vector<double> em_scores, em_weights;
+      aggregateScores_(x_scores, (Size)param_.getValue("em_number_of_bins"), em_scores, em_weights);
+      const double total_weight = Math::sum(em_weights.begin(), em_weights.end()); // number of scores
+
       vector<double> incorrect_log_density, correct_log_density;
-      fillLogDensitiesGumbel(x_scores, incorrect_log_density, correct_log_density);
+      fillLogDensitiesGumbel(em_scores, incorrect_log_density, correct_log_density);
       vector<double> bins;
       vector<double> incorrect_posteriors;
-      double maxlike = computeLLAndIncorrectPosteriorsFromLogDensities(incorrect_log_density, correct_log_density, incorrect_posteriors);
-      double sumIncorrectPosteriors = Math::sum(incorrect_posteriors.begin(),incorrect_posteriors.end());
-      double sumCorrectPosteriors = x_scores.size() - sumIncorrectPosteriors;
+      double maxlike = computeLLAndIncorrectPosteriorsFromLogDensities(incorrect_log_density, correct_log_density, em_weights, incorrect_posteriors);
+      double sumIncorrectPosteriors = std::inner_product(em_weights.begin(), em_weights.end(), incorrect_posteriors.begin(), 0.0);
+      double sumCorrectPosteriors = total_weight - sumIncorrectPosteriors;
 
       OpenMS::Math::GumbelMaxLikelihoodFitter gmlf{incorrectly_assigned_fit_gumbel_param_};
+      vector<double> weighted_incorrect_posteriors(em_weights.size());
 
       do
       {
         //-------------------------------------------------------------
         // E-STEP (gauss)
-        double newGaussMean = 0.0;
-        auto the_x = x_scores.cbegin();
-
-        for (auto incorrect = incorrect_posteriors.cbegin(); incorrect != incorrect_posteriors.cend(); ++incorrect, ++the_x)
-        {
-          newGaussMean += (1.-*incorrect) * *the_x;
-        }
-        newGaussMean /= sumCorrectPosteriors;
-
-        double newGaussSigma = 0.0;
-        the_x = x_scores.cbegin();
+        double newGaussMean = pos_neg_mean_weighted_posteriors(em_scores, incorrect_posteriors, em_weights).first / sumCorrectPosteriors;
+        double newGaussSigma = pos_neg_sigma_weighted_posteriors(em_scores, incorrect_posteriors, em_weights, {newGaussMean, 0.0}).first;
+        newGaussSigma = sqrt(newGaussSigma/sumCorrectPosteriors);
 
-        for (auto incorrect = incorrect_posteriors.cbegin(); incorrect != incorrect_posteriors.cend(); ++incorrect, ++the_x)
+        // weight of each point for the incorrect component
+        for (Size i = 0; i < em_weights.size(); ++i)
         {
-          newGaussSigma += (1. - *incorrect) * pow((*the_x) - newGaussMean, 2);
+          weighted_incorrect_posteriors[i] = em_weights[i] * incorrect_posteriors[i];
         }
-        newGaussSigma = sqrt(newGaussSigma/sumCorrectPosteriors);
-
-        GumbelMaxLikelihoodFitter::GumbelDistributionFitResult newGumbelParams = gmlf.fitWeighted(x_scores, incorrect_posteriors);
+        GumbelMaxLikelihoodFitter::GumbelDistributionFitResult newGumbelParams = gmlf.fitWeighted(em_scores, weighted_incorrect_posteriors);
 
         if (newGumbelParams.b <= 0 || std::isnan(newGumbelParams.b))
         {
@@ -168,11 +168,11 @@ namespace OpenMS::Math
 
 
         // compute new prior probabilities negative peptides
-        fillLogDensitiesGumbel(x_scores, incorrect_log_density, correct_log_density);
-        double new_maxlike = computeLLAndIncorrectPosteriorsFromLogDensities(incorrect_log_density, correct_log_density, incorrect_posteriors);
-        sumIncorrectPosteriors = Math::sum(incorrect_posteriors.begin(),incorrect_posteriors.end());
-        sumCorrectPosteriors = x_scores.size() - sumIncorrectPosteriors;
-        negative_prior_ = sumIncorrectPosteriors / x_scores.size();
+        fillLogDensitiesGumbel(em_scores, incorrect_log_density, correct_log_density);
+        double new_maxlike = computeLLAndIncorrectPosteriorsFromLogDensities(incorrect_log_density, correct_log_density, em_weights, incorrect_posteriors);
+        sumIncorrectPosteriors = std::inner_product(em_weights.begin(), em_weights.end(), incorrect_posteriors.begin(), 0.0);
+        sumCorrectPosteriors = total_weight - sumIncorrectPosteriors;
+        negative_prior_ = sumIncorrectPosteriors / total_weight;
 
         if (std::isnan(new_maxlike - maxlike))
         {
@@ -309,23 +309,28 @@ namespace OpenMS::Math
       int delta = param_.getValue("neg_log_delta");
       int itns = 0;
 
+      // data points for the EM: identical (or, if binned, similar) scores are merged into weighted points
+      vector<double> em_scores, em_weights;
+      aggregateScores_(x_scores, (Size)param_.getValue("em_number_of_bins"), em_scores, em_weights);
+      const double total_weight = Math::sum(em_weights.begin(), em_weights.end()); // number of scores
+
       vector<double> incorrect_log_density, correct_log_density;
-      fillLogDensities(x_scores, incorrect_log_density, correct_log_density);
+      fillLogDensities(em_scores, incorrect_log_density, correct_log_density);
       vector<double> incorrect_posteriors;
-      double maxlike = computeLLAndIncorrectPosteriorsFromLogDensities(incorrect_log_density, correct_log_density, incorrect_posteriors);
-      double sumIncorrectPosteriors = Math::sum(incorrect_posteriors.begin(),incorrect_posteriors.end());
-      double sumCorrectPosteriors = x_scores.size() - sumIncorrectPosteriors;
+      double maxlike = computeLLAndIncorrectPosteriorsFromLogDensities(incorrect_log_density, correct_log_density, em_weights, incorrect_posteriors);
+      double sumIncorrectPosteriors = std::inner_product(em_weights.begin(), em_weights.end(), incorrect_posteriors.begin(), 0.0);
+      double sumCorrectPosteriors = total_weight - sumIncorrectPosteriors;
 
       do
       {
         //-------------------------------------------------------------
         // E-STEP
-        std::pair<double,double> newMeans = pos_neg_mean_weighted_posteriors(x_scores, incorrect_posteriors);
+        std::pair<double,double> newMeans = pos_neg_mean_weighted_posteriors(em_scores, incorrect_posteriors, em_weights);
         newMeans.first /= sumCorrectPosteriors;
         newMeans.second /= sumIncorrectPosteriors;
 
         //new standard deviation
-        std::pair<double,double> newSigmas = pos_neg_sigma_weighted_posteriors(x_scores, incorrect_posteriors, newMeans);
+        std::pair<double,double> newSigmas = pos_neg_sigma_weighted_posteriors(em_scores, incorrect_posteriors, em_weights, newMeans);
         newSigmas.first = sqrt(newSigmas.first/sumCorrectPosteriors);
         newSigmas.second = sqrt(newSigmas.second/sumIncorrectPosteriors);
 
@@ -347,11 +352,11 @@ namespace OpenMS::Math
 
 
         // compute new prior probabilities negative peptides
-        fillLogDensities(x_scores, incorrect_log_density, correct_log_density);
-        double new_maxlike = computeLLAndIncorrectPosteriorsFromLogDensities(incorrect_log_density, correct_log_density, incorrect_posteriors);
-        sumIncorrectPosteriors = Math::sum(incorrect_posteriors.begin(),incorrect_posteriors.end());
-        sumCorrectPosteriors = x_scores.size() - sumIncorrectPosteriors;
-        negative_prior_ = sumIncorrectPosteriors / x_scores.size();
+        fillLogDensities(em_scores, incorrect_log_density, correct_log_density);
+        double new_maxlike = computeLLAndIncorrectPosteriorsFromLogDensities(incorrect_log_density, correct_log_density, em_weights, incorrect_posteriors);
+        sumIncorrectPosteriors = std::inner_product(em_weights.begin(), em_weights.end(), incorrect_posteriors.begin(), 0.0);
+        sumCorrectPosteriors = total_weight - sumIncorrectPosteriors;
+        negative_prior_ = sumIncorrectPosteriors / total_weight;
 
         if (std::isnan(new_maxlike - maxlike))
         {
@@ -533,6 +538,30 @@ namespace OpenMS::Math
       return loglikelihood;
     }
 
+    double PosteriorErrorProbabilityModel::computeLLAndIncorrectPosteriorsFromLogDensities(
+        const vector<double>& incorrect_log_density, const vector<double>& correct_log_density,
+        const vector<double>& weights, vector<double>& incorrect_posterior) const
+    {
+      double loglikelihood = 0.0;
+      const double log_prior_pos = log(1. - negative_prior_);
+      const double log_prior_neg = log(negative_prior_);
+      const Size n = incorrect_log_density.size();
+      incorrect_posterior.resize(n);
+
+      for (Size i = 0; i < n; ++i)
+      {
+        double log_resp_correct = log_prior_pos + correct_log_density[i];
+        double log_resp_incorrect = log_prior_neg + incorrect_log_density[i];
+        const double max_log_resp = std::max(log_resp_correct, log_resp_incorrect);
+        const double resp_correct = exp(log_resp_correct - max_log_resp);
+        const double resp_incorrect = exp(log_resp_incorrect - max_log_resp);
+        const double sum = resp_correct + resp_incorrect;
+        incorrect_posterior[i] = resp_incorrect / sum;
+        loglikelihood += weights[i] * (max_log_resp + log(sum));
+      }
+      return loglikelihood;
+    }
+
     std::pair<double,double> PosteriorErrorProbabilityModel::pos_neg_mean_weighted_posteriors(const vector<double>& x_scores, const vector<double>& incorrect_posteriors)
     {
       double pos_x0(0);
@@ -566,6 +595,83 @@ namespace OpenMS::Math
       return {pos_sigma, neg_sigma};
     }
 
+    std::pair<double,double> PosteriorErrorProbabilityModel::pos_neg_mean_weighted_posteriors(
+        const vector<double>& x_scores,
+        const vector<double>& incorrect_posteriors,
+        const vector<double>& weights)
+    {
+      double pos_x0(0);
+      double neg_x0(0);
+      for (Size i = 0; i < x_scores.size(); ++i)
+      {
+        const double wx = weights[i] * x_scores[i];
+        pos_x0 += (1. - incorrect_posteriors[i]) * wx;
+        neg_x0 += incorrect_posteriors[i] * wx;
+      }
+      return {pos_x0, neg_x0};
+    }
+
+    std::pair<double,double> PosteriorErrorProbabilityModel::pos_neg_sigma_weighted_posteriors(
+        const vector<double>& x_scores,
+        const vector<double>& incorrect_posteriors,
+        const vector<double>& weights,
+        const std::pair<double,double>& pos_neg_mean)
+    {
+      double pos_sigma(0);
+      double neg_sigma(0);
+      for (Size i = 0; i < x_scores.size(); ++i)
+      {
+        const double pos_diff = x_scores[i] - pos_neg_mean.first;
+        const double neg_diff = x_scores[i] - pos_neg_mean.second;
+        pos_sigma += weights[i] * (1. - incorrect_posteriors[i]) * pos_diff * pos_diff;
+        neg_sigma += weights[i] * incorrect_posteriors[i] * neg_diff * neg_diff;
+      }
+      return {pos_sigma, neg_sigma};
+    }
+
+    void PosteriorErrorProbabilityModel::aggregateScores_(const vector<double>& x_scores, Size nr_bins, vector<double>& values, vector<double>& weights)
+    {
+      values.clear();
+      weights.clear();
+      if (x_scores.empty())
+      {
+        return;
+      }
+      vector<double> sorted_copy;
+      const vector<double>* x = &x_scores;
+      if (!std::is_sorted(x_scores.begin(), x_scores.end()))
+      {
+        sorted_copy = x_scores;
+        std::sort(sorted_copy.begin(), sorted_copy.end());
+        x = &sorted_copy;
+      }
+      const double lowest = x->front();
+      const double highest = x->back();
+      const bool binned = nr_bins > 0 && x->size() > nr_bins && highest > lowest;
+      const double bin_width = binned ? (highest - lowest) / nr_bins : 0.0;
+      // bins (or identical scores for the exact fit) are consecutive in the sorted scores
+      auto same_group = [&](double a, double b)
+      {
+        if (!binned)
+        {
+          return a == b;
+        }
+        return std::min(Size((a - lowest) / bin_width), nr_bins - 1) == std::min(Size((b - lowest) / bin_width), nr_bins - 1);
+      };
+      for (Size i = 0; i < x->size();)
+      {
+        double sum = 0.0;
+        Size j = i;
+        for (; j < x->size() && same_group((*x)[i], (*x)[j]); ++j)
+        {
+          sum += (*x)[j];
+        }
+        values.push_back(sum / double(j - i));
+        weights.push_back(double(j - i));
+        i = j;
+      }
+    }
+
     double PosteriorErrorProbabilityModel::computeProbability(double score) const
     {
       // apply the same transformation that was applied before fitting
@@ -0,0 +1,228 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg$
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/MATH/STATISTICS/QuantileSketch.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/CONCEPT/Macros.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace OpenMS
+{
+  namespace Math
+  {
+    QuantileSketch::QuantileSketch(double relative_accuracy) :
+      relative_accuracy_(relative_accuracy)
+    {
+      if (!(relative_accuracy > 0.0 && relative_accuracy < 1.0))
+      {
+        throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "The relative accuracy needs to be in (0, 1).", String(relative_accuracy));
+      }
+      gamma_ = (1.0 + relative_accuracy) / (1.0 - relative_accuracy);
+      log_gamma_ = std::log(gamma_);
+    }
+
+    QuantileSketch::QuantileSketch(double relative_accuracy, const Bins& positive, const Bins& negative, UInt64 zero_count, double min, double max) :
+      QuantileSketch(relative_accuracy)
+    {
+      positive_ = positive;
+      negative_ = negative;
+      zero_count_ = zero_count;
+      count_ = zero_count;
+      for (const auto& bin : positive_)
+      {
+        count_ += bin.second;
+      }
+      for (const auto& bin : negative_)
+      {
+        count_ += bin.second;
+      }
+      min_ = min;
+      max_ = max;
+    }
+
+    bool QuantileSketch::operator==(const QuantileSketch& rhs) const
+    {
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wfloat-equal"
+      return relative_accuracy_ == rhs.relative_accuracy_ &&
+             positive_ == rhs.positive_ &&
+             negative_ == rhs.negative_ &&
+             zero_count_ == rhs.zero_count_ &&
+             count_ == rhs.count_ &&
+             min_ == rhs.min_ &&
+             max_ == rhs.max_;
+#pragma clang diagnostic pop
+    }
+
+    Int QuantileSketch::index_(double value) const
+    {
+      return Int(std::ceil(std::log(value) / log_gamma_));
+    }
+
+    double QuantileSketch::value_(Int index) const
+    {
+      return 2.0 * std::pow(gamma_, index) / (gamma_ + 1.0);
+    }
+
+    void QuantileSketch::add(double value, UInt64 count)
+    {
+      if (count == 0 || std::isnan(value))
+      {
+        return;
+      }
+      if (value >= std::numeric_limits<double>::min())
+      {
+        positive_[index_(value)] += count;
+      }
+      else if (value <= -std::numeric_limits<double>::min())
+      {
+        negative_[index_(-value)] += count;
+      }
+      else
+      {
+        zero_count_ += count;
+      }
+
+      if (count_ == 0)
+      {
+        min_ = value;
+        max_ = value;
+      }
+      else
+      {
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+      }
+      count_ += count;
+    }
+
+    void QuantileSketch::merge(const QuantileSketch& other)
+    {
+      if (std::fabs(relative_accuracy_ - other.relative_accuracy_) > 1e-12)
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Sketches with different relative accuracy cannot be merged.");
+      }
+      if (other.empty())
+      {
+        return;
+      }
+      for (const auto& bin : other.positive_)
+      {
+        positive_[bin.first] += bin.second;
+      }
+      for (const auto& bin : other.negative_)
+      {
+        negative_[bin.first] += bin.second;
+      }
+      zero_count_ += other.zero_count_;
+
+      if (count_ == 0)
+      {
+        min_ = other.min_;
+        max_ = other.max_;
+      }
+      else
+      {
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+      }
+      count_ += other.count_;
+    }
+
+    double QuantileSketch::getQuantile(double q) const
+    {
+      if (!(q >= 0.0 && q <= 1.0))
+      {
+        throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "The quantile needs to be in [0, 1].", String(q));
+      }
+      if (empty())
+      {
+        throw Exception::Precondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "The sketch needs to contain values to compute a quantile.");
+      }
+
+      // walk through the bins in ascending order of their values until the rank is reached
+      const double rank = q * double(count_ - 1);
+      double result = max_;
+      UInt64 seen = 0;
+      bool found = false;
+      for (auto it = negative_.rbegin(); it != negative_.rend() && !found; ++it)
+      {
+        seen += it->second;
+        if (double(seen) > rank)
+        {
+          result = -value_(it->first);
+          found = true;
+        }
+      }
+      if (!found)
+      {
+        seen += zero_count_;
+        if (double(seen) > rank)
+        {
+          result = 0.0;
+          found = true;
+        }
+      }
+      for (auto it = positive_.begin(); it != positive_.end() && !found; ++it)
+      {
+        seen += it->second;
+        if (double(seen) > rank)
+        {
+          result = value_(it->first);
+          found = true;
+        }
+      }
+      return std::max(min_, std::min(max_, result));
+    }
+
+    UInt64 QuantileSketch::getCount() const
+    {
+      return count_;
+    }
+
+    bool QuantileSketch::empty() const
+    {
+      return count_ == 0;
+    }
+
+    double QuantileSketch::getMin() const
+    {
+      return min_;
+    }
+
+    double QuantileSketch::getMax() const
+    {
+      return max_;
+    }
+
+    double QuantileSketch::getRelativeAccuracy() const
+    {
+      return relative_accuracy_;
+    }
+
+    const QuantileSketch::Bins& QuantileSketch::getPositiveBins() const
+    {
+      return positive_;
+    }
+
+    const QuantileSketch::Bins& QuantileSketch::getNegativeBins() const
+    {
+      return negative_;
+    }
+
+    UInt64 QuantileSketch::getZeroCount() const
+    {
+      return zero_count_;
+    }
+  } // namespace Math
+} // namespace OpenMS
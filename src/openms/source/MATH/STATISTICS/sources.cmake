@@ -10,6 +10,7 @@ GumbelDistributionFitter.cpp
 GumbelMaxLikelihoodFitter.cpp
 Histogram.cpp
 PosteriorErrorProbabilityModel.cpp
+QuantileSketch.cpp
 )
 
 ### add path to the filenames
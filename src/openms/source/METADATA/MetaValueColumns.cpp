@@ -0,0 +1,359 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/METADATA/MetaValueColumns.h>
+
+#include <OpenMS/METADATA/MetaInfoRegistry.h>
+
+using namespace std;
+
+namespace OpenMS
+{
+
+  MetaValueColumns::MetaValueColumns(Size rows) :
+    rows_(rows)
+  {
+  }
+
+  bool MetaValueColumns::operator==(const MetaValueColumns& rhs) const
+  {
+    if (rows_ != rhs.rows_)
+    {
+      return false;
+    }
+    vector<UInt> keys, rhs_keys;
+    for (Size row = 0; row < rows_; ++row)
+    {
+      getKeys(row, keys);
+      rhs.getKeys(row, rhs_keys);
+      if (keys != rhs_keys)
+      {
+        return false;
+      }
+      for (UInt key : keys)
+      {
+        if (getMetaValue(row, key) != rhs.getMetaValue(row, key))
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  bool MetaValueColumns::operator!=(const MetaValueColumns& rhs) const
+  {
+    return !(operator==(rhs));
+  }
+
+  void MetaValueColumns::resize(Size rows)
+  {
+    rows_ = rows;
+    for (auto& [key, column] : columns_)
+    {
+      resizeColumn_(column, rows);
+    }
+  }
+
+  void MetaValueColumns::clear()
+  {
+    rows_ = 0;
+    columns_.clear();
+  }
+
+  DataValue MetaValueColumns::getMetaValue(Size row, const String& name, const DataValue& default_value) const
+  {
+    return getMetaValue(row, MetaInfoInterface::metaRegistry().getIndex(name), default_value);
+  }
+
+  DataValue MetaValueColumns::getMetaValue(Size row, UInt index, const DataValue& default_value) const
+  {
+    checkRow_(row);
+    const Column* column = findColumn_(index);
+    if (column == nullptr || !column->present[row])
+    {
+      return default_value;
+    }
+    return getValue_(*column, row);
+  }
+
+  bool MetaValueColumns::metaValueExists(Size row, const String& name) const
+  {
+    return metaValueExists(row, MetaInfoInterface::metaRegistry().getIndex(name));
+  }
+
+  bool MetaValueColumns::metaValueExists(Size row, UInt index) const
+  {
+    const Column* column = findColumn_(index);
+    return column != nullptr && row < rows_ && column->present[row];
+  }
+
+  void MetaValueColumns::setMetaValue(Size row, const String& name, const DataValue& value)
+  {
+    setMetaValue(row, MetaInfoInterface::metaRegistry().registerName(name), value);
+  }
+
+  void MetaValueColumns::setMetaValue(Size row, UInt index, const DataValue& value)
+  {
+    checkRow_(row);
+    if (value.isEmpty())
+    {
+      removeMetaValue(row, index);
+      return;
+    }
+
+    auto it = columns_.find(index);
+    if (it == columns_.end())
+    {
+      // the first value decides on the storage type of the column
+      Column column;
+      if (value.hasUnit())
+      {
+        column.type = ColumnType::GENERIC;
+      }
+      else if (value.valueType() == DataValue::DOUBLE_VALUE)
+      {
+        column.type = ColumnType::DOUBLE;
+      }
+      else if (value.valueType() == DataValue::INT_VALUE)
+      {
+        column.type = ColumnType::INT;
+      }
+      else if (value.valueType() == DataValue::STRING_VALUE)
+      {
+        column.type = ColumnType::STRING;
+      }
+      else
+      {
+        column.type = ColumnType::GENERIC;
+      }
+      resizeColumn_(column, rows_);
+      it = columns_.emplace(index, std::move(column)).first;
+    }
+    setValue_(it->second, row, value);
+  }
+
+  void MetaValueColumns::removeMetaValue(Size row, const String& name)
+  {
+    removeMetaValue(row, MetaInfoInterface::metaRegistry().getIndex(name));
+  }
+
+  void MetaValueColumns::removeMetaValue(Size row, UInt index)
+  {
+    auto it = columns_.find(index);
+    if (it == columns_.end() || row >= rows_)
+    {
+      return;
+    }
+    Column& column = it->second;
+    column.present[row] = false;
+    if (column.type == ColumnType::GENERIC)
+    {
+      column.values[row] = DataValue::EMPTY; // release the memory of the value
+    }
+  }
+
+  void MetaValueColumns::getKeys(Size row, vector<String>& keys) const
+  {
+    vector<UInt> indices;
+    getKeys(row, indices);
+    keys.resize(indices.size());
+    for (Size i = 0; i < indices.size(); ++i)
+    {
+      keys[i] = MetaInfoInterface::metaRegistry().getName(indices[i]);
+    }
+  }
+
+  void MetaValueColumns::getKeys(Size row, vector<UInt>& keys) const
+  {
+    keys.clear();
+    if (row >= rows_)
+    {
+      return;
+    }
+    for (const auto& [key, column] : columns_)
+    {
+      if (column.present[row])
+      {
+        keys.push_back(key);
+      }
+    }
+  }
+
+  vector<String> MetaValueColumns::getColumnNames() const
+  {
+    vector<String> names;
+    names.reserve(columns_.size());
+    for (const auto& [key, column] : columns_)
+    {
+      names.push_back(MetaInfoInterface::metaRegistry().getName(key));
+    }
+    return names;
+  }
+
+  bool MetaValueColumns::hasColumn(const String& name) const
+  {
+    return findColumn_(MetaInfoInterface::metaRegistry().getIndex(name)) != nullptr;
+  }
+
+  MetaValueColumns::ColumnType MetaValueColumns::getColumnType(const String& name) const
+  {
+    const Column* column = findColumn_(MetaInfoInterface::metaRegistry().getIndex(name));
+    if (column == nullptr)
+    {
+      throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, name);
+    }
+    return column->type;
+  }
+
+  void MetaValueColumns::getDoubleColumn(const String& name, vector<double>& values, double missing) const
+  {
+    const Column* column = findColumn_(MetaInfoInterface::metaRegistry().getIndex(name));
+    if (column == nullptr)
+    {
+      throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, name);
+    }
+    values.assign(rows_, missing);
+    for (Size row = 0; row < rows_; ++row)
+    {
+      if (!column->present[row])
+      {
+        continue;
+      }
+      switch (column->type)
+      {
+        case ColumnType::DOUBLE:
+          values[row] = column->doubles[row];
+          break;
+        case ColumnType::INT:
+          values[row] = double(column->ints[row]);
+          break;
+        default:
+        {
+          const DataValue value = getValue_(*column, row);
+          if (value.valueType() != DataValue::DOUBLE_VALUE && value.valueType() != DataValue::INT_VALUE)
+          {
+            throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Could not convert value of '" + name + "' in row " + String(row) + " to double");
+          }
+          values[row] = double(value);
+        }
+      }
+    }
+  }
+
+  const MetaValueColumns::Column* MetaValueColumns::findColumn_(UInt index) const
+  {
+    auto it = columns_.find(index);
+    if (it == columns_.end())
+    {
+      return nullptr;
+    }
+    return &it->second;
+  }
+
+  DataValue MetaValueColumns::getValue_(const Column& column, Size row)
+  {
+    switch (column.type)
+    {
+      case ColumnType::DOUBLE:
+        return DataValue(column.doubles[row]);
+      case ColumnType::INT:
+        return DataValue(column.ints[row]);
+      case ColumnType::STRING:
+        return DataValue(column.dictionary[column.codes[row]]);
+      default:
+        return column.values[row];
+    }
+  }
+
+  void MetaValueColumns::setValue_(Column& column, Size row, const DataValue& value)
+  {
+    if (column.type != ColumnType::GENERIC)
+    {
+      const DataValue::DataType expected = column.type == ColumnType::DOUBLE ? DataValue::DOUBLE_VALUE :
+                                           column.type == ColumnType::INT ? DataValue::INT_VALUE : DataValue::STRING_VALUE;
+      if (value.hasUnit() || value.valueType() != expected)
+      {
+        makeGeneric_(column);
+      }
+    }
+
+    column.present[row] = true;
+    switch (column.type)
+    {
+      case ColumnType::DOUBLE:
+        column.doubles[row] = double(value);
+        break;
+      case ColumnType::INT:
+        column.ints[row] = SignedSize(value);
+        break;
+      case ColumnType::STRING:
+      {
+        const std::string s = value;
+        auto it = column.lookup.find(s);
+        if (it == column.lookup.end())
+        {
+          it = column.lookup.emplace(s, UInt(column.dictionary.size())).first;
+          column.dictionary.push_back(s);
+        }
+        column.codes[row] = it->second;
+        break;
+      }
+      default:
+        column.values[row] = value;
+    }
+  }
+
+  void MetaValueColumns::resizeColumn_(Column& column, Size rows)
+  {
+    column.present.resize(rows, false);
+    switch (column.type)
+    {
+      case ColumnType::DOUBLE:
+        column.doubles.resize(rows);
+        break;
+      case ColumnType::INT:
+        column.ints.resize(rows);
+        break;
+      case ColumnType::STRING:
+        column.codes.resize(rows);
+        break;
+      default:
+        column.values.resize(rows);
+    }
+  }
+
+  void MetaValueColumns::makeGeneric_(Column& column)
+  {
+    const Size rows = column.present.size();
+    vector<DataValue> values(rows);
+    for (Size row = 0; row < rows; ++row)
+    {
+      if (column.present[row])
+      {
+        values[row] = getValue_(column, row);
+      }
+    }
+    column.type = ColumnType::GENERIC;
+    column.values.swap(values);
+    column.doubles = vector<double>();
+    column.ints = vector<SignedSize>();
+    column.codes = vector<UInt>();
+    column.dictionary = vector<String>();
+    column.lookup = unordered_map<string, UInt>();
+  }
+
+  void MetaValueColumns::checkRow_(Size row) const
+  {
+    if (row >= rows_)
+    {
+      throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, row, rows_);
+    }
+  }
+
+} // namespace OpenMS
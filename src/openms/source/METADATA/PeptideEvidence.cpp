@@ -92,7 +92,7 @@ namespace OpenMS
 
   const String& PeptideEvidence::getProteinAccession() const
   {
-    return accession_;
+    return accession_.str();
   }
 
   void PeptideEvidence::setStart(const Int a)
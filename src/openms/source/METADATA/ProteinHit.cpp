@@ -21,7 +21,7 @@ namespace OpenMS
     MetaInfoInterface(),
     score_(0),
     rank_(0),
-    accession_(""),
+    accession_(),
     sequence_(""),
     coverage_(COVERAGE_UNKNOWN)
   {
@@ -84,7 +84,7 @@ namespace OpenMS
   // returns the accession of the protein
   const String& ProteinHit::getAccession() const
   {
-    return accession_;
+    return accession_.str();
   }
 
   // returns the description of the protein
@@ -135,8 +135,8 @@ namespace OpenMS
   // sets the accession of the protein
   void ProteinHit::setAccession(const String& accession)
   {
-    accession_ = accession;
-    accession_.trim();
+    String trimmed(accession);
+    accession_ = trimmed.trim();
   }
 
   // sets the coverage (in percent) of the protein hit based upon matched peptides
@@ -7,6 +7,7 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/METADATA/SpectrumLookup.h>
+#include <OpenMS/FORMAT/OffsetIndexFile.h>
 #include <boost/regex/v4/regex_match.hpp>
 
 using namespace std;
@@ -26,6 +27,32 @@ namespace OpenMS
   SpectrumLookup::~SpectrumLookup() = default;
 
 
+  void SpectrumLookup::readSpectra(const OffsetIndexFile& index,
+                                   const String& scan_regexp)
+  {
+    rts_.clear();
+    ids_.clear();
+    scans_.clear();
+    const vector<OffsetIndexFile::Entry>& spectra = index.getSpectra();
+    n_spectra_ = spectra.size();
+    setScanRegExp_(scan_regexp);
+    for (Size i = 0; i < n_spectra_; ++i)
+    {
+      const String& native_id = spectra[i].native_id;
+      Int scan_no = -1;
+      if (!scan_regexp.empty())
+      {
+        scan_no = extractScanNumber(native_id, scan_regexp_, true);
+        if (scan_no < 0)
+        {
+          OPENMS_LOG_WARN << "Warning: Could not extract scan number from spectrum native ID '" + native_id + "' using regular expression '" + scan_regexp + "'. Look-up by scan number may not work properly." << std::endl;
+        }
+      }
+      addEntry_(i, spectra[i].rt, scan_no, native_id);
+    }
+  }
+
+
   bool SpectrumLookup::empty() const
   {
     return n_spectra_ == 0;
@@ -166,6 +166,7 @@ namespace OpenMS
           auto opts = fh.getOptions();
           // speed up reading. We do not need the actual peaks in the spectra
           opts.setFillData(false);
+          opts.setSkimBinaryData(true);
           opts.setSkipXMLChecks(true);
           fh.setOptions(opts);
           fh.loadExperiment(filename, exp, {FileTypes::MZXML, FileTypes::MZML, FileTypes::MZDATA, FileTypes::MGF}, OpenMS::ProgressLogger::NONE, true, true);
@@ -202,6 +203,7 @@ namespace OpenMS
       FileHandler fh;
       auto opts = fh.getOptions();
       opts.setFillData(false);
+      opts.setSkimBinaryData(true);
       opts.setSkipXMLChecks(true);
       fh.setOptions(opts);
       fh.loadExperiment(filename, exp, {FileTypes::MZXML, FileTypes::MZML, FileTypes::MZDATA, FileTypes::MGF}, OpenMS::ProgressLogger::NONE, true, true);
@@ -28,6 +28,7 @@ MetaInfo.cpp
 MetaInfoDescription.cpp
 MetaInfoInterface.cpp
 MetaInfoRegistry.cpp
+MetaValueColumns.cpp
 Modification.cpp
 PeptideEvidence.cpp
 PeptideHit.cpp
@@ -12,6 +12,10 @@
 #include <OpenMS/ML/CLUSTERING/CompleteLinkage.h>
 #include <OpenMS/ML/CLUSTERING/AverageLinkage.h>
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
 using namespace std;
 
 namespace OpenMS
@@ -31,4 +35,118 @@ namespace OpenMS
 
   ClusterFunctor::InsufficientInput::~InsufficientInput() throw() = default;
 
+  void ClusterFunctor::operator()(Size n, std::vector<PairDistance> & distances, std::vector<BinaryTreeNode> & cluster_tree, const float threshold) const
+  {
+    if (n < 2)
+    {
+      throw ClusterFunctor::InsufficientInput(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Distances to start from only contain one element");
+    }
+    DistanceMatrix<float> matrix(n, threshold);
+    for (const PairDistance& pair : distances)
+    {
+      if (pair.i >= n || pair.j >= n)
+      {
+        throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, std::max(pair.i, pair.j), n);
+      }
+      matrix.setValueQuick(pair.i, pair.j, pair.distance);
+    }
+    matrix.updateMinElement();
+    (*this)(matrix, cluster_tree, threshold);
+  }
+
+  void ClusterFunctor::nearestNeighborChain_(DistanceMatrix<float> & distance, const LinkageUpdate & update, std::vector<PairDistance> & merges)
+  {
+    const Size n = distance.dimensionsize();
+    merges.clear();
+    merges.reserve(n - 1);
+    // a merged cluster lives on in the slot of its first cluster
+    std::vector<bool> active(n, true);
+    std::vector<Size> size(n, 1);
+    std::vector<Size> chain;
+    chain.reserve(n);
+    Size first_active = 0;
+
+    for (Size remaining = n; remaining > 1; )
+    {
+      if (chain.empty())
+      {
+        while (!active[first_active]) ++first_active;
+        chain.push_back(first_active);
+      }
+      // nearest neighbor of the chain's end; on ties prefer its predecessor so that the chain terminates
+      const Size a = chain.back();
+      Size nearest = (chain.size() > 1) ? chain[chain.size() - 2] : n;
+      float nearest_distance = (nearest < n) ? distance.getValue(a, nearest) : std::numeric_limits<float>::infinity();
+      for (Size k = first_active; k < n; ++k)
+      {
+        if (!active[k] || k == a) continue;
+        const float d = distance.getValue(a, k);
+        if (d < nearest_distance || nearest == n)
+        {
+          nearest = k;
+          nearest_distance = d;
+        }
+      }
+
+      if (chain.size() < 2 || nearest != chain[chain.size() - 2])
+      {
+        chain.push_back(nearest);
+        continue;
+      }
+
+      // reciprocal nearest neighbors: merge them
+      chain.pop_back();
+      chain.pop_back();
+      const Size keep = std::min(a, nearest), drop = std::max(a, nearest);
+      merges.push_back({keep, drop, nearest_distance});
+      for (Size k = first_active; k < n; ++k)
+      {
+        if (!active[k] || k == keep || k == drop) continue;
+        distance.setValueQuick(keep, k, update(distance.getValue(keep, k), distance.getValue(drop, k), size[keep], size[drop], size[k]));
+      }
+      size[keep] += size[drop];
+      active[drop] = false;
+      --remaining;
+    }
+  }
+
+  void ClusterFunctor::buildTree_(Size n, std::vector<PairDistance> & merges, std::vector<BinaryTreeNode> & cluster_tree, float threshold)
+  {
+    std::stable_sort(merges.begin(), merges.end(), [](const PairDistance& a, const PairDistance& b) { return a.distance < b.distance; });
+
+    // union-find over the elements; the root of every cluster is its smallest element
+    std::vector<Size> parent(n);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](Size x)
+    {
+      while (parent[x] != x)
+      {
+        parent[x] = parent[parent[x]]; // path halving
+        x = parent[x];
+      }
+      return x;
+    };
+
+    cluster_tree.clear();
+    cluster_tree.reserve(n - 1);
+    for (const PairDistance& merge : merges)
+    {
+      if (!(merge.distance < threshold) || cluster_tree.size() + 1 == n) break;
+      Size left = find(merge.i), right = find(merge.j);
+      if (left == right) continue;
+      if (left > right) std::swap(left, right);
+      cluster_tree.emplace_back(left, right, merge.distance);
+      parent[right] = left;
+    }
+
+    // fill tree with dummy nodes
+    for (Size i = 1; i < n && cluster_tree.size() + 1 < n; ++i)
+    {
+      if (find(i) == i)
+      {
+        cluster_tree.emplace_back(0, i, -1.0);
+      }
+    }
+  }
+
 }
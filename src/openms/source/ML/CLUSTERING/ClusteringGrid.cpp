@@ -32,30 +32,13 @@ std::vector<double> ClusteringGrid::getGridSpacingY() const
 
 void ClusteringGrid::addCluster(const CellIndex &cell_index, const int &cluster_index)
 {
-    if (cells_.find(cell_index) == cells_.end())
-    {
-        // If hash grid cell does not yet exist, create a new one.
-        std::list<int> clusters;
-        clusters.push_back(cluster_index);
-        cells_.insert(std::make_pair(cell_index, clusters));
-    }
-    else
-    {
-        // If hash grid cell already exists, add the new cluster index to the existing list of clusters.
-        cells_.find(cell_index)->second.push_back(cluster_index);
-    }
+    // The hash grid cell is created if it does not exist yet.
+    cells_.insert(OpenHashGrid<int>::CellIndex(cell_index.first, cell_index.second), cluster_index);
 }
 
 void ClusteringGrid::removeCluster(const CellIndex &cell_index, const int &cluster_index)
 {
-    if (cells_.find(cell_index) != cells_.end())
-    {
-        cells_.find(cell_index)->second.remove(cluster_index);
-        if (cells_.find(cell_index)->second.empty())
-        {
-            cells_.erase(cell_index);
-        }
-    }
+    cells_.erase(OpenHashGrid<int>::CellIndex(cell_index.first, cell_index.second), cluster_index);
 }
 
 void ClusteringGrid::removeAllClusters()
@@ -65,7 +48,12 @@ void ClusteringGrid::removeAllClusters()
 
 std::list<int> ClusteringGrid::getClusters(const CellIndex &cell_index) const
 {
-    return cells_.find(cell_index)->second;
+    const OpenHashGrid<int>::CellContent* clusters = cells_.find(OpenHashGrid<int>::CellIndex(cell_index.first, cell_index.second));
+    if (clusters == nullptr)
+    {
+        return std::list<int>();
+    }
+    return std::list<int>(clusters->begin(), clusters->end());
 }
 
 ClusteringGrid::CellIndex ClusteringGrid::getIndex(const Point &position) const
@@ -85,12 +73,12 @@ ClusteringGrid::CellIndex ClusteringGrid::getIndex(const Point &position) const
 
 bool ClusteringGrid::isNonEmptyCell(const CellIndex &cell_index) const
 {
-    return cells_.find(cell_index) != cells_.end();
+    return cells_.find(OpenHashGrid<int>::CellIndex(cell_index.first, cell_index.second)) != nullptr;
 }
 
 int ClusteringGrid::getCellCount() const
 {
-    return cells_.size();
+    return cells_.cellCount();
 }
 
 }
@@ -103,64 +103,34 @@ namespace OpenMS
       setProgress(k);
     }
 
+    // pointer representation -> merges: element i joins the cluster of pi[i] at distance lambda[i]
+    std::vector<PairDistance> merges;
+    merges.reserve(pi.size() - 1);
     for (Size i = 0; i < pi.size() - 1; ++i)
     {
-      //strict order is always kept in algorithm: i < pi[i]
-      cluster_tree.emplace_back(i, pi[i], lambda[i]);
-      //~ std::cout << i << '\n' << pi[i] << '\n' << lambda[i] << std::endl;
+      merges.push_back({i, pi[i], lambda[i]});
     }
+    buildTree_(original_distance.dimensionsize(), merges, cluster_tree, std::numeric_limits<float>::infinity());
 
-    //sort pre-tree
-    std::sort(cluster_tree.begin(), cluster_tree.end(), compareBinaryTreeNode);
-
-    // convert -pre-tree to correct format
-    for (Size i = 0; i < cluster_tree.size(); ++i)
-    {
-      if (cluster_tree[i].right_child < cluster_tree[i].left_child)
-      {
-        std::swap(cluster_tree[i].left_child, cluster_tree[i].right_child);
-      }
-      for (Size k = i + 1; k < cluster_tree.size(); ++k)
-      {
-        if (cluster_tree[k].left_child == cluster_tree[i].right_child)
-        {
-          cluster_tree[k].left_child = cluster_tree[i].left_child;
-        }
-        else if (cluster_tree[k].left_child > cluster_tree[i].right_child)
-        {
-          --cluster_tree[k].left_child;
-        }
-        if (cluster_tree[k].right_child == cluster_tree[i].right_child)
-        {
-          cluster_tree[k].right_child = cluster_tree[i].left_child;
-        }
-        else if (cluster_tree[k].right_child > cluster_tree[i].right_child)
-        {
-          --cluster_tree[k].right_child;
-        }
-      }
+    endProgress();
+  }
 
-    }
-    //~ prepare to redo clustering to get all indices for binarytree in min index element representation
-    std::vector<std::set<Size> > clusters(original_distance.dimensionsize());
-    for (Size i = 0; i < original_distance.dimensionsize(); ++i)
+  void SingleLinkage::operator()(Size n, std::vector<PairDistance> & distances, std::vector<BinaryTreeNode> & cluster_tree, const float threshold /*=1*/) const
+  {
+    if (n < 2)
     {
-      clusters[i].insert(i);
+      throw ClusterFunctor::InsufficientInput(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Distances to start from only contain one element");
     }
-    for (Size cluster_step = 0; cluster_step < cluster_tree.size(); ++cluster_step)
+    for (const PairDistance& pair : distances)
     {
-      Size new_left_child = *(clusters[cluster_tree[cluster_step].left_child].begin());
-      Size new_right_child = *(clusters[cluster_tree[cluster_step].right_child].begin());
-      clusters[cluster_tree[cluster_step].left_child].insert(clusters[cluster_tree[cluster_step].right_child].begin(), clusters[cluster_tree[cluster_step].right_child].end());
-      clusters.erase(clusters.begin() + cluster_tree[cluster_step].right_child);
-      std::swap(cluster_tree[cluster_step].left_child, new_left_child);
-      std::swap(cluster_tree[cluster_step].right_child, new_right_child);
-      if (cluster_tree[cluster_step].left_child > cluster_tree[cluster_step].right_child)
+      if (pair.i >= n || pair.j >= n)
       {
-        std::swap(cluster_tree[cluster_step].left_child, cluster_tree[cluster_step].right_child);
+        throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, std::max(pair.i, pair.j), n);
       }
     }
-
+    startProgress(0, 1, "clustering data");
+    // Kruskal: single linkage merges are the edges of a minimum spanning tree, in ascending order
+    buildTree_(n, distances, cluster_tree, threshold);
     endProgress();
   }
 
@@ -15,6 +15,9 @@
 #include <OpenMS/MATH/StatisticFunctions.h>
 #include <OpenMS/ML/GRIDSEARCH/GridSearch.h>
 
+#include <OpenMS/MATH/MathFunctions.h>
+
+#include <cmath>
 #include <cstdlib>
 
 using namespace OpenMS;
@@ -30,6 +33,9 @@ SimpleSVM::SimpleSVM():
   defaults_.setValue("xval", 5, "Number of partitions for cross-validation (parameter optimization)");
   defaults_.setMinInt("xval", 1);
 
+  defaults_.setValue("xval_samples", 0, "Maximum number of observations to use for cross-validation (parameter optimization). If there are more, a random sample (stratified by class for classification) is used; the final model is still trained on all observations. Set to 0 to use all observations.");
+  defaults_.setMinInt("xval_samples", 0);
+
   String values = "-5,-3,-1,1,3,5,7,9,11,13,15";
   defaults_.setValue("log2_C", ListUtils::create<double>(values), "Values to try for the SVM parameter 'C' during parameter optimization. A value 'x' is used as 'C = 2^x'.");
 
@@ -43,7 +49,7 @@ SimpleSVM::SimpleSVM():
   defaults_.setValue("epsilon", 0.001, "Stopping criterion", advanced);
   defaults_.setMinFloat("epsilon", 0.0);
 
-  defaults_.setValue("cache_size", 100.0, "Size of the kernel cache (in MB)", 
+  defaults_.setValue("cache_size", 100.0, "Size of the kernel cache (in MB). During cross-validation, the kernel matrix of all observations is precomputed (and shared by all partitions and values of 'C'/'epsilon') if it fits into this size.",
                      advanced);
   defaults_.setMinFloat("cache_size", 1.0);
 
@@ -484,40 +490,71 @@ tuple<double, double, double> SimpleSVM::chooseBestParameters_(bool higher_bette
       log2_p_[std::get<2>(indexes)]);
 }
 
+void SimpleSVM::preparePartitions_(bool classification, vector<Size>& xval_obs, vector<vector<Size>>& partitions) const
+{
+  // group training observations by class label (all in one group for regression) in random order:
+  map<double, vector<Size>> groups;
+  for (Size i = 0; i < Size(data_.l); ++i)
+  {
+    groups[classification ? data_.y[i] : 0.0].push_back(i);
+  }
+  Math::RandomShuffler shuffler(0); // fixed seed for reproducible results
+  Size n_samples = param_.getValue("xval_samples");
+  if ((n_samples == 0) || (n_samples > Size(data_.l))) n_samples = data_.l;
+
+  xval_obs.clear();
+  partitions.assign(n_parts_, vector<Size>());
+  Size pos = 0;
+  for (auto& group : groups)
+  {
+    vector<Size>& members = group.second;
+    shuffler.portable_random_shuffle(members.begin(), members.end());
+    // keep class proportions when sampling, but at least one observation per partition:
+    Size n_keep = Size(std::round(double(members.size()) * double(n_samples) / double(data_.l)));
+    n_keep = std::min(members.size(), std::max(n_keep, n_parts_));
+    // assign to partitions in turns, continuing across groups (stratification):
+    for (Size i = 0; i < n_keep; ++i, ++pos)
+    {
+      xval_obs.push_back(members[i]);
+      partitions[pos % n_parts_].push_back(pos);
+    }
+  }
+}
+
 void SimpleSVM::optimizeParameters_(bool classification)
 {
   OPENMS_LOG_INFO << "Optimizing parameters." << endl;
-  auto perFoldClassificationAccuracy = [&](const auto& d, const auto& targets)->double {
+  auto classificationAccuracy = [&](const vector<double>& truth, const vector<double>& targets)->double {
     Size n_correct = 0;
-    for (Size i = 0; i < Size(d.l); ++i)
+    for (Size i = 0; i < truth.size(); ++i)
     {
-      if (targets[i] == d.y[i]) n_correct++;
+      if (targets[i] == truth[i]) n_correct++;
     }
-    const double ratio = n_correct / double(d.l);
+    const double ratio = n_correct / double(truth.size());
     return ratio;            
   };
 
-  [[maybe_unused]]auto perFoldRegressionRSquared = [&](const auto& d, const auto& targets)->double {
+  [[maybe_unused]]auto regressionRSquared = [&](const vector<double>& truth, const vector<double>& targets)->double {
 
     double targets_mean = Math::mean(std::begin(targets), std::end(targets)); // mean of truth y-values
 
     double u{}, v{u};
-    for (Size i = 0; i < Size(d.l); ++i)
+    for (Size i = 0; i < truth.size(); ++i)
     {
-      u += std::pow(targets[i] - d.y[i], 2.0);
+      u += std::pow(targets[i] - truth[i], 2.0);
       v += std::pow(targets[i] - targets_mean, 2.0);      
     }
     const double Rsquared = (v != 0.0) ? (1.0 - u/v) : -1.0;
     return Rsquared;
   };
 
-  auto perFoldRMSE = [&](const auto& d, const auto& targets)->double {
+  auto rootMeanSquaredError = [&](const vector<double>& truth, const vector<double>& targets)->double {
     double err{};
-    for (Size i = 0; i < Size(d.l); ++i)
+    for (Size i = 0; i < truth.size(); ++i)
     {
-      err += std::pow(targets[i] - d.y[i], 2.0);
+      err += std::pow(targets[i] - truth[i], 2.0);
     }
-    err /= (double)Size(d.l);
+    err /= (double)truth.size();
     err = std::sqrt(err);
     return err;
   };
@@ -540,34 +577,133 @@ void SimpleSVM::optimizeParameters_(bool classification)
 
   OPENMS_LOG_INFO << "Running cross-validation to find optimal parameters..." 
           << endl;
+
+  // the same (stratified) partitions are used for all parameter combinations:
+  vector<Size> xval_obs;
+  vector<vector<Size>> partitions;
+  preparePartitions_(classification, xval_obs, partitions);
+  const Size n_xval = xval_obs.size();
+  if (n_xval < Size(data_.l))
+  {
+    OPENMS_LOG_INFO << "Using a sample of " << n_xval << " observations for cross-validation." << endl;
+  }
+  vector<double> truth(n_xval);
+  for (Size i = 0; i < n_xval; ++i)
+  {
+    truth[i] = data_.y[xval_obs[i]];
+  }
+
+  // The kernel only depends on "gamma" (RBF) or on nothing at all (linear kernel). If the kernel matrix fits
+  // into the cache, precompute it and let LIBSVM look up kernel values for all partitions and values of "C"/"p":
+  const double matrix_mb = double(n_xval) * (double(n_xval + 2) * sizeof(svm_node) + double(n_xval) * sizeof(double)) / (1024.0 * 1024.0);
+  const bool precomputed = matrix_mb <= svm_params_.cache_size;
+  vector<double> products; // squared distances (RBF) or dot products (linear) between observations
+  vector<vector<svm_node>> kernel_rows;
+  if (precomputed)
+  {
+    OPENMS_LOG_DEBUG << "Precomputing kernel matrix (" << matrix_mb << " MB) for cross-validation." << endl;
+    products.resize(n_xval * n_xval);
+    #pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < SignedSize(n_xval); ++i)
+    {
+      for (Size j = Size(i); j < n_xval; ++j)
+      {
+        double value = 0.0;
+        // predictors are dense, so nodes with equal positions have equal indexes:
+        for (const svm_node* x = data_.x[xval_obs[i]], *y = data_.x[xval_obs[j]]; x->index != -1; ++x, ++y)
+        {
+          value += (svm_params_.kernel_type == RBF) ? (x->value - y->value) * (x->value - y->value) : x->value * y->value;
+        }
+        products[i * n_xval + j] = products[j * n_xval + i] = value;
+      }
+    }
+    kernel_rows.assign(n_xval, vector<svm_node>(n_xval + 2));
+  }
+
+  // training and test observations of each partition (LIBSVM format):
+  auto observation = [&](Size pos) -> svm_node* {
+    return precomputed ? &(kernel_rows[pos][0]) : data_.x[xval_obs[pos]];
+  };
+  vector<vector<svm_node*>> train_x(n_parts_);
+  vector<vector<double>> train_y(n_parts_);
+  vector<svm_problem> train_data(n_parts_);
+  for (Size part = 0; part < n_parts_; ++part)
+  {
+    for (Size other = 0; other < n_parts_; ++other)
+    {
+      if ((other == part) && (n_parts_ > 1)) continue; // with one partition, train and test on all data
+      for (Size pos : partitions[other])
+      {
+        train_x[part].push_back(observation(pos));
+        train_y[part].push_back(truth[pos]);
+      }
+    }
+    train_data[part].l = int(train_x[part].size());
+    train_data[part].x = train_x[part].data();
+    train_data[part].y = train_y[part].data();
+  }
+
   Size prog_counter = 0;
   ProgressLogger prog_log;
   prog_log.startProgress(1, log2_gamma_.size() * log2_C_.size() * log2_p_.size(), 
                         "testing parameters");
 
   const String& performance_type = classification ? "accuracy: " : "error: ";
+  const Size n_combinations = log2_C_.size() * log2_p_.size();
 
   // classification performance for different parameter pairs:
   // vary "C"s in inner loop to keep results for all "C"s in one vector:
 
   performance_.resize(log2_gamma_.size());
-  for (int g_index = 0; g_index < (int)log2_gamma_.size(); ++g_index)
+  for (Size g_index = 0; g_index < log2_gamma_.size(); ++g_index)
   {
-    svm_params_.gamma = pow(2.0, log2_gamma_[g_index]);
-    performance_[g_index].resize(log2_C_.size());
-    for (int c_index = 0; c_index < (int)log2_C_.size(); ++c_index)
+    svm_parameter params = svm_params_;
+    params.gamma = pow(2.0, log2_gamma_[g_index]);
+    if (precomputed)
     {
-      svm_params_.C = pow(2.0, log2_C_[c_index]);
-      performance_[g_index][c_index].resize(log2_p_.size());
-      for (int p_index = 0; p_index < (int)log2_p_.size(); ++p_index)
+      // row format for precomputed kernels: serial number (from 1), kernel values, sentinel
+      #pragma omp parallel for
+      for (SignedSize i = 0; i < SignedSize(n_xval); ++i)
       {
-        svm_params_.p = pow(2.0, log2_p_[p_index]);
-
-        double* targets = (double *)malloc(sizeof(double) * data_.l);
-        svm_cross_validation(&data_, &svm_params_, n_parts_, &(targets[0]));
+        vector<svm_node>& row = kernel_rows[i];
+        row[0] = {0, double(i + 1)};
+        for (Size j = 0; j < n_xval; ++j)
+        {
+          double product = products[i * n_xval + j];
+          row[j + 1] = {int(j + 1), (params.kernel_type == RBF) ? exp(-params.gamma * product) : product};
+        }
+        row[n_xval + 1] = {-1, 0.0};
+      }
+      params.kernel_type = PRECOMPUTED;
+    }
 
-        double acc = classification ? perFoldClassificationAccuracy(data_, targets) : perFoldRMSE(data_, targets);
+    // predictions for all combinations of "C" and "p", trained on all partitions in parallel
+    // (training is independent and LIBSVM does not use random numbers without probability estimates):
+    vector<vector<double>> targets(n_combinations, vector<double>(n_xval));
+    #pragma omp parallel for schedule(dynamic)
+    for (SignedSize task = 0; task < SignedSize(n_combinations * n_parts_); ++task)
+    {
+      const Size combination = Size(task) / n_parts_;
+      const Size part = Size(task) % n_parts_;
+      svm_parameter task_params = params;
+      task_params.C = pow(2.0, log2_C_[combination / log2_p_.size()]);
+      task_params.p = pow(2.0, log2_p_[combination % log2_p_.size()]);
+      svm_model* model = svm_train(&train_data[part], &task_params);
+      for (Size pos : partitions[part])
+      {
+        targets[combination][pos] = svm_predict(model, observation(pos));
+      }
+      svm_free_and_destroy_model(&model);
+    }
 
+    performance_[g_index].resize(log2_C_.size());
+    for (Size c_index = 0; c_index < log2_C_.size(); ++c_index)
+    {
+      performance_[g_index][c_index].resize(log2_p_.size());
+      for (Size p_index = 0; p_index < log2_p_.size(); ++p_index)
+      {
+        const vector<double>& predicted = targets[c_index * log2_p_.size() + p_index];
+        double acc = classification ? classificationAccuracy(truth, predicted) : rootMeanSquaredError(truth, predicted);
         performance_[g_index][c_index][p_index] = acc;
         prog_log.setProgress(++prog_counter);
 
@@ -575,7 +711,6 @@ void SimpleSVM::optimizeParameters_(bool classification)
             << ", log2_gamma = " << log2_gamma_[g_index] << ") " 
             << ", log2_p = " << log2_p_[p_index] << ") "
             << performance_type << acc << endl;
-        free(targets);
       }
     }
   }
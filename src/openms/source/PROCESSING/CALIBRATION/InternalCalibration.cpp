@@ -19,9 +19,32 @@
 #include <QtCore/QStringList>
 
 #include <cstdio>
+#include <exception>
+#include <sstream>
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// A calibration point (see CalibrationData::insertCalibrationPoint())
+    struct CalibrationPoint
+    {
+      double rt;
+      double mz_obs;
+      double intensity;
+      double mz_ref;
+      double weight;
+      int group;
+    };
+
+    /// Lock masses found (and not found) in one spectrum
+    struct LockMassMatches
+    {
+      std::vector<CalibrationPoint> found;
+      std::vector<CalibrationPoint> failed;
+      String log; ///< verbose messages
+    };
+  }
 
   InternalCalibration::InternalCalibration()
     : ProgressLogger()
@@ -68,9 +91,10 @@ namespace OpenMS
 
   void InternalCalibration::applyTransformation(PeakMap& exp, const IntList& target_mslvl, const MZTrafoModel& trafo)
   {
-    for (PeakMap::Iterator it = exp.begin(); it != exp.end(); ++it)
+#pragma omp parallel for schedule(dynamic, 100)
+    for (SignedSize i = 0; i < (SignedSize)exp.size(); ++i)
     {
-      applyTransformation(*it, target_mslvl, trafo);
+      applyTransformation(exp[i], target_mslvl, trafo);
     }
   }
 
@@ -87,28 +111,27 @@ namespace OpenMS
     //
     // find lock masses in data and build calibrant table
     //
-    std::map<Size, Size> stats_cal_per_spectrum;
-    typedef PeakMap::ConstIterator ExpCIt;
-    for (ExpCIt it = exp.begin(); it != exp.end(); ++it)
+    // search the lock masses in all spectra (in parallel) ...
+    std::vector<LockMassMatches> matches(exp.size());
+#pragma omp parallel for schedule(dynamic, 100)
+    for (SignedSize i = 0; i < (SignedSize)exp.size(); ++i)
     {
-      // empty spectrum
-      if (it->empty()) {
-        ++stats_cal_per_spectrum[0];
-        continue;
-      }
+      const MSSpectrum& spec = exp[i];
+      if (spec.empty()) continue;
 
-      Size cnt_cd = cal_data_.size();
+      LockMassMatches& match = matches[i];
       // iterate over calibrants
       for (std::vector<InternalCalibration::LockMass>::const_iterator itl = ref_masses.begin(); itl != ref_masses.end(); ++itl)
       {
         // calibrant meant for this MS level?
-        if (it->getMSLevel() != itl->ms_level) continue;
+        if (spec.getMSLevel() != itl->ms_level) continue;
 
-        Size s = it->findNearest(itl->mz);
-        const double mz_obs = (*it)[s].getMZ();
+        const int group = std::distance(ref_masses.begin(), itl);
+        Size s = spec.findNearest(itl->mz);
+        const double mz_obs = spec[s].getMZ();
         if (Math::getPPMAbs(mz_obs, itl->mz) > tol_ppm)
         {
-          failed_lock_masses.insertCalibrationPoint(it->getRT(), itl->mz, 0.0, itl->mz, 0.0, std::distance(ref_masses.begin(), itl));
+          match.failed.push_back({spec.getRT(), itl->mz, 0.0, itl->mz, 0.0, group});
         }
         else
         {
@@ -116,14 +139,16 @@ namespace OpenMS
           {
             // check if its the monoisotopic .. discard otherwise
             const double mz_iso_left = mz_obs - (Constants::C13C12_MASSDIFF_U / itl->charge);
-            Size s_left = it->findNearest(mz_iso_left);
-            if (Math::getPPMAbs(mz_iso_left, (*it)[s_left].getMZ()) < 0.5) // intra-scan ppm should be very good!
+            Size s_left = spec.findNearest(mz_iso_left);
+            if (Math::getPPMAbs(mz_iso_left, spec[s_left].getMZ()) < 0.5) // intra-scan ppm should be very good!
             { // peak nearby lock mass was not the monoisotopic
               if (verbose)
               {
-                OPENMS_LOG_INFO << "peak at [RT, m/z] " << it->getRT() << ", " << (*it)[s].getMZ() << " is NOT monoisotopic. Skipping it!\n";
+                std::ostringstream msg;
+                msg << "peak at [RT, m/z] " << spec.getRT() << ", " << spec[s].getMZ() << " is NOT monoisotopic. Skipping it!\n";
+                match.log += msg.str();
               }
-              failed_lock_masses.insertCalibrationPoint(it->getRT(), itl->mz, 1.0, itl->mz, 0.0, std::distance(ref_masses.begin(), itl));
+              match.failed.push_back({spec.getRT(), itl->mz, 1.0, itl->mz, 0.0, group});
               continue;
             }
           }
@@ -131,22 +156,48 @@ namespace OpenMS
           {
             // require it to have a +1 isotope?!
             const double mz_iso_right = mz_obs + Constants::C13C12_MASSDIFF_U / itl->charge;
-            Size s_right = it->findNearest(mz_iso_right);
-            if (!(Math::getPPMAbs(mz_iso_right, (*it)[s_right].getMZ()) < 0.5)) // intra-scan ppm should be very good!
+            Size s_right = spec.findNearest(mz_iso_right);
+            if (!(Math::getPPMAbs(mz_iso_right, spec[s_right].getMZ()) < 0.5)) // intra-scan ppm should be very good!
             { // peak has no +1iso.. weird
               if (verbose)
               {
-                OPENMS_LOG_INFO << "peak at [RT, m/z] " << it->getRT() << ", " << (*it)[s].getMZ() << " has no +1 isotope (ppm to closest: " << Math::getPPM(mz_iso_right, (*it)[s_right].getMZ()) << ")... Skipping it!\n";
+                std::ostringstream msg;
+                msg << "peak at [RT, m/z] " << spec.getRT() << ", " << spec[s].getMZ() << " has no +1 isotope (ppm to closest: " << Math::getPPM(mz_iso_right, spec[s_right].getMZ()) << ")... Skipping it!\n";
+                match.log += msg.str();
               }
-              failed_lock_masses.insertCalibrationPoint(it->getRT(), itl->mz, 2.0, itl->mz, 0.0, std::distance(ref_masses.begin(), itl));
+              match.failed.push_back({spec.getRT(), itl->mz, 2.0, itl->mz, 0.0, group});
               continue;
             }
           }
-          cal_data_.insertCalibrationPoint(it->getRT(), mz_obs, (*it)[s].getIntensity(), itl->mz, std::log((*it)[s].getIntensity()), std::distance(ref_masses.begin(), itl));
+          match.found.push_back({spec.getRT(), mz_obs, spec[s].getIntensity(), itl->mz, std::log(spec[s].getIntensity()), group});
         }
       }
+    }
+
+    // ... and build the calibrant table in spectrum order
+    std::map<Size, Size> stats_cal_per_spectrum;
+    for (Size i = 0; i < exp.size(); ++i)
+    {
+      // empty spectrum
+      if (exp[i].empty()) {
+        ++stats_cal_per_spectrum[0];
+        continue;
+      }
+      const LockMassMatches& match = matches[i];
+      if (!match.log.empty())
+      {
+        OPENMS_LOG_INFO << match.log;
+      }
+      for (const CalibrationPoint& p : match.failed)
+      {
+        failed_lock_masses.insertCalibrationPoint(p.rt, p.mz_obs, p.intensity, p.mz_ref, p.weight, p.group);
+      }
+      for (const CalibrationPoint& p : match.found)
+      {
+        cal_data_.insertCalibrationPoint(p.rt, p.mz_obs, p.intensity, p.mz_ref, p.weight, p.group);
+      }
       // how many locks found in this spectrum?!
-      ++stats_cal_per_spectrum[cal_data_.size()-cnt_cd];
+      ++stats_cal_per_spectrum[match.found.size()];
     }
 
     OPENMS_LOG_INFO << "Lock masses found across viable spectra:\n";
@@ -275,6 +326,11 @@ namespace OpenMS
     return cal_data_;
   }
 
+  const std::map<String, MZTrafoModel>& InternalCalibration::getSpectrumModels() const
+  {
+    return spectrum_models_;
+  }
+
   bool InternalCalibration::calibrate(PeakMap& exp, 
                                       const IntList& target_mslvl,
                                       MZTrafoModel::MODELTYPE model_type,
@@ -297,6 +353,7 @@ namespace OpenMS
     }
 
     startProgress(0, exp.size(), "Applying calibration to data");
+    spectrum_models_.clear();
 
     std::vector<MZTrafoModel> tms; // each spectrum gets its own model (params are cheap to store)
     std::map<Size, Size> invalid_models; // indices from tms[] -> exp[]; where model creation failed (e..g, not enough calibration points)
@@ -310,40 +367,79 @@ namespace OpenMS
       if (MZTrafoModel::isValidModel(tms[0]))
       {
         applyTransformation(exp, target_mslvl, tms[0]);
+        for (const MSSpectrum& spec : exp)
+        {
+          if (ListUtils::contains(target_mslvl, spec.getMSLevel()) || ListUtils::contains(target_mslvl, spec.getMSLevel() - 1))
+          {
+            spectrum_models_[spec.getNativeID()] = tms[0];
+          }
+        }
         hasValidModels = true;
       }
     }
     else
     { // one model per spectrum (not all might be needed, if certain MS levels are excluded from calibration)
-      tms.reserve(exp.size());
-      // go through spectra and calibrate
-      Size i(0), i_mslvl(0);
-      for (PeakMap::Iterator it = exp.begin(); it != exp.end(); ++it, ++i)
+      // model index of each spectrum to calibrate (-1 for others)
+      std::vector<SignedSize> model_index(exp.size(), -1);
+      Size n_models(0);
+      for (Size i = 0; i < exp.size(); ++i)
       {
-        setProgress(i);
-
         // skip this MS level?
-        if (!(ListUtils::contains(target_mslvl, it->getMSLevel()) ||     // scan m/z needs correction
-              ListUtils::contains(target_mslvl, it->getMSLevel() - 1)))  // precursor m/z needs correction
+        if (!(ListUtils::contains(target_mslvl, exp[i].getMSLevel()) ||     // scan m/z needs correction
+              ListUtils::contains(target_mslvl, exp[i].getMSLevel() - 1)))  // precursor m/z needs correction
         {
           continue;
         }
+        model_index[i] = n_models++;
+      }
+      tms.resize(n_models);
+
+      // go through spectra and calibrate (the models are independent of each other)
+      Size progress(0);
+      std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)exp.size(); ++i)
+      {
+#pragma omp critical (progress)
+        setProgress(progress++);
+
+        if (model_index[i] < 0) continue;
+
+        try
+        {
+          //
+          // build model
+          //
+          MZTrafoModel& tm = tms[model_index[i]];
+          tm.train(cal_data_, model_type, use_RANSAC, exp[i].getRT() - rt_chunk, exp[i].getRT() + rt_chunk);
+          if (MZTrafoModel::isValidModel(tm)) // model trained and coefficients are not too extreme
+          {
+            applyTransformation(exp[i], target_mslvl, tm);
+          }
+        }
+        catch (...)
+        {
+#pragma omp critical (InternalCalibration_calibrate)
+          if (!error) error = std::current_exception();
+        }
+      }
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
 
-        //
-        // build model
-        //
-        tms.emplace_back();
-        tms.back().train(cal_data_, model_type, use_RANSAC, it->getRT() - rt_chunk, it->getRT() + rt_chunk);
-        if (!MZTrafoModel::isValidModel(tms.back())) // model not trained or coefficients are too extreme
+      for (Size i = 0; i < exp.size(); ++i)
+      {
+        if (model_index[i] < 0) continue;
+        if (!MZTrafoModel::isValidModel(tms[model_index[i]]))
         {
-          invalid_models[i_mslvl] = i;
+          invalid_models[model_index[i]] = i;
         }
         else
         {
-          applyTransformation(*it, target_mslvl, tms.back());
+          spectrum_models_[exp[i].getNativeID()] = tms[model_index[i]];
         }
-        ++i_mslvl;
-      } // MSExp::iter
+      }
 
       //////////////////////////////////////////////////////////////////////////
       // CHECK Models -- use neighbors if needed
@@ -386,6 +482,7 @@ namespace OpenMS
             model_index = p + dist_right;
           }
           applyTransformation(exp[it->second], target_mslvl, tms[model_index]);
+          spectrum_models_[exp[it->second].getNativeID()] = tms[model_index];
           tms_new[p].setCoefficients(tms[model_index]); // overwrite invalid model
         }
         tms_new.swap(tms);
@@ -13,14 +13,117 @@
 #include <OpenMS/METADATA/Precursor.h>
 #include <OpenMS/CONCEPT/LogStream.h>
 
+#include <algorithm>
+#include <exception>
 #include <iomanip>
 #include <fstream>
+#include <map>
+#include <numeric>
 
 using namespace std;
 using namespace OpenMS;
 
 namespace OpenMS
 {
+  namespace
+  {
+    /// For each spectrum, the index of its precursor spectrum as returned by MSExperiment::getPrecursorSpectrum (exp.size() if there is none), determined in a single pass
+    vector<Size> precursorSpectrumIndices(const MSExperiment& exp)
+    {
+      vector<Size> parent(exp.size(), exp.size());
+      map<UInt, Size> last_of_level; // most recent spectrum per MS level
+      map<pair<UInt, String>, Size> last_of_native_id; // most recent spectrum per MS level and native ID
+      for (Size i = 0; i != exp.size(); ++i)
+      {
+        const UInt ms_level = exp[i].getMSLevel();
+        if (ms_level != 1)
+        {
+          bool found = false;
+          const vector<Precursor>& pcs = exp[i].getPrecursors();
+          if (!pcs.empty() && pcs[0].metaValueExists("spectrum_ref"))
+          {
+            auto ref_it = last_of_native_id.find(make_pair(ms_level - 1, String(pcs[0].getMetaValue("spectrum_ref"))));
+            if (ref_it != last_of_native_id.end())
+            {
+              parent[i] = ref_it->second;
+              found = true;
+            }
+          }
+          if (!found)
+          {
+            auto level_it = last_of_level.find(ms_level - 1);
+            if (level_it != last_of_level.end())
+            {
+              parent[i] = level_it->second;
+            }
+          }
+        }
+        last_of_level[ms_level] = i;
+        last_of_native_id[make_pair(ms_level, exp[i].getNativeID())] = i;
+      }
+      return parent;
+    }
+
+    /// Bounding box of the convex hull of @p feature, extended as in PrecursorCorrection::overlaps_
+    DBoundingBox<2> extendedBoundingBox(const Feature& feature, double rt_tolerance)
+    {
+      DBoundingBox<2> box = feature.getConvexHull().getBoundingBox();
+      DPosition<2> extend_rt(rt_tolerance, 0.01);
+      box.setMin(box.minPosition() - extend_rt);
+      box.setMax(box.maxPosition() + extend_rt);
+      return box;
+    }
+
+    /**
+      @brief Locates the MS2 spectrum of each precursor and its MS1 precursor spectrum (in parallel)
+
+      @p ms1_index is exp.size() for precursors without an MS1 spectrum. @p find_peak is called for the others
+      and its results are stored in @p peak_index.
+    */
+    template <typename PeakFinder>
+    void findPrecursorPeaks(const MSExperiment& exp,
+                            const vector<Precursor>& precursors,
+                            const vector<double>& precursors_rt,
+                            vector<Size>& scan_index,
+                            vector<Size>& ms1_index,
+                            vector<Int>& peak_index,
+                            PeakFinder find_peak)
+    {
+      const vector<Size> parent = precursorSpectrumIndices(exp);
+      scan_index.assign(precursors_rt.size(), 0);
+      ms1_index.assign(precursors_rt.size(), exp.size());
+      peak_index.assign(precursors_rt.size(), -1);
+
+      std::exception_ptr err;
+#pragma omp parallel for schedule(dynamic, 100)
+      for (SignedSize i = 0; i < (SignedSize)precursors_rt.size(); ++i)
+      {
+        try
+        {
+          // MS2 spectrum (first spectrum at the precursor RT) and its parent
+          const Size scan = exp.RTBegin(precursors_rt[i] - 1e-8) - exp.begin();
+          scan_index[i] = scan;
+          if (scan == exp.size())
+          {
+            continue;
+          }
+          const Size ms1 = parent[scan];
+          if (ms1 == exp.size() || exp[ms1].getMSLevel() != 1)
+          {
+            continue;
+          }
+          ms1_index[i] = ms1;
+          peak_index[i] = find_peak(exp[ms1], precursors[i].getMZ());
+        }
+        catch (...)
+        {
+#pragma omp critical (PrecursorCorrection_findPrecursorPeaks)
+          if (!err) err = std::current_exception();
+        }
+      }
+      if (err) std::rethrow_exception(err);
+    }
+  }
 
    const std::string PrecursorCorrection::csv_header = "RT,uncorrectedMZ,correctedMZ,deltaMZ";
 
@@ -79,6 +182,12 @@ namespace OpenMS
       vector<Size> precursor_scan_index;
       getPrecursors(exp, precursors, precursors_rt, precursor_scan_index);
 
+      // find peak (index) closest to expected position in the MS1 spectrum of each precursor
+      vector<Size> scan_index, ms1_index;
+      vector<Int> peak_index;
+      findPrecursorPeaks(exp, precursors, precursors_rt, scan_index, ms1_index, peak_index,
+                         [](const MSSpectrum& ms1, double mz) { return (Int)ms1.findNearest(mz); });
+
       for (Size i = 0; i != precursors_rt.size(); ++i)
       {
         // get precursor rt
@@ -87,31 +196,17 @@ namespace OpenMS
         // get precursor MZ
         double mz = precursors[i].getMZ();
 
-        //cout << rt << " " << mz << endl;
-
-        // get precursor spectrum
-        MSExperiment::ConstIterator rt_it = exp.RTBegin(rt - 1e-8);
-
         // store index of MS2 spectrum
-        UInt precursor_spectrum_idx = rt_it - exp.begin();
-
-        // get parent (MS1) of precursor spectrum
-        rt_it = exp.getPrecursorSpectrum(rt_it);
+        UInt precursor_spectrum_idx = scan_index[i];
 
-        if (rt_it == exp.end() 
-        || rt_it->getMSLevel() != 1)
+        if (ms1_index[i] == exp.size())
         {
           OPENMS_LOG_WARN << "Warning: no MS1 spectrum for this precursor" << endl;
           continue;          
         }
 
-        //cout << rt_it->getRT() << " " << rt_it->size() << endl;
-
-        // find peak (index) closest to expected position
-        Size nearest_peak_idx = rt_it->findNearest(mz);
-
         // get actual position of closest peak
-        double nearest_peak_mz = (*rt_it)[nearest_peak_idx].getMZ();
+        double nearest_peak_mz = exp[ms1_index[i]][peak_index[i]].getMZ();
 
         // calculate error between expected and actual position
         double nearestPeakError = ppm ? abs(nearest_peak_mz - mz)/mz * 1e6 : abs(nearest_peak_mz - mz);
@@ -156,30 +251,32 @@ namespace OpenMS
       getPrecursors(exp, precursors, precursors_rt, precursor_scan_index);
       int count_error_highest_intenstiy = 0;
 
+      // get tolerance window and index of highest peak in the MS1 spectrum of each precursor
+      vector<Size> scan_index, ms1_index;
+      vector<Int> peak_index;
+      findPrecursorPeaks(exp, precursors, precursors_rt, scan_index, ms1_index, peak_index,
+                         [mz_tolerance, ppm](const MSSpectrum& ms1, double mz)
+                         {
+                           std::pair<double,double> tolerance_window = Math::getTolWindow(mz, mz_tolerance, ppm);
+                           return ms1.findHighestInWindow(mz, mz-tolerance_window.first, tolerance_window.second-mz);
+                         });
+
       for (Size i = 0; i != precursors_rt.size(); ++i)
       {
         double rt = precursors_rt[i]; // get precursor rt        
         double mz = precursors[i].getMZ(); // get precursor MZ
 
-        // retrieves iterator of the MS2 fragment spectrum
-        MSExperiment::ConstIterator rt_it = exp.RTBegin(rt - 1e-8);
-
         // store index of MS2 spectrum
-        UInt precursor_spectrum_idx = rt_it - exp.begin();
-
-        // get parent (MS1) of precursor spectrum
-        rt_it = exp.getPrecursorSpectrum(rt_it);
+        UInt precursor_spectrum_idx = scan_index[i];
 
-        if (rt_it == exp.end() 
-        || rt_it->getMSLevel() != 1)
+        if (ms1_index[i] == exp.size())
         {
           OPENMS_LOG_WARN << "Warning: no MS1 spectrum for this precursor" << endl;
           continue;
         }
 
-        // get tolerance window and index of highest peak
-        std::pair<double,double> tolerance_window = Math::getTolWindow(mz, mz_tolerance, ppm);
-        int highest_peak_idx = rt_it->findHighestInWindow(mz, mz-tolerance_window.first, tolerance_window.second-mz);
+        int highest_peak_idx = peak_index[i];
+        const MSSpectrum& ms1 = exp[ms1_index[i]];
 
         // no MS1 precursor peak in +- tolerance window found
         if (highest_peak_idx == -1)
@@ -189,8 +286,8 @@ namespace OpenMS
         }
 
         // get actual position and intensity of highest intensity peak
-        double highest_peak_mz = (*rt_it)[highest_peak_idx].getMZ();
-        double highest_peak_int = (*rt_it)[highest_peak_idx].getIntensity();
+        double highest_peak_mz = ms1[highest_peak_idx].getMZ();
+        double highest_peak_int = ms1[highest_peak_idx].getIntensity();
 
         // cout << mz << " -> " << nearest_peak_mz << endl;
         double delta_mz = highest_peak_mz - mz;
@@ -232,7 +329,36 @@ namespace OpenMS
       // if believe_charge is set, only add features that match the precursor charge
       map<Size, set<Size> > scan_idx_to_feature_idx;
 
-      for (Size scan = 0; scan != exp.size(); ++scan)
+      // index of the (extended) feature bounding boxes, ordered by their lower m/z bound.
+      // Note: computed up front as Feature::getConvexHull() updates a cache and is not thread safe
+      vector<DBoundingBox<2> > boxes;
+      boxes.reserve(features.size());
+      double max_mz_width = 0.0;
+      bool missing_hull = false;
+      for (const Feature& feature : features)
+      {
+        missing_hull |= feature.getConvexHulls().empty();
+        boxes.push_back(extendedBoundingBox(feature, rt_tolerance_s));
+        max_mz_width = std::max(max_mz_width, boxes.back().maxY() - boxes.back().minY());
+      }
+      if (missing_hull)
+      {
+        OPENMS_LOG_WARN << "HighResPrecursorMassCorrector warning: at least one feature has no convex hull - omitting feature for matching" << std::endl;
+      }
+      vector<Size> by_min_mz(features.size());
+      std::iota(by_min_mz.begin(), by_min_mz.end(), 0);
+      std::sort(by_min_mz.begin(), by_min_mz.end(), [&boxes](Size a, Size b) { return boxes[a].minY() < boxes[b].minY(); });
+      vector<double> min_mz(features.size());
+      for (Size k = 0; k != by_min_mz.size(); ++k)
+      {
+        min_mz[k] = boxes[by_min_mz[k]].minY();
+      }
+
+      // for each precursor/MS2 collect the overlapping features (ordered by index) and retain the compatible ones:
+      // if precursor_mz = feature_mz + n * feature_charge (+/- mz_tolerance) a feature is compatible
+      vector<vector<Size> > compatible_features(exp.size());
+#pragma omp parallel for schedule(dynamic, 100)
+      for (SignedSize scan = 0; scan < (SignedSize)exp.size(); ++scan)
       {
         // skip non-tandem mass spectra
         if (exp[scan].getMSLevel() != 2 || exp[scan].getPrecursors().empty()) continue;
@@ -241,55 +367,35 @@ namespace OpenMS
         const double pc_mz = exp[scan].getPrecursors()[0].getMZ();
         const double rt = exp[scan].getRT();
         const int pc_charge = exp[scan].getPrecursors()[0].getCharge();
+        const double mz_tolerance_da = ppm ? pc_mz * mz_tolerance * 1e-6  : mz_tolerance;
 
-        for (Size f = 0; f != features.size(); ++f)
+        // only boxes starting in [pc_mz - max_mz_width, pc_mz] can enclose the precursor (small margin for rounding)
+        vector<double>::const_iterator first = std::lower_bound(min_mz.begin(), min_mz.end(), pc_mz - max_mz_width - 1e-6);
+        vector<double>::const_iterator last = std::upper_bound(first, min_mz.cend(), pc_mz);
+        vector<Size>& candidates = compatible_features[scan];
+        for (vector<double>::const_iterator it = first; it != last; ++it)
         {
+          const Size f = by_min_mz[it - min_mz.begin()];
           // feature  is incompatible if believe_charge is set and charges don't match
           if (believe_charge && features[f].getCharge() != pc_charge)
           {
             continue;
           }
           // check if precursor/MS2 position overlap with feature
-          if (overlaps_(features[f], rt, pc_mz, rt_tolerance_s))
+          if (boxes[f].encloses(DPosition<2>(rt, pc_mz)) && compatible_(features[f], pc_mz, mz_tolerance_da, max_trace))
           {
-            scan_idx_to_feature_idx[scan].insert(f);
+            candidates.push_back(f);
           }
         }
+        std::sort(candidates.begin(), candidates.end());
       }
 
-      // filter sets to retain compatible features:
-      // if precursor_mz = feature_mz + n * feature_charge (+/- mz_tolerance) a feature is compatible, others are removed from the set
-      for (map<Size, set<Size> >::iterator it = scan_idx_to_feature_idx.begin(); it != scan_idx_to_feature_idx.end(); ++it)
-      {
-        const Size scan = it->first;
-        const double pc_mz = exp[scan].getPrecursors()[0].getMZ();
-        const double mz_tolerance_da = ppm ? pc_mz * mz_tolerance * 1e-6  : mz_tolerance;
-
-        // Note: This is the "delete while iterating" pattern so mind the pre- and postincrement
-        for (set<Size>::iterator sit = it->second.begin(); sit != it->second.end(); )
-        {
-          if (!compatible_(features[*sit], pc_mz, mz_tolerance_da, max_trace))
-          {
-            it->second.erase(sit++);
-          }
-          else
-          {
-            ++sit;
-          }
-        }
-      }
-
-      // remove entries with no compatible features (empty sets).
-      // Note: This is the "delete while iterating" pattern so mind the pre- and postincrement
-      for (map<Size, set<Size> >::iterator it = scan_idx_to_feature_idx.begin(); it != scan_idx_to_feature_idx.end(); )
+      // keep entries with compatible features only
+      for (Size scan = 0; scan != exp.size(); ++scan)
       {
-        if (it->second.empty())
-        {
-          scan_idx_to_feature_idx.erase(it++);
-        }
-        else
+        if (!compatible_features[scan].empty())
         {
-          ++it;
+          scan_idx_to_feature_idx[scan].insert(compatible_features[scan].begin(), compatible_features[scan].end());
         }
       }
 
@@ -379,10 +485,7 @@ namespace OpenMS
       }
 
       // get bounding box and extend by retention time tolerance
-      DBoundingBox<2> box = feature.getConvexHull().getBoundingBox();
-      DPosition<2> extend_rt(rt_tolerance, 0.01);
-      box.setMin(box.minPosition() - extend_rt);
-      box.setMax(box.maxPosition() + extend_rt);
+      DBoundingBox<2> box = extendedBoundingBox(feature, rt_tolerance);
 
       DPosition<2> pc_pos(rt, pc_mz);
       if (box.encloses(pc_pos))
@@ -10,12 +10,16 @@
 #include <OpenMS/PROCESSING/CENTROIDING/PeakPickerHiRes.h>
 
 #include <OpenMS/PROCESSING/NOISEESTIMATION/SignalToNoiseEstimatorMedian.h>
+#include <OpenMS/KERNEL/ColumnarSpectrum.h>
 #include <OpenMS/KERNEL/OnDiscMSExperiment.h>
+#include <OpenMS/KERNEL/OnDiscSpectrumPrefetcher.h>
 #include <OpenMS/KERNEL/MSChromatogram.h>
 #include <OpenMS/MATH/MISC/SplineBisection.h>
 #include <OpenMS/MATH/MISC/CubicSpline2d.h>
 #include <OpenMS/KERNEL/SpectrumHelper.h>
 
+#include <exception>
+
 
 using namespace std;
 
@@ -96,6 +100,20 @@ namespace OpenMS
     pick_(input, output, boundaries, check_spacings);
   }
 
+  void PeakPickerHiRes::pick(const ColumnarSpectrum& input, ColumnarSpectrum& output) const
+  {
+    std::vector<PeakBoundary> boundaries;
+    pick(input, output, boundaries);
+  }
+
+  void PeakPickerHiRes::pick(const ColumnarSpectrum& input, ColumnarSpectrum& output, std::vector<PeakBoundary>& boundaries) const
+  {
+    MSSpectrum profile, picked;
+    input.toMSSpectrum(profile);
+    pick(profile, picked, boundaries);
+    output.assign(picked);
+  }
+
   template <typename ContainerType>
   void PeakPickerHiRes::pick_(const ContainerType& input,
                               ContainerType& output,
@@ -447,17 +465,22 @@ namespace OpenMS
     // resize output with respect to input
     output.resize(input.size());
 
-    Size progress = 0;
     startProgress(0, input.size() + input.getChromatograms().size(), "picking peaks");
 
     // MSLevel -> stats
     map<int, SpectraPickInfo> pick_info;
 
-    if (input.getNrSpectra() > 0)
+    // spectra (and chromatograms) are picked in parallel; the boundaries are
+    // collected per spectrum and appended in order afterwards
+    std::vector<char> was_picked(input.size(), false);
+    std::vector<std::vector<PeakBoundary> > boundaries_s(input.size()); // peak boundaries of each spectrum
+    std::exception_ptr error;
+    SignedSize error_idx = std::numeric_limits<SignedSize>::max();
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize scan_idx = 0; scan_idx < (SignedSize)input.size(); ++scan_idx)
     {
-      for (Size scan_idx = 0; scan_idx != input.size(); ++scan_idx)
+      try
       {
-        bool was_picked{false};
         // auto mode
         if (ms_levels_.empty()) 
         {
@@ -468,10 +491,8 @@ namespace OpenMS
           }
           else
           {
-            std::vector<PeakBoundary> boundaries_s; // peak boundaries of a single spectrum
-            pick(input[scan_idx], output[scan_idx], boundaries_s);
-            was_picked = true;
-            boundaries_spec.push_back(std::move(boundaries_s));
+            pick(input[scan_idx], output[scan_idx], boundaries_s[scan_idx]);
+            was_picked[scan_idx] = true;
           }
         }
         // manual mode
@@ -481,32 +502,57 @@ namespace OpenMS
         }
         else
         {
-          std::vector<PeakBoundary> boundaries_s; // peak boundaries of a single spectrum
           SpectrumSettings::SpectrumType spectrum_type = input[scan_idx].getType(true); // uses meta-info and inspects data if needed
           if (spectrum_type == SpectrumSettings::CENTROID && check_spectrum_type)
           {
             throw OpenMS::Exception::IllegalArgument(__FILE__, __LINE__, __FUNCTION__, "Error: Centroided data provided but profile spectra expected.");
           }
 
-          pick(input[scan_idx], output[scan_idx], boundaries_s);
-          was_picked = true;
-          boundaries_spec.push_back(std::move(boundaries_s));
+          pick(input[scan_idx], output[scan_idx], boundaries_s[scan_idx]);
+          was_picked[scan_idx] = true;
         }
-        pick_info[input[scan_idx].getMSLevel()].picked += was_picked;
-        ++pick_info[input[scan_idx].getMSLevel()].total;
-        setProgress(++progress);
       }
+      catch (...)
+      {
+#pragma omp critical (PeakPickerHiRes_pickExperiment)
+        {
+          // report the error of the first spectrum (as a sequential run would)
+          if (scan_idx < error_idx)
+          {
+            error_idx = scan_idx;
+            error = std::current_exception();
+          }
+        }
+      }
+      nextProgress();
+    }
+    if (error)
+    {
+      std::rethrow_exception(error);
     }
 
+    for (Size scan_idx = 0; scan_idx < input.size(); ++scan_idx)
+    {
+      if (was_picked[scan_idx])
+      {
+        boundaries_spec.push_back(std::move(boundaries_s[scan_idx]));
+      }
+      pick_info[input[scan_idx].getMSLevel()].picked += was_picked[scan_idx];
+      ++pick_info[input[scan_idx].getMSLevel()].total;
+    }
 
-    for (Size i = 0; i < input.getChromatograms().size(); ++i)
+    std::vector<MSChromatogram> chromatograms(input.getChromatograms().size());
+    std::vector<std::vector<PeakBoundary> > boundaries_c(chromatograms.size()); // peak boundaries of each chromatogram
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < (SignedSize)chromatograms.size(); ++i)
     {
-      MSChromatogram chromatogram;
-      std::vector<PeakBoundary> boundaries_c; // peak boundaries of a single chromatogram
-      pick(input.getChromatograms()[i], chromatogram, boundaries_c);
-      output.addChromatogram(chromatogram);
-      boundaries_chrom.push_back(boundaries_c);
-      setProgress(++progress);
+      pick(input.getChromatograms()[i], chromatograms[i], boundaries_c[i]);
+      nextProgress();
+    }
+    for (Size i = 0; i < chromatograms.size(); ++i)
+    {
+      output.addChromatogram(std::move(chromatograms[i]));
+      boundaries_chrom.push_back(std::move(boundaries_c[i]));
     }
     endProgress();
 
@@ -533,47 +579,76 @@ namespace OpenMS
     // resize output with respect to input
     output.resize(input.size());
 
-    if (input.getNrSpectra() > 0)
+    // read, decode and pick spectra in batches: the next batch is read (and
+    // decoded in parallel) in the background while the current one is picked
+    OnDiscSpectrumPrefetcher prefetcher(input);
+    std::vector<MSSpectrum> batch;
+    while (prefetcher.nextBatch(batch))
     {
-      for (Size scan_idx = 0; scan_idx != input.size(); ++scan_idx)
+      const Size batch_start = prefetcher.batchStart();
+      size_t err_count = 0;
+      String error_message;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (SignedSize k = 0; k < (SignedSize)batch.size(); ++k)
       {
-        if (ms_levels_.empty()) //auto mode
+        if (err_count) continue; // no need to pick further if already an error was encountered
+        const Size scan_idx = batch_start + k;
+        MSSpectrum& s = batch[k];
+        try
         {
-          MSSpectrum s = input[scan_idx];
-          s.sortByPosition();
+          if (ms_levels_.empty()) //auto mode
+          {
+            s.sortByPosition();
 
-          // determine type of spectral data (profile or centroided)
-          SpectrumSettings::SpectrumType spectrumType = s.getType();
-          if (spectrumType == SpectrumSettings::CENTROID)
+            // determine type of spectral data (profile or centroided)
+            SpectrumSettings::SpectrumType spectrumType = s.getType();
+            if (spectrumType == SpectrumSettings::CENTROID)
+            {
+              output[scan_idx] = std::move(s);
+            }
+            else
+            {
+              pick(s, output[scan_idx]);
+            }
+          }
+          else if (!ListUtils::contains(ms_levels_, s.getMSLevel())) // manual mode
           {
-            output[scan_idx] = input[scan_idx];
+            output[scan_idx] = std::move(s);
           }
           else
           {
+            s.sortByPosition();
+
+            // determine type of spectral data (profile or centroided)
+            SpectrumSettings::SpectrumType spectrum_type = s.getType();
+
+            if (spectrum_type == SpectrumSettings::CENTROID && check_spectrum_type)
+            {
+              throw OpenMS::Exception::IllegalArgument(__FILE__, __LINE__, __FUNCTION__, "Error: Centroided data provided but profile spectra expected.");
+            }
+
             pick(s, output[scan_idx]);
           }
         }
-        else if (!ListUtils::contains(ms_levels_, input[scan_idx].getMSLevel())) // manual mode
-        {
-          output[scan_idx] = input[scan_idx];
-        }
-        else
+        catch (OpenMS::Exception::BaseException& e)
         {
-          MSSpectrum s = input[scan_idx];
-          s.sortByPosition();
-
-          // determine type of spectral data (profile or centroided)
-          SpectrumSettings::SpectrumType spectrum_type = s.getType();
-
-          if (spectrum_type == SpectrumSettings::CENTROID && check_spectrum_type)
+#ifdef _OPENMP
+#pragma omp critical(PeakPickerHiResErrorHandling)
+#endif
           {
-            throw OpenMS::Exception::IllegalArgument(__FILE__, __LINE__, __FUNCTION__, "Error: Centroided data provided but profile spectra expected.");
+            ++err_count;
+            error_message = e.what();
           }
-
-          pick(s, output[scan_idx]);
         }
-        setProgress(++progress);
       }
+      if (err_count != 0)
+      {
+        throw OpenMS::Exception::IllegalArgument(__FILE__, __LINE__, __FUNCTION__, error_message);
+      }
+      progress += batch.size();
+      setProgress(progress);
     }
 
     for (Size i = 0; i < input.getNrChromatograms(); ++i)
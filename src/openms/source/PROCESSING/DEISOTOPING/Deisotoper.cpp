@@ -19,6 +19,73 @@
 namespace OpenMS
 {
 
+namespace
+{
+  /**
+    @brief Same result as MSSpectrum::findNearest(mz, tolerance), for queries with non-decreasing @p mz
+
+    Remembers the position of the previous query, so sweeping over a spectrum replaces one binary search per query by an amortized constant number of steps.
+  */
+  class NearestPeakSweep
+  {
+  public:
+    explicit NearestPeakSweep(const std::vector<double>& mzs) :
+      mzs_(&mzs)
+    {
+    }
+
+    Int find(double mz, double tolerance)
+    {
+      const std::vector<double>& mzs = *mzs_;
+      if (mzs.empty()) return -1;
+
+      // first peak at or after mz (as MSSpectrum::MZBegin)
+      while (pos_ < mzs.size() && mzs[pos_] < mz) ++pos_;
+
+      // the peak before or the current peak are closest
+      Size nearest;
+      if (pos_ == 0)
+      {
+        nearest = 0;
+      }
+      else if (pos_ == mzs.size())
+      {
+        nearest = mzs.size() - 1;
+      }
+      else
+      {
+        nearest = std::fabs(mzs[pos_] - mz) < std::fabs(mzs[pos_ - 1] - mz) ? pos_ : pos_ - 1;
+      }
+
+      const double found_mz = mzs[nearest];
+      return (found_mz >= mz - tolerance && found_mz <= mz + tolerance) ? static_cast<Int>(nearest) : -1;
+    }
+
+  private:
+    const std::vector<double>* mzs_;
+    Size pos_ = 0;
+  };
+
+  /// One sweep per charge (from @p min_charge to @p max_charge) and isotopic peak (up to @p max_isopeaks), index: (q - min_charge) * max_isopeaks + i
+  std::vector<NearestPeakSweep> isotopeSweeps(const std::vector<double>& mzs, int min_charge, int max_charge, unsigned int max_isopeaks)
+  {
+    const Size charges = max_charge >= min_charge ? Size(max_charge - min_charge + 1) : 0;
+    return std::vector<NearestPeakSweep>(charges * max_isopeaks, NearestPeakSweep(mzs));
+  }
+
+  /// m/z of all peaks of @p spec
+  std::vector<double> peakPositions(const MSSpectrum& spec)
+  {
+    std::vector<double> mzs;
+    mzs.reserve(spec.size());
+    for (const Peak1D& p : spec)
+    {
+      mzs.push_back(p.getMZ());
+    }
+    return mzs;
+  }
+}
+
 // static
 void Deisotoper::deisotopeWithAveragineModel(MSSpectrum& spec,
   double fragment_tolerance,
@@ -109,6 +176,14 @@ void Deisotoper::deisotopeWithAveragineModel(MSSpectrum& spec,
 
   const float averagine_check_threshold[7] = {0.0f, 0.0f, 0.05f, 0.1f, 0.2f, 0.4f, 0.6f};
 
+  // the expected position of each isotopic peak only increases with the monoisotopic peak, so search it with one sweep per charge and isotope
+  const std::vector<double> mzs = peakPositions(old_spectrum);
+  std::vector<NearestPeakSweep> sweeps = isotopeSweeps(mzs, min_charge, max_charge, max_isopeaks);
+
+  // buffers reused for all candidate clusters
+  std::vector<double> extensions_intensities;
+  std::vector<double> distr;
+
   bool has_precursor_data(false);
   double precursor_mass(0);
   if (old_spectrum.getPrecursors().size() == 1)
@@ -147,8 +222,9 @@ void Deisotoper::deisotopeWithAveragineModel(MSSpectrum& spec,
       }
 
       // fail early if you do not find a single extension
+      NearestPeakSweep* charge_sweeps = &sweeps[(q - min_charge) * max_isopeaks];
       const double expected_first_mz = current_mz + Constants::C13C12_MASSDIFF_U / static_cast<double>(q);
-      Int p = old_spectrum.findNearest(expected_first_mz, tolerance_dalton);
+      Int p = charge_sweeps[1].find(expected_first_mz, tolerance_dalton);
       if (p == -1) // test for missing peak
       { 
         continue;
@@ -162,10 +238,10 @@ void Deisotoper::deisotopeWithAveragineModel(MSSpectrum& spec,
       extensions.push_back(current_peak);
 
       // Save frequently used values for performance reasons
-      std::vector<double> extensions_intensities = {current_intensity};
+      extensions_intensities.assign(1, current_intensity);
       
       // generate averagine distribution for peptide mass corresponding to current mz and charge
-      std::vector<double> distr = CoarseIsotopePatternGenerator::approximateIntensities(q * (current_mz - Constants::PROTON_MASS_U), max_isopeaks);
+      CoarseIsotopePatternGenerator::approximateIntensities(q * (current_mz - Constants::PROTON_MASS_U), max_isopeaks, distr);
       
       // sum of intensities of both observed and generated peaks is needed for normalization
       double spec_total_intensity = current_intensity;
@@ -181,7 +257,7 @@ void Deisotoper::deisotopeWithAveragineModel(MSSpectrum& spec,
         else
         {
           const double expected_mz = current_mz + static_cast<double>(i) * Constants::C13C12_MASSDIFF_U / static_cast<double>(q);
-          p = old_spectrum.findNearest(expected_mz, tolerance_dalton);
+          p = charge_sweeps[i].find(expected_mz, tolerance_dalton);
 
           if (p == -1)// test for missing peak
           {
@@ -396,6 +472,10 @@ void Deisotoper::deisotopeAndSingleCharge(MSSpectrum& spec,
 
   std::vector<size_t> extensions;
 
+  // the expected position of each isotopic peak only increases with the monoisotopic peak, so search it with one sweep per charge and isotope
+  const std::vector<double> mzs = peakPositions(old_spectrum);
+  std::vector<NearestPeakSweep> sweeps = isotopeSweeps(mzs, min_charge, max_charge, max_isopeaks);
+
   bool has_precursor_data(false);
   double precursor_mass(0);
   if (old_spectrum.getPrecursors().size() == 1)
@@ -436,10 +516,11 @@ void Deisotoper::deisotopeAndSingleCharge(MSSpectrum& spec,
 
         extensions.clear();
         extensions.push_back(current_peak);
+        NearestPeakSweep* charge_sweeps = &sweeps[(q - min_charge) * max_isopeaks];
         for (unsigned int i = 1; i < max_isopeaks; ++i)
         {
           const double expected_mz = current_mz + static_cast<double>(i) * Constants::C13C12_MASSDIFF_U / static_cast<double>(q);
-          const int p = old_spectrum.findNearest(expected_mz, tolerance_dalton);
+          const int p = charge_sweeps[i].find(expected_mz, tolerance_dalton);
           if (p == -1) // test for missing peak
           {
             has_min_isopeaks = (i >= min_isopeaks);
@@ -8,129 +8,147 @@
 
 #include <OpenMS/PROCESSING/FEATURE/FeatureOverlapFilter.h>
 
+#include <OpenMS/SYSTEM/TaskScheduler.h>
+
 #include <Quadtree.h>
 #include <Box.h>
-#include <unordered_set>
 
 #include <cmath>
+#include <numeric>
 
 namespace OpenMS
 {
-  /// Boundaries for a mass trace in a feature
-  struct MassTraceBounds
+  namespace
   {
-    Size sub_index;
-    double rt_min, rt_max, mz_min, mz_max;
-  };
+    /// Boundaries for a mass trace in a feature
+    struct MassTraceBounds
+    {
+      Size sub_index;
+      double rt_min, rt_max, mz_min, mz_max;
+    };
 
-  /// Boundaries for all mass traces per feature
-  using FeatureBoundsMap = std::map<UInt64, std::vector<MassTraceBounds>>;
+    /// Boundaries for all mass traces per feature (by index of the feature in the map)
+    using FeatureBounds = std::vector<std::vector<MassTraceBounds>>;
 
-  /// Get bounding boxes for all mass traces in all features of a feature map
-  FeatureBoundsMap getFeatureBounds(const FeatureMap& features)
-  {
-    FeatureBoundsMap feature_bounds;
-    for (const auto& feat : features)
+    /// Get bounding boxes for all mass traces in all features of a feature map
+    FeatureBounds getFeatureBounds(const FeatureMap& features)
     {
-      for (Size i = 0; i < feat.getSubordinates().size(); ++i)
+      FeatureBounds feature_bounds(features.size());
+      for (Size f = 0; f < features.size(); ++f)
       {
-        MassTraceBounds mtb;
-        mtb.sub_index = i;
-        const ConvexHull2D::PointArrayType& points =
-        feat.getConvexHulls()[i].getHullPoints();
-        mtb.mz_min = points.front().getY();
-        mtb.mz_max = points.back().getY();
-        const Feature& sub = feat.getSubordinates()[i];
-        // convex hulls should be written out by "MRMFeatureFinderScoring" (see
-        // parameter "write_convex_hull"):
-        if (sub.getConvexHulls().empty())
+        const Feature& feat = features[f];
+        for (Size i = 0; i < feat.getSubordinates().size(); ++i)
         {
-          String error = "convex hulls for mass traces missing";
-          throw Exception::MissingInformation(__FILE__, __LINE__,
-                                            OPENMS_PRETTY_FUNCTION, error);
-        }
-        const ConvexHull2D& hull = sub.getConvexHulls()[0];
-        // find beginning of mass trace (non-zero intensity):
-        if (hull.getHullPoints().empty())
-        {
-          continue;
-        }
-        double rt_min = hull.getHullPoints().back().getX();
-        for (auto p_it = hull.getHullPoints().begin(); p_it != hull.getHullPoints().end(); ++p_it)
-        {
-          if (p_it->getY() > 0)
+          MassTraceBounds mtb;
+          mtb.sub_index = i;
+          const ConvexHull2D::PointArrayType& points =
+          feat.getConvexHulls()[i].getHullPoints();
+          mtb.mz_min = points.front().getY();
+          mtb.mz_max = points.back().getY();
+          const Feature& sub = feat.getSubordinates()[i];
+          // convex hulls should be written out by "MRMFeatureFinderScoring" (see
+          // parameter "write_convex_hull"):
+          if (sub.getConvexHulls().empty())
           {
-            rt_min = p_it->getX();
-            break;
+            String error = "convex hulls for mass traces missing";
+            throw Exception::MissingInformation(__FILE__, __LINE__,
+                                              OPENMS_PRETTY_FUNCTION, error);
           }
-        }
-        // find end of mass trace (non-zero intensity):
-        double rt_max = hull.getHullPoints().front().getX();
-        for (auto p_it =
-             hull.getHullPoints().rbegin(); p_it !=
-             hull.getHullPoints().rend(); ++p_it)
-        {
-          if (p_it->getX() < rt_min)
+          const ConvexHull2D& hull = sub.getConvexHulls()[0];
+          // find beginning of mass trace (non-zero intensity):
+          if (hull.getHullPoints().empty())
           {
-            break;
+            continue;
           }
-          if (p_it->getY() > 0)
+          double rt_min = hull.getHullPoints().back().getX();
+          for (auto p_it = hull.getHullPoints().begin(); p_it != hull.getHullPoints().end(); ++p_it)
           {
-            rt_max = p_it->getX();
-            break;
+            if (p_it->getY() > 0)
+            {
+              rt_min = p_it->getX();
+              break;
+            }
           }
+          // find end of mass trace (non-zero intensity):
+          double rt_max = hull.getHullPoints().front().getX();
+          for (auto p_it =
+               hull.getHullPoints().rbegin(); p_it !=
+               hull.getHullPoints().rend(); ++p_it)
+          {
+            if (p_it->getX() < rt_min)
+            {
+              break;
+            }
+            if (p_it->getY() > 0)
+            {
+              rt_max = p_it->getX();
+              break;
+            }
+          }
+          if (rt_min > rt_max)
+          {
+            continue; // no peak -> skip
+          }
+          mtb.rt_min = rt_min;
+          mtb.rt_max = rt_max;
+          feature_bounds[f].push_back(std::move(mtb));
         }
-        if (rt_min > rt_max)
-        {
-          continue; // no peak -> skip
-        }
-        mtb.rt_min = rt_min;
-        mtb.rt_max = rt_max;
-        feature_bounds[feat.getUniqueId()].push_back(std::move(mtb));
       }
+      return feature_bounds;
     }
-    return feature_bounds;
-  }
 
-  /// Check if two sets of mass trace boundaries overlap
-  bool hasOverlappingBounds(const std::vector<MassTraceBounds>& mtb1, const std::vector<MassTraceBounds>& mtb2)
-  {
-    for (const MassTraceBounds& mt1 : mtb1)
+    /// Check if two sets of mass trace boundaries overlap
+    bool hasOverlappingBounds(const std::vector<MassTraceBounds>& mtb1, const std::vector<MassTraceBounds>& mtb2)
     {
-      for (const MassTraceBounds& mt2 : mtb2)
+      for (const MassTraceBounds& mt1 : mtb1)
       {
-        if (!((mt1.rt_max < mt2.rt_min) ||
-              (mt1.rt_min > mt2.rt_max) ||
-              (mt1.mz_max < mt2.mz_min) ||
-              (mt1.mz_min > mt2.mz_max)))
+        for (const MassTraceBounds& mt2 : mtb2)
         {
-          return true;
+          if (!((mt1.rt_max < mt2.rt_min) ||
+                (mt1.rt_min > mt2.rt_max) ||
+                (mt1.mz_max < mt2.mz_min) ||
+                (mt1.mz_min > mt2.mz_max)))
+          {
+            return true;
+          }
         }
       }
+      return false;
     }
-    return false;
-  }
 
-  bool tracesOverlap(const Feature& a, const Feature& b, const FeatureBoundsMap& feature_bounds)
-  {
-    auto fbm_it1 = feature_bounds.find(a.getUniqueId());
-    auto fbm_it2 = feature_bounds.find(b.getUniqueId());
-    return hasOverlappingBounds(fbm_it1->second, fbm_it2->second);
+    /// Root of @p i in a union-find forest (with path halving)
+    Size findRoot(std::vector<Size>& parent, Size i)
+    {
+      while (parent[i] != i)
+      {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+      }
+      return i;
+    }
   }
 
   void FeatureOverlapFilter::filter(FeatureMap& fmap, 
     std::function<bool(const Feature&, const Feature&)> FeatureComparator, 
     std::function<bool(Feature&, Feature&)> FeatureOverlapCallback,
-    bool check_overlap_at_trace_level)
+    bool check_overlap_at_trace_level,
+    bool parallel)
   {
     fmap.updateRanges();
     // Sort all features according to the comparator. After the sort, the "smallest" == best feature will be the first entry we will start processing with...
     std::stable_sort(fmap.begin(), fmap.end(), FeatureComparator);
 
-    const auto getBox = [](const Feature* f)
+    // the (lazily computed) overall convex hulls are evaluated once, the quadtree refers to the features by index
+    const Size n = fmap.size();
+    std::vector<quadtree::Box<float>> boxes(n);
+    TaskScheduler::parallelFor(0, n, [&](SignedSize i)
     {
-        const auto& bb = f->getConvexHull().getBoundingBox();
-        return quadtree::Box<float>(bb.minY(), bb.minX(), bb.maxY()-bb.minY(), bb.maxX()-bb.minX());
+      const auto& bb = fmap[i].getConvexHull().getBoundingBox();
+      boxes[i] = quadtree::Box<float>(bb.minY(), bb.minX(), bb.maxY()-bb.minY(), bb.maxX()-bb.minX());
+    }, 1024);
+    const auto getBox = [&boxes](Size i) -> const quadtree::Box<float>&
+    {
+        return boxes[i];
     };
 
     float minMZ = fmap.getMinMZ();
@@ -140,54 +158,121 @@ namespace OpenMS
 
     // build quadtree with all features
     quadtree::Box<float> fullExp(minMZ-1, minRT-1, maxMZ-minMZ+2, maxRT-minRT+2);
-    auto quadtree = quadtree::Quadtree<Feature*, decltype(getBox)>(fullExp, getBox);
-    for (auto& f : fmap)
+    auto quadtree = quadtree::Quadtree<Size, decltype(getBox)>(fullExp, getBox);
+    for (Size i = 0; i < n; ++i)
     {
-        quadtree.add(&f);
+        quadtree.add(i);
     }        
 
     // if we check for overlapping traces we need a faster lookup structure
-    FeatureBoundsMap fbm;
+    FeatureBounds fbm;
     if (check_overlap_at_trace_level)
     {
       fbm = getFeatureBounds(fmap);
     }
 
-    std::unordered_set<Size> removed_uids;
-    for (auto& f : fmap)
+    std::vector<char> removed(n, 0);
+    // resolves the overlaps of feature f (unless it was removed before) with the features in overlaps
+    const auto resolveOverlaps = [&](Size f, const std::vector<Size>& overlaps)
     {
-      if (removed_uids.count(f.getUniqueId()) == 0)
+      if (removed[f])
+      {
+        return;
+      }
+      for (Size overlap : overlaps)
       {
-        for (auto& overlap : quadtree.query(getBox(&f)))
+        if (overlap != f)
         {
-          if ((overlap != &f))
-          {
-            // Because feature boundaries might be large and lead to many overlapps, we (optionally) also can check if the boundaries of traces overlap
-            bool is_true_overlap = true;
-            if (check_overlap_at_trace_level)
-            {            
-              is_true_overlap = tracesOverlap(f, *overlap, fbm);
-            }
+          // Because feature boundaries might be large and lead to many overlapps, we (optionally) also can check if the boundaries of traces overlap
+          bool is_true_overlap = true;
+          if (check_overlap_at_trace_level)
+          {            
+            is_true_overlap = hasOverlappingBounds(fbm[f], fbm[overlap]);
+          }
 
-            if (is_true_overlap)
+          if (is_true_overlap)
+          {
+            // callback allows to e.g., transfer information from the to-be-removed feature to the representative feature
+            // if the callback returns false, overlap will not be removed (at least not because of an overlap with f)
+            if (FeatureOverlapCallback(fmap[f], fmap[overlap])) 
             {
-              // callback allows to e.g., transfer information from the to-be-removed feature to the representative feature
-              // if the callback returns false, overlap will not be removed (at least not because of an overlap with f)
-              if (FeatureOverlapCallback(f, *overlap)) 
-              {
-                removed_uids.insert(overlap->getUniqueId());
-              }                            
-            }
+              removed[overlap] = 1;
+            }                            
           }
         }
       }
+    };
+
+    if (!parallel)
+    {
+      for (Size f = 0; f < n; ++f)
+      {
+        if (!removed[f])
+        {
+          resolveOverlaps(f, quadtree.query(boxes[f]));
+        }
+      }
     }
+    else
+    {
+      // features can only interact within a cluster of (transitively) overlapping bounding boxes:
+      // query all overlaps in parallel, determine the clusters and resolve them independently
+      std::vector<std::vector<Size>> overlaps(n);
+      TaskScheduler::parallelFor(0, n, [&](SignedSize f)
+      {
+        overlaps[f] = quadtree.query(boxes[f]);
+      }, 64);
 
-    const auto filtered = [&removed_uids](const Feature& f)
+      std::vector<Size> parent(n);
+      std::iota(parent.begin(), parent.end(), 0);
+      for (Size f = 0; f < n; ++f)
+      {
+        for (Size overlap : overlaps[f])
+        {
+          Size root_f = findRoot(parent, f), root_o = findRoot(parent, overlap);
+          if (root_f != root_o)
+          {
+            parent[std::max(root_f, root_o)] = std::min(root_f, root_o);
+          }
+        }
+      }
+      // members of each cluster in order of the features (i.e. from best to worst)
+      std::vector<std::vector<Size>> clusters;
+      std::vector<Size> cluster_index(n);
+      for (Size f = 0; f < n; ++f)
+      {
+        Size root = findRoot(parent, f);
+        if (root == f)
+        {
+          cluster_index[f] = clusters.size();
+          clusters.emplace_back();
+        }
+        clusters[cluster_index[root]].push_back(f);
+      }
+
+      TaskScheduler::parallelFor(0, clusters.size(), [&](SignedSize c)
+      {
+        for (Size f : clusters[c])
+        {
+          resolveOverlaps(f, overlaps[f]);
+        }
+      });
+    }
+
+    // remove the overlapping features (keeping the order of the others)
+    Size kept = 0;
+    for (Size i = 0; i < n; ++i)
     {
-        return removed_uids.count(f.getUniqueId()) == 1;
-    };
-    fmap.erase(std::remove_if(fmap.begin(), fmap.end(), filtered), fmap.end());
+      if (!removed[i])
+      {
+        if (kept != i)
+        {
+          fmap[kept] = std::move(fmap[i]);
+        }
+        ++kept;
+      }
+    }
+    fmap.erase(fmap.begin() + kept, fmap.end());
   }
 
 }
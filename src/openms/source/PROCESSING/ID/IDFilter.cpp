@@ -313,27 +313,10 @@ namespace OpenMS
       }
     }
 
-    auto check_prots_avail = [&run_to_accessions, &remove_peptides_without_reference](PeptideIdentification& pep) -> void {
-      const String& run_id = pep.getIdentifier();
-      const unordered_set<String>& accessions = run_to_accessions[run_id];
-      struct HasMatchingAccessionUnordered<PeptideEvidence> acc_filter(accessions);
-      // check protein accessions of each peptide hit
-      for (PeptideHit& hit : pep.getHits())
-      {
-        // no non-const "PeptideHit::getPeptideEvidences" implemented, so we
-        // can't use "keepMatchingItems":
-        vector<PeptideEvidence> evidences;
-        remove_copy_if(hit.getPeptideEvidences().begin(), hit.getPeptideEvidences().end(), back_inserter(evidences), std::not_fn(acc_filter));
-        hit.setPeptideEvidences(evidences);
-      }
-
-      if (remove_peptides_without_reference)
-      {
-        removeMatchingItems(pep.getHits(), HasNoEvidence());
-      }
+    auto check_prots_avail = [&run_to_accessions, remove_peptides_without_reference](PeptideIdentification& pep) -> void {
+      keepMatchingEvidences_(pep, accessionsOfRun_(run_to_accessions, pep.getIdentifier()), remove_peptides_without_reference);
     };
-
-    cmap.applyFunctionOnPeptideIDs(check_prots_avail);
+    applyOnPeptideIDs_(cmap, check_prots_avail);
   }
 
   void IDFilter::updateProteinReferences(ConsensusMap& cmap, const ProteinIdentification& ref_run, bool remove_peptides_without_reference)
@@ -346,27 +329,10 @@ namespace OpenMS
       accessions_avail.insert(hit.getAccession());
     }
 
-    // TODO could be refactored and pulled out
-    auto check_prots_avail = [&accessions_avail, &remove_peptides_without_reference](PeptideIdentification& pep) -> void {
-      const unordered_set<String>& accessions = accessions_avail;
-      struct HasMatchingAccessionUnordered<PeptideEvidence> acc_filter(accessions);
-      // check protein accessions of each peptide hit
-      for (PeptideHit& hit : pep.getHits())
-      {
-        // no non-const "PeptideHit::getPeptideEvidences" implemented, so we
-        // can't use "keepMatchingItems":
-        vector<PeptideEvidence> evidences;
-        remove_copy_if(hit.getPeptideEvidences().begin(), hit.getPeptideEvidences().end(), back_inserter(evidences), std::not_fn(acc_filter));
-        hit.setPeptideEvidences(evidences);
-      }
-
-      if (remove_peptides_without_reference)
-      {
-        removeMatchingItems(pep.getHits(), HasNoEvidence());
-      }
+    auto check_prots_avail = [&accessions_avail, remove_peptides_without_reference](PeptideIdentification& pep) -> void {
+      keepMatchingEvidences_(pep, accessions_avail, remove_peptides_without_reference);
     };
-
-    cmap.applyFunctionOnPeptideIDs(check_prots_avail);
+    applyOnPeptideIDs_(cmap, check_prots_avail);
   }
 
   void IDFilter::updateProteinReferences(vector<PeptideIdentification>& peptides, const vector<ProteinIdentification>& proteins, bool remove_peptides_without_reference)
@@ -382,28 +348,78 @@ namespace OpenMS
       }
     }
 
-    for (PeptideIdentification& pep : peptides)
+    parallelForEach(peptides, [&run_to_accessions, remove_peptides_without_reference](PeptideIdentification& pep) {
+      keepMatchingEvidences_(pep, accessionsOfRun_(run_to_accessions, pep.getIdentifier()), remove_peptides_without_reference);
+    });
+  }
+
+  void IDFilter::updateProteinReferences(PeakMap& experiment, bool remove_peptides_without_reference)
+  {
+    // collect valid protein accessions for each ID run (once for all spectra):
+    map<String, unordered_set<String>> run_to_accessions;
+    for (const ProteinIdentification& prot : experiment.getProteinIdentifications())
     {
-      const String& run_id = pep.getIdentifier();
-      const unordered_set<String>& accessions = run_to_accessions[run_id];
-      struct HasMatchingAccessionUnordered<PeptideEvidence> acc_filter(accessions);
-      // check protein accessions of each peptide hit
-      for (PeptideHit& hit : pep.getHits())
+      const String& run_id = prot.getIdentifier();
+      for (const ProteinHit& hit : prot.getHits())
       {
-        // no non-const "PeptideHit::getPeptideEvidences" implemented, so we
-        // can't use "keepMatchingItems":
-        vector<PeptideEvidence> evidences;
-        remove_copy_if(hit.getPeptideEvidences().begin(), hit.getPeptideEvidences().end(), back_inserter(evidences), std::not_fn(acc_filter));
-        hit.setPeptideEvidences(evidences);
+        run_to_accessions[run_id].insert(hit.getAccession());
       }
+    }
 
-      if (remove_peptides_without_reference)
+    parallelForEach(experiment, [&run_to_accessions, remove_peptides_without_reference](MSSpectrum& spectrum) {
+      for (PeptideIdentification& pep : spectrum.getPeptideIdentifications())
       {
-        removeMatchingItems(pep.getHits(), HasNoEvidence());
+        keepMatchingEvidences_(pep, accessionsOfRun_(run_to_accessions, pep.getIdentifier()), remove_peptides_without_reference);
       }
+    });
+  }
+
+  const unordered_set<String>& IDFilter::accessionsOfRun_(const map<String, unordered_set<String>>& run_to_accessions, const String& run_id)
+  {
+    // no insertion (as by "operator[]"), so this can be used from several threads
+    static const unordered_set<String> no_accessions;
+    map<String, unordered_set<String>>::const_iterator pos = run_to_accessions.find(run_id);
+    return (pos == run_to_accessions.end()) ? no_accessions : pos->second;
+  }
+
+  void IDFilter::keepMatchingEvidences_(PeptideIdentification& pep, const unordered_set<String>& accessions, bool remove_peptides_without_reference)
+  {
+    struct HasMatchingAccessionUnordered<PeptideEvidence> acc_filter(accessions);
+    // check protein accessions of each peptide hit
+    for (PeptideHit& hit : pep.getHits())
+    {
+      // no non-const "PeptideHit::getPeptideEvidences" implemented, so we
+      // can't use "keepMatchingItems"; most hits keep all their evidences,
+      // so only those with invalid references are copied:
+      const vector<PeptideEvidence>& evidences = hit.getPeptideEvidences();
+      vector<PeptideEvidence>::const_iterator first_invalid = find_if_not(evidences.begin(), evidences.end(), acc_filter);
+      if (first_invalid == evidences.end())
+      {
+        continue;
+      }
+      vector<PeptideEvidence> valid(evidences.begin(), first_invalid);
+      copy_if(first_invalid + 1, evidences.end(), back_inserter(valid), acc_filter);
+      hit.setPeptideEvidences(std::move(valid));
+    }
+
+    if (remove_peptides_without_reference)
+    {
+      removeMatchingItems(pep.getHits(), HasNoEvidence());
     }
   }
 
+  void IDFilter::applyOnPeptideIDs_(ConsensusMap& cmap, const std::function<void(PeptideIdentification&)>& f)
+  {
+    // same as "ConsensusMap::applyFunctionOnPeptideIDs", but in parallel over features
+    parallelForEach(cmap, [&f](ConsensusFeature& feature) {
+      for (PeptideIdentification& pep : feature.getPeptideIdentifications())
+      {
+        f(pep);
+      }
+    });
+    parallelForEach(cmap.getUnassignedPeptideIdentifications(), f);
+  }
+
 
   bool IDFilter::updateProteinGroups(vector<ProteinIdentification::ProteinGroup>& groups, const vector<ProteinHit>& hits)
   {
@@ -462,8 +478,7 @@ namespace OpenMS
 
   void IDFilter::keepBestPeptideHits(vector<PeptideIdentification>& peptides, bool strict)
   {
-    for (PeptideIdentification& pep : peptides)
-    {
+    parallelForEach(peptides, [strict](PeptideIdentification& pep) {
       vector<PeptideHit>& hits = pep.getHits();
       if (hits.size() > 1)
       {
@@ -496,7 +511,7 @@ namespace OpenMS
           }
         }
       }
-    }
+    });
   }
 
   void IDFilter::filterGroupsByScore(std::vector<ProteinIdentification::ProteinGroup>& grps, double threshold_score, bool higher_better)
@@ -510,48 +525,22 @@ namespace OpenMS
 
   void IDFilter::filterPeptidesByLength(vector<PeptideIdentification>& peptides, Size min_length, Size max_length)
   {
-    if (min_length > 0)
-    {
-      struct HasMinPeptideLength length_filter(min_length);
-      for (PeptideIdentification& pep : peptides)
-      {
-        keepMatchingItems(pep.getHits(), length_filter);
-      }
-    }
-
-    if (max_length == std::numeric_limits<decltype(max_length)>::max()) return; // no upper end filtering needed
-
-    ++max_length; // the predicate tests for ">=", we need ">"
-    if (max_length > min_length)
-    {
-      struct HasMinPeptideLength length_filter(max_length);
-      for (PeptideIdentification& pep : peptides)
-      {
-        removeMatchingItems(pep.getHits(), length_filter);
-      }
-    }
+    // both bounds in one pass; the upper one is only used if it is set and not below the lower one
+    bool use_max = (max_length != std::numeric_limits<decltype(max_length)>::max()) && (max_length >= min_length);
+    struct HasMinPeptideLength min_filter(min_length);
+    struct HasMinPeptideLength max_filter(use_max ? max_length + 1 : 0); // the predicate tests for ">=", we need ">"
+    auto in_range = [&min_filter, &max_filter, use_max](const PeptideHit& hit) { return min_filter(hit) && !(use_max && max_filter(hit)); };
+    keepMatchingItemsUnroll(peptides, in_range);
   }
 
   void IDFilter::filterPeptidesByCharge(vector<PeptideIdentification>& peptides, Int min_charge, Int max_charge)
   {
-    struct HasMinCharge charge_filter(min_charge);
-    
-    for (PeptideIdentification& pep : peptides)
-    {
-      keepMatchingItems(pep.getHits(), charge_filter);
-    }
-
-    if (max_charge == std::numeric_limits<decltype(max_charge)>::max()) return; // no upper end filtering needed
-
-    ++max_charge; // the predicate tests for ">=", we need ">"
-    if (max_charge > min_charge)
-    {     
-      charge_filter = HasMinCharge(max_charge);
-      for (PeptideIdentification& pep : peptides)
-      {
-        removeMatchingItems(pep.getHits(), charge_filter);
-      }
-    }    
+    // both bounds in one pass; the upper one is only used if it is set and not below the lower one
+    bool use_max = (max_charge != std::numeric_limits<decltype(max_charge)>::max()) && (max_charge >= min_charge);
+    struct HasMinCharge min_filter(min_charge);
+    struct HasMinCharge max_filter(use_max ? max_charge + 1 : 0); // the predicate tests for ">=", we need ">"
+    auto in_range = [&min_filter, &max_filter, use_max](const PeptideHit& hit) { return min_filter(hit) && !(use_max && max_filter(hit)); };
+    keepMatchingItemsUnroll(peptides, in_range);
   }
 
 
@@ -571,28 +560,24 @@ namespace OpenMS
 
   void IDFilter::filterPeptidesByMZError(vector<PeptideIdentification>& peptides, double mass_error, bool unit_ppm)
   {
-    for (PeptideIdentification& pep : peptides)
-    {
+    parallelForEach(peptides, [mass_error, unit_ppm](PeptideIdentification& pep) {
       struct HasLowMZError error_filter(pep.getMZ(), mass_error, unit_ppm);
       keepMatchingItems(pep.getHits(), error_filter);
-    }
+    });
   }
 
 
   void IDFilter::filterPeptidesByRTPredictPValue(vector<PeptideIdentification>& peptides, const String& metavalue_key, double threshold)
   {
-    Size n_initial = 0, n_metavalue = 0; // keep track of numbers of hits
+    // keep track of numbers of hits
+    Size n_initial = countHits(peptides);
     struct HasMetaValue<PeptideHit> present_filter(metavalue_key, DataValue());
+    keepMatchingItemsUnroll(peptides, present_filter);
+    Size n_metavalue = countHits(peptides);
+
     double cutoff = 1 - threshold; // why? - Hendrik
     struct HasMaxMetaValue<PeptideHit> pvalue_filter(metavalue_key, cutoff);
-    for (PeptideIdentification& pep : peptides)
-    {
-      n_initial += pep.getHits().size();
-      keepMatchingItems(pep.getHits(), present_filter);
-      n_metavalue += pep.getHits().size();
-
-      keepMatchingItems(pep.getHits(), pvalue_filter);
-    }
+    keepMatchingItemsUnroll(peptides, pvalue_filter);
 
     if (n_metavalue < n_initial)
     {
@@ -605,10 +590,7 @@ namespace OpenMS
   void IDFilter::removePeptidesWithMatchingModifications(vector<PeptideIdentification>& peptides, const set<String>& modifications)
   {
     struct HasMatchingModification mod_filter(modifications);
-    for (PeptideIdentification& pep : peptides)
-    {
-      removeMatchingItems(pep.getHits(), mod_filter);
-    }
+    removeMatchingItemsUnroll(peptides, mod_filter);
   }
 
   void IDFilter::removePeptidesWithMatchingRegEx(vector<PeptideIdentification>& peptides, const String& regex)
@@ -618,19 +600,13 @@ namespace OpenMS
     // true if regex matches to parts or entire unmodified sequence
     auto regex_matches = [&re](const PeptideHit& ph) -> bool { return std::regex_search(ph.getSequence().toUnmodifiedString(), re); };
 
-    for (auto& pep : peptides)
-    {
-      removeMatchingItems(pep.getHits(), regex_matches);
-    }
+    removeMatchingItemsUnroll(peptides, regex_matches);
   }
 
   void IDFilter::keepPeptidesWithMatchingModifications(vector<PeptideIdentification>& peptides, const set<String>& modifications)
   {
     struct HasMatchingModification mod_filter(modifications);
-    for (PeptideIdentification& pep : peptides)
-    {
-      keepMatchingItems(pep.getHits(), mod_filter);
-    }
+    keepMatchingItemsUnroll(peptides, mod_filter);
   }
 
 
@@ -639,10 +615,7 @@ namespace OpenMS
     set<String> bad_seqs;
     extractPeptideSequences(bad_peptides, bad_seqs, ignore_mods);
     struct HasMatchingSequence seq_filter(bad_seqs, ignore_mods);
-    for (PeptideIdentification& pep : peptides)
-    {
-      removeMatchingItems(pep.getHits(), seq_filter);
-    }
+    removeMatchingItemsUnroll(peptides, seq_filter);
   }
 
 
@@ -651,26 +624,20 @@ namespace OpenMS
     set<String> good_seqs;
     extractPeptideSequences(good_peptides, good_seqs, ignore_mods);
     struct HasMatchingSequence seq_filter(good_seqs, ignore_mods);
-    for (PeptideIdentification& pep : peptides)
-    {
-      keepMatchingItems(pep.getHits(), seq_filter);
-    }
+    keepMatchingItemsUnroll(peptides, seq_filter);
   }
 
 
   void IDFilter::keepUniquePeptidesPerProtein(vector<PeptideIdentification>& peptides)
   {
-    Size n_initial = 0, n_metavalue = 0; // keep track of numbers of hits
+    // keep track of numbers of hits
+    Size n_initial = countHits(peptides);
     struct HasMetaValue<PeptideHit> present_filter("protein_references", DataValue());
-    struct HasMetaValue<PeptideHit> unique_filter("protein_references", DataValue("unique"));
-    for (PeptideIdentification& pep : peptides)
-    {
-      n_initial += pep.getHits().size();
-      keepMatchingItems(pep.getHits(), present_filter);
-      n_metavalue += pep.getHits().size();
+    keepMatchingItemsUnroll(peptides, present_filter);
+    Size n_metavalue = countHits(peptides);
 
-      keepMatchingItems(pep.getHits(), unique_filter);
-    }
+    struct HasMetaValue<PeptideHit> unique_filter("protein_references", DataValue("unique"));
+    keepMatchingItemsUnroll(peptides, unique_filter);
 
     if (n_metavalue < n_initial)
     {
@@ -683,34 +650,33 @@ namespace OpenMS
   // @TODO: generalize this to protein hits?
   void IDFilter::removeDuplicatePeptideHits(vector<PeptideIdentification>& peptides, bool seq_only)
   {
-    for (PeptideIdentification& pep : peptides)
-    {
-      vector<PeptideHit> filtered_hits;
+    parallelForEach(peptides, [seq_only](PeptideIdentification& pep) {
+      vector<PeptideHit>& hits = pep.getHits();
       if (seq_only)
       {
         set<AASequence> seqs;
-        for (PeptideHit& hit : pep.getHits())
-        {
-          if (seqs.insert(hit.getSequence()).second) // new sequence
-          {
-            filtered_hits.push_back(hit);
-          }
-        }
+        removeMatchingItems(hits, [&seqs](const PeptideHit& hit) { return !seqs.insert(hit.getSequence()).second; }); // not a new sequence
       }
       else
       {
         // there's no "PeptideHit::operator<" defined, so we can't use a set nor
-        // "sort" + "unique" from the standard library:
-        for (PeptideHit& hit : pep.getHits())
+        // "sort" + "unique" from the standard library; compact in place, comparing
+        // each hit to the ones kept so far:
+        vector<PeptideHit>::iterator kept_end = hits.begin();
+        for (vector<PeptideHit>::iterator hit_it = hits.begin(); hit_it != hits.end(); ++hit_it)
         {
-          if (find(filtered_hits.begin(), filtered_hits.end(), hit) == filtered_hits.end())
+          if (find(hits.begin(), kept_end, *hit_it) == kept_end)
           {
-            filtered_hits.push_back(hit);
+            if (hit_it != kept_end)
+            {
+              *kept_end = std::move(*hit_it);
+            }
+            ++kept_end;
           }
         }
+        hits.erase(kept_end, hits.end());
       }
-      pep.getHits().swap(filtered_hits);
-    }
+    });
   }
 
   void IDFilter::keepNBestSpectra(std::vector<PeptideIdentification>& peptides, Size n)
@@ -23,6 +23,7 @@
 
 #include <cmath>
 #include <algorithm>    // std::min, std::max
+#include <cstddef>
 #include <cstdlib>
 #include <vector>
 #include <functional>
@@ -474,6 +475,41 @@ namespace c_lowess
       }
     }
 
+    /// A point at which a weighted regression is computed, with its neighborhood
+    struct FitPoint
+    {
+      size_t i, nleft, nright;
+    };
+
+    /// Determine the points at which regressions are computed (and their
+    /// neighborhoods); this only depends on x and delta, not on the fit.
+    void plan_fits(const ContainerType& x,
+                   const size_t n,
+                   const size_t ns,
+                   const ValueType delta,
+                   std::vector<FitPoint>& fits)
+    {
+      size_t i(0), last(-1), nleft(0), nright(ns - 1);
+      do
+      {
+        // Identify the neighborhood around the current x[i]
+        // -> get the nearest ns points
+        update_neighborhood(x, n, i, nleft, nright);
+        fits.push_back({i, nleft, nright});
+
+        // Find the next i for which we'll run a regression (see
+        // update_indices, ties are skipped)
+        last = i;
+        ValueType cut = x[last] + delta;
+        for (i = last + 1; i < n; i++)
+        {
+          if (x[i] > cut) break;
+          if (x[i] == x[last]) last = i;
+        }
+        i = std::max(last + 1, i - 1);
+      } while (last < n - 1);
+    }
+
 public:
 
     int lowess(const ContainerType& x,
@@ -486,8 +522,6 @@ public:
                ContainerType& weights   // vector res
                )
     {
-      bool fit_ok;
-
       size_t ns, n(x.size());
       if (n < 2)
       {
@@ -500,28 +534,40 @@ public:
       size_t tmp = (size_t)(frac * (double)n);
       ns = std::max(std::min(tmp, n), (size_t)2);
 
+      // The points at which the regressions are computed and their
+      // neighborhoods are the same in all iterations.
+      std::vector<FitPoint> fits;
+      plan_fits(x, n, ns, delta, fits);
+
       // robustness iterations
       for (int iter = 1; iter <= nsteps + 1; iter++)
       {
+        // The regressions are independent of each other, so they can be
+        // computed in parallel (each thread needs its own weight vector).
+#pragma omp parallel
+        {
+          ContainerType local_weights(weights);
+#pragma omp for schedule(dynamic, 16)
+          for (std::ptrdiff_t k = 0; k < (std::ptrdiff_t)fits.size(); ++k)
+          {
+            const FitPoint& fit = fits[k];
+            // Calculate weights and apply fit (original lowest function)
+            const bool fit_ok = lowest(x, y, n, x[fit.i], ys[fit.i], fit.nleft, fit.nright,
+                                       local_weights, (iter > 1), resid_weights);
+
+            // if something went wrong during the fit, use y[i] as the
+            // fitted value at x[i]
+            if (!fit_ok) ys[fit.i] = y[fit.i];
+          }
+        }
+
         // start of array in C++ at 0 / in FORTRAN at 1
         // last: index of prev estimated point
         // i: index of current point
-        size_t i(0), last(-1), nleft(0), nright(ns -1);
-
-        // Fit all data points y[i] until the end of the array
-        do
+        size_t i(0), last(-1);
+        for (const FitPoint& fit : fits)
         {
-          // Identify the neighborhood around the current x[i]
-          // -> get the nearest ns points
-          update_neighborhood(x, n, i, nleft, nright);
-
-          // Calculate weights and apply fit (original lowest function)
-          fit_ok = lowest(x, y, n, x[i], ys[i], nleft, nright,
-                          weights, (iter > 1), resid_weights);
-
-          // if something went wrong during the fit, use y[i] as the
-          // fitted value at x[i]
-          if (!fit_ok) ys[i] = y[i];
+          i = fit.i;
 
           // If we skipped some points (because of how delta was set), go back
           // and fit them by linear interpolation.
@@ -530,11 +576,10 @@ public:
             interpolate_skipped_fits(x, i, last, ys);
           }
 
-          // Update the last fit counter to indicate we've now fit this point.
-          // Find the next i for which we'll run a regression.
+          // Update the last fit counter to indicate we've now fit this point
+          // (copies the fit to tied x values).
           update_indices(x, n, delta, i, last, ys);
-
-        } while (last < n - 1);
+        }
 
         // compute current residuals
         for (i = 0; i < n; i++)
@@ -12,6 +12,7 @@
 #include <OpenMS/KERNEL/MSExperiment.h>
 
 #include <cmath>
+#include <exception>
 
 namespace OpenMS
 {
@@ -142,20 +143,49 @@ namespace OpenMS
 
   void GaussFilter::filterExperiment(PeakMap & map)
   {
-    Size progress = 0;
-    startProgress(0, map.size() + map.getChromatograms().size(), "smoothing data");
-    for (Size i = 0; i < map.size(); ++i)
-    {
-      filter(map[i]);
-      setProgress(++progress);
-    }
+    const SignedSize spectra_count = (SignedSize)map.size();
+    const SignedSize total_count = spectra_count + (SignedSize)map.getChromatograms().size();
+    startProgress(0, total_count, "smoothing data");
 
-    for (Size i = 0; i < map.getChromatograms().size(); ++i)
+    std::exception_ptr error;
+    SignedSize error_index = total_count;
+#pragma omp parallel
     {
-      filter(map.getChromatogram(i));
-      setProgress(++progress);
+      // the ppm mode re-initializes the kernel for every data point, so each thread needs its own filter
+      GaussFilter local_filter(*this);
+
+      // spectra first, then chromatograms (index >= spectra_count)
+#pragma omp for schedule(dynamic)
+      for (SignedSize i = 0; i < total_count; ++i)
+      {
+        try
+        {
+          if (i < spectra_count)
+          {
+            local_filter.filter(map[i]);
+          }
+          else
+          {
+            local_filter.filter(map.getChromatogram(i - spectra_count));
+          }
+        }
+        catch (...)
+        {
+#pragma omp critical (GaussFilter_filterExperiment)
+          {
+            if (i < error_index)
+            {
+              error_index = i;
+              error = std::current_exception();
+            }
+          }
+        }
+        nextProgress();
+      }
     }
     endProgress();
+
+    if (error) std::rethrow_exception(error);
   }
 
 }
@@ -46,6 +46,7 @@ namespace OpenMS
 
     DoubleVector distances(input_size, 0.0);
     DoubleVector sortedDistances(input_size, 0.0);
+    std::vector<double> weigths(input_size, 0);
 
     for (Size outer_idx = 0; outer_idx < input_size; ++outer_idx)
     {
@@ -57,11 +58,10 @@ namespace OpenMS
         sortedDistances[inner_idx] = distances[inner_idx];
       }
 
-      // Sort distances in order from smallest to largest.
-      std::sort(sortedDistances.begin(), sortedDistances.end());
+      // Find the q-th smallest distance (a partial sort is sufficient).
+      std::nth_element(sortedDistances.begin(), sortedDistances.begin() + q, sortedDistances.end());
 
       // Compute weigths.
-      std::vector<double> weigths(input_size, 0);
       for (Size inner_idx = 0; inner_idx < input_size; ++inner_idx)
       {
         weigths.at(inner_idx) = tricube_(distances[inner_idx], sortedDistances[q]);
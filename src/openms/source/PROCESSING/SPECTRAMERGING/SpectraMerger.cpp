@@ -9,6 +9,10 @@
 
 #include <OpenMS/PROCESSING/SPECTRAMERGING/SpectraMerger.h>
 
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
 using namespace std;
 namespace OpenMS
 {
@@ -121,4 +125,108 @@ namespace OpenMS
     return *this;
   }
 
+  MSSpectrum SpectraMerger::mergeBlock(const std::vector<MSSpectrum>& block, const UInt ms_level) const
+  {
+    if (block.empty())
+    {
+      throw Exception::InvalidSize(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, block.size());
+    }
+    std::vector<Size> sacrifices(block.size() - 1);
+    std::iota(sacrifices.begin(), sacrifices.end(), 1);
+
+    MSSpectrum consensus_spec;
+    Size count_peaks_aligned(0), count_peaks_overall(0);
+    mergeBlock_(block, 0, sacrifices, ms_level, getMergeAlignment_(), consensus_spec, count_peaks_aligned, count_peaks_overall);
+    return consensus_spec;
+  }
+
+  SpectrumAlignment SpectraMerger::getMergeAlignment_() const
+  {
+    double mz_binning_width(param_.getValue("mz_binning_width"));
+    std::string mz_binning_unit(param_.getValue("mz_binning_width_unit"));
+
+    SpectrumAlignment sas;
+    Param p;
+    p.setValue("tolerance", mz_binning_width);
+    if (!(mz_binning_unit == "Da" || mz_binning_unit == "ppm"))
+    {
+      throw Exception::IllegalSelfOperation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);  // sanity check
+    }
+
+    p.setValue("is_relative_tolerance", mz_binning_unit == "Da" ? "false" : "true");
+    sas.setParameters(p);
+    return sas;
+  }
+
+  std::vector<std::vector<Size> > SpectraMerger::clusterPrecursors_(const std::vector<BaseFeature>& data) const
+  {
+    SpectraDistance_ llc;
+    llc.setParameters(param_.copy("precursor_method:", true));
+    const double rt_tolerance = param_.getValue("precursor_method:rt_tolerance");
+    const double mz_tolerance = param_.getValue("precursor_method:mz_tolerance");
+
+    // union-find forest of the groups
+    std::vector<Size> parent(data.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find_root = [&parent](Size i)
+    {
+      while (parent[i] != i)
+      {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+      }
+      return i;
+    };
+
+    // with a zero tolerance, no two precursors are similar (see SpectraDistance_)
+    if (rt_tolerance > 0 && mz_tolerance > 0)
+    {
+      std::vector<Size> rt_order(data.size());
+      std::iota(rt_order.begin(), rt_order.end(), 0);
+      std::stable_sort(rt_order.begin(), rt_order.end(), [&data](Size a, Size b) { return data[a].getRT() < data[b].getRT(); });
+
+      // m/z bucket (of width mz_tolerance) ==> precursors visited so far, in order of RT
+      std::unordered_map<Int64, std::vector<Size> > buckets;
+      for (const Size i : rt_order)
+      {
+        const Int64 bucket = (Int64)std::floor(data[i].getMZ() / mz_tolerance);
+        for (Int64 b = bucket - 1; b <= bucket + 1; ++b)
+        {
+          auto it = buckets.find(b);
+          if (it == buckets.end()) continue;
+          for (auto c = it->second.rbegin(); c != it->second.rend(); ++c)
+          {
+            // all earlier precursors of this bucket are even further away in RT
+            if (fabs(data[i].getRT() - data[*c].getRT()) > rt_tolerance) break;
+
+            Size root_i = find_root(i);
+            Size root_c = find_root(*c);
+            if (root_i == root_c) continue;
+            // same criterion as for the (float) DistanceMatrix of the hierarchical clustering: distances of 1.0 (== similarity 0) are not clustered
+            if (float(1 - llc(data[i], data[*c])) < 1.0f)
+            {
+              parent[std::max(root_i, root_c)] = std::min(root_i, root_c);
+            }
+          }
+        }
+        buckets[bucket].push_back(i);
+      }
+    }
+
+    // collect the groups; visiting the elements in ascending order sorts the groups by their first element
+    std::vector<std::vector<Size> > clusters;
+    std::vector<Size> cluster_of_root(data.size(), std::numeric_limits<Size>::max());
+    for (Size i = 0; i < data.size(); ++i)
+    {
+      const Size root = find_root(i);
+      if (cluster_of_root[root] == std::numeric_limits<Size>::max())
+      {
+        cluster_of_root[root] = clusters.size();
+        clusters.emplace_back();
+      }
+      clusters[cluster_of_root[root]].push_back(i);
+    }
+    return clusters;
+  }
+
 }
@@ -8,33 +8,48 @@
 
 #include <OpenMS/KERNEL/FeatureMap.h>
 #include <OpenMS/QC/FWHM.h>
+#include <OpenMS/QC/QCEngine.h>
 
 namespace OpenMS
 {
+  void FWHM::copyFWHM_(const Feature& f, PeptideIdentification& pi)
+  {
+    if (f.metaValueExists("FWHM")) // from FF-Centroided
+    {
+      pi.setMetaValue("FWHM", f.getMetaValue("FWHM"));
+    }
+    else if (f.metaValueExists("model_FWHM")) // from FF-Identification
+    {
+      pi.setMetaValue("FWHM", f.getMetaValue("model_FWHM")); // use 'FWHM' as target to make the name unique for downstream processing
+    }
+    else
+    {
+      // throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Metavalue 'FWHM' or 'model_FWHM' is missing for a feature in a FeatureMap. Please check your FeatureFinder
+      // reports FWHM using these metavalues or add a new mapping here.");
+    }
+  }
+
   void FWHM::compute(FeatureMap& features)
   {
     for (auto& f : features)
     {
-      if (f.metaValueExists("FWHM")) // from FF-Centroided
+      for (auto& pi : f.getPeptideIdentifications())
       {
-        for (auto& pi : f.getPeptideIdentifications())
-        {
-          pi.setMetaValue("FWHM", f.getMetaValue("FWHM"));
-        }
+        copyFWHM_(f, pi);
       }
-      else if (f.metaValueExists("model_FWHM")) // from FF-Identification
-      {
-        for (auto& pi : f.getPeptideIdentifications())
+    }
+  }
+
+  void FWHM::addVisitors(QCEngine& engine) const
+  {
+    engine.addPSMVisitor(
+      [](PeptideIdentification& pi, const Feature* feature, const MSSpectrum*) {
+        if (feature != nullptr) // unassigned PSMs have no FWHM
         {
-          pi.setMetaValue("FWHM", f.getMetaValue("model_FWHM")); // use 'FWHM' as target to make the name unique for downstream processing
+          copyFWHM_(*feature, pi);
         }
-      }
-      else
-      {
-        // throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Metavalue 'FWHM' or 'model_FWHM' is missing for a feature in a FeatureMap. Please check your FeatureFinder
-        // reports FWHM using these metavalues or add a new mapping here.");
-      }
-    }
+      },
+      true);
   }
 
   const String& FWHM::getName() const
@@ -9,8 +9,11 @@
 #include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/KERNEL/FeatureMap.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/QC/MissedCleavages.h>
+#include <OpenMS/QC/QCEngine.h>
 #include <iostream>
+#include <memory>
 
 namespace OpenMS
 {
@@ -34,6 +37,7 @@ namespace OpenMS
                       << " the allowed maximum number of missed cleavages during MS2-Search in: " << pep_id.getHits()[0].getSequence() << "\n";
     }
 
+#pragma omp critical (MissedCleavages_result)
     ++result[num_mc];
 
     pep_id.getHits()[0].setMetaValue("missed_cleavages", num_mc);
@@ -74,12 +78,17 @@ namespace OpenMS
 
   void MissedCleavages::compute(FeatureMap& fmap)
   {
-    MapU32 result {};
+    QCEngine engine;
+    addVisitors(engine, fmap);
+    engine.run(MSExperiment(), fmap, QCBase::SpectraMap());
+  }
 
+  void MissedCleavages::addVisitors(QCEngine& engine, const FeatureMap& fmap)
+  {
     bool has_pepIDs = QCBase::hasPepID(fmap);
     if (!has_pepIDs)
     {
-      mc_result_.push_back(result);
+      engine.addFinishCallback([this]() { mc_result_.push_back(MapU32()); });
       return;
     }
 
@@ -87,7 +96,7 @@ namespace OpenMS
     if (fmap.empty())
     {
       OPENMS_LOG_WARN << "FeatureXML is empty.\n";
-      mc_result_.push_back(result);
+      engine.addFinishCallback([this]() { mc_result_.push_back(MapU32()); });
       return;
     }
 
@@ -98,7 +107,7 @@ namespace OpenMS
     }
 
     String enzyme = fmap.getProteinIdentifications()[0].getSearchParameters().digestion_enzyme.getName();
-    auto max_mc = fmap.getProteinIdentifications()[0].getSearchParameters().missed_cleavages;
+    UInt32 max_mc = fmap.getProteinIdentifications()[0].getSearchParameters().missed_cleavages;
 
     // Exception if digestion enzyme is not given
     if (enzyme == "unknown_enzyme")
@@ -106,23 +115,26 @@ namespace OpenMS
       throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No digestion enzyme in FeatureMap detected. No computation possible.");
     }
 
-    // create a digestor, which doesn't allow any missed cleavages
-    ProteaseDigestion digestor;
-    digestor.setEnzyme(enzyme);
-    digestor.setMissedCleavages(0);
-
-    // small lambda function to apply get_missed_cleavages_from_peptide_identification on pep_ids
-    auto l = [&](PeptideIdentification& pep_id) {
-      get_missed_cleavages_from_peptide_identification_(digestor, result, max_mc, pep_id);
-      return;
+    // state of this run, shared by the visitor and the finish callback
+    struct State
+    {
+      ProteaseDigestion digestor;
+      MapU32 result;
     };
-    // iterate through all PeptideIdentifications of a given FeatureMap and applies the given lambda function
-    fmap.applyFunctionOnPeptideIDs(l);
-
-    mc_result_.push_back(result);
+    auto state = std::make_shared<State>();
+    // create a digestor, which doesn't allow any missed cleavages
+    state->digestor.setEnzyme(enzyme);
+    state->digestor.setMissedCleavages(0);
+
+    // counts are collected in a critical section, everything else only touches the PSM
+    engine.addPSMVisitor(
+      [this, state, max_mc](PeptideIdentification& pep_id, const Feature*, const MSSpectrum*) {
+        get_missed_cleavages_from_peptide_identification_(state->digestor, state->result, max_mc, pep_id);
+      },
+      true);
+    engine.addFinishCallback([this, state]() { mc_result_.push_back(state->result); });
   }
 
-
   const String& MissedCleavages::getName() const
   {
     static const String& name = "MissedCleavages";
@@ -15,17 +15,25 @@
 #include <OpenMS/MATH/MathFunctions.h>
 #include <OpenMS/METADATA/DataProcessing.h>
 #include <OpenMS/QC/MzCalibration.h>
+#include <OpenMS/QC/QCEngine.h>
 
 using namespace std;
 
 namespace OpenMS
 {
-  MzCalibration::MzCalibration() : mz_raw_ {}, mz_ref_ {}, no_mzml_(false)
+  MzCalibration::MzCalibration() : no_mzml_(false)
   {
   }
 
   // find original m/z Value, set meta value "mz_raw" and set meta value "mz_ref"
   void MzCalibration::compute(FeatureMap& features, const MSExperiment& exp, const QCBase::SpectraMap& map_to_spectrum)
+  {
+    QCEngine engine;
+    addVisitors(engine, exp);
+    engine.run(exp, features, map_to_spectrum);
+  }
+
+  void MzCalibration::addVisitors(QCEngine& engine, const MSExperiment& exp)
   {
     if (exp.empty())
     {
@@ -45,38 +53,22 @@ namespace OpenMS
       }
     }
 
-    // set meta values for the first hit of all PeptideIdentifications of all features
-    for (Feature& feature : features)
-    {
-      if (feature.getPeptideIdentifications().empty())
-      {
-        continue;
-      }
-
-      for (PeptideIdentification& peptide_ID : feature.getPeptideIdentifications())
-      {
-        addMzMetaValues_(peptide_ID, exp, map_to_spectrum);
-      }
-    }
-    // set meta values for the first hit of all unasssigned PeptideIdentifications
-    for (PeptideIdentification& unassigned_ID : features.getUnassignedPeptideIdentifications())
-    {
-      addMzMetaValues_(unassigned_ID, exp, map_to_spectrum);
-    }
+    // set meta values for the first hit of all PeptideIdentifications (assigned and unassigned)
+    engine.addPSMVisitor([this](PeptideIdentification& peptide_ID, const Feature*, const MSSpectrum* spectrum) { addMzMetaValues_(peptide_ID, spectrum); }, true);
   }
 
-  void MzCalibration::addMzMetaValues_(PeptideIdentification& peptide_ID, const PeakMap& exp, const QCBase::SpectraMap& map_to_spectrum)
+  void MzCalibration::addMzMetaValues_(PeptideIdentification& peptide_ID, const MSSpectrum* spectrum) const
   {
     if (peptide_ID.getHits().empty())
     {
       return;
     }
 
-    mz_ref_ = peptide_ID.getHits()[0].getSequence().getMZ(peptide_ID.getHits()[0].getCharge());
+    const double mz_ref = peptide_ID.getHits()[0].getSequence().getMZ(peptide_ID.getHits()[0].getCharge());
 
     if (no_mzml_)
     {
-      peptide_ID.getHits()[0].setMetaValue("uncalibrated_mz_error_ppm", Math::getPPM(peptide_ID.getMZ(), mz_ref_));
+      peptide_ID.getHits()[0].setMetaValue("uncalibrated_mz_error_ppm", Math::getPPM(peptide_ID.getMZ(), mz_ref));
     }
     else
     {
@@ -84,19 +76,21 @@ namespace OpenMS
       {
         throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No spectrum reference annotated at peptide identification!");
       }
-
-      // get spectrum from mapping and meta value
-      MSSpectrum spectrum = exp[map_to_spectrum.at(peptide_ID.getSpectrumReference())];
+      if (spectrum == nullptr)
+      {
+        throw Exception::ElementNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("No spectrum with identifier '") + peptide_ID.getSpectrumReference() + "' in MSExperiment!");
+      }
 
       // check if spectrum fulfills all requirements
-      if (spectrum.getMSLevel() == 2)
+      double mz_raw;
+      if (spectrum->getMSLevel() == 2)
       {
         // meta value has to be there, because InternalCalibration had to be called to get here
-        if (!spectrum.getPrecursors()[0].metaValueExists("mz_raw"))
+        if (!spectrum->getPrecursors()[0].metaValueExists("mz_raw"))
         {
           throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Expected meta value 'mz_raw' at MSSpectrum, but could not find it.");
         }
-        mz_raw_ = spectrum.getPrecursors()[0].getMetaValue("mz_raw");
+        mz_raw = spectrum->getPrecursors()[0].getMetaValue("mz_raw");
       }
       else
       {
@@ -104,10 +98,10 @@ namespace OpenMS
       }
 
       // set meta values
-      peptide_ID.getHits()[0].setMetaValue("mz_raw", mz_raw_);
-      peptide_ID.getHits()[0].setMetaValue("mz_ref", mz_ref_);
-      peptide_ID.getHits()[0].setMetaValue("uncalibrated_mz_error_ppm", Math::getPPM(mz_raw_, mz_ref_));
-      peptide_ID.getHits()[0].setMetaValue("calibrated_mz_error_ppm", Math::getPPM(peptide_ID.getMZ(), mz_ref_));
+      peptide_ID.getHits()[0].setMetaValue("mz_raw", mz_raw);
+      peptide_ID.getHits()[0].setMetaValue("mz_ref", mz_ref);
+      peptide_ID.getHits()[0].setMetaValue("uncalibrated_mz_error_ppm", Math::getPPM(mz_raw, mz_ref));
+      peptide_ID.getHits()[0].setMetaValue("calibrated_mz_error_ppm", Math::getPPM(peptide_ID.getMZ(), mz_ref));
     }
   }
 
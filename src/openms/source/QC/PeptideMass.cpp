@@ -8,21 +8,28 @@
 
 #include <OpenMS/KERNEL/FeatureMap.h>
 #include <OpenMS/QC/PeptideMass.h>
+#include <OpenMS/QC/QCEngine.h>
 
 namespace OpenMS
 {
+  void PeptideMass::annotateMass_(PeptideIdentification& pi)
+  {
+    if (pi.getHits().empty())
+    {
+      return;
+    }
+    auto& hit = pi.getHits()[0];
+    hit.setMetaValue("mass", (pi.getMZ() - Constants::PROTON_MASS_U) * hit.getCharge());
+  }
+
   void PeptideMass::compute(FeatureMap& features)
   {
-    features.applyFunctionOnPeptideIDs(
-      [](PeptideIdentification& pi) {
-        if (pi.getHits().empty())
-        {
-          return;
-        }
-        auto& hit = pi.getHits()[0];
-        hit.setMetaValue("mass", (pi.getMZ() - Constants::PROTON_MASS_U) * hit.getCharge());
-      },
-      true);
+    features.applyFunctionOnPeptideIDs(annotateMass_, true);
+  }
+
+  void PeptideMass::addVisitors(QCEngine& engine) const
+  {
+    engine.addPSMVisitor([](PeptideIdentification& pi, const Feature*, const MSSpectrum*) { annotateMass_(pi); }, true);
   }
 
   const String& PeptideMass::getName() const
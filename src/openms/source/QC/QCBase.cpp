@@ -41,6 +41,11 @@ namespace OpenMS
     return it->second;
   }
 
+  bool QCBase::SpectraMap::contains(const String& identifier) const
+  {
+    return nativeid_to_index_.find(identifier) != nativeid_to_index_.end();
+  }
+
   void QCBase::SpectraMap::clear()
   {
     nativeid_to_index_.clear();
@@ -0,0 +1,207 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/QC/QCEngine.h>
+
+#include <OpenMS/KERNEL/FeatureMap.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <exception>
+#include <limits>
+
+namespace OpenMS
+{
+  void QCEngine::addSpectrumVisitor(const SpectrumVisitor& visitor, bool thread_safe)
+  {
+    spectrum_visitors_.push_back(visitor);
+    spectrum_visitors_thread_safe_ = spectrum_visitors_thread_safe_ && thread_safe;
+  }
+
+  void QCEngine::addPSMVisitor(const PSMVisitor& visitor, bool thread_safe)
+  {
+    psm_visitors_.push_back(visitor);
+    psm_visitors_thread_safe_ = psm_visitors_thread_safe_ && thread_safe;
+  }
+
+  void QCEngine::addFinishCallback(const FinishCallback& callback)
+  {
+    finish_callbacks_.push_back(callback);
+  }
+
+  Size QCEngine::getNrSpectrumVisitors() const
+  {
+    return spectrum_visitors_.size();
+  }
+
+  Size QCEngine::getNrPSMVisitors() const
+  {
+    return psm_visitors_.size();
+  }
+
+  void QCEngine::clear()
+  {
+    *this = QCEngine();
+  }
+
+  void QCEngine::run(const MSExperiment& exp, FeatureMap& fmap, const QCBase::SpectraMap& map_to_spectrum) const
+  {
+    visitSpectra_(exp);
+    visitPSMs_(exp, fmap, map_to_spectrum);
+    finish();
+  }
+
+  void QCEngine::run(const MSExperiment& exp) const
+  {
+    visitSpectra_(exp);
+    finish();
+  }
+
+  void QCEngine::visitSpectrum(const MSSpectrum& spectrum, Size index) const
+  {
+    for (const SpectrumVisitor& visitor : spectrum_visitors_)
+    {
+      visitor(spectrum, index);
+    }
+  }
+
+  void QCEngine::visitPSM(PeptideIdentification& pep_id, const Feature* feature, const MSSpectrum* spectrum) const
+  {
+    for (const PSMVisitor& visitor : psm_visitors_)
+    {
+      visitor(pep_id, feature, spectrum);
+    }
+  }
+
+  void QCEngine::finish() const
+  {
+    for (const FinishCallback& callback : finish_callbacks_)
+    {
+      callback();
+    }
+  }
+
+  void QCEngine::visitSpectra_(const MSExperiment& exp) const
+  {
+    if (spectrum_visitors_.empty())
+    {
+      return;
+    }
+    if (!spectrum_visitors_thread_safe_)
+    {
+      for (Size i = 0; i < exp.size(); ++i)
+      {
+        visitSpectrum(exp[i], i);
+      }
+      return;
+    }
+
+    std::exception_ptr error;
+    SignedSize error_idx = std::numeric_limits<SignedSize>::max();
+#pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize i = 0; i < (SignedSize)exp.size(); ++i)
+    {
+      try
+      {
+        visitSpectrum(exp[i], i);
+      }
+      catch (...)
+      {
+#pragma omp critical (QCEngine_visitSpectra)
+        {
+          // report the error of the first spectrum (as a sequential run would)
+          if (i < error_idx)
+          {
+            error_idx = i;
+            error = std::current_exception();
+          }
+        }
+      }
+    }
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+
+  void QCEngine::visitPSMs_(const MSExperiment& exp, FeatureMap& fmap, const QCBase::SpectraMap& map_to_spectrum) const
+  {
+    if (psm_visitors_.empty())
+    {
+      return;
+    }
+
+    // lookup of the spectrum, shared by all visitors
+    auto spectrumOf = [&exp, &map_to_spectrum](const PeptideIdentification& pep_id) -> const MSSpectrum* {
+      if (map_to_spectrum.empty() || !pep_id.metaValueExists("spectrum_reference"))
+      {
+        return nullptr;
+      }
+      const String ref = pep_id.getSpectrumReference();
+      if (!map_to_spectrum.contains(ref))
+      {
+        return nullptr;
+      }
+      return &exp[map_to_spectrum.at(ref)];
+    };
+
+    // features first, then the unassigned PSMs (same order as FeatureMap::applyFunctionOnPeptideIDs)
+    const SignedSize nr_features = (SignedSize)fmap.size();
+    std::vector<PeptideIdentification>& unassigned = fmap.getUnassignedPeptideIdentifications();
+    auto visitItem = [&](SignedSize i) {
+      if (i < nr_features)
+      {
+        Feature& feature = fmap[i];
+        for (PeptideIdentification& pep_id : feature.getPeptideIdentifications())
+        {
+          visitPSM(pep_id, &feature, spectrumOf(pep_id));
+        }
+      }
+      else
+      {
+        PeptideIdentification& pep_id = unassigned[i - nr_features];
+        visitPSM(pep_id, nullptr, spectrumOf(pep_id));
+      }
+    };
+    const SignedSize nr_items = nr_features + (SignedSize)unassigned.size();
+
+    if (!psm_visitors_thread_safe_)
+    {
+      for (SignedSize i = 0; i < nr_items; ++i)
+      {
+        visitItem(i);
+      }
+      return;
+    }
+
+    std::exception_ptr error;
+    SignedSize error_idx = std::numeric_limits<SignedSize>::max();
+#pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize i = 0; i < nr_items; ++i)
+    {
+      try
+      {
+        visitItem(i);
+      }
+      catch (...)
+      {
+#pragma omp critical (QCEngine_visitPSMs)
+        {
+          if (i < error_idx)
+          {
+            error_idx = i;
+            error = std::current_exception();
+          }
+        }
+      }
+    }
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+} // namespace OpenMS
@@ -0,0 +1,251 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Axel Walter $
+// $Authors: Axel Walter $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/QC/QCMetricAccumulator.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/CONCEPT/Macros.h>
+
+#include <nlohmann/json.hpp>
+
+#include <cmath>
+#include <fstream>
+
+using json = nlohmann::json;
+
+namespace OpenMS
+{
+  QCMetricAccumulator::Summary::Summary(double relative_accuracy) :
+    sketch_(relative_accuracy)
+  {
+  }
+
+  QCMetricAccumulator::Summary::Summary(double mean, double m2, const Math::QuantileSketch& sketch) :
+    mean_(mean),
+    m2_(m2),
+    sketch_(sketch)
+  {
+  }
+
+  bool QCMetricAccumulator::Summary::operator==(const Summary& rhs) const
+  {
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wfloat-equal"
+    return mean_ == rhs.mean_ && m2_ == rhs.m2_ && sketch_ == rhs.sketch_;
+#pragma clang diagnostic pop
+  }
+
+  void QCMetricAccumulator::Summary::add(double value)
+  {
+    if (std::isnan(value))
+    {
+      return;
+    }
+    sketch_.add(value);
+    // Welford's update
+    const double delta = value - mean_;
+    mean_ += delta / double(sketch_.getCount());
+    m2_ += delta * (value - mean_);
+  }
+
+  void QCMetricAccumulator::Summary::merge(const Summary& other)
+  {
+    const double n_a = double(getCount());
+    const double n_b = double(other.getCount());
+    sketch_.merge(other.sketch_); // throws before anything is changed
+    if (n_b == 0.0)
+    {
+      return;
+    }
+    // Chan et al.: combine means and sums of squared differences of two sets
+    const double n = n_a + n_b;
+    const double delta = other.mean_ - mean_;
+    mean_ += delta * n_b / n;
+    m2_ += other.m2_ + delta * delta * n_a * n_b / n;
+  }
+
+  UInt64 QCMetricAccumulator::Summary::getCount() const
+  {
+    return sketch_.getCount();
+  }
+
+  double QCMetricAccumulator::Summary::getMean() const
+  {
+    return mean_;
+  }
+
+  double QCMetricAccumulator::Summary::getM2() const
+  {
+    return m2_;
+  }
+
+  double QCMetricAccumulator::Summary::getVariance() const
+  {
+    return getCount() < 2 ? 0.0 : m2_ / double(getCount() - 1);
+  }
+
+  double QCMetricAccumulator::Summary::getMin() const
+  {
+    return sketch_.getMin();
+  }
+
+  double QCMetricAccumulator::Summary::getMax() const
+  {
+    return sketch_.getMax();
+  }
+
+  double QCMetricAccumulator::Summary::getQuantile(double q) const
+  {
+    return sketch_.getQuantile(q);
+  }
+
+  const Math::QuantileSketch& QCMetricAccumulator::Summary::getSketch() const
+  {
+    return sketch_;
+  }
+
+  QCMetricAccumulator::QCMetricAccumulator(double relative_accuracy) :
+    relative_accuracy_(relative_accuracy)
+  {
+    Math::QuantileSketch check(relative_accuracy); // throws for invalid accuracies
+  }
+
+  bool QCMetricAccumulator::operator==(const QCMetricAccumulator& rhs) const
+  {
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wfloat-equal"
+    return relative_accuracy_ == rhs.relative_accuracy_ && runs_ == rhs.runs_ && metrics_ == rhs.metrics_;
+#pragma clang diagnostic pop
+  }
+
+  void QCMetricAccumulator::addRun(const String& label)
+  {
+    runs_.push_back(label);
+  }
+
+  void QCMetricAccumulator::add(const String& accession, double value)
+  {
+    metrics_.emplace(accession, Summary(relative_accuracy_)).first->second.add(value);
+  }
+
+  void QCMetricAccumulator::merge(const QCMetricAccumulator& other)
+  {
+    if (std::fabs(relative_accuracy_ - other.relative_accuracy_) > 1e-12)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Accumulators with different relative accuracy cannot be merged.");
+    }
+    runs_.insert(runs_.end(), other.runs_.begin(), other.runs_.end());
+    for (const auto& metric : other.metrics_)
+    {
+      metrics_.emplace(metric.first, Summary(relative_accuracy_)).first->second.merge(metric.second);
+    }
+  }
+
+  const std::vector<String>& QCMetricAccumulator::getRuns() const
+  {
+    return runs_;
+  }
+
+  const QCMetricAccumulator::Metrics& QCMetricAccumulator::getMetrics() const
+  {
+    return metrics_;
+  }
+
+  double QCMetricAccumulator::getRelativeAccuracy() const
+  {
+    return relative_accuracy_;
+  }
+
+  bool QCMetricAccumulator::empty() const
+  {
+    return runs_.empty() && metrics_.empty();
+  }
+
+  void QCMetricAccumulator::store(const String& filename) const
+  {
+    std::ofstream os(filename.c_str());
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    auto binsToJSON = [](const Math::QuantileSketch::Bins& bins) {
+      json array = json::array();
+      for (const auto& bin : bins)
+      {
+        array.push_back({bin.first, bin.second});
+      }
+      return array;
+    };
+
+    json out;
+    out["version"] = 1;
+    out["relative_accuracy"] = relative_accuracy_;
+    out["runs"] = json::array();
+    for (const String& run : runs_)
+    {
+      out["runs"].push_back(run);
+    }
+    out["metrics"] = json::object();
+    for (const auto& metric : metrics_)
+    {
+      const Summary& s = metric.second;
+      const Math::QuantileSketch& sketch = s.getSketch();
+      out["metrics"][metric.first] = {
+        {"mean", s.getMean()},
+        {"m2", s.getM2()},
+        {"min", sketch.getMin()},
+        {"max", sketch.getMax()},
+        {"zero_count", sketch.getZeroCount()},
+        {"positive", binsToJSON(sketch.getPositiveBins())},
+        {"negative", binsToJSON(sketch.getNegativeBins())}
+      };
+    }
+    os << out.dump(2);
+  }
+
+  void QCMetricAccumulator::load(const String& filename)
+  {
+    std::ifstream ifs(filename.c_str());
+    if (!ifs.good())
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    auto jsonToBins = [](const json& array) {
+      Math::QuantileSketch::Bins bins;
+      for (const json& bin : array)
+      {
+        bins[bin.at(0).get<Int>()] = bin.at(1).get<UInt64>();
+      }
+      return bins;
+    };
+
+    try
+    {
+      json in = json::parse(ifs);
+      QCMetricAccumulator result(in.at("relative_accuracy").get<double>());
+      for (const json& run : in.at("runs"))
+      {
+        result.runs_.push_back(run.get<std::string>());
+      }
+      for (const auto& metric : in.at("metrics").items())
+      {
+        const json& m = metric.value();
+        Math::QuantileSketch sketch(result.relative_accuracy_, jsonToBins(m.at("positive")), jsonToBins(m.at("negative")),
+                                    m.at("zero_count").get<UInt64>(), m.at("min").get<double>(), m.at("max").get<double>());
+        result.metrics_.emplace(metric.key(), Summary(m.at("mean").get<double>(), m.at("m2").get<double>(), sketch));
+      }
+      *this = std::move(result);
+    }
+    catch (const json::exception& e)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, String("Not a valid QC metric accumulator: ") + e.what());
+    }
+  }
+} // namespace OpenMS
@@ -18,6 +18,8 @@ set(sources_list
   PeptideMass.cpp
   PSMExplainedIonCurrent.cpp
   QCBase.cpp
+  QCEngine.cpp
+  QCMetricAccumulator.cpp
   RTAlignment.cpp
   SpectrumCount.cpp
   DBSuitability.cpp
@@ -624,6 +624,32 @@ namespace OpenMS
     return dir;
   }
 
+  String File::getCacheDirectory()
+  {
+    String dir;
+    if (getenv("OPENMS_CACHE_DIR") != nullptr)
+    {
+      dir = getenv("OPENMS_CACHE_DIR");
+    }
+    else
+    {
+    #ifdef __unix__
+      if (getenv("XDG_CACHE_HOME") != nullptr)
+      {
+        dir = String(getenv("XDG_CACHE_HOME")) + "/OpenMS";
+      }
+      else
+      {
+        dir = getOpenMSHomePath() + "/.cache/OpenMS";
+      }
+    #else
+      dir = getOpenMSHomePath() + "/.OpenMS/cache";
+    #endif
+    }
+    dir.ensureLastChar('/');
+    return dir;
+  }
+
   String File::findDatabase(const String& db_name)
   {
     Param sys_p = getSystemParameters();
@@ -0,0 +1,59 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/SYSTEM/MemoryBudget.h>
+
+#include <OpenMS/SYSTEM/SysInfo.h>
+
+#include <atomic>
+
+using namespace std;
+
+namespace OpenMS
+{
+  namespace
+  {
+    atomic<UInt64> memory_limit_(0);
+  }
+
+  void MemoryBudget::setLimit(UInt64 bytes)
+  {
+    memory_limit_ = bytes;
+  }
+
+  UInt64 MemoryBudget::getLimit()
+  {
+    return memory_limit_;
+  }
+
+  bool MemoryBudget::hasLimit()
+  {
+    return memory_limit_ != 0;
+  }
+
+  UInt64 MemoryBudget::getUsage()
+  {
+    size_t mem_kb = 0;
+    if (!SysInfo::getProcessMemoryConsumption(mem_kb))
+    {
+      return 0;
+    }
+    return UInt64(mem_kb) * 1024;
+  }
+
+  bool MemoryBudget::isExceeded(UInt64 additional_bytes)
+  {
+    const UInt64 limit = memory_limit_;
+    if (limit == 0)
+    {
+      return false;
+    }
+    const UInt64 usage = getUsage();
+    return usage != 0 && usage + additional_bytes > limit;
+  }
+}
@@ -7,6 +7,7 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/SYSTEM/SysInfo.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
 
 #include <array>
 #include <cstdlib>
@@ -164,6 +165,22 @@ namespace OpenMS
 #endif
   }
 
+  Size SysInfo::getNumaNodeCount()
+  {
+    return TaskScheduler::getNumaTopology().size();
+  }
+
+  String SysInfo::getNumaTopologyInfo()
+  {
+    const std::vector<std::vector<int>> nodes = TaskScheduler::getNumaTopology();
+    String s = String(nodes.size()) + (nodes.size() == 1 ? " NUMA node (" : " NUMA nodes (");
+    for (Size i = 0; i < nodes.size(); ++i)
+    {
+      s += (i > 0 ? " + " : "") + String(nodes[i].size());
+    }
+    return s + " cores)";
+  }
+
   SysInfo::MemUsage::MemUsage()
     : mem_before(0), mem_before_peak(0), mem_after(0), mem_after_peak(0)
   {
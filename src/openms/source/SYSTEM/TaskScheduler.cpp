@@ -0,0 +1,341 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/SYSTEM/TaskScheduler.h>
+
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace OpenMS
+{
+  namespace
+  {
+    atomic<TaskScheduler::MemoryPlacement> memory_placement_(TaskScheduler::MemoryPlacement::DEFAULT);
+    atomic<bool> deterministic_(false);
+
+#ifdef __linux__
+    /// the cores the process was allowed to use before any binding (binding the calling thread changes its mask)
+    const cpu_set_t& initialCpuSet_()
+    {
+      static cpu_set_t initial;
+      static once_flag flag;
+      call_once(flag, []()
+      {
+        CPU_ZERO(&initial);
+        if (sched_getaffinity(0, sizeof(cpu_set_t), &initial) != 0)
+        {
+          for (unsigned int i = 0; i < std::max(1u, thread::hardware_concurrency()) && i < CPU_SETSIZE; ++i)
+          {
+            CPU_SET(i, &initial);
+          }
+        }
+      });
+      return initial;
+    }
+
+    /// parses a Linux cpu (or node) list such as "0-3,8,10-11"
+    vector<int> parseCpuList_(const string& list)
+    {
+      vector<int> cpus;
+      stringstream ss(list);
+      string range;
+      while (getline(ss, range, ','))
+      {
+        if (range.empty() || range == "\n")
+        {
+          continue;
+        }
+        const size_t dash = range.find('-');
+        try
+        {
+          const int first = stoi(range.substr(0, dash));
+          const int last = (dash == string::npos) ? first : stoi(range.substr(dash + 1));
+          for (int c = first; c <= last; ++c)
+          {
+            cpus.push_back(c);
+          }
+        }
+        catch (const std::exception&)
+        {
+          // ignore malformed entries
+        }
+      }
+      return cpus;
+    }
+
+    // memory policies of set_mempolicy(2) (numaif.h is part of libnuma, which we do not depend on)
+    const int MPOL_DEFAULT_ = 0;
+    const int MPOL_INTERLEAVE_ = 3;
+    const Size MAX_NUMA_NODES_ = 1024;
+#endif
+  }
+
+  TaskScheduler::TaskGroup::~TaskGroup()
+  {
+    try
+    {
+      wait();
+    }
+    catch (...)
+    {
+      // destructors must not throw
+    }
+  }
+
+  void TaskScheduler::TaskGroup::execute_(const std::function<void()>& task)
+  {
+    try
+    {
+      task();
+    }
+    catch (...)
+    {
+#pragma omp critical (TaskScheduler_error)
+      if (!error_) error_ = std::current_exception();
+    }
+  }
+
+  void TaskScheduler::TaskGroup::startPending_()
+  {
+    for (; started_ < tasks_.size(); ++started_)
+    {
+      // take the address here: other threads must not access the deque while tasks are added
+      const std::function<void()>* task = &tasks_[started_];
+#pragma omp task default(shared) firstprivate(task)
+      execute_(*task);
+    }
+  }
+
+  void TaskScheduler::TaskGroup::wait()
+  {
+    if (inParallel_())
+    {
+      startPending_();
+#pragma omp taskwait
+    }
+    else if (started_ < tasks_.size())
+    {
+#pragma omp parallel
+#pragma omp single
+      startPending_();
+      // the implicit barrier waits for all tasks
+    }
+    tasks_.clear();
+    started_ = 0;
+    if (error_)
+    {
+      std::exception_ptr error = error_;
+      error_ = nullptr;
+      std::rethrow_exception(error);
+    }
+  }
+
+  bool TaskScheduler::inParallel_()
+  {
+#ifdef _OPENMP
+    return omp_get_level() > 0;
+#else
+    return false;
+#endif
+  }
+
+  void TaskScheduler::setNumThreads(int num_threads)
+  {
+#ifdef _OPENMP
+    omp_set_num_threads(std::max(1, num_threads));
+#else
+    (void)num_threads;
+#endif
+  }
+
+  int TaskScheduler::getNumThreads()
+  {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+  }
+
+  std::vector<std::vector<int> > TaskScheduler::getNumaTopology()
+  {
+    vector<vector<int> > nodes;
+#ifdef __linux__
+    const cpu_set_t& allowed = initialCpuSet_();
+    for (int node = 0; ; ++node)
+    {
+      ifstream is("/sys/devices/system/node/node" + to_string(node) + "/cpulist");
+      if (!is)
+      {
+        break;
+      }
+      string list;
+      getline(is, list);
+      vector<int> cpus;
+      for (int c : parseCpuList_(list))
+      {
+        if (c >= 0 && c < CPU_SETSIZE && CPU_ISSET(c, &allowed))
+        {
+          cpus.push_back(c);
+        }
+      }
+      if (!cpus.empty())
+      {
+        nodes.push_back(cpus);
+      }
+    }
+    if (nodes.empty())
+    {
+      vector<int> cpus;
+      for (int c = 0; c < CPU_SETSIZE; ++c)
+      {
+        if (CPU_ISSET(c, &allowed))
+        {
+          cpus.push_back(c);
+        }
+      }
+      nodes.push_back(cpus);
+    }
+#else
+    vector<int> cpus;
+    for (unsigned int c = 0; c < std::max(1u, thread::hardware_concurrency()); ++c)
+    {
+      cpus.push_back(int(c));
+    }
+    nodes.push_back(cpus);
+#endif
+    return nodes;
+  }
+
+  void TaskScheduler::setMemoryPlacement(MemoryPlacement placement)
+  {
+    memory_placement_ = placement;
+  }
+
+  TaskScheduler::MemoryPlacement TaskScheduler::getMemoryPlacement()
+  {
+    return memory_placement_;
+  }
+
+  void TaskScheduler::setDeterministic(bool deterministic)
+  {
+    deterministic_ = deterministic;
+  }
+
+  bool TaskScheduler::isDeterministic()
+  {
+    return deterministic_;
+  }
+
+  bool TaskScheduler::setMemoryInterleaving(bool interleave)
+  {
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+    if (!interleave)
+    {
+      return syscall(SYS_set_mempolicy, MPOL_DEFAULT_, nullptr, 0) == 0;
+    }
+    // all nodes with memory
+    ifstream is("/sys/devices/system/node/has_memory");
+    string list;
+    if (!is || !getline(is, list))
+    {
+      return false;
+    }
+    const Size bits_per_word = 8 * sizeof(unsigned long);
+    vector<unsigned long> mask(MAX_NUMA_NODES_ / bits_per_word, 0);
+    for (int node : parseCpuList_(list))
+    {
+      if (node >= 0 && Size(node) < MAX_NUMA_NODES_)
+      {
+        mask[node / bits_per_word] |= 1ul << (node % bits_per_word);
+      }
+    }
+    return syscall(SYS_set_mempolicy, MPOL_INTERLEAVE_, mask.data(), MAX_NUMA_NODES_) == 0;
+#else
+    (void)interleave;
+    return false;
+#endif
+  }
+
+  bool TaskScheduler::setThreadAffinity(ThreadAffinity affinity)
+  {
+#ifdef __linux__
+    const vector<vector<int> > nodes = getNumaTopology();
+
+    // order in which cores are assigned to threads
+    vector<int> cores;
+    if (affinity == ThreadAffinity::COMPACT)
+    {
+      for (const vector<int>& node : nodes)
+      {
+        cores.insert(cores.end(), node.begin(), node.end());
+      }
+    }
+    else if (affinity == ThreadAffinity::SPREAD)
+    {
+      Size max_node_size = 0;
+      for (const vector<int>& node : nodes)
+      {
+        max_node_size = std::max(max_node_size, node.size());
+      }
+      // the i-th core of every node, then the (i+1)-th, ...
+      for (Size i = 0; i < max_node_size; ++i)
+      {
+        for (const vector<int>& node : nodes)
+        {
+          if (i < node.size())
+          {
+            cores.push_back(node[i]);
+          }
+        }
+      }
+    }
+
+    bool success = true;
+#pragma omp parallel reduction(&& : success)
+    {
+      int thread_index = 0;
+#ifdef _OPENMP
+      thread_index = omp_get_thread_num();
+#endif
+      cpu_set_t mask;
+      if (cores.empty())
+      {
+        mask = initialCpuSet_();
+      }
+      else
+      {
+        CPU_ZERO(&mask);
+        CPU_SET(cores[thread_index % cores.size()], &mask);
+      }
+      success = (sched_setaffinity(0, sizeof(cpu_set_t), &mask) == 0);
+    }
+    return success;
+#else
+    (void)affinity;
+    return false;
+#endif
+  }
+
+} // namespace OpenMS
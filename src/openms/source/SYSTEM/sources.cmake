@@ -8,11 +8,13 @@ ExternalProcess.cpp
 File.cpp
 FileWatcher.cpp
 JavaInfo.cpp
+MemoryBudget.cpp
 NetworkGetRequest.cpp
 PythonInfo.cpp
 RWrapper.cpp
 StopWatch.cpp
 SysInfo.cpp
+TaskScheduler.cpp
 UpdateCheck.cpp
 )
 
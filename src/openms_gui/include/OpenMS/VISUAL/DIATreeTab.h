@@ -13,6 +13,8 @@
 #include <OpenMS/VISUAL/DataSelectionTabs.h>
 #include <OpenMS/VISUAL/LayerDataBase.h>
 
+#include <memory>
+
 class QLineEdit;
 class QComboBox;
 class QTreeWidget;
@@ -20,6 +22,7 @@ class QTreeWidgetItem;
 
 namespace OpenMS
 {
+  class OSWFile;
   class TreeView;
   struct OSWIndexTrace;
 
@@ -36,7 +39,7 @@ namespace OpenMS
     /// Constructor
     DIATreeTab(QWidget* parent = nullptr);
     /// Destructor
-    ~DIATreeTab() override = default;
+    ~DIATreeTab() override;
 
     // docu in base class
     bool hasData(const LayerDataBase* layer) override;
@@ -63,6 +66,9 @@ namespace OpenMS
     /// Useful to avoid useless repaintings, which would loose the open/close state of internal tree nodes and selected items
     OSWData* current_data_ = nullptr;
 
+    /// the source file of current_data_, kept open to read proteins on demand (and prefetch their neighbours)
+    std::unique_ptr<OSWFile> osw_file_;
+
     /** 
       @brief convert a tree item to a pointer into an OSWData structure
 
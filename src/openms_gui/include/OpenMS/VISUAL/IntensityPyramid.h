@@ -0,0 +1,111 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/VISUAL/OpenMS_GUIConfig.h>
+
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace OpenMS
+{
+  class MSExperiment;
+
+  /**
+    @brief Multi-resolution grid of the peak intensities of a map (RT x m/z), for fast painting of zoomed out views
+
+    The finest level (level 0) divides the RT and m/z range of the spectra of one MS level into equally spaced tiles
+    and stores the maximum and the sum of the intensities of the peaks in each tile. Each further level merges 2x2
+    tiles of the level below, up to a single tile.
+
+    To paint a view, select the coarsest level whose tiles are not larger than a pixel (selectLevel()) and take
+    the maximum of the (at most a few) tiles covered by each pixel. The cost is thus independent of the number of peaks.
+
+    @ingroup Visual
+  */
+  class OPENMS_GUI_DLLAPI IntensityPyramid
+  {
+public:
+    /// A half-open range [first, second) of tile indices
+    using TileRange = std::pair<Size, Size>;
+
+    /// One resolution level
+    struct Level
+    {
+      Size rt_tiles = 0; ///< number of tiles in RT
+      Size mz_tiles = 0; ///< number of tiles in m/z
+      std::vector<float> max_intensity; ///< maximum intensity of each tile (index: rt * mz_tiles + mz); -1 for tiles without peaks
+      std::vector<float> sum_intensity; ///< summed intensity of each tile (same indexing)
+    };
+
+    /// Default constructor (no levels)
+    IntensityPyramid() = default;
+
+    /**
+      @brief Builds the pyramid of the spectra with MS level @p ms_level
+
+      Spectra need to be sorted by m/z.
+
+      @param exp The map
+      @param ms_level MS level of the spectra to use
+      @param max_tiles Number of tiles of level 0 in m/z and (at most, since there are not more tiles than spectra) in RT.
+             Tile numbers are rounded down to powers of two, so each level halves them exactly.
+      @param cancel If given and set to true while building, building stops and the pyramid remains empty
+    */
+    IntensityPyramid(const MSExperiment& exp, UInt ms_level = 1, Size max_tiles = 4096, const std::atomic<bool>* cancel = nullptr);
+
+    /// No levels (no data or cancelled)?
+    bool empty() const;
+
+    /// Number of levels
+    Size size() const;
+
+    /// Level @p level (0 is the finest)
+    const Level& getLevel(Size level) const;
+
+    /// RT and m/z range of the data (as given by the spectra and their first/last peak)
+    double getMinRT() const;
+    double getMaxRT() const;
+    double getMinMZ() const;
+    double getMaxMZ() const;
+
+    /**
+      @brief The coarsest level whose tiles are not larger than a pixel
+
+      @param rt_span RT span of the view
+      @param mz_span m/z span of the view
+      @param rt_pixels Number of pixels in RT
+      @param mz_pixels Number of pixels in m/z
+      @return The level, or size() if even the tiles of level 0 are larger than a pixel
+    */
+    Size selectLevel(double rt_span, double mz_span, Size rt_pixels, Size mz_pixels) const;
+
+    /// RT tiles of level @p level which overlap [rt_start, rt_end)
+    TileRange getRTTiles(Size level, double rt_start, double rt_end) const;
+
+    /// m/z tiles of level @p level which overlap [mz_start, mz_end)
+    TileRange getMZTiles(Size level, double mz_start, double mz_end) const;
+
+    /// Maximum intensity of the given tiles of level @p level (-1 if they do not contain peaks)
+    float getMaxIntensity(Size level, const TileRange& rt_tiles, const TileRange& mz_tiles) const;
+
+protected:
+    /// Tiles of @p tiles equally spaced tiles in [min, max] which overlap [start, end)
+    static TileRange getTiles_(double min, double max, Size tiles, double start, double end);
+
+    std::vector<Level> levels_;
+    double min_rt_ = 0.0;
+    double max_rt_ = 0.0;
+    double min_mz_ = 0.0;
+    double max_mz_ = 0.0;
+  };
+}
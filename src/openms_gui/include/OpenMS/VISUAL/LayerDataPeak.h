@@ -14,11 +14,18 @@
 #include <OpenMS/METADATA/PeptideIdentification.h>
 #include <OpenMS/METADATA/ProteinIdentification.h>
 
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace OpenMS
 {
   class Annotation1DItem;
+  class IntensityPyramid;
+  class SpectrumCache;
 
   /**
   @brief Class that stores the data for one layer of type PeakMap
@@ -72,20 +79,13 @@ namespace OpenMS
 
     bool annotate(const std::vector<PeptideIdentification>& identifications, const std::vector<ProteinIdentification>& protein_identifications) override;
 
-    const ExperimentType::SpectrumType& getSpectrum(Size spectrum_idx) const
-    {
-      if ((*peak_map_)[spectrum_idx].size() > 0)
-      {
-        return (*peak_map_)[spectrum_idx];
-      }
-      if (!on_disc_peaks_->empty())
-      {
-        static MSSpectrum local_spec;
-        local_spec = on_disc_peaks_->getSpectrum(spectrum_idx);
-        return local_spec;
-      }
-      return (*peak_map_)[spectrum_idx];
-    }
+    /**
+    @brief Returns the spectrum with index @p spectrum_idx, from memory or (if its peaks are cached on disk) from disk
+
+    Spectra read from disk are kept in a cache of recently used spectra (shared by copies of the layer), see SpectrumCache.
+    The returned reference remains valid until SpectrumCache::getCapacity() other spectra have been read from disk.
+    */
+    const ExperimentType::SpectrumType& getSpectrum(Size spectrum_idx) const;
 
     /**
     @brief Returns a const reference to the current in-memory peak data
@@ -106,25 +106,25 @@ namespace OpenMS
     cached on disk.
 
     @note Do *not* use this function to access the current spectrum for the 1D view, use getCurrentSpectrum() instead.
+    @note Discards the intensity pyramid (see getIntensityPyramid()), since the data may be modified.
     */
-    const ExperimentSharedPtrType& getPeakDataMuteable()
-    {
-      return peak_map_;
-    }
+    const ExperimentSharedPtrType& getPeakDataMuteable();
 
     /**
     @brief Set the current in-memory peak data
     */
-    void setPeakData(ExperimentSharedPtrType p)
-    {
-      peak_map_ = p;
-    }
+    void setPeakData(ExperimentSharedPtrType p);
+
+    /**
+    @brief Returns the intensity pyramid of the MS1 peak data (for fast painting of zoomed out 2D views), if available
+
+    If it was not built for the current peak data yet, it is built in a background thread and nullptr is returned
+    in the meantime. @p on_ready is called (from the background thread!) once it is available.
+    */
+    std::shared_ptr<const IntensityPyramid> getIntensityPyramid(const std::function<void()>& on_ready) const;
 
     /// Set the current on-disc data
-    void setOnDiscPeakData(ODExperimentSharedPtrType p)
-    {
-      on_disc_peaks_ = p;
-    }
+    void setOnDiscPeakData(ODExperimentSharedPtrType p);
 
     /// Returns a mutable reference to the on-disc data
     const ODExperimentSharedPtrType& getOnDiscPeakData() const
@@ -192,6 +192,28 @@ namespace OpenMS
 
     /// on disc peak data
     ODExperimentSharedPtrType on_disc_peaks_ = ODExperimentSharedPtrType(new OnDiscMSExperiment());
+
+    /// Creates the cache of recently used spectra of @p on_disc
+    static std::shared_ptr<SpectrumCache> createSpectrumCache_(const ODExperimentSharedPtrType& on_disc);
+
+    /// recently used spectra read from on_disc_peaks_
+    std::shared_ptr<SpectrumCache> spectrum_cache_ = createSpectrumCache_(on_disc_peaks_);
+
+    /// The intensity pyramid and its background build (shared by copies of the layer, which share the peak data)
+    struct PyramidCache
+    {
+      ~PyramidCache();
+      /// Cancels (and waits for) a running build and discards the pyramid
+      void reset();
+
+      std::mutex mutex;
+      std::shared_ptr<const IntensityPyramid> pyramid; ///< nullptr while building
+      const ExperimentType* source = nullptr; ///< the data the pyramid is built from
+      UInt64 source_size = 0; ///< number of peaks of the data (to detect modifications)
+      std::shared_ptr<std::atomic<bool>> cancel; ///< cancels the running build
+      std::shared_future<void> done; ///< ready when the running build has finished
+    };
+    std::shared_ptr<PyramidCache> pyramid_cache_ = std::make_shared<PyramidCache>();
   };
 
 }// namespace OpenMS
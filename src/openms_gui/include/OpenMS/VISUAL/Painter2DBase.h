@@ -25,6 +25,7 @@ class String;
 namespace OpenMS
 {
   class ConsensusFeature;
+  class IntensityPyramid;
   class LayerDataChrom;
   class LayerDataConsensus;
   class LayerDataFeature;
@@ -115,6 +116,15 @@ namespace OpenMS
     */
     void paintMaximumIntensities_(QPainter& painter, Plot2DCanvas* canvas, Size layer_index, Size rt_pixel_count, Size mz_pixel_count);
 
+    /**
+      @brief Paints the maximum intensity of each pixel from the intensity pyramid of the layer (see IntensityPyramid)
+
+      Same result as paintMaximumIntensities_() (up to tile boundaries), but the cost only depends on the number of pixels.
+
+      @return false if no level of the pyramid is fine enough for the current view (nothing was painted)
+    */
+    bool paintPyramidIntensities_(Plot2DCanvas* canvas, const IntensityPyramid& pyramid, Size layer_index, Size rt_pixel_count, Size mz_pixel_count);
+
 
     /**
       @brief Paints the locations where MS2 scans where triggered
@@ -89,14 +89,39 @@ protected:
     void qglColor_(const QColor& color);
     ///helper function to replicate old behaviour of QGLWidget
     void qglClearColor_(const QColor& clearColor);
-    /// Builds up a display list for the 3D view
-    GLuint makeDataAsStick_();
+    /// Vertex of the peak data (position and color, interleaved in the vertex buffer)
+    struct PeakVertex
+    {
+      GLfloat position[3];
+      GLubyte color[4];
+    };
+
+    /// Vertices in the peak buffer which are drawn together, with the same settings (one per layer)
+    struct PeakBatch
+    {
+      GLenum mode = GL_LINES; ///< GL_LINES (sticks) or GL_POINTS (top view)
+      GLfloat size = 1.0f; ///< line width or point size
+      bool smooth = false; ///< smooth (or flat) shading
+      GLint first = 0; ///< first vertex
+      GLsizei count = 0; ///< number of vertices
+    };
+
+    /// Fills the peak buffer with sticks for the 3D view
+    void makeDataAsStick_();
     /// Builds up a display list for the axes
     GLuint makeAxes_();
     /// Builds up a display list for axis ticks
     GLuint makeAxesTicks_();
-    /// Builds up a display list for the birds-eye view
-    GLuint makeDataAsTopView_();
+    /// Fills the peak buffer with points for the birds-eye view
+    void makeDataAsTopView_();
+    /// Uploads @p vertices to the peak buffer (created on first use)
+    void uploadPeakData_(const std::vector<PeakVertex>& vertices);
+    /// Draws the batches of the peak buffer
+    void drawPeakData_();
+    /// Vertex at the given position with the given color
+    static PeakVertex makePeakVertex_(double x, double y, double z, const QColor& color);
+    /// Color of a peak with intensity @p intensity of layer @p layer (with index @p layer_index), depending on the intensity mode
+    QColor peakColor_(const LayerDataBase& layer, float intensity, Size layer_index);
     /// Builds up a display list for the background
     GLuint makeGround_();
     /// Builds up a display list for grid lines
@@ -136,9 +161,12 @@ protected:
     /// restores the original rotation and zoom factor (e.g. before changing into zoom mode)
     void restoreRotationAndZoom();
 
+    /// vertex buffer object with the peak data (sticks or top view), drawn in batches
+    GLuint peak_buffer_ = 0;
+    std::vector<PeakBatch> peak_batches_;
+
     /** @name Different OpenGL display lists */
     //@{
-    GLuint stickdata_;
     GLuint axes_;
     GLuint axes_ticks_;
     GLuint gridlines_;
@@ -0,0 +1,120 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/VISUAL/OpenMS_GUIConfig.h>
+
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <QAbstractItemModel>
+#include <QStringList>
+
+#include <boost/shared_ptr.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Item model of the spectra of a PeakMap, for SpectraTreeTab
+
+    Spectra of higher MS levels are shown as children of the preceding spectrum of the level below
+    (e.g. MS2 spectra below their MS1 spectrum). If the MS levels do not allow for such a tree (e.g. an MS3
+    spectrum directly after an MS1 spectrum), a flat list is shown instead.
+
+    Only the tree structure (a few integers per spectrum) is computed when the data is set. The content of the
+    rows is taken from the spectra when a view asks for it, i.e. only for the visible rows. This keeps showing
+    maps with hundreds of thousands of spectra fast and cheap, as opposed to a QTreeWidget, which needs an item
+    for every spectrum up front.
+
+    @ingroup PlotWidgets
+  */
+  class OPENMS_GUI_DLLAPI SpectraTreeModel :
+    public QAbstractItemModel
+  {
+    Q_OBJECT
+public:
+    /// The columns
+    enum Column
+    {
+      MS_LEVEL, SPEC_INDEX, RT, PRECURSOR_MZ, DISSOCIATION, SCANTYPE, ZOOM, /* last entry --> */ SIZE_OF_COLUMNS
+    };
+
+    /// Names of the columns (same order as Column)
+    static const QStringList HEADER_NAMES;
+
+    /// Constructor
+    explicit SpectraTreeModel(QObject* parent = nullptr);
+
+    /// Shows the spectra of @p exp (nullptr for none)
+    void setExperiment(const boost::shared_ptr<const MSExperiment>& exp);
+
+    /// The data shown
+    const MSExperiment* getExperiment() const;
+
+    /// Index of the spectrum represented by @p index (or -1 if @p index is invalid)
+    int getSpectrumIndex(const QModelIndex& index) const;
+
+    /// Model index (of column @p column) of the spectrum with index @p spectrum_index (invalid if there is no such spectrum)
+    QModelIndex indexOfSpectrum(Size spectrum_index, int column = 0) const;
+
+    /**
+      @brief Finds the first spectrum (by index) whose text in column @p column matches @p text (case insensitive)
+
+      @param text The text to search
+      @param column The column to search in
+      @param exact Does the whole text need to match (otherwise the text of the column only needs to start with @p text)?
+      @return The model index of the first match (invalid if there is none)
+    */
+    QModelIndex findSpectrum(const QString& text, int column, bool exact) const;
+
+    /// Was a flat list used, since the MS levels of the spectra do not form a tree?
+    bool isFlat() const;
+
+    /// @name Reimplemented from QAbstractItemModel
+    //@{
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& index) const override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+    //@}
+
+protected:
+    /// Computes the tree structure from the MS levels (returns false if they do not form a tree)
+    bool buildTree_();
+
+    /// Computes a flat list
+    void buildFlat_();
+
+    /// Fills roots_, child_offsets_, children_ and row_ from parent_
+    void indexChildren_();
+
+    /// Value of column @p column of spectrum @p spectrum_index for display
+    QVariant displayData_(Size spectrum_index, int column) const;
+
+    /// marks spectra without parent
+    static constexpr Size NO_PARENT = std::numeric_limits<Size>::max();
+
+    boost::shared_ptr<const MSExperiment> exp_;
+    bool flat_ = true;
+    /// parent of each spectrum (or NO_PARENT)
+    std::vector<Size> parent_;
+    /// row of each spectrum below its parent
+    std::vector<int> row_;
+    /// spectra without parent
+    std::vector<Size> roots_;
+    /// children of spectrum i are children_[child_offsets_[i] .. child_offsets_[i + 1])
+    std::vector<Size> child_offsets_;
+    std::vector<Size> children_;
+  };
+}
@@ -16,15 +16,21 @@
 
 class QLineEdit;
 class QComboBox;
+class QModelIndex;
+class QTreeView;
 class QTreeWidget;
 class QTreeWidgetItem;
 
 namespace OpenMS
 {
+  class SpectraTreeModel;
   class TreeView;
   /**
     @brief Hierarchical visualization and selection of spectra.
 
+    Spectra are shown using a SpectraTreeModel (which creates rows only when they are shown, so large maps are
+    displayed instantly), chromatograms are grouped by precursor in a TreeView.
+
     @ingroup PlotWidgets
   */
   class OPENMS_GUI_DLLAPI SpectraTreeTab :
@@ -68,13 +74,22 @@ signals:
 private:
     QLineEdit* spectra_search_box_ = nullptr;
     QComboBox* spectra_combo_box_ = nullptr;
+    /// shows chromatograms
     TreeView* spectra_treewidget_ = nullptr;
+    /// shows spectra (of spectra_model_)
+    QTreeView* spectra_treeview_ = nullptr;
+    SpectraTreeModel* spectra_model_ = nullptr;
     LayerDataBase* layer_ = nullptr;
     /// cache to store mapping of chromatogram precursors to chromatogram indices
     std::map<size_t, std::map<Precursor, std::vector<Size>, Precursor::MZLess> > map_precursor_to_chrom_idx_cache_;
     /// remember the last PeakMap that we used to fill the spectra list (and avoid rebuilding it)
     const PeakMap* last_peakmap_ = nullptr;
 
+    /// are spectra (and not chromatograms) shown?
+    bool showsSpectra_() const;
+    /// show either the spectra or the chromatogram view
+    void showSpectraView_(bool spectra);
+
 private slots:
 
     /// fill the search-combo-box with current column header names
@@ -89,6 +104,12 @@ private slots:
     void itemDoubleClicked_(QTreeWidgetItem *); 
     /// Display context menu; allows to open metadata window
     void spectrumContextMenu_(const QPoint &);
+    /// emits spectrumSelected() for the spectrum at @p current
+    void spectrumSelectionChange_(const QModelIndex& current, const QModelIndex& previous);
+    /// emits spectrumDoubleClicked() for the spectrum at @p index
+    void spectrumDoubleClicked_(const QModelIndex& index);
+    /// Display context menu of the spectra view; allows to open metadata window
+    void spectrumViewContextMenu_(const QPoint &);
   };
 }
 
@@ -0,0 +1,85 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/VISUAL/OpenMS_GUIConfig.h>
+
+#include <OpenMS/KERNEL/MSSpectrum.h>
+
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace OpenMS
+{
+  /**
+    @brief Keeps the most recently used spectra of an on-disc map in memory
+
+    Spectra are read on demand by a loader function (e.g. from an OnDiscMSExperiment) and kept
+    until @p capacity other spectra have been requested since their last use (least recently used first).
+    This allows showing spectra of maps which do not fit into memory (e.g. in the 1D view), while
+    browsing back and forth does not read the same spectra from disk again.
+
+    All functions are thread-safe. The loader is only called by one thread at a time.
+
+    @ingroup Visual
+  */
+  class OPENMS_GUI_DLLAPI SpectrumCache
+  {
+public:
+    /// Reads the spectrum with the given index
+    using Loader = std::function<MSSpectrum(Size)>;
+
+    /**
+      @brief Constructor
+
+      @param loader Reads the spectra
+      @param capacity Maximum number of spectra kept in memory (at least one spectrum is kept)
+    */
+    explicit SpectrumCache(const Loader& loader, Size capacity = 64);
+
+    /**
+      @brief Returns the spectrum with index @p index, reading it if it is not in memory
+
+      The reference remains valid until @p capacity other spectra have been requested (or clear() is called).
+
+      @throw Exception::BaseException (or derived) if the loader throws; the cache is not modified then
+    */
+    const MSSpectrum& getSpectrum(Size index);
+
+    /// Is the spectrum with index @p index in memory?
+    bool contains(Size index) const;
+
+    /// Number of spectra in memory
+    Size size() const;
+
+    /// Maximum number of spectra kept in memory
+    Size getCapacity() const;
+
+    /// Sets the maximum number of spectra kept in memory (the least recently used ones are discarded if there are more)
+    void setCapacity(Size capacity);
+
+    /// Discards all spectra
+    void clear();
+
+protected:
+    /// Discards the least recently used spectra until not more than capacity_ are left (mutex_ must be locked)
+    void shrink_();
+
+    Loader loader_;
+    Size capacity_;
+    /// the spectra, most recently used first
+    std::list<std::pair<Size, MSSpectrum>> entries_;
+    /// spectrum index -> entry
+    std::unordered_map<Size, std::list<std::pair<Size, MSSpectrum>>::iterator> index_;
+    mutable std::mutex mutex_;
+  };
+}
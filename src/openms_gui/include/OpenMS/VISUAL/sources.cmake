@@ -17,6 +17,7 @@ GUIProgressLoggerImpl.h
 HistogramWidget.h
 InputFile.h
 InputFileList.h
+IntensityPyramid.h
 LayerListView.h
 LayerData1DBase.h
 LayerData1DChrom.h
@@ -49,8 +50,10 @@ PlotCanvas.h
 PlotWidget.h
 RecentFilesMenu.h
 SequenceVisualizer.h
+SpectraTreeModel.h
 SpectraTreeTab.h
 SpectraIDViewTab.h
+SpectrumCache.h
 SwathLibraryStats.h
 TableView.h
 TOPPASEdge.h
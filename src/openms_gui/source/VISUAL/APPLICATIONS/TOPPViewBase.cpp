@@ -674,13 +674,21 @@ namespace OpenMS
 
             peak_map_sptr = on_disc_peaks->getMetaData();
 
+            // (read and decode the MS1 spectra in parallel; all other spectra are read on demand,
+            // see LayerDataPeak::getSpectrum())
+            std::vector<Size> ms1_indices;
             for (Size k = 0; k < indexed_mzml_file.getNrSpectra() && !cache_ms1_on_disc; k++)
             {
               if ( peak_map_sptr->getSpectrum(k).getMSLevel() == 1)
               {
-                peak_map_sptr->getSpectrum(k) = on_disc_peaks->getSpectrum(k);
+                ms1_indices.push_back(k);
               }
             }
+            std::vector<MSSpectrum> ms1_spectra = on_disc_peaks->getSpectra(ms1_indices);
+            for (Size i = 0; i < ms1_indices.size(); ++i)
+            {
+              peak_map_sptr->getSpectrum(ms1_indices[i]) = std::move(ms1_spectra[i]);
+            }
             for (Size k = 0; k < indexed_mzml_file.getNrChromatograms() && !cache_ms2_on_disc; k++)
             {
               peak_map_sptr->getChromatogram(k) = on_disc_peaks->getChromatogram(k);
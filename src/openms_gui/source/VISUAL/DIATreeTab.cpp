@@ -112,6 +112,8 @@ namespace OpenMS
     spectra_widget_layout->addLayout(tmp_hbox_layout);
   }
 
+  DIATreeTab::~DIATreeTab() = default;
+
   /// adds a subtree (with peptides ...) to a given protein 
   void fillProt(const OSWProtein& prot, QTreeWidgetItem* item_prot)
   {
@@ -199,9 +201,14 @@ namespace OpenMS
     case OSWHierarchy::Level::PROTEIN:
       if (item->childCount() == 0)
       { // no peptides... load them
-        OSWFile f(current_data_->getSqlSourceFile());
-        f.readProtein(*current_data_, tr.idx_prot);
+        if (osw_file_ == nullptr)
+        { // keep the file open: its lookup indices are built on first use
+          osw_file_ = std::make_unique<OSWFile>(current_data_->getSqlSourceFile());
+        }
+        osw_file_->readProtein(*current_data_, tr.idx_prot);
         fillProt(current_data_->getProteins()[tr.idx_prot], item);
+        // the user is likely to browse to the neighbouring proteins next
+        osw_file_->prefetchProteins(*current_data_, {Size(tr.idx_prot + 1), Size(tr.idx_prot - 1)}); // an index of -1 is out of range, i.e. ignored
       }
       // do nothing else -- showing all transitions for a protein is overwhelming...      
       break;
@@ -283,6 +290,7 @@ namespace OpenMS
 
     // update last data pointer
     current_data_ = data;
+    osw_file_.reset(); // opened on demand for the new data
 
     dia_treewidget_->blockSignals(true);
     RAIICleanup clean([&]() { dia_treewidget_->blockSignals(false); });
@@ -328,6 +336,7 @@ namespace OpenMS
     dia_treewidget_->clear();
     spectra_combo_box_->clear();
     current_data_ = nullptr;
+    osw_file_.reset();
   }
 
 }
@@ -0,0 +1,213 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/VISUAL/IntensityPyramid.h>
+
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+namespace OpenMS
+{
+  namespace
+  {
+    /// largest power of two which is not larger than @p n (n > 0)
+    Size floorPowerOfTwo_(Size n)
+    {
+      Size p = 1;
+      while (p * 2 <= n)
+      {
+        p *= 2;
+      }
+      return p;
+    }
+
+    /// tile of @p x within @p tiles equally spaced tiles in [min, max]
+    Size tileIndex_(double x, double min, double max, Size tiles)
+    {
+      if (max <= min)
+      {
+        return 0;
+      }
+      return std::min(tiles - 1, Size(std::max(0.0, (x - min) / (max - min) * tiles)));
+    }
+  }
+
+  IntensityPyramid::IntensityPyramid(const MSExperiment& exp, UInt ms_level, Size max_tiles, const std::atomic<bool>* cancel)
+  {
+    // data range
+    Size n_scans(0);
+    min_rt_ = min_mz_ = std::numeric_limits<double>::max();
+    max_rt_ = max_mz_ = std::numeric_limits<double>::lowest();
+    for (const MSSpectrum& spec : exp)
+    {
+      if (spec.getMSLevel() != ms_level || spec.empty())
+      {
+        continue;
+      }
+      ++n_scans;
+      min_rt_ = std::min(min_rt_, spec.getRT());
+      max_rt_ = std::max(max_rt_, spec.getRT());
+      min_mz_ = std::min(min_mz_, spec.front().getMZ());
+      max_mz_ = std::max(max_mz_, spec.back().getMZ());
+    }
+    if (n_scans == 0 || max_tiles == 0)
+    {
+      min_rt_ = max_rt_ = min_mz_ = max_mz_ = 0.0;
+      return;
+    }
+
+    // finest level
+    Level level;
+    level.rt_tiles = floorPowerOfTwo_(std::min(max_tiles, n_scans));
+    level.mz_tiles = floorPowerOfTwo_(max_tiles);
+    level.max_intensity.assign(level.rt_tiles * level.mz_tiles, -1.0f);
+    level.sum_intensity.assign(level.rt_tiles * level.mz_tiles, 0.0f);
+    for (const MSSpectrum& spec : exp)
+    {
+      if (cancel != nullptr && *cancel)
+      {
+        levels_.clear();
+        return;
+      }
+      if (spec.getMSLevel() != ms_level)
+      {
+        continue;
+      }
+      const Size row = tileIndex_(spec.getRT(), min_rt_, max_rt_, level.rt_tiles) * level.mz_tiles;
+      for (const Peak1D& p : spec)
+      {
+        const Size index = row + tileIndex_(p.getMZ(), min_mz_, max_mz_, level.mz_tiles);
+        level.max_intensity[index] = std::max(level.max_intensity[index], p.getIntensity());
+        level.sum_intensity[index] += p.getIntensity();
+      }
+    }
+    levels_.push_back(std::move(level));
+
+    // merge 2x2 tiles until a single tile is left
+    while (levels_.back().rt_tiles > 1 || levels_.back().mz_tiles > 1)
+    {
+      const Level& fine = levels_.back();
+      Level coarse;
+      coarse.rt_tiles = std::max(Size(1), fine.rt_tiles / 2);
+      coarse.mz_tiles = std::max(Size(1), fine.mz_tiles / 2);
+      coarse.max_intensity.assign(coarse.rt_tiles * coarse.mz_tiles, -1.0f);
+      coarse.sum_intensity.assign(coarse.rt_tiles * coarse.mz_tiles, 0.0f);
+      const Size rt_factor = fine.rt_tiles / coarse.rt_tiles;
+      const Size mz_factor = fine.mz_tiles / coarse.mz_tiles;
+      for (Size rt = 0; rt < fine.rt_tiles; ++rt)
+      {
+        for (Size mz = 0; mz < fine.mz_tiles; ++mz)
+        {
+          const Size from = rt * fine.mz_tiles + mz;
+          const Size to = (rt / rt_factor) * coarse.mz_tiles + mz / mz_factor;
+          coarse.max_intensity[to] = std::max(coarse.max_intensity[to], fine.max_intensity[from]);
+          coarse.sum_intensity[to] += fine.sum_intensity[from];
+        }
+      }
+      levels_.push_back(std::move(coarse));
+    }
+  }
+
+  bool IntensityPyramid::empty() const
+  {
+    return levels_.empty();
+  }
+
+  Size IntensityPyramid::size() const
+  {
+    return levels_.size();
+  }
+
+  const IntensityPyramid::Level& IntensityPyramid::getLevel(Size level) const
+  {
+    return levels_[level];
+  }
+
+  double IntensityPyramid::getMinRT() const
+  {
+    return min_rt_;
+  }
+
+  double IntensityPyramid::getMaxRT() const
+  {
+    return max_rt_;
+  }
+
+  double IntensityPyramid::getMinMZ() const
+  {
+    return min_mz_;
+  }
+
+  double IntensityPyramid::getMaxMZ() const
+  {
+    return max_mz_;
+  }
+
+  Size IntensityPyramid::selectLevel(double rt_span, double mz_span, Size rt_pixels, Size mz_pixels) const
+  {
+    if (rt_pixels == 0 || mz_pixels == 0)
+    {
+      return size();
+    }
+    const double rt_pixel = rt_span / rt_pixels;
+    const double mz_pixel = mz_span / mz_pixels;
+    for (Size i = size(); i > 0; --i)
+    {
+      const Level& level = levels_[i - 1];
+      if ((max_rt_ - min_rt_) / level.rt_tiles <= rt_pixel && (max_mz_ - min_mz_) / level.mz_tiles <= mz_pixel)
+      {
+        return i - 1;
+      }
+    }
+    return size();
+  }
+
+  IntensityPyramid::TileRange IntensityPyramid::getTiles_(double min, double max, Size tiles, double start, double end)
+  {
+    if (max <= min) // all data in one tile
+    {
+      return (start <= min && min < end) ? TileRange(0, tiles) : TileRange(0, 0);
+    }
+    const double width = (max - min) / tiles;
+    const double first = std::floor((start - min) / width);
+    const double last = std::ceil((end - min) / width);
+    const Size first_tile = Size(std::clamp(first, 0.0, double(tiles)));
+    const Size last_tile = Size(std::clamp(last, 0.0, double(tiles)));
+    return TileRange(first_tile, std::max(first_tile, last_tile));
+  }
+
+  IntensityPyramid::TileRange IntensityPyramid::getRTTiles(Size level, double rt_start, double rt_end) const
+  {
+    return getTiles_(min_rt_, max_rt_, levels_[level].rt_tiles, rt_start, rt_end);
+  }
+
+  IntensityPyramid::TileRange IntensityPyramid::getMZTiles(Size level, double mz_start, double mz_end) const
+  {
+    return getTiles_(min_mz_, max_mz_, levels_[level].mz_tiles, mz_start, mz_end);
+  }
+
+  float IntensityPyramid::getMaxIntensity(Size level, const TileRange& rt_tiles, const TileRange& mz_tiles) const
+  {
+    const Level& l = levels_[level];
+    float max = -1.0f;
+    for (Size rt = rt_tiles.first; rt < rt_tiles.second; ++rt)
+    {
+      const float* row = l.max_intensity.data() + rt * l.mz_tiles;
+      for (Size mz = mz_tiles.first; mz < mz_tiles.second; ++mz)
+      {
+        max = std::max(max, row[mz]);
+      }
+    }
+    return max;
+  }
+}
@@ -11,13 +11,17 @@
 #include <OpenMS/ANALYSIS/ID/IDMapper.h>
 
 #include <OpenMS/VISUAL/ANNOTATION/Annotation1DPeakItem.h>
+#include <OpenMS/VISUAL/IntensityPyramid.h>
 #include <OpenMS/VISUAL/LayerData1DIonMobility.h>
 #include <OpenMS/VISUAL/LayerData1DChrom.h>
 #include <OpenMS/VISUAL/LayerData1DPeak.h>
 #include <OpenMS/VISUAL/Painter2DBase.h>
+#include <OpenMS/VISUAL/SpectrumCache.h>
 #include <OpenMS/VISUAL/VISITORS/LayerStatistics.h>
 #include <OpenMS/VISUAL/VISITORS/LayerStoreData.h>
 
+#include <thread>
+
 using namespace std;
 
 namespace OpenMS
@@ -282,4 +286,111 @@ namespace OpenMS
     return boost::static_pointer_cast<const ExperimentType>(peak_map_);
   }
 
+  const LayerDataBase::ExperimentSharedPtrType& LayerDataPeak::getPeakDataMuteable()
+  {
+    // the background build must not read the data while it is modified
+    pyramid_cache_->reset();
+    return peak_map_;
+  }
+
+  void LayerDataPeak::setPeakData(ExperimentSharedPtrType p)
+  {
+    peak_map_ = p;
+  }
+
+  const LayerDataPeak::ExperimentType::SpectrumType& LayerDataPeak::getSpectrum(Size spectrum_idx) const
+  {
+    if ((*peak_map_)[spectrum_idx].size() > 0 || on_disc_peaks_->empty())
+    {
+      return (*peak_map_)[spectrum_idx];
+    }
+    return spectrum_cache_->getSpectrum(spectrum_idx);
+  }
+
+  void LayerDataPeak::setOnDiscPeakData(ODExperimentSharedPtrType p)
+  {
+    on_disc_peaks_ = p;
+    spectrum_cache_ = createSpectrumCache_(on_disc_peaks_);
+  }
+
+  std::shared_ptr<SpectrumCache> LayerDataPeak::createSpectrumCache_(const ODExperimentSharedPtrType& on_disc)
+  {
+    return std::make_shared<SpectrumCache>([on_disc](Size index) { return on_disc->getSpectrum(index); });
+  }
+
+  std::shared_ptr<const IntensityPyramid> LayerDataPeak::getIntensityPyramid(const std::function<void()>& on_ready) const
+  {
+    std::lock_guard<std::mutex> lock(pyramid_cache_->mutex);
+    PyramidCache& cache = *pyramid_cache_;
+    if (cache.source == peak_map_.get() && cache.source_size == peak_map_->getSize())
+    {
+      return cache.pyramid;
+    }
+
+    // (re)build for the current data; an outdated build is cancelled (its data is kept alive by its thread)
+    if (cache.cancel)
+    {
+      *cache.cancel = true;
+    }
+    cache.pyramid.reset();
+    cache.source = peak_map_.get();
+    cache.source_size = peak_map_->getSize();
+    cache.cancel = std::make_shared<std::atomic<bool>>(false);
+    std::promise<void> done;
+    cache.done = done.get_future().share();
+
+    std::weak_ptr<PyramidCache> weak_cache = pyramid_cache_;
+    std::thread([data = peak_map_, weak_cache, cancel = cache.cancel, done = std::move(done), on_ready]() mutable
+    {
+      auto pyramid = std::make_shared<const IntensityPyramid>(*data, 1, 4096, cancel.get());
+      bool published = false;
+      {
+        std::shared_ptr<PyramidCache> owner = weak_cache.lock();
+        if (owner)
+        {
+          std::lock_guard<std::mutex> lock(owner->mutex);
+          if (owner->cancel == cancel && !*cancel)
+          {
+            owner->pyramid = pyramid;
+            published = true;
+          }
+        }
+        // before releasing the cache: its destructor waits for this
+        done.set_value();
+      }
+      if (published && on_ready)
+      {
+        on_ready();
+      }
+    }).detach();
+    return nullptr;
+  }
+
+  LayerDataPeak::PyramidCache::~PyramidCache()
+  {
+    reset();
+  }
+
+  void LayerDataPeak::PyramidCache::reset()
+  {
+    std::shared_future<void> running;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (cancel)
+      {
+        *cancel = true;
+      }
+      running = done;
+      pyramid.reset();
+      source = nullptr;
+      source_size = 0;
+      cancel.reset();
+      done = std::shared_future<void>();
+    }
+    if (running.valid())
+    {
+      running.wait();
+    }
+  }
+
 } // namespace OpenMS
\ No newline at end of file
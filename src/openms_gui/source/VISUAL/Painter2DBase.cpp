@@ -12,6 +12,7 @@
 #include <OpenMS/DATASTRUCTURES/String.h>
 #include <OpenMS/MATH/MathFunctions.h>
 
+#include <OpenMS/VISUAL/IntensityPyramid.h>
 #include <OpenMS/VISUAL/LayerDataChrom.h>
 #include <OpenMS/VISUAL/LayerDataConsensus.h>
 #include <OpenMS/VISUAL/LayerDataIdent.h>
@@ -22,8 +23,10 @@
 #include <OpenMS/VISUAL/Plot2DCanvas.h>
 
 #include <QColor>
+#include <QCoreApplication>
 #include <QPainter>
 #include <QPoint>
+#include <QPointer>
 
 using namespace std;
 
@@ -347,6 +350,26 @@ namespace OpenMS
     const auto& map = *layer_->getPeakData();
     const auto& area = canvas->visible_area_.getAreaUnit();
 
+    // RT/m/z data without filters: use the precomputed tiles (once they are built in the background)
+    if (!map.isIMFrame() && !layer_->filters.isActive())
+    {
+      QPointer<Plot2DCanvas> target(canvas);
+      auto pyramid = layer_->getIntensityPyramid([target]() {
+        // called from the building thread: repaint in the GUI thread
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [target]() {
+          if (target)
+          {
+            target->update_buffer_ = true;
+            target->update();
+          }
+        }, Qt::QueuedConnection);
+      });
+      if (pyramid && paintPyramidIntensities_(canvas, *pyramid, layer_index, rt_pixel_count, mz_pixel_count))
+      {
+        return;
+      }
+    }
+
     // for IM data, use whatever is there. For RT/mz data, use MSlevel 1
     const UInt MS_LEVEL = (! map.empty() && map.isIMFrame()) ? map[0].getMSLevel() : 1;
 
@@ -449,6 +472,60 @@ namespace OpenMS
     }
   }
 
+  bool Painter2DPeak::paintPyramidIntensities_(Plot2DCanvas* canvas, const IntensityPyramid& pyramid, Size layer_index, Size rt_pixel_count, Size mz_pixel_count)
+  {
+    const auto& area = canvas->visible_area_.getAreaUnit();
+    const double rt_min = area.getMinRT();
+    const double rt_max = area.getMaxRT();
+    const double mz_min = area.getMinMZ();
+    const double mz_max = area.getMaxMZ();
+    const Size level = pyramid.selectLevel(rt_max - rt_min, mz_max - mz_min, rt_pixel_count, mz_pixel_count);
+    if (level == pyramid.size())
+    {
+      return false;
+    }
+    const double snap_factor = canvas->snap_factors_[layer_index];
+
+    // calculate pixel size in data coordinates
+    double rt_step_size = (rt_max - rt_min) / rt_pixel_count;
+    double mz_step_size = (mz_max - mz_min) / mz_pixel_count;
+
+    // the m/z tiles of a pixel are the same for all RT pixels
+    std::vector<IntensityPyramid::TileRange> mz_tiles(mz_pixel_count);
+    for (Size mz = 0; mz < mz_pixel_count; ++mz)
+    {
+      double mz_start = mz_min + mz_step_size * mz;
+      mz_tiles[mz] = pyramid.getMZTiles(level, mz_start, mz_start + mz_step_size);
+    }
+
+    for (Size rt = 0; rt < rt_pixel_count; ++rt)
+    {
+      double rt_start = rt_min + rt_step_size * rt;
+      // reached the end of data
+      if (rt_start > pyramid.getMaxRT())
+      {
+        break;
+      }
+      const IntensityPyramid::TileRange rt_tiles = pyramid.getRTTiles(level, rt_start, rt_start + rt_step_size);
+      if (rt_tiles.first == rt_tiles.second)
+      {
+        continue;
+      }
+      for (Size mz = 0; mz < mz_pixel_count; ++mz)
+      {
+        float max = pyramid.getMaxIntensity(level, rt_tiles, mz_tiles[mz]);
+        // draw to buffer
+        if (max >= 0.0)
+        {
+          double mz_start = mz_min + mz_step_size * mz;
+          QPoint pos = canvas->dataToWidget_(canvas->unit_mapper_.map(Peak2D({rt_start + 0.5 * rt_step_size, mz_start + 0.5 * mz_step_size}, 0)));
+          canvas->buffer_.setPixel(pos.x(), pos.y(), canvas->heightColor_(max, layer_->gradient, snap_factor).rgb());
+        }
+      }
+    }
+    return true;
+  }
+
   void Painter2DPeak::paintPrecursorPeaks_(QPainter& painter, Plot2DCanvas* canvas)
   {
     const auto& peak_map = *layer_->getPeakData();
@@ -16,6 +16,10 @@
 
 #include <QMouseEvent>
 
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
 using std::cout;
 using std::endl;
 using std::max;
@@ -47,7 +51,15 @@ namespace OpenMS
     trans_y_ = 0.0;
   }
 
-  Plot3DOpenGLCanvas::~Plot3DOpenGLCanvas() = default;
+  Plot3DOpenGLCanvas::~Plot3DOpenGLCanvas()
+  {
+    if (peak_buffer_ != 0)
+    {
+      makeCurrent();
+      glDeleteBuffers(1, &peak_buffer_);
+      doneCurrent();
+    }
+  }
 
   void Plot3DOpenGLCanvas::calculateGridLines_()
   {
@@ -187,16 +199,7 @@ namespace OpenMS
         zrot_ = 0;
         zoom_ = 1.25;
 
-        if (stickdata_ != 0)
-        {
-          glDeleteLists(stickdata_, 1);
-#ifdef DEBUG_TOPPVIEW
-          cout << "BEGIN " << OPENMS_PRETTY_FUNCTION << endl;
-          std::cout << "Deleting sticklist near makeDataAsTopView" << std::endl;
-#endif
-        }
-
-        stickdata_ = makeDataAsTopView_();
+        makeDataAsTopView_();
         axes_ticks_ = makeAxesTicks_();
         //drawAxesLegend_();
       }
@@ -211,16 +214,7 @@ namespace OpenMS
       x_2_ = 0.0;
       y_2_ = 0.0;
 
-      if (stickdata_ != 0)
-      {
-        glDeleteLists(stickdata_, 1);
-#ifdef DEBUG_TOPPVIEW
-        cout << "BEGIN " << OPENMS_PRETTY_FUNCTION << endl;
-        std::cout << "Deleting sticklist near makeDataAsTopView" << std::endl;
-#endif
-      }
-
-      stickdata_ =  makeDataAsStick_();
+      makeDataAsStick_();
       axes_ticks_ = makeAxesTicks_();
       //drawAxesLegend_();
     }
@@ -275,7 +269,7 @@ namespace OpenMS
       if (canvas_3d_.action_mode_ == PlotCanvas::AM_ZOOM 
        || canvas_3d_.action_mode_ == PlotCanvas::AM_TRANSLATE)
       {
-        glCallList(stickdata_);
+        drawPeakData_();
       }
 
       // draw axes legend
@@ -505,209 +499,202 @@ namespace OpenMS
     return list;
   }
 
-  GLuint Plot3DOpenGLCanvas::makeDataAsTopView_()
+  namespace
   {
-    GLuint list = glGenLists(1);
-    glNewList(list, GL_COMPILE);
-    glPointSize(3.0);
-
-    for (Size i = 0; i < canvas_3d_.getLayerCount(); ++i)
+    /// a peak to display
+    struct DisplayedPeak
     {
-      const LayerDataPeak& layer = dynamic_cast<LayerDataPeak&>(canvas_3d_.getLayer(i));
-      if (layer.visible)
+      double rt;
+      double mz;
+      float intensity;
+    };
+
+    /**
+      @brief Selects the peaks to display in the given area of the layer
+
+      If there are more than @p max_peaks peaks (which pass the filters of the layer), the area is divided into
+      @p max_peaks cells (in RT and m/z) and only the most intense peak of each cell is kept. Thus, unlike taking
+      every n-th peak, all peaks which stand out are shown.
+    */
+    std::vector<DisplayedPeak> selectDisplayedPeaks_(const LayerDataPeak& layer, const RangeAllType& area, Size max_peaks)
+    {
+      const auto& exp = *layer.getPeakData();
+      auto begin_it = exp.areaBeginConst(area.getMinRT(), area.getMaxRT(), area.getMinMZ(), area.getMaxMZ());
+      auto end_it = exp.areaEndConst();
+      const auto passes = [&](const auto& it) {
+        PeakIndex pi = it.getPeakIndex();
+        return layer.filters.passes(exp[pi.spectrum], pi.peak);
+      };
+
+      std::vector<DisplayedPeak> peaks;
+      const Size count = std::distance(begin_it, end_it);
+      if (count <= max_peaks)
+      {
+        peaks.reserve(count);
+        for (auto it = begin_it; it != end_it; ++it)
+        {
+          if (passes(it))
+          {
+            peaks.push_back({it.getRT(), it->getMZ(), it->getIntensity()});
+          }
+        }
+        return peaks;
+      }
+
+      // the most intense peak of each cell (intensity < 0: empty cell)
+      const Size cells_per_dim = std::max(Size(1), Size(std::sqrt(double(max_peaks))));
+      std::vector<DisplayedPeak> cells(cells_per_dim * cells_per_dim, DisplayedPeak{0.0, 0.0, -1.0f});
+      const double rt_span = std::max(area.RangeRT::getSpan(), std::numeric_limits<double>::min());
+      const double mz_span = std::max(area.RangeMZ::getSpan(), std::numeric_limits<double>::min());
+      for (auto it = begin_it; it != end_it; ++it)
       {
-        if ((Int)layer.param.getValue("dot:shade_mode"))
+        if (!passes(it))
         {
-          glShadeModel(GL_SMOOTH);
+          continue;
         }
-        else
+        const Size rt_cell = std::min(cells_per_dim - 1, Size(std::max(0.0, (it.getRT() - area.getMinRT()) / rt_span * cells_per_dim)));
+        const Size mz_cell = std::min(cells_per_dim - 1, Size(std::max(0.0, (it->getMZ() - area.getMinMZ()) / mz_span * cells_per_dim)));
+        DisplayedPeak& cell = cells[rt_cell * cells_per_dim + mz_cell];
+        if (it->getIntensity() > cell.intensity)
         {
-          glShadeModel(GL_FLAT);
+          cell = {it.getRT(), it->getMZ(), it->getIntensity()};
         }
+      }
+      for (const DisplayedPeak& cell : cells)
+      {
+        if (cell.intensity >= 0.0f)
+        {
+          peaks.push_back(cell);
+        }
+      }
+      return peaks;
+    }
+  }
 
-        const auto area = canvas_3d_.visible_area_.getAreaUnit();
-        auto begin_it = layer.getPeakData()->areaBeginConst(area.getMinRT(), area.getMaxRT(), area.getMinMZ(), area.getMaxMZ());
-        auto end_it = layer.getPeakData()->areaEndConst();
+  Plot3DOpenGLCanvas::PeakVertex Plot3DOpenGLCanvas::makePeakVertex_(double x, double y, double z, const QColor& color)
+  {
+    return PeakVertex{{GLfloat(x), GLfloat(y), GLfloat(z)}, {GLubyte(color.red()), GLubyte(color.green()), GLubyte(color.blue()), GLubyte(color.alpha())}};
+  }
 
-        // count peaks in area
-        int count = std::distance(begin_it, end_it);
+  QColor Plot3DOpenGLCanvas::peakColor_(const LayerDataBase& layer, float intensity, Size layer_index)
+  {
+    switch (canvas_3d_.intensity_mode_)
+    {
+    case PlotCanvas::IM_PERCENTAGE:
+      return layer.gradient.precalculatedColorAt(intensity * 100.0 / canvas_3d_.getMaxIntensity(layer_index));
 
-        int max_displayed_peaks = 10000;
-        int step = 1;
-        if (count > max_displayed_peaks)
-        {
-          step = 1 + count / max_displayed_peaks;
-        }
+    case PlotCanvas::IM_LOG:
+      return layer.gradient.precalculatedColorAt(log10(1 + max(0.0, (double)intensity)));
 
-        for (auto it = begin_it; it != end_it; ++it)
-        {
-          if (step > 1)
-          {
-            for (int i = 0; i < step - 1; ++i)
-            {
-              ++it;
-            }
-          }
-          if (it == end_it)
-          {
-            glEndList();
-            return list;
-          }
+    default: // IM_NONE, IM_SNAP
+      return layer.gradient.precalculatedColorAt(intensity);
+    }
+  }
 
-          PeakIndex pi = it.getPeakIndex();
-          if (layer.filters.passes((*layer.getPeakData())[pi.spectrum], pi.peak))
-          {
-            glBegin(GL_POINTS);
-            double intensity = 0;
-            switch (canvas_3d_.intensity_mode_)
-            {
-            case PlotCanvas::IM_NONE:
-              qglColor_(layer.gradient.precalculatedColorAt(it->getIntensity()));
-              break;
-
-            case PlotCanvas::IM_PERCENTAGE:
-              intensity = it->getIntensity() * 100.0 / canvas_3d_.getMaxIntensity(i);
-              qglColor_(layer.gradient.precalculatedColorAt(intensity));
-              break;
-
-            case PlotCanvas::IM_SNAP:
-              qglColor_(layer.gradient.precalculatedColorAt(it->getIntensity()));
-              break;
-
-            case PlotCanvas::IM_LOG:
-              qglColor_(layer.gradient.precalculatedColorAt(log10(1 + max(0.0, (double)(it->getIntensity())))));
-              break;
-
-            }
-            glVertex3f(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                       -corner_,
-                       -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-            glEnd();
-          }
-        }
+  void Plot3DOpenGLCanvas::makeDataAsTopView_()
+  {
+    std::vector<PeakVertex> vertices;
+    peak_batches_.clear();
+
+    for (Size i = 0; i < canvas_3d_.getLayerCount(); ++i)
+    {
+      const LayerDataPeak& layer = dynamic_cast<LayerDataPeak&>(canvas_3d_.getLayer(i));
+      if (!layer.visible)
+      {
+        continue;
+      }
+      PeakBatch batch;
+      batch.mode = GL_POINTS;
+      batch.size = 3.0f;
+      batch.smooth = ((Int)layer.param.getValue("dot:shade_mode") != 0);
+      batch.first = GLint(vertices.size());
+
+      for (const DisplayedPeak& peak : selectDisplayedPeaks_(layer, canvas_3d_.visible_area_.getAreaUnit(), 100000))
+      {
+        vertices.push_back(makePeakVertex_(-corner_ + scaledMZ_(peak.mz),
+                                           -corner_,
+                                           -near_ - 2 * corner_ - scaledRT_(peak.rt),
+                                           peakColor_(layer, peak.intensity, i)));
       }
+      batch.count = GLsizei(vertices.size() - batch.first);
+      peak_batches_.push_back(batch);
     }
-    glEndList();
-    return list;
+    uploadPeakData_(vertices);
   }
 
-  GLuint Plot3DOpenGLCanvas::makeDataAsStick_()
+  void Plot3DOpenGLCanvas::makeDataAsStick_()
   {
-    GLuint list = glGenLists(1);
-    glNewList(list, GL_COMPILE);
+    std::vector<PeakVertex> vertices;
+    peak_batches_.clear();
 
     for (Size i = 0; i < canvas_3d_.getLayerCount(); i++)
     {
       LayerDataPeak& layer = dynamic_cast<LayerDataPeak&>(canvas_3d_.getLayer(i));
-      if (layer.visible)
+      if (!layer.visible)
       {
-        recalculateDotGradient_(layer);
-
-        if ((Int)layer.param.getValue("dot:shade_mode"))
-        {
-          glShadeModel(GL_SMOOTH);
-        }
-        else
-        {
-          glShadeModel(GL_FLAT);
-        }
-
-        glLineWidth(layer.param.getValue("dot:line_width"));
+        continue;
+      }
+      recalculateDotGradient_(layer);
 
-        const auto area = canvas_3d_.visible_area_.getAreaUnit();
-        auto begin_it = layer.getPeakData()->areaBeginConst(area.getMinRT(), area.getMaxRT(), area.getMinMZ(), area.getMaxMZ());
-        auto end_it = layer.getPeakData()->areaEndConst();
-        // count peaks in area
-        int count = std::distance(begin_it, end_it);
+      PeakBatch batch;
+      batch.mode = GL_LINES;
+      batch.size = layer.param.getValue("dot:line_width");
+      batch.smooth = ((Int)layer.param.getValue("dot:shade_mode") != 0);
+      batch.first = GLint(vertices.size());
 
-        int max_displayed_peaks = 100000;
-        int step = 1;
-        if (count > max_displayed_peaks)
-        {
-          step = 1 + count / max_displayed_peaks;
-        }
+      const QColor base_color = layer.gradient.precalculatedColorAt(0.0);
+      for (const DisplayedPeak& peak : selectDisplayedPeaks_(layer, canvas_3d_.visible_area_.getAreaUnit(), 1000000))
+      {
+        const double x = -corner_ + scaledMZ_(peak.mz);
+        const double z = -near_ - 2 * corner_ - scaledRT_(peak.rt);
+        vertices.push_back(makePeakVertex_(x, -corner_, z, base_color));
+        vertices.push_back(makePeakVertex_(x, -corner_ + scaledIntensity_(peak.intensity, i), z, peakColor_(layer, peak.intensity, i)));
+      }
+      batch.count = GLsizei(vertices.size() - batch.first);
+      peak_batches_.push_back(batch);
+    }
+    uploadPeakData_(vertices);
+  }
 
-        for (auto it = begin_it; it != end_it; ++it)
-        {
-          if (step > 1)
-          {
-            for (int i = 0; i < step - 1; ++i)
-            {
-              ++it;
-            }
-          }
-          if (it == end_it)
-          {
-            glEndList();
-            return list;
-          }
+  void Plot3DOpenGLCanvas::uploadPeakData_(const std::vector<PeakVertex>& vertices)
+  {
+    if (peak_buffer_ == 0)
+    {
+      glGenBuffers(1, &peak_buffer_);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, peak_buffer_);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(PeakVertex), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+  }
 
-          PeakIndex pi = it.getPeakIndex();
-          if (layer.filters.passes((*layer.getPeakData())[pi.spectrum], pi.peak))
-          {
-            glBegin(GL_LINES);
-            double intensity = 0;
-            switch (canvas_3d_.intensity_mode_)
-            {
-
-            case PlotCanvas::IM_PERCENTAGE:
-
-              intensity = it->getIntensity() * 100.0 / canvas_3d_.getMaxIntensity(i);
-              qglColor_(layer.gradient.precalculatedColorAt(0.0));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_,
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-              qglColor_(layer.gradient.precalculatedColorAt(intensity));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_ + (GLfloat)scaledIntensity_(it->getIntensity(), i),
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-              break;
-
-            case PlotCanvas::IM_NONE:
-
-              qglColor_(layer.gradient.precalculatedColorAt(0.0));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_,
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-              qglColor_(layer.gradient.precalculatedColorAt(it->getIntensity()));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_ + (GLfloat)scaledIntensity_(it->getIntensity(), i),
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-              break;
-
-            case PlotCanvas::IM_SNAP:
-
-              qglColor_(layer.gradient.precalculatedColorAt(0.0));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_,
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-              qglColor_(layer.gradient.precalculatedColorAt(it->getIntensity()));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_ + (GLfloat)scaledIntensity_(it->getIntensity(), i),
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-
-              break;
-
-            case PlotCanvas::IM_LOG:
-
-              qglColor_(layer.gradient.precalculatedColorAt(0.0));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_,
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-              qglColor_(layer.gradient.precalculatedColorAt(log10(1 + max(0.0, (double)(it->getIntensity())))));
-              glVertex3d(-corner_ + (GLfloat)scaledMZ_(it->getMZ()),
-                         -corner_ + (GLfloat)scaledIntensity_(it->getIntensity(), i),
-                         -near_ - 2 * corner_ - (GLfloat)scaledRT_(it.getRT()));
-
-              break;
-            }
-            glEnd();
-          }
-        }
+  void Plot3DOpenGLCanvas::drawPeakData_()
+  {
+    if (peak_buffer_ == 0 || peak_batches_.empty())
+    {
+      return;
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, peak_buffer_);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    // the pointers are offsets into the bound buffer
+    glVertexPointer(3, GL_FLOAT, sizeof(PeakVertex), reinterpret_cast<const GLvoid*>(offsetof(PeakVertex, position)));
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(PeakVertex), reinterpret_cast<const GLvoid*>(offsetof(PeakVertex, color)));
+    for (const PeakBatch& batch : peak_batches_)
+    {
+      glShadeModel(batch.smooth ? GL_SMOOTH : GL_FLAT);
+      if (batch.mode == GL_POINTS)
+      {
+        glPointSize(batch.size);
+      }
+      else
+      {
+        glLineWidth(batch.size);
       }
+      glDrawArrays(batch.mode, batch.first, batch.count);
     }
-    glEndList();
-    return list;
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
   }
 
   GLuint Plot3DOpenGLCanvas::makeGridLines_()
@@ -0,0 +1,279 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/VISUAL/SpectraTreeModel.h>
+
+#include <OpenMS/CONCEPT/LogStream.h>
+#include <OpenMS/DATASTRUCTURES/ListUtils.h>
+
+namespace OpenMS
+{
+  // keep in SYNC with enum Column
+  const QStringList SpectraTreeModel::HEADER_NAMES = QStringList()
+    << "MS level" << "index" << "RT" << "precursor m/z" << "dissociation" << "scan" << "zoom";
+
+  SpectraTreeModel::SpectraTreeModel(QObject* parent) :
+    QAbstractItemModel(parent)
+  {
+  }
+
+  void SpectraTreeModel::setExperiment(const boost::shared_ptr<const MSExperiment>& exp)
+  {
+    beginResetModel();
+    exp_ = exp;
+    flat_ = !buildTree_();
+    if (flat_)
+    {
+      buildFlat_();
+    }
+    indexChildren_();
+    endResetModel();
+  }
+
+  const MSExperiment* SpectraTreeModel::getExperiment() const
+  {
+    return exp_.get();
+  }
+
+  int SpectraTreeModel::getSpectrumIndex(const QModelIndex& index) const
+  {
+    if (!index.isValid())
+    {
+      return -1;
+    }
+    return int(index.internalId());
+  }
+
+  QModelIndex SpectraTreeModel::indexOfSpectrum(Size spectrum_index, int column) const
+  {
+    if (spectrum_index >= parent_.size())
+    {
+      return QModelIndex();
+    }
+    return createIndex(row_[spectrum_index], column, quintptr(spectrum_index));
+  }
+
+  QModelIndex SpectraTreeModel::findSpectrum(const QString& text, int column, bool exact) const
+  {
+    for (Size i = 0; i < parent_.size(); ++i)
+    {
+      const QString value = displayData_(i, column).toString();
+      if (exact ? value.compare(text, Qt::CaseInsensitive) == 0 : value.startsWith(text, Qt::CaseInsensitive))
+      {
+        return indexOfSpectrum(i, column);
+      }
+    }
+    return QModelIndex();
+  }
+
+  bool SpectraTreeModel::isFlat() const
+  {
+    return flat_;
+  }
+
+  QModelIndex SpectraTreeModel::index(int row, int column, const QModelIndex& parent) const
+  {
+    if (row < 0 || column < 0 || column >= SIZE_OF_COLUMNS)
+    {
+      return QModelIndex();
+    }
+    if (!parent.isValid())
+    {
+      if (Size(row) >= roots_.size())
+      {
+        return QModelIndex();
+      }
+      return createIndex(row, column, quintptr(roots_[row]));
+    }
+    const Size p = parent.internalId();
+    if (Size(row) >= child_offsets_[p + 1] - child_offsets_[p])
+    {
+      return QModelIndex();
+    }
+    return createIndex(row, column, quintptr(children_[child_offsets_[p] + row]));
+  }
+
+  QModelIndex SpectraTreeModel::parent(const QModelIndex& index) const
+  {
+    if (!index.isValid())
+    {
+      return QModelIndex();
+    }
+    const Size p = parent_[index.internalId()];
+    if (p == NO_PARENT)
+    {
+      return QModelIndex();
+    }
+    return createIndex(row_[p], 0, quintptr(p));
+  }
+
+  int SpectraTreeModel::rowCount(const QModelIndex& parent) const
+  {
+    if (!parent.isValid())
+    {
+      return int(roots_.size());
+    }
+    // only the first column has children
+    if (parent.column() != 0)
+    {
+      return 0;
+    }
+    const Size p = parent.internalId();
+    return int(child_offsets_[p + 1] - child_offsets_[p]);
+  }
+
+  int SpectraTreeModel::columnCount(const QModelIndex& /*parent*/) const
+  {
+    return SIZE_OF_COLUMNS;
+  }
+
+  QVariant SpectraTreeModel::data(const QModelIndex& index, int role) const
+  {
+    if (!index.isValid() || role != Qt::DisplayRole)
+    {
+      return QVariant();
+    }
+    return displayData_(index.internalId(), index.column());
+  }
+
+  QVariant SpectraTreeModel::headerData(int section, Qt::Orientation orientation, int role) const
+  {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole || section < 0 || section >= SIZE_OF_COLUMNS)
+    {
+      return QVariant();
+    }
+    return HEADER_NAMES[section];
+  }
+
+  Qt::ItemFlags SpectraTreeModel::flags(const QModelIndex& index) const
+  {
+    // a single spectrum cannot be selected (there is nothing to choose from)
+    if (!index.isValid() || parent_.size() < 2)
+    {
+      return Qt::NoItemFlags;
+    }
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsDragEnabled;
+  }
+
+  bool SpectraTreeModel::buildTree_()
+  {
+    parent_.clear();
+    if (!exp_)
+    {
+      return true;
+    }
+    const std::vector<MSSpectrum>& spectra = exp_->getSpectra();
+    parent_.resize(spectra.size(), NO_PARENT);
+
+    // the last spectrum at each depth of the tree (i.e. the potential parents of the next spectrum)
+    std::vector<Size> last_at_depth;
+    Size depth = 0;
+    for (Size i = 0; i < spectra.size(); ++i)
+    {
+      if (i > 0)
+      {
+        const UInt level = spectra[i].getMSLevel();
+        const UInt prev_level = spectra[i - 1].getMSLevel();
+        if (level == prev_level + 1)
+        { // e.g. MS2 after MS1
+          ++depth;
+        }
+        else if (level < prev_level)
+        { // e.g. MS1 after MS2
+          depth -= std::min(depth, Size(prev_level - level));
+        }
+        else if (level != prev_level)
+        {
+          OPENMS_LOG_WARN << "Cannot build treelike view for spectrum browser, generating flat list instead." << std::endl;
+          return false;
+        }
+      }
+      if (depth > 0)
+      {
+        parent_[i] = last_at_depth[depth - 1];
+      }
+      last_at_depth.resize(depth + 1);
+      last_at_depth[depth] = i;
+    }
+    return true;
+  }
+
+  void SpectraTreeModel::buildFlat_()
+  {
+    parent_.assign(exp_ ? exp_->size() : 0, NO_PARENT);
+  }
+
+  void SpectraTreeModel::indexChildren_()
+  {
+    const Size n = parent_.size();
+    roots_.clear();
+    row_.assign(n, 0);
+    child_offsets_.assign(n + 1, 0);
+    for (Size i = 0; i < n; ++i)
+    {
+      if (parent_[i] == NO_PARENT)
+      {
+        row_[i] = int(roots_.size());
+        roots_.push_back(i);
+      }
+      else
+      {
+        row_[i] = int(child_offsets_[parent_[i] + 1]++);
+      }
+    }
+    // number of children -> offsets
+    for (Size i = 0; i < n; ++i)
+    {
+      child_offsets_[i + 1] += child_offsets_[i];
+    }
+    children_.resize(child_offsets_[n]);
+    for (Size i = 0; i < n; ++i)
+    {
+      if (parent_[i] != NO_PARENT)
+      {
+        children_[child_offsets_[parent_[i]] + row_[i]] = i;
+      }
+    }
+  }
+
+  QVariant SpectraTreeModel::displayData_(Size spectrum_index, int column) const
+  {
+    const MSSpectrum& spec = (*exp_)[spectrum_index];
+    switch (column)
+    {
+      case MS_LEVEL:
+        return QString("MS") + QString::number(spec.getMSLevel());
+      case SPEC_INDEX:
+        return int(spectrum_index);
+      case RT:
+        return spec.getRT();
+      case PRECURSOR_MZ:
+        if (spec.metaValueExists("analyzer scan offset"))
+        {
+          return double(spec.getMetaValue("analyzer scan offset"));
+        }
+        if (!spec.getPrecursors().empty())
+        {
+          return spec.getPrecursors()[0].getMZ();
+        }
+        return QVariant();
+      case DISSOCIATION:
+        if (!spec.metaValueExists("analyzer scan offset") && !spec.getPrecursors().empty())
+        {
+          return ListUtils::concatenate(spec.getPrecursors()[0].getActivationMethodsAsString(), ",").toQString();
+        }
+        return QVariant();
+      case SCANTYPE:
+        return QString::fromStdString(spec.getInstrumentSettings().NamesOfScanMode[spec.getInstrumentSettings().getScanMode()]);
+      case ZOOM:
+        return QString(spec.getInstrumentSettings().getZoomScan() ? "yes" : "no");
+      default:
+        return QVariant();
+    }
+  }
+}
@@ -11,11 +11,14 @@
 #include <OpenMS/CONCEPT/RAIICleanup.h>
 #include <OpenMS/VISUAL/LayerData1DPeak.h>
 #include <OpenMS/VISUAL/LayerDataChrom.h>
+#include <OpenMS/VISUAL/SpectraTreeModel.h>
 #include <OpenMS/VISUAL/TreeView.h>
 
 #include <QtWidgets/QComboBox>
+#include <QtWidgets/QHeaderView>
 #include <QtWidgets/QLineEdit>
 #include <QtWidgets/QMenu>
+#include <QtWidgets/QTreeView>
 
 namespace OpenMS
 {
@@ -40,25 +43,12 @@ namespace OpenMS
 
 
   // Use a namespace to encapsulate names, yet use c-style 'enum' for fast conversion to int.
-  // So we can write: 'ClmnPeak::MS_LEVEL', but get implicit conversion to int
-  namespace ClmnPeak
-  {
-    enum HeaderNames
-    { // indices into QTableWidget's columns (which start at index 0)
-      // note: make sure SPEC_INDEX remains at 1 (and is synced with ClmnChrom::CHROM_INDEX!!!)
-      MS_LEVEL, SPEC_INDEX, RT, PRECURSOR_MZ, DISSOCIATION, SCANTYPE, ZOOM, /* last entry --> */ SIZE_OF_HEADERNAMES
-    };
-    // keep in SYNC with enum HeaderNames
-    const QStringList HEADER_NAMES = QStringList()
-       << "MS level" << "index" << "RT" << "precursor m/z" << "dissociation" << "scan" << "zoom";
-  }
-  // Use a namespace to encapsulate names, yet use c-style 'enum' for fast conversion to int.
-  // So we can write: 'ClmnPeak::MS_LEVEL', but get implicit conversion to int
+  // So we can write: 'ClmnChrom::TYPE', but get implicit conversion to int
+  // (the columns of spectra are defined by SpectraTreeModel)
   namespace ClmnChrom
   {
     enum HeaderNames
     { // indices into QTableWidget's columns (which start at index 0)
-      // note: make sure CHROM_INDEX remains at 1 (and is synced with ClmnPeak::SPEC_INDEX!!!)
       TYPE, CHROM_INDEX, MZ, DESCRIPTION, RT_START, RT_END, CHARGE, CHROM_TYPE, /* last entry --> */ SIZE_OF_HEADERNAMES
     };
     // keep in SYNC with enum HeaderNames
@@ -69,7 +59,7 @@ namespace OpenMS
   struct IndexExtrator
   {
     explicit IndexExtrator(const QTreeWidgetItem* item)
-      : spectrum_index(item->data(ClmnPeak::SPEC_INDEX, Qt::DisplayRole).toInt()),
+      : spectrum_index(item->data(ClmnChrom::CHROM_INDEX, Qt::DisplayRole).toInt()),
         res(item->data(ClmnChrom::TYPE, Qt::UserRole).toList()) // this works, even if the QVariant is invalid (then the list is empty)
     {
     }
@@ -87,9 +77,6 @@ namespace OpenMS
   SpectraTreeTab::SpectraTreeTab(QWidget * parent) :
     QWidget(parent)
   {
-    // these must be identical, because there is code which extracts the scan index irrespective of what we show
-    assert(ClmnPeak::SPEC_INDEX == ClmnChrom::CHROM_INDEX);
-
     setObjectName("Scans");
     QVBoxLayout* spectra_widget_layout = new QVBoxLayout(this);
     spectra_treewidget_ = new TreeView(this);
@@ -110,6 +97,36 @@ namespace OpenMS
 
     spectra_widget_layout->addWidget(spectra_treewidget_);
 
+    // spectra: rows are only created when shown
+    spectra_treeview_ = new QTreeView(this);
+    spectra_treeview_->setWhatsThis(spectra_treewidget_->whatsThis());
+    spectra_model_ = new SpectraTreeModel(this);
+    spectra_treeview_->setModel(spectra_model_);
+    spectra_treeview_->setUniformRowHeights(true); // avoids asking for the size of all rows
+    spectra_treeview_->setDragEnabled(true);
+    spectra_treeview_->setContextMenuPolicy(Qt::CustomContextMenu);
+    spectra_treeview_->header()->setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(spectra_treeview_->header(), &QHeaderView::customContextMenuRequested, this, [this](const QPoint& pos)
+    { // allows to hide/show columns (like TreeView)
+      QMenu context_menu(spectra_treeview_->header());
+      for (int i = 0; i < SpectraTreeModel::SIZE_OF_COLUMNS; ++i)
+      {
+        auto action = context_menu.addAction(SpectraTreeModel::HEADER_NAMES[i], [i, this]() {
+          spectra_treeview_->setColumnHidden(i, !spectra_treeview_->isColumnHidden(i));
+        });
+        action->setCheckable(true);
+        action->setChecked(!spectra_treeview_->isColumnHidden(i));
+      }
+      context_menu.exec(spectra_treeview_->header()->mapToGlobal(pos));
+    });
+
+    connect(spectra_treeview_->selectionModel(), &QItemSelectionModel::currentChanged, this, &SpectraTreeTab::spectrumSelectionChange_);
+    connect(spectra_treeview_, &QTreeView::doubleClicked, this, &SpectraTreeTab::spectrumDoubleClicked_);
+    connect(spectra_treeview_, &QTreeView::customContextMenuRequested, this, &SpectraTreeTab::spectrumViewContextMenu_);
+
+    spectra_widget_layout->addWidget(spectra_treeview_);
+    showSpectraView_(false);
+
     QHBoxLayout* tmp_hbox_layout = new QHBoxLayout();
 
     spectra_search_box_ = new QLineEdit(this);
@@ -132,18 +149,41 @@ namespace OpenMS
     spectra_widget_layout->addLayout(tmp_hbox_layout);
   }
 
+  bool SpectraTreeTab::showsSpectra_() const
+  {
+    return !spectra_treeview_->isHidden();
+  }
+
+  void SpectraTreeTab::showSpectraView_(bool spectra)
+  {
+    spectra_treeview_->setVisible(spectra);
+    spectra_treewidget_->setVisible(!spectra);
+  }
+
   void SpectraTreeTab::spectrumSearchText_()
   {
     const QString& text = spectra_search_box_->text(); // get text from QLineEdit
-    if (!text.isEmpty())
+    if (text.isEmpty())
+    {
+      return;
+    }
+    // only the 'index' has to be matched exactly (it is named identically for spectra and chromatograms)
+    const bool exact = (spectra_combo_box_->currentText() == ClmnChrom::HEADER_NAMES[ClmnChrom::CHROM_INDEX]);
+    if (showsSpectra_())
+    {
+      QModelIndex searched = spectra_model_->findSpectrum(text, spectra_combo_box_->currentIndex(), exact);
+      if (searched.isValid())
+      {
+        spectra_treeview_->selectionModel()->select(searched, QItemSelectionModel::ClearAndSelect | QItemSelectionModel::Rows);
+        spectra_treeview_->scrollTo(searched);
+      }
+    }
+    else
     {
       Qt::MatchFlags matchflags = Qt::MatchFixedString;
       matchflags |=  Qt::MatchRecursive; // match subitems (below top-level)
-      // 'index' must be named identically for both data types
-      assert(ClmnPeak::HEADER_NAMES[ClmnPeak::SPEC_INDEX] == ClmnChrom::HEADER_NAMES[ClmnChrom::CHROM_INDEX]);
-      // ... for the following to work:
-      if (spectra_combo_box_->currentText() != ClmnPeak::HEADER_NAMES[ClmnPeak::SPEC_INDEX])
-      { // only the 'index' has to be matched exactly
+      if (!exact)
+      {
         matchflags |= Qt::MatchStartsWith;
       }
       QList<QTreeWidgetItem*> searched = spectra_treewidget_->findItems(text, matchflags, spectra_combo_box_->currentIndex());
@@ -161,23 +201,26 @@ namespace OpenMS
   bool SpectraTreeTab::getSelectedScan(MSExperiment& exp, LayerDataBase::DataType& current_type) const
   {
     exp.clear(true);
-    QTreeWidgetItem* item = spectra_treewidget_->currentItem();
-    if (item == nullptr)
+    if (showsSpectra_())
     {
-      return false;
-    }
-    // getting the index works for PEAK and CHROM data
-    int index = item->data(ClmnPeak::SPEC_INDEX, Qt::DisplayRole).toInt();
-    if (spectra_treewidget_->headerItem()->text(ClmnChrom::MZ) == ClmnChrom::HEADER_NAMES[ClmnChrom::MZ])
-    { // we currently show chromatogram data
-      current_type = LayerDataBase::DT_CHROMATOGRAM;
-      exp.addChromatogram(last_peakmap_->getChromatograms()[index]);
+      int index = spectra_model_->getSpectrumIndex(spectra_treeview_->currentIndex());
+      if (index < 0)
+      {
+        return false;
+      }
+      current_type = LayerDataBase::DT_PEAK;
+      exp.addSpectrum(spectra_model_->getExperiment()->getSpectra()[index]);
+      return true;
     }
-    else
+    QTreeWidgetItem* item = spectra_treewidget_->currentItem();
+    if (item == nullptr || spectra_treewidget_->headerItem()->text(ClmnChrom::MZ) != ClmnChrom::HEADER_NAMES[ClmnChrom::MZ])
     {
-      current_type = LayerDataBase::DT_PEAK;
-      exp.addSpectrum(last_peakmap_->getSpectra()[index]);
+      return false;
     }
+    // we currently show chromatogram data
+    int index = item->data(ClmnChrom::CHROM_INDEX, Qt::DisplayRole).toInt();
+    current_type = LayerDataBase::DT_CHROMATOGRAM;
+    exp.addChromatogram(last_peakmap_->getChromatograms()[index]);
     return true;
   }
 
@@ -199,9 +242,28 @@ namespace OpenMS
     }
   }
 
+  void SpectraTreeTab::spectrumSelectionChange_(const QModelIndex& current, const QModelIndex& /*previous*/)
+  {
+    int index = spectra_model_->getSpectrumIndex(current);
+    if (index >= 0)
+    {
+      emit spectrumSelected(index);
+    }
+  }
+
   void SpectraTreeTab::searchAndShow_()
   {
     spectrumSearchText_(); // update selection first (we might be in a new layer)
+    if (showsSpectra_())
+    {
+      QModelIndexList selected = spectra_treeview_->selectionModel()->selectedRows();
+      // show the first selected item
+      if (!selected.empty())
+      {
+        emit spectrumSelected(spectra_model_->getSpectrumIndex(selected.first()));
+      }
+      return;
+    }
     QList<QTreeWidgetItem*> selected = spectra_treewidget_->selectedItems();
 
     // show the first selected item
@@ -228,6 +290,34 @@ namespace OpenMS
     }
   }
 
+  void SpectraTreeTab::spectrumDoubleClicked_(const QModelIndex& index)
+  {
+    int spectrum_index = spectra_model_->getSpectrumIndex(index);
+    if (spectrum_index >= 0)
+    {
+      emit spectrumDoubleClicked(spectrum_index);
+    }
+  }
+
+  void SpectraTreeTab::spectrumViewContextMenu_(const QPoint& pos)
+  {
+    int spectrum_index = spectra_model_->getSpectrumIndex(spectra_treeview_->indexAt(pos));
+    if (spectrum_index < 0)
+    {
+      return;
+    }
+    QMenu context_menu(spectra_treeview_);
+    context_menu.addAction("Show in 1D view", [&]()
+    {
+      emit showSpectrumAsNew1D(spectrum_index);
+    });
+    context_menu.addAction("Meta data", [&]()
+    {
+      emit showSpectrumMetaData(spectrum_index);
+    });
+    context_menu.exec(spectra_treeview_->viewport()->mapToGlobal(pos));
+  }
+
   void SpectraTreeTab::spectrumContextMenu_(const QPoint& pos)
   {
     QTreeWidgetItem* item = spectra_treewidget_->itemAt(pos);
@@ -257,34 +347,6 @@ namespace OpenMS
   }
 
 
-  void populatePeakDataRow_(QTreeWidgetItem* item, const int index, const MSSpectrum& spec)
-  {
-    item->setText(ClmnPeak::MS_LEVEL, QString("MS") + QString::number(spec.getMSLevel()));
-    item->setData(ClmnPeak::SPEC_INDEX, Qt::DisplayRole, index);
-    item->setData(ClmnPeak::RT, Qt::DisplayRole, spec.getRT());
-
-    const std::vector<Precursor>& current_precursors = spec.getPrecursors();
-
-    if (!current_precursors.empty() || spec.metaValueExists("analyzer scan offset"))
-    {
-      double precursor_mz;
-      if (spec.metaValueExists("analyzer scan offset"))
-      {
-        precursor_mz = spec.getMetaValue("analyzer scan offset");
-      }
-      else
-      {
-        const Precursor& current_pc = current_precursors[0];
-        precursor_mz = current_pc.getMZ();
-        item->setText(ClmnPeak::DISSOCIATION, ListUtils::concatenate(current_pc.getActivationMethodsAsString(), ",").toQString());
-      }
-      item->setData(ClmnPeak::PRECURSOR_MZ, Qt::DisplayRole, precursor_mz);
-    }
-
-    item->setText(ClmnPeak::SCANTYPE, QString::fromStdString(spec.getInstrumentSettings().NamesOfScanMode[spec.getInstrumentSettings().getScanMode()]));
-    item->setText(ClmnPeak::ZOOM, (spec.getInstrumentSettings().getZoomScan() ? "yes" : "no"));
-  }
-
   bool SpectraTreeTab::hasData(const LayerDataBase* layer)
   {
     if (layer == nullptr)
@@ -305,14 +367,16 @@ namespace OpenMS
     }
     layer_ = layer;
 
-    if (!spectra_treewidget_->isVisible() || spectra_treewidget_->signalsBlocked())
+    if (!isVisible() || spectra_treewidget_->signalsBlocked())
     {
       return;
     }
     
     spectra_treewidget_->blockSignals(true);
+    spectra_treeview_->selectionModel()->blockSignals(true);
     RAIICleanup clean([&](){
       spectra_treewidget_->blockSignals(false); 
+      spectra_treeview_->selectionModel()->blockSignals(false);
     });
 
     QTreeWidgetItem* toplevel_item = nullptr;
@@ -328,119 +392,18 @@ namespace OpenMS
       {
         spec_index = layer_peak1d->getCurrentIndex();
       }
-      const auto& cl = *lp;
-      spectra_treewidget_->clear();
-
-      std::vector<QTreeWidgetItem *> parent_stack;
-      parent_stack.push_back(nullptr);
-      bool fail = false;
-      last_peakmap_ = &(*cl.getPeakData());
-      spectra_treewidget_->setHeaders(ClmnPeak::HEADER_NAMES);
-
-      for (Size i = 0; i < cl.getPeakData()->size(); ++i)
-      {
-        const MSSpectrum& current_spec = (*cl.getPeakData())[i];
-
-        if (i > 0)
-        {
-          const MSSpectrum& prev_spec = (*cl.getPeakData())[i-1];
-          // current MS level = previous MS level + 1 (e.g. current: MS2, previous: MS1)
-          if (current_spec.getMSLevel() == prev_spec.getMSLevel() + 1)
-          {
-            toplevel_item = new QTreeWidgetItem(parent_stack.back());
-            parent_stack.resize(parent_stack.size() + 1);
-          }
-          // current MS level = previous MS level (e.g. MS2,MS2 or MS1,MS1)
-          else if (current_spec.getMSLevel() == prev_spec.getMSLevel())
-          {
-            if (parent_stack.size() == 1)
-            {
-              toplevel_item = new QTreeWidgetItem();
-            }
-            else
-            {
-              toplevel_item = new QTreeWidgetItem(*(parent_stack.end() - 2));
-            }
-          }
-          // current MS level < previous MS level (e.g. MS1,MS2)
-          else if (current_spec.getMSLevel() < prev_spec.getMSLevel())
-          {
-            Int level_diff = prev_spec.getMSLevel() - current_spec.getMSLevel();
-            Size parent_index = 0;
-            if (parent_stack.size() - level_diff >= 2)
-            {
-              parent_index = parent_stack.size() - level_diff - 1;
-              QTreeWidgetItem * parent = parent_stack[parent_index];
-              toplevel_item = new QTreeWidgetItem(parent, parent_stack[parent_index + 1]);
-            }
-            else
-            {
-              toplevel_item = new QTreeWidgetItem((QTreeWidget *)nullptr);
-            }
-            parent_stack.resize(parent_index + 1);
-          }
-          else
-          {
-            std::cerr << "Cannot build treelike view for spectrum browser, generating flat list instead." << std::endl;
-            fail = true;
-            break;
-          }
-        }
-        else
-        {
-          toplevel_item = new QTreeWidgetItem();
-        }
-
-        parent_stack.back() = toplevel_item;
-        if (parent_stack.size() == 1)
-        {
-          toplevel_items.push_back(toplevel_item);
-        }
-
-        populatePeakDataRow_(toplevel_item, i, current_spec);
-
-        if (i == spec_index)
-        {
-          // just remember it, select later
-          selected_item = toplevel_item;
-        }
-      }
-
-      if (fail)
-      {
-        // generate flat list instead
-        spectra_treewidget_->clear();
-        toplevel_items.clear();
-        selected_item = nullptr;
-        for (Size i = 0; i < cl.getPeakData()->size(); ++i)
-        {
-          const MSSpectrum& current_spec = (*cl.getPeakData())[i];
-          toplevel_item = new QTreeWidgetItem();
-          
-          populatePeakDataRow_(toplevel_item, i, current_spec);
-
-          toplevel_items.push_back(toplevel_item);
-          if (i == spec_index)
-          {
-            // just remember it, select later
-            selected_item = toplevel_item;
-          }
-        }
-      }
-      spectra_treewidget_->addTopLevelItems(toplevel_items);
+      // only the tree structure is computed here, rows are populated when shown
+      spectra_model_->setExperiment(lp->getPeakData());
+      last_peakmap_ = spectra_model_->getExperiment();
+      showSpectraView_(true);
 
-      if (selected_item)
+      QModelIndex selected_index = spectra_model_->indexOfSpectrum(spec_index);
+      if (selected_index.isValid())
       {
-        // now, select and scroll down to item
-        selected_item->setSelected(true);
         // selected = for mouse clicks and multiselection,
         // current = for arrow navigation and signifies THE ONE active item
-        spectra_treewidget_->setCurrentItem(selected_item);
-        spectra_treewidget_->scrollToItem(selected_item);
-      }
-      if (cl.getPeakData()->size() > 1)
-      {
-        more_than_one_spectrum = false;
+        spectra_treeview_->selectionModel()->setCurrentIndex(selected_index, QItemSelectionModel::ClearAndSelect | QItemSelectionModel::Rows);
+        spectra_treeview_->scrollTo(selected_index);
       }
     }
     // Branch if the current layer is a chromatogram (either indicated by its
@@ -457,6 +420,7 @@ namespace OpenMS
       }
       
       last_peakmap_ = exp.get();
+      showSpectraView_(false);
       spectra_treewidget_->clear();
       // New data:
       // We need to redraw the whole Widget because the we have changed all the layers.
@@ -577,6 +541,7 @@ namespace OpenMS
     // Branch if its neither (just draw an empty item)
     else
     {
+      showSpectraView_(false);
       spectra_treewidget_->setHeaders(QStringList() << "No peak map");
     }
 
@@ -590,11 +555,13 @@ namespace OpenMS
     // automatically set column width, depending on data
     spectra_treewidget_->header()->setStretchLastSection(false);
     spectra_treewidget_->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    spectra_treeview_->header()->setStretchLastSection(false);
+    spectra_treeview_->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
   }
 
   void SpectraTreeTab::populateSearchBox_()
   {
-    QStringList headers = spectra_treewidget_->getHeaderNames(WidgetHeader::WITH_INVISIBLE);
+    QStringList headers = showsSpectra_() ? SpectraTreeModel::HEADER_NAMES : spectra_treewidget_->getHeaderNames(WidgetHeader::WITH_INVISIBLE);
     int current_index = spectra_combo_box_->currentIndex(); // when repainting we want the index to stay the same
     spectra_combo_box_->clear();
     spectra_combo_box_->addItems(headers);
@@ -604,6 +571,7 @@ namespace OpenMS
   void SpectraTreeTab::clear()
   {
     spectra_treewidget_->clear();
+    spectra_model_->setExperiment(nullptr);
     spectra_combo_box_->clear();
   }
 
@@ -0,0 +1,77 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/VISUAL/SpectrumCache.h>
+
+#include <algorithm>
+
+namespace OpenMS
+{
+  SpectrumCache::SpectrumCache(const Loader& loader, Size capacity) :
+    loader_(loader),
+    capacity_(std::max(Size(1), capacity))
+  {
+  }
+
+  const MSSpectrum& SpectrumCache::getSpectrum(Size index)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(index);
+    if (it != index_.end())
+    {
+      // move to the front (does not invalidate references)
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return it->second->second;
+    }
+    entries_.emplace_front(index, loader_(index));
+    index_[index] = entries_.begin();
+    shrink_();
+    return entries_.front().second;
+  }
+
+  bool SpectrumCache::contains(Size index) const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_.find(index) != index_.end();
+  }
+
+  Size SpectrumCache::size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+  }
+
+  Size SpectrumCache::getCapacity() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+  }
+
+  void SpectrumCache::setCapacity(Size capacity)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = std::max(Size(1), capacity);
+    shrink_();
+  }
+
+  void SpectrumCache::clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    index_.clear();
+  }
+
+  void SpectrumCache::shrink_()
+  {
+    while (entries_.size() > capacity_)
+    {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+  }
+}
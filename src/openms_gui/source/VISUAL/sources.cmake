@@ -20,6 +20,7 @@ InputFile.cpp
 InputFile.ui
 InputFileList.cpp
 InputFileList.ui
+IntensityPyramid.cpp
 LayerListView.cpp
 LayerData1DBase.cpp
 LayerData1DChrom.cpp
@@ -57,7 +58,9 @@ RecentFilesMenu.cpp
 SequenceVisualizer.cpp
 SequenceVisualizer.ui
 SpectraIDViewTab.cpp
+SpectraTreeModel.cpp
 SpectraTreeTab.cpp
+SpectrumCache.cpp
 SwathLibraryStats.cpp
 SwathLibraryStats.ui
 TableView.cpp
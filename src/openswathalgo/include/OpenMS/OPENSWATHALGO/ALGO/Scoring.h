@@ -107,10 +107,18 @@ public:
     OPENSWATHALGO_DLLAPI XCorrArrayType normalizedCrossCorrelationPost(std::vector<double>& normalized_data1,
                                                                        std::vector<double>& normalized_data2, const int maxdelay, const int lag);                                                                   
 
+    /// Calculate crosscorrelation on std::vector data that is already normalized, storing it in @p result (reusing its memory)
+    OPENSWATHALGO_DLLAPI void normalizedCrossCorrelationPost(std::vector<double>& normalized_data1,
+                                                             std::vector<double>& normalized_data2, const int maxdelay, const int lag, XCorrArrayType& result);
+
     /// Calculate crosscorrelation on std::vector data without normalization
     OPENSWATHALGO_DLLAPI XCorrArrayType calculateCrossCorrelation(const std::vector<double>& data1,
                                                                   const std::vector<double>& data2, const int maxdelay, const int lag);
 
+    /// Calculate crosscorrelation on std::vector data without normalization, storing it in @p result (reusing its memory)
+    OPENSWATHALGO_DLLAPI void calculateCrossCorrelation(const std::vector<double>& data1,
+                                                        const std::vector<double>& data2, const int maxdelay, const int lag, XCorrArrayType& result);
+
     /// Find best peak in an cross-correlation (highest apex)
     OPENSWATHALGO_DLLAPI XCorrArrayType::const_iterator xcorrArrayGetMaxPeak(const XCorrArrayType & array);
 
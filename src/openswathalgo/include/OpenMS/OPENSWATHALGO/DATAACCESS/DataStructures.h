@@ -176,6 +176,8 @@ public:
   typedef OSSpectrumMeta SpectrumMeta;
   typedef boost::shared_ptr<SpectrumMeta> SpectrumMetaPtr;
 
+  class SpectrumMobilityIndex;
+
   /// The structure that captures the generation of a peak list (including the underlying acquisitions)
   struct OPENSWATHALGO_DLLAPI OSSpectrum
   {
@@ -186,6 +188,9 @@ private:
     /// list of binary data arrays.
     std::vector<BinaryDataArrayPtr> binaryDataArrayPtrs;
 
+    /// optional ion mobility index of the peaks (see SpectrumMobilityIndex)
+    boost::shared_ptr<const SpectrumMobilityIndex> mobilityIndex;
+
 public:
     OSSpectrum() :
       defaultArrayLength(2),
@@ -271,6 +276,18 @@ public:
       return binaryDataArrayPtrs;
     }
 
+    /// get the ion mobility index of the peaks (may be null, check SpectrumMobilityIndex::isIndexOf() before use)
+    const boost::shared_ptr<const SpectrumMobilityIndex>& getMobilityIndex() const
+    {
+      return mobilityIndex;
+    }
+
+    /// set the ion mobility index of the peaks (see SpectrumMobilityIndex::addToSpectrum())
+    void setMobilityIndex(boost::shared_ptr<const SpectrumMobilityIndex> index)
+    {
+      mobilityIndex = index;
+    }
+
   };
   typedef OSSpectrum Spectrum;
   typedef boost::shared_ptr<Spectrum> SpectrumPtr;
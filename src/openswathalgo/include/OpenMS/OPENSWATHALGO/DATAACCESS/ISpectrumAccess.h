@@ -11,6 +11,8 @@
 #include <OpenMS/OPENSWATHALGO/OpenSwathAlgoConfig.h>
 
 #include <OpenMS/OPENSWATHALGO/DATAACCESS/DataStructures.h>
+#include <OpenMS/OPENSWATHALGO/DATAACCESS/SpectrumMobilityIndex.h>
+#include <OpenMS/OPENSWATHALGO/DATAACCESS/SpectrumRTIndex.h>
 #include <boost/shared_ptr.hpp>
 #include <string>
 #include <vector>
@@ -52,8 +54,21 @@ public:
     /// Return pointer to a spectrum at the given id, the spectrum will be filtered by drift time
     SpectrumPtr getSpectrumById(int id, double drift_start, double drift_end );
 
-    /// Return a vector of ids of spectra that are within RT +/- deltaRT
+    /// Return a vector of ids of spectra that are within RT +/- deltaRT (see SpectrumRTIndex::getSpectraByRT() for the exact semantics)
     virtual std::vector<std::size_t> getSpectraByRT(double RT, double deltaRT) const = 0;
+
+    /// Batch version of getSpectraByRT(), answered from the RT index (see getRTIndex()) if there is one
+    virtual std::vector<std::vector<std::size_t> > getSpectraByRTs(const std::vector<double>& RTs, double deltaRT) const;
+
+    /**
+      @brief Return the precomputed retention time index of the spectra
+
+      All implementations which hold the retention times of their spectra
+      provide an index; it is shared between light clones. The default
+      implementation returns a nullptr.
+    */
+    virtual const SpectrumRTIndex* getRTIndex() const;
+
     /// Returns the number of spectra available
     virtual size_t getNrSpectra() const = 0;
     /// Returns the meta information for a spectrum
@@ -81,7 +96,8 @@ public:
     /// filters a spectrum by drift time, spectrum pointer returned is a copy
     static SpectrumPtr filterByDrift(const SpectrumPtr& input, double drift_start, double drift_end)
     {
-      // NOTE: this function is very inefficient because filtering unsorted array
+      // NOTE: without an ion mobility index (see SpectrumMobilityIndex) this
+      // function is very inefficient because filtering unsorted array
       //OPENMS_PRECONDITION(drift_start <= 0, "Cannot filter by drift time if drift_start is not set");
       //OPENMS_PRECONDITION(drift_end - drift_start < 0, "Cannot filter by drift time if range is empty");
       //OPENMS_PRECONDITION(input->getDriftTimeArray() != nullptr, "Cannot filter by drift time if no drift time is available.");
@@ -107,17 +123,36 @@ public:
       OpenSwath::BinaryDataArrayPtr im_arr_out(new OpenSwath::BinaryDataArray);
       im_arr_out->description = im_arr->description;
 
-      while (mz_it != mz_end)
+      const boost::shared_ptr<const SpectrumMobilityIndex>& index = input->getMobilityIndex();
+      if (index && index->isIndexOf(*input))
+      {
+        // only visit the peaks in the ion mobility bins of the range
+        std::vector<std::size_t> peaks;
+        index->getPeaks(drift_start, drift_end, peaks);
+        mz_arr_out->data.reserve(peaks.size());
+        intens_arr_out->data.reserve(peaks.size());
+        im_arr_out->data.reserve(peaks.size());
+        for (std::size_t k : peaks)
+        {
+          mz_arr_out->data.push_back( mz_arr->data[k] );
+          intens_arr_out->data.push_back( int_arr->data[k] );
+          im_arr_out->data.push_back( im_arr->data[k] );
+        }
+      }
+      else
       {
-        if ( (drift_start <= *im_it) && (drift_end >= *im_it) )
+        while (mz_it != mz_end)
         {
-          mz_arr_out->data.push_back( *mz_it );
-          intens_arr_out->data.push_back( *int_it );
-          im_arr_out->data.push_back( *im_it );
+          if ( (drift_start <= *im_it) && (drift_end >= *im_it) )
+          {
+            mz_arr_out->data.push_back( *mz_it );
+            intens_arr_out->data.push_back( *int_it );
+            im_arr_out->data.push_back( *im_it );
+          }
+          ++mz_it;
+          ++int_it;
+          ++im_it;
         }
-        ++mz_it;
-        ++int_it;
-        ++im_it;
       }
       output->setMZArray(mz_arr_out);
       output->setIntensityArray(intens_arr_out);
@@ -125,6 +160,9 @@ public:
       return output;
   }
 
+protected:
+    /// Id of the spectrum closest to @p RT (see SpectrumRTIndex::getClosestSpectrum()), uses the RT index if there is one
+    int getClosestSpectrumId_(double RT) const;
 
    };
 
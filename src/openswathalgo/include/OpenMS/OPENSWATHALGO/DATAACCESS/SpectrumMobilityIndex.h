@@ -0,0 +1,101 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/OPENSWATHALGO/DATAACCESS/DataStructures.h>
+#include <OpenMS/OPENSWATHALGO/OpenSwathAlgoConfig.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace OpenSwath
+{
+  /**
+    @brief Precomputed ion mobility index of the peaks of a single (m/z sorted) spectrum
+
+    Frame-based ion mobility spectra (e.g. diaPASEF) contain the peaks of
+    all mobility scans sorted by m/z, and filtering them by ion mobility
+    (see ISpectrumAccess::filterByDrift()) has to look at every single peak.
+
+    The index divides the peaks into blocks of consecutive peaks (i.e. m/z
+    ranges) and the ion mobility range into bins of equal width, and stores
+    the peaks of each block grouped by bin. A mobility range query thus only
+    visits the bins overlapping the range in each block; only the peaks of
+    the two bins at the borders of the range are compared to the range. The
+    result is in the original (m/z) order, i.e. identical to a linear scan.
+
+    The index refers to the ion mobility array of the spectrum it was built
+    from (which it shares) and is attached to the spectrum with
+    OSSpectrum::setMobilityIndex(). It is only valid as long as the peaks of
+    the spectrum are not modified, see isIndexOf().
+  */
+  class OPENSWATHALGO_DLLAPI SpectrumMobilityIndex
+  {
+public:
+    /// Default constructor (empty index)
+    SpectrumMobilityIndex() = default;
+
+    /**
+      @brief Constructor from the peaks of @p spectrum
+
+      The index is empty if the spectrum has no ion mobility array (or its
+      size does not match the m/z array).
+
+      @param spectrum The spectrum (sorted by m/z)
+      @param block_size Number of consecutive peaks per block (at most 65536)
+      @param nr_bins Number of ion mobility bins
+    */
+    explicit SpectrumMobilityIndex(const OSSpectrum& spectrum, std::size_t block_size = 256, std::size_t nr_bins = 32);
+
+    /// Number of indexed peaks
+    std::size_t size() const;
+
+    /// Whether the index is empty
+    bool empty() const;
+
+    /// Whether this index was built from (the current ion mobility array of) @p spectrum
+    bool isIndexOf(const OSSpectrum& spectrum) const;
+
+    /**
+      @brief Positions of all peaks with @p drift_start <= ion mobility <= @p drift_end
+
+      The positions are in ascending order (the order of the spectrum).
+    */
+    void getPeaks(double drift_start, double drift_end, std::vector<std::size_t>& peaks) const;
+
+    /**
+      @brief Builds the index of @p spectrum and attaches it to the spectrum
+
+      Only spectra with an ion mobility array get an index.
+
+      @returns Whether an index was attached
+    */
+    static bool addToSpectrum(OSSpectrum& spectrum);
+
+protected:
+    /// Ion mobility bin of @p im (clamped to the existing bins)
+    std::size_t bin_(double im) const;
+
+    /// Ion mobility array the index was built from
+    BinaryDataArrayPtr im_;
+    /// Number of consecutive peaks per block
+    std::size_t block_size_ = 0;
+    /// Number of ion mobility bins
+    std::size_t nr_bins_ = 0;
+    /// Ion mobility of the first bin
+    double im_min_ = 0.0;
+    /// Number of bins per unit of ion mobility
+    double bins_per_im_ = 0.0;
+    /// Peaks of each block grouped by bin (position within the block, ascending within each bin)
+    std::vector<std::uint16_t> order_;
+    /// Start of each bin in order_ (nr_bins_ + 1 entries per block)
+    std::vector<std::uint32_t> offsets_;
+  };
+}
@@ -0,0 +1,100 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/OPENSWATHALGO/OpenSwathAlgoConfig.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace OpenSwath
+{
+  /**
+    @brief Precomputed retention time index of the spectra of a spectrum access object
+
+    Stores the retention times of all spectra in ascending order (together
+    with the spectrum ids if the spectra are not sorted by RT) and an offset
+    table, which divides the RT range into as many bins of equal width as
+    there are spectra and stores the first spectrum of each bin. A lookup
+    computes the bin of the requested RT and only searches within this bin,
+    which takes constant time for the (roughly) constant acquisition rate of
+    DIA data.
+
+    The index is used by all ISpectrumAccess implementations to answer
+    ISpectrumAccess::getSpectraByRT() and to find the spectra which
+    ISpectrumAccess::getMultipleSpectra() fetches.
+  */
+  class OPENSWATHALGO_DLLAPI SpectrumRTIndex
+  {
+public:
+    /// Default constructor (empty index)
+    SpectrumRTIndex() = default;
+
+    /// Constructor from the retention times of the spectra (indexed by spectrum id)
+    explicit SpectrumRTIndex(const std::vector<double>& rts);
+
+    /// Number of indexed spectra
+    std::size_t size() const;
+
+    /// Whether the index is empty
+    bool empty() const;
+
+    /**
+      @brief Ids of the spectra within RT +/- deltaRT
+
+      Returns the first spectrum with a retention time of at least RT - deltaRT
+      and all following spectra up to a retention time of RT + deltaRT (in
+      order of retention time). Thus, the first spectrum after RT - deltaRT is
+      returned even if it lies outside of the window, which allows to use a
+      @p deltaRT of zero to look up the next spectrum. The result is empty if
+      all spectra have a retention time below RT - deltaRT.
+    */
+    std::vector<std::size_t> getSpectraByRT(double RT, double deltaRT) const;
+
+    /// Batch version of getSpectraByRT(), looks up all @p RTs with the same @p deltaRT
+    std::vector<std::vector<std::size_t> > getSpectraByRT(const std::vector<double>& RTs, double deltaRT) const;
+
+    /**
+      @brief Id of the spectrum closest to @p RT
+
+      Only retention times up to the last spectrum are considered: if all
+      spectra have a retention time below @p RT, -1 is returned. Otherwise,
+      the first spectrum at or after @p RT or the spectrum before it is
+      returned, whichever is closer (the later spectrum on ties).
+    */
+    int getClosestSpectrum(double RT) const;
+
+    /// Batch version of getClosestSpectrum()
+    std::vector<int> getClosestSpectra(const std::vector<double>& RTs) const;
+
+protected:
+    /// Position (in RT order) of the first spectrum with a retention time of at least @p RT
+    std::size_t lowerBound_(double RT) const;
+
+    /// Bin of the offset table for @p RT
+    std::size_t bin_(double RT) const;
+
+    /// Spectrum id at position @p pos (in RT order)
+    std::size_t id_(std::size_t pos) const
+    {
+      return ids_.empty() ? pos : ids_[pos];
+    }
+
+    /// Retention times in ascending order
+    std::vector<double> rts_;
+    /// Spectrum ids in RT order (empty if the spectra are sorted by RT)
+    std::vector<std::size_t> ids_;
+    /// Position of the first spectrum of each bin (one more entry than bins)
+    std::vector<std::size_t> offsets_;
+    /// Retention time of the first spectrum
+    double rt_min_ = 0.0;
+    /// Number of bins per second
+    double bins_per_rt_ = 0.0;
+  };
+}
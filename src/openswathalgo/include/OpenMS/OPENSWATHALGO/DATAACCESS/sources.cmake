@@ -10,6 +10,8 @@ ITrans2Trans.h
 ITransition.h
 MockObjects.h
 SpectrumHelpers.h
+SpectrumMobilityIndex.h
+SpectrumRTIndex.h
 SwathMap.h
 TransitionExperiment.h
 Transitions.h
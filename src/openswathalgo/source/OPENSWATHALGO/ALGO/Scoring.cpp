@@ -143,40 +143,103 @@ namespace OpenSwath::Scoring
     XCorrArrayType normalizedCrossCorrelationPost(std::vector<double>& normalized_data1,
                                                   std::vector<double>& normalized_data2, const int maxdelay, const int lag = 1)
     {
-      XCorrArrayType result = calculateCrossCorrelation(normalized_data1, normalized_data2, maxdelay, lag);
+      XCorrArrayType result;
+      normalizedCrossCorrelationPost(normalized_data1, normalized_data2, maxdelay, lag, result);
+      return result;
+    }
+
+    void normalizedCrossCorrelationPost(std::vector<double>& normalized_data1,
+                                        std::vector<double>& normalized_data2, const int maxdelay, const int lag, XCorrArrayType& result)
+    {
+      calculateCrossCorrelation(normalized_data1, normalized_data2, maxdelay, lag, result);
 
       for (XCorrArrayType::iterator it = result.begin(); it != result.end(); ++it)
       {
         it->second /= normalized_data1.size();
       }
-      return result;
     }
 
     XCorrArrayType calculateCrossCorrelation(const std::vector<double>& data1,
                                              const std::vector<double>& data2, const int maxdelay, const int lag)
+    {
+      XCorrArrayType result;
+      calculateCrossCorrelation(data1, data2, maxdelay, lag, result);
+      return result;
+    }
+
+    void calculateCrossCorrelation(const std::vector<double>& data1,
+                                   const std::vector<double>& data2, const int maxdelay, const int lag, XCorrArrayType& result)
     {
       OPENSWATH_PRECONDITION(data1.size() == data2.size(), "Both data vectors need to have the same length");
 
-      XCorrArrayType result;
+      result.data.clear();
       result.data.reserve( (size_t)std::ceil((2*maxdelay + 1) / lag));
-      int datasize = static_cast<int>(data1.size());
-      int i, j, delay;
-
-      for (delay = -maxdelay; delay <= maxdelay; delay = delay + lag)
+      const int datasize = static_cast<int>(data1.size());
+      const double* x = data1.data();
+      const double* y = data2.data();
+
+      // The delays are processed in blocks: each data point of data1 is
+      // multiplied with the data points of data2 at all delays of the block
+      // at once, which vectorizes over the delays. The sum of each delay
+      // still adds its products in order of increasing i, so the result is
+      // identical to summing up each delay separately.
+      constexpr int block_size = 8;
+      double sxy[block_size];
+      for (int first = -maxdelay; first <= maxdelay; first += block_size * lag)
       {
-        double sxy = 0;
-        for (i = 0; i < datasize; ++i)
+        const int nr_delays = std::min(block_size, (maxdelay - first) / lag + 1);
+        const int last = first + (nr_delays - 1) * lag;
+
+        // data1[i] pairs with data2[i + delay] for all delays of the block if common_begin <= i < common_end
+        const int common_begin = std::max(0, -first);
+        const int common_end = std::min(datasize, datasize - last);
+        if (common_begin >= common_end)
         {
-          j = i + delay;
-          if (j < 0 || j >= datasize)
+          for (int b = 0; b < nr_delays; ++b)
           {
-            continue;
+            const int delay = first + b * lag;
+            sxy[b] = 0;
+            for (int i = std::max(0, -delay); i < std::min(datasize, datasize - delay); ++i)
+            {
+              sxy[b] += x[i] * y[i + delay];
+            }
+          }
+        }
+        else
+        {
+          for (int b = 0; b < nr_delays; ++b)
+          {
+            const int delay = first + b * lag;
+            sxy[b] = 0;
+            for (int i = std::max(0, -delay); i < common_begin; ++i)
+            {
+              sxy[b] += x[i] * y[i + delay];
+            }
+          }
+          for (int i = common_begin; i < common_end; ++i)
+          {
+            const double xi = x[i];
+            const double* yi = y + i + first;
+            for (int b = 0; b < nr_delays; ++b)
+            {
+              sxy[b] += xi * yi[b * lag];
+            }
+          }
+          for (int b = 0; b < nr_delays; ++b)
+          {
+            const int delay = first + b * lag;
+            for (int i = common_end; i < std::min(datasize, datasize - delay); ++i)
+            {
+              sxy[b] += x[i] * y[i + delay];
+            }
           }
-          sxy += (data1[i]) * (data2[j]);
         }
-        result.data.push_back(std::make_pair(delay, sxy));
+
+        for (int b = 0; b < nr_delays; ++b)
+        {
+          result.data.emplace_back(first + b * lag, sxy[b]);
+        }
       }
-      return result;
     }
 
     XCorrArrayType calcxcorr_legacy_mquest_(std::vector<double>& data1,
@@ -19,14 +19,37 @@ namespace OpenSwath
   {
   }
 
-  SpectrumSequence ISpectrumAccess::getMultipleSpectra(double RT, int nr_spectra_to_fetch)
+  std::vector<std::vector<std::size_t> > ISpectrumAccess::getSpectraByRTs(const std::vector<double>& RTs, double deltaRT) const
   {
-    std::vector<std::size_t> indices = getSpectraByRT(RT, 0.0);
-    SpectrumSequence all_spectra;
+    if (const SpectrumRTIndex* index = getRTIndex())
+    {
+      return index->getSpectraByRT(RTs, deltaRT);
+    }
+    std::vector<std::vector<std::size_t> > result;
+    result.reserve(RTs.size());
+    for (double RT : RTs)
+    {
+      result.push_back(getSpectraByRT(RT, deltaRT));
+    }
+    return result;
+  }
 
-    if (indices.empty() )
+  const SpectrumRTIndex* ISpectrumAccess::getRTIndex() const
+  {
+    return nullptr;
+  }
+
+  int ISpectrumAccess::getClosestSpectrumId_(double RT) const
+  {
+    if (const SpectrumRTIndex* index = getRTIndex())
     {
-      return all_spectra;
+      return index->getClosestSpectrum(RT);
+    }
+
+    std::vector<std::size_t> indices = getSpectraByRT(RT, 0.0);
+    if (indices.empty())
+    {
+      return -1;
     }
     int closest_idx = boost::numeric_cast<int>(indices[0]);
     if (indices[0] != 0 &&
@@ -35,6 +58,17 @@ namespace OpenSwath
     {
       closest_idx--;
     }
+    return closest_idx;
+  }
+
+  SpectrumSequence ISpectrumAccess::getMultipleSpectra(double RT, int nr_spectra_to_fetch)
+  {
+    SpectrumSequence all_spectra;
+    int closest_idx = getClosestSpectrumId_(RT);
+    if (closest_idx < 0)
+    {
+      return all_spectra;
+    }
 
     all_spectra.push_back(getSpectrumById(closest_idx));
 
@@ -57,20 +91,12 @@ namespace OpenSwath
 
   SpectrumSequence ISpectrumAccess::getMultipleSpectra(double RT, int nr_spectra_to_fetch, double drift_start, double drift_end)
   {
-    std::vector<std::size_t> indices = getSpectraByRT(RT, 0.0);
     SpectrumSequence all_spectra;
-
-    if (indices.empty() )
+    int closest_idx = getClosestSpectrumId_(RT);
+    if (closest_idx < 0)
     {
       return all_spectra;
     }
-    int closest_idx = boost::numeric_cast<int>(indices[0]);
-    if (indices[0] != 0 &&
-        std::fabs(getSpectrumMetaById(boost::numeric_cast<int>(indices[0]) - 1).RT - RT) <
-        std::fabs(getSpectrumMetaById(boost::numeric_cast<int>(indices[0])).RT - RT))
-    {
-      closest_idx--;
-    }
 
     all_spectra.push_back(getSpectrumById(closest_idx, drift_start, drift_end));
 
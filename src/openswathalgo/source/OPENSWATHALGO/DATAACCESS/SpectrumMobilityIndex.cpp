@@ -0,0 +1,139 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/OPENSWATHALGO/DATAACCESS/SpectrumMobilityIndex.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace OpenSwath
+{
+  SpectrumMobilityIndex::SpectrumMobilityIndex(const OSSpectrum& spectrum, std::size_t block_size, std::size_t nr_bins)
+  {
+    BinaryDataArrayPtr im_arr = spectrum.getDriftTimeArray();
+    if (im_arr == nullptr || spectrum.getMZArray() == nullptr || im_arr->data.size() != spectrum.getMZArray()->data.size() ||
+        im_arr->data.empty() || im_arr->data.size() > std::numeric_limits<std::uint32_t>::max())
+    {
+      return;
+    }
+    const std::vector<double>& im = im_arr->data;
+    const std::size_t n = im.size();
+
+    im_ = im_arr;
+    block_size_ = std::min(std::max(block_size, std::size_t(1)), std::size_t(std::numeric_limits<std::uint16_t>::max()) + 1);
+    nr_bins_ = std::max(nr_bins, std::size_t(1));
+    auto minmax = std::minmax_element(im.begin(), im.end());
+    im_min_ = *minmax.first;
+    bins_per_im_ = (*minmax.second > *minmax.first) ? nr_bins_ / (*minmax.second - *minmax.first) : 0.0;
+
+    const std::size_t nr_blocks = (n + block_size_ - 1) / block_size_;
+    order_.resize(n);
+    offsets_.assign(nr_blocks * (nr_bins_ + 1), 0);
+    std::vector<std::uint32_t> cursor(nr_bins_);
+    for (std::size_t block = 0; block < nr_blocks; ++block)
+    {
+      const std::size_t first = block * block_size_;
+      const std::size_t last = std::min(first + block_size_, n);
+      std::uint32_t* offsets = &offsets_[block * (nr_bins_ + 1)];
+
+      // counting sort of the block by bin (stable, so positions stay ascending within each bin)
+      for (std::size_t k = first; k < last; ++k)
+      {
+        ++offsets[bin_(im[k]) + 1];
+      }
+      offsets[0] = static_cast<std::uint32_t>(first);
+      for (std::size_t b = 0; b < nr_bins_; ++b)
+      {
+        offsets[b + 1] += offsets[b];
+      }
+      std::copy(offsets, offsets + nr_bins_, cursor.begin());
+      for (std::size_t k = first; k < last; ++k)
+      {
+        order_[cursor[bin_(im[k])]++] = static_cast<std::uint16_t>(k - first);
+      }
+    }
+  }
+
+  std::size_t SpectrumMobilityIndex::size() const
+  {
+    return order_.size();
+  }
+
+  bool SpectrumMobilityIndex::empty() const
+  {
+    return order_.empty();
+  }
+
+  bool SpectrumMobilityIndex::isIndexOf(const OSSpectrum& spectrum) const
+  {
+    return !empty() && spectrum.getDriftTimeArray() == im_ && im_->data.size() == order_.size() &&
+           spectrum.getMZArray() != nullptr && spectrum.getMZArray()->data.size() == order_.size();
+  }
+
+  std::size_t SpectrumMobilityIndex::bin_(double im) const
+  {
+    const double bin = std::floor((im - im_min_) * bins_per_im_);
+    if (!(bin > 0.0)) // also catches NaN
+    {
+      return 0;
+    }
+    return std::min(static_cast<std::size_t>(bin), nr_bins_ - 1);
+  }
+
+  void SpectrumMobilityIndex::getPeaks(double drift_start, double drift_end, std::vector<std::size_t>& peaks) const
+  {
+    peaks.clear();
+    if (empty() || drift_end < drift_start)
+    {
+      return;
+    }
+    const std::vector<double>& im = im_->data;
+
+    // the bin function is monotonic: all peaks in bins after first_bin have an
+    // ion mobility of at least drift_start and all peaks in bins before
+    // last_bin one of at most drift_end, only the border bins need a check
+    const std::size_t first_bin = bin_(drift_start);
+    const std::size_t last_bin = bin_(drift_end);
+    const std::size_t nr_blocks = offsets_.size() / (nr_bins_ + 1);
+    for (std::size_t block = 0; block < nr_blocks; ++block)
+    {
+      const std::size_t first = block * block_size_;
+      const std::uint32_t* offsets = &offsets_[block * (nr_bins_ + 1)];
+      const std::size_t block_start = peaks.size();
+      for (std::size_t b = first_bin; b <= last_bin; ++b)
+      {
+        const bool border = (b == first_bin || b == last_bin);
+        for (std::uint32_t p = offsets[b]; p < offsets[b + 1]; ++p)
+        {
+          const std::size_t k = first + order_[p];
+          if (!border || (drift_start <= im[k] && drift_end >= im[k]))
+          {
+            peaks.push_back(k);
+          }
+        }
+      }
+      // merge the bins of this block back into the order of the spectrum
+      if (first_bin != last_bin)
+      {
+        std::sort(peaks.begin() + block_start, peaks.end());
+      }
+    }
+  }
+
+  bool SpectrumMobilityIndex::addToSpectrum(OSSpectrum& spectrum)
+  {
+    boost::shared_ptr<SpectrumMobilityIndex> index(new SpectrumMobilityIndex(spectrum));
+    if (index->empty())
+    {
+      return false;
+    }
+    spectrum.setMobilityIndex(index);
+    return true;
+  }
+}
@@ -0,0 +1,149 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/OPENSWATHALGO/DATAACCESS/SpectrumRTIndex.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace OpenSwath
+{
+  SpectrumRTIndex::SpectrumRTIndex(const std::vector<double>& rts)
+  {
+    if (rts.empty())
+    {
+      return;
+    }
+
+    if (std::is_sorted(rts.begin(), rts.end()))
+    {
+      rts_ = rts;
+    }
+    else
+    {
+      ids_.resize(rts.size());
+      std::iota(ids_.begin(), ids_.end(), 0);
+      std::stable_sort(ids_.begin(), ids_.end(), [&rts](std::size_t a, std::size_t b) { return rts[a] < rts[b]; });
+      rts_.reserve(rts.size());
+      for (std::size_t id : ids_)
+      {
+        rts_.push_back(rts[id]);
+      }
+    }
+
+    // one bin per spectrum; offsets_[b] is the first position whose bin is at least b
+    rt_min_ = rts_.front();
+    const double rt_range = rts_.back() - rts_.front();
+    const std::size_t nr_bins = rts_.size();
+    bins_per_rt_ = rt_range > 0 ? nr_bins / rt_range : 0.0;
+    offsets_.assign(nr_bins + 1, rts_.size());
+    std::size_t bin = 0;
+    for (std::size_t pos = 0; pos < rts_.size(); ++pos)
+    {
+      const std::size_t pos_bin = bin_(rts_[pos]);
+      while (bin <= pos_bin)
+      {
+        offsets_[bin++] = pos;
+      }
+    }
+  }
+
+  std::size_t SpectrumRTIndex::size() const
+  {
+    return rts_.size();
+  }
+
+  bool SpectrumRTIndex::empty() const
+  {
+    return rts_.empty();
+  }
+
+  std::size_t SpectrumRTIndex::bin_(double RT) const
+  {
+    // note: monotonic in RT, thus spectra in bins before bin_(RT) have a
+    // smaller and spectra in bins after bin_(RT) a larger retention time
+    const double bin = std::floor((RT - rt_min_) * bins_per_rt_);
+    if (!(bin > 0)) // also catches NaN
+    {
+      return 0;
+    }
+    if (bin >= double(rts_.size() - 1))
+    {
+      return rts_.size() - 1;
+    }
+    return static_cast<std::size_t>(bin);
+  }
+
+  std::size_t SpectrumRTIndex::lowerBound_(double RT) const
+  {
+    if (rts_.empty() || RT <= rts_.front())
+    {
+      return 0;
+    }
+    if (RT > rts_.back())
+    {
+      return rts_.size();
+    }
+    const std::size_t bin = bin_(RT);
+    return std::lower_bound(rts_.begin() + offsets_[bin], rts_.begin() + offsets_[bin + 1], RT) - rts_.begin();
+  }
+
+  std::vector<std::size_t> SpectrumRTIndex::getSpectraByRT(double RT, double deltaRT) const
+  {
+    std::vector<std::size_t> result;
+    std::size_t pos = lowerBound_(RT - deltaRT);
+    if (pos == rts_.size())
+    {
+      return result;
+    }
+
+    result.push_back(id_(pos));
+    for (++pos; pos < rts_.size() && rts_[pos] <= RT + deltaRT; ++pos)
+    {
+      result.push_back(id_(pos));
+    }
+    return result;
+  }
+
+  std::vector<std::vector<std::size_t> > SpectrumRTIndex::getSpectraByRT(const std::vector<double>& RTs, double deltaRT) const
+  {
+    std::vector<std::vector<std::size_t> > result;
+    result.reserve(RTs.size());
+    for (double RT : RTs)
+    {
+      result.push_back(getSpectraByRT(RT, deltaRT));
+    }
+    return result;
+  }
+
+  int SpectrumRTIndex::getClosestSpectrum(double RT) const
+  {
+    const std::size_t pos = lowerBound_(RT);
+    if (pos == rts_.size())
+    {
+      return -1;
+    }
+    if (pos != 0 && std::fabs(rts_[pos - 1] - RT) < std::fabs(rts_[pos] - RT))
+    {
+      return static_cast<int>(id_(pos - 1));
+    }
+    return static_cast<int>(id_(pos));
+  }
+
+  std::vector<int> SpectrumRTIndex::getClosestSpectra(const std::vector<double>& RTs) const
+  {
+    std::vector<int> result;
+    result.reserve(RTs.size());
+    for (double RT : RTs)
+    {
+      result.push_back(getClosestSpectrum(RT));
+    }
+    return result;
+  }
+}
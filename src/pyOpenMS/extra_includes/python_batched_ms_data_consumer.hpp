@@ -0,0 +1,155 @@
+#ifndef __PYTHON_BATCHED_MS_DATA_CONSUMER_HPP__
+#define __PYTHON_BATCHED_MS_DATA_CONSUMER_HPP__
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/INTERFACES/IMSDataConsumer.h>
+#include <OpenMS/KERNEL/ColumnarExperiment.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/METADATA/ExperimentalSettings.h>
+
+#include <algorithm>
+#include <utility>
+
+// Batched variant of PythonMSDataConsumer (see python_ms_data_consumer.hpp):
+// spectra are collected in C++ and handed to the Python method
+// "consumeSpectra" in batches of batch_size, as a PeakMap (meta data) plus a
+// ColumnarExperiment (concatenated m/z / intensity / RT / MS level arrays and
+// offsets) which the wrapper exposes as NumPy arrays.
+//
+// The parser may run without holding the GIL (MzMLFile.transform with
+// "nogil"), so Python is only entered with PyGILState_Ensure() while a batch,
+// a chromatogram or the settings are delivered. Call flush() once transform()
+// returned to deliver the last (incomplete) batch.
+class PythonBatchedMSDataConsumer :
+  virtual public OpenMS::Interfaces::IMSDataConsumer
+{
+
+    typedef OpenMS::PeakMap::SpectrumType SpectrumType;
+    typedef OpenMS::PeakMap::ChromatogramType ChromatogramType;
+
+    // typedefs for function ptr (helper fxn to convert C++ type to Python object)
+    // see ../addons/MzMLFile.pyx
+    typedef PyObject* (*BatchToPythonWrapper) (const OpenMS::PeakMap &, const OpenMS::ColumnarExperiment &);
+    typedef PyObject* (*ChromatogramToPythonWrapper) (const ChromatogramType &);
+    typedef PyObject* (*ExperimentalSettingsToPythonWrapper) (const OpenMS::ExperimentalSettings &);
+
+    private:
+
+        PyObject *py_consumer_;
+
+        BatchToPythonWrapper wrap_batch_;
+        ChromatogramToPythonWrapper wrap_chromatogram_;
+        ExperimentalSettingsToPythonWrapper wrap_experimental_settings_;
+
+        OpenMS::Size batch_size_;
+
+        /// spectra of the current batch (peaks are moved in, not copied)
+        OpenMS::PeakMap batch_;
+        /// columns of the current batch, reused between batches
+        OpenMS::ColumnarExperiment columns_;
+
+        /// Acquires the GIL for the lifetime of the object
+        struct GILGuard
+        {
+          GILGuard() : state(PyGILState_Ensure()) {}
+          ~GILGuard() { PyGILState_Release(state); }
+          PyGILState_STATE state;
+        };
+
+        /// Calls method @p name of py_consumer_ with @p arg (steals the reference to @p arg, needs the GIL)
+        void callMethod_(const char * name, PyObject * arg)
+        {
+            PyObject * method_name = PyUnicode_FromString(name);
+            PyObject * r = PyObject_CallMethodObjArgs(py_consumer_, method_name, arg, NULL);
+            Py_DECREF(arg);
+            Py_DECREF(method_name);
+            // NULL indicates python exception:
+            if (r == NULL)
+                throw "exception"; // not sense needed, as cython evaluates python strack trace
+            Py_DECREF(r);
+        }
+
+    public:
+
+        /// Constructor
+        PythonBatchedMSDataConsumer(PyObject *py_consumer,
+                                    BatchToPythonWrapper wrap_batch,
+                                    ChromatogramToPythonWrapper wrap_chromatogram,
+                                    ExperimentalSettingsToPythonWrapper wrap_experimental_settings,
+                                    OpenMS::Size batch_size) :
+          py_consumer_(py_consumer),
+          wrap_batch_(wrap_batch),
+          wrap_chromatogram_(wrap_chromatogram),
+          wrap_experimental_settings_(wrap_experimental_settings),
+          batch_size_(std::max(batch_size, OpenMS::Size(1)))
+        {
+           Py_INCREF(py_consumer_);
+           batch_.reserveSpaceSpectra(batch_size_);
+        };
+
+        /// Destructor (spectra which were not flushed are dropped)
+        ~PythonBatchedMSDataConsumer()
+        {
+           GILGuard gil;
+           Py_DECREF(py_consumer_);
+        };
+
+        /// Collects the spectrum; a full batch is delivered to Python
+        virtual void consumeSpectrum(SpectrumType & spec)
+        {
+            batch_.addSpectrum(std::move(spec));
+            if (batch_.size() >= batch_size_)
+            {
+                flush();
+            }
+        };
+
+        /// Delivers the collected spectra to the Python method "consumeSpectra" (no call if there are none)
+        void flush()
+        {
+            if (batch_.empty())
+                return;
+
+            // C++ side of the conversion, without the GIL
+            columns_.assign(batch_);
+            {
+                GILGuard gil;
+                callMethod_("consumeSpectra", wrap_batch_(batch_, columns_));
+            }
+            batch_.clear(false);
+            batch_.reserveSpaceSpectra(batch_size_);
+        };
+
+        /// Consume chromatogram (call Python method "consumeChromatogram" of the py_consumer_ object from C++)
+        virtual void consumeChromatogram(ChromatogramType & chrom)
+        {
+            GILGuard gil;
+            callMethod_("consumeChromatogram", wrap_chromatogram_(chrom));
+        };
+
+        virtual void setExpectedSize(OpenMS::Size expectedSpectra,
+                                     OpenMS::Size expectedChromatograms)
+        {
+            GILGuard gil;
+            PyObject * expected_spectra = PyInt_FromSize_t(expectedSpectra);
+            PyObject * expected_chromatograms = PyInt_FromSize_t(expectedChromatograms);
+            PyObject * method_name = PyUnicode_FromString("setExpectedSize");
+            PyObject * r = PyObject_CallMethodObjArgs(py_consumer_, method_name, expected_spectra,
+                                                      expected_chromatograms, NULL);
+            Py_DECREF(expected_spectra);
+            Py_DECREF(expected_chromatograms);
+            Py_DECREF(method_name);
+            // NULL indicates python exception:
+            if (r == NULL)
+                throw "exception"; // not sense needed, as cython evaluates python strack trace
+            Py_DECREF(r);
+        };
+
+        virtual void setExperimentalSettings(const OpenMS::ExperimentalSettings & exp_settings)
+        {
+            GILGuard gil;
+            callMethod_("setExperimentalSettings", wrap_experimental_settings_(exp_settings));
+        };
+};
+
+#endif
@@ -0,0 +1,171 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include "BenchmarkData.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace std;
+
+namespace OpenMS
+{
+  namespace BenchmarkData
+  {
+    namespace
+    {
+      const unsigned int seed = 42;
+    }
+
+    PeakMap profileExperiment(Size spectra, Size peaks_per_spectrum)
+    {
+      mt19937 rng(seed);
+      uniform_real_distribution<double> mz_dist(200.0, 1500.0);
+      uniform_real_distribution<double> int_dist(1e3, 1e6);
+      const double sigma = 0.003; // FWHM of ~7 mDa
+      const double spacing = 0.0015;
+
+      PeakMap experiment;
+      for (Size s = 0; s < spectra; ++s)
+      {
+        MSSpectrum spec;
+        spec.setRT(double(s));
+        spec.setMSLevel(1);
+        spec.setType(SpectrumSettings::SpectrumType::PROFILE);
+        spec.reserve(peaks_per_spectrum * 11);
+        for (Size p = 0; p < peaks_per_spectrum; ++p)
+        {
+          const double center = mz_dist(rng);
+          const double height = int_dist(rng);
+          for (int k = -5; k <= 5; ++k)
+          {
+            const double d = k * spacing;
+            spec.emplace_back(center + d, height * std::exp(-d * d / (2.0 * sigma * sigma)));
+          }
+        }
+        spec.sortByPosition();
+        experiment.addSpectrum(std::move(spec));
+      }
+      experiment.updateRanges();
+      return experiment;
+    }
+
+    PeakMap centroidedExperiment(Size spectra, Size peaks_per_spectrum)
+    {
+      mt19937 rng(seed);
+      uniform_real_distribution<double> mz_dist(200.0, 1500.0);
+      uniform_real_distribution<double> int_dist(1e3, 1e6);
+
+      PeakMap experiment;
+      for (Size s = 0; s < spectra; ++s)
+      {
+        MSSpectrum spec;
+        spec.setRT(double(s));
+        spec.setMSLevel(1);
+        spec.setType(SpectrumSettings::SpectrumType::CENTROID);
+        spec.reserve(peaks_per_spectrum);
+        for (Size p = 0; p < peaks_per_spectrum; ++p)
+        {
+          spec.emplace_back(mz_dist(rng), int_dist(rng));
+        }
+        spec.sortByPosition();
+        experiment.addSpectrum(std::move(spec));
+      }
+      experiment.updateRanges();
+      return experiment;
+    }
+
+    vector<AASequence> peptides(Size count)
+    {
+      mt19937 rng(seed);
+      const String residues = "ACDEFGHILMNPQSTVWY";
+      uniform_int_distribution<Size> residue_dist(0, residues.size() - 1);
+      uniform_int_distribution<Size> length_dist(6, 19);
+
+      vector<AASequence> result;
+      result.reserve(count);
+      for (Size i = 0; i < count; ++i)
+      {
+        String seq;
+        const Size length = length_dist(rng);
+        for (Size r = 0; r < length; ++r)
+        {
+          seq += residues[residue_dist(rng)];
+        }
+        seq += (i % 2 == 0) ? 'K' : 'R';
+        result.push_back(AASequence::fromString(seq));
+      }
+      return result;
+    }
+
+    vector<PeptideIdentification> peptideIdentifications(Size count)
+    {
+      mt19937 rng(seed);
+      normal_distribution<double> target_dist(30.0, 10.0);
+      normal_distribution<double> decoy_dist(15.0, 5.0);
+      const vector<AASequence> seqs = peptides(count);
+
+      vector<PeptideIdentification> ids(count);
+      for (Size i = 0; i < count; ++i)
+      {
+        const bool decoy = (i % 2 == 1);
+        PeptideHit hit(decoy ? decoy_dist(rng) : target_dist(rng), 1, 2, seqs[i]);
+        hit.setMetaValue("target_decoy", decoy ? "decoy" : "target");
+        ids[i].setScoreType("score");
+        ids[i].setHigherScoreBetter(true);
+        ids[i].setIdentifier("run");
+        ids[i].insertHit(std::move(hit));
+      }
+      return ids;
+    }
+
+    vector<FeatureMap> featureMaps(Size maps, Size features_per_map)
+    {
+      mt19937 rng(seed);
+      uniform_real_distribution<double> mz_dist(200.0, 1500.0);
+      uniform_real_distribution<double> rt_dist(0.0, 3600.0);
+      uniform_real_distribution<double> int_dist(1e4, 1e7);
+      normal_distribution<double> rt_shift(0.0, 5.0);
+      normal_distribution<double> mz_shift(0.0, 0.002);
+      normal_distribution<double> int_factor(1.0, 0.1);
+
+      // the "true" features
+      vector<Feature> templates(features_per_map);
+      for (Feature& f : templates)
+      {
+        f.setMZ(mz_dist(rng));
+        f.setRT(rt_dist(rng));
+        f.setIntensity(int_dist(rng));
+        f.setCharge(2);
+        f.setOverallQuality(1.0);
+      }
+
+      vector<FeatureMap> result(maps);
+      for (FeatureMap& fm : result)
+      {
+        for (const Feature& t : templates)
+        {
+          Feature f(t);
+          f.setRT(t.getRT() + rt_shift(rng));
+          f.setMZ(t.getMZ() + mz_shift(rng));
+          f.setIntensity(t.getIntensity() * std::max(0.1, int_factor(rng)));
+          f.setUniqueId();
+          fm.push_back(f);
+        }
+        fm.updateRanges();
+      }
+      return result;
+    }
+
+    String testDataPath(const String& filename)
+    {
+      return String(OPENMS_BENCHMARK_DATA_PATH) + filename;
+    }
+  }
+}
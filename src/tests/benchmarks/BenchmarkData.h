@@ -0,0 +1,45 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CHEMISTRY/AASequence.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/METADATA/PeptideIdentification.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Deterministic input data for the benchmarks
+
+    All generators use a fixed seed, so every run (and every build) benchmarks the same data.
+  */
+  namespace BenchmarkData
+  {
+    /// Profile MS1 spectra with @p peaks_per_spectrum Gaussian peaks (11 raw data points each) between m/z 200 and 1500
+    PeakMap profileExperiment(Size spectra, Size peaks_per_spectrum);
+
+    /// Centroided MS1 spectra (one second apart) with @p peaks_per_spectrum peaks between m/z 200 and 1500
+    PeakMap centroidedExperiment(Size spectra, Size peaks_per_spectrum);
+
+    /// Random tryptic peptides (7 to 20 residues, ending in K or R)
+    std::vector<AASequence> peptides(Size count);
+
+    /// Peptide identifications with one hit each, alternating target and decoy hits with overlapping score distributions
+    std::vector<PeptideIdentification> peptideIdentifications(Size count);
+
+    /// @p maps feature maps of the same @p features_per_map features with small RT, m/z and intensity deviations
+    std::vector<FeatureMap> featureMaps(Size maps, Size features_per_map);
+
+    /// Path of a file of the class test data (which may not be present, e.g. in source packages)
+    String testDataPath(const String& filename);
+  }
+}
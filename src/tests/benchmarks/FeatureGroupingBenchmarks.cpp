@@ -0,0 +1,33 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include "BenchmarkData.h"
+
+#include <OpenMS/ANALYSIS/MAPMATCHING/FeatureGroupingAlgorithmKD.h>
+#include <OpenMS/KERNEL/ConsensusMap.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace OpenMS;
+using namespace std;
+
+/// link 10 feature maps (argument: features per map)
+static void BM_FeatureGroupingAlgorithmKD_group(benchmark::State& state)
+{
+  const vector<FeatureMap> maps = BenchmarkData::featureMaps(10, state.range(0));
+  FeatureGroupingAlgorithmKD algo;
+  algo.setLogType(ProgressLogger::NONE);
+  for (auto _ : state)
+  {
+    ConsensusMap out;
+    algo.group(maps, out);
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * maps.size() * maps[0].size());
+}
+BENCHMARK(BM_FeatureGroupingAlgorithmKD_group)->ArgName("features")->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
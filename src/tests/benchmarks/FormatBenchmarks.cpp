@@ -0,0 +1,111 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include "BenchmarkData.h"
+
+#include <OpenMS/FORMAT/Base64.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace OpenMS;
+using namespace std;
+
+namespace
+{
+  /// synthetic mzML files (uncompressed and zlib compressed), written once and removed on exit
+  struct SyntheticMzMLFiles_
+  {
+    SyntheticMzMLFiles_()
+    {
+      const PeakMap exp = BenchmarkData::profileExperiment(200, 2000);
+      for (bool zlib : {false, true})
+      {
+        String filename = File::getTempDirectory() + "/" + File::getUniqueName(false) + (zlib ? "_zlib" : "") + ".mzML";
+        MzMLFile mzml;
+        mzml.getOptions().setCompression(zlib);
+        mzml.store(filename, exp);
+        files.push_back(filename);
+      }
+    }
+
+    ~SyntheticMzMLFiles_()
+    {
+      for (const String& f : files)
+      {
+        File::remove(f);
+      }
+    }
+
+    vector<String> files;
+  };
+
+  const String& syntheticMzML(bool zlib)
+  {
+    static const SyntheticMzMLFiles_ files;
+    return files.files[zlib ? 1 : 0];
+  }
+
+  void loadMzML_(benchmark::State& state, const String& filename)
+  {
+    if (!File::exists(filename))
+    {
+      state.SkipWithError(("missing input file " + filename).c_str());
+      return;
+    }
+    Size spectra = 0;
+    for (auto _ : state)
+    {
+      PeakMap exp;
+      MzMLFile().load(filename, exp);
+      spectra = exp.size();
+      benchmark::DoNotOptimize(exp);
+    }
+    state.SetItemsProcessed(state.iterations() * spectra);
+    state.SetBytesProcessed(state.iterations() * File::fileSize(filename));
+  }
+}
+
+/// load 200 synthetic profile spectra with 22k data points each (argument: zlib compression)
+static void BM_MzMLFile_load_synthetic(benchmark::State& state)
+{
+  loadMzML_(state, syntheticMzML(state.range(0) != 0));
+}
+BENCHMARK(BM_MzMLFile_load_synthetic)->ArgName("zlib")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+/// load a small Orbitrap profile file of the class tests
+static void BM_MzMLFile_load_real(benchmark::State& state)
+{
+  loadMzML_(state, BenchmarkData::testDataPath("PeakPickerHiRes_orbitrap.mzML"));
+}
+BENCHMARK(BM_MzMLFile_load_real)->Unit(benchmark::kMillisecond);
+
+/// decode 1M doubles (argument: zlib compression)
+static void BM_Base64_decode(benchmark::State& state)
+{
+  const bool zlib = state.range(0) != 0;
+  const PeakMap exp = BenchmarkData::profileExperiment(1, 1000000 / 11);
+  vector<double> mz;
+  for (const Peak1D& p : exp[0])
+  {
+    mz.push_back(p.getMZ());
+  }
+  String encoded;
+  Base64::encode(mz, Base64::BYTEORDER_LITTLEENDIAN, encoded, zlib);
+
+  vector<double> decoded;
+  for (auto _ : state)
+  {
+    Base64::decode(encoded, Base64::BYTEORDER_LITTLEENDIAN, decoded, zlib);
+    benchmark::DoNotOptimize(decoded.data());
+  }
+  state.SetItemsProcessed(state.iterations() * mz.size());
+  state.SetBytesProcessed(state.iterations() * encoded.size());
+}
+BENCHMARK(BM_Base64_decode)->ArgName("zlib")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,53 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include "BenchmarkData.h"
+
+#include <OpenMS/ANALYSIS/ID/FalseDiscoveryRate.h>
+#include <OpenMS/CHEMISTRY/TheoreticalSpectrumGenerator.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace OpenMS;
+using namespace std;
+
+/// generate b and y ion spectra of 1000 tryptic peptides (argument: maximal fragment charge)
+static void BM_TheoreticalSpectrumGenerator_getSpectrum(benchmark::State& state)
+{
+  const vector<AASequence> peptides = BenchmarkData::peptides(1000);
+  const Int max_charge = Int(state.range(0));
+  TheoreticalSpectrumGenerator tsg;
+  for (auto _ : state)
+  {
+    for (const AASequence& seq : peptides)
+    {
+      PeakSpectrum spec;
+      tsg.getSpectrum(spec, seq, 1, max_charge);
+      benchmark::DoNotOptimize(spec);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * peptides.size());
+}
+BENCHMARK(BM_TheoreticalSpectrumGenerator_getSpectrum)->ArgName("max_charge")->Arg(1)->Arg(3)->Unit(benchmark::kMillisecond);
+
+/// compute q-values of PSMs (argument: number of PSMs, half of them decoys)
+static void BM_FalseDiscoveryRate_apply(benchmark::State& state)
+{
+  const vector<PeptideIdentification> ids = BenchmarkData::peptideIdentifications(state.range(0));
+  FalseDiscoveryRate fdr;
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    vector<PeptideIdentification> scored(ids);
+    state.ResumeTiming();
+    fdr.apply(scored);
+    benchmark::DoNotOptimize(scored.data());
+  }
+  state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK(BM_FalseDiscoveryRate_apply)->ArgName("psms")->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
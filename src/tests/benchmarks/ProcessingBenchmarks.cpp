@@ -0,0 +1,102 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include "BenchmarkData.h"
+
+#include <OpenMS/ANALYSIS/OPENSWATH/ChromatogramExtractorAlgorithm.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/PROCESSING/CENTROIDING/PeakPickerHiRes.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+
+using namespace OpenMS;
+using namespace std;
+
+namespace
+{
+  void pickExperiment_(benchmark::State& state, const PeakMap& exp)
+  {
+    PeakPickerHiRes pp;
+    Size points = 0;
+    for (const MSSpectrum& s : exp)
+    {
+      points += s.size();
+    }
+    for (auto _ : state)
+    {
+      for (const MSSpectrum& s : exp)
+      {
+        MSSpectrum picked;
+        pp.pick(s, picked);
+        benchmark::DoNotOptimize(picked);
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * points);
+  }
+}
+
+/// pick 50 synthetic profile spectra (argument: peaks per spectrum)
+static void BM_PeakPickerHiRes_pick_synthetic(benchmark::State& state)
+{
+  pickExperiment_(state, BenchmarkData::profileExperiment(50, state.range(0)));
+}
+BENCHMARK(BM_PeakPickerHiRes_pick_synthetic)->ArgName("peaks")->Arg(500)->Arg(5000)->Unit(benchmark::kMillisecond);
+
+/// pick a small Orbitrap profile file of the class tests
+static void BM_PeakPickerHiRes_pick_real(benchmark::State& state)
+{
+  const String filename = BenchmarkData::testDataPath("PeakPickerHiRes_orbitrap.mzML");
+  if (!File::exists(filename))
+  {
+    state.SkipWithError(("missing input file " + filename).c_str());
+    return;
+  }
+  PeakMap exp;
+  MzMLFile().load(filename, exp);
+  pickExperiment_(state, exp);
+}
+BENCHMARK(BM_PeakPickerHiRes_pick_real)->Unit(benchmark::kMillisecond);
+
+/// extract XICs (argument: number of coordinates) from 600 centroided spectra with 5000 peaks each
+static void BM_ChromatogramExtractorAlgorithm_extract(benchmark::State& state)
+{
+  boost::shared_ptr<PeakMap> exp(new PeakMap(BenchmarkData::centroidedExperiment(600, 5000)));
+  OpenSwath::SpectrumAccessPtr access = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(exp);
+
+  mt19937 rng(42);
+  uniform_real_distribution<double> mz_dist(200.0, 1500.0);
+  uniform_real_distribution<double> rt_dist(0.0, 500.0);
+  vector<ChromatogramExtractorAlgorithm::ExtractionCoordinates> coordinates(state.range(0));
+  for (Size i = 0; i < coordinates.size(); ++i)
+  {
+    coordinates[i].mz = mz_dist(rng);
+    coordinates[i].rt_start = rt_dist(rng);
+    coordinates[i].rt_end = coordinates[i].rt_start + 100.0;
+    coordinates[i].id = String(i);
+  }
+  sort(coordinates.begin(), coordinates.end(), ChromatogramExtractorAlgorithm::ExtractionCoordinates::SortExtractionCoordinatesByMZ);
+
+  ChromatogramExtractorAlgorithm extractor;
+  for (auto _ : state)
+  {
+    vector<OpenSwath::ChromatogramPtr> chromatograms;
+    for (Size i = 0; i < coordinates.size(); ++i)
+    {
+      chromatograms.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+    }
+    extractor.extractChromatograms(access, chromatograms, coordinates, 50.0, true, -1, "tophat");
+    benchmark::DoNotOptimize(chromatograms.data());
+  }
+  state.SetItemsProcessed(state.iterations() * exp->size());
+}
+BENCHMARK(BM_ChromatogramExtractorAlgorithm_extract)->ArgName("coordinates")->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
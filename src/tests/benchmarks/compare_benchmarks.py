@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+# Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+# SPDX-License-Identifier: BSD-3-Clause
+# --------------------------------------------------------------------------
+# $Maintainer: Timo Sachsenberg $
+# $Authors: Timo Sachsenberg $
+# --------------------------------------------------------------------------
+
+"""Compares two JSON outputs of OpenMS_benchmarks (e.g. of 'make run_benchmarks').
+
+For each benchmark present in both files, the median (or the single run, if no
+repetitions were made) of the contender is compared to the baseline. Exits
+with 1 if any benchmark got slower by more than the threshold, so the script
+can gate upgrades in CI.
+
+usage: compare_benchmarks.py baseline.json contender.json [--threshold 0.1] [--metric real_time|cpu_time]
+"""
+
+import argparse
+import json
+import sys
+
+TIME_UNIT_FACTOR = {"ns": 1e-9, "us": 1e-6, "ms": 1e-3, "s": 1.0}
+
+
+def load(filename, metric):
+    with open(filename) as f:
+        doc = json.load(f)
+    medians = {}
+    singles = {}
+    for b in doc.get("benchmarks", []):
+        if b.get("error_occurred"):
+            continue
+        seconds = b[metric] * TIME_UNIT_FACTOR[b.get("time_unit", "ns")]
+        name = b.get("run_name", b["name"])
+        if b.get("run_type") == "aggregate":
+            if b.get("aggregate_name") == "median":
+                medians[name] = seconds
+        else:
+            singles.setdefault(name, []).append(seconds)
+    # prefer medians; fall back to the median of individual runs
+    for name, times in singles.items():
+        if name not in medians:
+            times.sort()
+            medians[name] = times[len(times) // 2]
+    return medians
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two OpenMS_benchmarks JSON files.")
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--threshold", type=float, default=0.1,
+                        help="relative slow-down which counts as regression (default: 0.1, i.e. 10%%)")
+    parser.add_argument("--metric", choices=["real_time", "cpu_time"], default="real_time")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline, args.metric)
+    contender = load(args.contender, args.metric)
+
+    regressions = []
+    width = max([len(n) for n in baseline] + [9])
+    print(f"{'benchmark':<{width}}  {'baseline':>12}  {'contender':>12}  {'change':>8}")
+    for name in sorted(baseline):
+        if name not in contender:
+            print(f"{name:<{width}}  {baseline[name]:>12.6f}  {'missing':>12}")
+            continue
+        change = contender[name] / baseline[name] - 1.0 if baseline[name] > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            regressions.append(name)
+            flag = "  REGRESSION"
+        print(f"{name:<{width}}  {baseline[name]:>12.6f}  {contender[name]:>12.6f}  {change:>+8.1%}{flag}")
+    for name in sorted(set(contender) - set(baseline)):
+        print(f"{name:<{width}}  {'new':>12}  {contender[name]:>12.6f}")
+
+    if regressions:
+        print(f"\n{len(regressions)} benchmark(s) slower by more than {args.threshold:.0%} ({args.metric}, seconds)")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,94 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/CHEMISTRY/AASequenceCache.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(AASequenceCache, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+AASequenceCache* ptr = nullptr;
+AASequenceCache* nullPointer = nullptr;
+
+START_SECTION((explicit AASequenceCache(Size max_size = 1000000, bool permissive = true)))
+{
+  ptr = new AASequenceCache();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->size(), 0)
+}
+END_SECTION
+
+START_SECTION((~AASequenceCache()))
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((const AASequence& fromString(const String& s)))
+{
+  AASequenceCache cache;
+  TEST_EQUAL(cache.fromString("PEPTIDE") == AASequence::fromString("PEPTIDE"), true)
+  TEST_EQUAL(cache.fromString("PEPTIDER") == AASequence::fromString("PEPTIDER"), true)
+  TEST_EQUAL(cache.fromString("PEPTIDE") == AASequence::fromString("PEPTIDE"), true)
+  TEST_EQUAL(cache.size(), 2)
+
+  // invalid sequences throw and are not cached
+  TEST_EXCEPTION(Exception::ParseError, cache.fromString("PEP(TIDE"))
+  TEST_EQUAL(cache.size(), 2)
+
+  // not permissive
+  AASequenceCache strict(0, false);
+  TEST_EQUAL(cache.fromString("PEP TIDE") == AASequence::fromString("PEPTIDE"), true)
+  TEST_EXCEPTION(Exception::ParseError, strict.fromString("PEP TIDE"))
+}
+END_SECTION
+
+START_SECTION((std::shared_ptr<const AASequence> intern(const String& s)))
+{
+  AASequenceCache cache(2);
+  std::shared_ptr<const AASequence> first = cache.intern("PEPTIDE");
+  TEST_EQUAL(cache.intern("PEPTIDE") == first, true)
+  TEST_EQUAL(cache.intern("PEPTIDER") == first, false)
+
+  // exceeding the maximum size clears the cache, interned sequences stay valid
+  cache.intern("PEPTIDEK");
+  TEST_EQUAL(cache.size(), 1)
+  TEST_EQUAL(first->toString(), "PEPTIDE")
+  TEST_EQUAL(cache.intern("PEPTIDE") == first, false)
+  TEST_EQUAL(*cache.intern("PEPTIDE") == *first, true)
+}
+END_SECTION
+
+START_SECTION((Size size() const))
+{
+  // tested above
+  NOT_TESTABLE
+}
+END_SECTION
+
+START_SECTION((void clear()))
+{
+  AASequenceCache cache;
+  cache.fromString("PEPTIDE");
+  cache.clear();
+  TEST_EQUAL(cache.size(), 0)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -1555,7 +1555,7 @@ END_SECTION
 
 START_SECTION([EXTRA] multithreaded example)
 {
-  OPENMS_LOG_WARN.remove(std::cout);
+  OpenMS_Log_warn.remove(std::cout);
   // All measurements are best of three (wall time, Linux, 8 threads)
   //
   // Serial execution of code:
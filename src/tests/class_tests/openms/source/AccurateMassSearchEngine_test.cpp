@@ -272,6 +272,79 @@ START_SECTION((void queryByConsensusFeature(const ConsensusFeature& cfeat, const
 }
 END_SECTION
 
+START_SECTION((void queryByFeatureMap(const FeatureMap& fmap, const String& ion_mode, std::vector<std::vector<AccurateMassSearchResult>>& results) const))
+{
+  FeatureMap fm;
+  for (Size i = 0; i < 50; ++i)
+  {
+    Feature f;
+    f.setRT(300.0 + i);
+    f.setMZ(i % 2 == 0 ? 399.33486 : 150.0 + 17.3 * i);
+    f.setIntensity(100.0);
+    f.setCharge(1);
+    fm.push_back(f);
+  }
+  std::vector<std::vector<AccurateMassSearchResult>> results;
+  ams_feat_test.queryByFeatureMap(fm, "positive", results);
+  TEST_EQUAL(results.size(), fm.size())
+  ABORT_IF(results.size() != fm.size())
+  bool all_equal = true;
+  for (Size i = 0; i < fm.size(); ++i)
+  {
+    std::vector<AccurateMassSearchResult> single;
+    ams_feat_test.queryByFeature(fm[i], i, "positive", single);
+    all_equal &= (single.size() == results[i].size());
+    for (Size j = 0; all_equal && j < single.size(); ++j)
+    {
+      all_equal &= (single[j].getFormulaString() == results[i][j].getFormulaString()) && (single[j].getSourceFeatureIndex() == i)
+        && (single[j].getFoundAdduct() == results[i][j].getFoundAdduct()) && (results[i][j].getSourceFeatureIndex() == i);
+    }
+  }
+  TEST_EQUAL(all_equal, true)
+  TEST_EQUAL(results[0].size(), 3)
+  TEST_EXCEPTION(Exception::InvalidParameter, ams_feat_test.queryByFeatureMap(fm, "invalid_scan_polarity", results))
+}
+END_SECTION
+
+START_SECTION((void queryByConsensusMap(const ConsensusMap& cmap, const String& ion_mode, std::vector<std::vector<AccurateMassSearchResult>>& results) const))
+{
+  ConsensusMap cm;
+  cm.getColumnHeaders()[0].filename = "a.featureXML";
+  cm.getColumnHeaders()[1].filename = "b.featureXML";
+  for (Size i = 0; i < 20; ++i)
+  {
+    ConsensusFeature cf;
+    cf.setRT(300.0);
+    cf.setMZ(i % 2 == 0 ? 399.33486 : 210.0 + 3.1 * i);
+    cf.setCharge(1);
+    FeatureHandle fh;
+    fh.setMapIndex(1);
+    fh.setIntensity(50.0 + i);
+    cf.insert(fh);
+    cm.push_back(cf);
+  }
+  std::vector<std::vector<AccurateMassSearchResult>> results;
+  ams_feat_test.queryByConsensusMap(cm, "positive", results);
+  TEST_EQUAL(results.size(), cm.size())
+  ABORT_IF(results.size() != cm.size())
+  bool all_equal = true;
+  for (Size i = 0; i < cm.size(); ++i)
+  {
+    std::vector<AccurateMassSearchResult> single;
+    ams_feat_test.queryByConsensusFeature(cm[i], i, 2, "positive", single);
+    all_equal &= (single.size() == results[i].size());
+    for (Size j = 0; all_equal && j < single.size(); ++j)
+    {
+      all_equal &= (single[j].getFormulaString() == results[i][j].getFormulaString()) && (results[i][j].getIndividualIntensities() == single[j].getIndividualIntensities());
+    }
+  }
+  TEST_EQUAL(all_equal, true)
+  TEST_EQUAL(results[0].size(), 3)
+  ABORT_IF(results[0].size() != 3)
+  TEST_EQUAL(results[0][0].getIndividualIntensities().size(), 2)
+}
+END_SECTION
+
 FuzzyStringComparator fsc;
 // fsc.setAcceptableAbsolute((3.04011223650013 - 3.04011223637974)*1.1); // 1.3242891228060217e-10
 // also Linux may give slightly different results depending on optimization level (O0 vs O1) 
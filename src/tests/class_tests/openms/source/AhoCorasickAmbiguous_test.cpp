@@ -341,6 +341,37 @@ START_SECTION(void getAllHits(ACTrieState& state) const)
   NOT_TESTABLE // tested above
 END_SECTION
 
+START_SECTION(void getAllHits(std::vector<ACTrieState>& states) const)
+{
+  // deep needles (beyond the dense top levels of the trie) and queries of different length
+  vector<string> needles = {"MDDDEADC", "MDD", "DD", "DEADC", "ACDEFGHIKLMNPQRSTVWY", "GHIKLM", "PEPTIDEPEPTIDE", "TIDE", "LLLLLLLLLLK"};
+  vector<string> proteins = {"MBBDEABCRAFG", "", "XXACDEFGHIKLMNPQRSTVWYACDEFGHJKLMNPQRSTVWY", "PEPTIDEPEPTIDEPEPTIDE", "**LLLLJLLLLLLK**", "PEPTIXEPEPTIDE", "A"};
+  for (const auto& mm : {std::make_pair(0, 0), std::make_pair(2, 0), std::make_pair(0, 1), std::make_pair(3, 2)})
+  {
+    ACTrie t(mm.first, mm.second);
+    t.addNeedlesAndCompress(needles);
+
+    std::vector<ACTrieState> states(proteins.size());
+    for (size_t i = 0; i < proteins.size(); ++i)
+    {
+      states[i].setQuery(proteins[i]);
+    }
+    t.getAllHits(states);
+
+    for (size_t i = 0; i < proteins.size(); ++i)
+    {
+      ACTrieState single;
+      single.setQuery(proteins[i]);
+      t.getAllHits(single);
+      StringList expected, observed;
+      for (const auto& hit : single.hits) expected.push_back(needles[hit.needle_index] + "@" + String(hit.query_pos));
+      for (const auto& hit : states[i].hits) observed.push_back(needles[hit.needle_index] + "@" + String(hit.query_pos));
+      compareHits(__LINE__, proteins[i], ListUtils::concatenate(expected, ","), observed);
+    }
+  }
+}
+END_SECTION
+
 /////////////////////////////////////
 //// testing ACTrieState
 /////////////////////////////////////
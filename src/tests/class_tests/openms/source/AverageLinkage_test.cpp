@@ -118,6 +118,60 @@ START_SECTION((void operator()(DistanceMatrix< float > &original_distance, std::
 }
 END_SECTION
 
+START_SECTION(([EXTRA] nearest-neighbor chain gives the same tree as merging the closest pair))
+{
+	// random distances (no ties), compared to the textbook algorithm on explicit clusters
+	Size n = 60;
+	DistanceMatrix<float> matrix(n, 0);
+	vector<vector<float>> full(n, vector<float>(n, 0));
+	Size seed = 42;
+	for (Size i = 1; i < n; ++i)
+	{
+		for (Size j = 0; j < i; ++j)
+		{
+			seed = (seed * 1103515245 + 12345) % 2147483648;
+			full[i][j] = full[j][i] = float(seed % 1000000) / 1000000.0f;
+			matrix.setValueQuick(i, j, full[i][j]);
+		}
+	}
+	vector<vector<Size>> clusters(n);
+	for (Size i = 0; i < n; ++i) clusters[i].push_back(i);
+	vector<BinaryTreeNode> expected;
+	while (clusters.size() > 1)
+	{
+		Size best_a = 0, best_b = 1;
+		double best = 2.0;
+		for (Size a = 0; a < clusters.size(); ++a)
+		{
+			for (Size b = a + 1; b < clusters.size(); ++b)
+			{
+				double sum = 0;
+				for (Size x : clusters[a]) for (Size y : clusters[b]) sum += full[x][y];
+				double average = sum / double(clusters[a].size() * clusters[b].size());
+				if (average < best) { best = average; best_a = a; best_b = b; }
+			}
+		}
+		expected.push_back(BinaryTreeNode(clusters[best_a][0], clusters[best_b][0], float(best)));
+		clusters[best_a].insert(clusters[best_a].end(), clusters[best_b].begin(), clusters[best_b].end());
+		sort(clusters[best_a].begin(), clusters[best_a].end());
+		clusters.erase(clusters.begin() + best_b);
+	}
+
+	vector< BinaryTreeNode > result;
+	AverageLinkage al;
+	al(matrix, result);
+	TEST_EQUAL(result.size(), expected.size());
+	ABORT_IF(result.size() != expected.size());
+	TOLERANCE_ABSOLUTE(0.0001);
+	for (Size i = 0; i < result.size(); ++i)
+	{
+			TEST_EQUAL(result[i].left_child, expected[i].left_child);
+			TEST_EQUAL(result[i].right_child, expected[i].right_child);
+			TEST_REAL_SIMILAR(result[i].distance, expected[i].distance);
+	}
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
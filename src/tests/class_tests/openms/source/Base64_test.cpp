@@ -151,6 +151,27 @@ START_SECTION((template < typename ToType > void decode(const String &in, ByteOr
   src = "whoPutMeHere:somecrazyperson,obviously!WhatifIcontaininvalidcharacterslikethese";
   TEST_EXCEPTION(Exception::ConversionError, b64.decode(src, Base64::BYTEORDER_BIGENDIAN, res) );
 
+  // decoding writes directly into the result: check all lengths around the register size
+  for (Size n = 1; n < 40; ++n)
+  {
+    std::vector<double> in_double(n), out_double;
+    std::vector<float> in_float(n), out_float;
+    for (Size k = 0; k < n; ++k)
+    {
+      in_double[k] = 100.0 + 0.37 * k;
+      in_float[k] = 100.0f + 0.37f * k;
+    }
+    String encoded;
+    std::vector<double> tmp_double = in_double;
+    b64.encode(tmp_double, Base64::BYTEORDER_BIGENDIAN, encoded);
+    b64.decode(encoded, Base64::BYTEORDER_BIGENDIAN, out_double);
+    TEST_EQUAL(out_double == in_double, true)
+    std::vector<float> tmp_float = in_float;
+    b64.encode(tmp_float, Base64::BYTEORDER_LITTLEENDIAN, encoded);
+    b64.decode(encoded, Base64::BYTEORDER_LITTLEENDIAN, out_float);
+    TEST_EQUAL(out_float == in_float, true)
+  }
+
   // TODO : some error checking and handling
   // currently there is no "safe" Base64 decoding that checks that all
   // characters are actually valid and the string is actually encoding to
@@ -140,4 +140,82 @@ START_TEST(BasicProteinInferenceAlgorithm, "$Id$")
     }
     END_SECTION
 
+    START_SECTION([EXTRA] BasicProteinInferenceAlgorithm on multiple runs)
+    {
+      auto make_run = [](const String& id)
+      {
+        ProteinIdentification run;
+        run.setIdentifier(id);
+        for (const String& acc : {"A", "B"})
+        {
+          ProteinHit hit;
+          hit.setAccession(acc);
+          run.insertHit(hit);
+        }
+        return run;
+      };
+      auto make_pep = [](const String& id, const String& seq, double score, const std::vector<String>& accs)
+      {
+        PeptideIdentification pep;
+        pep.setIdentifier(id);
+        pep.setScoreType("score");
+        pep.setHigherScoreBetter(true);
+        PeptideHit hit(score, 1, 2, AASequence::fromString(seq));
+        for (const String& acc : accs)
+        {
+          PeptideEvidence ev;
+          ev.setProteinAccession(acc);
+          hit.addPeptideEvidence(ev);
+        }
+        pep.insertHit(hit);
+        return pep;
+      };
+
+      BasicProteinInferenceAlgorithm bpia;
+      Param p = bpia.getParameters();
+      p.setValue("min_peptides_per_protein", 0);
+      p.setValue("annotate_indistinguishable_groups", "false");
+      bpia.setParameters(p);
+
+      // runs with unique identifiers (processed in parallel), each one only uses its own peptides
+      vector<ProteinIdentification> prots{make_run("run1"), make_run("run2")};
+      vector<PeptideIdentification> peps{
+        make_pep("run1", "PEPTIDE", 0.5, {"A"}),
+        make_pep("run2", "PEPTIDEK", 0.9, {"B"}),
+        make_pep("run3", "PEPTIDER", 0.3, {"A"}),
+        make_pep("run1", "PEPTIDER", 0.7, {"A", "B", "C"})};
+      bpia.run(peps, prots);
+      TEST_EQUAL(prots[0].getHits()[0].getScore(), 0.7)
+      TEST_EQUAL(prots[0].getHits()[1].getScore(), 0.7)
+      TEST_EQUAL(prots[0].getHits()[0].getMetaValue("nr_found_peptides"), 2)
+      TEST_EQUAL(prots[0].getHits()[1].getMetaValue("nr_found_peptides"), 1)
+      TEST_EQUAL(prots[1].getHits()[0].getScore(), -std::numeric_limits<double>::infinity())
+      TEST_EQUAL(prots[1].getHits()[1].getScore(), 0.9)
+      TEST_EQUAL(prots[1].getHits()[0].getMetaValue("nr_found_peptides"), 0)
+      TEST_EQUAL(prots[1].getHits()[1].getMetaValue("nr_found_peptides"), 1)
+      // the order of the peptides is kept
+      TEST_EQUAL(peps.size(), 4)
+      TEST_EQUAL(peps[0].getHits()[0].getSequence().toString(), "PEPTIDE")
+      TEST_EQUAL(peps[1].getHits()[0].getSequence().toString(), "PEPTIDEK")
+      TEST_EQUAL(peps[2].getIdentifier(), "run3")
+      TEST_EQUAL(peps[3].getHits()[0].getSequence().toString(), "PEPTIDER")
+
+      // duplicate identifiers: the runs are processed one by one on all peptides
+      vector<ProteinIdentification> dup_prots{make_run("run1"), make_run("run1")};
+      vector<PeptideIdentification> dup_peps{make_pep("run1", "PEPTIDE", 0.5, {"A"}), make_pep("run1", "PEPTIDEK", 0.9, {"B"})};
+      bpia.run(dup_peps, dup_prots);
+      for (const auto& run : dup_prots)
+      {
+        TEST_EQUAL(run.getHits()[0].getScore(), 0.5)
+        TEST_EQUAL(run.getHits()[1].getScore(), 0.9)
+      }
+
+      // mixed score types
+      peps.push_back(make_pep("run2", "PEPTIDE", 0.1, {"A"}));
+      peps.back().setScoreType("other");
+      TEST_EXCEPTION(Exception::InvalidParameter, bpia.run(peps, prots))
+      TEST_EQUAL(peps.size(), 5)
+    }
+    END_SECTION
+
 END_TEST
@@ -203,6 +203,40 @@ START_SECTION((template <typename ProbabilityIterator, typename CoordinateIterat
 }
 END_SECTION;
 //-----------------------------------------------------------
+START_SECTION((void update(const probability_container& probability)))
+{
+	BasicStatistics<> stats;
+	const std::vector<double> probability(dvector_data, dvector_data + num_numbers);
+	stats.update( probability );
+	TOLERANCE_ABSOLUTE(0.1);
+	TEST_REAL_SIMILAR( stats.sum(), 15228.2 );
+	TEST_REAL_SIMILAR( stats.mean(), 96.4639 );
+	TEST_REAL_SIMILAR( stats.variance(), 3276.51 );
+
+	stats.update( std::vector<double>(dvector_zero_data, dvector_zero_data + num_zeros) );
+	TEST_REAL_SIMILAR( stats.sum(), 0 );
+	TEST_REAL_SIMILAR( stats.mean(), 0 );
+	TEST_REAL_SIMILAR( stats.variance(), 0 );
+}
+END_SECTION
+//-----------------------------------------------------------
+START_SECTION((void update(const probability_container& probability, const coordinate_container& coordinate)))
+{
+	BasicStatistics<> stats;
+	const std::vector<double> probability(dvector_data, dvector_data + num_numbers);
+	std::vector<double> coordinate;
+	for ( Size i = 0; i < probability.size(); ++i ) coordinate.push_back(1000. - i);
+	stats.update( probability, coordinate );
+	TOLERANCE_ABSOLUTE(0.1);
+	TEST_REAL_SIMILAR( stats.sum(), 15228.2 );
+	TEST_REAL_SIMILAR( stats.mean(), 1000.-96.4639 );
+	TEST_REAL_SIMILAR( stats.variance(), 3276.51 );
+
+	coordinate.pop_back();
+	TEST_EXCEPTION( Exception::InvalidRange, stats.update( probability, coordinate ) );
+}
+END_SECTION;
+//-----------------------------------------------------------
 
 BasicStatistics<double> bid;
 
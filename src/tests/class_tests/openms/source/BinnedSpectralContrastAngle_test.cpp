@@ -80,6 +80,34 @@ START_SECTION((double operator()(const BinnedSpectrum &spec) const ))
 }
 END_SECTION
 
+START_SECTION((std::vector<double> scoreAll(const BinnedSpectrum& query, const std::vector<BinnedSpectrum>& library) const))
+{
+  PeakSpectrum s1;
+  DTAFile().load(OPENMS_GET_TEST_DATA_PATH("PILISSequenceDB_DFPIANGER_1.dta"), s1);
+  BinnedSpectrum query(s1, 1.5, false, 2, BinnedSpectrum::DEFAULT_BIN_OFFSET_LOWRES);
+  std::vector<BinnedSpectrum> library;
+  PeakSpectrum s2 = s1;
+  while (s2.size() > 1)
+  { // more and more peaks missing at the start
+    library.emplace_back(s2, 1.5, false, 2, BinnedSpectrum::DEFAULT_BIN_OFFSET_LOWRES);
+    s2.erase(s2.begin(), s2.begin() + std::min(Size(5), s2.size() - 1));
+  }
+  PeakSpectrum s3 = s1; // no overlap with the query, bins beyond its range
+  for (Peak1D& p : s3) p.setMZ(p.getMZ() + 5000.0);
+  library.emplace_back(s3, 1.5, false, 2, BinnedSpectrum::DEFAULT_BIN_OFFSET_LOWRES);
+
+  std::vector<double> scores = ptr->scoreAll(query, library);
+  TEST_EQUAL(scores.size(), library.size())
+  for (Size i = 0; i < library.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(scores[i], (*ptr)(query, library[i]))
+  }
+  TEST_REAL_SIMILAR(scores[0], 1.0)
+  TEST_REAL_SIMILAR(scores.back(), 0.0)
+  TEST_EQUAL(ptr->scoreAll(query, std::vector<BinnedSpectrum>()).size(), 0)
+}
+END_SECTION
+
 delete ptr;
 
 /////////////////////////////////////////////////////////////
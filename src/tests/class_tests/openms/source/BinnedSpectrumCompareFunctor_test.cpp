@@ -11,6 +11,7 @@
 
 ///////////////////////////
 #include <OpenMS/COMPARISON/BinnedSpectrumCompareFunctor.h>
+#include <OpenMS/COMPARISON/BinnedSpectralContrastAngle.h>
 
 using namespace OpenMS;
 using namespace std;
@@ -58,6 +59,45 @@ START_SECTION((virtual double operator()(const BinnedSpectrum &spec) const =0))
 }
 END_SECTION
 
+START_SECTION((virtual std::vector<double> scoreAll(const BinnedSpectrum& query, const std::vector<BinnedSpectrum>& library) const))
+{
+  NOT_TESTABLE // tested in derived classes
+}
+END_SECTION
+
+START_SECTION((std::vector<std::pair<Size, double>> topK(const BinnedSpectrum& query, const std::vector<BinnedSpectrum>& library, Size k) const))
+{
+  PeakSpectrum s;
+  for (double mz : {100.0, 200.0, 300.0, 400.0})
+  {
+    s.push_back(Peak1D(mz, 100.0f));
+  }
+  BinnedSpectrum query(s, 1.0, false, 0, 0.0);
+  std::vector<BinnedSpectrum> library;
+  for (Size missing = 4; missing > 0; --missing)
+  { // library[i] shares i peaks with the query (plus one other peak)
+    PeakSpectrum l(s);
+    l.erase(l.begin() + (4 - missing), l.end());
+    l.push_back(Peak1D(900.0, 100.0f));
+    library.emplace_back(BinnedSpectrum(l, 1.0, false, 0, 0.0));
+  }
+  library.emplace_back(BinnedSpectrum(s, 1.0, false, 0, 0.0)); // library[4] and library[5] are identical to the query
+  library.push_back(library.back());
+
+  BinnedSpectralContrastAngle sca;
+  std::vector<std::pair<Size, double>> hits = sca.topK(query, library, 3);
+  TEST_EQUAL(hits.size(), 3)
+  ABORT_IF(hits.size() != 3)
+  TEST_EQUAL(hits[0].first, 4)
+  TEST_REAL_SIMILAR(hits[0].second, 1.0)
+  TEST_EQUAL(hits[1].first, 5) // tie, ordered by index
+  TEST_EQUAL(hits[2].first, 3)
+  TEST_REAL_SIMILAR(hits[2].second, 0.75)
+  TEST_EQUAL(sca.topK(query, library, 100).size(), library.size())
+  TEST_EQUAL(sca.topK(query, library, 0).size(), 0)
+}
+END_SECTION
+
 START_SECTION(([BinnedSpectrumCompareFunctor::IncompatibleBinning] IncompatibleBinning(const char *file, int line, const char *function, const char *message="compared spectra have different settings in binsize and/or binspread")))
 {
   NOT_TESTABLE
@@ -0,0 +1,127 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/DATASTRUCTURES/BloomFilter.h>
+///////////////////////////
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
+
+#include <string>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(BloomFilter, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+BloomFilter* ptr = nullptr;
+BloomFilter* nullPointer = nullptr;
+START_SECTION((explicit BloomFilter(Size expected_keys, double false_positive_rate = 0.01)))
+{
+  ptr = new BloomFilter(1000);
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  // about 9.6 bits and 7 hashes per key for 1%
+  TEST_EQUAL(ptr->getBitCount() >= 9500 && ptr->getBitCount() <= 9700, true)
+  TEST_EQUAL(ptr->getHashCount(), 7)
+
+  BloomFilter tiny(0);
+  TEST_EQUAL(tiny.getBitCount() >= 64, true)
+
+  TEST_EXCEPTION(Exception::InvalidValue, BloomFilter(10, 0.0))
+  TEST_EXCEPTION(Exception::InvalidValue, BloomFilter(10, 1.0))
+}
+END_SECTION
+
+START_SECTION((~BloomFilter()))
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((void insert(std::string_view key)))
+{
+  NOT_TESTABLE // tested with mayContain
+}
+END_SECTION
+
+START_SECTION((bool mayContain(std::string_view key) const))
+{
+  BloomFilter filter(10000, 0.01);
+  TEST_EQUAL(filter.mayContain("PEPTIDE"), false)
+  for (Size i = 0; i < 10000; ++i)
+  {
+    filter.insert("PEPTIDE" + std::to_string(i));
+  }
+  // no false negatives
+  Size found = 0;
+  for (Size i = 0; i < 10000; ++i)
+  {
+    found += filter.mayContain("PEPTIDE" + std::to_string(i));
+  }
+  TEST_EQUAL(found, 10000)
+  // false positive rate close to the requested one
+  Size false_positives = 0;
+  for (Size i = 0; i < 10000; ++i)
+  {
+    false_positives += filter.mayContain("PROTEIN" + std::to_string(i));
+  }
+  TEST_EQUAL(false_positives < 200, true)
+  // the empty key is a key like any other
+  filter.insert("");
+  TEST_EQUAL(filter.mayContain(""), true)
+}
+END_SECTION
+
+START_SECTION((void clear()))
+{
+  BloomFilter filter(100);
+  filter.insert("PEPTIDE");
+  TEST_EQUAL(filter.mayContain("PEPTIDE"), true)
+  filter.clear();
+  TEST_EQUAL(filter.mayContain("PEPTIDE"), false)
+}
+END_SECTION
+
+START_SECTION((Size getBitCount() const))
+{
+  NOT_TESTABLE // tested with the constructor
+}
+END_SECTION
+
+START_SECTION((Size getHashCount() const))
+{
+  NOT_TESTABLE // tested with the constructor
+}
+END_SECTION
+
+START_SECTION([EXTRA] concurrent insert)
+{
+  BloomFilter filter(100000, 0.001);
+  TaskScheduler::parallelFor(0, 100000, [&](SignedSize i)
+  {
+    filter.insert("PEPTIDE" + std::to_string(i));
+  }, 100);
+  Size found = 0;
+  for (Size i = 0; i < 100000; ++i)
+  {
+    found += filter.mayContain("PEPTIDE" + std::to_string(i));
+  }
+  TEST_EQUAL(found, 100000)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -16,6 +16,7 @@
 #include <OpenMS/KERNEL/MSSpectrum.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/SYSTEM/File.h>
 
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wshadow"
@@ -264,6 +265,93 @@ START_SECTION(( void createMemdumpIndex(String filename) ))
 }
 END_SECTION
 
+START_SECTION(( [EXTRA] void writeMemdump(const MapType& exp, const String& out, bool compress) const ))
+{
+  std::string tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  std::string tmp_filename_compressed;
+  NEW_TMP_FILE(tmp_filename_compressed);
+
+  PeakMap exp;
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), exp);
+
+  CachedMzMLHandler cache;
+  cache.writeMemdump(exp, tmp_filename, false);
+  cache.createMemdumpIndex(tmp_filename);
+  TEST_EQUAL(cache.isCompressed(), false)
+
+  CachedMzMLHandler cache_compressed;
+  cache_compressed.writeMemdump(exp, tmp_filename_compressed, true);
+  cache_compressed.createMemdumpIndex(tmp_filename_compressed);
+  TEST_EQUAL(cache_compressed.isCompressed(), true)
+  TEST_EQUAL(cache_compressed.getSpectraIndex().size(), 4)
+  TEST_EQUAL(cache_compressed.getChromatogramIndex().size(), 2)
+  TEST_EQUAL(File::fileSize(tmp_filename_compressed) < File::fileSize(tmp_filename), true)
+
+  // reading the whole file back gives the same data
+  PeakMap exp_plain, exp_compressed;
+  cache.readMemdump(exp_plain, tmp_filename);
+  cache_compressed.readMemdump(exp_compressed, tmp_filename_compressed);
+  TEST_EQUAL(exp_compressed.size(), exp_plain.size())
+  TEST_EQUAL(exp_compressed.getChromatograms().size(), exp_plain.getChromatograms().size())
+  for (Size i = 0; i < exp_plain.size(); i++)
+  {
+    TEST_TRUE(exp_compressed[i] == exp_plain[i])
+  }
+  for (Size i = 0; i < exp_plain.getChromatograms().size(); i++)
+  {
+    TEST_TRUE(exp_compressed.getChromatogram(i) == exp_plain.getChromatogram(i))
+  }
+}
+END_SECTION
+
+START_SECTION(( static void uncompressRecord(const char* buffer, Size buffer_size, std::string& record) ))
+{
+  std::string tmp_filename_compressed;
+  NEW_TMP_FILE(tmp_filename_compressed);
+
+  CachedMzMLHandler cache_compressed;
+  cache_compressed.writeMemdump(exp, tmp_filename_compressed, true);
+  cache_compressed.createMemdumpIndex(tmp_filename_compressed);
+
+  std::ifstream ifs_(tmp_filename_compressed.c_str(), std::ios::binary);
+  std::string buffer((std::istreambuf_iterator<char>(ifs_)), std::istreambuf_iterator<char>());
+
+  // random access to a single record
+  std::streamoff offset = cache_compressed.getSpectraIndex()[2];
+  std::string record;
+  CachedMzMLHandler::uncompressRecord(buffer.data() + offset, buffer.size() - offset, record);
+  MSSpectrum s;
+  CachedMzMLHandler::readSpectrum(s, record.data(), record.size());
+  TEST_EQUAL(s.size(), exp.getSpectrum(2).size())
+  for (Size i = 0; i < s.size(); i++)
+  {
+    TEST_REAL_SIMILAR(s[i].getMZ(), exp.getSpectrum(2)[i].getMZ())
+    TEST_REAL_SIMILAR(s[i].getIntensity(), exp.getSpectrum(2)[i].getIntensity())
+  }
+
+  // same record read from a stream
+  std::string record_stream;
+  ifs_.clear();
+  ifs_.seekg(cache_compressed.getSpectraIndex()[2]);
+  CachedMzMLHandler::uncompressRecord(ifs_, record_stream);
+  TEST_EQUAL(record_stream == record, true)
+
+  offset = cache_compressed.getChromatogramIndex()[1];
+  CachedMzMLHandler::uncompressRecord(buffer.data() + offset, buffer.size() - offset, record);
+  MSChromatogram c;
+  CachedMzMLHandler::readChromatogram(c, record.data(), record.size());
+  TEST_EQUAL(c.size(), exp.getChromatogram(1).size())
+
+  // truncated or corrupt records
+  offset = cache_compressed.getSpectraIndex()[0];
+  TEST_EXCEPTION(Exception::ParseError, CachedMzMLHandler::uncompressRecord(buffer.data() + offset, 2 * sizeof(Size) + 1, record))
+  std::string corrupt = buffer.substr(offset, std::streamoff(cache_compressed.getSpectraIndex()[1]) - offset);
+  corrupt[2 * sizeof(Size)] = ~corrupt[2 * sizeof(Size)];
+  TEST_EXCEPTION(Exception::ParseError, CachedMzMLHandler::uncompressRecord(corrupt.data(), corrupt.size(), record))
+}
+END_SECTION
+
 START_SECTION(( const std::vector<std::streampos>& getSpectraIndex() const ))
 {
   TEST_EQUAL( cache_.getSpectraIndex().size(), 4);
@@ -386,6 +474,70 @@ START_SECTION( static inline void readChromatogramFast(OpenSwath::BinaryDataArra
 }
 END_SECTION
 
+START_SECTION(static std::vector<OpenSwath::BinaryDataArrayPtr> readSpectrumFast(const char* buffer, Size buffer_size, int& ms_level, double& rt))
+{
+  std::ifstream ifs_(tmp_filename.c_str(), std::ios::binary);
+  std::string buffer((std::istreambuf_iterator<char>(ifs_)), std::istreambuf_iterator<char>());
+  std::vector<std::streampos> spectra_index = cache_.getSpectraIndex();
+  TEST_EQUAL(spectra_index.size(), 4)
+
+  for (Size k = 0; k < spectra_index.size(); k++)
+  {
+    std::streamoff offset = spectra_index[k];
+    int ms_level = -1;
+    double rt = -1.0;
+    std::vector<OpenSwath::BinaryDataArrayPtr> data =
+      CachedMzMLHandler::readSpectrumFast(buffer.data() + offset, buffer.size() - offset, ms_level, rt);
+
+    TEST_EQUAL(ms_level, exp.getSpectrum(k).getMSLevel())
+    TEST_REAL_SIMILAR(rt, exp.getSpectrum(k).getRT())
+    TEST_EQUAL(data.size(), 2 + exp.getSpectrum(k).getFloatDataArrays().size())
+    TEST_EQUAL(data[0]->data.size(), exp.getSpectrum(k).size())
+    for (Size i = 0; i < data[0]->data.size(); i++)
+    {
+      TEST_REAL_SIMILAR(data[0]->data[i], exp.getSpectrum(k)[i].getMZ())
+      TEST_REAL_SIMILAR(data[1]->data[i], exp.getSpectrum(k)[i].getIntensity())
+    }
+  }
+
+  // same result as reading from the stream
+  MSSpectrum s1, s2;
+  ifs_.clear();
+  ifs_.seekg(spectra_index[1]);
+  CachedMzMLHandler::readSpectrum(s1, ifs_);
+  CachedMzMLHandler::readSpectrum(s2, buffer.data() + std::streamoff(spectra_index[1]), buffer.size() - std::streamoff(spectra_index[1]));
+  TEST_TRUE(s1 == s2)
+
+  // should not read past the end of the buffer
+  int ms_level = -1;
+  double rt = -1.0;
+  std::streamoff offset = spectra_index[0];
+  TEST_EXCEPTION(Exception::ParseError, CachedMzMLHandler::readSpectrumFast(buffer.data() + offset, 10, ms_level, rt))
+  TEST_EXCEPTION(Exception::ParseError, CachedMzMLHandler::readSpectrumFast(buffer.data() + offset, std::streamoff(spectra_index[1]) - offset - 1, ms_level, rt))
+}
+END_SECTION
+
+START_SECTION(static std::vector<OpenSwath::BinaryDataArrayPtr> readChromatogramFast(const char* buffer, Size buffer_size))
+{
+  std::ifstream ifs_(tmp_filename.c_str(), std::ios::binary);
+  std::string buffer((std::istreambuf_iterator<char>(ifs_)), std::istreambuf_iterator<char>());
+  std::vector<std::streampos> chrom_index = cache_.getChromatogramIndex();
+  TEST_EQUAL(chrom_index.size(), 2)
+
+  std::streamoff offset = chrom_index[0];
+  std::vector<OpenSwath::BinaryDataArrayPtr> data = CachedMzMLHandler::readChromatogramFast(buffer.data() + offset, buffer.size() - offset);
+  TEST_EQUAL(data[0]->data.size(), exp.getChromatogram(0).size())
+  for (Size i = 0; i < data[0]->data.size(); i++)
+  {
+    TEST_REAL_SIMILAR(data[0]->data[i], exp.getChromatogram(0)[i].getRT())
+    TEST_REAL_SIMILAR(data[1]->data[i], exp.getChromatogram(0)[i].getIntensity())
+  }
+
+  // should not read past the end of the buffer
+  TEST_EXCEPTION(Exception::ParseError, CachedMzMLHandler::readChromatogramFast(buffer.data() + offset, 20))
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -154,6 +154,39 @@ START_SECTION(( [EXTRA] testCaching))
 }
 END_SECTION
 
+START_SECTION(( bool isMemoryMapped() const ))
+{
+  TEST_EQUAL(cache_example.isMemoryMapped(), true)
+  CachedmzML copy(cache_example);
+  TEST_EQUAL(copy.isMemoryMapped(), true)
+  // copies share the mapping and read the same data
+  TEST_TRUE(copy.getSpectrum(1) == cache_example.getSpectrum(1))
+  TEST_TRUE(copy.getChromatogram(0) == cache_example.getChromatogram(0))
+}
+END_SECTION
+
+START_SECTION(( bool isCompressed() const ))
+{
+  TEST_EQUAL(cache_example.isCompressed(), false)
+
+  std::string tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  CachedmzML::store(tmp_filename, exp, true);
+  CachedmzML cache_compressed;
+  CachedmzML::load(tmp_filename, cache_compressed);
+  TEST_EQUAL(cache_compressed.isCompressed(), true)
+  TEST_EQUAL(cache_compressed.getNrSpectra(), cache_example.getNrSpectra())
+  for (Size i = 0; i < cache_example.getNrSpectra(); i++)
+  {
+    TEST_TRUE(cache_compressed.getSpectrum(i) == cache_example.getSpectrum(i))
+  }
+  for (Size i = 0; i < cache_example.getNrChromatograms(); i++)
+  {
+    TEST_TRUE(cache_compressed.getChromatogram(i) == cache_example.getChromatogram(i))
+  }
+}
+END_SECTION
+
 START_SECTION(( size_t getNrSpectra() const ))
     TEST_EQUAL(cache_example.getNrSpectra(), 4)
 END_SECTION
@@ -11,6 +11,7 @@
 #include <OpenMS/CONCEPT/ClassTest.h>
 #include <OpenMS/test_config.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/KERNEL/ColumnarSpectrum.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
 
 using namespace OpenMS;
@@ -110,6 +111,79 @@ START_SECTION(void extractChromatograms(const OpenSwath::SpectrumAccessPtr input
 }
 END_SECTION
 
+START_SECTION(void extractChromatograms(const std::vector<ColumnarSpectrum>& input, std::vector< OpenSwath::ChromatogramPtr >& output, const std::vector<ExtractionCoordinates>& extraction_coordinates, double mz_extraction_window, bool ppm, double im_extraction_window, const String& filter))
+{
+  double extract_window = 0.05;
+  boost::shared_ptr<PeakMap > exp(new PeakMap);
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("ChromatogramExtractor_input.mzML"), *exp);
+  OpenSwath::SpectrumAccessPtr expptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(exp);
+
+  std::vector<ColumnarSpectrum> columnar;
+  for (const auto& spec : *exp)
+  {
+    columnar.emplace_back(spec);
+  }
+
+  ChromatogramExtractorAlgorithm extractor;
+
+  std::vector< ChromatogramExtractorAlgorithm::ExtractionCoordinates > coordinates;
+  std::vector< OpenSwath::ChromatogramPtr > out_exp, out_ref;
+  for (int i = 0; i < 3; i++)
+  {
+    out_exp.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+    out_ref.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+  }
+
+  {
+    ChromatogramExtractorAlgorithm::ExtractionCoordinates coord;
+    coord.mz = 618.31; coord.rt_start = 0; coord.rt_end = -1; coord.id = "tr1";
+    coordinates.push_back(coord);
+    coord.mz = 628.45; coord.rt_start = 0; coord.rt_end = -1; coord.id = "tr2";
+    coordinates.push_back(coord);
+    coord.mz = 654.38; coord.rt_start = 0; coord.rt_end = -1; coord.id = "tr3";
+    coordinates.push_back(coord);
+  }
+  extractor.extractChromatograms(columnar, out_exp, coordinates, extract_window, false, -1, "tophat");
+  extractor.extractChromatograms(expptr, out_ref, coordinates, extract_window, false, -1, "tophat");
+
+  TEST_EQUAL(out_exp[0]->getTimeArray()->data.size(), 59);
+  TEST_EQUAL(out_exp[0]->getIntensityArray()->data.size(), 59);
+
+  double max_value = -1; double foundat = -1;
+  find_max_helper(out_exp[1], max_value, foundat);
+  TEST_REAL_SIMILAR(max_value, 169.792);
+  TEST_REAL_SIMILAR(foundat, 3120.26);
+
+  // same result as extraction from the spectrum access
+  for (Size k = 0; k < out_exp.size(); ++k)
+  {
+    TEST_EQUAL(out_exp[k]->getIntensityArray()->data.size(), out_ref[k]->getIntensityArray()->data.size())
+    for (Size i = 0; i < out_exp[k]->getIntensityArray()->data.size(); ++i)
+    {
+      TEST_REAL_SIMILAR(out_exp[k]->getTimeArray()->data[i], out_ref[k]->getTimeArray()->data[i])
+      TEST_REAL_SIMILAR(out_exp[k]->getIntensityArray()->data[i], out_ref[k]->getIntensityArray()->data[i])
+    }
+  }
+
+  // there is no ion mobility, so this should not work
+  TEST_EXCEPTION(Exception::IllegalArgument, extractor.extractChromatograms(columnar, out_exp, coordinates, extract_window, false, 1, "tophat"))
+
+  // ion mobility extraction on the IM column
+  std::vector<ColumnarSpectrum> im_input(1);
+  im_input[0].setRT(10.0);
+  im_input[0].push_back(500.0, 10.0f, 1.0f);
+  im_input[0].push_back(500.001, 20.0f, 2.0f);
+  im_input[0].push_back(500.002, 40.0f, 1.05f);
+  std::vector< ChromatogramExtractorAlgorithm::ExtractionCoordinates > im_coordinates(1);
+  im_coordinates[0].mz = 500.001; im_coordinates[0].ion_mobility = 1.0; im_coordinates[0].rt_start = 0; im_coordinates[0].rt_end = -1;
+  std::vector< OpenSwath::ChromatogramPtr > im_out(1, OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+  extractor.extractChromatograms(im_input, im_out, im_coordinates, 0.05, false, 0.2, "tophat");
+  TEST_EQUAL(im_out[0]->getIntensityArray()->data.size(), 1)
+  TEST_REAL_SIMILAR(im_out[0]->getIntensityArray()->data[0], 50.0)
+  TEST_REAL_SIMILAR(im_out[0]->getTimeArray()->data[0], 10.0)
+}
+END_SECTION
+
 START_SECTION([EXTRA] void extractChromatograms(const OpenSwath::SpectrumAccessPtr input, std::vector< OpenSwath::ChromatogramPtr > &output, std::vector< ExtractionCoordinates >& extraction_coordinates, double mz_extraction_window, bool ppm, String filter))
 {
   typedef OpenMS::DataArrays::FloatDataArray FloatDataArray;
@@ -318,6 +392,152 @@ static const double im_arr[] = {
   300.2
 };
 
+START_SECTION(void extractChromatograms(const OpenSwath::SpectrumAccessPtr& input, std::vector< std::vector< OpenSwath::ChromatogramPtr > >& outputs, const std::vector< std::vector<ExtractionCoordinates> >& extraction_coordinates, double mz_extraction_window, bool ppm, double im_extraction_window, const String& filter, Size block_size = 64))
+{
+  boost::shared_ptr<PeakMap > exp(new PeakMap);
+  for (int i = 0; i < 10; i++)
+  {
+    MSSpectrum s;
+    s.setRT(10.0 * i);
+    for (int k = 0; k < 20; k++)
+    {
+      s.push_back(Peak1D(500.0 + k * 0.01, 10 * i + k));
+    }
+    exp->addSpectrum(s);
+  }
+  OpenSwath::SpectrumAccessPtr expptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(exp);
+
+  // three batches: whole RT range, RT 20-45 and RT 200-300 (outside of the data)
+  std::vector< std::vector< ChromatogramExtractorAlgorithm::ExtractionCoordinates > > coordinates(3);
+  ChromatogramExtractorAlgorithm::ExtractionCoordinates coord;
+  coord.rt_start = 0; coord.rt_end = -1;
+  coord.mz = 500.02; coord.id = "a"; coordinates[0].push_back(coord);
+  coord.mz = 500.15; coord.id = "b"; coordinates[0].push_back(coord);
+  coord.rt_start = 20; coord.rt_end = 45;
+  coord.mz = 500.05; coord.id = "c"; coordinates[1].push_back(coord);
+  coord.rt_start = 200; coord.rt_end = 300;
+  coord.mz = 500.1; coord.id = "d"; coordinates[2].push_back(coord);
+
+  ChromatogramExtractorAlgorithm extractor;
+  std::vector< std::vector< OpenSwath::ChromatogramPtr > > outputs(3);
+  for (Size b = 0; b < coordinates.size(); ++b)
+  {
+    for (Size i = 0; i < coordinates[b].size(); ++i)
+    {
+      outputs[b].push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+    }
+  }
+  extractor.extractChromatograms(expptr, outputs, coordinates, 0.025, false, -1, "tophat", 3);
+
+  // same result as extracting each batch separately
+  for (Size b = 0; b < coordinates.size(); ++b)
+  {
+    std::vector< OpenSwath::ChromatogramPtr > expected;
+    for (Size i = 0; i < coordinates[b].size(); ++i)
+    {
+      expected.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+    }
+    extractor.extractChromatograms(expptr, expected, coordinates[b], 0.025, false, -1, "tophat");
+    for (Size i = 0; i < coordinates[b].size(); ++i)
+    {
+      TEST_EQUAL(outputs[b][i]->getTimeArray()->data == expected[i]->getTimeArray()->data, true)
+      TEST_EQUAL(outputs[b][i]->getIntensityArray()->data == expected[i]->getIntensityArray()->data, true)
+    }
+  }
+  TEST_EQUAL(outputs[0][0]->getIntensityArray()->data.size(), 10)
+  TEST_EQUAL(outputs[1][0]->getIntensityArray()->data.size(), 3)
+  TEST_REAL_SIMILAR(outputs[1][0]->getIntensityArray()->data[0], 20 + 4 + 20 + 5 + 20 + 6)
+  TEST_EQUAL(outputs[2][0]->getIntensityArray()->data.size(), 0)
+
+  outputs.pop_back();
+  TEST_EXCEPTION(Exception::IllegalArgument, extractor.extractChromatograms(expptr, outputs, coordinates, 0.025, false, -1, "tophat"))
+  outputs.push_back(std::vector< OpenSwath::ChromatogramPtr >(1, OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram)));
+  TEST_EXCEPTION(Exception::NotImplemented, extractor.extractChromatograms(expptr, outputs, coordinates, 0.025, false, -1, "bartlett"))
+  TEST_EXCEPTION(Exception::IllegalArgument, extractor.extractChromatograms(expptr, outputs, coordinates, 0.025, false, 0.1, "tophat"))
+}
+END_SECTION
+
+START_SECTION([EXTRA] void extractChromatograms(const std::vector<ColumnarSpectrum>& input, std::vector< OpenSwath::ChromatogramPtr >& output, const std::vector<ExtractionCoordinates>& extraction_coordinates, double mz_extraction_window, bool ppm, double im_extraction_window, const String& filter))
+{
+  // dense spectrum, all windows are compared to the sum over all peaks strictly inside the window
+  std::vector<ColumnarSpectrum> input(1);
+  input[0].setRT(5.0);
+  for (int k = 0; k < 2000; ++k)
+  {
+    input[0].push_back(400.0 + k * 0.0037 + (k % 7) * 0.0002, float(1 + (k * 37) % 101), float(0.6 + (k % 13) * 0.05));
+  }
+  const std::vector<double>& mz = input[0].getMZArray();
+
+  std::vector< ChromatogramExtractorAlgorithm::ExtractionCoordinates > coordinates;
+  ChromatogramExtractorAlgorithm::ExtractionCoordinates coord;
+  coord.rt_start = 0; coord.rt_end = -1;
+  // windows before the first peak, overlapping windows, windows at the last peak and after the spectrum
+  for (double target : {399.9, 400.001, 400.01, 401.5, 401.503, 403.0, 404.0, 407.39, 407.4, 407.41, 409.0})
+  {
+    coord.mz = target;
+    coord.ion_mobility = target < 404.0 ? 0.9 : -1;
+    coordinates.push_back(coord);
+  }
+
+  ChromatogramExtractorAlgorithm extractor;
+  for (bool ppm : {false, true})
+  {
+    const double window = ppm ? 40.0 : 0.03;
+    for (double im_window : {-1.0, 0.3})
+    {
+      std::vector< OpenSwath::ChromatogramPtr > out;
+      for (Size i = 0; i < coordinates.size(); ++i)
+      {
+        out.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+      }
+      extractor.extractChromatograms(input, out, coordinates, window, ppm, im_window, "tophat");
+      for (Size i = 0; i < coordinates.size(); ++i)
+      {
+        const double half = ppm ? coordinates[i].mz * window / 2.0 * 1.0e-6 : window / 2.0;
+        const bool use_im = im_window > 0 && coordinates[i].ion_mobility >= 0;
+        double expected = 0;
+        for (Size j = 0; j < mz.size(); ++j)
+        {
+          if (mz[j] <= coordinates[i].mz - half || mz[j] >= coordinates[i].mz + half) continue;
+          const double im = input[0].getIonMobilityArray()[j];
+          if (use_im && (im <= coordinates[i].ion_mobility - im_window / 2.0 || im >= coordinates[i].ion_mobility + im_window / 2.0)) continue;
+          expected += input[0].getIntensityArray()[j];
+        }
+        ABORT_IF(out[i]->getIntensityArray()->data.size() != 1)
+        TEST_REAL_SIMILAR(out[i]->getIntensityArray()->data[0], expected)
+      }
+    }
+  }
+
+  // same result when the same spectrum is extracted through the spectrum access
+  boost::shared_ptr<PeakMap > exp(new PeakMap);
+  MSSpectrum spectrum;
+  spectrum.setRT(5.0);
+  for (Size j = 0; j < mz.size(); ++j)
+  {
+    spectrum.push_back(Peak1D(mz[j], input[0].getIntensityArray()[j]));
+  }
+  exp->addSpectrum(spectrum);
+  OpenSwath::SpectrumAccessPtr expptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(exp);
+  std::vector< OpenSwath::ChromatogramPtr > out_exp, out_ref;
+  for (Size i = 0; i < coordinates.size(); ++i)
+  {
+    out_exp.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+    out_ref.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+  }
+  extractor.extractChromatograms(input, out_exp, coordinates, 0.05, false, -1, "tophat");
+  extractor.extractChromatograms(expptr, out_ref, coordinates, 0.05, false, -1, "tophat");
+  for (Size i = 0; i < coordinates.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(out_exp[i]->getIntensityArray()->data[0], out_ref[i]->getIntensityArray()->data[0])
+  }
+  TEST_EQUAL(out_exp[0]->getIntensityArray()->data[0], 0.0)
+  TEST_EQUAL(out_exp.back()->getIntensityArray()->data[0], 0.0)
+
+  TEST_EXCEPTION(Exception::NotImplemented, extractor.extractChromatograms(input, out_exp, coordinates, 0.05, false, -1, "bartlett"))
+}
+END_SECTION
+
 START_SECTION(void extract_value_tophat(const std::vector< double >::const_iterator &mz_start, std::vector< double >::const_iterator &mz_it, const std::vector< double >::const_iterator &mz_end, std::vector< double >::const_iterator &int_it, const double &mz, double &integrated_intensity, const double &mz_extraction_window, bool ppm))
 { 
   std::vector<double> mz (mz_arr, mz_arr + sizeof(mz_arr) / sizeof(mz_arr[0]) );
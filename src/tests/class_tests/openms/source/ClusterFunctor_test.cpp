@@ -53,6 +53,12 @@ START_SECTION((virtual void operator()(DistanceMatrix< float > &original_distanc
 }
 END_SECTION
 
+START_SECTION((virtual void operator()(Size n, std::vector<PairDistance>& distances, std::vector<BinaryTreeNode>& cluster_tree, const float threshold = 1) const))
+{
+  NOT_TESTABLE // tested in CompleteLinkage_test
+}
+END_SECTION
+
 START_SECTION(([ClusterFunctor::InsufficientInput] InsufficientInput(const char *file, int line, const char *function, const char *message="not enough data points to cluster anything")))
 {
   NOT_TESTABLE
@@ -256,6 +256,48 @@ START_SECTION((void cluster(std::vector<PeakSpectrum>& data, const BinnedSpectru
 }
 END_SECTION
 
+START_SECTION((template <typename Data, typename SimilarityComparator, typename CandidatePredicate> void clusterSparse(const std::vector<Data>& data, const SimilarityComparator& comparator, const CandidatePredicate& is_candidate, const ClusterFunctor& clusterer, std::vector<BinaryTreeNode>& cluster_tree) const))
+{
+ vector<Size> d(6,0);
+ for (Size i = 0; i<d.size(); ++i)
+ {
+  d[i]=i;
+ }
+ ClusterHierarchical ch;
+ LowlevelComparator lc;
+ SingleLinkage sl;
+ vector< BinaryTreeNode > result;
+ vector< BinaryTreeNode > tree;
+ tree.push_back(BinaryTreeNode(1,2,0.3f));
+ tree.push_back(BinaryTreeNode(3,4,0.4f));
+ tree.push_back(BinaryTreeNode(0,1,0.5f));
+ tree.push_back(BinaryTreeNode(0,3,0.6f));
+ tree.push_back(BinaryTreeNode(0,5,0.7f));
+
+ ch.clusterSparse(d, lc, [](Size, Size) { return true; }, sl, result);
+ TEST_EQUAL(tree.size(), result.size());
+ for (Size i = 0; i < tree.size(); ++i)
+ {
+   TOLERANCE_ABSOLUTE(0.0001);
+   TEST_EQUAL(tree[i].left_child, result[i].left_child);
+   TEST_EQUAL(tree[i].right_child, result[i].right_child);
+   TEST_REAL_SIMILAR(tree[i].distance, result[i].distance);
+ }
+
+ // element 5 is no candidate for anything, so it stays separate
+ tree.back() = BinaryTreeNode(0,5,-1.0f);
+ ch.clusterSparse(d, lc, [](Size a, Size b) { return a != 5 && b != 5; }, sl, result);
+ TEST_EQUAL(tree.size(), result.size());
+ for (Size i = 0; i < tree.size(); ++i)
+ {
+   TOLERANCE_ABSOLUTE(0.0001);
+   TEST_EQUAL(tree[i].left_child, result[i].left_child);
+   TEST_EQUAL(tree[i].right_child, result[i].right_child);
+   TEST_REAL_SIMILAR(tree[i].distance, result[i].distance);
+ }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
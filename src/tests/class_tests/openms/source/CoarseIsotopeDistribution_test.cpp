@@ -265,6 +265,66 @@ START_SECTION(IsotopeDitribution CoarseIsotopePatternGenerator::estimateFromPept
 }
 END_SECTION
 
+START_SECTION(static void clearCache())
+{
+    // memoized and freshly convolved distributions are identical
+    CoarseIsotopePatternGenerator gen(5);
+    EmpiricalFormula ef("C222H360N60O70S3");
+    IsotopeDistribution first = gen.run(ef);
+    IsotopeDistribution memoized = gen.run(ef);
+    CoarseIsotopePatternGenerator::clearCache();
+    IsotopeDistribution fresh = gen.run(ef);
+    TEST_EQUAL(first == memoized, true)
+    TEST_EQUAL(first == fresh, true)
+
+    // other settings are not served from the memo
+    gen.setRoundMasses(true);
+    TEST_REAL_SIMILAR(gen.run(ef).begin()->getMZ(), round(first.begin()->getMZ()))
+    gen.setMaxIsotope(2);
+    TEST_EQUAL(gen.run(ef).size(), 2)
+}
+END_SECTION
+
+START_SECTION(void setAveragineGrid(double bin_width, double max_weight))
+{
+    CoarseIsotopePatternGenerator exact(4);
+    CoarseIsotopePatternGenerator grid(4);
+    TEST_EQUAL(grid.getAveragineGridBinWidth(), 0.0)
+    grid.setAveragineGrid(10.0, 5000.0);
+    TEST_EQUAL(grid.getAveragineGridBinWidth(), 10.0)
+
+    // exact at the grid points
+    IsotopeDistribution e = exact.estimateFromPeptideWeight(1500.0);
+    IsotopeDistribution g = grid.estimateFromPeptideWeight(1500.0);
+    TEST_EQUAL(e.size(), g.size())
+    for (Size i = 0; i < e.size(); ++i)
+    {
+      TEST_REAL_SIMILAR(g[i].getMZ(), e[i].getMZ())
+      TEST_REAL_SIMILAR(g[i].getIntensity(), e[i].getIntensity())
+    }
+
+    // close in between
+    e = exact.estimateFromPeptideWeight(2345.6);
+    g = grid.estimateFromPeptideWeight(2345.6);
+    TEST_EQUAL(e.size(), g.size())
+    for (Size i = 0; i < e.size(); ++i)
+    {
+      TEST_EQUAL(fabs(g[i].getMZ() - e[i].getMZ()) < 5.0, true)
+      TEST_EQUAL(fabs(g[i].getIntensity() - e[i].getIntensity()) < 0.01, true)
+    }
+
+    // outside of the grid the estimate is exact
+    TEST_EQUAL(grid.estimateFromPeptideWeight(6000.0) == exact.estimateFromPeptideWeight(6000.0), true)
+
+    // changing the settings discards the grid
+    grid.setMaxIsotope(3);
+    TEST_EQUAL(grid.getAveragineGridBinWidth(), 0.0)
+
+    TEST_EXCEPTION(Exception::InvalidValue, grid.setAveragineGrid(0.0, 5000.0))
+    TEST_EXCEPTION(Exception::InvalidValue, grid.setAveragineGrid(10.0, 5.0))
+}
+END_SECTION
+
 START_SECTION(IsotopeDitribution CoarseIsotopePatternGenerator::approximateFromPeptideWeight(double mass, int num_peaks))
 {
   std::vector<float> masses_to_test = {20, 300, 1000, 2500};
@@ -323,6 +383,19 @@ START_SECTION(IsotopeDitribution CoarseIsotopePatternGenerator::approximateInten
 }
 END_SECTION
 
+START_SECTION(static void approximateIntensities(double mass, UInt num_peaks, std::vector<double>& result))
+{
+  std::vector<double> result(3, -1.0); // previous content is replaced
+  for (double mass : {300.0, 2500.0})
+  {
+    CoarseIsotopePatternGenerator::approximateIntensities(mass, 8, result);
+    std::vector<double> expected = CoarseIsotopePatternGenerator::approximateIntensities(mass, 8);
+    TEST_EQUAL(result.size(), 8)
+    TEST_EQUAL(result == expected, true)
+  }
+}
+END_SECTION
+
 START_SECTION(IsotopeDistribution CoarseIsotopePatternGenerator::estimateForFragmentFromPeptideWeightAndS(double average_weight_precursor, UInt S_precursor, double average_weight_fragment, UInt S_fragment, const std::vector<UInt>& precursor_isotopes))
 {
     IsotopeDistribution iso;
@@ -0,0 +1,175 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/KERNEL/ColumnarConsensusMap.h>
+#include <OpenMS/KERNEL/ConsensusMap.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(ColumnarConsensusMap, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+// two consensus features over three maps; map 1 is missing in the second one
+ConsensusMap map;
+map.getColumnHeaders()[0].size = 2;
+map.getColumnHeaders()[1].size = 1;
+map.getColumnHeaders()[2].size = 2;
+{
+  ConsensusFeature cf;
+  Peak2D p;
+  p.setRT(10.0); p.setMZ(500.0); p.setIntensity(100.0f);
+  cf.insert(2, p, 1);
+  p.setRT(11.0); p.setMZ(500.1); p.setIntensity(200.0f);
+  cf.insert(0, p, 1);
+  p.setRT(12.0); p.setMZ(500.2); p.setIntensity(300.0f);
+  cf.insert(1, p, 1);
+  map.push_back(cf);
+  ConsensusFeature cf2;
+  p.setRT(20.0); p.setMZ(600.0); p.setIntensity(400.0f);
+  cf2.insert(0, p, 2);
+  p.setRT(21.0); p.setMZ(600.1); p.setIntensity(500.0f);
+  cf2.insert(2, p, 2);
+  map.push_back(cf2);
+}
+
+ColumnarConsensusMap* ptr = nullptr;
+ColumnarConsensusMap* nullPointer = nullptr;
+START_SECTION(ColumnarConsensusMap())
+{
+  ptr = new ColumnarConsensusMap();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->featureCount(), 0)
+  TEST_EQUAL(ptr->entryCount(), 0)
+  TEST_EQUAL(ptr->mapCount(), 0)
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(explicit ColumnarConsensusMap(const ConsensusMap& map))
+{
+  ColumnarConsensusMap columns(map);
+  TEST_EQUAL(columns.featureCount(), 2)
+  TEST_EQUAL(columns.entryCount(), 5)
+  TEST_EQUAL(columns.mapCount(), 3)
+  // entries in the order of the handle sets (by map index)
+  TEST_EQUAL(columns.getFeatureOffsets() == vector<Size>({0, 3, 5}), true)
+  TEST_EQUAL(columns.getMapIndices() == vector<UInt64>({0, 1, 2, 0, 2}), true)
+  TEST_EQUAL(columns.getIntensities() == vector<float>({200, 300, 100, 400, 500}), true)
+  TEST_REAL_SIMILAR(columns.getRT()[0], 11.0)
+  TEST_REAL_SIMILAR(columns.getMZ()[4], 600.1)
+}
+END_SECTION
+
+START_SECTION(Size featureCount() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(Size entryCount() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(Size mapCount() const)
+{
+  // handles with a map index beyond the column headers
+  ConsensusMap extra = map;
+  ConsensusFeature cf;
+  cf.insert(5, Peak2D(), 3);
+  extra.push_back(cf);
+  TEST_EQUAL(ColumnarConsensusMap(extra).mapCount(), 6)
+}
+END_SECTION
+
+START_SECTION(const std::vector<Size>& getFeatureOffsets() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(const std::vector<UInt64>& getMapIndices() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(const std::vector<double>& getRT() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(const std::vector<double>& getMZ() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(const std::vector<float>& getIntensities() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(const std::vector<Size>& getMapOffsets() const)
+{
+  ColumnarConsensusMap columns(map);
+  TEST_EQUAL(columns.getMapOffsets() == vector<Size>({0, 2, 3, 5}), true)
+  TEST_EQUAL(columns.getMapEntries() == vector<Size>({0, 3, 1, 2, 4}), true)
+}
+END_SECTION
+
+START_SECTION(const std::vector<Size>& getMapEntries() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(std::vector<float> getMapIntensities(UInt64 map_index) const)
+{
+  ColumnarConsensusMap columns(map);
+  TEST_EQUAL(columns.getMapIntensities(0) == vector<float>({200, 400}), true)
+  TEST_EQUAL(columns.getMapIntensities(1) == vector<float>({300}), true)
+  TEST_EQUAL(columns.getMapIntensities(2) == vector<float>({100, 500}), true)
+  TEST_EQUAL(columns.getMapIntensities(3).empty(), true)
+}
+END_SECTION
+
+START_SECTION(void applyIntensities(ConsensusMap& map) const)
+{
+  ConsensusMap copy = map;
+  ColumnarConsensusMap columns(copy);
+  for (float& i : columns.getIntensities())
+  {
+    i *= 2;
+  }
+  columns.applyIntensities(copy);
+  TEST_REAL_SIMILAR(copy[0].begin()->getIntensity(), 400.0)
+  TEST_REAL_SIMILAR(copy[1].rbegin()->getIntensity(), 1000.0)
+
+  // different structure
+  copy[1].clear();
+  TEST_EXCEPTION(Exception::InvalidSize, columns.applyIntensities(copy))
+  copy.pop_back();
+  TEST_EXCEPTION(Exception::InvalidSize, columns.applyIntensities(copy))
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
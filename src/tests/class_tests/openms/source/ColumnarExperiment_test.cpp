@@ -0,0 +1,262 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/KERNEL/ColumnarExperiment.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(ColumnarExperiment, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+ColumnarExperiment* ptr = nullptr;
+ColumnarExperiment* nullPointer = nullptr;
+
+START_SECTION((ColumnarExperiment()))
+{
+  ptr = new ColumnarExperiment();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->getNrSpectra(), 0)
+  TEST_EQUAL(ptr->getNrChromatograms(), 0)
+  TEST_EQUAL(ptr->getSpectrumOffsets().size(), 1)
+  TEST_EQUAL(ptr->getChromatogramOffsets().size(), 1)
+}
+END_SECTION
+
+START_SECTION((~ColumnarExperiment()))
+{
+  delete ptr;
+}
+END_SECTION
+
+// three spectra (the second one empty) and one chromatogram
+MSExperiment exp;
+{
+  MSSpectrum spec;
+  spec.setRT(1.0);
+  spec.setMSLevel(1);
+  spec.setNativeID("scan=1");
+  spec.push_back(Peak1D(100.0, 10.0f));
+  spec.push_back(Peak1D(200.0, 20.0f));
+  exp.addSpectrum(spec);
+
+  spec.clear(true);
+  spec.setRT(2.0);
+  spec.setMSLevel(2);
+  spec.setNativeID("scan=2");
+  exp.addSpectrum(spec);
+
+  spec.clear(true);
+  spec.setRT(3.0);
+  spec.setMSLevel(1);
+  spec.setNativeID("scan=3");
+  spec.push_back(Peak1D(150.0, 15.0f));
+  exp.addSpectrum(spec);
+
+  MSChromatogram chrom;
+  chrom.setNativeID("TIC");
+  chrom.push_back(ChromatogramPeak(1.0, 30.0));
+  chrom.push_back(ChromatogramPeak(2.0, 0.0));
+  chrom.push_back(ChromatogramPeak(3.0, 15.0));
+  exp.addChromatogram(chrom);
+}
+
+START_SECTION((explicit ColumnarExperiment(const MSExperiment& exp)))
+{
+  ColumnarExperiment col(exp);
+  TEST_EQUAL(col.getNrSpectra(), 3)
+  TEST_EQUAL(col.getNrSpectraPeaks(), 3)
+  TEST_EQUAL(col.getNrChromatograms(), 1)
+  TEST_EQUAL(col.getNrChromatogramPeaks(), 3)
+}
+END_SECTION
+
+START_SECTION((void assign(const MSExperiment& exp)))
+{
+  ColumnarExperiment col;
+  col.assign(exp);
+  TEST_EQUAL(col.getMZArray().size(), 3)
+  TEST_REAL_SIMILAR(col.getMZArray()[0], 100.0)
+  TEST_REAL_SIMILAR(col.getMZArray()[1], 200.0)
+  TEST_REAL_SIMILAR(col.getMZArray()[2], 150.0)
+  TEST_REAL_SIMILAR(col.getIntensityArray()[2], 15.0)
+  ABORT_IF(col.getSpectrumOffsets().size() != 4)
+  TEST_EQUAL(col.getSpectrumOffsets()[0], 0)
+  TEST_EQUAL(col.getSpectrumOffsets()[1], 2)
+  TEST_EQUAL(col.getSpectrumOffsets()[2], 2)
+  TEST_EQUAL(col.getSpectrumOffsets()[3], 3)
+  TEST_REAL_SIMILAR(col.getRTArray()[1], 2.0)
+  TEST_EQUAL(col.getMSLevelArray()[1], 2)
+  ABORT_IF(col.getChromatogramOffsets().size() != 2)
+  TEST_EQUAL(col.getChromatogramOffsets()[1], 3)
+  TEST_REAL_SIMILAR(col.getChromatogramRTArray()[2], 3.0)
+  TEST_REAL_SIMILAR(col.getChromatogramIntensityArray()[0], 30.0)
+
+  // assigning an empty map removes everything
+  col.assign(MSExperiment());
+  TEST_EQUAL(col == ColumnarExperiment(), true)
+}
+END_SECTION
+
+START_SECTION((void toMSExperiment(MSExperiment& exp) const))
+{
+  ColumnarExperiment col(exp);
+  col.getIntensityArray()[0] = 50.0f;
+  col.getChromatogramIntensityArray()[1] = 5.0f;
+
+  // meta data of existing spectra is kept
+  MSExperiment out = exp;
+  col.toMSExperiment(out);
+  ABORT_IF(out.size() != 3)
+  TEST_EQUAL(out[0].size(), 2)
+  TEST_EQUAL(out[1].size(), 0)
+  TEST_EQUAL(out[2].size(), 1)
+  TEST_REAL_SIMILAR(out[0][0].getIntensity(), 50.0)
+  TEST_REAL_SIMILAR(out[0][1].getMZ(), 200.0)
+  TEST_EQUAL(out[1].getMSLevel(), 2)
+  TEST_EQUAL(out[2].getNativeID(), "scan=3")
+  ABORT_IF(out.getNrChromatograms() != 1)
+  TEST_EQUAL(out.getChromatograms()[0].getNativeID(), "TIC")
+  TEST_REAL_SIMILAR(out.getChromatograms()[0][1].getIntensity(), 5.0)
+
+  // into an empty map
+  MSExperiment empty;
+  col.toMSExperiment(empty);
+  TEST_EQUAL(empty.size(), 3)
+  TEST_REAL_SIMILAR(empty[2].getRT(), 3.0)
+  TEST_EQUAL(ColumnarExperiment(empty) == col, true)
+
+  // surplus spectra are removed
+  ColumnarExperiment().toMSExperiment(out);
+  TEST_EQUAL(out.size(), 0)
+  TEST_EQUAL(out.getNrChromatograms(), 0)
+}
+END_SECTION
+
+START_SECTION((void setSpectra(std::vector<double> mz, std::vector<float> intensity, std::vector<UInt64> offsets, std::vector<double> rt, std::vector<UInt> ms_level)))
+{
+  ColumnarExperiment col;
+  col.setSpectra({100.0, 200.0, 300.0}, {1.0f, 2.0f, 3.0f}, {0, 1, 3}, {10.0, 20.0}, {1, 2});
+  TEST_EQUAL(col.getNrSpectra(), 2)
+  MSExperiment out;
+  col.toMSExperiment(out);
+  ABORT_IF(out.size() != 2)
+  TEST_EQUAL(out[1].size(), 2)
+  TEST_REAL_SIMILAR(out[1][1].getMZ(), 300.0)
+  TEST_EQUAL(out[1].getMSLevel(), 2)
+
+  TEST_EXCEPTION(Exception::InvalidSize, col.setSpectra({100.0}, {}, {0, 1}, {10.0}, {1}))
+  TEST_EXCEPTION(Exception::InvalidSize, col.setSpectra({100.0}, {1.0f}, {0, 1}, {10.0, 20.0}, {1, 1}))
+  TEST_EXCEPTION(Exception::InvalidSize, col.setSpectra({100.0}, {1.0f}, {0, 1}, {10.0}, {}))
+  TEST_EXCEPTION(Exception::InvalidValue, col.setSpectra({100.0}, {1.0f}, {1, 1}, {10.0}, {1}))
+  TEST_EXCEPTION(Exception::InvalidValue, col.setSpectra({100.0}, {1.0f}, {0, 2}, {10.0}, {1}))
+  TEST_EXCEPTION(Exception::InvalidValue, col.setSpectra({100.0}, {1.0f}, {0, 1, 0, 1}, {1.0, 2.0, 3.0}, {1, 1, 1}))
+  // unchanged after an exception
+  TEST_EQUAL(col.getNrSpectra(), 2)
+}
+END_SECTION
+
+START_SECTION((void setChromatograms(std::vector<double> rt, std::vector<float> intensity, std::vector<UInt64> offsets)))
+{
+  ColumnarExperiment col;
+  col.setChromatograms({1.0, 2.0}, {5.0f, 6.0f}, {0, 2});
+  TEST_EQUAL(col.getNrChromatograms(), 1)
+  TEST_EQUAL(col.getNrChromatogramPeaks(), 2)
+  TEST_EXCEPTION(Exception::InvalidSize, col.setChromatograms({1.0, 2.0}, {5.0f}, {0, 2}))
+  TEST_EXCEPTION(Exception::InvalidValue, col.setChromatograms({1.0, 2.0}, {5.0f, 6.0f}, {0, 1}))
+  TEST_EXCEPTION(Exception::InvalidValue, col.setChromatograms({1.0, 2.0}, {5.0f, 6.0f}, {}))
+}
+END_SECTION
+
+START_SECTION((void clear()))
+{
+  ColumnarExperiment col(exp);
+  col.clear();
+  TEST_EQUAL(col.getNrSpectra(), 0)
+  TEST_EQUAL(col.getNrChromatograms(), 0)
+  TEST_EQUAL(col.getMZArray().empty(), true)
+}
+END_SECTION
+
+START_SECTION((bool operator==(const ColumnarExperiment& rhs) const))
+{
+  ColumnarExperiment a(exp), b(exp);
+  TEST_EQUAL(a == b, true)
+  b.getRTArray()[0] = 5.0;
+  TEST_EQUAL(a == b, false)
+}
+END_SECTION
+
+START_SECTION((bool operator!=(const ColumnarExperiment& rhs) const))
+{
+  ColumnarExperiment a(exp), b(exp);
+  TEST_EQUAL(a != b, false)
+  b.getMSLevelArray()[0] = 3;
+  TEST_EQUAL(a != b, true)
+}
+END_SECTION
+
+START_SECTION((Size getNrSpectra() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((Size getNrSpectraPeaks() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((const std::vector<double>& getMZArray() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((const std::vector<float>& getIntensityArray() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((const std::vector<UInt64>& getSpectrumOffsets() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((const std::vector<double>& getRTArray() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((const std::vector<UInt>& getMSLevelArray() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((Size getNrChromatograms() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((Size getNrChromatogramPeaks() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((const std::vector<double>& getChromatogramRTArray() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((const std::vector<float>& getChromatogramIntensityArray() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((const std::vector<UInt64>& getChromatogramOffsets() const))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
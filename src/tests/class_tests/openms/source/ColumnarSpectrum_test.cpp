@@ -0,0 +1,249 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/KERNEL/ColumnarSpectrum.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+#include <OpenMS/IONMOBILITY/IMDataConverter.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(ColumnarSpectrum, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+ColumnarSpectrum* ptr = nullptr;
+ColumnarSpectrum* nullPointer = nullptr;
+
+START_SECTION((ColumnarSpectrum()))
+{
+  ptr = new ColumnarSpectrum();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->size(), 0)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_EQUAL(ptr->hasIonMobility(), false)
+  TEST_EQUAL(ptr->getMSLevel(), 1)
+}
+END_SECTION
+
+START_SECTION((~ColumnarSpectrum()))
+{
+  delete ptr;
+}
+END_SECTION
+
+MSSpectrum spec;
+spec.setRT(12.5);
+spec.setMSLevel(2);
+spec.setDriftTime(3.0);
+spec.setDriftTimeUnit(DriftTimeUnit::MILLISECOND);
+spec.push_back(Peak1D(100.0, 10.0f));
+spec.push_back(Peak1D(200.0, 20.0f));
+spec.push_back(Peak1D(300.0, 30.0f));
+
+MSSpectrum im_spec = spec;
+im_spec.getFloatDataArrays().resize(1);
+IMDataConverter::setIMUnit(im_spec.getFloatDataArrays()[0], DriftTimeUnit::VSSC);
+im_spec.getFloatDataArrays()[0].push_back(0.8f);
+im_spec.getFloatDataArrays()[0].push_back(0.9f);
+im_spec.getFloatDataArrays()[0].push_back(1.0f);
+
+START_SECTION((explicit ColumnarSpectrum(const MSSpectrum& spectrum)))
+{
+  ColumnarSpectrum c(spec);
+  TEST_EQUAL(c.size(), 3)
+  TEST_REAL_SIMILAR(c.getMZArray()[1], 200.0)
+  TEST_REAL_SIMILAR(c.getIntensityArray()[2], 30.0)
+  TEST_REAL_SIMILAR(c.getRT(), 12.5)
+  TEST_EQUAL(c.getMSLevel(), 2)
+  TEST_REAL_SIMILAR(c.getDriftTime(), 3.0)
+  TEST_EQUAL(c.getDriftTimeUnit() == DriftTimeUnit::MILLISECOND, true)
+  TEST_EQUAL(c.hasIonMobility(), false)
+
+  ColumnarSpectrum c_im(im_spec);
+  TEST_EQUAL(c_im.hasIonMobility(), true)
+  TEST_EQUAL(c_im.getIonMobilityArray().size(), 3)
+  TEST_REAL_SIMILAR(c_im.getIonMobilityArray()[1], 0.9)
+  TEST_EQUAL(c_im.getIonMobilityArrayName(), im_spec.getFloatDataArrays()[0].getName())
+}
+END_SECTION
+
+START_SECTION((void assign(const MSSpectrum& spectrum)))
+{
+  ColumnarSpectrum c(im_spec);
+  c.assign(spec);
+  TEST_EQUAL(c.size(), 3)
+  TEST_EQUAL(c.hasIonMobility(), false)
+  TEST_EQUAL(c.getIonMobilityArrayName(), "")
+
+  // IM array of wrong size
+  MSSpectrum broken = im_spec;
+  broken.getFloatDataArrays()[0].pop_back();
+  TEST_EXCEPTION(Exception::InvalidSize, c.assign(broken))
+}
+END_SECTION
+
+START_SECTION((void toMSSpectrum(MSSpectrum& spectrum) const))
+{
+  ColumnarSpectrum c(im_spec);
+  MSSpectrum out;
+  out.setNativeID("spectrum=1");
+  out.getFloatDataArrays().resize(2);
+  c.toMSSpectrum(out);
+  TEST_EQUAL(out.getNativeID(), "spectrum=1") // other meta data is kept
+  TEST_EQUAL(out.size(), 3)
+  TEST_EQUAL(out.getFloatDataArrays().size(), 1)
+  TEST_EQUAL(out.containsIMData(), true)
+  TEST_EQUAL(out.getIMData().second == DriftTimeUnit::VSSC, true)
+  TEST_EQUAL(out == im_spec, false) // native id differs
+  out.setNativeID("");
+  TEST_EQUAL(out == im_spec, true)
+
+  // unnamed column is named according to the drift time unit
+  ColumnarSpectrum c2;
+  c2.setDriftTimeUnit(DriftTimeUnit::MILLISECOND);
+  c2.push_back(100.0, 1.0f, 2.0f);
+  c2.toMSSpectrum(out);
+  TEST_EQUAL(out.containsIMData(), true)
+  TEST_EQUAL(out.getIMData().second == DriftTimeUnit::MILLISECOND, true)
+  c2.setDriftTimeUnit(DriftTimeUnit::NONE);
+  TEST_EXCEPTION(Exception::InvalidValue, c2.toMSSpectrum(out))
+}
+END_SECTION
+
+START_SECTION((MSSpectrum toMSSpectrum() const))
+{
+  ColumnarSpectrum c(spec);
+  TEST_EQUAL(c.toMSSpectrum() == spec, true)
+  TEST_EQUAL(ColumnarSpectrum(c.toMSSpectrum()) == c, true)
+}
+END_SECTION
+
+START_SECTION((bool operator==(const ColumnarSpectrum& rhs) const))
+{
+  ColumnarSpectrum c1(spec), c2(spec);
+  TEST_EQUAL(c1 == c2, true)
+  c2.getIntensityArray()[0] = 5.0f;
+  TEST_EQUAL(c1 == c2, false)
+  c2 = c1;
+  c2.setRT(1.0);
+  TEST_EQUAL(c1 == c2, false)
+}
+END_SECTION
+
+START_SECTION((bool operator!=(const ColumnarSpectrum& rhs) const))
+{
+  ColumnarSpectrum c1(spec), c2(im_spec);
+  TEST_EQUAL(c1 != c2, true)
+  c2.assign(spec);
+  TEST_EQUAL(c1 != c2, false)
+}
+END_SECTION
+
+START_SECTION((void push_back(double mz, float intensity, float ion_mobility)))
+{
+  ColumnarSpectrum c;
+  c.reserve(2);
+  c.push_back(100.0, 1.0f, 0.5f);
+  c.push_back(101.0, 2.0f, 0.6f);
+  TEST_EQUAL(c.size(), 2)
+  TEST_EQUAL(c.hasIonMobility(), true)
+  TEST_REAL_SIMILAR(c.getIonMobilityArray()[1], 0.6)
+  c.clear();
+  TEST_EQUAL(c.empty(), true)
+  TEST_EQUAL(c.hasIonMobility(), false)
+}
+END_SECTION
+
+START_SECTION((void erase(Size first, Size last)))
+{
+  ColumnarSpectrum c(im_spec);
+  c.erase(0, 2);
+  TEST_EQUAL(c.size(), 1)
+  TEST_REAL_SIMILAR(c.getMZArray()[0], 300.0)
+  TEST_REAL_SIMILAR(c.getIntensityArray()[0], 30.0)
+  TEST_REAL_SIMILAR(c.getIonMobilityArray()[0], 1.0)
+}
+END_SECTION
+
+START_SECTION((void sortByPosition()))
+{
+  ColumnarSpectrum c;
+  c.push_back(300.0, 3.0f, 0.3f);
+  c.push_back(100.0, 1.0f, 0.1f);
+  c.push_back(200.0, 2.0f, 0.2f);
+  TEST_EQUAL(c.isSorted(), false)
+  c.sortByPosition();
+  TEST_EQUAL(c.isSorted(), true)
+  TEST_REAL_SIMILAR(c.getMZArray()[0], 100.0)
+  TEST_REAL_SIMILAR(c.getIntensityArray()[0], 1.0)
+  TEST_REAL_SIMILAR(c.getIonMobilityArray()[0], 0.1)
+  TEST_REAL_SIMILAR(c.getMZArray()[2], 300.0)
+  TEST_REAL_SIMILAR(c.getIntensityArray()[2], 3.0)
+  TEST_REAL_SIMILAR(c.getIonMobilityArray()[2], 0.3)
+}
+END_SECTION
+
+START_SECTION((Size MZBegin(double mz) const))
+{
+  ColumnarSpectrum c(spec);
+  TEST_EQUAL(c.MZBegin(50.0), 0)
+  TEST_EQUAL(c.MZBegin(200.0), 1)
+  TEST_EQUAL(c.MZBegin(250.0), 2)
+  TEST_EQUAL(c.MZBegin(350.0), 3)
+}
+END_SECTION
+
+START_SECTION((Size MZEnd(double mz) const))
+{
+  ColumnarSpectrum c(spec);
+  TEST_EQUAL(c.MZEnd(50.0), 0)
+  TEST_EQUAL(c.MZEnd(200.0), 2)
+  TEST_EQUAL(c.MZEnd(350.0), 3)
+}
+END_SECTION
+
+START_SECTION((Size findNearest(double mz) const))
+{
+  ColumnarSpectrum c(spec);
+  TEST_EQUAL(c.findNearest(10.0), 0)
+  TEST_EQUAL(c.findNearest(160.0), 1)
+  TEST_EQUAL(c.findNearest(240.0), 1)
+  TEST_EQUAL(c.findNearest(260.0), 2)
+  TEST_EQUAL(c.findNearest(1000.0), 2)
+  TEST_EXCEPTION(Exception::Precondition, ColumnarSpectrum().findNearest(100.0))
+}
+END_SECTION
+
+START_SECTION((Int findNearest(double mz, double tolerance) const))
+{
+  ColumnarSpectrum c(spec);
+  TEST_EQUAL(c.findNearest(201.0, 2.0), 1)
+  TEST_EQUAL(c.findNearest(250.0, 2.0), -1)
+  TEST_EQUAL(ColumnarSpectrum().findNearest(100.0, 1.0), -1)
+}
+END_SECTION
+
+START_SECTION((double sumIntensity(double mz_start, double mz_end) const))
+{
+  ColumnarSpectrum c(spec);
+  TEST_REAL_SIMILAR(c.sumIntensity(0.0, 1000.0), 60.0)
+  TEST_REAL_SIMILAR(c.sumIntensity(150.0, 300.0), 50.0)
+  TEST_REAL_SIMILAR(c.sumIntensity(210.0, 290.0), 0.0)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -119,6 +119,39 @@ START_SECTION((void operator()(DistanceMatrix< float > &original_distance, std::
 }
 END_SECTION
 
+START_SECTION((void operator()(Size n, std::vector<PairDistance>& distances, std::vector<BinaryTreeNode>& cluster_tree, const float threshold = 1) const))
+{
+	// only the distances below the threshold (same data as above)
+	vector<ClusterFunctor::PairDistance> distances;
+	distances.push_back({1, 0, 0.5f});
+	distances.push_back({2, 1, 0.3f});
+	distances.push_back({3, 0, 0.6f});
+	distances.push_back({4, 3, 0.4f});
+
+	vector< BinaryTreeNode > tree;
+	tree.push_back(BinaryTreeNode(1,2,0.3f));
+	tree.push_back(BinaryTreeNode(3,4,0.4f));
+	tree.push_back(BinaryTreeNode(0,1,-1.0f));
+	tree.push_back(BinaryTreeNode(0,3,-1.0f));
+	tree.push_back(BinaryTreeNode(0,5,-1.0f));
+
+	vector< BinaryTreeNode > result;
+	(*ptr)(6, distances, result, 0.7f);
+	TEST_EQUAL(tree.size(), result.size());
+	for (Size i = 0; i < result.size(); ++i)
+	{
+			TOLERANCE_ABSOLUTE(0.0001);
+			TEST_EQUAL(tree[i].left_child, result[i].left_child);
+			TEST_EQUAL(tree[i].right_child, result[i].right_child);
+			TEST_REAL_SIMILAR(tree[i].distance, result[i].distance);
+	}
+
+	distances.push_back({6, 0, 0.1f});
+	TEST_EXCEPTION(Exception::IndexOverflow, (*ptr)(6, distances, result, 0.7f));
+	TEST_EXCEPTION(ClusterFunctor::InsufficientInput, (*ptr)(1, distances, result, 0.7f));
+}
+END_SECTION
+
 delete ptr;
 
 /////////////////////////////////////////////////////////////
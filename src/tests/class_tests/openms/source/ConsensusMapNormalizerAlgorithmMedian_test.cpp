@@ -53,6 +53,55 @@ START_SECTION((static std::vector<double> computeNormalizationFactors(const Cons
 }
 END_SECTION
 
+START_SECTION((static Size computeMedians(const ConsensusMap &map, const ColumnarConsensusMap &columns, std::vector< double > &medians, const String &acc_filter, const String &desc_filter)))
+{
+  // map 0: 1, 2, 4 (median 2); map 1: 10, 30 (median 20)
+  ConsensusMap map;
+  map.getColumnHeaders()[0].size = 3;
+  map.getColumnHeaders()[1].size = 2;
+  const float ints[3][2] = {{2.0f, 10.0f}, {4.0f, 30.0f}, {1.0f, 0.0f}};
+  for (Size i = 0; i < 3; ++i)
+  {
+    ConsensusFeature cf;
+    Peak2D p;
+    p.setIntensity(ints[i][0]);
+    cf.insert(0, p, i);
+    if (i < 2)
+    {
+      p.setIntensity(ints[i][1]);
+      cf.insert(1, p, i);
+    }
+    map.push_back(cf);
+  }
+
+  ColumnarConsensusMap columns(map);
+  vector<double> medians;
+  TEST_EQUAL(ConsensusMapNormalizerAlgorithmMedian::computeMedians(map, columns, medians, "", ""), 0)
+  TEST_EQUAL(medians.size(), 2)
+  TEST_REAL_SIMILAR(medians[0], 2.0)
+  TEST_REAL_SIMILAR(medians[1], 20.0)
+
+  vector<double> medians_map;
+  TEST_EQUAL(ConsensusMapNormalizerAlgorithmMedian::computeMedians(map, medians_map, "", ""), 0)
+  TEST_TRUE(medians_map == medians)
+
+  // features without identifications do not pass an accession filter
+  TEST_EQUAL(ConsensusMapNormalizerAlgorithmMedian::computeMedians(map, columns, medians, "^P1$", ""), 0)
+  TEST_REAL_SIMILAR(medians[0], 1.0)
+  TEST_REAL_SIMILAR(medians[1], 1.0)
+
+  ConsensusMap larger = map;
+  larger.push_back(ConsensusFeature());
+  TEST_EXCEPTION(Exception::InvalidSize, ConsensusMapNormalizerAlgorithmMedian::computeMedians(larger, columns, medians, "", ""))
+
+  // scaling to the median of the largest map
+  ConsensusMapNormalizerAlgorithmMedian::normalizeMaps(map, ConsensusMapNormalizerAlgorithmMedian::NM_SCALE, "", "");
+  TEST_REAL_SIMILAR(map[0].begin()->getIntensity(), 2.0)
+  TEST_REAL_SIMILAR(map[0].rbegin()->getIntensity(), 1.0)
+  TEST_REAL_SIMILAR(map[1].rbegin()->getIntensity(), 3.0)
+}
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
@@ -20,6 +20,30 @@ START_TEST(ConsensusMapNormalizerAlgorithmQuantile, "$Id$")
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 
+// three consensus features over two maps; map 1 is missing in the last one
+ConsensusMap map;
+map.getColumnHeaders()[0].size = 3;
+map.getColumnHeaders()[1].size = 2;
+{
+  Peak2D p;
+  ConsensusFeature cf;
+  p.setIntensity(3.0f);
+  cf.insert(0, p, 0);
+  p.setIntensity(10.0f);
+  cf.insert(1, p, 0);
+  map.push_back(cf);
+  ConsensusFeature cf2;
+  p.setIntensity(1.0f);
+  cf2.insert(0, p, 1);
+  p.setIntensity(20.0f);
+  cf2.insert(1, p, 1);
+  map.push_back(cf2);
+  ConsensusFeature cf3;
+  p.setIntensity(2.0f);
+  cf3.insert(0, p, 2);
+  map.push_back(cf3);
+}
+
 ConsensusMapNormalizerAlgorithmQuantile* ptr = nullptr;
 ConsensusMapNormalizerAlgorithmQuantile* null_ptr = nullptr;
 START_SECTION(ConsensusMapNormalizerAlgorithmQuantile())
@@ -43,13 +67,62 @@ END_SECTION
 
 START_SECTION((static void normalizeMaps(ConsensusMap &map)))
 {
-  // TODO
+  // reference distribution: mean of (1, 2, 3) and (10, 15, 20) = (5.5, 8.5, 11.5)
+  ConsensusMap normalized = map;
+  ConsensusMapNormalizerAlgorithmQuantile::normalizeMaps(normalized);
+  TEST_REAL_SIMILAR(normalized[0].begin()->getIntensity(), 11.5)
+  TEST_REAL_SIMILAR(normalized[0].rbegin()->getIntensity(), 5.5)
+  TEST_REAL_SIMILAR(normalized[1].begin()->getIntensity(), 5.5)
+  TEST_REAL_SIMILAR(normalized[1].rbegin()->getIntensity(), 11.5)
+  TEST_REAL_SIMILAR(normalized[2].begin()->getIntensity(), 8.5)
+
+  ConsensusMap no_headers = map;
+  no_headers.getColumnHeaders().erase(0);
+  no_headers.getColumnHeaders()[2].size = 3;
+  TEST_EXCEPTION(Exception::ElementNotFound, ConsensusMapNormalizerAlgorithmQuantile::normalizeMaps(no_headers))
+}
+END_SECTION
+
+START_SECTION((static void normalizeMaps(ColumnarConsensusMap &columns)))
+{
+  ColumnarConsensusMap columns(map);
+  ConsensusMapNormalizerAlgorithmQuantile::normalizeMaps(columns);
+  vector<float> ints = columns.getMapIntensities(0);
+  TEST_EQUAL(ints.size(), 3)
+  TEST_REAL_SIMILAR(ints[0], 11.5)
+  TEST_REAL_SIMILAR(ints[1], 5.5)
+  TEST_REAL_SIMILAR(ints[2], 8.5)
+  ints = columns.getMapIntensities(1);
+  TEST_EQUAL(ints.size(), 2)
+  TEST_REAL_SIMILAR(ints[0], 5.5)
+  TEST_REAL_SIMILAR(ints[1], 11.5)
+
+  // same result as the normalization of the consensus map
+  ConsensusMap normalized = map;
+  ConsensusMapNormalizerAlgorithmQuantile::normalizeMaps(normalized);
+  ConsensusMap applied = map;
+  columns.applyIntensities(applied);
+  TEST_TRUE(applied == normalized)
 }
 END_SECTION
 
 START_SECTION((static void resample(const std::vector< double > &data_in, std::vector< double > &data_out, UInt n_resampling_points)))
 {
-  // TODO
+  vector<double> data_in = {1.0, 2.0, 3.0};
+  vector<double> data_out;
+  ConsensusMapNormalizerAlgorithmQuantile::resample(data_in, data_out, 5);
+  TEST_EQUAL(data_out.size(), 5)
+  TEST_REAL_SIMILAR(data_out[0], 1.0)
+  TEST_REAL_SIMILAR(data_out[1], 1.5)
+  TEST_REAL_SIMILAR(data_out[2], 2.0)
+  TEST_REAL_SIMILAR(data_out[3], 2.5)
+  TEST_REAL_SIMILAR(data_out[4], 3.0)
+  ConsensusMapNormalizerAlgorithmQuantile::resample(data_in, data_out, 2);
+  TEST_EQUAL(data_out.size(), 2)
+  TEST_REAL_SIMILAR(data_out[0], 1.0)
+  TEST_REAL_SIMILAR(data_out[1], 3.0)
+  ConsensusMapNormalizerAlgorithmQuantile::resample(data_in, data_out, 0);
+  TEST_EQUAL(data_out.size(), 0)
 }
 END_SECTION
 
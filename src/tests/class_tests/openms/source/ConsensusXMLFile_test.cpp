@@ -16,6 +16,7 @@
 #include <OpenMS/KERNEL/StandardTypes.h>
 #include <OpenMS/KERNEL/ConsensusMap.h>
 #include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/INTERFACES/IConsensusDataConsumer.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
@@ -30,6 +31,25 @@ DRange<1> makeRange(double a, double b)
   return DRange<1>(pa, pb);
 }
 
+// collects everything passed by ConsensusXMLFile::transform()
+class StoringConsensusConsumer :
+  public Interfaces::IConsensusDataConsumer
+{
+public:
+  void consumeConsensusFeature(ConsensusFeature& f) override
+  {
+    map.push_back(f);
+  }
+  void setExpectedSize(Size /* expected_features */) override
+  {
+  }
+  void setMapMetaData(const ConsensusMap& meta) override
+  {
+    map = meta;
+  }
+  ConsensusMap map;
+};
+
 START_TEST(ConsensusXMLFile, "$Id$")
 
 /////////////////////////////////////////////////////////////
@@ -203,6 +223,25 @@ START_SECTION((void store(const String &filename, const ConsensusMap &consensus_
 
 END_SECTION
 
+START_SECTION((void transform(const String& filename, Interfaces::IConsensusDataConsumer* consumer)))
+  ConsensusMap map;
+  ConsensusXMLFile f;
+  f.load(OPENMS_GET_TEST_DATA_PATH("ConsensusXMLFile_1.consensusXML"), map);
+
+  StoringConsensusConsumer consumer;
+  f.transform(OPENMS_GET_TEST_DATA_PATH("ConsensusXMLFile_1.consensusXML"), &consumer);
+  TEST_EQUAL(consumer.map.size(), map.size())
+  TEST_EQUAL(consumer.map.getColumnHeaders().size(), map.getColumnHeaders().size())
+  TEST_EQUAL(consumer.map.getProteinIdentifications().size(), map.getProteinIdentifications().size())
+  TEST_EQUAL(consumer.map == map, true)
+
+  // range options apply
+  f.getOptions().setRTRange(makeRange(815, 818));
+  StoringConsensusConsumer filtered;
+  f.transform(OPENMS_GET_TEST_DATA_PATH("ConsensusXMLFile_2_options.consensusXML"), &filtered);
+  TEST_EQUAL(filtered.map.size(), 1)
+END_SECTION
+
 START_SECTION([EXTRA](bool isValid(const String &filename)))
   ConsensusXMLFile f;
   TEST_EQUAL(f.isValid(OPENMS_GET_TEST_DATA_PATH("ConsensusXMLFile_1.consensusXML"), std::cerr), true);
@@ -0,0 +1,126 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/DATAACCESS/ConsensusXMLWritingConsumer.h>
+///////////////////////////
+
+#include <OpenMS/FORMAT/ConsensusXMLFile.h>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(ConsensusXMLWritingConsumer, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+ConsensusXMLWritingConsumer* ptr = nullptr;
+ConsensusXMLWritingConsumer* null_ptr = nullptr;
+String tmp_filename;
+NEW_TMP_FILE(tmp_filename);
+
+START_SECTION((explicit ConsensusXMLWritingConsumer(const String& filename)))
+{
+  ptr = new ConsensusXMLWritingConsumer(tmp_filename);
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->getNrFeaturesWritten(), 0)
+  TEST_EXCEPTION(Exception::UnableToCreateFile, ConsensusXMLWritingConsumer("this_directory_does_not_exist/out.consensusXML"))
+}
+END_SECTION
+
+START_SECTION((~ConsensusXMLWritingConsumer()))
+{
+  delete ptr;
+  // an empty, but complete file
+  ConsensusMap empty;
+  ConsensusXMLFile().load(tmp_filename, empty);
+  TEST_EQUAL(empty.size(), 0)
+}
+END_SECTION
+
+ConsensusMap map;
+ConsensusXMLFile().load(OPENMS_GET_TEST_DATA_PATH("ConsensusXMLFile_1.consensusXML"), map);
+
+START_SECTION((void consumeConsensusFeature(ConsensusFeature& f)))
+{
+  String stored, streamed;
+  NEW_TMP_FILE(stored);
+  NEW_TMP_FILE(streamed);
+  ConsensusXMLFile().store(stored, map);
+  {
+    ConsensusXMLWritingConsumer consumer(streamed);
+    consumer.setExpectedSize(map.size());
+    consumer.setMapMetaData(map);
+    for (ConsensusFeature f : map)
+    {
+      consumer.consumeConsensusFeature(f);
+    }
+    TEST_EQUAL(consumer.getNrFeaturesWritten(), map.size())
+  }
+  // identical to writing the whole map at once
+  TEST_FILE_EQUAL(stored.c_str(), streamed.c_str())
+
+  // features without unique id get one
+  ConsensusFeature no_id;
+  no_id.setRT(1.0);
+  {
+    ConsensusXMLWritingConsumer consumer(streamed);
+    consumer.consumeConsensusFeature(no_id);
+  }
+  TEST_EQUAL(no_id.hasValidUniqueId(), true)
+  ConsensusMap reloaded;
+  ConsensusXMLFile().load(streamed, reloaded);
+  ABORT_IF(reloaded.size() != 1)
+  TEST_EQUAL(reloaded[0].getUniqueId(), no_id.getUniqueId())
+}
+END_SECTION
+
+START_SECTION((void setExpectedSize(Size expected_features)))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((void setMapMetaData(const ConsensusMap& map)))
+{
+  String streamed;
+  NEW_TMP_FILE(streamed);
+  ConsensusXMLWritingConsumer consumer(streamed);
+  consumer.setMapMetaData(map);
+  ConsensusFeature f = map[0];
+  consumer.consumeConsensusFeature(f);
+  TEST_EXCEPTION(Exception::IllegalArgument, consumer.setMapMetaData(map))
+}
+END_SECTION
+
+START_SECTION((Size getNrFeaturesWritten() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION([EXTRA] streaming with ConsensusXMLFile::transform())
+{
+  String streamed;
+  NEW_TMP_FILE(streamed);
+  {
+    ConsensusXMLWritingConsumer consumer(streamed);
+    ConsensusXMLFile().transform(OPENMS_GET_TEST_DATA_PATH("ConsensusXMLFile_1.consensusXML"), &consumer);
+  }
+  WHITELIST("?xml-stylesheet")
+  TEST_FILE_SIMILAR(OPENMS_GET_TEST_DATA_PATH("ConsensusXMLFile_1.consensusXML"), streamed)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -157,6 +157,46 @@ START_SECTION((void getAllChildTerms(std::set<String>& terms, const String& pare
 	TEST_EQUAL(terms.find("OpenMS:5") == terms.end(), false)
 END_SECTION
 
+String snapshot_file;
+NEW_TMP_FILE(snapshot_file)
+const StringList snapshot_sources = {OPENMS_GET_TEST_DATA_PATH("ControlledVocabulary.obo")};
+START_SECTION(void storeSnapshot(const String& snapshot_file, const StringList& sources) const)
+	cv.storeSnapshot(snapshot_file, snapshot_sources);
+	TEST_EQUAL(File::exists(snapshot_file), true)
+	TEST_EXCEPTION(Exception::UnableToCreateFile, cv.storeSnapshot("/does/not/exist/cv.cvbin", snapshot_sources))
+END_SECTION
+
+START_SECTION(bool loadSnapshot(const String& snapshot_file, const StringList& sources))
+	ControlledVocabulary loaded;
+	TEST_EQUAL(loaded.loadSnapshot(snapshot_file, snapshot_sources), true)
+	TEST_EQUAL(loaded.name(), cv.name())
+	TEST_EQUAL(loaded.version(), cv.version())
+	TEST_EQUAL(loaded.getTerms().size(), cv.getTerms().size())
+	bool all_equal = true;
+	for (const auto& [id, term] : cv.getTerms())
+	{
+		const ControlledVocabulary::CVTerm& other = loaded.getTerm(id);
+		all_equal &= other.name == term.name && other.id == term.id && other.parents == term.parents &&
+		             other.children == term.children && other.obsolete == term.obsolete &&
+		             other.description == term.description && other.synonyms == term.synonyms &&
+		             other.unparsed == term.unparsed && other.xref_type == term.xref_type &&
+		             other.xref_binary == term.xref_binary && other.units == term.units;
+	}
+	TEST_EQUAL(all_equal, true)
+	TEST_EQUAL(loaded.getTermByName(cv.getTerm("OpenMS:1").name).id, "OpenMS:1")
+	TEST_EQUAL(loaded.isChildOf("OpenMS:5", "OpenMS:2"), true)
+
+	// missing, invalid and outdated snapshots leave the CV unchanged
+	ControlledVocabulary other;
+	TEST_EQUAL(other.loadSnapshot("/does/not/exist/cv.cvbin", snapshot_sources), false)
+	TEST_EQUAL(other.loadSnapshot(OPENMS_GET_TEST_DATA_PATH("ControlledVocabulary.obo"), snapshot_sources), false)
+	TEST_EQUAL(other.loadSnapshot(snapshot_file, StringList()), false)
+	TEST_EQUAL(other.loadSnapshot(snapshot_file, StringList{OPENMS_GET_TEST_DATA_PATH("ControlledVocabulary.obo"), snapshot_file}), false)
+	TEST_EQUAL(other.getTerms().empty(), true)
+	TEST_EQUAL(loaded.loadSnapshot(snapshot_file, StringList()), false)
+	TEST_EQUAL(loaded.getTerms().size(), cv.getTerms().size())
+END_SECTION
+
 
 ControlledVocabulary::CVTerm * cvterm = nullptr;
 ControlledVocabulary::CVTerm * cvtermNullPointer = nullptr;
@@ -111,6 +111,23 @@ START_SECTION(double eval(double x))
   }
 END_SECTION
 
+START_SECTION(void eval(std::vector<double>& x))
+  // increasing positions (including the nodes) and some jumps back
+  std::vector<double> xs = {x_min, -0.45, -0.3, -0.1, 0.0, 0.3, 0.3, 0.75, x_max, 0.2, -0.5, 1.2, 1.0, x_max};
+  std::vector<double> ys(xs);
+  sp5.eval(ys);
+  TEST_EQUAL(ys.size(), xs.size());
+  for (Size i = 0; i < xs.size(); ++i)
+  {
+    TEST_EQUAL(ys[i], sp5.eval(xs[i]));
+  }
+  std::vector<double> empty;
+  sp5.eval(empty);
+  TEST_EQUAL(empty.empty(), true);
+  std::vector<double> outside = {0.0, x_max + 0.1};
+  TEST_EXCEPTION(Exception::IllegalArgument, sp5.eval(outside));
+END_SECTION
+
 START_SECTION(double derivatives(double x, unsigned order))
   // near border of spline range
   TEST_REAL_SIMILAR(sp1.derivatives(486.785,1), 39270152.2996247)
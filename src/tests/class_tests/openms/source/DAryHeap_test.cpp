@@ -0,0 +1,140 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Lars Nilse $
+// $Authors: Lars Nilse $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/DATASTRUCTURES/DAryHeap.h>
+///////////////////////////
+
+#include <algorithm>
+#include <random>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(DAryHeap, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+mt19937 rng(42);
+uniform_int_distribution<int> value(0, 100);
+vector<int> values;
+for (Size i = 0; i < 1000; ++i)
+{
+  values.push_back(value(rng)); // many duplicates
+}
+vector<int> sorted_values = values;
+sort(sorted_values.begin(), sorted_values.end());
+
+DAryHeap<int>* ptr = nullptr;
+DAryHeap<int>* nullPointer = nullptr;
+START_SECTION(DAryHeap(const Compare& compare = Compare()))
+{
+  ptr = new DAryHeap<int>();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->size(), 0)
+  TEST_EQUAL(ptr->empty(), true)
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(void push(T value))
+{
+  DAryHeap<int> heap;
+  heap.push(3);
+  heap.push(1);
+  heap.push(2);
+  TEST_EQUAL(heap.size(), 3)
+  TEST_EQUAL(heap.top(), 1)
+}
+END_SECTION
+
+START_SECTION(void pop())
+{
+  // default arity, binary heap and a custom order
+  DAryHeap<int> heap;
+  DAryHeap<int, std::less<int>, 2> binary_heap;
+  DAryHeap<int, std::greater<int> > max_heap;
+  heap.reserve(values.size());
+  for (int v : values)
+  {
+    heap.push(v);
+    binary_heap.push(v);
+    max_heap.push(v);
+  }
+  vector<int> popped, binary_popped, max_popped;
+  while (!heap.empty())
+  {
+    popped.push_back(heap.top());
+    heap.pop();
+    binary_popped.push_back(binary_heap.top());
+    binary_heap.pop();
+    max_popped.push_back(max_heap.top());
+    max_heap.pop();
+  }
+  TEST_EQUAL(popped == sorted_values, true)
+  TEST_EQUAL(binary_popped == sorted_values, true)
+  reverse(max_popped.begin(), max_popped.end());
+  TEST_EQUAL(max_popped == sorted_values, true)
+
+  // interleaved pushes and pops
+  DAryHeap<int> mixed;
+  mixed.push(5);
+  mixed.push(7);
+  mixed.pop();
+  mixed.push(6);
+  mixed.push(1);
+  TEST_EQUAL(mixed.top(), 1)
+  mixed.pop();
+  TEST_EQUAL(mixed.top(), 6)
+  mixed.pop();
+  TEST_EQUAL(mixed.top(), 7)
+  mixed.pop();
+  TEST_EQUAL(mixed.empty(), true)
+}
+END_SECTION
+
+START_SECTION(void clear())
+{
+  DAryHeap<int> heap;
+  heap.push(1);
+  heap.clear();
+  TEST_EQUAL(heap.empty(), true)
+}
+END_SECTION
+
+START_SECTION(const T& top() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(Size size() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(bool empty() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(void reserve(Size n))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -14,6 +14,7 @@
 #include <iomanip>
 
 #include <OpenMS/CHEMISTRY/TheoreticalSpectrumGenerator.h>
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternGenerator.h>
 
 using namespace std;
 using namespace OpenMS;
@@ -505,6 +506,35 @@ START_SECTION([EXTRA] getBYSeries_test)
 }
 END_SECTION
 
+START_SECTION(const IsotopeDistribution& getCoarseIsotopeDistribution(const EmpiricalFormula& formula, Size nr_isotopes))
+{
+  EmpiricalFormula ef("C100H150N30O30S");
+  IsotopeDistribution expected = ef.getIsotopeDistribution(CoarseIsotopePatternGenerator(5));
+  const IsotopeDistribution& d = OpenMS::DIAHelpers::getCoarseIsotopeDistribution(ef, 5);
+  TEST_EQUAL(d == expected, true)
+  // second lookup returns the stored distribution
+  TEST_EQUAL(&OpenMS::DIAHelpers::getCoarseIsotopeDistribution(ef, 5) == &d, true)
+  TEST_EQUAL(OpenMS::DIAHelpers::getCoarseIsotopeDistribution(ef, 3).size(), 3)
+  TEST_EQUAL(OpenMS::DIAHelpers::getCoarseIsotopeDistribution(EmpiricalFormula("C100H150N30O29S"), 5) == expected, false)
+}
+END_SECTION
+
+START_SECTION(const IsotopeDistribution& getCoarseAveragineDistribution(double average_weight, Size nr_isotopes))
+{
+  for (double weight : {500.0, 1234.5, 1234.6, 3000.0})
+  {
+    IsotopeDistribution expected = CoarseIsotopePatternGenerator(4).estimateFromPeptideWeight(weight);
+    const IsotopeDistribution& d = OpenMS::DIAHelpers::getCoarseAveragineDistribution(weight, 4);
+    ABORT_IF(d.size() != expected.size())
+    for (Size i = 0; i < d.size(); ++i)
+    {
+      TEST_EQUAL(d[i].getMZ(), expected[i].getMZ())
+      TEST_EQUAL(d[i].getIntensity(), expected[i].getIntensity())
+    }
+  }
+}
+END_SECTION
+
 #if 0
 START_SECTION([EXTRA] getAveragineIsotopeDistribution_test)
 {
@@ -804,6 +804,94 @@ START_SECTION ( void dia_by_ion_score(std::vector<SpectrumType> spectrum, AASequ
 }
 END_SECTION
 
+START_SECTION ( void prepareTheoreticalPatterns(const std::vector<TransitionType>& transitions, const AASequence& sequence, int by_charge, TheoreticalPatterns& patterns) const )
+{
+  std::vector<OpenSwath::LightTransition> transitions;
+  transitions.push_back(mock_tr1);
+  transitions.push_back(mock_tr2);
+
+  DIAScoring diascoring;
+  diascoring.setParameters(p_dia);
+  DIAScoring::TheoreticalPatterns patterns;
+  diascoring.prepareTheoreticalPatterns(transitions, AASequence::fromString("SYVAWDR"), 1, patterns);
+  ABORT_IF(patterns.isotopes.size() != 2)
+  TEST_EQUAL(patterns.isotopes[0].size(), 5) // dia_nr_isotopes + 1
+  TEST_REAL_SIMILAR(*std::max_element(patterns.isotopes[0].begin(), patterns.isotopes[0].end()), 1.0)
+  TEST_EQUAL(patterns.bseries.empty(), false)
+  TEST_EQUAL(patterns.yseries.empty(), false)
+
+  std::vector<double> bseries, yseries;
+  TheoreticalSpectrumGenerator generator;
+  Param p;
+  p.setValue("add_metainfo", "true");
+  generator.setParameters(p);
+  OpenMS::DIAHelpers::getBYSeries(AASequence::fromString("SYVAWDR"), bseries, yseries, &generator, 1);
+  TEST_EQUAL(patterns.bseries == bseries, true)
+  TEST_EQUAL(patterns.yseries == yseries, true)
+
+  // no sequence: no b/y ion series
+  diascoring.prepareTheoreticalPatterns(transitions, AASequence(), 1, patterns);
+  TEST_EQUAL(patterns.isotopes.size(), 2)
+  TEST_EQUAL(patterns.bseries.empty(), true)
+  TEST_EQUAL(patterns.yseries.empty(), true)
+}
+END_SECTION
+
+START_SECTION ( void dia_isotope_scores(const std::vector<TransitionType>& transitions, SpectrumSequence& spectrum, OpenSwath::IMRMFeature* mrmfeature, const RangeMobility& im_range, const TheoreticalPatterns& patterns, double& isotope_corr, double& isotope_overlap) const )
+{
+  OpenMS::RangeMobility empty_im_range;
+  SpectrumSequence sptr = prepareSpectrumSequence();
+
+  MockMRMFeature * imrmfeature_test = new MockMRMFeature();
+  getMRMFeatureTest(imrmfeature_test);
+
+  std::vector<OpenSwath::LightTransition> transitions;
+  transitions.push_back(mock_tr1);
+  transitions.push_back(mock_tr2);
+
+  DIAScoring diascoring;
+  diascoring.setParameters(p_dia);
+  DIAScoring::TheoreticalPatterns patterns;
+  diascoring.prepareTheoreticalPatterns(transitions, AASequence(), 1, patterns);
+
+  double isotope_corr = 0, isotope_overlap = 0;
+  double expected_corr = 0, expected_overlap = 0;
+  diascoring.dia_isotope_scores(transitions, sptr, imrmfeature_test, empty_im_range, patterns, isotope_corr, isotope_overlap);
+  diascoring.dia_isotope_scores(transitions, sptr, imrmfeature_test, empty_im_range, expected_corr, expected_overlap);
+  TEST_EQUAL(isotope_corr, expected_corr)
+  TEST_EQUAL(isotope_overlap, expected_overlap)
+  TEST_REAL_SIMILAR(isotope_corr, 0.995335798317618 * 0.7 + 0.959692139694113 * 0.3)
+  delete imrmfeature_test;
+}
+END_SECTION
+
+START_SECTION ( void dia_by_ion_score(const SpectrumSequence& spectrum, const TheoreticalPatterns& patterns, const RangeMobility& im_range, double& bseries_score, double& yseries_score) const )
+{
+  OpenSwath::SpectrumPtr sptr = (OpenSwath::SpectrumPtr)(new OpenSwath::Spectrum);
+  OpenSwath::BinaryDataArrayPtr data1 = (OpenSwath::BinaryDataArrayPtr)(new OpenSwath::BinaryDataArray);
+  OpenSwath::BinaryDataArrayPtr data2 = (OpenSwath::BinaryDataArrayPtr)(new OpenSwath::BinaryDataArray);
+  data1->data = {350.17164, 421.20875, 421.20875 + 79.9657, 547.26291, 646.33133, 809.39466 + 79.9657};
+  data2->data = std::vector<double>(6, 100);
+  sptr->setMZArray(data1);
+  sptr->setIntensityArray(data2);
+  SpectrumSequence sptrArr;
+  sptrArr.push_back(sptr);
+
+  DIAScoring diascoring;
+  diascoring.setParameters(p_dia);
+  OpenMS::RangeMobility empty_imRange;
+  AASequence a = AASequence::fromString("SYVAWDR");
+  a.setModification(1, "Phospho");
+  DIAScoring::TheoreticalPatterns patterns;
+  diascoring.prepareTheoreticalPatterns(std::vector<OpenSwath::LightTransition>(), a, 1, patterns);
+
+  double bseries_score = 0, yseries_score = 0;
+  diascoring.dia_by_ion_score(sptrArr, patterns, empty_imRange, bseries_score, yseries_score);
+  TEST_REAL_SIMILAR (bseries_score, 1);
+  TEST_REAL_SIMILAR (yseries_score, 3);
+}
+END_SECTION
+
 START_SECTION( void score_with_isotopes(std::vector<SpectrumType> spectrum, const std::vector< TransitionType > &transitions, double &dotprod, double &manhattan))
 {
   OpenSwath::LightTransition mock_tr1;
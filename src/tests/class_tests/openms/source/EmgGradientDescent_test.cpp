@@ -353,6 +353,47 @@ START_SECTION(void fitEMGPeakModel(
 }
 END_SECTION
 
+START_SECTION(template <typename PeakContainerT> void fitEMGPeakModels(
+  const std::vector<PeakContainerT>& input_peaks,
+  std::vector<PeakContainerT>& output_peaks,
+  const std::vector<std::pair<double, double>>& boundaries = {}
+) const)
+{
+  EmgGradientDescent emg;
+  const std::vector<MSChromatogram> chromatograms {chromatogram, saturated_chrom_min, saturated_cutoff_chrom_min, cutoff_chrom_min};
+  std::vector<MSChromatogram> out;
+  emg.fitEMGPeakModels(chromatograms, out);
+  TEST_EQUAL(out.size(), chromatograms.size())
+  for (Size i = 0; i < chromatograms.size(); ++i)
+  {
+    MSChromatogram expected;
+    emg.fitEMGPeakModel(chromatograms[i], expected);
+    TEST_TRUE(out[i] == expected)
+  }
+
+  // without the first and the last point
+  std::vector<std::pair<double, double>> boundaries;
+  for (const MSChromatogram& c : chromatograms)
+  {
+    boundaries.emplace_back(c[1].getPos(), c[c.size() - 2].getPos());
+  }
+  emg.fitEMGPeakModels(chromatograms, out, boundaries);
+  for (Size i = 0; i < chromatograms.size(); ++i)
+  {
+    MSChromatogram expected;
+    emg.fitEMGPeakModel(chromatograms[i], expected, boundaries[i].first, boundaries[i].second);
+    TEST_TRUE(out[i] == expected)
+  }
+
+  TEST_EXCEPTION(Exception::InvalidSize, emg.fitEMGPeakModels(chromatograms, out, {{2.6, 2.8}}))
+  MSSpectrum single_point;
+  single_point.emplace_back(2.7, 1000.0f);
+  std::vector<MSSpectrum> spectra {spectrum, single_point};
+  std::vector<MSSpectrum> out_spectra;
+  TEST_EXCEPTION(Exception::SizeUnderflow, emg.fitEMGPeakModels(spectra, out_spectra))
+}
+END_SECTION
+
 START_SECTION(double Loss_function(
   const std::vector<double>& xs,
   const std::vector<double>& ys,
@@ -391,6 +432,42 @@ START_SECTION(double Loss_function(
 }
 END_SECTION
 
+START_SECTION(void Loss_and_gradient(
+  const std::vector<double>& xs,
+  const std::vector<double>& ys,
+  const double h,
+  const double mu,
+  const double sigma,
+  const double tau,
+  double& E,
+  double& diff_E_h,
+  double& diff_E_mu,
+  double& diff_E_sigma,
+  double& diff_E_tau
+) const)
+{
+  EmgGradientDescent_friend emg_f;
+  // parameter sets covering all three branches of the EMG function (z < 0, z <= 6.71e7, z > 6.71e7)
+  const std::vector<std::vector<double>> parameters {
+    {1317410, 2.68121, 0.0212625, 0.0235329},
+    {1317410, 2.68121, 0.0212625, 0.5},
+    {1317410, 2.68121, 0.5, 0.0212625},
+    {1317410, 2.68121, 0.01, 1e-10}
+  };
+  for (const std::vector<double>& p : parameters)
+  {
+    double E, diff_E_h, diff_E_mu, diff_E_sigma, diff_E_tau;
+    emg_f.Loss_and_gradient(position, intensity, p[0], p[1], p[2], p[3], E, diff_E_h, diff_E_mu, diff_E_sigma, diff_E_tau);
+    // identical (not only similar) results, as gradient descent only uses the signs of the derivatives
+    TEST_EQUAL(E == emg_f.Loss_function(position, intensity, p[0], p[1], p[2], p[3]), true)
+    TEST_EQUAL(diff_E_h == emg_f.E_wrt_h(position, intensity, p[0], p[1], p[2], p[3]), true)
+    TEST_EQUAL(diff_E_mu == emg_f.E_wrt_mu(position, intensity, p[0], p[1], p[2], p[3]), true)
+    TEST_EQUAL(diff_E_sigma == emg_f.E_wrt_sigma(position, intensity, p[0], p[1], p[2], p[3]), true)
+    TEST_EQUAL(diff_E_tau == emg_f.E_wrt_tau(position, intensity, p[0], p[1], p[2], p[3]), true)
+  }
+}
+END_SECTION
+
 START_SECTION(void extractTrainingSet(
   const std::vector<double>& xs,
   const std::vector<double>& ys,
@@ -615,6 +615,38 @@ START_SECTION((static EmpiricalFormula hydrogen(int n_atoms = 1)))
 }
 END_SECTION
 
+START_SECTION(([EXTRA] cached weights and arithmetic on more than eight elements))
+{
+  // more elements than the inline storage holds
+  EmpiricalFormula big("C10H20N3O4S1P1Se1Na1K1Ca1(13)C2");
+  EmpiricalFormula diff("C-2H4N3O1Na-1Fe2");
+  EmpiricalFormula sum = big + diff;
+  TEST_EQUAL(sum, EmpiricalFormula("C8H24N6O5S1P1Se1K1Ca1(13)C2Fe2"))
+  TEST_EQUAL(sum - diff, big)
+  EmpiricalFormula acc(big);
+  acc += diff;
+  TEST_EQUAL(acc, sum)
+  acc -= diff;
+  TEST_EQUAL(acc, big)
+
+  // cached weights equal freshly parsed ones
+  TEST_REAL_SIMILAR(sum.getMonoWeight(), EmpiricalFormula("C8H24N6O5S1P1Se1K1Ca1(13)C2Fe2").getMonoWeight())
+  TEST_REAL_SIMILAR(sum.getAverageWeight(), EmpiricalFormula("C8H24N6O5S1P1Se1K1Ca1(13)C2Fe2").getAverageWeight())
+  EmpiricalFormula water("H2O");
+  water.setCharge(1);
+  TEST_REAL_SIMILAR(water.getMonoWeight(), EmpiricalFormula("H2O+").getMonoWeight())
+
+  // modifying counts through the non-const iterators is reflected in the weights
+  EmpiricalFormula ef("C6H12O6");
+  for (auto it = ef.begin(); it != ef.end(); ++it)
+  {
+    it->second *= 2;
+  }
+  TEST_REAL_SIMILAR(ef.getMonoWeight(), EmpiricalFormula("C12H24O12").getMonoWeight())
+  TEST_REAL_SIMILAR(ef.getAverageWeight(), EmpiricalFormula("C12H24O12").getAverageWeight())
+}
+END_SECTION
+
 delete e_ptr;
 
 /////////////////////////////////////////////////////////////
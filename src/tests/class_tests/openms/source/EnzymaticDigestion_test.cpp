@@ -489,6 +489,75 @@ START_SECTION(Size countInternalCleavageSites(const String& sequence) )
   TEST_EQUAL(ed.countInternalCleavageSites("EEEEEEEEEEEEEEE"), 0); // has 0 internal cleavage sites
 END_SECTION
 
+START_SECTION((Size digestUnmodified(const std::vector<StringView>& sequences, std::vector<std::vector<std::pair<Size, Size>>>& output, Size min_length, Size max_length) const))
+{
+  EnzymaticDigestion ed;
+  ed.setMissedCleavages(1);
+  std::vector<std::string> proteins = {"ACKDEFRPGHKLR", "", "MKPEPTIDERAAAK", "RKR"};
+  for (Size i = 0; i < 100; ++i)
+  {
+    proteins.push_back(String(i % 7, 'A') + "KPEK" + String(i % 5, 'C') + "R");
+  }
+  std::vector<StringView> views(proteins.begin(), proteins.end());
+  std::vector<std::vector<std::pair<Size, Size>>> out;
+  Size wrong = ed.digestUnmodified(views, out, 2, 8);
+  TEST_EQUAL(out.size(), proteins.size())
+  Size wrong_single(0);
+  bool all_equal = true;
+  for (Size i = 0; i < proteins.size(); ++i)
+  {
+    std::vector<std::pair<Size, Size>> single;
+    wrong_single += ed.digestUnmodified(views[i], single, 2, 8);
+    all_equal &= (single == out[i]);
+  }
+  TEST_EQUAL(all_equal, true)
+  TEST_EQUAL(wrong, wrong_single)
+  TEST_EQUAL(out[0].size(), 3) // ACK, DEFRPGHK, LR (ACKDEFRPGHK and DEFRPGHKLR are too long)
+  TEST_EQUAL(out[1].size(), 0)
+}
+END_SECTION
+
+START_SECTION([EXTRA] cleavage regular expressions with lookbehind and lookahead)
+{
+  // cleavage before D and after K (both at and near the sequence ends)
+  DigestionEnzyme both("test_both", "((?<=K))|((?=D))", std::set<String>());
+  EnzymaticDigestion ed;
+  ed.setEnzyme(&both);
+  vector<StringView> out;
+  std::string s = "DAKDKAD";
+  ed.digestUnmodified(s, out);
+  TEST_EQUAL(out.size(), 4)
+  ABORT_IF(out.size() != 4)
+  TEST_EQUAL(out[0].getString(), "DAK")
+  TEST_EQUAL(out[1].getString(), "DK")
+  TEST_EQUAL(out[2].getString(), "A")
+  TEST_EQUAL(out[3].getString(), "D")
+  TEST_EQUAL(ed.countInternalCleavageSites("AAKAA"), 1)
+
+  // multi-character lookbehind and negative lookahead
+  DigestionEnzyme pro("test_pro", "(?<=[HKR]P)(?!P)", std::set<String>());
+  ed.setEnzyme(&pro);
+  s = "AKPAHPPARPC";
+  ed.digestUnmodified(s, out);
+  TEST_EQUAL(out.size(), 3)
+  ABORT_IF(out.size() != 3)
+  TEST_EQUAL(out[0].getString(), "AKP")
+  TEST_EQUAL(out[1].getString(), "AHPPARP")
+  TEST_EQUAL(out[2].getString(), "C")
+
+  // syntax beyond lookaround assertions is handled by boost::regex
+  DigestionEnzyme alt("test_alt", "(?<=K)(?!P)|(?<=W{2})", std::set<String>());
+  ed.setEnzyme(&alt);
+  s = "AKPWWAKC";
+  ed.digestUnmodified(s, out);
+  TEST_EQUAL(out.size(), 3)
+  ABORT_IF(out.size() != 3)
+  TEST_EQUAL(out[0].getString(), "AKPWW")
+  TEST_EQUAL(out[1].getString(), "AK")
+  TEST_EQUAL(out[2].getString(), "C")
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
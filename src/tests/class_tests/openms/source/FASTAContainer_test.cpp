@@ -220,6 +220,20 @@ START_SECTION(Result countDecoys(FASTAContainer<T>& proteins))
   TEST_EQUAL(DecoyHelper::countDecoys(f2) == ds2, true)
 END_SECTION
 
+START_SECTION(static std::string matchDecoyPrefix(const std::string& lower))
+  TEST_EQUAL(DecoyHelper::matchDecoyPrefix("decoy_sp|p12345"), "decoy_")
+  TEST_EQUAL(DecoyHelper::matchDecoyPrefix("rev__sp|p12345"), "rev__")
+  TEST_EQUAL(DecoyHelper::matchDecoyPrefix("reversed"), "reverse") // first affix of the list which matches
+  TEST_EQUAL(DecoyHelper::matchDecoyPrefix("sp|p12345"), "")
+END_SECTION
+
+START_SECTION(static std::string matchDecoySuffix(const std::string& lower))
+  TEST_EQUAL(DecoyHelper::matchDecoySuffix("sp|p12345_decoy"), "_decoy")
+  TEST_EQUAL(DecoyHelper::matchDecoySuffix("sp|p12345_revv"), "_revv")
+  TEST_EQUAL(DecoyHelper::matchDecoySuffix("sp|p12345_decoy_x"), "")
+  TEST_EQUAL(DecoyHelper::matchDecoySuffix("sp|p12345"), "")
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -17,6 +17,9 @@
 #include <OpenMS/DATASTRUCTURES/String.h>
 #include <OpenMS/CHEMISTRY/ModificationsDB.h>
 #include <OpenMS/CHEMISTRY/AASequence.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <fstream>
 
 #include <vector>
 
@@ -270,6 +273,117 @@ START_SECTION([EXTRA] test_position)
 END_SECTION
 
 
+// small FASTA file with a PEFF header, Windows line endings and an entry without description
+String index_test_file;
+NEW_TMP_FILE(index_test_file);
+{
+  ofstream os(index_test_file.c_str(), ios::binary);
+  os << "# PEFF 1.0\n"
+     << ">P1 first protein\r\nPEPTIDE\r\nPEPTIDE\r\n"
+     << ">P2\nAAA>CCC\n"
+     << ">P3 third protein\nKKKK";
+}
+
+START_SECTION((static std::vector<Int64> buildIndex(const String& filename)))
+{
+  std::vector<Int64> offsets = FASTAFile::buildIndex(index_test_file);
+  ABORT_IF(offsets.size() != 4)
+  TEST_EQUAL(offsets[0], 11)
+  TEST_EQUAL(offsets[1], 48)
+  TEST_EQUAL(offsets[2], 60)
+  TEST_EQUAL(offsets[3], 82)
+  TEST_EXCEPTION(Exception::FileNotFound, FASTAFile::buildIndex("FASTAFile_test_this_file_does_not_exist"))
+}
+END_SECTION
+
+START_SECTION((static void readEntries(const String& filename, const std::vector<Int64>& offsets, Size begin, Size end, std::vector<FASTAEntry>& data)))
+{
+  std::vector<Int64> offsets = FASTAFile::buildIndex(index_test_file);
+  vector<FASTAFile::FASTAEntry> data, all;
+  FASTAFile::readEntries(index_test_file, offsets, 1, 3, data);
+  ABORT_IF(data.size() != 2)
+  TEST_EQUAL(data[0].identifier, "P2")
+  TEST_EQUAL(data[0].description, "")
+  TEST_EQUAL(data[0].sequence, "AAA>CCC")
+  TEST_EQUAL(data[1].identifier, "P3")
+  TEST_EQUAL(data[1].description, "third protein")
+  TEST_EQUAL(data[1].sequence, "KKKK")
+  FASTAFile::readEntries(index_test_file, offsets, 2, 2, data);
+  TEST_EQUAL(data.size(), 0)
+  TEST_EXCEPTION(Exception::IndexOverflow, FASTAFile::readEntries(index_test_file, offsets, 0, 4, data))
+
+  // same result as streamed reading
+  FASTAFile::readEntries(index_test_file, offsets, 0, 3, all);
+  FASTAFile f;
+  FASTAFile::FASTAEntry entry;
+  f.readStart(index_test_file);
+  for (const FASTAFile::FASTAEntry& e : all)
+  {
+    f.readNext(entry);
+    TEST_EQUAL(e == entry, true)
+  }
+  TEST_EQUAL(f.readNext(entry), false)
+
+  // entry without sequence
+  String bad_file;
+  NEW_TMP_FILE(bad_file);
+  ofstream(bad_file.c_str()) << ">P1\nPEPTIDE\n>P2 no sequence\n>P3\nPEPTIDE\n";
+  offsets = FASTAFile::buildIndex(bad_file);
+  TEST_EXCEPTION_WITH_MESSAGE(Exception::ParseError, FASTAFile::readEntries(bad_file, offsets, 0, 3, data),
+    "Error while parsing FASTA file! Only 1 proteins could be read. Parsing next record failed. Please check the file! in: " + bad_file)
+  TEST_EXCEPTION(Exception::ParseError, FASTAFile().load(bad_file, data))
+}
+END_SECTION
+
+START_SECTION((static void storeIndex(const String& index_file, const String& filename, const std::vector<Int64>& offsets)))
+{
+  // tested below
+  NOT_TESTABLE
+}
+END_SECTION
+
+START_SECTION((static bool loadIndex(const String& index_file, const String& filename, std::vector<Int64>& offsets)))
+{
+  std::vector<Int64> offsets = FASTAFile::buildIndex(index_test_file), loaded;
+  String index_file;
+  NEW_TMP_FILE(index_file);
+  FASTAFile::storeIndex(index_file, index_test_file, offsets);
+  TEST_EQUAL(FASTAFile::loadIndex(index_file, index_test_file, loaded), true)
+  TEST_EQUAL(loaded == offsets, true)
+
+  // outdated (the FASTA file has a different size)
+  String other_file;
+  NEW_TMP_FILE(other_file);
+  ofstream(other_file.c_str()) << ">P1\nPEPTIDE\n";
+  TEST_EQUAL(FASTAFile::loadIndex(index_file, other_file, loaded), false)
+  TEST_EQUAL(loaded.size(), 0)
+  TEST_EQUAL(FASTAFile::loadIndex("this_file_does_not_exist.offsets", index_test_file, loaded), false)
+  TEST_EQUAL(FASTAFile::loadIndex(index_test_file, index_test_file, loaded), false)
+}
+END_SECTION
+
+START_SECTION((static std::vector<Int64> loadOrBuildIndex(const String& filename, bool write_index = true)))
+{
+  const String index_file = FASTAFile::getIndexName(index_test_file);
+  std::vector<Int64> offsets = FASTAFile::loadOrBuildIndex(index_test_file, false);
+  TEST_EQUAL(File::exists(index_file), false)
+  TEST_EQUAL(offsets == FASTAFile::buildIndex(index_test_file), true)
+  offsets = FASTAFile::loadOrBuildIndex(index_test_file);
+  TEST_EQUAL(File::exists(index_file), true)
+  std::vector<Int64> loaded;
+  TEST_EQUAL(FASTAFile::loadIndex(index_file, index_test_file, loaded), true)
+  TEST_EQUAL(loaded == offsets, true)
+  TEST_EQUAL(FASTAFile::loadOrBuildIndex(index_test_file) == offsets, true)
+  File::remove(index_file);
+}
+END_SECTION
+
+START_SECTION((static String getIndexName(const String& filename)))
+{
+  TEST_EQUAL(FASTAFile::getIndexName("db/uniprot.fasta"), "db/uniprot.fasta.offsets")
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
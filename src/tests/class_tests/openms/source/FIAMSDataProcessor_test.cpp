@@ -119,6 +119,40 @@ START_SECTION((mergeAlongTime))
 }
 END_SECTION
 
+START_SECTION([EXTRA] mergeAlongTime equals the windows of SpectrumAddition::addUpSpectra)
+{
+    // spectra with different m/z ranges, one of them empty
+    vector<MSSpectrum> shifted(spectra);
+    for (Size i = 0; i < shifted.size(); ++i) {
+        for (auto & pk : shifted[i]) pk.setMZ(pk.getMZ() + 21.7 * i + 0.003 * i);
+    }
+    shifted.insert(shifted.begin() + 1, MSSpectrum());
+    MSSpectrum output = fia_processor.mergeAlongTime(shifted);
+    MSSpectrum expected;
+    const vector<float>& mzs = fia_processor.getMZs();
+    for (Size i = 0; i + 1 < mzs.size(); ++i) {
+        MSSpectrum full = SpectrumAddition::addUpSpectra(shifted, fia_processor.getBinSizes()[i], false);
+        for (const auto & pk : full) {
+            if (pk.getMZ() > mzs[i+1]) break;
+            if (pk.getMZ() >= mzs[i]) expected.push_back(pk);
+        }
+    }
+    expected.sortByPosition();
+    TEST_EQUAL(output.size(), expected.size());
+    bool same = output.size() == expected.size();
+    for (Size i = 0; same && i < output.size(); ++i) {
+        same = output[i].getMZ() == expected[i].getMZ() && output[i].getIntensity() == expected[i].getIntensity();
+    }
+    TEST_EQUAL(same, true);
+
+    // a single spectrum is kept as is (the peak at m/z 100 is on the border of two windows and part of both),
+    // nothing is merged if the first spectrum is empty
+    TEST_EQUAL(fia_processor.mergeAlongTime({spectra[0]}).size(), spectra[0].size() + 1);
+    TEST_EQUAL(fia_processor.mergeAlongTime({MSSpectrum(), spectra[0]}).empty(), true);
+    TEST_EQUAL(fia_processor.mergeAlongTime({}).empty(), true);
+}
+END_SECTION
+
 START_SECTION((extractPeaks))
 {
     MSSpectrum picked = fia_processor.extractPeaks(merged);
@@ -141,6 +175,39 @@ START_SECTION((convertToFeatureMap))
 }
 END_SECTION
 
+START_SECTION((Param getAccurateMassSearchParameters() const))
+{
+    Param ams_param = fia_processor.getAccurateMassSearchParameters();
+    TEST_REAL_SIMILAR(static_cast<double>(ams_param.getValue("mass_error_value")), 1e6 / (120000.0 * 2));
+    TEST_EQUAL(ams_param.getValue("positive_adducts").toString(), OPENMS_GET_TEST_DATA_PATH("FIAMS_negative_adducts.tsv"));
+    TEST_EQUAL(ams_param.getValue("keep_unidentified_masses").toString(), "false");
+}
+END_SECTION
+
+START_SECTION((void setAccurateMassSearchEngine(std::shared_ptr<const AccurateMassSearchEngine> engine)))
+{
+    FIAMSDataProcessor processor(fia_processor);
+    auto ams = std::make_shared<AccurateMassSearchEngine>();
+    ams->setParameters(processor.getAccurateMassSearchParameters());
+    ams->init();
+    processor.setAccurateMassSearchEngine(ams);
+
+    FeatureMap features = processor.convertToFeatureMap(spec_picked);
+    MzTab shared_output, own_output;
+    processor.runAccurateMassSearch(features, shared_output);
+    FeatureMap features_own = fia_processor.convertToFeatureMap(spec_picked);
+    FIAMSDataProcessor(fia_processor).runAccurateMassSearch(features_own, own_output);
+    TEST_EQUAL(shared_output.getSmallMoleculeSectionRows().size(), own_output.getSmallMoleculeSectionRows().size());
+
+    // an engine with other settings is rejected
+    auto other = std::make_shared<AccurateMassSearchEngine>();
+    Param other_param = processor.getAccurateMassSearchParameters();
+    other_param.setValue("mass_error_value", 10.0);
+    other->setParameters(other_param);
+    TEST_EXCEPTION(Exception::IllegalArgument, processor.setAccurateMassSearchEngine(other));
+}
+END_SECTION
+
 START_SECTION((test_run_cached))
 {
     MzTab mztab_output_30;
@@ -10,7 +10,9 @@
 #include <OpenMS/test_config.h>
 ///////////////////////////
 #include <OpenMS/KERNEL/FeatureMap.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/QC/FWHM.h>
+#include <OpenMS/QC/QCEngine.h>
 
 ///////////////////////////
 
@@ -52,6 +54,23 @@ START_SECTION(void compute(FeatureMap& features))
 }
 END_SECTION
 
+START_SECTION(void addVisitors(QCEngine& engine) const)
+{
+  Feature f;
+  f.getPeptideIdentifications().push_back(PeptideIdentification());
+  f.setMetaValue("FWHM", 12.5);
+  FeatureMap fm;
+  fm.push_back(f);
+  fm.getUnassignedPeptideIdentifications().push_back(PeptideIdentification());
+  QCEngine engine;
+  FWHM().addVisitors(engine);
+  TEST_EQUAL(engine.getNrPSMVisitors(), 1)
+  engine.run(MSExperiment(), fm, QCBase::SpectraMap());
+  TEST_EQUAL(fm[0].getPeptideIdentifications()[0].getMetaValue("FWHM"), 12.5)
+  TEST_EQUAL(fm.getUnassignedPeptideIdentifications()[0].metaValueExists("FWHM"), false)
+}
+END_SECTION
+
 START_SECTION(QCBase::Status requirements() const override)
 {
   FWHM fw;
@@ -107,4 +107,51 @@ START_SECTION((Filter FeatureMap))
 
 END_SECTION
 
+START_SECTION(([EXTRA] Filter FeatureMap in parallel))
+  // chains of overlapping features in many clusters
+  FeatureMap fmap;
+  for (Size i = 0; i < 2000; ++i)
+  {
+    Feature f;
+    double rt = double(i / 10) * 100.0 + double(i % 10) * 3.0;
+    double mz = 100.0 + double(i % 3) * 0.3;
+    f.setRT(rt);
+    f.setMZ(mz);
+    f.setOverallQuality(double((i * 37) % 101));
+    std::vector<ConvexHull2D> hulls(1);
+    hulls[0].addPoint(DPosition<2>(rt, mz));
+    hulls[0].addPoint(DPosition<2>(rt + 5.0, mz + 0.5));
+    f.setConvexHulls(hulls);
+    f.ensureUniqueId();
+    fmap.push_back(f);
+  }
+  fmap.updateRanges();
+
+  // counts the removed features at the representative (only modifies the arguments)
+  auto callback = [](Feature& best, Feature& overlap)
+  {
+    if (int(overlap.getOverallQuality()) % 5 == 0) return false;
+    best.setMetaValue("n_removed", int(best.getMetaValue("n_removed", 0)) + 1);
+    return true;
+  };
+  auto comparator = [](const Feature& left, const Feature& right){ return left.getOverallQuality() > right.getOverallQuality(); };
+
+  FeatureMap serial = fmap, parallel = fmap;
+  FeatureOverlapFilter::filter(serial, comparator, callback, false);
+  FeatureOverlapFilter::filter(parallel, comparator, callback, false, true);
+  TEST_EQUAL(serial.size() < fmap.size(), true)
+  TEST_EQUAL(parallel.size(), serial.size())
+  bool same = true;
+  for (Size i = 0; i < serial.size(); ++i)
+  {
+    same &= serial[i].getUniqueId() == parallel[i].getUniqueId();
+    same &= int(serial[i].getMetaValue("n_removed", 0)) == int(parallel[i].getMetaValue("n_removed", 0));
+  }
+  TEST_EQUAL(same, true)
+
+  FeatureMap empty;
+  FeatureOverlapFilter::filter(empty, comparator, callback, false, true);
+  TEST_EQUAL(empty.size(), 0)
+END_SECTION
+
 END_TEST
@@ -14,6 +14,7 @@
 #include <OpenMS/KERNEL/FeatureMap.h>
 #include <OpenMS/FORMAT/OPTIONS/FeatureFileOptions.h>
 #include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/INTERFACES/IFeatureDataConsumer.h>
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 #include <OpenMS/KERNEL/MSSpectrum.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
@@ -27,6 +28,27 @@ DRange<1> makeRange(double a, double b)
   return DRange<1>(pa, pb);
 }
 
+// collects everything passed by FeatureXMLFile::transform()
+class StoringFeatureConsumer :
+  public Interfaces::IFeatureDataConsumer
+{
+public:
+  void consumeFeature(Feature& f) override
+  {
+    map.push_back(f);
+  }
+  void setExpectedSize(Size expected_features) override
+  {
+    expected = expected_features;
+  }
+  void setMapMetaData(const FeatureMap& meta) override
+  {
+    map = meta;
+  }
+  FeatureMap map;
+  Size expected = 0;
+};
+
 ///////////////////////////
 
 START_TEST(FeatureXMLFile, "$Id$")
@@ -218,6 +240,28 @@ START_SECTION((void store(const String &filename, const FeatureMap&feature_map))
 }
 END_SECTION
 
+START_SECTION((void transform(const String& filename, Interfaces::IFeatureDataConsumer* consumer)))
+{
+  FeatureMap map;
+  FeatureXMLFile f;
+  f.load(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML"), map);
+
+  StoringFeatureConsumer consumer;
+  f.transform(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML"), &consumer);
+  TEST_EQUAL(consumer.expected, map.size())
+  TEST_EQUAL(consumer.map.size(), map.size())
+  consumer.map.updateRanges();
+  TEST_EQUAL(consumer.map == map, true)
+
+  // range options apply
+  f.getOptions().setRTRange(makeRange(1.5, 4.5));
+  StoringFeatureConsumer filtered;
+  f.transform(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_2_options.featureXML"), &filtered);
+  TEST_EQUAL(filtered.map.size(), 5)
+  TEST_EQUAL(filtered.map.getIdentifier(), "lsid2")
+}
+END_SECTION
+
 START_SECTION((FeatureFileOptions & getOptions()))
 {
   FeatureXMLFile f;
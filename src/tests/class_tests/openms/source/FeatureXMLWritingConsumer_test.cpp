@@ -0,0 +1,126 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/DATAACCESS/FeatureXMLWritingConsumer.h>
+///////////////////////////
+
+#include <OpenMS/FORMAT/FeatureXMLFile.h>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(FeatureXMLWritingConsumer, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+FeatureXMLWritingConsumer* ptr = nullptr;
+FeatureXMLWritingConsumer* null_ptr = nullptr;
+String tmp_filename;
+NEW_TMP_FILE(tmp_filename);
+
+START_SECTION((explicit FeatureXMLWritingConsumer(const String& filename)))
+{
+  ptr = new FeatureXMLWritingConsumer(tmp_filename);
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->getNrFeaturesWritten(), 0)
+  TEST_EXCEPTION(Exception::UnableToCreateFile, FeatureXMLWritingConsumer("this_directory_does_not_exist/out.featureXML"))
+}
+END_SECTION
+
+START_SECTION((~FeatureXMLWritingConsumer()))
+{
+  delete ptr;
+  // an empty, but complete file
+  FeatureMap empty;
+  FeatureXMLFile().load(tmp_filename, empty);
+  TEST_EQUAL(empty.size(), 0)
+}
+END_SECTION
+
+FeatureMap map;
+FeatureXMLFile().load(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML"), map);
+
+START_SECTION((void consumeFeature(Feature& f)))
+{
+  String stored, streamed;
+  NEW_TMP_FILE(stored);
+  NEW_TMP_FILE(streamed);
+  FeatureXMLFile().store(stored, map);
+  {
+    FeatureXMLWritingConsumer consumer(streamed);
+    consumer.setExpectedSize(map.size());
+    consumer.setMapMetaData(map);
+    for (Feature f : map)
+    {
+      consumer.consumeFeature(f);
+    }
+    TEST_EQUAL(consumer.getNrFeaturesWritten(), map.size())
+  }
+  // identical to writing the whole map at once
+  TEST_FILE_EQUAL(stored.c_str(), streamed.c_str())
+
+  // features without unique id get one
+  Feature no_id;
+  no_id.setRT(1.0);
+  {
+    FeatureXMLWritingConsumer consumer(streamed);
+    consumer.consumeFeature(no_id);
+  }
+  TEST_EQUAL(no_id.hasValidUniqueId(), true)
+  FeatureMap reloaded;
+  FeatureXMLFile().load(streamed, reloaded);
+  ABORT_IF(reloaded.size() != 1)
+  TEST_EQUAL(reloaded[0].getUniqueId(), no_id.getUniqueId())
+}
+END_SECTION
+
+START_SECTION((void setExpectedSize(Size expected_features)))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((void setMapMetaData(const FeatureMap& map)))
+{
+  String streamed;
+  NEW_TMP_FILE(streamed);
+  FeatureXMLWritingConsumer consumer(streamed);
+  consumer.setMapMetaData(map);
+  Feature f = map[0];
+  consumer.consumeFeature(f);
+  TEST_EXCEPTION(Exception::IllegalArgument, consumer.setMapMetaData(map))
+}
+END_SECTION
+
+START_SECTION((Size getNrFeaturesWritten() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION([EXTRA] streaming with FeatureXMLFile::transform())
+{
+  String streamed;
+  NEW_TMP_FILE(streamed);
+  {
+    FeatureXMLWritingConsumer consumer(streamed);
+    FeatureXMLFile().transform(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML"), &consumer);
+  }
+  WHITELIST("?xml-stylesheet")
+  TEST_FILE_SIMILAR(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML"), streamed)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -435,6 +435,42 @@ START_SECTION(( void setAbsolute(bool absolute) ))
 }
 END_SECTION
 
+START_SECTION(( std::vector<IsotopeDistribution> runBatch(const std::vector<EmpiricalFormula>& formulas, const String& cache_file = "") const ))
+{
+  std::vector<EmpiricalFormula> formulas = {EmpiricalFormula("C520H817N139O147S8"), EmpiricalFormula("C6H12O6"),
+                                            EmpiricalFormula("C100H202"), EmpiricalFormula("C6H12O6"), EmpiricalFormula("C2H5OHBr")};
+  for (bool total_prob : {true, false})
+  {
+    FineIsotopePatternGenerator gen(0.01, total_prob, false);
+    std::vector<IsotopeDistribution> batch = gen.runBatch(formulas);
+    TEST_EQUAL(batch.size(), formulas.size())
+    for (Size i = 0; i < formulas.size(); ++i)
+    {
+      TEST_EQUAL(batch[i] == gen.run(formulas[i]), true)
+    }
+  }
+
+  // the cache file reproduces the computed distributions exactly
+  String cache_file;
+  NEW_TMP_FILE(cache_file);
+  FineIsotopePatternGenerator gen(0.01, false, false);
+  std::vector<IsotopeDistribution> first = gen.runBatch(formulas, cache_file);
+  std::vector<IsotopeDistribution> cached = gen.runBatch(formulas, cache_file);
+  TEST_EQUAL(cached.size(), formulas.size())
+  for (Size i = 0; i < formulas.size(); ++i)
+  {
+    TEST_EQUAL(cached[i] == first[i], true)
+  }
+
+  // entries of a cache file written with other settings are not used
+  FineIsotopePatternGenerator other(0.001, false, true);
+  std::vector<IsotopeDistribution> recomputed = other.runBatch({formulas[0]}, cache_file);
+  TEST_EQUAL(recomputed[0] == other.run(formulas[0]), true)
+
+  TEST_EQUAL(gen.runBatch({}).empty(), true)
+}
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
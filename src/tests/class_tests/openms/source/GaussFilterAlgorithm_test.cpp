@@ -66,6 +66,34 @@ START_SECTION((template <typename ConstIterT, typename IterT> bool filter(ConstI
   }
 END_SECTION 
 
+START_SECTION([EXTRA] equidistant data uses a pre-sampled kernel with the same result)
+  // equidistant data, and the same data with one far away point appended (which is then not equidistant anymore)
+  std::vector<double> mz, intensities;
+  for (Size i = 0; i < 200; ++i)
+  {
+    mz.push_back(500.0 + 0.01 * i);
+    intensities.push_back(100.0 * std::exp(-std::pow((i % 50) - 25.0, 2) / 20.0) + (i % 7));
+  }
+  std::vector<double> mz_nonuniform(mz), intensities_nonuniform(intensities);
+  mz_nonuniform.push_back(510.0);
+  intensities_nonuniform.push_back(0.0);
+
+  GaussFilterAlgorithm gauss;
+  gauss.initialize(0.1 /* gaussian_width */, 0.001 /* spacing */, 10.0 /* ppm_tolerance */, false /* use_ppm_tolerance */);
+  std::vector<double> mz_out(mz.size()), intensities_out(mz.size());
+  TEST_EQUAL(gauss.filter(mz.begin(), mz.end(), intensities.begin(), mz_out.begin(), intensities_out.begin()), true)
+  std::vector<double> mz_out_nonuniform(mz_nonuniform.size()), intensities_out_nonuniform(mz_nonuniform.size());
+  gauss.filter(mz_nonuniform.begin(), mz_nonuniform.end(), intensities_nonuniform.begin(), mz_out_nonuniform.begin(), intensities_out_nonuniform.begin());
+
+  // identical, except close to the end of the equidistant data (where the kernel is cut off only there)
+  TOLERANCE_RELATIVE(1.0 + 1e-6)
+  for (Size i = 0; mz[i] < mz.back() - 0.1; ++i)
+  {
+    TEST_REAL_SIMILAR(mz_out[i], mz[i])
+    TEST_REAL_SIMILAR(intensities_out[i], intensities_out_nonuniform[i])
+  }
+END_SECTION
+
 START_SECTION((bool filter(OpenMS::Interfaces::SpectrumPtr spectrum)))
 
   OpenMS::Interfaces::SpectrumPtr spectrum(new OpenMS::Interfaces::Spectrum);
@@ -68,6 +68,71 @@ START_SECTION(void cluster())
     TEST_EQUAL(clustering.getResults().size(), 12);
 END_SECTION
 
+START_SECTION(void clusterParallel(Size max_region_size = std::numeric_limits<Size>::max()))
+    // points on a finer grid, in stripes separated by empty columns and with duplicate distances
+    std::vector<double> fine_spacing_x;
+    std::vector<double> fine_spacing_y;
+    for (double i = 0; i <= 200; ++i)
+    {
+        fine_spacing_x.push_back(i);
+    }
+    for (double i = 0; i <= 20; ++i)
+    {
+        fine_spacing_y.push_back(i);
+    }
+    std::vector<double> fine_x;
+    std::vector<double> fine_y;
+    std::vector<int> fine_A;
+    std::vector<int> fine_B;
+    for (int i = 0; i < 3000; ++i)
+    {
+        double stripe = 10.0 * (i % 20);
+        fine_x.push_back(stripe + 3.0 * (sin(static_cast<double>(i)) + 1));
+        fine_y.push_back(i % 7 == 0 ? 5.0 : 10.0 * (sin(static_cast<double>(i + 18)) + 1));
+        fine_A.push_back((i / 20) % 2);
+        fine_B.push_back((i / 40) % 4);
+    }
+
+    GridBasedClustering<MultiplexClustering::MultiplexDistance> sequential(metric, fine_x, fine_y, fine_A, fine_B, fine_spacing_x, fine_spacing_y);
+    sequential.cluster();
+    GridBasedClustering<MultiplexClustering::MultiplexDistance> parallel(metric, fine_x, fine_y, fine_A, fine_B, fine_spacing_x, fine_spacing_y);
+    parallel.clusterParallel();
+    std::map<int, GridBasedCluster> expected = sequential.getResults();
+    std::map<int, GridBasedCluster> result = parallel.getResults();
+    TEST_EQUAL(result.size(), expected.size())
+    bool same = result.size() == expected.size();
+    for (std::map<int, GridBasedCluster>::const_iterator it = result.begin(), it_exp = expected.begin(); same && it != result.end(); ++it, ++it_exp)
+    {
+        same = it->first == it_exp->first && it->second.getPoints() == it_exp->second.getPoints();
+    }
+    TEST_EQUAL(same, true)
+
+    // same on the original data (no empty columns)
+    GridBasedClustering<MultiplexClustering::MultiplexDistance> dense(metric, data_x, data_y, properties_A, properties_B, grid_spacing_x, grid_spacing_y);
+    dense.clusterParallel();
+    TEST_EQUAL(dense.getResults().size(), 12)
+
+    // cut into small regions and stitched: every point in exactly one cluster, clusters respect properties A and B
+    GridBasedClustering<MultiplexClustering::MultiplexDistance> cut(metric, fine_x, fine_y, fine_A, fine_B, fine_spacing_x, fine_spacing_y);
+    cut.clusterParallel(50);
+    result = cut.getResults();
+    std::vector<int> count(fine_x.size(), 0);
+    bool valid = true;
+    for (const std::pair<const int, GridBasedCluster>& c : result)
+    {
+        std::set<int> B;
+        for (int p : c.second.getPoints())
+        {
+            ++count[p];
+            valid &= fine_A[p] == fine_A[c.second.getPoints().front()];
+            valid &= B.insert(fine_B[p]).second;
+        }
+    }
+    TEST_EQUAL(valid, true)
+    TEST_EQUAL(std::count(count.begin(), count.end(), 1), (SignedSize)fine_x.size())
+    TEST_EQUAL(result.size() >= expected.size(), true)
+END_SECTION
+
 START_SECTION(std::map<int Cluster> getResults() const)
     clustering.cluster();
     TEST_EQUAL(clustering.getResults().size(), 12);
@@ -55,5 +55,49 @@ START_TEST(GridSearch, "$Id$")
         }
     END_SECTION
 
+    START_SECTION(GridSearch evaluateInBatches)
+    {
+      auto evaluator = [](double i, const std::string& j, double k, double l)
+      {
+        return i+j.length()+k+l;
+      };
+      for (size_t batch_size : {1, 3, 8, 100})
+      {
+        Size nr_evaluated = 0;
+        auto batch_evaluator = [&](const std::vector<std::tuple<double, std::string, double, double>>& batch)
+        {
+          TEST_EQUAL(batch.size() <= batch_size, true)
+          nr_evaluated += batch.size();
+          std::vector<double> results;
+          for (const auto& c : batch)
+          {
+            results.push_back(evaluator(get<0>(c), get<1>(c), get<2>(c), get<3>(c)));
+          }
+          return results;
+        };
+
+        GridSearch<double, std::string, double, double> gs({1,3,5,2},{"foo","barz"},{2},{3});
+        std::array<size_t, 4> bestParamIdx{{0u,0u,0u,0u}};
+        double best = gs.evaluateInBatches(batch_evaluator, batch_size, -1.0, bestParamIdx);
+        TEST_REAL_SIMILAR(best, 14.0)
+        TEST_EQUAL(nr_evaluated, 8)
+        TEST_EQUAL(get<0>(bestParamIdx),2)
+        TEST_EQUAL(get<1>(bestParamIdx),1)
+        TEST_EQUAL(get<2>(bestParamIdx),0)
+        TEST_EQUAL(get<3>(bestParamIdx),0)
+      }
+
+      // ties: the first combination (in the order of evaluate()) wins
+      GridSearch<double, double> ties({1,1},{2,2});
+      std::array<size_t, 2> bestIdx{{5u,5u}};
+      ties.evaluateInBatches([](const std::vector<std::tuple<double, double>>& batch)
+      {
+        return std::vector<double>(batch.size(), 1.0);
+      }, 3, 0.0, bestIdx);
+      TEST_EQUAL(get<0>(bestIdx),0)
+      TEST_EQUAL(get<1>(bestIdx),0)
+    }
+    END_SECTION
+
 
 END_TEST
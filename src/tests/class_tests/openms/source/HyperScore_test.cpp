@@ -91,6 +91,15 @@ START_SECTION((static double compute(double fragment_mass_tolerance, bool fragme
 }
 END_SECTION
 
+START_SECTION((static double computeFromMatches(size_t matched_b_ions, size_t matched_y_ions, double dot_product)))
+{
+  TEST_REAL_SIMILAR(HyperScore::computeFromMatches(0, 0, 0.0), 0.0);
+  // same as the full match of PEPTIDE above (5 b-ions, 6 y-ions)
+  TEST_REAL_SIMILAR(HyperScore::computeFromMatches(5, 6, 11.0), 13.8516496);
+  TEST_REAL_SIMILAR(HyperScore::computeFromMatches(6, 5, 11.0), 13.8516496);
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
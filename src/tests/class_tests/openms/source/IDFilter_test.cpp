@@ -97,6 +97,41 @@ START_SECTION((template <class Container, class Predicate> static void keepMatch
 }
 END_SECTION
 
+START_SECTION((template <class Container, class Function> static void parallelForEach(Container& items, const Function& f)))
+{
+  vector<int> numbers(1000);
+  for (Size i = 0; i < numbers.size(); ++i)
+  {
+    numbers[i] = i;
+  }
+  IDFilter::parallelForEach(numbers, [](int& n) { n *= 2; });
+  bool all_doubled = true;
+  for (Size i = 0; i < numbers.size(); ++i)
+  {
+    all_doubled &= (numbers[i] == 2 * int(i));
+  }
+  TEST_EQUAL(all_doubled, true);
+
+  // the exception of the first failing item is re-thrown:
+  String error;
+  try
+  {
+    IDFilter::parallelForEach(numbers, [](int& n) {
+      if (n % 400 == 2)
+      {
+        throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "odd", String(n));
+      }
+    });
+  }
+  catch (Exception::InvalidValue& e)
+  {
+    error = e.what();
+  }
+  TEST_EQUAL(error.hasSubstring("'2'"), true);
+  TEST_EQUAL(error.hasSubstring("'802'"), false);
+}
+END_SECTION
+
 START_SECTION((template <class IdentificationType> static Size countHits(const vector<IdentificationType>& ids)))
 {
   vector<PeptideIdentification> peptides(4);
@@ -290,6 +325,46 @@ START_SECTION((static void updateProteinReferences(vector<PeptideIdentification>
 }
 END_SECTION
 
+START_SECTION((static void updateProteinReferences(PeakMap& experiment, bool remove_peptides_without_reference = false)))
+{
+  PeakMap experiment;
+  experiment.getProteinIdentifications().resize(1);
+  experiment.getProteinIdentifications()[0].setIdentifier("run");
+  experiment.getProteinIdentifications()[0].getHits().resize(2);
+  experiment.getProteinIdentifications()[0].getHits()[0].setAccession("A");
+  experiment.getProteinIdentifications()[0].getHits()[1].setAccession("B");
+
+  PeptideEvidence evidence_a, evidence_b, evidence_c;
+  evidence_a.setProteinAccession("A");
+  evidence_b.setProteinAccession("B");
+  evidence_c.setProteinAccession("C");
+  vector<PeptideIdentification> ids(2);
+  ids[0].setIdentifier("run");
+  ids[0].getHits().resize(2);
+  ids[0].getHits()[0].setPeptideEvidences({evidence_c, evidence_a, evidence_c, evidence_b});
+  ids[0].getHits()[1].setPeptideEvidences({evidence_c});
+  ids[1].setIdentifier("other_run"); // no proteins
+  ids[1].getHits().resize(1);
+  ids[1].getHits()[0].setPeptideEvidences({evidence_a});
+  experiment.addSpectrum(MSSpectrum());
+  experiment.addSpectrum(MSSpectrum());
+  experiment[1].setPeptideIdentifications(ids);
+
+  IDFilter::updateProteinReferences(experiment);
+  const vector<PeptideIdentification>& filtered = experiment[1].getPeptideIdentifications();
+  TEST_EQUAL(filtered[0].getHits().size(), 2);
+  TEST_EQUAL(filtered[0].getHits()[0].getPeptideEvidences().size(), 2);
+  TEST_EQUAL(filtered[0].getHits()[0].getPeptideEvidences()[0].getProteinAccession(), "A");
+  TEST_EQUAL(filtered[0].getHits()[0].getPeptideEvidences()[1].getProteinAccession(), "B");
+  TEST_EQUAL(filtered[0].getHits()[1].getPeptideEvidences().empty(), true);
+  TEST_EQUAL(filtered[1].getHits()[0].getPeptideEvidences().empty(), true);
+
+  IDFilter::updateProteinReferences(experiment, true);
+  TEST_EQUAL(filtered[0].getHits().size(), 1);
+  TEST_EQUAL(filtered[1].getHits().empty(), true);
+}
+END_SECTION
+
 START_SECTION((bool updateProteinGroups(vector<ProteinIdentification::ProteinGroup>& groups, const vector<ProteinHit>& hits)))
 {
   vector<ProteinIdentification::ProteinGroup> groups(2);
@@ -505,6 +580,46 @@ START_SECTION((template <class IdentificationType> static void keepHitsMatchingP
 }
 END_SECTION
 
+START_SECTION((template <class IdentificationType> class HitFilterPipeline))
+{
+  set<String> accessions;
+  accessions.insert("Q824A5");
+  accessions.insert("Q872T5");
+  accessions.insert("AAD30739");
+
+  // same result as the separate filter functions:
+  vector<PeptideIdentification> peptides = global_peptides;
+  peptides[0].getHits()[0].setMetaValue("target_decoy", "decoy");
+  peptides[0].getHits()[2].setMetaValue("isDecoy", "true");
+  vector<PeptideIdentification> expected = peptides;
+  IDFilter::filterHitsByScore(expected, 33);
+  IDFilter::removeDecoyHits(expected);
+  IDFilter::keepHitsMatchingProteins(expected, accessions);
+
+  IDFilter::HitFilterPipeline<PeptideIdentification> pipeline;
+  pipeline.keepByScore(33).removeDecoys().keepMatchingProteins(accessions);
+  TEST_EQUAL(pipeline.size(), 3);
+  pipeline.apply(peptides);
+  TEST_EQUAL(peptides.size(), 1);
+  TEST_EQUAL(peptides[0].getHits().size(), expected[0].getHits().size());
+  TEST_EQUAL(peptides[0].getHits() == expected[0].getHits(), true);
+
+  // custom filters, removal of empty IDs:
+  accessions.erase("AAD30739");
+  vector<ProteinIdentification> proteins = global_proteins;
+  IDFilter::HitFilterPipeline<ProteinIdentification> protein_pipeline;
+  protein_pipeline.removeMatchingProteins(accessions)
+    .keepIf([](const ProteinIdentification& id, const ProteinHit& hit) { return id.getScoreType() == "Mascot" && hit.getAccession() != "S53854"; });
+  protein_pipeline.apply(proteins);
+  TEST_EQUAL(proteins.size(), 1);
+  TEST_EQUAL(proteins[0].getHits().size(), 1);
+  TEST_EQUAL(proteins[0].getHits()[0].getAccession(), "AAD30739");
+  protein_pipeline.keepMatching([](const ProteinHit&) { return false; }).setRemoveEmptyIdentifications(true);
+  protein_pipeline.apply(proteins);
+  TEST_EQUAL(proteins.empty(), true);
+}
+END_SECTION
+
 START_SECTION((static void keepBestPeptideHits(vector<PeptideIdentification>& peptides, bool strict = false)))
 {
   vector<PeptideIdentification> peptides = global_peptides;
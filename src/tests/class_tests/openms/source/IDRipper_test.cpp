@@ -62,6 +62,72 @@ START_SECTION((void rip(std::map< String, std::pair< std::vector< ProteinIdentif
 }
 END_SECTION
 
+START_SECTION((void rip(const RipFileConsumer& consumer, std::vector<ProteinIdentification>& proteins, std::vector<PeptideIdentification>& peptides, bool numeric_filenames, bool split_ident_runs)))
+{
+  // one run with peptides from two files (annotated by file_origin)
+  vector<ProteinIdentification> proteins(1);
+  proteins[0].setIdentifier("run");
+  for (const String& acc : {"P1", "P2", "P3"})
+  {
+    ProteinHit hit;
+    hit.setAccession(acc);
+    proteins[0].insertHit(hit);
+  }
+  vector<PeptideIdentification> peptides;
+  const vector<pair<String, String> > origins_accessions = {{"a.mzML", "P1"}, {"b.mzML", "P2"}, {"a.mzML", "P3"}, {"b.mzML", "P2"}};
+  for (Size i = 0; i < origins_accessions.size(); ++i)
+  {
+    PeptideIdentification pep;
+    pep.setIdentifier("run");
+    pep.setRT(double(i));
+    pep.setMetaValue("file_origin", origins_accessions[i].first);
+    PeptideHit hit;
+    PeptideEvidence evidence;
+    evidence.setProteinAccession(origins_accessions[i].second);
+    hit.addPeptideEvidence(evidence);
+    pep.insertHit(hit);
+    peptides.push_back(pep);
+  }
+
+  // reference: the map-based rip
+  IDRipper::RipFileMap ripped;
+  vector<ProteinIdentification> proteins_copy = proteins;
+  vector<PeptideIdentification> peptides_copy = peptides;
+  IDRipper().rip(ripped, proteins_copy, peptides_copy, false, false);
+  TEST_EQUAL(ripped.size(), 2)
+
+  vector<IDRipper::RipFileIdentifier> rfis;
+  vector<IDRipper::RipFileContent> rfcs;
+  IDRipper().rip([&rfis, &rfcs](const IDRipper::RipFileIdentifier& rfi, IDRipper::RipFileContent&& rfc)
+  {
+    rfis.push_back(rfi);
+    rfcs.push_back(std::move(rfc));
+  }, proteins, peptides, false, false);
+  TEST_EQUAL(peptides.empty(), true)
+  ABORT_IF(rfcs.size() != ripped.size())
+  Size i = 0;
+  for (auto& it : ripped)
+  {
+    TEST_EQUAL(rfis[i].getOutputBasename(), it.first.getOutputBasename())
+    const vector<ProteinIdentification>& prots = rfcs[i].getProteinIdentifications();
+    const vector<PeptideIdentification>& peps = rfcs[i].getPeptideIdentifications();
+    TEST_EQUAL(prots == it.second.getProteinIdentifications(), true)
+    TEST_EQUAL(peps == it.second.getPeptideIdentifications(), true)
+    ++i;
+  }
+  // only the proteins referenced by the peptides of each file
+  TEST_EQUAL(rfis[0].getOutputBasename(), "a")
+  ABORT_IF(rfcs[0].getProteinIdentifications().size() != 1)
+  TEST_EQUAL(rfcs[0].getProteinIdentifications()[0].getHits().size(), 2)
+  TEST_EQUAL(rfcs[0].getProteinIdentifications()[0].getHits()[0].getAccession(), "P1")
+  TEST_EQUAL(rfcs[0].getProteinIdentifications()[0].getHits()[1].getAccession(), "P3")
+  TEST_EQUAL(rfcs[0].getPeptideIdentifications().size(), 2)
+  TEST_EQUAL(rfcs[1].getProteinIdentifications()[0].getHits().size(), 1)
+  TEST_EQUAL(rfcs[1].getPeptideIdentifications().size(), 2)
+  TEST_REAL_SIMILAR(rfcs[1].getPeptideIdentifications()[1].getRT(), 3.0)
+}
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
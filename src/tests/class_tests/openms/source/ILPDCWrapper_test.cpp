@@ -60,7 +60,26 @@ START_SECTION((double compute(const FeatureMap fm, PairsType &pairs, Size verbos
 
   // real data test
 
-
+  // components without conflicting edges are solved without the ILP: all edges are activated
+  for (Size i = 0; i < 5; ++i)
+  {
+    Feature f;
+    f.setMZ(100.0 * (i + 1));
+    f.setRT(10.0);
+    fm.push_back(f);
+  }
+  Compomer cmp(0, 0.0, log(0.5));
+  pairs.push_back(ChargePair(0, 1, 1, 2, cmp, 0.0, false));
+  pairs.push_back(ChargePair(1, 2, 2, 3, cmp, 0.0, false)); // same charge variant of feature 1
+  pairs.push_back(ChargePair(3, 4, 1, 1, cmp, 0.0, false));
+  double score = iw.compute(fm, pairs, 1);
+  TEST_EQUAL(pairs.size(), 3)
+  TEST_REAL_SIMILAR(score, 1.5)
+  for (const ChargePair& cp : pairs)
+  {
+    TEST_EQUAL(cp.isActive(), true)
+    TEST_REAL_SIMILAR(cp.getEdgeScore(), 0.5)
+  }
 }
 END_SECTION
 
@@ -15,6 +15,7 @@
 #include <OpenMS/IONMOBILITY/IMDataConverter.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/PROCESSING/SPECTRAMERGING/SpectraMerger.h>
 
 using namespace OpenMS;
 using namespace std;
@@ -144,6 +145,78 @@ START_SECTION(static MSExperiment reshapeIMFrameToMany(MSSpectrum im_frame))
 }
 END_SECTION
 
+START_SECTION(static std::vector<IMFrameView> getIMFrameViews(const MSSpectrum& im_frame))
+{
+  TEST_EXCEPTION(Exception::MissingInformation, IMDataConverter::getIMFrameViews(spec))
+  TEST_EQUAL(IMDataConverter::getIMFrameViews(MSSpectrum()).size(), 0)
+
+  auto views = IMDataConverter::getIMFrameViews(frame);
+  TEST_EQUAL(views.size(), 9); // nine different IM-values
+  TEST_EQUAL(views[0].begin, 0);
+  TEST_EQUAL(views[0].end, 1);
+  TEST_EQUAL(views[1].begin, 1);
+  TEST_EQUAL(views[1].end, 3);
+  TEST_EQUAL(views[1].drift_time, 1.11f);
+  TEST_EQUAL(views[8].begin, 9);
+  TEST_EQUAL(views[8].end, 10);
+  TEST_EQUAL(views[8].drift_time, 7.7f);
+
+  MSSpectrum unsorted = frame;
+  std::swap(unsorted.getFloatDataArrays()[0][0], unsorted.getFloatDataArrays()[0][9]);
+  TEST_EXCEPTION(Exception::Precondition, IMDataConverter::getIMFrameViews(unsorted))
+}
+END_SECTION
+
+START_SECTION(static MSSpectrum extractIMFrameView(const MSSpectrum& im_frame, const IMFrameView& view, DriftTimeUnit im_unit))
+{
+  auto views = IMDataConverter::getIMFrameViews(frame);
+  auto exp = IMDataConverter::reshapeIMFrameToMany(frame);
+  for (Size i = 0; i < views.size(); ++i)
+  {
+    MSSpectrum s = IMDataConverter::extractIMFrameView(frame, views[i], DriftTimeUnit::MILLISECOND);
+    s.updateRanges(); // as for the reshaped experiment
+    TEST_EQUAL(s, exp[i])
+  }
+  MSSpectrum s = IMDataConverter::extractIMFrameView(frame, views[1], DriftTimeUnit::MILLISECOND);
+  TEST_EQUAL(s.size(), 2)
+  TEST_EQUAL(s[1].getIntensity(), 13.0f)
+  TEST_EQUAL(s.getFloatDataArrays().size(), 0)
+  TEST_EQUAL(s.getDriftTime(), 1.11f)
+  TEST_EQUAL(s.getRT(), 1)
+}
+END_SECTION
+
+START_SECTION(static std::vector<MSSpectrum> binIMFrame(MSSpectrum& im_frame, const Math::BinContainer& bins, const SpectraMerger& merger))
+{
+  SpectraMerger merger;
+  Param p = merger.getParameters();
+  p.setValue("mz_binning_width", 5.0);
+  p.setValue("mz_binning_width_unit", "ppm");
+  merger.setParameters(p);
+
+  MSSpectrum f = frame;
+  auto binned = IMDataConverter::binIMFrame(f, {{1.1, 3.3}, {3.3, 5.5}, {5.5, 7.7}, {8.0, 9.0}}, merger);
+  TEST_EQUAL(binned.size(), 4)
+  TEST_EQUAL(binned[0].size(), 4)
+  TEST_EQUAL(binned[1].size(), 1)
+  TEST_EQUAL(binned[2].size(), 3)
+  TEST_EQUAL(binned[3].empty(), true) // no peaks in this bin
+  TEST_EQUAL(binned[0][0].getIntensity(), 11+12)
+  TEST_REAL_SIMILAR(binned[0].getDriftTime(), 2.2)
+  TEST_TRUE(binned[0].getDriftTimeUnit() == DriftTimeUnit::MILLISECOND)
+  TEST_EQUAL(binned[0].getRT(), 1)
+
+  // overlapping bins: the spectrum at IM 4.4 goes into both
+  f = frame;
+  binned = IMDataConverter::binIMFrame(f, {{1.1, 4.5}, {4.3, 7.7}}, merger);
+  TEST_EQUAL(binned[0].size(), 5)
+  TEST_EQUAL(binned[1].size(), 4)
+  TEST_EQUAL(binned[1][0].getIntensity(), 40.0f)
+
+  TEST_EXCEPTION(Exception::MissingInformation, IMDataConverter::binIMFrame(spec, {{1.1, 4.4}}, merger))
+}
+END_SECTION
+
 START_SECTION((static std::tuple<std::vector<MSExperiment>, Math::BinContainer> splitExperimentByIonMobility(MSExperiment&& in, UInt number_of_IM_bins, double bin_extension_abs, double mz_binning_width, MZ_UNITS mz_binning_width_unit)))
 {
 	MSExperiment e_in;
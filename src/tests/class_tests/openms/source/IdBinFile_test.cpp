@@ -0,0 +1,261 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/IdBinFile.h>
+#include <OpenMS/FORMAT/IdXMLFile.h>
+///////////////////////////
+
+#include <fstream>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(IdBinFile, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+IdBinFile* ptr = nullptr;
+IdBinFile* nullPointer = nullptr;
+
+START_SECTION((IdBinFile()))
+{
+  ptr = new IdBinFile();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->isOpen(), false)
+}
+END_SECTION
+
+START_SECTION((~IdBinFile()))
+{
+  delete ptr;
+}
+END_SECTION
+
+// synthetic identifications covering all stored members
+vector<ProteinIdentification> proteins(1);
+proteins[0].setIdentifier("run_1");
+proteins[0].setSearchEngine("Comet");
+proteins[0].setSearchEngineVersion("2023");
+proteins[0].setScoreType("expect");
+proteins[0].setHigherScoreBetter(false);
+proteins[0].setSignificanceThreshold(0.05);
+{
+  ProteinIdentification::SearchParameters sp;
+  sp.db = "db.fasta";
+  sp.charges = "+2,+3";
+  sp.mass_type = ProteinIdentification::AVERAGE;
+  sp.fixed_modifications.push_back("Carbamidomethyl (C)");
+  sp.variable_modifications.push_back("Oxidation (M)");
+  sp.missed_cleavages = 2;
+  sp.fragment_mass_tolerance = 0.02;
+  sp.precursor_mass_tolerance = 10.0;
+  sp.precursor_mass_tolerance_ppm = true;
+  sp.enzyme_term_specificity = EnzymaticDigestion::SPEC_SEMI;
+  sp.setMetaValue("extra", "value");
+  proteins[0].setSearchParameters(sp);
+
+  ProteinHit ph(0.9, 1, "PROT_1", "PEPTIDER");
+  ph.setCoverage(12.5);
+  ph.setDescription("first protein");
+  proteins[0].getHits().push_back(ph);
+  ph.setAccession("PROT_2");
+  proteins[0].getHits().push_back(ph);
+
+  ProteinIdentification::ProteinGroup group;
+  group.probability = 0.8;
+  group.accessions = {"PROT_1", "PROT_2"};
+  proteins[0].getProteinGroups().push_back(group);
+  proteins[0].getIndistinguishableProteins().push_back(group);
+  proteins[0].setPrimaryMSRunPath({"file.mzML"});
+}
+
+vector<PeptideIdentification> peptides(4);
+for (Size i = 0; i < peptides.size(); ++i)
+{
+  PeptideIdentification& pi = peptides[i];
+  pi.setIdentifier("run_1");
+  pi.setScoreType("expect");
+  pi.setHigherScoreBetter(false);
+  pi.setRT(100.0 + double(i));
+  pi.setMZ(500.0 + double(i));
+  pi.setSpectrumReference(i == 3 ? "scan=1" : "scan=" + String(i));
+
+  PeptideHit hit(0.01 * double(i), 1, 2, AASequence::fromString(i % 2 == 0 ? "PEPTIDER" : "PEPM(Oxidation)TIDEK"));
+  hit.addPeptideEvidence(PeptideEvidence("PROT_1", 3, 10, 'K', 'A'));
+  hit.setMetaValue("target_decoy", "target");
+  hit.setMetaValue("COMET:xcorr", 2.5 + double(i));
+  hit.setMetaValue("num_matched", int(i));
+  hit.setMetaValue("isotopes", ListUtils::create<int>("0,1"));
+  hit.setMetaValue("masses", ListUtils::create<double>("1.5,2.5"));
+  hit.setMetaValue("proteins", ListUtils::create<String>("PROT_1,PROT_2"));
+  PeptideHit::PeakAnnotation pa;
+  pa.annotation = "y3";
+  pa.charge = 1;
+  pa.mz = 345.6;
+  pa.intensity = 100.0;
+  hit.setPeakAnnotations({pa});
+  PeptideHit::PepXMLAnalysisResult ar;
+  ar.score_type = "peptideprophet";
+  ar.higher_is_better = true;
+  ar.main_score = 0.99;
+  ar.sub_scores["fval"] = 1.5;
+  hit.addAnalysisResults(ar);
+  pi.insertHit(hit);
+}
+peptides[2].getHits().clear(); // ids without hits are kept
+peptides[2].setBaseName("base");
+
+START_SECTION((void store(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids)))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  IdBinFile().store(filename, proteins, peptides);
+  TEST_EQUAL(IdBinFile::isIdBinFile(filename), true)
+  TEST_EXCEPTION(Exception::UnableToCreateFile, IdBinFile().store("/does/not/exist/file.idbin", proteins, peptides))
+}
+END_SECTION
+
+START_SECTION((void load(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids)))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  IdBinFile().store(filename, proteins, peptides);
+
+  vector<ProteinIdentification> proteins2;
+  vector<PeptideIdentification> peptides2(1);
+  IdBinFile f;
+  f.load(filename, proteins2, peptides2);
+  TEST_EQUAL(f.isOpen(), false)
+  TEST_EQUAL(proteins2.size(), 1)
+  TEST_EQUAL(peptides2.size(), 4)
+  TEST_EQUAL(proteins2[0] == proteins[0], true)
+  TEST_EQUAL(proteins2[0].getSearchParameters() == proteins[0].getSearchParameters(), true)
+  TEST_EQUAL(proteins2[0].getSearchParameters().getMetaValue("extra"), "value")
+  TEST_EQUAL(proteins2[0].getHits()[1].getDescription(), "first protein")
+  for (Size i = 0; i < peptides.size(); ++i)
+  {
+    TEST_EQUAL(peptides2[i] == peptides[i], true)
+  }
+  TEST_EQUAL(peptides2[2].getBaseName(), "base")
+  TEST_EQUAL(peptides2[1].getHits()[0].getSequence().toString(), "PEPM(Oxidation)TIDEK")
+  TEST_EQUAL(peptides2[1].getHits()[0].getPeakAnnotations().size(), 1)
+  TEST_EQUAL(peptides2[1].getHits()[0].getAnalysisResults().size(), 1)
+  TEST_REAL_SIMILAR(peptides2[1].getHits()[0].getAnalysisResults()[0].sub_scores.at("fval"), 1.5)
+
+  // empty input
+  NEW_TMP_FILE(filename)
+  IdBinFile().store(filename, {}, {});
+  f.load(filename, proteins2, peptides2);
+  TEST_EQUAL(proteins2.size(), 0)
+  TEST_EQUAL(peptides2.size(), 0)
+
+  // no idbin file
+  TEST_EXCEPTION(Exception::ParseError, f.load(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), proteins2, peptides2))
+  TEST_EXCEPTION(Exception::FileNotFound, f.load("/does/not/exist.idbin", proteins2, peptides2))
+
+  // truncated file
+  NEW_TMP_FILE(filename)
+  IdBinFile().store(filename, proteins, peptides);
+  String truncated;
+  NEW_TMP_FILE(truncated)
+  {
+    ifstream in(filename.c_str(), ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    ofstream out(truncated.c_str(), ios::binary);
+    out.write(content.data(), content.size() / 2);
+  }
+  TEST_EXCEPTION(Exception::ParseError, f.load(truncated, proteins2, peptides2))
+}
+END_SECTION
+
+START_SECTION((static bool isIdBinFile(const String& filename)))
+{
+  TEST_EQUAL(IdBinFile::isIdBinFile(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML")), false)
+  TEST_EQUAL(IdBinFile::isIdBinFile("/does/not/exist.idbin"), false)
+}
+END_SECTION
+
+START_SECTION((void open(const String& filename)))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  IdBinFile().store(filename, proteins, peptides);
+  IdBinFile f;
+  f.open(filename);
+  TEST_EQUAL(f.isOpen(), true)
+  TEST_EQUAL(f.getNrProteinIdentifications(), 1)
+  TEST_EQUAL(f.getNrPeptideIdentifications(), 4)
+  f.close();
+  TEST_EQUAL(f.isOpen(), false)
+  TEST_EQUAL(f.getNrPeptideIdentifications(), 0)
+}
+END_SECTION
+
+START_SECTION((void getPeptideIdentification(Size index, PeptideIdentification& peptide_id)))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  IdBinFile().store(filename, proteins, peptides);
+  IdBinFile f;
+  PeptideIdentification pi;
+  TEST_EXCEPTION(Exception::IllegalArgument, f.getPeptideIdentification(0, pi))
+  f.open(filename);
+  f.getPeptideIdentification(3, pi);
+  TEST_EQUAL(pi == peptides[3], true)
+  f.getPeptideIdentification(0, pi);
+  TEST_EQUAL(pi == peptides[0], true)
+  TEST_EXCEPTION(Exception::IndexOverflow, f.getPeptideIdentification(4, pi))
+
+  vector<ProteinIdentification> proteins2;
+  f.getProteinIdentifications(proteins2);
+  TEST_EQUAL(proteins2 == proteins, true)
+}
+END_SECTION
+
+START_SECTION((std::vector<Size> findBySpectrumReference(const String& spectrum_reference)))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  IdBinFile().store(filename, proteins, peptides);
+  IdBinFile f;
+  f.open(filename);
+  vector<Size> result = f.findBySpectrumReference("scan=1");
+  TEST_EQUAL(result.size(), 2)
+  ABORT_IF(result.size() != 2)
+  TEST_EQUAL(result[0], 1)
+  TEST_EQUAL(result[1], 3)
+  result = f.findBySpectrumReference("scan=2");
+  TEST_EQUAL(result.size(), 1)
+  TEST_EQUAL(result[0], 2)
+  TEST_EQUAL(f.findBySpectrumReference("scan=5").size(), 0)
+  TEST_EQUAL(f.findBySpectrumReference("").size(), 0)
+}
+END_SECTION
+
+START_SECTION(([EXTRA] idXML round trip))
+{
+  vector<ProteinIdentification> proteins_xml, proteins_bin;
+  vector<PeptideIdentification> peptides_xml, peptides_bin;
+  IdXMLFile().load(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), proteins_xml, peptides_xml);
+  String filename;
+  NEW_TMP_FILE(filename)
+  IdBinFile().store(filename, proteins_xml, peptides_xml);
+  IdBinFile().load(filename, proteins_bin, peptides_bin);
+  TEST_EQUAL(proteins_bin == proteins_xml, true)
+  TEST_EQUAL(peptides_bin == peptides_xml, true)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -0,0 +1,166 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/FORMAT/InMemoryFileStore.h>
+#include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/KERNEL/ConsensusMap.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(InMemoryFileStore, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+PeakMap exp;
+exp.resize(2);
+exp[0].setRT(1.0);
+exp[1].setRT(2.0);
+exp[1].push_back(Peak1D(500.0, 10.0f));
+
+FeatureMap features;
+Feature f;
+f.setMZ(400.0);
+f.setIntensity(100.0f);
+features.push_back(f);
+
+ConsensusMap consensus;
+consensus.push_back(ConsensusFeature());
+consensus.push_back(ConsensusFeature());
+
+START_SECTION(static bool isInMemory(const String& filename))
+{
+  TEST_EQUAL(InMemoryFileStore::isInMemory("mem://a.mzML"), true)
+  TEST_EQUAL(InMemoryFileStore::isInMemory(InMemoryFileStore::PREFIX + "b.featureXML"), true)
+  TEST_EQUAL(InMemoryFileStore::isInMemory("a.mzML"), false)
+  TEST_EQUAL(InMemoryFileStore::isInMemory("/tmp/mem://a.mzML"), false)
+}
+END_SECTION
+
+START_SECTION(static bool store(const String& filename, const MSExperiment& exp))
+{
+  TEST_EQUAL(InMemoryFileStore::store("mem://a.mzML", exp), true)
+  TEST_EQUAL(InMemoryFileStore::store("a.mzML", exp), false)
+  TEST_EQUAL(InMemoryFileStore::contains("mem://a.mzML"), true)
+  TEST_EQUAL(InMemoryFileStore::contains("a.mzML"), false)
+}
+END_SECTION
+
+START_SECTION(static bool store(const String& filename, const FeatureMap& map))
+{
+  TEST_EQUAL(InMemoryFileStore::store("mem://b.featureXML", features), true)
+  TEST_EQUAL(InMemoryFileStore::store("b.featureXML", features), false)
+}
+END_SECTION
+
+START_SECTION(static bool store(const String& filename, const ConsensusMap& map))
+{
+  TEST_EQUAL(InMemoryFileStore::store("mem://c.consensusXML", consensus), true)
+  TEST_EQUAL(InMemoryFileStore::store("c.consensusXML", consensus), false)
+}
+END_SECTION
+
+START_SECTION(static bool load(const String& filename, MSExperiment& exp))
+{
+  PeakMap loaded;
+  TEST_EQUAL(InMemoryFileStore::load("mem://a.mzML", loaded), true)
+  TEST_EQUAL(loaded == exp, true)
+  TEST_EQUAL(InMemoryFileStore::load("a.mzML", loaded), false)
+  TEST_EXCEPTION(Exception::FileNotFound, InMemoryFileStore::load("mem://missing.mzML", loaded))
+  TEST_EXCEPTION(Exception::InvalidFileType, InMemoryFileStore::load("mem://b.featureXML", loaded))
+
+  // loads are copies
+  loaded[1][0].setIntensity(5.0f);
+  PeakMap loaded2;
+  InMemoryFileStore::load("mem://a.mzML", loaded2);
+  TEST_REAL_SIMILAR(loaded2[1][0].getIntensity(), 10.0)
+}
+END_SECTION
+
+START_SECTION(static bool load(const String& filename, FeatureMap& map))
+{
+  FeatureMap loaded;
+  TEST_EQUAL(InMemoryFileStore::load("mem://b.featureXML", loaded), true)
+  TEST_EQUAL(loaded.size(), 1)
+  TEST_REAL_SIMILAR(loaded[0].getMZ(), 400.0)
+  TEST_EXCEPTION(Exception::InvalidFileType, InMemoryFileStore::load("mem://a.mzML", loaded))
+}
+END_SECTION
+
+START_SECTION(static bool load(const String& filename, ConsensusMap& map))
+{
+  ConsensusMap loaded;
+  TEST_EQUAL(InMemoryFileStore::load("mem://c.consensusXML", loaded), true)
+  TEST_EQUAL(loaded.size(), 2)
+}
+END_SECTION
+
+START_SECTION(static std::vector<String> getFileNames())
+{
+  vector<String> names = InMemoryFileStore::getFileNames();
+  TEST_EQUAL(names.size(), 3)
+  ABORT_IF(names.size() != 3)
+  TEST_EQUAL(names[0], "mem://a.mzML")
+  TEST_EQUAL(names[2], "mem://c.consensusXML")
+}
+END_SECTION
+
+START_SECTION(static void remove(const String& filename))
+{
+  InMemoryFileStore::remove("mem://a.mzML");
+  InMemoryFileStore::remove("mem://never_stored.mzML");
+  TEST_EQUAL(InMemoryFileStore::contains("mem://a.mzML"), false)
+  TEST_EQUAL(InMemoryFileStore::getFileNames().size(), 2)
+}
+END_SECTION
+
+START_SECTION(static void clear())
+{
+  InMemoryFileStore::clear();
+  TEST_EQUAL(InMemoryFileStore::getFileNames().empty(), true)
+}
+END_SECTION
+
+START_SECTION([EXTRA] FileHandler with in-memory files)
+{
+  FileHandler fh;
+  fh.storeExperiment("mem://fh.mzML", exp, {FileTypes::MZML});
+  fh.storeFeatures("mem://fh.featureXML", features, {FileTypes::FEATUREXML});
+  fh.storeConsensusFeatures("mem://fh.consensusXML", consensus, {FileTypes::CONSENSUSXML});
+  TEST_EQUAL(InMemoryFileStore::getFileNames().size(), 3)
+
+  PeakMap loaded_exp;
+  fh.loadExperiment("mem://fh.mzML", loaded_exp, {FileTypes::MZML});
+  TEST_EQUAL(loaded_exp == exp, true)
+  FeatureMap loaded_features;
+  fh.loadFeatures("mem://fh.featureXML", loaded_features, {FileTypes::FEATUREXML});
+  TEST_EQUAL(loaded_features.size(), 1)
+  ConsensusMap loaded_consensus;
+  fh.loadConsensusFeatures("mem://fh.consensusXML", loaded_consensus, {FileTypes::CONSENSUSXML});
+  TEST_EQUAL(loaded_consensus.size(), 2)
+
+  // file types are still checked by extension
+  TEST_EXCEPTION(Exception::InvalidFileType, fh.storeFeatures("mem://fh.mzML", features, {FileTypes::FEATUREXML}))
+  TEST_EXCEPTION(Exception::ParseError, fh.loadExperiment("mem://fh.featureXML", loaded_exp, {FileTypes::MZML}))
+  InMemoryFileStore::clear();
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
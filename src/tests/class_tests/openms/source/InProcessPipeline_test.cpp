@@ -0,0 +1,152 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/APPLICATIONS/InProcessPipeline.h>
+#include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/FORMAT/InMemoryFileStore.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+
+#include <cstdlib>
+
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+// scales the feature intensities
+class TOPPScaleTest
+  : public TOPPBase
+{
+public:
+  TOPPScaleTest()
+    : TOPPBase("TOPPScaleTest", "A test class", false, {}, false)
+  {
+  }
+
+  static Size runs;
+
+protected:
+  void registerOptionsAndFlags_() override
+  {
+    registerInputFile_("in", "<file>", "", "input file");
+    setValidFormats_("in", {"featureXML"});
+    registerOutputFile_("out", "<file>", "", "output file");
+    setValidFormats_("out", {"featureXML"});
+    registerDoubleOption_("factor", "<factor>", 2.0, "scaling factor", false);
+  }
+
+  ExitCodes main_(int, const char**) override
+  {
+    ++runs;
+    FeatureMap map;
+    FileHandler().loadFeatures(getStringOption_("in"), map, {FileTypes::FEATUREXML});
+    for (Feature& f : map)
+    {
+      f.setIntensity(f.getIntensity() * getDoubleOption_("factor"));
+    }
+    FileHandler().storeFeatures(getStringOption_("out"), map, {FileTypes::FEATUREXML});
+    return EXECUTION_OK;
+  }
+};
+
+Size TOPPScaleTest::runs = 0;
+
+InProcessPipeline::ToolFactory scale_tool = []() { return std::unique_ptr<TOPPBase>(new TOPPScaleTest()); };
+
+START_TEST(InProcessPipeline, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+char* var = (char*)("OPENMS_DISABLE_UPDATE_CHECK=ON");
+#ifdef OPENMS_WINDOWSPLATFORM
+_putenv(var);
+#else
+putenv(var);
+#endif
+
+InProcessPipeline* ptr = nullptr;
+InProcessPipeline* null_ptr = nullptr;
+START_SECTION(InProcessPipeline())
+{
+  ptr = new InProcessPipeline();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->size(), 0)
+}
+END_SECTION
+
+START_SECTION(~InProcessPipeline())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(void addStep(const String& name, const ToolFactory& factory, const StringList& arguments))
+{
+  InProcessPipeline pipeline;
+  pipeline.addStep("scale", scale_tool, {"-in", "mem://in.featureXML", "-out", "mem://out.featureXML"});
+  TEST_EQUAL(pipeline.size(), 1)
+}
+END_SECTION
+
+START_SECTION(Size size() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(TOPPBase::ExitCodes run())
+{
+  FeatureMap input;
+  Feature f;
+  f.setIntensity(1.0f);
+  input.push_back(f);
+  InMemoryFileStore::store("mem://in.featureXML", input);
+
+  // intermediate and final results in memory
+  InProcessPipeline pipeline;
+  pipeline.addStep("scale1", scale_tool, {"-in", "mem://in.featureXML", "-out", "mem://step1.featureXML"});
+  pipeline.addStep("scale2", scale_tool, {"-in", "mem://step1.featureXML", "-out", "mem://step2.featureXML", "-factor", "5"});
+  TEST_EQUAL(pipeline.run(), TOPPBase::EXECUTION_OK)
+  TEST_EQUAL(TOPPScaleTest::runs, 2)
+  // all in-memory files of the pipeline are released
+  TEST_EQUAL(InMemoryFileStore::getFileNames().empty(), true)
+
+  // pipeline with a result on disk
+  InMemoryFileStore::store("mem://in.featureXML", input);
+  String out_file;
+  NEW_TMP_FILE(out_file)
+  out_file += ".featureXML";
+  InProcessPipeline pipeline2;
+  pipeline2.addStep("scale1", scale_tool, {"-in", "mem://in.featureXML", "-out", "mem://step1.featureXML"});
+  pipeline2.addStep("scale2", scale_tool, {"-in", "mem://step1.featureXML", "-out", out_file, "-factor", "5"});
+  TEST_EQUAL(pipeline2.run(), TOPPBase::EXECUTION_OK)
+  FeatureMap result;
+  FileHandler().loadFeatures(out_file, result);
+  ABORT_IF(result.size() != 1)
+  TEST_REAL_SIMILAR(result[0].getIntensity(), 10.0)
+
+  // a missing in-memory input stops the pipeline
+  TOPPScaleTest::runs = 0;
+  InProcessPipeline pipeline3;
+  pipeline3.addStep("scale1", scale_tool, {"-in", "mem://missing.featureXML", "-out", "mem://step1.featureXML"});
+  pipeline3.addStep("scale2", scale_tool, {"-in", "mem://step1.featureXML", "-out", "mem://step2.featureXML"});
+  TEST_EQUAL(pipeline3.run(), TOPPBase::INPUT_FILE_NOT_FOUND)
+  TEST_EQUAL(TOPPScaleTest::runs, 0)
+  TEST_EQUAL(InMemoryFileStore::getFileNames().empty(), true)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
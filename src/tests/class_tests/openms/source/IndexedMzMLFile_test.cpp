@@ -14,6 +14,8 @@
 ///////////////////////////
 
 #include <OpenMS/FORMAT/FileTypes.h>
+#include <OpenMS/FORMAT/OffsetIndexFile.h>
+#include <OpenMS/SYSTEM/File.h>
 
 // for comparison
 #include <OpenMS/KERNEL/MSExperiment.h>
@@ -107,6 +109,46 @@ START_SECTION(( void openFile(String filename) ))
 }
 END_SECTION
 
+START_SECTION(( void setOffsetIndexFallback(bool fallback) ))
+{
+  // copy of a file without index (the offset index is cached next to it)
+  String tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  File::copy(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), tmp_filename);
+
+  PeakMap exp;
+  MzMLFile().load(tmp_filename, exp);
+
+  IndexedMzMLHandler file;
+  file.setOffsetIndexFallback(true);
+  file.openFile(tmp_filename);
+  TEST_EQUAL(file.getParsingSuccess(), true)
+  TEST_EQUAL(file.getNrSpectra(), exp.getSpectra().size())
+  TEST_EQUAL(file.getNrChromatograms(), exp.getChromatograms().size())
+  for (Size i = 0; i < file.getNrSpectra(); ++i)
+  {
+    MSSpectrum spec = file.getMSSpectrumById(int(i));
+    TEST_EQUAL(spec.size(), exp.getSpectra()[i].size())
+    TEST_EQUAL(spec.getNativeID(), exp.getSpectra()[i].getNativeID())
+  }
+  TEST_EQUAL(File::exists(OffsetIndexFile::getSidecarName(tmp_filename)), true)
+
+  // second time, the cached index is used
+  IndexedMzMLHandler cached;
+  cached.setOffsetIndexFallback(true);
+  cached.openFile(tmp_filename);
+  TEST_EQUAL(cached.getParsingSuccess(), true)
+  TEST_EQUAL(cached.getNrSpectra(), exp.getSpectra().size())
+  File::remove(OffsetIndexFile::getSidecarName(tmp_filename));
+
+  // indexed files are not affected
+  IndexedMzMLHandler indexed;
+  indexed.setOffsetIndexFallback(true);
+  indexed.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+  TEST_EQUAL(indexed.getParsingSuccess(), true)
+}
+END_SECTION
+
 START_SECTION(( size_t getNrSpectra() const ))
 {
   IndexedMzMLHandler file(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
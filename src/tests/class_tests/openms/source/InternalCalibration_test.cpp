@@ -105,6 +105,39 @@ START_SECTION(bool calibrate(PeakMap& exp, const IntList& target_mslvl, MZTrafoM
   TEST_EQUAL(success, true)
 END_SECTION
 
+START_SECTION((const std::map<String, MZTrafoModel>& getSpectrumModels() const))
+  InternalCalibration ic;
+  TEST_EQUAL(ic.getSpectrumModels().empty(), true)
+  ic.fillCalibrants(peps, 3.0);
+  PeakMap exp;
+  MzMLFile().load(File::find("./examples/BSA/BSA1.mzML"), exp);
+  exp.sortSpectra(true);
+  PeakMap exp_calibrated = exp;
+  MZTrafoModel::setRANSACSeed(0);
+  MZTrafoModel::setRANSACParams(Math::RANSACParam(2, 1000, 1.0, 30, true));
+  IntList ms_level(1, 1);
+  TEST_EQUAL(ic.calibrate(exp_calibrated, ms_level, MZTrafoModel::LINEAR, -1, true, 1.0, 1.0), true)
+
+  // MS1 spectra (data) and MS2 spectra (precursors) are calibrated
+  Size n_calibrated(0);
+  for (const MSSpectrum& s : exp)
+  {
+    if (s.getMSLevel() <= 2) ++n_calibrated;
+  }
+  TEST_EQUAL(ic.getSpectrumModels().size(), n_calibrated)
+
+  // applying the recorded models gives the calibrated data
+  for (Size i = 0; i < exp.size(); ++i)
+  {
+    auto it = ic.getSpectrumModels().find(exp[i].getNativeID());
+    ABORT_IF(it == ic.getSpectrumModels().end())
+    InternalCalibration::applyTransformation(exp[i], ms_level, it->second);
+  }
+  ABORT_IF(exp[0].empty())
+  TEST_REAL_SIMILAR(exp[0][0].getMZ(), exp_calibrated[0][0].getMZ())
+  TEST_REAL_SIMILAR(exp[0].back().getMZ(), exp_calibrated[0].back().getMZ())
+END_SECTION
+
 PeakMap::SpectrumType spec;
 spec.push_back(Peak1D(250.0, 1000.0));
 spec.push_back(Peak1D(500.0, 1000.0));
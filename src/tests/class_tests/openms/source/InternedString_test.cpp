@@ -0,0 +1,181 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/DATASTRUCTURES/InternedString.h>
+///////////////////////////
+
+#include <OpenMS/METADATA/PeptideEvidence.h>
+#include <OpenMS/METADATA/ProteinHit.h>
+
+#include <sstream>
+#include <unordered_set>
+#include <vector>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(InternedString, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+InternedString* ptr = nullptr;
+InternedString* nullPointer = nullptr;
+START_SECTION(InternedString())
+{
+  ptr = new InternedString();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_EQUAL(ptr->str(), "")
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(InternedString(const String& s))
+{
+  InternedString a(String("InternedString_test_P1"));
+  InternedString b(String("InternedString_test_P1"));
+  InternedString c(String("InternedString_test_P2"));
+  TEST_EQUAL(a.str(), "InternedString_test_P1")
+  TEST_EQUAL(&a.str() == &b.str(), true) // one copy in the pool
+  TEST_EQUAL(&a.str() == &c.str(), false)
+  // the empty string is not pooled
+  TEST_EQUAL(InternedString(String("")) == InternedString(), true)
+}
+END_SECTION
+
+START_SECTION(InternedString(const char* s))
+{
+  InternedString a("InternedString_test_P1");
+  TEST_EQUAL(a == InternedString(String("InternedString_test_P1")), true)
+}
+END_SECTION
+
+START_SECTION(InternedString& operator=(const String& s))
+{
+  InternedString a;
+  a = String("InternedString_test_P3");
+  TEST_EQUAL(a.str(), "InternedString_test_P3")
+  a = String();
+  TEST_EQUAL(a.empty(), true)
+}
+END_SECTION
+
+START_SECTION(const String& str() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(operator const String&() const)
+{
+  InternedString a("InternedString_test_P1");
+  const String& s = a;
+  TEST_EQUAL(s, "InternedString_test_P1")
+  TEST_EQUAL(&s == &a.str(), true)
+}
+END_SECTION
+
+START_SECTION(bool empty() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(bool operator==(const InternedString& rhs) const)
+{
+  InternedString a("InternedString_test_P1"), b("InternedString_test_P1"), c("InternedString_test_P2");
+  TEST_EQUAL(a == b, true)
+  TEST_EQUAL(a == c, false)
+}
+END_SECTION
+
+START_SECTION(bool operator!=(const InternedString& rhs) const)
+{
+  InternedString a("InternedString_test_P1"), b("InternedString_test_P1"), c("InternedString_test_P2");
+  TEST_EQUAL(a != b, false)
+  TEST_EQUAL(a != c, true)
+}
+END_SECTION
+
+START_SECTION(bool operator<(const InternedString& rhs) const)
+{
+  InternedString a("InternedString_test_P1"), b("InternedString_test_P2"), empty;
+  TEST_EQUAL(a < b, true)
+  TEST_EQUAL(b < a, false)
+  TEST_EQUAL(a < a, false)
+  TEST_EQUAL(empty < a, true)
+}
+END_SECTION
+
+START_SECTION(static Size poolSize())
+{
+  Size before = InternedString::poolSize();
+  InternedString a("InternedString_test_P4");
+  TEST_EQUAL(InternedString::poolSize(), before + 1)
+  InternedString b("InternedString_test_P4");
+  TEST_EQUAL(InternedString::poolSize(), before + 1)
+  InternedString c("");
+  TEST_EQUAL(InternedString::poolSize(), before + 1)
+
+  // concurrent interning of the same values
+  vector<InternedString> values(1000);
+#pragma omp parallel for
+  for (SignedSize i = 0; i < SignedSize(values.size()); ++i)
+  {
+    values[i] = String("InternedString_test_Q") + String(i % 10);
+  }
+  TEST_EQUAL(InternedString::poolSize(), before + 11)
+  bool all_equal = true;
+  for (Size i = 10; i < values.size(); ++i)
+  {
+    all_equal &= (values[i] == values[i % 10]) && (values[i].str() == String("InternedString_test_Q") + String(i % 10));
+  }
+  TEST_EQUAL(all_equal, true)
+}
+END_SECTION
+
+START_SECTION(std::ostream& operator<<(std::ostream& os, const InternedString& s))
+{
+  stringstream ss;
+  ss << InternedString("InternedString_test_P1");
+  TEST_EQUAL(ss.str(), "InternedString_test_P1")
+}
+END_SECTION
+
+START_SECTION(std::hash<InternedString>)
+{
+  unordered_set<InternedString> set;
+  set.insert(InternedString("InternedString_test_P1"));
+  set.insert(InternedString("InternedString_test_P1"));
+  set.insert(InternedString("InternedString_test_P2"));
+  TEST_EQUAL(set.size(), 2)
+}
+END_SECTION
+
+START_SECTION([EXTRA] shared accessions)
+{
+  // accessions of peptide evidences and protein hits share one copy
+  PeptideEvidence pe("InternedString_test_P1", 1, 5, 'K', 'A');
+  ProteinHit hit(1.0, 1, " InternedString_test_P1 ", "PEPTIDE");
+  TEST_EQUAL(hit.getAccession(), "InternedString_test_P1")
+  TEST_EQUAL(&pe.getProteinAccession() == &hit.getAccession(), true)
+  hit.setAccession("InternedString_test_P2\t");
+  TEST_EQUAL(hit.getAccession(), "InternedString_test_P2")
+  PeptideEvidence copy(pe);
+  TEST_EQUAL(&copy.getProteinAccession() == &pe.getProteinAccession(), true)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
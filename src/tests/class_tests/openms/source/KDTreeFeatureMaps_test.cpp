@@ -62,6 +62,17 @@ START_SECTION((KDTreeFeatureMaps(const std::vector<MapType>& maps, const Param&
   delete ptr;
 END_SECTION
 
+START_SECTION((KDTreeFeatureMaps(Size num_maps, const Param& param)))
+  KDTreeFeatureMaps kd_data(3, p);
+  TEST_EQUAL(kd_data.numMaps(), 3)
+  TEST_EQUAL(kd_data.size(), 0)
+  kd_data.addFeature(2, &(fmaps[0][1]));
+  kd_data.optimizeTree();
+  TEST_EQUAL(kd_data.size(), 1)
+  TEST_EQUAL(kd_data.mapIndex(0), 2)
+  TEST_EQUAL(kd_data.feature(0), &(fmaps[0][1]))
+END_SECTION
+
 KDTreeFeatureMaps kd_data_1(fmaps, p);
 
 START_SECTION((KDTreeFeatureMaps(const KDTreeFeatureMaps& rhs)))
@@ -150,11 +161,56 @@ START_SECTION((void getNeighborhood(Size index, std::vector<Size>& result_indice
 END_SECTION
 
 START_SECTION((void queryRegion(double rt_low, double rt_high, double mz_low, double mz_high, std::vector<Size>& result_indices, Size ignored_map_index = std::numeric_limits<Size>::max()) const))
-  NOT_TESTABLE;
+  vector<Size> result(1, 5);
+  kd_data_1.queryRegion(900, 2100, 399, 501, result);
+  TEST_EQUAL(result.size(), 2)
+  kd_data_1.queryRegion(900, 1100, 399, 501, result);
+  TEST_EQUAL(result.size(), 1)
+  TEST_EQUAL(result[0], 0)
+  kd_data_1.queryRegion(900, 2100, 399, 501, result, 0);
+  TEST_EQUAL(result.size(), 0)
+
+  // features added after optimizeTree() are found as well
+  KDTreeFeatureMaps kd_data(2, p);
+  kd_data.addFeature(0, &(fmaps[0][0]));
+  kd_data.optimizeTree();
+  kd_data.addFeature(1, &(fmaps[0][1]));
+  kd_data.queryRegion(900, 2100, 399, 501, result, 0);
+  TEST_EQUAL(result.size(), 1)
+  TEST_EQUAL(result[0], 1)
+END_SECTION
+
+START_SECTION((void queryRegions(const std::vector<Region>& regions, std::vector<std::vector<Size> >& result_indices, Size ignored_map_index = std::numeric_limits<Size>::max()) const))
+  vector<KDTreeFeatureMaps::Region> regions;
+  regions.push_back({{900, 399}, {2100, 501}});
+  regions.push_back({{1900, 399}, {2100, 501}});
+  regions.push_back({{900, 450}, {2100, 460}});
+  vector<vector<Size> > results;
+  kd_data_1.queryRegions(regions, results);
+  TEST_EQUAL(results.size(), 3)
+  TEST_EQUAL(results[0].size(), 2)
+  TEST_EQUAL(results[1].size(), 1)
+  TEST_EQUAL(results[1][0], 1)
+  TEST_EQUAL(results[2].size(), 0)
+  kd_data_1.queryRegions(regions, results, 0);
+  TEST_EQUAL(results[0].size(), 0)
 END_SECTION
 
 START_SECTION((void applyTransformations(const std::vector<TransformationModelLowess*>& trafos)))
-  NOT_TESTABLE;
+  // shift all RTs by 500 s
+  TransformationModel::DataPoints data;
+  for (double rt = 0.0; rt < 3000.0; rt += 100.0) data.push_back(TransformationModel::DataPoint(rt, rt + 500.0));
+  Param lowess_param;
+  lowess_param.setValue("span", 0.5);
+  TransformationModelLowess trafo(data, lowess_param);
+  KDTreeFeatureMaps kd_data(fmaps, p);
+  kd_data.applyTransformations(vector<TransformationModelLowess*>(1, &trafo));
+  TEST_REAL_SIMILAR(kd_data.rt(0), 1500)
+  vector<Size> result;
+  kd_data.queryRegion(1400, 1600, 399, 401, result);
+  TEST_EQUAL(result.size(), 1)
+  kd_data.queryRegion(900, 1100, 399, 401, result);
+  TEST_EQUAL(result.size(), 0)
 END_SECTION
 
 delete ptr;
@@ -499,6 +499,82 @@ START_SECTION(( template < typename PeakTypeIterator, typename ConstPeakTypeIter
 }
 END_SECTION
 
+START_SECTION((template <typename ValueT> void raster_uniform(const double* mz_raw_it, const double* mz_raw_end, const double* int_raw_it, double start_pos, double spacing, ValueT* int_resample_it, ValueT* int_resample_end) const))
+{
+  std::vector<double> mz, intensity;
+  for (const Peak1D& p : input_spectrum)
+  {
+    mz.push_back(p.getMZ());
+    intensity.push_back(p.getIntensity());
+  }
+  std::vector<double> resampled(4, 0.0);
+
+  LinearResamplerAlign lr;
+  lr.raster_uniform(mz.data(), mz.data() + mz.size(), intensity.data(), 0.0, 0.75, resampled.data(), resampled.data() + resampled.size());
+
+  TEST_REAL_SIMILAR(resampled[0], 3+2);
+  TEST_REAL_SIMILAR(resampled[1], 4+2.0/3*8);
+  TEST_REAL_SIMILAR(resampled[2], 1.0/3*8+2+1.0/3);
+  TEST_REAL_SIMILAR(resampled[3], 2.0 / 3);
+
+  // points outside of the raster are added to the first / last point
+  std::vector<double> short_raster(2, 0.0);
+  lr.raster_uniform(mz.data(), mz.data() + mz.size(), intensity.data(), 0.5, 0.75, short_raster.data(), short_raster.data() + short_raster.size());
+  TEST_REAL_SIMILAR(short_raster[0], 3+6+8*0.25/0.75);
+  TEST_REAL_SIMILAR(short_raster[1], 8*0.5/0.75+2+1);
+}
+END_SECTION
+
+START_SECTION((Size raster_size(double start_pos, double end_pos) const))
+{
+  LinearResamplerAlign lr;
+  Param param;
+  param.setValue("spacing",0.75);
+  lr.setParameters(param);
+  TEST_EQUAL(lr.raster_size(0, 1.8), 4)
+  TEST_EQUAL(lr.raster_size(-0.25, 1.8), 4)
+  TEST_EQUAL(lr.raster_size(2.25, 1.8), 0)
+}
+END_SECTION
+
+START_SECTION((template <typename SpecT, typename ValueT> void raster_align(const std::vector<SpecT>& containers, double start_pos, double end_pos, ValueT* output) const))
+{
+  LinearResamplerAlign lr;
+  Param param;
+  param.setValue("spacing",0.75);
+  lr.setParameters(param);
+
+  // same result as the single spectrum version
+  std::vector<float> matrix(lr.raster_size(0, 1.8), 0.0f);
+  lr.raster_align(std::vector<MSSpectrum>(1, input_spectrum), 0, 1.8, matrix.data());
+  TEST_REAL_SIMILAR(matrix[0], 3+2);
+  TEST_REAL_SIMILAR(matrix[1], 4+2.0/3*8);
+  TEST_REAL_SIMILAR(matrix[2], 1.0/3*8+2+1.0/3);
+  TEST_REAL_SIMILAR(matrix[3], 2.0 / 3);
+
+  MSSpectrum shifted = input_spectrum;
+  for (Peak1D& p : shifted) p.setMZ(p.getMZ() + 0.3);
+  std::vector<MSSpectrum> spectra = {input_spectrum, MSSpectrum(), shifted};
+
+  for (double start_pos : {0.0, -0.25, 0.5})
+  {
+    const Size size = lr.raster_size(start_pos, 1.8);
+    matrix.assign(spectra.size() * size, 0.0f);
+    lr.raster_align(spectra, start_pos, 1.8, matrix.data());
+
+    for (Size r = 0; r < spectra.size(); ++r)
+    {
+      MSSpectrum spec = spectra[r];
+      lr.raster_align(spec, start_pos, 1.8);
+      for (Size i = 0; i < size; ++i)
+      {
+        TEST_REAL_SIMILAR(matrix[r * size + i], spec.empty() ? 0.0 : spec[i].getIntensity())
+      }
+    }
+  }
+}
+END_SECTION
+
 // it should accept nonsense input values
 START_SECTION([EXTRA] test_linear_res_align_input)
 {
@@ -21,6 +21,8 @@
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
 
 #include <fstream>
+#include <iomanip>
+#include <set>
 #include <boost/regex.hpp>
 
 // OpenMP support
@@ -497,6 +499,56 @@ START_SECTION(([EXTRA] Test caching of empty lines))
 }
 END_SECTION
 
+START_SECTION(([EXTRA] Macro test - statements of inactive streams and of multiple threads))
+{
+  OpenMS_Log_info.removeAllStreams();
+  OpenMS_Log_info.rdbuf()->clearCache();
+  TEST_EQUAL(OpenMS_Log_info.isActive(), false)
+
+  // nothing attached: the arguments are not evaluated
+  int evaluated = 0;
+  auto count = [&evaluated]() { return ++evaluated; };
+  OPENMS_LOG_INFO << "evaluated " << count() << endl;
+  TEST_EQUAL(evaluated, 0)
+
+  ostringstream stream_by_logger;
+  OpenMS_Log_info.insert(stream_by_logger);
+  TEST_EQUAL(OpenMS_Log_info.isActive(), true)
+  OPENMS_LOG_INFO << "evaluated " << count() << endl;
+  TEST_EQUAL(evaluated, 1)
+
+  // format flags only apply to their statement
+  OPENMS_LOG_INFO << "fixed " << std::fixed << std::setprecision(2) << 1.0 << endl;
+  OPENMS_LOG_INFO << "default " << 1.5 << endl;
+
+  // statements of different threads are not mixed
+#pragma omp parallel for
+  for (int i = 0; i < 1000; ++i)
+  {
+    OPENMS_LOG_INFO << "line " << i << " of " << 1000 << endl;
+  }
+  OpenMS_Log_info.remove(stream_by_logger);
+  TEST_EQUAL(OpenMS_Log_info.isActive(), false)
+
+  StringList lines = ListUtils::create<String>(String(stream_by_logger.str()), '\n');
+  TEST_EQUAL(lines.size(), 1004) // there is an extra line since we ended with endl
+  TEST_EQUAL(lines[0], "evaluated 1")
+  TEST_EQUAL(lines[1], "fixed 1.00")
+  TEST_EQUAL(lines[2], "default 1.5")
+  boost::regex rx(R"(^line (\d+) of 1000$)");
+  std::set<String> thread_lines;
+  bool all_complete = true;
+  for (Size i = 3; i < lines.size() - 1; ++i)
+  {
+    all_complete &= regex_search(lines[i], rx);
+    thread_lines.insert(lines[i]);
+  }
+  TEST_EQUAL(all_complete, true)
+  TEST_EQUAL(thread_lines.size(), 1000)
+  OpenMS_Log_info.insert(cout);
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -539,6 +539,59 @@ END_SECTION*/
         }
     END_SECTION
 
+    BOOST_AUTO_TEST_CASE(setStoreXCorrArrays)
+        {
+          MockMRMFeature * imrmfeature = new MockMRMFeature();
+          MRMScoring full, compact;
+          TEST_EQUAL(compact.getStoreXCorrArrays(), true)
+          compact.setStoreXCorrArrays(false);
+          TEST_EQUAL(compact.getStoreXCorrArrays(), false)
+
+          std::vector<std::string> precursor_ids;
+          std::vector<std::string> native_ids;
+          fill_mock_objects2(imrmfeature, precursor_ids, native_ids);
+          std::vector<double> weights {0.5, 0.5};
+
+          // score twice with the same object: the buffers of the first pass are reused
+          for (int pass = 0; pass < 2; ++pass)
+          {
+            full.initializeXCorrMatrix(imrmfeature, native_ids);
+            compact.initializeXCorrMatrix(imrmfeature, native_ids);
+            TEST_EQUAL(full.getXCorrMatrix().rows(), 2)
+            TEST_EQUAL(compact.getXCorrMatrix().rows(), 0)
+            TEST_EQUAL(compact.calcXcorrCoelutionScore(), full.calcXcorrCoelutionScore())
+            TEST_EQUAL(compact.calcXcorrCoelutionWeightedScore(weights), full.calcXcorrCoelutionWeightedScore(weights))
+            TEST_EQUAL(compact.calcXcorrShapeScore(), full.calcXcorrShapeScore())
+            TEST_EQUAL(compact.calcXcorrShapeWeightedScore(weights), full.calcXcorrShapeWeightedScore(weights))
+
+            full.initializeXCorrContrastMatrix(imrmfeature, native_ids, native_ids);
+            compact.initializeXCorrContrastMatrix(imrmfeature, native_ids, native_ids);
+            TEST_EQUAL(compact.getXCorrContrastMatrix().rows(), 0)
+            TEST_EQUAL(compact.calcSeparateXcorrContrastCoelutionScore() == full.calcSeparateXcorrContrastCoelutionScore(), true)
+            TEST_EQUAL(compact.calcSeparateXcorrContrastShapeScore() == full.calcSeparateXcorrContrastShapeScore(), true)
+
+            full.initializeXCorrPrecursorMatrix(imrmfeature, precursor_ids);
+            compact.initializeXCorrPrecursorMatrix(imrmfeature, precursor_ids);
+            TEST_EQUAL(compact.calcXcorrPrecursorCoelutionScore(), full.calcXcorrPrecursorCoelutionScore())
+            TEST_EQUAL(compact.calcXcorrPrecursorShapeScore(), full.calcXcorrPrecursorShapeScore())
+
+            full.initializeXCorrPrecursorContrastMatrix(imrmfeature, precursor_ids, native_ids);
+            compact.initializeXCorrPrecursorContrastMatrix(imrmfeature, precursor_ids, native_ids);
+            TEST_EQUAL(compact.getXCorrPrecursorContrastMatrix().rows(), 0)
+            TEST_EQUAL(compact.calcXcorrPrecursorContrastCoelutionScore(), full.calcXcorrPrecursorContrastCoelutionScore())
+            TEST_EQUAL(compact.calcXcorrPrecursorContrastShapeScore(), full.calcXcorrPrecursorContrastShapeScore())
+
+            full.initializeXCorrPrecursorCombinedMatrix(imrmfeature, precursor_ids, native_ids);
+            compact.initializeXCorrPrecursorCombinedMatrix(imrmfeature, precursor_ids, native_ids);
+            TEST_EQUAL(compact.getXCorrPrecursorCombinedMatrix().rows(), 0)
+            TEST_EQUAL(compact.calcXcorrPrecursorCombinedCoelutionScore(), full.calcXcorrPrecursorCombinedCoelutionScore())
+            TEST_EQUAL(compact.calcXcorrPrecursorCombinedShapeScore(), full.calcXcorrPrecursorCombinedShapeScore())
+          }
+          TEST_REAL_SIMILAR(compact.calcXcorrPrecursorCombinedShapeScore(), 0.5079334)
+          delete imrmfeature;
+        }
+    END_SECTION
+
 //START_SECTION((virtual void test_calcLibraryScore()))
     BOOST_AUTO_TEST_CASE(test_Library_score)
         {
@@ -0,0 +1,148 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataBlockMergingConsumer.h>
+
+///////////////////////////
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataStoringConsumer.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+START_TEST(MSDataBlockMergingConsumer, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+using namespace OpenMS;
+
+// MS1 spectra every fourth scan, MS2 spectra in between
+PeakMap exp;
+for (Size i = 0; i < 23; ++i)
+{
+  MSSpectrum s;
+  s.setRT(i * 1.0);
+  s.setNativeID(String("scan=") + String(100 + i));
+  s.setMSLevel(i % 4 == 0 ? 1 : 2);
+  if (s.getMSLevel() == 2)
+  {
+    Precursor pc;
+    pc.setMZ(500.0 + i);
+    s.setPrecursors({pc});
+  }
+  for (Size k = 0; k < 5; ++k)
+  {
+    s.push_back(Peak1D(100.0 + 10.0 * k + (i % 3) * 1e-5, 10.0 * (i + 1)));
+  }
+  exp.addSpectrum(s);
+}
+
+MSDataBlockMergingConsumer* ptr = nullptr;
+MSDataBlockMergingConsumer* null_ptr = nullptr;
+
+START_SECTION((MSDataBlockMergingConsumer(Interfaces::IMSDataConsumer* next_consumer, const SpectraMerger& merger)))
+  MSDataStoringConsumer storage;
+  SpectraMerger merger;
+  ptr = new MSDataBlockMergingConsumer(&storage, merger);
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  delete ptr;
+END_SECTION
+
+START_SECTION((~MSDataBlockMergingConsumer()))
+  MSDataStoringConsumer storage;
+  {
+    SpectraMerger merger;
+    MSDataBlockMergingConsumer consumer(&storage, merger);
+    MSSpectrum s = exp[0];
+    consumer.consumeSpectrum(s);
+    TEST_EQUAL(storage.getData().size(), 0)
+  }
+  // the last block is flushed
+  TEST_EQUAL(storage.getData().size(), 1)
+END_SECTION
+
+START_SECTION((void consumeSpectrum(SpectrumType& s)))
+  for (const String ms_levels : {"1", "2", "1 2"})
+  {
+    SpectraMerger merger;
+    Param p = merger.getParameters();
+    p.setValue("block_method:ms_levels", ListUtils::create<Int>(ms_levels, ' '));
+    p.setValue("block_method:rt_block_size", 3);
+    p.setValue("block_method:rt_max_length", 9.5);
+    merger.setParameters(p);
+
+    PeakMap expected = exp;
+    merger.mergeSpectraBlockWise(expected);
+
+    MSDataStoringConsumer storage;
+    MSDataBlockMergingConsumer consumer(&storage, merger);
+    for (MSSpectrum s : exp)
+    {
+      consumer.consumeSpectrum(s);
+    }
+    consumer.flush();
+
+    // same spectra, but not sorted by RT
+    PeakMap result = storage.getData();
+    result.sortSpectra();
+    TEST_EQUAL(result.size(), expected.size())
+    ABORT_IF(result.size() != expected.size())
+    for (Size i = 0; i < result.size(); ++i)
+    {
+      TEST_EQUAL(result[i].getNativeID(), expected[i].getNativeID())
+      TEST_EQUAL(result[i].getMSLevel(), expected[i].getMSLevel())
+      TEST_REAL_SIMILAR(result[i].getRT(), expected[i].getRT())
+      TEST_EQUAL(result[i].getPrecursors().size(), expected[i].getPrecursors().size())
+      TEST_EQUAL(result[i] == expected[i], true)
+    }
+  }
+END_SECTION
+
+START_SECTION((void consumeChromatogram(ChromatogramType& c)))
+  MSDataStoringConsumer storage;
+  SpectraMerger merger;
+  MSDataBlockMergingConsumer consumer(&storage, merger);
+  MSChromatogram c;
+  c.setNativeID("chrom");
+  consumer.consumeChromatogram(c);
+  TEST_EQUAL(storage.getData().getChromatograms().size(), 1)
+  TEST_EQUAL(storage.getData().getChromatograms()[0].getNativeID(), "chrom")
+END_SECTION
+
+START_SECTION((void flush()))
+  SpectraMerger merger;
+  Param p = merger.getParameters();
+  p.setValue("block_method:ms_levels", ListUtils::create<Int>("2"));
+  p.setValue("block_method:rt_block_size", 10);
+  merger.setParameters(p);
+
+  MSDataStoringConsumer storage;
+  MSDataBlockMergingConsumer consumer(&storage, merger);
+  for (Size i = 1; i < 4; ++i)
+  {
+    MSSpectrum s = exp[i];
+    consumer.consumeSpectrum(s);
+  }
+  TEST_EQUAL(storage.getData().size(), 0)
+  consumer.flush();
+  TEST_EQUAL(storage.getData().size(), 1)
+  TEST_EQUAL(storage.getData()[0].getNativeID(), "scan=101,scan=102,scan=103")
+  TEST_REAL_SIMILAR(storage.getData()[0].getRT(), 2.0)
+  TEST_REAL_SIMILAR(storage.getData()[0].getPrecursors()[0].getMZ(), 502.0)
+  // nothing left
+  consumer.flush();
+  TEST_EQUAL(storage.getData().size(), 1)
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -0,0 +1,111 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataIMBinningConsumer.h>
+
+///////////////////////////
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataStoringConsumer.h>
+#include <OpenMS/IONMOBILITY/IMDataConverter.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+START_TEST(MSDataIMBinningConsumer, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+using namespace OpenMS;
+
+// three IM frames with the same IM values
+PeakMap exp;
+for (Size i = 0; i < 3; ++i)
+{
+  MSSpectrum frame;
+  frame.setRT(i * 1.0);
+  frame.setNativeID(String("frame=") + String(i));
+  MSSpectrum::FloatDataArray& fda = frame.getFloatDataArrays().emplace_back();
+  for (Size k = 0; k < 20; ++k)
+  {
+    frame.push_back(Peak1D(100.0 + 10.0 * (k % 7) + i * 1e-5, 10.0 * (k + 1)));
+    fda.push_back(1.0f + 0.05f * ((k * 3) % 20));
+  }
+  IMDataConverter::setIMUnit(fda, DriftTimeUnit::VSSC);
+  exp.addSpectrum(frame);
+}
+exp.setComment("IM frames");
+
+const Math::BinContainer bins = Math::createBins(1.0, 1.95, 3, 0.05);
+
+MSDataIMBinningConsumer* ptr = nullptr;
+MSDataIMBinningConsumer* null_ptr = nullptr;
+
+START_SECTION((MSDataIMBinningConsumer(const std::vector<Interfaces::IMSDataConsumer*>& bin_consumers, const Math::BinContainer& bins, double mz_binning_width, MZ_UNITS mz_binning_width_unit)))
+  MSDataStoringConsumer s1, s2, s3;
+  ptr = new MSDataIMBinningConsumer({&s1, &s2, &s3}, bins, 5.0, MZ_UNITS::PPM);
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  delete ptr;
+  TEST_EXCEPTION(Exception::InvalidValue, MSDataIMBinningConsumer({&s1, &s2}, bins, 5.0, MZ_UNITS::PPM))
+END_SECTION
+
+START_SECTION((void consumeSpectrum(SpectrumType& s)))
+  // same as binning the whole experiment
+  auto [expected, expected_bins] = IMDataConverter::splitExperimentByIonMobility(PeakMap(exp), 3, 0.05, 5.0, MZ_UNITS::PPM);
+
+  MSDataStoringConsumer s1, s2, s3;
+  MSDataIMBinningConsumer consumer({&s1, &s2, &s3}, expected_bins, 5.0, MZ_UNITS::PPM);
+  consumer.setExperimentalSettings(exp);
+  for (const MSSpectrum& frame : exp)
+  {
+    MSSpectrum s = frame;
+    consumer.consumeSpectrum(s);
+  }
+
+  MSDataStoringConsumer* storages[] = {&s1, &s2, &s3};
+  for (Size b = 0; b < 3; ++b)
+  {
+    PeakMap result = storages[b]->getData();
+    result.updateRanges(); // as for the split experiment
+    TEST_EQUAL(result.size(), 3)
+    TEST_EQUAL(result.size(), expected[b].size())
+    for (Size i = 0; i < result.size() && i < expected[b].size(); ++i)
+    {
+      TEST_EQUAL(result[i] == expected[b][i], true)
+    }
+    TEST_EQUAL(result.getComment(), "IM frames")
+  }
+
+  // not an IM frame
+  MSSpectrum no_im;
+  no_im.push_back(Peak1D(100.0, 1.0));
+  TEST_EXCEPTION(Exception::InvalidValue, consumer.consumeSpectrum(no_im))
+END_SECTION
+
+START_SECTION((void consumeChromatogram(ChromatogramType&)))
+  MSDataStoringConsumer s1, s2, s3;
+  MSDataIMBinningConsumer consumer({&s1, &s2, &s3}, bins, 5.0, MZ_UNITS::PPM);
+  MSChromatogram c;
+  consumer.consumeChromatogram(c);
+  TEST_EQUAL(s1.getData().getNrChromatograms(), 0)
+END_SECTION
+
+START_SECTION((void setExperimentalSettings(const OpenMS::ExperimentalSettings& exp)))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION((void setExpectedSize(Size, Size)))
+  NOT_TESTABLE // does nothing
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -619,7 +619,41 @@ END_SECTION
 
 START_SECTION((void updateRanges(Int ms_level)))
 {
-  NOT_TESTABLE // tested above
+  // enough spectra and chromatograms to be distributed over several threads
+  PeakMap exp;
+  for (Size i = 0; i < 1000; ++i)
+  {
+    MSSpectrum spec;
+    spec.setRT(double(i));
+    spec.setMSLevel(i % 4 == 0 ? 1 : 2);
+    spec.push_back(Peak1D(100.0 + i, 1.0f + float(i % 7)));
+    spec.push_back(Peak1D(200.0 + i, 2.0f));
+    exp.addSpectrum(spec);
+  }
+  for (Size i = 0; i < 100; ++i)
+  {
+    MSChromatogram chrom;
+    chrom.push_back(ChromatogramPeak(-1.0 - i, 50.0));
+    exp.addChromatogram(chrom);
+  }
+  exp.updateRanges();
+  TEST_EQUAL(exp.getSize(), 2100)
+  TEST_EQUAL(exp.getMSLevels().size(), 2)
+  TEST_REAL_SIMILAR(exp.getMinRT(), -100.0)
+  TEST_REAL_SIMILAR(exp.getMaxRT(), 999.0)
+  TEST_REAL_SIMILAR(exp.getMinMZ(), 0.0) // chromatograms without m/z
+  TEST_REAL_SIMILAR(exp.getMaxMZ(), 1199.0)
+  TEST_REAL_SIMILAR(exp.getMinIntensity(), 1.0)
+  TEST_REAL_SIMILAR(exp.getMaxIntensity(), 50.0)
+  TEST_REAL_SIMILAR(exp[999].getMinMZ(), 1099.0)
+  TEST_REAL_SIMILAR(exp.getChromatograms()[99].getMinRT(), -100.0)
+
+  exp.getChromatograms().clear();
+  exp.updateRanges(1);
+  TEST_EQUAL(exp.getSize(), 500)
+  TEST_EQUAL(exp.getMSLevels().size(), 1)
+  TEST_REAL_SIMILAR(exp.getMaxMZ(), 1196.0)
+  TEST_REAL_SIMILAR(exp.getMaxIntensity(), 7.0)
 }
 END_SECTION
 
@@ -1228,6 +1262,28 @@ START_SECTION((bool clearMetaDataArrays()))
 }
 END_SECTION
 
+START_SECTION((void placeMemory(TaskScheduler::MemoryPlacement placement)))
+{
+  PeakMap exp;
+  exp.resize(20);
+  for (Size i = 0; i < exp.size(); ++i)
+  {
+    exp[i].setRT(double(i));
+    exp[i].resize(100 * (i + 1), Peak1D(100.0 + i, 1.0f));
+    exp[i].getFloatDataArrays().resize(1);
+  }
+  exp.addChromatogram(MSChromatogram());
+  exp.getChromatograms()[0].resize(10);
+  const PeakMap original = exp;
+  exp.placeMemory(TaskScheduler::MemoryPlacement::FIRST_TOUCH);
+  TEST_EQUAL(exp == original, true)
+  exp.placeMemory(TaskScheduler::MemoryPlacement::INTERLEAVE);
+  TEST_EQUAL(exp == original, true)
+  TEST_EQUAL(exp[19].size(), 2000)
+  TEST_EQUAL(exp.getChromatograms()[0].size(), 10)
+}
+END_SECTION
+
 START_SECTION((void swap(MSExperiment &from)))
 {
   PeakMap exp1, exp2;
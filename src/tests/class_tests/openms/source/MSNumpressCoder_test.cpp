@@ -373,6 +373,45 @@ START_SECTION([EXTRA] test_large_SLOF)
 }
 END_SECTION
 
+START_SECTION([EXTRA] test_varying_int_sizes)
+{
+  // differences of all magnitudes (and signs) need 1 to 9 half bytes each,
+  // covering all code paths of the integer decoder
+  std::vector<double> in_pic, in_linear;
+  double mz = 100.0;
+  for (Size i = 0; i < 2000; ++i)
+  {
+    double magnitude = std::pow(16.0, double(i % 8));
+    in_pic.push_back(std::floor(magnitude * ((i * 7919) % 13) / 13.0));
+    mz += (i % 2 == 0 ? 1.0 : 1e-4) * ((i * 104729) % 17);
+    in_linear.push_back(mz);
+  }
+
+  MSNumpressCoder::NumpressConfig config;
+  String encoded;
+  std::vector<double> result;
+
+  config.np_compression = MSNumpressCoder::PIC;
+  MSNumpressCoder().encodeNPRaw(in_pic, encoded, config);
+  MSNumpressCoder().decodeNPRaw(encoded, result, config);
+  TEST_EQUAL(result.size(), in_pic.size())
+  TEST_EQUAL(result == in_pic, true)
+
+  config.np_compression = MSNumpressCoder::LINEAR;
+  config.estimate_fixed_point = true;
+  encoded.clear();
+  MSNumpressCoder().encodeNPRaw(in_linear, encoded, config);
+  MSNumpressCoder().decodeNPRaw(encoded, result, config);
+  TEST_EQUAL(result.size(), in_linear.size())
+  ABORT_IF(result.size() != in_linear.size())
+  TOLERANCE_ABSOLUTE(1e-5)
+  for (Size i = 0; i < result.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(result[i], in_linear[i])
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
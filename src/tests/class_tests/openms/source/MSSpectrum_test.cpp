@@ -16,6 +16,7 @@
 
 #include <OpenMS/IONMOBILITY/IMDataConverter.h>
 
+#include <limits>
 #include <sstream>
 
 using namespace OpenMS;
@@ -342,6 +343,19 @@ START_SECTION((virtual void updateRanges()))
   TEST_REAL_SIMILAR(s.getMaxMZ(), 2)
   TEST_REAL_SIMILAR(s.getMinMZ(), 2)
   TEST_TRUE(s.RangeMobility::isEmpty())
+
+  // NaN values are ignored, empty spectra have empty ranges
+  s.push_back(Peak1D(std::numeric_limits<double>::quiet_NaN(), 5.0f));
+  s.push_back(Peak1D(7.0, std::numeric_limits<float>::quiet_NaN()));
+  s.updateRanges();
+  TEST_REAL_SIMILAR(s.getMinMZ(), 2)
+  TEST_REAL_SIMILAR(s.getMaxMZ(), 7)
+  TEST_REAL_SIMILAR(s.getMinIntensity(), 1)
+  TEST_REAL_SIMILAR(s.getMaxIntensity(), 5)
+  s.clear(true);
+  s.updateRanges();
+  TEST_TRUE(s.RangeMZ::isEmpty())
+  TEST_TRUE(s.RangeIntensity::isEmpty())
 }
 END_SECTION
 
@@ -110,6 +110,42 @@ START_SECTION((template <typename DataType> void setReference(DataType& data)))
 END_SECTION
 
 
+START_SECTION(([EXTRA] align many maps))
+{
+  // the maps are processed in parallel, the results need to be in the order of the maps and sequences:
+  const vector<String> sequences = {"PEPTIDE", "ELVISLIVES", "AAAK", "DFPIANGER", "LLLLK"};
+  vector<vector<PeptideIdentification>> maps(20);
+  for (Size i = 0; i < maps.size(); ++i)
+  {
+    for (Size j = 0; j < sequences.size(); ++j)
+    {
+      if ((i + j) % 7 == 0) continue; // not every peptide in every map
+      PeptideIdentification id;
+      id.setRT(100.0 * (j + 1) + i);
+      id.insertHit(PeptideHit(1.0, 1, 2, AASequence::fromString(sequences[j])));
+      maps[i].push_back(id);
+    }
+  }
+  MapAlignmentAlgorithmIdentification many_aligner;
+  vector<TransformationDescription> transforms;
+  many_aligner.align(maps, transforms);
+  TEST_EQUAL(transforms.size(), maps.size());
+  for (Size i = 0; i < maps.size(); ++i)
+  {
+    const TransformationDescription::DataPoints& points = transforms[i].getDataPoints();
+    TEST_EQUAL(points.size(), maps[i].size());
+    for (Size k = 0; k < points.size(); ++k)
+    {
+      if (k > 0) TEST_EQUAL(points[k - 1].note < points[k].note, true);
+      Size j = find(sequences.begin(), sequences.end(), points[k].note) - sequences.begin();
+      TEST_REAL_SIMILAR(points[k].first, 100.0 * (j + 1) + i);
+    }
+  }
+  // same reference RT for all occurrences of a peptide:
+  TEST_REAL_SIMILAR(transforms[1].getDataPoints()[0].second, transforms[2].getDataPoints()[0].second);
+}
+END_SECTION
+
 // can't test protected methods...
 
 // START_SECTION((void computeMedians_(SeqToList&, SeqToValue&, bool)))
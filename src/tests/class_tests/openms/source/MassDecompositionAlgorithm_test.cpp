@@ -59,6 +59,65 @@ START_SECTION((void getDecompositions(std::vector<MassDecomposition>& decomps, d
 }
 END_SECTION
 
+START_SECTION((void getDecompositions(std::vector<std::vector<MassDecomposition> >& decomps, const std::vector<double>& weights) const))
+{
+  MassDecompositionAlgorithm mda;
+  Param p(mda.getParameters());
+  p.setValue("tolerance", 0.001);
+  mda.setParameters(p);
+
+  vector<double> weights;
+  for (const String& seq : {"DFPIANGER", "PEPTIDE", "GG", "SAMPLER", "DFPIANGER"})
+  {
+    weights.push_back(AASequence::fromString(seq).getMonoWeight(Residue::Internal));
+  }
+  vector<vector<MassDecomposition> > batch;
+  mda.getDecompositions(batch, weights);
+  TEST_EQUAL(batch.size(), weights.size())
+  TEST_EQUAL(batch[0].size(), 911)
+  for (Size i = 0; i < weights.size(); ++i)
+  {
+    vector<MassDecomposition> single;
+    mda.getDecompositions(single, weights[i]);
+    TEST_EQUAL(batch[i].size(), single.size())
+    bool identical = true;
+    for (Size j = 0; j < single.size() && identical; ++j)
+    {
+      identical = (batch[i][j].toString() == single[j].toString());
+    }
+    TEST_EQUAL(identical, true)
+  }
+}
+END_SECTION
+
+START_SECTION((Size getNumberOfDecompositions(double weight) const))
+{
+  MassDecompositionAlgorithm mda;
+  Param p(mda.getParameters());
+  p.setValue("tolerance", 0.0001);
+  mda.setParameters(p);
+  double mass = AASequence::fromString("DFPIANGER").getMonoWeight(Residue::Internal);
+  TEST_EQUAL(mda.getNumberOfDecompositions(mass), 842)
+}
+END_SECTION
+
+START_SECTION((std::vector<Size> getNumberOfDecompositions(const std::vector<double>& weights) const))
+{
+  MassDecompositionAlgorithm mda;
+  Param p(mda.getParameters());
+  p.setValue("tolerance", 0.001);
+  mda.setParameters(p);
+  vector<double> weights = {AASequence::fromString("DFPIANGER").getMonoWeight(Residue::Internal),
+                            AASequence::fromString("PEPTIDE").getMonoWeight(Residue::Internal)};
+  vector<Size> counts = mda.getNumberOfDecompositions(weights);
+  TEST_EQUAL(counts.size(), 2)
+  TEST_EQUAL(counts[0], 911)
+  vector<MassDecomposition> decomps;
+  mda.getDecompositions(decomps, weights[1]);
+  TEST_EQUAL(counts[1], decomps.size())
+}
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
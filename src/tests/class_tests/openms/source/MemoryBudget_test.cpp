@@ -0,0 +1,71 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/SYSTEM/MemoryBudget.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(MemoryBudget, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+START_SECTION(static void setLimit(UInt64 bytes))
+{
+  TEST_EQUAL(MemoryBudget::hasLimit(), false)
+  MemoryBudget::setLimit(1024);
+  TEST_EQUAL(MemoryBudget::getLimit(), 1024)
+  TEST_EQUAL(MemoryBudget::hasLimit(), true)
+  MemoryBudget::setLimit(0);
+  TEST_EQUAL(MemoryBudget::hasLimit(), false)
+}
+END_SECTION
+
+START_SECTION(static UInt64 getLimit())
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(static bool hasLimit())
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(static UInt64 getUsage())
+{
+  NOT_TESTABLE // platform dependent; 0 if unknown
+}
+END_SECTION
+
+START_SECTION(static bool isExceeded(UInt64 additional_bytes = 0))
+{
+  // no limit
+  TEST_EQUAL(MemoryBudget::isExceeded(), false)
+  TEST_EQUAL(MemoryBudget::isExceeded(UInt64(1) << 62), false)
+
+  const bool usage_known = MemoryBudget::getUsage() != 0;
+  MemoryBudget::setLimit(1);
+  TEST_EQUAL(MemoryBudget::isExceeded(), usage_known)
+  MemoryBudget::setLimit(UInt64(1) << 62);
+  TEST_EQUAL(MemoryBudget::isExceeded(), false)
+  TEST_EQUAL(MemoryBudget::isExceeded(UInt64(1) << 62), usage_known)
+  MemoryBudget::setLimit(0);
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -0,0 +1,216 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/METADATA/MetaValueColumns.h>
+#include <OpenMS/METADATA/PeptideHit.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(MetaValueColumns, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+MetaValueColumns* ptr = nullptr;
+MetaValueColumns* nullPointer = nullptr;
+
+START_SECTION((MetaValueColumns()))
+{
+  ptr = new MetaValueColumns();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->size(), 0)
+}
+END_SECTION
+
+START_SECTION((~MetaValueColumns()))
+{
+  delete ptr;
+}
+END_SECTION
+
+vector<PeptideHit> hits(3);
+for (Size i = 0; i < hits.size(); ++i)
+{
+  hits[i].setScore(double(i));
+  hits[i].setMetaValue("MVC_score", 0.5 * double(i));
+  hits[i].setMetaValue("MVC_charge", int(i + 1));
+  hits[i].setMetaValue("MVC_td", i == 1 ? "decoy" : "target");
+}
+hits[0].setMetaValue("MVC_mixed", 1.5);
+hits[2].setMetaValue("MVC_mixed", "text");
+hits[1].setMetaValue("MVC_list", ListUtils::create<double>("1.0,2.0"));
+
+START_SECTION((explicit MetaValueColumns(Size rows)))
+{
+  MetaValueColumns c(5);
+  TEST_EQUAL(c.size(), 5)
+  TEST_EQUAL(c.metaValueExists(4, "MVC_score"), false)
+  TEST_EQUAL(c.getMetaValue(4, "MVC_score", 2.0), DataValue(2.0))
+}
+END_SECTION
+
+START_SECTION((template <typename Container> void compact(Container& objects)))
+{
+  vector<PeptideHit> h = hits;
+  MetaValueColumns c;
+  c.compact(h);
+  TEST_EQUAL(c.size(), 3)
+  TEST_EQUAL(h[0].isMetaEmpty(), true)
+  TEST_EQUAL(h[2].isMetaEmpty(), true)
+  TEST_REAL_SIMILAR(h[2].getScore(), 2.0) // only the meta values are moved
+
+  TEST_EQUAL(c.getColumnType("MVC_score") == MetaValueColumns::ColumnType::DOUBLE, true)
+  TEST_EQUAL(c.getColumnType("MVC_charge") == MetaValueColumns::ColumnType::INT, true)
+  TEST_EQUAL(c.getColumnType("MVC_td") == MetaValueColumns::ColumnType::STRING, true)
+  TEST_EQUAL(c.getColumnType("MVC_mixed") == MetaValueColumns::ColumnType::GENERIC, true)
+  TEST_EQUAL(c.getColumnType("MVC_list") == MetaValueColumns::ColumnType::GENERIC, true)
+
+  TEST_EQUAL(c.getMetaValue(2, "MVC_score"), DataValue(1.0))
+  TEST_EQUAL(c.getMetaValue(1, "MVC_charge"), DataValue(2))
+  TEST_EQUAL(c.getMetaValue(1, "MVC_td"), DataValue("decoy"))
+  TEST_EQUAL(c.getMetaValue(2, "MVC_td"), DataValue("target"))
+  TEST_EQUAL(c.getMetaValue(0, "MVC_mixed"), DataValue(1.5))
+  TEST_EQUAL(c.getMetaValue(2, "MVC_mixed"), DataValue("text"))
+  TEST_EQUAL(c.metaValueExists(1, "MVC_mixed"), false)
+  TEST_EQUAL(c.getMetaValue(1, "MVC_list").toDoubleList().size(), 2)
+  TEST_EXCEPTION(Exception::IndexOverflow, c.getMetaValue(3, "MVC_score"))
+}
+END_SECTION
+
+START_SECTION((template <typename Container> void expand(Container& objects) const))
+{
+  vector<PeptideHit> h = hits;
+  MetaValueColumns c;
+  c.compact(h);
+  c.expand(h);
+  TEST_EQUAL(h == hits, true)
+
+  vector<PeptideHit> too_short(2);
+  TEST_EXCEPTION(Exception::InvalidSize, c.expand(too_short))
+}
+END_SECTION
+
+START_SECTION((void setMetaValue(Size row, const String& name, const DataValue& value)))
+{
+  MetaValueColumns c(2);
+  c.setMetaValue(0, "MVC_score", 1.0);
+  c.setMetaValue(1, "MVC_score", 2.0);
+  TEST_EQUAL(c.getColumnType("MVC_score") == MetaValueColumns::ColumnType::DOUBLE, true)
+  // a value of a different type turns the column into a generic one
+  c.setMetaValue(1, "MVC_score", "high");
+  TEST_EQUAL(c.getColumnType("MVC_score") == MetaValueColumns::ColumnType::GENERIC, true)
+  TEST_EQUAL(c.getMetaValue(0, "MVC_score"), DataValue(1.0))
+  TEST_EQUAL(c.getMetaValue(1, "MVC_score"), DataValue("high"))
+
+  // values with unit are kept
+  DataValue with_unit(3.0);
+  with_unit.setUnitType(DataValue::UnitType::UNIT_ONTOLOGY);
+  with_unit.setUnit(10);
+  c.setMetaValue(0, "MVC_unit", with_unit);
+  TEST_EQUAL(c.getMetaValue(0, "MVC_unit").getUnit(), 10)
+
+  // setting an empty value removes it
+  c.setMetaValue(0, "MVC_score", DataValue());
+  TEST_EQUAL(c.metaValueExists(0, "MVC_score"), false)
+  TEST_EXCEPTION(Exception::IndexOverflow, c.setMetaValue(2, "MVC_score", 1.0))
+}
+END_SECTION
+
+START_SECTION((void removeMetaValue(Size row, const String& name)))
+{
+  MetaValueColumns c(2);
+  c.setMetaValue(0, "MVC_td", "target");
+  c.setMetaValue(1, "MVC_td", "decoy");
+  c.removeMetaValue(0, "MVC_td");
+  c.removeMetaValue(0, "MVC_does_not_exist");
+  TEST_EQUAL(c.metaValueExists(0, "MVC_td"), false)
+  TEST_EQUAL(c.metaValueExists(1, "MVC_td"), true)
+}
+END_SECTION
+
+START_SECTION((void getKeys(Size row, std::vector<String>& keys) const))
+{
+  vector<PeptideHit> h = hits;
+  MetaValueColumns c;
+  c.compact(h);
+  vector<String> keys;
+  c.getKeys(1, keys);
+  std::sort(keys.begin(), keys.end());
+  TEST_EQUAL(ListUtils::concatenate(keys, ","), "MVC_charge,MVC_list,MVC_score,MVC_td")
+  c.getKeys(5, keys);
+  TEST_EQUAL(keys.size(), 0)
+}
+END_SECTION
+
+START_SECTION((std::vector<String> getColumnNames() const))
+{
+  vector<PeptideHit> h = hits;
+  MetaValueColumns c;
+  c.compact(h);
+  TEST_EQUAL(c.getColumnNames().size(), 5)
+  TEST_EQUAL(c.hasColumn("MVC_td"), true)
+  TEST_EQUAL(c.hasColumn("MVC_does_not_exist"), false)
+  TEST_EXCEPTION(Exception::ElementNotFound, c.getColumnType("MVC_does_not_exist"))
+}
+END_SECTION
+
+START_SECTION((void getDoubleColumn(const String& name, std::vector<double>& values, double missing = 0.0) const))
+{
+  vector<PeptideHit> h = hits;
+  MetaValueColumns c;
+  c.compact(h);
+  vector<double> values;
+  c.getDoubleColumn("MVC_score", values);
+  TEST_EQUAL(values.size(), 3)
+  TEST_REAL_SIMILAR(values[2], 1.0)
+  c.getDoubleColumn("MVC_charge", values);
+  TEST_REAL_SIMILAR(values[2], 3.0)
+  // row 2 holds a string
+  TEST_EXCEPTION(Exception::ConversionError, c.getDoubleColumn("MVC_mixed", values, -1.0))
+}
+END_SECTION
+
+START_SECTION((bool operator==(const MetaValueColumns& rhs) const))
+{
+  vector<PeptideHit> h = hits;
+  MetaValueColumns c1, c2;
+  c1.compact(h);
+  h = hits;
+  c2.compact(h);
+  TEST_EQUAL(c1 == c2, true)
+  c2.setMetaValue(0, "MVC_td", "decoy");
+  TEST_EQUAL(c1 == c2, false)
+  TEST_EQUAL(c1 != c2, true)
+}
+END_SECTION
+
+START_SECTION((void resize(Size rows)))
+{
+  vector<PeptideHit> h = hits;
+  MetaValueColumns c;
+  c.compact(h);
+  c.resize(4);
+  TEST_EQUAL(c.size(), 4)
+  TEST_EQUAL(c.metaValueExists(3, "MVC_score"), false)
+  c.setMetaValue(3, "MVC_td", "decoy");
+  TEST_EQUAL(c.getMetaValue(3, "MVC_td"), DataValue("decoy"))
+  c.clear();
+  TEST_EQUAL(c.size(), 0)
+  TEST_EQUAL(c.getColumnNames().size(), 0)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
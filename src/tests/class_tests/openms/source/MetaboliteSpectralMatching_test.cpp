@@ -43,7 +43,44 @@ END_SECTION
 
 START_SECTION((double computeHyperScore(MSSpectrum, MSSpectrum, const double &, const double &)))
 {
-  // TODO
+  MSSpectrum exp_spec, db_spec;
+  for (Size i = 1; i <= 4; ++i)
+  {
+    exp_spec.push_back(Peak1D(100.0 * i, 10.0 * i));
+  }
+  // two DB peaks match the first exp. peak (the more intense one counts), the last one matches nothing:
+  db_spec.push_back(Peak1D(99.99, 2.0));
+  db_spec.push_back(Peak1D(100.01, 1.0));
+  db_spec.push_back(Peak1D(200.01, 1.0));
+  db_spec.push_back(Peak1D(300.01, 1.0));
+  db_spec.push_back(Peak1D(400.4, 1.0));
+  db_spec.getStringDataArrays().resize(1);
+  db_spec.getIntegerDataArrays().resize(1);
+  for (Size i = 0; i < db_spec.size(); ++i)
+  {
+    db_spec.getStringDataArrays()[0].push_back("ion" + String(i));
+    db_spec.getIntegerDataArrays()[0].push_back(1);
+  }
+
+  // log(10 * 2 + 20 + 30) + log(3!)
+  TEST_REAL_SIMILAR(MetaboliteSpectralMatching::computeHyperScore(0.05, false, exp_spec, db_spec), log(420.0))
+  std::vector<PeptideHit::PeakAnnotation> annotations;
+  double score = MetaboliteSpectralMatching::computeHyperScore(0.05, false, exp_spec, db_spec, annotations);
+  TEST_REAL_SIMILAR(score, log(420.0))
+  TEST_EQUAL(annotations.size(), 4)
+  ABORT_IF(annotations.size() != 4)
+  TEST_EQUAL(annotations[0].annotation, "ion0")
+  TEST_REAL_SIMILAR(annotations[0].mz, 100.0)
+  TEST_EQUAL(annotations[1].annotation, "ion1")
+  TEST_REAL_SIMILAR(annotations[1].mz, 100.0)
+  TEST_EQUAL(annotations[3].annotation, "ion3")
+  TEST_REAL_SIMILAR(annotations[3].mz, 300.0)
+
+  // lower m/z bound excludes the first DB peaks -> too few matches
+  TEST_REAL_SIMILAR(MetaboliteSpectralMatching::computeHyperScore(0.05, false, exp_spec, db_spec, 150.0), 0.0)
+  // ppm tolerance: 100 ppm at m/z 100 is 0.01
+  TEST_REAL_SIMILAR(MetaboliteSpectralMatching::computeHyperScore(200.0, true, exp_spec, db_spec), log(420.0))
+  TEST_REAL_SIMILAR(MetaboliteSpectralMatching::computeHyperScore(0.05, false, MSSpectrum(), db_spec), 0.0)
 }
 END_SECTION
 
@@ -253,6 +253,43 @@ START_SECTION((static void applyVariableModifications(const ModifiedPeptideGener
 }
 END_SECTION
 
+START_SECTION((static void enumerateVariableModifications(const std::vector<ModificationSite>& sites, double mono_weight, Size max_variable_mods_per_peptide, const VariantCallback& callback, bool keep_original=true)))
+{
+  // the same variants (and masses) as applyVariableModifications
+  vector<String> mods = {"Oxidation (M)", "Phospho (S)", "Phospho (T)", "Carbamyl (T)", "Carbamyl (N-term)"};
+  ModifiedPeptideGenerator::MapToResidueType variable_mods = ModifiedPeptideGenerator::getModifications(mods);
+  const AASequence seq = AASequence::fromString("MSTPEPTMDE");
+  // (for max_mods = 1 applyVariableModifications skips modifications that are only specific to a terminus)
+  for (Size max_mods : {0, 2, 3})
+  {
+    for (bool keep_original : {true, false})
+    {
+      vector<AASequence> expected_peptides;
+      ModifiedPeptideGenerator::applyVariableModifications(variable_mods, seq, max_mods, expected_peptides, keep_original);
+      std::set<String> expected;
+      for (const auto& p : expected_peptides) { expected.insert(p.toString()); }
+
+      vector<ModifiedPeptideGenerator::ModificationSite> sites;
+      ModifiedPeptideGenerator::getVariableModificationSites(variable_mods, seq, sites);
+      std::set<String> enumerated;
+      Size nr_variants(0);
+      bool masses_match(true);
+      ModifiedPeptideGenerator::enumerateVariableModifications(sites, seq.getMonoWeight(), max_mods,
+        [&](double mono_weight, const vector<Size>& chosen_sites)
+        {
+          ++nr_variants;
+          AASequence variant = ModifiedPeptideGenerator::applyVariableModificationSites(variable_mods, seq, sites, chosen_sites);
+          enumerated.insert(variant.toString());
+          masses_match &= std::fabs(variant.getMonoWeight() - mono_weight) < 1e-6;
+        }, keep_original);
+      TEST_EQUAL(nr_variants, expected_peptides.size())
+      TEST_EQUAL(enumerated == expected, true)
+      TEST_EQUAL(masses_match, true)
+    }
+  }
+}
+END_SECTION
+
 START_SECTION([EXTRA] multithreaded example)
 {
 // only do this in release, since MP errors are unlikely to occur in Debug mode anyway and it takes 5min to run the test in Debug
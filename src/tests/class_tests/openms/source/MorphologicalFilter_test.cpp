@@ -256,7 +256,7 @@ START_SECTION((template < typename InputIterator, typename OutputIterator > void
     std::vector<Peak1D::IntensityType> simple_filtered_1;
     MorphologicalFilter mf;
 
-    for ( Int struc_length = 3; struc_length <= 2 * data_size + 2; struc_length += 2 )
+    for ( Int struc_length = 1; struc_length <= 2 * data_size + 2; struc_length += 2 )
     {
       //STATUS("data_size: " << data_size);
       //STATUS("struc_elem_length: " << struc_length);
@@ -334,7 +334,7 @@ START_SECTION((template < typename InputIterator, typename OutputIterator > void
     std::vector<Peak1D::IntensityType> simple_filtered_1;
     MorphologicalFilter mf;
 
-    for ( Int struc_length = 3; struc_length <= 2 * data_size + 2; struc_length += 2 )
+    for ( Int struc_length = 1; struc_length <= 2 * data_size + 2; struc_length += 2 )
     {
       //STATUS("data_size: " << data_size);
       //STATUS("struc_elem_length: " << struc_length);
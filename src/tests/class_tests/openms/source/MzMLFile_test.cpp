@@ -1096,6 +1096,68 @@ START_SECTION((void storeBuffer(std::string & output, const PeakMap& map) const)
 }
 END_SECTION
 
+START_SECTION([EXTRA] storeBuffer with parallel writing)
+{
+  // parallel writing has to give exactly the same output (including the index) as sequential writing
+  MzMLFile file;
+  PeakMap exp_original;
+  file.load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), exp_original);
+
+  for (bool compression : {false, true})
+  {
+    file.getOptions().setCompression(compression);
+    file.getOptions().setMaxDataPoolSize(1); // one spectrum per pool
+
+    std::string sequential;
+    file.getOptions().setParallelWriting(false);
+    file.storeBuffer(sequential, exp_original);
+
+    std::string parallel;
+    file.getOptions().setParallelWriting(true);
+    file.storeBuffer(parallel, exp_original);
+    TEST_EQUAL(parallel.size(), sequential.size())
+    TEST_EQUAL(parallel == sequential, true)
+
+    file.getOptions().setMaxDataPoolSize(100); // all spectra in one pool
+    file.storeBuffer(parallel, exp_original);
+    TEST_EQUAL(parallel == sequential, true)
+  }
+}
+END_SECTION
+
+START_SECTION([EXTRA] load with skimming of binary data)
+{
+  // skimming gives the same meta data as loading without data (for files with and without index)
+  for (const String& in : {String(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML")), String(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"))})
+  {
+    MzMLFile file;
+    PeakMap meta, skimmed;
+    file.getOptions().setFillData(false);
+    file.load(in, meta);
+    file.getOptions().setFillData(true);
+    file.getOptions().setSkimBinaryData(true);
+    file.load(in, skimmed);
+
+    ABORT_IF(skimmed.size() != meta.size())
+    TEST_EQUAL(skimmed.getChromatograms().size(), meta.getChromatograms().size())
+    for (Size i = 0; i < meta.size(); ++i)
+    {
+      TEST_EQUAL(skimmed[i].getNativeID(), meta[i].getNativeID())
+      TEST_REAL_SIMILAR(skimmed[i].getRT(), meta[i].getRT())
+      TEST_EQUAL(skimmed[i].getMSLevel(), meta[i].getMSLevel())
+      TEST_EQUAL(skimmed[i].getPrecursors() == meta[i].getPrecursors(), true)
+      TEST_EQUAL(skimmed[i].size(), 0)
+    }
+    for (Size i = 0; i < meta.getChromatograms().size(); ++i)
+    {
+      TEST_EQUAL(skimmed.getChromatograms()[i].getNativeID(), meta.getChromatograms()[i].getNativeID())
+      TEST_EQUAL(skimmed.getChromatograms()[i].size(), 0)
+    }
+    TEST_EQUAL(skimmed.getInstrument() == meta.getInstrument(), true)
+  }
+}
+END_SECTION
+
 START_SECTION(bool isValid(const String& filename, std::ostream& os = std::cerr))
 {
   std::string tmp_filename;
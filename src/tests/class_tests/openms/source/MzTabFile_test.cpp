@@ -96,6 +96,50 @@ START_SECTION(void store(const String& filename, MzTab& mzTab) )
 }
 END_SECTION
 
+START_SECTION((void store(const String& filename, const std::vector<ProteinIdentification>& protein_identifications, const std::vector<PeptideIdentification>& peptide_identifications, bool first_run_inference_only, bool export_empty_pep_ids = false, bool export_all_psms = false, const String& title = "ID export from OpenMS")))
+{
+  vector<ProteinIdentification> prot_ids(1);
+  prot_ids[0].setIdentifier("run1");
+  prot_ids[0].setSearchEngine("XTandem");
+  prot_ids[0].setScoreType("score");
+  prot_ids[0].setPrimaryMSRunPath({"run1.mzML"});
+  vector<PeptideIdentification> pep_ids;
+  for (Size i = 0; i < 25; ++i)
+  {
+    ProteinHit prot_hit;
+    prot_hit.setAccession("P" + String(i));
+    prot_hit.setScore(i);
+    prot_ids[0].insertHit(prot_hit);
+
+    PeptideIdentification pep_id;
+    pep_id.setIdentifier("run1");
+    pep_id.setScoreType("score");
+    pep_id.setRT(10.0 * i);
+    pep_id.setMZ(400.0 + i);
+    pep_id.setMetaValue("spectrum_reference", "scan=" + String(i));
+    PeptideHit pep_hit;
+    pep_hit.setSequence(AASequence::fromString("PEPTIDER"));
+    pep_hit.setScore(i);
+    pep_hit.setCharge(2);
+    PeptideEvidence evidence;
+    evidence.setProteinAccession("P" + String(i));
+    pep_hit.addPeptideEvidence(evidence);
+    pep_id.insertHit(pep_hit);
+    pep_ids.push_back(pep_id);
+  }
+
+  // streamed (rows formatted in batches) vs. export via the MzTab data structure
+  String streamed, stored;
+  NEW_TMP_FILE(streamed)
+  NEW_TMP_FILE(stored)
+  MzTabFile().store(streamed, prot_ids, pep_ids, false);
+  MzTabFile().store(stored, MzTab::exportIdentificationsToMzTab(prot_ids, pep_ids, streamed, false));
+  TEST_FILE_EQUAL(streamed.c_str(), stored.c_str())
+
+  TEST_EXCEPTION(Exception::UnableToCreateFile, MzTabFile().store("this_directory_does_not_exist/out.mzTab", prot_ids, pep_ids, false))
+}
+END_SECTION
+
 START_SECTION(~MzTabFile())
 {
   delete ptr;
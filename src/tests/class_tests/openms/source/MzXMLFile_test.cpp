@@ -13,6 +13,7 @@
 
 #include <OpenMS/FORMAT/MzXMLFile.h>
 #include <OpenMS/FORMAT/FileTypes.h>
+#include <OpenMS/FORMAT/OffsetIndexFile.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/KERNEL/StandardTypes.h>
 
@@ -566,6 +567,44 @@ START_SECTION(([EXTRA] load/store for nested scans))
 }
 END_SECTION
 
+START_SECTION((void loadSpectrum(const String& filename, const OffsetIndexFile& index, Size index_pos, MSSpectrum& spectrum)))
+{
+  std::string tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  MzXMLFile f;
+  PeakMap e;
+  f.load(OPENMS_GET_TEST_DATA_PATH("MzXMLFile_1.mzXML"), e);
+  // MS1 - MS2 - MS1 (the MS2 scan is nested in the first MS1 scan)
+  e.resize(3);
+  e[0].setMSLevel(1);
+  e[1].setMSLevel(2);
+  e[2].setMSLevel(1);
+  f.store(tmp_filename, e);
+
+  OffsetIndexFile index;
+  index.scan(tmp_filename);
+  TEST_EQUAL(index.getSpectra().size(), 3)
+  for (Size i = 0; i < index.getSpectra().size(); ++i)
+  {
+    MSSpectrum spec;
+    f.loadSpectrum(tmp_filename, index, i, spec);
+    TEST_EQUAL(spec.getNativeID(), e[i].getNativeID())
+    TEST_EQUAL(spec.getMSLevel(), e[i].getMSLevel())
+    TEST_REAL_SIMILAR(spec.getRT(), e[i].getRT())
+    ABORT_IF(spec.size() != e[i].size())
+    for (Size p = 0; p < spec.size(); ++p)
+    {
+      TEST_REAL_SIMILAR(spec[p].getMZ(), e[i][p].getMZ())
+      TEST_REAL_SIMILAR(spec[p].getIntensity(), e[i][p].getIntensity())
+    }
+  }
+
+  MSSpectrum spec;
+  TEST_EXCEPTION(Exception::IndexOverflow, f.loadSpectrum(tmp_filename, index, 3, spec))
+  TEST_EXCEPTION(Exception::IllegalArgument, f.loadSpectrum(tmp_filename, OffsetIndexFile(), 0, spec))
+}
+END_SECTION
+
 START_SECTION((template<typename MapType> void store(const String& filename, const MapType& map) const ))
 {
   std::string tmp_filename;
@@ -38,6 +38,34 @@ START_SECTION(double align(const String& seq1, const String& seq2))
 }
 END_SECTION
 
+START_SECTION(std::vector<int> align(const String& seq1, const std::vector<String>& seqs2))
+{
+  NeedlemanWunsch alignment = NeedlemanWunsch(NeedlemanWunsch::ScoringMatrix::PAM30MS, 5);
+  // more than one batch, different lengths, an empty sequence, an invalid residue ('U') and a long sequence:
+  String long_seq;
+  for (Size i = 0; i < 200; ++i) long_seq += seq2;
+  std::vector<String> seqs = {seq2, seq1, "", "PEPTIDE", "IGGATLIGQLAIQQAHVHLK", "A", "PEPUTIDE", long_seq,
+                              "HVHL", seq1 + seq2, "IGGA", "LAIQQ"};
+  std::vector<int> scores = alignment.align(seq1, seqs);
+  TEST_EQUAL(scores.size(), seqs.size())
+  TEST_EQUAL(scores[0], 93)
+  TEST_EQUAL(scores[1], 131)
+  for (Size i = 0; i < seqs.size(); ++i)
+  {
+    TEST_EQUAL(scores[i], alignment.align(seq1, seqs[i]))
+  }
+  alignment.setMatrix(NeedlemanWunsch::ScoringMatrix::identity);
+  scores = alignment.align(seq1, seqs);
+  TEST_EQUAL(scores[0], 1)
+  for (Size i = 0; i < seqs.size(); ++i)
+  {
+    TEST_EQUAL(scores[i], alignment.align(seq1, seqs[i]))
+  }
+  TEST_EQUAL(alignment.align(seq1, std::vector<String>()).empty(), true)
+  TEST_EQUAL(alignment.align("", seqs)[0], -5 * int(seq2.size()))
+}
+END_SECTION
+
 START_SECTION(void setMatrix(const ScoringMatrix& matrix))
 {
   NeedlemanWunsch alignment = NeedlemanWunsch(NeedlemanWunsch::ScoringMatrix::identity, 5);
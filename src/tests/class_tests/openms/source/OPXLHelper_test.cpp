@@ -124,6 +124,49 @@ START_SECTION(static std::vector<OPXLDataStructs::XLPrecursor> enumerateCrossLin
 
 END_SECTION
 
+START_SECTION(static void enumerateCrossLinksAndMasses(const std::vector<OPXLDataStructs::AASeqWithMass>&  peptides, double cross_link_mass_light, const DoubleList& cross_link_mass_mono_link, const StringList& cross_link_residue1, const StringList& cross_link_residue2, const std::vector< double >& spectrum_precursors, double precursor_mass_tolerance, bool precursor_mass_tolerance_unit_ppm, const std::function<void(const OPXLDataStructs::XLPrecursor&, int)>& callback))
+
+  std::vector< int > spectrum_precursor_correction_positions;
+  std::vector<OPXLDataStructs::XLPrecursor> precursors = OPXLHelper::enumerateCrossLinksAndMasses(peptides, cross_link_mass, cross_link_mass_mono_link, cross_link_residue1, cross_link_residue2, spectrum_precursors, spectrum_precursor_correction_positions, precursor_mass_tolerance, precursor_mass_tolerance_unit_ppm);
+
+  std::vector<OPXLDataStructs::XLPrecursor> streamed;
+  std::vector< int > streamed_positions;
+  OPXLHelper::enumerateCrossLinksAndMasses(peptides, cross_link_mass, cross_link_mass_mono_link, cross_link_residue1, cross_link_residue2, spectrum_precursors, precursor_mass_tolerance, precursor_mass_tolerance_unit_ppm,
+    [&](const OPXLDataStructs::XLPrecursor& precursor, int pm)
+    {
+      streamed.push_back(precursor);
+      streamed_positions.push_back(pm);
+    });
+
+  TEST_EQUAL(streamed.size(), 9604)
+  TEST_EQUAL(streamed_positions.size(), 9604)
+  ABORT_IF(streamed.size() != precursors.size())
+  bool all_equal = true;
+  for (Size i = 0; i < streamed.size(); ++i)
+  {
+    all_equal &= (streamed[i].alpha_index == precursors[i].alpha_index) && (streamed[i].beta_index == precursors[i].beta_index)
+      && (streamed[i].alpha_seq == precursors[i].alpha_seq) && (streamed[i].beta_seq == precursors[i].beta_seq)
+      && (streamed_positions[i] == spectrum_precursor_correction_positions[i]);
+  }
+  TEST_EQUAL(all_equal, true)
+
+  // the precursor mass of every candidate is within the tolerance of its spectrum precursor
+  bool all_within_tolerance = true;
+  for (Size i = 0; i < streamed.size(); ++i)
+  {
+    double spectrum_precursor = spectrum_precursors[streamed_positions[i]];
+    all_within_tolerance &= (std::fabs(streamed[i].precursor_mass - spectrum_precursor) <= spectrum_precursor * precursor_mass_tolerance * 1e-6 + 1e-3);
+  }
+  TEST_EQUAL(all_within_tolerance, true)
+
+  // no candidates without spectrum precursors
+  Size count = 0;
+  OPXLHelper::enumerateCrossLinksAndMasses(peptides, cross_link_mass, cross_link_mass_mono_link, cross_link_residue1, cross_link_residue2, std::vector< double >(), precursor_mass_tolerance, precursor_mass_tolerance_unit_ppm,
+    [&](const OPXLDataStructs::XLPrecursor&, int) { ++count; });
+  TEST_EQUAL(count, 0)
+
+END_SECTION
+
 // building more data structures required in the following test
 std::cout << std::endl;
 std::vector< int > spectrum_precursor_correction_positions;
@@ -13,6 +13,8 @@
 #include <OpenMS/FORMAT/OSWFile.h>
 ///////////////////////////
 
+#include <sqlite3.h>
+
 using namespace OpenMS;
 using namespace std;
 
@@ -151,6 +153,150 @@ START_SECTION(void readMinimal(OSWData & swath_result))
 	checkData(res);
 END_SECTION
 
+START_SECTION(void prefetchProteins(const OSWData& swath_result, const std::vector<Size>& indices))
+	// a small OSW file (only the columns used by OSWFile) with three proteins; the third one has no peptides
+	String osw;
+	NEW_TMP_FILE_EXT(osw, ".osw");
+	{
+		SqliteConnector conn(osw);
+		conn.executeStatement("CREATE TABLE RUN(ID INT PRIMARY KEY NOT NULL, FILENAME TEXT NOT NULL);"
+		                      "CREATE TABLE PROTEIN(ID INT PRIMARY KEY NOT NULL, PROTEIN_ACCESSION TEXT NOT NULL, DECOY INT NOT NULL);"
+		                      "CREATE TABLE PEPTIDE_PROTEIN_MAPPING(PEPTIDE_ID INT NOT NULL, PROTEIN_ID INT NOT NULL);"
+		                      "CREATE TABLE PEPTIDE(ID INT PRIMARY KEY NOT NULL, MODIFIED_SEQUENCE TEXT NOT NULL);"
+		                      "CREATE TABLE PRECURSOR_PEPTIDE_MAPPING(PRECURSOR_ID INT NOT NULL, PEPTIDE_ID INT NOT NULL);"
+		                      "CREATE TABLE PRECURSOR(ID INT PRIMARY KEY NOT NULL, PRECURSOR_MZ REAL NOT NULL, CHARGE INT NULL);"
+		                      "CREATE TABLE FEATURE(ID INT PRIMARY KEY NOT NULL, RUN_ID INT NOT NULL, PRECURSOR_ID INT NOT NULL, EXP_RT REAL NOT NULL, "
+		                      "                     DELTA_RT REAL NOT NULL, LEFT_WIDTH REAL NOT NULL, RIGHT_WIDTH REAL NOT NULL);"
+		                      "CREATE TABLE FEATURE_TRANSITION(FEATURE_ID INT NOT NULL, TRANSITION_ID INT NOT NULL);"
+		                      "CREATE TABLE SCORE_MS2(FEATURE_ID INT NOT NULL, SCORE DOUBLE NOT NULL, QVALUE DOUBLE NOT NULL, PEP DOUBLE NOT NULL);"
+		                      "CREATE TABLE TRANSITION(ID INT PRIMARY KEY NOT NULL, PRODUCT_MZ REAL NOT NULL, TYPE CHAR(255), DECOY INT NOT NULL, ANNOTATION TEXT);"
+		                      "CREATE INDEX idx_scorems2_feature_id ON SCORE_MS2(FEATURE_ID);" // an indexed column (as pyProphet creates) is used as is
+		                      "INSERT INTO RUN VALUES (17, 'run.mzML');"
+		                      "INSERT INTO PROTEIN VALUES (1, 'PROT1', 0), (2, 'PROT2', 0), (3, 'DECOY_PROT3', 1);"
+		                      "INSERT INTO PEPTIDE VALUES (10, 'PEPTIDEK'), (11, 'PEPT(UniMod:35)IDER');"
+		                      "INSERT INTO PEPTIDE_PROTEIN_MAPPING VALUES (10, 1), (10, 2), (11, 2);"
+		                      "INSERT INTO PRECURSOR VALUES (100, 500.5, 2), (101, 667.0, 3), (102, 600.25, 2);"
+		                      "INSERT INTO PRECURSOR_PEPTIDE_MAPPING VALUES (100, 10), (101, 10), (102, 11);"
+		                      "INSERT INTO FEATURE VALUES (1000, 17, 100, 120.5, 1.5, 118, 123), (1001, 17, 100, 300, -2, 298, 302), "
+		                      "                           (1002, 17, 101, 121, 2, 119, 124), (1003, 17, 102, 500, 0.5, 495, 505);"
+		                      "INSERT INTO SCORE_MS2 VALUES (1000, 5, 0.01, 0.1), (1001, 1, 0.5, 0.9), (1002, 4, 0.02, 0.2), (1003, 3, 0.03, 0.3);"
+		                      "INSERT INTO TRANSITION VALUES (1, 100.1, 'y', 0, 'y1'), (2, 200.2, 'y', 0, 'y2'), (3, 300.3, 'b', 0, 'b3'), (4, 400.4, 'y', 0, 'y4');"
+		                      "INSERT INTO FEATURE_TRANSITION VALUES (1000, 2), (1000, 1), (1001, 1), (1001, 2), (1002, 3), (1003, 4), (1003, 3);");
+	}
+
+	auto testEqualProteins = [](const OSWProtein& a, const OSWProtein& b)
+	{
+		TEST_EQUAL(a.getID(), b.getID())
+		TEST_EQUAL(a.getAccession(), b.getAccession())
+		TEST_EQUAL(a.getPeptidePrecursors().size(), b.getPeptidePrecursors().size())
+		if (a.getPeptidePrecursors().size() != b.getPeptidePrecursors().size()) return;
+		for (Size i = 0; i < a.getPeptidePrecursors().size(); ++i)
+		{
+			const auto& pa = a.getPeptidePrecursors()[i];
+			const auto& pb = b.getPeptidePrecursors()[i];
+			TEST_EQUAL(pa.getSequence(), pb.getSequence())
+			TEST_EQUAL(pa.getCharge(), pb.getCharge())
+			TEST_EQUAL(pa.isDecoy(), pb.isDecoy())
+			TEST_EQUAL(pa.getPCMz(), pb.getPCMz())
+			TEST_EQUAL(pa.getFeatures().size(), pb.getFeatures().size())
+			if (pa.getFeatures().size() != pb.getFeatures().size()) return;
+			for (Size f = 0; f < pa.getFeatures().size(); ++f)
+			{
+				TEST_EQUAL(pa.getFeatures()[f].getRTExperimental(), pb.getFeatures()[f].getRTExperimental())
+				TEST_EQUAL(pa.getFeatures()[f].getRTLeftWidth(), pb.getFeatures()[f].getRTLeftWidth())
+				TEST_EQUAL(pa.getFeatures()[f].getRTRightWidth(), pb.getFeatures()[f].getRTRightWidth())
+				TEST_EQUAL(pa.getFeatures()[f].getRTDelta(), pb.getFeatures()[f].getRTDelta())
+				TEST_EQUAL(pa.getFeatures()[f].getQValue(), pb.getFeatures()[f].getQValue())
+				TEST_EQUAL(pa.getFeatures()[f].getTransitionIDs() == pb.getFeatures()[f].getTransitionIDs(), true)
+			}
+		}
+	};
+
+	OSWData full;
+	OSWFile(osw).read(full);
+	TEST_EQUAL(full.getProteins().size(), 2) // the protein without peptides is not reported
+	TEST_EQUAL(full.getProteins()[1].getPeptidePrecursors().size(), 3)
+	TEST_EQUAL(full.getProteins()[1].getPeptidePrecursors()[2].getSequence(), "PEPT(UniMod:35)IDER")
+	TEST_EQUAL(full.getProteins()[0].getPeptidePrecursors()[0].getFeatures().size(), 2)
+	TEST_REAL_SIMILAR(full.getProteins()[0].getPeptidePrecursors()[0].getFeatures()[1].getQValue(), 0.5)
+	TEST_EQUAL(full.getProteins()[0].getPeptidePrecursors()[0].getFeatures()[0].getTransitionIDs().size(), 2)
+	TEST_EQUAL(full.getProteins()[0].getPeptidePrecursors()[0].getFeatures()[0].getTransitionIDs()[0], 1)
+
+	{ // single proteins (using the lookup tables) are the same as in a full read
+		OSWData res;
+		OSWFile oswf(osw);
+		oswf.readMinimal(res);
+		TEST_EQUAL(res.getProteins().size(), 3)
+		oswf.readProtein(res, 1);
+		oswf.readProtein(res, 0);
+		testEqualProteins(res.getProteins()[0], full.getProteins()[0]);
+		testEqualProteins(res.getProteins()[1], full.getProteins()[1]);
+		TEST_EXCEPTION(Exception::InvalidValue, oswf.readProtein(res, 2))
+	}
+
+	{ // prefetched proteins
+		OSWData res;
+		OSWFile oswf(osw);
+		oswf.readMinimal(res);
+		oswf.prefetchProteins(res, {1, 0, 2, 7}); // invalid indices and proteins without peptides are ignored
+		oswf.prefetchProteins(res, {1}); // stops the previous prefetch
+		for (Size i = 0; i < 2; ++i)
+		{
+			oswf.readProtein(res, i);
+			testEqualProteins(res.getProteins()[i], full.getProteins()[i]);
+		}
+		TEST_EXCEPTION(Exception::InvalidValue, oswf.readProtein(res, 2))
+		oswf.prefetchProteins(res, {0, 1}); // already populated: nothing to do
+		oswf.prefetchProteins(res, {2}); // destroyed while (maybe) still running
+	}
+END_SECTION
+
+START_SECTION(static void merge(const StringList& in, const String& out))
+	// two shards of the same run with disjoint features
+	StringList shards;
+	for (Size s = 0; s < 2; ++s)
+	{
+		String shard;
+		NEW_TMP_FILE_EXT(shard, String(s) + ".osw"); // one file per shard
+		SqliteConnector conn(shard);
+		conn.executeStatement("CREATE TABLE RUN(ID INT PRIMARY KEY NOT NULL, FILENAME TEXT NOT NULL);"
+		                      "CREATE TABLE FEATURE(ID INT PRIMARY KEY NOT NULL, RUN_ID INT NOT NULL, PRECURSOR_ID INT NOT NULL);"
+		                      "CREATE TABLE FEATURE_TRANSITION(FEATURE_ID INT NOT NULL, TRANSITION_ID INT NOT NULL);"
+		                      "INSERT INTO RUN VALUES (17, 'run.mzML');");
+		for (Size f = 0; f < 3; ++f)
+		{
+			const String id(s * 3 + f);
+			conn.executeStatement("INSERT INTO FEATURE VALUES (" + id + ", 17, " + String(s) + ");"
+			                      "INSERT INTO FEATURE_TRANSITION VALUES (" + id + ", 1), (" + id + ", 2);");
+		}
+		shards.push_back(shard);
+	}
+
+	String merged;
+	NEW_TMP_FILE(merged);
+	OSWFile::merge(shards, merged);
+
+	OSWFile oswf(merged);
+	TEST_EQUAL(oswf.getRunID(), 17); // one run
+	SqliteConnector conn(merged);
+	sqlite3_stmt* stmt;
+	conn.prepareStatement(&stmt, "SELECT COUNT(*), SUM(ID), SUM(PRECURSOR_ID) FROM FEATURE;");
+	TEST_EQUAL(Internal::SqliteHelper::nextRow(stmt) == Internal::SqliteHelper::SqlState::SQL_ROW, true)
+	TEST_EQUAL(Internal::SqliteHelper::extractInt(stmt, 0), 6)
+	TEST_EQUAL(Internal::SqliteHelper::extractInt(stmt, 1), 15)
+	TEST_EQUAL(Internal::SqliteHelper::extractInt(stmt, 2), 3)
+	sqlite3_finalize(stmt);
+	conn.prepareStatement(&stmt, "SELECT COUNT(*) FROM FEATURE_TRANSITION;");
+	TEST_EQUAL(Internal::SqliteHelper::nextRow(stmt) == Internal::SqliteHelper::SqlState::SQL_ROW, true)
+	TEST_EQUAL(Internal::SqliteHelper::extractInt(stmt, 0), 12)
+	sqlite3_finalize(stmt);
+
+	// duplicate features cannot be merged
+	String twice;
+	NEW_TMP_FILE(twice);
+	TEST_EXCEPTION(Exception::IllegalArgument, OSWFile::merge(ListUtils::create<String>(shards[0] + "," + shards[0]), twice))
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -0,0 +1,222 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/OffsetIndexFile.h>
+///////////////////////////
+
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/FORMAT/MzXMLFile.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <fstream>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(OffsetIndexFile, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+OffsetIndexFile* ptr = nullptr;
+OffsetIndexFile* nullPointer = nullptr;
+
+START_SECTION((OffsetIndexFile()))
+{
+  ptr = new OffsetIndexFile();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->getFileType(), FileTypes::UNKNOWN)
+  TEST_EQUAL(ptr->getSpectra().size(), 0)
+  TEST_EQUAL(ptr->getRunEnd(), -1)
+}
+END_SECTION
+
+START_SECTION((~OffsetIndexFile()))
+{
+  delete ptr;
+}
+END_SECTION
+
+// test data: MS1 - MS2 - MS1 spectra and a chromatogram
+PeakMap exp;
+for (Size i = 0; i < 3; ++i)
+{
+  MSSpectrum spec;
+  spec.setRT(10.0 * (i + 1));
+  spec.setMSLevel(i == 1 ? 2 : 1);
+  spec.setNativeID("scan=" + String(i + 1));
+  if (i == 1)
+  {
+    Precursor prec;
+    prec.setMZ(500.25);
+    spec.getPrecursors().push_back(prec);
+  }
+  for (Size j = 0; j < 5; ++j)
+  {
+    spec.push_back(Peak1D(100.0 + 10.0 * j + i, 1000.0 * (j + 1)));
+  }
+  exp.addSpectrum(spec);
+}
+{
+  MSChromatogram chrom;
+  chrom.setNativeID("TIC & more");
+  chrom.push_back(ChromatogramPeak(10.0, 5.0));
+  chrom.push_back(ChromatogramPeak(20.0, 6.0));
+  exp.addChromatogram(chrom);
+}
+
+String mzml_file;
+NEW_TMP_FILE(mzml_file);
+{
+  MzMLFile f;
+  f.getOptions().setWriteIndex(false);
+  f.store(mzml_file, exp);
+}
+String mzxml_file;
+NEW_TMP_FILE(mzxml_file);
+MzXMLFile().store(mzxml_file, exp);
+
+START_SECTION((void scan(const String& data_file)))
+{
+  OffsetIndexFile index;
+  index.scan(mzml_file);
+  TEST_EQUAL(index.getFileType(), FileTypes::MZML)
+  ABORT_IF(index.getSpectra().size() != 3)
+  for (Size i = 0; i < 3; ++i)
+  {
+    const OffsetIndexFile::Entry& e = index.getSpectra()[i];
+    TEST_EQUAL(e.native_id, exp[i].getNativeID())
+    TEST_REAL_SIMILAR(e.rt, exp[i].getRT())
+    TEST_EQUAL(e.ms_level, exp[i].getMSLevel())
+    TEST_EQUAL(e.unclosed, false)
+  }
+  TEST_REAL_SIMILAR(index.getSpectra()[1].precursor_mz, 500.25)
+  TEST_EQUAL(index.getSpectra()[0].precursor_mz, 0.0)
+  ABORT_IF(index.getChromatograms().size() != 1)
+  TEST_EQUAL(index.getChromatograms()[0].native_id, "TIC & more")
+  TEST_EQUAL(index.getRunEnd() > index.getChromatograms()[0].offset, true)
+
+  // nested scans in mzXML: the MS1 scan ends where the MS2 scan starts
+  index.scan(mzxml_file);
+  TEST_EQUAL(index.getFileType(), FileTypes::MZXML)
+  ABORT_IF(index.getSpectra().size() != 3)
+  for (Size i = 0; i < 3; ++i)
+  {
+    const OffsetIndexFile::Entry& e = index.getSpectra()[i];
+    TEST_EQUAL(e.native_id, exp[i].getNativeID())
+    TEST_REAL_SIMILAR(e.rt, exp[i].getRT())
+    TEST_EQUAL(e.ms_level, exp[i].getMSLevel())
+  }
+  TEST_EQUAL(index.getSpectra()[0].unclosed, true)
+  TEST_EQUAL(index.getSpectra()[0].offset + index.getSpectra()[0].length <= index.getSpectra()[1].offset, true)
+  TEST_EQUAL(index.getSpectra()[1].unclosed, false)
+  TEST_REAL_SIMILAR(index.getSpectra()[1].precursor_mz, 500.25)
+  TEST_EQUAL(index.getChromatograms().size(), 0)
+
+  String no_xml;
+  NEW_TMP_FILE(no_xml);
+  ofstream(no_xml.c_str()) << "no mass spectrometry data";
+  TEST_EXCEPTION(Exception::ParseError, index.scan(no_xml))
+  TEST_EXCEPTION(Exception::FileNotFound, index.scan("this_file_does_not_exist.mzML"))
+}
+END_SECTION
+
+START_SECTION((static std::string readElement(const String& data_file, const Entry& entry)))
+{
+  OffsetIndexFile index;
+  index.scan(mzml_file);
+  String spectrum = OffsetIndexFile::readElement(mzml_file, index.getSpectra()[2]);
+  TEST_EQUAL(spectrum.hasPrefix("<spectrum "), true)
+  TEST_EQUAL(spectrum.hasSuffix("</spectrum>"), true)
+  TEST_EQUAL(spectrum.hasSubstring("id=\"scan=3\""), true)
+
+  index.scan(mzxml_file);
+  String scan = OffsetIndexFile::readElement(mzxml_file, index.getSpectra()[0]);
+  TEST_EQUAL(scan.hasPrefix("<scan "), true)
+  TEST_EQUAL(scan.hasSuffix("</scan>"), true)
+  TEST_EQUAL(scan.hasSubstring("msLevel=\"2\""), false)
+
+  OffsetIndexFile::Entry outside;
+  outside.offset = File::fileSize(mzxml_file);
+  outside.length = 10;
+  TEST_EXCEPTION(Exception::ParseError, OffsetIndexFile::readElement(mzxml_file, outside))
+}
+END_SECTION
+
+START_SECTION((void store(const String& index_file, const String& data_file) const))
+{
+  // tested below
+  NOT_TESTABLE
+}
+END_SECTION
+
+START_SECTION((bool load(const String& index_file, const String& data_file)))
+{
+  OffsetIndexFile index, loaded;
+  index.scan(mzml_file);
+  String index_file;
+  NEW_TMP_FILE(index_file);
+  index.store(index_file, mzml_file);
+  TEST_EQUAL(loaded.load(index_file, mzml_file), true)
+  TEST_EQUAL(loaded.getFileType(), FileTypes::MZML)
+  TEST_EQUAL(loaded.getRunEnd(), index.getRunEnd())
+  TEST_EQUAL(loaded.getSpectra() == index.getSpectra(), true)
+  TEST_EQUAL(loaded.getChromatograms() == index.getChromatograms(), true)
+
+  // outdated (the data file has a different size)
+  TEST_EQUAL(loaded.load(index_file, mzxml_file), false)
+  TEST_EQUAL(loaded.getSpectra().size(), 0)
+  TEST_EQUAL(loaded.load("this_file_does_not_exist.offsets", mzml_file), false)
+  TEST_EQUAL(loaded.load(mzml_file, mzml_file), false)
+}
+END_SECTION
+
+START_SECTION((void loadOrScan(const String& data_file, bool write_sidecar = true)))
+{
+  OffsetIndexFile index;
+  index.loadOrScan(mzxml_file, false);
+  TEST_EQUAL(File::exists(OffsetIndexFile::getSidecarName(mzxml_file)), false)
+  TEST_EQUAL(index.getSpectra().size(), 3)
+
+  index.loadOrScan(mzxml_file);
+  TEST_EQUAL(File::exists(OffsetIndexFile::getSidecarName(mzxml_file)), true)
+  OffsetIndexFile loaded;
+  TEST_EQUAL(loaded.load(OffsetIndexFile::getSidecarName(mzxml_file), mzxml_file), true)
+  TEST_EQUAL(loaded.getSpectra() == index.getSpectra(), true)
+  loaded.loadOrScan(mzxml_file);
+  TEST_EQUAL(loaded.getSpectra() == index.getSpectra(), true)
+  File::remove(OffsetIndexFile::getSidecarName(mzxml_file));
+}
+END_SECTION
+
+START_SECTION((static String getSidecarName(const String& data_file)))
+{
+  TEST_EQUAL(OffsetIndexFile::getSidecarName("data/run.mzML"), "data/run.mzML.offsets")
+}
+END_SECTION
+
+START_SECTION((void clear()))
+{
+  OffsetIndexFile index;
+  index.scan(mzml_file);
+  index.clear();
+  TEST_EQUAL(index.getFileType(), FileTypes::UNKNOWN)
+  TEST_EQUAL(index.getSpectra().size(), 0)
+  TEST_EQUAL(index.getChromatograms().size(), 0)
+  TEST_EQUAL(index.getRunEnd(), -1)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
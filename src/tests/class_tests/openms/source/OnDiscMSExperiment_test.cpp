@@ -211,6 +211,36 @@ START_SECTION((MSSpectrum getSpectrum(Size id)))
 }
 END_SECTION
 
+START_SECTION((std::vector<MSSpectrum> getSpectra(const std::vector<Size>& ids)))
+{
+  OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+  std::vector<Size> ids = {1, 0, 1};
+  std::vector<MSSpectrum> spectra = tmp.getSpectra(ids);
+  TEST_EQUAL(spectra.size(), 3)
+  TEST_EQUAL(spectra[0].size(), 19800)
+  TEST_EQUAL(spectra[1].size(), 19914)
+  TEST_TRUE(spectra[0] == tmp.getSpectrum(1))
+  TEST_TRUE(spectra[1] == tmp.getSpectrum(0))
+  TEST_TRUE(spectra[2] == spectra[0])
+
+  TEST_EQUAL(tmp.getSpectra({}).empty(), true)
+
+  // errors in any of the threads are reported
+  OnDiscPeakMap tmp2; tmp2.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), true);
+  TEST_EXCEPTION(Exception::ParseError, tmp2.getSpectra({0, tmp2.getNrSpectra()}))
+}
+END_SECTION
+
+START_SECTION((std::vector<MSChromatogram> getChromatograms(const std::vector<Size>& ids)))
+{
+  OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+  std::vector<Size> ids = {0};
+  std::vector<MSChromatogram> chromatograms = tmp.getChromatograms(ids);
+  TEST_EQUAL(chromatograms.size(), 1)
+  TEST_TRUE(chromatograms[0] == tmp.getChromatogram(0))
+}
+END_SECTION
+
 START_SECTION(OpenMS::Interfaces::SpectrumPtr getSpectrumById(Size id))
 {
   OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
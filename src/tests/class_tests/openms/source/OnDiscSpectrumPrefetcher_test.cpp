@@ -0,0 +1,112 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/KERNEL/OnDiscSpectrumPrefetcher.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(OnDiscSpectrumPrefetcher, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+OnDiscPeakMap exp;
+exp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+
+OnDiscSpectrumPrefetcher* ptr = nullptr;
+OnDiscSpectrumPrefetcher* nullPointer = nullptr;
+START_SECTION((explicit OnDiscSpectrumPrefetcher(OnDiscMSExperiment& exp, Size batch_size = 1000)))
+{
+  ptr = new OnDiscSpectrumPrefetcher(exp);
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->remaining(), 2)
+  TEST_EXCEPTION(Exception::IllegalArgument, OnDiscSpectrumPrefetcher(exp, 0))
+}
+END_SECTION
+
+START_SECTION((~OnDiscSpectrumPrefetcher()))
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((OnDiscSpectrumPrefetcher(OnDiscMSExperiment& exp, const std::vector<Size>& ids, Size batch_size = 1000)))
+{
+  OnDiscSpectrumPrefetcher prefetcher(exp, {1, 0, 1}, 2);
+  TEST_EQUAL(prefetcher.remaining(), 3)
+  TEST_EXCEPTION(Exception::IllegalArgument, OnDiscSpectrumPrefetcher(exp, {0}, 0))
+}
+END_SECTION
+
+START_SECTION((bool nextBatch(std::vector<MSSpectrum>& batch)))
+{
+  OnDiscSpectrumPrefetcher prefetcher(exp, {1, 0, 1}, 2);
+  std::vector<MSSpectrum> batch;
+  TEST_EQUAL(prefetcher.nextBatch(batch), true)
+  TEST_EQUAL(prefetcher.batchStart(), 0)
+  TEST_EQUAL(prefetcher.remaining(), 1)
+  TEST_EQUAL(batch.size(), 2)
+  TEST_TRUE(batch[0] == exp.getSpectrum(1))
+  TEST_TRUE(batch[1] == exp.getSpectrum(0))
+  TEST_EQUAL(prefetcher.nextBatch(batch), true)
+  TEST_EQUAL(prefetcher.batchStart(), 2)
+  TEST_EQUAL(prefetcher.remaining(), 0)
+  TEST_EQUAL(batch.size(), 1)
+  TEST_TRUE(batch[0] == exp.getSpectrum(1))
+  TEST_EQUAL(prefetcher.nextBatch(batch), false)
+  TEST_EQUAL(batch.empty(), true)
+
+  // nothing to read
+  OnDiscSpectrumPrefetcher empty(exp, std::vector<Size>());
+  TEST_EQUAL(empty.nextBatch(batch), false)
+
+  // errors of the reading thread are rethrown for their batch
+  OnDiscPeakMap no_meta;
+  no_meta.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), true);
+  OnDiscSpectrumPrefetcher failing(no_meta, {0, no_meta.getNrSpectra()}, 1);
+  TEST_EQUAL(failing.nextBatch(batch), true)
+  TEST_EXCEPTION(Exception::ParseError, failing.nextBatch(batch))
+}
+END_SECTION
+
+START_SECTION((bool next(MSSpectrum& spectrum)))
+{
+  OnDiscSpectrumPrefetcher prefetcher(exp, 1);
+  MSSpectrum spectrum;
+  Size count = 0;
+  while (prefetcher.next(spectrum))
+  {
+    TEST_TRUE(spectrum == exp.getSpectrum(count))
+    ++count;
+    TEST_EQUAL(prefetcher.remaining(), exp.getNrSpectra() - count)
+  }
+  TEST_EQUAL(count, 2)
+}
+END_SECTION
+
+START_SECTION((Size batchStart() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((Size remaining() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
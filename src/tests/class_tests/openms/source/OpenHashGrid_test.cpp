@@ -0,0 +1,139 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Lars Nilse $
+// $Authors: Lars Nilse $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+#include <OpenMS/ML/CLUSTERING/OpenHashGrid.h>
+
+#include <vector>
+
+using namespace OpenMS;
+
+typedef OpenHashGrid<int> TestGrid;
+
+START_TEST(OpenHashGrid, "$Id$")
+
+START_SECTION(void insert(const CellIndex& x, const Value& value))
+{
+  TestGrid t;
+  TEST_EQUAL(t.empty(), true)
+  t.insert(TestGrid::CellIndex(1, 2), 5);
+  t.insert(TestGrid::CellIndex(1, 2), 3);
+  t.insert(TestGrid::CellIndex(-7, 2), 4);
+  TEST_EQUAL(t.size(), 3)
+  TEST_EQUAL(t.cellCount(), 2)
+  const TestGrid::CellContent* cell = t.find(TestGrid::CellIndex(1, 2));
+  TEST_EQUAL(cell->size(), 2)
+  TEST_EQUAL((*cell)[0], 5)
+  TEST_EQUAL((*cell)[1], 3)
+
+  // many cells (the table grows)
+  for (int i = 0; i < 1000; ++i)
+  {
+    t.insert(TestGrid::CellIndex(i, -i), i);
+  }
+  TEST_EQUAL(t.size(), 1003)
+  TEST_EQUAL(t.cellCount(), 1002)
+  bool all = true;
+  for (int i = 0; i < 1000; ++i)
+  {
+    const TestGrid::CellContent* c = t.find(TestGrid::CellIndex(i, -i));
+    all &= (c != nullptr && c->back() == i);
+  }
+  TEST_EQUAL(all, true)
+}
+END_SECTION
+
+START_SECTION(Size erase(const CellIndex& x, const Value& value))
+{
+  TestGrid t;
+  t.insert(TestGrid::CellIndex(0, 0), 1);
+  t.insert(TestGrid::CellIndex(0, 0), 2);
+  t.insert(TestGrid::CellIndex(0, 0), 1);
+  t.insert(TestGrid::CellIndex(0, 0), 3);
+  TEST_EQUAL(t.erase(TestGrid::CellIndex(0, 0), 1), 2)
+  TEST_EQUAL(t.erase(TestGrid::CellIndex(0, 0), 7), 0)
+  TEST_EQUAL(t.erase(TestGrid::CellIndex(3, 0), 2), 0)
+  const TestGrid::CellContent* cell = t.find(TestGrid::CellIndex(0, 0));
+  TEST_EQUAL(cell->size(), 2)
+  TEST_EQUAL((*cell)[0], 2)
+  TEST_EQUAL((*cell)[1], 3)
+  TEST_EQUAL(t.size(), 2)
+
+  // empty cells are not found
+  t.erase(TestGrid::CellIndex(0, 0), 2);
+  t.erase(TestGrid::CellIndex(0, 0), 3);
+  TEST_EQUAL(t.find(TestGrid::CellIndex(0, 0)) == nullptr, true)
+  TEST_EQUAL(t.cellCount(), 0)
+  TEST_EQUAL(t.empty(), true)
+  t.insert(TestGrid::CellIndex(0, 0), 4);
+  TEST_EQUAL(t.cellCount(), 1)
+  TEST_EQUAL(t.find(TestGrid::CellIndex(0, 0))->front(), 4)
+}
+END_SECTION
+
+START_SECTION(void clear())
+{
+  TestGrid t;
+  t.insert(TestGrid::CellIndex(0, 0), 1);
+  t.clear();
+  TEST_EQUAL(t.size(), 0)
+  TEST_EQUAL(t.cellCount(), 0)
+  TEST_EQUAL(t.find(TestGrid::CellIndex(0, 0)) == nullptr, true)
+}
+END_SECTION
+
+START_SECTION(const CellContent* find(const CellIndex& x) const)
+{
+  TestGrid t;
+  TEST_EQUAL(t.find(TestGrid::CellIndex(0, 0)) == nullptr, true)
+}
+END_SECTION
+
+START_SECTION((template <typename Functor> void forEachNeighbor(const CellIndex& x, Functor&& f) const))
+{
+  TestGrid t;
+  for (int i = 0; i < 5; ++i)
+  {
+    for (int j = 0; j < 5; ++j)
+    {
+      t.insert(TestGrid::CellIndex(i, j), 10 * i + j);
+    }
+  }
+  t.insert(TestGrid::CellIndex(2, 2), 100);
+  std::vector<int> found;
+  t.forEachNeighbor(TestGrid::CellIndex(2, 2), [&found](int v) { found.push_back(v); });
+  std::vector<int> expected = {11, 12, 13, 21, 22, 100, 23, 31, 32, 33};
+  TEST_EQUAL(found == expected, true)
+  found.clear();
+  t.forEachNeighbor(TestGrid::CellIndex(4, 0), [&found](int v) { found.push_back(v); });
+  expected = {30, 31, 40, 41};
+  TEST_EQUAL(found == expected, true)
+}
+END_SECTION
+
+START_SECTION(Size size() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(bool empty() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(Size cellCount() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+END_TEST
@@ -0,0 +1,105 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: George Rosenberger $
+// $Authors: George Rosenberger $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathOSWWriter.h>
+///////////////////////////
+
+#include <OpenMS/FORMAT/OSWFile.h>
+#include <OpenMS/FORMAT/SqliteConnector.h>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(OpenSwathOSWWriter, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+OpenSwathOSWWriter* ptr = nullptr;
+OpenSwathOSWWriter* nullPointer = nullptr;
+
+START_SECTION((OpenSwathOSWWriter(const String& output_filename, const UInt64 run_id, const String& input_filename = "inputfile", bool uis_scores = false)))
+{
+  ptr = new OpenSwathOSWWriter("", 0);
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->isActive(), false)
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(bool isActive() const)
+{
+  TEST_EQUAL(OpenSwathOSWWriter("out.osw", 0).isActive(), true)
+}
+END_SECTION
+
+START_SECTION(void writeHeader(bool checkpoints = false))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  OpenSwathOSWWriter writer(filename, 42, "run.mzML");
+  writer.writeHeader();
+  TEST_EQUAL(OSWFile(filename).getRunID(), 42)
+  SqliteConnector conn(filename);
+  TEST_EQUAL(conn.tableExists("FEATURE"), true)
+  TEST_EQUAL(conn.tableExists("CHECKPOINT"), false)
+
+  String filename_checkpoints;
+  NEW_TMP_FILE(filename_checkpoints)
+  OpenSwathOSWWriter(filename_checkpoints, 42).writeHeader(true);
+  TEST_EQUAL(SqliteConnector(filename_checkpoints).tableExists("CHECKPOINT"), true)
+}
+END_SECTION
+
+START_SECTION(std::set<String> readCheckpoints() const)
+{
+  // no file yet
+  String filename;
+  NEW_TMP_FILE(filename)
+  OpenSwathOSWWriter writer(filename, 42);
+  TEST_EQUAL(writer.readCheckpoints().empty(), true)
+
+  // no CHECKPOINT table
+  writer.writeHeader();
+  TEST_EQUAL(writer.readCheckpoints().empty(), true)
+}
+END_SECTION
+
+START_SECTION(String prepareCheckpoint(const String& unit) const)
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  OpenSwathOSWWriter writer(filename, 42);
+  writer.writeHeader(true);
+  TEST_EQUAL(writer.readCheckpoints().empty(), true)
+
+  // a unit and its checkpoint are written in one transaction
+  std::vector<String> lines = {"INSERT INTO FEATURE (ID, RUN_ID, PRECURSOR_ID, EXP_RT, NORM_RT, DELTA_RT, LEFT_WIDTH, RIGHT_WIDTH) VALUES (1, 42, 7, 100.0, 10.0, 0.5, 95.0, 105.0);",
+                               writer.prepareCheckpoint("SWATH 0 (m/z 400-425)")};
+  writer.enqueueLines(lines);
+  writer.flush();
+  std::vector<String> more_lines = {writer.prepareCheckpoint("window 'one'")};
+  writer.writeLines(more_lines);
+
+  std::set<String> checkpoints = writer.readCheckpoints();
+  TEST_EQUAL(checkpoints.size(), 2)
+  TEST_EQUAL(checkpoints.count("SWATH 0 (m/z 400-425)"), 1)
+  TEST_EQUAL(checkpoints.count("window 'one'"), 1)
+
+  // a unit cannot be completed twice
+  TEST_EXCEPTION(Exception::IllegalArgument, writer.writeLines(more_lines))
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
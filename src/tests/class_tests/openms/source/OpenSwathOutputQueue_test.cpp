@@ -0,0 +1,112 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathOutputQueue.h>
+///////////////////////////
+
+#include <algorithm>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(OpenSwathOutputQueue, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+OpenSwathOutputQueue* ptr = nullptr;
+OpenSwathOutputQueue* nullPointer = nullptr;
+
+std::vector<String> written;
+Size nr_batches = 0;
+OpenSwathOutputQueue::Sink sink = [&written, &nr_batches](const std::vector<String>& lines)
+{
+  written.insert(written.end(), lines.begin(), lines.end());
+  ++nr_batches;
+};
+
+START_SECTION((explicit OpenSwathOutputQueue(Sink sink)))
+{
+  ptr = new OpenSwathOutputQueue(sink);
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->pending(), 0)
+}
+END_SECTION
+
+START_SECTION((~OpenSwathOutputQueue()))
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((void push(std::vector<String>& lines)))
+{
+  written.clear();
+  nr_batches = 0;
+  OpenSwathOutputQueue queue(sink);
+  std::vector<String> lines = {"a", "b"};
+  queue.push(lines);
+  TEST_EQUAL(lines.empty(), true)
+  TEST_EQUAL(queue.pending(), 0)
+  TEST_EQUAL(nr_batches, 1)
+  ABORT_IF(written.size() != 2)
+  TEST_EQUAL(written[0], "a")
+  TEST_EQUAL(written[1], "b")
+
+  // many threads: every line is written exactly once, lines of one push stay together
+  written.clear();
+#pragma omp parallel for
+  for (int i = 0; i < 200; ++i)
+  {
+    std::vector<String> thread_lines = {String(i) + "_0", String(i) + "_1", String(i) + "_2"};
+    queue.push(thread_lines);
+  }
+  queue.flush();
+  TEST_EQUAL(written.size(), 600)
+  bool consecutive = true;
+  for (Size k = 0; k + 2 < written.size(); k += 3)
+  {
+    String prefix = written[k].prefix('_');
+    consecutive &= (written[k + 1] == prefix + "_1" && written[k + 2] == prefix + "_2");
+  }
+  TEST_EQUAL(consecutive, true)
+  std::vector<String> sorted(written);
+  std::sort(sorted.begin(), sorted.end());
+  TEST_EQUAL(std::unique(sorted.begin(), sorted.end()) == sorted.end(), true)
+}
+END_SECTION
+
+START_SECTION((void flush()))
+{
+  written.clear();
+  nr_batches = 0;
+  OpenSwathOutputQueue queue(sink);
+  queue.flush();
+  TEST_EQUAL(nr_batches, 0)
+  std::vector<String> lines = {"x"};
+  queue.push(lines);
+  queue.flush();
+  TEST_EQUAL(written.size(), 1)
+  TEST_EQUAL(nr_batches, 1)
+}
+END_SECTION
+
+START_SECTION((Size pending() const))
+{
+  // tested above
+  NOT_TESTABLE
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
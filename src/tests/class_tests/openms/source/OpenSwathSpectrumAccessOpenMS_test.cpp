@@ -219,6 +219,36 @@ START_SECTION ( std::vector<std::size_t> SpectrumAccessOpenMS::getSpectraByRT(do
 }
 END_SECTION
 
+START_SECTION ( const OpenSwath::SpectrumRTIndex* getRTIndex() const)
+{
+  boost::shared_ptr< PeakMap > exp(new PeakMap);
+  MSSpectrum s;
+  for (int i = 0; i < 5; ++i)
+  {
+    s.setRT(10.0 * i);
+    exp->addSpectrum(s);
+  }
+  SpectrumAccessOpenMS spectrum_acc(exp);
+  ABORT_IF(spectrum_acc.getRTIndex() == nullptr)
+  TEST_EQUAL(spectrum_acc.getRTIndex()->size(), 5)
+
+  // light clones share the index
+  boost::shared_ptr<OpenSwath::ISpectrumAccess> clone = spectrum_acc.lightClone();
+  TEST_EQUAL(clone->getRTIndex() == spectrum_acc.getRTIndex(), true)
+
+  // batch lookup and spectrum selection use the index
+  std::vector<std::vector<std::size_t> > res = clone->getSpectraByRTs({20.0, 34.0, 50.0}, 5.0);
+  ABORT_IF(res.size() != 3)
+  TEST_EQUAL(res[0].size(), 1)
+  TEST_EQUAL(res[0][0], 2)
+  TEST_EQUAL(res[1].size(), 1)
+  TEST_EQUAL(res[1][0], 3)
+  TEST_EQUAL(res[2].size(), 0)
+  TEST_EQUAL(clone->getMultipleSpectra(21.0, 3).size(), 3)
+  TEST_EQUAL(clone->getMultipleSpectra(41.0, 3).size(), 0)
+}
+END_SECTION
+
 START_SECTION( size_t getNrChromatograms() const)
 {
   NOT_TESTABLE // see getNrSpectra
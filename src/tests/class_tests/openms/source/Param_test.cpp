@@ -1713,6 +1713,104 @@ START_SECTION((void update(const Param& old_version, const bool add_unknown = fa
 }
 END_SECTION
 
+START_SECTION([EXTRA] copy on write)
+{
+  Param p;
+  p.setValue("a:b:c", 1, "desc", {"advanced"});
+  p.setValue("a:d", "x");
+  p.setValidStrings("a:d", {"x", "y"});
+  p.setSectionDescription("a", "section");
+
+  // all modifications of a copy leave the original unchanged (and vice versa)
+  Param copy(p);
+  copy.setValue("a:b:c", 2);
+  copy.setValue("a:e", 3.0);
+  copy.addTag("a:d", "tag");
+  copy.setSectionDescription("a:b", "subsection");
+  TEST_EQUAL(int(p.getValue("a:b:c")), 1)
+  TEST_EQUAL(int(copy.getValue("a:b:c")), 2)
+  TEST_EQUAL(p.exists("a:e"), false)
+  TEST_EQUAL(p.hasTag("a:d", "tag"), false)
+  TEST_EQUAL(copy.hasTag("a:d", "tag"), true)
+  TEST_EQUAL(p.getSectionDescription("a:b"), "")
+  TEST_EQUAL(p.size(), 2)
+  TEST_EQUAL(copy.size(), 3)
+
+  Param assigned;
+  assigned = p;
+  TEST_EQUAL(assigned == p, true)
+  p.remove("a:d");
+  TEST_EQUAL(assigned.exists("a:d"), true)
+  TEST_EQUAL(assigned.getValidStrings("a:d").size(), 2)
+  p.removeAll("a:");
+  TEST_EQUAL(p.empty(), true)
+  TEST_EQUAL(assigned.size(), 2)
+  assigned.clear();
+  TEST_EQUAL(copy.size(), 3)
+
+  // removing nothing and inserting a Param into itself
+  Param self(copy);
+  self.remove("a:nothing");
+  self.removeAll("x:");
+  TEST_EQUAL(self == copy, true)
+  self.insert("b:", self);
+  TEST_EQUAL(self.size(), 6)
+  TEST_EQUAL(int(self.getValue("b:a:b:c")), 2)
+  TEST_EQUAL(copy.size(), 3)
+
+  // moved-from Params can be reused
+  Param moved(copy);
+  Param target(std::move(moved));
+  TEST_EQUAL(target.size(), 3)
+  moved.setValue("z", 1);
+  TEST_EQUAL(int(moved.getValue("z")), 1)
+  TEST_EQUAL(target.exists("z"), false)
+}
+END_SECTION
+
+START_SECTION([EXTRA] hashed lookups)
+{
+  // lookups switch to a hash table after many queries; interleave them with modifications
+  Param p;
+  for (int i = 0; i < 200; ++i)
+  {
+    p.setValue("section" + std::to_string(i % 7) + ":sub" + std::to_string(i % 3) + ":value" + std::to_string(i), i);
+  }
+  bool all_found = true;
+  for (int round = 0; round < 4; ++round)
+  {
+    for (int i = 0; i < 200; ++i)
+    {
+      const std::string key = "section" + std::to_string(i % 7) + ":sub" + std::to_string(i % 3) + ":value" + std::to_string(i);
+      all_found &= p.exists(key) && int(p.getValue(key)) == i + round;
+      all_found &= !p.exists(key + "x") && !p.exists("section" + std::to_string(i % 7) + ":value" + std::to_string(i));
+    }
+    for (int i = 0; i < 200; ++i)
+    {
+      p.setValue("section" + std::to_string(i % 7) + ":sub" + std::to_string(i % 3) + ":value" + std::to_string(i), i + round + 1);
+    }
+  }
+  TEST_EQUAL(all_found, true)
+  TEST_EXCEPTION(Exception::ElementNotFound, p.getValue("section0:sub0"))
+  TEST_EQUAL(p.exists("section0:sub0:"), false)
+
+  // concurrent lookups in copies
+  Param shared(p);
+  int found = 0;
+#pragma omp parallel for reduction(+: found)
+  for (int i = 0; i < 2000; ++i)
+  {
+    Param local(shared);
+    const int j = i % 200;
+    if (int(local.getValue("section" + std::to_string(j % 7) + ":sub" + std::to_string(j % 3) + ":value" + std::to_string(j))) == j + 4)
+    {
+      ++found;
+    }
+  }
+  TEST_EQUAL(found, 2000)
+}
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
@@ -205,6 +205,21 @@ START_SECTION((const vector<Int>& getMSLevels() const))
 	TEST_EQUAL(tmp.getMSLevels().empty(),true);
 END_SECTION
 
+START_SECTION(bool getSkimBinaryData() const)
+{
+	PeakFileOptions tmp;
+	TEST_EQUAL(tmp.getSkimBinaryData(), false);
+}
+END_SECTION
+
+START_SECTION(void setSkimBinaryData(bool skim))
+{
+	PeakFileOptions tmp;
+	tmp.setSkimBinaryData(true);
+	TEST_EQUAL(tmp.getSkimBinaryData(), true);
+}
+END_SECTION
+
 START_SECTION(Size getMaxDataPoolSize() const)
 {
 	PeakFileOptions tmp;
@@ -220,6 +235,36 @@ START_SECTION(void setMaxDataPoolSize(Size size))
 }
 END_SECTION
 
+START_SECTION(bool getPipelinedDecoding() const)
+{
+	PeakFileOptions tmp;
+	TEST_EQUAL(tmp.getPipelinedDecoding(), true);
+}
+END_SECTION
+
+START_SECTION(void setPipelinedDecoding(bool pipelined))
+{
+	PeakFileOptions tmp;
+	tmp.setPipelinedDecoding(false);
+	TEST_EQUAL(tmp.getPipelinedDecoding(), false);
+}
+END_SECTION
+
+START_SECTION(bool getParallelWriting() const)
+{
+	PeakFileOptions tmp;
+	TEST_EQUAL(tmp.getParallelWriting(), true);
+}
+END_SECTION
+
+START_SECTION(void setParallelWriting(bool parallel))
+{
+	PeakFileOptions tmp;
+	tmp.setParallelWriting(false);
+	TEST_EQUAL(tmp.getParallelWriting(), false);
+}
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
@@ -948,6 +948,29 @@ START_SECTION(PeakShapeMetrics calculatePeakShapeMetrics(
 }
 END_SECTION
 
+START_SECTION([EXTRA] fit_EMG reuses the last fit of the same peak)
+{
+  PeakIntegrator pi;
+  Param params = pi.getParameters();
+  params.setValue("fit_EMG", "true");
+  pi.setParameters(params);
+  MSChromatogram scaled_chromatogram = chromatogram;
+  for (ChromatogramPeak& p : scaled_chromatogram)
+  {
+    p.setIntensity(p.getIntensity() * 2);
+  }
+  const PeakIntegrator::PeakArea pa = pi.integratePeak(chromatogram, left, right);
+  const PeakIntegrator::PeakArea pa_2 = pi.integratePeak(scaled_chromatogram, left, right);
+  TEST_NOT_EQUAL(pa.area, pa_2.area)
+  TEST_EQUAL(pi.integratePeak(chromatogram, left, right).area, pa.area)
+  TEST_EQUAL(pi.integratePeak(chromatogram, left, right).area, pa.area)
+  TEST_EQUAL(pi.integratePeak(scaled_chromatogram, left, right).area, pa_2.area)
+  // other boundaries are fitted again
+  TEST_NOT_EQUAL(pi.integratePeak(chromatogram, left_past_50, right_past_50).area, pa.area)
+  TEST_EQUAL(pi.integratePeak(chromatogram, left, right).area, pa.area)
+}
+END_SECTION
+
 START_SECTION([EXTRA]  template <typename PeakContainerConstIteratorT> double findPosAtPeakHeightPercent_(...))
 {
   PeakIntegratorTest pit;
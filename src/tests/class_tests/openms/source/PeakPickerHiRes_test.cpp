@@ -12,6 +12,7 @@
 
 ///////////////////////////
 #include <OpenMS/PROCESSING/CENTROIDING/PeakPickerHiRes.h>
+#include <OpenMS/KERNEL/ColumnarSpectrum.h>
 ///////////////////////////
 
 using namespace OpenMS;
@@ -181,6 +182,23 @@ START_SECTION((template <typename PeakType> void pick(const MSSpectrum& input, M
 }
 END_SECTION
 
+START_SECTION((void pick(const ColumnarSpectrum& input, ColumnarSpectrum& output, std::vector<PeakBoundary>& boundaries) const))
+{
+  ColumnarSpectrum columnar_in(input[0]), columnar_out;
+  std::vector<PeakPickerHiRes::PeakBoundary> tmp_boundaries;
+  pp_hires.pick(columnar_in, columnar_out, tmp_boundaries);
+
+  TEST_EQUAL(columnar_out.size(), output[0].size())
+  for (Size peak_idx = 0; peak_idx < columnar_out.size(); ++peak_idx)
+  {
+    TEST_REAL_SIMILAR(columnar_out.getMZArray()[peak_idx], output[0][peak_idx].getMZ())
+    TEST_REAL_SIMILAR(columnar_out.getIntensityArray()[peak_idx], output[0][peak_idx].getIntensity())
+  }
+  TEST_EQUAL(tmp_boundaries.size(), columnar_out.size())
+  TEST_REAL_SIMILAR(columnar_out.getRT(), input[0].getRT())
+}
+END_SECTION
+
 START_SECTION([EXTRA](template <typename PeakType> void pickExperiment(const MSExperiment<PeakType>& input, MSExperiment<PeakType>& output)))
   // does the same as pick method for spectra
   NOT_TESTABLE
@@ -10,7 +10,9 @@
 #include <OpenMS/test_config.h>
 ///////////////////////////
 #include <OpenMS/KERNEL/FeatureMap.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/QC/PeptideMass.h>
+#include <OpenMS/QC/QCEngine.h>
 
 ///////////////////////////
 
@@ -53,6 +55,20 @@ START_SECTION(void compute(FeatureMap& features))
 }
 END_SECTION
 
+START_SECTION(void addVisitors(QCEngine& engine) const)
+{
+  PeptideIdentification pi;
+  pi.getHits().push_back(PeptideHit(1.0, 1, 2, AASequence::fromString("KKK")));
+  pi.setMZ(100.0);
+  FeatureMap fm;
+  fm.getUnassignedPeptideIdentifications().push_back(pi);
+  QCEngine engine;
+  PeptideMass().addVisitors(engine);
+  engine.run(MSExperiment(), fm, QCBase::SpectraMap());
+  TEST_EQUAL(fm.getUnassignedPeptideIdentifications()[0].getHits()[0].getMetaValue("mass"), (100.0 - Constants::PROTON_MASS_U) * 2)
+}
+END_SECTION
+
 START_SECTION(QCBase::Status requirements() const override)
 {
   PeptideMass fw;
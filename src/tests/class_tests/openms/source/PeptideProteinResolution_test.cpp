@@ -54,6 +54,61 @@ START_SECTION(static void PeptideProteinResolution::run(vector<ProteinIdentifica
 }
 END_SECTION
 
+START_SECTION([EXTRA] void resolveGraph(ProteinIdentification& protein, std::vector<PeptideIdentification>& peptides))
+{
+  // indist. groups A > B > C > D > E; components {A, B}, {C, D} and {E}
+  ProteinIdentification prot;
+  const vector<String> accs{"A", "B", "C", "D", "E"};
+  for (Size i = 0; i < accs.size(); ++i)
+  {
+    ProteinHit hit;
+    hit.setAccession(accs[i]);
+    prot.insertHit(hit);
+    ProteinIdentification::ProteinGroup grp;
+    grp.accessions = {accs[i]};
+    grp.probability = 0.9 - 0.1 * i;
+    prot.insertIndistinguishableProteins(grp);
+  }
+  auto make_pep = [](const vector<String>& pep_accs)
+  {
+    PeptideHit hit;
+    for (const String& acc : pep_accs)
+    {
+      PeptideEvidence ev;
+      ev.setProteinAccession(acc);
+      hit.addPeptideEvidence(ev);
+    }
+    PeptideIdentification pep;
+    pep.insertHit(hit);
+    return pep;
+  };
+  vector<PeptideIdentification> peps{make_pep({"C", "D"}), make_pep({"A", "B"}), make_pep({"E"}), make_pep({"D"}), make_pep({"B"})};
+
+  PeptideProteinResolution ppr;
+  ppr.buildGraph(prot, peps);
+  ppr.resolveGraph(prot, peps);
+
+  const vector<String> kept{"C", "A", "E", "D", "B"};
+  for (Size i = 0; i < peps.size(); ++i)
+  {
+    const vector<PeptideEvidence>& evs = peps[i].getHits()[0].getPeptideEvidences();
+    TEST_EQUAL(evs.size(), 1)
+    TEST_EQUAL(evs[0].getProteinAccession(), kept[i])
+  }
+  // one ambiguity group per non-singleton component, in the order of the components
+  const vector<ProteinIdentification::ProteinGroup>& grps = prot.getProteinGroups();
+  TEST_EQUAL(grps.size(), 2)
+  TEST_EQUAL(ListUtils::concatenate(grps[0].accessions, ","), "A,B")
+  TEST_REAL_SIMILAR(grps[0].probability, 0.9)
+  TEST_EQUAL(ListUtils::concatenate(grps[1].accessions, ","), "C,D")
+  TEST_REAL_SIMILAR(grps[1].probability, 0.7)
+
+  // missing groups
+  ProteinIdentification no_groups;
+  TEST_EXCEPTION(Exception::MissingInformation, ppr.buildGraph(no_groups, peps))
+}
+END_SECTION
+
 START_SECTION(~PeptideProteinResolution())
 {
 	delete ptr;
@@ -13,6 +13,9 @@
 #include <OpenMS/FORMAT/PercolatorInfile.h>
 ///////////////////////////
 
+#include <OpenMS/CHEMISTRY/AASequence.h>
+#include <OpenMS/FORMAT/TextFile.h>
+
 using namespace OpenMS;
 using namespace std;
 
@@ -59,6 +62,40 @@ START_SECTION(vector<PeptideIdentification> PercolatorInfile::load(const String&
 }
 END_SECTION
 
+START_SECTION((static void store(const String& pin_file, const std::vector<PeptideIdentification>& peptide_ids, const StringList& feature_set, const std::string& enz, int min_charge, int max_charge)))
+{
+  vector<PeptideIdentification> pids;
+  for (Size i = 0; i < 1000; ++i)
+  {
+    PeptideIdentification pid;
+    pid.setSpectrumReference("scan=" + String(i + 1));
+    pid.setMZ(500.0 + i);
+    pid.setRT(10.0 * i);
+    PeptideHit hit(1.5, 1, 2, AASequence::fromString("PEPTIDEK"));
+    hit.addPeptideEvidence(PeptideEvidence("P1", 0, 7, 'K', 'A'));
+    hit.addPeptideEvidence(PeptideEvidence("DECOY_P2", 0, 7, '[', ']'));
+    hit.setMetaValue("target_decoy", i % 2 ? "decoy" : "target");
+    if (i % 10 != 3) hit.setMetaValue("MS:1002049", int(i)); // missing in some hits
+    pid.insertHit(hit);
+    pids.push_back(pid);
+  }
+  StringList feature_set = ListUtils::create<String>("SpecId,Label,ScanNr,charge2,charge3,enzN,MS:1002049,Peptide,Proteins");
+
+  String pin_file;
+  NEW_TMP_FILE(pin_file)
+  PercolatorInfile::store(pin_file, pids, feature_set, "trypsin", 2, 3);
+  TextFile pin(pin_file);
+  vector<String> lines(pin.begin(), pin.end());
+  ABORT_IF(lines.size() != 901)
+  TEST_EQUAL(lines[0], ListUtils::concatenate(feature_set, '\t'))
+  // hits without the meta value are skipped, the others are in input order
+  TEST_EQUAL(lines[1], "scan=1\t1\t1\t1\t0\t0\t0\tK.PEPTIDEK.A\tP1\tDECOY_P2")
+  TEST_EQUAL(lines[2], "scan=2\t-1\t2\t1\t0\t0\t1\tK.PEPTIDEK.A\tP1\tDECOY_P2")
+  TEST_EQUAL(lines[4], "scan=5\t1\t5\t1\t0\t0\t4\tK.PEPTIDEK.A\tP1\tDECOY_P2")
+  TEST_EQUAL(lines[900].hasPrefix("scan=1000\t-1\t1000\t"), true)
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
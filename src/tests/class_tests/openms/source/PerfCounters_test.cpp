@@ -0,0 +1,131 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg$
+// $Authors: Timo Sachsenberg$
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/CONCEPT/PerfCounters.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <thread>
+/////////////////////////////////////////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(PerfCounters, "$Id$")
+
+/////////////////////////////////////////////////////////////
+
+START_SECTION(static void setEnabled(bool enabled))
+  TEST_EQUAL(PerfCounters::isEnabled(), false)
+  // disabled: nothing is counted
+  PerfCounters::add(PerfCounters::SPECTRA_DECODED, 5);
+  TEST_EQUAL(PerfCounters::getTotalCounts()[PerfCounters::SPECTRA_DECODED], 0)
+  PerfCounters::setEnabled(true);
+  TEST_EQUAL(PerfCounters::isEnabled(), true)
+END_SECTION
+
+START_SECTION(static bool isEnabled())
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(static void add(Counter counter, UInt64 count = 1))
+  PerfCounters::add(PerfCounters::SPECTRA_DECODED);
+  PerfCounters::add(PerfCounters::SPECTRA_DECODED, 2);
+  PerfCounters::add(PerfCounters::BYTES_DECOMPRESSED, 1000);
+  PerfCounters::Counts total = PerfCounters::getTotalCounts();
+  TEST_EQUAL(total[PerfCounters::SPECTRA_DECODED], 3)
+  TEST_EQUAL(total[PerfCounters::BYTES_DECOMPRESSED], 1000)
+  TEST_EQUAL(total[PerfCounters::CACHE_HITS], 0)
+END_SECTION
+
+START_SECTION(static std::vector<Counts> getThreadCounts())
+  // counts of other threads are kept (also after they ended)
+  std::thread([]() { PerfCounters::add(PerfCounters::CANDIDATES_SCORED, 7); }).join();
+  vector<PerfCounters::Counts> counts = PerfCounters::getThreadCounts();
+  TEST_EQUAL(counts.size(), 2)
+  TEST_EQUAL(counts[0][PerfCounters::SPECTRA_DECODED], 3)
+  TEST_EQUAL(counts[0][PerfCounters::CANDIDATES_SCORED], 0)
+  TEST_EQUAL(counts[1][PerfCounters::SPECTRA_DECODED], 0)
+  TEST_EQUAL(counts[1][PerfCounters::CANDIDATES_SCORED], 7)
+END_SECTION
+
+START_SECTION(static Counts getTotalCounts())
+  TEST_EQUAL(PerfCounters::getTotalCounts()[PerfCounters::CANDIDATES_SCORED], 7)
+END_SECTION
+
+START_SECTION([EXTRA] counting in parallel)
+  TaskScheduler::parallelFor(0, 10000, [](SignedSize)
+  {
+    PerfCounters::add(PerfCounters::CACHE_MISSES);
+  }, 10);
+  TEST_EQUAL(PerfCounters::getTotalCounts()[PerfCounters::CACHE_MISSES], 10000)
+END_SECTION
+
+START_SECTION(LockWait())
+  std::mutex m;
+  PerfCounters::LockWait wait;
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  {
+    std::lock_guard<std::mutex> lock(m);
+    wait.acquired();
+    wait.acquired(); // only the first call counts
+  }
+  PerfCounters::Counts total = PerfCounters::getTotalCounts();
+  TEST_EQUAL(total[PerfCounters::LOCK_ACQUISITIONS], 1)
+  TEST_EQUAL(total[PerfCounters::LOCK_WAIT_NS] >= 2000000, true)
+
+  // not measured if disabled on construction
+  PerfCounters::setEnabled(false);
+  PerfCounters::LockWait ignored;
+  PerfCounters::setEnabled(true);
+  ignored.acquired();
+  TEST_EQUAL(PerfCounters::getTotalCounts()[PerfCounters::LOCK_ACQUISITIONS], 1)
+END_SECTION
+
+START_SECTION(void LockWait::acquired())
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(static void storeJSON(const String& filename, const String& tool = ""))
+  String filename;
+  NEW_TMP_FILE(filename)
+  PerfCounters::storeJSON(filename, "TestTool");
+  ifstream is(filename.c_str());
+  nlohmann::json doc = nlohmann::json::parse(is);
+  TEST_EQUAL(doc["tool"].get<std::string>(), "TestTool")
+  TEST_EQUAL(doc["totals"]["spectra_decoded"].get<UInt64>(), 3)
+  TEST_EQUAL(doc["totals"]["candidates_scored"].get<UInt64>(), 7)
+  TEST_EQUAL(doc["totals"].size(), PerfCounters::SIZE_OF_COUNTER)
+  ABORT_IF(doc["threads"].size() < 2)
+  TEST_EQUAL(doc["threads"][0]["thread"].get<Size>(), 0)
+  TEST_EQUAL(doc["threads"][1]["counters"]["candidates_scored"].get<UInt64>(), 7)
+
+  TEST_EXCEPTION(Exception::UnableToCreateFile, PerfCounters::storeJSON("/does/not/exist/counters.json"))
+END_SECTION
+
+START_SECTION(static void reset())
+  PerfCounters::reset();
+  PerfCounters::Counts total = PerfCounters::getTotalCounts();
+  for (Size i = 0; i < PerfCounters::SIZE_OF_COUNTER; ++i)
+  {
+    TEST_EQUAL(total[i], 0)
+  }
+  PerfCounters::setEnabled(false);
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -0,0 +1,148 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg$
+// $Authors: Timo Sachsenberg$
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/CONCEPT/ProgressProfiler.h>
+#include <OpenMS/CONCEPT/ProgressLogger.h>
+
+#include <nlohmann/json.hpp>
+
+#include <fstream>
+/////////////////////////////////////////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(ProgressProfiler, "$Id$")
+
+/////////////////////////////////////////////////////////////
+
+START_SECTION(static void setEnabled(bool enabled))
+  TEST_EQUAL(ProgressProfiler::isEnabled(), false)
+  // disabled: nothing is recorded
+  ProgressProfiler::beginScope("ignored");
+  ProgressProfiler::endScope();
+  TEST_EQUAL(ProgressProfiler::getRecords().size(), 0)
+  ProgressProfiler::setEnabled(true);
+  TEST_EQUAL(ProgressProfiler::isEnabled(), true)
+END_SECTION
+
+START_SECTION(static bool isEnabled())
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(static void beginScope(const String& label))
+  ProgressProfiler::beginScope("outer");
+  ProgressProfiler::beginScope("inner");
+  ProgressProfiler::endScope(1024);
+  ProgressProfiler::endScope();
+  // unmatched calls are ignored
+  ProgressProfiler::endScope();
+
+  vector<ProgressProfiler::Record> records = ProgressProfiler::getRecords();
+  ABORT_IF(records.size() != 2)
+  TEST_EQUAL(records[0].label, "outer")
+  TEST_EQUAL(records[0].depth, 0)
+  TEST_EQUAL(records[0].bytes_processed, 0)
+  TEST_EQUAL(records[1].label, "inner")
+  TEST_EQUAL(records[1].depth, 1)
+  TEST_EQUAL(records[1].bytes_processed, 1024)
+  TEST_EQUAL(records[0].thread, records[1].thread)
+  TEST_EQUAL(records[0].start <= records[1].start, true)
+  TEST_EQUAL(records[0].wall_time >= records[1].wall_time, true)
+  TEST_EQUAL(records[1].cpu_time >= 0.0, true)
+END_SECTION
+
+START_SECTION(static void endScope(UInt64 bytes_processed = 0))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(static std::vector<Record> getRecords())
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(static void clear())
+  ProgressProfiler::clear();
+  TEST_EQUAL(ProgressProfiler::getRecords().size(), 0)
+END_SECTION
+
+START_SECTION([ProgressProfiler::Scope] Scope(const String& label))
+  {
+    ProgressProfiler::Scope scope("scope");
+    scope.setBytesProcessed(7);
+  }
+  vector<ProgressProfiler::Record> records = ProgressProfiler::getRecords();
+  ABORT_IF(records.size() != 1)
+  TEST_EQUAL(records[0].label, "scope")
+  TEST_EQUAL(records[0].bytes_processed, 7)
+  ProgressProfiler::clear();
+END_SECTION
+
+START_SECTION([ProgressProfiler::Scope] void setBytesProcessed(UInt64 bytes))
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION([EXTRA] scopes of ProgressLogger)
+  ProgressLogger pl; // log type NONE, but still profiled
+  pl.startProgress(0, 10, "loading");
+  pl.startProgress(0, 10, "parsing");
+  pl.endProgress(100);
+  pl.endProgress();
+
+  vector<ProgressProfiler::Record> records = ProgressProfiler::getRecords();
+  ABORT_IF(records.size() != 2)
+  TEST_EQUAL(records[0].label, "loading")
+  TEST_EQUAL(records[0].depth, 0)
+  TEST_EQUAL(records[1].label, "parsing")
+  TEST_EQUAL(records[1].depth, 1)
+  TEST_EQUAL(records[1].bytes_processed, 100)
+END_SECTION
+
+START_SECTION(static void storeJSON(const String& filename))
+  String filename;
+  NEW_TMP_FILE(filename)
+  ProgressProfiler::storeJSON(filename);
+  ifstream is(filename.c_str());
+  nlohmann::json doc = nlohmann::json::parse(is);
+  ABORT_IF(doc["threads"].size() != 1)
+  const nlohmann::json& scopes = doc["threads"][0]["scopes"];
+  ABORT_IF(scopes.size() != 1)
+  TEST_EQUAL(scopes[0]["label"].get<std::string>(), "loading")
+  ABORT_IF(scopes[0]["children"].size() != 1)
+  TEST_EQUAL(scopes[0]["children"][0]["label"].get<std::string>(), "parsing")
+  TEST_EQUAL(scopes[0]["children"][0]["bytes_processed"].get<UInt64>(), 100)
+  TEST_EQUAL(scopes[0]["children"][0]["children"].size(), 0)
+
+  TEST_EXCEPTION(Exception::UnableToCreateFile, ProgressProfiler::storeJSON("/does/not/exist/profile.json"))
+END_SECTION
+
+START_SECTION(static void storeTraceEvents(const String& filename))
+  String filename;
+  NEW_TMP_FILE(filename)
+  ProgressProfiler::storeTraceEvents(filename);
+  ifstream is(filename.c_str());
+  nlohmann::json doc = nlohmann::json::parse(is);
+  const nlohmann::json& events = doc["traceEvents"];
+  ABORT_IF(events.size() != 2)
+  TEST_EQUAL(events[0]["name"].get<std::string>(), "loading")
+  TEST_EQUAL(events[0]["ph"].get<std::string>(), "X")
+  TEST_EQUAL(events[1]["name"].get<std::string>(), "parsing")
+  TEST_EQUAL(events[1]["args"]["bytes_processed"].get<UInt64>(), 100)
+  TEST_EQUAL(events[0]["ts"].get<double>() <= events[1]["ts"].get<double>(), true)
+
+  ProgressProfiler::setEnabled(false);
+  ProgressProfiler::clear();
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -0,0 +1,168 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/ID/ProteinSuffixIndex.h>
+///////////////////////////
+
+#include <fstream>
+#include <iterator>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(ProteinSuffixIndex, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+ProteinSuffixIndex* ptr = nullptr;
+ProteinSuffixIndex* nullPointer = nullptr;
+
+START_SECTION((ProteinSuffixIndex()))
+{
+  ptr = new ProteinSuffixIndex();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->getNumberOfProteins(), 0)
+  TEST_EQUAL(ptr->countOccurrences("PEPTIDE"), 0)
+}
+END_SECTION
+
+START_SECTION((~ProteinSuffixIndex()))
+{
+  delete ptr;
+}
+END_SECTION
+
+std::vector<FASTAFile::FASTAEntry> proteins;
+proteins.emplace_back("P1", "", "MPEPTIDERAAAAAAK");
+proteins.emplace_back("P2", "", "peptlderpeptider");
+proteins.emplace_back("P3", "", "");
+proteins.emplace_back("P4", "", "AAAA");
+
+using Occ = ProteinSuffixIndex::Occurrence;
+
+START_SECTION((void build(const std::vector<FASTAFile::FASTAEntry>& proteins, bool IL_equivalent = true)))
+{
+  ProteinSuffixIndex index;
+  index.build(proteins);
+  TEST_EQUAL(index.getNumberOfProteins(), 4)
+  TEST_EQUAL(index.isILEquivalent(), true)
+  TEST_EQUAL(index.getAccession(3), "P4")
+
+  ProteinSuffixIndex exact;
+  exact.build(proteins, false);
+  TEST_EQUAL(exact.isILEquivalent(), false)
+  TEST_EQUAL(exact.countOccurrences("PEPTIDER"), 2)
+  TEST_EQUAL(index.countOccurrences("PEPTIDER"), 3)
+}
+END_SECTION
+
+START_SECTION((std::vector<Occurrence> findPeptide(const String& peptide) const))
+{
+  ProteinSuffixIndex index;
+  index.build(proteins);
+  std::vector<Occ> expected = {{0, 1}, {1, 0}, {1, 8}};
+  TEST_EQUAL(index.findPeptide("PEPTLDER") == expected, true)
+  TEST_EQUAL(index.findPeptide("peptider") == expected, true)
+  // overlapping hits and no hits across proteins
+  expected = {{0, 9}, {0, 10}, {0, 11}, {3, 0}};
+  TEST_EQUAL(index.findPeptide("AAAA") == expected, true)
+  TEST_EQUAL(index.findPeptide("AAKAAA").empty(), true)
+  TEST_EQUAL(index.findPeptide("K").size(), 1)
+  TEST_EQUAL(index.findPeptide("").empty(), true)
+  TEST_EQUAL(index.findPeptide("R$P").empty(), true)
+  TEST_EQUAL(index.findPeptide("MPEPTIDERAAAAAAKX").empty(), true)
+
+  // compare to a naive search
+  for (const String pep : {"P", "EP", "PEP", "DER", "A", "AA", "AAAAAAK", "ERPEP", "W"})
+  {
+    std::vector<Occ> naive;
+    for (Size p = 0; p < proteins.size(); ++p)
+    {
+      String seq = proteins[p].sequence;
+      seq.toUpper().substitute('I', 'L');
+      for (Size pos = seq.find(pep); pos != String::npos; pos = seq.find(pep, pos + 1))
+      {
+        naive.push_back({uint32_t(p), uint32_t(pos)});
+      }
+    }
+    TEST_EQUAL(index.findPeptide(pep) == naive, true)
+    TEST_EQUAL(index.countOccurrences(pep), naive.size())
+  }
+}
+END_SECTION
+
+START_SECTION((Size countOccurrences(const String& peptide) const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((Size getNumberOfProteins() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((const String& getAccession(Size index) const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((bool isILEquivalent() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((void store(const String& filename) const))
+{
+  NOT_TESTABLE // tested below
+}
+END_SECTION
+
+START_SECTION((void load(const String& filename)))
+{
+  ProteinSuffixIndex index;
+  index.build(proteins, false);
+  String filename;
+  NEW_TMP_FILE(filename)
+  index.store(filename);
+
+  ProteinSuffixIndex loaded;
+  loaded.load(filename);
+  TEST_EQUAL(loaded.getNumberOfProteins(), 4)
+  TEST_EQUAL(loaded.isILEquivalent(), false)
+  TEST_EQUAL(loaded.getAccession(1), "P2")
+  TEST_EQUAL(loaded.findPeptide("PEPTIDER") == index.findPeptide("PEPTIDER"), true)
+  TEST_EQUAL(loaded.findPeptide("AAAA") == index.findPeptide("AAAA"), true)
+
+  TEST_EXCEPTION(Exception::FileNotFound, loaded.load("this_file_does_not_exist.psi"))
+  // not an index file
+  String fasta;
+  NEW_TMP_FILE(fasta)
+  std::ofstream(fasta.c_str()) << ">P1\nPEPTIDER\n";
+  TEST_EXCEPTION(Exception::ParseError, loaded.load(fasta))
+  // truncated index file
+  {
+    std::ifstream is(filename.c_str(), std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+    std::ofstream(filename.c_str(), std::ios::binary | std::ios::trunc) << content.substr(0, content.size() / 2);
+  }
+  TEST_EXCEPTION(Exception::ParseError, loaded.load(filename))
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -79,6 +79,12 @@ START_TEST(SpectraMap, "$Id$")
   START_SECTION(QCBase::SpectraMap::size())
     NOT_TESTABLE;
   END_SECTION
+
+  START_SECTION(QCBase::SpectraMap::contains(const String& identifier))
+    QCBase::SpectraMap spec_map(exp);
+    TEST_EQUAL(spec_map.contains("XTandem::1"), true);
+    TEST_EQUAL(spec_map.contains("XTandem::15"), false);
+  END_SECTION
   
 END_TEST
 
@@ -0,0 +1,232 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/QC/QCEngine.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/QC/PeptideMass.h>
+///////////////////////////
+
+#include <atomic>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(QCEngine, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+QCEngine* ptr = nullptr;
+QCEngine* nullPointer = nullptr;
+START_SECTION(QCEngine())
+{
+  ptr = new QCEngine();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->getNrSpectrumVisitors(), 0)
+  TEST_EQUAL(ptr->getNrPSMVisitors(), 0)
+}
+END_SECTION
+
+START_SECTION(~QCEngine())
+{
+  delete ptr;
+}
+END_SECTION
+
+// 100 spectra; feature i has PSMs referencing spectrum i and (for even i) one without a reference
+MSExperiment exp;
+FeatureMap fmap;
+for (Size i = 0; i < 100; ++i)
+{
+  MSSpectrum spec;
+  spec.setNativeID(String("spec=") + i);
+  spec.setRT(double(i));
+  exp.addSpectrum(spec);
+
+  PeptideIdentification pep_id;
+  pep_id.setSpectrumReference(String("spec=") + i);
+  Feature f;
+  f.getPeptideIdentifications().push_back(pep_id);
+  if (i % 2 == 0)
+  {
+    f.getPeptideIdentifications().push_back(PeptideIdentification());
+  }
+  fmap.push_back(f);
+}
+PeptideIdentification unassigned;
+unassigned.setSpectrumReference("spec=unknown");
+fmap.getUnassignedPeptideIdentifications().push_back(unassigned);
+QCBase::SpectraMap spec_map(exp);
+
+START_SECTION(void addSpectrumVisitor(const SpectrumVisitor& visitor, bool thread_safe = false))
+{
+  QCEngine engine;
+  engine.addSpectrumVisitor([](const MSSpectrum&, Size) {});
+  engine.addSpectrumVisitor([](const MSSpectrum&, Size) {}, true);
+  TEST_EQUAL(engine.getNrSpectrumVisitors(), 2)
+}
+END_SECTION
+
+START_SECTION(void addPSMVisitor(const PSMVisitor& visitor, bool thread_safe = false))
+{
+  QCEngine engine;
+  engine.addPSMVisitor([](PeptideIdentification&, const Feature*, const MSSpectrum*) {});
+  TEST_EQUAL(engine.getNrPSMVisitors(), 1)
+}
+END_SECTION
+
+START_SECTION(void addFinishCallback(const FinishCallback& callback))
+{
+  NOT_TESTABLE // tested below
+}
+END_SECTION
+
+START_SECTION(Size getNrSpectrumVisitors() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(Size getNrPSMVisitors() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(void clear())
+{
+  QCEngine engine;
+  engine.addSpectrumVisitor([](const MSSpectrum&, Size) {});
+  engine.addPSMVisitor([](PeptideIdentification&, const Feature*, const MSSpectrum*) {});
+  engine.clear();
+  TEST_EQUAL(engine.getNrSpectrumVisitors(), 0)
+  TEST_EQUAL(engine.getNrPSMVisitors(), 0)
+}
+END_SECTION
+
+START_SECTION(void run(const MSExperiment& exp, FeatureMap& fmap, const QCBase::SpectraMap& map_to_spectrum) const)
+{
+  for (bool thread_safe : {false, true})
+  {
+    std::atomic<Size> nr_spectra(0);
+    std::atomic<Size> index_sum(0);
+    std::atomic<Size> nr_psms(0);
+    std::atomic<Size> nr_with_spectrum(0);
+    std::atomic<Size> nr_unassigned(0);
+    std::atomic<Size> nr_matching(0);
+    std::atomic<Size> nr_in_order(0);
+    Size finished = 0;
+
+    QCEngine engine;
+    engine.addSpectrumVisitor([&](const MSSpectrum&, Size index) { ++nr_spectra; index_sum += index; }, thread_safe);
+    engine.addPSMVisitor(
+      [&](PeptideIdentification& pep_id, const Feature* feature, const MSSpectrum* spectrum) {
+        ++nr_psms;
+        if (feature == nullptr) ++nr_unassigned;
+        if (spectrum != nullptr)
+        {
+          ++nr_with_spectrum;
+          if (spectrum->getNativeID() == pep_id.getSpectrumReference()) ++nr_matching;
+        }
+        pep_id.setMetaValue("visited", 1);
+      },
+      thread_safe);
+    // visitors are called in order
+    engine.addPSMVisitor([&](PeptideIdentification& pep_id, const Feature*, const MSSpectrum*) { if (pep_id.metaValueExists("visited")) ++nr_in_order; }, thread_safe);
+    engine.addFinishCallback([&]() { finished = nr_psms; });
+
+    engine.run(exp, fmap, spec_map);
+    TEST_EQUAL(nr_spectra, 100)
+    TEST_EQUAL(index_sum, 4950)
+    TEST_EQUAL(nr_psms, 151)
+    TEST_EQUAL(nr_with_spectrum, 100)
+    TEST_EQUAL(nr_matching, 100)
+    TEST_EQUAL(nr_unassigned, 1)
+    TEST_EQUAL(nr_in_order, 151)
+    TEST_EQUAL(finished, 151)
+  }
+
+  // without spectra, PSMs get no spectrum
+  Size nr_with_spectrum = 0;
+  QCEngine engine;
+  engine.addPSMVisitor([&](PeptideIdentification&, const Feature*, const MSSpectrum* spectrum) { if (spectrum != nullptr) ++nr_with_spectrum; });
+  engine.run(MSExperiment(), fmap, QCBase::SpectraMap());
+  TEST_EQUAL(nr_with_spectrum, 0)
+
+  // exceptions of visitors are passed on (also from parallel passes)
+  QCEngine failing;
+  failing.addPSMVisitor(
+    [](PeptideIdentification& pep_id, const Feature*, const MSSpectrum*) {
+      if (pep_id.getSpectrumReference() == "spec=50") throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "test", "spec=50");
+    },
+    true);
+  TEST_EXCEPTION(Exception::InvalidValue, failing.run(exp, fmap, spec_map))
+
+  // metrics register their visitors
+  fmap[0].getPeptideIdentifications()[0].insertHit(PeptideHit(1.0, 1, 2, AASequence::fromString("PEPTIDE")));
+  fmap[0].getPeptideIdentifications()[0].setMZ(500.0);
+  QCEngine metrics;
+  PeptideMass().addVisitors(metrics);
+  metrics.run(exp, fmap, spec_map);
+  TEST_EQUAL(fmap[0].getPeptideIdentifications()[0].getHits()[0].metaValueExists("mass"), true)
+}
+END_SECTION
+
+START_SECTION(void run(const MSExperiment& exp) const)
+{
+  Size nr_spectra = 0;
+  Size nr_finished = 0;
+  QCEngine engine;
+  engine.addSpectrumVisitor([&](const MSSpectrum&, Size) { ++nr_spectra; });
+  engine.addFinishCallback([&]() { ++nr_finished; });
+  engine.run(exp);
+  TEST_EQUAL(nr_spectra, 100)
+  TEST_EQUAL(nr_finished, 1)
+}
+END_SECTION
+
+START_SECTION(void visitSpectrum(const MSSpectrum& spectrum, Size index) const)
+{
+  Size last_index = 0;
+  QCEngine engine;
+  engine.addSpectrumVisitor([&](const MSSpectrum&, Size index) { last_index = index; });
+  engine.visitSpectrum(exp[5], 5);
+  TEST_EQUAL(last_index, 5)
+}
+END_SECTION
+
+START_SECTION(void visitPSM(PeptideIdentification& pep_id, const Feature* feature, const MSSpectrum* spectrum) const)
+{
+  const MSSpectrum* seen = nullptr;
+  QCEngine engine;
+  engine.addPSMVisitor([&](PeptideIdentification&, const Feature*, const MSSpectrum* spectrum) { seen = spectrum; });
+  PeptideIdentification pep_id;
+  engine.visitPSM(pep_id, nullptr, &exp[3]);
+  TEST_EQUAL(seen, &exp[3])
+}
+END_SECTION
+
+START_SECTION(void finish() const)
+{
+  Size nr_finished = 0;
+  QCEngine engine;
+  engine.addFinishCallback([&]() { ++nr_finished; });
+  engine.addFinishCallback([&]() { ++nr_finished; });
+  engine.finish();
+  TEST_EQUAL(nr_finished, 2)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -0,0 +1,211 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Axel Walter $
+// $Authors: Axel Walter $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/QC/QCMetricAccumulator.h>
+///////////////////////////
+
+#include <fstream>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(QCMetricAccumulator, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+QCMetricAccumulator* ptr = nullptr;
+QCMetricAccumulator* nullPointer = nullptr;
+START_SECTION(QCMetricAccumulator(double relative_accuracy = 0.01))
+{
+  ptr = new QCMetricAccumulator();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_REAL_SIMILAR(ptr->getRelativeAccuracy(), 0.01)
+  TEST_EXCEPTION(Exception::InvalidValue, QCMetricAccumulator(2.0))
+}
+END_SECTION
+
+START_SECTION(~QCMetricAccumulator())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(void Summary::add(double value))
+{
+  QCMetricAccumulator::Summary s;
+  for (double v : {2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0})
+  {
+    s.add(v);
+  }
+  s.add(std::nan(""));
+  TEST_EQUAL(s.getCount(), 8)
+  TEST_REAL_SIMILAR(s.getMean(), 5.0)
+  TEST_REAL_SIMILAR(s.getVariance(), 32.0 / 7.0)
+  TEST_REAL_SIMILAR(s.getMin(), 2.0)
+  TEST_REAL_SIMILAR(s.getMax(), 9.0)
+  // median at rank 3.5 of the sorted values (within the relative accuracy)
+  TOLERANCE_RELATIVE(1.011)
+  TEST_REAL_SIMILAR(s.getQuantile(0.5), 4.0)
+  TOLERANCE_RELATIVE(1.00001)
+  TEST_REAL_SIMILAR(QCMetricAccumulator::Summary().getVariance(), 0.0)
+}
+END_SECTION
+
+START_SECTION(void Summary::merge(const Summary& other))
+{
+  QCMetricAccumulator::Summary all, a, b;
+  for (Size i = 0; i < 100; ++i)
+  {
+    double v = double(i * i % 37);
+    all.add(v);
+    (i < 30 ? a : b).add(v);
+  }
+  a.merge(b);
+  TEST_EQUAL(a.getCount(), 100)
+  TEST_REAL_SIMILAR(a.getMean(), all.getMean())
+  TEST_REAL_SIMILAR(a.getVariance(), all.getVariance())
+  TEST_EQUAL(a.getSketch() == all.getSketch(), true)
+  // merging into an empty summary
+  QCMetricAccumulator::Summary empty;
+  empty.merge(all);
+  TEST_REAL_SIMILAR(empty.getMean(), all.getMean())
+  TEST_REAL_SIMILAR(empty.getVariance(), all.getVariance())
+  TEST_EXCEPTION(Exception::IllegalArgument, a.merge(QCMetricAccumulator::Summary(0.1)))
+}
+END_SECTION
+
+START_SECTION(void addRun(const String& label))
+{
+  QCMetricAccumulator acc;
+  acc.addRun("run1.mzML");
+  TEST_EQUAL(acc.getRuns().size(), 1)
+  TEST_EQUAL(acc.getRuns()[0], "run1.mzML")
+  TEST_EQUAL(acc.empty(), false)
+}
+END_SECTION
+
+START_SECTION(void add(const String& accession, double value))
+{
+  QCMetricAccumulator acc;
+  acc.add("QC:4000059", 100.0);
+  acc.add("QC:4000059", 200.0);
+  acc.add("QC:4000060", 50.0);
+  TEST_EQUAL(acc.getMetrics().size(), 2)
+  TEST_EQUAL(acc.getMetrics().at("QC:4000059").getCount(), 2)
+  TEST_REAL_SIMILAR(acc.getMetrics().at("QC:4000059").getMean(), 150.0)
+}
+END_SECTION
+
+QCMetricAccumulator run1, run2, run3;
+run1.addRun("run1");
+run1.add("QC:4000059", 100.0);
+run1.add("QC:4000060", 1000.0);
+run2.addRun("run2");
+run2.add("QC:4000059", 120.0);
+run3.addRun("run3");
+run3.add("QC:4000059", 80.0);
+run3.add("QC:4000060", 1500.0);
+
+START_SECTION(void merge(const QCMetricAccumulator& other))
+{
+  QCMetricAccumulator cohort;
+  cohort.merge(run1);
+  cohort.merge(run2);
+  cohort.merge(run3);
+  TEST_EQUAL(cohort.getRuns().size(), 3)
+  TEST_EQUAL(cohort.getRuns()[2], "run3")
+  const auto& spectra = cohort.getMetrics().at("QC:4000059");
+  TEST_EQUAL(spectra.getCount(), 3)
+  TEST_REAL_SIMILAR(spectra.getMean(), 100.0)
+  TEST_REAL_SIMILAR(spectra.getVariance(), 400.0)
+  TEST_REAL_SIMILAR(spectra.getMin(), 80.0)
+  TEST_REAL_SIMILAR(spectra.getMax(), 120.0)
+  TEST_EQUAL(cohort.getMetrics().at("QC:4000060").getCount(), 2)
+
+  // incremental: merging partial cohorts gives the same result
+  QCMetricAccumulator part1, part2;
+  part1.merge(run1);
+  part1.merge(run2);
+  part2.merge(run3);
+  part1.merge(part2);
+  TEST_EQUAL(part1 == cohort, true)
+
+  TEST_EXCEPTION(Exception::IllegalArgument, cohort.merge(QCMetricAccumulator(0.05)))
+}
+END_SECTION
+
+START_SECTION(void store(const String& filename) const)
+{
+  QCMetricAccumulator cohort;
+  cohort.merge(run1);
+  cohort.merge(run3);
+  cohort.add("negative", -3.5);
+  cohort.add("zero", 0.0);
+  String filename;
+  NEW_TMP_FILE(filename)
+  cohort.store(filename);
+
+  QCMetricAccumulator loaded;
+  loaded.load(filename);
+  TEST_EQUAL(loaded == cohort, true)
+  // loaded accumulators can be merged further
+  loaded.merge(run2);
+  TEST_EQUAL(loaded.getRuns().size(), 3)
+  TEST_EQUAL(loaded.getMetrics().at("QC:4000059").getCount(), 3)
+  TEST_REAL_SIMILAR(loaded.getMetrics().at("QC:4000059").getMean(), 100.0)
+
+  TEST_EXCEPTION(Exception::UnableToCreateFile, cohort.store("/does/not/exist/acc.json"))
+}
+END_SECTION
+
+START_SECTION(void load(const String& filename))
+{
+  QCMetricAccumulator acc;
+  TEST_EXCEPTION(Exception::FileNotFound, acc.load("/does/not/exist/acc.json"))
+  String filename;
+  NEW_TMP_FILE(filename)
+  {
+    std::ofstream os(filename.c_str());
+    os << "{\"version\": 1, \"runs\": []}";
+  }
+  TEST_EXCEPTION(Exception::ParseError, acc.load(filename))
+}
+END_SECTION
+
+START_SECTION(bool operator==(const QCMetricAccumulator& rhs) const)
+{
+  TEST_EQUAL(QCMetricAccumulator() == QCMetricAccumulator(), true)
+  TEST_EQUAL(run1 == run2, false)
+}
+END_SECTION
+
+START_SECTION(const std::vector<String>& getRuns() const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(const Metrics& getMetrics() const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(double getRelativeAccuracy() const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(bool empty() const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -186,6 +186,9 @@ START_SECTION((QTCluster::Elements getAllNeighbors() const))
     TEST_EQUAL(neighbors[0].feature, &gf3);
     TEST_EQUAL(neighbors[1].feature, &gf4);
   }
+  // neighbors are reported in the order of their map indices
+  TEST_EQUAL(neighbors[0].map_index, 222)
+  TEST_EQUAL(neighbors[1].map_index, 789)
 }
 END_SECTION
 
@@ -0,0 +1,163 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg$
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/MATH/STATISTICS/QuantileSketch.h>
+///////////////////////////
+
+#include <cmath>
+
+using namespace OpenMS;
+using namespace OpenMS::Math;
+using namespace std;
+
+START_TEST(QuantileSketch, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+QuantileSketch* ptr = nullptr;
+QuantileSketch* nullPointer = nullptr;
+START_SECTION(QuantileSketch(double relative_accuracy = 0.01))
+{
+  ptr = new QuantileSketch();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_REAL_SIMILAR(ptr->getRelativeAccuracy(), 0.01)
+  TEST_EXCEPTION(Exception::InvalidValue, QuantileSketch(0.0))
+  TEST_EXCEPTION(Exception::InvalidValue, QuantileSketch(1.0))
+}
+END_SECTION
+
+START_SECTION(~QuantileSketch())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(void add(double value, UInt64 count = 1))
+{
+  QuantileSketch sketch;
+  sketch.add(5.0);
+  sketch.add(-2.0, 3);
+  sketch.add(0.0);
+  sketch.add(std::nan(""));
+  sketch.add(7.0, 0);
+  TEST_EQUAL(sketch.getCount(), 5)
+  TEST_EQUAL(sketch.getZeroCount(), 1)
+  TEST_EQUAL(sketch.getPositiveBins().size(), 1)
+  TEST_EQUAL(sketch.getNegativeBins().begin()->second, 3)
+  TEST_REAL_SIMILAR(sketch.getMin(), -2.0)
+  TEST_REAL_SIMILAR(sketch.getMax(), 5.0)
+}
+END_SECTION
+
+START_SECTION(double getQuantile(double q) const)
+{
+  QuantileSketch sketch(0.01);
+  for (Size i = 1; i <= 1000; ++i)
+  {
+    sketch.add(double(i));
+  }
+  // exact quantile at rank q * (n - 1) is 1 + q * 999
+  for (double q : {0.0, 0.05, 0.25, 0.5, 0.75, 0.95, 1.0})
+  {
+    double exact = 1.0 + q * 999.0;
+    TEST_EQUAL(std::fabs(sketch.getQuantile(q) - exact) <= 0.01 * exact + 1.0, true)
+  }
+  TEST_REAL_SIMILAR(sketch.getQuantile(0.0), 1.0)
+  TEST_REAL_SIMILAR(sketch.getQuantile(1.0), 1000.0)
+
+  QuantileSketch mixed;
+  mixed.add(-10.0);
+  mixed.add(0.0);
+  mixed.add(10.0);
+  TEST_REAL_SIMILAR(mixed.getQuantile(0.5), 0.0)
+  TEST_EQUAL(mixed.getQuantile(0.0) < 0.0, true)
+
+  TEST_EXCEPTION(Exception::InvalidValue, sketch.getQuantile(1.5))
+  TEST_EXCEPTION(Exception::Precondition, QuantileSketch().getQuantile(0.5))
+}
+END_SECTION
+
+START_SECTION(void merge(const QuantileSketch& other))
+{
+  QuantileSketch all, first, second;
+  for (Size i = 0; i < 500; ++i)
+  {
+    double value = std::exp(double(i) / 50.0) - 20.0;
+    all.add(value);
+    (i % 3 == 0 ? first : second).add(value);
+  }
+  first.merge(second);
+  TEST_EQUAL(first == all, true)
+  first.merge(QuantileSketch());
+  TEST_EQUAL(first == all, true)
+  TEST_EXCEPTION(Exception::IllegalArgument, first.merge(QuantileSketch(0.05)))
+}
+END_SECTION
+
+START_SECTION((QuantileSketch(double relative_accuracy, const Bins& positive, const Bins& negative, UInt64 zero_count, double min, double max)))
+{
+  QuantileSketch sketch;
+  sketch.add(3.0, 2);
+  sketch.add(-1.0);
+  sketch.add(0.0);
+  QuantileSketch restored(sketch.getRelativeAccuracy(), sketch.getPositiveBins(), sketch.getNegativeBins(), sketch.getZeroCount(), sketch.getMin(), sketch.getMax());
+  TEST_EQUAL(restored == sketch, true)
+  TEST_EQUAL(restored.getCount(), 4)
+}
+END_SECTION
+
+START_SECTION(bool operator==(const QuantileSketch& rhs) const)
+{
+  QuantileSketch a, b;
+  TEST_EQUAL(a == b, true)
+  a.add(1.0);
+  TEST_EQUAL(a == b, false)
+}
+END_SECTION
+
+START_SECTION(UInt64 getCount() const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(bool empty() const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(double getMin() const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(double getMax() const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(double getRelativeAccuracy() const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(const Bins& getPositiveBins() const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(const Bins& getNegativeBins() const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+START_SECTION(UInt64 getZeroCount() const)
+  NOT_TESTABLE // tested above
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -12,6 +12,10 @@
 ///////////////////////////
 #include <OpenMS/ML/RANSAC/RANSAC.h>
 #include <OpenMS/ML/RANSAC/RANSACModelLinear.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 ///////////////////////////
 
 using namespace std;
@@ -422,6 +426,49 @@ if __name__=='__main__':
 }
 END_SECTION
 
+START_SECTION([EXTRA] parallel evaluation is independent of the number of threads)
+{
+  std::vector<std::pair<double, double> > noisy;
+  for (int i = 0; i < 200; ++i)
+  {
+    double x = i * 0.1;
+    noisy.push_back(make_pair(x, (i % 5 == 0) ? 50.0 * (i % 7) : 3.0 * x + 1.0)); // 20% outliers
+  }
+  std::vector<std::pair<double, double> > perfect;
+  for (int i = 0; i < 20; ++i)
+  {
+    perfect.push_back(make_pair(double(i), 2.0 * i));
+  }
+
+  int threads_before = 1;
+#ifdef _OPENMP
+  threads_before = omp_get_max_threads();
+  omp_set_num_threads(1);
+#endif
+  Math::RANSAC<Math::RansacModelLinear> serial(42);
+  std::vector<std::pair<double, double> > serial_noisy = serial.ransac(noisy, 2, 300, 0.25, 100, false);
+  // all points fit the first hypothesis: stops early, after a single shuffle
+  std::vector<std::pair<double, double> > serial_perfect = serial.ransac(perfect, 2, 300, 0.25, 5, false);
+  std::vector<std::pair<double, double> > serial_next = serial.ransac(noisy, 2, 300, 0.25, 100, false);
+#ifdef _OPENMP
+  omp_set_num_threads(4);
+#endif
+  Math::RANSAC<Math::RansacModelLinear> parallel(42);
+  TEST_EQUAL(parallel.ransac(noisy, 2, 300, 0.25, 100, false) == serial_noisy, true)
+  TEST_EQUAL(parallel.ransac(perfect, 2, 300, 0.25, 5, false) == serial_perfect, true)
+  // the random state after the early stop is the same as after a single iteration
+  TEST_EQUAL(parallel.ransac(noisy, 2, 300, 0.25, 100, false) == serial_next, true)
+#ifdef _OPENMP
+  omp_set_num_threads(threads_before);
+#endif
+  Math::RANSAC<Math::RansacModelLinear> single(42);
+  single.ransac(noisy, 2, 300, 0.25, 100, false);
+  single.ransac(perfect, 2, 1, 0.25, 5, false);
+  TEST_EQUAL(single.ransac(noisy, 2, 300, 0.25, 100, false) == serial_next, true)
+  TEST_EQUAL(serial_noisy.size() >= 160, true)
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -0,0 +1,134 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/ReadAheadBuffer.h>
+///////////////////////////
+
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <string>
+
+using namespace OpenMS;
+using namespace std;
+
+/// produces @p total bytes ("0123456789" repeated) in chunks of at most 7 bytes; throws at @p fail_at if set
+struct CountingProducer
+{
+  Size total;
+  Size fail_at;
+  Size pos = 0;
+
+  size_t operator()(char* s, size_t n, bool& end)
+  {
+    if (pos >= fail_at)
+    {
+      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "corrupted");
+    }
+    size_t count = min(min(n, size_t(7)), total - pos);
+    for (size_t i = 0; i < count; ++i)
+    {
+      s[i] = char('0' + (pos + i) % 10);
+    }
+    pos += count;
+    end = (pos == total);
+    return count;
+  }
+};
+
+string expected(Size total)
+{
+  string result;
+  for (Size i = 0; i < total; ++i)
+  {
+    result += char('0' + i % 10);
+  }
+  return result;
+}
+
+START_TEST(ReadAheadBuffer, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+ReadAheadBuffer* ptr = nullptr;
+ReadAheadBuffer* nullPointer = nullptr;
+START_SECTION(explicit ReadAheadBuffer(Producer producer, Size block_size = 1 << 20, Size max_blocks = 4))
+{
+  ptr = new ReadAheadBuffer(CountingProducer{100, Size(-1)});
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->atEnd(), false)
+}
+END_SECTION
+
+START_SECTION(~ReadAheadBuffer())
+{
+  delete ptr;
+  // stopping a reader thread that waits for space in the queue
+  ReadAheadBuffer buffer(CountingProducer{100000, Size(-1)}, 10, 2);
+  char c;
+  TEST_EQUAL(buffer.read(&c, 1), 1)
+}
+END_SECTION
+
+START_SECTION(size_t read(char* s, size_t n))
+{
+  // small blocks and a short queue: the reader thread has to wait for the consumer
+  ReadAheadBuffer buffer(CountingProducer{1000, Size(-1)}, 16, 2);
+  string result;
+  char chunk[33];
+  size_t count;
+  while ((count = buffer.read(chunk, 33)) == 33)
+  {
+    result.append(chunk, count);
+    TEST_EQUAL(buffer.atEnd(), false)
+  }
+  result.append(chunk, count);
+  TEST_EQUAL(count, 1000 % 33)
+  TEST_EQUAL(result == expected(1000), true)
+  TEST_EQUAL(buffer.atEnd(), true)
+  TEST_EQUAL(buffer.read(chunk, 33), 0)
+
+  // the read that returns the last bytes reaches the end, even if it is a full read
+  ReadAheadBuffer exact(CountingProducer{30, Size(-1)}, 16, 2);
+  TEST_EQUAL(exact.read(chunk, 29), 29)
+  TEST_EQUAL(exact.atEnd(), false)
+  TEST_EQUAL(exact.read(chunk, 1), 1)
+  TEST_EQUAL(exact.atEnd(), true)
+
+  // empty input
+  ReadAheadBuffer empty(CountingProducer{0, Size(-1)});
+  TEST_EQUAL(empty.read(chunk, 10), 0)
+  TEST_EQUAL(empty.atEnd(), true)
+
+  // errors are reported after the data read before the error
+  ReadAheadBuffer failing(CountingProducer{1000, 70}, 16, 2);
+  result.clear();
+  while ((count = failing.read(chunk, 10)) == 10)
+  {
+    result.append(chunk, count);
+  }
+  result.append(chunk, count);
+  TEST_EQUAL(result == expected(70).substr(0, result.size()), true)
+  TEST_EQUAL(result.size() <= 70, true)
+  TEST_EXCEPTION(Exception::ConversionError, failing.read(chunk, 10))
+}
+END_SECTION
+
+START_SECTION(bool atEnd() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
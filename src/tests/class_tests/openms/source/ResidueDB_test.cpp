@@ -85,6 +85,20 @@ START_SECTION(const Residue* getModifiedResidue(const Residue* residue, const St
 	const Residue* prot_nterm_mod_res = ptr->getModifiedResidue(ptr->getResidue("F"), "Deamidated (Protein N-term F)"); // <umod:specificity hidden="1" site="F" position="Protein N-term"
 	TEST_STRING_EQUAL(prot_nterm_mod_res->getOneLetterCode(), "F")
 	TEST_STRING_EQUAL(prot_nterm_mod_res->getModificationName(), "Deamidated")
+
+	// concurrent lookups (and creation) of modified residues return the same residue
+	std::vector<const Residue*> concurrent(100);
+#pragma omp parallel for
+	for (int i = 0; i < 100; ++i)
+	{
+		concurrent[i] = ptr->getModifiedResidue(ptr->getResidue(i % 2 ? "S" : "M"), i % 2 ? "Phospho (S)" : "Oxidation (M)");
+	}
+	for (Size i = 0; i < concurrent.size(); ++i)
+	{
+		TEST_EQUAL(concurrent[i] == concurrent[i % 2], true)
+	}
+	TEST_EQUAL(concurrent[0] == mod_res, true)
+	TEST_STRING_EQUAL(concurrent[1]->getModificationName(), "Phospho")
 END_SECTION
 
 START_SECTION((const std::set<const Residue*> getResidues(const String& residue_set="All") const))
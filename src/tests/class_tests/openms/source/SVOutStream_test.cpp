@@ -175,4 +175,68 @@ START_SECTION((template <typename NumericT> SVOutStream& writeValueOrNan(Numeric
 }
 END_SECTION
 
+START_SECTION((void setNumberFormat(NumberFormat format, int precision = 6)))
+{
+  stringstream strstr;
+  SVOutStream out(strstr, ",");
+  out << -1234567890123LL << 42u << short(-7) << nl;
+  out.setNumberFormat(SVOutStream::NUMBER_SHORTEST);
+  out << 3.14 << 0.1f << 1e300 << 0.0 << 12345.678 << nl;
+  out.setNumberFormat(SVOutStream::NUMBER_FIXED, 3);
+  out << 3.14159 << -0.5f << 12345.678 << 1e300 << 7 << nl;
+  out.writeValueOrNan(std::numeric_limits<double>::quiet_NaN());
+  out << nl;
+  // numbers that are too long for fixed notation are formatted as String
+  TEST_EQUAL(strstr.str(), "-1234567890123,42,-7\n3.14,0.1,1e+300,0,12345.678\n3.142,-0.500,12345.678," + String(1e300) + ",7\nnan\n");
+  TEST_EXCEPTION(Exception::IllegalArgument, out.setNumberFormat(SVOutStream::NUMBER_FIXED, -1))
+}
+END_SECTION
+
+START_SECTION((NumberFormat getNumberFormat() const))
+{
+  stringstream strstr;
+  SVOutStream out(strstr, ",");
+  TEST_EQUAL(out.getNumberFormat(), SVOutStream::NUMBER_STRING)
+  out.setNumberFormat(SVOutStream::NUMBER_SHORTEST);
+  TEST_EQUAL(out.getNumberFormat(), SVOutStream::NUMBER_SHORTEST)
+}
+END_SECTION
+
+START_SECTION((template <typename RowFunction> SVOutStream& writeRows(Size n_rows, const RowFunction& write_row, Size block_size = 256)))
+{
+  auto write_row = [](Size row, SVOutStream& out)
+  {
+    out << row << "row" << row * 0.5 << nl;
+  };
+
+  stringstream serial;
+  {
+    SVOutStream out(serial, ";", "_", String::NONE);
+    out.setNumberFormat(SVOutStream::NUMBER_FIXED, 2);
+    out << "#header" << nl;
+    for (Size row = 0; row < 1000; ++row)
+    {
+      write_row(row, out);
+    }
+  }
+
+  // the settings are passed on to the streams of the blocks, the order of the rows is kept
+  stringstream parallel;
+  SVOutStream out(parallel, ";", "_", String::NONE);
+  out.setNumberFormat(SVOutStream::NUMBER_FIXED, 2);
+  out << "#header" << nl;
+  out.writeRows(1000, write_row, 7);
+  TEST_EQUAL(parallel.str(), serial.str())
+  TEST_EQUAL(parallel.str().substr(8, 21), "0;row;0.00\n1;row;0.50")
+  out.writeRows(0, write_row);
+  TEST_EQUAL(parallel.str(), serial.str())
+
+  // rows must be complete lines
+  out << "incomplete";
+  TEST_EXCEPTION(Exception::IllegalArgument, out.writeRows(1, write_row))
+  out << nl;
+  TEST_EXCEPTION(Exception::IllegalArgument, out.writeRows(1, [](Size, SVOutStream& o) { o << "no newline"; }))
+}
+END_SECTION
+
 END_TEST
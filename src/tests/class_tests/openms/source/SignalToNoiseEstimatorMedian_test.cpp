@@ -88,6 +88,78 @@ START_SECTION([EXTRA](virtual void init(const Container& c)))
 
 END_SECTION
 
+START_SECTION([EXTRA](virtual void init(const Container& c) with exact_median))
+  // compare against a brute force median of each window
+  MSSpectrum raw_data;
+  for (Size i = 0; i < 200; ++i)
+  {
+    // unevenly spaced, with repeated intensities
+    raw_data.push_back(Peak1D(100.0 + i * 0.7 + (i % 3) * 0.2, float((i * 37) % 23 + (i % 5 == 0 ? 50 : 0))));
+  }
+
+  SignalToNoiseEstimatorMedian< MSSpectrum > sne;
+  Param p;
+  p.setValue("win_len", 10.0);
+  p.setValue("noise_for_empty_window", 2.0);
+  p.setValue("min_required_elements", 5);
+  p.setValue("exact_median", "true");
+  sne.setParameters(p);
+  sne.init(raw_data);
+
+  for (Size i = 0; i < raw_data.size(); ++i)
+  {
+    vector<double> window;
+    for (const Peak1D& peak : raw_data)
+    {
+      if (peak.getMZ() >= raw_data[i].getMZ() - 5.0 && peak.getMZ() <= raw_data[i].getMZ() + 5.0) window.push_back(peak.getIntensity());
+    }
+    sort(window.begin(), window.end());
+    double noise = window.size() < 5 ? 2.0 : max(1.0, window[(window.size() + 1) / 2 - 1]);
+    TEST_REAL_SIMILAR(sne.getSignalToNoise(i), raw_data[i].getIntensity() / noise)
+  }
+  TEST_REAL_SIMILAR(sne.getHistogramRightmostPercent(), 0.0)
+
+  // sparse windows
+  p.setValue("min_required_elements", 1000);
+  p.setValue("write_log_messages", "false");
+  sne.setParameters(p);
+  sne.init(raw_data);
+  TEST_REAL_SIMILAR(sne.getSignalToNoise(0), raw_data[0].getIntensity() / 2.0)
+  TEST_REAL_SIMILAR(sne.getSparseWindowPercent(), 100.0)
+END_SECTION
+
+START_SECTION((std::vector<std::vector<double>> estimateAll(const std::vector<Container>& containers) const))
+  MSSpectrum raw_data;
+  DTAFile dta_file;
+  dta_file.load(OPENMS_GET_TEST_DATA_PATH("SignalToNoiseEstimator_test.dta"), raw_data);
+  vector<MSSpectrum> spectra(5, raw_data);
+  spectra[1].clear(true);
+  spectra[3].resize(raw_data.size() / 2);
+
+  for (const String exact : {"false", "true"})
+  {
+    SignalToNoiseEstimatorMedian< MSSpectrum > sne;
+    Param p;
+    p.setValue("win_len", 40.0);
+    p.setValue("exact_median", exact);
+    p.setValue("write_log_messages", "false");
+    sne.setParameters(p);
+
+    vector<vector<double>> stn = sne.estimateAll(spectra);
+    TEST_EQUAL(stn.size(), spectra.size())
+    for (Size s = 0; s < spectra.size(); ++s)
+    {
+      TEST_EQUAL(stn[s].size(), spectra[s].size())
+      if (spectra[s].empty()) continue;
+      sne.init(spectra[s]);
+      for (Size i = 0; i < spectra[s].size(); ++i)
+      {
+        TEST_REAL_SIMILAR(stn[s][i], sne.getSignalToNoise(i))
+      }
+    }
+  }
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
@@ -218,6 +218,37 @@ START_SECTION((void writeXvalResults(const String& path) const))
 END_SECTION
 
 
+START_SECTION(cross_validation_on_sample)
+{
+  ABORT_IF(predictors.empty());
+  ABORT_IF(labels.empty());
+
+  SimpleSVM sample_svm;
+  Param param = sample_svm.getParameters();
+  param.setValue("xval_samples", 40);
+  param.setValue("log2_C", ListUtils::create<double>("-1,5"));
+  param.setValue("log2_gamma", ListUtils::create<double>("-5,-1"));
+  sample_svm.setParameters(param);
+  SimpleSVM::PredictorMap tmp(predictors);
+  sample_svm.setup(tmp, labels);
+
+  // the final model is trained on all observations:
+  vector<SimpleSVM::Prediction> predictions;
+  sample_svm.predict(predictions);
+  TEST_EQUAL(predictions.size(), predictors.begin()->second.size());
+
+  // results are reproducible (same partitions and sample):
+  string xval_file1, xval_file2;
+  NEW_TMP_FILE(xval_file1);
+  NEW_TMP_FILE(xval_file2);
+  sample_svm.writeXvalResults(xval_file1);
+  tmp = predictors;
+  sample_svm.setup(tmp, labels);
+  sample_svm.writeXvalResults(xval_file2);
+  TEST_FILE_EQUAL(xval_file1.c_str(), xval_file2.c_str())
+}
+END_SECTION
+
 START_SECTION(regression_train_and_predict_on_all)
 {
   // create some noisy sinus data (data with clear outlier)
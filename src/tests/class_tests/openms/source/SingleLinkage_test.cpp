@@ -113,6 +113,59 @@ START_SECTION((void operator()(DistanceMatrix< float > &original_distance, std::
 }
 END_SECTION
 
+START_SECTION((void operator()(Size n, std::vector<PairDistance>& distances, std::vector<BinaryTreeNode>& cluster_tree, const float threshold = 1) const))
+{
+	vector<ClusterFunctor::PairDistance> distances;
+	distances.push_back({1, 0, 0.5f});
+	distances.push_back({2, 0, 0.8f});
+	distances.push_back({2, 1, 0.3f});
+	distances.push_back({3, 0, 0.6f});
+	distances.push_back({3, 1, 0.8f});
+	distances.push_back({4, 3, 0.4f});
+	distances.push_back({5, 0, 0.7f});
+	distances.push_back({5, 4, 0.8f});
+
+	// same result as for the full distance matrix
+	vector< BinaryTreeNode > tree;
+	tree.push_back(BinaryTreeNode(1,2,0.3f));
+	tree.push_back(BinaryTreeNode(3,4,0.4f));
+	tree.push_back(BinaryTreeNode(0,1,0.5f));
+	tree.push_back(BinaryTreeNode(0,3,0.6f));
+	tree.push_back(BinaryTreeNode(0,5,0.7f));
+
+	vector< BinaryTreeNode > result;
+	vector<ClusterFunctor::PairDistance> copy(distances);
+	(*ptr)(6, copy, result);
+	TEST_EQUAL(tree.size(), result.size());
+	for (Size i = 0; i < tree.size(); ++i)
+	{
+			TOLERANCE_ABSOLUTE(0.0001);
+			TEST_EQUAL(tree[i].left_child, result[i].left_child);
+			TEST_EQUAL(tree[i].right_child, result[i].right_child);
+			TEST_REAL_SIMILAR(tree[i].distance, result[i].distance);
+	}
+
+	// with threshold
+	tree.pop_back();
+	tree.pop_back();
+	tree.push_back(BinaryTreeNode(0,3,-1.0f));
+	tree.push_back(BinaryTreeNode(0,5,-1.0f));
+	copy = distances;
+	(*ptr)(6, copy, result, 0.6f);
+	TEST_EQUAL(tree.size(), result.size());
+	for (Size i = 0; i < tree.size(); ++i)
+	{
+			TOLERANCE_ABSOLUTE(0.0001);
+			TEST_EQUAL(tree[i].left_child, result[i].left_child);
+			TEST_EQUAL(tree[i].right_child, result[i].right_child);
+			TEST_REAL_SIMILAR(tree[i].distance, result[i].distance);
+	}
+
+	copy.push_back({0, 6, 0.1f});
+	TEST_EXCEPTION(Exception::IndexOverflow, (*ptr)(6, copy, result));
+}
+END_SECTION
+
 delete ptr;
 
 /////////////////////////////////////////////////////////////
@@ -120,6 +120,37 @@ START_SECTION((template < typename MapType > void mergeSpectraPrecursors(MapType
 
 END_SECTION
 
+START_SECTION((MSSpectrum mergeBlock(const std::vector<MSSpectrum>& block, const UInt ms_level) const))
+  SpectraMerger merger;
+  Param p = merger.getParameters();
+  p.setValue("mz_binning_width", 0.01);
+  p.setValue("mz_binning_width_unit", "Da");
+  merger.setParameters(p);
+
+  std::vector<MSSpectrum> block(2);
+  block[0].setRT(10.0);
+  block[0].setNativeID("scan=1");
+  block[0].push_back(Peak1D(100.0, 1.0));
+  block[0].push_back(Peak1D(200.0, 2.0));
+  block[1].setRT(20.0);
+  block[1].setNativeID("scan=2");
+  block[1].push_back(Peak1D(200.001, 3.0));
+  block[1].push_back(Peak1D(300.0, 4.0));
+
+  MSSpectrum merged = merger.mergeBlock(block, 1);
+  TEST_EQUAL(merged.getNativeID(), "scan=1,scan=2")
+  TEST_EQUAL(merged.getMSLevel(), 1)
+  TEST_REAL_SIMILAR(merged.getRT(), 15.0)
+  TEST_EQUAL(merged.size(), 3)
+  ABORT_IF(merged.size() != 3)
+  TEST_REAL_SIMILAR(merged[0].getIntensity(), 1.0)
+  TEST_REAL_SIMILAR(merged[1].getMZ(), 200.0)
+  TEST_REAL_SIMILAR(merged[1].getIntensity(), 5.0)
+  TEST_REAL_SIMILAR(merged[2].getIntensity(), 4.0)
+
+  TEST_EXCEPTION(Exception::InvalidSize, merger.mergeBlock(std::vector<MSSpectrum>(), 1))
+END_SECTION
+
 START_SECTION((bool areMassesMatched(double mz1, double mz2, double tol_ppm, int max_c)))
   SpectraMerger merger;
   bool non_matched = merger.areMassesMatched(100, 1000, 10, 5);
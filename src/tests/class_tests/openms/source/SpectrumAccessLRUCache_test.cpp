@@ -0,0 +1,148 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessLRUCache.h>
+///////////////////////////
+
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessOpenMS.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/SpectrumAddition.h>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(SpectrumAccessLRUCache, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+// five spectra at RT 0, 10, ..., 40
+boost::shared_ptr<PeakMap> exp(new PeakMap);
+for (Size i = 0; i < 5; ++i)
+{
+  MSSpectrum s;
+  s.setRT(10.0 * i);
+  for (Size j = 0; j < 4; ++j)
+  {
+    s.push_back(Peak1D(100.0 + j, 10.0 * (i + 1)));
+  }
+  exp->addSpectrum(s);
+}
+OpenSwath::SpectrumAccessPtr backend(new SpectrumAccessOpenMS(exp));
+
+SpectrumAccessLRUCache* ptr = nullptr;
+SpectrumAccessLRUCache* nullPointer = nullptr;
+
+START_SECTION((SpectrumAccessLRUCache(OpenSwath::SpectrumAccessPtr sptr, Size max_spectra, Size max_summed)))
+{
+  ptr = new SpectrumAccessLRUCache(backend, 2, 2);
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->getNrSpectra(), 5)
+  TEST_EQUAL(ptr->getRTIndex() == backend->getRTIndex(), true)
+}
+END_SECTION
+
+START_SECTION((~SpectrumAccessLRUCache()))
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((OpenSwath::SpectrumPtr getSpectrumById(int id)))
+{
+  SpectrumAccessLRUCache cache(backend, 2, 2);
+  OpenSwath::SpectrumPtr s0 = cache.getSpectrumById(0);
+  TEST_EQUAL(s0->getMZArray()->data.size(), 4)
+  TEST_REAL_SIMILAR(s0->getIntensityArray()->data[0], 10.0)
+  TEST_EQUAL(cache.getSpectrumById(0) == s0, true)
+  TEST_EQUAL(cache.getStatistics().hits, 1)
+  TEST_EQUAL(cache.getStatistics().misses, 1)
+
+  // capacity of 2: decoding 2 evicts the least recently used spectrum (1)
+  OpenSwath::SpectrumPtr s1 = cache.getSpectrumById(1);
+  cache.getSpectrumById(0);
+  cache.getSpectrumById(2);
+  TEST_EQUAL(cache.getSpectrumById(0) == s0, true)
+  TEST_EQUAL(cache.getSpectrumById(1) == s1, false)
+  TEST_EQUAL(cache.getStatistics().hits, 3)
+  TEST_EQUAL(cache.getStatistics().misses, 4)
+
+  // no caching at all
+  SpectrumAccessLRUCache no_cache(backend, 0, 0);
+  TEST_EQUAL(no_cache.getSpectrumById(3) == no_cache.getSpectrumById(3), false)
+  TEST_EQUAL(no_cache.getStatistics().misses, 2)
+}
+END_SECTION
+
+START_SECTION((boost::shared_ptr<OpenSwath::ISpectrumAccess> lightClone() const))
+{
+  SpectrumAccessLRUCache cache(backend, 4, 4);
+  OpenSwath::SpectrumPtr s2 = cache.getSpectrumById(2);
+  boost::shared_ptr<OpenSwath::ISpectrumAccess> clone = cache.lightClone();
+  TEST_EQUAL(clone->getSpectrumById(2) == s2, true)
+  TEST_EQUAL(clone->getNrSpectra(), 5)
+  TEST_EQUAL(cache.getStatistics().hits, 1)
+}
+END_SECTION
+
+START_SECTION((OpenSwath::SpectrumPtr getSummedSpectrum(double RT, int nr_spectra_to_add, const RangeMobility& im_range, double sampling_rate)))
+{
+  SpectrumAccessLRUCache cache(backend, 4, 4);
+  RangeMobility no_im;
+  OpenSwath::SpectrumPtr summed = cache.getSummedSpectrum(21.0, 3, no_im, 0.005);
+  OpenSwath::SpectrumPtr expected = SpectrumAddition::addUpSpectra(backend->getMultipleSpectra(21.0, 3), no_im, 0.005, true);
+  ABORT_IF(summed->getMZArray()->data.size() != expected->getMZArray()->data.size())
+  for (Size k = 0; k < expected->getMZArray()->data.size(); ++k)
+  {
+    TEST_REAL_SIMILAR(summed->getMZArray()->data[k], expected->getMZArray()->data[k])
+    TEST_REAL_SIMILAR(summed->getIntensityArray()->data[k], expected->getIntensityArray()->data[k])
+  }
+
+  // same closest spectrum (RT 20): answered from the cache
+  TEST_EQUAL(cache.getSummedSpectrum(19.0, 3, no_im, 0.005) == summed, true)
+  TEST_EQUAL(cache.getSummedSpectrum(19.0, 1, no_im, 0.005) == summed, false)
+  TEST_EQUAL(cache.getSummedSpectrum(31.0, 3, no_im, 0.005) == summed, false)
+
+  SpectrumAccessLRUCache::CacheStatistics stats = cache.getStatistics();
+  TEST_EQUAL(stats.summed_hits, 1)
+  TEST_EQUAL(stats.summed_misses, 3)
+
+  // beyond the last spectrum
+  TEST_EQUAL(cache.getSummedSpectrum(100.0, 3, no_im, 0.005)->getMZArray()->data.size(), 0)
+}
+END_SECTION
+
+START_SECTION((CacheStatistics getStatistics() const))
+{
+  SpectrumAccessLRUCache cache(backend, 4, 4);
+  TEST_REAL_SIMILAR(cache.getStatistics().getHitRate(), 0.0)
+  cache.getSpectrumById(1);
+  cache.getSpectrumById(1);
+  cache.getSpectrumById(1);
+  cache.getSpectrumById(4);
+  TEST_REAL_SIMILAR(cache.getStatistics().getHitRate(), 0.5)
+}
+END_SECTION
+
+START_SECTION((void clearCache()))
+{
+  SpectrumAccessLRUCache cache(backend, 4, 4);
+  OpenSwath::SpectrumPtr s1 = cache.getSpectrumById(1);
+  cache.clearCache();
+  TEST_EQUAL(cache.getStatistics().misses, 0)
+  TEST_EQUAL(cache.getSpectrumById(1) == s1, false)
+  TEST_EQUAL(cache.getStatistics().misses, 1)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -213,6 +213,128 @@ START_SECTION((static OpenSwath::SpectrumPtr addUpSpectra(std::vector< OpenSwath
 }
 END_SECTION
 
+START_SECTION((static void addUpSpectra(const SpectrumSequence& all_spectra, double sampling_rate, bool filter_zeros, Workspace& workspace, OpenSwath::Spectrum& output)))
+{
+  OpenSwath::SpectrumPtr spec1(new OpenSwath::Spectrum());
+  spec1->getMZArray()->data = {100, 101.5, 101.9, 102.0, 102.1, 102.11, 102.2, 102.25, 102.3, 102.4, 102.45};
+  spec1->getIntensityArray()->data = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+  OpenSwath::SpectrumPtr spec2(new OpenSwath::Spectrum());
+  spec2->getMZArray()->data = {100, 101.6, 101.95, 102.0, 102.05, 102.1, 102.12, 102.15, 102.2, 102.25, 102.30};
+  spec2->getIntensityArray()->data = {1, 3, 5, 7, 9, 11, 9, 7, 5, 3, 1};
+  SpectrumSequence all_spectra = {spec1, spec2};
+
+  // same result as the allocating version, also when the workspace and output are reused
+  SpectrumAddition::Workspace workspace;
+  OpenSwath::Spectrum output;
+  for (bool filter_zeros : {false, true, false})
+  {
+    OpenSwath::SpectrumPtr expected = SpectrumAddition::addUpSpectra(all_spectra, 0.1, filter_zeros);
+    SpectrumAddition::addUpSpectra(all_spectra, 0.1, filter_zeros, workspace, output);
+    ABORT_IF(output.getMZArray()->data.size() != expected->getMZArray()->data.size())
+    for (Size k = 0; k < expected->getMZArray()->data.size(); ++k)
+    {
+      TEST_REAL_SIMILAR(output.getMZArray()->data[k], expected->getMZArray()->data[k])
+      TEST_REAL_SIMILAR(output.getIntensityArray()->data[k], expected->getIntensityArray()->data[k])
+    }
+  }
+  TEST_EQUAL(output.getMZArray()->data.size(), 25)
+
+  // single spectrum: copied
+  SpectrumAddition::addUpSpectra({spec2}, 0.1, true, workspace, output);
+  TEST_EQUAL(output.getMZArray()->data == spec2->getMZArray()->data, true)
+  TEST_EQUAL(output.getIntensityArray()->data == spec2->getIntensityArray()->data, true)
+
+  SpectrumAddition::addUpSpectra(SpectrumSequence(), 0.1, true, workspace, output);
+  TEST_EQUAL(output.getMZArray()->data.size(), 0)
+  TEST_EQUAL(output.getIntensityArray()->data.size(), 0)
+}
+END_SECTION
+
+START_SECTION((static void addUpSpectra(const SpectrumSequence& all_spectra, const RangeMobility& im_range, double sampling_rate, bool filter_zeros, Workspace& workspace, OpenSwath::Spectrum& output)))
+{
+  OpenSwath::SpectrumPtr spec1(new OpenSwath::Spectrum());
+  spec1->getMZArray()->data = {100, 100.5, 101, 101.5};
+  spec1->getIntensityArray()->data = {1, 2, 3, 4};
+  OpenSwath::BinaryDataArrayPtr im1(new OpenSwath::BinaryDataArray);
+  im1->data = {0.5, 1.5, 0.8, 0.9};
+  spec1->setDriftTimeArray(im1);
+  OpenSwath::SpectrumPtr spec2(new OpenSwath::Spectrum());
+  spec2->getMZArray()->data = {100.2, 100.7, 101.2};
+  spec2->getIntensityArray()->data = {5, 6, 7};
+  OpenSwath::BinaryDataArrayPtr im2(new OpenSwath::BinaryDataArray);
+  im2->data = {0.7, 0.1, 1.0};
+  spec2->setDriftTimeArray(im2);
+  SpectrumSequence all_spectra = {spec1, spec2};
+
+  RangeMobility im_range(0.6, 1.0);
+  OpenSwath::SpectrumPtr expected = SpectrumAddition::addUpSpectra(all_spectra, im_range, 0.1, true);
+  SpectrumAddition::Workspace workspace;
+  OpenSwath::Spectrum output;
+  SpectrumAddition::addUpSpectra(all_spectra, im_range, 0.1, true, workspace, output);
+  ABORT_IF(output.getMZArray()->data.size() != expected->getMZArray()->data.size())
+  for (Size k = 0; k < expected->getMZArray()->data.size(); ++k)
+  {
+    TEST_REAL_SIMILAR(output.getMZArray()->data[k], expected->getMZArray()->data[k])
+    TEST_REAL_SIMILAR(output.getIntensityArray()->data[k], expected->getIntensityArray()->data[k])
+  }
+  TEST_EQUAL(output.getDataArrays().size(), 2)
+
+  // peaks at IM 0.5, 1.5 and 0.1 are skipped
+  double sum = 0;
+  for (double i : output.getIntensityArray()->data) sum += i;
+  TEST_REAL_SIMILAR(sum, 3 + 4 + 5 + 7)
+
+  // same result with ion mobility indices
+  TEST_EQUAL(OpenSwath::SpectrumMobilityIndex::addToSpectrum(*spec1), true)
+  TEST_EQUAL(OpenSwath::SpectrumMobilityIndex::addToSpectrum(*spec2), true)
+  OpenSwath::Spectrum indexed_output;
+  SpectrumAddition::addUpSpectra(all_spectra, im_range, 0.1, true, workspace, indexed_output);
+  TEST_EQUAL(indexed_output.getMZArray()->data == output.getMZArray()->data, true)
+  TEST_EQUAL(indexed_output.getIntensityArray()->data == output.getIntensityArray()->data, true)
+}
+END_SECTION
+
+START_SECTION((static void concatenateSpectra(const SpectrumSequence& all_spectra, Workspace& workspace, OpenSwath::Spectrum& output)))
+{
+  OpenSwath::SpectrumPtr spec1(new OpenSwath::Spectrum());
+  spec1->getMZArray()->data = {100, 101, 102};
+  spec1->getIntensityArray()->data = {1, 2, 3};
+  OpenSwath::BinaryDataArrayPtr im1(new OpenSwath::BinaryDataArray);
+  im1->data = {0.1, 0.2, 0.3};
+  spec1->setDriftTimeArray(im1);
+  OpenSwath::SpectrumPtr spec2(new OpenSwath::Spectrum());
+  spec2->getMZArray()->data = {99, 101, 103};
+  spec2->getIntensityArray()->data = {4, 5, 6};
+  OpenSwath::BinaryDataArrayPtr im2(new OpenSwath::BinaryDataArray);
+  im2->data = {0.4, 0.5, 0.6};
+  spec2->setDriftTimeArray(im2);
+
+  SpectrumAddition::Workspace workspace;
+  OpenSwath::Spectrum output;
+  SpectrumAddition::concatenateSpectra({spec1, spec2}, workspace, output);
+  TEST_EQUAL(output.getMZArray()->data == std::vector<double>({99, 100, 101, 101, 102, 103}), true)
+  // equal m/z: the peak of the first spectrum comes first
+  TEST_EQUAL(output.getIntensityArray()->data == std::vector<double>({4, 1, 2, 5, 3, 6}), true)
+  ABORT_IF(output.getDriftTimeArray() == nullptr)
+  TEST_EQUAL(output.getDriftTimeArray()->data == std::vector<double>({0.4, 0.1, 0.2, 0.5, 0.3, 0.6}), true)
+
+  // same as the allocating version (which sorts)
+  OpenSwath::SpectrumPtr expected = SpectrumAddition::concatenateSpectra({spec1, spec2});
+  TEST_EQUAL(expected->getMZArray()->data == output.getMZArray()->data, true)
+  TEST_EQUAL(expected->getIntensityArray()->data == output.getIntensityArray()->data, true)
+
+  // unsorted input is sorted
+  spec2->getMZArray()->data = {103, 101, 99};
+  SpectrumAddition::concatenateSpectra({spec1, spec2}, workspace, output);
+  TEST_EQUAL(output.getMZArray()->data == std::vector<double>({99, 100, 101, 101, 102, 103}), true)
+  TEST_EQUAL(output.getIntensityArray()->data == std::vector<double>({6, 1, 2, 5, 3, 4}), true)
+
+  SpectrumAddition::concatenateSpectra(SpectrumSequence(), workspace, output);
+  TEST_EQUAL(output.getMZArray()->data.size(), 0)
+  TEST_EQUAL(output.getDataArrays().size(), 2)
+}
+END_SECTION
+
 START_SECTION((static OpenMS::MSSpectrum addUpSpectra(std::vector< OpenMS::Spectrum<> all_spectra, double sampling_rate, bool filter_zeros) ))
 {
   // Intensity
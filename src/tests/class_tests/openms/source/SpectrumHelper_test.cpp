@@ -12,6 +12,7 @@
 ///////////////////////////
 #include <OpenMS/KERNEL/MSSpectrum.h>
 #include <OpenMS/KERNEL/MSChromatogram.h>
+#include <OpenMS/KERNEL/ColumnarSpectrum.h>
 #include <OpenMS/KERNEL/SpectrumHelper.h>
 ///////////////////////////
 
@@ -254,6 +255,62 @@ START_SECTION(void subtractMinimumIntensity(PeakContainerT& p))
 }
 END_SECTION
 
+START_SECTION(void removePeaks(ColumnarSpectrum& p, const double pos_start, const double pos_end))
+{
+  ColumnarSpectrum s;
+  for (Size i = 5; i < 15; ++i) // m/z: [5 14]
+  {
+    s.push_back(i, 0, i * 0.1);
+  }
+
+  ColumnarSpectrum s1 = s;
+  removePeaks(s1, 3, 6);
+  TEST_EQUAL(s1.size(), 2)
+  TEST_EQUAL(s1.getIonMobilityArray().size(), 2)
+  TEST_REAL_SIMILAR(s1.getMZArray()[0], 5)
+  TEST_REAL_SIMILAR(s1.getMZArray()[1], 6)
+  TEST_REAL_SIMILAR(s1.getIonMobilityArray()[1], 0.6)
+
+  ColumnarSpectrum s2 = s;
+  removePeaks(s2, 0, 4); // no peak within the requested range
+  TEST_EQUAL(s2.size(), 0)
+  TEST_EQUAL(s2.getIonMobilityArray().size(), 0)
+
+  ColumnarSpectrum s3 = s;
+  removePeaks(s3, 12, 16);
+  TEST_EQUAL(s3.size(), 3)
+  TEST_REAL_SIMILAR(s3.getMZArray()[0], 12)
+  TEST_REAL_SIMILAR(s3.getMZArray()[2], 14)
+
+  ColumnarSpectrum s4 = s;
+  removePeaks(s4, 9.5, 9.7); // empty range between two peaks
+  TEST_EQUAL(s4.size(), 0)
+
+  ColumnarSpectrum s_empty;
+  removePeaks(s_empty, 9, 12);
+  TEST_EQUAL(s_empty.size(), 0)
+}
+END_SECTION
+
+START_SECTION(void subtractMinimumIntensity(ColumnarSpectrum& p))
+{
+  ColumnarSpectrum s;
+  for (Int i = -5; i < 5; ++i) // Intensities: [-5 4]
+  {
+    s.push_back(i + 5, i);
+  }
+
+  subtractMinimumIntensity(s);
+  TEST_REAL_SIMILAR(s.getIntensityArray()[0], 0)
+  TEST_REAL_SIMILAR(s.getIntensityArray()[1], 1)
+  TEST_REAL_SIMILAR(s.getIntensityArray()[9], 9)
+
+  ColumnarSpectrum s_empty;
+  subtractMinimumIntensity(s_empty);
+  TEST_EQUAL(s_empty.size(), 0)
+}
+END_SECTION
+
 START_SECTION(void makePeakPositionUnique(PeakContainerT& p, const int m) )
 {
   MSSpectrum s;
@@ -13,6 +13,10 @@
 #include <OpenMS/METADATA/SpectrumLookup.h>
 ///////////////////////////
 
+#include <OpenMS/FORMAT/OffsetIndexFile.h>
+
+#include <fstream>
+
 using namespace OpenMS;
 using namespace std;
 
@@ -67,6 +71,27 @@ START_SECTION((template <typename SpectrumContainer> void readSpectra(const Spec
 END_SECTION
 
 
+START_SECTION((void readSpectra(const OffsetIndexFile& index, const String& scan_regexp)))
+{
+  // index of a small mzXML file
+  String tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  ofstream(tmp_filename.c_str()) << "<?xml version=\"1.0\"?>\n<mzXML>\n<msRun>\n"
+    << "<scan num=\"7\" msLevel=\"1\" retentionTime=\"PT1.5S\"></scan>\n"
+    << "<scan num=\"8\" msLevel=\"1\" retentionTime=\"PT2.5S\"></scan>\n"
+    << "</msRun>\n</mzXML>\n";
+  OffsetIndexFile index;
+  index.scan(tmp_filename);
+
+  SpectrumLookup index_lookup;
+  index_lookup.readSpectra(index);
+  TEST_EQUAL(index_lookup.empty(), false);
+  TEST_EQUAL(index_lookup.findByNativeID("scan=8"), 1);
+  TEST_EQUAL(index_lookup.findByScanNumber(7), 0);
+  TEST_EQUAL(index_lookup.findByRT(2.5), 1);
+}
+END_SECTION
+
 START_SECTION((Size findByRT(double) const))
 {
   TEST_EQUAL(lookup.findByRT(2.0), 1);
@@ -0,0 +1,192 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/SpillableSpectrumList.h>
+///////////////////////////
+
+#include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/SYSTEM/MemoryBudget.h>
+
+using namespace OpenMS;
+using namespace std;
+
+namespace
+{
+  MSSpectrum makeSpectrum(Size i)
+  {
+    MSSpectrum s;
+    s.setRT(10.0 * i);
+    s.setMSLevel(1 + int(i % 2));
+    s.setNativeID("scan=" + String(i));
+    for (Size j = 0; j < 5 + i; ++j)
+    {
+      s.emplace_back(100.0 + j, float(i * 10 + j));
+    }
+    s.getFloatDataArrays().resize(1);
+    s.getFloatDataArrays()[0].setName("ion mobility");
+    s.getFloatDataArrays()[0].assign(s.size(), 0.5f);
+    s.getIntegerDataArrays().resize(1);
+    s.getIntegerDataArrays()[0].setName("charge");
+    s.getIntegerDataArrays()[0].assign(s.size(), 2);
+    s.getStringDataArrays().resize(1);
+    s.getStringDataArrays()[0].push_back("annotation");
+    return s;
+  }
+}
+
+START_TEST(SpillableSpectrumList, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+SpillableSpectrumList* ptr = nullptr;
+SpillableSpectrumList* nullPointer = nullptr;
+START_SECTION((explicit SpillableSpectrumList(const String& cache_file = "", Size block_size = 1000)))
+{
+  ptr = new SpillableSpectrumList();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_EQUAL(ptr->getCacheFile().empty(), false)
+  TEST_EXCEPTION(Exception::IllegalArgument, SpillableSpectrumList("", 0))
+}
+END_SECTION
+
+START_SECTION((~SpillableSpectrumList()))
+{
+  delete ptr;
+
+  String cache_file;
+  NEW_TMP_FILE(cache_file)
+  {
+    SpillableSpectrumList list(cache_file, 1);
+    list.push_back(makeSpectrum(0));
+    list.spill();
+    TEST_EQUAL(File::exists(cache_file), true)
+  }
+  TEST_EQUAL(File::exists(cache_file), false)
+}
+END_SECTION
+
+START_SECTION((void push_back(MSSpectrum spectrum)))
+{
+  // without a memory limit nothing is spilled
+  SpillableSpectrumList list("", 2);
+  for (Size i = 0; i < 5; ++i)
+  {
+    list.push_back(makeSpectrum(i));
+  }
+  TEST_EQUAL(list.size(), 5)
+  TEST_EQUAL(list.getSpilledCount(), 0)
+
+  // with an exceeded budget, one (the least recently accessed) block is spilled per completed block
+  MemoryBudget::setLimit(1);
+  if (MemoryBudget::isExceeded())
+  {
+    SpillableSpectrumList budget_list("", 2);
+    budget_list.push_back(makeSpectrum(0));
+    TEST_EQUAL(budget_list.getSpilledCount(), 0)
+    budget_list.push_back(makeSpectrum(1));
+    TEST_EQUAL(budget_list.getSpilledCount(), 2)
+    budget_list.push_back(makeSpectrum(2));
+    budget_list.push_back(makeSpectrum(3));
+    TEST_EQUAL(budget_list.getSpilledCount(), 4)
+    for (Size i = 0; i < 4; ++i)
+    {
+      TEST_TRUE(budget_list.getSpectrum(i) == makeSpectrum(i))
+    }
+  }
+  MemoryBudget::setLimit(0);
+}
+END_SECTION
+
+START_SECTION((MSSpectrum getSpectrum(Size index) const))
+{
+  SpillableSpectrumList list("", 2);
+  for (Size i = 0; i < 5; ++i)
+  {
+    list.push_back(makeSpectrum(i));
+  }
+  TEST_TRUE(list.getSpectrum(3) == makeSpectrum(3))
+  list.spill();
+  TEST_EQUAL(list.getSpilledCount(), 4)
+  bool all_equal = true;
+  for (Size i = 0; i < 5; ++i)
+  {
+    all_equal &= (list.getSpectrum(i) == makeSpectrum(i));
+  }
+  TEST_EQUAL(all_equal, true)
+  MSSpectrum s = list.getSpectrum(1);
+  TEST_EQUAL(s.getNativeID(), "scan=1")
+  TEST_EQUAL(s.size(), 6)
+  TEST_EQUAL(s.getIntegerDataArrays()[0][0], 2)
+  TEST_EQUAL(s.getStringDataArrays()[0][0], "annotation")
+  TEST_EQUAL(s.getFloatDataArrays()[0].getName(), "ion mobility")
+
+  // concurrent reads
+  std::vector<MSSpectrum> spectra(100);
+#pragma omp parallel for
+  for (SignedSize i = 0; i < SignedSize(spectra.size()); ++i)
+  {
+    spectra[i] = list.getSpectrum(i % 5);
+  }
+  all_equal = true;
+  for (Size i = 0; i < spectra.size(); ++i)
+  {
+    all_equal &= (spectra[i] == makeSpectrum(i % 5));
+  }
+  TEST_EQUAL(all_equal, true)
+
+  TEST_EXCEPTION(Exception::IndexOverflow, list.getSpectrum(5))
+}
+END_SECTION
+
+START_SECTION((void spill()))
+{
+  SpillableSpectrumList list("", 2);
+  list.spill();
+  TEST_EQUAL(list.getSpilledCount(), 0)
+  list.push_back(makeSpectrum(0));
+  list.spill(); // the incomplete block stays in memory
+  TEST_EQUAL(list.getSpilledCount(), 0)
+  list.push_back(makeSpectrum(1));
+  list.spill();
+  TEST_EQUAL(list.getSpilledCount(), 2)
+}
+END_SECTION
+
+START_SECTION((Size size() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((bool empty() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((Size getSpilledCount() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((const String& getCacheFile() const))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -12,6 +12,7 @@
 ///////////////////////////
 
 #include <OpenMS/FORMAT/SqMassFile.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataStoringConsumer.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/FORMAT/FileTypes.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
@@ -462,7 +463,108 @@ START_SECTION([EXTRA_FULL_META] void store(const String& filename, MapType& map)
 }
 END_SECTION
 
+START_SECTION(void transform(const String& filename_in, Interfaces::IMSDataConsumer* consumer, bool skip_full_count = false, bool skip_first_pass = false) const)
+{
+  // more spectra than fit into a single batch
+  MSExperiment exp_orig;
+  for (Size i = 0; i < 1234; ++i)
+  {
+    MSSpectrum spec;
+    spec.setNativeID("spectrum=" + String(i));
+    spec.setRT(double(i));
+    for (Size k = 0; k < 10; ++k)
+    {
+      spec.push_back(Peak1D(100.0 + k, double(i + k)));
+    }
+    exp_orig.addSpectrum(spec);
+  }
+  MSChromatogram chrom;
+  chrom.setNativeID("chromatogram");
+  for (Size k = 0; k < 10; ++k)
+  {
+    chrom.push_back(ChromatogramPeak(double(k), 5.0 * k));
+  }
+  exp_orig.addChromatogram(chrom);
+
+  SqMassFile::SqMassConfig config;
+  config.use_lossy_numpress = false;
+  config.write_full_meta = false;
+
+  SqMassFile file;
+  file.setConfig(config);
+  std::string tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  file.store(tmp_filename, exp_orig);
+
+  MSDataStoringConsumer consumer;
+  file.transform(tmp_filename, &consumer);
+  const PeakMap& exp = consumer.getData();
+
+  TEST_EQUAL(exp.getNrSpectra(), 1234)
+  TEST_EQUAL(exp.getNrChromatograms(), 1)
+  ABORT_IF(exp.getNrSpectra() != 1234)
+  TEST_EQUAL(exp.getSpectra()[0].getNativeID(), "spectrum=0")
+  TEST_EQUAL(exp.getSpectra()[1233].getNativeID(), "spectrum=1233")
+  TEST_EQUAL(exp.getSpectra()[765].size(), 10)
+  TEST_REAL_SIMILAR(exp.getSpectra()[765][3].getMZ(), 103.0)
+  TEST_REAL_SIMILAR(exp.getSpectra()[765][3].getIntensity(), 768.0)
+  TEST_REAL_SIMILAR(exp.getChromatograms()[0][4].getIntensity(), 20.0)
+}
+END_SECTION
+
+START_SECTION(static void merge(const StringList& in, const String& out))
+{
+  // two shards of the same run
+  std::vector<std::string> shards(2);
+  SqMassFile file;
+  for (Size s = 0; s < shards.size(); ++s)
+  {
+    MSExperiment shard;
+    shard.setSqlRunID(42);
+    for (Size i = 0; i < 3; ++i)
+    {
+      MSSpectrum spec;
+      spec.setNativeID("spectrum=" + String(s * 3 + i));
+      spec.setRT(double(s * 3 + i));
+      spec.push_back(Peak1D(100.0 + s, 10.0 * (s * 3 + i)));
+      shard.addSpectrum(spec);
+    }
+    MSChromatogram chrom;
+    chrom.setNativeID("chromatogram=" + String(s));
+    chrom.push_back(ChromatogramPeak(1.0, 5.0 * (s + 1)));
+    Precursor prec;
+    prec.setMZ(500.0 + s);
+    chrom.setPrecursor(prec);
+    shard.addChromatogram(chrom);
+    NEW_TMP_FILE_EXT(shards[s], String(s) + ".sqMass"); // one file per shard
+    file.store(shards[s], shard);
+  }
+
+  std::string tmp_filename;
+  NEW_TMP_FILE(tmp_filename);
+  SqMassFile::merge(ListUtils::create<String>(String(shards[0]) + "," + String(shards[1])), tmp_filename);
+
+  MSExperiment exp;
+  file.load(tmp_filename, exp);
+  TEST_EQUAL(exp.getNrSpectra(), 6)
+  TEST_EQUAL(exp.getNrChromatograms(), 2)
+  TEST_EQUAL(exp.getSqlRunID(), 42)
+  ABORT_IF(exp.getNrSpectra() != 6 || exp.getNrChromatograms() != 2)
+  for (Size i = 0; i < 6; ++i)
+  {
+    TEST_EQUAL(exp.getSpectra()[i].getNativeID(), "spectrum=" + String(i))
+    TEST_REAL_SIMILAR(exp.getSpectra()[i][0].getIntensity(), 10.0 * i)
+  }
+  TEST_REAL_SIMILAR(exp.getSpectra()[4][0].getMZ(), 101.0)
+  TEST_EQUAL(exp.getChromatograms()[1].getNativeID(), "chromatogram=1")
+  TEST_REAL_SIMILAR(exp.getChromatograms()[1][0].getIntensity(), 10.0)
+  TEST_REAL_SIMILAR(exp.getChromatograms()[1].getPrecursor().getMZ(), 501.0)
+
+  // the output must not be one of the inputs
+  TEST_EXCEPTION(Exception::IllegalArgument, SqMassFile::merge(ListUtils::create<String>(String(shards[0]) + "," + String(shards[1])), shards[1]))
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
-
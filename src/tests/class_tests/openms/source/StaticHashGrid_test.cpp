@@ -0,0 +1,139 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Lars Nilse $
+// $Authors: Lars Nilse $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+#include <OpenMS/ML/CLUSTERING/StaticHashGrid.h>
+
+#include <limits>
+#include <vector>
+
+using namespace OpenMS;
+
+typedef StaticHashGrid<int> TestGrid;
+const TestGrid::ClusterCenter cell_dimension(1, 1);
+
+START_TEST(StaticHashGrid, "$Id$")
+
+// elements 0..24 at (x, y) = (i % 5 + 0.5, i / 5 + 0.5), i.e. one per cell, plus a second element in cell (2, 2)
+std::vector<TestGrid::value_type> elements;
+for (int i = 24; i >= 0; --i)
+{
+  elements.emplace_back(TestGrid::ClusterCenter(i % 5 + 0.5, i / 5 + 0.5), i);
+}
+elements.emplace_back(TestGrid::ClusterCenter(2.7, 2.1), 100);
+
+START_SECTION((StaticHashGrid(const ClusterCenter& c_dimension, std::vector<value_type> elements)))
+{
+  TestGrid t(cell_dimension, elements);
+  TEST_EQUAL(t.cell_dimension == cell_dimension, true)
+  TEST_EQUAL(t.size(), 26)
+  TEST_EQUAL(t.getCells().size(), 25)
+
+  // cells are sorted by index, elements by cell and then by insertion order
+  bool sorted = true;
+  for (Size c = 1; c < t.getCells().size(); ++c)
+  {
+    sorted &= (t.getCells()[c - 1].index < t.getCells()[c].index);
+    sorted &= (t.getCells()[c - 1].end == t.getCells()[c].begin);
+  }
+  TEST_EQUAL(sorted, true)
+  const TestGrid::Cell* cell = t.findCell(TestGrid::CellIndex(2, 2));
+  TEST_EQUAL(cell->end - cell->begin, 2)
+  TEST_EQUAL(t.getElements()[cell->begin].second, 12)
+  TEST_EQUAL(t.getElements()[cell->begin + 1].second, 100)
+
+  std::vector<TestGrid::value_type> out_of_range(1, TestGrid::value_type(TestGrid::ClusterCenter(0, (double)std::numeric_limits<Int64>::min() - 1e5), 0));
+  TEST_EXCEPTION(Exception::OutOfRange, TestGrid(cell_dimension, out_of_range))
+
+  TestGrid empty(cell_dimension, std::vector<TestGrid::value_type>());
+  TEST_EQUAL(empty.empty(), true)
+  TEST_EQUAL(empty.begin() == empty.end(), true)
+}
+END_SECTION
+
+TestGrid grid(cell_dimension, elements);
+
+START_SECTION(CellIndex cellIndex(const ClusterCenter& key) const)
+{
+  TEST_EQUAL(grid.cellIndex(TestGrid::ClusterCenter(2.7, 2.1)) == TestGrid::CellIndex(2, 2), true)
+  TEST_EQUAL(grid.cellIndex(TestGrid::ClusterCenter(-0.5, 1.0)) == TestGrid::CellIndex(-1, 1), true)
+}
+END_SECTION
+
+START_SECTION(const Cell* findCell(const CellIndex& x) const)
+{
+  TEST_EQUAL(grid.findCell(TestGrid::CellIndex(0, 0))->index == TestGrid::CellIndex(0, 0), true)
+  TEST_EQUAL(grid.findCell(TestGrid::CellIndex(5, 0)) == nullptr, true)
+  TEST_EQUAL(grid.findCell(TestGrid::CellIndex(-1, 2)) == nullptr, true)
+}
+END_SECTION
+
+START_SECTION((template <typename Functor> void forEachNeighbor(const CellIndex& x, Functor&& f) const))
+{
+  std::vector<int> found;
+  grid.forEachNeighbor(TestGrid::CellIndex(2, 2), [&found](const TestGrid::value_type& v) { found.push_back(v.second); });
+  // row by row (cells (1, 1), (1, 2), (1, 3), (2, 1), ...); element i is in cell (i % 5, i / 5)
+  std::vector<int> expected = {6, 11, 16, 7, 12, 100, 17, 8, 13, 18};
+  TEST_EQUAL(found == expected, true)
+
+  // at the border
+  found.clear();
+  grid.forEachNeighbor(TestGrid::CellIndex(0, 0), [&found](const TestGrid::value_type& v) { found.push_back(v.second); });
+  expected = {0, 5, 1, 6};
+  TEST_EQUAL(found == expected, true)
+
+  // far away
+  found.clear();
+  grid.forEachNeighbor(TestGrid::CellIndex(10, 10), [&found](const TestGrid::value_type& v) { found.push_back(v.second); });
+  TEST_EQUAL(found.empty(), true)
+}
+END_SECTION
+
+START_SECTION(const_iterator begin() const)
+{
+  TEST_EQUAL(grid.begin()->second, 0)
+  Size n = 0;
+  for (TestGrid::const_iterator it = grid.begin(); it != grid.end(); ++it) ++n;
+  TEST_EQUAL(n, 26)
+}
+END_SECTION
+
+START_SECTION(const_iterator end() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(bool empty() const)
+{
+  TEST_EQUAL(grid.empty(), false)
+}
+END_SECTION
+
+START_SECTION(size_type size() const)
+{
+  TEST_EQUAL(grid.size(), 26)
+}
+END_SECTION
+
+START_SECTION(const std::vector<value_type>& getElements() const)
+{
+  TEST_EQUAL(grid.getElements().size(), 26)
+}
+END_SECTION
+
+START_SECTION(const std::vector<Cell>& getCells() const)
+{
+  TEST_EQUAL(grid.getCells().front().index == TestGrid::CellIndex(0, 0), true)
+  TEST_EQUAL(grid.getCells().back().index == TestGrid::CellIndex(4, 4), true)
+}
+END_SECTION
+
+END_TEST
@@ -0,0 +1,212 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Johannes Veit $
+// $Authors: Johannes Veit $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/DATASTRUCTURES/StaticKDTree.h>
+///////////////////////////
+
+#include <algorithm>
+#include <random>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(StaticKDTree, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+// random points (with duplicates in x) and their brute-force range queries
+mt19937 rng(42);
+uniform_real_distribution<double> coord(0.0, 100.0);
+vector<StaticKDTree::Point> points;
+for (Size i = 0; i < 2000; ++i)
+{
+  double x = (i % 10 == 0) ? 50.0 : coord(rng);
+  points.push_back({{x, coord(rng)}, i});
+}
+vector<StaticKDTree::Box> boxes;
+for (Size i = 0; i < 200; ++i)
+{
+  double x = coord(rng), y = coord(rng);
+  boxes.push_back({{x, y}, {x + coord(rng) / 5.0, y + coord(rng) / 5.0}});
+}
+boxes.push_back({{50.0, 0.0}, {50.0, 100.0}}); // degenerate box on the duplicates
+boxes.push_back({{-10.0, -10.0}, {200.0, 200.0}}); // all points
+boxes.push_back({{10.0, 10.0}, {5.0, 20.0}}); // empty box
+
+auto bruteForce = [&points](const StaticKDTree::Box& box, Size n)
+{
+  vector<Size> result;
+  for (Size i = 0; i < n; ++i)
+  {
+    const StaticKDTree::Point& p = points[i];
+    if (p.coords[0] >= box.low[0] && p.coords[0] <= box.high[0] && p.coords[1] >= box.low[1] && p.coords[1] <= box.high[1])
+    {
+      result.push_back(p.index);
+    }
+  }
+  return result;
+};
+
+StaticKDTree* ptr = nullptr;
+StaticKDTree* nullPointer = nullptr;
+START_SECTION(StaticKDTree())
+{
+  ptr = new StaticKDTree();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->size(), 0)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_EQUAL(ptr->isBuilt(), true)
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(void insert(double x, double y, Size index))
+{
+  StaticKDTree tree;
+  tree.insert(1.0, 2.0, 7);
+  TEST_EQUAL(tree.size(), 1)
+  TEST_EQUAL(tree.isBuilt(), false)
+  TEST_EQUAL(tree.getPoints()[0].index, 7)
+  TEST_REAL_SIMILAR(tree.getPoints()[0].coords[1], 2.0)
+}
+END_SECTION
+
+START_SECTION(void build())
+{
+  StaticKDTree tree;
+  for (const StaticKDTree::Point& p : points)
+  {
+    tree.insert(p.coords[0], p.coords[1], p.index);
+  }
+  tree.build();
+  TEST_EQUAL(tree.size(), points.size())
+  TEST_EQUAL(tree.isBuilt(), true)
+  // the points are only reordered
+  vector<Size> indices;
+  for (const StaticKDTree::Point& p : tree.getPoints()) indices.push_back(p.index);
+  sort(indices.begin(), indices.end());
+  bool all = true;
+  for (Size i = 0; i < indices.size(); ++i) all &= (indices[i] == i);
+  TEST_EQUAL(all, true)
+  // the median of the whole array splits in x
+  const vector<StaticKDTree::Point>& tree_points = tree.getPoints();
+  const Size median = tree_points.size() / 2;
+  bool split = true;
+  for (Size i = 0; i < median; ++i) split &= (tree_points[i].coords[0] <= tree_points[median].coords[0]);
+  for (Size i = median + 1; i < tree_points.size(); ++i) split &= (tree_points[i].coords[0] >= tree_points[median].coords[0]);
+  TEST_EQUAL(split, true)
+}
+END_SECTION
+
+START_SECTION(void queryRange(const Box& box, std::vector<Size>& result) const)
+{
+  // half of the points organized in the tree, the rest inserted afterwards
+  StaticKDTree tree;
+  for (Size i = 0; i < points.size(); ++i)
+  {
+    tree.insert(points[i].coords[0], points[i].coords[1], points[i].index);
+    if (i == points.size() / 2) tree.build();
+  }
+  for (Size step = 0; step < 2; ++step)
+  {
+    bool all_equal = true;
+    for (const StaticKDTree::Box& box : boxes)
+    {
+      vector<Size> result;
+      tree.queryRange(box, result);
+      sort(result.begin(), result.end());
+      all_equal &= (result == bruteForce(box, points.size()));
+    }
+    TEST_EQUAL(all_equal, true)
+    tree.build();
+  }
+
+  // results are appended
+  vector<Size> result(1, 12345);
+  tree.queryRange(boxes.back(), result);
+  TEST_EQUAL(result.size(), 1)
+  tree.queryRange(boxes[boxes.size() - 2], result);
+  TEST_EQUAL(result.size(), points.size() + 1)
+
+  // small trees are scanned linearly
+  StaticKDTree small;
+  small.insert(1.0, 1.0, 0);
+  small.insert(2.0, 2.0, 1);
+  small.build();
+  result.clear();
+  small.queryRange({{1.5, 0.0}, {3.0, 3.0}}, result);
+  TEST_EQUAL(result.size(), 1)
+  TEST_EQUAL(result[0], 1)
+}
+END_SECTION
+
+START_SECTION((void queryRanges(const std::vector<Box>& boxes, std::vector<std::vector<Size> >& results) const))
+{
+  StaticKDTree tree;
+  for (const StaticKDTree::Point& p : points)
+  {
+    tree.insert(p.coords[0], p.coords[1], p.index);
+  }
+  tree.build();
+  vector<vector<Size> > results(3);
+  tree.queryRanges(boxes, results);
+  TEST_EQUAL(results.size(), boxes.size())
+  bool all_equal = true;
+  for (Size i = 0; i < boxes.size(); ++i)
+  {
+    sort(results[i].begin(), results[i].end());
+    all_equal &= (results[i] == bruteForce(boxes[i], points.size()));
+  }
+  TEST_EQUAL(all_equal, true)
+  TEST_EQUAL(results[boxes.size() - 3].size(), 200) // the duplicates
+}
+END_SECTION
+
+START_SECTION(void clear())
+{
+  StaticKDTree tree;
+  tree.insert(1.0, 2.0, 0);
+  tree.clear();
+  TEST_EQUAL(tree.size(), 0)
+  TEST_EQUAL(tree.empty(), true)
+  TEST_EQUAL(tree.isBuilt(), true)
+}
+END_SECTION
+
+START_SECTION(Size size() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(bool empty() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(bool isBuilt() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(const std::vector<Point>& getPoints() const)
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
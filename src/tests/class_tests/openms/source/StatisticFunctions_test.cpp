@@ -409,6 +409,70 @@ START_SECTION([EXTRA](template <typename IteratorType> static double quantile(It
 }
 END_SECTION
 
+START_SECTION([EXTRA](template <typename T> static double sum(const std::vector<T>& values)))
+{
+  TEST_EQUAL(Math::sum(std::vector<int>{-1, 0, 1, 2, 3}), 5)
+  TEST_EQUAL(Math::sum(std::vector<double>()), 0)
+  std::vector<double> y = ListUtils::create<double>("-1.0,-0.5,0.0,0.5,1.0,1.5,2.0");
+  TEST_REAL_SIMILAR(Math::sum(y), 3.5)
+  TEST_REAL_SIMILAR(Math::mean(y), 0.5)
+  TEST_EXCEPTION(Exception::InvalidRange, Math::mean(std::vector<double>()))
+}
+END_SECTION
+
+START_SECTION([EXTRA](template <typename T> static std::pair<double, double> meanAndVariance(const std::vector<T>& values)))
+{
+  std::vector<double> y = ListUtils::create<double>("1.0,-0.5,2.0,0.5,-1.0,1.5,0.0,3.25,1e-3");
+  const std::pair<double, double> mv = Math::meanAndVariance(y);
+  TEST_REAL_SIMILAR(mv.first, Math::mean(y.begin(), y.end()))
+  TEST_REAL_SIMILAR(mv.second, Math::variance(y.begin(), y.end()))
+  TEST_REAL_SIMILAR(Math::variance(y), Math::variance(y.begin(), y.end()))
+  TEST_REAL_SIMILAR(Math::sd(y), Math::sd(y.begin(), y.end()))
+
+  // values far from zero
+  std::vector<double> shifted(y);
+  for (double& v : shifted) v += 1e9;
+  TEST_REAL_SIMILAR(Math::variance(shifted), Math::variance(y.begin(), y.end()))
+
+  TEST_EXCEPTION(Exception::InvalidRange, Math::meanAndVariance(std::vector<double>()))
+}
+END_SECTION
+
+START_SECTION([EXTRA](template <typename T> static double median(std::vector<T> values)))
+{
+  TEST_EXCEPTION(Exception::InvalidRange, Math::median(std::vector<double>()))
+  std::vector<int> x = {8, 3, 20, 7, 16, 10, 8, 13, 6, 15};
+  std::vector<int> y = {15, 3, 7, 8, 16, 10, 13, 6, 8};
+  for (const std::vector<int>& v : {x, y})
+  {
+    std::vector<int> sorted(v);
+    std::sort(sorted.begin(), sorted.end());
+    TEST_EQUAL(Math::median(v), Math::median(sorted.begin(), sorted.end(), true))
+    TEST_EQUAL(Math::quantile1st(v), Math::quantile1st(sorted.begin(), sorted.end(), true))
+    TEST_EQUAL(Math::quantile3rd(v), Math::quantile3rd(sorted.begin(), sorted.end(), true))
+  }
+  TEST_REAL_SIMILAR(Math::quantile1st(x), 6.5)
+  TEST_REAL_SIMILAR(Math::median(x), 9.0)
+  TEST_REAL_SIMILAR(Math::quantile3rd(x), 15.5)
+  TEST_REAL_SIMILAR(Math::median(y), 8.0)
+  TEST_EXCEPTION(Exception::InvalidRange, Math::quantile1st(std::vector<int>{1, 2}))
+  TEST_EXCEPTION(Exception::InvalidRange, Math::quantile3rd(std::vector<int>{1, 2}))
+  TEST_REAL_SIMILAR(Math::quantile1st(std::vector<int>{3, 1, 2}), 1.0)
+  TEST_REAL_SIMILAR(Math::quantile3rd(std::vector<int>{3, 1, 2}), 3.0)
+}
+END_SECTION
+
+START_SECTION([EXTRA](template <typename T1, typename T2> static double pearsonCorrelationCoefficient(const std::vector<T1>& a, const std::vector<T2>& b)))
+{
+  std::vector<double> a = ListUtils::create<double>("1.0,-0.5,2.0,0.5,-1.0,1.5,0.0,3.25,1e-3");
+  std::vector<float> b = {2.0f, 1.0f, 3.5f, 1.0f, 0.0f, 2.0f, 0.25f, 7.0f, 0.5f};
+  TEST_REAL_SIMILAR(Math::pearsonCorrelationCoefficient(a, b), Math::pearsonCorrelationCoefficient(a.begin(), a.end(), b.begin(), b.end()))
+  TEST_REAL_SIMILAR(Math::pearsonCorrelationCoefficient(a, a), 1.0)
+  TEST_EXCEPTION(Exception::InvalidRange, Math::pearsonCorrelationCoefficient(a, std::vector<double>(3)))
+  TEST_EXCEPTION(Exception::InvalidRange, Math::pearsonCorrelationCoefficient(std::vector<double>(), std::vector<double>()))
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 
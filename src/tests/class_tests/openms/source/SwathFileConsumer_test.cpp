@@ -548,6 +548,115 @@ START_SECTION(([EXTRA] void consumeSpectrum(MapType::SpectrumType & s)))
 END_SECTION
 }
 
+// Test streaming consumer
+{
+
+START_SECTION(([EXTRA] StreamingSwathFileConsumer(std::vector<OpenSwath::SwathMap> known_window_boundaries, const String& cachedir, const String& basename, const std::vector<int>& nr_ms2_spectra, Size memory_budget, WindowCallback window_ready = WindowCallback())))
+{
+  StreamingSwathFileConsumer* ptr = new StreamingSwathFileConsumer(std::vector<OpenSwath::SwathMap>(), "./", "tmp_osw_streaming", std::vector<int>(), 0);
+  StreamingSwathFileConsumer* nullPointer = nullptr;
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->getMemoryUsage(), 0)
+  TEST_EQUAL(ptr->getNrSpilledMaps(), 0)
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(([EXTRA] consumeAndRetrieve_windowSorted))
+{
+  // MS1, then the two scans of each window in turn (e.g. concatenated per-window files)
+  int nr_swath = 3;
+  PeakMap cycle;
+  getSwathFile(cycle, nr_swath, false);
+  PeakMap exp;
+  getSwathFile(exp, 0, true);
+  for (int i = 0; i < nr_swath; i++)
+  {
+    exp.addSpectrum(cycle[i]);
+    exp.addSpectrum(cycle[i]);
+  }
+  std::vector<OpenSwath::SwathMap> boundaries;
+  for (int i = 0; i < nr_swath; i++)
+  {
+    boundaries.push_back(OpenSwath::SwathMap(400 + i*25.0, 425 + i*25.0, 412.5 + i*25.0, false));
+  }
+  std::vector<int> nr_ms2_spectra(nr_swath, 2);
+
+  for (Size memory_budget : {Size(0), Size(1)})
+  {
+    Size consumed = 0;
+    std::vector<std::pair<double, Size> > ready; // window center and number of spectra consumed at that time
+    std::vector<Size> ready_spectra;
+    StreamingSwathFileConsumer consumer(boundaries, "./", "tmp_osw_streaming", nr_ms2_spectra, memory_budget,
+      [&](const OpenSwath::SwathMap& map)
+      {
+        ready.push_back(std::make_pair(map.center, consumed));
+        ready_spectra.push_back(map.sptr->getNrSpectra());
+      });
+    for (Size i = 0; i < exp.size(); i++)
+    {
+      PeakMap::SpectrumType s = exp[i];
+      consumer.consumeSpectrum(s);
+      consumed++;
+    }
+
+    // each window is handed out right after its last spectrum
+    ABORT_IF(ready.size() != 3)
+    for (int i = 0; i < nr_swath; i++)
+    {
+      TEST_REAL_SIMILAR(ready[i].first, 412.5 + i*25.0)
+      TEST_EQUAL(ready[i].second, 2 + 2*i)
+      TEST_EQUAL(ready_spectra[i], 2)
+    }
+    if (memory_budget == 0)
+    {
+      TEST_EQUAL(consumer.getNrSpilledMaps(), 0)
+      TEST_NOT_EQUAL(consumer.getMemoryUsage(), 0)
+    }
+    else
+    {
+      // everything is spilled to disk
+      TEST_EQUAL(consumer.getNrSpilledMaps(), 4)
+      TEST_EQUAL(consumer.getMemoryUsage(), 0)
+    }
+
+    std::vector<OpenSwath::SwathMap> maps;
+    consumer.retrieveSwathMaps(maps);
+    TEST_EQUAL(ready.size(), 3) // no window handed out twice
+    TEST_EQUAL(maps.size(), nr_swath+1) // Swath number + MS1
+    ABORT_IF(maps.size() != 4)
+    TEST_EQUAL(maps[0].ms1, true)
+    TEST_EQUAL(maps[0].sptr->getNrSpectra(), 1)
+    TEST_REAL_SIMILAR(maps[0].sptr->getSpectrumById(0)->getMZArray()->data[0], 100.0)
+    for (int i = 0; i < nr_swath; i++)
+    {
+      TEST_EQUAL(maps[i+1].ms1, false)
+      TEST_EQUAL(maps[i+1].sptr->getNrSpectra(), 2)
+      TEST_EQUAL(maps[i+1].sptr->getSpectrumById(1)->getMZArray()->data.size(), 1)
+      TEST_REAL_SIMILAR(maps[i+1].sptr->getSpectrumById(1)->getMZArray()->data[0], 101.0+i)
+      TEST_REAL_SIMILAR(maps[i+1].sptr->getSpectrumById(1)->getIntensityArray()->data[0], 201.0+i)
+      TEST_REAL_SIMILAR(maps[i+1].lower, 400+i*25.0)
+      TEST_REAL_SIMILAR(maps[i+1].upper, 425+i*25.0)
+    }
+  }
+}
+END_SECTION
+
+START_SECTION(([EXTRA] consumeAndRetrieve_tooManySpectra))
+{
+  std::vector<OpenSwath::SwathMap> boundaries(1, OpenSwath::SwathMap(400, 425, 412.5, false));
+  StreamingSwathFileConsumer consumer(boundaries, "./", "tmp_osw_streaming", std::vector<int>(1, 1), 0);
+  PeakMap exp;
+  getSwathFile(exp, 1, false);
+  PeakMap::SpectrumType s = exp[0];
+  consumer.consumeSpectrum(s);
+  s = exp[0];
+  TEST_EXCEPTION(Exception::IllegalArgument, consumer.consumeSpectrum(s))
+}
+END_SECTION
+
+}
+
 START_SECTION(([EXTRA] consumeAndRetrieve_with_ion_mobility))
 {
 
@@ -63,4 +63,19 @@ START_SECTION(static bool getProcessMemoryConsumption(size_t& mem_virtual))
 }
 END_SECTION
 
+START_SECTION(static Size getNumaNodeCount())
+{
+  TEST_EQUAL(SysInfo::getNumaNodeCount() >= 1, true)
+}
+END_SECTION
+
+START_SECTION(static String getNumaTopologyInfo())
+{
+  String info = SysInfo::getNumaTopologyInfo();
+  std::cout << "NUMA topology: " << info << std::endl;
+  TEST_EQUAL(info.hasPrefix(String(SysInfo::getNumaNodeCount()) + " NUMA node"), true)
+  TEST_EQUAL(info.hasSuffix(" cores)"), true)
+}
+END_SECTION
+
 END_TEST
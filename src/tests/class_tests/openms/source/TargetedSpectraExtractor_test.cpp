@@ -1130,6 +1130,121 @@ START_SECTION(annotateSpectra(const std::vector<MSSpectrum>& spectra, const Feat
 }
 END_SECTION
 
+START_SECTION([EXTRA] annotateSpectra with many features and spectra and matching against a binned library)
+{
+  // compare with a direct check of every spectrum against every feature (in input order)
+  TargetedSpectraExtractor tse;
+  Param params = tse.getParameters();
+  params.setValue("rt_window", 10.0);
+  params.setValue("mz_tolerance", 0.5);
+  tse.setParameters(params);
+
+  FeatureMap ms1_features;
+  std::vector<const Feature*> targets;
+  for (Size i = 0; i < 200; ++i)
+  {
+    Feature f;
+    f.setRT(double((i * 37) % 500));
+    f.setMZ(100.0 + double((i * 11) % 50) / 10.0);
+    f.setMetaValue("PeptideRef", i % 25 == 3 ? String("null") : "target_" + String(i));
+    if (i % 4 == 0)
+    {
+      Feature sub = f;
+      sub.setRT(f.getRT() + 2.0);
+      f.setSubordinates({sub, sub});
+    }
+    ms1_features.push_back(f);
+  }
+  for (const Feature& f : ms1_features)
+  {
+    if (f.getSubordinates().empty()) targets.push_back(&f);
+    for (const Feature& sub : f.getSubordinates()) targets.push_back(&sub);
+  }
+
+  std::vector<MSSpectrum> spectra;
+  for (Size s = 0; s < 300; ++s)
+  {
+    MSSpectrum spectrum;
+    spectrum.setMSLevel(s % 10 == 0 ? 1 : 2);
+    spectrum.setRT(double(s) * 1.7);
+    if (s % 3 != 0)
+    {
+      Precursor precursor;
+      precursor.setMZ(100.0 + double(s % 50) / 10.0);
+      spectrum.setPrecursors({precursor});
+    }
+    spectra.push_back(spectrum);
+  }
+
+  std::vector<String> expected;
+  for (const MSSpectrum& spectrum : spectra)
+  {
+    if (spectrum.getMSLevel() == 1) continue;
+    const double mz = spectrum.getPrecursors().empty() ? 0.0 : spectrum.getPrecursors()[0].getMZ();
+    for (const Feature* f : targets)
+    {
+      if (f->getMetaValue("PeptideRef") == "null") continue;
+      if (f->getRT() >= spectrum.getRT() - 5.0 && f->getRT() <= spectrum.getRT() + 5.0 &&
+          (mz == 0.0 || (f->getMZ() >= mz - 0.25 && f->getMZ() <= mz + 0.25)))
+      {
+        expected.push_back(String(spectrum.getRT()) + "_" + f->getMetaValue("PeptideRef").toString());
+      }
+    }
+  }
+
+  FeatureMap ms2_features;
+  std::vector<MSSpectrum> annotated_spectra;
+  tse.annotateSpectra(spectra, ms1_features, ms2_features, annotated_spectra);
+  TEST_EQUAL(expected.size() > 100, true)
+  ABORT_IF(annotated_spectra.size() != expected.size())
+  ABORT_IF(ms2_features.size() != expected.size())
+  for (Size i = 0; i < expected.size(); ++i)
+  {
+    TEST_EQUAL(String(annotated_spectra[i].getRT()) + "_" + annotated_spectra[i].getName(), expected[i])
+    TEST_EQUAL(ms2_features[i].getMetaValue("PeptideRef"), annotated_spectra[i].getName())
+    TEST_EQUAL(ms2_features[i].getRT(), annotated_spectra[i].getRT())
+  }
+  std::set<UInt64> unique_ids;
+  for (const Feature& f : ms2_features) unique_ids.insert(f.getUniqueId());
+  TEST_EQUAL(unique_ids.size(), ms2_features.size())
+
+  // the library comparator scores like the pairwise contrast angle
+  std::vector<MSSpectrum> library;
+  for (Size l = 0; l < 50; ++l)
+  {
+    MSSpectrum lib;
+    lib.setName("lib_" + String(l));
+    for (Size p = 0; p < 20; ++p)
+    {
+      lib.emplace_back(50.0 + double((l * 7 + p * 13) % 300), float(1 + (l + p) % 9));
+    }
+    lib.sortByPosition();
+    library.push_back(lib);
+  }
+  TargetedSpectraExtractor::BinnedSpectrumComparator cmp;
+  cmp.init(library, {{"bin_size", 1.0}});
+  MSSpectrum query = library[17];
+  query.emplace_back(222.0, 5.0f);
+  query.sortByPosition();
+  std::vector<std::pair<Size, double>> scores;
+  cmp.generateScores(query, scores, 0.0);
+  const BinnedSpectrum query_bs(query, 1.0, false, 0, 0.0);
+  BinnedSpectralContrastAngle contrast_angle;
+  Size compared = 0;
+  for (const auto& s : scores)
+  {
+    TEST_REAL_SIMILAR(s.second, contrast_angle(query_bs, BinnedSpectrum(library[s.first], 1.0, false, 0, 0.0)))
+    ++compared;
+  }
+  TEST_EQUAL(compared, library.size()) // all scores are >= 0
+
+  std::vector<TargetedSpectraExtractor::Match> matches;
+  tse.matchSpectrum(query, cmp, matches);
+  ABORT_IF(matches.empty())
+  TEST_EQUAL(matches[0].spectrum.getName(), "lib_17")
+}
+END_SECTION
+
 START_SECTION(constructTransitionsList(const String& filename, const OpenMS::FeatureMap& ms1_features, const OpenMS::FeatureMap& ms2_features) const)
 {
   OpenMS::FeatureMap ms1_features;
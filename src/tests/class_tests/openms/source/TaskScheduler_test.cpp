@@ -0,0 +1,307 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: Timo Sachsenberg $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/SYSTEM/TaskScheduler.h>
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <atomic>
+#include <numeric>
+#include <set>
+
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(TaskScheduler, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+const int threads_before = TaskScheduler::getNumThreads();
+
+START_SECTION(static void setNumThreads(int num_threads))
+{
+  TaskScheduler::setNumThreads(3);
+#ifdef _OPENMP
+  TEST_EQUAL(TaskScheduler::getNumThreads(), 3)
+#else
+  TEST_EQUAL(TaskScheduler::getNumThreads(), 1)
+#endif
+  TaskScheduler::setNumThreads(0); // at least one thread
+  TEST_EQUAL(TaskScheduler::getNumThreads(), 1)
+  TaskScheduler::setNumThreads(4);
+}
+END_SECTION
+
+START_SECTION(static int getNumThreads())
+{
+  TEST_EQUAL(TaskScheduler::getNumThreads() >= 1, true)
+}
+END_SECTION
+
+START_SECTION((template <typename Function> static void parallelFor(SignedSize begin, SignedSize end, const Function& body, SignedSize grain_size = 1)))
+{
+  // every index is visited exactly once
+  vector<int> visits(1000, 0);
+  TaskScheduler::parallelFor(0, 1000, [&](SignedSize i) { ++visits[i]; });
+  TEST_EQUAL(accumulate(visits.begin(), visits.end(), 0), 1000)
+  TEST_EQUAL(*min_element(visits.begin(), visits.end()), 1)
+
+  // shifted and empty ranges, grain sizes
+  atomic<SignedSize> sum(0);
+  TaskScheduler::parallelFor(10, 20, [&](SignedSize i) { sum += i; }, 3);
+  TEST_EQUAL(sum, 145)
+  TaskScheduler::parallelFor(5, 5, [&](SignedSize) { sum = -1; });
+  TaskScheduler::parallelFor(5, 2, [&](SignedSize) { sum = -1; }, 0);
+  TEST_EQUAL(sum, 145)
+
+  // nested loops share the threads of the outer loop
+  vector<vector<int> > matrix(20, vector<int>(50, 0));
+  TaskScheduler::parallelFor(0, 20, [&](SignedSize i)
+  {
+    TaskScheduler::parallelFor(0, 50, [&](SignedSize j) { matrix[i][j] = int(i * j); });
+  });
+  bool all_set = true;
+  for (Size i = 0; i < matrix.size(); ++i)
+  {
+    for (Size j = 0; j < matrix[i].size(); ++j)
+    {
+      all_set &= (matrix[i][j] == int(i * j));
+    }
+  }
+  TEST_EQUAL(all_set, true)
+
+  // exceptions are rethrown in the calling thread (also from nested loops)
+  TEST_EXCEPTION(Exception::InvalidValue, TaskScheduler::parallelFor(0, 100, [](SignedSize i)
+  {
+    if (i == 42) throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "test", String(i));
+  }))
+  TEST_EXCEPTION(Exception::InvalidValue, TaskScheduler::parallelFor(0, 10, [](SignedSize)
+  {
+    TaskScheduler::parallelFor(0, 10, [](SignedSize j)
+    {
+      if (j == 5) throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "test", String(j));
+    });
+  }))
+}
+END_SECTION
+
+START_SECTION(([TaskScheduler::TaskGroup] template <typename Function> void run(Function&& task)))
+{
+  atomic<int> count(0);
+  TaskScheduler::TaskGroup group;
+  for (int i = 0; i < 10; ++i)
+  {
+    group.run([&count, i]() { count += i; });
+  }
+  group.wait();
+  TEST_EQUAL(count, 45)
+
+  // the group can be reused
+  group.run([&count]() { count += 5; });
+  group.wait();
+  TEST_EQUAL(count, 50)
+}
+END_SECTION
+
+START_SECTION(([TaskScheduler::TaskGroup] void wait()))
+{
+  // task groups within parallelFor() (tasks of tasks)
+  vector<int> results(8, 0);
+  TaskScheduler::parallelFor(0, 8, [&](SignedSize i)
+  {
+    vector<int> parts(4, 0);
+    TaskScheduler::TaskGroup group;
+    for (int p = 0; p < 4; ++p)
+    {
+      group.run([&parts, p, i]() { parts[p] = int(i) + p; });
+    }
+    group.wait();
+    results[i] = accumulate(parts.begin(), parts.end(), 0);
+  });
+  TEST_EQUAL(results[0], 6)
+  TEST_EQUAL(results[7], 34)
+
+  // exceptions
+  TaskScheduler::TaskGroup group;
+  group.run([]() { throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "test", "x"); });
+  group.run([]() {});
+  TEST_EXCEPTION(Exception::InvalidValue, group.wait())
+  // ... are reported only once
+  group.run([]() {});
+  group.wait();
+}
+END_SECTION
+
+START_SECTION(static std::vector<std::vector<int> > getNumaTopology())
+{
+  vector<vector<int> > nodes = TaskScheduler::getNumaTopology();
+  TEST_EQUAL(nodes.empty(), false)
+  set<int> cores;
+  for (const vector<int>& node : nodes)
+  {
+    TEST_EQUAL(node.empty(), false)
+    cores.insert(node.begin(), node.end());
+  }
+  Size total = 0;
+  for (const vector<int>& node : nodes)
+  {
+    total += node.size();
+  }
+  TEST_EQUAL(cores.size(), total) // no core in two nodes
+}
+END_SECTION
+
+START_SECTION(static bool setThreadAffinity(ThreadAffinity affinity))
+{
+  // results depend on the system (Linux only), but the work must be done either way
+  TaskScheduler::setThreadAffinity(TaskScheduler::ThreadAffinity::SPREAD);
+  TaskScheduler::setThreadAffinity(TaskScheduler::ThreadAffinity::COMPACT);
+  atomic<int> count(0);
+  TaskScheduler::parallelFor(0, 100, [&](SignedSize) { ++count; });
+  TEST_EQUAL(count, 100)
+#ifdef __linux__
+  TEST_EQUAL(TaskScheduler::setThreadAffinity(TaskScheduler::ThreadAffinity::NONE), true)
+#else
+  TEST_EQUAL(TaskScheduler::setThreadAffinity(TaskScheduler::ThreadAffinity::NONE), false)
+#endif
+}
+END_SECTION
+
+START_SECTION((template <typename Container> static void placeMemory(Container& elements, MemoryPlacement placement)))
+{
+  vector<vector<double> > data(50);
+  for (Size i = 0; i < data.size(); ++i)
+  {
+    data[i].assign(1000 + i, double(i));
+  }
+  const vector<vector<double> > original = data;
+  for (TaskScheduler::MemoryPlacement placement : {TaskScheduler::MemoryPlacement::DEFAULT, TaskScheduler::MemoryPlacement::FIRST_TOUCH, TaskScheduler::MemoryPlacement::INTERLEAVE})
+  {
+    TaskScheduler::placeMemory(data, placement);
+    TEST_EQUAL(data == original, true)
+  }
+  vector<vector<double> > empty;
+  TaskScheduler::placeMemory(empty, TaskScheduler::MemoryPlacement::FIRST_TOUCH);
+  TEST_EQUAL(empty.size(), 0)
+}
+END_SECTION
+
+START_SECTION(static void setMemoryPlacement(MemoryPlacement placement))
+{
+  TEST_EQUAL(TaskScheduler::getMemoryPlacement() == TaskScheduler::MemoryPlacement::DEFAULT, true)
+  TaskScheduler::setMemoryPlacement(TaskScheduler::MemoryPlacement::INTERLEAVE);
+  TEST_EQUAL(TaskScheduler::getMemoryPlacement() == TaskScheduler::MemoryPlacement::INTERLEAVE, true)
+  TaskScheduler::setMemoryPlacement(TaskScheduler::MemoryPlacement::DEFAULT);
+}
+END_SECTION
+
+START_SECTION(static MemoryPlacement getMemoryPlacement())
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(static bool setMemoryInterleaving(bool interleave))
+{
+  // depends on the system (and may be forbidden in containers); resetting must not fail after success
+  if (TaskScheduler::setMemoryInterleaving(true))
+  {
+    vector<double> v(1000000, 1.0);
+    TEST_EQUAL(v.back(), 1.0)
+    TEST_EQUAL(TaskScheduler::setMemoryInterleaving(false), true)
+  }
+}
+END_SECTION
+
+START_SECTION(static void setDeterministic(bool deterministic))
+{
+  TEST_EQUAL(TaskScheduler::isDeterministic(), false)
+  TaskScheduler::setDeterministic(true);
+  TEST_EQUAL(TaskScheduler::isDeterministic(), true)
+  TaskScheduler::OrderedMerge<int> merge([](Size, int&) {});
+  TEST_EQUAL(merge.isOrdered(), true)
+  TaskScheduler::setDeterministic(false);
+  TEST_EQUAL(TaskScheduler::OrderedMerge<int>([](Size, int&) {}).isOrdered(), false)
+}
+END_SECTION
+
+START_SECTION(static bool isDeterministic())
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION(([TaskScheduler::OrderedMerge] void add(Size index, Result result)))
+{
+  vector<Size> order;
+  TaskScheduler::OrderedMerge<vector<int> > merge([&order](Size index, vector<int>& result)
+  {
+    TEST_EQUAL(result.size(), index)
+    order.push_back(index);
+  }, 2, true);
+  merge.add(4, vector<int>(4));
+  merge.add(3, vector<int>(3));
+  TEST_EQUAL(order.empty(), true)
+  TEST_EQUAL(merge.pendingCount(), 2)
+  merge.add(2, vector<int>(2));
+  TEST_EQUAL(merge.pendingCount(), 0)
+  TEST_EQUAL(order == vector<Size>({2, 3, 4}), true)
+
+  // results of parallel iterations are consumed in order (by one thread at a time)
+  TaskScheduler::setNumThreads(4);
+  vector<Size> consumed;
+  TaskScheduler::OrderedMerge<Size> parallel_merge([&consumed](Size index, Size& result)
+  {
+    TEST_EQUAL(index, result)
+    consumed.push_back(result);
+  }, 0, true);
+  TaskScheduler::parallelFor(0, 1000, [&parallel_merge](SignedSize i) { parallel_merge.add(Size(i), Size(i)); });
+  parallel_merge.finish();
+  vector<Size> expected(1000);
+  iota(expected.begin(), expected.end(), 0);
+  TEST_EQUAL(consumed == expected, true)
+
+  // unordered: consumed right away
+  Size count = 0;
+  TaskScheduler::OrderedMerge<int> unordered([&count](Size, int&) { ++count; }, 0, false);
+  unordered.add(5, 0);
+  TEST_EQUAL(count, 1)
+
+  // exceptions of the consumer are passed on
+  TaskScheduler::OrderedMerge<int> failing([](Size, int&) { throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "failed", "0"); }, 0, true);
+  failing.add(1, 0);
+  TEST_EXCEPTION(Exception::InvalidValue, failing.add(0, 0))
+}
+END_SECTION
+
+START_SECTION(([TaskScheduler::OrderedMerge] void finish()))
+{
+  vector<Size> order;
+  TaskScheduler::OrderedMerge<int> merge([&order](Size index, int&) { order.push_back(index); }, 0, true);
+  merge.add(5, 0);
+  merge.add(2, 0);
+  merge.finish(); // index 0, 1, 3, 4 are missing
+  TEST_EQUAL(order == vector<Size>({2, 5}), true)
+  // later indices are consumed right away
+  merge.add(6, 0);
+  TEST_EQUAL(order.size(), 3)
+}
+END_SECTION
+
+TaskScheduler::setNumThreads(threads_before);
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
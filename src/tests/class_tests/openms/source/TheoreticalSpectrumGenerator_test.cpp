@@ -882,6 +882,56 @@ START_SECTION(([EXTRA] test first prefix loss))
 }
 END_SECTION
 
+START_SECTION(([EXTRA] unannotated spectra are identical to annotated spectra))
+{
+  // without meta info, isotopes and losses the ion ladders are computed from precomputed prefix / suffix masses
+  TheoreticalSpectrumGenerator t_gen;
+  Param params = t_gen.getParameters();
+  for (const String& ion : {"a", "c", "x", "z"})
+  {
+    params.setValue("add_" + ion + "_ions", "true");
+  }
+  params.setValue("add_precursor_peaks", "true");
+  params.setValue("add_abundant_immonium_ions", "true");
+
+  for (const String& seq : {"R", "PEPTIDEK", "IFSQVGK", "(Acetyl)PEPTIDEK(Amidated)"})
+  {
+    AASequence peptide = AASequence::fromString(seq);
+    for (const String& first_prefix : {"true", "false"})
+    {
+      params.setValue("add_first_prefix_ion", first_prefix);
+      if (peptide.size() < 2)
+      {
+        params.setValue("add_c_ions", "false");
+        params.setValue("add_x_ions", "false");
+      }
+      else
+      {
+        params.setValue("add_c_ions", "true");
+        params.setValue("add_x_ions", "true");
+      }
+
+      PeakSpectrum annotated, plain;
+      params.setValue("add_metainfo", "true");
+      t_gen.setParameters(params);
+      t_gen.getSpectrum(annotated, peptide, 1, 3);
+      params.setValue("add_metainfo", "false");
+      t_gen.setParameters(params);
+      t_gen.getSpectrum(plain, peptide, 1, 3);
+
+      TEST_EQUAL(plain.getStringDataArrays().empty(), true)
+      TEST_EQUAL(plain.getIntegerDataArrays().empty(), true)
+      ABORT_IF(plain.size() != annotated.size())
+      for (Size i = 0; i < plain.size(); ++i)
+      {
+        TEST_REAL_SIMILAR(plain[i].getMZ(), annotated[i].getMZ())
+        TEST_REAL_SIMILAR(plain[i].getIntensity(), annotated[i].getIntensity())
+      }
+    }
+  }
+}
+END_SECTION
+
 delete ptr;
 
 /////////////////////////////////////////////////////////////
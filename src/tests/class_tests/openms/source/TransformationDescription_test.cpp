@@ -117,6 +117,35 @@ START_SECTION((double apply(double value) const))
 }
 END_SECTION
 
+START_SECTION((void apply(std::vector<double>& values) const))
+{
+	TransformationDescription td;
+	std::vector<double> values = {-0.5, 1000.0, 3.0};
+	td.apply(values);
+	TEST_EQUAL(values[0], -0.5);
+	TEST_EQUAL(values[1], 1000);
+	TEST_EQUAL(values[2], 3.0);
+
+	TransformationDescription::DataPoints data;
+	data.push_back(make_pair(0.0, 1.0));
+	data.push_back(make_pair(0.5, 4.0));
+	data.push_back(make_pair(1.0, 2.0));
+	data.push_back(make_pair(1.5, 3.0));
+	td.setDataPoints(data);
+	for (const String model_type : {"linear", "interpolated", "b_spline"})
+	{
+		td.fitModel(model_type);
+		values = {-1.0, 0.0, 0.2, 0.7, 1.5, 0.4, 2.0};
+		std::vector<double> results(values);
+		td.apply(results);
+		for (Size i = 0; i < values.size(); ++i)
+		{
+			TEST_REAL_SIMILAR(results[i], td.apply(values[i]));
+		}
+	}
+}
+END_SECTION
+
 START_SECTION((const String& getModelType() const))
 {
 	TransformationDescription td;
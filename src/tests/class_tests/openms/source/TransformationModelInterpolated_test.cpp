@@ -161,6 +161,27 @@ START_SECTION(([EXTRA] TransformationModelInterpolated::evaluate() beyond the ac
 }
 END_SECTION
 
+START_SECTION((void evaluate(std::vector<double>& values) const))
+{
+  // unsorted values (partly sorted runs), inside and outside of the data range
+  std::vector<double> values = {-0.5, 0.0, 0.1, 0.25, 0.5, 0.5, 0.8, 1.0, 1.5, 0.3, 0.1, 0.9, -1.0, 0.7};
+  for (const String interpolation_type : {"linear", "cspline", "akima"})
+  {
+    Param p;
+    TransformationModelInterpolated::getDefaultParameters(p);
+    p.setValue("interpolation_type", interpolation_type);
+    TransformationModelInterpolated tr(dummy_data, p);
+    std::vector<double> results(values);
+    tr.evaluate(results);
+    TEST_EQUAL(results.size(), values.size());
+    for (Size i = 0; i < values.size(); ++i)
+    {
+      TEST_EQUAL(results[i], tr.evaluate(values[i]));
+    }
+  }
+}
+END_SECTION
+
 START_SECTION((static void getDefaultParameters(Param & params)))
 {
   Param p;
@@ -9,9 +9,13 @@
 #include <OpenMS/CONCEPT/ClassTest.h>
 #include <OpenMS/test_config.h>
 #include <OpenMS/FORMAT/TraMLFile.h>
+#include <OpenMS/SYSTEM/File.h>
 
 #include <boost/assign/std/vector.hpp>
 
+#include <fstream>
+#include <iterator>
+
 ///////////////////////////
 #include <OpenMS/ANALYSIS/OPENSWATH/TransitionPQPFile.h>
 ///////////////////////////
@@ -54,6 +58,170 @@ START_SECTION( void convertPQPToTargetedExperiment(const char * filename, OpenMS
 }
 END_SECTION
 
+// small light library with shared compound references and protein accessions
+OpenSwath::LightTargetedExperiment light_exp;
+{
+  OpenSwath::LightProtein protein;
+  protein.id = "PROT_1";
+  light_exp.proteins.push_back(protein);
+  OpenSwath::LightCompound peptide;
+  peptide.id = "PEPTIDEK/2";
+  peptide.sequence = "PEPTIDEK";
+  peptide.rt = 42.5;
+  peptide.charge = 2;
+  peptide.drift_time = 0.9;
+  peptide.protein_refs.push_back("PROT_1");
+  peptide.modifications.push_back({3, 35});
+  light_exp.compounds.push_back(peptide);
+  OpenSwath::LightCompound metabolite;
+  metabolite.id = "caffeine";
+  metabolite.rt = 100.0;
+  metabolite.compound_name = "Caffeine";
+  metabolite.sum_formula = "C8H10N4O2";
+  light_exp.compounds.push_back(metabolite);
+  for (int i = 0; i < 5; ++i)
+  {
+    OpenSwath::LightTransition tr;
+    tr.transition_name = "tr_" + String(i);
+    tr.peptide_ref = i < 3 ? "PEPTIDEK/2" : "caffeine";
+    tr.library_intensity = 100.0 * i;
+    tr.product_mz = 200.0 + i;
+    tr.precursor_mz = 450.5;
+    tr.fragment_charge = i % 2;
+    tr.decoy = (i == 1);
+    tr.detecting_transition = (i != 2);
+    tr.quantifying_transition = (i == 3);
+    tr.identifying_transition = (i == 4);
+    light_exp.transitions.push_back(tr);
+  }
+}
+
+START_SECTION(void storeSnapshot(const String& snapshot_file, const String& pqp_file, const OpenSwath::LightTargetedExperiment& targeted_exp, bool legacy_traml_id = false) const)
+{
+  // tested below
+  NOT_TESTABLE
+}
+END_SECTION
+
+START_SECTION(bool loadSnapshot(const String& snapshot_file, const String& pqp_file, OpenSwath::LightTargetedExperiment& targeted_exp, bool legacy_traml_id = false) const)
+{
+  String pqp_file, snapshot_file;
+  NEW_TMP_FILE(pqp_file);
+  NEW_TMP_FILE(snapshot_file);
+  ofstream(pqp_file.c_str()) << "stands in for the PQP file";
+
+  TransitionPQPFile pqp;
+  pqp.storeSnapshot(snapshot_file, pqp_file, light_exp);
+  OpenSwath::LightTargetedExperiment loaded;
+  TEST_EQUAL(pqp.loadSnapshot(snapshot_file, pqp_file, loaded), true)
+  ABORT_IF(loaded.proteins.size() != 1 || loaded.compounds.size() != 2 || loaded.transitions.size() != 5)
+  TEST_EQUAL(loaded.proteins[0].id, "PROT_1")
+  const OpenSwath::LightCompound& peptide = loaded.compounds[0];
+  TEST_EQUAL(peptide.id, "PEPTIDEK/2")
+  TEST_EQUAL(peptide.sequence, "PEPTIDEK")
+  TEST_REAL_SIMILAR(peptide.rt, 42.5)
+  TEST_EQUAL(peptide.charge, 2)
+  TEST_REAL_SIMILAR(peptide.drift_time, 0.9)
+  TEST_EQUAL(peptide.protein_refs.size(), 1)
+  TEST_EQUAL(peptide.modifications.size(), 1)
+  TEST_EQUAL(peptide.modifications[0].location, 3)
+  TEST_EQUAL(peptide.modifications[0].unimod_id, 35)
+  TEST_EQUAL(peptide.isPeptide(), true)
+  TEST_EQUAL(loaded.compounds[1].isPeptide(), false)
+  TEST_EQUAL(loaded.compounds[1].sum_formula, "C8H10N4O2")
+  for (Size i = 0; i < loaded.transitions.size(); ++i)
+  {
+    const OpenSwath::LightTransition& tr = loaded.transitions[i];
+    const OpenSwath::LightTransition& orig = light_exp.transitions[i];
+    TEST_EQUAL(tr.transition_name, orig.transition_name)
+    TEST_EQUAL(tr.peptide_ref, orig.peptide_ref)
+    TEST_REAL_SIMILAR(tr.library_intensity, orig.library_intensity)
+    TEST_REAL_SIMILAR(tr.product_mz, orig.product_mz)
+    TEST_REAL_SIMILAR(tr.precursor_mz, orig.precursor_mz)
+    TEST_REAL_SIMILAR(tr.precursor_im, orig.precursor_im)
+    TEST_EQUAL(tr.fragment_charge, orig.fragment_charge)
+    TEST_EQUAL(tr.decoy, orig.decoy)
+    TEST_EQUAL(tr.detecting_transition, orig.detecting_transition)
+    TEST_EQUAL(tr.quantifying_transition, orig.quantifying_transition)
+    TEST_EQUAL(tr.identifying_transition, orig.identifying_transition)
+  }
+  TEST_EQUAL(loaded.getCompoundByRef("caffeine").compound_name, "Caffeine")
+
+  // written with different settings
+  TEST_EQUAL(pqp.loadSnapshot(snapshot_file, pqp_file, loaded, true), false)
+  TEST_EQUAL(loaded.transitions.size(), 0)
+  TransitionPQPFile pqp_force;
+  Param p = pqp_force.getParameters();
+  p.setValue("force_invalid_mods", "true");
+  pqp_force.setParameters(p);
+  TEST_EQUAL(pqp_force.loadSnapshot(snapshot_file, pqp_file, loaded), false)
+
+  // outdated (the PQP file has a different size)
+  ofstream(pqp_file.c_str(), ios::app) << " (modified)";
+  TEST_EQUAL(pqp.loadSnapshot(snapshot_file, pqp_file, loaded), false)
+  TEST_EQUAL(pqp.loadSnapshot("this_file_does_not_exist.snapshot", pqp_file, loaded), false)
+  TEST_EQUAL(pqp.loadSnapshot(pqp_file, pqp_file, loaded), false)
+
+  // truncated
+  pqp.storeSnapshot(snapshot_file, pqp_file, light_exp);
+  String truncated_file;
+  NEW_TMP_FILE(truncated_file);
+  {
+    ifstream is(snapshot_file.c_str(), ios::binary);
+    std::string content((istreambuf_iterator<char>(is)), istreambuf_iterator<char>());
+    ofstream(truncated_file.c_str(), ios::binary) << content.substr(0, content.size() - 10);
+  }
+  TEST_EQUAL(pqp.loadSnapshot(truncated_file, pqp_file, loaded), false)
+  TEST_EQUAL(loaded.compounds.size(), 0)
+  TEST_EXCEPTION(Exception::UnableToCreateFile, pqp.storeSnapshot("/does/not/exist/lib.snapshot", pqp_file, light_exp))
+}
+END_SECTION
+
+START_SECTION(void convertPQPToTargetedExperimentCached(const char* filename, OpenSwath::LightTargetedExperiment& targeted_exp, bool legacy_traml_id = false, bool write_snapshot = true))
+{
+  TargetedExperiment traml;
+  TraMLFile().load(OPENMS_GET_TEST_DATA_PATH("OpenSwath_generic_input.TraML"), traml);
+  String pqp_file;
+  NEW_TMP_FILE(pqp_file);
+  TransitionPQPFile pqp;
+  pqp.convertTargetedExperimentToPQP(pqp_file.c_str(), traml);
+
+  OpenSwath::LightTargetedExperiment converted, cached;
+  pqp.convertPQPToTargetedExperiment(pqp_file.c_str(), converted);
+  pqp.convertPQPToTargetedExperimentCached(pqp_file.c_str(), cached, false, false);
+  TEST_EQUAL(File::exists(TransitionPQPFile::getSnapshotName(pqp_file)), false)
+  TEST_EQUAL(cached.transitions.size(), converted.transitions.size())
+
+  pqp.convertPQPToTargetedExperimentCached(pqp_file.c_str(), cached);
+  TEST_EQUAL(File::exists(TransitionPQPFile::getSnapshotName(pqp_file)), true)
+  OpenSwath::LightTargetedExperiment loaded;
+  TEST_EQUAL(pqp.loadSnapshot(TransitionPQPFile::getSnapshotName(pqp_file), pqp_file, loaded), true)
+  pqp.convertPQPToTargetedExperimentCached(pqp_file.c_str(), cached);
+  ABORT_IF(cached.transitions.size() != converted.transitions.size())
+  ABORT_IF(cached.compounds.size() != converted.compounds.size())
+  TEST_EQUAL(cached.proteins.size(), converted.proteins.size())
+  for (Size i = 0; i < converted.transitions.size(); ++i)
+  {
+    TEST_EQUAL(cached.transitions[i].transition_name, converted.transitions[i].transition_name)
+    TEST_EQUAL(cached.transitions[i].peptide_ref, converted.transitions[i].peptide_ref)
+    TEST_REAL_SIMILAR(cached.transitions[i].product_mz, converted.transitions[i].product_mz)
+  }
+  for (Size i = 0; i < converted.compounds.size(); ++i)
+  {
+    TEST_EQUAL(cached.compounds[i].id, converted.compounds[i].id)
+    TEST_EQUAL(cached.compounds[i].sequence, converted.compounds[i].sequence)
+    TEST_EQUAL(cached.compounds[i].modifications.size(), converted.compounds[i].modifications.size())
+  }
+  File::remove(TransitionPQPFile::getSnapshotName(pqp_file));
+}
+END_SECTION
+
+START_SECTION(static String getSnapshotName(const String& pqp_file))
+{
+  TEST_EQUAL(TransitionPQPFile::getSnapshotName("lib/pan_human.pqp"), "lib/pan_human.pqp.snapshot")
+}
+END_SECTION
+
 START_SECTION( void validateTargetedExperiment(OpenMS::TargetedExperiment & targeted_exp))
 {
   NOT_TESTABLE
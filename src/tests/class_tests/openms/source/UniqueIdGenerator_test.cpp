@@ -13,6 +13,7 @@
 #include <OpenMS/CONCEPT/UniqueIdGenerator.h>
 #include <ctime>
 #include <algorithm> // for std::sort and std::adjacent_find
+#include <thread>
 // array_wrapper needs to be included before it is used
 // only in boost1.64+. See issue #2790
 #if OPENMS_BOOST_VERSION_MINOR >= 64
@@ -142,6 +143,90 @@ START_SECTION([EXTRA] multithreaded example)
 }
 END_SECTION
 
+START_SECTION([EXTRA] reproducible with a fixed number of threads)
+{
+  // each thread has its own generator, seeded from the global seed and the thread number
+  auto generate = [nofIdsToGenerate]()
+  {
+    OpenMS::UniqueIdGenerator::setSeed(546666321);
+    std::vector<OpenMS::UInt64> ids(nofIdsToGenerate);
+#pragma omp parallel for num_threads(4) schedule(static)
+    for (int i = 0; i < static_cast<int>(nofIdsToGenerate); ++i)
+    {
+      ids[i] = OpenMS::UniqueIdGenerator::getUniqueId();
+    }
+    return ids;
+  };
+  std::vector<OpenMS::UInt64> ids = generate();
+  TEST_EQUAL(ids == generate(), true)
+  // the first chunk is created by the main thread, like single threaded code
+  TEST_EQUAL(ids[0], 4039984684862977299U)
+  std::sort(ids.begin(), ids.end());
+  TEST_EQUAL(std::adjacent_find(ids.begin(), ids.end()) == ids.end(), true)
+
+  // threads with a thread number that is in use (here: 0) get a separate generator
+  OpenMS::UniqueIdGenerator::setSeed(546666321);
+  OpenMS::UInt64 main_id = OpenMS::UniqueIdGenerator::getUniqueId();
+  OpenMS::UInt64 thread_id = 0;
+  std::thread t([&thread_id]() { OpenMS::UniqueIdGenerator::setSeed(546666321); thread_id = OpenMS::UniqueIdGenerator::getUniqueId(); });
+  t.join();
+  TEST_EQUAL(main_id, 4039984684862977299U)
+  TEST_NOT_EQUAL(thread_id, main_id)
+}
+END_SECTION
+
+START_SECTION(([UniqueIdGenerator::ItemScope] explicit ItemScope(UInt64 item, bool enabled = true)))
+{
+  // the ids of an item are the same, whichever thread creates them and in whichever order
+  auto generate = [](int nr_threads)
+  {
+    OpenMS::UniqueIdGenerator::setSeed(546666321);
+    std::vector<OpenMS::UInt64> ids(100);
+#pragma omp parallel for num_threads(nr_threads) schedule(dynamic)
+    for (int item = 0; item < 50; ++item)
+    {
+      OpenMS::UniqueIdGenerator::ItemScope scope(item);
+      ids[2 * item] = OpenMS::UniqueIdGenerator::getUniqueId();
+      ids[2 * item + 1] = OpenMS::UniqueIdGenerator::getUniqueId();
+    }
+    return ids;
+  };
+  std::vector<OpenMS::UInt64> ids = generate(1);
+  TEST_EQUAL(ids == generate(4), true)
+  std::sort(ids.begin(), ids.end());
+  TEST_EQUAL(std::adjacent_find(ids.begin(), ids.end()) == ids.end(), true)
+
+  // nested scopes restore the outer generator, disabled scopes do nothing
+  OpenMS::UniqueIdGenerator::setSeed(546666321);
+  OpenMS::UInt64 outer_first, outer_second, inner;
+  {
+    OpenMS::UniqueIdGenerator::ItemScope outer(7);
+    outer_first = OpenMS::UniqueIdGenerator::getUniqueId();
+    {
+      OpenMS::UniqueIdGenerator::ItemScope nested(8);
+      inner = OpenMS::UniqueIdGenerator::getUniqueId();
+      OpenMS::UniqueIdGenerator::ItemScope disabled(9, false);
+      TEST_NOT_EQUAL(OpenMS::UniqueIdGenerator::getUniqueId(), inner)
+    }
+    outer_second = OpenMS::UniqueIdGenerator::getUniqueId();
+  }
+  TEST_NOT_EQUAL(outer_first, inner)
+  {
+    OpenMS::UniqueIdGenerator::ItemScope outer(7);
+    TEST_EQUAL(OpenMS::UniqueIdGenerator::getUniqueId(), outer_first)
+    TEST_EQUAL(OpenMS::UniqueIdGenerator::getUniqueId(), outer_second)
+  }
+  // outside of scopes, the thread generator is used as before
+  TEST_EQUAL(OpenMS::UniqueIdGenerator::getUniqueId(), 4039984684862977299U)
+}
+END_SECTION
+
+START_SECTION(([UniqueIdGenerator::ItemScope] ~ItemScope()))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -0,0 +1,196 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+
+///////////////////////////
+
+#include <OpenMS/VISUAL/IntensityPyramid.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(IntensityPyramid, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+// 8 MS1 spectra at RT 0..7 with peaks at m/z 100..107 (intensity = RT + m/z - 100) and an MS2 spectrum
+MSExperiment exp;
+for (Size rt = 0; rt < 8; ++rt)
+{
+  MSSpectrum spec;
+  spec.setRT(rt);
+  spec.setMSLevel(1);
+  for (Size mz = 0; mz < 8; ++mz)
+  {
+    spec.push_back(Peak1D(100.0 + mz, float(rt + mz)));
+  }
+  exp.addSpectrum(spec);
+}
+MSSpectrum ms2;
+ms2.setRT(3.5);
+ms2.setMSLevel(2);
+ms2.push_back(Peak1D(50.0, 1000.0f));
+exp.addSpectrum(ms2);
+
+IntensityPyramid* ptr = nullptr;
+IntensityPyramid* null_ptr = nullptr;
+START_SECTION(IntensityPyramid())
+{
+  ptr = new IntensityPyramid();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_EQUAL(ptr->size(), 0)
+}
+END_SECTION
+
+START_SECTION(~IntensityPyramid())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(IntensityPyramid(const MSExperiment& exp, UInt ms_level = 1, Size max_tiles = 4096, const std::atomic<bool>* cancel = nullptr))
+{
+  IntensityPyramid p(exp, 1, 8);
+  TEST_EQUAL(p.size(), 4) // 8x8, 4x4, 2x2, 1x1
+  TEST_EQUAL(p.getLevel(0).rt_tiles, 8)
+  TEST_EQUAL(p.getLevel(0).mz_tiles, 8)
+  TEST_EQUAL(p.getLevel(3).rt_tiles, 1)
+  TEST_EQUAL(p.getLevel(3).mz_tiles, 1)
+  // the MS2 spectrum is not used
+  TEST_REAL_SIMILAR(p.getLevel(3).max_intensity[0], 14.0)
+  TEST_REAL_SIMILAR(p.getLevel(3).sum_intensity[0], 448.0)
+  TEST_REAL_SIMILAR(p.getLevel(0).max_intensity[1 * 8 + 2], 3.0)
+  TEST_REAL_SIMILAR(p.getLevel(1).max_intensity[0], 2.0) // RT 0-1, m/z 100-101
+  TEST_REAL_SIMILAR(p.getLevel(1).sum_intensity[0], 4.0)
+
+  // not more RT tiles than spectra, rounded down to a power of two
+  IntensityPyramid p2(exp, 1, 1000);
+  TEST_EQUAL(p2.getLevel(0).rt_tiles, 8)
+  TEST_EQUAL(p2.getLevel(0).mz_tiles, 512)
+
+  // no spectra of this MS level
+  TEST_EQUAL(IntensityPyramid(exp, 3).empty(), true)
+
+  // cancelled
+  std::atomic<bool> cancel(true);
+  TEST_EQUAL(IntensityPyramid(exp, 1, 8, &cancel).empty(), true)
+}
+END_SECTION
+
+IntensityPyramid pyramid(exp, 1, 8);
+
+START_SECTION(bool empty() const)
+{
+  TEST_EQUAL(pyramid.empty(), false)
+}
+END_SECTION
+
+START_SECTION(Size size() const)
+{
+  TEST_EQUAL(pyramid.size(), 4)
+}
+END_SECTION
+
+START_SECTION(const Level& getLevel(Size level) const)
+{
+  TEST_EQUAL(pyramid.getLevel(2).max_intensity.size(), 4)
+  TEST_EQUAL(pyramid.getLevel(2).sum_intensity.size(), 4)
+}
+END_SECTION
+
+START_SECTION(double getMinRT() const)
+{
+  TEST_REAL_SIMILAR(pyramid.getMinRT(), 0.0)
+}
+END_SECTION
+
+START_SECTION(double getMaxRT() const)
+{
+  TEST_REAL_SIMILAR(pyramid.getMaxRT(), 7.0)
+}
+END_SECTION
+
+START_SECTION(double getMinMZ() const)
+{
+  TEST_REAL_SIMILAR(pyramid.getMinMZ(), 100.0)
+}
+END_SECTION
+
+START_SECTION(double getMaxMZ() const)
+{
+  TEST_REAL_SIMILAR(pyramid.getMaxMZ(), 107.0)
+}
+END_SECTION
+
+START_SECTION(Size selectLevel(double rt_span, double mz_span, Size rt_pixels, Size mz_pixels) const)
+{
+  // tiles of level 0 are 7/8 wide
+  TEST_EQUAL(pyramid.selectLevel(7.0, 7.0, 1, 1), 3)
+  TEST_EQUAL(pyramid.selectLevel(7.0, 7.0, 2, 2), 2)
+  TEST_EQUAL(pyramid.selectLevel(7.0, 7.0, 4, 8), 0)
+  TEST_EQUAL(pyramid.selectLevel(7.0, 7.0, 2, 8), 0)
+  // pixels smaller than the finest tiles
+  TEST_EQUAL(pyramid.selectLevel(7.0, 7.0, 16, 8), pyramid.size())
+  TEST_EQUAL(pyramid.selectLevel(7.0, 7.0, 0, 8), pyramid.size())
+}
+END_SECTION
+
+START_SECTION(TileRange getRTTiles(Size level, double rt_start, double rt_end) const)
+{
+  TEST_EQUAL(pyramid.getRTTiles(0, 0.0, 7.0).first, 0)
+  TEST_EQUAL(pyramid.getRTTiles(0, 0.0, 7.0).second, 8)
+  TEST_EQUAL(pyramid.getRTTiles(0, -10.0, 0.5).first, 0)
+  TEST_EQUAL(pyramid.getRTTiles(0, -10.0, 0.5).second, 1)
+  TEST_EQUAL(pyramid.getRTTiles(1, 3.6, 5.0).first, 2)
+  TEST_EQUAL(pyramid.getRTTiles(1, 3.6, 5.0).second, 3)
+  // outside of the data
+  IntensityPyramid::TileRange r = pyramid.getRTTiles(0, 20.0, 30.0);
+  TEST_EQUAL(r.first, r.second)
+}
+END_SECTION
+
+START_SECTION(TileRange getMZTiles(Size level, double mz_start, double mz_end) const)
+{
+  TEST_EQUAL(pyramid.getMZTiles(3, 0.0, 1000.0).first, 0)
+  TEST_EQUAL(pyramid.getMZTiles(3, 0.0, 1000.0).second, 1)
+  TEST_EQUAL(pyramid.getMZTiles(0, 106.5, 200.0).first, 7)
+  TEST_EQUAL(pyramid.getMZTiles(0, 106.5, 200.0).second, 8)
+}
+END_SECTION
+
+START_SECTION(float getMaxIntensity(Size level, const TileRange& rt_tiles, const TileRange& mz_tiles) const)
+{
+  TEST_REAL_SIMILAR(pyramid.getMaxIntensity(0, pyramid.getRTTiles(0, 0.0, 7.0), pyramid.getMZTiles(0, 100.0, 107.0)), 14.0)
+  TEST_REAL_SIMILAR(pyramid.getMaxIntensity(0, {2, 3}, {4, 6}), 7.0)
+  TEST_REAL_SIMILAR(pyramid.getMaxIntensity(0, {2, 2}, {4, 6}), -1.0)
+
+  // tiles without peaks
+  MSExperiment sparse;
+  MSSpectrum spec;
+  spec.setMSLevel(1);
+  spec.push_back(Peak1D(100.0, 5.0f));
+  spec.setRT(0.0);
+  sparse.addSpectrum(spec);
+  spec.setRT(10.0);
+  spec[0].setMZ(200.0);
+  sparse.addSpectrum(spec);
+  IntensityPyramid p(sparse, 1, 2);
+  TEST_REAL_SIMILAR(p.getMaxIntensity(0, {0, 1}, {1, 2}), -1.0)
+  TEST_REAL_SIMILAR(p.getMaxIntensity(0, {1, 2}, {1, 2}), 5.0)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -0,0 +1,141 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Chris Bielow $
+// $Authors: Chris Bielow $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+
+///////////////////////////
+
+#include <OpenMS/VISUAL/SpectrumCache.h>
+#include <OpenMS/CONCEPT/Exception.h>
+
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(SpectrumCache, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+// 'reads' spectra with RT = index and counts the reads
+Size reads = 0;
+SpectrumCache::Loader loader = [&reads](Size index)
+{
+  if (index >= 100)
+  {
+    throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, index, 100);
+  }
+  ++reads;
+  MSSpectrum spec;
+  spec.setRT(double(index));
+  spec.push_back(Peak1D(100.0, 1.0f));
+  return spec;
+};
+
+SpectrumCache* ptr = nullptr;
+SpectrumCache* null_ptr = nullptr;
+START_SECTION(explicit SpectrumCache(const Loader& loader, Size capacity = 64))
+{
+  ptr = new SpectrumCache(loader);
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->size(), 0)
+  TEST_EQUAL(ptr->getCapacity(), 64)
+  TEST_EQUAL(SpectrumCache(loader, 0).getCapacity(), 1)
+}
+END_SECTION
+
+START_SECTION(~SpectrumCache())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(const MSSpectrum& getSpectrum(Size index))
+{
+  SpectrumCache cache(loader, 2);
+  reads = 0;
+  const MSSpectrum& s3 = cache.getSpectrum(3);
+  TEST_REAL_SIMILAR(s3.getRT(), 3.0)
+  TEST_EQUAL(reads, 1)
+  // from memory
+  TEST_REAL_SIMILAR(cache.getSpectrum(3).getRT(), 3.0)
+  TEST_EQUAL(reads, 1)
+  cache.getSpectrum(5);
+  TEST_EQUAL(reads, 2)
+  // the reference is still valid
+  TEST_REAL_SIMILAR(s3.getRT(), 3.0)
+  // 3 was used more recently than 5, so 5 is discarded
+  cache.getSpectrum(3);
+  cache.getSpectrum(7);
+  TEST_EQUAL(reads, 3)
+  TEST_EQUAL(cache.contains(3), true)
+  TEST_EQUAL(cache.contains(5), false)
+  TEST_EQUAL(cache.contains(7), true)
+  // failed reads do not change the cache
+  TEST_EXCEPTION(Exception::IndexOverflow, cache.getSpectrum(100))
+  TEST_EQUAL(cache.size(), 2)
+  TEST_EQUAL(cache.contains(3), true)
+}
+END_SECTION
+
+START_SECTION(bool contains(Size index) const)
+{
+  SpectrumCache cache(loader);
+  TEST_EQUAL(cache.contains(1), false)
+  cache.getSpectrum(1);
+  TEST_EQUAL(cache.contains(1), true)
+}
+END_SECTION
+
+START_SECTION(Size size() const)
+{
+  SpectrumCache cache(loader, 3);
+  for (Size i = 0; i < 10; ++i)
+  {
+    cache.getSpectrum(i);
+  }
+  TEST_EQUAL(cache.size(), 3)
+}
+END_SECTION
+
+START_SECTION(Size getCapacity() const)
+{
+  TEST_EQUAL(SpectrumCache(loader, 5).getCapacity(), 5)
+}
+END_SECTION
+
+START_SECTION(void setCapacity(Size capacity))
+{
+  SpectrumCache cache(loader, 5);
+  for (Size i = 0; i < 5; ++i)
+  {
+    cache.getSpectrum(i);
+  }
+  cache.setCapacity(2);
+  TEST_EQUAL(cache.getCapacity(), 2)
+  TEST_EQUAL(cache.size(), 2)
+  TEST_EQUAL(cache.contains(4), true)
+  TEST_EQUAL(cache.contains(3), true)
+  TEST_EQUAL(cache.contains(2), false)
+}
+END_SECTION
+
+START_SECTION(void clear())
+{
+  SpectrumCache cache(loader);
+  cache.getSpectrum(1);
+  cache.clear();
+  TEST_EQUAL(cache.size(), 0)
+  TEST_EQUAL(cache.contains(1), false)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
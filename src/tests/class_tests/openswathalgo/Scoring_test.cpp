@@ -10,6 +10,8 @@
 
 #include "OpenMS/OPENSWATHALGO/ALGO/Scoring.h"
 
+#include <cmath>
+
 #ifdef USE_BOOST_UNIT_TEST
 
 // include boost unit test framework
@@ -293,6 +295,47 @@ BOOST_AUTO_TEST_CASE(test_calculateCrossCorrelation)
 }
 END_SECTION
 
+BOOST_AUTO_TEST_CASE(test_calculateCrossCorrelation_blocked)
+{
+  // the blocked implementation adds up the products of each delay in the
+  // same order as the straightforward loop, the results are identical
+  std::vector<double> data1, data2;
+  for (int i = 0; i < 41; ++i)
+  {
+    data1.push_back(std::sin(0.37 * i) * 1000.0 + i);
+    data2.push_back(std::cos(0.11 * i * i) * 10.0);
+  }
+
+  for (int size : {0, 1, 5, 8, 17, 41})
+  {
+    std::vector<double> d1(data1.begin(), data1.begin() + size);
+    std::vector<double> d2(data2.begin(), data2.begin() + size);
+    for (int maxdelay : {0, 3, 13, size, size + 9})
+    {
+      for (int lag : {1, 2, 3})
+      {
+        OpenSwath::Scoring::XCorrArrayType result = Scoring::calculateCrossCorrelation(d1, d2, maxdelay, lag);
+        Size k = 0;
+        bool identical = true;
+        for (int delay = -maxdelay; delay <= maxdelay; delay += lag, ++k)
+        {
+          double sxy = 0;
+          for (int i = 0; i < size; ++i)
+          {
+            int j = i + delay;
+            if (j < 0 || j >= size) continue;
+            sxy += d1[i] * d2[j];
+          }
+          identical = identical && k < result.data.size() && result.data[k].first == delay && result.data[k].second == sxy;
+        }
+        TEST_EQUAL(identical, true)
+        TEST_EQUAL(result.data.size(), k)
+      }
+    }
+  }
+}
+END_SECTION
+
 BOOST_AUTO_TEST_CASE(test_MRMFeatureScoring_normalizedCrossCorrelation)
 //START_SECTION((MRMFeatureScoring::XCorrArrayType MRMFeatureScoring::normalizedCrossCorrelation(std::vector<double>& data1, std::vector<double>& data2, int maxdelay, int lag)))
 {
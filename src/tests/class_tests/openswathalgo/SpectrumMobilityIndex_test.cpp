@@ -0,0 +1,115 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include "OpenMS/OPENSWATHALGO/DATAACCESS/SpectrumMobilityIndex.h"
+#include "OpenMS/OPENSWATHALGO/DATAACCESS/ISpectrumAccess.h"
+#include <OpenMS/CONCEPT/ClassTest.h>
+
+#include <cmath>
+
+using namespace OpenMS;
+using namespace std;
+
+///////////////////////////
+
+START_TEST(SpectrumMobilityIndex, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+// a frame of 1000 peaks sorted by m/z with scrambled ion mobility values between 0.6 and 1.6
+OpenSwath::SpectrumPtr frame(new OpenSwath::Spectrum);
+OpenSwath::BinaryDataArrayPtr frame_im(new OpenSwath::BinaryDataArray);
+for (std::size_t k = 0; k < 1000; ++k)
+{
+  frame->getMZArray()->data.push_back(400.0 + 0.5 * k);
+  frame->getIntensityArray()->data.push_back(1.0 + k);
+  frame_im->data.push_back(0.6 + std::fmod(k * 0.37, 1.0));
+}
+frame_im->data[500] = 1.0; // duplicates of a range border
+frame_im->data[501] = 1.0;
+frame->setDriftTimeArray(frame_im);
+
+START_SECTION(SpectrumMobilityIndex(const OSSpectrum& spectrum, std::size_t block_size = 256, std::size_t nr_bins = 32))
+{
+  OpenSwath::SpectrumMobilityIndex index(*frame);
+  TEST_EQUAL(index.size(), 1000)
+  TEST_EQUAL(index.empty(), false)
+  TEST_EQUAL(index.isIndexOf(*frame), true)
+
+  // no ion mobility array
+  OpenSwath::Spectrum no_im;
+  no_im.getMZArray()->data.push_back(100.0);
+  no_im.getIntensityArray()->data.push_back(1.0);
+  OpenSwath::SpectrumMobilityIndex empty(no_im);
+  TEST_EQUAL(empty.empty(), true)
+  TEST_EQUAL(empty.isIndexOf(no_im), false)
+  TEST_EQUAL(index.isIndexOf(no_im), false)
+}
+END_SECTION
+
+START_SECTION(void getPeaks(double drift_start, double drift_end, std::vector<std::size_t>& peaks) const)
+{
+  // compare to a linear scan for different block and bin sizes
+  for (std::size_t block_size : {1, 7, 256, 5000})
+  {
+    for (std::size_t nr_bins : {1, 3, 32})
+    {
+      OpenSwath::SpectrumMobilityIndex index(*frame, block_size, nr_bins);
+      for (double start = 0.5; start < 1.7; start += 0.1)
+      {
+        for (double width : {0.0, 0.05, 0.3, 2.0})
+        {
+          std::vector<std::size_t> expected, peaks;
+          for (std::size_t k = 0; k < frame_im->data.size(); ++k)
+          {
+            if (start <= frame_im->data[k] && start + width >= frame_im->data[k]) expected.push_back(k);
+          }
+          index.getPeaks(start, start + width, peaks);
+          TEST_EQUAL(peaks == expected, true)
+        }
+      }
+      std::vector<std::size_t> peaks;
+      index.getPeaks(1.0, 1.0, peaks);
+      ABORT_IF(peaks.size() < 2)
+      TEST_EQUAL(peaks[0], 500)
+      TEST_EQUAL(peaks[1], 501)
+      index.getPeaks(1.2, 1.1, peaks);
+      TEST_EQUAL(peaks.size(), 0)
+    }
+  }
+}
+END_SECTION
+
+START_SECTION(static bool addToSpectrum(OSSpectrum& spectrum))
+{
+  OpenSwath::SpectrumPtr expected = OpenSwath::ISpectrumAccess::filterByDrift(frame, 0.9, 1.05);
+  TEST_EQUAL(OpenSwath::SpectrumMobilityIndex::addToSpectrum(*frame), true)
+  TEST_EQUAL(frame->getMobilityIndex() != nullptr, true)
+
+  // filtering uses the index and gives the same result
+  OpenSwath::SpectrumPtr filtered = OpenSwath::ISpectrumAccess::filterByDrift(frame, 0.9, 1.05);
+  TEST_EQUAL(filtered->getMZArray()->data == expected->getMZArray()->data, true)
+  TEST_EQUAL(filtered->getIntensityArray()->data == expected->getIntensityArray()->data, true)
+  TEST_EQUAL(filtered->getDriftTimeArray()->data == expected->getDriftTimeArray()->data, true)
+  TEST_EQUAL(filtered->getMZArray()->data.empty(), false)
+
+  // a replaced ion mobility array invalidates the index
+  OpenSwath::Spectrum copy(*frame);
+  copy.getDataArrays().back() = OpenSwath::BinaryDataArrayPtr(new OpenSwath::BinaryDataArray(*frame_im));
+  TEST_EQUAL(copy.getMobilityIndex()->isIndexOf(copy), false)
+
+  OpenSwath::Spectrum no_im;
+  TEST_EQUAL(OpenSwath::SpectrumMobilityIndex::addToSpectrum(no_im), false)
+  TEST_EQUAL(no_im.getMobilityIndex() == nullptr, true)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -0,0 +1,114 @@
+// Copyright (c) 2002-present, The OpenMS Team -- EKU Tuebingen, ETH Zurich, and FU Berlin
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Hannes Roest $
+// $Authors: Hannes Roest $
+// --------------------------------------------------------------------------
+
+#include "OpenMS/OPENSWATHALGO/DATAACCESS/SpectrumRTIndex.h"
+#include <OpenMS/CONCEPT/ClassTest.h>
+
+#include <cmath>
+
+using namespace OpenMS;
+using namespace std;
+
+///////////////////////////
+
+START_TEST(SpectrumRTIndex, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+// irregular spacing with duplicates and a gap
+std::vector<double> rts = {10.0, 10.5, 11.0, 11.0, 12.5, 20.0, 20.1, 20.2, 35.0};
+
+START_SECTION(std::vector<std::size_t> getSpectraByRT(double RT, double deltaRT) const)
+{
+  OpenSwath::SpectrumRTIndex index(rts);
+  TEST_EQUAL(index.size(), 9)
+  TEST_EQUAL(index.empty(), false)
+
+  std::vector<std::size_t> res = index.getSpectraByRT(11.0, 0.5);
+  ABORT_IF(res.size() != 3)
+  TEST_EQUAL(res[0], 1)
+  TEST_EQUAL(res[2], 3)
+
+  // the first spectrum after RT - deltaRT is always returned
+  res = index.getSpectraByRT(15.0, 1.0);
+  ABORT_IF(res.size() != 1)
+  TEST_EQUAL(res[0], 5)
+  TEST_EQUAL(index.getSpectraByRT(0.0, 0.0).size(), 1)
+  TEST_EQUAL(index.getSpectraByRT(40.0, 1.0).size(), 0)
+  TEST_EQUAL(index.getSpectraByRT(20.0, 100.0).size(), 9)
+
+  // compare to a linear search
+  for (double rt = 5.0; rt < 40.0; rt += 0.05)
+  {
+    for (double delta : {0.0, 0.3, 2.0})
+    {
+      std::vector<std::size_t> expected;
+      for (std::size_t i = 0; i < rts.size(); ++i)
+      {
+        if (rts[i] >= rt - delta && (expected.empty() || rts[i] <= rt + delta)) expected.push_back(i);
+      }
+      TEST_EQUAL(index.getSpectraByRT(rt, delta) == expected, true)
+    }
+  }
+
+  OpenSwath::SpectrumRTIndex empty;
+  TEST_EQUAL(empty.empty(), true)
+  TEST_EQUAL(empty.getSpectraByRT(10.0, 1.0).size(), 0)
+}
+END_SECTION
+
+START_SECTION(std::vector<std::vector<std::size_t> > getSpectraByRT(const std::vector<double>& RTs, double deltaRT) const)
+{
+  OpenSwath::SpectrumRTIndex index(rts);
+  std::vector<std::vector<std::size_t> > res = index.getSpectraByRT({20.1, 10.0, 50.0}, 0.1);
+  ABORT_IF(res.size() != 3)
+  TEST_EQUAL(res[0] == index.getSpectraByRT(20.1, 0.1), true)
+  TEST_EQUAL(res[1] == index.getSpectraByRT(10.0, 0.1), true)
+  TEST_EQUAL(res[2].size(), 0)
+}
+END_SECTION
+
+START_SECTION(int getClosestSpectrum(double RT) const)
+{
+  OpenSwath::SpectrumRTIndex index(rts);
+  TEST_EQUAL(index.getClosestSpectrum(0.0), 0)
+  TEST_EQUAL(index.getClosestSpectrum(10.2), 0)
+  TEST_EQUAL(index.getClosestSpectrum(10.25), 1) // ties go to the later spectrum
+  TEST_EQUAL(index.getClosestSpectrum(12.0), 4)
+  TEST_EQUAL(index.getClosestSpectrum(19.0), 5)
+  TEST_EQUAL(index.getClosestSpectrum(35.0), 8)
+  TEST_EQUAL(index.getClosestSpectrum(36.0), -1)
+  TEST_EQUAL(OpenSwath::SpectrumRTIndex().getClosestSpectrum(1.0), -1)
+
+  // unsorted input: ids refer to the original order
+  OpenSwath::SpectrumRTIndex unsorted({30.0, 10.0, 20.0});
+  TEST_EQUAL(unsorted.getClosestSpectrum(11.0), 1)
+  TEST_EQUAL(unsorted.getClosestSpectrum(26.0), 0)
+  std::vector<std::size_t> res = unsorted.getSpectraByRT(20.0, 10.0);
+  ABORT_IF(res.size() != 3)
+  TEST_EQUAL(res[0], 1)
+  TEST_EQUAL(res[1], 2)
+  TEST_EQUAL(res[2], 0)
+}
+END_SECTION
+
+START_SECTION(std::vector<int> getClosestSpectra(const std::vector<double>& RTs) const)
+{
+  OpenSwath::SpectrumRTIndex index(rts);
+  std::vector<int> res = index.getClosestSpectra({36.0, 20.14, 0.0});
+  ABORT_IF(res.size() != 3)
+  TEST_EQUAL(res[0], -1)
+  TEST_EQUAL(res[1], 6)
+  TEST_EQUAL(res[2], 0)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -10,6 +10,10 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataChainingConsumer.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataTransformingConsumer.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
 #include <OpenMS/PROCESSING/BASELINE/MorphologicalFilter.h>
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
 
@@ -84,6 +88,31 @@ protected:
     setValidStrings_("struc_elem_unit", ListUtils::create<String>("Thomson,DataPoints"));
     registerStringOption_("method", "<string>", "tophat", "The name of the morphological filter to be applied. If you are unsure, use the default.", false);
     setValidStrings_("method", ListUtils::create<String>("identity,erosion,dilation,opening,closing,gradient,tophat,bothat,erosion_simple,dilation_simple"));
+    registerStringOption_("processOption", "<name>", "inmemory", "Whether to load all data and process them in-memory or whether to process the data on the fly (lowmemory) without loading the whole file into memory first", false, true);
+    setValidStrings_("processOption", ListUtils::create<String>("inmemory,lowmemory"));
+  }
+
+  ExitCodes doLowMemAlgorithm(const String& in, const String& out, MorphologicalFilter& morph_filter)
+  {
+    // filter each spectrum while it is read and write it out right away
+    MSDataTransformingConsumer filter_consumer;
+    filter_consumer.setSpectraProcessingFunc([&morph_filter](MSSpectrum& spectrum)
+    {
+      if (!spectrum.isSorted())
+      {
+        spectrum.sortByPosition();
+      }
+      morph_filter.filter(spectrum);
+    });
+    PlainMSDataWritingConsumer writer(out);
+    writer.addDataProcessing(getProcessingInfo_(DataProcessing::BASELINE_REDUCTION));
+
+    MSDataChainingConsumer chain({&filter_consumer, &writer});
+    MzMLFile mz_data_file;
+    mz_data_file.setLogType(log_type_);
+    mz_data_file.transform(in, &chain);
+
+    return EXECUTION_OK;
   }
 
   ExitCodes main_(int, const char **) override
@@ -94,6 +123,20 @@ protected:
     String in = getStringOption_("in");
     String out = getStringOption_("out");
 
+    MorphologicalFilter morph_filter;
+    morph_filter.setLogType(log_type_);
+
+    Param parameters;
+    parameters.setValue("struc_elem_length", getDoubleOption_("struc_elem_length"));
+    parameters.setValue("struc_elem_unit", getStringOption_("struc_elem_unit"));
+    parameters.setValue("method", getStringOption_("method"));
+    morph_filter.setParameters(parameters);
+
+    if (getStringOption_("processOption") == "lowmemory")
+    {
+      return doLowMemAlgorithm(in, out, morph_filter);
+    }
+
     //-------------------------------------------------------------
     // loading input
     //-------------------------------------------------------------
@@ -126,15 +169,6 @@ protected:
     //-------------------------------------------------------------
     // calculations
     //-------------------------------------------------------------
-    MorphologicalFilter morph_filter;
-    morph_filter.setLogType(log_type_);
-
-    Param parameters;
-    parameters.setValue("struc_elem_length", getDoubleOption_("struc_elem_length"));
-    parameters.setValue("struc_elem_unit", getStringOption_("struc_elem_unit"));
-    parameters.setValue("method", getStringOption_("method"));
-
-    morph_filter.setParameters(parameters);
     morph_filter.filterExperiment(ms_exp);
 
     //-------------------------------------------------------------
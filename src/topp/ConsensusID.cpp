@@ -21,6 +21,11 @@
 #include <OpenMS/FORMAT/FileTypes.h>
 #include <OpenMS/CHEMISTRY/ProteaseDB.h>
 #include <unordered_set>
+#include <memory>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace OpenMS;
 using namespace std;
@@ -549,9 +554,84 @@ protected:
   }
 
 
+  /// creates and sets up the consensus algorithm selected with the "algorithm" option
+  std::unique_ptr<ConsensusIDAlgorithm> createConsensusAlgorithm_()
+  {
+    std::unique_ptr<ConsensusIDAlgorithm> consensus;
+    // general algorithm parameters:
+    Param algo_params = ConsensusIDAlgorithmBest().getDefaults();
+    if (algorithm_ == "PEPMatrix")
+    {
+      consensus.reset(new ConsensusIDAlgorithmPEPMatrix());
+      // add algorithm-specific parameters:
+      algo_params.merge(getParam_().copy("PEPMatrix:", true));
+    }
+    else if (algorithm_ == "PEPIons")
+    {
+      consensus.reset(new ConsensusIDAlgorithmPEPIons());
+      // add algorithm-specific parameters:
+      algo_params.merge(getParam_().copy("PEPIons:", true));
+    }
+    else if (algorithm_ == "best")
+    {
+      consensus.reset(new ConsensusIDAlgorithmBest());
+    }
+    else if (algorithm_ == "worst")
+    {
+      consensus.reset(new ConsensusIDAlgorithmWorst());
+    }
+    else if (algorithm_ == "average")
+    {
+      consensus.reset(new ConsensusIDAlgorithmAverage());
+    }
+    else // algorithm_ == "ranks"
+    {
+      consensus.reset(new ConsensusIDAlgorithmRanks());
+    }
+    algo_params.update(getParam_(), false, OpenMS_Log_debug); // update general params.
+    consensus->setParameters(algo_params);
+    return consensus;
+  }
+
+  /**
+    @brief Computes the consensus for all groups of IDs, in parallel
+
+    The algorithms keep state between calls (e.g. caches of sequence similarities), so every thread
+    uses its own instance. The groups are independent and processed in place.
+  */
+  void applyConsensus_(const vector<vector<PeptideIdentification>*>& groups,
+                       const vector<Size>& number_of_runs,
+                       const map<String, String>& se_info)
+  {
+    std::exception_ptr error;
+    #pragma omp parallel if (groups.size() > 1)
+    {
+      std::unique_ptr<ConsensusIDAlgorithm> consensus;
+      #pragma omp critical (ConsensusID_createAlgorithm)
+      consensus = createConsensusAlgorithm_();
+
+      #pragma omp for schedule(dynamic, 100)
+      for (SignedSize i = 0; i < (SignedSize) groups.size(); ++i)
+      {
+        try
+        {
+          consensus->apply(*groups[i], se_info, number_of_runs[i]);
+        }
+        catch (...)
+        {
+          #pragma omp critical (ConsensusID_applyConsensus)
+          if (!error) error = std::current_exception();
+        }
+      }
+    }
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+
   template <typename MapType>
-  void processFeatureOrConsensusMap_(MapType& input_map,
-                                     ConsensusIDAlgorithm* consensus)
+  void processFeatureOrConsensusMap_(MapType& input_map)
   {
     // Problem with feature data: IDs from multiple spectra may be attached to
     // a (consensus) feature, so we may have multiple IDs from the same search
@@ -575,6 +655,8 @@ protected:
     }
 
     // compute consensus:
+    vector<vector<PeptideIdentification>*> groups;
+    vector<Size> group_number_of_runs;
     for (typename MapType::Iterator map_it = input_map.begin();
          map_it != input_map.end(); ++map_it)
     {
@@ -586,8 +668,10 @@ protected:
       }
       Size n_repeats = *max_element(times_seen.begin(), times_seen.end());
 
-      consensus->apply(ids, runid_to_se, number_of_runs * n_repeats);
+      groups.push_back(&ids);
+      group_number_of_runs.push_back(number_of_runs * n_repeats);
     }
+    applyConsensus_(groups, group_number_of_runs, runid_to_se);
 
     // create new identification run:
     setProteinIdentifications_(input_map.getProteinIdentifications());
@@ -608,40 +692,7 @@ protected:
     //----------------------------------------------------------------
     // set up ConsensusID
     //----------------------------------------------------------------
-    ConsensusIDAlgorithm* consensus;
-    // general algorithm parameters:
-    Param algo_params = ConsensusIDAlgorithmBest().getDefaults();
     algorithm_ = getStringOption_("algorithm");
-    if (algorithm_ == "PEPMatrix")
-    {
-      consensus = new ConsensusIDAlgorithmPEPMatrix();
-      // add algorithm-specific parameters:
-      algo_params.merge(getParam_().copy("PEPMatrix:", true));
-    }
-    else if (algorithm_ == "PEPIons")
-    {
-      consensus = new ConsensusIDAlgorithmPEPIons();
-      // add algorithm-specific parameters:
-      algo_params.merge(getParam_().copy("PEPIons:", true));
-    }
-    else if (algorithm_ == "best")
-    {
-      consensus = new ConsensusIDAlgorithmBest();
-    }
-    else if (algorithm_ == "worst")
-    {
-      consensus = new ConsensusIDAlgorithmWorst();
-    }
-    else if (algorithm_ == "average")
-    {
-      consensus = new ConsensusIDAlgorithmAverage();
-    }
-    else // algorithm_ == "ranks"
-    {
-      consensus = new ConsensusIDAlgorithmRanks();
-    }
-    algo_params.update(getParam_(), false, OpenMS_Log_debug); // update general params.
-    consensus->setParameters(algo_params);
 
     //----------------------------------------------------------------
     // idXML
@@ -766,24 +817,29 @@ protected:
           // we could keep track of it but IMHO we should not allow raw there at all (just complicates things)
           to_put.setPrimaryMSRunPath({file_ref_peps.first + ".mzML"});
           setProteinIdentificationSettings_(to_put, mzml_to_sesettings[new_run_id], mzml_to_rescoresettings[new_run_id]);
-          for (const auto& ref_peps : file_ref_peps.second)
+          vector<vector<PeptideIdentification>*> groups;
+          // m/z, RT and spectrum reference of the groups
+          // (has to have a ref, save it, since apply might modify everything)
+          vector<std::tuple<double, double, String>> group_info;
+          for (auto& ref_peps : file_ref_peps.second)
           {
-            vector<PeptideIdentification> peps = ref_peps.second;
+            vector<PeptideIdentification>& peps = ref_peps.second;
             if (peps.empty())
             {
               continue; //sth went wrong. skip
             }
-            double mz = peps[0].getMZ();
-            double rt = peps[0].getRT();
-            // has to have a ref, save it, since apply might modify everything
-            String ref = peps[0].getSpectrumReference();
-            consensus->apply(peps, runid_to_old_se, mzml_to_sesettings[new_run_id].size());
-            for (auto& p : peps)
+            groups.push_back(&peps);
+            group_info.emplace_back(peps[0].getMZ(), peps[0].getRT(), peps[0].getSpectrumReference());
+          }
+          applyConsensus_(groups, vector<Size>(groups.size(), mzml_to_sesettings[new_run_id].size()), runid_to_old_se);
+          for (Size g = 0; g < groups.size(); ++g)
+          {
+            for (auto& p : *groups[g])
             {
               p.setIdentifier(to_put.getIdentifier());
-              p.setMZ(mz);
-              p.setRT(rt);
-              p.setSpectrumReference( ref);
+              p.setMZ(std::get<0>(group_info[g]));
+              p.setRT(std::get<1>(group_info[g]));
+              p.setSpectrumReference(std::get<2>(group_info[g]));
               //TODO copy other meta values from the originals? They need to be collected
               // in the algorithm subclasses though first
               pep_ids.emplace_back(std::move(p));
@@ -862,10 +918,15 @@ protected:
 
         // compute consensus
         pep_ids.clear();
+        vector<vector<PeptideIdentification>*> groups;
+        for (auto& cfeature : grouping)
+        {
+          groups.push_back(&cfeature.getPeptideIdentifications());
+        }
+        applyConsensus_(groups, vector<Size>(groups.size(), old_size), runid_to_se);
         for (auto& cfeature : grouping)
         {
           auto& ids = cfeature.getPeptideIdentifications();
-          consensus->apply(ids, runid_to_se, old_size);
 
           if (!ids.empty())
           {
@@ -894,7 +955,7 @@ protected:
       FeatureMap map;
       FileHandler().loadFeatures(in[0], map, {FileTypes::FEATUREXML});
 
-      processFeatureOrConsensusMap_(map, consensus);
+      processFeatureOrConsensusMap_(map);
 
       FileHandler().storeFeatures(out, map, {FileTypes::FEATUREXML});
     }
@@ -907,13 +968,11 @@ protected:
       ConsensusMap map;
       FileHandler().loadConsensusFeatures(in[0], map, {FileTypes::CONSENSUSXML});
 
-      processFeatureOrConsensusMap_(map, consensus);
+      processFeatureOrConsensusMap_(map);
 
       FileHandler().storeConsensusFeatures(out, map, {FileTypes::CONSENSUSXML});
     }
 
-    delete consensus;
-
     return EXECUTION_OK;
   }
 };
@@ -12,11 +12,17 @@
 #include <OpenMS/CHEMISTRY/ProteaseDB.h>
 #include <OpenMS/CHEMISTRY/ProteaseDigestion.h>
 #include <OpenMS/CHEMISTRY/ResidueDB.h>
+#include <OpenMS/DATASTRUCTURES/BloomFilter.h>
 #include <OpenMS/DATASTRUCTURES/FASTAContainer.h>
+#include <OpenMS/DATASTRUCTURES/StringView.h>
 #include <OpenMS/FORMAT/FASTAFile.h>
 #include <OpenMS/MATH/MathFunctions.h>
 #include <OpenMS/METADATA/ProteinIdentification.h>
+#include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
 
+#include <atomic>
+#include <memory>
 #include <regex>
 
 
@@ -50,6 +56,11 @@ externally.
 
 The tool will keep track of all protein identifiers and report duplicates.
 
+With @p check_collisions, the tool counts the peptides of the decoys (as defined by the given enzyme) which are also
+peptides of a target protein. The target peptides of all input files are kept in a Bloom filter, so the check
+needs little memory even for very large databases, at the price of a small number of false positives.
+Decoys of protein sequences are generated in parallel (see @p threads).
+
 Also the tool automatically checks for decoys already in the input files (based on most common pre-/suffixes)
 and terminates the program if decoys are found.
 
@@ -99,6 +110,7 @@ protected:
     registerDoubleOption_("shuffle_sequence_identity_threshold", "<double>", 0.5, "shuffle: target-decoy amino acid sequence identity threshold for the shuffle algorithm. If the sequence identity is above this threshold, shuffling is repeated. In case of repeated failure, individual amino acids are 'mutated' to produce a different amino acid sequence.", false, true);
 
     registerStringOption_("seed", "<int/'time')>", '1', "Random number seed (use 'time' for system time)", false, true);
+    registerFlag_("check_collisions", "Counts the decoy peptides which are also target peptides (needs an additional pass over the input; only for type 'protein').", true);
 
     StringList all_enzymes;
     ProteaseDB::getInstance()->getAllNames(all_enzymes);
@@ -138,6 +150,50 @@ protected:
     if (as_prefix) return decoy_string + identifier;
     else return identifier + decoy_string;
   }
+
+  /// false positive rate of the collision check
+  static constexpr double COLLISION_FALSE_POSITIVE_RATE = 0.001;
+
+  /// Inserts the peptides of all proteins in @p files into a Bloom filter (digested in parallel)
+  std::unique_ptr<BloomFilter> collectTargetPeptides_(const StringList& files, const ProteaseDigestion& digestion)
+  {
+    // a peptide has about 10 residues, i.e. there are fewer peptides than bytes / 10
+    UInt64 total_size = 0;
+    for (const auto& file : files)
+    {
+      total_size += File::fileSize(file);
+    }
+    auto target_peptides = std::make_unique<BloomFilter>(Size(total_size / 10), COLLISION_FALSE_POSITIVE_RATE);
+
+    const Size chunk_size = 10000;
+    vector<FASTAFile::FASTAEntry> proteins;
+    for (const auto& file : files)
+    {
+      FASTAFile f;
+      f.readStart(file);
+      FASTAFile::FASTAEntry entry;
+      bool has_more = true;
+      while (has_more)
+      {
+        proteins.clear();
+        while (proteins.size() < chunk_size && (has_more = f.readNext(entry)))
+        {
+          proteins.push_back(std::move(entry));
+        }
+        TaskScheduler::parallelFor(0, SignedSize(proteins.size()), [&](SignedSize i)
+        {
+          const String& sequence = proteins[i].sequence;
+          std::vector<std::pair<Size, Size> > peptides;
+          digestion.digestUnmodified(StringView(sequence), peptides);
+          for (const auto& pep : peptides)
+          {
+            target_peptides->insert(std::string_view(sequence).substr(pep.first, pep.second));
+          }
+        });
+      }
+    }
+    return target_peptides;
+  }
   
 
   ExitCodes main_(int, const char**) override
@@ -352,7 +408,106 @@ protected:
     MRMDecoy m;
     m.setParameters(decoy_param);
 
+    // target peptides of all inputs, to count the decoy peptides which are also target peptides
+    std::unique_ptr<BloomFilter> target_peptides;
+    if (getFlag_("check_collisions") && input_type == SeqType::protein)
+    {
+      target_peptides = collectTargetPeptides_(in, digestion);
+    }
+    std::atomic<Size> decoy_peptide_count(0), collision_count(0);
+
+    // generates the decoy of a protein (thread-safe)
+    auto makeProteinDecoy = [&](FASTAFile::FASTAEntry& entry)
+    {
+      // if (terminal_aminos != "none")
+      if (enzyme != "no cleavage" && (keepN || keepC))
+      {
+        std::vector<AASequence> peptides;
+        digestion.digest(AASequence::fromString(entry.sequence), peptides);
+        String new_sequence = "";
+        OpenMS::TargetedExperiment::Peptide p;
+        for (auto const& peptide : peptides)
+        {
+          p.sequence = peptide.toString();
+          // TODO why are the functions from TargetedExperiment and MRMDecoy not anywhere more general?
+          //  No soul would look there.
+          auto decoy_p = shuffle ? m.shufflePeptide(p, identity_threshold, seed, max_attempts) 
+                                 : MRMDecoy::reversePeptide(p, keepN, keepC, keep_const_pattern);
+          new_sequence += decoy_p.sequence;
+        }
+        entry.sequence = new_sequence;
+      }
+      else // no cleavage
+      {
+        // sequence
+        if (shuffle)
+        {
+          Math::RandomShuffler protein_shuffler(seed); // identical proteins are shuffled the same way
+          protein_shuffler.portable_random_shuffle(entry.sequence.begin(), entry.sequence.end());
+        }
+        else // reverse
+        {
+          entry.sequence.reverse();
+        }
+      }
+
+      if (target_peptides)
+      {
+        std::vector<std::pair<Size, Size> > peptides;
+        digestion.digestUnmodified(StringView(entry.sequence), peptides);
+        Size collisions = 0;
+        for (const auto& pep : peptides)
+        {
+          if (target_peptides->mayContain(std::string_view(entry.sequence).substr(pep.first, pep.second))) ++collisions;
+        }
+        decoy_peptide_count += peptides.size();
+        collision_count += collisions;
+      }
+    };
+
     Math::RandomShuffler shuffler(seed);
+    // generates the decoy of an RNA sequence (not thread-safe: the shuffler is not re-seeded for each sequence)
+    auto makeRNADecoy = [&](FASTAFile::FASTAEntry& entry)
+    {
+      string quick_seq = entry.sequence;
+      bool five_p = (entry.sequence.front() == 'p');
+      bool three_p = (entry.sequence.back() == 'p');
+      if (five_p) // we don't want to reverse terminal phosphates
+      {
+        quick_seq.erase(0, 1);
+      }
+      if (three_p) { quick_seq.pop_back(); }
+
+      vector<String> tokenized;
+      std::smatch m;
+      std::string pattern = R"([^\[]|(\[[^\[\]]*\]))";
+      std::regex re(pattern);
+
+      while (std::regex_search(quick_seq, m, re))
+      {
+        tokenized.emplace_back(m.str(0));
+        quick_seq = m.suffix();
+      }
+
+      if (shuffle) { shuffler.portable_random_shuffle(tokenized.begin(), tokenized.end()); }
+      else // reverse
+      {
+        reverse(tokenized.begin(), tokenized.end()); // reverse the tokens
+      }
+      if (five_p) // add back 5'
+      {
+        tokenized.insert(tokenized.begin(), String("p"));
+      }
+      if (three_p) // add back 3'
+      {
+        tokenized.emplace_back("p");
+      }
+      entry.sequence = ListUtils::concatenate(tokenized, "");
+    };
+
+    // the decoys of a chunk of proteins are generated in parallel, then all are written in the input order
+    const Size chunk_size = 10000;
+    vector<FASTAFile::FASTAEntry> targets, decoys;
     for (const auto& file_fasta : in)
     {
       /// in neighbor-peptide mode: write relevant peptides to the output file
@@ -360,115 +515,68 @@ protected:
 
       f.readStart(file_fasta);
       FASTAFile::FASTAEntry entry;
-      OpenMS::TargetedExperiment::Peptide p;
-
-      //-------------------------------------------------------------
-      // calculations
-      //-------------------------------------------------------------
-      while (f.readNext(entry))
+      bool has_more = true;
+      while (has_more)
       {
-        if (identifiers.find(entry.identifier) != identifiers.end())
+        targets.clear();
+        while (targets.size() < chunk_size && (has_more = f.readNext(entry)))
         {
-          OPENMS_LOG_WARN << "DecoyDatabase: Warning, identifier '" << entry.identifier << "' occurs more than once!" << endl;
+          targets.push_back(std::move(entry));
         }
-        identifiers.insert(entry.identifier);
 
-        if (append)
+        //-------------------------------------------------------------
+        // calculations
+        //-------------------------------------------------------------
+        decoys = targets;
+        if (input_type == SeqType::RNA)
         {
-          f.writeNext(entry);
-          if (write_relevant)
+          for (auto& decoy : decoys)
           {
-            fasta_out_relevant.writeNext(entry);
+            makeRNADecoy(decoy);
           }
         }
-
-        // new decoy identifier
-        entry.identifier = getDecoyIdentifier_(entry.identifier, decoy_string, decoy_string_position_prefix);
-
-        // new decoy sequence
-        if (input_type == SeqType::RNA)
+        else // protein input
         {
-          string quick_seq = entry.sequence;
-          bool five_p = (entry.sequence.front() == 'p');
-          bool three_p = (entry.sequence.back() == 'p');
-          if (five_p) // we don't want to reverse terminal phosphates
-          {
-            quick_seq.erase(0, 1);
-          }
-          if (three_p) { quick_seq.pop_back(); }
-
-          vector<String> tokenized;
-          std::smatch m;
-          std::string pattern = R"([^\[]|(\[[^\[\]]*\]))";
-          std::regex re(pattern);
+          TaskScheduler::parallelFor(0, SignedSize(decoys.size()), [&](SignedSize i) { makeProteinDecoy(decoys[i]); });
+        }
 
-          while (std::regex_search(quick_seq, m, re))
+        //-------------------------------------------------------------
+        // writing output
+        //-------------------------------------------------------------
+        for (Size i = 0; i < targets.size(); ++i)
+        {
+          if (identifiers.find(targets[i].identifier) != identifiers.end())
           {
-            tokenized.emplace_back(m.str(0));
-            quick_seq = m.suffix();
+            OPENMS_LOG_WARN << "DecoyDatabase: Warning, identifier '" << targets[i].identifier << "' occurs more than once!" << endl;
           }
+          identifiers.insert(targets[i].identifier);
 
-          if (shuffle) { shuffler.portable_random_shuffle(tokenized.begin(), tokenized.end()); }
-          else // reverse
+          if (append)
           {
-            reverse(tokenized.begin(), tokenized.end()); // reverse the tokens
-          }
-          if (five_p) // add back 5'
-          {
-            tokenized.insert(tokenized.begin(), String("p"));
-          }
-          if (three_p) // add back 3'
-          {
-            tokenized.emplace_back("p");
-          }
-          entry.sequence = ListUtils::concatenate(tokenized, "");
-        }
-        else // protein input
-        {
-          // if (terminal_aminos != "none")
-          if (enzyme != "no cleavage" && (keepN || keepC))
-          {
-            std::vector<AASequence> peptides;
-            digestion.digest(AASequence::fromString(entry.sequence), peptides);
-            String new_sequence = "";
-            for (auto const& peptide : peptides)
+            f.writeNext(targets[i]);
+            if (write_relevant)
             {
-              p.sequence = peptide.toString();
-              // TODO why are the functions from TargetedExperiment and MRMDecoy not anywhere more general?
-              //  No soul would look there.
-              auto decoy_p = shuffle ? m.shufflePeptide(p, identity_threshold, seed, max_attempts) 
-                                     : MRMDecoy::reversePeptide(p, keepN, keepC, keep_const_pattern);
-              new_sequence += decoy_p.sequence;
+              fasta_out_relevant.writeNext(targets[i]);
             }
-            entry.sequence = new_sequence;
           }
-          else // no cleavage
+
+          // new decoy identifier
+          decoys[i].identifier = getDecoyIdentifier_(decoys[i].identifier, decoy_string, decoy_string_position_prefix);
+          f.writeNext(decoys[i]);
+          // optional: if in neighbor mode: T+D of relevant peptides (if requested)
+          if (write_relevant)
           {
-            // sequence
-            if (shuffle)
-            {
-              shuffler.seed(seed); // identical proteins are shuffled the same way -> re-seed
-              shuffler.portable_random_shuffle(entry.sequence.begin(), entry.sequence.end());
-            }
-            else // reverse
-            {
-              entry.sequence.reverse();
-            }
+            fasta_out_relevant.writeNext(decoys[i]);
           }
-        } // protein entry
-
-        //-------------------------------------------------------------
-        // writing output
-        //-------------------------------------------------------------
-        f.writeNext(entry);
-        // optional: if in neighbor mode: T+D of relevant peptides (if requested)
-        if (write_relevant)
-        {
-          fasta_out_relevant.writeNext(entry);
         }
-
-      } // next protein
+      } // next chunk of proteins
     }   // input files
+
+    if (target_peptides)
+    {
+      OPENMS_LOG_INFO << collision_count << " of " << decoy_peptide_count << " decoy peptides are also target peptides"
+                      << " (this includes about " << Size(double(decoy_peptide_count) * COLLISION_FALSE_POSITIVE_RATE) << " false positives of the check)." << endl;
+    }
     
     return EXECUTION_OK;
   }
@@ -352,7 +352,7 @@ protected:
           // Not so easy to implement at first sight. Merge groups whenever one protein overlaps?
           prots[0].getIndistinguishableProteins().clear();
           prots[0].getProteinGroups().clear();
-          merger.insertRuns(prots, peps);
+          merger.insertRuns(std::move(prots), std::move(peps));
         }
         merger.returnResultsAndClear(mergedprots[0], mergedpeps);
       }
@@ -165,6 +165,7 @@ protected:
     registerFlag_("c", "Check for corrupt data in the file (peak files only)");
     registerFlag_("v", "Validate the file only (for mzML, mzData, mzXML, featureXML, idXML, consensusXML, pepXML)");
     registerFlag_("i", "Check whether a given mzML file contains valid indices (conforming to the indexedmzML standard)");
+    registerFlag_("skim", "Only read the meta data of spectra and chromatograms of mzML files, jumping over the binary data (fast; peak counts, m/z and intensity ranges and statistics are not available)", true);
   }
 
   template <class Map>
@@ -881,6 +882,10 @@ protected:
     else // peaks
     {
       SysInfo::MemUsage mu;
+      if (getFlag_("skim"))
+      {
+        fh.getOptions().setSkimBinaryData(true);
+      }
       fh.loadExperiment(in, exp, {in_type}, log_type_, false, false);
 
       // update range information and retrieve which MS levels were recorded
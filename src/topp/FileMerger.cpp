@@ -15,6 +15,8 @@
 #include <OpenMS/FORMAT/FileTypes.h>
 #include <OpenMS/FORMAT/TextFile.h>
 #include <OpenMS/FORMAT/FASTAFile.h>
+#include <OpenMS/FORMAT/OSWFile.h>
+#include <OpenMS/FORMAT/SqMassFile.h>
 
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
 
@@ -60,6 +62,10 @@ For spectrum-containing formats (no feature/consensusXML), the retention times f
 <li>or are auto-generated (starting at 1 with 1 second increment).
 </ul>
 
+OSW and sqMass files are merged in the database: the output is a copy of the first file, to which the features (OSW) or the
+spectra and chromatograms (sqMass) of the other files are added. This combines for example the shards of a distributed
+@ref TOPP_OpenSwathWorkflow run of one MS run (see there); OSW inputs need to be created from the same library.
+
 <B>The command line parameters of this tool are:</B>
 @verbinclude TOPP_FileMerger.cli
 <B>INI file documentation of this tool:</B>
@@ -86,13 +92,13 @@ protected:
 
   void registerOptionsAndFlags_() override
   {
-    StringList valid_in = ListUtils::create<String>("mzData,mzXML,mzML,dta,dta2d,mgf,featureXML,consensusXML,fid,traML,fasta");
+    StringList valid_in = ListUtils::create<String>("mzData,mzXML,mzML,dta,dta2d,mgf,featureXML,consensusXML,fid,traML,fasta,osw,sqMass");
     registerInputFileList_("in", "<files>", StringList(), "Input files separated by blank");
     setValidFormats_("in", valid_in);
     registerStringOption_("in_type", "<type>", "", "Input file type (default: determined from file extension or content)", false);
     setValidStrings_("in_type", valid_in);
     registerOutputFile_("out", "<file>", "", "Output file");
-    setValidFormats_("out", ListUtils::create<String>("mzML,featureXML,consensusXML,traML,fasta"));
+    setValidFormats_("out", ListUtils::create<String>("mzML,featureXML,consensusXML,traML,fasta,osw,sqMass"));
 
     registerFlag_("annotate_file_origin", "Store the original filename in each feature using meta value \"file_origin\" (for featureXML and consensusXML only).");
     registerStringOption_("append_method", "<choice>", "append_rows", "(ConsensusXML-only) Append quantitative information about features row-wise or column-wise.\n"
@@ -345,6 +351,14 @@ protected:
 
       fh.storeTransitions(out_file, out, {FileTypes::TRAML});
     }
+    else if (force_type == FileTypes::OSW)
+    {
+      OSWFile::merge(file_list, out_file);
+    }
+    else if (force_type == FileTypes::SQMASS)
+    {
+      SqMassFile::merge(file_list, out_file);
+    }
     else // raw data input (e.g. mzML)
     {
       // RT
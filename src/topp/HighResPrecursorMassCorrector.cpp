@@ -12,6 +12,10 @@
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
 #include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataChainingConsumer.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataTransformingConsumer.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
 #include <OpenMS/KERNEL/StandardTypes.h>
 #include <OpenMS/MATH/MathFunctions.h>
 #include <OpenMS/PROCESSING/CENTROIDING/PeakPickerHiRes.h>
@@ -22,6 +26,8 @@
 #include <string>
 #include <algorithm>
 #include <iomanip>
+#include <map>
+#include <set>
 
 using namespace OpenMS;
 using namespace std;
@@ -111,6 +117,58 @@ class TOPPHiResPrecursorMassCorrector :
 
       registerOutputFile_("out_csv", "<file>", "", "Optional CSV output file for results on 'nearest_peak' or 'highest_intensity_peak' algorithm (see corresponding subsection) containing columns: " + ListUtils::concatenate(ListUtils::create<String>(PrecursorCorrection::csv_header), ", ") + ".", false);
       setValidFormats_("out_csv", ListUtils::create<String>("csv"));
+
+      registerStringOption_("processOption", "<name>", "inmemory", "Whether to load all data and process them in-memory or whether to load only the MS1 peaks (and the meta data of all spectra) for the correction and to write the corrected spectra on the fly (lowmemory). Not supported with 'feature:keep_original'.", false, true);
+      setValidStrings_("processOption", ListUtils::create<String>("inmemory,lowmemory"));
+    }
+
+    /// Loads the MS1 spectra of @p in with their peaks and all other spectra (and chromatograms) without peaks, which are not needed for the correction
+    void loadMS1Peaks_(const String& in, PeakMap& exp)
+    {
+      MSDataTransformingConsumer drop_peaks;
+      drop_peaks.setSpectraProcessingFunc([](MSSpectrum& spec)
+      {
+        if (spec.getMSLevel() != 1)
+        {
+          spec.clear(false);
+        }
+      });
+      drop_peaks.setChromatogramProcessingFunc([](MSChromatogram& chrom)
+      {
+        chrom.clear(false);
+      });
+      MzMLFile mz_data_file;
+      mz_data_file.setLogType(log_type_);
+      mz_data_file.transform(in, &drop_peaks, exp);
+    }
+
+    /// Streams @p in to @p out, replacing the precursors by the corrected ones of the same spectrum (by native ID) in @p exp
+    void storeCorrectedPrecursors_(const String& in, const String& out, const PeakMap& exp)
+    {
+      map<String, vector<Precursor>> precursors;
+      for (const MSSpectrum& spec : exp)
+      {
+        if (!spec.getPrecursors().empty())
+        {
+          precursors[spec.getNativeID()] = spec.getPrecursors();
+        }
+      }
+
+      MSDataTransformingConsumer correct_consumer;
+      correct_consumer.setSpectraProcessingFunc([&precursors](MSSpectrum& spec)
+      {
+        auto it = precursors.find(spec.getNativeID());
+        if (it != precursors.end())
+        {
+          spec.setPrecursors(it->second);
+        }
+      });
+      PlainMSDataWritingConsumer writer(out);
+
+      MSDataChainingConsumer chain({&correct_consumer, &writer});
+      MzMLFile mz_data_file;
+      mz_data_file.setLogType(log_type_);
+      mz_data_file.transform(in, &chain);
     }
 
     ExitCodes main_(int, const char **) override
@@ -134,8 +192,32 @@ class TOPPHiResPrecursorMassCorrector :
       const double highest_intensity_peak_mz_tolerance = getDoubleOption_("highest_intensity_peak:mz_tolerance");
       const bool highest_intensity_peak_ppm = getStringOption_("highest_intensity_peak:mz_tolerance_unit") == "ppm" ? true : false;
 
+      const bool low_memory = getStringOption_("processOption") == "lowmemory";
+      if (low_memory && keep_original)
+      {
+        OPENMS_LOG_ERROR << "'feature:keep_original' adds spectra and cannot be used with 'processOption' 'lowmemory'." << std::endl;
+        return ILLEGAL_PARAMETERS;
+      }
+
       PeakMap exp;
-      FileHandler().loadExperiment(in_mzml, exp, {FileTypes::MZML});
+      if (low_memory)
+      {
+        loadMS1Peaks_(in_mzml, exp);
+        // corrected precursors are assigned to the streamed spectra by native ID
+        set<String> native_ids;
+        for (const MSSpectrum& spec : exp)
+        {
+          if (!native_ids.insert(spec.getNativeID()).second)
+          {
+            OPENMS_LOG_ERROR << "The native ID '" << spec.getNativeID() << "' is not unique. Use 'processOption' 'inmemory' for this input." << std::endl;
+            return INCOMPATIBLE_INPUT_DATA;
+          }
+        }
+      }
+      else
+      {
+        FileHandler().loadExperiment(in_mzml, exp, {FileTypes::MZML});
+      }
 
       cout << setprecision(12);
 
@@ -175,7 +257,14 @@ class TOPPHiResPrecursorMassCorrector :
         corrected_precursors.insert(corrected_to_nearest_feature.begin(), corrected_to_nearest_feature.end());
       }
 
-      FileHandler().storeExperiment(out_mzml, exp, {FileTypes::MZML},log_type_);
+      if (low_memory)
+      {
+        storeCorrectedPrecursors_(in_mzml, out_mzml, exp);
+      }
+      else
+      {
+        FileHandler().storeExperiment(out_mzml, exp, {FileTypes::MZML},log_type_);
+      }
 
       if (!out_csv.empty())
       {
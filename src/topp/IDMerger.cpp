@@ -309,7 +309,7 @@ protected:
         vector<ProteinIdentification> prots;
         vector<PeptideIdentification> peps;
         idXMLf.loadIdentifications(file,prots,peps, {FileTypes::IDXML});
-        merger.insertRuns(prots, peps);
+        merger.insertRuns(std::move(prots), std::move(peps));
       }
       merger.returnResultsAndClear(proteins[0], peptides);
     }
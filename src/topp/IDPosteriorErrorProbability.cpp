@@ -142,8 +142,6 @@ protected:
     vector<ProteinIdentification> protein_ids;
     vector<PeptideIdentification> peptide_ids;
     file.loadIdentifications(inputfile_name, protein_ids, peptide_ids, {FileTypes::IDXML});
-    PosteriorErrorProbabilityModel PEP_model;
-    PEP_model.setParameters(fit_algorithm);
     //-------------------------------------------------------------
     // calculations
     //-------------------------------------------------------------
@@ -183,26 +181,49 @@ protected:
 
     String out_plot = String(fit_algorithm.getValue("out_plot").toString()).trim();
 
-    for (auto & score : all_scores)
+    // the models (one per engine/charge) are independent: fit them in parallel, then
+    // evaluate the results in the original order. Plotting writes (and runs gnuplot on) files,
+    // so the fits stay sequential if plots are requested.
+    vector<map<String, vector<vector<double> > >::iterator> score_its;
+    for (auto it = all_scores.begin(); it != all_scores.end(); ++it)
     {
-      vector<String> engine_info;
-      score.first.split(',', engine_info);
-      String engine = engine_info[0];
-      Int charge = (engine_info.size() == 2) ? engine_info[1].toInt() : -1;
+      score_its.push_back(it);
+    }
+    vector<PosteriorErrorProbabilityModel> PEP_models(score_its.size());
+    vector<char> fit_succeeded(score_its.size(), false);
 
+#pragma omp parallel for schedule(dynamic) if (out_plot.empty())
+    for (SignedSize i = 0; i < (SignedSize)score_its.size(); ++i)
+    {
+      Param model_param = fit_algorithm;
       if (split_charge)
       {
+        vector<String> engine_info;
+        score_its[i]->first.split(',', engine_info);
+        Int charge = (engine_info.size() == 2) ? engine_info[1].toInt() : -1;
         // only adapt plot output if plot is requested (this badly violates the output rules and needs to change!)
         // one way to fix this: plot charges into a single file (no renaming of output file needed) - but this requires major code restructuring
-        if (!out_plot.empty()) fit_algorithm.setValue("out_plot", out_plot + "_charge_" + String(charge));
-        PEP_model.setParameters(fit_algorithm);
+        if (!out_plot.empty()) model_param.setValue("out_plot", out_plot + "_charge_" + String(charge));
       }
+      PEP_models[i].setParameters(model_param);
 
       // fit to score vector
       //TODO choose outlier handling based on search engine? If not set by user?
       //XTandem is prone to accumulation at min values/censoring
       //OMSSA is prone to outliers
-      bool return_value = PEP_model.fit(score.second[0], outlier_handling);
+      fit_succeeded[i] = PEP_models[i].fit(score_its[i]->second[0], outlier_handling);
+    }
+
+    for (Size i = 0; i < score_its.size(); ++i)
+    {
+      auto& score = *score_its[i];
+      PosteriorErrorProbabilityModel& PEP_model = PEP_models[i];
+      vector<String> engine_info;
+      score.first.split(',', engine_info);
+      String engine = engine_info[0];
+      Int charge = (engine_info.size() == 2) ? engine_info[1].toInt() : -1;
+
+      bool return_value = fit_succeeded[i];
 
       if (!return_value) 
       {
@@ -113,21 +113,13 @@ protected:
       throw Exception::Precondition(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "idXML file has to store protein and peptide identifications!");
     }
 
-    IDRipper::RipFileMap ripped;
-
-    // rip the idXML-file into several idXML according to the annotated file origin
-    IDRipper ripper;
-    ripper.rip(ripped, proteins, peptides, numeric_filenames, split_ident_runs);
-
     //-------------------------------------------------------------
     // writing output
     //-------------------------------------------------------------
 
-    for (IDRipper::RipFileMap::iterator it = ripped.begin(); it != ripped.end(); ++it)
+    // each output file is written as soon as it is assembled, so not all of them are held in memory
+    auto write_rip_file = [&](const IDRipper::RipFileIdentifier& rfi, IDRipper::RipFileContent&& rfc)
     {
-      const IDRipper::RipFileIdentifier& rfi = it->first;
-      const IDRipper::RipFileContent& rfc = it->second;
-
       QString output = output_directory.toQString();
 
       String out_fname;
@@ -147,7 +139,12 @@ protected:
 
       QDir dir(output_directory.toQString());
       FileHandler().storeIdentifications(out, rfc.prot_idents, rfc.pep_idents, {FileTypes::IDXML});
-    }
+    };
+
+    // rip the idXML-file into several idXML according to the annotated file origin
+    IDRipper ripper;
+    ripper.rip(write_rip_file, proteins, peptides, numeric_filenames, split_ident_runs);
+
     return EXECUTION_OK;
   }
 };
@@ -13,10 +13,15 @@
 
 #include <OpenMS/FORMAT/FileTypes.h>
 #include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataChainingConsumer.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataTransformingConsumer.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
 #include <OpenMS/FORMAT/TextFile.h>
 
 #include <OpenMS/KERNEL/FeatureMap.h>
 
+#include <set>
 #include <vector>
 
 using namespace OpenMS;
@@ -144,6 +149,8 @@ protected:
     setValidFormats_("in", {"mzML"});
     registerOutputFile_("out", "<file>", "", "Output file ");
     setValidFormats_("out", {"mzML"});
+    registerStringOption_("processOption", "<name>", "inmemory", "Whether to load all data and process them in-memory or whether to compute the calibration from the meta data (and lock mass spectra, if used) and apply it on the fly (lowmemory) without loading the whole file into memory first", false, true);
+    setValidStrings_("processOption", {"inmemory", "lowmemory"});
     registerInputFile_("rscript_executable", "<file>", "Rscript", "Path to the Rscript executable (default: 'Rscript').", false, false, {"is_executable"});
         
     addEmptyLine_();
@@ -202,6 +209,30 @@ protected:
     setValidFormats_("quality_control:residuals_plot", {"png"});
   }
 
+  /// Streams @p in to @p out, applying the model computed by @p ic (if given) to each spectrum
+  void streamCalibration_(const String& in, const String& out, const InternalCalibration* ic, const IntList& ms_level)
+  {
+    MSDataTransformingConsumer calibrate_consumer;
+    if (ic != nullptr)
+    {
+      calibrate_consumer.setSpectraProcessingFunc([&](MSSpectrum& spec)
+      {
+        auto it = ic->getSpectrumModels().find(spec.getNativeID());
+        if (it != ic->getSpectrumModels().end())
+        {
+          InternalCalibration::applyTransformation(spec, ms_level, it->second);
+        }
+      });
+    }
+    PlainMSDataWritingConsumer writer(out);
+    writer.addDataProcessing(getProcessingInfo_(DataProcessing::CALIBRATION));
+
+    MSDataChainingConsumer chain({&calibrate_consumer, &writer});
+    MzMLFile mz_data_file;
+    mz_data_file.setLogType(log_type_);
+    mz_data_file.transform(in, &chain);
+  }
+
   ExitCodes main_(int, const char**) override
   {
     //-------------------------------------------------------------
@@ -216,6 +247,7 @@ protected:
     double rt_chunk = getDoubleOption_("RT_chunking");
     
     IntList ms_level = getIntList_("ms_level");
+    bool low_memory = (getStringOption_("processOption") == "lowmemory");
 
     if (((int)!cal_lock.empty() + (int)!cal_id.empty()) != 1)
     {
@@ -227,10 +259,30 @@ protected:
     // loading input
     //-------------------------------------------------------------
 
-    // Raw data
+    // Raw data (only the meta data in low memory mode: the models are computed on it and applied while streaming the data)
     PeakMap exp;
     FileHandler mz_file;
-    mz_file.loadExperiment(in, exp, {FileTypes::MZML}, log_type_);
+    if (low_memory)
+    {
+      MzMLFile skeleton_file;
+      skeleton_file.setLogType(log_type_);
+      skeleton_file.getOptions().setFillData(false);
+      skeleton_file.load(in, exp);
+      // models are assigned to the streamed spectra by native ID
+      std::set<String> native_ids;
+      for (const MSSpectrum& spec : exp)
+      {
+        if (!native_ids.insert(spec.getNativeID()).second)
+        {
+          writeLogError_("Error: The native ID '" + spec.getNativeID() + "' is not unique. Use 'processOption' 'inmemory' for this input.");
+          return INCOMPATIBLE_INPUT_DATA;
+        }
+      }
+    }
+    else
+    {
+      mz_file.loadExperiment(in, exp, {FileTypes::MZML}, log_type_);
+    }
 
     InternalCalibration ic;
     ic.setLogType(log_type_);
@@ -277,7 +329,22 @@ protected:
 
       // match calibrants to data
       CalibrationData failed_points;
-      ic.fillCalibrants(exp, ref_masses, tol_ppm, lock_require_mono, lock_require_iso, failed_points, debug_level_ > 0);
+      if (low_memory)
+      { // only the spectra of the lock mass MS levels are needed with peaks
+        PeakMap exp_lock;
+        MzMLFile lock_file;
+        lock_file.setLogType(log_type_);
+        for (const InternalCalibration::LockMass& lm : ref_masses)
+        {
+          lock_file.getOptions().addMSLevel(lm.ms_level);
+        }
+        lock_file.load(in, exp_lock);
+        ic.fillCalibrants(exp_lock, ref_masses, tol_ppm, lock_require_mono, lock_require_iso, failed_points, debug_level_ > 0);
+      }
+      else
+      {
+        ic.fillCalibrants(exp, ref_masses, tol_ppm, lock_require_mono, lock_require_iso, failed_points, debug_level_ > 0);
+      }
       
       // write matched lock mass peaks
       if (!file_cal_lock_out.empty())
@@ -308,6 +375,11 @@ protected:
       }
       OPENMS_LOG_ERROR << "The 'force' flag was set to true. Storing uncalibrated data to '-out'." << std::endl;
       // do not calibrate
+      if (low_memory)
+      {
+        streamCalibration_(in, out, nullptr, ms_level);
+        return EXECUTION_OK;
+      }
       addDataProcessing_(exp, getProcessingInfo_(DataProcessing::CALIBRATION));
       mz_file.storeExperiment(out, exp, {FileTypes::MZML}, log_type_);
       return EXECUTION_OK;
@@ -353,6 +425,12 @@ protected:
     // writing output
     //-------------------------------------------------------------
 
+    if (low_memory)
+    {
+      streamCalibration_(in, out, &ic, ms_level);
+      return EXECUTION_OK;
+    }
+
     //annotate output with data processing info
     addDataProcessing_(exp, getProcessingInfo_(DataProcessing::CALIBRATION));
 
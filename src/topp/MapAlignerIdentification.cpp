@@ -14,6 +14,7 @@
 #include <OpenMS/METADATA/ExperimentalDesign.h>
 #include <OpenMS/FORMAT/ExperimentalDesignFile.h>
 #include <OpenMS/FORMAT/OMSFile.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
 
 using namespace OpenMS;
 using namespace std;
@@ -161,10 +162,11 @@ private:
     if (model_type != "none")
     {
       model_params = model_params.copy(model_type + ":", true);
-      for (TransformationDescription& tra : transformations)
+      // the models are independent of each other
+      TaskScheduler::parallelFor(0, transformations.size(), [&](SignedSize i)
       {
-        tra.fitModel(model_type, model_params);
-      }
+        transformations[i].fitModel(model_type, model_params);
+      });
     }
   }
 
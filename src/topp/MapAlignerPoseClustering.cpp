@@ -10,6 +10,7 @@
 #include <OpenMS/APPLICATIONS/MapAlignerBase.h>
 //TODO remove when we get loadsize support in handler
 #include <OpenMS/FORMAT/FeatureXMLFile.h>
+#include <OpenMS/FORMAT/InMemoryFileStore.h>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -148,25 +149,36 @@ protected:
     {
       OPENMS_LOG_INFO << "Picking a reference (by size) ..." << std::flush;
       // use map with highest number of features as reference:
-      Size max_count(0);
-      FeatureXMLFile f;
-      for (Size i = 0; i < in_files.size(); ++i)
+      std::vector<Size> sizes(in_files.size(), 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+      for (int i = 0; i < static_cast<int>(in_files.size()); ++i)
       {
-        Size s = 0;
-        if (in_type == FileTypes::FEATUREXML) 
+        if (in_type == FileTypes::FEATUREXML && InMemoryFileStore::isInMemory(in_files[i]))
         {
-          s = f.loadSize(in_files[i]);
+          FeatureMap map;
+          FileHandler().loadFeatures(in_files[i], map, {FileTypes::FEATUREXML});
+          sizes[i] = map.size();
+        }
+        else if (in_type == FileTypes::FEATUREXML)
+        {
+          sizes[i] = FeatureXMLFile().loadSize(in_files[i]); // FeatureXMLFile is not thread-safe, use one per file
         }
         else if (in_type == FileTypes::MZML) // this is expensive!
         {
           PeakMap exp;
           FileHandler().loadExperiment(in_files[i], exp, {FileTypes::MZML});
           exp.updateRanges(1);
-          s = exp.getSize();
+          sizes[i] = exp.getSize();
         }
-        if (s > max_count)
+      }
+      Size max_count(0);
+      for (Size i = 0; i < in_files.size(); ++i)
+      {
+        if (sizes[i] > max_count)
         {
-          max_count = s;
+          max_count = sizes[i];
           reference_index = i;
         }
       }
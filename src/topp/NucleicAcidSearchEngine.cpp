@@ -1273,11 +1273,18 @@ protected:
 
             Size scan_index = prec_it->second.scan_index;
             const MSSpectrum& exp_spectrum = spectra[scan_index];
+            // if only the top hits are reported, most matches are discarded -
+            // then score first and generate peak annotations only for the
+            // matches that are kept (see below):
             vector<PeptideHit::PeakAnnotation> annotations;
-            double score = MetaboliteSpectralMatching::computeHyperScore(
-              search_param.fragment_mass_tolerance,
-              search_param.fragment_tolerance_ppm, exp_spectrum, theo_spectrum,
-              annotations);
+            double score = (report_top_hits == 0) ?
+              MetaboliteSpectralMatching::computeHyperScore(
+                search_param.fragment_mass_tolerance,
+                search_param.fragment_tolerance_ppm, exp_spectrum, theo_spectrum,
+                annotations) :
+              MetaboliteSpectralMatching::computeHyperScore(
+                search_param.fragment_mass_tolerance,
+                search_param.fragment_tolerance_ppm, exp_spectrum, theo_spectrum);
 
             if (!exp_ms2_out.empty())
             {
@@ -1299,6 +1306,26 @@ protected:
 
             OPENMS_LOG_DEBUG << "Score: " << score << endl;
 
+            if (report_top_hits > 0)
+            {
+              // once a spectrum has enough hits, the worst score of its hits
+              // never decreases - so a match rejected now would also be
+              // rejected when it is added below:
+              bool keep = true;
+#pragma omp critical (annotated_hits_access)
+              {
+                const HitsByScore& scan_hits = annotated_hits[scan_index];
+                keep = (scan_hits.size() < report_top_hits) ||
+                  (score >= (--scan_hits.end())->first);
+              }
+              if (!keep) continue;
+
+              MetaboliteSpectralMatching::computeHyperScore(
+                search_param.fragment_mass_tolerance,
+                search_param.fragment_tolerance_ppm, exp_spectrum, theo_spectrum,
+                annotations);
+            }
+
 #pragma omp critical (annotated_hits_access)
             {
               HitsByScore& scan_hits = annotated_hits[scan_index];
@@ -1331,7 +1358,7 @@ protected:
                 // @TODO: is "observed - calculated" the right way around?
                 ah.precursor_error_ppm =
                   (prec_it->first - candidate_mass) / candidate_mass * 1.0e6;
-                ah.annotations = annotations;
+                ah.annotations = std::move(annotations);
                 ah.precursor_ref = &(prec_it->second);
               }
             }
@@ -89,6 +89,7 @@ class TOPPOpenSwathMzMLFileCacher
     //setValidFormats_("out_meta",ListUtils::create<String>("mzML"));
 
     registerFlag_("convert_back", "Convert back to mzML");
+    registerFlag_("compress_cache", "Compress each spectrum and chromatogram of the cached file individually (zlib, lossless). Reduces disk usage while keeping random access.", true);
 
     registerStringOption_("lossy_compression", "<type>", "true", "Use numpress compression to achieve optimally small file size (attention: may cause small loss of precision; only for mzML data).", false);
     setValidStrings_("lossy_compression", ListUtils::create<String>("true,false"));
@@ -108,6 +109,7 @@ class TOPPOpenSwathMzMLFileCacher
     String out_cached = out_meta + ".cached";
     bool convert_back =  getFlag_("convert_back");
     bool process_lowmemory = getFlag_("process_lowmemory");
+    bool compress_cache = getFlag_("compress_cache");
     int batchSize = (int)getIntOption_("lowmem_batchsize");
 
     bool full_meta = (getStringOption_("full_meta") == "true");
@@ -199,7 +201,7 @@ class TOPPOpenSwathMzMLFileCacher
         MzMLFile f;
         f.setLogType(log_type_);
 
-        MSDataCachedConsumer consumer(out_cached, true);
+        MSDataCachedConsumer consumer(out_cached, true, compress_cache);
         PeakFileOptions opt = f.getOptions();
         opt.setMaxDataPoolSize(batchSize);
         f.setOptions(opt);
@@ -217,7 +219,7 @@ class TOPPOpenSwathMzMLFileCacher
         cacher.setLogType(log_type_);
 
         FileHandler().loadExperiment(in, exp, {FileTypes::MZML}, log_type_);
-        cacher.writeMemdump(exp, out_cached);
+        cacher.writeMemdump(exp, out_cached, compress_cache);
         cacher.writeMetadata(exp, out_meta, true);
       }
     }
@@ -13,6 +13,7 @@
 // Files
 #include <OpenMS/FORMAT/FileHandler.h>
 #include <OpenMS/FORMAT/FileTypes.h>
+#include <OpenMS/FORMAT/OSWFile.h>
 #include <OpenMS/FORMAT/SwathFile.h>
 #include <OpenMS/FORMAT/DATAACCESS/MSDataTransformingConsumer.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/SwathWindowLoader.h>
@@ -375,6 +376,26 @@ The tab-separated feature output contains the following information:
 
 The overall execution flow for this tool is implemented in @ref OpenMS::OpenSwathWorkflow "OpenSwathWorkflow".
 
+<h3>Distributed analysis:</h3>
+
+A single run can be analyzed on several nodes by splitting its SWATH windows
+into shards: each node runs the tool with the same input and parameters and
+its own @p -shard_index (0 to @p -shard_count - 1), which deals the MS2 windows
+round-robin and processes only its share (MS1-only data is processed by
+shard 0). The shards of one run share the run ID, so their .osw (or
+sqMass/mzML chromatogram) outputs can be combined with @ref TOPP_FileMerger
+into the result of a single run. To avoid calibrating on every node, compute
+the RT normalization once (@p -Debugging:irt_trafo) and pass it to the shards
+using @p -rt_norm. SONAR data cannot be sharded.
+
+<h3>Resuming interrupted runs:</h3>
+
+With @p -resume, the features of each SWATH window are written to the OSW
+output together with a checkpoint of the window (in one transaction). If a run
+is interrupted (e.g. a preempted job), starting it again with the same
+parameters and @p -resume continues in the existing OSW output and skips the
+completed windows. Only OSW output can be resumed (no @p -out_chrom).
+
 <B>The command line parameters of this tool are:</B>
 @verbinclude TOPP_OpenSwathWorkflow.cli
 <B>INI file documentation of this tool:</B>
@@ -405,6 +426,7 @@ protected:
     setValidFormats_("tr", ListUtils::create<String>("traML,tsv,pqp"));
     registerStringOption_("tr_type", "<type>", "", "input file type -- default: determined from file extension or content\n", false);
     setValidStrings_("tr_type", ListUtils::create<String>("traML,tsv,pqp"));
+    registerFlag_("tr_snapshot", "For PQP transition files: store the converted transitions in a binary snapshot next to the file ('<tr>.snapshot') and load it instead of the PQP file in subsequent runs (as long as the PQP file is unchanged)", true);
 
     // one of the following two needs to be set
     registerInputFile_("tr_irt", "<file>", "", "transition file ('TraML')", false);
@@ -498,6 +520,15 @@ protected:
 
     registerIntOption_("batchSize", "<number>", 1000, "The batch size of chromatograms to process (0 means to only have one batch, sensible values are around 250-1000)", false, true);
     setMinInt_("batchSize", 0);
+    registerIntOption_("batches_per_pass", "<number>", 8, "How many batches (see batchSize) are extracted together in one pass over a SWATH map. Each spectrum is read and decoded once per pass; larger values reduce I/O but keep more chromatograms in memory.", false, true);
+    setMinInt_("batches_per_pass", 1);
+    registerIntOption_("spectrum_cache_size", "<number>", 32, "How many decoded spectra per SWATH map are kept in a cache shared by all threads during scoring (overlapping peak groups fetch the same spectra repeatedly). Mostly helps with cached and sqMass input, 0 disables the cache.", false, true);
+    setMinInt_("spectrum_cache_size", 0);
+    registerIntOption_("shard_count", "<number>", 1, "Number of shards the SWATH windows are split into to distribute the analysis of a run over several processes or nodes (see shard_index).", false, true);
+    setMinInt_("shard_count", 1);
+    registerIntOption_("shard_index", "<number>", 0, "Shard processed by this process (0 to shard_count - 1). MS2 windows are dealt round-robin to the shards; merge the outputs of all shards with FileMerger.", false, true);
+    setMinInt_("shard_index", 0);
+    registerResumeFlag_("SWATH windows (requires out_osw, not available with out_chrom)");
     registerIntOption_("outer_loop_threads", "<number>", -1, "How many threads should be used for the outer loop (-1 use all threads, use 4 to analyze 4 SWATH windows in memory at once).", false, true);
 
     registerIntOption_("ms1_isotopes", "<number>", 3, "The number of MS1 isotopes used for extraction", false, true);
@@ -617,6 +648,20 @@ protected:
     }
   }
 
+  /// Run ID shared by all shards of a run (FNV-1a hash of the input file names, independent of their directory)
+  static UInt64 shardRunId_(const StringList& file_list)
+  {
+    UInt64 hash = 14695981039346656037ULL;
+    for (const String& file : file_list)
+    {
+      for (const char c : File::basename(file) + '\n')
+      {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+      }
+    }
+    return hash;
+  }
+
   ExitCodes main_(int, const char **) override
   {
     ///////////////////////////////////
@@ -661,6 +706,11 @@ protected:
     bool use_ms1_traces = getStringOption_("enable_ms1") == "true";
     bool enable_uis_scoring = getStringOption_("enable_ipf") == "true";
     int batchSize = (int)getIntOption_("batchSize");
+    int batches_per_pass = (int)getIntOption_("batches_per_pass");
+    int spectrum_cache_size = (int)getIntOption_("spectrum_cache_size");
+    Size shard_count = (Size)getIntOption_("shard_count");
+    Size shard_index = (Size)getIntOption_("shard_index");
+    bool resume = getFlag_("resume");
     int outer_loop_threads = (int)getIntOption_("outer_loop_threads");
     int ms1_isotopes = (int)getIntOption_("ms1_isotopes");
     Size debug_level = (Size)getIntOption_("debug");
@@ -699,6 +749,28 @@ protected:
       std::cout << "When using sqMass input files, it is highly recommended to use the workingInMemory option as otherwise data access will be very slow." << std::endl;
     }
 
+    if (shard_index >= shard_count)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Parameter shard_index (" + String(shard_index) + ") needs to be smaller than shard_count (" + String(shard_count) + ").");
+    }
+    if ((shard_count > 1 || resume) && sonar)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "SONAR data cannot be analyzed in shards or resumed.");
+    }
+    if (resume && (out_osw.empty() || !out_chrom.empty()))
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+          "Only the OSW output can be resumed: resume requires out_osw and cannot be used with out_chrom.");
+    }
+    // an interrupted run is continued in its output file (instead of a fresh copy of the library)
+    bool resuming = resume && !OpenSwathOSWWriter(out_osw, 0).readCheckpoints().empty();
+    if (shard_count > 1 && trafo_in.empty() && !irt_tr_file.empty())
+    {
+      std::cout << "Each shard computes its own RT normalization. To calibrate only once, store it using Debugging:irt_trafo and pass it to the shards using rt_norm." << std::endl;
+    }
+
     if (trafo_in.empty() && irt_tr_file.empty())
     {
       std::cout << "Since neither rt_norm nor tr_irt is set, OpenSWATH will " <<
@@ -784,13 +856,13 @@ protected:
     ///////////////////////////////////
     // Load the transitions
     ///////////////////////////////////
-    OpenSwath::LightTargetedExperiment transition_exp = loadTransitionList(tr_type, tr_file, tsv_reader_param);
+    OpenSwath::LightTargetedExperiment transition_exp = loadTransitionList(tr_type, tr_file, tsv_reader_param, getFlag_("tr_snapshot"));
     OPENMS_LOG_INFO << "Loaded " << transition_exp.getProteins().size() << " proteins, " <<
       transition_exp.getCompounds().size() << " compounds with " << transition_exp.getTransitions().size() << " transitions." << std::endl;
 
     if (tr_type == FileTypes::PQP)
     {
-      if (!out_osw.empty())
+      if (!out_osw.empty() && !resuming)
       { // copy the PQP file and name it OSW file
         std::ifstream  src(tr_file.c_str(), std::ios::binary);
         std::ofstream  dst(out_osw.c_str(), std::ios::binary | std::ios::trunc);
@@ -920,7 +992,10 @@ protected:
     // Either use chrom.mzML or sqliteDB (sqMass)
     ///////////////////////////////////
     Interfaces::IMSDataConsumer* chromatogramConsumer;
-    UInt64 run_id = OpenMS::UniqueIdGenerator::getUniqueId();
+    // shards of one run need the same run ID to be merged, so it is derived from the input files
+    // (a resumed run continues with the ID of the interrupted one)
+    UInt64 run_id = shard_count > 1 ? shardRunId_(file_list) : OpenMS::UniqueIdGenerator::getUniqueId();
+    if (resuming) run_id = OSWFile(out_osw).getRunID();
     prepareChromOutput(&chromatogramConsumer, exp_meta, transition_exp, out_chrom, run_id);
 
     ///////////////////////////////////
@@ -944,6 +1019,10 @@ protected:
     {
       OpenSwathWorkflow wf(use_ms1_traces, use_ms1_im, prm, pasef, outer_loop_threads);
       wf.setLogType(log_type_);
+      wf.setBatchesPerPass(batches_per_pass);
+      wf.setSpectrumCacheSize(spectrum_cache_size);
+      wf.setShard(shard_index, shard_count);
+      wf.setResume(resume);
       wf.performExtraction(swath_maps, trafo_rtnorm, cp, cp_ms1, feature_finder_param, transition_exp,
           out_featureFile, !out.empty(), tsvwriter, oswwriter, chromatogramConsumer, batchSize, ms1_isotopes, load_into_memory);
     }
@@ -16,6 +16,9 @@
 
 #include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
 
+#include <exception>
+#include <limits>
+
 using namespace OpenMS;
 using namespace std;
 
@@ -101,6 +104,10 @@ protected:
 
   /**
     @brief Helper class for the Low Memory peak-picking
+
+    Spectra are collected in small batches which are picked in parallel and
+    then written in their original order. Call flush() after the last
+    spectrum/chromatogram was consumed.
   */
   class PPHiResMzMLConsumer :
     public MSDataWritingConsumer
@@ -115,7 +122,72 @@ protected:
       pp_ = pp;
     }
 
-    void processSpectrum_(MapType::SpectrumType& s) override
+    void consumeSpectrum(MapType::SpectrumType& s) override
+    {
+      batch_.push_back(s);
+      if (batch_.size() >= batch_size_)
+      {
+        flush();
+      }
+    }
+
+    void consumeChromatogram(MapType::ChromatogramType& c) override
+    {
+      flush(); // spectra have to be written before the chromatograms
+      MSDataWritingConsumer::consumeChromatogram(c);
+    }
+
+    /// Picks and writes the spectra collected so far
+    void flush()
+    {
+      std::exception_ptr error;
+      SignedSize error_idx = std::numeric_limits<SignedSize>::max();
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize i = 0; i < (SignedSize)batch_.size(); ++i)
+      {
+        try
+        {
+          pickSpectrum_(batch_[i]);
+        }
+        catch (...)
+        {
+#pragma omp critical (PPHiResMzMLConsumer_flush)
+          {
+            if (i < error_idx)
+            {
+              error_idx = i;
+              error = std::current_exception();
+            }
+          }
+        }
+      }
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+
+      for (MapType::SpectrumType& s : batch_)
+      {
+        MSDataWritingConsumer::consumeSpectrum(s);
+      }
+      batch_.clear();
+    }
+
+  protected:
+
+    void processSpectrum_(MapType::SpectrumType& /* s */) override
+    {
+      // already picked in flush()
+    }
+
+    void processChromatogram_(MapType::ChromatogramType & c) override
+    {
+      MapType::ChromatogramType c_out;
+      pp_.pick(c, c_out);
+      c = std::move(c_out);
+    }
+
+    void pickSpectrum_(MapType::SpectrumType& s) const
     {
       if (ms_levels_.empty()) //auto mode
       {
@@ -134,17 +206,14 @@ protected:
       s = std::move(sout);
     }
 
-    void processChromatogram_(MapType::ChromatogramType & c) override
-    {
-      MapType::ChromatogramType c_out;
-      pp_.pick(c, c_out);
-      c = std::move(c_out);
-    }
-
   private:
 
     PeakPickerHiRes pp_;
     std::vector<Int> ms_levels_;
+    /// spectra waiting to be picked and written
+    std::vector<MapType::SpectrumType> batch_;
+    /// number of spectra that are picked together
+    static constexpr Size batch_size_ = 100;
   };
 
   void registerOptionsAndFlags_() override
@@ -179,6 +248,7 @@ protected:
     MzMLFile mz_data_file;
     mz_data_file.setLogType(log_type_);
     mz_data_file.transform(in, &pp_consumer);
+    pp_consumer.flush();
 
     return EXECUTION_OK;
   }
@@ -26,6 +26,9 @@
 #include <cmath>
 #include <string>
 #include <set>
+#include <exception>
+#include <limits>
+#include <unordered_map>
 //#include <typeinfo>
 
 #include <boost/algorithm/clamp.hpp>
@@ -353,10 +356,11 @@ protected:
     }
   }
 
-  void readPoutAsMap_(const String& pout_file, std::map<String, PercolatorResult>& pep_map)
+  void readPoutAsMap_(const String& pout_file, std::unordered_map<String, PercolatorResult>& pep_map)
   {
     CsvFile csv_file(pout_file, '\t');
     StringList row;
+    pep_map.reserve(pep_map.size() + csv_file.rowCount());
 
     for (Size i = 1; i < csv_file.rowCount(); ++i)
     {
@@ -365,13 +369,13 @@ protected:
       // note: Since we create our pin file in a way that the SpecID (=PSMId) is composed of filename + spectrum native id
       //  this will be passed through Percolator and we use it again to read it back in.
       String spec_ref = res.PSMId + res.peptide;
-      writeDebug_("PSM identifier in pout file: " + spec_ref, 10);
-
-      // retain only the best result in the unlikely case that a PSMId+peptide combination occurs multiple times
-      if (pep_map.find(spec_ref) == pep_map.end())
+      if (debug_level_ >= 10)
       {
-        pep_map.insert( map<String, PercolatorResult>::value_type ( spec_ref, res ) );
+        writeDebug_("PSM identifier in pout file: " + spec_ref, 10);
       }
+
+      // retain only the best result in the unlikely case that a PSMId+peptide combination occurs multiple times
+      pep_map.emplace(std::move(spec_ref), std::move(res));
     }
   }
 
@@ -940,7 +944,7 @@ protected:
     //-------------------------------------------------------------
     // when percolator finished calculation, it stores the results -r option (with or without -U) or -m (which seems to be not working)
     //  WARNING: The -r option cannot be used in conjunction with -U: no peptide level statistics are calculated, redirecting PSM level statistics to provided file instead.
-    map<String, PercolatorResult> pep_map;
+    unordered_map<String, PercolatorResult> pep_map;
     String pout_target = getStringOption_("out_pout_target");
     String pout_decoy = getStringOption_("out_pout_decoy");
     String pout_target_proteins = getStringOption_("out_pout_target_proteins");
@@ -1002,86 +1006,120 @@ protected:
       size_t cnt = 0;
       String run_identifier = all_protein_ids.front().getIdentifier();
       const String scoreType = getStringOption_("score_type");
-      size_t index = 0;
-      for (PeptideIdentification& pep_id : all_peptide_ids)
+      const UInt svm_score_idx = MetaInfoInterface::metaRegistry().registerName("MS:1001492");
+      const UInt qvalue_idx = MetaInfoInterface::metaRegistry().registerName("MS:1001491");
+      const UInt pep_idx = MetaInfoInterface::metaRegistry().registerName("MS:1001493");
+      std::exception_ptr error;
+      SignedSize error_idx = std::numeric_limits<SignedSize>::max();
+      // PSMs are looked up in the hash map of the results, independently for each spectrum
+#pragma omp parallel for schedule(dynamic, 256) reduction(+: cnt)
+      for (SignedSize i = 0; i < (SignedSize)all_peptide_ids.size(); ++i)
       {
-        String old_score_type{pep_id.getScoreType()}; // copy because we modify the score type below
-        index++;
-        pep_id.setIdentifier(run_identifier);
-        if (scoreType == "pep")
-        {
-          pep_id.setScoreType("Posterior Error Probability");
-        }
-        else
+        try
         {
-          //TODO we should make a difference between peptide-level q-values and psm-level q-values!
-          // I am just not changing it right now, because a lot of tools currently depend on
-          // the score being exactly "q-value"
-          pep_id.setScoreType(scoreType);
-        }
-        pep_id.setHigherScoreBetter(scoreType == "svm");
+          PeptideIdentification& pep_id = all_peptide_ids[i];
+          String old_score_type{pep_id.getScoreType()}; // copy because we modify the score type below
+          const size_t index = i + 1;
+          pep_id.setIdentifier(run_identifier);
+          if (scoreType == "pep")
+          {
+            pep_id.setScoreType("Posterior Error Probability");
+          }
+          else
+          {
+            //TODO we should make a difference between peptide-level q-values and psm-level q-values!
+            // I am just not changing it right now, because a lot of tools currently depend on
+            // the score being exactly "q-value"
+            pep_id.setScoreType(scoreType);
+          }
+          pep_id.setHigherScoreBetter(scoreType == "svm");
         
-        String scan_identifier = PercolatorInfile::getScanIdentifier(pep_id, index);
-        String file_identifier = pep_id.getMetaValue("file_origin", String());
-        file_identifier += (String)pep_id.getMetaValue("id_merge_index", String());
-
-        //check each PeptideHit for compliance with one of the PercolatorResults (by sequence)
-        for (PeptideHit& hit : pep_id.getHits())
-        {
-          String peptide_sequence = hit.getSequence().toBracketString(false, true);
-          String psm_identifier = file_identifier + scan_identifier + peptide_sequence;
+          String scan_identifier = PercolatorInfile::getScanIdentifier(pep_id, index);
+          String file_identifier = pep_id.getMetaValue("file_origin", String());
+          file_identifier += (String)pep_id.getMetaValue("id_merge_index", String());
 
-          //Only for super debug
-          writeDebug_("PSM identifier in PeptideHit: " + psm_identifier, 10);
- 
-          map<String, PercolatorResult>::iterator pr = pep_map.find(psm_identifier);
-          if (pr != pep_map.end())
+          //check each PeptideHit for compliance with one of the PercolatorResults (by sequence)
+          for (PeptideHit& hit : pep_id.getHits())
           {
-            hit.setMetaValue(old_score_type, hit.getScore());  // old search engine "main" score as metavalue
-            hit.setMetaValue("MS:1001492", pr->second.score);  // svm score
-            hit.setMetaValue("MS:1001491", pr->second.qvalue);  // percolator q value
-            hit.setMetaValue("MS:1001493", pr->second.posterior_error_prob);  // percolator pep
+            String peptide_sequence = hit.getSequence().toBracketString(false, true);
+            String psm_identifier = file_identifier + scan_identifier + peptide_sequence;
 
-            if (scoreType == "q-value")
+            //Only for super debug
+            if (debug_level_ >= 10)
             {
-              hit.setScore(pr->second.qvalue);
+#pragma omp critical (PercolatorAdapter_writeDebug)
+              writeDebug_("PSM identifier in PeptideHit: " + psm_identifier, 10);
             }
-            else if (scoreType == "pep")
+ 
+            auto pr = pep_map.find(psm_identifier);
+            if (pr != pep_map.end())
             {
-              hit.setScore(pr->second.posterior_error_prob);
+              hit.setMetaValue(old_score_type, hit.getScore());  // old search engine "main" score as metavalue
+              hit.setMetaValue(svm_score_idx, pr->second.score);  // svm score
+              hit.setMetaValue(qvalue_idx, pr->second.qvalue);  // percolator q value
+              hit.setMetaValue(pep_idx, pr->second.posterior_error_prob);  // percolator pep
+
+              if (scoreType == "q-value")
+              {
+                hit.setScore(pr->second.qvalue);
+              }
+              else if (scoreType == "pep")
+              {
+                hit.setScore(pr->second.posterior_error_prob);
+              }
+              else if (scoreType == "svm")
+              {
+                hit.setScore(pr->second.score);
+              }
+
+              ++cnt;
             }
-            else if (scoreType == "svm")
+            else
             {
-              hit.setScore(pr->second.score);
+              // If the input contains multiple PSMs per spectrum, Percolator only reports the top scoring PSM.
+              // The remaining PSMs should be reported as not identified
+              if (debug_level_ >= 10)
+              {
+#pragma omp critical (PercolatorAdapter_writeDebug)
+                writeDebug_("PSM identifier " + psm_identifier + " not found in peptide map", 10);
+              }
+
+              // Percolator's svm score is scaled such that 0.0 is the score at the chosen FDR threshold,
+              // with positive scores representing PSMs under the FDR threshold (i.e. identified)
+              // and negative scores PSMs above the FDR threshold (i.e. not identified);
+              // -100.0 is typically more than low enough to represent a confidently non-identified PSM.
+              hit.setMetaValue(svm_score_idx, -100.0);  // svm score
+              hit.setMetaValue(qvalue_idx, 1.0);  // percolator q value
+              hit.setMetaValue(pep_idx, 1.0);  // percolator pep
+
+              if (scoreType == "q-value" || scoreType == "pep")
+              {
+                hit.setScore(1.0); // set q-value or PEP to 1.0 if hit not found in results
+              }
+              else if (scoreType == "svm")
+              {
+                hit.setScore(-100.0); // set SVM score to -100.0 if hit not found in results
+              }
             }
-
-            ++cnt;
           }
-          else
+        }
+        catch (...)
+        {
+#pragma omp critical (PercolatorAdapter_reannotate)
           {
-            // If the input contains multiple PSMs per spectrum, Percolator only reports the top scoring PSM.
-            // The remaining PSMs should be reported as not identified
-            writeDebug_("PSM identifier " + psm_identifier + " not found in peptide map", 10);
-
-            // Percolator's svm score is scaled such that 0.0 is the score at the chosen FDR threshold,
-            // with positive scores representing PSMs under the FDR threshold (i.e. identified)
-            // and negative scores PSMs above the FDR threshold (i.e. not identified);
-            // -100.0 is typically more than low enough to represent a confidently non-identified PSM.
-            hit.setMetaValue("MS:1001492", -100.0);  // svm score
-            hit.setMetaValue("MS:1001491", 1.0);  // percolator q value
-            hit.setMetaValue("MS:1001493", 1.0);  // percolator pep
-
-            if (scoreType == "q-value" || scoreType == "pep")
+            // report the error of the first spectrum (as a sequential run would)
+            if (i < error_idx)
             {
-              hit.setScore(1.0); // set q-value or PEP to 1.0 if hit not found in results
-            }
-            else if (scoreType == "svm")
-            {
-              hit.setScore(-100.0); // set SVM score to -100.0 if hit not found in results
+              error_idx = i;
+              error = std::current_exception();
             }
           }
         }
       }
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
 
       if (!peptide_level_fdrs)
       {
@@ -1181,12 +1219,18 @@ protected:
     }
     else
     {
-      std::map< std::string, OSWFile::PercolatorFeature > features;
+      // in the order of the keys (PSMId + peptide), so the result kept for each PSMId does not depend on the hash map
+      std::map<String, const PercolatorResult*> results;
       for (auto const &feat : pep_map)
+      {
+        results.emplace(feat.first, &feat.second);
+      }
+      std::map< std::string, OSWFile::PercolatorFeature > features;
+      for (auto const &feat : results)
       {
         features.emplace(std::piecewise_construct,
-                         std::forward_as_tuple(feat.second.PSMId),
-                         std::forward_as_tuple(feat.second.score, feat.second.qvalue, feat.second.posterior_error_prob));
+                         std::forward_as_tuple(feat.second->PSMId),
+                         std::forward_as_tuple(feat.second->score, feat.second->qvalue, feat.second->posterior_error_prob));
       }
       OSWFile::writeFromPercolator(out, osw_level, features);
     }
@@ -12,6 +12,8 @@
 #include <OpenMS/ANALYSIS/ID/AScore.h>
 #include <OpenMS/METADATA/SpectrumMetaDataLookup.h>
 
+#include <exception>
+
 using namespace OpenMS;
 using namespace std;
 
@@ -284,28 +286,51 @@ protected:
     SpectrumLookup lookup;
     lookup.readSpectra(exp.getSpectra());
 
-    for (const PeptideIdentification& pep : pep_ids)
+    // spectra are sorted by position (see above), so AScore does not modify them and
+    // several threads may score against the same spectrum
+    pep_out.resize(pep_ids.size());
+    std::exception_ptr error;
+    #pragma omp parallel if (pep_ids.size() > 1)
     {
-      Size scan_id = lookup.findByRT(pep.getRT());
-      PeakSpectrum& temp = exp.getSpectrum(scan_id);
-      
-      vector<PeptideHit> scored_peptides;
-      for (const PeptideHit& hit : pep.getHits())
+      AScore thread_ascore(ascore); // AScore keeps per-spectrum state during compute()
+
+      #pragma omp for schedule(dynamic, 100)
+      for (SignedSize i = 0; i < (SignedSize) pep_ids.size(); ++i)
       {
-        PeptideHit scored_hit = hit;
-        addScoreToMetaValues_(scored_hit, pep.getScoreType()); // backup score value
-        
-        OPENMS_LOG_DEBUG << "starting to compute AScore RT=" << pep.getRT() << " SEQUENCE: " << scored_hit.getSequence().toString() << std::endl;
-        
-        PeptideHit phospho_sites = ascore.compute(scored_hit, temp);
-        scored_peptides.push_back(phospho_sites);
-      }
+        try
+        {
+          const PeptideIdentification& pep = pep_ids[i];
+          Size scan_id = lookup.findByRT(pep.getRT());
+          PeakSpectrum& temp = exp.getSpectrum(scan_id);
 
-      PeptideIdentification new_pep_id(pep);
-      new_pep_id.setScoreType("PhosphoScore");
-      new_pep_id.setHigherScoreBetter(true);
-      new_pep_id.setHits(scored_peptides);
-      pep_out.push_back(new_pep_id);
+          vector<PeptideHit> scored_peptides;
+          for (const PeptideHit& hit : pep.getHits())
+          {
+            PeptideHit scored_hit = hit;
+            addScoreToMetaValues_(scored_hit, pep.getScoreType()); // backup score value
+
+            OPENMS_LOG_DEBUG << "starting to compute AScore RT=" << pep.getRT() << " SEQUENCE: " << scored_hit.getSequence().toString() << std::endl;
+
+            PeptideHit phospho_sites = thread_ascore.compute(scored_hit, temp);
+            scored_peptides.push_back(phospho_sites);
+          }
+
+          PeptideIdentification new_pep_id(pep);
+          new_pep_id.setScoreType("PhosphoScore");
+          new_pep_id.setHigherScoreBetter(true);
+          new_pep_id.setHits(scored_peptides);
+          pep_out[i] = new_pep_id;
+        }
+        catch (...)
+        {
+          #pragma omp critical (PhosphoScoring_compute)
+          if (!error) error = std::current_exception();
+        }
+      }
+    }
+    if (error)
+    {
+      std::rethrow_exception(error);
     }
     
     //-------------------------------------------------------------
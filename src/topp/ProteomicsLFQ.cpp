@@ -43,6 +43,7 @@
 #include <OpenMS/METADATA/ExperimentalDesign.h>
 #include <OpenMS/METADATA/SpectrumMetaDataLookup.h>
 #include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/SYSTEM/TaskScheduler.h>
 #include <OpenMS/FEATUREFINDER/FeatureFinderIdentificationAlgorithm.h>
 #include <OpenMS/FEATUREFINDER/FeatureFinderMultiplexAlgorithm.h>
 #include <OpenMS/PROCESSING/CENTROIDING/PeakPickerHiRes.h>
@@ -542,14 +543,18 @@ protected:
       }
 
       // find model parameters (if model_type == "identity" the fit is a NOP):
-      vector<TransformationDescription::TransformationStatistics> alignment_stats;
-      for (TransformationDescription & t : transformations)
+      TaskScheduler::parallelFor(0, transformations.size(), [&](SignedSize i)
       {
-        writeDebug_("Using " + String() + " points in fit.", 1); 
+        TransformationDescription & t = transformations[i];
         if (t.getDataPoints().size() > 10)
         {
           t.fitModel(model_type, model_params);
         }
+      });
+      vector<TransformationDescription::TransformationStatistics> alignment_stats;
+      for (TransformationDescription & t : transformations)
+      {
+        writeDebug_("Using " + String(t.getDataPoints().size()) + " points in fit.", 1); 
         t.printSummary(OpenMS_Log_debug);
         alignment_stats.emplace_back(t.getStatistics());
       }
@@ -11,7 +11,9 @@
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/KERNEL/FeatureMap.h>
 #include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/FORMAT/MzQCFile.h>
 #include <OpenMS/KERNEL/ConsensusMap.h>
+#include <OpenMS/QC/QCMetricAccumulator.h>
 
 using namespace OpenMS;
 using namespace std;
@@ -56,6 +58,8 @@ some quality parameter calculation are only available if both feature and ids ar
 - @p label only for mzQC: RECOMMENDED unique and informative label for the run, so that it can be used as a figure label
 - @p description only for mzQC: description and comments about the mzQC file contents
 - @p out_type specifies the output file type, default: determined by output file extension
+- @p out_accumulator only for mzQC: additionally stores the scalar metrics of the run in a small JSON file, which can be merged with those of other runs
+- @p in_accumulators merges the given accumulator files (of many runs, see @p out_accumulator) and writes the summary of all runs (count, mean, standard deviation, min, max and quantiles of every metric) as mzQC set quality to @p out. No other input is read in this mode. Merging is cheap, so cohort summaries can be updated incrementally whenever a run is added.
 
 Output is in mzQC with JSON formatting or qcML format (see parameter @p out) which can be viewed directly in a modern browser (chromium, firefox, safari).
 The output file specified by the user determines which output file format will be used.
@@ -93,7 +97,7 @@ public:
 protected:
   void registerOptionsAndFlags_() override
   {
-    registerInputFile_("in", "<file>", "", "raw data input file (this is relevant if you want to look at MS1, MS2 and precursor peak information)");
+    registerInputFile_("in", "<file>", "", "raw data input file (this is relevant if you want to look at MS1, MS2 and precursor peak information); required unless 'in_accumulators' is given", false);
     setValidFormats_("in", ListUtils::create<String>("mzML"));
     registerOutputFile_("out", "<file>", "", "Your QC file.");
     setValidFormats_("out", {"mzQC", "qcML"});
@@ -110,6 +114,10 @@ protected:
     registerInputFile_("consensus", "<file>", "", "consensus input file (this is only used for charge state deconvoluted output. Use the consensusXML output form the DeCharger)", false);
     setValidFormats_("consensus", ListUtils::create<String>("consensusXML"));
     registerFlag_("remove_duplicate_features", "This flag should be set, if you work with a set of merged features.");
+    registerOutputFile_("out_accumulator", "<file>", "", "only for mzQC: summaries of the scalar metrics of this run for a later merge with 'in_accumulators'", false);
+    setValidFormats_("out_accumulator", {"json"});
+    registerInputFileList_("in_accumulators", "<files>", {}, "accumulators of many runs (see 'out_accumulator'); if given, they are merged and their summary over all runs is written to 'out' (mzQC)", false);
+    setValidFormats_("in_accumulators", {"json"});
   }
 
   ExitCodes main_(int, const char**) override
@@ -125,10 +133,46 @@ protected:
     String description = getStringOption_("description");
     String label = getStringOption_("label");
     bool remove_duplicate_features(getFlag_("remove_duplicate_features"));
+    String outputfile_accumulator = getStringOption_("out_accumulator");
+    StringList inputfiles_accumulators = getStringList_("in_accumulators");
     
     // ensure output file hase valid extension
     FileTypes::Type out_type = FileHandler::getConsistentOutputfileType(outputfile_name, getStringOption_("out_type"));
 
+    // merge mode: summarize the accumulators of many runs
+    if (!inputfiles_accumulators.empty())
+    {
+      if (out_type != FileTypes::MZQC)
+      {
+        OPENMS_LOG_ERROR << "Merging accumulators is only supported for mzQC output." << endl;
+        return ILLEGAL_PARAMETERS;
+      }
+      QCMetricAccumulator cohort;
+      for (const String& file : inputfiles_accumulators)
+      {
+        QCMetricAccumulator run;
+        run.load(file);
+        cohort.merge(run);
+      }
+      MzQCFile().storeSetQualities(outputfile_name, cohort, contact_name, contact_address, description, label);
+      if (!outputfile_accumulator.empty())
+      {
+        cohort.store(outputfile_accumulator);
+      }
+      return EXECUTION_OK;
+    }
+
+    if (inputfile_name.empty())
+    {
+      OPENMS_LOG_ERROR << "Either 'in' or 'in_accumulators' needs to be given." << endl;
+      return ILLEGAL_PARAMETERS;
+    }
+    if (!outputfile_accumulator.empty() && out_type != FileTypes::MZQC)
+    {
+      OPENMS_LOG_ERROR << "'out_accumulator' is only supported for mzQC output." << endl;
+      return ILLEGAL_PARAMETERS;
+    }
+
     // prepare input
     cout << "Reading mzML file..." << endl;
     MSExperiment exp;
@@ -162,8 +206,17 @@ protected:
     
     // collect QC data and store according to output file extension
 
-    FileHandler().storeQC(inputfile_name, outputfile_name, exp, feature_map, prot_ids, pep_ids, consensus_map, contact_name, 
-    contact_address, description, label, remove_duplicate_features, {out_type});
+    if (!outputfile_accumulator.empty())
+    {
+      QCMetricAccumulator accumulator;
+      MzQCFile().store(inputfile_name, outputfile_name, exp, contact_name, contact_address, description, label, feature_map, prot_ids, pep_ids, &accumulator);
+      accumulator.store(outputfile_accumulator);
+    }
+    else
+    {
+      FileHandler().storeQC(inputfile_name, outputfile_name, exp, feature_map, prot_ids, pep_ids, consensus_map, contact_name, 
+      contact_address, description, label, remove_duplicate_features, {out_type});
+    }
 
 
     return EXECUTION_OK;
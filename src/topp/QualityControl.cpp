@@ -26,6 +26,7 @@
 #include <OpenMS/QC/MzCalibration.h>
 #include <OpenMS/QC/PeptideMass.h>
 #include <OpenMS/QC/PSMExplainedIonCurrent.h>
+#include <OpenMS/QC/QCEngine.h>
 #include <OpenMS/QC/RTAlignment.h>
 #include <OpenMS/QC/TIC.h>
 #include <OpenMS/QC/Ms2SpectrumStats.h>
@@ -320,30 +321,33 @@ protected:
         qc_ms2ir.compute(*fmap, exp, all_target_flag);
       }
 
+      // metrics which only look at single PSMs share one (parallel) pass over the FeatureMap
+      QCEngine psm_engine;
       if (qc_mz_calibration.isRunnable(status))
       {
-        qc_mz_calibration.compute(*fmap, exp, spec_map);
+        qc_mz_calibration.addVisitors(psm_engine, exp);
       }
 
       // after qc_mz_calibration, because it calculates 'mass' metavalue
       if (qc_missed_cleavages.isRunnable(status))
       {
-        qc_missed_cleavages.compute(*fmap);
-      }
-
-      if (qc_rt_alignment.isRunnable(status))
-      { // add metavalues rt_raw & rt_align to all PepIDs
-        qc_rt_alignment.compute(*fmap, trafo_descr);
+        qc_missed_cleavages.addVisitors(psm_engine, *fmap);
       }
 
       if (qc_fwhm.isRunnable(status))
       {
-        qc_fwhm.compute(*fmap);
+        qc_fwhm.addVisitors(psm_engine);
       }
 
       if (qc_pepmass.isRunnable(status))
       {
-        qc_pepmass.compute(*fmap);
+        qc_pepmass.addVisitors(psm_engine);
+      }
+      psm_engine.run(exp, *fmap, spec_map);
+
+      if (qc_rt_alignment.isRunnable(status))
+      { // add metavalues rt_raw & rt_align to all PepIDs
+        qc_rt_alignment.compute(*fmap, trafo_descr);
       }
 
       if (qc_psm_corr.isRunnable(status))
@@ -9,6 +9,10 @@
 #include <OpenMS/config.h>
 
 #include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataChainingConsumer.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataTransformingConsumer.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
 #include <OpenMS/VISUAL/MultiGradient.h>
 #include <OpenMS/PROCESSING/RESAMPLING/LinearResamplerAlign.h>
@@ -84,6 +88,62 @@ protected:
     registerDoubleOption_("min_int_cutoff", "<min intensity>", -1.0,
                           "Intensity cutoff for peaks to be stored in output spectrum (only peaks above this cutoff will be stored, -1 means store all data)", false);
 
+    registerStringOption_("processOption", "<name>", "inmemory", "Whether to load all data and process them in-memory or whether to process the data on the fly (lowmemory) without loading the whole file into memory first", false, true);
+    setValidStrings_("processOption", {"inmemory", "lowmemory"});
+  }
+
+  ExitCodes doLowMemAlgorithm(const String& in, const String& out, LinearResamplerAlign& lin_resampler, bool align_sampling, double min_int_cutoff)
+  {
+    // the aligned raster spans the whole map: get its range from the meta data (without peaks) first
+    double start_pos = 0.0, end_pos = 0.0;
+    if (align_sampling)
+    {
+      PeakMap skeleton;
+      MzMLFile skeleton_file;
+      skeleton_file.setLogType(log_type_);
+      skeleton_file.getOptions().setFillData(false);
+      skeleton_file.load(in, skeleton);
+      skeleton.updateRanges();
+      align_sampling = !skeleton.RangeRT::isEmpty();
+      if (align_sampling)
+      {
+        // start with even position
+        start_pos = floor(skeleton.getMinRT());
+        end_pos = skeleton.getMaxRT();
+      }
+    }
+
+    ThresholdMower mow;
+    Param p;
+    p.setValue("threshold", min_int_cutoff);
+    mow.setParameters(p);
+
+    // resample each spectrum while it is read and write it out right away
+    MSDataTransformingConsumer resample_consumer;
+    resample_consumer.setSpectraProcessingFunc([&](MSSpectrum& spectrum)
+    {
+      if (align_sampling)
+      {
+        lin_resampler.raster_align(spectrum, start_pos, end_pos);
+      }
+      else
+      {
+        lin_resampler.raster(spectrum);
+      }
+      if (min_int_cutoff >= 0.0)
+      {
+        mow.filterPeakSpectrum(spectrum);
+      }
+    });
+    PlainMSDataWritingConsumer writer(out);
+    writer.addDataProcessing(getProcessingInfo_(DataProcessing::DATA_PROCESSING));
+
+    MSDataChainingConsumer chain({&resample_consumer, &writer});
+    MzMLFile mz_data_file;
+    mz_data_file.setLogType(log_type_);
+    mz_data_file.transform(in, &chain);
+
+    return EXECUTION_OK;
   }
 
   ExitCodes main_(int, const char **) override
@@ -97,10 +157,6 @@ protected:
     double min_int_cutoff = getDoubleOption_("min_int_cutoff");
     bool align_sampling = getFlag_("align_sampling");
     bool ppm = getFlag_("ppm");
-    PeakMap exp;
-    exp.updateRanges();
-
-    FileHandler().loadExperiment(in, exp, {FileTypes::MZML}, log_type_);
 
     Param resampler_param;
     resampler_param.setValue("spacing", sampling_rate);
@@ -108,10 +164,21 @@ protected:
 
     LinearResamplerAlign lin_resampler; // LinearResampler does not know about ppm!
     lin_resampler.setParameters(resampler_param);
+
+    if (getStringOption_("processOption") == "lowmemory")
+    {
+      return doLowMemAlgorithm(in, out, lin_resampler, align_sampling, min_int_cutoff);
+    }
+
+    PeakMap exp;
+    exp.updateRanges();
+
+    FileHandler().loadExperiment(in, exp, {FileTypes::MZML}, log_type_);
     if (!align_sampling)
     {
       // resample every scan
-      for (Size i = 0; i < exp.size(); ++i)
+#pragma omp parallel for schedule(dynamic, 100)
+      for (SignedSize i = 0; i < (SignedSize)exp.size(); ++i)
       {
         lin_resampler.raster(exp[i]);
       }
@@ -122,9 +189,11 @@ protected:
       auto start_pos = floor(exp.getMinRT());
 
       // resample every scan
-      for (Size i = 0; i < exp.size(); ++i)
+      const double end_pos = exp.getMaxRT();
+#pragma omp parallel for schedule(dynamic, 100)
+      for (SignedSize i = 0; i < (SignedSize)exp.size(); ++i)
       {
-        lin_resampler.raster_align(exp[i], start_pos, exp.getMaxRT());
+        lin_resampler.raster_align(exp[i], start_pos, end_pos);
       }
     }
 
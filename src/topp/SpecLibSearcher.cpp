@@ -21,6 +21,7 @@
 #include <OpenMS/METADATA/PeptideIdentification.h>
 
 #include <ctime>
+#include <exception>
 #include <vector>
 #include <map>
 #include <cmath>
@@ -241,6 +242,197 @@ protected:
     return annotated_lib;
   }
 
+  /// Search and filter settings (see registerOptionsAndFlags_())
+  struct SearchSettings_
+  {
+    float precursor_mass_tolerance;
+    bool precursor_mass_tolerance_unit_ppm;
+    int pc_min_charge;
+    int pc_max_charge;
+    IntList isotopes;
+    int top_hits;
+    float remove_peaks_below_threshold;
+    UInt min_peaks;
+    UInt max_peaks;
+    Int cut_peaks_below;
+  };
+
+  /**
+    @brief Searches a single MS2 spectrum (with precursor) against the library
+
+    Only reads from its arguments, so it can be called in parallel for different query spectra.
+
+    @return False if the spectrum was not searched (too few peaks after filtering, or charge out of range)
+  */
+  static bool searchSpectrum_(const PeakSpectrum& query_spec,
+                              const String& accession,
+                              const MapLibraryPrecursorToLibrarySpectrum& mslib,
+                              const PeakSpectrumCompareFunctor& comparator,
+                              const String& compare_function,
+                              const SearchSettings_& settings,
+                              PeptideIdentification& pid)
+  {
+    // ID for each query spectrum
+    pid.setIdentifier("test");
+    pid.setScoreType(compare_function);
+
+    // filter query spectrum
+    double max_intensity = std::max_element(query_spec.begin(), query_spec.end(),
+                            [](const Peak1D& l, const Peak1D& r)
+                            {
+                              return (l.getIntensity() < r.getIntensity());
+                            })->getIntensity();
+
+    double min_high_intensity = max_intensity / settings.cut_peaks_below;
+
+    PeakSpectrum filtered_query;
+    for (UInt k = 0; k < query_spec.size(); ++k)
+    {
+      if (query_spec[k].getIntensity() >= settings.remove_peaks_below_threshold
+       && query_spec[k].getIntensity() >= min_high_intensity)
+      {
+        Peak1D peak;
+        peak.setIntensity(sqrt(query_spec[k].getIntensity()));
+        peak.setMZ(query_spec[k].getMZ());
+        filtered_query.push_back(peak);
+      }
+    }
+
+    // retain only top N peaks
+    if (filtered_query.size() > settings.max_peaks)
+    {
+      filtered_query.sortByIntensity(true);
+      filtered_query.resize(settings.max_peaks);
+      filtered_query.sortByPosition();
+    }
+
+    if (filtered_query.size() < settings.min_peaks)
+    {
+      return false;
+    }
+
+    const double& query_rt = query_spec.getRT();
+    const int& query_charge = query_spec.getPrecursors()[0].getCharge();
+    const double query_mz = query_spec.getPrecursors()[0].getMZ();
+
+    if (query_charge > 0 && (query_charge < settings.pc_min_charge || query_charge > settings.pc_max_charge))
+    {
+      return false;
+    }
+
+    // Special treatment for SpectraST score as it computes a score based on the whole library
+    const SpectraSTSimilarityScore* spectrast = (compare_function == "SpectraSTSimilarityScore") ? &dynamic_cast<const SpectraSTSimilarityScore&>(comparator) : nullptr;
+    BinnedSpectrum query_bin_spec; // binned once for all library spectra
+    if (spectrast != nullptr)
+    {
+      query_bin_spec = spectrast->transform(filtered_query);
+    }
+
+    for (auto const & iso : settings.isotopes)
+    {
+      // isotopic misassignment corrected query
+      const double ic_query_mz = query_mz - iso * Constants::C13C12_MASSDIFF_U;
+
+      // if tolerance unit is ppm convert to m/z
+      const double precursor_mass_tolerance_mz = settings.precursor_mass_tolerance_unit_ppm ? ic_query_mz * settings.precursor_mass_tolerance * 1e-6 : settings.precursor_mass_tolerance;
+
+      // skip matching of isotopic misassignments if charge not annotated
+      if (iso != 0 && query_charge == 0)
+      {
+        continue;
+      }
+
+      // skip matching of isotopic misassignments if search windows around isotopic peaks would overlap (resulting in more than one report of the same hit)
+      const double isotopic_peak_distance_mz = Constants::C13C12_MASSDIFF_U / query_charge;
+      if (iso != 0 && precursor_mass_tolerance_mz >= 0.5 * isotopic_peak_distance_mz)
+      {
+        continue;
+      }
+
+      // determine MS2 precursors that match to the current peptide mass
+      MapLibraryPrecursorToLibrarySpectrum::const_iterator low_it, up_it;
+
+      low_it = mslib.lower_bound(ic_query_mz - 0.5 * precursor_mass_tolerance_mz);
+      up_it = mslib.upper_bound(ic_query_mz + 0.5 * precursor_mass_tolerance_mz);
+
+      for (; low_it != up_it; ++low_it)
+      {
+        const PeakSpectrum& lib_spec = low_it->second;
+        PeptideHit hit = lib_spec.getPeptideIdentifications()[0].getHits()[0];
+        const int& lib_charge = hit.getCharge();
+
+        // check if charge state between library and experimental spectrum match
+        if (query_charge > 0 && lib_charge != query_charge)
+        {
+          continue;
+        }
+
+        double score;
+        if (spectrast != nullptr)
+        {
+          BinnedSpectrum lib_bin_spec = spectrast->transform(lib_spec);
+          score = (*spectrast)(query_bin_spec, lib_bin_spec);
+          double dot_bias = spectrast->dot_bias(query_bin_spec, lib_bin_spec, score);
+          hit.setMetaValue("DOTBIAS", dot_bias);
+        }
+        else
+        {
+          score = comparator(filtered_query, lib_spec);
+        }
+
+        DataValue RT(lib_spec.getRT());
+        DataValue MZ(lib_spec.getPrecursors()[0].getMZ());
+        hit.setMetaValue("lib:RT", RT);
+        hit.setMetaValue("lib:MZ", MZ);
+        hit.setMetaValue(Constants::UserParam::ISOTOPE_ERROR, iso);
+        hit.setScore(score);
+        PeptideEvidence pe;
+        pe.setProteinAccession(accession);
+        hit.addPeptideEvidence(pe);
+        pid.insertHit(hit);
+      }
+    }
+
+    pid.setHigherScoreBetter(true);
+    pid.sort();
+
+    if (spectrast != nullptr)
+    {
+      if (!pid.empty() && !pid.getHits().empty())
+      {
+        vector<PeptideHit> final_hits;
+        final_hits.resize(pid.getHits().size());
+        Size runner_up = 1;
+        for (; runner_up < pid.getHits().size(); ++runner_up)
+        {
+          if (pid.getHits()[0].getSequence().toUnmodifiedString() != pid.getHits()[runner_up].getSequence().toUnmodifiedString()
+           || runner_up > 5)
+          {
+            break;
+          }
+        }
+        double delta_D = spectrast->delta_D(pid.getHits()[0].getScore(), pid.getHits()[runner_up].getScore());
+        for (Size s = 0; s < pid.getHits().size(); ++s)
+        {
+          final_hits[s] = pid.getHits()[s];
+          final_hits[s].setMetaValue("delta D", delta_D);
+          final_hits[s].setMetaValue("dot product", pid.getHits()[s].getScore());
+          final_hits[s].setScore(spectrast->compute_F(pid.getHits()[s].getScore(), delta_D, pid.getHits()[s].getMetaValue("DOTBIAS")));
+        }
+        pid.setHits(final_hits);
+        pid.sort();
+        pid.setMZ(query_spec.getPrecursors()[0].getMZ());
+        pid.setRT(query_rt);
+      }
+    }
+
+    if (settings.top_hits != -1 && (UInt)settings.top_hits < pid.getHits().size())
+    {
+      pid.getHits().resize(settings.top_hits);
+    }
+    return true;
+  }
+
   ExitCodes main_(int, const char**) override
   {
     //-------------------------------------------------------------
@@ -279,6 +471,9 @@ protected:
       return ILLEGAL_PARAMETERS;
     }
 
+    const SearchSettings_ settings{precursor_mass_tolerance, precursor_mass_tolerance_unit_ppm, pc_min_charge, pc_max_charge, isotopes,
+                                   top_hits, remove_peaks_below_threshold, min_peaks, max_peaks, cut_peaks_below};
+
     // -------------------------------------------------------------
     // loading input
     // -------------------------------------------------------------
@@ -345,7 +540,6 @@ protected:
    //-------------------------------------------------------------
     // calculations
     //-------------------------------------------------------------
-    double score;
     StringList::iterator in, out_file;
     for (in  = in_spec.begin(), out_file  = out.begin(); in < in_spec.end(); ++in, ++out_file)
     {
@@ -383,202 +577,50 @@ protected:
 
 
       /***********SEARCH**********/
-      for (UInt j = 0; j < query.size(); ++j)
+      // every query spectrum is searched independently (in parallel); results are assembled in input order
+      vector<PeptideIdentification> query_ids(query.size());
+      vector<char> query_searched(query.size(), 0), query_missing_precursor(query.size(), 0);
+      std::exception_ptr error;
+#pragma omp parallel for schedule(dynamic, 10)
+      for (SignedSize j = 0; j < (SignedSize)query.size(); ++j)
       {
-        //Set identifier for each identifications
-        PeptideIdentification pid;
-        pid.setIdentifier("test");
-        pid.setScoreType(compare_function);
-        ProteinHit pr_hit;
-        pr_hit.setAccession(j);
-        prot_id.insertHit(pr_hit);
-
-        // proper MS2?
-        if (query[j].empty() || query[j].getMSLevel() != 2)
-        {
-          continue;
-        }
-
-        if (query[j].getPrecursors().empty())
-        {
-          writeLogWarn_("Warning MS2 spectrum without precursor information");
-          continue;
-        }
-
-        // filter query spectrum
-        double max_intensity = std::max_element(query[j].begin(), query[j].end(), 
-                                [](const Peak1D& l, const Peak1D& r) 
-                                { 
-                                  return (l.getIntensity() < r.getIntensity()); 
-                                })->getIntensity();
-
-        double min_high_intensity = max_intensity / cut_peaks_below;
-
-        PeakSpectrum filtered_query;
-        for (UInt k = 0; k < query[j].size(); ++k)
-        {
-          if (query[j][k].getIntensity() >= remove_peaks_below_threshold 
-           && query[j][k].getIntensity() >= min_high_intensity)
-          {
-            Peak1D peak;
-            peak.setIntensity(sqrt(query[j][k].getIntensity()));
-            peak.setMZ(query[j][k].getMZ());
-            filtered_query.push_back(peak);
-          }
-        }
-
-        // retain only top N peaks
-        if (filtered_query.size() > max_peaks)
-        {
-          filtered_query.sortByIntensity(true);
-          filtered_query.resize(max_peaks);
-          filtered_query.sortByPosition();
-        }
-
-        if (filtered_query.size() < min_peaks)
-        { 
-          continue;
-        }
-
-        const double& query_rt = query[j].getRT();
-        const int& query_charge = query[j].getPrecursors()[0].getCharge();
-        const double query_mz = query[j].getPrecursors()[0].getMZ();
-        
-        if (query_charge > 0 && (query_charge < pc_min_charge || query_charge > pc_max_charge))
-        { 
-          continue;
-        } 
-
-        for (auto const & iso : isotopes)
+        try
         {
-          // isotopic misassignment corrected query
-          const double ic_query_mz = query_mz - iso * Constants::C13C12_MASSDIFF_U;
-
-          // if tolerance unit is ppm convert to m/z
-          const double precursor_mass_tolerance_mz = precursor_mass_tolerance_unit_ppm ? ic_query_mz * precursor_mass_tolerance * 1e-6 : precursor_mass_tolerance;
-
-          // skip matching of isotopic misassignments if charge not annotated
-          if (iso != 0 && query_charge == 0)
-          {
+          if (query[j].empty() || query[j].getMSLevel() != 2)
+          { // no proper MS2
             continue;
           }
-
-          // skip matching of isotopic misassignments if search windows around isotopic peaks would overlap (resulting in more than one report of the same hit)
-          const double isotopic_peak_distance_mz = Constants::C13C12_MASSDIFF_U / query_charge;
-          if (iso != 0 && precursor_mass_tolerance_mz >= 0.5 * isotopic_peak_distance_mz)
-          { 
-            continue;
-          }
-
-          /* TODO: remove old code for charge estimation?
-          bool charge_one = false;
-          Int percent = (Int) Math::round((query[j].size() / 100.0) * 3.0);
-          Int margin  = (Int) Math::round((query[j].size() / 100.0) * 1.0);
-          for (vector<Peak1D>::iterator peak = query[j].end() - 1; percent >= 0; --peak, --percent)
-          {
-            if (peak->getMZ() < query_MZ)
-            {
-              break;
-            }
-          }
-          if (percent > margin)
+          if (query[j].getPrecursors().empty())
           {
-            charge_one = true;
-          }
-          */
-
-
-          // determine MS2 precursors that match to the current peptide mass
-          MapLibraryPrecursorToLibrarySpectrum::const_iterator low_it, up_it;
-        
-          low_it = mslib.lower_bound(ic_query_mz - 0.5 * precursor_mass_tolerance_mz);
-          up_it = mslib.upper_bound(ic_query_mz + 0.5 * precursor_mass_tolerance_mz);
-        
-          // no matching precursor in data
-          if (low_it == up_it)
-          { 
+            query_missing_precursor[j] = 1;
             continue;
           }
-       
-          for (; low_it != up_it; ++low_it)
-          {
-            const PeakSpectrum& lib_spec = low_it->second;;
-            PeptideHit hit = lib_spec.getPeptideIdentifications()[0].getHits()[0];
-            const int& lib_charge = hit.getCharge();  
-
-            // check if charge state between library and experimental spectrum match
-            if (query_charge > 0 && lib_charge != query_charge)
-            {
-              continue;
-            }
-
-            // Special treatment for SpectraST score as it computes a score based on the whole library
-            if (compare_function == "SpectraSTSimilarityScore")
-            {
-              auto& sp = dynamic_cast<SpectraSTSimilarityScore&>(*comparator);
-              BinnedSpectrum quer_bin_spec = sp.transform(filtered_query);
-              BinnedSpectrum lib_bin_spec = sp.transform(lib_spec);
-              score = sp(filtered_query, lib_spec); //(*sp)(quer_bin,librar_bin);
-              double dot_bias = sp.dot_bias(quer_bin_spec, lib_bin_spec, score);
-              hit.setMetaValue("DOTBIAS", dot_bias);
-            }
-            else
-            {
-              score = (*comparator)(filtered_query, lib_spec);
-            }
-
-            DataValue RT(lib_spec.getRT());
-            DataValue MZ(lib_spec.getPrecursors()[0].getMZ());
-            hit.setMetaValue("lib:RT", RT);
-            hit.setMetaValue("lib:MZ", MZ);
-            hit.setMetaValue(Constants::UserParam::ISOTOPE_ERROR, iso);
-            hit.setScore(score);
-            PeptideEvidence pe;
-            pe.setProteinAccession(pr_hit.getAccession());
-            hit.addPeptideEvidence(pe);
-            pid.insertHit(hit);
-          }
+          query_searched[j] = searchSpectrum_(query[j], String(j), mslib, *comparator, compare_function, settings, query_ids[j]) ? 1 : 0;
         }
-
-        pid.setHigherScoreBetter(true);
-        pid.sort();
-
-        if (compare_function == "SpectraSTSimilarityScore")
+        catch (...)
         {
-          if (!pid.empty() && !pid.getHits().empty())
-          {
-            vector<PeptideHit> final_hits;
-            final_hits.resize(pid.getHits().size());
-            auto& sp = dynamic_cast<SpectraSTSimilarityScore&>(*comparator);
-            Size runner_up = 1;
-            for (; runner_up < pid.getHits().size(); ++runner_up)
-            {
-              if (pid.getHits()[0].getSequence().toUnmodifiedString() != pid.getHits()[runner_up].getSequence().toUnmodifiedString() 
-               || runner_up > 5)
-              {
-                break;
-              }
-            }
-            double delta_D = sp.delta_D(pid.getHits()[0].getScore(), pid.getHits()[runner_up].getScore());
-            for (Size s = 0; s < pid.getHits().size(); ++s)
-            {
-              final_hits[s] = pid.getHits()[s];
-              final_hits[s].setMetaValue("delta D", delta_D);
-              final_hits[s].setMetaValue("dot product", pid.getHits()[s].getScore());
-              final_hits[s].setScore(sp.compute_F(pid.getHits()[s].getScore(), delta_D, pid.getHits()[s].getMetaValue("DOTBIAS")));
-            }
-            pid.setHits(final_hits);
-            pid.sort();
-            pid.setMZ(query[j].getPrecursors()[0].getMZ());
-            pid.setRT(query_rt);
-          }
+#pragma omp critical (SpecLibSearcher_search)
+          if (!error) error = std::current_exception();
         }
+      }
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
 
-        if (top_hits != -1 && (UInt)top_hits < pid.getHits().size())
+      for (Size j = 0; j < query.size(); ++j)
+      {
+        ProteinHit pr_hit;
+        pr_hit.setAccession(j);
+        prot_id.insertHit(pr_hit);
+        if (query_missing_precursor[j])
+        {
+          writeLogWarn_("Warning MS2 spectrum without precursor information");
+        }
+        if (query_searched[j])
         {
-          pid.getHits().resize(top_hits);
+          peptide_ids.push_back(std::move(query_ids[j]));
         }
-        peptide_ids.push_back(pid);
       }
       protein_ids.push_back(prot_id);
 
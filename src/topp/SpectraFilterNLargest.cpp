@@ -12,6 +12,10 @@
 #include <OpenMS/PROCESSING/FILTERING/NLargest.h>
 
 #include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataChainingConsumer.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataTransformingConsumer.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
 
 #include <typeinfo>
 
@@ -65,6 +69,9 @@ protected:
     registerOutputFile_("out", "<file>", "", "output file ");
     setValidFormats_("out", ListUtils::create<String>("mzML"));
 
+    registerStringOption_("processOption", "<name>", "inmemory", "Whether to load all data and process them in-memory or whether to process the data on the fly (lowmemory) without loading the whole file into memory first", false, true);
+    setValidStrings_("processOption", ListUtils::create<String>("inmemory,lowmemory"));
+
     // register one section for each algorithm
     registerSubsection_("algorithm", "Algorithm parameter subsection.");
 
@@ -75,6 +82,37 @@ protected:
     return NLargest().getParameters();
   }
 
+  ExitCodes doLowMemAlgorithm(const String& in, const String& out, NLargest& filter)
+  {
+    // filter each spectrum while it is read and write it out right away
+    bool meta_present = false;
+    MSDataTransformingConsumer filter_consumer;
+    filter_consumer.setSpectraProcessingFunc([&](MSSpectrum& spectrum)
+    {
+      if (!spectrum.getFloatDataArrays().empty() || !spectrum.getIntegerDataArrays().empty() || !spectrum.getStringDataArrays().empty())
+      {
+        meta_present = true;
+        spectrum.getFloatDataArrays().clear();
+        spectrum.getIntegerDataArrays().clear();
+        spectrum.getStringDataArrays().clear();
+      }
+      filter.filterPeakSpectrum(spectrum);
+    });
+    PlainMSDataWritingConsumer writer(out);
+    writer.addDataProcessing(getProcessingInfo_(DataProcessing::FILTERING));
+
+    MSDataChainingConsumer chain({&filter_consumer, &writer});
+    MzMLFile mz_data_file;
+    mz_data_file.setLogType(log_type_);
+    mz_data_file.transform(in, &chain);
+
+    if (meta_present)
+    {
+      writeLogWarn_("Warning: Spectrum meta data arrays cannot be sorted. They are deleted.");
+    }
+    return EXECUTION_OK;
+  }
+
   ExitCodes main_(int, const char **) override
   {
     //-------------------------------------------------------------
@@ -84,6 +122,18 @@ protected:
     //input/output files
     String in(getStringOption_("in"));
     String out(getStringOption_("out"));
+    String process_option = getStringOption_("processOption");
+
+    Param filter_param = getParam_().copy("algorithm:", true);
+    writeDebug_("Used filter parameters", filter_param, 3);
+
+    NLargest filter;
+    filter.setParameters(filter_param);
+
+    if (process_option == "lowmemory")
+    {
+      return doLowMemAlgorithm(in, out, filter);
+    }
 
     //-------------------------------------------------------------
     // loading input
@@ -103,11 +153,6 @@ protected:
     //-------------------------------------------------------------
     // filter
     //-------------------------------------------------------------
-    Param filter_param = getParam_().copy("algorithm:", true);
-    writeDebug_("Used filter parameters", filter_param, 3);
-
-    NLargest filter;
-    filter.setParameters(filter_param);
     filter.filterPeakMap(exp);
 
     //-------------------------------------------------------------
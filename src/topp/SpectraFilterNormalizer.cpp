@@ -12,6 +12,10 @@
 #include <OpenMS/PROCESSING/SCALING/Normalizer.h>
 
 #include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataChainingConsumer.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataTransformingConsumer.h>
+#include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
 
 #include <typeinfo>
 
@@ -67,6 +71,9 @@ protected:
     registerOutputFile_("out", "<file>", "", "output file");
     setValidFormats_("out", ListUtils::create<String>("mzML"));
 
+    registerStringOption_("processOption", "<name>", "inmemory", "Whether to load all data and process them in-memory or whether to process the data on the fly (lowmemory) without loading the whole file into memory first", false, true);
+    setValidStrings_("processOption", ListUtils::create<String>("inmemory,lowmemory"));
+
     // register one section for each algorithm
     registerSubsection_("algorithm", "Algorithm parameter subsection.");
 
@@ -77,6 +84,25 @@ protected:
     return Normalizer().getParameters();
   }
 
+  ExitCodes doLowMemAlgorithm(const String& in, const String& out, const Normalizer& filter)
+  {
+    // filter each spectrum while it is read and write it out right away
+    MSDataTransformingConsumer filter_consumer;
+    filter_consumer.setSpectraProcessingFunc([&](MSSpectrum& spectrum)
+    {
+      filter.filterPeakSpectrum(spectrum);
+    });
+    PlainMSDataWritingConsumer writer(out);
+    writer.addDataProcessing(getProcessingInfo_(DataProcessing::FILTERING));
+
+    MSDataChainingConsumer chain({&filter_consumer, &writer});
+    MzMLFile mz_data_file;
+    mz_data_file.setLogType(log_type_);
+    mz_data_file.transform(in, &chain);
+
+    return EXECUTION_OK;
+  }
+
   ExitCodes main_(int, const char **) override
   {
     //-------------------------------------------------------------
@@ -86,6 +112,18 @@ protected:
     //input/output files
     String in(getStringOption_("in"));
     String out(getStringOption_("out"));
+    String process_option = getStringOption_("processOption");
+
+    Param filter_param = getParam_().copy("algorithm:", true);
+    writeDebug_("Used filter parameters", filter_param, 3);
+
+    Normalizer filter;
+    filter.setParameters(filter_param);
+
+    if (process_option == "lowmemory")
+    {
+      return doLowMemAlgorithm(in, out, filter);
+    }
 
     //-------------------------------------------------------------
     // loading input
@@ -98,11 +136,6 @@ protected:
     //-------------------------------------------------------------
     // filter
     //-------------------------------------------------------------
-    Param filter_param = getParam_().copy("algorithm:", true);
-    writeDebug_("Used filter parameters", filter_param, 3);
-
-    Normalizer filter;
-    filter.setParameters(filter_param);
     filter.filterPeakMap(exp);
 
     //-------------------------------------------------------------
@@ -139,6 +139,14 @@ namespace OpenMS
     out.writeValueOrNan(width);
   }
 
+  // value of @p key in @p map, or zero if not contained (like std::map::operator[], but without modifying the map)
+  template <typename MapType>
+  Size lookupOrZero(const MapType& map, const typename MapType::key_type& key)
+  {
+    typename MapType::const_iterator it = map.find(key);
+    return (it == map.end()) ? 0 : it->second;
+  }
+
   // stream output operator for FeatureHandle
   SVOutStream& operator<<(SVOutStream& out, const FeatureHandle& feature)
   {
@@ -951,11 +959,10 @@ protected:
           writeFeatureHeader(output);
           output << nl;
 
-          for (ConsensusMap::const_iterator cmit = consensus_map.begin();
-               cmit != consensus_map.end(); ++cmit)
+          output.writeRows(consensus_map.size(), [&](Size i, SVOutStream& row_out)
           {
-            output << *cmit << nl;
-          }
+            row_out << consensus_map[i] << nl;
+          });
           consensus_centroids_file.close();
         }
 
@@ -983,19 +990,19 @@ protected:
           output << nl;
           output.modifyStrings(true);
 
-          for (ConsensusMap::const_iterator cmit = consensus_map.begin();
-               cmit != consensus_map.end(); ++cmit)
+          output.writeRows(consensus_map.size(), [&](Size i, SVOutStream& row_out)
           {
-            for (ConsensusFeature::const_iterator cfit = cmit->begin();
-                 cfit != cmit->end(); ++cfit)
+            const ConsensusFeature& cf = consensus_map[i];
+            for (ConsensusFeature::const_iterator cfit = cf.begin();
+                 cfit != cf.end(); ++cfit)
             {
-              output << "H" << *cfit << *cmit << nl;
+              row_out << "H" << *cfit << cf << nl;
             }
             // We repeat the first feature handle at the end of the list.
             // This way you can generate closed line drawings
             // See Gnuplot set datafile commentschars
-            output << "L" << *cmit->begin() << *cmit << nl;
-          }
+            row_out << "L" << *cf.begin() << cf << nl;
+          });
           consensus_elements_file.close();
         }
 
@@ -1096,21 +1103,22 @@ protected:
           output << nl;
           output.modifyStrings(true);
 
-          for (ConsensusMap::const_iterator cmit = consensus_map.begin();
-               cmit != consensus_map.end(); ++cmit)
+          // the rows are formatted in parallel, the lookup tables are only read
+          output.writeRows(consensus_map.size(), [&](Size i, SVOutStream& row_out)
           {
-            output << *cmit;
+            const ConsensusFeature* cmit = &consensus_map[i];
+            row_out << *cmit;
             std::vector<FeatureHandle> feature_handles(map_num_to_map_id.size(),
                                                        feature_handle_NaN);
             for (ConsensusFeature::const_iterator cfit = cmit->begin();
                  cfit != cmit->end(); ++cfit)
             {
-              feature_handles[map_id_to_map_num[cfit->getMapIndex()]] = *cfit;
+              feature_handles[lookupOrZero(map_id_to_map_num, cfit->getMapIndex())] = *cfit;
             }
             for (Size fhindex = 0; fhindex < feature_handles.size();
                  ++fhindex)
             {
-              output << feature_handles[fhindex];
+              row_out << feature_handles[fhindex];
             }
             if (!no_ids)
             {
@@ -1120,7 +1128,7 @@ protected:
                      cmit->getPeptideIdentifications().begin(); pep_it !=
                    cmit->getPeptideIdentifications().end(); ++pep_it)
               {
-                Size index = prot_runs[pep_it->getIdentifier()];
+                Size index = lookupOrZero(prot_runs, pep_it->getIdentifier());
                 for (vector<PeptideHit>::const_iterator hit_it = pep_it->
                                                                  getHits().begin(); hit_it != pep_it->getHits().end();
                      ++hit_it)
@@ -1141,8 +1149,8 @@ protected:
                 {
                   acc_it->substitute('/', '_');
                 }
-                output << ListUtils::concatenate(seqs, "/") << seqs.size()
-                       << ListUtils::concatenate(accs, "/") << accs.size();
+                row_out << ListUtils::concatenate(seqs, "/") << seqs.size()
+                        << ListUtils::concatenate(accs, "/") << accs.size();
               }
             }
             // append meta values for each ConsensusFeature
@@ -1150,11 +1158,11 @@ protected:
             {
               for (const auto& key: meta_value_keys)
               {
-                output << cmit->getMetaValue(key, "");
+                row_out << cmit->getMetaValue(key, "");
               }
             }
-            output << nl;
-          }
+            row_out << nl;
+          });
           consensus_features_file.close();
         }
 
@@ -1289,31 +1297,31 @@ protected:
             }
           }
 
-          // consensus features (incl. peptide annotations):
-          for (ConsensusMap::const_iterator cmit = consensus_map.begin();
-               cmit != consensus_map.end(); ++cmit)
+          // consensus features (incl. peptide annotations), formatted in parallel:
+          output.writeRows(consensus_map.size(), [&](Size i, SVOutStream& row_out)
           {
+            const ConsensusFeature* cmit = &consensus_map[i];
             std::vector<FeatureHandle> feature_handles(map_num_to_map_id.size(),
                                                        feature_handle_NaN);
-            output << "CONSENSUS" << *cmit;
+            row_out << "CONSENSUS" << *cmit;
             for (ConsensusFeature::const_iterator cfit = cmit->begin();
                  cfit != cmit->end(); ++cfit)
             {
-              feature_handles[map_id_to_map_num[cfit->getMapIndex()]] = *cfit;
+              feature_handles[lookupOrZero(map_id_to_map_num, cfit->getMapIndex())] = *cfit;
             }
             for (Size fhindex = 0; fhindex < feature_handles.size(); ++fhindex)
             {
-              output << feature_handles[fhindex];
+              row_out << feature_handles[fhindex];
             }
             // append meta values for each ConsensusFeature
             if (add_metavalues)
             {
               for (const auto& key: meta_value_keys)
               {
-                output << cmit->getMetaValue(key, "");
+                row_out << cmit->getMetaValue(key, "");
               }
             }
-            output << nl;
+            row_out << nl;
 
             // peptide ids
             if (!no_ids)
@@ -1322,10 +1330,10 @@ protected:
                      cmit->getPeptideIdentifications().begin(); pit !=
                    cmit->getPeptideIdentifications().end(); ++pit)
               {
-                writePeptideId(output, *pit, "PEPTIDE", false, false, false, peptide_id_meta_keys, peptide_hit_meta_keys);
+                writePeptideId(row_out, *pit, "PEPTIDE", false, false, false, peptide_id_meta_keys, peptide_hit_meta_keys);
               }
             }
-          }
+          });
         }
         return EXECUTION_OK;
       }